@@ -22,6 +22,14 @@ extern "C"
 #include "yDev.h"
 #include "yDev_usart.h"
 
+// ==================== 公共宏定义 ====================
+#ifndef UART_RX_BUF_SIZE
+#define UART_RX_BUF_SIZE (256) /*!< 接收缓冲区默认大小，半满/全满中断推进写入位置，无需覆盖整段突发数据 */
+#endif
+#ifndef UART_TX_BUF_SIZE
+#define UART_TX_BUF_SIZE (512) /*!< 发送队列默认大小 */
+#endif
+
     // ==================== 公共函数声明 ====================
 
     /**
@@ -32,6 +40,37 @@ extern "C"
      */
     void CommunicationInit(void);
 
+    /**
+     * @brief 更换收发缓冲区
+     * @param rx_size 接收缓冲区大小(字节)
+     * @param tx_size 发送队列大小(字节)
+     * @retval int32_t 0成功，-1堆空间不足或重新配置失败，失败的一侧保持原缓冲区
+     *
+     * @par 功能描述:
+     * 新缓冲区从yLib堆分配，配置成功后释放原缓冲区；发送队列先等待发完，
+     * 接收缓冲区中未读的数据丢弃，须在接收方(shell任务)取完数据后调用
+     */
+    int32_t CommunicationResize(uint32_t rx_size, uint32_t tx_size);
+
+    /**
+     * @brief 设置接收数据通知回调
+     * @param notify 通知回调，在中断中执行
+     * @param arg 回调参数
+     *
+     * @par 功能描述:
+     * 收到数据时在中断中调用notify，用于唤醒处理任务；须在CommunicationInit之前调用
+     */
+    void MessageNotifySet(yDevUsartRxNotify_t notify, void *arg);
+
+    /**
+     * @brief 获取通信串口的设备句柄
+     * @return void* 设备句柄
+     *
+     * @par 功能描述:
+     * 供yDevPoll等待接收数据，处理任务可以和其他设备一起等待
+     */
+    void *MessageHandle(void);
+
     /**
      * @brief 开关控制函数
      * @param type 开关类型
@@ -42,6 +81,25 @@ extern "C"
      */
     int32_t MessageWrite(const void *msg, uint16_t len);
 
+    /**
+     * @brief 发送一条零拷贝缓冲区链
+     * @param p 缓冲区链，调用者保留引用，返回后可释放
+     * @return int32_t 写入发送队列的字节数，失败返回负数
+     *
+     * @par 功能描述:
+     * 各段作为向量写入的分段直接进入DMA发送队列，整链连续发出
+     */
+    int32_t MessageWritePbuf(const struct ylib_pbuf *p);
+
+    /**
+     * @brief 查询发送队列中未发出的字节数
+     * @return uint32_t 未发出的字节数
+     *
+     * @par 功能描述:
+     * 用于低优先级数据控制自己在发送队列中的积压量
+     */
+    uint32_t MessagePending(void);
+
     /**
      * @brief 开关状态读取函数
      * @param type 开关类型
@@ -52,6 +110,22 @@ extern "C"
      */
     int32_t MessageRead(void *buff, uint16_t len);
 
+    /**
+     * @brief 查看接收数据
+     * @param span 输出的数据区间，最多两段，直接指向接收缓冲区
+     * @return uint32_t 可读字节总数
+     *
+     * @par 功能描述:
+     * 不拷贝数据，解析完成后调用MessageConsume提交消费长度
+     */
+    uint32_t MessagePeek(yDevUsartRxSpan_t *span);
+
+    /**
+     * @brief 提交已处理的接收数据
+     * @param len 已处理的字节数
+     */
+    void MessageConsume(uint32_t len);
+
     /**
      * @brief 开关状态读取函数
      * @param type 开关类型
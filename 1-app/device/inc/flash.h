@@ -7,7 +7,7 @@
  *
  * @par 功能描述:
  * 基于yDev框架的Flash存储设备驱动，提供Flash读写、擦除等统一控制接口
- * 支持25Q系列SPI Flash芯片的操作和管理
+ * 支持25Q系列SPI Flash芯片的操作和管理，以及片内Flash末尾的数据区
  */
 
 #ifndef APP_FLASH_H
@@ -21,22 +21,54 @@ extern "C"
 // ==================== 包含文件 ====================
 #include "yDev.h"
 #include "yDev_25q.h"
+#include "yDev_iflash.h"
+#include "yDev_fs.h"
 #include <stdint.h>
 #include <stdbool.h>
 
     // ==================== 宏定义 ====================
+#define FLASH_BENCH_ADDRESS (0UL)                       /**< 性能测试区起始地址，测试时会被擦除 */
+#define FLASH_BENCH_SIZE (YDEV_25Q_SECTOR_SIZE)         /**< 性能测试区大小，一个扇区 */
+#define FLASH_CRASHDUMP_RESERVED (YDEV_25Q_SECTOR_SIZE) /**< 25Q末尾保留给故障转储的大小 */
+#ifndef FLASH_FS_ADDRESS
+#define FLASH_FS_ADDRESS (0x63000UL)               /**< 文件系统区地址，位于KV存储区之后、日志区之前 */
+#endif
+#ifndef FLASH_FS_BLOCKS
+#define FLASH_FS_BLOCKS (13U)                      /**< 文件系统区块数，占满到日志区起点0x70000 */
+#endif
 
     // ==================== 函数声明 ====================
 
     /**
      * @brief 初始化Flash模块
-     * @retval true 初始化成功
-     * @retval false 初始化失败
+     * @retval 0 登记成功
+     * @retval -1 登记失败
      * @par 功能描述:
-     * 初始化25Q Flash设备，配置SPI接口参数并检测芯片
+     * 登记25Q Flash设备，芯片检测推迟到首次访问；以YDEV_INIT_DEVICE级别导出，启动任务自动调用
      */
     int32_t FlashInit(void);
 
+    /**
+     * @brief 获取Flash设备句柄
+     * @retval 25Q设备句柄指针
+     * @note 供性能测试等需要直接访问器件的模块使用
+     */
+    yDevHandle_25q_t *FlashGetHandle(void);
+
+    /**
+     * @brief 获取片内Flash数据区设备句柄
+     * @retval 片内Flash设备句柄指针
+     * @note 数据区为链接脚本保留的Flash末尾4KB(两页)
+     */
+    yDevHandle_Iflash_t *IflashGetHandle(void);
+
+    /**
+     * @brief 获取25Q上的文件系统
+     * @retval 已挂载的文件系统，挂载失败返回NULL
+     * @note 以YDEV_INIT_DEFERRED级别挂载，之前调用返回NULL；打开文件用yDevInitStatic(YDEV_TYPE_FILE)
+     */
+    yDevFs_t *FlashFsGet(void);
+
 #ifdef __cplusplus
 }
 #endif
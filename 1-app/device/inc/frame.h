@@ -0,0 +1,170 @@
+/**
+ * @file frame.h
+ * @brief 二进制帧协议模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 在通信串口上提供COBS编码的二进制帧，用于上位机遥测和命令，不经过文本shell
+ *
+ * @par 帧格式:
+ * 0x00 | COBS( id | payload | crc16_lo | crc16_hi ) | 0x00
+ * - CRC-16/CCITT-FALSE覆盖id和payload，由ylib_crc16计算
+ * - 编码后数据不含0x00，0x00只作帧分隔符，丢字节后下一个分隔符即重新同步
+ *
+ * @par 帧分发:
+ * 处理函数通过FRAME_EXPORT放入frameTable链接段，与shell的shellCommand段相同，
+ * 接收流水线分帧且校验通过后按id查表调用
+ */
+
+#ifndef APP_FRAME_H
+#define APP_FRAME_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+    // ==================== 宏定义 ====================
+
+    /**
+     * @brief 帧载荷最大长度
+     */
+#ifndef FRAME_PAYLOAD_MAX
+#define FRAME_PAYLOAD_MAX (128)
+#endif
+
+    /**
+     * @brief 未编码帧最大长度(id + 载荷 + CRC16)
+     */
+#define FRAME_RAW_MAX (1 + FRAME_PAYLOAD_MAX + 2)
+
+    /**
+     * @brief 编码后帧最大长度(COBS开销 + 首尾分隔符)
+     */
+#define FRAME_ENCODED_MAX (FRAME_RAW_MAX + (FRAME_RAW_MAX / 254) + 1 + 2)
+
+    /**
+     * @brief FrameInput接收环形缓冲区大小，必须是2的幂次
+     * @note 不小于流水线块大小PIPE_BLOCK_SIZE，缓冲区满时流水线总能分出一条消息或丢弃超长数据
+     */
+#ifndef FRAME_RX_RING
+#define FRAME_RX_RING (256)
+#endif
+
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief 帧处理函数类型
+     * @param id 帧ID
+     * @param payload 载荷数据，仅在调用期间有效
+     * @param len 载荷长度
+     * @return int32_t 处理结果，仅用于统计 (0=成功, 负数=失败)
+     */
+    typedef int32_t (*FrameHandler_t)(uint8_t id, const uint8_t *payload, uint16_t len);
+
+    /**
+     * @brief 帧分发表项
+     */
+    typedef struct
+    {
+        uint8_t id;             /*!< 帧ID */
+        FrameHandler_t handler; /*!< 处理函数 */
+    } FrameEntry_t;
+
+    /**
+     * @brief 帧协议统计信息
+     */
+    typedef struct
+    {
+        uint32_t rx_frames;  /*!< 校验通过并已分发的帧数 */
+        uint32_t rx_crc;     /*!< CRC错误帧数 */
+        uint32_t rx_format;  /*!< 格式错误帧数(COBS错误、超长、过短) */
+        uint32_t rx_unknown; /*!< 没有处理函数的帧数 */
+        uint32_t rx_failed;  /*!< 处理函数返回失败的帧数 */
+        uint32_t tx_frames;  /*!< 已发送帧数 */
+        uint32_t tx_dropped; /*!< 发送失败帧数 */
+    } FrameStats_t;
+
+    /**
+     * @brief 导出帧处理函数到分发表
+     * @param _id 帧ID
+     * @param _handler 处理函数
+     * @note 每个处理函数只能导出一次，同一id重复导出时先链接的生效
+     */
+#define FRAME_EXPORT(_id, _handler)                                   \
+    __attribute__((used, section("frameTable"), aligned(4)))          \
+    static const FrameEntry_t frame_entry_##_handler = {              \
+        .id = (_id),                                                  \
+        .handler = (_handler),                                        \
+    }
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 初始化帧协议模块
+     *
+     * @par 功能描述:
+     * 初始化发送互斥锁，须在调度器启动前或第一次收发前调用
+     */
+    void FrameInit(void);
+
+    /**
+     * @brief 向解码器输入接收数据
+     * @param data 接收数据
+     * @param len 数据长度
+     *
+     * @par 功能描述:
+     * 数据放入接收环形缓冲区，由接收流水线分帧、校验并分发完整帧，
+     * 不完整的帧留在缓冲区中等待后续数据；只能由一个任务调用
+     */
+    void FrameInput(const uint8_t *data, uint32_t len);
+
+    /**
+     * @brief 处理通信串口中的接收数据
+     * @return uint32_t 本次处理的字节数
+     *
+     * @par 功能描述:
+     * 通信串口作为流水线的数据源，直接在DMA接收缓冲区上分帧，处理完成后提交消费长度；
+     * 用于串口专用于帧协议的场合
+     */
+    uint32_t FramePoll(void);
+
+    /**
+     * @brief 发送一帧
+     * @param id 帧ID
+     * @param payload 载荷数据，可为NULL
+     * @param len 载荷长度，不超过FRAME_PAYLOAD_MAX
+     * @return int32_t 写入发送队列的字节数，失败返回负数
+     *
+     * @par 功能描述:
+     * 编码后一次写入DMA发送队列，多个任务可同时调用
+     */
+    int32_t FrameSend(uint8_t id, const void *payload, uint16_t len);
+
+    /**
+     * @brief 发送一帧，发送队列满时等待后重试
+     * @param id 帧ID
+     * @param payload 载荷数据，可为NULL
+     * @param len 载荷长度，不超过FRAME_PAYLOAD_MAX
+     * @param retries 最多尝试次数，每次失败后等待1个滴答
+     * @return int32_t 写入发送队列的字节数，全部失败返回负数
+     * @note 会阻塞，只能在任务中调用
+     */
+    int32_t FrameSendRetry(uint8_t id, const void *payload, uint16_t len, uint32_t retries);
+
+    /**
+     * @brief 读取统计信息
+     * @param stats 输出的统计信息
+     */
+    void FrameStatsGet(FrameStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_FRAME_H */
@@ -0,0 +1,152 @@
+/**
+ * @file latency.h
+ * @brief 请求端到端延迟跟踪模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 一条请求从接收到应答经过的各层在同一个请求上下文中打时间戳，
+ * 请求结束时每段耗时计入该阶段的直方图，latency命令查看时间花在了哪一段
+ *
+ * @par 阶段划分:
+ * 阶段按时间顺序排列，每段耗时为本阶段时间戳减去之前最近一个已打的时间戳，
+ * 没有打时间戳的阶段不计入；同一阶段只记第一次
+ * - rx: 请求第一个字节被处理到最后一个字节到达，含串口上的传输和DMA批次之间的等待
+ * - parse: 解码、校验和查找处理函数
+ * - flash: 处理函数中的存储访问，由处理函数自己标记
+ * - handle: 处理函数其余部分，到开始发送应答或处理函数返回为止
+ * - tx: 应答编码并写入DMA发送队列，不含串口上的发送时间
+ *
+ * @par 上下文传递:
+ * 上下文以LatId_t编号表示，可以随PipeBuf_t转交给其他任务；
+ * 分发处理函数期间编号登记为当前任务的当前请求(线程本地存储)，处理函数和它调用的发送函数用LatencyCurrent取得，
+ * 不需要层层传参，多个任务同时分发时各自独立
+ */
+
+#ifndef APP_LATENCY_H
+#define APP_LATENCY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+    // ==================== 宏定义 ====================
+
+    /**
+     * @brief 同时跟踪的请求数，超出时新请求不跟踪
+     */
+#ifndef LATENCY_CTX_MAX
+#define LATENCY_CTX_MAX (4)
+#endif
+
+    /**
+     * @brief 直方图桶数，桶i统计[2^i, 2^(i+1))微秒，最后一桶包含更长的耗时
+     */
+#define LATENCY_BUCKETS (16)
+
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief 请求上下文编号，0表示不跟踪
+     */
+    typedef uint16_t LatId_t;
+
+    /**
+     * @brief 阶段
+     */
+    typedef enum
+    {
+        LAT_STAGE_RX = 0, /*!< 接收 */
+        LAT_STAGE_PARSE,  /*!< 解码和分发 */
+        LAT_STAGE_FLASH,  /*!< 存储访问 */
+        LAT_STAGE_HANDLE, /*!< 处理 */
+        LAT_STAGE_TX,     /*!< 发送 */
+        LAT_STAGE_COUNT,
+    } LatStage_t;
+
+    /**
+     * @brief 阶段统计
+     */
+    typedef struct
+    {
+        uint32_t count;                     /*!< 记录次数 */
+        uint32_t max;                       /*!< 最长耗时(us) */
+        uint32_t sum;                       /*!< 耗时总和(us)，溢出后回绕 */
+        uint32_t bucket[LATENCY_BUCKETS];   /*!< 直方图 */
+    } LatHist_t;
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 开始跟踪一条请求
+     * @return LatId_t 上下文编号，上下文用完时返回0
+     *
+     * @par 功能描述:
+     * 以当前时间作为请求起点；任务中调用
+     */
+    LatId_t LatencyBegin(void);
+
+    /**
+     * @brief 打时间戳
+     * @param id 上下文编号，0或已结束的编号被忽略
+     * @param stage 结束的阶段
+     */
+    void LatencyStamp(LatId_t id, LatStage_t stage);
+
+    /**
+     * @brief 结束请求并计入直方图
+     * @param id 上下文编号
+     *
+     * @par 功能描述:
+     * 各阶段耗时计入对应直方图，起点到最后一个时间戳计入总耗时；可以在另一个任务中调用
+     */
+    void LatencyEnd(LatId_t id);
+
+    /**
+     * @brief 放弃请求，不计入直方图
+     * @param id 上下文编号
+     * @note 用于校验失败、没有处理函数等不产生应答的请求
+     */
+    void LatencyAbort(LatId_t id);
+
+    /**
+     * @brief 登记当前任务正在处理的请求
+     * @param id 上下文编号，0表示处理结束
+     */
+    void LatencySetCurrent(LatId_t id);
+
+    /**
+     * @brief 取得当前任务正在处理的请求
+     * @return LatId_t 上下文编号，其他任务调用或没有请求时为0
+     */
+    LatId_t LatencyCurrent(void);
+
+    /**
+     * @brief 为当前请求打时间戳
+     * @param stage 结束的阶段
+     * @note 供处理函数深处标记阶段，等同LatencyStamp(LatencyCurrent(), stage)
+     */
+    void LatencyMark(LatStage_t stage);
+
+    /**
+     * @brief 读取直方图
+     * @param stage 阶段，LAT_STAGE_COUNT表示总耗时
+     * @param hist 输出
+     */
+    void LatencyGet(uint32_t stage, LatHist_t *hist);
+
+    /**
+     * @brief 清零全部直方图
+     */
+    void LatencyReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_LATENCY_H */
@@ -0,0 +1,193 @@
+/**
+ * @file lin.h
+ * @brief LIN主机调度表模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 按调度表循环轮询LIN从机。TIM15的更新事件划分时隙，每个时隙开始时在中断中发出断开符、
+ * 同步字节和PID，主机发布的帧紧接着发出数据和校验和；接收DMA收回总线上的全部字节(含自己发出的)，
+ * 线路空闲达到LIN_RX_TIMEOUT_BITS后由接收超时中断校验回读和从机应答，解码结果发布到lin主题。
+ * 时隙边界由定时器硬件产生，与任务调度无关，每帧只在时隙开始和接收超时各进一次中断
+ *
+ * @par 资源:
+ * - USART2工作在LIN模式并使能硬件FIFO，引脚和接收DMA通道取自board.def的lin0
+ * - 发送不占DMA通道：报头加应答最多11字节，时隙开始时写入8级发送FIFO，余下的由FIFO阈值中断补齐
+ * - TIM15作时隙定时器，计数频率10kHz，重装载值带预装载，下一时隙的长度在本时隙开始时写入
+ * - 两个中断同为YDRV_IRQ_PRIO_LIN，互不抢占，帧状态在中断之间不需要保护
+ *
+ * @par 使用示例:
+ * @code
+ * static uint8_t lamp[2];
+ * static const LinSlot_t schedule[] = {
+ *     {.id = 0x10, .dir = LIN_DIR_PUBLISH, .len = 2, .slot_ms = 10, .data = lamp},
+ *     {.id = 0x21, .dir = LIN_DIR_SUBSCRIBE, .len = 4, .slot_ms = 10},
+ * };
+ * (void)LinStart(schedule, OS_ARRAY_LEN(schedule));
+ * @endcode
+ */
+
+#ifndef APP_LIN_H
+#define APP_LIN_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+#include "msgbus.h"
+
+    // ==================== 宏定义 ====================
+
+/**
+ * @brief 波特率
+ */
+#ifndef LIN_BAUDRATE
+#define LIN_BAUDRATE (19200U)
+#endif
+
+/**
+ * @brief 接收超时位数，须大于从机的应答间隔，否则迟到的应答记为无应答
+ * @note 从最后一个停止位起计，19200波特率下30位约1.6ms
+ */
+#ifndef LIN_RX_TIMEOUT_BITS
+#define LIN_RX_TIMEOUT_BITS (30U)
+#endif
+
+#define LIN_DATA_MAX (8U)       /**< 一帧最多的数据字节数 */
+#define LIN_ID_MAX (0x3FU)      /**< 最大帧ID */
+#define LIN_SLOT_MS_MAX (6553U) /**< 最长时隙，16位重装载值在10kHz计数下的上限 */
+
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief 帧方向
+     */
+    typedef enum
+    {
+        LIN_DIR_SUBSCRIBE = 0, /**< 主机只发报头，由从机应答 */
+        LIN_DIR_PUBLISH,       /**< 主机发出报头和应答 */
+    } LinDir_t;
+
+    /**
+     * @brief 帧结果
+     */
+    typedef enum
+    {
+        LIN_STATUS_OK = 0,      /**< 应答完整，校验和正确 */
+        LIN_STATUS_NO_RESPONSE, /**< 报头之后没有应答 */
+        LIN_STATUS_INCOMPLETE,  /**< 应答字节数不足 */
+        LIN_STATUS_CHECKSUM,    /**< 校验和错误 */
+        LIN_STATUS_READBACK,    /**< 回读的报头或主机应答与发出的不同，总线短路或冲突 */
+        LIN_STATUS_MAX,
+    } LinStatus_t;
+
+    /**
+     * @brief 调度表项
+     * @note 调度表在运行期间须一直有效
+     */
+    typedef struct
+    {
+        uint8_t id;       /**< 帧ID，0~LIN_ID_MAX */
+        uint8_t dir;      /**< LinDir_t */
+        uint8_t len;      /**< 数据长度，1~LIN_DATA_MAX */
+        uint8_t classic;  /**< 1=经典校验和(不含PID)，诊断帧0x3C/0x3D总是经典校验和 */
+        uint16_t slot_ms; /**< 时隙长度(毫秒)，本帧开始到下一帧开始，1~LIN_SLOT_MS_MAX */
+        uint8_t *data;    /**< 主机发布帧的数据，时隙开始时读取；订阅帧不用 */
+    } LinSlot_t;
+
+    /**
+     * @brief 解码后的帧，发布到lin主题
+     */
+    typedef struct
+    {
+        uint8_t id;                 /**< 帧ID */
+        uint8_t status;             /**< LinStatus_t */
+        uint8_t len;                /**< data中的有效字节数 */
+        uint8_t slot;               /**< 调度表中的序号 */
+        uint8_t data[LIN_DATA_MAX]; /**< 数据，主机发布帧为发出的数据 */
+    } LinFrame_t;
+
+    /**
+     * @brief 运行统计
+     */
+    typedef struct
+    {
+        uint32_t frames;                 /**< 发出的报头数 */
+        uint32_t status[LIN_STATUS_MAX]; /**< 按结果分类的帧数 */
+        uint32_t late;                   /**< 下一时隙开始时仍未收到接收超时的帧数，时隙过短或没有回读 */
+        uint16_t count;                  /**< 调度表项数，0为未启动过 */
+        uint8_t running;                 /**< 调度正在运行 */
+    } LinStats_t;
+
+    /**
+     * @brief 帧主题，载荷为LinFrame_t
+     * @note 在接收超时中断中发布；订阅帧每帧发布一次(含失败的)，主机发布帧只在失败时发布
+     */
+    MSGBUS_TOPIC_DECLARE(lin);
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 初始化LIN主机
+     * @return int32_t 0成功，-1串口、DMA或pbuf内存池初始化失败
+     * @note 在任务中、消息总线之后调用；只配置硬件，调度由LinStart启动
+     */
+    int32_t LinInit(void);
+
+    /**
+     * @brief 启动调度表
+     * @param table 调度表
+     * @param count 表项数
+     * @return int32_t 0成功，-1未初始化或表项参数错误
+     * @note 正在运行时先停止，从第一项开始，立即发出第一个报头
+     */
+    int32_t LinStart(const LinSlot_t *table, uint32_t count);
+
+    /**
+     * @brief 重新启动上一次的调度表
+     * @return int32_t 0成功，-1没有调度表
+     */
+    int32_t LinResume(void);
+
+    /**
+     * @brief 停止调度
+     * @note 正在进行的帧不再解码，总线在当前字节发完后空闲
+     */
+    void LinStop(void);
+
+    /**
+     * @brief 读取运行统计
+     * @param stats 输出
+     */
+    void LinGetStats(LinStats_t *stats);
+
+    /**
+     * @brief 清零运行统计
+     */
+    void LinResetStats(void);
+
+    /**
+     * @brief 计算受保护ID
+     * @param id 帧ID
+     * @return uint8_t 带两位奇偶校验的PID
+     */
+    uint8_t LinPid(uint8_t id);
+
+    /**
+     * @brief 计算校验和
+     * @param pid 增强型校验和的PID，经典校验和传0
+     * @param data 数据
+     * @param len 数据长度
+     * @return uint8_t 带进位累加和的反码
+     */
+    uint8_t LinChecksum(uint8_t pid, const uint8_t *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_LIN_H */
@@ -0,0 +1,252 @@
+/**
+ * @file msgbus.h
+ * @brief 任务间发布/订阅消息总线头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 按主题发布消息，每个订阅者从自己的队列取消息，或由总线任务回调；
+ * 传感器采样、按键事件、遥测等可以同时交给多个使用者，不需要每一对收发方各建一个队列
+ *
+ * @par 主题登记:
+ * 主题由MSGBUS_TOPIC_DEFINE放入msgbusTopic链接段，与frameTable段相同；
+ * 发布方在头文件中以MSGBUS_TOPIC_DECLARE声明，使用方以MSGBUS_TOPIC取主题，
+ * shell的bus命令按链接段列出全部主题和统计
+ *
+ * @par 零拷贝:
+ * - 消息只携带描述(主题、长度、载荷)，队列中传递的是描述
+ * - 载荷不超过MSGBUS_INLINE_MAX时直接放在描述中；更长的载荷放在pbuf中，
+ *   每投递给一个订阅者增加一个引用，订阅者处理完调用MsgBusRelease，数据本身不再拷贝
+ *
+ * @par 使用示例:
+ * @code
+ * MSGBUS_QUEUE_DEFINE(ui_queue, 8);
+ * static MsgBusSub_t ui_sub;
+ * QueueHandle_t queue = MSGBUS_QUEUE_CREATE(ui_queue);
+ * (void)MsgBusSubscribeQueue(MSGBUS_TOPIC(button), &ui_sub, queue);
+ * ...
+ * MsgBusMsg_t msg;
+ * if (xQueueReceive(queue, &msg, portMAX_DELAY) == pdPASS)
+ * {
+ *     const SwitchEvent_t *event = MsgBusPayload(&msg);
+ *     ...
+ *     MsgBusRelease(&msg);
+ * }
+ * @endcode
+ */
+
+#ifndef APP_MSGBUS_H
+#define APP_MSGBUS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "os_static.h"
+#include "yLib_pbuf.h"
+
+    // ==================== 宏定义 ====================
+
+    /**
+     * @brief 放在消息描述中的最大载荷，更长的载荷放在pbuf中
+     */
+#ifndef MSGBUS_INLINE_MAX
+#define MSGBUS_INLINE_MAX (8)
+#endif
+
+    /**
+     * @brief 总线任务的回调队列深度
+     */
+#ifndef MSGBUS_QUEUE_LEN
+#define MSGBUS_QUEUE_LEN (8)
+#endif
+
+    // ==================== 类型定义 ====================
+
+    typedef struct MsgBusSub MsgBusSub_t;
+
+    /**
+     * @brief 主题运行状态
+     */
+    typedef struct
+    {
+        MsgBusSub_t *subs;  /*!< 订阅链表 */
+        uint32_t published; /*!< 发布次数 */
+        uint32_t delivered; /*!< 投递次数，一次发布给多个订阅者计多次 */
+        uint32_t dropped;   /*!< 订阅者队列满或pbuf耗尽丢弃的次数 */
+        uint16_t count;     /*!< 订阅者数 */
+        uint16_t callbacks; /*!< 其中回调订阅者数 */
+    } MsgBusTopicState_t;
+
+    /**
+     * @brief 主题
+     */
+    typedef struct
+    {
+        const char *name;          /*!< 名称 */
+        MsgBusTopicState_t *state; /*!< 运行状态 */
+    } MsgBusTopic_t;
+
+    /**
+     * @brief 消息描述
+     * @note 订阅者队列的元素，以值传递
+     */
+    typedef struct
+    {
+        const MsgBusTopic_t *topic;                                  /*!< 主题 */
+        ylib_pbuf_t *pbuf;                                           /*!< 载荷缓冲区，NULL时载荷在data中 */
+        uint32_t time_us;                                            /*!< 发布时刻(yDevGetTimeUS) */
+        uint16_t len;                                                /*!< 载荷长度 */
+        uint16_t reserved;                                           /*!< 保留 */
+        uint8_t data[MSGBUS_INLINE_MAX] __attribute__((aligned(4))); /*!< 内联载荷 */
+    } MsgBusMsg_t;
+
+    /**
+     * @brief 回调订阅者的处理函数
+     * @param arg 订阅时传入的参数
+     * @param msg 消息，仅在调用期间有效，不调用MsgBusRelease
+     * @note 在总线任务中依次调用，不能长时间阻塞
+     */
+    typedef void (*MsgBusCallback_t)(void *arg, const MsgBusMsg_t *msg);
+
+    /**
+     * @brief 订阅者
+     * @note 由使用者提供存储，订阅期间必须一直有效
+     */
+    struct MsgBusSub
+    {
+        MsgBusSub_t *next;         /*!< 订阅链表 */
+        QueueHandle_t queue;       /*!< 接收队列，元素为MsgBusMsg_t；回调订阅者为NULL */
+        MsgBusCallback_t callback; /*!< 回调函数 */
+        void *arg;                 /*!< 回调参数 */
+        uint32_t dropped;          /*!< 队列满丢弃的消息数 */
+    };
+
+    /**
+     * @brief 定义主题
+     * @param _name 主题名，同时用于生成表项名
+     */
+#define MSGBUS_TOPIC_DEFINE(_name)                                    \
+    static MsgBusTopicState_t msgbus_state_##_name;                   \
+    __attribute__((used, section("msgbusTopic"), aligned(4)))         \
+    const MsgBusTopic_t msgbus_topic_##_name = {                      \
+        .name = #_name,                                               \
+        .state = &msgbus_state_##_name,                               \
+    }
+
+    /**
+     * @brief 声明在其他文件中定义的主题
+     */
+#define MSGBUS_TOPIC_DECLARE(_name) extern const MsgBusTopic_t msgbus_topic_##_name
+
+    /**
+     * @brief 取主题指针
+     */
+#define MSGBUS_TOPIC(_name) (&msgbus_topic_##_name)
+
+    /**
+     * @brief 定义订阅者接收队列的静态存储
+     * @param name 对象名
+     * @param length 队列深度
+     */
+#define MSGBUS_QUEUE_DEFINE(name, length) OS_QUEUE_DEFINE(name, MsgBusMsg_t, length)
+
+#define MSGBUS_QUEUE_CREATE(name) OS_QUEUE_CREATE(name)
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 创建总线任务
+     * @note 须在调度器启动前或第一个回调订阅者的消息发布前调用；队列订阅不依赖总线任务
+     */
+    void MsgBusInit(void);
+
+    /**
+     * @brief 以队列订阅主题
+     * @param topic 主题
+     * @param sub 订阅者
+     * @param queue 接收队列，元素大小为sizeof(MsgBusMsg_t)
+     * @return int32_t 0成功，-1参数错误或已订阅
+     * @note 队列满时新消息丢弃并计入sub->dropped，发布方不等待
+     */
+    int32_t MsgBusSubscribeQueue(const MsgBusTopic_t *topic, MsgBusSub_t *sub, QueueHandle_t queue);
+
+    /**
+     * @brief 以回调订阅主题
+     * @param topic 主题
+     * @param sub 订阅者
+     * @param callback 处理函数，在总线任务中调用
+     * @param arg 回调参数
+     * @return int32_t 0成功，-1参数错误或已订阅
+     */
+    int32_t MsgBusSubscribeCallback(const MsgBusTopic_t *topic, MsgBusSub_t *sub,
+                                    MsgBusCallback_t callback, void *arg);
+
+    /**
+     * @brief 取消订阅
+     * @param topic 主题
+     * @param sub 订阅者
+     * @note 队列中已有的消息仍须取出并MsgBusRelease；返回后回调不再被调用
+     */
+    void MsgBusUnsubscribe(const MsgBusTopic_t *topic, MsgBusSub_t *sub);
+
+    /**
+     * @brief 发布消息
+     * @param topic 主题
+     * @param data 载荷
+     * @param len 载荷长度
+     * @return int32_t 投递的订阅者数(回调订阅者合计为1)，pbuf耗尽返回-1
+     * @note 任务和中断中都可以调用，不阻塞；没有订阅者时只计数；
+     *       长载荷拷贝一次到pbuf，之后各订阅者共用，中断中发布长载荷前pbuf内存池须已创建
+     */
+    int32_t MsgBusPublish(const MsgBusTopic_t *topic, const void *data, uint32_t len);
+
+    /**
+     * @brief 以pbuf发布消息
+     * @param topic 主题
+     * @param p 载荷，调用者保留自己的引用，发布后照常释放
+     * @return int32_t 投递的订阅者数(回调订阅者合计为1)
+     * @note 每个投递增加一个引用，载荷不拷贝；订阅者以MsgBusPayload取第一段数据
+     */
+    int32_t MsgBusPublishPbuf(const MsgBusTopic_t *topic, ylib_pbuf_t *p);
+
+    /**
+     * @brief 释放从队列取出的消息
+     * @param msg 消息
+     */
+    void MsgBusRelease(MsgBusMsg_t *msg);
+
+    /**
+     * @brief 按名称查找主题
+     * @return const MsgBusTopic_t* 主题，不存在返回NULL
+     */
+    const MsgBusTopic_t *MsgBusFind(const char *name);
+
+    /**
+     * @brief 按序号取主题
+     * @param index 序号，从0开始
+     * @return const MsgBusTopic_t* 主题，超出范围返回NULL
+     */
+    const MsgBusTopic_t *MsgBusIterate(uint32_t index);
+
+    /**
+     * @brief 取消息载荷
+     * @param msg 消息
+     * @return const void* 载荷起始，pbuf载荷为第一段数据
+     */
+    static inline const void *MsgBusPayload(const MsgBusMsg_t *msg)
+    {
+        return (msg->pbuf != NULL) ? (const void *)msg->pbuf->payload : (const void *)msg->data;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_MSGBUS_H */
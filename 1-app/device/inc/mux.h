@@ -0,0 +1,170 @@
+/**
+ * @file mux.h
+ * @brief 串口文本/二进制通道复用模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * shell文本和二进制帧共用一个串口：接收时按帧分隔符0x00分流，
+ * 发送时限制文本在DMA发送队列中的积压，遥测帧不必排在长文本后面；
+ * 文本输出等待期间继续搬运接收数据，长输出不会造成接收溢出
+ *
+ * @par 分流规则:
+ * - 文本状态下收到0x00进入帧状态，其后数据交给帧解码器
+ * - 帧状态下收到非零数据后的0x00为帧尾，回到文本状态
+ * - 帧状态超过FRAME_ENCODED_MAX字节仍无帧尾时回到文本状态
+ * - 终端输入不含0x00，文本数据原样交给shell
+ */
+
+#ifndef APP_MUX_H
+#define APP_MUX_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+    // ==================== 宏定义 ====================
+
+    /**
+     * @brief 文本每次写入发送队列的最大长度
+     */
+#ifndef MUX_TEXT_CHUNK
+#define MUX_TEXT_CHUNK (32)
+#endif
+
+    /**
+     * @brief 发送队列积压达到该值时文本暂停写入
+     * @note 遥测帧最多排在MUX_TEXT_BACKLOG + MUX_TEXT_CHUNK字节文本之后
+     */
+#ifndef MUX_TEXT_BACKLOG
+#define MUX_TEXT_BACKLOG (64)
+#endif
+
+    /**
+     * @brief 低优先级文本暂停写入的积压
+     * @note 日志等后台文本在命令输出之前让出发送队列
+     */
+#ifndef MUX_TEXT_BACKLOG_LOW
+#define MUX_TEXT_BACKLOG_LOW (16)
+#endif
+
+    /**
+     * @brief 接收暂存缓冲区大小，必须是2的幂次
+     * @note 命令输出期间收到的数据在这里等待分流，加上DMA接收缓冲区即命令执行期间可容纳的输入量
+     */
+#ifndef MUX_RX_HOLD
+#define MUX_RX_HOLD (512)
+#endif
+
+    /**
+     * @brief 识别对端的XON/XOFF
+     * @note 开启后文本中的XOFF暂停文本输出，XON恢复，两者都不交给shell；帧数据不受影响
+     */
+#ifndef MUX_FLOW_XONXOFF
+#define MUX_FLOW_XONXOFF (0)
+#endif
+
+    /**
+     * @brief XOFF后未收到XON时恢复输出的时间
+     */
+#ifndef MUX_XOFF_TIMEOUT_MS
+#define MUX_XOFF_TIMEOUT_MS (5000)
+#endif
+
+#define MUX_XON (0x11U)  /**< DC1 */
+#define MUX_XOFF (0x13U) /**< DC3 */
+
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief 文本数据处理函数类型
+     * @param arg 用户参数
+     * @param data 文本数据，直接指向接收缓冲区
+     * @param len 数据长度
+     */
+    typedef void (*MuxTextHandler_t)(void *arg, const uint8_t *data, uint32_t len);
+
+    /**
+     * @brief 文本输出优先级
+     */
+    typedef enum
+    {
+        MUX_PRIO_LOW = 0, /*!< 后台文本，如日志 */
+        MUX_PRIO_NORMAL,  /*!< 命令输出 */
+        MUX_PRIO_MAX
+    } MuxPrio_t;
+
+    /**
+     * @brief 通道复用统计
+     */
+    typedef struct
+    {
+        uint32_t held;          /*!< 输出等待期间搬运的接收字节数 */
+        uint32_t hold_full;     /*!< 暂存缓冲区满的次数，接收数据只能留在DMA缓冲区中 */
+        uint32_t waits;         /*!< 文本因发送队列积压等待的滴答数 */
+        uint32_t xoff_timeouts; /*!< XOFF超时自动恢复的次数 */
+        uint8_t xoff;           /*!< 当前处于XOFF暂停 */
+    } MuxStats_t;
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 初始化通道复用
+     * @param handler 文本数据处理函数
+     * @param arg 处理函数参数
+     *
+     * @par 功能描述:
+     * 初始化帧协议模块并复位分流状态
+     */
+    void MuxInit(MuxTextHandler_t handler, void *arg);
+
+    /**
+     * @brief 处理通信串口中的接收数据
+     * @return uint32_t 本次处理的字节数
+     *
+     * @par 功能描述:
+     * 接收数据搬到暂存缓冲区后分流，文本交给处理函数，帧数据交给帧解码器；只能由MuxInit的任务调用
+     */
+    uint32_t MuxPoll(void);
+
+    /**
+     * @brief 写入文本数据
+     * @param data 文本数据
+     * @param len 数据长度
+     * @return int32_t 写入的字节数
+     *
+     * @par 功能描述:
+     * 分段写入发送队列，队列积压超过MUX_TEXT_BACKLOG时等待；
+     * 接口与shell的write函数一致，可直接作为shell输出
+     */
+    int32_t MuxTextWrite(const void *data, uint16_t len);
+
+    /**
+     * @brief 按优先级写入文本数据
+     * @param data 文本数据
+     * @param len 数据长度
+     * @param prio 优先级
+     * @return int32_t 写入的字节数
+     *
+     * @par 功能描述:
+     * 与MuxTextWrite相同，积压门限按优先级选择；XOFF期间等待XON或超时。
+     * 在MuxPoll的任务中等待时搬运接收数据
+     */
+    int32_t MuxTextWritePrio(const void *data, uint16_t len, MuxPrio_t prio);
+
+    /**
+     * @brief 读取通道复用统计
+     * @param stats 输出的统计
+     */
+    void MuxStatsGet(MuxStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_MUX_H */
@@ -0,0 +1,224 @@
+/**
+ * @file pipeline.h
+ * @brief 接收流水线模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 把接收处理拆成三级：数据源(DMA接收流) → 分帧器(行/COBS/长度前缀) → 分发表(按ID调用处理函数)，
+ * 新协议只需实现一个分帧器，收发任务、缓冲区管理和分发都复用
+ *
+ * @par 零拷贝:
+ * - 分帧器直接在数据源的接收缓冲区上查找消息，COBS等需要解码的格式原地解码
+ * - 消息跨越环形缓冲区回绕点时才拷贝到ylib_pbuf中拼接
+ * - 处理函数收到的是消息引用，调用期间有效；需要转发或交给其他任务时用PipeBufTake取得
+ *   ylib_pbuf，已在ylib_pbuf中的消息直接转移所有权，不再拷贝；之后可用yDevWritePbuf
+ *   直接写入串口、Flash等设备
+ *
+ * @par 延迟跟踪:
+ * 每条消息从第一次看到开头时开始跟踪，不完整时跨调用保留，分帧完成时记rx阶段，处理函数返回时结束；
+ * 被PipeBufTake取走的消息在PipeBufRelease时结束，转交给其他任务的处理时间也计入handle阶段
+ *
+ * @par 使用示例:
+ * @code
+ * static const PipeSource_t source = {MessagePeek, MessageConsume};
+ * static const PipeRoute_t routes[] = {{'A', OnAck, NULL}, {PIPE_ID_ANY, OnOther, NULL}};
+ * static Pipeline_t pipe;
+ *
+ * PipelineInit(&pipe, &source, &PipeFramerCobs, routes, 2);
+ * while (PipelinePoll(&pipe) > 0) {}
+ * @endcode
+ */
+
+#ifndef APP_PIPELINE_H
+#define APP_PIPELINE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+#include "yDev_usart.h"
+#include "yLib_pbuf.h"
+#include "latency.h"
+
+    // ==================== 宏定义 ====================
+
+    /**
+     * @brief 一条消息在接收流中的最大字节数(含分隔符和头部)
+     * @note 跨越回绕点的消息要放进一个ylib_pbuf，由YLIB_PBUF_SIZE决定
+     */
+#define PIPE_BLOCK_SIZE (YLIB_PBUF_SIZE)
+
+    /**
+     * @brief 分发表中匹配任意ID的表项
+     */
+#define PIPE_ID_ANY (0xFFFFU)
+
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief 消息引用
+     */
+    typedef struct
+    {
+        uint8_t *data;     /*!< 消息数据 */
+        uint16_t len;      /*!< 消息长度 */
+        uint16_t id;       /*!< 分发ID，由分帧器给出 */
+        ylib_pbuf_t *pbuf; /*!< 所在的缓冲区，NULL表示直接指向接收缓冲区 */
+        LatId_t lat;       /*!< 延迟跟踪上下文，随PipeBufTake转移，PipeBufRelease时结束 */
+    } PipeBuf_t;
+
+    /**
+     * @brief 分帧结果
+     */
+    typedef enum
+    {
+        PIPE_SCAN_MORE = 0, /*!< 消息不完整，等待更多数据 */
+        PIPE_SCAN_SKIP,     /*!< 开头的used字节不属于任何消息，丢弃 */
+        PIPE_SCAN_MSG,      /*!< 找到一条消息，占用开头的used字节 */
+    } PipeScan_t;
+
+    /**
+     * @brief 数据源
+     * @note 与MessagePeek/MessageConsume的形式相同，通信串口可直接作为数据源
+     */
+    typedef struct
+    {
+        uint32_t (*peek)(yDevUsartRxSpan_t *span); /*!< 查看可读数据，最多两段 */
+        void (*consume)(uint32_t len);             /*!< 提交已处理的字节数 */
+    } PipeSource_t;
+
+    /**
+     * @brief 分帧器
+     */
+    typedef struct
+    {
+        const char *name; /*!< 名称 */
+
+        /**
+         * @brief 在连续数据中查找一条消息
+         * @param data 从消息边界开始的数据，可原地改写
+         * @param len 数据长度，不超过PIPE_BLOCK_SIZE
+         * @param msg 找到消息时输出消息引用，data和len指向data内部
+         * @param used 输出占用或丢弃的字节数，至少为1
+         * @return PipeScan_t 分帧结果
+         * @note 不保存跨调用的状态，数据不完整时返回PIPE_SCAN_MORE，下次从同一位置重新查找
+         */
+        PipeScan_t (*scan)(uint8_t *data, uint32_t len, PipeBuf_t *msg, uint32_t *used);
+    } PipeFramer_t;
+
+    /**
+     * @brief 消息处理函数类型
+     * @param arg 用户参数
+     * @param msg 消息引用，仅在调用期间有效
+     */
+    typedef void (*PipeHandler_t)(void *arg, PipeBuf_t *msg);
+
+    /**
+     * @brief 分发表项
+     */
+    typedef struct
+    {
+        uint16_t id;           /*!< 消息ID，PIPE_ID_ANY匹配任意ID */
+        PipeHandler_t handler; /*!< 处理函数 */
+        void *arg;             /*!< 处理函数参数 */
+    } PipeRoute_t;
+
+    /**
+     * @brief 流水线统计信息
+     */
+    typedef struct
+    {
+        uint32_t messages;   /*!< 已分发的消息数 */
+        uint32_t unrouted;   /*!< 没有处理函数的消息数 */
+        uint32_t skipped;    /*!< 丢弃的字节数 */
+        uint32_t oversize;   /*!< 超过PIPE_BLOCK_SIZE仍不完整而丢弃的次数 */
+        uint32_t linearized; /*!< 跨越回绕点、拷贝到ylib_pbuf的消息数 */
+        uint32_t no_block;   /*!< ylib_pbuf不足的次数 */
+    } PipeStats_t;
+
+    /**
+     * @brief 流水线
+     */
+    typedef struct
+    {
+        const PipeSource_t *source; /*!< 数据源 */
+        const PipeFramer_t *framer; /*!< 分帧器 */
+        const PipeRoute_t *routes;  /*!< 分发表，按顺序匹配 */
+        uint32_t count;             /*!< 分发表项数 */
+        PipeStats_t stats;          /*!< 统计信息 */
+        LatId_t lat;                /*!< 开头未完整消息的延迟跟踪上下文，0表示尚未开始 */
+    } Pipeline_t;
+
+    // ==================== 内置分帧器 ====================
+
+    /**
+     * @brief 文本行：以'\n'结尾，去掉结尾的"\r\n"，ID为0
+     */
+    extern const PipeFramer_t PipeFramerLine;
+
+    /**
+     * @brief COBS：0x00分隔，原地解码，解码后第一个字节为ID
+     */
+    extern const PipeFramer_t PipeFramerCobs;
+
+    /**
+     * @brief 长度前缀：id | len | payload，len为载荷字节数
+     */
+    extern const PipeFramer_t PipeFramerLength;
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 初始化流水线
+     * @param pipe 流水线
+     * @param source 数据源
+     * @param framer 分帧器
+     * @param routes 分发表
+     * @param count 分发表项数
+     * @return int32_t 0成功，-1 ylib_pbuf内存池创建失败
+     *
+     * @par 功能描述:
+     * 记录各级并清零统计，须在任务中调用
+     */
+    int32_t PipelineInit(Pipeline_t *pipe, const PipeSource_t *source, const PipeFramer_t *framer,
+                         const PipeRoute_t *routes, uint32_t count);
+
+    /**
+     * @brief 处理数据源中的数据
+     * @param pipe 流水线
+     * @return uint32_t 本次提交给数据源的字节数
+     *
+     * @par 功能描述:
+     * 逐条分帧并分发，不完整的消息留在接收缓冲区中等待下次调用；只能由一个任务调用
+     */
+    uint32_t PipelinePoll(Pipeline_t *pipe);
+
+    /**
+     * @brief 取得消息的所有权
+     * @param msg 处理函数收到的消息引用
+     * @param out 输出的消息引用，out->pbuf持有一个引用，用完后调用PipeBufRelease
+     * @return int32_t 0成功，-1 ylib_pbuf不足
+     *
+     * @par 功能描述:
+     * 消息已在ylib_pbuf中时直接转移，否则拷贝到新的ylib_pbuf；只能在处理函数中调用。
+     * out->pbuf的payload和len即消息数据，可直接串入其他缓冲区链
+     */
+    int32_t PipeBufTake(PipeBuf_t *msg, PipeBuf_t *out);
+
+    /**
+     * @brief 释放消息引用
+     * @param buf PipeBufTake取得的引用
+     * @note 可以在任意任务中调用
+     */
+    void PipeBufRelease(PipeBuf_t *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_PIPELINE_H */
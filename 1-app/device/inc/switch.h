@@ -21,9 +21,13 @@ extern "C"
 // ==================== 包含文件 ====================
 #include "yDev.h"
 #include "yDev_gpio.h"
+#include "msgbus.h"
 #include <stdint.h>
 #include <stdbool.h>
 
+    // ==================== 宏定义 ====================
+#define SWITCH_LED_LEVELS (100U) /**< LED亮度等级数，即PWM载波周期计数值 */
+
     // ==================== 开关类型枚举 ====================
 
     /**
@@ -37,6 +41,23 @@ extern "C"
         SWITCH_TYPE_MAX, /**< 开关类型最大值 */
     } usrSwitchType_t;
 
+    /**
+     * @brief 按键事件，发布到button主题
+     */
+    typedef struct
+    {
+        uint32_t time_us;  /**< 消抖前首个边沿的时间戳 */
+        uint8_t pressed;   /**< 1为按下，0为松开 */
+        uint8_t count;     /**< 按下时为连续按下次数(0~3)，同SwitchGetLog */
+        uint16_t reserved; /**< 保留 */
+    } SwitchEvent_t;
+
+    /**
+     * @brief 按键事件主题，载荷为SwitchEvent_t
+     * @note 在取出消抖事件的上下文中发布(按键通知函数所在的定时器任务)
+     */
+    MSGBUS_TOPIC_DECLARE(button);
+
     // ==================== 公共函数声明 ====================
 
     /**
@@ -57,6 +78,27 @@ extern "C"
      */
     void SwitchCtrl(usrSwitchType_t type, uint32_t st);
 
+    /**
+     * @brief LED亮度设置函数
+     * @param level 亮度(0~SWITCH_LED_LEVELS)，超过上限按常亮处理
+     *
+     * @par 功能描述:
+     * 停止正在播放的亮度表，设置PWM比较值，下一个载波周期(10ms)生效
+     */
+    void SwitchLevel(uint32_t level);
+
+    /**
+     * @brief LED亮度表循环播放函数
+     * @param table 亮度表(每项0~SWITCH_LED_LEVELS)，播放期间必须保持有效
+     * @param len 表项数
+     * @return int32_t 0成功，-1失败(没有空闲DMA通道，LED改为常亮)
+     *
+     * @par 功能描述:
+     * 每个载波周期(10ms)由DMA从表中取一项写入比较值，循环播放，期间不需要任务参与；
+     * 播放期间占用一个DMA通道，SwitchLevel停止播放时释放
+     */
+    int32_t SwitchPlay(const uint16_t *table, uint32_t len);
+
     /**
      * @brief 开关状态读取函数
      * @param type 开关类型
@@ -76,6 +118,21 @@ extern "C"
      */
     uint32_t SwitchGetLog(void);
 
+    /**
+     * @brief 连续按键计数窗口剩余时间
+     * @return uint32_t 距上次按下满1.5秒的剩余毫秒数，已满返回0
+     */
+    uint32_t SwitchWindowLeft(void);
+
+    /**
+     * @brief 设置按键事件通知函数
+     * @param notify 通知函数，NULL表示不通知
+     *
+     * @par 功能描述:
+     * 按键消抖后产生新事件时在定时器任务中调用，函数内可调用SwitchRead/SwitchGetLog，不能阻塞
+     */
+    void SwitchSetNotify(void (*notify)(void));
+
 #ifdef __cplusplus
 }
 #endif
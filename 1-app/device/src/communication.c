@@ -10,43 +10,67 @@
  *
  * @par 主要特性:
  * - 基于yDev设备抽象层的USART通信
- * - DMA循环接收缓冲区管理
+ * - DMA循环接收流，支持原地解析
  * - 空闲中断检测数据接收完成
- * - 环形缓冲区数据处理
+ * - DMA发送队列，多个任务写入时由句柄互斥锁保证每次写入连续
+ * - 收发缓冲区从yLib堆分配，运行中可按运行参数更换大小
  * - 溢出检测和错误处理
+ * - uartstat命令查看端口统计
  */
 #include <string.h>
 #include "FreeRTOS.h"
 #include "task.h"
 #include "communication.h"
+#include "shell.h"
+#include "yLib_heap.h"
+#include "board.h"
 
 // ==================== 宏定义 ====================
 
-#define UART_RX_BUF_SIZE (1024) /*!< 串口接收缓冲区大小 */
+/**
+ * @brief 硬件流控
+ * @note 1时CTS无效期间USART暂停发送，接收数据寄存器未读时RTS无效；
+ *       接收由DMA及时搬走，RTS只在DMA来不及时起作用，接收缓冲区的积压由mux在输出等待期间搬运
+ */
+#ifndef COMM_FLOW_RTS_CTS
+#define COMM_FLOW_RTS_CTS (0)
+#endif
 
 // ==================== 静态变量定义 ====================
 
 /**
  * @brief USART设备配置结构体
- * @note 配置USART3，波特率115200，8N1格式，收发双向
+ * @note 波特率115200，8N1格式，收发双向；外设、引脚和DMA通道取自board.def
  */
 static yDevConfig_Usart_t usart_config =
     {
         .base = {
-            .type = YDEV_TYPE_USART, /*!< 设备类型：USART */
+            .type = YDEV_TYPE_USART,  /*!< 设备类型：USART */
+            .use_mutex = 1,           /*!< 句柄互斥锁：shell和帧协议等多个任务写入时串行化 */
+            .name = BOARD_UART3_NAME, /*!< 注册名 */
         },
         .drv_config = {
-            .usartId = YDRV_USART_3,              /*!< 使用USART3 */
-            .txPin = YDRV_PIND8,                  /*!< 发送引脚：PD8 */
-            .rxPin = YDRV_PIND9,                  /*!< 接收引脚：PD9 */
-            .rtsPin = YDRV_PINNULL,               /*!< RTS引脚：未使用 */
-            .ctsPin = YDRV_PINNULL,               /*!< CTS引脚：未使用 */
+            .usartId = BOARD_UART3_PERIPH,        /*!< USART编号 */
+            .txPin = BOARD_UART3_TX_PIN,          /*!< 发送引脚 */
+            .rxPin = BOARD_UART3_RX_PIN,          /*!< 接收引脚 */
+            .txAF = BOARD_UART3_TX_AF,            /*!< 发送引脚复用功能 */
+            .rxAF = BOARD_UART3_RX_AF,            /*!< 接收引脚复用功能 */
+#if COMM_FLOW_RTS_CTS
+            .rtsPin = BOARD_UART3_RTS_PIN,          /*!< RTS引脚 */
+            .ctsPin = BOARD_UART3_CTS_PIN,          /*!< CTS引脚 */
+            .rtsAF = BOARD_UART3_RTS_AF,            /*!< RTS引脚复用功能 */
+            .ctsAF = BOARD_UART3_CTS_AF,            /*!< CTS引脚复用功能 */
+            .flowControl = YDRV_USART_FLOW_RTS_CTS, /*!< 流控：RTS/CTS */
+#else
+            .rtsPin = YDRV_PINNULL,              /*!< RTS引脚：未使用 */
+            .ctsPin = YDRV_PINNULL,              /*!< CTS引脚：未使用 */
+            .flowControl = YDRV_USART_FLOW_NONE, /*!< 流控：无 */
+#endif
             .baudRate = 115200,                   /*!< 波特率：115200 */
             .dataBits = YDRV_USART_DATA_8BIT,     /*!< 数据位：8位 */
             .stopBits = YDRV_USART_STOP_1BIT,     /*!< 停止位：1位 */
             .parity = YDRV_USART_PARITY_NONE,     /*!< 校验位：无 */
             .direction = YDRV_USART_DIR_TX_RX,    /*!< 方向：收发双向 */
-            .flowControl = YDRV_USART_FLOW_NONE,  /*!< 流控：无 */
             .mode = YDRV_USART_MODE_ASYNCHRONOUS, /*!< 模式：异步 */
         },
 };
@@ -58,96 +82,152 @@ static yDevConfig_Usart_t usart_config =
 static yDevHandle_Usart_t usart_handle;
 
 /**
- * @brief USART接收中断回调函数声明
- * @param arg 回调函数参数（未使用）
+ * @brief DMA发送队列配置结构体
+ * @note 队列满时等待空间，打印长文本时调用任务不必等待数据全部发出；
+ *       缓冲区在CommunicationInit中从yLib堆分配，写入只拷贝到缓冲区，由DMA在后台逐段发送
  */
-static void usart_rx_callback(void *arg);
+static yDevUsartTxQueueConfig_t tx_queue_config = {
+    .channel = BOARD_UART3_TX_DMA,    /*!< DMA通道：板级固定分配 */
+    .buffer = NULL,                   /*!< 发送环形缓冲区 */
+    .size = UART_TX_BUF_SIZE,         /*!< 缓冲区大小 */
+    .prio = YDRV_IRQ_PRIO_UART_TX,    /*!< 发送完成中断优先级 */
+    .block = 1,                       /*!< 队列满时等待空间 */
+};
 
 /**
- * @brief USART接收缓冲区
- * @note DMA循环接收缓冲区，大小为UART_RX_BUF_SIZE
+ * @brief DMA接收流配置结构体
+ * @note USART3接收DMA循环写入接收缓冲区，空闲和DMA半满/全满中断推进写入位置；
+ *       缓冲区在CommunicationInit中从yLib堆分配
  */
-static uint8_t usart_rx_buffer[UART_RX_BUF_SIZE];
+static yDevUsartRxStreamConfig_t rx_stream_config = {
+    .channel = BOARD_UART3_RX_DMA,    /*!< DMA通道：板级固定分配 */
+    .buffer = NULL,                   /*!< 接收缓冲区 */
+    .size = UART_RX_BUF_SIZE,         /*!< 缓冲区大小 */
+    .prio = YDRV_IRQ_PRIO_UART_RX,    /*!< 空闲和接收DMA中断优先级，最高等级 */
+    .notify = NULL,                   /*!< 通知回调：无 */
+    .arg = NULL,                      /*!< 回调参数：无 */
+};
 
-/**
- * @brief 接收缓冲区头部索引
- * @note 指向已处理数据的下一个位置
- */
-static uint32_t buffer_write;
+// ==================== 私有函数 ====================
 
 /**
- * @brief 接收缓冲区尾部索引
- * @note 指向DMA写入数据的当前位置
+ * @brief 更换一侧的缓冲区
+ * @param buffer 配置中的缓冲区指针
+ * @param size 配置中的缓冲区大小
+ * @param new_size 新的大小
+ * @param cmd 配置命令
+ * @param config 配置结构体
+ * @retval 0成功，-1失败，失败时恢复原缓冲区
  */
-static uint32_t buffer_read;
+static int32_t comm_swap(uint8_t **buffer, uint32_t *size, uint32_t new_size, uint32_t cmd, void *config)
+{
+    uint8_t *old_buffer = *buffer;
+    uint32_t old_size = *size;
 
-/**
- * @brief 接收缓冲区溢出标志
- * @note 1表示发生溢出，0表示正常
- */
-static uint32_t buffer_overflow;
+    if (new_size == old_size)
+    {
+        return 0;
+    }
+#if YLIB_NO_HEAP_AFTER_INIT
+    if (ylib_heap_sealed())
+    {
+        return -1;
+    }
+#endif
 
-/**
- * @brief DMA接收配置结构体
- * @note 配置USART3的DMA循环接收
- */
-static yDrvDmaConfig_t dma_config = {
-    .channel = YDRV_DMA1_CHANNEL1,      /*!< DMA通道：DMA1通道1 */
-    .request = YDRV_DMA_REQ_USART3_RX,  /*!< DMA请求：USART3接收 */
-    .priority = YDRV_DMA_PRIORITY_HIGH, /*!< DMA优先级：高 */
-    .mode = YDRV_DMA_MODE_CIRCULAR,     /*!< DMA模式：循环模式 */
-    .src_width = YDRV_DMA_WIDTH_8BIT,   /*!< 源数据位宽：8位 */
-    .dst_width = YDRV_DMA_WIDTH_8BIT,   /*!< 目标数据位宽：8位 */
-    .src_inc = YDRV_DMA_INC_DISABLE,    /*!< 源地址递增：禁用（外设地址固定） */
-    .dst_inc = YDRV_DMA_INC_ENABLE,     /*!< 目标地址递增：使能（内存缓冲区） */
-    .src_buffer = usart_rx_buffer,      /*!< 源缓冲区：将设置为USART数据寄存器 */
-    .dst_buffer = usart_rx_buffer,      /*!< 目标缓冲区：接收缓冲区 */
-    .trans_len = UART_RX_BUF_SIZE,      /*!< 传输长度：缓冲区大小 */
-};
+    *buffer = (uint8_t *)ylib_malloc(new_size);
+    if (*buffer == NULL)
+    {
+        *buffer = old_buffer;
+        return -1;
+    }
+    *size = new_size;
 
-/**
- * @brief USART中断配置结构体
- * @note 配置USART空闲中断，用于检测数据接收完成
- */
-static yDrvUsartExtiConfig_t usart_exti_config = {
-    .trigger = YDRV_USART_EXTI_IDLE, /*!< 触发类型：空闲中断 */
-    .prio = 2,                       /*!< 中断优先级：2 */
-    .function = usart_rx_callback,   /*!< 回调函数：接收处理函数 */
-    .arg = NULL,                     /*!< 回调参数：无 */
-    .enable = 1,                     /*!< 中断使能：开启 */
-};
+    if (yDevIoctl(&usart_handle, cmd, config) != YDEV_OK)
+    {
+        ylib_free(*buffer);
+        *buffer = old_buffer;
+        *size = old_size;
+        (void)yDevIoctl(&usart_handle, cmd, config);
+        return -1;
+    }
+
+    ylib_free(old_buffer);
+    return 0;
+}
 
 // ==================== 公共API实现 ====================
 
 /**
  * @brief 通信模块初始化
  * @retval 无
- * @note 初始化USART设备、DMA接收和中断配置
+ * @note 初始化USART设备、DMA接收和中断配置，收发缓冲区按默认大小分配
  */
 void CommunicationInit(void)
 {
-    // 初始化缓冲区索引和标志
-    buffer_write = 0;
-    buffer_read = 0;
-    buffer_overflow = 0;
-
     // 初始化USART设备
     yDevInitStatic(&usart_config, &usart_handle);
 
-    // 配置DMA接收
-    yDevIoctl(&usart_handle,
-              YDEV_USART_IOCTL_SET_RECEIVE_DMA,
-              &dma_config);
+    // 启动早期堆中只有少量对象，分配失败说明堆配置错误
+    rx_stream_config.buffer = (uint8_t *)ylib_malloc(rx_stream_config.size);
+    tx_queue_config.buffer = (uint8_t *)ylib_malloc(tx_queue_config.size);
+    configASSERT((rx_stream_config.buffer != NULL) && (tx_queue_config.buffer != NULL));
 
-    // 使能DMA接收
+    // 配置DMA接收流
     yDevIoctl(&usart_handle,
-              YDEV_USART_IOCTL_ENABLE_RECEIVE_DMA,
-              NULL);
+              YDEV_USART_IOCTL_SET_RECEIVE_STREAM,
+              &rx_stream_config);
 
-    // 配置空闲中断
+    // 配置DMA发送队列
     yDevIoctl(&usart_handle,
-              YDEV_USART_IOCTL_SET_INTERRUPT,
-              &usart_exti_config);
+              YDEV_USART_IOCTL_SET_SEND_QUEUE,
+              &tx_queue_config);
+}
+
+/**
+ * @brief 更换收发缓冲区
+ * @param rx_size 接收缓冲区大小
+ * @param tx_size 发送队列大小
+ * @retval int32_t 0成功，-1失败
+ * @note 发送队列在驱动中等待发完再更换，期间其他任务的写入被句柄互斥锁挡住
+ */
+int32_t CommunicationResize(uint32_t rx_size, uint32_t tx_size)
+{
+    int32_t ret = 0;
+
+    if (comm_swap(&rx_stream_config.buffer, &rx_stream_config.size, rx_size,
+                  YDEV_USART_IOCTL_SET_RECEIVE_STREAM, &rx_stream_config) != 0)
+    {
+        ret = -1;
+    }
+    if (comm_swap(&tx_queue_config.buffer, &tx_queue_config.size, tx_size,
+                  YDEV_USART_IOCTL_SET_SEND_QUEUE, &tx_queue_config) != 0)
+    {
+        ret = -1;
+    }
+    return ret;
+}
+
+/**
+ * @brief 设置接收数据通知回调
+ * @param notify 通知回调，在中断中执行
+ * @param arg 回调参数
+ * @retval 无
+ * @note 须在CommunicationInit之前调用
+ */
+void MessageNotifySet(yDevUsartRxNotify_t notify, void *arg)
+{
+    rx_stream_config.notify = notify;
+    rx_stream_config.arg = arg;
+}
+
+/**
+ * @brief 获取通信串口的设备句柄
+ * @retval void* 设备句柄
+ */
+void *MessageHandle(void)
+{
+    return &usart_handle;
 }
 
 /**
@@ -155,96 +235,115 @@ void CommunicationInit(void)
  * @param msg 要发送的消息数据指针
  * @param len 要发送的消息长度
  * @retval 无
- * @note 通过USART发送指定长度的数据
+ * @note 数据拷贝到DMA发送队列后即返回，队列满时等待空间；
+ *       一次写入的数据在串口上连续发出，不会与其他任务的写入交错
  */
 int32_t MessageWrite(const void *msg, uint16_t len)
 {
     return yDevWrite(&usart_handle, (const uint8_t *)msg, len);
 }
 
+/**
+ * @brief 发送缓冲区链
+ * @param p 缓冲区链
+ * @retval int32_t 写入的字节数
+ * @note 不超过YDEV_PBUF_IOV_MAX段且队列放得下时整链在一次DMA传输中发出
+ */
+int32_t MessageWritePbuf(const struct ylib_pbuf *p)
+{
+    return yDevWritePbuf(&usart_handle, p);
+}
+
+/**
+ * @brief 查询发送队列中未发出的字节数
+ * @retval uint32_t 未发出的字节数
+ */
+uint32_t MessagePending(void)
+{
+    uint32_t pending = 0;
+
+    yDevIoctl(&usart_handle, YDEV_USART_IOCTL_GET_SEND_PENDING, &pending);
+    return pending;
+}
+
 /**
  * @brief 从通信缓冲区读取消息
  * @param buff 用于存放读取数据的缓冲区指针
  * @param len  要读取的最大数据长度
  * @retval int32_t 返回实际读取到的数据长度，如果缓冲区为空则返回0
- * @note 该函数从环形缓冲区中读取数据，并更新读取指针。
+ * @note 从DMA接收流拷贝数据，最多两次memcpy
  */
 int32_t MessageRead(void *buff, uint16_t len)
 {
-    uint16_t bytes_to_read = 0;
-    uint8_t *p_buff = (uint8_t *)buff;
-
-    // 检查缓冲区是否为空
-    if (buffer_write == buffer_read)
-    {
-        return 0;
-    }
-
-    // 计算可读取的数据长度
-    if (buffer_write > buffer_read)
-    {
-        bytes_to_read = buffer_write - buffer_read;
-    }
-    else // 数据已回绕
-    {
-        bytes_to_read = UART_RX_BUF_SIZE + buffer_write - buffer_read;
-    }
-
-    // 取请求长度和可读长度中的较小值
-    if (len < bytes_to_read)
-    {
-        bytes_to_read = len;
-    }
+    return (int32_t)yDevUsartRxCopy(&usart_handle, buff, len);
+}
 
-    // 从环形缓冲区复制数据
-    for (uint16_t i = 0; i < bytes_to_read; i++)
-    {
-        // 如果之前发生过溢出，清空标志并重置缓冲区
-        if (buffer_overflow)
-        {
-            buffer_read = buffer_write + 1; // 重置尾部索引到头部下一个位置
-            buffer_overflow = 0;
-            return i; // 返回i表示曾发生溢出，数据可能不连续
-        }
-        p_buff[i] = usart_rx_buffer[buffer_read];
-        buffer_read = (buffer_read + 1) % UART_RX_BUF_SIZE;
-    }
+/**
+ * @brief 查看通信缓冲区中的可读数据
+ * @param span 输出的数据区间，直接指向接收缓冲区
+ * @retval uint32_t 可读字节总数
+ * @note 解析完成后调用MessageConsume提交已处理的长度
+ */
+uint32_t MessagePeek(yDevUsartRxSpan_t *span)
+{
+    return yDevUsartRxPeek(&usart_handle, span);
+}
 
-    return bytes_to_read;
+/**
+ * @brief 提交已处理的数据长度
+ * @param len 已处理的字节数
+ * @retval 无
+ */
+void MessageConsume(uint32_t len)
+{
+    yDevUsartRxConsume(&usart_handle, len);
 }
 
 /**
  * @brief 消息循环处理函数
- * @retval int 缓冲区溢出状态 (0=正常, 非0=溢出)
- * @note 处理环形缓冲区中的数据，将接收到的数据通过USART发送出去
- *       这是一个回环测试函数，实现数据的原样返回
+ * @retval int 接收溢出次数 (0=正常, 非0=曾发生溢出)
  */
 int MessageLoop(void)
 {
-    return buffer_overflow;
-}
+    uint32_t overruns = 0;
 
-// ==================== 私有函数实现 ====================
+    yDevIoctl(&usart_handle, YDEV_USART_IOCTL_GET_RECEIVE_OVERRUNS, &overruns);
+    return (int)overruns;
+}
 
 /**
- * @brief USART接收中断回调函数
- * @param arg 回调函数参数（未使用）
- * @retval 无
- * @note 在USART空闲中断时调用，更新缓冲区尾部索引并检测溢出
+ * @brief 串口统计shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
  */
-static void usart_rx_callback(void *arg)
+static int UartStatCmd(int argc, char *argv[])
 {
-    (void)arg; // 避免未使用参数警告
+    yDevUsartStats_t stats;
+    Shell *shell = shellGetCurrent();
 
-    // 计算DMA当前写入位置（剩余长度转换为已接收位置）
-    uint32_t index = UART_RX_BUF_SIZE - yDevUsartDmaRxLenGet(&usart_handle);
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0))
+    {
+        yDevIoctl(&usart_handle, YDEV_USART_IOCTL_RESET_STATS, NULL);
+        return 0;
+    }
 
-    // 检测缓冲区溢出：新数据覆盖了未处理的数据
-    if (index < buffer_write && index >= buffer_read)
+    if (yDevIoctl(&usart_handle, YDEV_USART_IOCTL_GET_STATS, &stats) != YDEV_OK)
     {
-        buffer_overflow = 1; // 设置溢出标志
+        return 0;
     }
+    shellPrint(shell, "rx: %lu, tx: %lu\r\n",
+               (unsigned long)stats.rx_bytes, (unsigned long)stats.tx_bytes);
+    shellPrint(shell, "ore: %lu, fe: %lu, ne: %lu, pe: %lu\r\n",
+               (unsigned long)stats.ore, (unsigned long)stats.fe,
+               (unsigned long)stats.ne, (unsigned long)stats.pe);
+    shellPrint(shell, "overruns: %lu, lost: %lu, high water: %lu/%lu\r\n",
+               (unsigned long)stats.overruns, (unsigned long)stats.lost,
+               (unsigned long)stats.rx_high_water, (unsigned long)stats.rx_size);
+    shellPrint(shell, "tx high water: %lu/%lu\r\n",
+               (unsigned long)stats.tx_high_water, (unsigned long)stats.tx_size);
 
-    // 更新缓冲区尾部索引
-    buffer_write = index;
+    return 0;
 }
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 uartstat, UartStatCmd, uart statistics [reset]);
@@ -16,78 +16,694 @@
 // ==================== 包含文件 ====================
 #include "flash.h"
 #include "yDev_25q.h"
+#include "yDev_iflash.h"
+#include "shell.h"
+#include "board.h"
+#include "yLib_heap.h"
+#include "yLib_sbtree.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 // ==================== 私有变量 ====================
 static yDevHandle_25q_t g_flash_handle;
 static yDevConfig_25q_t g_flash_config = {
     .base.type = YDEV_TYPE_25Q,
+    .base.name = BOARD_FLASH0_NAME,
+    .base.idle_ms = 1000,   // 空闲1秒后芯片深度掉电并关闭SPI1时钟
     .base.timeOutMs = 5000, // 默认超时时间5秒
-    .spiId = YDRV_SPI_1,
+    .spiId = BOARD_FLASH0_PERIPH,
     .dataBits = 8,
     .crc = 0,
     .csMode = YDRV_SPI_CS_HARD_OUTPUT,
     .speed = YDRV_SPI_SPEED_LEVEL0,
-    .sckPin = YDRV_PINA1,
-    .misoPin = YDRV_PINA6,
-    .mosiPin = YDRV_PINA2,
-    .csPin = YDRV_PINA4,
-    .sckAF = 0,
-    .misoAF = 0,
-    .mosiAF = 0,
-    .csAF = 0};
-
-static int32_t data[1024];  // 用于测试写入数据的缓冲区
-static int32_t data2[1024]; // 用于测试写入数据的缓冲区
+    .sckPin = BOARD_FLASH0_SCK_PIN,
+    .misoPin = BOARD_FLASH0_MISO_PIN,
+    .mosiPin = BOARD_FLASH0_MOSI_PIN,
+    .csPin = BOARD_FLASH0_CS_PIN,
+    .sckAF = BOARD_FLASH0_SCK_AF,
+    .misoAF = BOARD_FLASH0_MISO_AF,
+    .mosiAF = BOARD_FLASH0_MOSI_AF,
+    .csAF = BOARD_FLASH0_CS_AF,
+    .dmaEnable = 1,                      // 批量读取使用DMA
+    .rxDmaChannel = BOARD_FLASH0_RX_DMA, // SPI接收DMA通道，板级固定分配
+    .txDmaChannel = BOARD_FLASH0_TX_DMA, // SPI发送DMA通道，板级固定分配
+    .fastRead = 1};                      // 使用快速读取命令
+
+static yDevHandle_Iflash_t g_iflash_handle;
+static yDevConfig_Iflash_t g_iflash_config = {
+    .base.type = YDEV_TYPE_IFLASH,
+    .base.name = "iflash0",
+    .base.use_mutex = 1, // 前台写入和同步擦除可能来自多个任务
+    .address = 0,        // 链接脚本保留的末尾数据区
+    .size = 0,
+    .callback = NULL,
+    .arg = NULL};
+
+static yDevFs_t g_fs;
+
+/**
+ * @brief flashlut打开索引时常驻RAM的上层节点字节数
+ * @note 只常驻整层；256字节页、4字节值时1KB可常驻根和不超过3页的第二层，约6000条记录以内的表每次只读叶子一页
+ */
+#ifndef FLASH_LUT_PIN
+#define FLASH_LUT_PIN (1024)
+#endif
+
 // ==================== 私有函数声明 ====================
 
+/**
+ * @brief Flash读缓存shell命令
+ * @param argc 参数个数
+ * @param argv 参数列表，argv[1]为可选的缓存行数(0=关闭)
+ * @retval 0
+ */
+static int FlashCacheCmd(int argc, char *argv[]);
+
+/**
+ * @brief Flash写回缓冲shell命令
+ * @param argc 参数个数
+ * @param argv 参数列表，argv[1]为可选的缓冲页数(0=关闭)，argv[2]为可选的超时写出时间(毫秒)
+ * @retval 0
+ */
+static int FlashWbackCmd(int argc, char *argv[]);
+
+/**
+ * @brief Flash SPI时钟校准shell命令
+ * @param argc 参数个数
+ * @param argv 参数列表，argv[1]为可选的速率等级(0~7)，不指定时自动校准
+ * @retval 0
+ */
+static int FlashTuneCmd(int argc, char *argv[]);
+
+/**
+ * @brief Flash SPI传输统计shell命令
+ * @param argc 参数个数
+ * @param argv 参数列表，argv[1]为"reset"时清零统计
+ * @retval 0
+ */
+static int FlashStatCmd(int argc, char *argv[]);
+
+/**
+ * @brief Flash总线作业调度shell命令
+ * @param argc 参数个数
+ * @param argv 参数列表，argv[1]、argv[2]为类别号和截止时间(毫秒)时设置类别默认截止时间
+ * @retval 0
+ */
+static int FlashJobCmd(int argc, char *argv[]);
+
+/**
+ * @brief Flash脚本执行shell命令
+ * @param argc 参数个数
+ * @param argv 参数列表，argv[1]、argv[2]为脚本地址和最大长度，argv[3]为"-e"时出错停止
+ * @retval 失败的命令数，-1为参数错误或读取失败
+ */
+static int FlashScriptCmd(int argc, char *argv[]);
+
+/**
+ * @brief Flash静态索引查找shell命令
+ * @param argc 参数个数
+ * @param argv 参数列表，argv[1]、argv[2]为索引镜像地址和键，argv[3]为"-f"时查找不大于键的最大键
+ * @retval 0找到，-1未找到或参数错误
+ */
+static int FlashLutCmd(int argc, char *argv[]);
+
+/**
+ * @brief 文件系统shell命令
+ * @param argc 参数个数
+ * @param argv 参数列表，argv[1]为子命令ls/cat/write/rm/df/format
+ * @retval 0成功，-1失败
+ */
+static int FlashFsCmd(int argc, char *argv[]);
+
 // ==================== 公共函数实现 ====================
 
 /**
  * @brief 初始化Flash模块
- * @retval true 初始化成功
- * @retval false 初始化失败
+ * @retval 0 登记成功
+ * @retval -1 登记失败
  * @par 功能描述:
- * 初始化25Q Flash设备，配置SPI接口参数并检测芯片
+ * 登记25Q Flash设备和片内Flash数据区设备，芯片检测和SPI配置推迟到首次访问(启动后台级别的故障转储或shell命令)；
+ * 读写测试由flashbench命令按需执行
  */
 int32_t FlashInit(void)
 {
-    size_t len;
     // 初始化配置结构体
     yDev25qHandleStructInit(&g_flash_handle);
 
     // 设置超时时间
     g_flash_config.base.timeOutMs = 5000; // 5秒超时
 
-    // 初始化25Q Flash设备
-    if (yDevInitStatic(&g_flash_config, &g_flash_handle) != YDEV_OK)
+    // 登记25Q Flash设备，首次访问时初始化
+    if (yDevInitLazy(&g_flash_config, &g_flash_handle) != YDEV_OK)
     {
         return -1;
     }
 
-    for (size_t i = 0; i < sizeof(data) / sizeof(data[0]); i++)
+    // 登记片内Flash数据区
+    yDevIflashHandleStructInit(&g_iflash_handle);
+    if (yDevInitLazy(&g_iflash_config, &g_iflash_handle) != YDEV_OK)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+YDEV_INIT_EXPORT(FlashInit, YDEV_INIT_DEVICE);
+
+/**
+ * @brief 获取Flash设备句柄
+ * @retval 25Q设备句柄指针
+ * @note 调用者直接使用yDev25q接口，不经过yDev的延迟初始化，返回前先完成初始化
+ */
+yDevHandle_25q_t *FlashGetHandle(void)
+{
+    (void)yDevProbe(&g_flash_handle);
+    return &g_flash_handle;
+}
+
+/**
+ * @brief 获取片内Flash数据区设备句柄
+ * @retval 片内Flash设备句柄指针
+ * @note 返回前先完成初始化
+ */
+yDevHandle_Iflash_t *IflashGetHandle(void)
+{
+    (void)yDevProbe(&g_iflash_handle);
+    return &g_iflash_handle;
+}
+
+/**
+ * @brief 挂载25Q上的文件系统
+ * @retval 0 挂载成功
+ * @retval -1 挂载失败
+ * @note 以YDEV_INIT_DEFERRED级别导出，首次访问完成25Q探测
+ */
+static int32_t FlashFsMount(void)
+{
+    yDevFsConfig_t config = {
+        .flash = FlashGetHandle(),
+        .baseAddress = FLASH_FS_ADDRESS,
+        .blockCount = FLASH_FS_BLOCKS,
+    };
+
+    return (yDevFsMount(&g_fs, &config) == YDEV_OK) ? 0 : -1;
+}
+YDEV_INIT_EXPORT(FlashFsMount, YDEV_INIT_DEFERRED);
+
+/**
+ * @brief 获取25Q上的文件系统
+ * @retval 已挂载的文件系统，未挂载返回NULL
+ */
+yDevFs_t *FlashFsGet(void)
+{
+    return g_fs.mounted ? &g_fs : NULL;
+}
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief Flash读缓存shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
+ */
+static int FlashCacheCmd(int argc, char *argv[])
+{
+    yDev25qCacheStats_t stats;
+    uint32_t lines;
+
+    // 指定行数时重新配置缓存
+    if (argc > 1)
+    {
+        lines = (uint32_t)atoi(argv[1]);
+        yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_CACHE_ENABLE, &lines);
+    }
+
+    yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_CACHE_STATS, &stats);
+    shellPrint(shellGetCurrent(), "lines: %lu, hit: %lu, miss: %lu\r\n",
+               (unsigned long)stats.lines, (unsigned long)stats.hit, (unsigned long)stats.miss);
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 flashcache, FlashCacheCmd, flash read cache [lines]);
+
+/**
+ * @brief Flash写回缓冲shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
+ */
+static int FlashWbackCmd(int argc, char *argv[])
+{
+    yDev25qWbackConfig_t config;
+    yDev25qWbackStats_t stats;
+
+    // 指定页数时重新配置缓冲，已缓冲的数据先写出
+    if (argc > 1)
+    {
+        config.pages = (uint32_t)atoi(argv[1]);
+        config.timeoutMs = (argc > 2) ? (uint32_t)atoi(argv[2]) : 0;
+        yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_WBACK_ENABLE, &config);
+        shellPrint(shellGetCurrent(), "timeout: %lu ms\r\n", (unsigned long)config.timeoutMs);
+    }
+
+    yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_WBACK_STATS, &stats);
+    shellPrint(shellGetCurrent(), "pages: %lu, writes: %lu, programs: %lu, timeouts: %lu\r\n",
+               (unsigned long)stats.pages, (unsigned long)stats.writes,
+               (unsigned long)stats.programs, (unsigned long)stats.timeouts);
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 flashwb, FlashWbackCmd, flash write-back buffer [pages [ms]]);
+
+/**
+ * @brief Flash顺序读取预读shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
+ */
+static int FlashPrefetchCmd(int argc, char *argv[])
+{
+    yDev25qPrefetchStats_t stats;
+    uint32_t pages;
+
+    // 指定页数时重新配置预读
+    if (argc > 1)
+    {
+        pages = (uint32_t)atoi(argv[1]);
+        if (yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_PREFETCH, &pages) != YDEV_OK)
+        {
+            shellPrint(shellGetCurrent(), "prefetch needs the background worker\r\n");
+        }
+    }
+
+    yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_PREFETCH_STATS, &stats);
+    shellPrint(shellGetCurrent(), "pages: %lu, issued: %lu, hit: %lu, miss: %lu\r\n",
+               (unsigned long)stats.pages, (unsigned long)stats.issued,
+               (unsigned long)stats.hit, (unsigned long)stats.miss);
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 flashpf, FlashPrefetchCmd, flash sequential read prefetch [pages]);
+
+/**
+ * @brief Flash SPI时钟校准shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
+ */
+static int FlashTuneCmd(int argc, char *argv[])
+{
+    yDev25qSpeedTune_t tune = {0};
+    uint32_t level;
+
+    // 指定等级时直接设置
+    if (argc > 1)
+    {
+        level = (uint32_t)atoi(argv[1]);
+        if (yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_SET_SPEED, &level) != YDEV_OK)
+        {
+            shellPrint(shellGetCurrent(), "set speed level %lu failed\r\n", (unsigned long)level);
+            return 0;
+        }
+        shellPrint(shellGetCurrent(), "speed level: %lu\r\n", (unsigned long)level);
+        return 0;
+    }
+
+    if (yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_SPEED_TUNE, &tune) != YDEV_OK)
+    {
+        shellPrint(shellGetCurrent(), "tune failed, pass mask: 0x%02X\r\n", tune.passMask);
+        return 0;
+    }
+    shellPrint(shellGetCurrent(), "speed level: %u, fastest: %u, pass mask: 0x%02X\r\n",
+               tune.level, tune.fastest, tune.passMask);
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 flashtune, FlashTuneCmd, flash spi clock tune [level]);
+
+/**
+ * @brief Flash SPI传输统计shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
+ */
+static int FlashStatCmd(int argc, char *argv[])
+{
+    yDev25qSpiStats_t stats;
+    Shell *shell = shellGetCurrent();
+
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0))
+    {
+        yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_SPI_STATS_RESET, NULL);
+        return 0;
+    }
+
+    if (yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_SPI_STATS, &stats) != YDEV_OK)
+    {
+        return 0;
+    }
+    shellPrint(shell, "transfers: %lu, bytes: %lu, max: %luus\r\n",
+               (unsigned long)stats.transfers, (unsigned long)stats.bytes, (unsigned long)stats.maxUs);
+    shellPrint(shell, "dma: %lu, irq: %lu, polled: %lu, short: %lu, timeout: %lu\r\n",
+               (unsigned long)stats.dma, (unsigned long)stats.irq, (unsigned long)stats.polled,
+               (unsigned long)stats.shortCount, (unsigned long)stats.timeouts);
+
+    // 只打印非空桶，桶n对应[2^(n-1), 2^n)us
+    for (uint32_t i = 0; i < YDEV_25Q_STATS_BUCKETS; i++)
     {
-        data[i] = i;
-        data2[i] = 11;
+        if ((stats.hist[i] != 0) && (i == (YDEV_25Q_STATS_BUCKETS - 1)))
+        {
+            shellPrint(shell, " >=%6luus: %lu\r\n", (unsigned long)(1UL << (i - 1)), (unsigned long)stats.hist[i]);
+        }
+        else if (stats.hist[i] != 0)
+        {
+            shellPrint(shell, "  <%6luus: %lu\r\n", (unsigned long)(1UL << i), (unsigned long)stats.hist[i]);
+        }
     }
 
-    // 全片擦除
-    yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_CHIP_ERASE, NULL);
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 flashstat, FlashStatCmd, flash spi statistics [reset]);
+
+/**
+ * @brief Flash总线作业调度shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
+ */
+static int FlashJobCmd(int argc, char *argv[])
+{
+    static const char *const names[YDEV_BUSJOB_CLASS_MAX] = {"urgent", "read", "write", "erase", "background"};
+    yDevBusJobStats_t stats[YDEV_BUSJOB_CLASS_MAX];
+    yDevBusJobDeadline_t deadline;
+    Shell *shell = shellGetCurrent();
 
-    // 读取数据
-    len = 0;
-    while (len < sizeof(data2) / sizeof(data2[0]))
+    if (argc > 2)
     {
-        len += yDevRead(&g_flash_handle, &data2[len], sizeof(data2) - len);
+        deadline.cls = strtoul(argv[1], NULL, 0);
+        deadline.deadline_ms = strtoul(argv[2], NULL, 0);
+        if (yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_JOB_DEADLINE, &deadline) != YDEV_OK)
+        {
+            shellPrint(shell, "invalid class or deadline\r\n");
+        }
+        return 0;
     }
 
-    // 写数据进去
-    len = 0;
-    while (len < sizeof(data) / sizeof(data[0]))
+    // 统计读取后清零，每次显示上次查看以来的情况
+    if (yDevIoctl(&g_flash_handle, YDEV_25Q_IOCTL_JOB_STATS, stats) != YDEV_OK)
     {
-        len += yDevWrite(&g_flash_handle, &data[len], sizeof(data) - len);
+        return 0;
+    }
+    shellPrint(shell, "class        runs  misses preempts contend timeout  max wait  max late  owner@max\r\n");
+    for (uint32_t i = 0; i < YDEV_BUSJOB_CLASS_MAX; i++)
+    {
+        shellPrint(shell, "%-10s %6lu  %6lu  %6lu  %6lu  %6lu  %6lums  %6lums  %s\r\n", names[i],
+                   (unsigned long)stats[i].runs, (unsigned long)stats[i].misses, (unsigned long)stats[i].preempts,
+                   (unsigned long)stats[i].contended, (unsigned long)stats[i].timeouts,
+                   (unsigned long)stats[i].max_wait_ms, (unsigned long)stats[i].max_late_ms,
+                   (stats[i].max_wait_owner[0] != '\0') ? stats[i].max_wait_owner : "-");
     }
 
     return 0;
 }
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 flashjob, FlashJobCmd, flash bus job statistics [class deadline_ms]);
+
+/**
+ * @brief Flash脚本执行shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 失败的命令数，-1为参数错误或读取失败
+ * @note 按块读取并逐行执行，遇到0x00或0xFF(擦除状态)视为脚本结束
+ */
+static int FlashScriptCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    ShellScript script;
+    char chunk[64];
+    uint32_t address;
+    uint32_t remain;
+    uint32_t n;
+    uint32_t end;
+
+    if (argc < 3)
+    {
+        shellPrint(shell, "usage: flashscript addr len [-e]\r\n");
+        return -1;
+    }
+
+    if (yDevProbe(&g_flash_handle) != YDEV_OK)
+    {
+        shellPrint(shell, "flash0 not ready\r\n");
+        return -1;
+    }
+
+    // 参数所在的输入缓冲会被脚本行覆盖，先取出
+    address = strtoul(argv[1], NULL, 0);
+    remain = strtoul(argv[2], NULL, 0);
+    shellScriptStart(&script, (argc > 3) && (strcmp(argv[3], "-e") == 0));
+
+    while ((remain > 0) && (script.stopLine == 0))
+    {
+        n = (remain < sizeof(chunk)) ? remain : sizeof(chunk);
+        if (yDev25qRead(&g_flash_handle, address, chunk, n) != (int32_t)n)
+        {
+            shellPrint(shell, "read 0x%08lX failed\r\n", (unsigned long)address);
+            shellScriptEnd(shell, &script);
+            return -1;
+        }
+        for (end = 0; end < n; end++)
+        {
+            if ((chunk[end] == 0x00) || (chunk[end] == (char)0xFF))
+            {
+                break;
+            }
+        }
+        shellScriptFeed(shell, &script, chunk, (unsigned short)end);
+        if (end < n)
+        {
+            break;
+        }
+        address += n;
+        remain -= n;
+    }
+
+    return shellScriptEnd(shell, &script);
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN) | SHELL_CMD_DISABLE_RETURN,
+                 flashscript, FlashScriptCmd, run script stored in flash addr len [-e]);
+
+/**
+ * @brief 静态索引读取回调
+ */
+static int FlashLutRead(void *ctx, uint32_t addr, void *buf, uint32_t len)
+{
+    return (yDev25qRead((yDevHandle_25q_t *)ctx, addr, buf, len) == (int32_t)len) ? 0 : -1;
+}
+
+/**
+ * @brief Flash静态索引查找shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0找到，-1未找到或参数错误
+ * @note 每次打开索引，读页数不含打开时读入的常驻层；读取经过25Q读缓存，命中的页不访问芯片
+ */
+static int FlashLutCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    struct ylib_sbtree *tree;
+    uint8_t value[16];
+    uint8_t *out;
+    uint32_t found;
+    uint32_t key;
+    int ret;
+
+    if (argc < 3)
+    {
+        shellPrint(shell, "usage: flashlut addr key [-f]\r\n");
+        return -1;
+    }
+
+    if (yDevProbe(&g_flash_handle) != YDEV_OK)
+    {
+        shellPrint(shell, "flash0 not ready\r\n");
+        return -1;
+    }
+
+#if YLIB_NO_HEAP_AFTER_INIT
+    if (ylib_heap_sealed())
+    {
+        shellPrint(shell, "heap sealed\r\n");
+        return -1;
+    }
+#endif
+    tree = (struct ylib_sbtree *)ylib_malloc(sizeof(*tree) + FLASH_LUT_PIN);
+    if (tree == NULL)
+    {
+        shellPrint(shell, "no memory\r\n");
+        return -1;
+    }
+
+    if (ylib_sbtree_open(tree, FlashLutRead, &g_flash_handle, strtoul(argv[1], NULL, 0), tree + 1,
+                         FLASH_LUT_PIN) != 0)
+    {
+        shellPrint(shell, "no index at %s\r\n", argv[1]);
+        ylib_free(tree);
+        return -1;
+    }
+
+    // 值超过16字节时只报告长度
+    out = (tree->hdr.value_size <= sizeof(value)) ? value : NULL;
+    key = strtoul(argv[2], NULL, 0);
+    found = key;
+    if ((argc > 3) && (strcmp(argv[3], "-f") == 0))
+    {
+        ret = ylib_sbtree_floor(tree, key, &found, out);
+    }
+    else
+    {
+        ret = ylib_sbtree_find(tree, key, out);
+    }
+
+    shellPrint(shell, "records: %lu, levels: %u, pinned: %u, reads: %lu\r\n", (unsigned long)tree->hdr.count,
+               tree->hdr.levels, tree->pinned, (unsigned long)tree->reads);
+    if ((ret == 1) && (out != NULL))
+    {
+        shellPrint(shell, "0x%08lX:", (unsigned long)found);
+        for (uint32_t i = 0; i < tree->hdr.value_size; i++)
+        {
+            shellPrint(shell, " %02X", value[i]);
+        }
+        shellPrint(shell, "\r\n");
+    }
+    else if (ret == 1)
+    {
+        shellPrint(shell, "0x%08lX: %u bytes\r\n", (unsigned long)found, tree->hdr.value_size);
+    }
+    else
+    {
+        shellPrint(shell, (ret == 0) ? "not found\r\n" : "read failed\r\n");
+    }
+
+    ylib_free(tree);
+    return (ret == 1) ? 0 : -1;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 flashlut, FlashLutCmd, look up static index in flash addr key [-f]);
+
+/**
+ * @brief 文件系统shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0成功，-1失败
+ * @note write把参数文本追加到文件末尾，一条命令对应一次提交
+ */
+static int FlashFsCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    yDevFs_t *fs = FlashFsGet();
+    yDevConfig_File_t config = YDEV_FILE_CONFIG_DEFAULT();
+    yDevHandle_File_t file;
+    yDevFsStats_t stats;
+    yDevFsInfo_t info;
+    char chunk[64];
+    int32_t n;
+    uint32_t i;
+
+    if (fs == NULL)
+    {
+        shellPrint(shell, "fs not mounted\r\n");
+        return -1;
+    }
+
+    if ((argc < 2) || (strcmp(argv[1], "ls") == 0))
+    {
+        for (i = 0; yDevFsDir(fs, i, &info) == YDEV_OK; i++)
+        {
+            shellPrint(shell, "%-24s %6lu  %u blk\r\n", info.name, (unsigned long)info.size,
+                       (unsigned int)info.blocks);
+        }
+        return 0;
+    }
+
+    if (strcmp(argv[1], "df") == 0)
+    {
+        yDevFsGetStats(fs, &stats);
+        shellPrint(shell, "blocks %u/%u, files %u, meta %u B\r\n", (unsigned int)stats.blocksUsed,
+                   (unsigned int)stats.blockCount, (unsigned int)stats.files, (unsigned int)stats.metaUsed);
+        shellPrint(shell, "commits %lu, compactions %lu, erases %lu, cow %lu, scans %lu\r\n",
+                   (unsigned long)stats.commits, (unsigned long)stats.compactions, (unsigned long)stats.erases,
+                   (unsigned long)stats.cows, (unsigned long)stats.scans);
+        shellPrint(shell, "cache hit %lu, miss %lu\r\n", (unsigned long)stats.cacheHits,
+                   (unsigned long)stats.cacheMisses);
+        return 0;
+    }
+
+    if (strcmp(argv[1], "format") == 0)
+    {
+        return (yDevFsFormat(fs) == YDEV_OK) ? 0 : -1;
+    }
+
+    if (argc < 3)
+    {
+        shellPrint(shell, "usage: fs [ls|df|format|cat <name>|write <name> <text>|rm <name>]\r\n");
+        return -1;
+    }
+
+    if (strcmp(argv[1], "rm") == 0)
+    {
+        return (yDevFsRemove(fs, argv[2]) == YDEV_OK) ? 0 : -1;
+    }
+
+    config.fs = fs;
+    config.path = argv[2];
+    if (strcmp(argv[1], "cat") == 0)
+    {
+        config.flags = YDEV_FS_O_RDONLY;
+    }
+    else if ((strcmp(argv[1], "write") == 0) && (argc > 3))
+    {
+        config.flags = YDEV_FS_O_WRONLY | YDEV_FS_O_CREAT | YDEV_FS_O_APPEND;
+    }
+    else
+    {
+        shellPrint(shell, "usage: fs [ls|df|format|cat <name>|write <name> <text>|rm <name>]\r\n");
+        return -1;
+    }
+
+    yDevFileHandleStructInit(&file);
+    if (yDevInitStatic(&config, &file) != YDEV_OK)
+    {
+        shellPrint(shell, "open %s failed\r\n", argv[2]);
+        return -1;
+    }
+
+    if (config.flags == YDEV_FS_O_RDONLY)
+    {
+        while ((n = yDevRead(&file, chunk, sizeof(chunk))) > 0)
+        {
+            shellPrint(shell, "%.*s", (int)n, chunk);
+        }
+        shellPrint(shell, "\r\n");
+        n = 0;
+    }
+    else
+    {
+        n = (yDevWrite(&file, argv[3], strlen(argv[3])) == (int32_t)strlen(argv[3])) ? 0 : -1;
+    }
+
+    if (yDevDeinitStatic(&file) != YDEV_OK)
+    {
+        n = -1;
+    }
+    return (int)n;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 fs, FlashFsCmd, file system [ls|df|format|cat|write|rm]);
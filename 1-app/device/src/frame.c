@@ -0,0 +1,487 @@
+/**
+ * @file frame.c
+ * @brief 二进制帧协议模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * COBS编码 + CRC16校验的二进制帧收发，接收经接收流水线分帧、校验和分发，
+ * 发送编码后整帧写入DMA发送队列
+ *
+ * @par 主要特性:
+ * - 复用流水线的COBS分帧器原地解码，帧分隔符之间的数据不再逐字节搬运
+ * - 复用通道时帧数据先放入接收环形缓冲区，串口专用时直接在DMA接收流上分帧
+ * - ylib_crc16计算CRC-16/CCITT-FALSE，注册硬件后端时由CRC单元完成
+ * - 帧处理函数通过frameTable链接段注册，按id分发
+ * - 发送编码缓冲区由互斥锁保护
+ * - 每帧的延迟由流水线跟踪，处理函数中发送的第一帧作为应答
+ */
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "os_lock.h"
+#include "os_static.h"
+#include "yLib_crc.h"
+#include "yLib_ring.h"
+#include "communication.h"
+#include "frame.h"
+#include "latency.h"
+#include "pipeline.h"
+
+#if (FRAME_RX_RING < PIPE_BLOCK_SIZE)
+#error "FRAME_RX_RING must hold at least one PIPE_BLOCK_SIZE block"
+#endif
+
+// ==================== 类型定义 ====================
+
+/**
+ * @brief COBS编码器状态
+ */
+typedef struct
+{
+    uint8_t *out;      /*!< 输出缓冲区 */
+    uint16_t len;      /*!< 已输出长度 */
+    uint16_t code_pos; /*!< 当前编码字节位置 */
+    uint8_t code;      /*!< 当前编码字节值 */
+} FrameEncoder_t;
+
+// ==================== 静态变量定义 ====================
+
+/**
+ * @brief frameTable链接段起止地址
+ * @note 由链接脚本定义
+ */
+extern const FrameEntry_t _frame_table_start;
+extern const FrameEntry_t _frame_table_end;
+
+/**
+ * @brief 复用通道的帧数据，等待流水线分帧
+ */
+static struct ylib_ring frame_rx;
+
+/**
+ * @brief 接收环形缓冲区
+ */
+static uint8_t frame_rx_buffer[FRAME_RX_RING];
+
+/**
+ * @brief FrameInput使用的流水线，数据源为frame_rx
+ */
+static Pipeline_t frame_pipe;
+
+/**
+ * @brief FramePoll使用的流水线，数据源为通信串口
+ */
+static Pipeline_t frame_uart_pipe;
+
+/**
+ * @brief 发送编码缓冲区
+ * @note 由frame_lock保护，编码完成后一次拷贝到DMA发送队列
+ */
+static uint8_t frame_tx_buffer[FRAME_ENCODED_MAX];
+
+/**
+ * @brief 发送缓冲区互斥锁
+ */
+OS_LOCK_DEFINE(frame_lock);
+
+/**
+ * @brief 统计信息
+ */
+static FrameStats_t frame_stats;
+
+// ==================== 静态函数声明 ====================
+
+/**
+ * @brief 获取互斥锁
+ * @retval 无
+ * @note 调度器未启动时只有一个执行流，不加锁
+ */
+static void prv_Lock(void);
+
+/**
+ * @brief 释放互斥锁
+ * @retval 无
+ */
+static void prv_Unlock(void);
+
+/**
+ * @brief 计算CRC16
+ * @param data 数据指针
+ * @param len 数据长度
+ * @retval uint16_t CRC-16/CCITT-FALSE结果
+ */
+static uint16_t prv_Crc16(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 查看接收环形缓冲区
+ * @param span 输出的数据区间
+ * @retval uint32_t 可读字节数
+ */
+static uint32_t prv_RxPeek(yDevUsartRxSpan_t *span);
+
+/**
+ * @brief 释放接收环形缓冲区中已分帧的数据
+ * @param len 字节数
+ * @retval 无
+ */
+static void prv_RxConsume(uint32_t len);
+
+/**
+ * @brief 帧分帧器，在COBS分帧后校验长度和CRC
+ * @note 格式错误和CRC错误的帧作为丢弃数据返回，不进入分发
+ */
+static PipeScan_t prv_Scan(uint8_t *data, uint32_t len, PipeBuf_t *msg, uint32_t *used);
+
+/**
+ * @brief 按id查找处理函数并调用
+ * @param arg 未使用
+ * @param msg 校验通过的帧，载荷不含CRC
+ * @retval 无
+ */
+static void prv_Dispatch(void *arg, PipeBuf_t *msg);
+
+/**
+ * @brief 编码器输入一个字节
+ * @param enc 编码器
+ * @param b 原始字节
+ * @retval 无
+ */
+static void prv_EncodePut(FrameEncoder_t *enc, uint8_t b);
+
+// ==================== 静态函数实现 ====================
+
+/**
+ * @brief 获取互斥锁实现
+ */
+static void prv_Lock(void)
+{
+    if (OsLockReady(&frame_lock) &&
+        (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        OsLockTake(&frame_lock, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief 释放互斥锁实现
+ */
+static void prv_Unlock(void)
+{
+    if (OsLockReady(&frame_lock) &&
+        (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        OsLockGive(&frame_lock);
+    }
+}
+
+/**
+ * @brief CRC16计算实现
+ */
+static uint16_t prv_Crc16(const uint8_t *data, uint32_t len)
+{
+    return ylib_crc16(YLIB_CRC16_INIT, data, len);
+}
+
+/**
+ * @brief 查看接收环形缓冲区实现
+ */
+static uint32_t prv_RxPeek(yDevUsartRxSpan_t *span)
+{
+    ylib_span_t ring;
+    uint32_t avail;
+
+    avail = ylib_ring_peek_linear(&frame_rx, ylib_ring_count(&frame_rx), &ring, 1);
+    span->data[0] = (const uint8_t *)ring.data[0];
+    span->len[0] = ring.len[0];
+    span->data[1] = (ring.data[1] != NULL) ? (const uint8_t *)ring.data[1] : frame_rx_buffer;
+    span->len[1] = ring.len[1];
+    return avail;
+}
+
+/**
+ * @brief 释放接收环形缓冲区实现
+ */
+static void prv_RxConsume(uint32_t len)
+{
+    ylib_ring_release(&frame_rx, len);
+}
+
+/**
+ * @brief 帧分帧实现
+ */
+static PipeScan_t prv_Scan(uint8_t *data, uint32_t len, PipeBuf_t *msg, uint32_t *used)
+{
+    uint8_t head = data[0]; // 解码失败时开头可能已被改写
+    PipeScan_t scan;
+    uint8_t id;
+    uint16_t crc;
+    uint16_t crc_rx;
+
+    scan = PipeFramerCobs.scan(data, len, msg, used);
+    if (scan == PIPE_SCAN_SKIP)
+    {
+        // 连续的分隔符(帧头分隔符紧跟上一帧帧尾)不是错误
+        if (head != 0)
+        {
+            frame_stats.rx_format++;
+        }
+        return scan;
+    }
+    if (scan != PIPE_SCAN_MSG)
+    {
+        return scan;
+    }
+
+    if ((msg->len < 2U) || (msg->len > (FRAME_PAYLOAD_MAX + 2U)))
+    {
+        frame_stats.rx_format++;
+        return PIPE_SCAN_SKIP;
+    }
+
+    msg->len -= 2U;
+    id = (uint8_t)msg->id;
+    crc = ylib_crc16(prv_Crc16(&id, 1), msg->data, msg->len);
+    crc_rx = (uint16_t)msg->data[msg->len] | ((uint16_t)msg->data[msg->len + 1U] << 8);
+    if (crc != crc_rx)
+    {
+        frame_stats.rx_crc++;
+        return PIPE_SCAN_SKIP;
+    }
+
+    return PIPE_SCAN_MSG;
+}
+
+/**
+ * @brief 帧分发实现
+ */
+static void prv_Dispatch(void *arg, PipeBuf_t *msg)
+{
+    const FrameEntry_t *entry;
+
+    (void)arg;
+    for (entry = &_frame_table_start; entry < &_frame_table_end; entry++)
+    {
+        if (entry->id == msg->id)
+        {
+            frame_stats.rx_frames++;
+            if (entry->handler((uint8_t)msg->id, msg->data, msg->len) < 0)
+            {
+                frame_stats.rx_failed++;
+            }
+            return;
+        }
+    }
+
+    // 没有处理函数的帧不计入延迟统计
+    frame_stats.rx_unknown++;
+    LatencyAbort(msg->lat);
+    msg->lat = 0;
+}
+
+/**
+ * @brief 编码器输入字节实现
+ */
+static void prv_EncodePut(FrameEncoder_t *enc, uint8_t b)
+{
+    if (b != 0)
+    {
+        enc->out[enc->len++] = b;
+        enc->code++;
+        if (enc->code != 0xFF)
+        {
+            return;
+        }
+    }
+
+    // 遇到0x00或数据块达到254字节，回填编码字节并开始新数据块
+    enc->out[enc->code_pos] = enc->code;
+    enc->code_pos = enc->len++;
+    enc->code = 1;
+}
+
+/**
+ * @brief 帧分帧器
+ */
+static const PipeFramer_t frame_framer = {"frame", prv_Scan};
+
+/**
+ * @brief 帧分发表，校验通过的帧都交给frameTable分发
+ */
+static const PipeRoute_t frame_routes[] = {
+    {PIPE_ID_ANY, prv_Dispatch, NULL},
+};
+
+/**
+ * @brief 接收环形缓冲区数据源
+ */
+static const PipeSource_t frame_rx_source = {prv_RxPeek, prv_RxConsume};
+
+/**
+ * @brief 通信串口数据源
+ */
+static const PipeSource_t frame_uart_source = {MessagePeek, MessageConsume};
+
+// ==================== 公共API实现 ====================
+
+/**
+ * @brief 帧协议初始化
+ * @retval 无
+ */
+void FrameInit(void)
+{
+    if (!OsLockReady(&frame_lock))
+    {
+        OsLockInit(&frame_lock, "frame");
+    }
+
+    (void)ylib_ring_init(&frame_rx, frame_rx_buffer, FRAME_RX_RING);
+    LatencyAbort(frame_pipe.lat);
+    LatencyAbort(frame_uart_pipe.lat);
+    (void)PipelineInit(&frame_pipe, &frame_rx_source, &frame_framer, frame_routes, 1);
+    (void)PipelineInit(&frame_uart_pipe, &frame_uart_source, &frame_framer, frame_routes, 1);
+    memset(&frame_stats, 0, sizeof(frame_stats));
+}
+
+/**
+ * @brief 解码器输入数据
+ * @param data 接收数据
+ * @param len 数据长度
+ * @retval 无
+ */
+void FrameInput(const uint8_t *data, uint32_t len)
+{
+    uint32_t n;
+
+    while (len != 0)
+    {
+        n = ylib_ring_enqueue_bulk(&frame_rx, data, len, 1);
+        data += n;
+        len -= n;
+
+        while (PipelinePoll(&frame_pipe) != 0)
+        {
+        }
+
+        // 缓冲区满且流水线无法前进(ylib_pbuf耗尽)，丢弃已缓存的数据重新同步
+        if ((n == 0) && (ylib_ring_free_count(&frame_rx) == 0))
+        {
+            ylib_ring_release(&frame_rx, ylib_ring_count(&frame_rx));
+            LatencyAbort(frame_pipe.lat);
+            frame_pipe.lat = 0;
+            frame_stats.rx_format++;
+        }
+    }
+}
+
+/**
+ * @brief 处理通信串口接收数据
+ * @retval uint32_t 处理的字节数
+ */
+uint32_t FramePoll(void)
+{
+    return PipelinePoll(&frame_uart_pipe);
+}
+
+/**
+ * @brief 发送一帧
+ * @param id 帧ID
+ * @param payload 载荷数据
+ * @param len 载荷长度
+ * @retval int32_t 写入字节数，失败返回-1
+ */
+int32_t FrameSend(uint8_t id, const void *payload, uint16_t len)
+{
+    const uint8_t *data = (const uint8_t *)payload;
+    LatId_t lat = LatencyCurrent();
+    FrameEncoder_t enc;
+    uint16_t crc;
+    int32_t ret;
+    uint16_t i;
+
+    if ((len > FRAME_PAYLOAD_MAX) || ((payload == NULL) && (len != 0)))
+    {
+        frame_stats.tx_dropped++;
+        return -1;
+    }
+
+    // 处理函数中发出的第一帧是应答，处理阶段到此结束
+    LatencyStamp(lat, LAT_STAGE_HANDLE);
+    crc = ylib_crc16(ylib_crc16(YLIB_CRC16_INIT, &id, 1), data, len);
+
+    prv_Lock();
+
+    // 帧头分隔符，接收端丢字节后从这里重新同步
+    frame_tx_buffer[0] = 0;
+    enc.out = frame_tx_buffer;
+    enc.code_pos = 1;
+    enc.len = 2;
+    enc.code = 1;
+
+    prv_EncodePut(&enc, id);
+    for (i = 0; i < len; i++)
+    {
+        prv_EncodePut(&enc, data[i]);
+    }
+    prv_EncodePut(&enc, (uint8_t)(crc & 0xFF));
+    prv_EncodePut(&enc, (uint8_t)(crc >> 8));
+
+    frame_tx_buffer[enc.code_pos] = enc.code;
+    frame_tx_buffer[enc.len++] = 0;
+
+    ret = MessageWrite(frame_tx_buffer, enc.len);
+    if (ret < (int32_t)enc.len)
+    {
+        frame_stats.tx_dropped++;
+        ret = -1;
+    }
+    else
+    {
+        frame_stats.tx_frames++;
+        LatencyStamp(lat, LAT_STAGE_TX);
+    }
+
+    prv_Unlock();
+
+    return ret;
+}
+
+/**
+ * @brief 发送一帧，发送队列满时等待后重试
+ * @param id 帧ID
+ * @param payload 载荷数据
+ * @param len 载荷长度
+ * @param retries 最多尝试次数
+ * @return int32_t 写入发送队列的字节数，全部失败返回负数
+ */
+int32_t FrameSendRetry(uint8_t id, const void *payload, uint16_t len, uint32_t retries)
+{
+    int32_t ret = -1;
+    uint32_t retry;
+
+    for (retry = 0; retry < retries; retry++)
+    {
+        ret = FrameSend(id, payload, len);
+        if (ret >= 0)
+        {
+            break;
+        }
+        vTaskDelay(1);
+    }
+    return ret;
+}
+
+/**
+ * @brief 读取统计信息
+ * @param stats 输出的统计信息
+ * @retval 无
+ */
+void FrameStatsGet(FrameStats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = frame_stats;
+    }
+}
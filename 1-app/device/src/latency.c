@@ -0,0 +1,334 @@
+/**
+ * @file latency.c
+ * @brief 请求端到端延迟跟踪模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 上下文放在固定大小的表中，编号由表项序号和代数组成，表项复用后旧编号自动失效；
+ * 打时间戳只写上下文自己的字段，分配、释放和计入直方图在短临界区内完成；
+ * 当前请求保存在任务的线程本地存储指针(LATENCY_TLS_INDEX)中，多个任务同时分发互不影响
+ *
+ * @par 主要特性:
+ * - 时间戳取yDrvGetTimeUs，直方图按2的幂分桶，计入时只有一次前导零计数
+ * - latency命令按阶段列出次数、平均、分位数和最大值，分位数取所在桶的上界
+ */
+#include <stdint.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "yDrv_basic.h"
+#include "shell.h"
+#include "latency.h"
+
+// ==================== 宏定义 ====================
+
+#define LAT_SLOT_BITS (3U)                          /*!< 编号中表项序号的位数 */
+#define LAT_SLOT_MASK ((1U << LAT_SLOT_BITS) - 1U)  /*!< 表项序号掩码 */
+#define LAT_GEN_MAX (0xFFFFU >> LAT_SLOT_BITS)      /*!< 最大代数 */
+
+#if (LATENCY_CTX_MAX < 1) || (LATENCY_CTX_MAX > (1 << LAT_SLOT_BITS))
+#error "LATENCY_CTX_MAX must be 1..8"
+#endif
+
+#if (configNUM_THREAD_LOCAL_STORAGE_POINTERS <= LATENCY_TLS_INDEX)
+#error "LATENCY_TLS_INDEX needs a thread local storage pointer"
+#endif
+
+// ==================== 类型定义 ====================
+
+/**
+ * @brief 请求上下文
+ */
+typedef struct
+{
+    uint32_t start;                  /*!< 请求起点 */
+    uint32_t stamp[LAT_STAGE_COUNT]; /*!< 各阶段时间戳 */
+    uint16_t gen;                    /*!< 代数，0表示空闲 */
+    uint8_t mask;                    /*!< 已打时间戳的阶段 */
+} LatCtx_t;
+
+// ==================== 静态变量定义 ====================
+
+static LatCtx_t lat_ctx[LATENCY_CTX_MAX];            /*!< 上下文表 */
+static uint16_t lat_gen = 0;                         /*!< 上次分配的代数 */
+static LatHist_t lat_hist[LAT_STAGE_COUNT + 1];      /*!< 各阶段和总耗时的直方图 */
+
+/**
+ * @brief 阶段名，最后一项为总耗时
+ */
+static const char *const lat_names[LAT_STAGE_COUNT + 1] = {
+    "rx", "parse", "flash", "handle", "tx", "total",
+};
+
+// ==================== 静态函数 ====================
+
+/**
+ * @brief 由编号找到上下文
+ * @param id 上下文编号
+ * @retval LatCtx_t* 上下文，编号无效或已结束时为NULL
+ */
+static LatCtx_t *prv_Find(LatId_t id)
+{
+    LatCtx_t *ctx;
+
+    if ((id == 0) || ((id & LAT_SLOT_MASK) >= LATENCY_CTX_MAX))
+    {
+        return NULL;
+    }
+    ctx = &lat_ctx[id & LAT_SLOT_MASK];
+    return (ctx->gen == (id >> LAT_SLOT_BITS)) ? ctx : NULL;
+}
+
+/**
+ * @brief 计入直方图
+ * @note 在临界区内调用
+ */
+static void prv_Record(LatHist_t *hist, uint32_t us)
+{
+    uint32_t bucket = (us < 2U) ? 0U : (31U - (uint32_t)__builtin_clz(us));
+
+    if (bucket >= LATENCY_BUCKETS)
+    {
+        bucket = LATENCY_BUCKETS - 1U;
+    }
+    hist->bucket[bucket]++;
+    hist->count++;
+    hist->sum += us;
+    if (us > hist->max)
+    {
+        hist->max = us;
+    }
+}
+
+/**
+ * @brief 由直方图估计分位数
+ * @param hist 直方图
+ * @param permille 千分位
+ * @retval uint32_t 所在桶的上界(us)，不超过最大值
+ */
+static uint32_t prv_Percentile(const LatHist_t *hist, uint32_t permille)
+{
+    uint32_t target = (uint32_t)(((uint64_t)hist->count * permille + 999U) / 1000U);
+    uint32_t seen = 0;
+    uint32_t bound;
+    uint32_t i;
+
+    for (i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        seen += hist->bucket[i];
+        if ((seen >= target) && (seen != 0))
+        {
+            bound = (i + 1U < LATENCY_BUCKETS) ? ((2U << i) - 1U) : hist->max;
+            return (bound < hist->max) ? bound : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+// ==================== 公共API实现 ====================
+
+/**
+ * @brief 开始跟踪一条请求
+ */
+LatId_t LatencyBegin(void)
+{
+    uint32_t now = yDrvGetTimeUs();
+    LatId_t id = 0;
+    uint32_t i;
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < LATENCY_CTX_MAX; i++)
+    {
+        if (lat_ctx[i].gen == 0)
+        {
+            if (++lat_gen > LAT_GEN_MAX)
+            {
+                lat_gen = 1;
+            }
+            lat_ctx[i].gen = lat_gen;
+            lat_ctx[i].mask = 0;
+            lat_ctx[i].start = now;
+            id = (LatId_t)((lat_gen << LAT_SLOT_BITS) | i);
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return id;
+}
+
+/**
+ * @brief 打时间戳
+ */
+void LatencyStamp(LatId_t id, LatStage_t stage)
+{
+    LatCtx_t *ctx = prv_Find(id);
+
+    if ((ctx == NULL) || ((uint32_t)stage >= LAT_STAGE_COUNT) || ((ctx->mask & (1U << stage)) != 0))
+    {
+        return;
+    }
+    ctx->stamp[stage] = yDrvGetTimeUs();
+    ctx->mask |= (uint8_t)(1U << stage);
+}
+
+/**
+ * @brief 结束请求并计入直方图
+ */
+void LatencyEnd(LatId_t id)
+{
+    LatCtx_t *ctx;
+    uint32_t prev;
+    uint32_t i;
+
+    taskENTER_CRITICAL();
+    ctx = prv_Find(id);
+    if (ctx != NULL)
+    {
+        prev = ctx->start;
+        for (i = 0; i < LAT_STAGE_COUNT; i++)
+        {
+            if ((ctx->mask & (1U << i)) != 0)
+            {
+                prv_Record(&lat_hist[i], ctx->stamp[i] - prev);
+                prev = ctx->stamp[i];
+            }
+        }
+        if (ctx->mask != 0)
+        {
+            prv_Record(&lat_hist[LAT_STAGE_COUNT], prev - ctx->start);
+        }
+        ctx->gen = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 放弃请求
+ */
+void LatencyAbort(LatId_t id)
+{
+    LatCtx_t *ctx;
+
+    taskENTER_CRITICAL();
+    ctx = prv_Find(id);
+    if (ctx != NULL)
+    {
+        ctx->gen = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 登记当前请求
+ */
+void LatencySetCurrent(LatId_t id)
+{
+    vTaskSetThreadLocalStoragePointer(NULL, LATENCY_TLS_INDEX, (void *)(uintptr_t)id);
+}
+
+/**
+ * @brief 取得当前请求
+ */
+LatId_t LatencyCurrent(void)
+{
+    return (LatId_t)(uintptr_t)pvTaskGetThreadLocalStoragePointer(NULL, LATENCY_TLS_INDEX);
+}
+
+/**
+ * @brief 为当前请求打时间戳
+ */
+void LatencyMark(LatStage_t stage)
+{
+    LatencyStamp(LatencyCurrent(), stage);
+}
+
+/**
+ * @brief 读取直方图
+ */
+void LatencyGet(uint32_t stage, LatHist_t *hist)
+{
+    if ((stage > LAT_STAGE_COUNT) || (hist == NULL))
+    {
+        return;
+    }
+    taskENTER_CRITICAL();
+    *hist = lat_hist[stage];
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 清零全部直方图
+ */
+void LatencyReset(void)
+{
+    taskENTER_CRITICAL();
+    memset(lat_hist, 0, sizeof(lat_hist));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 延迟统计shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
+ */
+static int LatencyCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    LatHist_t hist;
+    uint32_t i;
+    uint32_t j;
+
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0))
+    {
+        LatencyReset();
+        return 0;
+    }
+
+    // 指定阶段时列出直方图
+    if (argc > 1)
+    {
+        for (i = 0; i <= LAT_STAGE_COUNT; i++)
+        {
+            if (strcmp(argv[1], lat_names[i]) == 0)
+            {
+                break;
+            }
+        }
+        if (i > LAT_STAGE_COUNT)
+        {
+            shellPrint(shell, "unknown stage: %s\r\n", argv[1]);
+            return 0;
+        }
+        LatencyGet(i, &hist);
+        for (j = 0; j < LATENCY_BUCKETS; j++)
+        {
+            if (hist.bucket[j] != 0)
+            {
+                shellPrint(shell, "%8lu%s us: %lu\r\n", (unsigned long)((j == 0) ? 0U : (1UL << j)),
+                           (j + 1U < LATENCY_BUCKETS) ? "" : "+", (unsigned long)hist.bucket[j]);
+            }
+        }
+        return 0;
+    }
+
+    shellPrint(shell, "stage       count      avg      p50      p90      p99      max (us)\r\n");
+    for (i = 0; i <= LAT_STAGE_COUNT; i++)
+    {
+        LatencyGet(i, &hist);
+        shellPrint(shell, "%-8s %8lu %8lu %8lu %8lu %8lu %8lu\r\n", lat_names[i],
+                   (unsigned long)hist.count,
+                   (unsigned long)((hist.count != 0) ? (hist.sum / hist.count) : 0U),
+                   (unsigned long)prv_Percentile(&hist, 500U),
+                   (unsigned long)prv_Percentile(&hist, 900U),
+                   (unsigned long)prv_Percentile(&hist, 990U),
+                   (unsigned long)hist.max);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 latency, LatencyCmd, request latency by stage [reset|stage]);
@@ -0,0 +1,417 @@
+/**
+ * @file lin.c
+ * @brief LIN主机调度表模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * TIM15更新中断结束上一帧、写入下一时隙的长度并发出本帧；USART2的接收超时中断结束本帧。
+ * 接收DMA每帧从缓冲区开头写起，结束时按已写入的字节数解码，不逐字节进中断
+ */
+
+// ==================== 包含文件 ====================
+#include "lin.h"
+#include "board.h"
+#include "yDrv_basic.h"
+#include "yDrv_clock.h"
+#include "yDrv_dma.h"
+#include "yDrv_usart.h"
+#include "yLib_pbuf.h"
+#include "yLib_trace.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32g0xx_ll_bus.h"
+#include "stm32g0xx_ll_tim.h"
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define LIN_TIM_HZ 10000U                     /**< 时隙定时器计数频率 */
+#define LIN_TICKS_PER_MS (LIN_TIM_HZ / 1000U) /**< 每毫秒的计数 */
+#define LIN_SYNC 0x55U                        /**< 同步字节 */
+#define LIN_ID_CLASSIC 0x3CU                  /**< 从此ID起为诊断帧，总是经典校验和 */
+#define LIN_TX_MAX (2U + LIN_DATA_MAX + 1U)   /**< 同步、PID、数据和校验和 */
+#define LIN_RX_SIZE 16U                       /**< 接收缓冲区，断开符和发送的全部字节都会回读 */
+
+_Static_assert((uint32_t)LIN_SLOT_MS_MAX * LIN_TICKS_PER_MS <= 0x10000U, "LIN slot exceeds the 16-bit TIM15 period");
+
+// ==================== 私有变量 ====================
+
+static yDrvUsartHandle_t lin_usart; /**< USART2，LIN模式 */
+static yDrvDmaHandle_t lin_rx_dma;  /**< 接收DMA，每帧重新装载 */
+static const LinSlot_t *lin_table;  /**< 调度表 */
+static uint32_t lin_count;          /**< 调度表项数 */
+static uint32_t lin_cur;            /**< 正在进行的帧在表中的序号 */
+static uint32_t lin_next;           /**< 下一时隙的序号 */
+static uint8_t lin_tx[LIN_TX_MAX];  /**< 本帧要发送的字节 */
+static uint8_t lin_tx_len;          /**< 本帧字节数 */
+static uint8_t lin_tx_pos;          /**< 已写入FIFO的字节数 */
+static uint8_t lin_rx[LIN_RX_SIZE]; /**< 回读和应答 */
+static volatile uint8_t lin_active; /**< 帧已发出，等待接收超时 */
+static uint8_t lin_running;         /**< 调度正在运行 */
+static uint8_t lin_ready;           /**< 硬件已初始化 */
+static LinStats_t lin_stats;        /**< 运行统计 */
+
+static yDrvStatus_t lin_clock_notify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg);
+
+/**
+ * @brief 系统时钟切换后重算时隙定时器的预分频
+ */
+static yDrvClockNotifier_t lin_clock_notifier = {.callback = lin_clock_notify};
+
+MSGBUS_TOPIC_DEFINE(lin);
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 时钟切换通知
+ * @note 预分频值在下一个更新事件生效，切换时正在进行的时隙按新时钟和旧分频走完
+ */
+static yDrvStatus_t lin_clock_notify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg)
+{
+    (void)oldHz;
+    (void)arg;
+
+    if (event == YDRV_CLOCK_POST)
+        LL_TIM_SetPrescaler(TIM15, newHz / LIN_TIM_HZ - 1U);
+    return YDRV_OK;
+}
+
+/**
+ * @brief 校验和的起始值
+ * @return 增强型校验和为PID，经典校验和为0
+ */
+static uint8_t lin_seed(const LinSlot_t *slot)
+{
+    return (slot->classic || (slot->id >= LIN_ID_CLASSIC)) ? 0U : LinPid(slot->id);
+}
+
+/**
+ * @brief 把待发送字节写入发送FIFO
+ * @note FIFO满时打开阈值中断，在中断中继续写入
+ */
+static void lin_fill(void)
+{
+    USART_TypeDef *usart = lin_usart.instance;
+
+    while ((lin_tx_pos < lin_tx_len) && LL_USART_IsActiveFlag_TXE_TXFNF(usart))
+        LL_USART_TransmitData8(usart, lin_tx[lin_tx_pos++]);
+    if (lin_tx_pos < lin_tx_len)
+        LL_USART_EnableIT_TXFT(usart);
+    else
+        LL_USART_DisableIT_TXFT(usart);
+}
+
+/**
+ * @brief 发送FIFO阈值中断
+ */
+static void lin_txft(void *arg)
+{
+    (void)arg;
+    lin_fill();
+}
+
+/**
+ * @brief 发出一帧
+ * @param slot 调度表项
+ */
+static void lin_begin(const LinSlot_t *slot)
+{
+    USART_TypeDef *usart = lin_usart.instance;
+
+    // 接收从缓冲区开头写起，丢弃上一帧之后线路上的杂散字节和残留的错误、超时标志
+    yDrvDmaTransDisable(&lin_rx_dma);
+    LL_USART_RequestRxDataFlush(usart);
+    LL_USART_ClearFlag_FE(usart);
+    LL_USART_ClearFlag_NE(usart);
+    LL_USART_ClearFlag_ORE(usart);
+    LL_USART_ClearFlag_RTO(usart);
+    yDrvDmaDstBufferLen(&lin_rx_dma, sizeof(lin_rx));
+    yDrvDmaClearFlags(&lin_rx_dma);
+    yDrvDmaTransEnable(&lin_rx_dma);
+
+    lin_tx[0] = LIN_SYNC;
+    lin_tx[1] = LinPid(slot->id);
+    lin_tx_len = 2U;
+    if (slot->dir == LIN_DIR_PUBLISH)
+    {
+        memcpy(&lin_tx[2], slot->data, slot->len);
+        lin_tx[2U + slot->len] = LinChecksum(lin_seed(slot), &lin_tx[2], slot->len);
+        lin_tx_len += slot->len + 1U;
+    }
+    lin_tx_pos = 0;
+
+    // 断开符发完之前FIFO中的字节不会发出，同步字节和之后的数据可以一起写入
+    yDrvUsartSendLinBreak(&lin_usart);
+    lin_fill();
+    lin_active = 1;
+    lin_stats.frames++;
+}
+
+/**
+ * @brief 解码回读和应答
+ * @param slot 调度表项
+ * @param n 接收DMA写入的字节数
+ * @param frame 输出数据
+ * @return LinStatus_t
+ */
+static uint8_t lin_decode(const LinSlot_t *slot, uint32_t n, LinFrame_t *frame)
+{
+    const uint8_t *resp;
+    uint32_t got;
+    uint32_t i;
+
+    // 断开符按帧错误收为0x00，有的收发器不回读，同步字节只在前两个字节中找，不与数据混淆
+    for (i = 0; (i < 2U) && (i + 1U < n); i++)
+    {
+        if ((lin_rx[i] == LIN_SYNC) && (lin_rx[i + 1U] == lin_tx[1]))
+            break;
+    }
+    if ((i >= 2U) || (i + 1U >= n))
+        return LIN_STATUS_READBACK;
+    resp = &lin_rx[i + 2U];
+    got = n - i - 2U;
+
+    if (slot->dir == LIN_DIR_PUBLISH)
+    {
+        frame->len = slot->len;
+        memcpy(frame->data, &lin_tx[2], slot->len);
+        if ((got < slot->len + 1U) || (memcmp(resp, &lin_tx[2], slot->len + 1U) != 0))
+            return LIN_STATUS_READBACK;
+        return LIN_STATUS_OK;
+    }
+
+    if (got == 0)
+        return LIN_STATUS_NO_RESPONSE;
+    frame->len = (uint8_t)((got < slot->len) ? got : slot->len);
+    memcpy(frame->data, resp, frame->len);
+    if (got < slot->len + 1U)
+        return LIN_STATUS_INCOMPLETE;
+    if (LinChecksum(lin_seed(slot), resp, slot->len) != resp[slot->len])
+        return LIN_STATUS_CHECKSUM;
+    return LIN_STATUS_OK;
+}
+
+/**
+ * @brief 结束正在进行的帧，解码并发布
+ */
+static void lin_end(void)
+{
+    const LinSlot_t *slot = &lin_table[lin_cur];
+    LinFrame_t frame;
+
+    lin_active = 0;
+    LL_USART_DisableIT_TXFT(lin_usart.instance);
+
+    memset(&frame, 0, sizeof(frame));
+    frame.id = slot->id;
+    frame.slot = (uint8_t)lin_cur;
+    frame.status = lin_decode(slot, sizeof(lin_rx) - yDrvDmaCurLenGet(&lin_rx_dma), &frame);
+    lin_stats.status[frame.status]++;
+
+    // 主机发布的数据订阅方已知道，只报告失败
+    if ((slot->dir == LIN_DIR_SUBSCRIBE) || (frame.status != LIN_STATUS_OK))
+        (void)MsgBusPublish(MSGBUS_TOPIC(lin), &frame, sizeof(frame));
+}
+
+/**
+ * @brief 接收超时中断，线路空闲即本帧结束
+ */
+static void lin_rto(void *arg)
+{
+    (void)arg;
+    if (lin_active)
+        lin_end();
+}
+
+// ==================== 中断处理 ====================
+
+/**
+ * @brief TIM15中断入口，每个时隙开始时进入一次
+ */
+void TIM15_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    if (!LL_TIM_IsActiveFlag_UPDATE(TIM15))
+        return;
+    LL_TIM_ClearFlag_UPDATE(TIM15);
+
+    // 上一帧没有等到接收超时：时隙短于帧长或接收端没有回读，按已收到的字节解码
+    if (lin_active)
+    {
+        lin_stats.late++;
+        lin_end();
+    }
+
+    // 预装载值在下一个更新事件生效，即下一时隙的长度
+    lin_cur = lin_next;
+    lin_next = (lin_next + 1U < lin_count) ? (lin_next + 1U) : 0U;
+    LL_TIM_SetAutoReload(TIM15, (uint32_t)lin_table[lin_next].slot_ms * LIN_TICKS_PER_MS - 1U);
+    lin_begin(&lin_table[lin_cur]);
+}
+
+// ==================== 公共函数 ====================
+
+uint8_t LinPid(uint8_t id)
+{
+    uint32_t p0;
+    uint32_t p1;
+
+    id &= LIN_ID_MAX;
+    p0 = (id ^ (id >> 1) ^ (id >> 2) ^ (id >> 4)) & 1U;
+    p1 = ~((id >> 1) ^ (id >> 3) ^ (id >> 4) ^ (id >> 5)) & 1U;
+    return (uint8_t)(id | (p0 << 6) | (p1 << 7));
+}
+
+uint8_t LinChecksum(uint8_t pid, const uint8_t *data, uint32_t len)
+{
+    uint32_t sum = pid;
+    uint32_t i;
+
+    // 带进位累加：超过255时减去255
+    for (i = 0; i < len; i++)
+    {
+        sum += data[i];
+        if (sum > 0xFFU)
+            sum -= 0xFFU;
+    }
+    return (uint8_t)~sum;
+}
+
+int32_t LinInit(void)
+{
+    yDrvUsartConfig_t config = YDRV_USART_CONFIG_DEFAULT();
+    yDrvDmaConfig_t dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    yDrvUsartExtiConfig_t exti = YDRV_USART_EXTI_CONFIG_DEFAULT();
+    LL_TIM_InitTypeDef init = {0};
+    yDrvDmaChannel_t channel;
+
+    if (lin_ready)
+        return 0;
+
+    // 长载荷在中断中发布，pbuf内存池须先在任务中创建
+    if (ylib_pbuf_init() != 0)
+        return -1;
+
+    // 发送FIFO半空时补写，接收超时标记帧结束
+    config.usartId = BOARD_LIN0_PERIPH;
+    config.txPin = BOARD_LIN0_TX_PIN;
+    config.txAF = BOARD_LIN0_TX_AF;
+    config.rxPin = BOARD_LIN0_RX_PIN;
+    config.rxAF = BOARD_LIN0_RX_AF;
+    config.baudRate = LIN_BAUDRATE;
+    config.mode = YDRV_USART_MODE_LIN;
+    config.fifoEnable = 1;
+    config.txFifoThreshold = YDRV_USART_FIFO_TH_1_2;
+    config.rxTimeout = LIN_RX_TIMEOUT_BITS;
+    if (yDrvUsartInitStatic(&config, &lin_usart) != YDRV_OK)
+        return -1;
+
+    dma_config.channel = BOARD_LIN0_RX_DMA;
+    dma_config.priority = YDRV_DMA_PRIORITY_LOW;
+    dma_config.dst_buffer = lin_rx;
+    dma_config.trans_len = sizeof(lin_rx);
+    dma_config.owner = "lin rx";
+    if (yDrvDmaInitStatic(&dma_config, &lin_rx_dma, YDRV_DMA_DIR_P2M) != YDRV_OK)
+        return -1;
+    channel = lin_rx_dma.index;
+    if (yDrvUsartDmaRead(&lin_usart, &channel) != YDRV_OK)
+        return -1;
+
+    exti.prio = YDRV_IRQ_PRIO_LIN;
+    exti.enable = 1;
+    exti.trigger = YDRV_USART_EXTI_RTO;
+    exti.function = lin_rto;
+    if (yDrvUsartRegisterCallback(&lin_usart, &exti) != YDRV_OK)
+        return -1;
+    exti.trigger = YDRV_USART_EXTI_TXFT;
+    exti.function = lin_txft;
+    if (yDrvUsartRegisterCallback(&lin_usart, &exti) != YDRV_OK)
+        return -1;
+    LL_USART_DisableIT_TXFT(lin_usart.instance);
+
+    // 时隙定时器，APB不分频时定时器时钟等于SystemCoreClock
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM15);
+    init.Prescaler = (uint16_t)(SystemCoreClock / LIN_TIM_HZ - 1U);
+    init.CounterMode = LL_TIM_COUNTERMODE_UP;
+    init.Autoreload = LIN_TICKS_PER_MS - 1U;
+    init.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1;
+    LL_TIM_Init(TIM15, &init);
+    LL_TIM_EnableARRPreload(TIM15);
+    LL_TIM_ClearFlag_UPDATE(TIM15);
+    yDrvIrqSetPriority(TIM15_IRQn, YDRV_IRQ_PRIO_LIN);
+    NVIC_EnableIRQ(TIM15_IRQn);
+    yDrvClockRegister(&lin_clock_notifier);
+
+    lin_ready = 1;
+    return 0;
+}
+
+int32_t LinStart(const LinSlot_t *table, uint32_t count)
+{
+    uint32_t i;
+
+    if (!lin_ready || (table == NULL) || (count == 0) || (count > 0xFFU))
+        return -1;
+    for (i = 0; i < count; i++)
+    {
+        if ((table[i].id > LIN_ID_MAX) || (table[i].len == 0) || (table[i].len > LIN_DATA_MAX) ||
+            (table[i].slot_ms == 0) || (table[i].slot_ms > LIN_SLOT_MS_MAX))
+            return -1;
+        if ((table[i].dir != LIN_DIR_SUBSCRIBE) &&
+            ((table[i].dir != LIN_DIR_PUBLISH) || (table[i].data == NULL)))
+            return -1;
+    }
+
+    LinStop();
+    lin_table = table;
+    lin_count = count;
+    return LinResume();
+}
+
+int32_t LinResume(void)
+{
+    if (!lin_ready || (lin_table == NULL))
+        return -1;
+
+    LinStop();
+    lin_next = 0;
+
+    // 更新事件装入第一项的时隙长度并置更新标志，打开中断后立即发出第一帧
+    LL_TIM_SetAutoReload(TIM15, (uint32_t)lin_table[0].slot_ms * LIN_TICKS_PER_MS - 1U);
+    LL_TIM_GenerateEvent_UPDATE(TIM15);
+    lin_running = 1;
+    LL_TIM_EnableIT_UPDATE(TIM15);
+    LL_TIM_EnableCounter(TIM15);
+    return 0;
+}
+
+void LinStop(void)
+{
+    if (!lin_ready)
+        return;
+
+    LL_TIM_DisableIT_UPDATE(TIM15);
+    LL_TIM_DisableCounter(TIM15);
+    LL_TIM_ClearFlag_UPDATE(TIM15);
+    NVIC_ClearPendingIRQ(TIM15_IRQn);
+
+    // 任务上下文与接收超时中断都会改写CR3，关中断后放弃正在进行的帧
+    taskENTER_CRITICAL();
+    lin_active = 0;
+    LL_USART_DisableIT_TXFT(lin_usart.instance);
+    taskEXIT_CRITICAL();
+    lin_running = 0;
+}
+
+void LinGetStats(LinStats_t *stats)
+{
+    *stats = lin_stats;
+    stats->count = (uint16_t)lin_count;
+    stats->running = lin_running;
+}
+
+void LinResetStats(void)
+{
+    memset(&lin_stats, 0, sizeof(lin_stats));
+}
@@ -0,0 +1,395 @@
+/**
+ * @file msgbus.c
+ * @brief 任务间发布/订阅消息总线实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 发布方在自己的上下文中把消息描述直接写入各队列订阅者的队列，有回调订阅者时
+ * 再写一份到总线任务的队列，由总线任务依次回调
+ *
+ * @par 并发:
+ * - 订阅链表的修改在临界区内完成，每次只改一个指针，中断中的发布看到的总是完整链表
+ * - 任务中的发布在调度器挂起期间遍历链表，队列写入不等待；取消订阅的任务不会在遍历中途运行
+ * - 总线任务持有互斥锁回调，取消订阅等待本轮回调结束，返回后不会再被回调
+ */
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "os_lock.h"
+#include "os_static.h"
+#include "yDev.h"
+#include "msgbus.h"
+
+// ==================== 宏定义 ====================
+#define MSGBUS_TASK_PRIO 24     /**< 高于应用任务，低于中断下半部工作任务 */
+#define MSGBUS_STK_SIZE 256     /**< 回调在总线任务堆栈上运行 */
+
+// ==================== 静态变量定义 ====================
+
+/**
+ * @brief msgbusTopic链接段起止地址
+ * @note 由链接脚本定义
+ */
+extern const MsgBusTopic_t _msgbus_topic_start;
+extern const MsgBusTopic_t _msgbus_topic_end;
+
+OS_TASK_DEFINE(msgbus_task, MSGBUS_STK_SIZE);
+OS_QUEUE_DEFINE(msgbus_queue, MsgBusMsg_t, MSGBUS_QUEUE_LEN);
+OS_LOCK_DEFINE(msgbus_lock);
+
+static QueueHandle_t msgbus_queue;
+
+// ==================== 静态函数 ====================
+
+/**
+ * @brief 把一份消息描述写入队列
+ * @param queue 队列
+ * @param msg 消息
+ * @param woken 中断中发布时的切换标志，任务中为NULL
+ * @return int32_t 1写入，0队列满
+ * @note 写入成功时队列持有一个pbuf引用
+ */
+static int32_t msgbus_post(QueueHandle_t queue, const MsgBusMsg_t *msg, BaseType_t *woken)
+{
+    BaseType_t ret;
+
+    if (msg->pbuf != NULL)
+    {
+        ylib_pbuf_ref(msg->pbuf);
+    }
+
+    ret = (woken != NULL) ? xQueueSendFromISR(queue, msg, woken) : xQueueSend(queue, msg, 0);
+    if (ret != pdPASS)
+    {
+        if (msg->pbuf != NULL)
+        {
+            (void)ylib_pbuf_free(msg->pbuf);
+        }
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 投递给全部订阅者
+ * @param msg 消息，pbuf的引用由调用者保留
+ * @return int32_t 投递数，回调订阅者合计为1
+ */
+static int32_t msgbus_deliver(const MsgBusMsg_t *msg)
+{
+    MsgBusTopicState_t *state = msg->topic->state;
+    MsgBusSub_t *sub;
+    BaseType_t woken = pdFALSE;
+    BaseType_t *isr = NULL;
+    int32_t count = 0;
+
+    if (xPortIsInsideInterrupt())
+    {
+        isr = &woken;
+    }
+    else
+    {
+        vTaskSuspendAll();
+    }
+
+    state->published++;
+    for (sub = state->subs; sub != NULL; sub = sub->next)
+    {
+        if (sub->queue == NULL)
+        {
+            continue;
+        }
+        if (msgbus_post(sub->queue, msg, isr))
+        {
+            count++;
+        }
+        else
+        {
+            sub->dropped++;
+            state->dropped++;
+        }
+    }
+
+    if ((state->callbacks != 0U) && (msgbus_queue != NULL))
+    {
+        if (msgbus_post(msgbus_queue, msg, isr))
+        {
+            count++;
+        }
+        else
+        {
+            state->dropped++;
+        }
+    }
+    state->delivered += (uint32_t)count;
+
+    if (isr != NULL)
+    {
+        portYIELD_FROM_ISR(woken);
+    }
+    else
+    {
+        (void)xTaskResumeAll();
+    }
+
+    return count;
+}
+
+/**
+ * @brief 加入订阅链表
+ * @note 已在链表中的订阅者不修改，返回-1
+ */
+static int32_t msgbus_subscribe(const MsgBusTopic_t *topic, MsgBusSub_t *sub, QueueHandle_t queue,
+                                MsgBusCallback_t callback, void *arg)
+{
+    MsgBusTopicState_t *state = topic->state;
+    MsgBusSub_t *node;
+
+    if (OsLockReady(&msgbus_lock))
+    {
+        (void)OsLockTake(&msgbus_lock, portMAX_DELAY);
+    }
+
+    for (node = state->subs; node != NULL; node = node->next)
+    {
+        if (node == sub)
+        {
+            break;
+        }
+    }
+
+    if (node == NULL)
+    {
+        // 先填好next再挂到表头，中断中的遍历不会看到半个节点
+        sub->next = state->subs;
+        sub->queue = queue;
+        sub->callback = callback;
+        sub->arg = arg;
+        sub->dropped = 0;
+        taskENTER_CRITICAL();
+        state->subs = sub;
+        state->count++;
+        if (queue == NULL)
+        {
+            state->callbacks++;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if (OsLockReady(&msgbus_lock))
+    {
+        OsLockGive(&msgbus_lock);
+    }
+
+    return (node == NULL) ? 0 : -1;
+}
+
+/**
+ * @brief 总线任务，依次回调
+ */
+static void msgbus_task_entry(void *pvParameters)
+{
+    MsgBusMsg_t msg;
+    MsgBusSub_t *sub;
+
+    (void)pvParameters;
+
+    for (;;)
+    {
+        if (xQueueReceive(msgbus_queue, &msg, portMAX_DELAY) != pdPASS)
+        {
+            continue;
+        }
+
+        (void)OsLockTake(&msgbus_lock, portMAX_DELAY);
+        for (sub = msg.topic->state->subs; sub != NULL; sub = sub->next)
+        {
+            if (sub->queue == NULL)
+            {
+                sub->callback(sub->arg, &msg);
+            }
+        }
+        OsLockGive(&msgbus_lock);
+
+        MsgBusRelease(&msg);
+    }
+}
+
+// ==================== 公共函数 ====================
+
+void MsgBusInit(void)
+{
+    if (msgbus_queue != NULL)
+    {
+        return;
+    }
+
+    OsLockInit(&msgbus_lock, "msgbus");
+    msgbus_queue = OS_QUEUE_CREATE(msgbus_queue);
+    (void)OS_TASK_CREATE(msgbus_task, msgbus_task_entry, "MsgBus", NULL, MSGBUS_TASK_PRIO);
+}
+
+int32_t MsgBusSubscribeQueue(const MsgBusTopic_t *topic, MsgBusSub_t *sub, QueueHandle_t queue)
+{
+    if ((topic == NULL) || (sub == NULL) || (queue == NULL))
+    {
+        return -1;
+    }
+
+    return msgbus_subscribe(topic, sub, queue, NULL, NULL);
+}
+
+int32_t MsgBusSubscribeCallback(const MsgBusTopic_t *topic, MsgBusSub_t *sub,
+                                MsgBusCallback_t callback, void *arg)
+{
+    if ((topic == NULL) || (sub == NULL) || (callback == NULL))
+    {
+        return -1;
+    }
+
+    return msgbus_subscribe(topic, sub, NULL, callback, arg);
+}
+
+void MsgBusUnsubscribe(const MsgBusTopic_t *topic, MsgBusSub_t *sub)
+{
+    MsgBusTopicState_t *state;
+    MsgBusSub_t **link;
+
+    if ((topic == NULL) || (sub == NULL))
+    {
+        return;
+    }
+
+    state = topic->state;
+    if (OsLockReady(&msgbus_lock))
+    {
+        (void)OsLockTake(&msgbus_lock, portMAX_DELAY);
+    }
+
+    // 被摘下的节点next不变，正在经过它的遍历仍能走到链表末尾
+    taskENTER_CRITICAL();
+    for (link = &state->subs; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == sub)
+        {
+            *link = sub->next;
+            state->count--;
+            if (sub->queue == NULL)
+            {
+                state->callbacks--;
+            }
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (OsLockReady(&msgbus_lock))
+    {
+        OsLockGive(&msgbus_lock);
+    }
+}
+
+int32_t MsgBusPublish(const MsgBusTopic_t *topic, const void *data, uint32_t len)
+{
+    MsgBusMsg_t msg;
+    int32_t count;
+
+    if ((topic == NULL) || (len > UINT16_MAX) || ((data == NULL) && (len != 0U)))
+    {
+        return -1;
+    }
+
+    msg.topic = topic;
+    msg.pbuf = NULL;
+    msg.time_us = yDevGetTimeUS();
+    msg.len = (uint16_t)len;
+    msg.reserved = 0;
+
+    // 没有订阅者时不分配pbuf
+    if (topic->state->subs == NULL)
+    {
+        topic->state->published++;
+        return 0;
+    }
+
+    if (len <= MSGBUS_INLINE_MAX)
+    {
+        if (len != 0U)
+        {
+            memcpy(msg.data, data, len);
+        }
+        return msgbus_deliver(&msg);
+    }
+
+    msg.pbuf = ylib_pbuf_alloc(0, len);
+    if (msg.pbuf == NULL)
+    {
+        topic->state->published++;
+        topic->state->dropped++;
+        return -1;
+    }
+    memcpy(msg.pbuf->payload, data, len);
+
+    count = msgbus_deliver(&msg);
+    (void)ylib_pbuf_free(msg.pbuf);
+
+    return count;
+}
+
+int32_t MsgBusPublishPbuf(const MsgBusTopic_t *topic, ylib_pbuf_t *p)
+{
+    MsgBusMsg_t msg;
+
+    if ((topic == NULL) || (p == NULL))
+    {
+        return -1;
+    }
+
+    msg.topic = topic;
+    msg.pbuf = p;
+    msg.time_us = yDevGetTimeUS();
+    msg.len = p->tot_len;
+    msg.reserved = 0;
+
+    return msgbus_deliver(&msg);
+}
+
+void MsgBusRelease(MsgBusMsg_t *msg)
+{
+    if ((msg != NULL) && (msg->pbuf != NULL))
+    {
+        (void)ylib_pbuf_free(msg->pbuf);
+        msg->pbuf = NULL;
+    }
+}
+
+const MsgBusTopic_t *MsgBusFind(const char *name)
+{
+    const MsgBusTopic_t *topic;
+
+    if (name == NULL)
+    {
+        return NULL;
+    }
+
+    for (topic = &_msgbus_topic_start; topic < &_msgbus_topic_end; topic++)
+    {
+        if (strcmp(topic->name, name) == 0)
+        {
+            return topic;
+        }
+    }
+
+    return NULL;
+}
+
+const MsgBusTopic_t *MsgBusIterate(uint32_t index)
+{
+    const MsgBusTopic_t *topic = &_msgbus_topic_start + index;
+
+    return (topic < &_msgbus_topic_end) ? topic : NULL;
+}
@@ -0,0 +1,463 @@
+/**
+ * @file mux.c
+ * @brief 串口文本/二进制通道复用模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 接收侧把DMA接收流中的数据搬到暂存环形缓冲区，按0x00分隔符把连续的文本段和帧段
+ * 分别交给shell和帧解码器；发送侧文本分段写入并限制积压，帧由FrameSend直接写入发送队列
+ *
+ * @par 输出期间的接收:
+ * 命令大量输出时shell任务在MuxTextWrite中等待发送队列，不回到MuxPoll；
+ * 等待期间继续把接收流中的数据搬到暂存缓冲区，DMA接收缓冲区不会溢出，命令返回后按顺序分流。
+ * 搬运时只跟踪文本/帧状态识别XON/XOFF，帧不在命令执行期间分发，帧处理函数不会与正在执行的命令嵌套；
+ * 正在分流的数据留在暂存缓冲区中直到处理完，搬运只追加在其后
+ */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "communication.h"
+#include "frame.h"
+#include "mux.h"
+#include "shell.h"
+#include "yLib_ring.h"
+
+// ==================== 类型定义 ====================
+
+/**
+ * @brief 接收分流状态
+ */
+typedef enum
+{
+    MUX_STATE_TEXT = 0, /*!< 文本 */
+    MUX_STATE_FRAME,    /*!< 二进制帧 */
+} MuxState_t;
+
+/**
+ * @brief 单字节分流结果
+ */
+typedef enum
+{
+    MUX_STEP_TEXT = 0, /*!< 文本字节 */
+    MUX_STEP_OPEN,     /*!< 文本中的帧头分隔符，之前的文本应先交付 */
+    MUX_STEP_FRAME,    /*!< 帧内字节 */
+    MUX_STEP_CLOSE,    /*!< 帧尾分隔符，属于当前帧 */
+    MUX_STEP_ABORT,    /*!< 帧过长作废，该字节起按文本处理 */
+} MuxStep_t;
+
+/**
+ * @brief 分流状态机
+ */
+typedef struct
+{
+    MuxState_t state; /*!< 当前分流状态 */
+    uint8_t started;  /*!< 帧状态下已收到非零数据 */
+    uint32_t len;     /*!< 当前帧已收到的字节数 */
+} MuxScan_t;
+
+// ==================== 静态变量定义 ====================
+
+static MuxTextHandler_t mux_text_handler = NULL; /*!< 文本处理函数 */
+static void *mux_text_arg = NULL;                /*!< 文本处理函数参数 */
+static MuxScan_t mux_scan;                       /*!< 分流状态，对应已交付的数据 */
+static MuxScan_t mux_hold_scan;                  /*!< 暂存数据末尾的分流状态，用于识别XON/XOFF */
+static TaskHandle_t mux_owner = NULL;            /*!< 调用MuxPoll的任务，只有它搬运接收数据 */
+static struct ylib_ring mux_hold;                /*!< 已从接收流搬出、尚未分流的数据 */
+static uint8_t mux_hold_buffer[MUX_RX_HOLD];     /*!< 暂存缓冲区 */
+static volatile uint8_t mux_xoff = 0;            /*!< 对端发送了XOFF，文本暂停输出 */
+static TickType_t mux_xoff_tick;                 /*!< 收到XOFF的时刻 */
+static MuxStats_t mux_stats;                     /*!< 统计 */
+
+/**
+ * @brief 各优先级文本暂停写入的发送队列积压
+ */
+static const uint16_t mux_backlog[MUX_PRIO_MAX] = {
+    MUX_TEXT_BACKLOG_LOW, /*!< 后台文本先让出发送队列 */
+    MUX_TEXT_BACKLOG,     /*!< 命令输出 */
+};
+
+// ==================== 静态函数声明 ====================
+
+/**
+ * @brief 分流状态机处理一个字节
+ * @param scan 状态机
+ * @param b 接收字节
+ * @retval MuxStep_t 该字节的分流结果
+ */
+static MuxStep_t prv_Step(MuxScan_t *scan, uint8_t b);
+
+/**
+ * @brief 判断文本字节是否为流控字符
+ * @param b 文本字节
+ * @retval uint32_t 1为XON/XOFF，0为普通文本；未开启XON/XOFF时总是0
+ */
+static uint32_t prv_IsFlow(uint8_t b);
+
+/**
+ * @brief 把接收流中的数据搬到暂存缓冲区
+ * @retval uint32_t 搬运的字节数
+ * @note 只在mux_owner任务中调用，暂存缓冲区满时剩余数据留在接收流中
+ */
+static uint32_t prv_Hold(void);
+
+/**
+ * @brief 等待发送队列
+ * @retval 无
+ * @note 等待一个滴答，mux_owner任务在等待前搬运接收数据
+ */
+static void prv_Wait(void);
+
+/**
+ * @brief 分流一段连续的接收数据
+ * @param data 接收数据
+ * @param len 数据长度
+ * @retval 无
+ * @note 分流状态跨调用保持，帧可以跨越环形缓冲区回绕点
+ */
+static void prv_Route(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 交付一段文本
+ * @param data 文本数据
+ * @param len 数据长度
+ * @retval 无
+ */
+static void prv_Text(const uint8_t *data, uint32_t len);
+
+// ==================== 静态函数实现 ====================
+
+/**
+ * @brief 单字节分流实现
+ */
+static MuxStep_t prv_Step(MuxScan_t *scan, uint8_t b)
+{
+    if (scan->state == MUX_STATE_TEXT)
+    {
+        if (b != 0)
+        {
+            return MUX_STEP_TEXT;
+        }
+        scan->state = MUX_STATE_FRAME;
+        scan->started = 0;
+        scan->len = 0;
+        return MUX_STEP_OPEN;
+    }
+
+    scan->len++;
+    if (b != 0)
+    {
+        scan->started = 1;
+        if (scan->len <= FRAME_ENCODED_MAX)
+        {
+            return MUX_STEP_FRAME;
+        }
+        // 帧尾丢失，其后按文本处理
+        scan->state = MUX_STATE_TEXT;
+        return MUX_STEP_ABORT;
+    }
+
+    if (scan->started)
+    {
+        scan->state = MUX_STATE_TEXT;
+        return MUX_STEP_CLOSE;
+    }
+
+    return MUX_STEP_FRAME; // 帧头前连续的分隔符
+}
+
+/**
+ * @brief 流控字符判断实现
+ */
+static uint32_t prv_IsFlow(uint8_t b)
+{
+#if MUX_FLOW_XONXOFF
+    return ((b == MUX_XON) || (b == MUX_XOFF)) ? 1U : 0U;
+#else
+    (void)b;
+    return 0;
+#endif
+}
+
+/**
+ * @brief 文本交付实现
+ */
+static void prv_Text(const uint8_t *data, uint32_t len)
+{
+    if ((len != 0) && (mux_text_handler != NULL))
+    {
+        mux_text_handler(mux_text_arg, data, len);
+    }
+}
+
+/**
+ * @brief 分流实现
+ */
+static void prv_Route(const uint8_t *data, uint32_t len)
+{
+    uint32_t start = 0;
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        switch (prv_Step(&mux_scan, data[i]))
+        {
+        case MUX_STEP_TEXT:
+            // 流控字符已在搬运时处理，不交给shell
+            if (prv_IsFlow(data[i]))
+            {
+                prv_Text(&data[start], i - start);
+                start = i + 1U;
+            }
+            break;
+        case MUX_STEP_OPEN:
+            // 帧头分隔符，之前的文本先交付
+            prv_Text(&data[start], i - start);
+            start = i;
+            break;
+        case MUX_STEP_CLOSE:
+            FrameInput(&data[start], i + 1U - start);
+            start = i + 1U;
+            break;
+        case MUX_STEP_ABORT:
+            // 已收部分交给解码器作废，该字节重新按文本判断
+            FrameInput(&data[start], i - start);
+            start = i;
+            if (prv_IsFlow(data[i]))
+            {
+                start = i + 1U;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (mux_scan.state == MUX_STATE_TEXT)
+    {
+        prv_Text(&data[start], len - start);
+    }
+    else
+    {
+        FrameInput(&data[start], len - start);
+    }
+}
+
+/**
+ * @brief 搬运接收数据实现
+ */
+static uint32_t prv_Hold(void)
+{
+    yDevUsartRxSpan_t span;
+    uint32_t room;
+    uint32_t moved = 0;
+    uint32_t n;
+    uint32_t k;
+    uint32_t i;
+    MuxStep_t step;
+
+    if (MessagePeek(&span) == 0)
+    {
+        return 0;
+    }
+
+    // 暂存为空时从已交付数据的状态接着跟踪
+    if (ylib_ring_empty(&mux_hold))
+    {
+        mux_hold_scan = mux_scan;
+    }
+
+    room = ylib_ring_free_count(&mux_hold);
+    for (k = 0; (k < 2U) && (room != 0U); k++)
+    {
+        n = (span.len[k] < room) ? span.len[k] : room;
+        for (i = 0; i < n; i++)
+        {
+            step = prv_Step(&mux_hold_scan, span.data[k][i]);
+            if (((step == MUX_STEP_TEXT) || (step == MUX_STEP_ABORT)) && prv_IsFlow(span.data[k][i]))
+            {
+                mux_xoff = (span.data[k][i] == MUX_XOFF) ? 1U : 0U;
+                mux_xoff_tick = xTaskGetTickCount();
+            }
+        }
+        (void)ylib_ring_enqueue_bulk(&mux_hold, span.data[k], n, 1);
+        room -= n;
+        moved += n;
+    }
+
+    if (moved != 0U)
+    {
+        MessageConsume(moved);
+    }
+    if (ylib_ring_free_count(&mux_hold) == 0U)
+    {
+        mux_stats.hold_full++;
+    }
+
+    return moved;
+}
+
+/**
+ * @brief 等待发送队列实现
+ */
+static void prv_Wait(void)
+{
+    if (xTaskGetCurrentTaskHandle() == mux_owner)
+    {
+        mux_stats.held += prv_Hold();
+    }
+    vTaskDelay(1);
+}
+
+// ==================== 公共API实现 ====================
+
+/**
+ * @brief 通道复用初始化
+ * @param handler 文本处理函数
+ * @param arg 处理函数参数
+ * @retval 无
+ */
+void MuxInit(MuxTextHandler_t handler, void *arg)
+{
+    mux_text_handler = handler;
+    mux_text_arg = arg;
+    mux_scan.state = MUX_STATE_TEXT;
+    mux_scan.started = 0;
+    mux_scan.len = 0;
+    mux_owner = xTaskGetCurrentTaskHandle();
+    (void)ylib_ring_init(&mux_hold, mux_hold_buffer, MUX_RX_HOLD);
+    mux_xoff = 0;
+
+    FrameInit();
+}
+
+/**
+ * @brief 处理接收数据
+ * @retval uint32_t 处理的字节数
+ */
+uint32_t MuxPoll(void)
+{
+    ylib_span_t span;
+    uint32_t avail;
+
+    (void)prv_Hold();
+    avail = ylib_ring_peek_linear(&mux_hold, ylib_ring_count(&mux_hold), &span, 1);
+    if (avail == 0)
+    {
+        return 0;
+    }
+
+    // 分流期间命令输出等待时搬运的数据追加在这一批之后
+    prv_Route((const uint8_t *)span.data[0], span.len[0]);
+    prv_Route((const uint8_t *)span.data[1], span.len[1]);
+    ylib_ring_release(&mux_hold, avail);
+
+    return avail;
+}
+
+/**
+ * @brief 写入文本数据
+ * @param data 文本数据
+ * @param len 数据长度
+ * @retval int32_t 写入的字节数
+ */
+int32_t MuxTextWrite(const void *data, uint16_t len)
+{
+    return MuxTextWritePrio(data, len, MUX_PRIO_NORMAL);
+}
+
+/**
+ * @brief 按优先级写入文本数据
+ * @param data 文本数据
+ * @param len 数据长度
+ * @param prio 优先级
+ * @retval int32_t 写入的字节数
+ */
+int32_t MuxTextWritePrio(const void *data, uint16_t len, MuxPrio_t prio)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint16_t written = 0;
+    uint16_t chunk;
+    int32_t ret;
+
+    if (prio >= MUX_PRIO_MAX)
+    {
+        prio = MUX_PRIO_NORMAL;
+    }
+
+    while (written < len)
+    {
+        // 积压过多时让出发送队列，期间到来的遥测帧直接排在已有文本之后
+        if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+        {
+            while (mux_xoff)
+            {
+                if ((xTaskGetTickCount() - mux_xoff_tick) >= pdMS_TO_TICKS(MUX_XOFF_TIMEOUT_MS))
+                {
+                    mux_xoff = 0; // XON丢失时不永久停止输出
+                    mux_stats.xoff_timeouts++;
+                    break;
+                }
+                prv_Wait();
+            }
+            while (MessagePending() > mux_backlog[prio])
+            {
+                mux_stats.waits++;
+                prv_Wait();
+            }
+        }
+
+        chunk = len - written;
+        if (chunk > MUX_TEXT_CHUNK)
+        {
+            chunk = MUX_TEXT_CHUNK;
+        }
+
+        ret = MessageWrite(&p[written], chunk);
+        if (ret <= 0)
+        {
+            break;
+        }
+        written += (uint16_t)ret;
+    }
+
+    return (int32_t)written;
+}
+
+/**
+ * @brief 读取统计
+ * @param stats 输出的统计
+ * @retval 无
+ */
+void MuxStatsGet(MuxStats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = mux_stats;
+        stats->xoff = mux_xoff;
+    }
+}
+
+/**
+ * @brief 通道复用统计shell命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @retval 0
+ */
+static int MuxStatCmd(int argc, char *argv[])
+{
+    MuxStats_t stats;
+    Shell *shell = shellGetCurrent();
+
+    (void)argc;
+    (void)argv;
+    MuxStatsGet(&stats);
+    shellPrint(shell, "held: %lu, hold full: %lu, waits: %lu\r\n",
+               (unsigned long)stats.held, (unsigned long)stats.hold_full, (unsigned long)stats.waits);
+    shellPrint(shell, "xoff: %u, xoff timeouts: %lu\r\n",
+               (unsigned)stats.xoff, (unsigned long)stats.xoff_timeouts);
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 muxstat, MuxStatCmd, text/frame mux statistics);
@@ -0,0 +1,409 @@
+/**
+ * @file pipeline.c
+ * @brief 接收流水线模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 在数据源查看到的接收缓冲区上逐条分帧和分发，处理完成后一次提交消费长度；
+ * 不完整的消息不提交，留在接收缓冲区中，下次调用从消息开头重新分帧
+ *
+ * @par 主要特性:
+ * - 分帧器无状态，一个分帧器可以同时用于多条流水线
+ * - 只有跨越环形缓冲区回绕点的消息拷贝到ylib_pbuf中拼接
+ * - ylib_pbuf由所有使用者共用，引用计数归零时归还，可在任意任务中释放
+ */
+#include <string.h>
+#include "pipeline.h"
+
+// ==================== 静态函数声明 ====================
+
+/**
+ * @brief 从第pos个可读字节起拼接到池块
+ * @param span 数据源查看到的数据区间
+ * @param pos 起始位置
+ * @param avail 可读字节总数
+ * @param block 拼接缓冲区
+ * @retval uint32_t 拼接的字节数，不超过PIPE_BLOCK_SIZE
+ */
+static uint32_t prv_Gather(const yDevUsartRxSpan_t *span, uint32_t pos, uint32_t avail, uint8_t *block);
+
+/**
+ * @brief 按分发表调用处理函数
+ * @param pipe 流水线
+ * @param msg 消息引用
+ * @retval 无
+ */
+static void prv_Dispatch(Pipeline_t *pipe, PipeBuf_t *msg);
+
+/**
+ * @brief 原地COBS解码
+ * @param data 编码数据，不含分隔符
+ * @param len 编码长度
+ * @retval int32_t 解码后长度，格式错误返回-1
+ */
+static int32_t prv_CobsDecode(uint8_t *data, uint32_t len);
+
+// ==================== 静态函数实现 ====================
+
+/**
+ * @brief 拼接实现
+ */
+static uint32_t prv_Gather(const yDevUsartRxSpan_t *span, uint32_t pos, uint32_t avail, uint8_t *block)
+{
+    uint32_t len = avail - pos;
+    uint32_t first = span->len[0] - pos;
+
+    if (len > PIPE_BLOCK_SIZE)
+    {
+        len = PIPE_BLOCK_SIZE;
+    }
+    if (first > len)
+    {
+        first = len;
+    }
+
+    memcpy(block, &span->data[0][pos], first);
+    memcpy(&block[first], span->data[1], len - first);
+    return len;
+}
+
+/**
+ * @brief 分发实现
+ */
+static void prv_Dispatch(Pipeline_t *pipe, PipeBuf_t *msg)
+{
+    uint32_t i;
+
+    for (i = 0; i < pipe->count; i++)
+    {
+        if ((pipe->routes[i].id == msg->id) || (pipe->routes[i].id == PIPE_ID_ANY))
+        {
+            pipe->stats.messages++;
+            LatencyStamp(msg->lat, LAT_STAGE_PARSE);
+            LatencySetCurrent(msg->lat);
+            pipe->routes[i].handler(pipe->routes[i].arg, msg);
+            LatencySetCurrent(0);
+
+            // 处理函数取走消息时上下文随之转移
+            LatencyStamp(msg->lat, LAT_STAGE_HANDLE);
+            LatencyEnd(msg->lat);
+            return;
+        }
+    }
+
+    pipe->stats.unrouted++;
+    LatencyAbort(msg->lat);
+}
+
+/**
+ * @brief COBS解码实现
+ * @note 输出位置总在输入位置之前，可以原地解码
+ */
+static int32_t prv_CobsDecode(uint8_t *data, uint32_t len)
+{
+    uint32_t in = 0;
+    uint32_t out = 0;
+    uint32_t code;
+    uint32_t i;
+
+    while (in < len)
+    {
+        code = data[in++];
+        if ((code == 0U) || ((code - 1U) > (len - in)))
+        {
+            return -1;
+        }
+        for (i = 1; i < code; i++)
+        {
+            data[out++] = data[in++];
+        }
+        // 不足254字节的数据块后原本是一个0x00，最后一块除外
+        if ((code != 0xFFU) && (in < len))
+        {
+            data[out++] = 0;
+        }
+    }
+
+    return (int32_t)out;
+}
+
+/**
+ * @brief 文本行分帧
+ */
+static PipeScan_t prv_ScanLine(uint8_t *data, uint32_t len, PipeBuf_t *msg, uint32_t *used)
+{
+    const uint8_t *end = (const uint8_t *)memchr(data, '\n', len);
+    uint32_t n;
+
+    if (end == NULL)
+    {
+        return PIPE_SCAN_MORE;
+    }
+
+    n = (uint32_t)(end - data);
+    *used = n + 1U;
+    if ((n != 0) && (data[n - 1U] == '\r'))
+    {
+        n--;
+    }
+
+    msg->data = data;
+    msg->len = (uint16_t)n;
+    msg->id = 0;
+    return PIPE_SCAN_MSG;
+}
+
+/**
+ * @brief COBS分帧
+ */
+static PipeScan_t prv_ScanCobs(uint8_t *data, uint32_t len, PipeBuf_t *msg, uint32_t *used)
+{
+    const uint8_t *end;
+    uint32_t n;
+    int32_t decoded;
+
+    // 帧头分隔符和连续的分隔符
+    if (data[0] == 0)
+    {
+        for (n = 1; (n < len) && (data[n] == 0); n++)
+        {
+        }
+        *used = n;
+        return PIPE_SCAN_SKIP;
+    }
+
+    end = (const uint8_t *)memchr(data, 0, len);
+    if (end == NULL)
+    {
+        return PIPE_SCAN_MORE;
+    }
+
+    n = (uint32_t)(end - data);
+    *used = n + 1U;
+    decoded = prv_CobsDecode(data, n);
+    if (decoded < 1)
+    {
+        return PIPE_SCAN_SKIP;
+    }
+
+    msg->id = data[0];
+    msg->data = &data[1];
+    msg->len = (uint16_t)(decoded - 1);
+    return PIPE_SCAN_MSG;
+}
+
+/**
+ * @brief 长度前缀分帧
+ */
+static PipeScan_t prv_ScanLength(uint8_t *data, uint32_t len, PipeBuf_t *msg, uint32_t *used)
+{
+    uint32_t n;
+
+    if (len < 2U)
+    {
+        return PIPE_SCAN_MORE;
+    }
+
+    // 超过块大小的长度不可能是有效消息，逐字节重新同步
+    n = 2U + data[1];
+    if (n > PIPE_BLOCK_SIZE)
+    {
+        *used = 1;
+        return PIPE_SCAN_SKIP;
+    }
+    if (len < n)
+    {
+        return PIPE_SCAN_MORE;
+    }
+
+    *used = n;
+    msg->id = data[0];
+    msg->data = &data[2];
+    msg->len = data[1];
+    return PIPE_SCAN_MSG;
+}
+
+// ==================== 内置分帧器 ====================
+
+const PipeFramer_t PipeFramerLine = {"line", prv_ScanLine};
+const PipeFramer_t PipeFramerCobs = {"cobs", prv_ScanCobs};
+const PipeFramer_t PipeFramerLength = {"length", prv_ScanLength};
+
+// ==================== 公共API实现 ====================
+
+/**
+ * @brief 流水线初始化
+ */
+int32_t PipelineInit(Pipeline_t *pipe, const PipeSource_t *source, const PipeFramer_t *framer,
+                     const PipeRoute_t *routes, uint32_t count)
+{
+    if (ylib_pbuf_init() != 0)
+    {
+        return -1;
+    }
+
+    pipe->source = source;
+    pipe->framer = framer;
+    pipe->routes = routes;
+    pipe->count = count;
+    memset(&pipe->stats, 0, sizeof(pipe->stats));
+    pipe->lat = 0;
+    return 0;
+}
+
+/**
+ * @brief 处理数据源中的数据
+ */
+uint32_t PipelinePoll(Pipeline_t *pipe)
+{
+    yDevUsartRxSpan_t span;
+    PipeBuf_t msg;
+    PipeScan_t scan;
+    ylib_pbuf_t *block;
+    uint8_t *data;
+    uint32_t avail;
+    uint32_t done = 0;
+    uint32_t len;
+    uint32_t used;
+
+    // 提交消费前DMA不会写入查看到的区间，分帧器可以原地改写
+    avail = pipe->source->peek(&span);
+    while (done < avail)
+    {
+        block = NULL;
+        if (done < span.len[0])
+        {
+            data = (uint8_t *)&span.data[0][done];
+            len = span.len[0] - done;
+        }
+        else
+        {
+            data = (uint8_t *)&span.data[1][done - span.len[0]];
+            len = avail - done;
+        }
+        if (len > PIPE_BLOCK_SIZE)
+        {
+            len = PIPE_BLOCK_SIZE;
+        }
+
+        // 消息开头第一次出现时开始跟踪，不完整时保留到下次调用
+        used = 1;
+        if (pipe->lat == 0)
+        {
+            pipe->lat = LatencyBegin();
+        }
+        scan = pipe->framer->scan(data, len, &msg, &used);
+
+        // 第一段剩余部分不完整且数据回绕到了第二段，拼接后重新分帧
+        if ((scan == PIPE_SCAN_MORE) && (done < span.len[0]) && (len < PIPE_BLOCK_SIZE) && (avail > span.len[0]))
+        {
+            block = ylib_pbuf_alloc(0, PIPE_BLOCK_SIZE);
+            if (block == NULL)
+            {
+                pipe->stats.no_block++;
+                break;
+            }
+            len = prv_Gather(&span, done, avail, block->payload);
+            scan = pipe->framer->scan(block->payload, len, &msg, &used);
+            if (scan == PIPE_SCAN_MSG)
+            {
+                pipe->stats.linearized++;
+            }
+        }
+
+        if (scan == PIPE_SCAN_MORE)
+        {
+            if (len < PIPE_BLOCK_SIZE)
+            {
+                (void)ylib_pbuf_free(block);
+                break;
+            }
+            // 一个块都装不下的消息不可能完整，整段丢弃
+            pipe->stats.oversize++;
+            used = len;
+            scan = PIPE_SCAN_SKIP;
+        }
+
+        if ((used == 0) || (used > len))
+        {
+            used = len;
+        }
+
+        if (scan == PIPE_SCAN_SKIP)
+        {
+            pipe->stats.skipped += used;
+            LatencyAbort(pipe->lat);
+            pipe->lat = 0;
+        }
+        else
+        {
+            // 分帧完成即接收结束，上下文交给消息
+            msg.lat = pipe->lat;
+            pipe->lat = 0;
+            LatencyStamp(msg.lat, LAT_STAGE_RX);
+
+            // 处理函数用PipeBufTake取走缓冲区时清空pbuf
+            msg.pbuf = block;
+            prv_Dispatch(pipe, &msg);
+            block = msg.pbuf;
+        }
+
+        (void)ylib_pbuf_free(block);
+        done += used;
+    }
+
+    if (done != 0)
+    {
+        pipe->source->consume(done);
+    }
+
+    return done;
+}
+
+/**
+ * @brief 取得消息的所有权
+ */
+int32_t PipeBufTake(PipeBuf_t *msg, PipeBuf_t *out)
+{
+    ylib_pbuf_t *p = msg->pbuf;
+
+    if (p != NULL)
+    {
+        // 转移引用，缓冲区收缩到消息本身，分帧器的头部和分隔符不再可见
+        msg->pbuf = NULL;
+        (void)ylib_pbuf_header(p, -(int)(msg->data - p->payload));
+        p->len = msg->len;
+        p->tot_len = msg->len;
+    }
+    else
+    {
+        p = ylib_pbuf_alloc(0, msg->len);
+        if (p == NULL)
+        {
+            return -1;
+        }
+        memcpy(p->payload, msg->data, msg->len);
+    }
+
+    out->data = p->payload;
+    out->len = msg->len;
+    out->id = msg->id;
+    out->pbuf = p;
+    out->lat = msg->lat;
+    msg->lat = 0;
+    return 0;
+}
+
+/**
+ * @brief 释放消息引用
+ */
+void PipeBufRelease(PipeBuf_t *buf)
+{
+    (void)ylib_pbuf_free(buf->pbuf);
+    buf->pbuf = NULL;
+    LatencyStamp(buf->lat, LAT_STAGE_HANDLE);
+    LatencyEnd(buf->lat);
+    buf->lat = 0;
+}
@@ -8,50 +8,69 @@
 #include <string.h>
 #include "FreeRTOS.h"
 #include "task.h"
+#include "yDev_debounce.h"
+#include "yDev_tim.h"
 #include "switch.h"
 #include "shell.h"
+#include "board.h"
 // ==================== 静态变量 ====================
 
-static yDevConfig_Gpio_t switch_config[SWITCH_TYPE_MAX] = {
-    [SWITCH_TYPE_LED] = {
-        .base = {
-            .type = YDEV_TYPE_GPIO,
-        },
-        .drv_config = {
-            .pin = YDRV_PINC8,
-            .mode = YDRV_GPIO_MODE_OUTPUT_OD,
-            .pupd = YDRV_GPIO_PUPD_NONE,
-            .speed = YDRV_GPIO_SPEED_LEVEL0,
-        },
+/**
+ * @brief LED由TIM3通道3(PC8, AF1)的PWM驱动，定时器、引脚和DMA通道取自board.def
+ * @note 计数时钟10kHz，载波周期10ms，比较值即亮度百分比；100%以上输出恒为有效电平。
+ *       亮度表由更新事件触发DMA逐周期写入比较值，循环播放时不需要CPU参与
+ */
+static yDevConfig_Tim_t led_config = {
+    .base = {
+        .type = YDEV_TYPE_TIM,
+        .name = BOARD_LED0_NAME,
     },
-    [SWITCH_TYPE_BUTTON] = {
-        .base = {
-            .type = YDEV_TYPE_GPIO,
-        },
-        .drv_config = {
-            .pin = YDRV_PINC0,
-            .mode = YDRV_GPIO_MODE_INPUT,
-            .pupd = YDRV_GPIO_PUPD_PULLUP,
-            .speed = YDRV_GPIO_SPEED_LEVEL3,
+    .drv_config = {
+        .timId = BOARD_LED0_PERIPH,
+        .channel = YDRV_TIM_CH3,
+        .mode = YDRV_TIM_MODE_PWM,
+        .pin = BOARD_LED0_CH3_PIN,
+        .pinAF = BOARD_LED0_CH3_AF,
+        .openDrain = 1,
+        .tickHz = 10000,
+        .period = SWITCH_LED_LEVELS,
+        .pulse = 0,
+        .polarity = YDRV_TIM_POLARITY_HIGH,
+        .dma = {
+            .channel = BOARD_LED0_UP_DMA,
+            .priority = YDRV_DMA_PRIORITY_LOW,
+            .circular = 1,
         },
     },
 };
 
-static yDevHandle_Gpio_t switch_handle[SWITCH_TYPE_MAX];
+static yDevConfig_Gpio_t button_config = {
+    .base = {
+        .type = YDEV_TYPE_GPIO,
+        .name = BOARD_KEY0_NAME,
+    },
+    .drv_config = {
+        .pin = BOARD_KEY0_IN_PIN,
+        .mode = YDRV_GPIO_MODE_INPUT,
+        .pupd = YDRV_GPIO_PUPD_PULLUP,
+        .speed = YDRV_GPIO_SPEED_LEVEL3,
+    },
+};
+
+static yDevHandle_Tim_t led_handle;
+static yDevHandle_Gpio_t button_handle;
 
 static uint32_t log_flag;
 static uint32_t log_time;
+static uint32_t button_level; /**< 消抖后的按键电平，上拉输入，0为按下 */
+static uint8_t led_table;     /**< 亮度表正在播放 */
 
-static void button_log(void *arg);
+#define SWITCH_DEBOUNCE_MS (20)        /**< 按键消抖时间 */
+#define SWITCH_LOG_WINDOW_US (1500000) /**< 连续按键计数窗口 */
 
-static yDrvGpioExtiConfig_t button_exit =
-    {
-        .trigger = YDRV_GPIO_EXTI_TRIGGER_FALLING,
-        .prio = 1,
-        .arg = &switch_handle[SWITCH_TYPE_BUTTON],
-        .function = button_log,
-        .enable = 1,
-};
+static void button_log(void);
+
+MSGBUS_TOPIC_DEFINE(button);
 
 // ==================== 公共API实现 ====================
 
@@ -63,10 +82,15 @@ void SwitchInit(void)
     // 初始化开关模块变量
     log_flag = 0;
     log_time = 0;
-    yDevInitStatic(&switch_config[SWITCH_TYPE_LED], &switch_handle[SWITCH_TYPE_LED]);
-    yDevInitStatic(&switch_config[SWITCH_TYPE_BUTTON], &switch_handle[SWITCH_TYPE_BUTTON]);
+    led_table = 0;
+    yDevInitStatic(&led_config, &led_handle);
+    yDevIoctl(&led_handle, YDEV_TIM_START, NULL);
+    yDevInitStatic(&button_config, &button_handle);
+    button_level = yDevGpioReadFast(&button_handle);
 
-    yDevIoctl(&switch_handle[SWITCH_TYPE_BUTTON], YDEV_GPIO_REGISTER_EXIT, &button_exit);
+    // 按键边沿由消抖服务捕获，中断内只记录时间戳
+    yDevDebounceInit();
+    yDevDebounceAdd(&button_handle, SWITCH_DEBOUNCE_MS, YDRV_IRQ_PRIO_BUTTON);
 }
 
 /**
@@ -76,25 +100,69 @@ void SwitchInit(void)
  */
 void SwitchCtrl(usrSwitchType_t type, uint32_t st)
 {
-    uint32_t gpio_state;
+    uint32_t on;
+
+    if (type != SWITCH_TYPE_LED)
+    {
+        return; // 按键为输入，不能控制
+    }
 
     switch (st)
     {
     case 0:
-        // 关
-        gpio_state = 0;
-        yDevWrite(&switch_handle[type], &gpio_state, sizeof(gpio_state));
+        on = 0;
         break;
     case 1:
-        // 开
-        gpio_state = 1;
-        yDevWrite(&switch_handle[type], &gpio_state, sizeof(gpio_state));
+        on = 1;
         break;
     default:
-        // 翻转
-        yDevIoctl(&switch_handle[type], YDEV_GPIO_TOGGLE_PIN, NULL);
+        on = (yDevTimGetCaptureFast(&led_handle) == 0U) ? 1U : 0U;
         break;
     }
+
+    SwitchLevel(on ? SWITCH_LED_LEVELS : 0U);
+}
+
+/**
+ * @brief LED亮度设置函数
+ * @param level 亮度(0~SWITCH_LED_LEVELS)，超过上限按常亮处理
+ */
+void SwitchLevel(uint32_t level)
+{
+    if (led_table != 0U)
+    {
+        (void)yDevIoctl(&led_handle, YDEV_TIM_DMA_STOP, NULL);
+        led_table = 0;
+    }
+
+    // 比较值开启了预装载，下一个载波周期生效
+    yDevTimSetCompareFast(&led_handle, (level > SWITCH_LED_LEVELS) ? SWITCH_LED_LEVELS : level);
+}
+
+/**
+ * @brief LED亮度表循环播放函数
+ * @param table 亮度表(每项0~SWITCH_LED_LEVELS)
+ * @param len 表项数
+ * @return int32_t 0成功，-1失败(已改为常亮)
+ */
+int32_t SwitchPlay(const uint16_t *table, uint32_t len)
+{
+    yDevTimBurst_t burst;
+
+    SwitchLevel(SWITCH_LED_LEVELS);
+
+    burst.base = (yDrvTimBurstBase_t)(LL_TIM_DMABURST_BASEADDR_CCR1 +
+                                      (led_handle.drv_handle.channel << TIM_DCR_DBA_Pos));
+    burst.count = 1;
+    burst.table = table;
+    burst.len = len;
+    if (yDevIoctl(&led_handle, YDEV_TIM_BURST_START, &burst) != YDEV_OK)
+    {
+        return -1;
+    }
+    led_table = 1;
+
+    return 0;
 }
 
 /**
@@ -104,15 +172,39 @@ void SwitchCtrl(usrSwitchType_t type, uint32_t st)
  */
 uint32_t SwitchRead(usrSwitchType_t type)
 {
-    uint32_t gpio_state;
-    TickType_t nowtime = xTaskGetTickCount();
-    if (pdTICKS_TO_MS(nowtime - log_time) < 1500)
+    if (type == SWITCH_TYPE_LED)
+    {
+        return yDevTimGetCaptureFast(&led_handle);
+    }
+
+    // 电平取自消抖事件，不经过设备读取
+    button_log();
+    if (SwitchWindowLeft() != 0U)
     {
         return 0;
     }
 
-    yDevRead(&switch_handle[type], &gpio_state, sizeof(gpio_state));
-    return gpio_state;
+    return button_level;
+}
+
+/**
+ * @brief 连续按键计数窗口剩余时间
+ * @return uint32_t 距上次按下满1.5秒的剩余毫秒数，已满返回0
+ */
+uint32_t SwitchWindowLeft(void)
+{
+    uint32_t elapsed = yDevGetTimeUS() - log_time;
+
+    return (elapsed < SWITCH_LOG_WINDOW_US) ? ((SWITCH_LOG_WINDOW_US - elapsed + 999U) / 1000U) : 0U;
+}
+
+/**
+ * @brief 设置按键事件通知函数
+ * @param notify 通知函数，在定时器任务中调用，NULL表示不通知
+ */
+void SwitchSetNotify(void (*notify)(void))
+{
+    yDevDebounceSetNotify(notify);
 }
 
 /**
@@ -121,31 +213,54 @@ uint32_t SwitchRead(usrSwitchType_t type)
  */
 uint32_t SwitchGetLog(void)
 {
+    button_log();
     return log_flag;
 }
 
 /**
- * @brief 按键中断回调函数
- * @param arg 回调参数（未使用）
+ * @brief 按键事件处理
  *
  * @par 功能描述:
- * 按键中断服务函数，统计1.5秒内的按键按下次数
- * 用于实现不同的LED控制模式
+ * 取出消抖后的按键事件，按下时刻距上次按下不足1.5秒时计数加1，
+ * 用于实现不同的LED控制模式；时间取首个边沿的时间戳，不受取事件的时机影响
  */
-static void button_log(void *arg)
+static void button_log(void)
 {
-    (void)arg;
-    TickType_t nowtime = xTaskGetTickCountFromISR();
-    if (pdTICKS_TO_MS(nowtime - log_time) < 1500)
-    {
-        log_flag++;
-    }
-    else
+    yDevDebounceEvent_t event;
+    SwitchEvent_t msg;
+
+    while (yDevDebounceGet(&event, 0) == YDEV_OK)
     {
-        log_flag = 0;
+        if (event.gpio != &button_handle)
+        {
+            continue;
+        }
+
+        // 上拉输入，下降沿为按下
+        button_level = (event.edge == YDEV_DEBOUNCE_EDGE_RISING) ? 1U : 0U;
+        memset(&msg, 0, sizeof(msg));
+        msg.time_us = event.time_us;
+        if (event.edge != YDEV_DEBOUNCE_EDGE_FALLING)
+        {
+            (void)MsgBusPublish(MSGBUS_TOPIC(button), &msg, sizeof(msg));
+            continue;
+        }
+
+        if ((event.time_us - log_time) < SWITCH_LOG_WINDOW_US)
+        {
+            log_flag++;
+        }
+        else
+        {
+            log_flag = 0;
+        }
+        log_flag = log_flag > 3 ? 3 : log_flag;
+        log_time = event.time_us;
+
+        msg.pressed = 1;
+        msg.count = (uint8_t)log_flag;
+        (void)MsgBusPublish(MSGBUS_TOPIC(button), &msg, sizeof(msg));
     }
-    log_flag = log_flag > 3 ? 3 : log_flag;
-    log_time = nowtime;
 }
 
 /**
@@ -8,35 +8,183 @@
  * @par 功能描述:
  * 程序主入口，负责系统初始化和FreeRTOS调度器启动
  * 创建启动任务，完成各模块初始化后启动任务调度
+ *
+ * @par 启动顺序:
+ * - yLabInit：上电时钟为HSI，执行YDEV_INIT_BOARD级别
+ * - 启动任务：故障采集和工作任务，YDEV_INIT_DEVICE级别(切换到运行时钟、登记设备)，创建应用任务
+ * - 降到最低优先级执行YDEV_INIT_DEFERRED级别：DMA交叉点实测、外部Flash探测和故障转储，
+ *   此时shell已可用，shell的boot命令查看各级别完成时间和各初始化函数耗时
+ * - 运行selftest.boot选中的自检，默认只有快速项
+ * - 堆封闭模式(YLIB_NO_HEAP_AFTER_INIT)下自检后封闭堆，之后的分配记录故障后复位
+ * - 之后启动任务保持最低优先级，按设备空闲超时挂起设备，并把修改过的运行参数写入Flash
+ * - 看门狗在YDEV_INIT_DEVICE级别启动，启动任务从后台初始化开始登记心跳
+ * - 中断运行模式(OS_IRQ_RUN_ENABLE)不创建任务，两个初始化级别在main中执行后进入中断运行
  */
 // ==================== 包含文件 ====================
 #include "FreeRTOS.h"
 #include "task.h"
+#include "os_static.h"
+#include "os_mpu.h"
+#include "os_irqrun.h"
 #include "blink.h"
+#include "lin.h"
+#include "msgbus.h"
 #include "yDev.h"
 #include "serialshell.h"
+#include "logsink.h"
+#include "power.h"
+#include "selftest.h"
+#include "sensor.h"
+#include "settings.h"
+#include "watchdog.h"
 #include "flash.h"
+#include "yDev_dma.h"
+#include "yDrv_fault.h"
+#include "crashdump.h"
+#include "yLib_work.h"
+#include "yLib_heap.h"
+
+// ==================== 私有宏定义 ====================
+#define STARTUP_TASK_PRIO 31   /**< 启动任务优先级 */
+#define STARTUP_DEFERRED_PRIO 1 /**< 后台初始化阶段的优先级，低于所有应用任务 */
+#define STARTUP_STK_SIZE 1024  /**< 启动任务堆栈大小(字)，可按实测水位缩减 */
+#define STARTUP_PM_MAX_MS 500  /**< 设备挂起检查的最长间隔，覆盖之后才打开的设备 */
+#define STARTUP_WDG_MS 30000   /**< 启动任务的心跳期限，覆盖后台初始化和启动自检中最慢的一步 */
+
+// ==================== 私有变量 ====================
+
+#if !OS_IRQ_RUN_ENABLE
+OS_TASK_DEFINE(startup_task, STARTUP_STK_SIZE); /**< 启动任务堆栈和TCB */
+#endif
+
+/**
+ * @brief 内存拷贝DMA引擎
+ * @note 初始化后作为yDevDmaMemcpy的默认引擎
+ */
+static yDevHandle_Dma_t dma_handle = YDEV_DMA_HANDLE_DEFAULT();
+
 // ==================== 私有函数声明 ====================
 
+/**
+ * @brief 初始化内存拷贝引擎
+ * @retval 0 成功，-1 失败
+ * @note 关中断实测交叉点，放在后台级别，此前yDevDmaMemcpy由CPU拷贝
+ */
+static int32_t StartupDma(void)
+{
+    yDevConfig_Dma_t dma_config = YDEV_DMA_CONFIG_DEFAULT();
+
+    dma_config.base.name = "dma0";
+    return (yDevInitStatic(&dma_config, &dma_handle) == YDEV_OK) ? 0 : -1;
+}
+YDEV_INIT_EXPORT(StartupDma, YDEV_INIT_DEFERRED);
+
+/**
+ * @brief 把复位前的故障记录转存到外部Flash
+ * @retval 1 已保存，0 没有新记录，-1 失败
+ * @note 有故障记录时才访问flash0，首次访问完成芯片探测
+ */
+static int32_t StartupCrashSave(void)
+{
+    return CrashDumpSave(yDevFind("flash0"));
+}
+YDEV_INIT_EXPORT(StartupCrashSave, YDEV_INIT_DEFERRED);
+
+#if !OS_IRQ_RUN_ENABLE
 /**
  * @brief 系统启动任务
  * @param pvParameters 任务参数（未使用）
  *
  * @par 功能描述:
- * 负责系统各模块的初始化，完成后删除自身
+ * 负责系统各模块的初始化，应用任务创建后降低优先级执行慢速初始化，
+ * 完成后留在最低优先级挂起空闲超时的设备
  */
 static void Startup(void *pvParameters)
 {
+    uint32_t next_ms;
+    uint32_t save_ms;
+    int32_t wdg;
+
     // 抑制未使用参数警告
     (void)pvParameters;
-    // 初始化LED闪烁任务
-    FlashInit();
-    BlinkTaskInit();
+
+    // 填充主堆栈，shell的stacks命令据此报告中断使用的最大深度
+    yDrvMainStackPaint();
+
+    // 之后的故障附带任务名、堆状态和最近的跟踪事件
+    CrashDumpInit();
+
+    // 中断下半部工作任务，之前提交的工作项在任务启动后执行
+    ylib_work_service_init();
+
+    // 切换到运行时钟、登记设备，不探测慢速器件
+    (void)yDevInitRun(YDEV_INIT_DEVICE);
+
+    // 消息总线先于发布方创建，应用任务和LED闪烁模式，传感器驱动和LIN主机在之后登记
+    MsgBusInit();
+    BlinkInit();
     ShellTaskInit();
+    LogSinkInit();
+    SensorInit();
+    (void)LinInit();
 
-    // 初始化完成后删除启动任务
-    vTaskDelete(NULL);
+    // 让出CPU，应用任务先运行，空闲时再执行慢速初始化；外部Flash探测卡住时由看门狗复位
+    vTaskPrioritySet(NULL, STARTUP_DEFERRED_PRIO);
+    wdg = WatchdogRegister("Startup", STARTUP_WDG_MS);
+    (void)yDevInitRun(YDEV_INIT_DEFERRED);
+    WatchdogCheckin(wdg);
+
+    // 运行参数已读入，按selftest.boot选择的类别自检，结果写入日志
+    (void)SelfTestRun(SettingsGet(SETTING_SELFTEST_BOOT), NULL, NULL);
+
+#if YLIB_NO_HEAP_AFTER_INIT
+    // 初始化到此结束，之后的分配按故障记录后复位
+    ylib_heap_seal();
+#endif
+
+    // 启动任务的堆栈不回收，留下来按设备空闲超时挂起设备、延迟保存运行参数、累加任务运行时间，
+    // 只在最近的超时到期时唤醒
+    for (;;)
+    {
+        WatchdogCheckin(wdg);
+        next_ms = yDevPmProcess();
+        save_ms = SettingsProcess();
+        if (save_ms < next_ms)
+        {
+            next_ms = save_ms;
+        }
+        save_ms = PowerProcess();
+        if (save_ms < next_ms)
+        {
+            next_ms = save_ms;
+        }
+        vTaskDelay(pdMS_TO_TICKS((next_ms < STARTUP_PM_MAX_MS) ? next_ms : STARTUP_PM_MAX_MS) + 1U);
+    }
 }
+#endif /* !OS_IRQ_RUN_ENABLE */
+
+/**
+ * @brief 任务堆栈溢出回调
+ * @param xTask 溢出的任务
+ * @param pcTaskName 任务名
+ * @note 堆栈已被破坏，记录故障后复位，重启后用shell的fault命令查看
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    yDrvFaultLog(YDRV_FAULT_STACK_OVERFLOW, (uint32_t)xTask, pcTaskName);
+}
+
+#if YLIB_NO_HEAP_AFTER_INIT
+/**
+ * @brief 堆封闭后的分配
+ * @param caller 调用分配接口处的返回地址
+ * @note 调用者地址作为故障参数记录后复位，重启后用shell的fault命令查看
+ */
+void ylib_heap_seal_trap(const void *caller)
+{
+    yDrvFaultLog(YDRV_FAULT_USER, (uint32_t)(uintptr_t)caller, "heap sealed");
+}
+#endif
 
 /**
  * @brief 程序主入口函数
@@ -50,11 +198,26 @@ int main(void)
     // 系统底层初始化
     yLabInit();
 
+#if OS_IRQ_RUN_ENABLE
+    // 不启动调度器：设备登记和后台初始化在这里直接执行，之后只在中断中运行，应用逻辑挂在工作项和定时轮上
+    (void)yDevInitRun(YDEV_INIT_DEVICE);
+    (void)yDevInitRun(YDEV_INIT_DEFERRED);
+#if YLIB_NO_HEAP_AFTER_INIT
+    ylib_heap_seal();
+#endif
+    OsIrqRunStart();
+#else
     // 创建启动任务
-    xTaskCreate(Startup, "Startup", 1024, NULL, 31, NULL);
+    OS_TASK_CREATE(startup_task, Startup, "Startup", NULL, STARTUP_TASK_PRIO);
+
+#if OS_MPU_ENABLE
+    // 启动任务已带堆栈保护，之后创建的任务在OsTaskCreate中设置
+    OsMpuStart();
+#endif
 
     // 启动FreeRTOS调度器
     vTaskStartScheduler();
+#endif
 
     // 正常情况下不会执行到这里
     return 0;
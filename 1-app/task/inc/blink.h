@@ -1,13 +1,20 @@
 /**
  * @file blink.h
- * @brief LED闪烁任务模块头文件
- * @version 1.0
+ * @brief LED闪烁模式模块头文件
+ * @version 2.0
  * @date 2025
  * @author YLab Development Team
  *
  * @par 功能描述:
- * LED闪烁控制任务的头文件，提供LED闪烁任务的初始化和控制接口
- * 支持根据按键状态调整LED闪烁模式
+ * 表驱动的LED闪烁模式：每个模式是一组(亮度, 持续时间)步骤，由一个单次软件定时器
+ * 在步骤边沿推进，呼吸效果由PWM定时器的DMA循环播放亮度表，不占用任务和堆栈
+ *
+ * @par 按键控制:
+ * - 按键按下及松开后的1.5秒计数窗口内：LED常亮
+ * - 窗口结束时按下0次：正常闪烁（500ms间隔）
+ * - 按下1次：慢闪烁（1000ms间隔）
+ * - 按下2次：超慢闪烁（5000ms间隔）
+ * - 按下3次及以上：LED关闭
  */
 
 #ifndef TASK_BLINK_H
@@ -21,29 +28,55 @@ extern "C"
 // ==================== 包含文件 ====================
 #include <stdint.h>
 
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief LED闪烁模式
+     * @note 循环模式替换当前的基础模式；BLINK_ACK播放一遍后回到基础模式
+     */
+    typedef enum
+    {
+        BLINK_OFF = 0, /*!< 熄灭 */
+        BLINK_ON,      /*!< 常亮 */
+        BLINK_NORMAL,  /*!< 正常闪烁，亮灭各500ms */
+        BLINK_SLOW,    /*!< 慢闪烁，亮灭各1000ms */
+        BLINK_SLOWER,  /*!< 超慢闪烁，亮灭各5000ms */
+        BLINK_BREATHE, /*!< 呼吸，周期2秒 */
+        BLINK_ERROR,   /*!< 错误码，快闪3次后停1秒 */
+        BLINK_ACK,     /*!< 确认，快闪2次后回到基础模式 */
+        BLINK_PATTERN_MAX
+    } BlinkPattern_t;
+
     // ==================== 公共函数声明 ====================
 
     /**
-     * @brief LED闪烁任务处理函数
-     * @param pvParameters 任务参数（未使用）
+     * @brief 初始化LED闪烁模式
      *
      * @par 功能描述:
-     * LED闪烁任务的主处理函数，根据按键状态控制LED闪烁模式
-     * - 按键未按下：LED常亮
-     * - 按键按下0次：正常闪烁（500ms间隔）
-     * - 按键按下1次：慢闪烁（1000ms间隔）
-     * - 按键按下2次：超慢闪烁（5000ms间隔）
-     * - 按键按下3次及以上：LED关闭
+     * 初始化开关模块，创建步骤定时器并登记按键通知，以正常闪烁开始
      */
-    void BlinkTaskProcess(void *pvParameters);
+    void BlinkInit(void);
 
     /**
-     * @brief 初始化LED闪烁任务
-     *
-     * @par 功能描述:
-     * 创建LED闪烁任务，设置任务优先级和堆栈大小
+     * @brief 播放闪烁模式
+     * @param pattern 闪烁模式
+     * @return int32_t 0成功，-1模式无效或定时器命令队列已满
+     * @note 只发出定时器命令，模式在定时器任务中切换；不能在中断中调用
+     */
+    int32_t BlinkPlay(BlinkPattern_t pattern);
+
+    /**
+     * @brief 获取当前的基础模式
+     * @return BlinkPattern_t 基础模式
+     */
+    BlinkPattern_t BlinkGetPattern(void);
+
+    /**
+     * @brief 获取模式名称
+     * @param pattern 闪烁模式
+     * @return const char* 名称，模式无效时返回NULL
      */
-    void BlinkTaskInit(void);
+    const char *BlinkPatternName(BlinkPattern_t pattern);
 
 #ifdef __cplusplus
 }
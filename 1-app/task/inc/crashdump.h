@@ -0,0 +1,81 @@
+/**
+ * @file crashdump.h
+ * @brief 故障现场转储模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 在yDrv_fault的故障记录中附带当前任务名、堆状态和最近的跟踪事件；
+ * 复位后启动时把上一次的记录拷贝到外部Flash的最后一个扇区，掉电后仍可用shell的crashdump命令查看
+ *
+ * @par 附加数据格式:
+ * yDrvFaultRecord_t::extra按CrashDumpExtra_t存放，跟踪记录按时间先后排列，
+ * 第一条的时间差相对于未保存的更早记录，解码时从0开始累加
+ */
+
+#ifndef TASK_CRASHDUMP_H
+#define TASK_CRASHDUMP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDrv_fault.h"
+#include "yLib_trace.h"
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define CRASHDUMP_TRACE_RECORDS ((YDRV_FAULT_EXTRA_SIZE - 16U) / sizeof(struct ylib_trace_rec)) /**< 保存的跟踪记录条数 */
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 故障记录的附加数据
+     */
+    typedef struct
+    {
+        uint32_t heap_free;                                     /**< 空闲堆大小，未开启堆统计时为0 */
+        uint32_t heap_min;                                      /**< 历史最小空闲堆大小 */
+        uint32_t trace_hz;                                      /**< 跟踪时钟频率，0为未注册 */
+        uint32_t trace_count;                                   /**< 保存的跟踪记录条数 */
+        struct ylib_trace_rec trace[CRASHDUMP_TRACE_RECORDS];   /**< 最近的跟踪记录 */
+    } CrashDumpExtra_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 注册故障采集钩子
+     * @note 启动后尽早调用，之前发生的故障只有寄存器
+     */
+    void CrashDumpInit(void);
+
+    /**
+     * @brief 把复位前的故障记录拷贝到外部Flash
+     * @param flash 25Q设备句柄
+     * @retval 1 已保存，0 没有新记录(无故障或与Flash中相同)，-1 失败
+     * @note 启动时调用一次；RAM中的记录保留，fault命令仍可查看
+     */
+    int32_t CrashDumpSave(void *flash);
+
+    /**
+     * @brief 读出外部Flash中的故障记录
+     * @param flash 25Q设备句柄
+     * @return 模块内部的记录缓冲区，下次调用本模块接口前有效；无有效记录或读取失败返回NULL
+     */
+    const yDrvFaultRecord_t *CrashDumpLoad(void *flash);
+
+    /**
+     * @brief 擦除外部Flash中的故障记录
+     * @param flash 25Q设备句柄
+     * @retval 0 成功，-1 失败
+     */
+    int32_t CrashDumpErase(void *flash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_CRASHDUMP_H */
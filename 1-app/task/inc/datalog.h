@@ -0,0 +1,134 @@
+/**
+ * @file datalog.h
+ * @brief 采样数据记录模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 把采样值按时间顺序追加到25Q中的循环存储区，可连续记录数天；
+ * 按时间范围查询时先在段头中二分查找，再在段内二分查找，之后顺序读出，不扫描整个存储区
+ *
+ * @par 存储布局:
+ * - 存储区由若干扇区大小的段组成环，每段开头为 'YDLG' u32 | 序号u32 | 起始时间u32 | 记录数u32，
+ *   记录数在段写满时补写，其后为定长记录
+ * - 当前段之后的一段始终提前擦除，写满时直接换段，最旧的一段随之被擦除
+ * - 记录时间单位为DATALOG_TICK_MS，重启后从存储区中最后一条记录的时间继续，始终单调不减
+ *
+ * @par 写入:
+ * 记录先攒在两个页缓冲之一，攒满DATALOG_BATCH条交给25Q异步编程，同时填另一个缓冲；
+ * 复位时尚未写入的记录丢失，需要时调用DataLogSync
+ */
+
+#ifndef TASK_DATALOG_H
+#define TASK_DATALOG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define DATALOG_MAGIC 0x474C4459UL /**< 段头标识"YDLG" */
+
+#ifndef DATALOG_FLASH_ADDRESS
+#define DATALOG_FLASH_ADDRESS (0x31000UL) /**< 存储区在25Q中的地址，位于固件槽A、B之间 */
+#endif
+#ifndef DATALOG_FLASH_SIZE
+#define DATALOG_FLASH_SIZE (0xF000UL)     /**< 存储区大小，扇区整数倍且至少三个扇区 */
+#endif
+#ifndef DATALOG_TICK_MS
+#define DATALOG_TICK_MS 100               /**< 记录时间单位(毫秒)，32位可记录约13年 */
+#endif
+#ifndef DATALOG_BATCH
+#define DATALOG_BATCH 16                  /**< 每次编程的记录数，不超过一页 */
+#endif
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 一条记录
+     */
+    typedef struct
+    {
+        uint32_t time;    /*!< 时间，单位DATALOG_TICK_MS，0xFFFFFFFF为未写入 */
+        uint16_t channel; /*!< 通道号 */
+        uint16_t flags;   /*!< 调用者定义的标志 */
+        int32_t value;    /*!< 采样值 */
+    } DataLogRecord_t;
+
+    /**
+     * @brief 查询回调
+     * @param arg 用户参数
+     * @param rec 按时间顺序的若干条记录
+     * @param n 记录数
+     * @return int32_t 0继续，非0停止查询
+     */
+    typedef int32_t (*DataLogVisit_t)(void *arg, const DataLogRecord_t *rec, uint32_t n);
+
+    /**
+     * @brief 统计信息
+     */
+    typedef struct
+    {
+        uint32_t appended; /*!< 本次启动追加的记录数 */
+        uint32_t failed;   /*!< 追加失败的记录数 */
+        uint32_t rolls;    /*!< 换段次数 */
+        uint32_t segments; /*!< 有效段数 */
+        uint32_t records;  /*!< 存储区中的记录数，含尚未写入的 */
+        uint32_t first;    /*!< 最旧记录的时间 */
+        uint32_t last;     /*!< 最新记录的时间 */
+        uint32_t now;      /*!< 当前时间 */
+    } DataLogStats_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 追加一条记录
+     * @param channel 通道号
+     * @param flags 标志
+     * @param value 采样值
+     * @return int32_t 0成功，-1 25Q不可用或编程失败
+     * @note 时间取当前时间；可在多个任务中调用，不能在中断中调用
+     */
+    int32_t DataLogAppend(uint16_t channel, uint16_t flags, int32_t value);
+
+    /**
+     * @brief 把页缓冲中的记录写入Flash并等待编程完成
+     * @return int32_t 0成功，-1失败
+     */
+    int32_t DataLogSync(void);
+
+    /**
+     * @brief 按时间范围查询
+     * @param from 起始时间(含)
+     * @param to 结束时间(含)
+     * @param visit 回调，在调用者任务中执行，期间不持有锁
+     * @param arg 回调参数
+     * @return int32_t 回调收到的记录数，-1 25Q不可用或读取失败
+     * @note 先写入页缓冲中的记录；查询期间被换段擦除的部分提前结束
+     */
+    int32_t DataLogQuery(uint32_t from, uint32_t to, DataLogVisit_t visit, void *arg);
+
+    /**
+     * @brief 擦除存储区
+     * @return int32_t 0成功，-1失败
+     * @note 时间不清零，之后的记录继续使用当前时间
+     */
+    int32_t DataLogErase(void);
+
+    /**
+     * @brief 读取统计信息
+     * @param stats 输出
+     * @return int32_t 0成功，-1 25Q不可用
+     */
+    int32_t DataLogGetStats(DataLogStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_DATALOG_H */
@@ -0,0 +1,147 @@
+/**
+ * @file fwupdate.h
+ * @brief 固件升级接收模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 经帧协议接收固件镜像，边收边以25Q异步页编程写入外部Flash中较旧的一个槽(A/B)，
+ * RAM中只有两页的缓冲；收完后用硬件CRC校验接收数据和读回数据，最后写入槽头提交。
+ * 引导程序按槽头选择序号最大的有效槽，校验后复制到片内Flash
+ *
+ * @par 帧格式:
+ * FWUP_FRAME_ID帧，第一个字节为类型，多字节字段均为小端：
+ * - FWUP_BEGIN:  镜像大小u32 | CRC-32 u32 | 版本u32 [| 压缩流字节数u32]，开始擦除目标槽
+ * - FWUP_DATA:   偏移u32 | 数据(不超过FWUP_CHUNK)，偏移必须等于已接收长度
+ * - FWUP_END:    无载荷，写入剩余数据、校验并提交槽头
+ * - FWUP_STATUS: 无载荷，查询状态
+ * - FWUP_ABORT:  无载荷，放弃本次接收
+ * 每帧回复 类型|0x80 | 结果u8 | 下一个期望偏移u32 | 目标槽u8 | 状态u8；
+ * 结果为FWUP_ERR_BUSY时稍后重发同一帧，为FWUP_ERR_OFFSET时从回复中的偏移重发
+ *
+ * @par 压缩传输:
+ * FWUP_BEGIN带非0的压缩流字节数时，数据帧传送镜像的yLib_lz压缩流(tools/lz.py生成)，
+ * 偏移按压缩流计算，设备边收边解压到页缓冲；镜像大小和CRC-32仍针对解压后的镜像，
+ * 槽中存放的也是解压后的镜像，引导程序不需要改动
+ *
+ * @par 槽布局:
+ * 每个槽第一个扇区放槽头(FwUpdateHeader_t)，镜像从下一个扇区开始；
+ * 开始接收时先擦除槽头，提交前槽一直无效，接收中断不会留下半个镜像被引导程序采用
+ */
+
+#ifndef TASK_FWUPDATE_H
+#define TASK_FWUPDATE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define FWUP_FRAME_ID 0x55            /**< 固件升级帧ID('U') */
+#define FWUP_CHUNK 120                /**< 每帧数据长度上限，1 + 4 + 120不超过帧载荷上限 */
+#define FWUP_MAGIC 0x55574659UL       /**< 槽头标识"YFWU" */
+#define FWUP_SLOTS 2                  /**< 槽数 */
+
+#ifndef FWUP_SLOT_A_ADDRESS
+#define FWUP_SLOT_A_ADDRESS (0x10000UL) /**< 槽A在25Q中的地址，避开性能测试区 */
+#endif
+#ifndef FWUP_SLOT_B_ADDRESS
+#define FWUP_SLOT_B_ADDRESS (0x40000UL) /**< 槽B在25Q中的地址 */
+#endif
+#ifndef FWUP_SLOT_SIZE
+#define FWUP_SLOT_SIZE (0x21000UL)      /**< 槽大小：一个扇区槽头加128KB镜像 */
+#endif
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 帧类型
+     */
+    typedef enum
+    {
+        FWUP_BEGIN = 0,  /**< 开始 */
+        FWUP_DATA = 1,   /**< 数据 */
+        FWUP_END = 2,    /**< 结束 */
+        FWUP_STATUS = 3, /**< 查询 */
+        FWUP_ABORT = 4,  /**< 放弃 */
+    } FwUpdateType_t;
+
+    /**
+     * @brief 回复中的结果
+     */
+    typedef enum
+    {
+        FWUP_ERR_OK = 0,     /**< 成功 */
+        FWUP_ERR_BUSY = 1,   /**< 擦除或编程未完成，稍后重发 */
+        FWUP_ERR_OFFSET = 2, /**< 偏移不连续，从回复中的偏移重发 */
+        FWUP_ERR_STATE = 3,  /**< 当前状态不接受该帧 */
+        FWUP_ERR_SIZE = 4,   /**< 镜像超出槽大小或Flash容量不足 */
+        FWUP_ERR_CRC = 5,    /**< 接收数据或读回数据CRC不符 */
+        FWUP_ERR_FLASH = 6,  /**< Flash擦写失败 */
+    } FwUpdateError_t;
+
+    /**
+     * @brief 接收状态
+     */
+    typedef enum
+    {
+        FWUP_IDLE = 0,      /**< 空闲 */
+        FWUP_ERASING = 1,   /**< 正在擦除目标槽 */
+        FWUP_RECEIVING = 2, /**< 接收中 */
+        FWUP_DONE = 3,      /**< 已提交 */
+        FWUP_FAILED = 4,    /**< 失败，需重新开始 */
+    } FwUpdateState_t;
+
+    /**
+     * @brief 槽头，位于槽的第一个扇区起始处
+     */
+    typedef struct
+    {
+        uint32_t magic;   /**< FWUP_MAGIC */
+        uint32_t seq;     /**< 提交序号，引导程序选最大的 */
+        uint32_t version; /**< 镜像版本，由上位机给出 */
+        uint32_t size;    /**< 镜像字节数 */
+        uint32_t crc;     /**< 镜像CRC-32 */
+        uint32_t check;   /**< 前面各字段的CRC-32 */
+    } FwUpdateHeader_t;
+
+    /**
+     * @brief 接收状态快照
+     */
+    typedef struct
+    {
+        uint8_t state;    /**< FwUpdateState_t */
+        uint8_t slot;     /**< 目标槽 */
+        uint8_t error;    /**< 最近一次错误FwUpdateError_t */
+        uint32_t size;    /**< 镜像字节数 */
+        uint32_t packed;  /**< 压缩流字节数，0表示未压缩 */
+        uint32_t offset;  /**< 已接收字节数，压缩传输时按压缩流计算 */
+        uint32_t retries; /**< 忙和偏移不连续的回复次数 */
+    } FwUpdateStatus_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 读取接收状态
+     * @param status 输出的状态
+     */
+    void FwUpdateGetStatus(FwUpdateStatus_t *status);
+
+    /**
+     * @brief 读取槽头
+     * @param slot 槽号
+     * @param header 输出的槽头
+     * @return 0槽头有效，-1无效或读取失败
+     */
+    int32_t FwUpdateGetSlot(uint32_t slot, FwUpdateHeader_t *header);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_FWUPDATE_H */
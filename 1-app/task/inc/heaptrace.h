@@ -0,0 +1,133 @@
+/**
+ * @file heaptrace.h
+ * @brief 堆分配跟踪模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 通过yLib堆的分配/释放钩子记录每个存活块的调用者地址、大小、时间和所属任务，
+ * 统计大小分布和各任务占用峰值，用于长时间运行后定位内存增长
+ */
+
+#ifndef TASK_HEAPTRACE_H
+#define TASK_HEAPTRACE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define HEAPTRACE_MAX_LIVE 64     /**< 可记录的存活块数量 */
+#define HEAPTRACE_MAX_TASKS 8     /**< 可区分的任务数量，第0项记录中断和调度器启动前的分配 */
+#define HEAPTRACE_SIZE_CLASSES 8  /**< 大小分级：<=16, <=32, ... <=1024, >1024 */
+#define HEAPTRACE_MIN_CLASS_LOG2 4 /**< 最小分级为2^4字节 */
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 存活块记录
+     */
+    typedef struct
+    {
+        void *ptr;          /**< 块地址，NULL表示空槽 */
+        const void *caller; /**< 分配处返回地址 */
+        uint32_t size;      /**< 块可用大小 */
+        TickType_t tick;    /**< 分配时刻 */
+        uint8_t task;       /**< 所属任务序号，见HeapTraceGetTask */
+    } HeapTraceRecord_t;
+
+    /**
+     * @brief 按调用者汇总的存活块
+     */
+    typedef struct
+    {
+        const void *caller; /**< 分配处返回地址 */
+        uint32_t blocks;    /**< 存活块数 */
+        uint32_t bytes;     /**< 存活字节数 */
+    } HeapTraceSite_t;
+
+    /**
+     * @brief 任务占用统计
+     */
+    typedef struct
+    {
+        char name[configMAX_TASK_NAME_LEN]; /**< 首次分配时记下的任务名 */
+        uint32_t in_use;                    /**< 当前占用字节数 */
+        uint32_t peak;                      /**< 历史最大占用字节数 */
+    } HeapTraceTask_t;
+
+    /**
+     * @brief 跟踪总体统计
+     */
+    typedef struct
+    {
+        uint32_t live;                               /**< 已记录的存活块数 */
+        uint32_t live_bytes;                         /**< 已记录的存活字节数 */
+        uint32_t peak_bytes;                         /**< 存活字节数峰值 */
+        uint32_t allocs;                             /**< 跟踪期间的分配次数 */
+        uint32_t frees;                              /**< 跟踪期间的释放次数 */
+        uint32_t dropped;                            /**< 记录表满未记录的分配次数 */
+        uint32_t untracked;                          /**< 释放了未记录块的次数(开始跟踪前分配或记录表满) */
+        uint32_t size_class[HEAPTRACE_SIZE_CLASSES]; /**< 各大小分级的分配次数 */
+    } HeapTraceStats_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 安装钩子开始跟踪
+     * @note 开始前已分配的块不在记录中，释放时计入untracked
+     */
+    void HeapTraceStart(void);
+
+    /**
+     * @brief 卸下钩子停止跟踪，已有记录保留
+     */
+    void HeapTraceStop(void);
+
+    /**
+     * @brief 清空全部记录和统计
+     */
+    void HeapTraceReset(void);
+
+    /**
+     * @brief 获取总体统计
+     * @param stats 统计信息输出
+     */
+    void HeapTraceGetStats(HeapTraceStats_t *stats);
+
+    /**
+     * @brief 按序号获取存活块记录
+     * @param index 序号，从0开始
+     * @param record 记录输出
+     * @return 0成功，-1超出范围
+     */
+    int HeapTraceGetLive(uint32_t index, HeapTraceRecord_t *record);
+
+    /**
+     * @brief 按序号获取任务占用统计
+     * @param index 任务序号，从0开始
+     * @param task 统计输出
+     * @return 0成功，-1超出范围或未使用
+     */
+    int HeapTraceGetTask(uint32_t index, HeapTraceTask_t *task);
+
+    /**
+     * @brief 按存活字节数排序的前几个分配点
+     * @param sites 输出数组，按字节数从大到小
+     * @param count 数组容量
+     * @return 实际输出数量
+     */
+    uint32_t HeapTraceTopSites(HeapTraceSite_t *sites, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_HEAPTRACE_H */
@@ -0,0 +1,126 @@
+/**
+ * @file logsink.h
+ * @brief 二进制日志输出模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 低优先级任务取出yLib_log中的记录，按输出掩码原样以帧发给上位机、在设备上展开为文本输出，
+ * 或追加到25Q中的循环日志区；上位机用tools/log_decode.py对照ELF展开帧和Flash导出的数据
+ *
+ * @par 帧格式:
+ * LOG_FRAME_ID帧，第一个字节为类型，多字节字段均为小端：
+ * - LOGSINK_HEADER:  'YLOG' | 版本u8 | 时钟频率u32 | 丢弃条数u32
+ * - LOGSINK_RECORDS: 若干条完整记录，每条为 记录头u32 | 时间戳u32 | 参数u32 * n
+ *
+ * @par Flash日志区:
+ * 开头两个扇区为yDev_smap扇区状态表，记录各日志扇区写满/正在写入/已擦除，打开时由它直接找到正在写入的扇区，
+ * 状态表无效或与扇区头不符时才读取全部扇区头并重建状态表。
+ * 其后的扇区组成环，每个扇区开头为 扇区头标识u32 | 序号u32，写满后擦除序号最小的扇区继续写：
+ * - 'YLGS'：其后紧接记录，记录不跨扇区，读到0xFFFFFFFF为止
+ * - 'YLGZ'：其后为若干块，每块是一次取出的记录，块头u32低16位为存放字节数、高16位为记录字节数，
+ *   两者相等时原样存放，否则为yLib_lz压缩数据；块从4字节对齐处开始，不跨扇区，读到0xFFFFFFFF为止。
+ *   每块单独压缩，断电后从最后一个完整的块之后继续写
+ * LOGSINK_FLASH_LZ选择新扇区的格式，导出时两种扇区都展开为记录帧
+ */
+
+#ifndef TASK_LOGSINK_H
+#define TASK_LOGSINK_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define LOG_FRAME_ID 0x4C        /**< 日志帧ID('L') */
+#define LOGSINK_VERSION 1        /**< 帧格式版本 */
+#define LOGSINK_SECTOR_MAGIC 0x53474C59UL    /**< 扇区头标识"YLGS" */
+#define LOGSINK_SECTOR_MAGIC_LZ 0x5A474C59UL /**< 压缩扇区头标识"YLGZ" */
+
+#define LOGSINK_FRAME (1U << 0) /**< 原样以帧发送 */
+#define LOGSINK_TEXT (1U << 1)  /**< 展开为文本从shell串口输出 */
+#define LOGSINK_FLASH (1U << 2) /**< 追加到25Q日志区 */
+
+#ifndef LOGSINK_DEFAULT
+#define LOGSINK_DEFAULT (LOGSINK_TEXT) /**< 启动时的输出掩码 */
+#endif
+#ifndef LOGSINK_FLASH_ADDRESS
+#define LOGSINK_FLASH_ADDRESS (0x70000UL) /**< 日志区在25Q中的地址，位于固件槽之后 */
+#endif
+#ifndef LOGSINK_FLASH_SIZE
+#define LOGSINK_FLASH_SIZE (0xF000UL)     /**< 日志区大小(含两个状态表扇区)，扇区整数倍且至少四个扇区，到故障转储保留区之前为止 */
+#endif
+#ifndef LOGSINK_FLASH_LZ
+#define LOGSINK_FLASH_LZ 1                /**< 为1时按块压缩写入日志区 */
+#endif
+#ifndef LOGSINK_PERIOD_MS
+#define LOGSINK_PERIOD_MS 20              /**< 轮询周期，队列过半时提前唤醒 */
+#endif
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 帧类型
+     */
+    typedef enum
+    {
+        LOGSINK_HEADER = 0,  /**< 头部 */
+        LOGSINK_RECORDS = 1, /**< 记录块 */
+    } LogSinkType_t;
+
+    /**
+     * @brief 输出统计
+     */
+    typedef struct
+    {
+        uint32_t mask;         /**< 当前输出掩码 */
+        uint32_t records;      /**< 取出的记录条数 */
+        uint32_t frame_fail;   /**< 发送队列满丢弃的帧数 */
+        uint32_t flash_words;  /**< 写入Flash的记录字数 */
+        uint32_t flash_bytes;  /**< 实际写入Flash的字节数，压缩时小于记录字数*4 */
+        uint32_t flash_sector; /**< 当前写入的扇区 */
+        uint32_t flash_seq;    /**< 当前扇区序号，0表示日志区不可用 */
+    } LogSinkStats_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 创建日志输出任务
+     */
+    void LogSinkInit(void);
+
+    /**
+     * @brief 设置输出掩码
+     * @param mask LOGSINK_FRAME/LOGSINK_TEXT/LOGSINK_FLASH的组合
+     * @note 打开LOGSINK_FRAME时先发送头部帧；打开LOGSINK_FLASH时首次访问25Q并找到续写位置
+     */
+    void LogSinkSetMask(uint32_t mask);
+
+    /**
+     * @brief 读取输出统计
+     * @param stats 输出的统计
+     */
+    void LogSinkGetStats(LogSinkStats_t *stats);
+
+    /**
+     * @brief 按先后顺序以帧发送Flash日志区中的全部记录
+     * @return 发送的记录条数，日志区不可用或发送失败返回-1
+     */
+    int32_t LogSinkFlashDump(void);
+
+    /**
+     * @brief 擦除Flash日志区
+     * @return 0成功，-1失败
+     */
+    int32_t LogSinkFlashErase(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_LOGSINK_H */
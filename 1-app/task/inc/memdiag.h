@@ -0,0 +1,130 @@
+/**
+ * @file memdiag.h
+ * @brief 内存与寄存器诊断模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 不接调试器时在现场读写内存和外设寄存器：地址先按片内存储区和外设区校验，
+ * 外设区只允许按字访问；大块内存通过帧协议以二进制流发给上位机，
+ * 上位机用tools/mem_decode.py拼回文件
+ *
+ * @par 导出格式:
+ * MEMDIAG_FRAME_ID帧，第一个字节为类型，多字节字段均为小端：
+ * - MEMDIAG_DATA: 地址u32 | 数据
+ * - MEMDIAG_END:  起始地址u32 | 实际发送长度u32，地址无效时长度为0
+ * - MEMDIAG_READ: 起始地址u32 | 长度u32，上位机发来的读取请求，按同样格式回复
+ *
+ * @par 寄存器表:
+ * 构建时由tools/svd_regmap.py从STM32G070.svd生成，没有Python时不生成，regdump命令不可用
+ */
+
+#ifndef TASK_MEMDIAG_H
+#define TASK_MEMDIAG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define MEMDIAG_FRAME_ID 0x4D        /**< 内存导出帧ID('M') */
+#define MEMDIAG_CHUNK 120            /**< 每帧数据长度，按字对齐且1 + 4 + 120不超过帧载荷上限 */
+#define REGMAP_NOREAD 0x8000         /**< 寄存器偏移中的不可读标志：只写或读出有副作用 */
+#define REGMAP_OFFSET(reg) ((reg)->offset & 0x7FFF) /**< 寄存器偏移 */
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 导出帧类型
+     */
+    typedef enum
+    {
+        MEMDIAG_DATA = 0, /**< 数据块 */
+        MEMDIAG_END = 1,  /**< 结束 */
+        MEMDIAG_READ = 2, /**< 读取请求 */
+    } MemDiagType_t;
+
+    /**
+     * @brief 寄存器表项
+     */
+    typedef struct
+    {
+        uint16_t name;   /**< 名称在字符串池中的偏移 */
+        uint16_t offset; /**< 相对外设基地址的偏移，最高位为REGMAP_NOREAD */
+    } RegMapReg_t;
+
+    /**
+     * @brief 外设表项
+     */
+    typedef struct
+    {
+        uint16_t name;  /**< 名称在字符串池中的偏移 */
+        uint16_t first; /**< 第一个寄存器在寄存器表中的序号 */
+        uint16_t count; /**< 寄存器数量 */
+        uint32_t base;  /**< 基地址 */
+    } RegMapPeriph_t;
+
+    /**
+     * @brief 寄存器表
+     */
+    typedef struct
+    {
+        const char *names;              /**< 字符串池 */
+        const RegMapReg_t *regs;        /**< 寄存器表 */
+        const RegMapPeriph_t *periphs;  /**< 外设表，按名称排序 */
+        uint16_t count;                 /**< 外设数量 */
+    } RegMap_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 检查地址区间是否可以访问
+     * @param addr 起始地址
+     * @param len 长度(字节)
+     * @param width 访问宽度(1/2/4)
+     * @param write 非0时检查是否可写
+     * @return 0可以访问，-1地址无效、未对齐或外设区不按字访问
+     * @note 片内Flash和系统存储区只读，外设区和内核外设区只能按字访问
+     */
+    int32_t MemDiagCheck(uint32_t addr, uint32_t len, uint32_t width, uint8_t write);
+
+    /**
+     * @brief 按访问宽度读取内存
+     * @param dst 目的缓冲区
+     * @param addr 起始地址，须已经MemDiagCheck
+     * @param len 长度(字节)，须为宽度的整数倍
+     * @param width 访问宽度(1/2/4)
+     */
+    void MemDiagRead(void *dst, uint32_t addr, uint32_t len, uint32_t width);
+
+    /**
+     * @brief 通过帧协议发送一段内存
+     * @param addr 起始地址
+     * @param len 长度(字节)
+     * @return 发送的字节数，地址无效或发送失败返回-1
+     * @note 起始地址和长度按字对齐时按字读取，外设区必须按字对齐；发送队列满时等待
+     */
+    int32_t MemDiagSend(uint32_t addr, uint32_t len);
+
+    /**
+     * @brief 按名称查找外设
+     * @param name 外设名，不区分大小写
+     * @return 外设表项，没有寄存器表或找不到时返回NULL
+     */
+    const RegMapPeriph_t *MemDiagFindPeriph(const char *name);
+
+    /**
+     * @brief 寄存器表，由构建生成
+     */
+    extern const RegMap_t regmap;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_MEMDIAG_H */
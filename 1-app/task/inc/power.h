@@ -0,0 +1,148 @@
+/**
+ * @file power.h
+ * @brief 能耗估算模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 按时间乘电流估算电荷：CPU的运行、睡眠和STOP时间来自无滴答空闲，设备唤醒时间来自yDev电源管理，
+ * 任务运行时间来自FreeRTOS运行时统计，各自乘以电流表中的电流得到电荷(nAh)。
+ * 电流表按数据手册取典型值，可在运行时按实测修改，用于比较各部分的占比而不是精确计量
+ *
+ * @par 统计口径:
+ * - 设备电流是该设备唤醒时在CPU之外额外消耗的平均电流，挂起时计为0
+ * - 任务运行时按CPU运行电流计；空闲任务的运行时间扣除睡眠和STOP时间，这两部分单独列出
+ * - 任务运行时间是32位微秒计数，由PowerProcess定期累加到64位，回绕前至少累加一次
+ */
+
+#ifndef TASK_POWER_H
+#define TASK_POWER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+
+/**
+ * @brief CPU运行电流(uA)，64MHz从Flash执行，外设时钟另计
+ */
+#ifndef POWER_CPU_RUN_UA
+#define POWER_CPU_RUN_UA 6000
+#endif
+
+/**
+ * @brief CPU睡眠(WFI)电流(uA)
+ */
+#ifndef POWER_CPU_SLEEP_UA
+#define POWER_CPU_SLEEP_UA 1700
+#endif
+
+/**
+ * @brief STOP1模式电流(uA)，含RTC和LSI
+ */
+#ifndef POWER_CPU_STOP_UA
+#define POWER_CPU_STOP_UA 6
+#endif
+
+/**
+ * @brief 电流表的设备项数上限，与设备注册表相同
+ */
+#ifndef POWER_DEVICE_MAX
+#define POWER_DEVICE_MAX 8
+#endif
+
+/**
+ * @brief 累计运行时间的任务数上限，按任务编号索引，编号超出的任务不统计
+ */
+#ifndef POWER_TASK_MAX
+#define POWER_TASK_MAX 16
+#endif
+
+/**
+ * @brief 任务运行时间的累加周期(毫秒)，须小于32位微秒计数的回绕周期(约71.6分钟)
+ */
+#ifndef POWER_FOLD_MS
+#define POWER_FOLD_MS 60000U
+#endif
+
+#define POWER_NAME_CPU_RUN "cpu.run"     /**< 电流表中CPU运行电流的名称 */
+#define POWER_NAME_CPU_SLEEP "cpu.sleep" /**< 电流表中CPU睡眠电流的名称 */
+#define POWER_NAME_CPU_STOP "cpu.stop"   /**< 电流表中STOP电流的名称 */
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 任务的累计运行统计
+     */
+    typedef struct
+    {
+        char name[16];     /**< 任务名，任务删除后保留 */
+        uint32_t number;   /**< 任务编号 */
+        uint64_t run_us;   /**< 累计运行时间(微秒) */
+        uint32_t switches; /**< 切入次数 */
+        uint8_t idle;      /**< 1=空闲任务 */
+    } PowerTask_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 累加任务运行时间
+     * @return uint32_t 距下次需要累加的毫秒数
+     * @note 由启动任务在最低优先级周期调用，读取统计时也会先累加一次
+     */
+    uint32_t PowerProcess(void);
+
+    /**
+     * @brief 读取任务的累计运行统计
+     * @param out 输出，按任务编号升序
+     * @param max 最多输出的项数
+     * @return uint32_t 输出的项数
+     */
+    uint32_t PowerGetTasks(PowerTask_t *out, uint32_t max);
+
+    /**
+     * @brief 清零任务、设备和CPU的累计统计
+     */
+    void PowerReset(void);
+
+    /**
+     * @brief 统计时长
+     * @return uint32_t 上电或上次清零以来的毫秒数
+     * @note CPU运行时间为统计时长减去睡眠和STOP时间
+     */
+    uint32_t PowerGetElapsedMs(void);
+
+    /**
+     * @brief 查询电流表
+     * @param name 设备注册名或POWER_NAME_CPU_xxx
+     * @return uint32_t 电流(uA)，表中没有的设备返回0
+     */
+    uint32_t PowerGetCurrent(const char *name);
+
+    /**
+     * @brief 修改电流表
+     * @param name 电流表中已有的名字或已注册的设备名
+     * @param ua 电流(uA)
+     * @return int32_t 0成功，-1设备未注册或表已满
+     */
+    int32_t PowerSetCurrent(const char *name, uint32_t ua);
+
+    /**
+     * @brief 按电流和时间计算电荷
+     * @param ua 电流(uA)
+     * @param us 时间(微秒)
+     * @return uint64_t 电荷(nAh)
+     */
+    uint64_t PowerCharge(uint32_t ua, uint64_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_POWER_H */
@@ -0,0 +1,121 @@
+/**
+ * @file prof.h
+ * @brief 统计采样分析器头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * M0+没有ITM/ETM，改用定时中断统计：TIM16按固定频率中断，取被打断上下文压栈的PC，
+ * 在函数表中找到所在函数后计入直方图，采样足够多时各函数的样本比例即CPU时间比例。
+ * 忙等循环、关中断过长之外的热点都能在不接调试器的情况下看到
+ *
+ * @par 函数表:
+ * 链接后由tools/prof_syms.py从ELF符号表生成，写入Flash中预留的.prof_syms段，
+ * 段大小固定，写入不改变其他段的地址。格式(小端)：
+ * - 头部：魔数u32 | 函数数u32 | 名字区偏移u32
+ * - 函数项：起始地址u32 | 长度u16 | 名字偏移u16，按地址升序
+ * - 名字区：以0结尾的字符串
+ * 未生成函数表或PC不在任何函数内时按PROF_GRANULE字节对齐的地址计数
+ *
+ * @par 限制:
+ * - 占用TIM16，采样中断为最高等级，同级的串口接收中断和关中断区间内不能被采样，
+ *   其样本落在开中断后的第一条指令上
+ * - 直方图满时新函数的样本只计入other
+ */
+
+#ifndef TASK_PROF_H
+#define TASK_PROF_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define PROF_SYMS_MAGIC 0x4D595350UL /**< 函数表魔数('PSYM') */
+#define PROF_GRANULE 32U             /**< 不在函数表中的PC按此对齐计数 */
+
+/**
+ * @brief 直方图项数，须为2的幂
+ */
+#ifndef PROF_BINS
+#define PROF_BINS 64
+#endif
+
+/**
+ * @brief 默认采样频率(Hz)，取与1ms节拍不同步的质数，避免和周期任务同相
+ */
+#ifndef PROF_RATE_DEFAULT
+#define PROF_RATE_DEFAULT 1009
+#endif
+
+/**
+ * @brief 函数表预留的Flash字节数，0=不预留
+ * @note 放不下时tools/prof_syms.py舍去最短的函数
+ */
+#ifndef PROF_SYMS_SIZE
+#define PROF_SYMS_SIZE 6144
+#endif
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 直方图中的一项
+     */
+    typedef struct
+    {
+        uint32_t addr;     /**< 函数起始地址，或对齐后的PC */
+        uint32_t count;    /**< 样本数 */
+        const char *name;  /**< 函数名，不在函数表中时为NULL */
+    } ProfEntry_t;
+
+    /**
+     * @brief 采样统计
+     */
+    typedef struct
+    {
+        uint32_t rate;     /**< 实际采样频率(Hz) */
+        uint32_t samples;  /**< 样本总数 */
+        uint32_t other;    /**< 直方图满未能计入的样本数 */
+        uint32_t symbols;  /**< 函数表中的函数数，0=没有函数表 */
+        uint8_t running;   /**< 正在采样 */
+    } ProfStats_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 清空直方图并开始采样
+     * @param rate 采样频率(Hz)，0取PROF_RATE_DEFAULT
+     * @return 按定时器分辨率取整后的实际频率(Hz)，参数超出范围返回-1
+     */
+    int32_t ProfStart(uint32_t rate);
+
+    /**
+     * @brief 停止采样，直方图保留
+     */
+    void ProfStop(void);
+
+    /**
+     * @brief 读取采样统计
+     * @param stats 输出
+     */
+    void ProfGetStats(ProfStats_t *stats);
+
+    /**
+     * @brief 取样本数最多的若干项
+     * @param out 输出，按样本数从多到少
+     * @param max 最多输出的项数
+     * @return 输出的项数
+     * @note 采样进行中也可调用，结果是调用时刻的近似值
+     */
+    uint32_t ProfTop(ProfEntry_t *out, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_PROF_H */
@@ -0,0 +1,154 @@
+/**
+ * @file selftest.h
+ * @brief 自检模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 自检项以SELFTEST_EXPORT登记到.selftest段，按类别掩码选择运行，逐项给出结果和耗时；
+ * 启动时按运行参数selftest.boot的掩码运行(默认只运行快速项)，shell的selftest命令可运行任意项
+ *
+ * @par 类别:
+ * - SELFTEST_QUICK: 毫秒级、不改写任何存储内容，适合每次上电运行
+ * - SELFTEST_SLOW: 耗时较长或改写保留的测试区
+ * - SELFTEST_MANUAL: 需要外部接线，只在shell中指定名称时运行
+ *
+ * @par 使用示例:
+ * @code
+ * static SelfTestResult_t AdcSelfTest(char *detail, uint32_t size)
+ * {
+ *     return (AdcReadVref() > 1000) ? SELFTEST_PASS : SELFTEST_FAIL;
+ * }
+ * SELFTEST_EXPORT(adc_vref, AdcSelfTest, SELFTEST_QUICK);
+ * @endcode
+ */
+
+#ifndef TASK_SELFTEST_H
+#define TASK_SELFTEST_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+#include "yLib_def.h"
+
+// ==================== 公共宏定义 ====================
+#define SELFTEST_QUICK (1U << 0)  /**< 快速、无副作用 */
+#define SELFTEST_SLOW (1U << 1)   /**< 耗时或改写测试区 */
+#define SELFTEST_MANUAL (1U << 2) /**< 需要外部接线 */
+#define SELFTEST_ALL (SELFTEST_QUICK | SELFTEST_SLOW)
+
+#define SELFTEST_DETAIL_MAX 48 /**< 结果说明的最大长度(含结束符) */
+
+#ifndef SELFTEST_RAM_BYTES
+#define SELFTEST_RAM_BYTES 1024 /**< RAM March测试从堆上借用的字节数 */
+#endif
+#ifndef SELFTEST_UART_NAME
+#define SELFTEST_UART_NAME "uart_lb" /**< 回环测试的串口注册名，TX与RX须短接，未注册时跳过 */
+#endif
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 自检结果
+     */
+    typedef enum
+    {
+        SELFTEST_PASS = 0, /*!< 通过 */
+        SELFTEST_FAIL,     /*!< 失败 */
+        SELFTEST_SKIP,     /*!< 条件不具备，未运行 */
+    } SelfTestResult_t;
+
+    /**
+     * @brief 自检项
+     */
+    typedef struct
+    {
+        const char *name; /*!< 名称 */
+
+        /**
+         * @brief 运行自检
+         * @param detail 结果说明缓冲区，已清空，可不填
+         * @param size 缓冲区大小
+         * @return SelfTestResult_t 结果
+         */
+        SelfTestResult_t (*run)(char *detail, uint32_t size);
+
+        uint32_t flags; /*!< 类别SELFTEST_xxx */
+    } SelfTest_t;
+
+    /**
+     * @brief 一项自检的报告
+     */
+    typedef struct
+    {
+        SelfTestResult_t result;          /*!< 结果 */
+        uint32_t us;                      /*!< 耗时(微秒) */
+        char detail[SELFTEST_DETAIL_MAX]; /*!< 结果说明 */
+    } SelfTestReport_t;
+
+    /**
+     * @brief 报告回调
+     * @param arg 用户参数
+     * @param test 自检项
+     * @param report 报告
+     */
+    typedef void (*SelfTestNotify_t)(void *arg, const SelfTest_t *test, const SelfTestReport_t *report);
+
+    /**
+     * @brief 登记自检项
+     * @param _name 名称，同时用于生成表项名
+     * @param _func 自检函数
+     * @param _flags 类别
+     */
+#define SELFTEST_EXPORT(_name, _func, _flags) \
+    YLIB_USED const SelfTest_t selftest_##_name YLIB_SECTION(".selftest") = {#_name, _func, _flags}
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 按序号取自检项
+     * @param index 序号，从0开始
+     * @return const SelfTest_t* 自检项，超出范围返回NULL
+     */
+    const SelfTest_t *SelfTestIterate(uint32_t index);
+
+    /**
+     * @brief 按名称查找自检项
+     * @return const SelfTest_t* 自检项，不存在返回NULL
+     */
+    const SelfTest_t *SelfTestFind(const char *name);
+
+    /**
+     * @brief 运行一项自检并计时
+     * @param test 自检项
+     * @param report 输出报告
+     * @return SelfTestResult_t 结果
+     */
+    SelfTestResult_t SelfTestRunOne(const SelfTest_t *test, SelfTestReport_t *report);
+
+    /**
+     * @brief 运行类别掩码选中的全部自检项
+     * @param mask 类别掩码
+     * @param notify 每项完成后的回调，NULL时结果写入yLib_log
+     * @param arg 回调参数
+     * @return uint32_t 失败的项数
+     */
+    uint32_t SelfTestRun(uint32_t mask, SelfTestNotify_t notify, void *arg);
+
+    /**
+     * @brief 获取结果名称
+     * @param result 结果
+     * @return const char* "pass"、"FAIL"或"skip"
+     */
+    const char *SelfTestResultName(SelfTestResult_t result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_SELFTEST_H */
@@ -0,0 +1,206 @@
+/**
+ * @file sensor.h
+ * @brief 传感器采样管理模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 传感器驱动只声明一次采样事务(命令字节和读回长度)、采样周期和解码函数，
+ * 由一个采样任务统一调度：每次唤醒把到期的全部传感器按总线合并，
+ * SPI总线上的一批在一次总线作业内完成(yDevSpiBusBatch，参数相同的器件由DMA中断接续)，
+ * IIC传感器在传输结束中断中接续下一个，与SPI批量同时进行；
+ * 读回的原始数据带结束时刻的微秒时间戳，解码后写入各订阅者的环形队列
+ *
+ * @par 使用示例:
+ * @code
+ * static const uint8_t accel_cmd[] = {0x80 | 0x28};
+ * static uint32_t AccelDecode(const Sensor_t *sensor, const uint8_t *raw, int32_t *value)
+ * {
+ *     value[0] = (int16_t)(raw[0] | (raw[1] << 8));
+ *     value[1] = (int16_t)(raw[2] | (raw[3] << 8));
+ *     value[2] = (int16_t)(raw[4] | (raw[5] << 8));
+ *     return 3;
+ * }
+ * static Sensor_t accel = {.name = "accel", .bus = SENSOR_BUS_SPI, .dev = &accel_spi,
+ *                          .cmd = accel_cmd, .cmd_len = 1, .raw_len = 6, .period_ms = 10,
+ *                          .decode = AccelDecode};
+ * (void)SensorRegister(&accel);
+ * @endcode
+ */
+
+#ifndef TASK_SENSOR_H
+#define TASK_SENSOR_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+#include "yDrv_spi.h"
+#include "yLib_ring.h"
+#include "msgbus.h"
+
+// ==================== 公共宏定义 ====================
+#ifndef SENSOR_MAX
+#define SENSOR_MAX 16            /**< 最多登记的传感器数，订阅者按编号位图过滤 */
+#endif
+#ifndef SENSOR_RAW_MAX
+#define SENSOR_RAW_MAX 16        /**< 单次采样读回的最大字节数 */
+#endif
+#ifndef SENSOR_VALUES_MAX
+#define SENSOR_VALUES_MAX 4      /**< 单次采样解码出的最多数值个数 */
+#endif
+#ifndef SENSOR_IDLE_MS
+#define SENSOR_IDLE_MS 100       /**< 没有传感器时的检查间隔，新登记的传感器最迟在此之后开始采样 */
+#endif
+#ifndef SENSOR_IIC_TIMEOUT_MS
+#define SENSOR_IIC_TIMEOUT_MS 10 /**< IIC每个传感器的传输超时 */
+#endif
+
+_Static_assert(SENSOR_MAX <= 32, "sensor subscriber mask is 32 bits");
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 传感器所在的总线类型
+     */
+    typedef enum
+    {
+        SENSOR_BUS_SPI = 0, /*!< dev为yDevSpiBusDevice_t* */
+        SENSOR_BUS_IIC,     /*!< dev为yDevHandle_Iic_t* */
+    } SensorBus_t;
+
+    typedef struct Sensor Sensor_t;
+
+    /**
+     * @brief 解码函数
+     * @param sensor 传感器
+     * @param raw 读回的原始数据，raw_len字节
+     * @param value 输出数值，最多SENSOR_VALUES_MAX个
+     * @return uint32_t 输出的数值个数
+     * @note 在采样任务中调用
+     */
+    typedef uint32_t (*SensorDecode_t)(const Sensor_t *sensor, const uint8_t *raw, int32_t *value);
+
+    /**
+     * @brief 传感器
+     * @note 驱动填写前半部分后登记，之后只能由采样模块修改；结构体在登记后必须一直有效
+     */
+    struct Sensor
+    {
+        const char *name;      /*!< 名称 */
+        SensorBus_t bus;       /*!< 总线类型 */
+        void *dev;             /*!< 总线器件 */
+        uint16_t addr;         /*!< IIC 7位从机地址 */
+        const uint8_t *cmd;    /*!< SPI: 片选内先发送的命令；IIC: 重复起始前写入的寄存器地址 */
+        uint8_t cmd_len;       /*!< 命令字节数，可为0 */
+        uint8_t raw_len;       /*!< 读回字节数，1~SENSOR_RAW_MAX */
+        uint16_t period_ms;    /*!< 采样周期 */
+        SensorDecode_t decode; /*!< 解码函数，NULL时不输出数值 */
+
+        /* 以下由采样模块维护 */
+        uint32_t due_ms;               /*!< 下次采样时刻 */
+        uint32_t time_us;              /*!< 最近一次采样结束的时间戳 */
+        uint32_t samples;              /*!< 成功次数 */
+        uint32_t errors;               /*!< 失败次数 */
+        uint16_t id;                   /*!< 编号，登记顺序 */
+        volatile uint8_t status;       /*!< 最近一次结果，0成功 */
+        yDrvSpiSeg_t seg[2];           /*!< SPI分段：命令和读回 */
+        uint8_t raw[SENSOR_RAW_MAX];   /*!< 读回的原始数据 */
+    };
+
+    /**
+     * @brief 发布给订阅者的采样
+     */
+    typedef struct
+    {
+        uint32_t time_us;                  /*!< 传输结束时刻(yDrvGetTimeUs) */
+        uint16_t sensor;                   /*!< 传感器编号 */
+        uint8_t status;                    /*!< 0成功，非0时没有数值 */
+        uint8_t count;                     /*!< 数值个数 */
+        int32_t value[SENSOR_VALUES_MAX];  /*!< 解码后的数值 */
+    } SensorSample_t;
+
+    /**
+     * @brief 采样主题，载荷为SensorSample_t(放在pbuf中)
+     * @note 与订阅者环形队列并行，在采样任务中发布；没有订阅者时不分配pbuf
+     */
+    MSGBUS_TOPIC_DECLARE(sensor);
+
+    /**
+     * @brief 订阅者
+     * @note ring的元素为SensorSample_t，采样任务是唯一的生产者，订阅者是唯一的消费者；
+     *       队列满时新采样丢弃并计数
+     */
+    typedef struct SensorSub
+    {
+        struct ylib_ring *ring; /*!< 接收队列 */
+        uint32_t mask;          /*!< 关心的传感器编号位图，0为全部 */
+        void *task;             /*!< 每批有新采样时通知的任务(xTaskNotifyGive)，可为NULL */
+        uint32_t dropped;       /*!< 队列满丢弃的采样数 */
+        struct SensorSub *next; /*!< 订阅链表 */
+    } SensorSub_t;
+
+    /**
+     * @brief 统计信息
+     */
+    typedef struct
+    {
+        uint32_t batches;     /*!< 有采样的唤醒次数 */
+        uint32_t samples;     /*!< 成功采样数 */
+        uint32_t errors;      /*!< 失败采样数 */
+        uint32_t late;        /*!< 错过整个周期而重新对齐的次数 */
+        uint32_t max_busy_us; /*!< 单批从开始传输到发布完的最长时间 */
+        uint32_t sensors;     /*!< 已登记的传感器数 */
+    } SensorStats_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 创建采样任务
+     */
+    void SensorInit(void);
+
+    /**
+     * @brief 登记传感器
+     * @param sensor 传感器，驱动部分已填好
+     * @return int32_t 编号，-1参数无效或已满
+     * @note IIC传感器的设备句柄由采样模块独占，登记时接管其传输结束回调
+     */
+    int32_t SensorRegister(Sensor_t *sensor);
+
+    /**
+     * @brief 按编号取传感器
+     * @param id 编号
+     * @return Sensor_t* 传感器，不存在返回NULL
+     */
+    Sensor_t *SensorGet(uint32_t id);
+
+    /**
+     * @brief 订阅采样
+     * @param sub 订阅者，ring已初始化；结构体在订阅后必须一直有效
+     */
+    void SensorSubscribe(SensorSub_t *sub);
+
+    /**
+     * @brief 取出一个采样
+     * @param sub 订阅者
+     * @param sample 输出
+     * @return int32_t 1取到，0队列为空
+     */
+    int32_t SensorRead(SensorSub_t *sub, SensorSample_t *sample);
+
+    /**
+     * @brief 读取统计信息
+     * @param stats 输出
+     */
+    void SensorGetStats(SensorStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_SENSOR_H */
@@ -14,6 +14,64 @@
 
 #include "shell.h"
 
+/**
+ * @brief 隧道shell会话帧ID('S')
+ * @note 载荷为终端文本，上位机发来的是输入，设备回复的是输出；
+ *       收到第一帧时建立会话，与串口文本会话各有缓冲和历史记录
+ */
+#define SHELL_TUNNEL_FRAME_ID 0x53
+
+/**
+ * @brief 性能回归测试结果帧ID('P')
+ * @note perfsuite每项结果一帧，载荷为：类型u8 | 数值u32(小端) | 名称(不含结尾0)；
+ *       最后一帧类型为PERF_KIND_END，数值为结果项数，名称为主频如"64MHz"。
+ *       上位机tools/perf_check.py收集后与基线比较
+ */
+#define PERF_FRAME_ID 0x50
+#define PERF_KIND_CYCLES 0U   /**< CPU周期，越小越好 */
+#define PERF_KIND_US 1U       /**< 微秒，越小越好 */
+#define PERF_KIND_KBPS 2U     /**< 吞吐量KB/s，越大越好 */
+#define PERF_KIND_END 0xFFU   /**< 结束帧 */
+#define PERF_NAME_MAX 24U     /**< 名称最大长度 */
+
+/**
+ * @brief perfsuite串口回环测试的波特率
+ */
+#ifndef PERF_UART_BAUD
+#define PERF_UART_BAUD 921600U
+#endif
+
+/**
+ * @brief 每个会话的输入和历史记录缓冲默认大小
+ * @note 运行时大小由shell.buf参数决定，缓冲区从yLib堆分配
+ */
+#ifndef SERIAL_SHELL_BUFFER
+#define SERIAL_SHELL_BUFFER 512
+#endif
+
+/**
+ * @brief 长命令工作任务的堆栈大小(字)
+ * @note 带SHELL_CMD_LONG的命令在工作任务中执行，与shell任务的命令是同一批函数，堆栈大小相同
+ */
+#ifndef SERIAL_SHELL_WORKER_STACK
+#define SERIAL_SHELL_WORKER_STACK 512
+#endif
+
+/**
+ * @brief 长命令工作任务的优先级
+ * @note 低于shell任务，长命令执行期间输入和帧照常处理
+ */
+#ifndef SERIAL_SHELL_WORKER_PRIO
+#define SERIAL_SHELL_WORKER_PRIO 9
+#endif
+
 void ShellTaskInit(void);
 
+/**
+ * @brief 请求按运行参数更换缓冲区
+ * @note 唤醒shell任务，由它在处理完已收到的输入后按uart.rxbuf、uart.txbuf、shell.buf
+ *       重新分配串口收发缓冲区和shell缓冲区；任意任务中可调用
+ */
+void ShellTaskResize(void);
+
 #endif
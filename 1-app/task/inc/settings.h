@@ -0,0 +1,174 @@
+/**
+ * @file settings.h
+ * @brief 运行参数模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 把原来写死在各模块配置结构体里的参数(串口波特率、Flash超时、LED模式等)集中到一张参数表，
+ * 启动时从25Q的KV存储一次读入RAM影子，读取只访问RAM；修改后标记为脏，
+ * 安静一段时间后把整张表作为一条KV记录写入，连续调整多个参数只编程一次
+ *
+ * @par 存储格式:
+ * KV键SETTINGS_KV_KEY，值为 参数个数u32 | 参数值u32 * n，参数按表中顺序存放；
+ * 新参数只能追加在表尾，旧固件保存的记录缺少的参数保持默认值
+ *
+ * @par 缓冲区大小:
+ * 串口收发缓冲区和shell行缓冲区的大小也是参数，缓冲区从yLib堆分配；
+ * 读入或修改后由shell任务在处理完当前输入后更换缓冲区，不需要重启
+ */
+
+#ifndef TASK_SETTINGS_H
+#define TASK_SETTINGS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#ifndef SETTINGS_KV_ADDRESS
+#define SETTINGS_KV_ADDRESS (0x61000UL) /**< KV存储区在25Q中的地址，位于固件槽B之后、日志区之前 */
+#endif
+#ifndef SETTINGS_KV_SECTORS
+#define SETTINGS_KV_SECTORS 2           /**< KV存储区扇区数，至少两个 */
+#endif
+#ifndef SETTINGS_KV_KEYS
+#define SETTINGS_KV_KEYS 8              /**< KV存储区的键数上限，索引节点静态分配 */
+#endif
+#ifndef SETTINGS_SAVE_DELAY_MS
+#define SETTINGS_SAVE_DELAY_MS 2000     /**< 最后一次修改后等待多久写入Flash */
+#endif
+#define SETTINGS_KV_KEY "settings"      /**< 参数表的KV键 */
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 参数编号，与参数表顺序一致
+     */
+    typedef enum
+    {
+        SETTING_UART_BAUD = 0, /*!< 通信串口波特率 */
+        SETTING_FLASH_TIMEOUT, /*!< 25Q操作超时(毫秒) */
+        SETTING_FLASH_IDLE,    /*!< 25Q空闲挂起时间(毫秒) */
+        SETTING_LED_PATTERN,   /*!< 上电后的LED闪烁模式 */
+        SETTING_SELFTEST_BOOT, /*!< 启动时运行的自检类别掩码 */
+        SETTING_UART_RXBUF,    /*!< 通信串口接收缓冲区大小(字节) */
+        SETTING_UART_TXBUF,    /*!< 通信串口发送队列大小(字节) */
+        SETTING_SHELL_BUF,     /*!< shell输入和历史记录缓冲区大小(字节) */
+        SETTING_MAX
+    } SettingId_t;
+
+    /**
+     * @brief 参数信息
+     */
+    typedef struct
+    {
+        const char *name; /*!< 参数名，shell中使用 */
+        uint32_t def;     /*!< 默认值 */
+        uint32_t min;     /*!< 最小值 */
+        uint32_t max;     /*!< 最大值 */
+    } SettingInfo_t;
+
+    /**
+     * @brief 统计信息
+     */
+    typedef struct
+    {
+        uint32_t loaded; /*!< 启动时从Flash读入的参数个数 */
+        uint32_t sets;   /*!< 修改次数 */
+        uint32_t saves;  /*!< 写入Flash的次数 */
+        uint32_t errors; /*!< 挂载或写入失败次数 */
+        uint8_t mounted; /*!< KV存储已挂载 */
+        uint8_t dirty;   /*!< 有尚未写入的修改 */
+    } SettingsStats_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 读取参数
+     * @param id 参数编号
+     * @return uint32_t 参数值，编号无效时返回0
+     * @note 只读RAM影子，任意任务和中断中都可调用；Flash读入之前返回默认值
+     */
+    uint32_t SettingsGet(SettingId_t id);
+
+    /**
+     * @brief 修改参数
+     * @param id 参数编号
+     * @param value 新值
+     * @return int32_t 0成功，-1编号无效或超出范围
+     *
+     * @par 功能描述:
+     * 更新RAM影子并立即作用到对应模块，延迟SETTINGS_SAVE_DELAY_MS后由SettingsProcess写入Flash；
+     * 值不变时不标记为脏
+     */
+    int32_t SettingsSet(SettingId_t id, uint32_t value);
+
+    /**
+     * @brief 按名称查找参数
+     * @param name 参数名
+     * @return int32_t 参数编号，未找到返回-1
+     */
+    int32_t SettingsFind(const char *name);
+
+    /**
+     * @brief 获取参数信息
+     * @param id 参数编号
+     * @return const SettingInfo_t* 参数信息，编号无效时返回NULL
+     */
+    const SettingInfo_t *SettingsInfo(SettingId_t id);
+
+    /**
+     * @brief 立即写入尚未保存的修改
+     * @return int32_t 0成功或没有修改，-1 KV存储不可用或写入失败
+     */
+    int32_t SettingsSave(void);
+
+    /**
+     * @brief 全部参数恢复默认值
+     * @note 与修改参数相同，延迟写入Flash
+     */
+    void SettingsReset(void);
+
+    /**
+     * @brief 延迟写入处理
+     * @return uint32_t 距下次需要处理的毫秒数，没有待写入的修改时返回0xFFFFFFFF
+     * @note 由启动任务在最低优先级周期调用，Flash编程不占用应用任务
+     */
+    uint32_t SettingsProcess(void);
+
+    /**
+     * @brief 读取统计信息
+     * @param stats 输出
+     */
+    void SettingsGetStats(SettingsStats_t *stats);
+
+    /**
+     * @brief 读取与参数表共用KV存储的其他记录
+     * @param key 记录键，不能为SETTINGS_KV_KEY
+     * @param data 输出缓冲区
+     * @param len 缓冲区大小
+     * @return int32_t 记录长度，-1 KV存储不可用或记录不存在
+     */
+    int32_t SettingsRecordGet(const char *key, void *data, uint16_t len);
+
+    /**
+     * @brief 写入与参数表共用KV存储的其他记录
+     * @param key 记录键，不能为SETTINGS_KV_KEY
+     * @param data 记录内容
+     * @param len 记录长度，不超过YDEV_KV_VALUE_MAX
+     * @return int32_t 0成功，-1 KV存储不可用或写入失败
+     * @note 立即写入Flash，只用于很少更新的记录，例如缓冲区用量的历史峰值
+     */
+    int32_t SettingsRecordSet(const char *key, const void *data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_SETTINGS_H */
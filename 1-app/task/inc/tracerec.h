@@ -0,0 +1,81 @@
+/**
+ * @file tracerec.h
+ * @brief 跟踪记录导出模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 把yLib_trace中的二进制记录通过帧协议发给上位机，或先保存到外部Flash再导出，
+ * 上位机用tools/trace_decode.py还原为文本时间线或Chrome/Perfetto跟踪文件
+ *
+ * @par 导出格式:
+ * 每段数据作为一个TRACE_FRAME_ID帧的载荷，第一个字节为类型，多字节字段均为小端：
+ * - TRACEREC_HEADER: 'YTRC' | 版本u8 | 记录长度u8 | 时钟频率u32 | 记录条数u32 | 丢弃条数u32
+ * - TRACEREC_TASK:   任务编号u32 | 任务名(不含结尾0)
+ * - TRACEREC_RECORDS: 若干条struct ylib_trace_rec原样拷贝
+ * - TRACEREC_END:    实际导出的记录条数u32
+ * 保存到Flash时每段为 长度u8 | 载荷，从头部段读到结束段为止
+ */
+
+#ifndef TASK_TRACEREC_H
+#define TASK_TRACEREC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define TRACE_FRAME_ID 0x54        /**< 跟踪导出帧ID('T') */
+#define TRACEREC_VERSION 1         /**< 导出格式版本 */
+#define TRACEREC_MAX_TASKS 12      /**< 导出任务名的最大任务数 */
+#define TRACEREC_CHUNK_RECORDS 15  /**< 每段记录条数，1 + 15 * 8 = 121字节不超过帧载荷上限 */
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 导出段类型
+     */
+    typedef enum
+    {
+        TRACEREC_HEADER = 0,  /**< 头部 */
+        TRACEREC_TASK = 1,    /**< 任务编号与任务名 */
+        TRACEREC_RECORDS = 2, /**< 记录块 */
+        TRACEREC_END = 3,     /**< 结束 */
+    } TraceRecType_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 取出全部记录并通过帧协议发送
+     * @return 发送的记录条数，发送失败返回-1
+     * @note 记录期间也可调用，发送过程中新产生的记录留在队列中
+     */
+    int32_t TraceRecSend(void);
+
+    /**
+     * @brief 取出全部记录保存到外部Flash
+     * @param flash 25Q设备句柄
+     * @param address 起始地址，须扇区对齐
+     * @return 保存的记录条数，失败返回-1
+     * @note 先擦除足够容纳整个记录队列的扇区
+     */
+    int32_t TraceRecSave(void *flash, uint32_t address);
+
+    /**
+     * @brief 读出TraceRecSave保存的数据并通过帧协议发送
+     * @param flash 25Q设备句柄
+     * @param address 起始地址
+     * @return 发送的段数，数据无效或发送失败返回-1
+     */
+    int32_t TraceRecSendFlash(void *flash, uint32_t address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_TRACEREC_H */
@@ -0,0 +1,120 @@
+/**
+ * @file watch.h
+ * @brief 变量定时采样模块头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 由软件定时器按固定频率采样一组变量，样本先存入环形缓冲区，
+ * 再由发起采样的任务以帧或文本形式发出；采样时只通过启动时解析好的指针读取，
+ * 不再查找变量，上位机用tools/watch_decode.py还原为CSV
+ *
+ * @par 导出格式:
+ * WATCH_FRAME_ID帧，第一个字节为类型，多字节字段均为小端：
+ * - WATCH_START: 实际采样频率u32 | 变量数u8
+ * - WATCH_DATA:  第一个样本的序号u32 | 变量数u8 | 若干个样本，每个样本按变量顺序各一个i32
+ * - WATCH_END:   样本总数u32 | 缓冲区满丢弃的样本数u32
+ * 丢弃的样本也占序号，序号不连续处即为丢弃位置
+ */
+
+#ifndef TASK_WATCH_H
+#define TASK_WATCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#define WATCH_FRAME_ID 0x57 /**< 变量采样帧ID('W') */
+#define WATCH_VARS_MAX 8    /**< 同时采样的变量数上限 */
+
+/**
+ * @brief 样本缓冲区大小(字)，每个样本占变量数 + 1个字
+ */
+#ifndef WATCH_RING_WORDS
+#define WATCH_RING_WORDS 128
+#endif
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 采样帧类型
+     */
+    typedef enum
+    {
+        WATCH_START = 0, /**< 开始 */
+        WATCH_DATA = 1,  /**< 样本块 */
+        WATCH_END = 2,   /**< 结束 */
+    } WatchType_t;
+
+    /**
+     * @brief 被采样的变量
+     * @note get不为NULL时调用get(addr)取值，否则按width从addr直接读取并带符号扩展
+     */
+    typedef struct
+    {
+        const volatile void *addr; /**< 变量地址，或get的参数 */
+        int (*get)(void *);        /**< 取值函数，可为NULL */
+        uint8_t width;             /**< 变量宽度(1/2/4) */
+    } WatchVar_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 开始采样
+     * @param vars 变量表，内容被复制
+     * @param count 变量数量，不超过WATCH_VARS_MAX
+     * @param rate 采样频率(Hz)
+     * @return 按系统节拍取整后的实际频率(Hz)，参数错误或已在采样返回-1
+     * @note 缓冲区中的样本够一帧时通知调用任务，调用任务负责取出样本
+     */
+    int32_t WatchStart(const WatchVar_t *vars, uint32_t count, uint32_t rate);
+
+    /**
+     * @brief 停止采样
+     * @return 缓冲区满丢弃的样本数
+     * @note 缓冲区中剩余的样本仍可取出
+     */
+    uint32_t WatchStop(void);
+
+    /**
+     * @brief 取出样本
+     * @param values 输出缓冲区，每个样本按变量顺序存放
+     * @param max 最多取出的样本数
+     * @param seq 输出第一个样本的序号
+     * @return 取出的样本数，取出的样本序号连续
+     */
+    uint32_t WatchRead(int32_t *values, uint32_t max, uint32_t *seq);
+
+    /**
+     * @brief 每个WATCH_DATA帧能容纳的样本数
+     */
+    uint32_t WatchFrameSamples(void);
+
+    /**
+     * @brief 以帧发送缓冲区中的样本
+     * @param all 非0时连不满一帧的样本也发出
+     * @return 发送的样本数，发送失败返回-1
+     * @note 发送队列满时等待后重试
+     */
+    int32_t WatchSend(uint8_t all);
+
+    /**
+     * @brief 发送WATCH_START或WATCH_END帧
+     * @param type WATCH_START/WATCH_END
+     * @param a WATCH_START为实际频率，WATCH_END为样本总数
+     * @param b WATCH_START为变量数，WATCH_END为丢弃的样本数
+     * @return 0成功，-1发送失败
+     */
+    int32_t WatchSendMark(WatchType_t type, uint32_t a, uint32_t b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_WATCH_H */
@@ -0,0 +1,124 @@
+/**
+ * @file watchdog.h
+ * @brief 看门狗服务头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 关键任务登记各自的心跳期限并在循环中报到，监视定时器周期检查所有任务，
+ * 全部按时报到才喂独立看门狗；某个任务超期时以YDRV_FAULT_WATCHDOG记录该任务名和超期时间后复位，
+ * 下次启动由crashdump转存到25Q，shell的fault命令可查看
+ *
+ * @par 兜底:
+ * 定时器任务本身停止运行(中断风暴、关中断死循环)时不再喂狗，IWDG在WATCHDOG_IWDG_MS后复位，
+ * 这种复位没有故障记录，启动时按复位标志写一条日志
+ *
+ * @par 使用示例:
+ * @code
+ * int32_t wdg = WatchdogRegister("Sample", 1000);
+ * for (;;)
+ * {
+ *     WatchdogCheckin(wdg);
+ *     (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+ *     ...
+ * }
+ * @endcode
+ */
+
+#ifndef TASK_WATCHDOG_H
+#define TASK_WATCHDOG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include <stdint.h>
+
+// ==================== 公共宏定义 ====================
+#ifndef WATCHDOG_TASKS_MAX
+#define WATCHDOG_TASKS_MAX 8        /**< 最多登记的任务数 */
+#endif
+#ifndef WATCHDOG_PERIOD_MS
+#define WATCHDOG_PERIOD_MS 250      /**< 监视周期，同时限制了低功耗时的最长睡眠 */
+#endif
+#ifndef WATCHDOG_IWDG_MS
+#define WATCHDOG_IWDG_MS 2000       /**< IWDG超时时间，0不启动IWDG(只做心跳检查) */
+#endif
+#ifndef WATCHDOG_DEADLINE_MS
+#define WATCHDOG_DEADLINE_MS 5000   /**< 没有特别要求的任务使用的心跳期限 */
+#endif
+
+    // ==================== 公共类型定义 ====================
+
+    /**
+     * @brief 登记的任务信息
+     */
+    typedef struct
+    {
+        const char *name;     /*!< 名称，记录到故障记录中 */
+        uint32_t deadline_ms; /*!< 心跳期限 */
+        uint32_t age_ms;      /*!< 距上次报到的时间 */
+        uint32_t worst_ms;    /*!< 监视时见到的最长间隔 */
+        uint32_t checkins;    /*!< 报到次数 */
+        uint8_t suspended;    /*!< 暂停监视 */
+    } WatchdogInfo_t;
+
+    /**
+     * @brief 统计信息
+     */
+    typedef struct
+    {
+        uint32_t checks;      /*!< 监视次数 */
+        uint32_t kicks;       /*!< 喂狗次数 */
+        uint32_t iwdg_ms;     /*!< IWDG超时时间，0未启动 */
+        uint8_t iwdg_reset;   /*!< 上一次复位由IWDG引起 */
+    } WatchdogStats_t;
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 登记任务
+     * @param name 名称，须为常量字符串
+     * @param deadline_ms 心跳期限(毫秒)，须大于WATCHDOG_PERIOD_MS
+     * @return int32_t 登记号，-1登记表已满或期限无效
+     * @note 登记即视为报到一次
+     */
+    int32_t WatchdogRegister(const char *name, uint32_t deadline_ms);
+
+    /**
+     * @brief 报到
+     * @param id 登记号，-1时忽略
+     * @note 只写时间戳，任意任务和中断中都可调用
+     */
+    void WatchdogCheckin(int32_t id);
+
+    /**
+     * @brief 暂停或恢复监视
+     * @param id 登记号
+     * @param suspend 1暂停，0恢复并视为报到一次
+     * @note 预计会超期阻塞的操作(如整片擦除)前后调用，IWDG仍由监视定时器照常喂
+     */
+    void WatchdogSuspend(int32_t id, uint8_t suspend);
+
+    /**
+     * @brief 读取登记的任务信息
+     * @param id 登记号
+     * @param info 输出
+     * @return int32_t 0成功，-1该登记号未使用
+     */
+    int32_t WatchdogGetInfo(int32_t id, WatchdogInfo_t *info);
+
+    /**
+     * @brief 读取统计信息
+     * @param stats 输出
+     */
+    void WatchdogGetStats(WatchdogStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_WATCHDOG_H */
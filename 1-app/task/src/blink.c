@@ -1,111 +1,255 @@
 /**
  * @file blink.c
- * @brief LED闪烁任务模块实现
- * @version 1.0
+ * @brief LED闪烁模式模块实现
+ * @version 2.0
  * @date 2025
  * @author YLab Development Team
  *
  * @par 功能描述:
- * 实现LED闪烁任务，根据按键按下次数控制不同的LED闪烁模式
- * 支持多种闪烁频率和常亮/关闭状态控制
+ * 闪烁模式由步骤表描述，单次定时器只在步骤边沿唤醒一次，常亮、常灭和呼吸不需要唤醒；
+ * 呼吸由DMA在每个PWM载波周期写入比较值，CPU不参与。
+ * 模式状态只在定时器任务中修改：步骤推进在定时器回调中，按键通知来自消抖定时器回调，
+ * 其他任务的切换请求经xTimerPendFunctionCall转入定时器任务，不需要加锁
  */
 
 // ==================== 包含文件 ====================
+#include "blink.h"
 #include "FreeRTOS.h"
-#include "task.h"
+#include "timers.h"
+#include "os_static.h"
 #include "switch.h"
-#include "communication.h"
 
 // ==================== 私有宏定义 ====================
-#define LED_TASK_PRIO 6  /**< LED任务优先级 */
-#define LED_STK_SIZE 512 /**< LED任务堆栈大小 */
+#define BLINK_LEVEL_BREATHE (0xFFU) /**< 步骤亮度标记：循环播放呼吸亮度表 */
+#define BLINK_STEPS(s) (s), (uint8_t)(sizeof(s) / sizeof((s)[0])) /**< 步骤表及步骤数 */
+
+// ==================== 私有类型 ====================
+
+/**
+ * @brief 闪烁步骤
+ */
+typedef struct
+{
+    uint8_t level; /*!< 亮度(0~SWITCH_LED_LEVELS)或BLINK_LEVEL_BREATHE */
+    uint16_t ms;   /*!< 持续时间(毫秒)，0表示保持到下一次切换 */
+} BlinkStep_t;
+
+/**
+ * @brief 闪烁模式描述
+ */
+typedef struct
+{
+    const char *name;         /*!< 模式名称 */
+    const BlinkStep_t *steps; /*!< 步骤表 */
+    uint8_t count;            /*!< 步骤数 */
+    uint8_t repeat;           /*!< 播放遍数，0表示循环并成为基础模式 */
+} BlinkDesc_t;
+
+// ==================== 私有常量 ====================
+
+/**
+ * @brief 呼吸亮度表，每项一个10ms载波周期，一个周期2秒
+ */
+static const uint16_t blink_breath[200] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   1,   1,   1,   2,   2,   3,   4,   5,   5,   6,   7,   8,  10,  11,  12,  13,
+     15,  16,  18,  19,  21,  22,  24,  26,  27,  29,  31,  33,  35,  36,  38,  40,  42,  44,  46,  48,
+     50,  52,  54,  56,  58,  60,  62,  64,  65,  67,  69,  71,  73,  74,  76,  78,  79,  81,  82,  84,
+     85,  87,  88,  89,  90,  92,  93,  94,  95,  95,  96,  97,  98,  98,  99,  99,  99, 100, 100, 100,
+    100, 100, 100, 100,  99,  99,  99,  98,  98,  97,  96,  95,  95,  94,  93,  92,  90,  89,  88,  87,
+     85,  84,  82,  81,  79,  78,  76,  74,  73,  71,  69,  67,  65,  64,  62,  60,  58,  56,  54,  52,
+     50,  48,  46,  44,  42,  40,  38,  36,  35,  33,  31,  29,  27,  26,  24,  22,  21,  19,  18,  16,
+     15,  13,  12,  11,  10,   8,   7,   6,   5,   5,   4,   3,   2,   2,   1,   1,   1,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+static const BlinkStep_t blink_off[] = {{0, 0}};
+static const BlinkStep_t blink_on[] = {{SWITCH_LED_LEVELS, 0}};
+static const BlinkStep_t blink_normal[] = {{SWITCH_LED_LEVELS, 500}, {0, 500}};
+static const BlinkStep_t blink_slow[] = {{SWITCH_LED_LEVELS, 1000}, {0, 1000}};
+static const BlinkStep_t blink_slower[] = {{SWITCH_LED_LEVELS, 5000}, {0, 5000}};
+static const BlinkStep_t blink_breathe[] = {{BLINK_LEVEL_BREATHE, 0}};
+static const BlinkStep_t blink_error[] = {{SWITCH_LED_LEVELS, 150}, {0, 150}, {SWITCH_LED_LEVELS, 150},
+                                          {0, 150}, {SWITCH_LED_LEVELS, 150}, {0, 1000}};
+static const BlinkStep_t blink_ack[] = {{SWITCH_LED_LEVELS, 80}, {0, 80}, {SWITCH_LED_LEVELS, 80}, {0, 80}};
+
+/**
+ * @brief 模式表，按BlinkPattern_t排列
+ */
+static const BlinkDesc_t blink_patterns[BLINK_PATTERN_MAX] = {
+    [BLINK_OFF] = {"off", BLINK_STEPS(blink_off), 0},
+    [BLINK_ON] = {"on", BLINK_STEPS(blink_on), 0},
+    [BLINK_NORMAL] = {"normal", BLINK_STEPS(blink_normal), 0},
+    [BLINK_SLOW] = {"slow", BLINK_STEPS(blink_slow), 0},
+    [BLINK_SLOWER] = {"slower", BLINK_STEPS(blink_slower), 0},
+    [BLINK_BREATHE] = {"breathe", BLINK_STEPS(blink_breathe), 0},
+    [BLINK_ERROR] = {"error", BLINK_STEPS(blink_error), 0},
+    [BLINK_ACK] = {"ack", BLINK_STEPS(blink_ack), 1},
+};
+
+/**
+ * @brief 按键计数窗口结束时按下次数对应的模式，超出按最后一项
+ */
+static const BlinkPattern_t blink_button_patterns[] = {BLINK_NORMAL, BLINK_SLOW, BLINK_SLOWER, BLINK_OFF};
 
 // ==================== 私有变量 ====================
-TaskHandle_t LedTask_Handler; /**< LED任务句柄 */
+OS_TIMER_DEFINE(blink_timer);
 
-static uint32_t button_press_count;
+static TimerHandle_t blink_timer;          /**< 步骤定时器，单次 */
+static const BlinkDesc_t *blink_desc;      /**< 正在播放的模式 */
+static BlinkStep_t blink_hold;             /**< 按键常亮的临时步骤 */
+static BlinkDesc_t blink_hold_desc;        /**< 按键常亮的临时模式 */
+static volatile BlinkPattern_t blink_base; /**< 基础模式 */
+static uint32_t blink_step;                /**< 当前步骤 */
+static uint32_t blink_loops;               /**< 已播放的遍数 */
 
-// ==================== 公共函数实现 ====================
+// ==================== 私有函数 ====================
 
 /**
- * @brief LED闪烁任务处理函数
- * @param pvParameters 任务参数（未使用）
- *
- * @par 功能描述:
- * LED任务主循环，根据按键状态和按下次数控制LED闪烁模式：
- * - 按键未按下：LED常亮
- * - 按键按下0次：正常闪烁（500ms间隔）
- * - 按键按下1次：慢闪烁（1000ms间隔）
- * - 按键按下2次：超慢闪烁（5000ms间隔）
- * - 按键按下3次及以上：LED关闭
+ * @brief 输出当前步骤并定时到下一个边沿
  */
-void BlinkTaskProcess(void *pvParameters)
+static void blink_apply(void)
 {
-    // 抑制未使用参数警告
-    (void)pvParameters;
-
-    // 初始化按键计数
-    button_press_count = 0;
+    const BlinkStep_t *step = &blink_desc->steps[blink_step];
 
-    // 初始化开关模块
-    SwitchInit();
+    if (step->level == BLINK_LEVEL_BREATHE)
+    {
+        // 没有空闲DMA通道时保持常亮
+        (void)SwitchPlay(blink_breath, sizeof(blink_breath) / sizeof(blink_breath[0]));
+    }
+    else
+    {
+        SwitchLevel(step->level);
+    }
 
-    // 任务主循环
-    for (;;)
+    // 在定时器任务中发出的命令不等待，回调返回后立即处理
+    if (step->ms == 0U)
     {
+        (void)xTimerStop(blink_timer, 0);
+    }
+    else
+    {
+        (void)xTimerChangePeriod(blink_timer, pdMS_TO_TICKS(step->ms), 0);
+    }
+}
 
-        // 检查按键状态
-        if (SwitchRead(SWITCH_TYPE_BUTTON) != 0)
-        {
-            // 按键未按下，获取按键按下计数
-            button_press_count = SwitchGetLog();
-        }
-        else
+/**
+ * @brief 从第一步开始播放模式
+ * @param desc 模式描述
+ */
+static void blink_start(const BlinkDesc_t *desc)
+{
+    blink_desc = desc;
+    blink_step = 0;
+    blink_loops = 0;
+    blink_apply();
+}
+
+/**
+ * @brief 按键事件通知，在定时器任务中调用
+ *
+ * @par 功能描述:
+ * 按下期间和计数窗口内常亮：松开后定时到窗口结束，按住超过窗口时保持常亮直到松开；
+ * 窗口结束后按计数选择基础模式
+ */
+static void blink_button(void)
+{
+    uint32_t count;
+
+    if (SwitchRead(SWITCH_TYPE_BUTTON) != 0U)
+    {
+        count = SwitchGetLog();
+        if (count >= (sizeof(blink_button_patterns) / sizeof(blink_button_patterns[0])))
         {
-            // 按键按下，LED常亮
-            SwitchCtrl(SWITCH_TYPE_LED, 1);
-            vTaskDelay(pdMS_TO_TICKS(500));
-            continue;
+            count = (sizeof(blink_button_patterns) / sizeof(blink_button_patterns[0])) - 1U;
         }
+        blink_base = blink_button_patterns[count];
+        blink_start(&blink_patterns[blink_base]);
+        return;
+    }
 
-        // 根据按键按下次数控制LED闪烁模式
-        switch (button_press_count)
+    // 窗口已满仍读到0说明按键还按着，等松开的事件
+    blink_hold.level = SWITCH_LED_LEVELS;
+    blink_hold.ms = (uint16_t)SwitchWindowLeft();
+    blink_hold_desc.steps = &blink_hold;
+    blink_hold_desc.count = 1;
+    blink_hold_desc.repeat = 1;
+    blink_start(&blink_hold_desc);
+}
+
+/**
+ * @brief 步骤定时器回调，推进到下一步
+ * @param timer 定时器句柄
+ */
+static void blink_timer_callback(TimerHandle_t timer)
+{
+    (void)timer;
+
+    if (blink_desc == &blink_hold_desc)
+    {
+        blink_button();
+        return;
+    }
+
+    if (++blink_step >= blink_desc->count)
+    {
+        blink_step = 0;
+        if ((blink_desc->repeat != 0U) && (++blink_loops >= blink_desc->repeat))
         {
-        case 0:
-            // 正常闪烁模式：500ms间隔翻转
-            SwitchCtrl(SWITCH_TYPE_LED, 2);
-            vTaskDelay(pdMS_TO_TICKS(500));
-            break;
-        case 1:
-            // 慢闪烁模式：1000ms间隔翻转
-            SwitchCtrl(SWITCH_TYPE_LED, 2);
-            vTaskDelay(pdMS_TO_TICKS(1000));
-            break;
-        case 2:
-            // 超慢闪烁模式：5000ms间隔翻转
-            SwitchCtrl(SWITCH_TYPE_LED, 2);
-            vTaskDelay(pdMS_TO_TICKS(5000));
-            break;
-        default:
-            // 按下3次及以上：LED关闭
-            SwitchCtrl(SWITCH_TYPE_LED, 0);
-            vTaskDelay(pdMS_TO_TICKS(1000));
-            break;
+            blink_start(&blink_patterns[blink_base]);
+            return;
         }
     }
+    blink_apply();
 }
+
 /**
- * @brief 初始化LED闪烁任务
- *
- * @par 功能描述:
- * 创建LED闪烁任务，设置任务名称、堆栈大小和优先级
+ * @brief 切换模式，经xTimerPendFunctionCall在定时器任务中执行
+ * @param param 未使用
+ * @param pattern 闪烁模式
  */
-void BlinkTaskInit(void)
+static void blink_play_pended(void *param, uint32_t pattern)
+{
+    (void)param;
+
+    if (blink_patterns[pattern].repeat == 0U)
+    {
+        blink_base = (BlinkPattern_t)pattern;
+    }
+    blink_start(&blink_patterns[pattern]);
+}
+
+// ==================== 公共函数实现 ====================
+
+void BlinkInit(void)
+{
+    SwitchInit();
+
+    blink_base = BLINK_NORMAL;
+    blink_hold_desc.name = "button";
+    blink_timer = OS_TIMER_CREATE(blink_timer, "blink", 1, pdFALSE, NULL, blink_timer_callback);
+    SwitchSetNotify(blink_button);
+
+    // 没有按键时正常闪烁
+    (void)BlinkPlay(BLINK_NORMAL);
+}
+
+int32_t BlinkPlay(BlinkPattern_t pattern)
+{
+    if (((uint32_t)pattern >= BLINK_PATTERN_MAX) || (blink_timer == NULL))
+    {
+        return -1;
+    }
+
+    return (xTimerPendFunctionCall(blink_play_pended, NULL, (uint32_t)pattern, 0) == pdPASS) ? 0 : -1;
+}
+
+BlinkPattern_t BlinkGetPattern(void)
+{
+    return blink_base;
+}
+
+const char *BlinkPatternName(BlinkPattern_t pattern)
 {
-    xTaskCreate(BlinkTaskProcess, // 任务函数
-                "LedTask",        // 任务名称
-                LED_STK_SIZE,     // 堆栈大小
-                NULL,             // 任务参数
-                LED_TASK_PRIO,    // 任务优先级
-                NULL);            // 任务句柄
+    return ((uint32_t)pattern < BLINK_PATTERN_MAX) ? blink_patterns[pattern].name : NULL;
 }
@@ -0,0 +1,129 @@
+/**
+ * @file crashdump.c
+ * @brief 故障现场转储模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 采集钩子在关中断的故障现场运行，只读内存：任务名取自当前TCB，堆状态取统计变量
+ * (不遍历可能已损坏的堆)，跟踪记录从环形队列尾部复制而不移除；
+ * Flash中只保存一条记录，启动时按次数和校验判断是否已经保存过，热复位不会重复擦写
+ */
+
+// ==================== 包含文件 ====================
+#include "crashdump.h"
+#include "flash.h"
+#include "yDev_25q.h"
+#include "yLib_heap.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+
+_Static_assert(sizeof(CrashDumpExtra_t) <= YDRV_FAULT_EXTRA_SIZE, "CrashDumpExtra_t exceeds YDRV_FAULT_EXTRA_SIZE");
+
+// ==================== 私有变量 ====================
+static yDrvFaultRecord_t crash_record; /**< 读写Flash的记录缓冲区 */
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 故障记录保存地址，Flash末尾的FLASH_CRASHDUMP_RESERVED保留区
+ */
+static uint32_t crash_dump_address(yDevHandle_25q_t *flash)
+{
+    return flash->size - FLASH_CRASHDUMP_RESERVED;
+}
+
+/**
+ * @brief 故障采集钩子
+ */
+static void crash_dump_capture(yDrvFaultRecord_t *record)
+{
+    CrashDumpExtra_t *extra = (CrashDumpExtra_t *)record->extra;
+    TaskHandle_t task;
+    const char *name;
+    uint32_t i;
+
+    // 中断中出错时为被打断的任务，由psr的异常号区分
+    if ((record->name[0] == '\0') && (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED))
+    {
+        task = xTaskGetCurrentTaskHandle();
+        if (task != NULL)
+        {
+            name = pcTaskGetName(task);
+            for (i = 0; (i < YDRV_FAULT_NAME_LEN - 1U) && (name[i] != '\0'); i++)
+            {
+                record->name[i] = name[i];
+            }
+        }
+    }
+
+#if configHEAP_STATS_ENABLE
+    extra->heap_free = (uint32_t)ylib_get_free_heap_size();
+    extra->heap_min = (uint32_t)ylib_get_minimum_ever_free_heap_size();
+#endif
+    extra->trace_hz = ylib_trace_clock_hz();
+    extra->trace_count = ylib_trace_peek_tail(extra->trace, CRASHDUMP_TRACE_RECORDS);
+    record->extra_len = sizeof(*extra);
+}
+
+// ==================== 公共函数 ====================
+
+void CrashDumpInit(void)
+{
+    yDrvFaultRegisterHook(crash_dump_capture);
+}
+
+int32_t CrashDumpSave(void *flash)
+{
+    yDevHandle_25q_t *dev = (yDevHandle_25q_t *)flash;
+    uint32_t address;
+    uint32_t saved[2];
+
+    if (yDrvFaultGet(&crash_record) == 0)
+        return 0;
+    // 器件容量在初始化时读出，记录地址依赖它
+    if ((dev == NULL) || (yDevProbe(dev) != YDEV_OK))
+        return -1;
+
+    // count和check都相同说明上次启动已经保存过这条记录
+    address = crash_dump_address(dev);
+    if ((yDev25qRead(dev, address + offsetof(yDrvFaultRecord_t, count), &saved[0], 4) == 4) &&
+        (yDev25qRead(dev, address + offsetof(yDrvFaultRecord_t, check), &saved[1], 4) == 4) &&
+        (saved[0] == crash_record.count) && (saved[1] == crash_record.check))
+        return 0;
+
+    if (yDevIoctl(dev, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK)
+        return -1;
+    dev->address = address;
+    if (yDevWrite(dev, &crash_record, sizeof(crash_record)) != (int32_t)sizeof(crash_record))
+        return -1;
+    return 1;
+}
+
+const yDrvFaultRecord_t *CrashDumpLoad(void *flash)
+{
+    yDevHandle_25q_t *dev = (yDevHandle_25q_t *)flash;
+
+    if ((dev == NULL) || (yDevProbe(dev) != YDEV_OK))
+        return NULL;
+    if (yDev25qRead(dev, crash_dump_address(dev), &crash_record, sizeof(crash_record)) !=
+        (int32_t)sizeof(crash_record))
+        return NULL;
+    if ((yDrvFaultValid(&crash_record) == 0) || (crash_record.type == YDRV_FAULT_NONE) ||
+        (crash_record.extra_len > YDRV_FAULT_EXTRA_SIZE))
+        return NULL;
+    return &crash_record;
+}
+
+int32_t CrashDumpErase(void *flash)
+{
+    yDevHandle_25q_t *dev = (yDevHandle_25q_t *)flash;
+    uint32_t address;
+
+    if ((dev == NULL) || (yDevProbe(dev) != YDEV_OK))
+        return -1;
+    address = crash_dump_address(dev);
+    return (yDevIoctl(dev, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) == YDEV_OK) ? 0 : -1;
+}
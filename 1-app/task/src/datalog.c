@@ -0,0 +1,536 @@
+/**
+ * @file datalog.c
+ * @brief 采样数据记录模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 各段的序号、起始时间和记录数在首次访问时读入RAM，之后换段和查询都不再读段头；
+ * 段内的写入位置用二分查找第一条未写入的记录得到。追加、换段和读取在datalog_lock内进行，
+ * 查询按块读出后释放锁再调用回调，串口输出期间不阻塞追加
+ */
+
+// ==================== 包含文件 ====================
+#include "datalog.h"
+#include "flash.h"
+#include "os_lock.h"
+#include "os_static.h"
+#include "yDev.h"
+#include "yDev_25q.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define DATALOG_SEGMENTS (DATALOG_FLASH_SIZE / YDEV_25Q_SECTOR_SIZE)
+#define DATALOG_HEADER 16U                                   /**< 段头字节数 */
+#define DATALOG_PER_SEGMENT ((YDEV_25Q_SECTOR_SIZE - DATALOG_HEADER) / sizeof(DataLogRecord_t))
+#define DATALOG_COUNT_OFFSET 12U                             /**< 段头中记录数的偏移 */
+#define DATALOG_ERASED 0xFFFFFFFFUL                          /**< 未写入的时间和记录数 */
+#define DATALOG_WAIT_TICKS 100                               /**< 等待异步编程完成的滴答数上限 */
+
+_Static_assert(DATALOG_SEGMENTS >= 3, "datalog needs at least three segments");
+_Static_assert(DATALOG_BATCH * sizeof(DataLogRecord_t) <= YDEV_25Q_PAGE_SIZE, "DATALOG_BATCH exceeds one page");
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 段头
+ */
+typedef struct
+{
+    uint32_t magic; /**< DATALOG_MAGIC */
+    uint32_t seq;   /**< 段序号，越大越新 */
+    uint32_t start; /**< 第一条记录的时间 */
+    uint32_t count; /**< 记录数，写满前为DATALOG_ERASED */
+} DataLogHeader_t;
+
+/**
+ * @brief 记录器状态
+ */
+typedef struct
+{
+    yDevHandle_25q_t *dev;                 /**< 25Q句柄，未打开时为NULL */
+    uint32_t head;                         /**< 当前段 */
+    uint32_t time;                         /**< 当前时间 */
+    uint32_t last_ms;                      /**< time对应的系统毫秒数 */
+    uint32_t last;                         /**< 最新记录的时间 */
+    uint32_t seq[DATALOG_SEGMENTS];        /**< 段序号，0为无效段 */
+    uint32_t start[DATALOG_SEGMENTS];      /**< 段起始时间 */
+    uint16_t used[DATALOG_SEGMENTS];       /**< 段中已编程的记录数 */
+    uint8_t page;                          /**< 正在填充的页缓冲 */
+    uint8_t fill;                          /**< 页缓冲中的记录数 */
+    volatile uint8_t flash_fail;           /**< 异步编程失败，在定时器服务任务中置位 */
+} DataLog_t;
+
+// ==================== 私有变量 ====================
+OS_LOCK_DEFINE(datalog_lock);
+
+static DataLog_t datalog;
+static DataLogStats_t datalog_stats;
+static DataLogRecord_t datalog_page[2][DATALOG_BATCH]; /**< 页缓冲 */
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 段在25Q中的地址
+ */
+static uint32_t data_log_segment_address(uint32_t seg)
+{
+    return DATALOG_FLASH_ADDRESS + seg * YDEV_25Q_SECTOR_SIZE;
+}
+
+/**
+ * @brief 记录在25Q中的地址
+ */
+static uint32_t data_log_record_address(uint32_t seg, uint32_t index)
+{
+    return data_log_segment_address(seg) + DATALOG_HEADER + index * sizeof(DataLogRecord_t);
+}
+
+/**
+ * @brief 读取一条记录的时间
+ * @return 时间，读取失败时按未写入处理
+ */
+static uint32_t data_log_read_time(uint32_t seg, uint32_t index)
+{
+    uint32_t time;
+
+    if (yDev25qRead(datalog.dev, data_log_record_address(seg, index), &time, sizeof(time)) != (int32_t)sizeof(time))
+        return DATALOG_ERASED;
+    return time;
+}
+
+/**
+ * @brief 二分查找段内第一条时间不小于time的记录
+ * @param seg 段号
+ * @param count 查找范围内的记录数
+ * @param time 时间，DATALOG_ERASED时查找第一条未写入的记录
+ * @return 记录序号，全部小于time时返回count
+ */
+static uint32_t data_log_search(uint32_t seg, uint32_t count, uint32_t time)
+{
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    uint32_t mid;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2U;
+        if (data_log_read_time(seg, mid) < time)
+            lo = mid + 1U;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief 当前时间，按系统毫秒数推进，系统毫秒数回绕不影响
+ */
+static uint32_t data_log_now(void)
+{
+    uint32_t ticks = ((uint32_t)yDevGetTimeMS() - datalog.last_ms) / DATALOG_TICK_MS;
+
+    datalog.last_ms += ticks * DATALOG_TICK_MS;
+    datalog.time += ticks;
+    if (datalog.time >= DATALOG_ERASED)
+        datalog.time = DATALOG_ERASED - 1U;
+    return datalog.time;
+}
+
+/**
+ * @brief 异步编程完成回调
+ */
+static void data_log_program_done(void *arg, yDevStatus_t status)
+{
+    (void)arg;
+    if (status != YDEV_OK)
+        datalog.flash_fail = 1;
+}
+
+/**
+ * @brief 等待异步编程结束
+ * @return 0空闲，-1超时或编程失败
+ */
+static int32_t data_log_wait(void)
+{
+    uint32_t ticks;
+
+    for (ticks = 0; yDev25qIsAsyncBusy(datalog.dev); ticks++)
+    {
+        if (ticks >= DATALOG_WAIT_TICKS)
+            return -1;
+        vTaskDelay(1);
+    }
+    if (datalog.flash_fail)
+    {
+        datalog.flash_fail = 0;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 同步写入
+ */
+static int32_t data_log_write(uint32_t address, const void *data, uint32_t len)
+{
+    datalog.dev->address = address;
+    return (yDevWrite(datalog.dev, data, len) == (int32_t)len) ? 0 : -1;
+}
+
+/**
+ * @brief 把当前页缓冲交给异步编程并切换到另一个缓冲
+ * @return 0成功，-1失败，缓冲中的记录丢弃
+ */
+static int32_t data_log_flush(void)
+{
+    uint32_t address;
+    uint32_t len;
+
+    if (datalog.fill == 0)
+        return 0;
+
+    address = data_log_record_address(datalog.head, datalog.used[datalog.head]);
+    len = datalog.fill * sizeof(DataLogRecord_t);
+    if ((data_log_wait() != 0) ||
+        (yDev25qWriteAsync(datalog.dev, address, datalog_page[datalog.page], len, data_log_program_done, NULL) !=
+         YDEV_OK))
+    {
+        datalog_stats.failed += datalog.fill;
+        datalog.fill = 0;
+        return -1;
+    }
+
+    datalog.used[datalog.head] = (uint16_t)(datalog.used[datalog.head] + datalog.fill);
+    datalog.page ^= 1U;
+    datalog.fill = 0;
+    return 0;
+}
+
+/**
+ * @brief 提前擦除一段
+ * @note 后台擦除队列满时同步擦除
+ */
+static int32_t data_log_erase_ahead(uint32_t seg)
+{
+    uint32_t address = data_log_segment_address(seg);
+
+    datalog.seq[seg] = 0;
+    datalog.used[seg] = 0;
+    if (yDev25qEraseAsync(datalog.dev, address, YDEV_25Q_SECTOR_SIZE) == YDEV_OK)
+        return 0;
+    return (yDevIoctl(datalog.dev, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) == YDEV_OK) ? 0 : -1;
+}
+
+/**
+ * @brief 启用一段并提前擦除下一段
+ * @note 段头的同步写入等待该段的后台擦除完成
+ */
+static int32_t data_log_start(uint32_t seg, uint32_t seq, uint32_t time)
+{
+    DataLogHeader_t header = {DATALOG_MAGIC, seq, time, DATALOG_ERASED};
+
+    if (data_log_write(data_log_segment_address(seg), &header, sizeof(header)) != 0)
+        return -1;
+    datalog.seq[seg] = seq;
+    datalog.start[seg] = time;
+    datalog.used[seg] = 0;
+    datalog.head = seg;
+    return data_log_erase_ahead((seg + 1U) % DATALOG_SEGMENTS);
+}
+
+/**
+ * @brief 当前段写满，补写记录数后换到下一段
+ * @param time 新段第一条记录的时间
+ */
+static int32_t data_log_roll(uint32_t time)
+{
+    uint32_t count;
+
+    if ((data_log_flush() != 0) || (data_log_wait() != 0))
+        return -1;
+    count = datalog.used[datalog.head];
+    if (data_log_write(data_log_segment_address(datalog.head) + DATALOG_COUNT_OFFSET, &count, sizeof(count)) != 0)
+        return -1;
+
+    datalog_stats.rolls++;
+    return data_log_start((datalog.head + 1U) % DATALOG_SEGMENTS, datalog.seq[datalog.head] + 1U, time);
+}
+
+/**
+ * @brief 打开存储区：读入段头，定位写入位置，时间从最后一条记录继续
+ * @return 0成功，-1 25Q不可用或容量不足
+ * @note 调用者持有datalog_lock
+ */
+static int32_t data_log_open(void)
+{
+    DataLogHeader_t header;
+    yDevHandle_25q_t *dev;
+    uint32_t seg;
+    uint32_t count;
+
+    if (datalog.dev != NULL)
+        return 0;
+
+    // 末尾保留区留给故障转储
+    dev = FlashGetHandle();
+    if ((dev == NULL) || (dev->size < FLASH_CRASHDUMP_RESERVED) ||
+        (DATALOG_FLASH_ADDRESS + DATALOG_FLASH_SIZE > dev->size - FLASH_CRASHDUMP_RESERVED))
+        return -1;
+
+    datalog.dev = dev;
+    datalog.last_ms = (uint32_t)yDevGetTimeMS();
+    for (seg = 0; seg < DATALOG_SEGMENTS; seg++)
+    {
+        datalog.seq[seg] = 0;
+        datalog.used[seg] = 0;
+        if ((yDev25qRead(dev, data_log_segment_address(seg), &header, sizeof(header)) != (int32_t)sizeof(header)) ||
+            (header.magic != DATALOG_MAGIC) || (header.seq == 0) || (header.seq == DATALOG_ERASED))
+            continue;
+
+        datalog.seq[seg] = header.seq;
+        datalog.start[seg] = header.start;
+        count = header.count;
+        if (count > DATALOG_PER_SEGMENT)
+            count = data_log_search(seg, DATALOG_PER_SEGMENT, DATALOG_ERASED);
+        datalog.used[seg] = (uint16_t)count;
+        if (header.seq > datalog.seq[datalog.head])
+            datalog.head = seg;
+    }
+
+    if (datalog.seq[datalog.head] == 0)
+    {
+        datalog.time = 0;
+        datalog.last = 0;
+        if ((yDev25qEraseAsync(dev, DATALOG_FLASH_ADDRESS, DATALOG_FLASH_SIZE) != YDEV_OK) ||
+            (data_log_start(0, 1, 0) != 0))
+        {
+            datalog.dev = NULL;
+            return -1;
+        }
+        return 0;
+    }
+
+    seg = datalog.head;
+    datalog.last = (datalog.used[seg] != 0) ? data_log_read_time(seg, datalog.used[seg] - 1U) : datalog.start[seg];
+    datalog.time = datalog.last;
+
+    // 上次可能在擦除下一段之前掉电
+    if (data_log_erase_ahead((seg + 1U) % DATALOG_SEGMENTS) != 0)
+    {
+        datalog.dev = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 创建互斥量
+ * @retval 0
+ * @note 以YDEV_INIT_DEVICE级别导出，在应用任务创建之前执行；存储区在首次访问时打开
+ */
+static int32_t DataLogInit(void)
+{
+    OsLockInit(&datalog_lock, "datalog");
+    return 0;
+}
+YDEV_INIT_EXPORT(DataLogInit, YDEV_INIT_DEVICE);
+
+// ==================== 公共函数 ====================
+
+int32_t DataLogAppend(uint16_t channel, uint16_t flags, int32_t value)
+{
+    DataLogRecord_t *rec;
+    uint32_t time;
+    int32_t ret = 0;
+
+    (void)OsLockTake(&datalog_lock, portMAX_DELAY);
+    if (data_log_open() != 0)
+    {
+        datalog_stats.failed++;
+        OsLockGive(&datalog_lock);
+        return -1;
+    }
+
+    time = data_log_now();
+    if ((datalog.used[datalog.head] + datalog.fill >= DATALOG_PER_SEGMENT) && (data_log_roll(time) != 0))
+    {
+        datalog_stats.failed++;
+        OsLockGive(&datalog_lock);
+        return -1;
+    }
+
+    rec = &datalog_page[datalog.page][datalog.fill++];
+    rec->time = time;
+    rec->channel = channel;
+    rec->flags = flags;
+    rec->value = value;
+    datalog.last = time;
+    datalog_stats.appended++;
+
+    // 编程失败时缓冲中的记录计入failed
+    if ((datalog.fill >= DATALOG_BATCH) || (datalog.used[datalog.head] + datalog.fill >= DATALOG_PER_SEGMENT))
+        ret = data_log_flush();
+    OsLockGive(&datalog_lock);
+    return ret;
+}
+
+int32_t DataLogSync(void)
+{
+    int32_t ret = -1;
+
+    (void)OsLockTake(&datalog_lock, portMAX_DELAY);
+    if ((data_log_open() == 0) && (data_log_flush() == 0))
+        ret = data_log_wait();
+    OsLockGive(&datalog_lock);
+    return ret;
+}
+
+int32_t DataLogQuery(uint32_t from, uint32_t to, DataLogVisit_t visit, void *arg)
+{
+    DataLogRecord_t rec[DATALOG_BATCH];
+    uint32_t order[DATALOG_SEGMENTS];
+    uint32_t n = 0;
+    uint32_t k;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t seg;
+    uint32_t seq;
+    uint32_t index;
+    uint32_t m;
+    uint32_t c;
+    int32_t total = 0;
+
+    (void)OsLockTake(&datalog_lock, portMAX_DELAY);
+    if ((data_log_open() != 0) || (data_log_flush() != 0) || (data_log_wait() != 0))
+    {
+        OsLockGive(&datalog_lock);
+        return -1;
+    }
+
+    // 从当前段之后按环的顺序排列有效段，最后是当前段
+    for (k = 1; k <= DATALOG_SEGMENTS; k++)
+    {
+        seg = (datalog.head + k) % DATALOG_SEGMENTS;
+        if ((datalog.seq[seg] != 0) && (datalog.used[seg] != 0))
+            order[n++] = seg;
+    }
+
+    // 段头二分：最后一个起始时间不大于from的段，再在段内二分到第一条不早于from的记录
+    lo = 0;
+    hi = n;
+    while (lo < hi)
+    {
+        k = lo + (hi - lo) / 2U;
+        if (datalog.start[order[k]] <= from)
+            lo = k + 1U;
+        else
+            hi = k;
+    }
+    k = (lo != 0) ? (lo - 1U) : 0U;
+    index = (n != 0) ? data_log_search(order[k], datalog.used[order[k]], from) : 0U;
+    OsLockGive(&datalog_lock);
+
+    for (; k < n; k++, index = 0)
+    {
+        seg = order[k];
+        seq = datalog.seq[seg];
+        for (;;)
+        {
+            (void)OsLockTake(&datalog_lock, portMAX_DELAY);
+            if (datalog.seq[seg] != seq)
+            {
+                // 查询期间这一段已被换段擦除
+                OsLockGive(&datalog_lock);
+                return total;
+            }
+            if (index >= datalog.used[seg])
+            {
+                OsLockGive(&datalog_lock);
+                break;
+            }
+            m = datalog.used[seg] - index;
+            if (m > DATALOG_BATCH)
+                m = DATALOG_BATCH;
+            if ((data_log_wait() != 0) ||
+                (yDev25qRead(datalog.dev, data_log_record_address(seg, index), rec, m * sizeof(DataLogRecord_t)) !=
+                 (int32_t)(m * sizeof(DataLogRecord_t))))
+            {
+                OsLockGive(&datalog_lock);
+                return -1;
+            }
+            OsLockGive(&datalog_lock);
+
+            for (c = 0; (c < m) && (rec[c].time <= to); c++)
+            {
+            }
+            if (c != 0)
+            {
+                total += (int32_t)c;
+                if (visit(arg, rec, c) != 0)
+                    return total;
+            }
+            if (c < m)
+                return total;
+            index += m;
+        }
+    }
+
+    return total;
+}
+
+int32_t DataLogErase(void)
+{
+    uint32_t seg;
+    int32_t ret = -1;
+
+    (void)OsLockTake(&datalog_lock, portMAX_DELAY);
+    if ((data_log_open() == 0) && (data_log_wait() == 0))
+    {
+        datalog.fill = 0;
+        for (seg = 0; seg < DATALOG_SEGMENTS; seg++)
+        {
+            datalog.seq[seg] = 0;
+            datalog.used[seg] = 0;
+        }
+        if (yDev25qEraseAsync(datalog.dev, DATALOG_FLASH_ADDRESS, DATALOG_FLASH_SIZE) == YDEV_OK)
+            ret = data_log_start(0, 1, data_log_now());
+    }
+    OsLockGive(&datalog_lock);
+    return ret;
+}
+
+int32_t DataLogGetStats(DataLogStats_t *stats)
+{
+    uint32_t seg;
+    uint32_t k;
+
+    (void)OsLockTake(&datalog_lock, portMAX_DELAY);
+    if (data_log_open() != 0)
+    {
+        OsLockGive(&datalog_lock);
+        return -1;
+    }
+
+    *stats = datalog_stats;
+    stats->segments = 0;
+    stats->records = datalog.fill;
+    stats->first = datalog.last;
+    for (k = 1; k <= DATALOG_SEGMENTS; k++)
+    {
+        seg = (datalog.head + k) % DATALOG_SEGMENTS;
+        if (datalog.seq[seg] == 0)
+            continue;
+        if (stats->segments++ == 0)
+            stats->first = datalog.start[seg];
+        stats->records += datalog.used[seg];
+    }
+    stats->last = datalog.last;
+    stats->now = data_log_now();
+    OsLockGive(&datalog_lock);
+    return 0;
+}
@@ -0,0 +1,418 @@
+/**
+ * @file fwupdate.c
+ * @brief 固件升级接收模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 帧处理在帧解码所在的任务中执行：数据拷入两个页缓冲之一，满一页即交给25Q异步编程，
+ * 同时填另一页；只有上一页尚未编程完时才等待，串口接收由DMA环形缓冲承接。
+ * 槽的擦除在25Q后台擦除任务中进行，擦除期间数据帧回复忙。
+ * 压缩传输时数据经yLib_lz流式解压直接写入页缓冲，解压窗口1KB，CRC按解压后的数据计算
+ */
+
+// ==================== 包含文件 ====================
+#include "fwupdate.h"
+#include "flash.h"
+#include "frame.h"
+#include "latency.h"
+#include "yLib_crc.h"
+#include "yLib_lz.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define FWUP_SEND_RETRY 50  /**< 发送队列满时的重试次数，每次等待1个滴答 */
+#define FWUP_WAIT_TICKS 100 /**< 等待一页编程完成的滴答数上限，典型页编程约0.7ms */
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 接收会话
+ */
+typedef struct
+{
+    uint8_t state;               /**< FwUpdateState_t */
+    uint8_t slot;                /**< 目标槽 */
+    uint8_t error;               /**< 最近一次错误 */
+    uint8_t page;                /**< 正在填充的页缓冲 */
+    uint32_t size;               /**< 镜像字节数 */
+    uint32_t packed;             /**< 压缩流字节数，0表示未压缩 */
+    uint32_t crc;                /**< 上位机给出的CRC-32 */
+    uint32_t version;            /**< 镜像版本 */
+    uint32_t seq;                /**< 提交时写入的序号 */
+    uint32_t offset;             /**< 已接收字节数 */
+    uint32_t written;            /**< 已放入页缓冲的镜像字节数 */
+    uint32_t fill;               /**< 当前页缓冲中的字节数 */
+    uint32_t running;            /**< 已放入页缓冲的镜像的CRC-32 */
+    uint32_t retries;            /**< 忙和偏移不连续的回复次数 */
+    volatile uint8_t flash_fail; /**< 异步编程失败，在定时器服务任务中置位 */
+} FwUpdate_t;
+
+// ==================== 私有变量 ====================
+static FwUpdate_t fwup;
+static uint8_t fwup_page[2][YDEV_25Q_PAGE_SIZE] __attribute__((aligned(4))); /**< 页缓冲 */
+static uint8_t fwup_reply[8];                                                  /**< 回复载荷 */
+static struct ylib_lz_dec fwup_lz;                                             /**< 压缩传输的解压状态 */
+static const uint32_t fwup_slot_address[FWUP_SLOTS] = {FWUP_SLOT_A_ADDRESS, FWUP_SLOT_B_ADDRESS};
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 小端读取32位数
+ */
+static uint32_t fw_update_get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 镜像在25Q中的起始地址
+ */
+static uint32_t fw_update_image(uint32_t slot)
+{
+    return fwup_slot_address[slot] + YDEV_25Q_SECTOR_SIZE;
+}
+
+/**
+ * @brief 异步编程完成回调
+ */
+static void fw_update_program_done(void *arg, yDevStatus_t status)
+{
+    (void)arg;
+    if (status != YDEV_OK)
+        fwup.flash_fail = 1;
+}
+
+/**
+ * @brief 等待异步编程结束
+ * @return 0空闲，-1超时
+ */
+static int32_t fw_update_wait(yDevHandle_25q_t *dev)
+{
+    uint32_t ticks;
+
+    for (ticks = 0; yDev25qIsAsyncBusy(dev); ticks++)
+    {
+        if (ticks >= FWUP_WAIT_TICKS)
+            return -1;
+        vTaskDelay(1);
+    }
+    return 0;
+}
+
+/**
+ * @brief 把当前页缓冲交给异步编程并切换到另一页
+ * @return 0成功，-1失败
+ */
+static int32_t fw_update_flush(yDevHandle_25q_t *dev)
+{
+    uint32_t address;
+
+    if (fwup.fill == 0)
+        return 0;
+    if ((fw_update_wait(dev) != 0) || fwup.flash_fail)
+        return -1;
+
+    address = fw_update_image(fwup.slot) + fwup.written - fwup.fill;
+    if (yDev25qWriteAsync(dev, address, fwup_page[fwup.page], fwup.fill, fw_update_program_done, NULL) !=
+        YDEV_OK)
+        return -1;
+    fwup.page ^= 1U;
+    fwup.fill = 0;
+    return 0;
+}
+
+/**
+ * @brief 读取并校验槽头
+ */
+static int32_t fw_update_read_header(yDevHandle_25q_t *dev, uint32_t slot, FwUpdateHeader_t *header)
+{
+    if (yDev25qRead(dev, fwup_slot_address[slot], header, sizeof(*header)) != (int32_t)sizeof(*header))
+        return -1;
+    if ((header->magic != FWUP_MAGIC) || (header->size > FWUP_SLOT_SIZE - YDEV_25Q_SECTOR_SIZE) ||
+        (header->check != ylib_crc32(YLIB_CRC32_INIT, header, offsetof(FwUpdateHeader_t, check))))
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief 开始接收：选择较旧的槽并提交后台擦除
+ */
+static FwUpdateError_t fw_update_begin(yDevHandle_25q_t *dev, const uint8_t *payload, uint16_t len)
+{
+    FwUpdateHeader_t header;
+    uint32_t seq[FWUP_SLOTS];
+    uint8_t valid[FWUP_SLOTS];
+    uint32_t slot;
+    uint32_t size;
+
+    if ((len != 13) && (len != 17))
+        return FWUP_ERR_STATE;
+    if ((fw_update_wait(dev) != 0) || yDev25qIsEraseBusy(dev))
+        return FWUP_ERR_BUSY;
+
+    size = fw_update_get32(&payload[1]);
+    if ((size == 0) || (size > FWUP_SLOT_SIZE - YDEV_25Q_SECTOR_SIZE))
+        return FWUP_ERR_SIZE;
+    // 末尾保留区留给故障转储
+    for (slot = 0; slot < FWUP_SLOTS; slot++)
+    {
+        if (fwup_slot_address[slot] + FWUP_SLOT_SIZE > dev->size - FLASH_CRASHDUMP_RESERVED)
+            return FWUP_ERR_SIZE;
+        valid[slot] = (fw_update_read_header(dev, slot, &header) == 0) ? 1U : 0U;
+        seq[slot] = valid[slot] ? header.seq : 0;
+    }
+
+    // 写入无效的槽，都有效时写入序号较小的槽，正在使用的新镜像不受影响
+    slot = (!valid[0] || (valid[1] && (seq[0] < seq[1]))) ? 0U : 1U;
+    fwup.seq = ((seq[0] > seq[1]) ? seq[0] : seq[1]) + 1U;
+    fwup.slot = (uint8_t)slot;
+    fwup.size = size;
+    fwup.crc = fw_update_get32(&payload[5]);
+    fwup.version = fw_update_get32(&payload[9]);
+    fwup.packed = (len == 17) ? fw_update_get32(&payload[13]) : 0U;
+    fwup.offset = 0;
+    fwup.written = 0;
+    fwup.fill = 0;
+    fwup.page = 0;
+    fwup.running = YLIB_CRC32_INIT;
+    fwup.flash_fail = 0;
+    ylib_lz_dec_init(&fwup_lz);
+
+    if (yDev25qEraseAsync(dev, fwup_slot_address[slot], YDEV_25Q_SECTOR_SIZE + size) != YDEV_OK)
+    {
+        fwup.state = FWUP_FAILED;
+        return FWUP_ERR_FLASH;
+    }
+    fwup.state = FWUP_ERASING;
+    return FWUP_ERR_OK;
+}
+
+/**
+ * @brief 页缓冲中新放入part字节：累计CRC，满页即编程
+ */
+static int32_t fw_update_put(yDevHandle_25q_t *dev, uint32_t part)
+{
+    fwup.running = ylib_crc32(fwup.running, &fwup_page[fwup.page][fwup.fill], part);
+    fwup.fill += part;
+    fwup.written += part;
+    if ((fwup.fill == YDEV_25Q_PAGE_SIZE) && (fw_update_flush(dev) != 0))
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief 解压一段压缩流到页缓冲
+ * @return FWUP_ERR_OK，解压结果超出镜像大小返回FWUP_ERR_SIZE
+ */
+static FwUpdateError_t fw_update_unpack(yDevHandle_25q_t *dev, const uint8_t *payload, uint32_t n)
+{
+    size_t left = n;
+    uint32_t cap;
+    uint32_t part;
+
+    do
+    {
+        cap = YDEV_25Q_PAGE_SIZE - fwup.fill;
+        if (cap > fwup.size - fwup.written)
+            cap = fwup.size - fwup.written;
+        part = (uint32_t)ylib_lz_dec_run(&fwup_lz, &payload, &left, &fwup_page[fwup.page][fwup.fill], cap);
+        if ((part != 0) && (fw_update_put(dev, part) != 0))
+            return FWUP_ERR_FLASH;
+    } while ((part == cap) && (cap != 0));
+
+    return (left == 0) ? FWUP_ERR_OK : FWUP_ERR_SIZE;
+}
+
+/**
+ * @brief 数据：拷入或解压到页缓冲，满页即编程
+ */
+static FwUpdateError_t fw_update_data(yDevHandle_25q_t *dev, const uint8_t *payload, uint16_t len)
+{
+    FwUpdateError_t err = FWUP_ERR_OK;
+    uint32_t n;
+    uint32_t part;
+
+    if ((fwup.state == FWUP_ERASING) && !yDev25qIsEraseBusy(dev))
+        fwup.state = FWUP_RECEIVING;
+    if (fwup.state == FWUP_ERASING)
+        return FWUP_ERR_BUSY;
+    if ((fwup.state != FWUP_RECEIVING) || (len < 5))
+        return FWUP_ERR_STATE;
+    if (fw_update_get32(&payload[1]) != fwup.offset)
+        return FWUP_ERR_OFFSET;
+
+    n = len - 5U;
+    payload += 5;
+    if (n > ((fwup.packed != 0) ? fwup.packed : fwup.size) - fwup.offset)
+        return FWUP_ERR_SIZE;
+    fwup.offset += n;
+
+    if (fwup.packed != 0)
+    {
+        err = fw_update_unpack(dev, payload, n);
+    }
+    else
+    {
+        while ((n > 0) && (err == FWUP_ERR_OK))
+        {
+            part = YDEV_25Q_PAGE_SIZE - fwup.fill;
+            if (part > n)
+                part = n;
+            memcpy(&fwup_page[fwup.page][fwup.fill], payload, part);
+            payload += part;
+            n -= part;
+            if (fw_update_put(dev, part) != 0)
+                err = FWUP_ERR_FLASH;
+        }
+    }
+
+    // 已消耗的数据无法重收，解压超出镜像大小同样只能重新开始
+    if (err != FWUP_ERR_OK)
+        fwup.state = FWUP_FAILED;
+    return err;
+}
+
+/**
+ * @brief 结束：写完最后一页，校验接收数据和读回数据，写入槽头
+ */
+static FwUpdateError_t fw_update_end(yDevHandle_25q_t *dev)
+{
+    FwUpdateHeader_t header;
+    uint32_t image;
+    uint32_t pos;
+    uint32_t part;
+    uint32_t crc = YLIB_CRC32_INIT;
+
+    if (fwup.state != FWUP_RECEIVING)
+        return FWUP_ERR_STATE;
+    if ((fwup.offset != ((fwup.packed != 0) ? fwup.packed : fwup.size)) || (fwup.written != fwup.size))
+        return FWUP_ERR_OFFSET;
+
+    fwup.state = FWUP_FAILED;
+    if ((fw_update_flush(dev) != 0) || (fw_update_wait(dev) != 0) || fwup.flash_fail)
+        return FWUP_ERR_FLASH;
+    if (fwup.running != fwup.crc)
+        return FWUP_ERR_CRC;
+
+    // 读回校验，确认编程结果而不只是收到的数据
+    image = fw_update_image(fwup.slot);
+    for (pos = 0; pos < fwup.size; pos += part)
+    {
+        part = fwup.size - pos;
+        if (part > YDEV_25Q_PAGE_SIZE)
+            part = YDEV_25Q_PAGE_SIZE;
+        if (yDev25qRead(dev, image + pos, fwup_page[0], part) != (int32_t)part)
+            return FWUP_ERR_FLASH;
+        crc = ylib_crc32(crc, fwup_page[0], part);
+    }
+    if (crc != fwup.crc)
+        return FWUP_ERR_CRC;
+
+    header.magic = FWUP_MAGIC;
+    header.seq = fwup.seq;
+    header.version = fwup.version;
+    header.size = fwup.size;
+    header.crc = fwup.crc;
+    header.check = ylib_crc32(YLIB_CRC32_INIT, &header, offsetof(FwUpdateHeader_t, check));
+    memcpy(fwup_page[0], &header, sizeof(header));
+    if ((yDev25qWriteAsync(dev, fwup_slot_address[fwup.slot], fwup_page[0], sizeof(header),
+                           fw_update_program_done, NULL) != YDEV_OK) ||
+        (fw_update_wait(dev) != 0) || fwup.flash_fail)
+        return FWUP_ERR_FLASH;
+
+    fwup.state = FWUP_DONE;
+    return FWUP_ERR_OK;
+}
+
+/**
+ * @brief 发送回复，发送队列满时等待后重试
+ */
+static void fw_update_reply(uint8_t type, FwUpdateError_t err)
+{
+    fwup_reply[0] = (uint8_t)(type | 0x80U);
+    fwup_reply[1] = (uint8_t)err;
+    fwup_reply[2] = (uint8_t)fwup.offset;
+    fwup_reply[3] = (uint8_t)(fwup.offset >> 8);
+    fwup_reply[4] = (uint8_t)(fwup.offset >> 16);
+    fwup_reply[5] = (uint8_t)(fwup.offset >> 24);
+    fwup_reply[6] = fwup.slot;
+    fwup_reply[7] = fwup.state;
+    (void)FrameSendRetry(FWUP_FRAME_ID, fwup_reply, sizeof(fwup_reply), FWUP_SEND_RETRY);
+}
+
+// ==================== 公共函数 ====================
+
+void FwUpdateGetStatus(FwUpdateStatus_t *status)
+{
+    status->state = fwup.state;
+    status->slot = fwup.slot;
+    status->error = fwup.error;
+    status->size = fwup.size;
+    status->packed = fwup.packed;
+    status->offset = fwup.offset;
+    status->retries = fwup.retries;
+}
+
+int32_t FwUpdateGetSlot(uint32_t slot, FwUpdateHeader_t *header)
+{
+    yDevHandle_25q_t *dev = FlashGetHandle();
+
+    if ((slot >= FWUP_SLOTS) || (dev == NULL) || (dev->size == 0))
+        return -1;
+    return fw_update_read_header(dev, slot, header);
+}
+
+// ==================== 帧处理 ====================
+
+/**
+ * @brief 升级帧
+ * @note 在帧解码所在的任务中执行，只在页缓冲都在编程时短暂等待
+ */
+static int32_t FwUpdateFrameHandler(uint8_t id, const uint8_t *payload, uint16_t len)
+{
+    yDevHandle_25q_t *dev = FlashGetHandle();
+    FwUpdateError_t err;
+
+    (void)id;
+    if (len < 1)
+        return -1;
+
+    switch (payload[0])
+    {
+    case FWUP_BEGIN:
+        err = fw_update_begin(dev, payload, len);
+        break;
+    case FWUP_DATA:
+        err = fw_update_data(dev, payload, len);
+        break;
+    case FWUP_END:
+        err = fw_update_end(dev);
+        break;
+    case FWUP_STATUS:
+        if ((fwup.state == FWUP_ERASING) && !yDev25qIsEraseBusy(dev))
+            fwup.state = FWUP_RECEIVING;
+        err = FWUP_ERR_OK;
+        break;
+    case FWUP_ABORT:
+        err = (fw_update_wait(dev) == 0) ? FWUP_ERR_OK : FWUP_ERR_BUSY;
+        if (err == FWUP_ERR_OK)
+            fwup.state = FWUP_IDLE;
+        break;
+    default:
+        return -1;
+    }
+
+    LatencyMark(LAT_STAGE_FLASH);
+    if ((err == FWUP_ERR_BUSY) || (err == FWUP_ERR_OFFSET))
+        fwup.retries++;
+    if (err != FWUP_ERR_OK)
+        fwup.error = (uint8_t)err;
+    fw_update_reply(payload[0], err);
+    return (err == FWUP_ERR_OK) ? 0 : -1;
+}
+FRAME_EXPORT(FWUP_FRAME_ID, FwUpdateFrameHandler);
@@ -0,0 +1,275 @@
+/**
+ * @file heaptrace.c
+ * @brief 堆分配跟踪模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 挂接ylib_set_malloc_hook/ylib_set_free_hook，在固定大小的记录表中维护存活块，
+ * 钩子可能在中断中调用，记录表的读写都在关中断下进行
+ */
+
+// ==================== 包含文件 ====================
+#include "heaptrace.h"
+#include "yLib_heap.h"
+#include <string.h>
+
+// ==================== 私有变量 ====================
+static HeapTraceRecord_t trace_live[HEAPTRACE_MAX_LIVE]; /**< 存活块记录表 */
+static HeapTraceTask_t trace_task[HEAPTRACE_MAX_TASKS] = {{"isr/other", 0, 0}}; /**< 任务占用统计 */
+static TaskHandle_t trace_task_handle[HEAPTRACE_MAX_TASKS]; /**< 任务统计对应的句柄 */
+static HeapTraceStats_t trace_stats;                      /**< 总体统计 */
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 计算大小分级
+ * @param size 块大小
+ * @return 分级序号
+ */
+static uint32_t heap_trace_class(uint32_t size)
+{
+    uint32_t cls = 0;
+    uint32_t limit = 1UL << HEAPTRACE_MIN_CLASS_LOG2;
+
+    while (size > limit && cls < HEAPTRACE_SIZE_CLASSES - 1)
+    {
+        limit <<= 1;
+        cls++;
+    }
+    return cls;
+}
+
+/**
+ * @brief 查找或登记当前任务，须在关中断下调用
+ * @return 任务序号，中断、调度器未启动或任务表满时为0
+ */
+static uint8_t heap_trace_task(void)
+{
+    TaskHandle_t handle;
+    uint8_t index;
+
+    if (xPortIsInsideInterrupt() || xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+        return 0;
+
+    handle = xTaskGetCurrentTaskHandle();
+    for (index = 1; index < HEAPTRACE_MAX_TASKS; index++)
+    {
+        if (trace_task_handle[index] == handle)
+            return index;
+        if (trace_task_handle[index] == NULL)
+        {
+            trace_task_handle[index] = handle;
+            strncpy(trace_task[index].name, pcTaskGetName(handle), configMAX_TASK_NAME_LEN - 1);
+            return index;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 分配钩子
+ * @param pv 块地址
+ * @param size 块可用大小
+ * @param caller 分配处返回地址
+ */
+static void heap_trace_malloc(void *pv, size_t size, const void *caller)
+{
+    HeapTraceRecord_t *record = NULL;
+    HeapTraceTask_t *task;
+    UBaseType_t mask;
+    uint32_t index;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    trace_stats.allocs++;
+    trace_stats.size_class[heap_trace_class((uint32_t)size)]++;
+    for (index = 0; index < HEAPTRACE_MAX_LIVE; index++)
+    {
+        if (trace_live[index].ptr == NULL)
+        {
+            record = &trace_live[index];
+            break;
+        }
+    }
+
+    if (record == NULL)
+    {
+        trace_stats.dropped++;
+    }
+    else
+    {
+        record->ptr = pv;
+        record->caller = caller;
+        record->size = (uint32_t)size;
+        record->tick = xTaskGetTickCountFromISR();
+        record->task = heap_trace_task();
+
+        trace_stats.live++;
+        trace_stats.live_bytes += record->size;
+        if (trace_stats.live_bytes > trace_stats.peak_bytes)
+            trace_stats.peak_bytes = trace_stats.live_bytes;
+
+        task = &trace_task[record->task];
+        task->in_use += record->size;
+        if (task->in_use > task->peak)
+            task->peak = task->in_use;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/**
+ * @brief 释放钩子
+ * @param pv 块地址
+ * @param size 块可用大小
+ * @param caller 释放处返回地址
+ */
+static void heap_trace_free(void *pv, size_t size, const void *caller)
+{
+    HeapTraceRecord_t *record;
+    UBaseType_t mask;
+    uint32_t index;
+
+    (void)size;
+    (void)caller;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    trace_stats.frees++;
+    for (index = 0; index < HEAPTRACE_MAX_LIVE; index++)
+    {
+        record = &trace_live[index];
+        if (record->ptr == pv)
+        {
+            // 占用计入分配时的任务，而不是释放的任务
+            trace_task[record->task].in_use -= record->size;
+            trace_stats.live--;
+            trace_stats.live_bytes -= record->size;
+            record->ptr = NULL;
+            break;
+        }
+    }
+    if (index == HEAPTRACE_MAX_LIVE)
+        trace_stats.untracked++;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+// ==================== 公共函数实现 ====================
+
+void HeapTraceStart(void)
+{
+    ylib_set_malloc_hook(heap_trace_malloc);
+    ylib_set_free_hook(heap_trace_free);
+}
+
+void HeapTraceStop(void)
+{
+    ylib_set_malloc_hook(NULL);
+    ylib_set_free_hook(NULL);
+}
+
+void HeapTraceReset(void)
+{
+    UBaseType_t mask;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    memset(trace_live, 0, sizeof(trace_live));
+    memset(trace_task, 0, sizeof(trace_task));
+    memset(trace_task_handle, 0, sizeof(trace_task_handle));
+    memset(&trace_stats, 0, sizeof(trace_stats));
+    strncpy(trace_task[0].name, "isr/other", configMAX_TASK_NAME_LEN - 1);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+void HeapTraceGetStats(HeapTraceStats_t *stats)
+{
+    UBaseType_t mask;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    *stats = trace_stats;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+int HeapTraceGetLive(uint32_t index, HeapTraceRecord_t *record)
+{
+    UBaseType_t mask;
+    uint32_t slot;
+    int ret = -1;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    for (slot = 0; slot < HEAPTRACE_MAX_LIVE; slot++)
+    {
+        if (trace_live[slot].ptr != NULL && index-- == 0)
+        {
+            *record = trace_live[slot];
+            ret = 0;
+            break;
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+int HeapTraceGetTask(uint32_t index, HeapTraceTask_t *task)
+{
+    UBaseType_t mask;
+    int ret = -1;
+
+    if (index >= HEAPTRACE_MAX_TASKS)
+        return -1;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    if (index == 0 || trace_task_handle[index] != NULL)
+    {
+        *task = trace_task[index];
+        ret = 0;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+uint32_t HeapTraceTopSites(HeapTraceSite_t *sites, uint32_t count)
+{
+    HeapTraceSite_t site;
+    UBaseType_t mask;
+    uint32_t used = 0;
+    uint32_t i;
+    uint32_t j;
+    int seen;
+
+    for (i = 0; i < HEAPTRACE_MAX_LIVE; i++)
+    {
+        // 每个调用者只在首次出现处汇总一次，逐行关中断，避免长时间屏蔽
+        mask = portSET_INTERRUPT_MASK_FROM_ISR();
+        site.caller = trace_live[i].caller;
+        site.blocks = 0;
+        site.bytes = 0;
+        seen = (trace_live[i].ptr == NULL);
+        for (j = 0; j < i && !seen; j++)
+            seen = (trace_live[j].ptr != NULL && trace_live[j].caller == site.caller);
+        for (j = i; j < HEAPTRACE_MAX_LIVE && !seen; j++)
+        {
+            if (trace_live[j].ptr != NULL && trace_live[j].caller == site.caller)
+            {
+                site.blocks++;
+                site.bytes += trace_live[j].size;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+        if (seen)
+            continue;
+
+        // 插入排序，保留字节数最大的count项
+        for (j = used; j > 0 && sites[j - 1].bytes < site.bytes; j--)
+        {
+            if (j < count)
+                sites[j] = sites[j - 1];
+        }
+        if (j < count)
+        {
+            sites[j] = site;
+            if (used < count)
+                used++;
+        }
+    }
+    return used;
+}
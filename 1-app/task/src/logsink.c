@@ -0,0 +1,666 @@
+/**
+ * @file logsink.c
+ * @brief 二进制日志输出模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 调用处只写入记录，格式化、串口发送和Flash编程都在本任务中进行；
+ * 每次取出的记录不超过一帧，帧输出不需要再拆分，文本和Flash输出按记录逐条处理。
+ * 处理一批记录期间持有输出互斥量，shell中的Flash导出和擦除与之互斥，共用帧缓冲和日志区状态。
+ * 压缩格式的日志区每批记录压缩成一块写入，导出时解压回记录帧，上位机看到的帧格式不变
+ */
+
+// ==================== 包含文件 ====================
+#include "logsink.h"
+#include "flash.h"
+#include "frame.h"
+#include "mux.h"
+#include "os_lock.h"
+#include "os_static.h"
+#include "watchdog.h"
+#include "yDev_smap.h"
+#include "yLib_log.h"
+#include "yLib_lz.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define LOGSINK_TASK_PRIO 2                          /**< 低于全部应用任务，只高于后台初始化 */
+#define LOGSINK_STK_SIZE 320                         /**< 文本展开调用snprintf */
+#define LOGSINK_BATCH_WORDS ((FRAME_PAYLOAD_MAX - 1) / 4) /**< 一次取出的字数，正好装满一帧 */
+#define LOGSINK_TEXT_MAX 96                          /**< 一行文本的最大长度 */
+#define LOGSINK_SEND_RETRY 20                        /**< 发送队列满时的重试次数，每次等待1个滴答 */
+#define LOGSINK_SMAP_SIZE (2U * YDEV_25Q_SECTOR_SIZE)  /**< 日志区开头的扇区状态表 */
+#define LOGSINK_SECTORS ((LOGSINK_FLASH_SIZE - LOGSINK_SMAP_SIZE) / YDEV_25Q_SECTOR_SIZE)
+#define LOGSINK_SECTOR_HEADER 8U                     /**< 扇区头字节数 */
+#define LOGSINK_BLOCK_MAX (LOGSINK_BATCH_WORDS * 4U) /**< 一块记录的最大字节数 */
+
+#if (LOGSINK_SECTORS < 2)
+#error "LOGSINK_FLASH_SIZE must hold the sector-state table and at least two log sectors"
+#endif
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief Flash日志区写入位置
+ */
+typedef struct
+{
+    yDevHandle_25q_t *dev; /**< 25Q句柄，未打开时为NULL */
+    uint32_t sector;       /**< 当前扇区 */
+    uint32_t offset;       /**< 当前扇区内的写入偏移 */
+    uint32_t seq;          /**< 当前扇区序号 */
+    uint8_t lz;            /**< 当前扇区为压缩格式 */
+} LogSinkFlash_t;
+
+// ==================== 私有变量 ====================
+OS_TASK_DEFINE(log_task, LOGSINK_STK_SIZE);
+OS_LOCK_DEFINE(log_lock);
+
+static TaskHandle_t log_task;
+static volatile uint32_t log_mask = LOGSINK_DEFAULT;
+static volatile uint8_t log_header_pending;                     /**< 打开帧输出后先发头部 */
+static LogSinkFlash_t log_flash;
+static yDevSmap_t log_smap;                                     /**< 日志扇区状态表，PARTIAL为正在写入的扇区 */
+static uint8_t log_smap_map[YDEV_SMAP_BYTES(LOGSINK_SECTORS)];  /**< 状态表缓冲区 */
+static LogSinkStats_t log_stats;
+static uint32_t log_words[LOGSINK_BATCH_WORDS];                 /**< 取出的记录 */
+static uint32_t log_block[1U + LOGSINK_BATCH_WORDS];            /**< 块头 + 压缩数据 */
+static uint8_t log_frame[FRAME_PAYLOAD_MAX] __attribute__((aligned(4))); /**< 帧载荷 */
+static char log_text[LOGSINK_TEXT_MAX];                         /**< 一行文本 */
+static const char *const log_level_tag[] = {"D", "I", "W", "E"};
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 小端写入32位数
+ */
+static uint8_t *log_sink_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/**
+ * @brief 以帧发送，发送队列满时等待后重试
+ */
+static int32_t log_sink_send(uint16_t len)
+{
+    if (FrameSendRetry(LOG_FRAME_ID, log_frame, len, LOGSINK_SEND_RETRY) >= 0)
+        return 0;
+    log_stats.frame_fail++;
+    return -1;
+}
+
+/**
+ * @brief 发送头部帧
+ */
+static int32_t log_sink_send_header(void)
+{
+    uint8_t *p = log_frame;
+
+    *p++ = LOGSINK_HEADER;
+    memcpy(p, "YLOG", 4);
+    p += 4;
+    *p++ = LOGSINK_VERSION;
+    p = log_sink_put32(p, ylib_log_clock_hz());
+    p = log_sink_put32(p, ylib_log_dropped());
+    return log_sink_send((uint16_t)(p - log_frame));
+}
+
+/**
+ * @brief 把若干个字作为记录块发送
+ */
+static int32_t log_sink_send_words(const uint32_t *words, uint32_t n)
+{
+    uint8_t *p = log_frame;
+    uint32_t i;
+
+    *p++ = LOGSINK_RECORDS;
+    for (i = 0; i < n; i++)
+        p = log_sink_put32(p, words[i]);
+    return log_sink_send((uint16_t)(p - log_frame));
+}
+
+/**
+ * @brief 逐条展开为文本输出
+ */
+static void log_sink_text(const uint32_t *words, uint32_t n)
+{
+    uint32_t i;
+    int len;
+    int ret;
+
+    for (i = 0; i < n; i += YLIB_LOG_REC_WORDS(words[i]))
+    {
+        len = snprintf(log_text, sizeof(log_text), "[%lu.%06lu %s] ",
+                       (unsigned long)(words[i + 1] / 1000000U), (unsigned long)(words[i + 1] % 1000000U),
+                       log_level_tag[YLIB_LOG_HDR_LEVEL(words[i])]);
+        ret = ylib_log_format(&words[i], log_text + len, sizeof(log_text) - (size_t)len - 2U);
+        if (ret > 0)
+            len += ret;
+        // 截断时snprintf只写入缓冲区能容纳的部分，留出行尾
+        if (len > (int)sizeof(log_text) - 3)
+            len = (int)sizeof(log_text) - 3;
+        log_text[len++] = '\r';
+        log_text[len++] = '\n';
+        (void)MuxTextWritePrio(log_text, (uint16_t)len, MUX_PRIO_LOW);
+    }
+}
+
+/**
+ * @brief 日志区中扇区的地址
+ */
+static uint32_t log_sink_sector_address(uint32_t sector)
+{
+    return LOGSINK_FLASH_ADDRESS + LOGSINK_SMAP_SIZE + sector * YDEV_25Q_SECTOR_SIZE;
+}
+
+/**
+ * @brief 在状态表中记录扇区状态
+ * @note 状态表只用于加快打开，记录失败不影响日志写入，打开时校验不过即回到全扫描
+ */
+static void log_sink_mark(uint32_t sector, yDevSmapState_t state)
+{
+    if (log_smap.mounted)
+        (void)yDevSmapSet(&log_smap, (uint16_t)sector, state);
+}
+
+/**
+ * @brief 读取扇区头
+ * @param lz 输出扇区是否为压缩格式，可为NULL
+ * @return 扇区序号，扇区无效返回0
+ */
+static uint32_t log_sink_sector_seq(yDevHandle_25q_t *dev, uint32_t sector, uint8_t *lz)
+{
+    uint32_t header[2];
+
+    if (yDev25qRead(dev, log_sink_sector_address(sector), header, sizeof(header)) != (int32_t)sizeof(header))
+        return 0;
+    if (((header[0] != LOGSINK_SECTOR_MAGIC) && (header[0] != LOGSINK_SECTOR_MAGIC_LZ)) ||
+        (header[1] == 0xFFFFFFFFUL))
+        return 0;
+    if (lz != NULL)
+        *lz = (header[0] == LOGSINK_SECTOR_MAGIC_LZ) ? 1U : 0U;
+    return header[1];
+}
+
+/**
+ * @brief 在扇区中读取一条记录
+ * @param offset 记录在扇区内的偏移
+ * @param rec 输出的记录
+ * @return 记录字数，读到擦除状态、越界或读取失败返回0
+ */
+static uint32_t log_sink_read_record(yDevHandle_25q_t *dev, uint32_t sector, uint32_t offset, uint32_t *rec)
+{
+    uint32_t address = log_sink_sector_address(sector) + offset;
+    uint32_t len;
+
+    if (offset + 4U > YDEV_25Q_SECTOR_SIZE)
+        return 0;
+    if (yDev25qRead(dev, address, rec, 4) != 4)
+        return 0;
+    len = YLIB_LOG_REC_WORDS(rec[0]);
+    if ((rec[0] == 0xFFFFFFFFUL) || (offset + len * 4U > YDEV_25Q_SECTOR_SIZE))
+        return 0;
+    if (yDev25qRead(dev, address + 4U, rec + 1, (len - 1U) * 4U) != (int32_t)((len - 1U) * 4U))
+        return 0;
+    return len;
+}
+
+/**
+ * @brief 在压缩扇区中读取块头
+ * @param offset 块在扇区内的偏移
+ * @param head 输出的块头
+ * @return 块占用的字节数(含块头和对齐)，读到擦除状态、块头非法、越界或读取失败返回0
+ */
+static uint32_t log_sink_read_block(yDevHandle_25q_t *dev, uint32_t sector, uint32_t offset, uint32_t *head)
+{
+    uint32_t packed;
+    uint32_t raw;
+    uint32_t size;
+
+    if (offset + 4U > YDEV_25Q_SECTOR_SIZE)
+        return 0;
+    if (yDev25qRead(dev, log_sink_sector_address(sector) + offset, head, 4) != 4)
+        return 0;
+    packed = *head & 0xFFFFU;
+    raw = *head >> 16;
+    if ((packed == 0) || (packed > raw) || (raw > LOGSINK_BLOCK_MAX) || ((raw & 3U) != 0))
+        return 0;
+    size = 4U + ((packed + 3U) & ~3U);
+    if (offset + size > YDEV_25Q_SECTOR_SIZE)
+        return 0;
+    return size;
+}
+
+/**
+ * @brief 读出一块并解压到log_words
+ * @return 记录字数，读取失败或解压长度不符返回0
+ */
+static uint32_t log_sink_unpack_block(yDevHandle_25q_t *dev, uint32_t sector, uint32_t offset, uint32_t head)
+{
+    uint32_t address = log_sink_sector_address(sector) + offset + 4U;
+    uint32_t packed = head & 0xFFFFU;
+    uint32_t raw = head >> 16;
+
+    if (packed == raw)
+        return (yDev25qRead(dev, address, log_words, raw) == (int32_t)raw) ? raw / 4U : 0U;
+    if (yDev25qRead(dev, address, log_block, packed) != (int32_t)packed)
+        return 0;
+    if (ylib_lz_decompress(log_block, packed, log_words, raw) != raw)
+        return 0;
+    return raw / 4U;
+}
+
+/**
+ * @brief 擦除扇区并写入扇区头，格式由LOGSINK_FLASH_LZ决定
+ */
+static int32_t log_sink_start_sector(uint32_t sector, uint32_t seq)
+{
+    uint32_t header[2] = {LOGSINK_FLASH_LZ ? LOGSINK_SECTOR_MAGIC_LZ : LOGSINK_SECTOR_MAGIC, seq};
+    uint32_t address = log_sink_sector_address(sector);
+
+    // 换扇区期间表中没有正在写入的扇区，掉电后打开时回到全扫描
+    if (yDevSmapGet(&log_smap, (uint16_t)log_flash.sector) == YDEV_SMAP_PARTIAL)
+        log_sink_mark(log_flash.sector, YDEV_SMAP_FULL);
+    log_sink_mark(sector, YDEV_SMAP_FULL);
+    if (yDevIoctl(log_flash.dev, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK)
+        return -1;
+    log_flash.dev->address = address;
+    if (yDevWrite(log_flash.dev, header, sizeof(header)) != (int32_t)sizeof(header))
+        return -1;
+    log_sink_mark(sector, YDEV_SMAP_PARTIAL);
+    log_flash.sector = sector;
+    log_flash.offset = LOGSINK_SECTOR_HEADER;
+    log_flash.seq = seq;
+    log_flash.lz = LOGSINK_FLASH_LZ ? 1U : 0U;
+    return 0;
+}
+
+/**
+ * @brief 由状态表找到正在写入的扇区
+ * @param sector 输出扇区
+ * @param lz 输出扇区是否为压缩格式
+ * @return 扇区序号，状态表不可用或与扇区头不符返回0
+ * @note 表中恰好一个PARTIAL扇区、扇区头有效且下一个扇区不比它新时才采用；
+ *       表漏记了换扇区时下一个扇区的序号更大，不会续写到旧扇区
+ */
+static uint32_t log_sink_smap_current(yDevHandle_25q_t *dev, uint32_t *sector, uint8_t *lz)
+{
+    uint32_t seq;
+    int32_t found;
+
+    if (!log_smap.mounted || log_smap.formatted || (yDevSmapCount(&log_smap, YDEV_SMAP_PARTIAL) != 1U))
+        return 0;
+    found = yDevSmapFind(&log_smap, YDEV_SMAP_PARTIAL, 0);
+    if (found < 0)
+        return 0;
+    seq = log_sink_sector_seq(dev, (uint32_t)found, lz);
+    if ((seq == 0) || (log_sink_sector_seq(dev, ((uint32_t)found + 1U) % LOGSINK_SECTORS, NULL) > seq))
+        return 0;
+    *sector = (uint32_t)found;
+    return seq;
+}
+
+/**
+ * @brief 打开日志区，找到序号最大的扇区并定位到其中最后一条记录或最后一块之后
+ * @return 0成功，-1 25Q不可用或容量不足
+ * @note 调用者持有log_lock；先查扇区状态表，不可用时读取全部扇区头并重建状态表；
+ *       该扇区的格式与LOGSINK_FLASH_LZ不同时换到下一个扇区
+ */
+static int32_t log_sink_flash_open(void)
+{
+    uint32_t rec[2U + YLIB_LOG_ARGS_MAX];
+    yDevSmapConfig_t smap_config = {
+        .mapAddress = LOGSINK_FLASH_ADDRESS,
+        .baseAddress = LOGSINK_FLASH_ADDRESS + LOGSINK_SMAP_SIZE,
+        .sectorCount = LOGSINK_SECTORS,
+        .mapBuffer = log_smap_map,
+    };
+    yDevHandle_25q_t *dev;
+    uint32_t sector;
+    uint32_t seq;
+    uint32_t len;
+    uint8_t lz;
+
+    if (log_flash.dev != NULL)
+        return 0;
+
+    // 末尾保留区留给故障转储
+    dev = FlashGetHandle();
+    if ((dev == NULL) || (dev->size < FLASH_CRASHDUMP_RESERVED) ||
+        (LOGSINK_FLASH_ADDRESS + LOGSINK_FLASH_SIZE > dev->size - FLASH_CRASHDUMP_RESERVED))
+        return -1;
+    smap_config.flash = dev;
+
+    log_flash.dev = dev;
+    log_flash.sector = 0;
+    (void)yDevSmapMount(&log_smap, &smap_config);
+    log_flash.seq = log_sink_smap_current(dev, &log_flash.sector, &log_flash.lz);
+    if (log_flash.seq == 0)
+    {
+        for (sector = 0; sector < LOGSINK_SECTORS; sector++)
+        {
+            seq = log_sink_sector_seq(dev, sector, &lz);
+            if (seq > log_flash.seq)
+            {
+                log_flash.seq = seq;
+                log_flash.sector = sector;
+                log_flash.lz = lz;
+            }
+        }
+
+        // 重建状态表，除正在写入的扇区外都按写满记录
+        if (log_smap.mounted && (yDevSmapFormat(&log_smap, YDEV_SMAP_FULL) == YDEV_OK) && (log_flash.seq != 0))
+            log_sink_mark(log_flash.sector, YDEV_SMAP_PARTIAL);
+    }
+    if (log_flash.seq == 0)
+    {
+        if (log_sink_start_sector(0, 1) != 0)
+        {
+            log_flash.dev = NULL;
+            return -1;
+        }
+        return 0;
+    }
+
+    if (log_flash.lz != (LOGSINK_FLASH_LZ ? 1U : 0U))
+    {
+        if (log_sink_start_sector((log_flash.sector + 1U) % LOGSINK_SECTORS, log_flash.seq + 1U) != 0)
+        {
+            log_flash.dev = NULL;
+            return -1;
+        }
+        return 0;
+    }
+
+    log_flash.offset = LOGSINK_SECTOR_HEADER;
+    if (log_flash.lz)
+    {
+        while ((len = log_sink_read_block(dev, log_flash.sector, log_flash.offset, rec)) != 0)
+            log_flash.offset += len;
+    }
+    else
+    {
+        while ((len = log_sink_read_record(dev, log_flash.sector, log_flash.offset, rec)) != 0)
+            log_flash.offset += len * 4U;
+    }
+    return 0;
+}
+
+/**
+ * @brief 把一批记录压缩成一块追加到日志区，当前扇区放不下时换到下一个扇区
+ * @note 压缩后不比原数据小时原样存放
+ */
+static void log_sink_flash_block(const uint32_t *words, uint32_t n)
+{
+    uint32_t raw = n * 4U;
+    uint32_t packed;
+    uint32_t size;
+
+    packed = (uint32_t)ylib_lz_compress(words, raw, &log_block[1], raw - 1U);
+    if (packed == 0)
+    {
+        memcpy(&log_block[1], words, raw);
+        packed = raw;
+    }
+    log_block[0] = packed | (raw << 16);
+    size = 4U + ((packed + 3U) & ~3U);
+
+    if ((log_flash.offset + size > YDEV_25Q_SECTOR_SIZE) &&
+        (log_sink_start_sector((log_flash.sector + 1U) % LOGSINK_SECTORS, log_flash.seq + 1U) != 0))
+        return;
+
+    // 对齐填充不写入，保持擦除状态
+    log_flash.dev->address = log_sink_sector_address(log_flash.sector) + log_flash.offset;
+    if (yDevWrite(log_flash.dev, log_block, 4U + packed) != (int32_t)(4U + packed))
+        return;
+    log_flash.offset += size;
+    log_stats.flash_words += n;
+    log_stats.flash_bytes += size;
+}
+
+/**
+ * @brief 把整条记录追加到日志区，当前扇区放不下时换到下一个扇区
+ * @note 调用者持有log_lock
+ */
+static void log_sink_flash(const uint32_t *words, uint32_t n)
+{
+    uint32_t start = 0;
+    uint32_t end;
+    uint32_t len;
+
+    if (log_sink_flash_open() != 0)
+        return;
+    if (log_flash.lz)
+    {
+        log_sink_flash_block(words, n);
+        return;
+    }
+
+    while (start < n)
+    {
+        // 当前扇区能容纳的连续若干条记录一次写入
+        end = start;
+        while ((end < n) && (log_flash.offset + (end - start + YLIB_LOG_REC_WORDS(words[end])) * 4U <=
+                             YDEV_25Q_SECTOR_SIZE))
+            end += YLIB_LOG_REC_WORDS(words[end]);
+
+        if (end == start)
+        {
+            if (log_sink_start_sector((log_flash.sector + 1U) % LOGSINK_SECTORS, log_flash.seq + 1U) != 0)
+                break;
+            continue;
+        }
+
+        len = (end - start) * 4U;
+        log_flash.dev->address = log_sink_sector_address(log_flash.sector) + log_flash.offset;
+        if (yDevWrite(log_flash.dev, &words[start], len) != (int32_t)len)
+            break;
+        log_flash.offset += len;
+        log_stats.flash_words += end - start;
+        log_stats.flash_bytes += len;
+        start = end;
+    }
+}
+
+/**
+ * @brief 队列过半时唤醒日志任务
+ * @note 由ylib_log_write调用，可能在中断中
+ */
+static void log_sink_notify(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (log_task == NULL)
+        return;
+    if (__get_IPSR() != 0U)
+    {
+        vTaskNotifyGiveFromISR(log_task, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    else
+    {
+        xTaskNotifyGive(log_task);
+    }
+}
+
+/**
+ * @brief 日志输出任务
+ */
+static void log_sink_task(void *pvParameters)
+{
+    uint32_t mask;
+    uint32_t n;
+    uint32_t i;
+    int32_t wdg;
+
+    (void)pvParameters;
+    wdg = WatchdogRegister("log", WATCHDOG_DEADLINE_MS);
+    for (;;)
+    {
+        WatchdogCheckin(wdg);
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOGSINK_PERIOD_MS));
+
+        while ((n = ylib_log_read(log_words, LOGSINK_BATCH_WORDS)) != 0)
+        {
+            (void)OsLockTake(&log_lock, portMAX_DELAY);
+            mask = log_mask;
+            for (i = 0; i < n; i += YLIB_LOG_REC_WORDS(log_words[i]))
+                log_stats.records++;
+
+            if (mask & LOGSINK_FRAME)
+            {
+                if (log_header_pending && (log_sink_send_header() == 0))
+                    log_header_pending = 0;
+                (void)log_sink_send_words(log_words, n);
+            }
+            if (mask & LOGSINK_TEXT)
+                log_sink_text(log_words, n);
+            if (mask & LOGSINK_FLASH)
+                log_sink_flash(log_words, n);
+            OsLockGive(&log_lock);
+        }
+    }
+}
+
+/**
+ * @brief 从当前扇区的下一个开始按序号递增的顺序导出，跳过无效扇区
+ * @note 调用者持有log_lock；压缩块解压到log_words后整块发送
+ */
+static int32_t log_sink_flash_dump(void)
+{
+    uint32_t rec[2U + YLIB_LOG_ARGS_MAX];
+    uint32_t seq[LOGSINK_SECTORS];
+    uint8_t lz[LOGSINK_SECTORS];
+    uint32_t fill = 0;
+    uint32_t records = 0;
+    uint32_t next;
+    uint32_t sector;
+    uint32_t offset;
+    uint32_t len;
+    uint32_t i;
+    uint32_t j;
+
+    if ((log_sink_flash_open() != 0) || (log_sink_send_header() != 0))
+        return -1;
+
+    for (sector = 0; sector < LOGSINK_SECTORS; sector++)
+        seq[sector] = log_sink_sector_seq(log_flash.dev, sector, &lz[sector]);
+    for (i = 1; i <= LOGSINK_SECTORS; i++)
+    {
+        next = (log_flash.sector + i) % LOGSINK_SECTORS;
+        if ((seq[next] == 0) || (seq[next] > log_flash.seq))
+            continue;
+        if (lz[next])
+        {
+            for (offset = LOGSINK_SECTOR_HEADER;
+                 (len = log_sink_read_block(log_flash.dev, next, offset, rec)) != 0; offset += len)
+            {
+                if ((fill != 0) && (log_sink_send_words(log_words, fill) != 0))
+                    return -1;
+                fill = log_sink_unpack_block(log_flash.dev, next, offset, rec[0]);
+                if (fill == 0)
+                    break;
+                for (j = 0; j < fill; j += YLIB_LOG_REC_WORDS(log_words[j]))
+                    records++;
+            }
+            continue;
+        }
+        for (offset = LOGSINK_SECTOR_HEADER; (len = log_sink_read_record(log_flash.dev, next, offset, rec)) != 0;
+             offset += len * 4U)
+        {
+            if (fill + len > LOGSINK_BATCH_WORDS)
+            {
+                if (log_sink_send_words(log_words, fill) != 0)
+                    return -1;
+                fill = 0;
+            }
+            memcpy(&log_words[fill], rec, len * 4U);
+            fill += len;
+            records++;
+        }
+    }
+    if ((fill != 0) && (log_sink_send_words(log_words, fill) != 0))
+        return -1;
+    return (int32_t)records;
+}
+
+/**
+ * @brief 擦除有数据的扇区，从第一个扇区重新开始
+ * @note 调用者持有log_lock
+ */
+static int32_t log_sink_flash_erase(void)
+{
+    uint32_t address;
+    uint32_t sector;
+
+    if (log_sink_flash_open() != 0)
+        return -1;
+    for (sector = 1; sector < LOGSINK_SECTORS; sector++)
+    {
+        if (log_sink_sector_seq(log_flash.dev, sector, NULL) == 0)
+            continue;
+        address = log_sink_sector_address(sector);
+        if (yDevIoctl(log_flash.dev, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK)
+            return -1;
+        log_sink_mark(sector, YDEV_SMAP_ERASED);
+    }
+    return log_sink_start_sector(0, 1);
+}
+
+// ==================== 公共函数 ====================
+
+void LogSinkInit(void)
+{
+    OsLockInit(&log_lock, "log");
+    log_header_pending = (LOGSINK_DEFAULT & LOGSINK_FRAME) ? 1U : 0U;
+    log_task = OS_TASK_CREATE(log_task, log_sink_task, "log", NULL, LOGSINK_TASK_PRIO);
+    ylib_log_register_notify(log_sink_notify);
+}
+
+void LogSinkSetMask(uint32_t mask)
+{
+    if ((mask & LOGSINK_FRAME) && !(log_mask & LOGSINK_FRAME))
+        log_header_pending = 1;
+    log_mask = mask;
+}
+
+void LogSinkGetStats(LogSinkStats_t *stats)
+{
+    (void)OsLockTake(&log_lock, portMAX_DELAY);
+    *stats = log_stats;
+    stats->mask = log_mask;
+    stats->flash_sector = log_flash.sector;
+    stats->flash_seq = (log_flash.dev != NULL) ? log_flash.seq : 0U;
+    OsLockGive(&log_lock);
+}
+
+int32_t LogSinkFlashDump(void)
+{
+    int32_t ret;
+
+    (void)OsLockTake(&log_lock, portMAX_DELAY);
+    ret = log_sink_flash_dump();
+    OsLockGive(&log_lock);
+    return ret;
+}
+
+int32_t LogSinkFlashErase(void)
+{
+    int32_t ret;
+
+    (void)OsLockTake(&log_lock, portMAX_DELAY);
+    ret = log_sink_flash_erase();
+    OsLockGive(&log_lock);
+    return ret;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file memdiag.c
+ * @brief 内存与寄存器诊断模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 访问前按区域表校验，越过区域边界或访问保留地址会在M0+上触发HardFault；
+ * 外设寄存器不一定支持字节和半字访问，外设区一律按字读写
+ */
+
+// ==================== 包含文件 ====================
+#include "memdiag.h"
+#include "frame.h"
+#include "stm32g0xx.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <ctype.h>
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define MEMDIAG_SEND_RETRY 50 /**< 发送队列满时的重试次数，每次等待1个滴答 */
+#define MEMDIAG_RO 0x01       /**< 区域只读 */
+#define MEMDIAG_WORD 0x02     /**< 区域只能按字访问 */
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 可访问区域
+ */
+typedef struct
+{
+    uint32_t start; /**< 起始地址 */
+    uint32_t end;   /**< 结束地址(不含) */
+    uint8_t flags;  /**< MEMDIAG_RO/MEMDIAG_WORD */
+} MemDiagRegion_t;
+
+// ==================== 私有变量 ====================
+extern uint32_t _estack[];
+
+static uint8_t memdiag_buffer[1 + 4 + MEMDIAG_CHUNK] __attribute__((aligned(4))); /**< 帧载荷缓冲区 */
+
+#if !defined(MEMDIAG_REGMAP)
+/**
+ * @brief 没有生成寄存器表时的空表
+ */
+const RegMap_t regmap = {NULL, NULL, NULL, 0};
+#endif
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 小端写入32位数
+ */
+static uint8_t *mem_diag_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/**
+ * @brief 小端读取32位数
+ */
+static uint32_t mem_diag_get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 以帧发送，发送队列满时等待后重试
+ */
+static int32_t mem_diag_frame(uint16_t len)
+{
+    return (FrameSendRetry(MEMDIAG_FRAME_ID, memdiag_buffer, len, MEMDIAG_SEND_RETRY) >= 0) ? 0 : -1;
+}
+
+/**
+ * @brief 查找包含地址区间的区域
+ * @return 区域的MEMDIAG_RO/MEMDIAG_WORD标志，跨区域或不在任何区域内时返回-1
+ * @note 外设区按总线整体划分，其中没有外设的空洞读出为0
+ */
+static int32_t mem_diag_region(uint32_t addr, uint32_t len)
+{
+    // RAM结束地址来自链接脚本，Flash大小来自出厂写入的FLASH_SIZE，都要在运行时取
+    const MemDiagRegion_t regions[] = {
+        {FLASH_BASE, FLASH_BASE + FLASH_SIZE, MEMDIAG_RO},
+        {SRAM_BASE, (uint32_t)(uintptr_t)_estack, 0},
+        {0x1FFF0000UL, 0x1FFF7880UL, MEMDIAG_RO},                      // 系统存储区、工程字节、选项字节
+        {APBPERIPH_BASE, APBPERIPH_BASE + 0x00016000UL, MEMDIAG_WORD}, // APB外设
+        {AHBPERIPH_BASE, AHBPERIPH_BASE + 0x00003400UL, MEMDIAG_WORD}, // DMA、RCC、EXTI、Flash接口、CRC
+        {IOPORT_BASE, IOPORT_BASE + 0x00001800UL, MEMDIAG_WORD},       // GPIO
+        {0xE000E000UL, 0xE000F000UL, MEMDIAG_WORD},                    // SysTick、NVIC、SCB
+    };
+    uint32_t i;
+
+    for (i = 0; i < sizeof(regions) / sizeof(regions[0]); i++)
+    {
+        if ((addr >= regions[i].start) && (addr < regions[i].end) && (len <= regions[i].end - addr))
+            return regions[i].flags;
+    }
+    return -1;
+}
+
+// ==================== 公共函数 ====================
+
+int32_t MemDiagCheck(uint32_t addr, uint32_t len, uint32_t width, uint8_t write)
+{
+    int32_t flags;
+
+    if (((width != 1) && (width != 2) && (width != 4)) || (len == 0) || ((addr | len) & (width - 1)))
+        return -1;
+    flags = mem_diag_region(addr, len);
+    if (flags < 0)
+        return -1;
+    if (((flags & MEMDIAG_WORD) && (width != 4)) || (write && (flags & MEMDIAG_RO)))
+        return -1;
+    return 0;
+}
+
+void MemDiagRead(void *dst, uint32_t addr, uint32_t len, uint32_t width)
+{
+    uint8_t *out = (uint8_t *)dst;
+    uint32_t value;
+    uint32_t i;
+
+    for (i = 0; i < len; i += width)
+    {
+        if (width == 4)
+        {
+            value = *(volatile const uint32_t *)(uintptr_t)(addr + i);
+            memcpy(out + i, &value, 4);
+        }
+        else if (width == 2)
+        {
+            value = *(volatile const uint16_t *)(uintptr_t)(addr + i);
+            out[i] = (uint8_t)value;
+            out[i + 1] = (uint8_t)(value >> 8);
+        }
+        else
+        {
+            out[i] = *(volatile const uint8_t *)(uintptr_t)(addr + i);
+        }
+    }
+}
+
+int32_t MemDiagSend(uint32_t addr, uint32_t len)
+{
+    uint32_t width = (((addr | len) & 3U) == 0) ? 4U : 1U;
+    uint32_t sent = 0;
+    uint32_t chunk;
+
+    if (MemDiagCheck(addr, len, width, 0) == 0)
+    {
+        while (sent < len)
+        {
+            chunk = (len - sent > MEMDIAG_CHUNK) ? MEMDIAG_CHUNK : len - sent;
+            memdiag_buffer[0] = MEMDIAG_DATA;
+            mem_diag_put32(&memdiag_buffer[1], addr + sent);
+            MemDiagRead(&memdiag_buffer[5], addr + sent, chunk, width);
+            if (mem_diag_frame((uint16_t)(5 + chunk)) != 0)
+                return -1;
+            sent += chunk;
+        }
+    }
+
+    // 地址无效时也发结束帧，上位机据长度0判断
+    memdiag_buffer[0] = MEMDIAG_END;
+    mem_diag_put32(mem_diag_put32(&memdiag_buffer[1], addr), sent);
+    if (mem_diag_frame(9) != 0)
+        return -1;
+    return (sent == len) ? (int32_t)sent : -1;
+}
+
+const RegMapPeriph_t *MemDiagFindPeriph(const char *name)
+{
+    const RegMapPeriph_t *periph;
+    const char *pname;
+    uint32_t low = 0;
+    uint32_t high = regmap.count;
+    uint32_t mid;
+    size_t i;
+    int cmp;
+
+    while (low < high)
+    {
+        mid = (low + high) / 2U;
+        periph = &regmap.periphs[mid];
+        pname = regmap.names + periph->name;
+        for (i = 0; (name[i] != '\0') && (toupper((unsigned char)name[i]) == (unsigned char)pname[i]); i++)
+        {
+        }
+        cmp = toupper((unsigned char)name[i]) - (unsigned char)pname[i];
+        if (cmp == 0)
+            return periph;
+        if (cmp < 0)
+            high = mid;
+        else
+            low = mid + 1U;
+    }
+    return NULL;
+}
+
+// ==================== 帧处理 ====================
+
+/**
+ * @brief 上位机读取请求
+ * @note 在帧解码所在的任务中发送，期间该任务不处理其他输入
+ */
+static int32_t MemDiagFrameHandler(uint8_t id, const uint8_t *payload, uint16_t len)
+{
+    (void)id;
+    if ((len != 9) || (payload[0] != MEMDIAG_READ))
+        return -1;
+    return (MemDiagSend(mem_diag_get32(&payload[1]), mem_diag_get32(&payload[5])) < 0) ? -1 : 0;
+}
+FRAME_EXPORT(MEMDIAG_FRAME_ID, MemDiagFrameHandler);
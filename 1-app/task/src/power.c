@@ -0,0 +1,222 @@
+/**
+ * @file power.c
+ * @brief 能耗估算模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 电流表为名称到电流的静态数组，按名称查找；任务运行时间按编号保存上次读到的32位计数，
+ * 挂起调度器时读取全部任务状态，差值累加到64位。设备和CPU的时间由yDev累计，这里只提供电流
+ */
+
+// ==================== 包含文件 ====================
+#include "power.h"
+#include "board.h"
+#include "os_static.h"
+#include "yDev.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+_Static_assert(POWER_FOLD_MS < 4294967U, "POWER_FOLD_MS must be shorter than the 32-bit us wrap");
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 电流表项，name为NULL表示空闲
+ */
+typedef struct
+{
+    const char *name;   /**< 设备注册名或POWER_NAME_CPU_xxx */
+    uint32_t ua;        /**< 电流(uA) */
+} PowerLoad_t;
+
+/**
+ * @brief 任务的累计值
+ */
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN]; /**< 任务名 */
+    uint64_t run_us;                    /**< 累计运行时间 */
+    uint32_t last;                      /**< 上次读到的运行时间计数 */
+    uint32_t base_switches;             /**< 清零时的切入次数 */
+    uint8_t used;                       /**< 出现过 */
+    uint8_t idle;                       /**< 空闲任务 */
+} PowerTaskAcc_t;
+
+// ==================== 私有变量 ====================
+
+/**
+ * @brief 电流表，设备电流为唤醒时CPU之外的平均值，按板子实测修改
+ */
+static PowerLoad_t power_load[3 + POWER_DEVICE_MAX] = {
+    {POWER_NAME_CPU_RUN, POWER_CPU_RUN_UA},
+    {POWER_NAME_CPU_SLEEP, POWER_CPU_SLEEP_UA},
+    {POWER_NAME_CPU_STOP, POWER_CPU_STOP_UA},
+    {BOARD_UART3_NAME, 150},   // USART时钟和常开的接收DMA
+    {BOARD_FLASH0_NAME, 1500}, // SPI时钟加器件读写与待机电流的折中
+    {BOARD_LED0_NAME, 2000},   // TIM3和LED平均亮度下的电流
+    {BOARD_KEY0_NAME, 0},      // 上拉输入，按下时才有电流
+    {BOARD_BENCH_NAME, 150},   // USART时钟
+    {"dma0", 50},              // 内存拷贝时的DMA时钟
+};
+
+static TaskStatus_t power_status[POWER_TASK_MAX]; /**< 读取任务状态的缓冲区，只在挂起调度器时使用 */
+static PowerTaskAcc_t power_task[POWER_TASK_MAX];  /**< 按任务编号索引的累计值 */
+static uint32_t power_fold_ms;                     /**< 上次累加的时间 */
+static uint32_t power_reset_ms;                    /**< 上次清零的时间，0为上电 */
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 把各任务的运行时间差累加到64位
+ * @note 调用者挂起调度器，任务数超过POWER_TASK_MAX时本次不累加
+ */
+static void power_fold(void)
+{
+    PowerTaskAcc_t *acc;
+    TaskHandle_t idle;
+    UBaseType_t n;
+    UBaseType_t i;
+
+    idle = xTaskGetIdleTaskHandle();
+    n = uxTaskGetSystemState(power_status, POWER_TASK_MAX, NULL);
+    for (i = 0; i < n; i++)
+    {
+        if (power_status[i].xTaskNumber >= POWER_TASK_MAX)
+            continue;
+        acc = &power_task[power_status[i].xTaskNumber];
+        if (!acc->used)
+        {
+            // 首次出现的任务从创建时算起
+            strncpy(acc->name, power_status[i].pcTaskName, sizeof(acc->name) - 1U);
+            acc->used = 1;
+            acc->idle = (power_status[i].xHandle == idle) ? 1U : 0U;
+        }
+        acc->run_us += power_status[i].ulRunTimeCounter - acc->last;
+        acc->last = power_status[i].ulRunTimeCounter;
+    }
+    power_fold_ms = (uint32_t)yDevGetTimeMS();
+}
+
+/**
+ * @brief 查找电流表项
+ * @return 表项，没有时返回NULL
+ */
+static PowerLoad_t *power_find(const char *name)
+{
+    uint32_t i;
+
+    for (i = 0; i < OS_ARRAY_LEN(power_load); i++)
+    {
+        if ((power_load[i].name != NULL) && (strcmp(power_load[i].name, name) == 0))
+            return &power_load[i];
+    }
+    return NULL;
+}
+
+// ==================== 公共函数 ====================
+
+uint32_t PowerProcess(void)
+{
+    uint32_t elapsed;
+
+    elapsed = (uint32_t)yDevGetTimeMS() - power_fold_ms;
+    if (elapsed < POWER_FOLD_MS)
+        return POWER_FOLD_MS - elapsed;
+
+    vTaskSuspendAll();
+    power_fold();
+    (void)xTaskResumeAll();
+    return POWER_FOLD_MS;
+}
+
+uint32_t PowerGetTasks(PowerTask_t *out, uint32_t max)
+{
+    uint32_t n = 0;
+    uint32_t i;
+
+    vTaskSuspendAll();
+    power_fold();
+    for (i = 0; (i < POWER_TASK_MAX) && (n < max); i++)
+    {
+        if (!power_task[i].used)
+            continue;
+        strncpy(out[n].name, power_task[i].name, sizeof(out[n].name) - 1U);
+        out[n].name[sizeof(out[n].name) - 1U] = '\0';
+        out[n].number = i;
+        out[n].run_us = power_task[i].run_us;
+        out[n].switches = OsTaskSwitchCount(i) - power_task[i].base_switches;
+        out[n].idle = power_task[i].idle;
+        n++;
+    }
+    (void)xTaskResumeAll();
+    return n;
+}
+
+void PowerReset(void)
+{
+    uint32_t i;
+
+    vTaskSuspendAll();
+    power_fold();
+    for (i = 0; i < POWER_TASK_MAX; i++)
+    {
+        power_task[i].run_us = 0;
+        power_task[i].base_switches = OsTaskSwitchCount(i);
+    }
+    power_reset_ms = (uint32_t)yDevGetTimeMS();
+    (void)xTaskResumeAll();
+    yDevPmResetUsage();
+}
+
+uint32_t PowerGetElapsedMs(void)
+{
+    return (uint32_t)yDevGetTimeMS() - power_reset_ms;
+}
+
+uint32_t PowerGetCurrent(const char *name)
+{
+    PowerLoad_t *load = power_find(name);
+
+    return (load != NULL) ? load->ua : 0;
+}
+
+int32_t PowerSetCurrent(const char *name, uint32_t ua)
+{
+    PowerLoad_t *load = power_find(name);
+    const char *reg = NULL;
+    uint32_t i;
+
+    if (load == NULL)
+    {
+        // 表中只保存名字指针，新增的设备取注册表中的名字
+        for (i = 0; yDevIterate(i, &reg) != NULL; i++)
+        {
+            if (strcmp(reg, name) == 0)
+                break;
+        }
+        if ((reg == NULL) || (strcmp(reg, name) != 0))
+            return -1;
+        for (i = 0; i < OS_ARRAY_LEN(power_load); i++)
+        {
+            if (power_load[i].name == NULL)
+            {
+                load = &power_load[i];
+                load->name = reg;
+                break;
+            }
+        }
+    }
+    if (load == NULL)
+        return -1;
+    load->ua = ua;
+    return 0;
+}
+
+uint64_t PowerCharge(uint32_t ua, uint64_t us)
+{
+    // 1uAh = 3.6e9 uA*us，结果取nAh
+    return ((uint64_t)ua * us) / 3600000U;
+}
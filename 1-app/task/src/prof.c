@@ -0,0 +1,298 @@
+/**
+ * @file prof.c
+ * @brief 统计采样分析器实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 采样中断入口按EXC_RETURN选择被打断上下文的堆栈，取异常帧中的PC；
+ * 在Flash函数表中二分查找所在函数，以函数起始地址为键计入开放寻址的直方图。
+ * 直方图只有中断写入，读取方得到的是近似值，不需要加锁
+ */
+
+// ==================== 包含文件 ====================
+#include "prof.h"
+#include "yDrv_basic.h"
+#include "stm32g0xx_ll_bus.h"
+#include "stm32g0xx_ll_tim.h"
+#include <string.h>
+
+_Static_assert(((PROF_BINS & (PROF_BINS - 1)) == 0) && (PROF_BINS <= 256), "PROF_BINS must be a power of two up to 256");
+
+// ==================== 私有宏定义 ====================
+#define PROF_TIM_HZ 1000000U /**< 定时器计数频率 */
+#define PROF_RATE_MIN 16U    /**< 最低采样频率，重装载值不超过16位 */
+#define PROF_RATE_MAX 20000U /**< 最高采样频率，采样中断占用不超过几个百分点 */
+#define PROF_PROBE_MAX 8U    /**< 直方图冲突时最多探测的项数 */
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 函数表头部
+ */
+typedef struct
+{
+    uint32_t magic;     /**< PROF_SYMS_MAGIC */
+    uint32_t count;     /**< 函数数 */
+    uint32_t names;     /**< 名字区相对表起始的偏移 */
+} ProfSymsHeader_t;
+
+/**
+ * @brief 函数表项
+ */
+typedef struct
+{
+    uint32_t addr;      /**< 起始地址，已去掉Thumb位 */
+    uint16_t size;      /**< 长度 */
+    uint16_t name;      /**< 名字相对名字区的偏移 */
+} ProfSym_t;
+
+/**
+ * @brief 直方图项，addr为0表示空闲
+ */
+typedef struct
+{
+    uint32_t addr;      /**< 函数起始地址或对齐后的PC */
+    uint32_t count;     /**< 样本数 */
+} ProfBin_t;
+
+// ==================== 私有变量 ====================
+
+#if (PROF_SYMS_SIZE > 0)
+/**
+ * @brief 函数表，链接后由tools/prof_syms.py填写
+ * @note 初值全0，未填写时魔数不符，按地址计数
+ */
+static const uint8_t prof_syms[PROF_SYMS_SIZE] __attribute__((section(".prof_syms"), used, aligned(4))) = {0};
+#endif
+
+static ProfBin_t prof_bins[PROF_BINS];     /**< 直方图 */
+static volatile uint32_t prof_samples;     /**< 样本总数 */
+static volatile uint32_t prof_other;       /**< 直方图满未计入的样本数 */
+static uint32_t prof_rate;                 /**< 实际采样频率 */
+static uint8_t prof_running;               /**< 正在采样 */
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 取有效的函数表
+ * @param syms 输出函数项数组
+ * @return 函数数，没有函数表返回0
+ */
+static uint32_t prof_table(const ProfSym_t **syms)
+{
+#if (PROF_SYMS_SIZE > 0)
+    const ProfSymsHeader_t *hdr = (const ProfSymsHeader_t *)(const void *)prof_syms;
+
+    if ((hdr->magic != PROF_SYMS_MAGIC) ||
+        (sizeof(*hdr) + hdr->count * sizeof(ProfSym_t) > hdr->names) || (hdr->names > PROF_SYMS_SIZE))
+        return 0;
+    *syms = (const ProfSym_t *)(const void *)(prof_syms + sizeof(*hdr));
+    return hdr->count;
+#else
+    (void)syms;
+    return 0;
+#endif
+}
+
+/**
+ * @brief PC所在函数的起始地址
+ * @return 不在函数表中时返回按PROF_GRANULE对齐的PC
+ * @note 找最后一个起始地址不大于PC的函数，再检查PC是否在其长度内
+ */
+static uint32_t prof_lookup(uint32_t pc)
+{
+    const ProfSym_t *syms = NULL;
+    uint32_t n = prof_table(&syms);
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    uint32_t mid;
+
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2U;
+        if (syms[mid].addr <= pc)
+            lo = mid + 1U;
+        else
+            hi = mid;
+    }
+    if ((lo != 0) && (pc - syms[lo - 1U].addr < syms[lo - 1U].size))
+        return syms[lo - 1U].addr;
+    return pc & ~(PROF_GRANULE - 1U);
+}
+
+/**
+ * @brief 起始地址对应的函数名
+ * @return 不是函数表中的函数起始地址时返回NULL
+ */
+static const char *prof_name(uint32_t addr)
+{
+    const ProfSym_t *syms = NULL;
+    uint32_t n = prof_table(&syms);
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    uint32_t mid;
+
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2U;
+        if (syms[mid].addr < addr)
+            lo = mid + 1U;
+        else
+            hi = mid;
+    }
+#if (PROF_SYMS_SIZE > 0)
+    if ((lo < n) && (syms[lo].addr == addr))
+        return (const char *)prof_syms + ((const ProfSymsHeader_t *)(const void *)prof_syms)->names + syms[lo].name;
+#endif
+    return NULL;
+}
+
+/**
+ * @brief 采样中断的C语言部分
+ * @param frame 被打断上下文的异常帧：r0 r1 r2 r3 r12 lr pc xpsr
+ */
+static void __attribute__((used)) prof_isr(const uint32_t *frame)
+{
+    uint32_t addr;
+    uint32_t slot;
+    uint32_t i;
+
+    TIM16->SR = ~TIM_SR_UIF;
+
+    addr = prof_lookup(frame[6]);
+    prof_samples++;
+
+    // 乘法散列后线性探测，M0+的乘法为单周期
+    slot = ((addr >> 1) * 2654435761UL) >> 24;
+    for (i = 0; i < PROF_PROBE_MAX; i++, slot++)
+    {
+        ProfBin_t *bin = &prof_bins[slot & (PROF_BINS - 1U)];
+
+        if (bin->addr == addr)
+        {
+            bin->count++;
+            return;
+        }
+        if (bin->addr == 0)
+        {
+            bin->count = 1;
+            bin->addr = addr;
+            return;
+        }
+    }
+    prof_other++;
+}
+
+// ==================== 中断处理函数 ====================
+
+/**
+ * @brief TIM16中断入口
+ * @note 按EXC_RETURN的bit2选择被打断上下文的堆栈(MSP/PSP)，异常帧地址作为参数；
+ *       压入lr时一并压入r1保持8字节对齐，返回时弹出到pc完成异常返回
+ */
+void __attribute__((naked)) TIM16_IRQHandler(void)
+{
+    __asm volatile("movs r0, #4          \n"
+                   "mov  r1, lr          \n"
+                   "tst  r0, r1          \n"
+                   "beq  1f              \n"
+                   "mrs  r0, psp         \n"
+                   "b    2f              \n"
+                   "1:                   \n"
+                   "mrs  r0, msp         \n"
+                   "2:                   \n"
+                   "push {r1, lr}        \n"
+                   "bl   prof_isr        \n"
+                   "pop  {r1, pc}        \n");
+}
+
+// ==================== 公共函数 ====================
+
+int32_t ProfStart(uint32_t rate)
+{
+    LL_TIM_InitTypeDef init = {0};
+
+    if (rate == 0)
+        rate = PROF_RATE_DEFAULT;
+    if ((rate < PROF_RATE_MIN) || (rate > PROF_RATE_MAX))
+        return -1;
+
+    ProfStop();
+    memset(prof_bins, 0, sizeof(prof_bins));
+    prof_samples = 0;
+    prof_other = 0;
+
+    // 与TIM17时基相同，APB不分频时定时器时钟等于SystemCoreClock
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM16);
+    init.Prescaler = (uint16_t)(SystemCoreClock / PROF_TIM_HZ - 1U);
+    init.CounterMode = LL_TIM_COUNTERMODE_UP;
+    init.Autoreload = (PROF_TIM_HZ + rate / 2U) / rate - 1U;
+    init.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1;
+    LL_TIM_Init(TIM16, &init);
+    LL_TIM_ClearFlag_UPDATE(TIM16);
+    prof_rate = PROF_TIM_HZ / (init.Autoreload + 1U);
+
+    yDrvIrqSetPriority(TIM16_IRQn, YDRV_IRQ_PRIO_PROF);
+    NVIC_EnableIRQ(TIM16_IRQn);
+    LL_TIM_EnableIT_UPDATE(TIM16);
+    LL_TIM_EnableCounter(TIM16);
+    prof_running = 1;
+
+    return (int32_t)prof_rate;
+}
+
+void ProfStop(void)
+{
+    if (!prof_running)
+        return;
+    LL_TIM_DisableCounter(TIM16);
+    LL_TIM_DisableIT_UPDATE(TIM16);
+    NVIC_DisableIRQ(TIM16_IRQn);
+    LL_APB2_GRP1_DisableClock(LL_APB2_GRP1_PERIPH_TIM16);
+    prof_running = 0;
+}
+
+void ProfGetStats(ProfStats_t *stats)
+{
+    const ProfSym_t *syms = NULL;
+
+    stats->rate = prof_rate;
+    stats->samples = prof_samples;
+    stats->other = prof_other;
+    stats->symbols = prof_table(&syms);
+    stats->running = prof_running;
+}
+
+uint32_t ProfTop(ProfEntry_t *out, uint32_t max)
+{
+    uint8_t taken[PROF_BINS];
+    uint32_t n = 0;
+    uint32_t best;
+    uint32_t i;
+
+    memset(taken, 0, sizeof(taken));
+
+    // 项数很少，每次选出剩余项中最多的
+    while (n < max)
+    {
+        best = PROF_BINS;
+        for (i = 0; i < PROF_BINS; i++)
+        {
+            if ((prof_bins[i].addr != 0) && !taken[i] &&
+                ((best == PROF_BINS) || (prof_bins[i].count > out[n].count)))
+            {
+                best = i;
+                out[n].count = prof_bins[i].count;
+            }
+        }
+        if (best == PROF_BINS)
+            break;
+        out[n].addr = prof_bins[best].addr;
+        out[n].name = prof_name(out[n].addr);
+        taken[best] = 1;
+        n++;
+    }
+    return n;
+}
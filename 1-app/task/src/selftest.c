@@ -0,0 +1,298 @@
+/**
+ * @file selftest.c
+ * @brief 自检模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 自检框架和内置自检项：25Q芯片ID、测试扇区图案读写、串口回环和RAM March C-；
+ * 其他模块可在自己的文件中用SELFTEST_EXPORT登记自检项
+ */
+
+// ==================== 包含文件 ====================
+#include "selftest.h"
+#include "flash.h"
+#include "yDev.h"
+#include "yDev_25q.h"
+#include "yDrv_basic.h"
+#include "yLib_heap.h"
+#include "yLib_log.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define SELFTEST_UART_BYTES 16        /**< 回环测试的字节数 */
+#define SELFTEST_UART_TIMEOUT_MS 20   /**< 每个字节等待回环的时间 */
+
+// ==================== 私有变量 ====================
+
+/* 链接脚本在.selftest段前后定义 */
+extern const SelfTest_t __selftest_start[];
+extern const SelfTest_t __selftest_end[];
+
+static const char *const selftest_result_name[] = {"pass", "FAIL", "skip"};
+
+// ==================== 内置自检项 ====================
+
+/**
+ * @brief 25Q芯片ID：能读出JEDEC ID且容量已识别
+ * @note 首次访问完成芯片探测
+ */
+static SelfTestResult_t SelfTestFlashId(char *detail, uint32_t size)
+{
+    yDevHandle_25q_t *dev = FlashGetHandle();
+    uint32_t id = 0;
+
+    if ((dev == NULL) || (yDevIoctl(dev, YDEV_25Q_IOCTL_READ_JEDEC_ID, &id) != YDEV_OK))
+        return SELFTEST_FAIL;
+
+    id &= 0xFFFFFFUL;
+    snprintf(detail, size, "id %06lx, %lu KB", (unsigned long)id, (unsigned long)(dev->size / 1024U));
+    return ((id == 0) || (id == 0xFFFFFFUL) || (dev->size == 0)) ? SELFTEST_FAIL : SELFTEST_PASS;
+}
+SELFTEST_EXPORT(flash_id, SelfTestFlashId, SELFTEST_QUICK);
+
+/**
+ * @brief 测试扇区图案读写：擦除FLASH_BENCH_ADDRESS扇区，逐页写入与地址相关的图案后读回比较
+ */
+static SelfTestResult_t SelfTestFlashPattern(char *detail, uint32_t size)
+{
+    yDevHandle_25q_t *dev = FlashGetHandle();
+    uint8_t page[YDEV_25Q_PAGE_SIZE];
+    uint8_t expect;
+    uint32_t address = FLASH_BENCH_ADDRESS;
+    uint32_t offset;
+    uint32_t i;
+
+    if ((dev == NULL) || (yDevIoctl(dev, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK))
+    {
+        snprintf(detail, size, "erase failed");
+        return SELFTEST_FAIL;
+    }
+
+    for (offset = 0; offset < FLASH_BENCH_SIZE; offset += sizeof(page))
+    {
+        for (i = 0; i < sizeof(page); i++)
+            page[i] = (uint8_t)((offset + i) ^ (offset >> 8) ^ 0xA5U);
+        dev->address = FLASH_BENCH_ADDRESS + offset;
+        if (yDevWrite(dev, page, sizeof(page)) != (int32_t)sizeof(page))
+        {
+            snprintf(detail, size, "write failed at 0x%lx", (unsigned long)(FLASH_BENCH_ADDRESS + offset));
+            return SELFTEST_FAIL;
+        }
+    }
+
+    for (offset = 0; offset < FLASH_BENCH_SIZE; offset += sizeof(page))
+    {
+        if (yDev25qRead(dev, FLASH_BENCH_ADDRESS + offset, page, sizeof(page)) != (int32_t)sizeof(page))
+        {
+            snprintf(detail, size, "read failed at 0x%lx", (unsigned long)(FLASH_BENCH_ADDRESS + offset));
+            return SELFTEST_FAIL;
+        }
+        for (i = 0; i < sizeof(page); i++)
+        {
+            expect = (uint8_t)((offset + i) ^ (offset >> 8) ^ 0xA5U);
+            if (page[i] != expect)
+            {
+                snprintf(detail, size, "0x%lx: %02x != %02x", (unsigned long)(FLASH_BENCH_ADDRESS + offset + i),
+                         page[i], expect);
+                return SELFTEST_FAIL;
+            }
+        }
+    }
+
+    snprintf(detail, size, "%lu bytes", (unsigned long)FLASH_BENCH_SIZE);
+    return SELFTEST_PASS;
+}
+SELFTEST_EXPORT(flash_pattern, SelfTestFlashPattern, SELFTEST_SLOW);
+
+/**
+ * @brief 串口回环：逐字节发送后等待收回，TX与RX须短接
+ * @note 未配置接收流时按轮询读取，逐字节收发不会溢出
+ */
+static SelfTestResult_t SelfTestUartLoopbackRun(void *dev, char *detail, uint32_t size)
+{
+    uint32_t start;
+    uint32_t i;
+    uint8_t tx;
+    uint8_t rx;
+
+    for (i = 0; i < SELFTEST_UART_BYTES; i++)
+    {
+        tx = (uint8_t)(0x55U ^ (i * 37U));
+        if (yDevWrite(dev, &tx, 1) != 1)
+        {
+            snprintf(detail, size, "write failed");
+            return SELFTEST_FAIL;
+        }
+        start = (uint32_t)yDevGetTimeMS();
+        while (yDevRead(dev, &rx, 1) != 1)
+        {
+            if ((uint32_t)yDevGetTimeMS() - start >= SELFTEST_UART_TIMEOUT_MS)
+            {
+                snprintf(detail, size, "byte %lu timeout", (unsigned long)i);
+                return SELFTEST_FAIL;
+            }
+            vTaskDelay(1);
+        }
+        if (rx != tx)
+        {
+            snprintf(detail, size, "byte %lu: %02x != %02x", (unsigned long)i, rx, tx);
+            return SELFTEST_FAIL;
+        }
+    }
+
+    snprintf(detail, size, "%u bytes", (unsigned int)SELFTEST_UART_BYTES);
+    return SELFTEST_PASS;
+}
+
+/**
+ * @brief 串口回环自检入口
+ * @note 测试期间持有一次引用，其他模块释放串口时不会反初始化
+ */
+static SelfTestResult_t SelfTestUartLoopback(char *detail, uint32_t size)
+{
+    SelfTestResult_t result;
+    void *dev = yDevOpen(SELFTEST_UART_NAME);
+
+    if (dev == NULL)
+    {
+        snprintf(detail, size, "%s not registered", SELFTEST_UART_NAME);
+        return SELFTEST_SKIP;
+    }
+
+    result = SelfTestUartLoopbackRun(dev, detail, size);
+    (void)yDevDeinitStatic(dev);
+    return result;
+}
+SELFTEST_EXPORT(uart_loopback, SelfTestUartLoopback, SELFTEST_MANUAL);
+
+/**
+ * @brief RAM March C-：在从堆上借用的一块内存上检测固定、耦合和地址译码故障
+ * @note {⇕(w0); ⇑(r0,w1); ⇑(r1,w0); ⇓(r0,w1); ⇓(r1,w0); ⇕(r0)}，按字访问，数据为全0和全1
+ */
+static SelfTestResult_t SelfTestRamMarch(char *detail, uint32_t size)
+{
+    static const uint32_t pattern[2] = {0, 0xFFFFFFFFUL};
+    volatile uint32_t *mem;
+    uint32_t words = SELFTEST_RAM_BYTES / sizeof(uint32_t);
+    uint32_t step;
+    uint32_t bad = words;
+    uint32_t i;
+    uint32_t k;
+    uint32_t r;
+    uint32_t w;
+
+#if YLIB_NO_HEAP_AFTER_INIT
+    if (ylib_heap_sealed())
+    {
+        snprintf(detail, size, "heap sealed");
+        return SELFTEST_SKIP;
+    }
+#endif
+    mem = (volatile uint32_t *)ylib_malloc(SELFTEST_RAM_BYTES);
+    if (mem == NULL)
+    {
+        snprintf(detail, size, "no heap for %u bytes", (unsigned int)SELFTEST_RAM_BYTES);
+        return SELFTEST_SKIP;
+    }
+
+    for (i = 0; i < words; i++)
+        mem[i] = pattern[0];
+
+    // 四个读写单元：前两个地址递增，后两个地址递减；读r写w交替
+    for (step = 0; (step < 4U) && (bad == words); step++)
+    {
+        r = step & 1U;
+        w = r ^ 1U;
+        for (k = 0; k < words; k++)
+        {
+            i = (step < 2U) ? k : (words - 1U - k);
+            if (mem[i] != pattern[r])
+            {
+                bad = i;
+                break;
+            }
+            mem[i] = pattern[w];
+        }
+    }
+    for (i = 0; (i < words) && (bad == words); i++)
+    {
+        if (mem[i] != pattern[0])
+            bad = i;
+    }
+
+    if (bad != words)
+        snprintf(detail, size, "fault at %p", (void *)&mem[bad]);
+    else
+        snprintf(detail, size, "%u bytes at %p", (unsigned int)SELFTEST_RAM_BYTES, (void *)mem);
+    ylib_free((void *)mem);
+    return (bad == words) ? SELFTEST_PASS : SELFTEST_FAIL;
+}
+SELFTEST_EXPORT(ram_march, SelfTestRamMarch, SELFTEST_QUICK);
+
+// ==================== 公共函数 ====================
+
+const SelfTest_t *SelfTestIterate(uint32_t index)
+{
+    const SelfTest_t *test = __selftest_start + index;
+
+    return (test < __selftest_end) ? test : NULL;
+}
+
+const SelfTest_t *SelfTestFind(const char *name)
+{
+    const SelfTest_t *test;
+
+    for (test = __selftest_start; test < __selftest_end; test++)
+    {
+        if (strcmp(test->name, name) == 0)
+            return test;
+    }
+    return NULL;
+}
+
+SelfTestResult_t SelfTestRunOne(const SelfTest_t *test, SelfTestReport_t *report)
+{
+    uint32_t start;
+
+    memset(report, 0, sizeof(*report));
+    start = yDrvGetTimeUs();
+    report->result = test->run(report->detail, sizeof(report->detail));
+    report->us = yDrvGetTimeUs() - start;
+    return report->result;
+}
+
+uint32_t SelfTestRun(uint32_t mask, SelfTestNotify_t notify, void *arg)
+{
+    const SelfTest_t *test;
+    SelfTestReport_t report;
+    uint32_t failed = 0;
+
+    for (test = __selftest_start; test < __selftest_end; test++)
+    {
+        if ((test->flags & mask) == 0)
+            continue;
+
+        if (SelfTestRunOne(test, &report) == SELFTEST_FAIL)
+            failed++;
+
+        // 日志只能保存常量字符串，结果说明在shell中查看
+        if (notify != NULL)
+            notify(arg, test, &report);
+        else if (report.result == SELFTEST_FAIL)
+            YLIB_LOGE("selftest %s %s, %u us", test->name, selftest_result_name[report.result], report.us);
+        else
+            YLIB_LOGI("selftest %s %s, %u us", test->name, selftest_result_name[report.result], report.us);
+    }
+
+    return failed;
+}
+
+const char *SelfTestResultName(SelfTestResult_t result)
+{
+    return ((uint32_t)result < 3U) ? selftest_result_name[result] : "?";
+}
@@ -0,0 +1,381 @@
+/**
+ * @file sensor.c
+ * @brief 传感器采样管理模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 采样任务睡到最早的到期时刻，醒来后先启动IIC链(在传输结束中断中逐个接续)，
+ * 再把到期的SPI传感器按总线和时钟参数排序后逐条总线执行批量事务，最后等IIC链结束，
+ * 统一解码发布；每批只在SPI每组参数和IIC链结束时各唤醒一次任务
+ */
+
+// ==================== 包含文件 ====================
+#include "sensor.h"
+#include "os_event.h"
+#include "os_static.h"
+#include "watchdog.h"
+#include "yDev.h"
+#include "yDev_iic.h"
+#include "yDev_spibus.h"
+#include "yDrv_basic.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define SENSOR_TASK_PRIO 20        /**< 高于shell，低于中断下半部工作任务 */
+#define SENSOR_STK_SIZE 256        /**< 采样任务堆栈(字) */
+#define SENSOR_BUS_WAIT_MS 50      /**< 等待SPI总线的超时 */
+#define SENSOR_EVENT_IIC (1U << 0) /**< IIC链结束 */
+
+// ==================== 私有变量 ====================
+
+OS_TASK_DEFINE(sensor_task, SENSOR_STK_SIZE);
+
+static TaskHandle_t sensor_task;
+static Sensor_t *sensor_table[SENSOR_MAX];
+static volatile uint32_t sensor_count;
+static SensorSub_t *sensor_subs;
+static SensorStats_t sensor_stats;
+
+/* 本批到期的SPI传感器，与批量事务项一一对应 */
+static Sensor_t *sensor_spi[SENSOR_MAX];
+static yDevSpiBusBatchItem_t sensor_spi_item[SENSOR_MAX];
+
+/* 本批到期的IIC传感器，在中断中逐个接续 */
+static Sensor_t *sensor_iic[SENSOR_MAX];
+static uint32_t sensor_iic_count;
+static volatile uint32_t sensor_iic_index;
+static OsEvent_t sensor_event = OS_EVENT_INIT(); /* IIC链结束由中断置位 */
+
+MSGBUS_TOPIC_DEFINE(sensor);
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 从当前项开始启动IIC传输，启动失败的项标记失败后跳过
+ * @note 在任务中启动第一项，之后在IIC中断中调用；全部结束时置位事件
+ */
+static void sensor_iic_next(void)
+{
+    Sensor_t *sensor;
+    yDevHandle_Iic_t *iic;
+
+    while (sensor_iic_index < sensor_iic_count)
+    {
+        sensor = sensor_iic[sensor_iic_index];
+        iic = (yDevHandle_Iic_t *)sensor->dev;
+        if (yDrvI2cTransfer(&iic->drv_handle, sensor->addr, sensor->cmd, sensor->cmd_len, sensor->raw,
+                            sensor->raw_len) == YDRV_OK)
+            return;
+        sensor->status = 1;
+        sensor->time_us = yDrvGetTimeUs();
+        sensor_iic_index++;
+    }
+
+    OsEventSet(&sensor_event, SENSOR_EVENT_IIC);
+}
+
+/**
+ * @brief IIC传输结束回调，登记时接管设备句柄的用户回调
+ */
+static void sensor_iic_callback(void *arg, yDrvI2cResult_t result)
+{
+    Sensor_t *sensor;
+
+    (void)arg;
+    if (sensor_iic_index >= sensor_iic_count)
+        return;
+
+    sensor = sensor_iic[sensor_iic_index];
+    sensor->time_us = yDrvGetTimeUs();
+    sensor->status = (result == YDRV_I2C_RESULT_OK) ? 0U : 1U;
+    sensor_iic_index++;
+    sensor_iic_next();
+}
+
+/**
+ * @brief 等待IIC链结束，超时中止当前传输，剩余项标记失败
+ */
+static void sensor_iic_wait(void)
+{
+    Sensor_t *sensor;
+    uint32_t i;
+
+    if (OsEventWait(&sensor_event, pdMS_TO_TICKS(SENSOR_IIC_TIMEOUT_MS * sensor_iic_count)) & SENSOR_EVENT_IIC)
+        return;
+
+    // 超时后中断可能刚好结束链，关中断再取一次
+    taskENTER_CRITICAL();
+    if (!(OsEventTake(&sensor_event) & SENSOR_EVENT_IIC))
+    {
+        sensor = sensor_iic[sensor_iic_index];
+        (void)yDrvI2cAbort(&((yDevHandle_Iic_t *)sensor->dev)->drv_handle);
+        for (i = sensor_iic_index; i < sensor_iic_count; i++)
+            sensor_iic[i]->status = 1;
+        sensor_iic_index = sensor_iic_count;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief SPI排序键：同一总线相邻，同一总线上时钟参数相同的相邻
+ */
+static uint32_t sensor_spi_key(const Sensor_t *sensor)
+{
+    const yDevSpiBusDevice_t *device = (const yDevSpiBusDevice_t *)sensor->dev;
+
+    return ((uint32_t)device->polarity << 16) | ((uint32_t)device->phase << 8) | (uint32_t)device->speed;
+}
+
+static int32_t sensor_spi_before(const Sensor_t *a, const Sensor_t *b)
+{
+    const yDevSpiBusDevice_t *da = (const yDevSpiBusDevice_t *)a->dev;
+    const yDevSpiBusDevice_t *db = (const yDevSpiBusDevice_t *)b->dev;
+
+    if (da->bus != db->bus)
+        return ((uintptr_t)da->bus < (uintptr_t)db->bus) ? 1 : 0;
+    return (sensor_spi_key(a) < sensor_spi_key(b)) ? 1 : 0;
+}
+
+/**
+ * @brief 逐条总线执行本批SPI事务
+ */
+static void sensor_spi_run(uint32_t count)
+{
+    yDevSpiBus_t *bus;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+
+    for (i = 0; i < count; i++)
+    {
+        sensor_spi_item[i].device = (yDevSpiBusDevice_t *)sensor_spi[i]->dev;
+        sensor_spi_item[i].seg = (sensor_spi[i]->cmd_len != 0U) ? &sensor_spi[i]->seg[0] : &sensor_spi[i]->seg[1];
+        sensor_spi_item[i].count = (sensor_spi[i]->cmd_len != 0U) ? 2U : 1U;
+        sensor_spi_item[i].status = YDEV_ERROR;
+    }
+
+    for (i = 0; i < count; i = j)
+    {
+        bus = sensor_spi_item[i].device->bus;
+        for (j = i + 1U; (j < count) && (sensor_spi_item[j].device->bus == bus); j++)
+        {
+        }
+        if (yDevSpiBusBatch(bus, &sensor_spi_item[i], j - i, YDEV_BUSJOB_URGENT, 0, SENSOR_BUS_WAIT_MS) != YDEV_OK)
+        {
+            for (k = i; k < j; k++)
+                sensor_spi_item[k].timeUs = yDrvGetTimeUs();
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        sensor_spi[i]->status = (sensor_spi_item[i].status == YDEV_OK) ? 0U : 1U;
+        sensor_spi[i]->time_us = sensor_spi_item[i].timeUs;
+    }
+}
+
+/**
+ * @brief 解码并写入订阅者队列
+ */
+static void sensor_publish(Sensor_t *sensor)
+{
+    SensorSample_t sample;
+    SensorSub_t *sub;
+    uint32_t n;
+
+    memset(&sample, 0, sizeof(sample));
+    sample.time_us = sensor->time_us;
+    sample.sensor = sensor->id;
+    sample.status = sensor->status;
+    if (sensor->status == 0U)
+    {
+        sensor->samples++;
+        sensor_stats.samples++;
+        if (sensor->decode != NULL)
+        {
+            n = sensor->decode(sensor, sensor->raw, sample.value);
+            sample.count = (uint8_t)((n < SENSOR_VALUES_MAX) ? n : SENSOR_VALUES_MAX);
+        }
+    }
+    else
+    {
+        sensor->errors++;
+        sensor_stats.errors++;
+    }
+
+    for (sub = sensor_subs; sub != NULL; sub = sub->next)
+    {
+        if ((sub->mask != 0U) && !(sub->mask & (1UL << sensor->id)))
+            continue;
+        if (!ylib_ring_enqueue(sub->ring, &sample, sizeof(sample)))
+            sub->dropped++;
+    }
+
+    (void)MsgBusPublish(MSGBUS_TOPIC(sensor), &sample, sizeof(sample));
+}
+
+/**
+ * @brief 采样任务
+ */
+static void sensor_task_entry(void *pvParameters)
+{
+    Sensor_t *sensor;
+    SensorSub_t *sub;
+    uint32_t now;
+    uint32_t wait;
+    uint32_t remain;
+    uint32_t start;
+    uint32_t count;
+    uint32_t nspi;
+    uint32_t i;
+    uint32_t k;
+    int32_t wdg;
+
+    (void)pvParameters;
+    wdg = WatchdogRegister("sensor", WATCHDOG_DEADLINE_MS);
+    for (;;)
+    {
+        WatchdogCheckin(wdg);
+
+        // 收集到期的传感器，SPI按总线和时钟参数插入排序
+        now = (uint32_t)yDevGetTimeMS();
+        count = sensor_count;
+        wait = SENSOR_IDLE_MS;
+        nspi = 0;
+        sensor_iic_count = 0;
+        for (i = 0; i < count; i++)
+        {
+            sensor = sensor_table[i];
+            if ((int32_t)(now - sensor->due_ms) >= 0)
+            {
+                sensor->due_ms += sensor->period_ms;
+                if ((int32_t)(now - sensor->due_ms) >= 0)
+                {
+                    sensor->due_ms = now + sensor->period_ms;
+                    sensor_stats.late++;
+                }
+
+                if (sensor->bus == SENSOR_BUS_IIC)
+                {
+                    sensor_iic[sensor_iic_count++] = sensor;
+                }
+                else
+                {
+                    for (k = nspi; (k > 0U) && sensor_spi_before(sensor, sensor_spi[k - 1U]); k--)
+                        sensor_spi[k] = sensor_spi[k - 1U];
+                    sensor_spi[k] = sensor;
+                    nspi++;
+                }
+            }
+            remain = sensor->due_ms - now;
+            if (remain < wait)
+                wait = remain;
+        }
+
+        if ((nspi == 0U) && (sensor_iic_count == 0U))
+        {
+            vTaskDelay(pdMS_TO_TICKS(wait) + 1U);
+            continue;
+        }
+
+        // IIC链在中断中推进，与SPI批量同时进行
+        start = yDrvGetTimeUs();
+        if (sensor_iic_count != 0U)
+        {
+            sensor_iic_index = 0;
+            (void)OsEventTake(&sensor_event);
+            sensor_iic_next();
+        }
+        if (nspi != 0U)
+            sensor_spi_run(nspi);
+        if (sensor_iic_count != 0U)
+            sensor_iic_wait();
+
+        for (i = 0; i < nspi; i++)
+            sensor_publish(sensor_spi[i]);
+        for (i = 0; i < sensor_iic_count; i++)
+            sensor_publish(sensor_iic[i]);
+
+        for (sub = sensor_subs; sub != NULL; sub = sub->next)
+        {
+            if ((sub->task != NULL) && !ylib_ring_empty(sub->ring))
+                xTaskNotifyGive((TaskHandle_t)sub->task);
+        }
+
+        sensor_stats.batches++;
+        remain = yDrvGetTimeUs() - start;
+        if (remain > sensor_stats.max_busy_us)
+            sensor_stats.max_busy_us = remain;
+    }
+}
+
+// ==================== 公共函数 ====================
+
+void SensorInit(void)
+{
+    sensor_task = OS_TASK_CREATE(sensor_task, sensor_task_entry, "sensor", NULL, SENSOR_TASK_PRIO);
+    OsEventInit(&sensor_event, sensor_task);
+}
+
+int32_t SensorRegister(Sensor_t *sensor)
+{
+    int32_t id = -1;
+
+    if ((sensor == NULL) || (sensor->dev == NULL) || (sensor->raw_len == 0U) ||
+        (sensor->raw_len > SENSOR_RAW_MAX) || (sensor->period_ms == 0U) ||
+        ((sensor->cmd_len != 0U) && (sensor->cmd == NULL)) ||
+        ((sensor->bus != SENSOR_BUS_SPI) && (sensor->bus != SENSOR_BUS_IIC)))
+        return -1;
+
+    sensor->seg[0] = (yDrvSpiSeg_t){sensor->cmd, NULL, sensor->cmd_len};
+    sensor->seg[1] = (yDrvSpiSeg_t){NULL, sensor->raw, sensor->raw_len};
+    sensor->due_ms = (uint32_t)yDevGetTimeMS();
+    sensor->samples = 0;
+    sensor->errors = 0;
+    sensor->status = 0;
+
+    taskENTER_CRITICAL();
+    if (sensor_count < SENSOR_MAX)
+    {
+        if (sensor->bus == SENSOR_BUS_IIC)
+        {
+            ((yDevHandle_Iic_t *)sensor->dev)->callback = sensor_iic_callback;
+            ((yDevHandle_Iic_t *)sensor->dev)->arg = NULL;
+        }
+        id = (int32_t)sensor_count;
+        sensor->id = (uint16_t)id;
+        sensor_table[id] = sensor;
+        sensor_count = (uint32_t)id + 1U;
+    }
+    taskEXIT_CRITICAL();
+    return id;
+}
+
+Sensor_t *SensorGet(uint32_t id)
+{
+    return (id < sensor_count) ? sensor_table[id] : NULL;
+}
+
+void SensorSubscribe(SensorSub_t *sub)
+{
+    sub->dropped = 0;
+    taskENTER_CRITICAL();
+    sub->next = sensor_subs;
+    sensor_subs = sub;
+    taskEXIT_CRITICAL();
+}
+
+int32_t SensorRead(SensorSub_t *sub, SensorSample_t *sample)
+{
+    return ylib_ring_dequeue(sub->ring, sample, sizeof(*sample));
+}
+
+void SensorGetStats(SensorStats_t *stats)
+{
+    *stats = sensor_stats;
+    stats->sensors = sensor_count;
+}
@@ -11,12 +11,85 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
+#include "os_lock.h"
+#include "os_static.h"
 
+#include "blink.h"
+#include "board.h"
 #include "communication.h"
+#include "crashdump.h"
+#include "datalog.h"
+#include "flash.h"
+#include "frame.h"
+#include "fwupdate.h"
+#include "heaptrace.h"
+#include "lin.h"
+#include "logsink.h"
+#include "memdiag.h"
+#include "msgbus.h"
+#include "mux.h"
+#include "power.h"
+#include "prof.h"
+#include "selftest.h"
+#include "sensor.h"
 #include "serialshell.h"
+#include "settings.h"
+#include "tracerec.h"
+#include "watch.h"
+#include "watchdog.h"
+#include "yDev.h"
+#include "yDev_dma.h"
+#include "yDrv_clock.h"
+#include "yDrv_dma.h"
+#include "yDrv_fault.h"
+#include "yDrv_usart.h"
+#include "yLib_bench.h"
+#include "yLib_cache.h"
+#include "yLib_heap.h"
+#include "yLib_log.h"
+#include "yLib_memops.h"
+#include "yLib_probe.h"
+#include "yLib_ring.h"
+#include "yLib_mempool.h"
+#include "yLib_trace.h"
+#include "yLib_work.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SHELL_TUNNEL_RETRY 50     /**< 隧道输出发送队列满时的重试次数，每次等待1个滴答 */
+#define SHELL_PEAK_KEY "bufpeak"  /**< 缓冲区用量历史峰值的KV键 */
+#define SHELL_PEAK_MARGIN_SHIFT 2 /**< 建议大小在峰值上留出的余量，峰值的1/4 */
+#define SHELL_PEAK_ALIGN 32U      /**< 建议大小的对齐粒度 */
+
+/**
+ * @brief 缓冲区用量峰值，保存在KV中时取历次启动的最大值
+ */
+typedef struct
+{
+    uint32_t rx;   /**< 接收缓冲区未读数据 */
+    uint32_t tx;   /**< 发送队列未发出数据 */
+    uint32_t line; /**< shell输入行长度 */
+} serial_shell_peak_t;
 
 static Shell shell;
-static char shell_buffer[512];
+static char *shell_buffer;
+static uint32_t shell_buffer_size;
+static Shell shell_tunnel;
+static char *shell_tunnel_buffer;
+static uint8_t shell_tunnel_open = 0;
+static uint32_t shell_line_peak;      /**< 本次启动的最长输入行 */
+static volatile uint8_t shell_resize; /**< 有待处理的缓冲区更换请求 */
+
+YLIB_PROBE_DEFINE(shell_cmd);  /**< 回车的处理耗时，含命令执行，长命令只含交给工作任务 */
+YLIB_PROBE_DEFINE(shell_long); /**< 工作任务中长命令的执行耗时 */
+
+OS_TASK_DEFINE(shell_task, 512);
+#if SHELL_SUPPORT_BACKGROUND == 1
+OS_TASK_DEFINE(shell_worker, SERIAL_SHELL_WORKER_STACK);
+static TaskHandle_t shell_worker_handle = NULL;
+static Shell *volatile shell_worker_target = NULL; /**< 交给工作任务的会话 */
+#endif
 
 // static int32_t shell_read(void *buff, uint16_t len);
 // static int32_t shell_write(const void *buff, uint16_t len);
@@ -30,25 +103,251 @@ static char shell_buffer[512];
 // {
 //     return 0;
 // }
+/**
+ * @brief 文本数据交给shell
+ * @param arg shell对象
+ * @param data 文本数据，直接指向接收缓冲区
+ * @param len 数据长度
+ * @note 整批处理完后一次写出回显和提示符
+ */
+static void serial_shell_text(void *arg, const uint8_t *data, uint32_t len)
+{
+    Shell *target = (Shell *)arg;
+
+    while (len--)
+    {
+        if ((*data == '\r') || (*data == '\n'))
+        {
+            YLIB_PROBE_BEGIN(shell_cmd);
+            shellHandler(target, (char)*data++);
+            YLIB_PROBE_END(shell_cmd);
+        }
+        else
+        {
+            shellHandler(target, (char)*data++);
+        }
+        if (target->parser.length > shell_line_peak)
+        {
+            shell_line_peak = target->parser.length;
+        }
+    }
+    // 工作任务执行长命令期间输出缓冲归它使用
+    if (!shellBusy(target))
+    {
+        shellFlush(target);
+    }
+}
+
+/**
+ * @brief 按运行参数更换缓冲区
+ * @note 在shell任务中、没有待分流的输入时执行；新缓冲区分配失败时保留原缓冲区，
+ *       shell缓冲区更换后当前输入行和历史记录清空
+ */
+static void serial_shell_resize(void)
+{
+    uint32_t size = SettingsGet(SETTING_SHELL_BUF);
+    char *buffer;
+    char *tunnel = NULL;
+
+    shell_resize = 0;
+#if YLIB_NO_HEAP_AFTER_INIT
+    // 堆封闭后不再更换缓冲区，修改的大小保存后在下次启动时生效
+    if (ylib_heap_sealed())
+    {
+        return;
+    }
+#endif
+    (void)CommunicationResize(SettingsGet(SETTING_UART_RXBUF), SettingsGet(SETTING_UART_TXBUF));
+
+    if (size == shell_buffer_size)
+    {
+        return;
+    }
+    buffer = (char *)ylib_malloc(size);
+    if (shell_tunnel_open)
+    {
+        tunnel = (char *)ylib_malloc(size);
+    }
+    if ((buffer == NULL) || (shell_tunnel_open && (tunnel == NULL)))
+    {
+        ylib_free(buffer);
+        ylib_free(tunnel);
+        return;
+    }
+
+    ylib_free(shell_buffer);
+    shell_buffer = buffer;
+    shellSetBuffer(&shell, shell_buffer, (uint16_t)size);
+    if (shell_tunnel_open)
+    {
+        ylib_free(shell_tunnel_buffer);
+        shell_tunnel_buffer = tunnel;
+        shellSetBuffer(&shell_tunnel, shell_tunnel_buffer, (uint16_t)size);
+    }
+    shell_buffer_size = size;
+}
+
+#if SHELL_SUPPORT_BACKGROUND == 1
+/**
+ * @brief 把长命令交给工作任务
+ * @retval 0成功，-1工作任务未创建，命令在shell任务中执行
+ * @note 在shell任务中调用，shellExec已置位忙标志；忙时其他会话的命令被拒绝，工作任务同一时刻只有一个命令
+ */
+static int serial_shell_exec(Shell *target)
+{
+    if (shell_worker_handle == NULL)
+    {
+        return -1;
+    }
+    shell_worker_target = target;
+    xTaskNotifyGive(shell_worker_handle);
+    return 0;
+}
+
+/**
+ * @brief 长命令工作任务
+ * @note 与驱动等待共用默认通知，残留的通知在没有交来的会话时忽略；
+ *       命令结束后唤醒shell任务，处理执行期间推迟的缓冲区更换
+ */
+static void serial_shell_worker(void *arg)
+{
+    Shell *target;
+
+    (void)arg;
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        target = shell_worker_target;
+        if (target == NULL)
+        {
+            continue;
+        }
+        shell_worker_target = NULL;
+        YLIB_PROBE_BEGIN(shell_long);
+        shellBackgroundRun(target);
+        YLIB_PROBE_END(shell_long);
+        yDevPollWake(MessageHandle());
+    }
+}
+#endif
+
+/**
+ * @brief 隧道会话输出，按帧载荷上限分段发送
+ * @note 发送队列满时等待后重试，仍失败时丢弃剩余输出
+ */
+static int32_t serial_shell_tunnel_write(const void *data, uint16_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint16_t sent = 0;
+    uint16_t chunk;
+    uint32_t retry;
+
+    while (sent < len)
+    {
+        chunk = (len - sent > FRAME_PAYLOAD_MAX) ? FRAME_PAYLOAD_MAX : len - sent;
+        for (retry = 0; FrameSend(SHELL_TUNNEL_FRAME_ID, p + sent, chunk) < 0; retry++)
+        {
+            if (retry >= SHELL_TUNNEL_RETRY)
+            {
+                return sent;
+            }
+            vTaskDelay(1);
+        }
+        sent += chunk;
+    }
+    return sent;
+}
+
+/**
+ * @brief 隧道会话没有直接读取的输入，输入全部经帧到达
+ */
+static int32_t serial_shell_tunnel_read(void *data, uint16_t len)
+{
+    (void)data;
+    (void)len;
+    return 0;
+}
+
+/**
+ * @brief 分配隧道缓冲区并初始化隧道会话
+ * @retval 0成功，-1内存不足
+ */
+static int32_t serial_shell_tunnel_open(void)
+{
+    shell_tunnel_buffer = (char *)ylib_malloc(shell_buffer_size);
+    if (shell_tunnel_buffer == NULL)
+    {
+        return -1;
+    }
+    shell_tunnel.write = serial_shell_tunnel_write;
+    shell_tunnel.read = serial_shell_tunnel_read;
+#if SHELL_SUPPORT_BACKGROUND == 1
+    shell_tunnel.exec = serial_shell_exec;
+#endif
+    shellInit(&shell_tunnel, shell_tunnel_buffer, (uint16_t)shell_buffer_size);
+    shell_tunnel_open = 1;
+    return 0;
+}
+
+/**
+ * @brief 隧道会话输入
+ * @note 在shell任务的MuxPoll中执行，与串口文本会话轮流处理，命令不会并发执行
+ */
+static int32_t serial_shell_tunnel_frame(uint8_t id, const uint8_t *payload, uint16_t len)
+{
+    (void)id;
+    // 隧道缓冲区在第一帧到达时分配，不用隧道的设备不占这部分RAM
+    if (!shell_tunnel_open && (serial_shell_tunnel_open() != 0))
+    {
+        return -1;
+    }
+    serial_shell_text(&shell_tunnel, payload, len);
+    return 0;
+}
+FRAME_EXPORT(SHELL_TUNNEL_FRAME_ID, serial_shell_tunnel_frame);
+
 /**
  * @brief shell处理函数
- *
+ * @note 串口文本会话和帧隧道会话由这一个任务处理；空闲时在yDevPoll上等待通信串口可读，
+ *       就绪后分流全部已收到的字节，文本交给串口会话，隧道帧交给隧道会话，其他帧交给帧协议分发；
+ *       已收到的字节全部分流后处理缓冲区更换请求，此时接收缓冲区中没有未读数据。
+ *       带SHELL_CMD_LONG的命令交给工作任务，执行期间本任务继续分流，ctrl+c取消命令，帧照常分发
  */
 static void serial_shell_task(void *arg)
 {
+    void *handles[1];
+    uint32_t events[1] = {YDEV_POLLIN};
+    uint32_t revents[1];
+
     (void)arg;
-    uint8_t data;
-    shell.write = MessageWrite;
+    shell.write = MuxTextWrite;
     shell.read = MessageRead;
+#if SHELL_SUPPORT_BACKGROUND == 1
+    shell.exec = serial_shell_exec;
+#endif
     CommunicationInit();
-    shellInit(&shell, shell_buffer, 512);
+    MuxInit(serial_shell_text, &shell);
+    shell_buffer_size = SERIAL_SHELL_BUFFER;
+    shell_buffer = (char *)ylib_malloc(shell_buffer_size);
+    configASSERT(shell_buffer != NULL);
+    shellInit(&shell, shell_buffer, (uint16_t)shell_buffer_size);
+#if YLIB_NO_HEAP_AFTER_INIT
+    // 堆封闭后不能再分配，隧道缓冲区在初始化阶段一并分配
+    (void)serial_shell_tunnel_open();
+#endif
+    handles[0] = MessageHandle();
     for (;;)
     {
-        if (MessageRead(&data, 1) == 1)
+        // yDevPoll先登记任务再检查，取数期间到达的数据也不会丢失唤醒
+        while (MuxPoll() > 0)
+        {
+        }
+        // 长命令的参数还在输入缓冲中，等它结束后由工作任务唤醒再更换
+        if (shell_resize && !shellBusy(&shell) && !shellBusy(&shell_tunnel))
         {
-            shellHandler(&shell, data);
+            serial_shell_resize();
         }
-        vTaskDelay(pdMS_TO_TICKS(10)); // 延时10ms，避免过快处理
+        (void)yDevPoll(handles, events, revents, 1, 0);
     }
 }
 /**
@@ -57,10 +356,2925 @@ static void serial_shell_task(void *arg)
  */
 void ShellTaskInit(void)
 {
-    xTaskCreate(serial_shell_task, // 任务函数
-                "ShellTask",       // 任务名称
-                512,               // 堆栈大小
-                NULL,              // 任务参数
-                10,                // 任务优先级
-                NULL);             // 任务句柄
+    OS_TASK_CREATE(shell_task,        // 任务存储
+                   serial_shell_task, // 任务函数
+                   "ShellTask",       // 任务名称
+                   NULL,              // 任务参数
+                   10);               // 任务优先级
+#if SHELL_SUPPORT_BACKGROUND == 1
+    shell_worker_handle = OS_TASK_CREATE(shell_worker, serial_shell_worker, "ShellWork", NULL,
+                                         SERIAL_SHELL_WORKER_PRIO);
+#endif
+}
+
+/**
+ * @brief 请求按运行参数更换缓冲区
+ * @note 运行参数读入或修改时由settings调用；在shell命令中修改时，命令返回后即更换
+ */
+void ShellTaskResize(void)
+{
+    shell_resize = 1;
+    yDevPollWake(MessageHandle());
+}
+
+/**
+ * @brief DMA通道占用查询命令
+ * @note 列出每个通道的使用者、DMAMUX请求信号、优先级、运行状态和同步溢出次数，
+ *       以及已分配的DMAMUX请求生成器
+ */
+static int DmaStatCmd(int argc, char *argv[])
+{
+    static const char *const prio_name[] = {"low", "medium", "high", "very high"};
+    static const char *const edge_name[] = {"none", "rising", "falling", "both"};
+    yDrvDmaChannelInfo_t info;
+    yDrvDmaGenInfo_t gen;
+    Shell *shell = shellGetCurrent();
+
+    (void)argc;
+    (void)argv;
+
+    for (yDrvDmaChannel_t ch = YDRV_DMA1_CHANNEL1; ch < YDRV_DMA_CHANNEL_MAX; ch++)
+    {
+        if (yDrvDmaGetChannelInfo(ch, &info) != YDRV_OK)
+        {
+            continue;
+        }
+        if (!info.used)
+        {
+            shellPrint(shell, "ch%d: free\r\n", (int)ch + 1);
+            continue;
+        }
+        shellPrint(shell, "ch%d: %s, req %lu, %s, %s, overrun %lu\r\n",
+                   (int)ch + 1,
+                   (info.owner != NULL) ? info.owner : "-",
+                   (unsigned long)info.request,
+                   prio_name[(info.priority >> DMA_CCR_PL_Pos) & 0x3U],
+                   info.enabled ? "running" : "idle",
+                   (unsigned long)info.overrun);
+    }
+
+    for (uint32_t index = 0; index < YDRV_DMA_GEN_MAX; index++)
+    {
+        if ((yDrvDmaGenGetInfo(index, &gen) != YDRV_OK) || !gen.used)
+        {
+            continue;
+        }
+        shellPrint(shell, "gen%lu: %s, sig %lu %s, nbreq %lu, %s, overrun %lu\r\n",
+                   (unsigned long)index,
+                   (gen.owner != NULL) ? gen.owner : "-",
+                   (unsigned long)gen.signal,
+                   edge_name[gen.edge & 0x3U],
+                   (unsigned long)gen.nbreq,
+                   gen.enabled ? "enabled" : "disabled",
+                   (unsigned long)gen.overrun);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 dmastat, DmaStatCmd, dma channel and generator usage);
+
+/**
+ * @brief 设备基准测试缓冲区
+ * @note 按块循环读写，测试长度不受缓冲区大小限制
+ */
+static uint8_t dev_bench_buffer[256];
+
+/**
+ * @brief 基准测试每项的采样次数
+ */
+#define BENCH_SAMPLES 32
+
+/**
+ * @brief uartbench使用的USART和引脚
+ * @note 单线半双工模式下接收器连在TX引脚上，发送的数据同时被接收，不需要外部跳线；
+ *       该USART和引脚在board.def中登记，被其他设备占用时生成失败
+ */
+#define UART_BENCH_ID BOARD_BENCH_PERIPH
+#define UART_BENCH_PIN BOARD_BENCH_TX_PIN
+#define UART_BENCH_AF BOARD_BENCH_TX_AF
+
+/**
+ * @brief 基准测试采样
+ */
+typedef struct
+{
+    uint32_t us[BENCH_SAMPLES]; /**< 每次操作耗时 */
+    uint32_t count;             /**< 采样数 */
+    uint32_t bytes;             /**< 累计字节数 */
+    uint32_t total;             /**< 累计耗时(us) */
+} BenchStat_t;
+
+/**
+ * @brief 清空采样
+ */
+static void bench_reset(BenchStat_t *stat)
+{
+    memset(stat, 0, sizeof(BenchStat_t));
+}
+
+/**
+ * @brief 记录一次操作
+ * @param stat 采样
+ * @param start 操作开始时的yDevGetTimeUS
+ * @param bytes 操作的字节数，不计吞吐量时为0
+ */
+static void bench_add(BenchStat_t *stat, uint32_t start, uint32_t bytes)
+{
+    uint32_t us = yDevGetTimeUS() - start;
+
+    if (stat->count < BENCH_SAMPLES)
+    {
+        stat->us[stat->count++] = us;
+    }
+    stat->bytes += bytes;
+    stat->total += us;
+}
+
+/**
+ * @brief 耗时从小到大排序，之后us[]可直接取分位数
+ */
+static void bench_sort(BenchStat_t *stat)
+{
+    uint32_t value;
+    uint32_t i;
+    uint32_t j;
+
+    // 采样数少，插入排序即可
+    for (i = 1; i < stat->count; i++)
+    {
+        value = stat->us[i];
+        for (j = i; (j > 0) && (stat->us[j - 1] > value); j--)
+        {
+            stat->us[j] = stat->us[j - 1];
+        }
+        stat->us[j] = value;
+    }
+}
+
+/**
+ * @brief 吞吐量(KB/s，按1000字节计)
+ * @note 按累计字节数和累计耗时计算，每微秒字节数即MB/s
+ */
+static uint32_t bench_kbps(const BenchStat_t *stat)
+{
+    return (stat->total != 0) ? (uint32_t)((uint64_t)stat->bytes * 1000U / stat->total) : 0;
+}
+
+/**
+ * @brief 打印吞吐量和耗时分位数
+ * @note 吞吐量按累计字节数和累计耗时计算，字节数为0时不打印
+ */
+static void bench_print(Shell *shell, const char *name, BenchStat_t *stat)
+{
+    uint32_t kbps;
+
+    if (stat->count == 0)
+    {
+        shellPrint(shell, "%-14s no sample\r\n", name);
+        return;
+    }
+
+    bench_sort(stat);
+
+    // 保留3位小数的MB/s
+    if (stat->bytes != 0)
+    {
+        kbps = bench_kbps(stat);
+        shellPrint(shell, "%-14s %4lu.%03lu MB/s", name, (unsigned long)(kbps / 1000U), (unsigned long)(kbps % 1000U));
+    }
+    else
+    {
+        shellPrint(shell, "%-14s %13s", name, "");
+    }
+    shellPrint(shell, "  p50 %6luus  p90 %6luus  max %6luus\r\n",
+               (unsigned long)stat->us[(stat->count - 1) * 50U / 100U],
+               (unsigned long)stat->us[(stat->count - 1) * 90U / 100U],
+               (unsigned long)stat->us[stat->count - 1]);
+}
+
+/**
+ * @brief 已注册设备列表命令
+ * @note 列出注册表中每个设备的名称、类型、电源状态和错误码
+ */
+static int DevListCmd(int argc, char *argv[])
+{
+    static const char *const type_name[YDEV_TYPE_MAX] = {
+        [YDEV_TYPE_GPIO] = "gpio",
+        [YDEV_TYPE_USART] = "usart",
+        [YDEV_TYPE_SPI] = "spi",
+        [YDEV_TYPE_25Q] = "25q",
+        [YDEV_TYPE_25Q_FTL] = "25q-ftl",
+        [YDEV_TYPE_SPI_SLAVE] = "spi-slave",
+        [YDEV_TYPE_GPIO_PORT] = "gpio-port",
+        [YDEV_TYPE_TIM] = "tim",
+        [YDEV_TYPE_ADC] = "adc",
+        [YDEV_TYPE_IIC] = "iic",
+        [YDEV_TYPE_DMA] = "dma",
+        [YDEV_TYPE_IFLASH] = "iflash",
+        [YDEV_TYPE_FILE] = "file",
+        [YDEV_TYPE_25Q_ARRAY] = "25q-array",
+        [YDEV_TYPE_PBUS] = "pbus",
+        [YDEV_TYPE_KEYPAD] = "keypad",
+    };
+    static const char *const state_name[] = {
+        [YDEV_STATE_UNINITIALIZED] = "uninit",
+        [YDEV_STATE_INITIALIZED] = "init",
+        [YDEV_STATE_OPENED] = "open",
+        [YDEV_STATE_BUSY] = "busy",
+        [YDEV_STATE_SUSPENDED] = "suspend",
+        [YDEV_STATE_ERROR] = "error",
+        [YDEV_STATE_DEFERRED] = "deferred",
+    };
+    Shell *shell = shellGetCurrent();
+    const char *name;
+    yDevHandle_t *handle;
+    yDevType_t type;
+    yDevState_t state;
+
+    (void)argc;
+    (void)argv;
+
+    for (uint32_t index = 0; (handle = (yDevHandle_t *)yDevIterate(index, &name)) != NULL; index++)
+    {
+        type = yDevGetType(handle);
+        state = yDevGetState(handle);
+        shellPrint(shell, "%-8s %-10s %-8s refs %-3lu errno 0x%08lX\r\n", name,
+                   ((type < YDEV_TYPE_MAX) && (type_name[type] != NULL)) ? type_name[type] : "-",
+                   (state <= YDEV_STATE_DEFERRED) ? state_name[state] : "-",
+                   (unsigned long)handle->refs, (unsigned long)handle->errno);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 devlist, DevListCmd, list registered devices);
+
+/**
+ * @brief 消息总线主题列表命令
+ * @note 列出每个主题的订阅者数(其中回调订阅者数)、发布、投递和丢弃次数
+ */
+static int BusCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    const MsgBusTopic_t *topic;
+    const MsgBusTopicState_t *state;
+
+    (void)argc;
+    (void)argv;
+
+    for (uint32_t index = 0; (topic = MsgBusIterate(index)) != NULL; index++)
+    {
+        state = topic->state;
+        shellPrint(shell, "%-10s subs %u(%u cb) pub %lu dlv %lu drop %lu\r\n", topic->name,
+                   (unsigned)state->count, (unsigned)state->callbacks, (unsigned long)state->published,
+                   (unsigned long)state->delivered, (unsigned long)state->dropped);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 bus, BusCmd, list message bus topics);
+
+/**
+ * @brief 启动过程统计命令
+ * @note 列出初始化表中每个函数的级别、耗时和返回值，以及各级别完成的时间
+ */
+static int BootCmd(int argc, char *argv[])
+{
+    static const char *const level_name[YDEV_INIT_LEVEL_MAX] = {
+        [YDEV_INIT_BOARD] = "board",
+        [YDEV_INIT_DEVICE] = "device",
+        [YDEV_INIT_DEFERRED] = "deferred",
+    };
+    Shell *shell = shellGetCurrent();
+    const yDevInitEntry_t *entry;
+    uint32_t done;
+    uint32_t us;
+    int32_t ret;
+
+    (void)argc;
+    (void)argv;
+
+    for (uint32_t index = 0; (entry = yDevInitIterate(index, &us, &ret)) != NULL; index++)
+    {
+        shellPrint(shell, "%-20s %-8s %8lu us ret %ld\r\n", entry->name, level_name[entry->level],
+                   (unsigned long)us, (long)ret);
+    }
+    for (uint32_t level = 0; level < YDEV_INIT_LEVEL_MAX; level++)
+    {
+        done = yDevInitDoneUs(level);
+        if (done != 0)
+        {
+            shellPrint(shell, "%-8s done at %lu us\r\n", level_name[level], (unsigned long)done);
+        }
+        else
+        {
+            shellPrint(shell, "%-8s pending\r\n", level_name[level]);
+        }
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 boot, BootCmd, show init levels and timing);
+
+/**
+ * @brief 设备读写基准测试命令
+ * @note devbench <name> read|write <size>[k|m]，从设备当前位置按块读写，
+ *       打印实际字节数、耗时和吞吐量；写入测试会改写设备内容
+ */
+static int DevBenchCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    void *handle;
+    uint8_t flag_write;
+    uint32_t size;
+    uint32_t done;
+    uint32_t chunk;
+    uint32_t start;
+    uint32_t us;
+    int32_t ret;
+    char *end;
+
+    if (argc < 4)
+    {
+        shellPrint(shell, "usage: devbench <name> read|write <size>[k|m]\r\n");
+        return -1;
+    }
+
+    handle = yDevFind(argv[1]);
+    if (handle == NULL)
+    {
+        shellPrint(shell, "%s: not found\r\n", argv[1]);
+        return -1;
+    }
+    if (strcmp(argv[2], "read") == 0)
+    {
+        flag_write = 0;
+    }
+    else if (strcmp(argv[2], "write") == 0)
+    {
+        flag_write = 1;
+        memset(dev_bench_buffer, 0x5A, sizeof(dev_bench_buffer));
+    }
+    else
+    {
+        shellPrint(shell, "%s: unknown direction\r\n", argv[2]);
+        return -1;
+    }
+
+    size = (uint32_t)strtoul(argv[3], &end, 0);
+    if ((*end == 'k') || (*end == 'K'))
+    {
+        size *= 1024U;
+    }
+    else if ((*end == 'm') || (*end == 'M'))
+    {
+        size *= 1024U * 1024U;
+    }
+
+    // 按块读写，设备返回不足时提前结束
+    done = 0;
+    start = yDevGetTimeUS();
+    while ((done < size) && !shellCancelled(shell))
+    {
+        chunk = ((size - done) > sizeof(dev_bench_buffer)) ? sizeof(dev_bench_buffer) : (size - done);
+        ret = (flag_write != 0) ? yDevWrite(handle, dev_bench_buffer, chunk)
+                                : yDevRead(handle, dev_bench_buffer, chunk);
+        if (ret <= 0)
+        {
+            break;
+        }
+        done += (uint32_t)ret;
+    }
+    us = yDevGetTimeUS() - start;
+
+    shellPrint(shell, "%s %s: %lu/%lu bytes, %luus, %lu KB/s\r\n", argv[1], argv[2],
+               (unsigned long)done, (unsigned long)size, (unsigned long)us,
+               (unsigned long)((us != 0) ? (((uint64_t)done * 1000000U / 1024U) / us) : 0));
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN) | SHELL_CMD_LONG,
+                 devbench, DevBenchCmd, device throughput <name> read|write <size>[k|m]);
+
+/**
+ * @brief 内存操作基准测试源缓冲区
+ * @note 目的缓冲区复用dev_bench_buffer
+ */
+static uint8_t mem_bench_buffer[256];
+
+/**
+ * @brief 内存操作基准测试命令
+ * @note membench [size]，C库、yLib和DMA引擎的对齐/不对齐复制、填充、比较各采样BENCH_SAMPLES次，
+ *       再测yLib堆和内存池一次分配加释放的耗时；YLIB_MEMOPS_OVERRIDE_LIBC=1时C库函数即yLib实现，
+ *       DMA引擎对短于交叉点的拷贝直接用CPU
+ */
+static int MemBenchCmd(int argc, char *argv[])
+{
+    static const char *const name[] = {"memcpy", "memcpy+1", "memset", "memcmp"};
+    static const char *const impl_name[] = {"libc", "ylib", "dma"};
+    Shell *shell = shellGetCurrent();
+    ylib_mempool_t *pool;
+    BenchStat_t stat;
+    char label[16];
+    uint32_t size = 240;
+    uint32_t start;
+    uint32_t test;
+    uint32_t impl;
+    uint32_t loop;
+    void *ptr;
+
+    if (argc > 1)
+        size = (uint32_t)strtoul(argv[1], NULL, 0);
+    if (size > sizeof(mem_bench_buffer) - 4U)
+        size = sizeof(mem_bench_buffer) - 4U;
+
+    memset(mem_bench_buffer, 0x5A, sizeof(mem_bench_buffer));
+    memset(dev_bench_buffer, 0x5A, sizeof(dev_bench_buffer));
+    for (test = 0; test < ARRAY_SIZE(name); test++)
+    {
+        // DMA引擎只做对齐复制
+        for (impl = 0; impl < ((test == 0) ? 3U : 2U); impl++)
+        {
+            bench_reset(&stat);
+            for (loop = 0; loop < BENCH_SAMPLES; loop++)
+            {
+                start = yDevGetTimeUS();
+                switch (test)
+                {
+                case 0:
+                    if (impl == 2)
+                        (void)yDevDmaMemcpy(dev_bench_buffer, mem_bench_buffer, size, NULL, NULL);
+                    else
+                        impl ? ylib_memcpy(dev_bench_buffer, mem_bench_buffer, size)
+                             : memcpy(dev_bench_buffer, mem_bench_buffer, size);
+                    break;
+                case 1:
+                    impl ? ylib_memcpy(dev_bench_buffer, mem_bench_buffer + 1, size)
+                         : memcpy(dev_bench_buffer, mem_bench_buffer + 1, size);
+                    break;
+                case 2:
+                    impl ? ylib_memset(dev_bench_buffer, loop, size) : memset(dev_bench_buffer, loop, size);
+                    break;
+                default:
+                    (void)(impl ? ylib_memcmp(dev_bench_buffer, mem_bench_buffer, size)
+                                : memcmp(dev_bench_buffer, mem_bench_buffer, size));
+                    break;
+                }
+                // 阻止编译器把循环内的重复调用合并掉
+                __asm volatile("" : : : "memory");
+                bench_add(&stat, start, size);
+            }
+            if (test == 2)
+                memset(dev_bench_buffer, 0x5A, sizeof(dev_bench_buffer));
+            snprintf(label, sizeof(label), "%s %s", name[test], impl_name[impl]);
+            bench_print(shell, label, &stat);
+        }
+    }
+
+#if YLIB_NO_HEAP_AFTER_INIT
+    if (ylib_heap_sealed())
+    {
+        shellPrint(shell, "heap sealed, allocator skipped\r\n");
+        return 0;
+    }
+#endif
+
+    // 分配器：每次采样为一次分配加释放
+    bench_reset(&stat);
+    for (loop = 0; loop < BENCH_SAMPLES; loop++)
+    {
+        start = yDevGetTimeUS();
+        ptr = ylib_malloc(size);
+        ylib_free(ptr);
+        bench_add(&stat, start, 0);
+    }
+    bench_print(shell, "malloc+free", &stat);
+
+    pool = ylib_mempool_create(size, 1);
+    if (pool != NULL)
+    {
+        bench_reset(&stat);
+        for (loop = 0; loop < BENCH_SAMPLES; loop++)
+        {
+            start = yDevGetTimeUS();
+            ptr = ylib_mempool_alloc(pool);
+            (void)ylib_mempool_free(pool, ptr);
+            bench_add(&stat, start, 0);
+        }
+        bench_print(shell, "mempool", &stat);
+        ylib_mempool_destroy(pool);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 membench, MemBenchCmd, memcpy/memset/memcmp and allocator timing [size]);
+
+/**
+ * @brief rambench的测试循环，同一段代码分别放在Flash和RAM中
+ * @note 逐字节移位异或，带分支，与中断处理中的状态机循环相近
+ */
+#define RAM_BENCH_KERNEL(name, attr)                                                     \
+    attr __attribute__((noinline)) static uint32_t name(const uint8_t *data, uint32_t len) \
+    {                                                                                    \
+        uint32_t sum = 0;                                                                \
+        uint32_t i;                                                                      \
+        for (i = 0; i < len; i++)                                                        \
+        {                                                                                \
+            sum = (sum << 1) ^ data[i] ^ ((sum & 0x80000000UL) ? 0x04C11DB7UL : 0U);     \
+        }                                                                                \
+        return sum;                                                                      \
+    }
+
+RAM_BENCH_KERNEL(ram_bench_flash, )
+RAM_BENCH_KERNEL(ram_bench_ram, YLIB_RAMFUNC)
+
+/**
+ * @brief 打印周期数的最小、最大值
+ */
+static void ram_bench_print(Shell *shell, const char *name, const uint32_t *cycles, uint32_t count)
+{
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        min = (cycles[i] < min) ? cycles[i] : min;
+        max = (cycles[i] > max) ? cycles[i] : max;
+    }
+    shellPrint(shell, "%-14s min %6lu  max %6lu cycles\r\n", name, (unsigned long)min, (unsigned long)max);
+}
+
+/**
+ * @brief RAM函数基准测试命令
+ * @note rambench [size]，关中断后用SysTick计同一循环在Flash和RAM中的周期数，
+ *       以及环形队列一次入队加出队的周期数(随YLIB_RAMFUNC_ENABLE放在RAM或Flash)；
+ *       最大值与最小值之差即取指等待带来的抖动
+ */
+static int RamBenchCmd(int argc, char *argv[])
+{
+    static const char *const name[] = {"loop flash", "loop ram", "ring put+get"};
+    uint32_t cycles[BENCH_SAMPLES];
+    Shell *shell = shellGetCurrent();
+    struct ylib_ring ring;
+    uint32_t ring_buffer[8];
+    uint32_t size = 256;
+    uint32_t value = 0;
+    uint32_t primask;
+    uint32_t start;
+    uint32_t test;
+    uint32_t loop;
+
+    if (argc > 1)
+        size = (uint32_t)strtoul(argv[1], NULL, 0);
+    if (size > sizeof(mem_bench_buffer))
+        size = sizeof(mem_bench_buffer);
+
+    (void)ylib_ring_init(&ring, ring_buffer, ARRAY_SIZE(ring_buffer));
+    for (test = 0; test < ARRAY_SIZE(name); test++)
+    {
+        for (loop = 0; loop < BENCH_SAMPLES; loop++)
+        {
+            primask = __get_PRIMASK();
+            __disable_irq();
+            start = yDrvCycleNow();
+            switch (test)
+            {
+            case 0:
+                value += ram_bench_flash(mem_bench_buffer, size);
+                break;
+            case 1:
+                value += ram_bench_ram(mem_bench_buffer, size);
+                break;
+            default:
+                (void)ylib_ring_enqueue(&ring, &loop, sizeof(uint32_t));
+                (void)ylib_ring_dequeue(&ring, &value, sizeof(uint32_t));
+                break;
+            }
+            cycles[loop] = yDrvCycleSince(start);
+            __set_PRIMASK(primask);
+        }
+        ram_bench_print(shell, name[test], cycles, BENCH_SAMPLES);
+    }
+    shellPrint(shell, "YLIB_RAMFUNC %s, %lu MHz, check %08lx\r\n", YLIB_RAMFUNC_ENABLE ? "on" : "off",
+               (unsigned long)(SystemCoreClock / 1000000U), (unsigned long)value);
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 rambench, RamBenchCmd, flash vs RAM execution cycles [size]);
+
+// ==================== 微基准测试项 ====================
+
+static uint32_t micro_ring_buffer[8];     /**< ring测试的队列存储 */
+static struct ylib_ring micro_ring;       /**< ring测试的队列 */
+static void *micro_key;                   /**< dispatch测试的设备，未注册时为NULL */
+static volatile uint32_t micro_sink;      /**< 测试结果写到这里，防止被优化掉 */
+
+static void micro_ring_setup(void)
+{
+    (void)ylib_ring_init(&micro_ring, micro_ring_buffer, ARRAY_SIZE(micro_ring_buffer));
+}
+
+/**
+ * @brief 环形队列一次入队加出队
+ */
+YLIB_BENCH_SETUP(ring, micro_ring_setup)
+{
+    uint32_t value = micro_sink;
+
+    (void)ylib_ring_enqueue(&micro_ring, &value, sizeof(value));
+    (void)ylib_ring_dequeue(&micro_ring, &value, sizeof(value));
+    micro_sink = value;
+}
+
+#if !YLIB_NO_HEAP_AFTER_INIT
+/**
+ * @brief 堆分配再释放32字节
+ * @note 堆封闭模式下不登记，运行期不允许分配
+ */
+YLIB_BENCH(heap)
+{
+    void *ptr = ylib_malloc(32);
+
+    ylib_free(ptr);
+    micro_sink = (uint32_t)ptr;
+}
+#endif
+
+/**
+ * @brief 对齐拷贝64字节
+ */
+YLIB_BENCH(memcpy64)
+{
+    (void)ylib_memcpy(&mem_bench_buffer[128], mem_bench_buffer, 64);
+}
+
+/**
+ * @brief 让EXTI4_15挂起后开中断，测量中断进入、分发和返回
+ * @note 没有挂起的EXTI线时分发函数直接返回；NVIC中该中断保持使能，分发不会误调回调
+ */
+static void micro_exti_setup(void)
+{
+    NVIC_EnableIRQ(EXTI4_15_IRQn);
+}
+
+YLIB_BENCH_SETUP(exti, micro_exti_setup)
+{
+    NVIC_SetPendingIRQ(EXTI4_15_IRQn);
+    __enable_irq();
+    __ISB();
+    __disable_irq();
+}
+
+static void micro_dispatch_setup(void)
+{
+    micro_key = yDevFind("key0");
+}
+
+/**
+ * @brief 经yDev接口读一次GPIO，测量设备分发开销
+ */
+YLIB_BENCH_SETUP(dispatch, micro_dispatch_setup)
+{
+    uint32_t value;
+
+    if ((micro_key != NULL) && (yDevRead(micro_key, &value, sizeof(value)) > 0))
+    {
+        micro_sink = value;
+    }
+}
+
+/**
+ * @brief 带两个参数的二进制日志调用，与shellPrint的格式化开销对比
+ */
+static void micro_log_setup(void)
+{
+    ylib_log_threshold = YLIB_LOG_DEBUG;
+}
+
+YLIB_BENCH_SETUP(log, micro_log_setup)
+{
+    YLIB_LOGD("bench %lu %08lx", (unsigned long)micro_sink, (unsigned long)micro_sink);
+}
+
+/**
+ * @brief 微基准测试命令
+ * @note bench [name] [samples]，逐项关中断用SysTick计周期，减去计时开销后打印最小、中位数和最大值；
+ *       不带参数时运行全部测试项
+ */
+static int BenchCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    const struct ylib_bench *bench;
+    struct ylib_bench_result result = {0};
+    const char *name = NULL;
+    uint32_t samples = 0;
+    uint32_t index;
+
+    if (argc > 1)
+    {
+        name = argv[1];
+        if (ylib_bench_find(name) == NULL)
+        {
+            shellPrint(shell, "no benchmark %s\r\n", name);
+            return -1;
+        }
+    }
+    if (argc > 2)
+    {
+        samples = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+
+    shellPrint(shell, "%lu MHz, cycles\r\n", (unsigned long)(SystemCoreClock / 1000000U));
+    shellPrint(shell, "%-12s %8s %8s %8s\r\n", "name", "min", "median", "max");
+    for (index = 0; (bench = ylib_bench_iterate(index)) != NULL; index++)
+    {
+        if ((name != NULL) && (strcmp(bench->name, name) != 0))
+        {
+            continue;
+        }
+        if (ylib_bench_run(bench, samples, &result) != 0)
+        {
+            shellPrint(shell, "no cycle counter\r\n");
+            return -1;
+        }
+        shellPrint(shell, "%-12s %8lu %8lu %8lu\r\n", bench->name, (unsigned long)result.min,
+                   (unsigned long)result.median, (unsigned long)result.max);
+    }
+    shellPrint(shell, "overhead %lu cycles subtracted\r\n", (unsigned long)result.overhead);
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 bench, BenchCmd, cycle micro benchmarks [name] [samples]);
+
+/**
+ * @brief 耗时探针命令
+ * @note probes列出全部探针的次数和最小、平均、最大耗时；probes reset读出后清零，
+ *       两次之间的统计即这段时间的负载
+ */
+static int ProbesCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    struct ylib_probe_stats stats;
+    struct ylib_probe *probe;
+    uint32_t index;
+    int reset;
+
+    reset = ((argc > 1) && (strcmp(argv[1], "reset") == 0)) ? 1 : 0;
+
+    shellPrint(shell, "%-12s %8s %8s %8s %8s\r\n", "name", "count", "min", "avg", "max");
+    for (index = 0; (probe = ylib_probe_iterate(index)) != NULL; index++)
+    {
+        ylib_probe_read(probe, &stats, reset);
+        shellPrint(shell, "%-12s %8lu %8lu %8lu %8lu\r\n", probe->name, (unsigned long)stats.count,
+                   (unsigned long)stats.min, (unsigned long)stats.avg, (unsigned long)stats.max);
+    }
+    if (index == 0)
+    {
+        shellPrint(shell, "no probes\r\n");
+    }
+    else
+    {
+        shellPrint(shell, "us%s\r\n", (reset != 0) ? ", reset" : "");
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 probes, ProbesCmd, code section timing probes [reset]);
+
+/**
+ * @brief 中断入口延迟命令
+ * @note irqlat列出已测量的中断；irqlat <中断号> [次数]插入测量包装后每个滴答软件挂起一次，
+ *       统计累计到下一次插入；irqlat off <中断号>恢复原入口。在另一会话或任务中制造
+ *       Flash擦写等负载的同时测量，max即为该负载下的最坏入口延迟
+ */
+static int IrqLatCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    const yDrvIrqLatency_t *lat;
+    IRQn_Type irq;
+    uint32_t samples = 100;
+    uint32_t mhz = SystemCoreClock / 1000000U;
+    uint32_t i;
+
+    if ((argc > 1) && (strcmp(argv[1], "off") == 0))
+    {
+        if (argc > 2)
+        {
+            yDrvIrqLatencyDetach((IRQn_Type)strtol(argv[2], NULL, 0));
+        }
+        return 0;
+    }
+
+    if (argc > 1)
+    {
+        irq = (IRQn_Type)strtol(argv[1], NULL, 0);
+        if (argc > 2)
+        {
+            samples = (uint32_t)strtoul(argv[2], NULL, 0);
+        }
+        if (yDrvIrqLatencyAttach(irq, NULL, 0) != YDRV_OK)
+        {
+            shellPrint(shell, "attach irq %d failed\r\n", (int)irq);
+            return -1;
+        }
+        for (i = 0; i < samples; i++)
+        {
+            if (yDrvIrqLatencyProbe(irq, NULL) != YDRV_OK)
+            {
+                shellPrint(shell, "irq %d not enabled or blocked\r\n", (int)irq);
+                break;
+            }
+            vTaskDelay(1);
+        }
+    }
+
+    shellPrint(shell, "%-4s %4s %8s %8s %8s %8s\r\n", "irq", "prio", "count", "min", "max", "max ns");
+    for (i = 0; (lat = yDrvIrqLatencyGet(i)) != NULL; i++)
+    {
+        shellPrint(shell, "%-4d %4lu %8lu %8lu %8lu %8lu\r\n", (int)lat->irq,
+                   (unsigned long)NVIC_GetPriority(lat->irq), (unsigned long)lat->count,
+                   (unsigned long)((lat->count != 0) ? lat->min : 0), (unsigned long)lat->max,
+                   (unsigned long)((mhz != 0) ? (lat->max * 1000U / mhz) : 0));
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 irqlat, IrqLatCmd, irq entry latency [irq|off irq] [samples]);
+
+/**
+ * @brief LED闪烁模式命令
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return int 0成功，-1模式名无效
+ * @note led列出模式并标出当前的基础模式；led <模式名>播放该模式，按键仍可切换
+ */
+static int LedCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    const char *name;
+    uint32_t i;
+
+    if (argc > 1)
+    {
+        for (i = 0; (name = BlinkPatternName((BlinkPattern_t)i)) != NULL; i++)
+        {
+            if (strcmp(argv[1], name) == 0)
+            {
+                return (BlinkPlay((BlinkPattern_t)i) == 0) ? 0 : -1;
+            }
+        }
+        shellPrint(shell, "unknown pattern %s\r\n", argv[1]);
+        return -1;
+    }
+
+    for (i = 0; (name = BlinkPatternName((BlinkPattern_t)i)) != NULL; i++)
+    {
+        shellPrint(shell, "%c %s\r\n", (BlinkGetPattern() == (BlinkPattern_t)i) ? '*' : ' ', name);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 led, LedCmd, led pattern [name]);
+
+/**
+ * @brief 运行参数命令
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return int 0成功，-1参数名或值无效、写入失败
+ * @note cfg列出全部参数；cfg <名称> [值]查看或修改，修改延迟写入Flash；
+ *       cfg save立即写入；cfg reset全部恢复默认值
+ */
+static int CfgCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    const SettingInfo_t *info;
+    SettingsStats_t stats;
+    int32_t id;
+    uint32_t i;
+
+    if ((argc > 1) && (strcmp(argv[1], "save") == 0))
+    {
+        return (SettingsSave() == 0) ? 0 : -1;
+    }
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0))
+    {
+        SettingsReset();
+        return 0;
+    }
+    if (argc > 1)
+    {
+        id = SettingsFind(argv[1]);
+        if (id < 0)
+        {
+            shellPrint(shell, "unknown setting %s\r\n", argv[1]);
+            return -1;
+        }
+        info = SettingsInfo((SettingId_t)id);
+        if ((argc > 2) && (SettingsSet((SettingId_t)id, strtoul(argv[2], NULL, 0)) != 0))
+        {
+            shellPrint(shell, "%s range %lu..%lu\r\n", info->name, (unsigned long)info->min,
+                       (unsigned long)info->max);
+            return -1;
+        }
+        shellPrint(shell, "%s = %lu\r\n", info->name, (unsigned long)SettingsGet((SettingId_t)id));
+        return 0;
+    }
+
+    for (i = 0; (info = SettingsInfo((SettingId_t)i)) != NULL; i++)
+    {
+        shellPrint(shell, "%-16s %10lu  default %lu\r\n", info->name, (unsigned long)SettingsGet((SettingId_t)i),
+                   (unsigned long)info->def);
+    }
+    SettingsGetStats(&stats);
+    shellPrint(shell, "%s, loaded %lu, sets %lu, saves %lu, errors %lu%s\r\n",
+               stats.mounted ? "mounted" : "not mounted", (unsigned long)stats.loaded, (unsigned long)stats.sets,
+               (unsigned long)stats.saves, (unsigned long)stats.errors, stats.dirty ? ", save pending" : "");
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 cfg, CfgCmd, settings [name [value]|save|reset]);
+
+/**
+ * @brief 按用量峰值计算建议的缓冲区大小
+ * @param id 缓冲区大小参数
+ * @param need 需要的字节数
+ * @return uint32_t 加上余量、按SHELL_PEAK_ALIGN对齐并限制在参数范围内的大小
+ */
+static uint32_t serial_shell_suggest(SettingId_t id, uint32_t need)
+{
+    const SettingInfo_t *info = SettingsInfo(id);
+    uint32_t size;
+
+    size = need + (need >> SHELL_PEAK_MARGIN_SHIFT);
+    size = (size + SHELL_PEAK_ALIGN - 1U) & ~(SHELL_PEAK_ALIGN - 1U);
+    if (size < info->min)
+    {
+        size = info->min;
+    }
+    if (size > info->max)
+    {
+        size = info->max;
+    }
+    return size;
+}
+
+/**
+ * @brief 缓冲区用量和建议大小命令实现
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return int 0成功，-1 KV存储不可用或参数修改失败
+ * @note bufsize列出每个缓冲区的当前大小、本次启动的峰值、保存的历史峰值和建议大小；
+ *       bufsize save把本次峰值并入保存的历史峰值；bufsize apply把建议大小写入运行参数，
+ *       shell任务随即更换缓冲区，参数延迟写入Flash后下次启动直接按新大小分配；
+ *       bufsize clear清除保存的历史峰值
+ */
+static int BufSizeCmd(int argc, char *argv[])
+{
+    static const char *const name[] = {"uart rx", "uart tx", "shell"};
+    static const SettingId_t id[] = {SETTING_UART_RXBUF, SETTING_UART_TXBUF, SETTING_SHELL_BUF};
+    Shell *shell = shellGetCurrent();
+    yDevUsartStats_t stats;
+    serial_shell_peak_t stored = {0, 0, 0};
+    uint32_t peak[3];
+    uint32_t saved[3];
+    uint32_t size[3];
+    uint32_t need[3];
+    uint32_t i;
+    int ret = 0;
+
+    if (yDevIoctl(MessageHandle(), YDEV_USART_IOCTL_GET_STATS, &stats) != YDEV_OK)
+    {
+        return -1;
+    }
+    (void)SettingsRecordGet(SHELL_PEAK_KEY, &stored, (uint16_t)sizeof(stored));
+
+    peak[0] = stats.rx_high_water;
+    peak[1] = stats.tx_high_water;
+    peak[2] = shell_line_peak;
+    saved[0] = stored.rx;
+    saved[1] = stored.tx;
+    saved[2] = stored.line;
+    size[0] = stats.rx_size;
+    size[1] = stats.tx_size;
+    size[2] = shell_buffer_size;
+    for (i = 0; i < 3U; i++)
+    {
+        need[i] = (peak[i] > saved[i]) ? peak[i] : saved[i];
+    }
+    // 发送队列可用容量为size-1；shell缓冲区分为历史记录条数加一行，每行含结束符
+    need[1] += 1U;
+    need[2] = (need[2] + 1U) * (SHELL_HISTORY_MAX_NUMBER + 1U);
+
+    if ((argc > 1) && (strcmp(argv[1], "save") == 0))
+    {
+        stored.rx = need[0];
+        stored.tx = need[1] - 1U;
+        stored.line = (peak[2] > saved[2]) ? peak[2] : saved[2];
+        return (SettingsRecordSet(SHELL_PEAK_KEY, &stored, (uint16_t)sizeof(stored)) == 0) ? 0 : -1;
+    }
+    if ((argc > 1) && (strcmp(argv[1], "clear") == 0))
+    {
+        memset(&stored, 0, sizeof(stored));
+        return (SettingsRecordSet(SHELL_PEAK_KEY, &stored, (uint16_t)sizeof(stored)) == 0) ? 0 : -1;
+    }
+    if ((argc > 1) && (strcmp(argv[1], "apply") == 0))
+    {
+        for (i = 0; i < 3U; i++)
+        {
+            if (SettingsSet(id[i], serial_shell_suggest(id[i], need[i])) != 0)
+            {
+                ret = -1;
+            }
+        }
+        return ret;
+    }
+
+    shellPrint(shell, "%-8s %6s %8s %6s %7s %8s\r\n", "buffer", "size", "setting", "peak", "stored", "suggest");
+    for (i = 0; i < 3U; i++)
+    {
+        shellPrint(shell, "%-8s %6lu %8lu %6lu %7lu %8lu\r\n", name[i], (unsigned long)size[i],
+                   (unsigned long)SettingsGet(id[i]), (unsigned long)peak[i], (unsigned long)saved[i],
+                   (unsigned long)serial_shell_suggest(id[i], need[i]));
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 bufsize, BufSizeCmd, buffer usage and sizing [save|apply|clear]);
+
+/**
+ * @brief 以当前传输方式测一遍测试扇区
+ * @param flash Flash设备
+ * @param stat 输出：擦除、逐页编程、逐页读取三项采样
+ * @return 错误数，含读回数据不符
+ */
+static uint32_t flash_bench_pass(yDevHandle_25q_t *flash, BenchStat_t stat[3])
+{
+    uint32_t address;
+    uint32_t errors = 0;
+    uint32_t start;
+    uint32_t i;
+
+    bench_reset(&stat[0]);
+    bench_reset(&stat[1]);
+    bench_reset(&stat[2]);
+
+    address = FLASH_BENCH_ADDRESS;
+    start = yDevGetTimeUS();
+    if (yDevIoctl(flash, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK)
+        errors++;
+    bench_add(&stat[0], start, FLASH_BENCH_SIZE);
+
+    for (address = FLASH_BENCH_ADDRESS; address < FLASH_BENCH_ADDRESS + FLASH_BENCH_SIZE; address += sizeof(dev_bench_buffer))
+    {
+        for (i = 0; i < sizeof(dev_bench_buffer); i++)
+            dev_bench_buffer[i] = (uint8_t)(i + (address >> 8) * 7U);
+        flash->address = address;
+        start = yDevGetTimeUS();
+        if (yDevWrite(flash, dev_bench_buffer, sizeof(dev_bench_buffer)) != (int32_t)sizeof(dev_bench_buffer))
+            errors++;
+        bench_add(&stat[1], start, sizeof(dev_bench_buffer));
+    }
+
+    for (address = FLASH_BENCH_ADDRESS; address < FLASH_BENCH_ADDRESS + FLASH_BENCH_SIZE; address += sizeof(dev_bench_buffer))
+    {
+        start = yDevGetTimeUS();
+        if (yDev25qRead(flash, address, dev_bench_buffer, sizeof(dev_bench_buffer)) != (int32_t)sizeof(dev_bench_buffer))
+            errors++;
+        bench_add(&stat[2], start, sizeof(dev_bench_buffer));
+        for (i = 0; i < sizeof(dev_bench_buffer); i++)
+        {
+            if (dev_bench_buffer[i] != (uint8_t)(i + (address >> 8) * 7U))
+            {
+                errors++;
+                break;
+            }
+        }
+    }
+
+    return errors;
+}
+
+/**
+ * @brief Flash基准测试命令
+ * @note flashbench [polled|irq|dma]，在FLASH_BENCH_ADDRESS的测试扇区上依次按每种传输方式
+ *       擦除一次、逐页编程、逐页读取并校验；测试期间关闭读缓存，结束后恢复自动选择传输方式
+ */
+static int FlashBenchCmd(int argc, char *argv[])
+{
+    static const char *const mode_name[YDEV_25Q_XFER_MAX] = {"auto", "polled", "irq", "dma"};
+    Shell *shell = shellGetCurrent();
+    yDevHandle_25q_t *flash = FlashGetHandle();
+    yDev25qCacheStats_t cache;
+    BenchStat_t stat[3];
+    char label[16];
+    uint32_t errors;
+    uint32_t lines;
+    uint32_t mode;
+    uint32_t first = YDEV_25Q_XFER_POLLED;
+    uint32_t last = YDEV_25Q_XFER_DMA;
+
+    if (argc > 1)
+    {
+        for (first = YDEV_25Q_XFER_POLLED; first < YDEV_25Q_XFER_MAX; first++)
+        {
+            if (strcmp(argv[1], mode_name[first]) == 0)
+                break;
+        }
+        if (first >= YDEV_25Q_XFER_MAX)
+        {
+            shellPrint(shell, "usage: flashbench [polled|irq|dma]\r\n");
+            return -1;
+        }
+        last = first;
+    }
+
+    // 缓存命中会掩盖传输方式的差别
+    yDevIoctl(flash, YDEV_25Q_IOCTL_CACHE_STATS, &cache);
+    lines = 0;
+    yDevIoctl(flash, YDEV_25Q_IOCTL_CACHE_ENABLE, &lines);
+
+    for (mode = first; (mode <= last) && !shellCancelled(shell); mode++)
+    {
+        yDevIoctl(flash, YDEV_25Q_IOCTL_XFER_MODE, &mode);
+        errors = flash_bench_pass(flash, stat);
+
+        snprintf(label, sizeof(label), "%s erase", mode_name[mode]);
+        bench_print(shell, label, &stat[0]);
+        snprintf(label, sizeof(label), "%s program", mode_name[mode]);
+        bench_print(shell, label, &stat[1]);
+        snprintf(label, sizeof(label), "%s read", mode_name[mode]);
+        bench_print(shell, label, &stat[2]);
+        if (errors != 0)
+            shellPrint(shell, "%s: %lu errors\r\n", mode_name[mode], (unsigned long)errors);
+    }
+
+    mode = YDEV_25Q_XFER_AUTO;
+    yDevIoctl(flash, YDEV_25Q_IOCTL_XFER_MODE, &mode);
+    yDevIoctl(flash, YDEV_25Q_IOCTL_CACHE_ENABLE, &cache.lines);
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN) | SHELL_CMD_LONG,
+                 flashbench, FlashBenchCmd, flash erase/program/read per transfer mode [polled|irq|dma]);
+
+/**
+ * @brief 自检结果输出
+ */
+static void SelfTestPrint(void *arg, const SelfTest_t *test, const SelfTestReport_t *report)
+{
+    shellPrint((Shell *)arg, "%-16s %s %8lu us  %s\r\n", test->name, SelfTestResultName(report->result),
+               (unsigned long)report->us, report->detail);
+}
+
+/**
+ * @brief 自检命令
+ * @note selftest列出自检项；selftest quick|slow|all按类别运行，selftest <名称>...运行指定项(含需要接线的项)
+ */
+static int SelfTestCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    const SelfTest_t *test;
+    SelfTestReport_t report;
+    uint32_t failed = 0;
+    uint32_t i;
+    int n;
+
+    if (argc < 2)
+    {
+        for (i = 0; (test = SelfTestIterate(i)) != NULL; i++)
+        {
+            shellPrint(shell, "%-16s %s\r\n", test->name,
+                       (test->flags & SELFTEST_QUICK) ? "quick" : ((test->flags & SELFTEST_SLOW) ? "slow" : "manual"));
+        }
+        return 0;
+    }
+
+    if (strcmp(argv[1], "quick") == 0)
+        failed = SelfTestRun(SELFTEST_QUICK, SelfTestPrint, shell);
+    else if (strcmp(argv[1], "slow") == 0)
+        failed = SelfTestRun(SELFTEST_SLOW, SelfTestPrint, shell);
+    else if (strcmp(argv[1], "all") == 0)
+        failed = SelfTestRun(SELFTEST_ALL, SelfTestPrint, shell);
+    else
+    {
+        for (n = 1; n < argc; n++)
+        {
+            test = SelfTestFind(argv[n]);
+            if (test == NULL)
+            {
+                shellPrint(shell, "unknown test %s\r\n", argv[n]);
+                return -1;
+            }
+            if (SelfTestRunOne(test, &report) == SELFTEST_FAIL)
+                failed++;
+            SelfTestPrint(shell, test, &report);
+        }
+    }
+
+    return (failed == 0) ? 0 : -1;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 selftest, SelfTestCmd, self test [quick|slow|all|name...]);
+
+/**
+ * @brief 以一个波特率测串口单线回环
+ * @param baud 波特率
+ * @param stat 输出采样，每次采样为收发16字节
+ * @return 0成功，-1初始化失败，正数为出错的采样序号加1
+ */
+static int32_t uart_bench_pass(uint32_t baud, BenchStat_t *stat)
+{
+    yDrvUsartConfig_t config = YDRV_USART_CONFIG_DEFAULT();
+    yDrvUsartHandle_t handle;
+    uint32_t timeout;
+    uint32_t errors = 0;
+    uint32_t start;
+    uint32_t wait;
+    uint32_t loop;
+    uint32_t i;
+    uint8_t rx;
+
+    config.usartId = UART_BENCH_ID;
+    config.mode = YDRV_USART_MODE_SINGLE_WIRE;
+    config.txPin = UART_BENCH_PIN;
+    config.rxPin = UART_BENCH_PIN;
+    config.txAF = UART_BENCH_AF;
+    config.rxAF = UART_BENCH_AF;
+    config.baudRate = baud;
+    bench_reset(stat);
+    if ((baud == 0) || (yDrvUsartInitStatic(&config, &handle) != YDRV_OK))
+        return -1;
+
+    // 每字节10位，超时按20个位时间加余量
+    timeout = 20000000U / baud + 100U;
+    while (yDrvUsartReadByte(&handle, &rx) != 0)
+    {
+    }
+    for (loop = 0; (loop < BENCH_SAMPLES) && (errors == 0); loop++)
+    {
+        start = yDevGetTimeUS();
+        for (i = 0; (i < 16U) && (errors == 0); i++)
+        {
+            dev_bench_buffer[i] = (uint8_t)(loop * 16U + i);
+            wait = yDevGetTimeUS();
+            while (yDrvUsartWriteByte(&handle, &dev_bench_buffer[i]) == 0)
+            {
+                if ((yDevGetTimeUS() - wait) > timeout)
+                    break;
+            }
+            wait = yDevGetTimeUS();
+            while (yDrvUsartReadByte(&handle, &rx) == 0)
+            {
+                if ((yDevGetTimeUS() - wait) > timeout)
+                {
+                    errors++;
+                    break;
+                }
+            }
+            if ((errors == 0) && (rx != dev_bench_buffer[i]))
+                errors++;
+        }
+        if (errors == 0)
+            bench_add(stat, start, 16U);
+    }
+    yDrvUsartDeInitStatic(&handle);
+
+    return (errors == 0) ? 0 : (int32_t)loop;
+}
+
+/**
+ * @brief 串口回环基准测试命令
+ * @note uartbench [baud...]，UART_BENCH_ID以单线半双工模式逐个波特率初始化，
+ *       轮询发送并收回16字节为一次采样，测试完反初始化；不指定波特率时测试115200、921600和2000000
+ */
+static int UartBenchCmd(int argc, char *argv[])
+{
+    static const uint32_t default_baud[] = {115200U, 921600U, 2000000U};
+    Shell *shell = shellGetCurrent();
+    BenchStat_t stat;
+    char label[16];
+    uint32_t count = (argc > 1) ? (uint32_t)(argc - 1) : ARRAY_SIZE(default_baud);
+    uint32_t baud;
+    uint32_t n;
+    int32_t ret;
+
+    for (n = 0; n < count; n++)
+    {
+        baud = (argc > 1) ? (uint32_t)strtoul(argv[n + 1], NULL, 0) : default_baud[n];
+        ret = uart_bench_pass(baud, &stat);
+        if (ret < 0)
+        {
+            shellPrint(shell, "%lu: init failed\r\n", (unsigned long)baud);
+            continue;
+        }
+
+        snprintf(label, sizeof(label), "%lu", (unsigned long)baud);
+        bench_print(shell, label, &stat);
+        if (ret > 0)
+            shellPrint(shell, "%lu: loopback failed at sample %lu\r\n", (unsigned long)baud, (unsigned long)ret);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 uartbench, UartBenchCmd, single-wire loopback throughput [baud...]);
+
+/**
+ * @brief 发送并打印一项性能指标
+ * @param kind PERF_KIND_xxx
+ * @note 发送队列满时等待后重试，仍失败时只打印
+ */
+static void perf_report(Shell *shell, uint8_t kind, const char *name, uint32_t value)
+{
+    static const char *const unit[] = {"cycles", "us", "KB/s"};
+    uint8_t payload[5 + PERF_NAME_MAX];
+    uint32_t len = strlen(name);
+    uint32_t retry;
+
+    if (len > PERF_NAME_MAX)
+        len = PERF_NAME_MAX;
+    payload[0] = kind;
+    payload[1] = (uint8_t)value;
+    payload[2] = (uint8_t)(value >> 8);
+    payload[3] = (uint8_t)(value >> 16);
+    payload[4] = (uint8_t)(value >> 24);
+    memcpy(&payload[5], name, len);
+    for (retry = 0; FrameSend(PERF_FRAME_ID, payload, (uint16_t)(5U + len)) < 0; retry++)
+    {
+        if (retry >= SHELL_TUNNEL_RETRY)
+            break;
+        vTaskDelay(1);
+    }
+
+    if (kind < ARRAY_SIZE(unit))
+        shellPrint(shell, "%-16s %10lu %s\r\n", name, (unsigned long)value, unit[kind]);
+}
+
+/**
+ * @brief 性能回归测试命令
+ * @note 依次运行固定的一组测试：Flash擦除/编程/读取(自动传输方式，关闭读缓存)、
+ *       串口921600回环、全部周期微基准(memcpy、环形缓冲、堆、EXTI、yDev分发、日志)。
+ *       每项结果打印一行并以PERF_FRAME_ID帧发出，最后发一帧PERF_KIND_END，
+ *       由tools/perf_check.py与保存的基线比较
+ */
+static int PerfSuiteCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    yDevHandle_25q_t *flash = FlashGetHandle();
+    const struct ylib_bench *bench;
+    struct ylib_bench_result result;
+    yDev25qCacheStats_t cache;
+    BenchStat_t stat[3];
+    char label[PERF_NAME_MAX + 1];
+    uint32_t count = 0;
+    uint32_t errors = 0;
+    uint32_t lines;
+    uint32_t mode;
+    uint32_t index;
+
+    (void)argc;
+    (void)argv;
+
+    yDevIoctl(flash, YDEV_25Q_IOCTL_CACHE_STATS, &cache);
+    lines = 0;
+    yDevIoctl(flash, YDEV_25Q_IOCTL_CACHE_ENABLE, &lines);
+    mode = YDEV_25Q_XFER_AUTO;
+    yDevIoctl(flash, YDEV_25Q_IOCTL_XFER_MODE, &mode);
+    errors += flash_bench_pass(flash, stat);
+    yDevIoctl(flash, YDEV_25Q_IOCTL_CACHE_ENABLE, &cache.lines);
+
+    bench_sort(&stat[0]);
+    perf_report(shell, PERF_KIND_US, "flash.erase", stat[0].us[0]);
+    perf_report(shell, PERF_KIND_KBPS, "flash.program", bench_kbps(&stat[1]));
+    perf_report(shell, PERF_KIND_KBPS, "flash.read", bench_kbps(&stat[2]));
+    count += 3;
+
+    if (uart_bench_pass(PERF_UART_BAUD, &stat[0]) == 0)
+    {
+        snprintf(label, sizeof(label), "uart.%lu", (unsigned long)PERF_UART_BAUD);
+        perf_report(shell, PERF_KIND_KBPS, label, bench_kbps(&stat[0]));
+        count++;
+    }
+    else
+    {
+        errors++;
+    }
+
+    for (index = 0; (bench = ylib_bench_iterate(index)) != NULL; index++)
+    {
+        // 取消时不发结束帧，上位机按不完整的结果处理
+        if (shellCancelled(shell))
+            return -1;
+        if (ylib_bench_run(bench, 0, &result) != 0)
+        {
+            errors++;
+            break;
+        }
+        snprintf(label, sizeof(label), "bench.%s", bench->name);
+        perf_report(shell, PERF_KIND_CYCLES, label, result.median);
+        count++;
+    }
+
+    snprintf(label, sizeof(label), "%luMHz", (unsigned long)(SystemCoreClock / 1000000U));
+    perf_report(shell, PERF_KIND_END, label, count);
+    shellPrint(shell, "%lu metrics, %lu errors, %s\r\n", (unsigned long)count, (unsigned long)errors, label);
+
+    return (errors == 0) ? 0 : -1;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN) | SHELL_CMD_LONG,
+                 perfsuite, PerfSuiteCmd, fixed benchmark set reported as PERF frames);
+
+/**
+ * @brief 设备操作统计命令
+ * @note devstat [name] [reset]，不带设备名时列出全部已注册设备；
+ *       每行为一类操作的次数、字节数、错误数和最短/平均/最长耗时(us)
+ */
+static int DevStatCmd(int argc, char *argv[])
+{
+    static const char *const op_name[YDEV_STAT_MAX] = {"read", "write", "ioctl"};
+    Shell *shell = shellGetCurrent();
+    yDevOpStats_t stats[YDEV_STAT_MAX];
+    const char *name;
+    void *handle;
+    uint32_t index;
+    uint32_t op;
+
+    for (index = 0; (handle = yDevIterate(index, &name)) != NULL; index++)
+    {
+        if ((argc > 1) && (strcmp(argv[1], name) != 0))
+        {
+            continue;
+        }
+        if ((argc > 2) && (strcmp(argv[2], "reset") == 0))
+        {
+            yDevResetOpStats(handle);
+            continue;
+        }
+        if (yDevGetOpStats(handle, stats) != YDEV_OK)
+        {
+            shellPrint(shell, "device stats not compiled in\r\n");
+            return -1;
+        }
+
+        for (op = 0; op < YDEV_STAT_MAX; op++)
+        {
+            if (stats[op].count == 0)
+            {
+                continue;
+            }
+            shellPrint(shell, "%-8s %-5s n=%lu bytes=%lu err=%lu us=%lu/%lu/%lu\r\n",
+                       name, op_name[op],
+                       (unsigned long)stats[op].count, (unsigned long)stats[op].bytes,
+                       (unsigned long)stats[op].errors, (unsigned long)stats[op].min_us,
+                       (unsigned long)(stats[op].total_us / stats[op].count),
+                       (unsigned long)stats[op].max_us);
+        }
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 devstat, DevStatCmd, device op counters [name] [reset]);
+
+/**
+ * @brief 对象缓存列表命令
+ * @note cache [shrink]，每行为缓存名、对象大小/间隔、分区数、已用/总数、峰值和扩展失败次数；
+ *       带shrink时先把全空分区归还给堆
+ */
+static int CacheCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    ylib_cache_stats_t stats;
+    ylib_cache_t *cache;
+
+    for (uint32_t index = 0; (cache = ylib_cache_iterate(index)) != NULL; index++)
+    {
+        if ((argc > 1) && (strcmp(argv[1], "shrink") == 0))
+        {
+            ylib_cache_shrink(cache);
+        }
+        ylib_cache_get_stats(cache, &stats);
+        shellPrint(shell, "%-10s %lu/%lu slabs %lu used %lu/%lu peak %lu fail %lu\r\n",
+                   (stats.name != NULL) ? stats.name : "-",
+                   (unsigned long)stats.obj_size, (unsigned long)stats.stride,
+                   (unsigned long)stats.slabs, (unsigned long)stats.in_use,
+                   (unsigned long)stats.total, (unsigned long)stats.peak,
+                   (unsigned long)stats.grow_fails);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 cache, CacheCmd, object cache usage [shrink]);
+
+/**
+ * @brief 堆分配跟踪
+ * @note heaptrace start|stop|reset控制跟踪；heaptrace live列出存活块；
+ *       不带参数打印总体统计、大小分布、各任务占用和占用最多的分配点
+ */
+static int HeapTraceCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    HeapTraceStats_t stats;
+    HeapTraceRecord_t record;
+    HeapTraceTask_t task;
+    HeapTraceSite_t sites[8];
+    uint32_t count;
+    uint32_t index;
+
+    if (argc > 1 && strcmp(argv[1], "start") == 0)
+    {
+        HeapTraceStart();
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "stop") == 0)
+    {
+        HeapTraceStop();
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "reset") == 0)
+    {
+        HeapTraceReset();
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "live") == 0)
+    {
+        shellPrint(shell, "ptr        caller     size  tick       task\r\n");
+        for (index = 0; HeapTraceGetLive(index, &record) == 0; index++)
+        {
+            HeapTraceGetTask(record.task, &task);
+            shellPrint(shell, "0x%08lx 0x%08lx %5lu %10lu %s\r\n",
+                       (unsigned long)(uintptr_t)record.ptr, (unsigned long)(uintptr_t)record.caller,
+                       (unsigned long)record.size, (unsigned long)record.tick, task.name);
+        }
+        return 0;
+    }
+
+    HeapTraceGetStats(&stats);
+    shellPrint(shell, "live %lu blocks %lu bytes peak %lu\r\n", (unsigned long)stats.live,
+               (unsigned long)stats.live_bytes, (unsigned long)stats.peak_bytes);
+    shellPrint(shell, "alloc %lu free %lu dropped %lu untracked %lu\r\n", (unsigned long)stats.allocs,
+               (unsigned long)stats.frees, (unsigned long)stats.dropped, (unsigned long)stats.untracked);
+    for (index = 0; index < HEAPTRACE_SIZE_CLASSES; index++)
+    {
+        if (index < HEAPTRACE_SIZE_CLASSES - 1)
+            shellPrint(shell, "<=%-5lu %lu\r\n", 1UL << (HEAPTRACE_MIN_CLASS_LOG2 + index),
+                       (unsigned long)stats.size_class[index]);
+        else
+            shellPrint(shell, ">%-6lu %lu\r\n", 1UL << (HEAPTRACE_MIN_CLASS_LOG2 + index - 1),
+                       (unsigned long)stats.size_class[index]);
+    }
+    for (index = 0; index < HEAPTRACE_MAX_TASKS; index++)
+    {
+        if (HeapTraceGetTask(index, &task) == 0)
+            shellPrint(shell, "%-16s in use %lu peak %lu\r\n", task.name, (unsigned long)task.in_use,
+                       (unsigned long)task.peak);
+    }
+    count = HeapTraceTopSites(sites, sizeof(sites) / sizeof(sites[0]));
+    for (index = 0; index < count; index++)
+    {
+        shellPrint(shell, "0x%08lx %lu blocks %lu bytes\r\n", (unsigned long)(uintptr_t)sites[index].caller,
+                   (unsigned long)sites[index].blocks, (unsigned long)sites[index].bytes);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 heaptrace, HeapTraceCmd, heap allocation trace [start|stop|reset|live]);
+
+#if configHEAP_CHECK_ENABLE
+/**
+ * @brief 堆和内存分区巡检结果
+ * @note heapcheck clear清除损坏记录并重新开始巡检
+ */
+static int HeapCheckCmd(int argc, char *argv[])
+{
+    static const char *const reasons[] = {"?", "header", "guard", "link"};
+    Shell *shell = shellGetCurrent();
+    ylib_heap_fault_t fault;
+
+    if (argc > 1 && strcmp(argv[1], "clear") == 0)
+    {
+        ylib_heap_clear_fault();
+        return 0;
+    }
+    if (!ylib_heap_get_fault(&fault))
+    {
+        shellPrint(shell, "no corruption found\r\n");
+        return 0;
+    }
+
+    shellPrint(shell, "%s corrupt at 0x%08lx", (fault.reason < 4) ? reasons[fault.reason] : reasons[0],
+               (unsigned long)(uintptr_t)fault.block);
+    if (fault.pool != NULL)
+    {
+#if YLIB_MEM_NAME_EN > 0u
+        shellPrint(shell, " in pool 0x%08lx %s\r\n", (unsigned long)(uintptr_t)fault.pool,
+                   (const char *)((YLIB_MEM *)fault.pool)->MemName);
+#else
+        shellPrint(shell, " in pool 0x%08lx\r\n", (unsigned long)(uintptr_t)fault.pool);
+#endif
+    }
+    else if (fault.owner != YLIB_HEAP_OWNER_UNKNOWN)
+        shellPrint(shell, " owner %lu\r\n", (unsigned long)fault.owner);
+    else
+        shellPrint(shell, " owner unknown\r\n");
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 heapcheck, HeapCheckCmd, heap and pool scrub result [clear]);
+#endif
+
+#if configHEAP_STATS_ENABLE
+/**
+ * @brief 内存概况命令
+ * @note 堆总量、已用、空闲、峰值占用和最大空闲块，碎片率为1减去最大空闲块占空闲总量的比例；
+ *       FreeRTOS内核对象和任务栈与应用共用yLib堆，xPortGetMinimumEverFreeHeapSize即堆的历史最小空闲
+ */
+static int FreeCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    ylib_heap_stats_t stats;
+    uint32_t frag;
+
+    (void)argc;
+    (void)argv;
+    ylib_get_heap_stats(&stats);
+    frag = 1000U - stats.largest_free_permille;
+    shellPrint(shell, "       total   used   free   peak largest  frag\r\n");
+    shellPrint(shell, "heap  %6lu %6lu %6lu %6lu  %6lu %3lu.%lu%%\r\n", (unsigned long)stats.total_heap_size,
+               (unsigned long)(stats.total_heap_size - stats.free_heap_size), (unsigned long)stats.free_heap_size,
+               (unsigned long)(stats.total_heap_size - stats.minimum_ever_free_heap_size),
+               (unsigned long)stats.max_block_size, (unsigned long)(frag / 10U), (unsigned long)(frag % 10U));
+    shellPrint(shell, "rtos min ever free %lu\r\n", (unsigned long)xPortGetMinimumEverFreeHeapSize());
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 free, FreeCmd, heap total/used/peak and fragmentation);
+
+/**
+ * @brief 堆详细统计命令
+ * @note 空闲块数量和大小范围、分配释放次数、各分配者当前和峰值占用(含块头)；
+ *       分配者0为ylib_malloc默认归属，1为FreeRTOS
+ */
+static int HeapCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    ylib_heap_stats_t stats;
+#if configHEAP_OWNER_MAX
+    uint32_t owner;
+#endif
+
+    (void)argc;
+    (void)argv;
+    ylib_get_heap_stats(&stats);
+    shellPrint(shell, "size %lu free %lu min ever free %lu\r\n", (unsigned long)stats.total_heap_size,
+               (unsigned long)stats.free_heap_size, (unsigned long)stats.minimum_ever_free_heap_size);
+    shellPrint(shell, "free blocks %lu, smallest %lu largest %lu (%lu.%lu%% of free)\r\n",
+               (unsigned long)stats.number_of_free_blocks, (unsigned long)stats.min_block_size,
+               (unsigned long)stats.max_block_size, (unsigned long)(stats.largest_free_permille / 10U),
+               (unsigned long)(stats.largest_free_permille % 10U));
+    shellPrint(shell, "allocs %lu frees %lu\r\n", (unsigned long)stats.successful_allocations,
+               (unsigned long)stats.successful_frees);
+#if configHEAP_OWNER_MAX
+    shellPrint(shell, "owner  in use   peak\r\n");
+    for (owner = 0; owner < configHEAP_OWNER_MAX; owner++)
+    {
+        shellPrint(shell, "%-5s %7lu %6lu\r\n",
+                   (owner == YLIB_HEAP_OWNER_APP) ? "app" : (owner == YLIB_HEAP_OWNER_RTOS) ? "rtos" : "user",
+                   (unsigned long)stats.owner_in_use[owner], (unsigned long)stats.owner_peak[owner]);
+    }
+#endif
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 heap, HeapCmd, heap free-list and per-owner statistics);
+#endif
+
+#if configHEAP_CHECK_ENABLE
+/**
+ * @brief 内存分区用量命令
+ * @note 每个分区一行：名称、块大小、总块数、已用、峰值和空闲，最近创建的分区在前
+ */
+static int PoolsCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    YLIB_MEM_DATA data;
+    uint32_t index;
+
+    (void)argc;
+    (void)argv;
+    shellPrint(shell, "name             blk  total  used  peak  free\r\n");
+    for (index = 0; YLibMemQueryIndex(index, &data) == YLIB_MEM_NO_ERR; index++)
+    {
+#if YLIB_MEM_NAME_EN > 0u
+        shellPrint(shell, "%-16s", (const char *)data.MemName);
+#else
+        shellPrint(shell, "0x%08lx      ", (unsigned long)(uintptr_t)data.MemAddr);
+#endif
+        shellPrint(shell, "%4lu %6lu %5lu %5lu %5lu\r\n", (unsigned long)data.MemBlkSize,
+                   (unsigned long)data.MemNBlks, (unsigned long)data.MemNUsed,
+                   (unsigned long)(data.MemNBlks - data.MemNMinFree), (unsigned long)data.MemNFree);
+    }
+    if (index == 0)
+        shellPrint(shell, "no pool\r\n");
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 pools, PoolsCmd, memory pool usage and peak);
+#endif
+
+/**
+ * @brief top命令的任务快照
+ * @note 两次快照的运行时间差除以墙钟时间差得到占用率，任务数超过上限时uxTaskGetSystemState返回0
+ */
+#define TOP_MAX_TASKS 12
+static TaskStatus_t top_prev[TOP_MAX_TASKS];
+static TaskStatus_t top_curr[TOP_MAX_TASKS];
+
+/**
+ * @brief 任务CPU占用命令
+ * @note top [interval_ms] [count]，每隔interval_ms(默认1000)刷新一次，共count次(默认1)；
+ *       每行为任务名、状态(X运行/R就绪/B阻塞/S挂起/D删除)、优先级、栈剩余最少字节数和占用率，
+ *       最后一行为空闲任务的占用率；运行时间由TIM17微秒时间戳计量，命令执行期间shell不响应输入
+ */
+static int TopCmd(int argc, char *argv[])
+{
+    static const char state_name[] = "XRBSD?";
+    Shell *shell = shellGetCurrent();
+    uint32_t interval = 1000;
+    uint32_t count = 1;
+    uint32_t prev_total;
+    uint32_t curr_total;
+    uint32_t total;
+    uint32_t delta;
+    uint32_t idle;
+    uint32_t permille;
+    UBaseType_t prev_n;
+    UBaseType_t curr_n;
+    UBaseType_t i;
+    UBaseType_t j;
+
+    if (argc > 1)
+        interval = (uint32_t)strtoul(argv[1], NULL, 0);
+    if (argc > 2)
+        count = (uint32_t)strtoul(argv[2], NULL, 0);
+    if (interval == 0)
+        interval = 1000;
+
+    prev_n = uxTaskGetSystemState(top_prev, TOP_MAX_TASKS, &prev_total);
+    while (count--)
+    {
+        vTaskDelay(pdMS_TO_TICKS(interval));
+        curr_n = uxTaskGetSystemState(top_curr, TOP_MAX_TASKS, &curr_total);
+        if (curr_n == 0)
+        {
+            shellPrint(shell, "more than %d tasks\r\n", TOP_MAX_TASKS);
+            return -1;
+        }
+
+        total = curr_total - prev_total;
+        idle = 0;
+        shellPrint(shell, "name             st prio  stack   cpu\r\n");
+        for (i = 0; i < curr_n; i++)
+        {
+            // 新建的任务没有上一次快照，运行时间从0算起
+            delta = top_curr[i].ulRunTimeCounter;
+            for (j = 0; j < prev_n; j++)
+            {
+                if (top_prev[j].xTaskNumber == top_curr[i].xTaskNumber)
+                {
+                    delta -= top_prev[j].ulRunTimeCounter;
+                    break;
+                }
+            }
+            permille = (total != 0) ? (uint32_t)(((uint64_t)delta * 1000U) / total) : 0;
+            if (top_curr[i].xHandle == xTaskGetIdleTaskHandle())
+                idle = permille;
+
+            shellPrint(shell, "%-16s %c  %4lu %6lu %3lu.%lu%%\r\n", top_curr[i].pcTaskName,
+                       state_name[(top_curr[i].eCurrentState <= eInvalid) ? top_curr[i].eCurrentState : eInvalid],
+                       (unsigned long)top_curr[i].uxCurrentPriority,
+                       (unsigned long)(top_curr[i].usStackHighWaterMark * sizeof(StackType_t)),
+                       (unsigned long)(permille / 10U), (unsigned long)(permille % 10U));
+        }
+        shellPrint(shell, "idle %lu.%lu%% over %luus\r\n", (unsigned long)(idle / 10U),
+                   (unsigned long)(idle % 10U), (unsigned long)total);
+
+        memcpy(top_prev, top_curr, curr_n * sizeof(TaskStatus_t));
+        prev_n = curr_n;
+        prev_total = curr_total;
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 top, TopCmd, task cpu usage [interval_ms] [count]);
+
+/**
+ * @brief 中断下半部工作队列统计
+ * @note 每个队列一行：新入队次数、合并次数、执行次数、当前和峰值队列长度
+ */
+static int WorkqCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    struct ylib_work_queue stats;
+    unsigned int prio;
+
+    (void)argc;
+    (void)argv;
+    shellPrint(shell, "prio      posts     merged       runs depth  max\r\n");
+    for (prio = 0; ylib_work_stats(prio, &stats) == 0; prio++)
+    {
+        shellPrint(shell, "%4u %10lu %10lu %10lu %5u %4u\r\n", prio, (unsigned long)stats.posts,
+                   (unsigned long)stats.merged, (unsigned long)stats.runs, stats.depth, stats.max_depth);
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 workq, WorkqCmd, deferred work queue statistics);
+
+/**
+ * @brief 系统时钟等级
+ * @note 不带参数显示当前频率、空闲等级和各等级请求数；带参数设置空闲等级，被驱动否决时稍后由yDevPmProcess重试
+ */
+static int ClockCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    uint16_t count[YDRV_CLOCK_LEVEL_MAX];
+    uint32_t idle;
+    uint32_t level;
+
+    if (argc > 1)
+    {
+        level = (uint32_t)strtoul(argv[1], NULL, 0);
+        if (yDevClockSetIdle(level) != YDEV_OK)
+        {
+            shellPrint(shell, "switch to level %lu vetoed or invalid\r\n", (unsigned long)level);
+        }
+    }
+
+    idle = yDevClockGetRequests(count);
+    shellPrint(shell, "sysclk %luHz, idle level %lu\r\n", (unsigned long)SystemCoreClock, (unsigned long)idle);
+    for (level = 0; level < YDRV_CLOCK_LEVEL_MAX; level++)
+    {
+        shellPrint(shell, "%c%lu %8luHz %u\r\n", (level == (uint32_t)yDrvClockGet()) ? '*' : ' ',
+                   (unsigned long)level, (unsigned long)yDrvClockLevelHz((yDrvClockLevel_t)level), count[level]);
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 clock, ClockCmd, system clock level [idle_level]);
+
+/**
+ * @brief 堆栈用量告警阈值(%)，历史最大用量超过时在行尾标记
+ */
+#define STACK_WARN_PERCENT 75U
+
+/**
+ * @brief 堆栈用量命令
+ * @note 每个任务一行：堆栈大小、历史最大用量、剩余最少字节数和用量比例，最后一行为中断使用的主堆栈；
+ *       用量来自创建时的0xA5填充，只反映已经走过的路径，最坏情况见构建时tools/stack_report.py的输出
+ */
+static int StackCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    uint32_t size;
+    uint32_t free;
+    uint32_t used;
+    UBaseType_t n;
+    UBaseType_t i;
+
+    (void)argc;
+    (void)argv;
+    n = uxTaskGetSystemState(top_curr, TOP_MAX_TASKS, NULL);
+    if (n == 0)
+    {
+        shellPrint(shell, "more than %d tasks\r\n", TOP_MAX_TASKS);
+        return -1;
+    }
+
+    shellPrint(shell, "name              size  used  free  use\r\n");
+    for (i = 0; i < n; i++)
+    {
+        size = OsTaskStackDepth(top_curr[i].pxStackBase) * sizeof(StackType_t);
+        free = top_curr[i].usStackHighWaterMark * sizeof(StackType_t);
+        if (size == 0)
+        {
+            shellPrint(shell, "%-16s     - %5s %5lu    -\r\n", top_curr[i].pcTaskName, "-", (unsigned long)free);
+            continue;
+        }
+        used = size - free;
+        shellPrint(shell, "%-16s %5lu %5lu %5lu  %2lu%%%s\r\n", top_curr[i].pcTaskName, (unsigned long)size,
+                   (unsigned long)used, (unsigned long)free, (unsigned long)(used * 100U / size),
+                   (used * 100U > size * STACK_WARN_PERCENT) ? " !" : "");
+    }
+
+    used = yDrvMainStackUsed(&size);
+    shellPrint(shell, "%-16s %5lu %5lu %5lu  %2lu%%%s\r\n", "(isr msp)", (unsigned long)size, (unsigned long)used,
+               (unsigned long)(size - used), (unsigned long)(used * 100U / size),
+               (used * 100U > size * STACK_WARN_PERCENT) ? " !" : "");
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 stacks, StackCmd, task stack high-water marks);
+
+/**
+ * @brief 互斥锁等待统计命令
+ * @note 每把锁一行：获得次数、需要等待的次数、超时次数、平均和最长等待以及最长等待时的持有者；
+ *       带reset参数时显示后清零。持有者优先级低于等待者时已由互斥锁继承提升，
+ *       最长等待仍然很大说明持有者本身持锁太久
+ */
+static int LockCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    uint8_t reset = ((argc > 1) && (strcmp(argv[1], "reset") == 0)) ? 1U : 0U;
+    OsLockStats_t stats;
+    OsLock_t *lock;
+
+    shellPrint(shell, "name          takes contend timeout  avg wait  max wait  owner@max\r\n");
+    for (lock = OsLockNext(NULL); lock != NULL; lock = OsLockNext(lock))
+    {
+        OsLockGetStats(lock, &stats, reset);
+        shellPrint(shell, "%-10s %8lu  %6lu  %6lu  %6lums  %6lums  %s\r\n", lock->name, (unsigned long)stats.takes,
+                   (unsigned long)stats.contended, (unsigned long)stats.timeouts,
+                   (unsigned long)((stats.contended != 0) ? (stats.wait_ms / stats.contended) : 0U),
+                   (unsigned long)stats.max_wait_ms, (stats.max_owner[0] != '\0') ? stats.max_owner : "-");
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 locks, LockCmd, mutex wait statistics [reset]);
+
+/**
+ * @brief 故障类型名
+ */
+static const char *FaultTypeName(uint32_t type)
+{
+    static const char *const type_name[] = {"none", "hardfault", "stack overflow", "user", "assert", "watchdog"};
+
+    return (type < sizeof(type_name) / sizeof(type_name[0])) ? type_name[type] : "?";
+}
+
+/**
+ * @brief 故障记录命令
+ * @note fault显示上一次复位前的故障记录，fault clear清除；
+ *       HardFault的pc为出错指令地址，可用arm-none-eabi-addr2line定位
+ */
+static int FaultCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    yDrvFaultRecord_t record;
+
+    if ((argc > 1) && (strcmp(argv[1], "clear") == 0))
+    {
+        yDrvFaultClear();
+        return 0;
+    }
+    if (yDrvFaultGet(&record) == 0)
+    {
+        shellPrint(shell, "no fault recorded\r\n");
+        return 0;
+    }
+
+    shellPrint(shell, "%s #%lu at %lums %s\r\n", FaultTypeName(record.type), (unsigned long)record.count,
+               (unsigned long)record.time_ms, record.name);
+    shellPrint(shell, "pc 0x%08lx lr 0x%08lx psr 0x%08lx sp 0x%08lx arg 0x%08lx\r\n", (unsigned long)record.pc,
+               (unsigned long)record.lr, (unsigned long)record.psr, (unsigned long)record.sp,
+               (unsigned long)record.arg);
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 fault, FaultCmd, last fault record [clear]);
+
+/**
+ * @brief 看门狗状态命令
+ * @note 列出登记的任务、心跳期限、距上次报到的时间和见到的最长间隔
+ */
+static int WdgCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    WatchdogStats_t stats;
+    WatchdogInfo_t info;
+    int32_t id;
+
+    (void)argc;
+    (void)argv;
+    WatchdogGetStats(&stats);
+    shellPrint(shell, "iwdg %lums, checks %lu, kicks %lu%s\r\n", (unsigned long)stats.iwdg_ms,
+               (unsigned long)stats.checks, (unsigned long)stats.kicks, stats.iwdg_reset ? ", last reset by IWDG" : "");
+    shellPrint(shell, "task         deadline       age     worst  checkins\r\n");
+    for (id = 0; id < WATCHDOG_TASKS_MAX; id++)
+    {
+        if (WatchdogGetInfo(id, &info) != 0)
+            continue;
+        shellPrint(shell, "%-12s %8lu %9lu %9lu %9lu%s\r\n", info.name, (unsigned long)info.deadline_ms,
+                   (unsigned long)info.age_ms, (unsigned long)info.worst_ms, (unsigned long)info.checkins,
+                   info.suspended ? " suspended" : "");
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 wdg, WdgCmd, task heartbeat watchdog status);
+
+/**
+ * @brief 报告中列出的函数数上限
+ */
+#define PROF_REPORT_MAX 20
+
+/**
+ * @brief 统计采样分析命令
+ * @note prof start [hz] 清空后开始采样，prof stop 停止，prof report [n] 列出样本最多的n个函数；
+ *       没有函数表或PC不在函数内时以地址代替函数名
+ */
+static int ProfCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    ProfEntry_t top[PROF_REPORT_MAX];
+    ProfStats_t stats;
+    uint32_t permille;
+    uint32_t n;
+    uint32_t i;
+    int32_t ret;
+
+    if ((argc > 1) && (strcmp(argv[1], "start") == 0))
+    {
+        ret = ProfStart((argc > 2) ? (uint32_t)atoi(argv[2]) : 0);
+        if (ret < 0)
+            shellPrint(shell, "invalid rate\r\n");
+        else
+            shellPrint(shell, "sampling at %ld Hz\r\n", (long)ret);
+        return 0;
+    }
+    if ((argc > 1) && (strcmp(argv[1], "stop") == 0))
+    {
+        ProfStop();
+        return 0;
+    }
+    if ((argc < 2) || (strcmp(argv[1], "report") != 0))
+    {
+        shellPrint(shell, "usage: prof start [hz] | stop | report [n]\r\n");
+        return 0;
+    }
+
+    n = (argc > 2) ? (uint32_t)atoi(argv[2]) : 10;
+    if ((n == 0) || (n > PROF_REPORT_MAX))
+        n = PROF_REPORT_MAX;
+    ProfGetStats(&stats);
+    shellPrint(shell, "%s, %lu Hz, %lu samples, %lu not binned, %lu symbols\r\n", stats.running ? "running" : "stopped",
+               (unsigned long)stats.rate, (unsigned long)stats.samples, (unsigned long)stats.other,
+               (unsigned long)stats.symbols);
+    if (stats.samples == 0)
+        return 0;
+
+    n = ProfTop(top, n);
+    shellPrint(shell, " samples     %%  function\r\n");
+    for (i = 0; i < n; i++)
+    {
+        permille = (uint32_t)((uint64_t)top[i].count * 1000U / stats.samples);
+        shellPrint(shell, "%8lu %5lu.%lu ", (unsigned long)top[i].count, (unsigned long)(permille / 10U),
+                   (unsigned long)(permille % 10U));
+        if (top[i].name != NULL)
+            shellPrint(shell, " %s\r\n", top[i].name);
+        else
+            shellPrint(shell, " 0x%08lx\r\n", (unsigned long)top[i].addr);
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 prof, ProfCmd, statistical profiler start [hz] | stop | report [n]);
+
+/**
+ * @brief LIN主机命令
+ * @note lin 显示调度状态和按结果分类的帧数，lin start 重新启动上一次的调度表，
+ *       lin stop 停止调度，lin reset 清零统计；解码后的帧用bus命令查看lin主题
+ */
+static int LinCmd(int argc, char *argv[])
+{
+    static const char *const names[LIN_STATUS_MAX] = {"ok", "no response", "incomplete", "checksum", "readback"};
+    Shell *shell = shellGetCurrent();
+    LinStats_t stats;
+    uint32_t i;
+
+    if ((argc > 1) && (strcmp(argv[1], "start") == 0))
+    {
+        if (LinResume() != 0)
+            shellPrint(shell, "no schedule\r\n");
+        return 0;
+    }
+    if ((argc > 1) && (strcmp(argv[1], "stop") == 0))
+    {
+        LinStop();
+        return 0;
+    }
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0))
+    {
+        LinResetStats();
+        return 0;
+    }
+    if (argc > 1)
+    {
+        shellPrint(shell, "usage: lin [start | stop | reset]\r\n");
+        return 0;
+    }
+
+    LinGetStats(&stats);
+    shellPrint(shell, "%s, %u slots, %lu headers, %lu late\r\n", stats.running ? "running" : "stopped",
+               (unsigned)stats.count, (unsigned long)stats.frames, (unsigned long)stats.late);
+    for (i = 0; i < LIN_STATUS_MAX; i++)
+        shellPrint(shell, "%-12s %10lu\r\n", names[i], (unsigned long)stats.status[i]);
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 lin, LinCmd, LIN master schedule status | start | stop | reset);
+
+/**
+ * @brief 能耗报告的任务数上限
+ */
+#define POWER_REPORT_TASKS 16
+
+/**
+ * @brief 能耗报告的一行：名称、时间(毫秒)、次数、电流和估算电荷(uAh)
+ */
+static uint64_t power_line(Shell *shell, const char *name, uint64_t us, uint32_t count, uint32_t ua)
+{
+    uint64_t nah = PowerCharge(ua, us);
+
+    shellPrint(shell, "%-16s %10lu %8lu %6lu %8lu.%03lu\r\n", name, (unsigned long)(us / 1000U),
+               (unsigned long)count, (unsigned long)ua, (unsigned long)(nah / 1000U), (unsigned long)(nah % 1000U));
+    return nah;
+}
+
+/**
+ * @brief 能耗估算命令
+ * @note power 列出上电或清零以来CPU各状态、已注册设备和各任务的时间、次数和估算电荷；
+ *       CPU一栏的次数为进入睡眠/STOP的次数，设备为唤醒次数，任务为切入次数；
+ *       power reset 清零，power ua <name> <uA> 修改电流表，name为设备注册名或cpu.run/cpu.sleep/cpu.stop
+ */
+static int PowerCmd(int argc, char *argv[])
+{
+    static PowerTask_t tasks[POWER_REPORT_TASKS];
+    Shell *shell = shellGetCurrent();
+    yDevPmCpuStats_t cpu;
+    yDevPmUsage_t usage;
+    const char *name;
+    void *handle;
+    uint64_t window_us;
+    uint64_t run_us;
+    uint64_t nah;
+    uint32_t index;
+    uint32_t n;
+
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0))
+    {
+        PowerReset();
+        return 0;
+    }
+    if ((argc > 3) && (strcmp(argv[1], "ua") == 0))
+    {
+        if (PowerSetCurrent(argv[2], (uint32_t)strtoul(argv[3], NULL, 0)) != 0)
+            shellPrint(shell, "unknown device %s\r\n", argv[2]);
+        return 0;
+    }
+    if (argc > 1)
+    {
+        shellPrint(shell, "usage: power [reset | ua <name> <uA>]\r\n");
+        return 0;
+    }
+
+    if (yDevPmGetCpuStats(&cpu) != YDEV_OK)
+    {
+        shellPrint(shell, "not supported\r\n");
+        return 0;
+    }
+    window_us = (uint64_t)PowerGetElapsedMs() * 1000U;
+    run_us = window_us - (((cpu.sleep_us + cpu.stop_us) < window_us) ? (cpu.sleep_us + cpu.stop_us) : window_us);
+
+    shellPrint(shell, "name                time_ms    count     uA      uAh\r\n");
+    nah = power_line(shell, "cpu.run", run_us, 0, PowerGetCurrent(POWER_NAME_CPU_RUN));
+    nah += power_line(shell, "cpu.sleep", cpu.sleep_us, cpu.sleeps, PowerGetCurrent(POWER_NAME_CPU_SLEEP));
+    nah += power_line(shell, "cpu.stop", cpu.stop_us, cpu.stops, PowerGetCurrent(POWER_NAME_CPU_STOP));
+    for (index = 0; (handle = yDevIterate(index, &name)) != NULL; index++)
+    {
+        if (yDevPmGetUsage(handle, &usage) == YDEV_OK)
+            nah += power_line(shell, name, usage.awake_us, usage.wakes, PowerGetCurrent(name));
+    }
+    shellPrint(shell, "total %lu.%03lu uAh over %lu ms\r\n", (unsigned long)(nah / 1000U),
+               (unsigned long)(nah % 1000U), (unsigned long)(window_us / 1000U));
+
+    // 任务运行时按CPU运行电流计，空闲任务扣除睡眠和STOP时间，合计约等于cpu.run一行
+    n = PowerGetTasks(tasks, POWER_REPORT_TASKS);
+    shellPrint(shell, "task                 run_ms switches     uA      uAh\r\n");
+    for (index = 0; index < n; index++)
+    {
+        run_us = tasks[index].run_us;
+        if (tasks[index].idle)
+            run_us -= ((cpu.sleep_us + cpu.stop_us) < run_us) ? (cpu.sleep_us + cpu.stop_us) : run_us;
+        (void)power_line(shell, tasks[index].name, run_us, tasks[index].switches,
+                         PowerGetCurrent(POWER_NAME_CPU_RUN));
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 power, PowerCmd, energy estimate [reset | ua <name> <uA>]);
+
+/**
+ * @brief 传感器采样命令
+ * @note 列出登记的传感器、周期、成功和失败次数以及最近一次的原始数据
+ */
+static int SensorCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    SensorStats_t stats;
+    Sensor_t *sensor;
+    uint32_t id;
+    uint32_t i;
+
+    (void)argc;
+    (void)argv;
+    SensorGetStats(&stats);
+    shellPrint(shell, "%lu sensors, batches %lu, samples %lu, errors %lu, late %lu, max busy %lu us\r\n",
+               (unsigned long)stats.sensors, (unsigned long)stats.batches, (unsigned long)stats.samples,
+               (unsigned long)stats.errors, (unsigned long)stats.late, (unsigned long)stats.max_busy_us);
+    for (id = 0; (sensor = SensorGet(id)) != NULL; id++)
+    {
+        shellPrint(shell, "%2lu %-10s %s %5ums %8lu %6lu %s", (unsigned long)id, sensor->name,
+                   (sensor->bus == SENSOR_BUS_IIC) ? "iic" : "spi", (unsigned int)sensor->period_ms,
+                   (unsigned long)sensor->samples, (unsigned long)sensor->errors, sensor->status ? "FAIL" : "ok  ");
+        for (i = 0; i < sensor->raw_len; i++)
+            shellPrint(shell, " %02x", sensor->raw[i]);
+        shellPrint(shell, "\r\n");
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 sensor, SensorCmd, sensor sampling status);
+
+/**
+ * @brief 外部Flash中的故障转储命令
+ * @note crashdump显示启动时从RAM拷贝到flash0的故障记录，掉电后仍保留；clear擦除，
+ *       save立即拷贝RAM中的记录。跟踪事件的时间为相对第一条的时钟计数，
+ *       arg为断言行号或堆栈溢出的任务句柄
+ */
+static int CrashDumpCmd(int argc, char *argv[])
+{
+    static const char *const event_name[] = {"time",       "lost",       "task in",   "task create", "tick",
+                                             "isr",        "queue send", "queue recv", "dev begin",  "dev end"};
+    Shell *shell = shellGetCurrent();
+    const yDrvFaultRecord_t *record;
+    const CrashDumpExtra_t *extra;
+    void *flash;
+    uint32_t time = 0;
+    uint32_t i;
+
+    flash = yDevFind("flash0");
+    if (flash == NULL)
+    {
+        shellPrint(shell, "flash0 not found\r\n");
+        return -1;
+    }
+    if (argc > 1 && strcmp(argv[1], "clear") == 0)
+        return (int)CrashDumpErase(flash);
+    if (argc > 1 && strcmp(argv[1], "save") == 0)
+        return (CrashDumpSave(flash) < 0) ? -1 : 0;
+
+    record = CrashDumpLoad(flash);
+    if (record == NULL)
+    {
+        shellPrint(shell, "no crash dump\r\n");
+        return 0;
+    }
+
+    shellPrint(shell, "%s #%lu at %lums task %s", FaultTypeName(record->type), (unsigned long)record->count,
+               (unsigned long)record->time_ms, record->name);
+    if (record->psr & 0x3FU)
+        shellPrint(shell, " in exception %lu", (unsigned long)(record->psr & 0x3FU));
+    shellPrint(shell, "\r\nr0 0x%08lx r1 0x%08lx r2 0x%08lx r3 0x%08lx r12 0x%08lx\r\n", (unsigned long)record->r0,
+               (unsigned long)record->r1, (unsigned long)record->r2, (unsigned long)record->r3,
+               (unsigned long)record->r12);
+    shellPrint(shell, "pc 0x%08lx lr 0x%08lx psr 0x%08lx sp 0x%08lx arg 0x%08lx\r\n", (unsigned long)record->pc,
+               (unsigned long)record->lr, (unsigned long)record->psr, (unsigned long)record->sp,
+               (unsigned long)record->arg);
+    if (record->extra_len < sizeof(CrashDumpExtra_t))
+        return 0;
+
+    extra = (const CrashDumpExtra_t *)record->extra;
+    shellPrint(shell, "heap free %lu min %lu\r\n", (unsigned long)extra->heap_free, (unsigned long)extra->heap_min);
+    shellPrint(shell, "last %lu trace events, clock %luHz\r\n", (unsigned long)extra->trace_count,
+               (unsigned long)extra->trace_hz);
+    for (i = 0; (i < extra->trace_count) && (i < CRASHDUMP_TRACE_RECORDS); i++)
+    {
+        time += extra->trace[i].delta;
+        if (extra->trace[i].event < sizeof(event_name) / sizeof(event_name[0]))
+            shellPrint(shell, "%10lu %-11s 0x%08lx\r\n", (unsigned long)time, event_name[extra->trace[i].event],
+                       (unsigned long)extra->trace[i].arg);
+        else
+            shellPrint(shell, "%10lu user %-6u 0x%08lx\r\n", (unsigned long)time, (unsigned)extra->trace[i].event,
+                       (unsigned long)extra->trace[i].arg);
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 crashdump, CrashDumpCmd, fault dump saved in flash [clear|save]);
+
+/**
+ * @brief 固件升级状态命令
+ * @note fwup显示接收进度和两个槽的槽头，镜像由tools/fw_upload.py经帧协议发送
+ */
+static int FwUpdateCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    static const char *const states[] = {"idle", "erasing", "receiving", "done", "failed"};
+    FwUpdateStatus_t status;
+    FwUpdateHeader_t header;
+    uint32_t slot;
+
+    (void)argc;
+    (void)argv;
+
+    FwUpdateGetStatus(&status);
+    shellPrint(shell, "state %s, slot %c, %lu/%lu bytes, error %u, retries %lu\r\n",
+               (status.state < 5U) ? states[status.state] : "?", 'A' + status.slot,
+               (unsigned long)status.offset, (unsigned long)((status.packed != 0) ? status.packed : status.size),
+               status.error, (unsigned long)status.retries);
+    if (status.packed != 0)
+        shellPrint(shell, "compressed, image %lu bytes\r\n", (unsigned long)status.size);
+    for (slot = 0; slot < FWUP_SLOTS; slot++)
+    {
+        if (FwUpdateGetSlot(slot, &header) != 0)
+        {
+            shellPrint(shell, "slot %c: empty\r\n", (int)('A' + slot));
+            continue;
+        }
+        shellPrint(shell, "slot %c: seq %lu, version 0x%08lx, %lu bytes, crc 0x%08lx\r\n", (int)('A' + slot),
+                   (unsigned long)header.seq, (unsigned long)header.version, (unsigned long)header.size,
+                   (unsigned long)header.crc);
+    }
+
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 fwup, FwUpdateCmd, firmware update slots);
+
+/**
+ * @brief 二进制日志命令
+ * @note log level <0~3>设置级别门限，log sink <frame|text|flash|off...>选择输出，
+ *       log dump以帧发送Flash日志区，log erase擦除日志区，log test写入几条测试日志；
+ *       不带参数时显示统计。帧用tools/log_decode.py解码
+ */
+static int LogCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    LogSinkStats_t stats;
+    uint32_t mask = 0;
+    int32_t ret;
+    int i;
+
+    if (argc < 2)
+    {
+        LogSinkGetStats(&stats);
+        shellPrint(shell, "sink%s%s%s, level %u, %lu records, %lu dropped, %u words queued\r\n",
+                   (stats.mask & LOGSINK_FRAME) ? " frame" : "", (stats.mask & LOGSINK_TEXT) ? " text" : "",
+                   (stats.mask & LOGSINK_FLASH) ? " flash" : "", (unsigned int)ylib_log_threshold,
+                   (unsigned long)stats.records, (unsigned long)ylib_log_dropped(), ylib_log_count());
+        shellPrint(shell, "frame fail %lu, flash %lu words in %lu bytes, sector %lu seq %lu\r\n",
+                   (unsigned long)stats.frame_fail, (unsigned long)stats.flash_words,
+                   (unsigned long)stats.flash_bytes, (unsigned long)stats.flash_sector,
+                   (unsigned long)stats.flash_seq);
+        return 0;
+    }
+
+    if ((argc > 2) && (strcmp(argv[1], "level") == 0))
+    {
+        ylib_log_threshold = (uint8_t)strtoul(argv[2], NULL, 0);
+        return 0;
+    }
+    if ((argc > 2) && (strcmp(argv[1], "sink") == 0))
+    {
+        for (i = 2; i < argc; i++)
+        {
+            if (strcmp(argv[i], "frame") == 0)
+                mask |= LOGSINK_FRAME;
+            else if (strcmp(argv[i], "text") == 0)
+                mask |= LOGSINK_TEXT;
+            else if (strcmp(argv[i], "flash") == 0)
+                mask |= LOGSINK_FLASH;
+            else if (strcmp(argv[i], "off") != 0)
+            {
+                shellPrint(shell, "unknown sink %s\r\n", argv[i]);
+                return -1;
+            }
+        }
+        LogSinkSetMask(mask);
+        return 0;
+    }
+    if (strcmp(argv[1], "test") == 0)
+    {
+        YLIB_LOGD("log test, tick %lu", (unsigned long)xTaskGetTickCount());
+        YLIB_LOGI("log test, %lu words queued", (unsigned long)ylib_log_count());
+        YLIB_LOGW("log test, %s", "constant string");
+        YLIB_LOGE("log test, %d %u 0x%x %c", -1, 2U, 0x3FU, 'y');
+        return 0;
+    }
+    if (strcmp(argv[1], "dump") == 0)
+    {
+        ret = LogSinkFlashDump();
+    }
+    else if (strcmp(argv[1], "erase") == 0)
+    {
+        ret = LogSinkFlashErase();
+    }
+    else
+    {
+        shellPrint(shell, "usage: log [level <0~3>|sink <frame|text|flash|off>...|dump|erase|test]\r\n");
+        return -1;
+    }
+
+    if (ret < 0)
+    {
+        shellPrint(shell, "failed\r\n");
+        return -1;
+    }
+    shellPrint(shell, "%ld\r\n", (long)ret);
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 log, LogCmd, binary log [level <n>|sink <frame|text|flash|off>...|dump|erase|test]);
+
+/**
+ * @brief 数据记录查询回调，每条记录输出一行
+ */
+static int32_t DataLogPrint(void *arg, const DataLogRecord_t *rec, uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        shellPrint((Shell *)arg, "%lu %u %u %ld\r\n", (unsigned long)rec[i].time, (unsigned int)rec[i].channel,
+                   (unsigned int)rec[i].flags, (long)rec[i].value);
+    }
+    return 0;
+}
+
+/**
+ * @brief 采样数据记录命令
+ * @note dlog add <通道> <值> [个数]追加记录，dlog dump [起始 [结束]]按时间范围逐行输出
+ *       "时间 通道 标志 值"，dlog sync写入缓冲的记录，dlog erase擦除存储区；
+ *       不带参数时显示统计，时间单位为DATALOG_TICK_MS
+ */
+static int DataLogCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    DataLogStats_t stats;
+    uint32_t from = 0;
+    uint32_t to = 0xFFFFFFFFUL;
+    uint32_t count = 1;
+    uint32_t i;
+    int32_t ret = 0;
+
+    if (argc < 2)
+    {
+        if (DataLogGetStats(&stats) != 0)
+        {
+            shellPrint(shell, "flash0 unavailable\r\n");
+            return -1;
+        }
+        shellPrint(shell, "%lu records in %lu segments, time %lu..%lu, now %lu (%u ms)\r\n",
+                   (unsigned long)stats.records, (unsigned long)stats.segments, (unsigned long)stats.first,
+                   (unsigned long)stats.last, (unsigned long)stats.now, (unsigned int)DATALOG_TICK_MS);
+        shellPrint(shell, "appended %lu, failed %lu, rolls %lu\r\n", (unsigned long)stats.appended,
+                   (unsigned long)stats.failed, (unsigned long)stats.rolls);
+        return 0;
+    }
+
+    if ((argc > 3) && (strcmp(argv[1], "add") == 0))
+    {
+        if (argc > 4)
+            count = strtoul(argv[4], NULL, 0);
+        for (i = 0; (i < count) && (ret == 0); i++)
+            ret = DataLogAppend((uint16_t)strtoul(argv[2], NULL, 0), 0, (int32_t)strtol(argv[3], NULL, 0));
+    }
+    else if (strcmp(argv[1], "dump") == 0)
+    {
+        if (argc > 2)
+            from = strtoul(argv[2], NULL, 0);
+        if (argc > 3)
+            to = strtoul(argv[3], NULL, 0);
+        ret = DataLogQuery(from, to, DataLogPrint, shell);
+        if (ret >= 0)
+            shellPrint(shell, "%ld records\r\n", (long)ret);
+    }
+    else if (strcmp(argv[1], "sync") == 0)
+    {
+        ret = DataLogSync();
+    }
+    else if (strcmp(argv[1], "erase") == 0)
+    {
+        ret = DataLogErase();
+    }
+    else
+    {
+        shellPrint(shell, "usage: dlog [add <ch> <value> [n]|dump [from [to]]|sync|erase]\r\n");
+        return -1;
+    }
+
+    if (ret < 0)
+    {
+        shellPrint(shell, "failed\r\n");
+        return -1;
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 dlog, DataLogCmd, sample log [add <ch> <value> [n]|dump [from [to]]|sync|erase]);
+
+#if YLIB_TRACE_ENABLE
+/**
+ * @brief 事件跟踪命令
+ * @note trace start [mask]开始记录(默认除滴答外全部事件)，stop停止，clear清空，
+ *       dump以帧发送全部记录，save <addr>保存到flash0，load <addr>从flash0读出并以帧发送；
+ *       不带参数时显示状态。帧用tools/trace_decode.py解码
+ */
+static int TraceCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    void *flash;
+    int32_t ret;
+
+    if (argc < 2)
+    {
+        shellPrint(shell, "%s, %u records, %lu dropped, mask 0x%08lx\r\n", ylib_trace_mask ? "running" : "stopped",
+                   ylib_trace_count(), (unsigned long)ylib_trace_dropped(), (unsigned long)ylib_trace_mask);
+        return 0;
+    }
+
+    if (strcmp(argv[1], "start") == 0)
+    {
+        if (ylib_trace_start((argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : YLIB_TRACE_MASK_DEFAULT) != 0)
+        {
+            shellPrint(shell, "no trace clock\r\n");
+            return -1;
+        }
+        return 0;
+    }
+    if (strcmp(argv[1], "stop") == 0)
+    {
+        ylib_trace_stop();
+        return 0;
+    }
+    if (strcmp(argv[1], "clear") == 0)
+    {
+        ylib_trace_stop();
+        ylib_trace_clear();
+        return 0;
+    }
+    if (strcmp(argv[1], "dump") == 0)
+    {
+        ret = TraceRecSend();
+    }
+    else if (argc > 2 && (strcmp(argv[1], "save") == 0 || strcmp(argv[1], "load") == 0))
+    {
+        flash = yDevFind("flash0");
+        if (flash == NULL)
+        {
+            shellPrint(shell, "flash0 not found\r\n");
+            return -1;
+        }
+        if (argv[1][0] == 's')
+            ret = TraceRecSave(flash, (uint32_t)strtoul(argv[2], NULL, 0));
+        else
+            ret = TraceRecSendFlash(flash, (uint32_t)strtoul(argv[2], NULL, 0));
+    }
+    else
+    {
+        shellPrint(shell, "usage: trace [start [mask]|stop|clear|dump|save <addr>|load <addr>]\r\n");
+        return -1;
+    }
+
+    if (ret < 0)
+    {
+        shellPrint(shell, "failed\r\n");
+        return -1;
+    }
+    shellPrint(shell, "%ld\r\n", (long)ret);
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 trace, TraceCmd, event trace [start [mask]|stop|clear|dump|save <addr>|load <addr>]);
+#endif
+
+/**
+ * @brief md文本输出的最大长度，更长的内存用md -b走帧协议
+ */
+#define MD_TEXT_MAX 1024U
+
+/**
+ * @brief 内存显示命令
+ * @note md <addr> [len] [width]，len默认64，width为1/2/4(默认4)，外设区只能按字读；
+ *       md -b <addr> <len>以MEMDIAG_FRAME_ID帧发送原始数据，不受文本长度限制
+ */
+static int MdCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    uint8_t line[16] __attribute__((aligned(4)));
+    uint32_t addr;
+    uint32_t len = 64;
+    uint32_t width = 4;
+    uint32_t n;
+    uint32_t i;
+    int32_t ret;
+
+    if ((argc > 3) && (strcmp(argv[1], "-b") == 0))
+    {
+        ret = MemDiagSend((uint32_t)strtoul(argv[2], NULL, 0), (uint32_t)strtoul(argv[3], NULL, 0));
+        if (ret < 0)
+        {
+            shellPrint(shell, "failed\r\n");
+            return -1;
+        }
+        shellPrint(shell, "%ld\r\n", (long)ret);
+        return 0;
+    }
+    if (argc < 2)
+    {
+        shellPrint(shell, "usage: md <addr> [len] [width] | md -b <addr> <len>\r\n");
+        return -1;
+    }
+
+    addr = (uint32_t)strtoul(argv[1], NULL, 0);
+    if (argc > 2)
+        len = (uint32_t)strtoul(argv[2], NULL, 0);
+    if (argc > 3)
+        width = (uint32_t)strtoul(argv[3], NULL, 0);
+    if (len > MD_TEXT_MAX)
+        len = MD_TEXT_MAX;
+    if (MemDiagCheck(addr, len, width, 0) != 0)
+    {
+        shellPrint(shell, "invalid address, length or width\r\n");
+        return -1;
+    }
+
+    // 每行16字节：地址、按宽度的十六进制值、字节宽度时附ASCII
+    while ((len > 0) && !shellCancelled(shell))
+    {
+        n = (len > sizeof(line)) ? sizeof(line) : len;
+        MemDiagRead(line, addr, n, width);
+        shellPrint(shell, "%08lx:", (unsigned long)addr);
+        for (i = 0; i < n; i += width)
+        {
+            if (width == 4)
+                shellPrint(shell, " %08lx", (unsigned long)((uint32_t)line[i] | ((uint32_t)line[i + 1] << 8) |
+                                                           ((uint32_t)line[i + 2] << 16) | ((uint32_t)line[i + 3] << 24)));
+            else if (width == 2)
+                shellPrint(shell, " %04x", (unsigned int)(line[i] | (line[i + 1] << 8)));
+            else
+                shellPrint(shell, " %02x", (unsigned int)line[i]);
+        }
+        if (width == 1)
+        {
+            shellPrint(shell, "%*s  ", (int)((sizeof(line) - n) * 3U), "");
+            for (i = 0; i < n; i++)
+                shellPrint(shell, "%c", ((line[i] >= 0x20) && (line[i] < 0x7F)) ? line[i] : '.');
+        }
+        shellPrint(shell, "\r\n");
+        addr += n;
+        len -= n;
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN) | SHELL_CMD_LONG,
+                 md, MdCmd, memory display <addr> [len] [width] | -b <addr> <len>);
+
+/**
+ * @brief 内存写命令
+ * @note mw <addr> <value> [width]，写后读回显示；Flash和系统存储区只读，外设区只能按字写
+ */
+static int MwCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    uint32_t addr;
+    uint32_t value;
+    uint32_t width = 4;
+
+    if (argc < 3)
+    {
+        shellPrint(shell, "usage: mw <addr> <value> [width]\r\n");
+        return -1;
+    }
+    addr = (uint32_t)strtoul(argv[1], NULL, 0);
+    value = (uint32_t)strtoul(argv[2], NULL, 0);
+    if (argc > 3)
+        width = (uint32_t)strtoul(argv[3], NULL, 0);
+    if (MemDiagCheck(addr, width, width, 1) != 0)
+    {
+        shellPrint(shell, "invalid address or width\r\n");
+        return -1;
+    }
+
+    if (width == 4)
+    {
+        *(volatile uint32_t *)(uintptr_t)addr = value;
+        value = *(volatile uint32_t *)(uintptr_t)addr;
+    }
+    else if (width == 2)
+    {
+        *(volatile uint16_t *)(uintptr_t)addr = (uint16_t)value;
+        value = *(volatile uint16_t *)(uintptr_t)addr;
+    }
+    else
+    {
+        *(volatile uint8_t *)(uintptr_t)addr = (uint8_t)value;
+        value = *(volatile uint8_t *)(uintptr_t)addr;
+    }
+    shellPrint(shell, "%08lx: %0*lx\r\n", (unsigned long)addr, (int)(width * 2U), (unsigned long)value);
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 mw, MwCmd, memory write <addr> <value> [width]);
+
+/**
+ * @brief 外设寄存器显示命令
+ * @note regdump <periph>按SVD生成的寄存器表逐个读出；只写和读出有副作用的寄存器不读，显示为wo；
+ *       外设时钟关闭时寄存器读出为0；不带参数列出全部外设
+ */
+static int RegDumpCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    const RegMapPeriph_t *periph;
+    const RegMapReg_t *reg;
+    uint32_t i;
+
+    if (regmap.count == 0)
+    {
+        shellPrint(shell, "no register map in this build\r\n");
+        return -1;
+    }
+    if (argc < 2)
+    {
+        for (i = 0; i < regmap.count; i++)
+            shellPrint(shell, "%s%s", regmap.names + regmap.periphs[i].name, (i + 1U < regmap.count) ? " " : "\r\n");
+        return 0;
+    }
+
+    periph = MemDiagFindPeriph(argv[1]);
+    if (periph == NULL)
+    {
+        shellPrint(shell, "%s not found\r\n", argv[1]);
+        return -1;
+    }
+    for (i = 0; i < periph->count; i++)
+    {
+        reg = &regmap.regs[periph->first + i];
+        if (reg->offset & REGMAP_NOREAD)
+            shellPrint(shell, "%-16s %08lx       wo\r\n", regmap.names + reg->name,
+                       (unsigned long)(periph->base + REGMAP_OFFSET(reg)));
+        else
+            shellPrint(shell, "%-16s %08lx %08lx\r\n", regmap.names + reg->name,
+                       (unsigned long)(periph->base + REGMAP_OFFSET(reg)),
+                       (unsigned long)*(volatile const uint32_t *)(uintptr_t)(periph->base + REGMAP_OFFSET(reg)));
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 regdump, RegDumpCmd, peripheral registers from SVD [periph]);
+
+/**
+ * @brief watch等待样本的最长时间(毫秒)，超时后不满一帧的样本也发出
+ */
+#define WATCH_FLUSH_MS 20U
+
+extern ShellCommand *shellSeekCommand(Shell *shell, const char *cmd, ShellCommand *base, unsigned short compareLength);
+
+/**
+ * @brief 变量采样命令
+ * @note watch <var...> @ <rate> [csv]，按rate(Hz)采样shell导出的int/short/char/node变量，
+ *       默认以WATCH_FRAME_ID帧发送，csv时以文本逐行输出；变量地址在开始时解析一次，
+ *       采样时直接读取；通信串口收到任何数据即停止，停止的按键随后照常交给shell
+ */
+static int WatchCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    WatchVar_t vars[WATCH_VARS_MAX];
+    int32_t values[WATCH_VARS_MAX];
+    yDevUsartRxSpan_t span;
+    ShellCommand *command;
+    uint32_t count = 0;
+    uint32_t total = 0;
+    uint32_t pending;
+    uint32_t dropped;
+    uint32_t seq;
+    uint32_t rate = 0;
+    uint32_t i;
+    uint8_t csv = 0;
+    int32_t ret;
+    int at;
+
+    for (at = 1; (at < argc) && (strcmp(argv[at], "@") != 0); at++)
+    {
+    }
+    if ((at == 1) || (at >= argc - 1) || (at > WATCH_VARS_MAX + 1))
+    {
+        shellPrint(shell, "usage: watch <var...> @ <rate> [csv], at most %d vars\r\n", WATCH_VARS_MAX);
+        return -1;
+    }
+    rate = (uint32_t)strtoul(argv[at + 1], NULL, 0);
+    csv = ((at + 2 < argc) && (strcmp(argv[at + 2], "csv") == 0)) ? 1 : 0;
+
+    for (i = 1; i < (uint32_t)at; i++)
+    {
+        command = shellSeekCommand(shell, argv[i], shell->commandList.base, 0);
+        if ((command == NULL) || (command->attr.attrs.type < SHELL_TYPE_VAR_INT) ||
+            (command->attr.attrs.type > SHELL_TYPE_VAR_NODE) ||
+            (command->attr.attrs.type == SHELL_TYPE_VAR_STRING) || (command->attr.attrs.type == SHELL_TYPE_VAR_POINT))
+        {
+            shellPrint(shell, "%s: not an int/short/char/node variable\r\n", argv[i]);
+            return -1;
+        }
+        vars[count].get = NULL;
+        vars[count].addr = command->data.var.value;
+        if (command->attr.attrs.type == SHELL_TYPE_VAR_NODE)
+        {
+            vars[count].get = ((ShellNodeVarAttr *)command->data.var.value)->get;
+            vars[count].addr = ((ShellNodeVarAttr *)command->data.var.value)->var;
+            if (vars[count].get == NULL)
+            {
+                shellPrint(shell, "%s: no get method\r\n", argv[i]);
+                return -1;
+            }
+        }
+        vars[count].width = (command->attr.attrs.type == SHELL_TYPE_VAR_INT)     ? 4
+                             : (command->attr.attrs.type == SHELL_TYPE_VAR_SHORT) ? 2
+                                                                                  : 1;
+        count++;
+    }
+
+    ret = WatchStart(vars, count, rate);
+    if (ret < 0)
+    {
+        shellPrint(shell, "invalid rate or watch already running\r\n");
+        return -1;
+    }
+    shellPrint(shell, "watching at %ld Hz, any key to stop\r\n", (long)ret);
+    if (csv)
+    {
+        shellPrint(shell, "seq");
+        for (i = 1; i < (uint32_t)at; i++)
+            shellPrint(shell, ",%s", argv[i]);
+        shellPrint(shell, "\r\n");
+    }
+    else
+    {
+        (void)WatchSendMark(WATCH_START, (uint32_t)ret, count);
+    }
+    shellFlush(shell);
+
+    // 命令在MuxPoll中执行，进入时已查看的数据还未提交，之后新到的数据才是停止按键
+    pending = MessagePeek(&span);
+    for (;;)
+    {
+        ret = (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WATCH_FLUSH_MS)) == 0) ? 1 : 0;
+        if (csv)
+        {
+            while (WatchRead(values, 1, &seq) == 1)
+            {
+                shellPrint(shell, "%lu", (unsigned long)seq);
+                for (i = 0; i < count; i++)
+                    shellPrint(shell, ",%ld", (long)values[i]);
+                shellPrint(shell, "\r\n");
+                total++;
+            }
+            shellFlush(shell);
+        }
+        else
+        {
+            ret = WatchSend((uint8_t)ret);
+            if (ret < 0)
+                break;
+            total += (uint32_t)ret;
+        }
+        if (MessagePeek(&span) > pending)
+            break;
+    }
+
+    dropped = WatchStop();
+    if (!csv)
+    {
+        ret = WatchSend(1);
+        total += (ret > 0) ? (uint32_t)ret : 0U;
+        (void)WatchSendMark(WATCH_END, total, dropped);
+    }
+    shellPrint(shell, "%lu samples, %lu dropped\r\n", (unsigned long)total, (unsigned long)dropped);
+    return 0;
 }
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 watch, WatchCmd, sample variables <var...> @ <rate> [csv]);
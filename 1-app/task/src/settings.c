@@ -0,0 +1,335 @@
+/**
+ * @file settings.c
+ * @brief 运行参数模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 参数值保存在RAM影子数组中，修改时记下脏位和修改时间，由启动任务在安静期结束后
+ * 把整张表写成一条KV记录；Flash读入和写入都在settings_lock内进行，读取不加锁
+ */
+
+// ==================== 包含文件 ====================
+#include "settings.h"
+#include "blink.h"
+#include "communication.h"
+#include "flash.h"
+#include "os_lock.h"
+#include "os_static.h"
+#include "selftest.h"
+#include "serialshell.h"
+#include "yDev.h"
+#include "yDev_kv.h"
+#include "yDev_usart.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define SETTINGS_RECORD_WORDS (1U + SETTING_MAX) /**< 记录字数：参数个数加参数值 */
+
+_Static_assert(SETTINGS_RECORD_WORDS * 4U <= YDEV_KV_VALUE_MAX, "settings record exceeds YDEV_KV_VALUE_MAX");
+_Static_assert(SETTING_MAX <= 32, "settings dirty mask is 32 bits");
+
+// ==================== 私有函数声明 ====================
+static void settings_apply_baud(uint32_t value);
+static void settings_apply_flash_timeout(uint32_t value);
+static void settings_apply_flash_idle(uint32_t value);
+static void settings_apply_led(uint32_t value);
+static void settings_apply_buffer(uint32_t value);
+
+// ==================== 私有变量 ====================
+
+/**
+ * @brief 参数表，顺序与SettingId_t一致，只能在表尾追加
+ */
+static const SettingInfo_t settings_info[SETTING_MAX] = {
+    {"uart.baud", 115200, 1200, 4000000},
+    {"flash.timeout", 5000, 10, 60000},
+    {"flash.idle", 1000, 0, 600000},
+    {"led.pattern", BLINK_NORMAL, BLINK_OFF, BLINK_ERROR},
+    {"selftest.boot", SELFTEST_QUICK, 0, SELFTEST_ALL},
+    {"uart.rxbuf", UART_RX_BUF_SIZE, 64, 4096},
+    {"uart.txbuf", UART_TX_BUF_SIZE, 64, 4096},
+    {"shell.buf", SERIAL_SHELL_BUFFER, 128, 2048},
+};
+
+/**
+ * @brief 参数修改后作用到对应模块，在修改参数的任务中调用；NULL表示使用处按需读取
+ */
+static void (*const settings_apply[SETTING_MAX])(uint32_t value) = {
+    settings_apply_baud,
+    settings_apply_flash_timeout,
+    settings_apply_flash_idle,
+    settings_apply_led,
+    NULL,
+    settings_apply_buffer,
+    settings_apply_buffer,
+    settings_apply_buffer,
+};
+
+OS_LOCK_DEFINE(settings_lock);
+
+static volatile uint32_t settings_value[SETTING_MAX]; /**< RAM影子 */
+static uint32_t settings_dirty;                       /**< 尚未写入的参数位图 */
+static uint32_t settings_changed_ms;                  /**< 最后一次修改的时间 */
+static yDevKv_t settings_kv;
+static yDevKvSector_t settings_kv_sector[SETTINGS_KV_SECTORS]; /**< KV扇区信息，不从堆分配 */
+static yDevKvIndex_t settings_kv_index[SETTINGS_KV_KEYS];      /**< KV索引节点，增删键不使用堆 */
+static SettingsStats_t settings_stats;
+
+// ==================== 私有函数 ====================
+
+static void settings_apply_baud(uint32_t value)
+{
+    (void)yDevIoctl(MessageHandle(), YDEV_USART_IOCTL_SET_BAUD, &value);
+}
+
+static void settings_apply_flash_timeout(uint32_t value)
+{
+    FlashGetHandle()->base.timeOutMs = value;
+}
+
+static void settings_apply_flash_idle(uint32_t value)
+{
+    FlashGetHandle()->base.idle_ms = value;
+}
+
+static void settings_apply_led(uint32_t value)
+{
+    (void)BlinkPlay((BlinkPattern_t)value);
+}
+
+static void settings_apply_buffer(uint32_t value)
+{
+    (void)value;
+    ShellTaskResize();
+}
+
+/**
+ * @brief 把整张表写成一条KV记录
+ * @return 0成功，-1失败
+ * @note 调用者持有settings_lock
+ */
+static int32_t settings_flush(void)
+{
+    uint32_t record[SETTINGS_RECORD_WORDS];
+    uint32_t i;
+
+    if (settings_dirty == 0U)
+        return 0;
+    if (!settings_stats.mounted)
+        return -1;
+
+    record[0] = SETTING_MAX;
+    for (i = 0; i < SETTING_MAX; i++)
+        record[1U + i] = settings_value[i];
+
+    if (yDevKvSet(&settings_kv, SETTINGS_KV_KEY, record, (uint16_t)sizeof(record)) != YDEV_OK)
+    {
+        settings_stats.errors++;
+        return -1;
+    }
+
+    settings_dirty = 0;
+    settings_stats.saves++;
+    return 0;
+}
+
+/**
+ * @brief 创建互斥量并填入默认值
+ * @retval 0
+ * @note 以YDEV_INIT_DEVICE级别导出，在应用任务创建之前执行
+ */
+static int32_t SettingsInit(void)
+{
+    uint32_t i;
+
+    OsLockInit(&settings_lock, "settings");
+    for (i = 0; i < SETTING_MAX; i++)
+        settings_value[i] = settings_info[i].def;
+    return 0;
+}
+YDEV_INIT_EXPORT(SettingsInit, YDEV_INIT_DEVICE);
+
+/**
+ * @brief 挂载KV存储，读入保存的参数并作用到各模块
+ * @retval 读入的参数个数，-1 KV存储不可用
+ * @note 以YDEV_INIT_DEFERRED级别导出，首次访问完成25Q探测；
+ *       读入前已在shell中修改过的参数保留修改后的值
+ */
+static int32_t SettingsLoad(void)
+{
+    yDevKvConfig_t config = {NULL, SETTINGS_KV_ADDRESS, SETTINGS_KV_SECTORS, settings_kv_sector, settings_kv_index,
+                             SETTINGS_KV_KEYS};
+    uint32_t record[SETTINGS_RECORD_WORDS];
+    uint32_t count = 0;
+    uint32_t value;
+    uint32_t i;
+    int32_t len;
+
+    config.flash = FlashGetHandle();
+
+    (void)OsLockTake(&settings_lock, portMAX_DELAY);
+    if (yDevKvMount(&settings_kv, &config) != YDEV_OK)
+    {
+        settings_stats.errors++;
+        OsLockGive(&settings_lock);
+        return -1;
+    }
+    settings_stats.mounted = 1;
+
+    len = yDevKvGet(&settings_kv, SETTINGS_KV_KEY, record, (uint16_t)sizeof(record));
+    if (len >= 4)
+    {
+        // 新固件增加的参数不在旧记录中，旧固件读到多出的参数时忽略
+        count = (uint32_t)len / 4U - 1U;
+        if (count > record[0])
+            count = record[0];
+        if (count > SETTING_MAX)
+            count = SETTING_MAX;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        value = record[1U + i];
+        if ((settings_dirty & (1UL << i)) || (value < settings_info[i].min) || (value > settings_info[i].max))
+            continue;
+        settings_value[i] = value;
+        if ((value != settings_info[i].def) && (settings_apply[i] != NULL))
+            settings_apply[i](value);
+    }
+    settings_stats.loaded = count;
+    OsLockGive(&settings_lock);
+
+    return (int32_t)count;
+}
+YDEV_INIT_EXPORT(SettingsLoad, YDEV_INIT_DEFERRED);
+
+// ==================== 公共函数 ====================
+
+uint32_t SettingsGet(SettingId_t id)
+{
+    return ((uint32_t)id < SETTING_MAX) ? settings_value[id] : 0U;
+}
+
+int32_t SettingsSet(SettingId_t id, uint32_t value)
+{
+    if (((uint32_t)id >= SETTING_MAX) || (value < settings_info[id].min) || (value > settings_info[id].max))
+        return -1;
+
+    (void)OsLockTake(&settings_lock, portMAX_DELAY);
+    settings_stats.sets++;
+    if (settings_value[id] != value)
+    {
+        settings_value[id] = value;
+        settings_dirty |= 1UL << id;
+        settings_changed_ms = (uint32_t)yDevGetTimeMS();
+        if (settings_apply[id] != NULL)
+            settings_apply[id](value);
+    }
+    OsLockGive(&settings_lock);
+    return 0;
+}
+
+int32_t SettingsFind(const char *name)
+{
+    uint32_t i;
+
+    for (i = 0; i < SETTING_MAX; i++)
+    {
+        if (strcmp(name, settings_info[i].name) == 0)
+            return (int32_t)i;
+    }
+    return -1;
+}
+
+const SettingInfo_t *SettingsInfo(SettingId_t id)
+{
+    return ((uint32_t)id < SETTING_MAX) ? &settings_info[id] : NULL;
+}
+
+int32_t SettingsSave(void)
+{
+    int32_t ret;
+
+    (void)OsLockTake(&settings_lock, portMAX_DELAY);
+    ret = settings_flush();
+    OsLockGive(&settings_lock);
+    return ret;
+}
+
+void SettingsReset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < SETTING_MAX; i++)
+        (void)SettingsSet((SettingId_t)i, settings_info[i].def);
+}
+
+uint32_t SettingsProcess(void)
+{
+    uint32_t elapsed;
+    uint32_t remain = 0xFFFFFFFFUL;
+
+    (void)OsLockTake(&settings_lock, portMAX_DELAY);
+    if ((settings_dirty != 0U) && settings_stats.mounted)
+    {
+        // 安静期内的修改合并到同一次写入，写入失败时隔一个安静期重试
+        elapsed = (uint32_t)yDevGetTimeMS() - settings_changed_ms;
+        if (elapsed < SETTINGS_SAVE_DELAY_MS)
+        {
+            remain = SETTINGS_SAVE_DELAY_MS - elapsed;
+        }
+        else if (settings_flush() != 0)
+        {
+            settings_changed_ms = (uint32_t)yDevGetTimeMS();
+            remain = SETTINGS_SAVE_DELAY_MS;
+        }
+    }
+    OsLockGive(&settings_lock);
+    return remain;
+}
+
+void SettingsGetStats(SettingsStats_t *stats)
+{
+    (void)OsLockTake(&settings_lock, portMAX_DELAY);
+    *stats = settings_stats;
+    stats->dirty = (settings_dirty != 0U) ? 1U : 0U;
+    OsLockGive(&settings_lock);
+}
+
+int32_t SettingsRecordGet(const char *key, void *data, uint16_t len)
+{
+    int32_t ret = -1;
+
+    if (strcmp(key, SETTINGS_KV_KEY) == 0)
+        return -1;
+
+    (void)OsLockTake(&settings_lock, portMAX_DELAY);
+    if (settings_stats.mounted)
+        ret = yDevKvGet(&settings_kv, key, data, len);
+    OsLockGive(&settings_lock);
+    return (ret >= 0) ? ret : -1;
+}
+
+int32_t SettingsRecordSet(const char *key, const void *data, uint16_t len)
+{
+    int32_t ret = -1;
+
+    if (strcmp(key, SETTINGS_KV_KEY) == 0)
+        return -1;
+
+    (void)OsLockTake(&settings_lock, portMAX_DELAY);
+    if (settings_stats.mounted)
+    {
+        if (yDevKvSet(&settings_kv, key, data, len) == YDEV_OK)
+            ret = 0;
+        else
+            settings_stats.errors++;
+    }
+    OsLockGive(&settings_lock);
+    return ret;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file tracerec.c
+ * @brief 跟踪记录导出模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 导出时按开始时刻的记录条数分段取出，头部中的条数与实际导出一致；
+ * 发送和保存共用同一个分段过程，只是每段的去向不同。段缓冲区第0字节留给Flash中的长度，
+ * 载荷从第1字节开始，保存时不需要再拷贝
+ */
+
+// ==================== 包含文件 ====================
+#include "tracerec.h"
+#include "frame.h"
+#include "yDev_25q.h"
+#include "yLib_trace.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define TRACEREC_SEND_RETRY 50 /**< 发送队列满时的重试次数，每次等待1个滴答 */
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 段输出函数
+ * @param ctx 输出上下文
+ * @param seg 段缓冲区，载荷从seg[1]开始
+ * @param len 载荷长度
+ * @return 0成功，-1失败
+ */
+typedef int32_t (*TraceRecSink_t)(void *ctx, uint8_t *seg, uint16_t len);
+
+/**
+ * @brief Flash输出上下文
+ */
+typedef struct
+{
+    yDevHandle_25q_t *flash; /**< 25Q设备句柄 */
+    uint32_t address;        /**< 下一段写入地址 */
+} TraceRecFlash_t;
+
+// ==================== 私有变量 ====================
+static uint8_t trace_seg[1 + FRAME_PAYLOAD_MAX] __attribute__((aligned(4))); /**< 段缓冲区 */
+static TaskStatus_t trace_tasks[TRACEREC_MAX_TASKS];                          /**< 任务名快照 */
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 小端写入32位数
+ */
+static uint8_t *trace_rec_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/**
+ * @brief 以帧发送一段，发送队列满时等待后重试
+ */
+static int32_t trace_rec_frame_sink(void *ctx, uint8_t *seg, uint16_t len)
+{
+    (void)ctx;
+    return (FrameSendRetry(TRACE_FRAME_ID, seg + 1, len, TRACEREC_SEND_RETRY) >= 0) ? 0 : -1;
+}
+
+/**
+ * @brief 以 长度|载荷 写入Flash
+ */
+static int32_t trace_rec_flash_sink(void *ctx, uint8_t *seg, uint16_t len)
+{
+    TraceRecFlash_t *out = (TraceRecFlash_t *)ctx;
+
+    seg[0] = (uint8_t)len;
+    out->flash->address = out->address;
+    if (yDevWrite(out->flash, seg, (size_t)len + 1U) != (int32_t)len + 1)
+        return -1;
+    out->address += (uint32_t)len + 1U;
+    return 0;
+}
+
+/**
+ * @brief 分段导出
+ * @param sink 段输出函数
+ * @param ctx 输出上下文
+ * @param tasks 任务数，由调用者预先填好trace_tasks
+ * @param total 导出的记录条数
+ * @return 导出的记录条数，失败返回-1
+ */
+static int32_t trace_rec_export(TraceRecSink_t sink, void *ctx, UBaseType_t tasks, uint32_t total)
+{
+    uint8_t *p;
+    uint32_t sent = 0;
+    uint32_t n;
+    size_t name_len;
+    UBaseType_t i;
+
+    p = trace_seg + 1;
+    *p++ = TRACEREC_HEADER;
+    memcpy(p, "YTRC", 4);
+    p += 4;
+    *p++ = TRACEREC_VERSION;
+    *p++ = (uint8_t)sizeof(struct ylib_trace_rec);
+    p = trace_rec_put32(p, ylib_trace_clock_hz());
+    p = trace_rec_put32(p, total);
+    p = trace_rec_put32(p, ylib_trace_dropped());
+    if (sink(ctx, trace_seg, (uint16_t)(p - trace_seg - 1)) != 0)
+        return -1;
+
+    for (i = 0; i < tasks; i++)
+    {
+        p = trace_seg + 1;
+        *p++ = TRACEREC_TASK;
+        p = trace_rec_put32(p, (uint32_t)trace_tasks[i].xTaskNumber);
+        name_len = strnlen(trace_tasks[i].pcTaskName, configMAX_TASK_NAME_LEN);
+        memcpy(p, trace_tasks[i].pcTaskName, name_len);
+        p += name_len;
+        if (sink(ctx, trace_seg, (uint16_t)(p - trace_seg - 1)) != 0)
+            return -1;
+    }
+
+    while (sent < total)
+    {
+        n = total - sent;
+        if (n > TRACEREC_CHUNK_RECORDS)
+            n = TRACEREC_CHUNK_RECORDS;
+        trace_seg[1] = TRACEREC_RECORDS;
+        n = ylib_trace_read((struct ylib_trace_rec *)(void *)(trace_seg + 4), n);
+        if (n == 0)
+            break;
+        // 记录从4字节对齐处读出，再前移到类型字节之后
+        memmove(trace_seg + 2, trace_seg + 4, n * sizeof(struct ylib_trace_rec));
+        if (sink(ctx, trace_seg, (uint16_t)(1U + n * sizeof(struct ylib_trace_rec))) != 0)
+            return -1;
+        sent += n;
+    }
+
+    p = trace_seg + 1;
+    *p++ = TRACEREC_END;
+    p = trace_rec_put32(p, sent);
+    if (sink(ctx, trace_seg, (uint16_t)(p - trace_seg - 1)) != 0)
+        return -1;
+
+    return (int32_t)sent;
+}
+
+/**
+ * @brief 任务名快照
+ * @return 任务数，超过TRACEREC_MAX_TASKS时为0(只导出记录，解码器按编号显示)
+ */
+static UBaseType_t trace_rec_tasks(void)
+{
+    return uxTaskGetSystemState(trace_tasks, TRACEREC_MAX_TASKS, NULL);
+}
+
+// ==================== 公共函数 ====================
+
+int32_t TraceRecSend(void)
+{
+    UBaseType_t tasks = trace_rec_tasks();
+
+    return trace_rec_export(trace_rec_frame_sink, NULL, tasks, ylib_trace_count());
+}
+
+int32_t TraceRecSave(void *flash, uint32_t address)
+{
+    TraceRecFlash_t out;
+    UBaseType_t tasks;
+    uint32_t total;
+    uint32_t size;
+    uint32_t erase;
+
+    if ((flash == NULL) || (address % YDEV_25Q_SECTOR_SIZE))
+        return -1;
+
+    tasks = trace_rec_tasks();
+    total = ylib_trace_count();
+
+    // 头部、任务名、记录块、结束段各带1字节长度
+    size = (1U + 19U) + tasks * (1U + 5U + configMAX_TASK_NAME_LEN) +
+           ((total + TRACEREC_CHUNK_RECORDS - 1U) / TRACEREC_CHUNK_RECORDS) * 2U +
+           total * sizeof(struct ylib_trace_rec) + (1U + 5U);
+    for (erase = address; erase < address + size; erase += YDEV_25Q_SECTOR_SIZE)
+    {
+        if (yDevIoctl(flash, YDEV_25Q_IOCTL_SECTOR_ERASE, &erase) != YDEV_OK)
+            return -1;
+    }
+
+    out.flash = (yDevHandle_25q_t *)flash;
+    out.address = address;
+    return trace_rec_export(trace_rec_flash_sink, &out, tasks, total);
+}
+
+int32_t TraceRecSendFlash(void *flash, uint32_t address)
+{
+    int32_t segs = 0;
+    uint8_t len;
+
+    if ((flash == NULL) || (yDevProbe(flash) != YDEV_OK))
+        return -1;
+
+    for (;;)
+    {
+        if (yDev25qRead((yDevHandle_25q_t *)flash, address, &len, 1) != 1)
+            return -1;
+        // 读到擦除状态(0xFF)或其他越界长度说明数据不完整
+        if ((len == 0) || (len > FRAME_PAYLOAD_MAX))
+            return -1;
+        if (yDev25qRead((yDevHandle_25q_t *)flash, address + 1U, trace_seg + 1, len) != (int32_t)len)
+            return -1;
+        // 第一段必须是头部，否则不是TraceRecSave保存的数据
+        if ((segs == 0) && ((trace_seg[1] != TRACEREC_HEADER) || (memcmp(trace_seg + 2, "YTRC", 4) != 0)))
+            return -1;
+        if (trace_rec_frame_sink(NULL, trace_seg, len) != 0)
+            return -1;
+        segs++;
+        address += (uint32_t)len + 1U;
+        if (trace_seg[1] == TRACEREC_END)
+            return segs;
+    }
+}
@@ -0,0 +1,213 @@
+/**
+ * @file watch.c
+ * @brief 变量定时采样模块实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 定时器回调只做读取和入队，在定时器任务中运行，采样时刻不受发送阻塞影响；
+ * 环形缓冲区只有定时器回调写入、调用任务读取，读写序号各由一方修改，不需要加锁
+ */
+
+// ==================== 包含文件 ====================
+#include "watch.h"
+#include "frame.h"
+#include "os_static.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define WATCH_SEND_RETRY 50 /**< 发送队列满时的重试次数，每次等待1个滴答 */
+#define WATCH_HEADER 6      /**< WATCH_DATA帧头：类型、序号、变量数 */
+
+// ==================== 私有变量 ====================
+OS_TIMER_DEFINE(watch_timer);
+
+static TimerHandle_t watch_timer;                                              /**< 采样定时器 */
+static WatchVar_t watch_vars[WATCH_VARS_MAX];                                  /**< 被采样的变量 */
+static uint32_t watch_count;                                                   /**< 变量数量 */
+static uint32_t watch_capacity;                                                /**< 缓冲区能容纳的样本数 */
+static uint32_t watch_batch;                                                   /**< 满一帧的样本数，达到时通知 */
+static TaskHandle_t watch_task;                                                /**< 取样本的任务 */
+static int32_t watch_ring[WATCH_RING_WORDS];                                   /**< 样本缓冲区 */
+static volatile uint32_t watch_head;                                           /**< 已写入的样本序号 */
+static volatile uint32_t watch_tail;                                           /**< 已取出的样本序号 */
+static volatile uint32_t watch_dropped;                                        /**< 缓冲区满丢弃的样本数 */
+static uint32_t watch_seq;                                                     /**< 下一次采样的序号，丢弃的样本也占序号 */
+static int32_t watch_samples[(FRAME_PAYLOAD_MAX - WATCH_HEADER) / 4];          /**< 一帧的样本 */
+static uint8_t watch_frame[FRAME_PAYLOAD_MAX];                                 /**< 帧载荷缓冲区 */
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 小端写入32位数
+ */
+static uint8_t *watch_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/**
+ * @brief 以帧发送，发送队列满时等待后重试
+ */
+static int32_t watch_send_frame(uint16_t len)
+{
+    return (FrameSendRetry(WATCH_FRAME_ID, watch_frame, len, WATCH_SEND_RETRY) >= 0) ? 0 : -1;
+}
+
+/**
+ * @brief 采样定时器回调
+ * @note 缓冲区满时丢弃新样本并计数，样本够一帧时通知取样本的任务；
+ *       每个样本占变量数 + 1个字，第一个字为序号
+ */
+static void watch_timer_callback(TimerHandle_t timer)
+{
+    const WatchVar_t *var;
+    uint32_t head = watch_head;
+    int32_t *out;
+    uint32_t i;
+
+    (void)timer;
+    if (head - watch_tail >= watch_capacity)
+    {
+        watch_seq++;
+        watch_dropped++;
+        return;
+    }
+
+    out = &watch_ring[(head % watch_capacity) * (watch_count + 1U)];
+    *out++ = (int32_t)watch_seq++;
+    for (i = 0; i < watch_count; i++)
+    {
+        var = &watch_vars[i];
+        if (var->get != NULL)
+            out[i] = var->get((void *)(uintptr_t)var->addr);
+        else if (var->width == 4)
+            out[i] = *(const volatile int32_t *)var->addr;
+        else if (var->width == 2)
+            out[i] = *(const volatile int16_t *)var->addr;
+        else
+            out[i] = *(const volatile int8_t *)var->addr;
+    }
+    watch_head = head + 1U;
+
+    if (watch_head - watch_tail == watch_batch)
+        xTaskNotifyGive(watch_task);
+}
+
+// ==================== 公共函数 ====================
+
+int32_t WatchStart(const WatchVar_t *vars, uint32_t count, uint32_t rate)
+{
+    TickType_t period;
+
+    if ((vars == NULL) || (count == 0) || (count > WATCH_VARS_MAX) || (rate == 0))
+        return -1;
+    if ((watch_timer != NULL) && (xTimerIsTimerActive(watch_timer) != pdFALSE))
+        return -1;
+
+    period = (TickType_t)(configTICK_RATE_HZ / rate);
+    if (period == 0)
+        period = 1;
+
+    memcpy(watch_vars, vars, count * sizeof(WatchVar_t));
+    watch_count = count;
+    watch_capacity = WATCH_RING_WORDS / (count + 1U);
+    watch_batch = WatchFrameSamples();
+    watch_task = xTaskGetCurrentTaskHandle();
+    watch_head = 0;
+    watch_tail = 0;
+    watch_dropped = 0;
+    watch_seq = 0;
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+
+    if (watch_timer == NULL)
+        watch_timer = OS_TIMER_CREATE(watch_timer, "watch", period, pdTRUE, NULL, watch_timer_callback);
+    // 修改周期同时启动定时器
+    if (xTimerChangePeriod(watch_timer, period, portMAX_DELAY) != pdPASS)
+        return -1;
+    return (int32_t)(configTICK_RATE_HZ / period);
+}
+
+uint32_t WatchStop(void)
+{
+    if (watch_timer != NULL)
+        (void)xTimerStop(watch_timer, portMAX_DELAY);
+    return watch_dropped;
+}
+
+uint32_t WatchRead(int32_t *values, uint32_t max, uint32_t *seq)
+{
+    uint32_t tail = watch_tail;
+    uint32_t avail = watch_head - tail;
+    const int32_t *slot;
+    uint32_t n;
+
+    // 遇到序号不连续(中间有丢弃)时停止，一次取出的样本序号总是连续的
+    for (n = 0; (n < avail) && (n < max); n++)
+    {
+        slot = &watch_ring[((tail + n) % watch_capacity) * (watch_count + 1U)];
+        if (n == 0)
+            *seq = (uint32_t)slot[0];
+        else if ((uint32_t)slot[0] != *seq + n)
+            break;
+        memcpy(&values[n * watch_count], &slot[1], watch_count * sizeof(int32_t));
+    }
+    watch_tail = tail + n;
+    return n;
+}
+
+uint32_t WatchFrameSamples(void)
+{
+    uint32_t n = (FRAME_PAYLOAD_MAX - WATCH_HEADER) / (watch_count * sizeof(int32_t));
+
+    return (n < watch_capacity) ? n : watch_capacity;
+}
+
+int32_t WatchSend(uint8_t all)
+{
+    uint32_t per_frame = WatchFrameSamples();
+    uint32_t sent = 0;
+    uint32_t seq;
+    uint32_t n;
+
+    while ((watch_head - watch_tail >= per_frame) || (all && (watch_head != watch_tail)))
+    {
+        n = WatchRead(watch_samples, per_frame, &seq);
+        // 样本在帧中不按字对齐，逐字节拷贝
+        memcpy(&watch_frame[WATCH_HEADER], watch_samples, n * watch_count * sizeof(int32_t));
+        watch_frame[0] = WATCH_DATA;
+        watch_put32(&watch_frame[1], seq);
+        watch_frame[5] = (uint8_t)watch_count;
+        if (watch_send_frame((uint16_t)(WATCH_HEADER + n * watch_count * sizeof(int32_t))) != 0)
+            return -1;
+        sent += n;
+    }
+    return (int32_t)sent;
+}
+
+int32_t WatchSendMark(WatchType_t type, uint32_t a, uint32_t b)
+{
+    uint16_t len;
+
+    watch_frame[0] = (uint8_t)type;
+    watch_put32(&watch_frame[1], a);
+    if (type == WATCH_START)
+    {
+        watch_frame[5] = (uint8_t)b;
+        len = 6;
+    }
+    else
+    {
+        watch_put32(&watch_frame[5], b);
+        len = 9;
+    }
+    return watch_send_frame(len);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file watchdog.c
+ * @brief 看门狗服务实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 登记表为静态数组，报到只写时间戳；监视在定时器任务中执行，
+ * 定时器任务优先级最高，应用任务忙循环不会让监视本身超期；
+ * 中断运行模式(OS_IRQ_RUN_ENABLE)没有定时器任务，监视改为定时轮上的周期定时器
+ */
+
+// ==================== 包含文件 ====================
+#include "watchdog.h"
+#include "os_static.h"
+#include "yDev.h"
+#include "yDrv_fault.h"
+#include "yDrv_wdg.h"
+#include "yLib_log.h"
+#include "yLib_timer.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+_Static_assert((WATCHDOG_IWDG_MS == 0) || (WATCHDOG_IWDG_MS > 2 * WATCHDOG_PERIOD_MS),
+               "IWDG timeout must cover at least two supervisor periods");
+
+// ==================== 私有类型定义 ====================
+
+typedef struct
+{
+    const char *name;
+    uint32_t deadline_ms;
+    volatile uint32_t last_ms;
+    volatile uint32_t checkins;
+    uint32_t worst_ms;
+    volatile uint8_t active;
+    volatile uint8_t suspended;
+} WatchdogSlot_t;
+
+// ==================== 私有变量 ====================
+
+#if OS_IRQ_RUN_ENABLE
+static struct ylib_timer watchdog_timer; /* 中断运行模式没有定时器任务，挂在定时轮上 */
+#else
+OS_TIMER_DEFINE(watchdog_timer);
+#endif
+
+static WatchdogSlot_t watchdog_slot[WATCHDOG_TASKS_MAX];
+static WatchdogStats_t watchdog_stats;
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 监视回调，所有任务按时报到才喂狗
+ */
+static void watchdog_check(void *arg)
+{
+    WatchdogSlot_t *slot;
+    uint32_t last;
+    uint32_t elapsed;
+    uint32_t i;
+
+    (void)arg;
+    watchdog_stats.checks++;
+
+    for (i = 0; i < WATCHDOG_TASKS_MAX; i++)
+    {
+        slot = &watchdog_slot[i];
+        if (!slot->active || slot->suspended)
+            continue;
+
+        // 先取报到时间再取当前时间，中间被中断报到也不会得到负的间隔
+        last = slot->last_ms;
+        elapsed = (uint32_t)yDevGetTimeMS() - last;
+        if (elapsed > slot->worst_ms)
+            slot->worst_ms = elapsed;
+        if (elapsed > slot->deadline_ms)
+            yDrvFaultLog(YDRV_FAULT_WATCHDOG, elapsed, slot->name);
+    }
+
+#if WATCHDOG_IWDG_MS
+    yDrvIwdgKick();
+    watchdog_stats.kicks++;
+#endif
+}
+
+#if !OS_IRQ_RUN_ENABLE
+/**
+ * @brief 监视定时器回调
+ */
+static void watchdog_timer_callback(TimerHandle_t timer)
+{
+    watchdog_check(timer);
+}
+#endif
+
+/**
+ * @brief 启动监视定时器和IWDG
+ * @retval 0成功，-1 IWDG未能启动
+ * @note 以YDEV_INIT_DEVICE级别导出，在应用任务创建之前执行；
+ *       之后的慢速初始化只要定时器任务在运行就不会触发IWDG
+ */
+static int32_t WatchdogInit(void)
+{
+#if OS_IRQ_RUN_ENABLE
+    watchdog_stats.iwdg_reset = yDrvIwdgWasReset();
+    if (watchdog_stats.iwdg_reset)
+        YLIB_LOGE("reset by IWDG, timer wheel stalled");
+
+    ylib_timer_init(&watchdog_timer, watchdog_check, NULL);
+    ylib_timer_start(&watchdog_timer, WATCHDOG_PERIOD_MS, WATCHDOG_PERIOD_MS);
+#else
+    TimerHandle_t timer;
+
+    watchdog_stats.iwdg_reset = yDrvIwdgWasReset();
+    if (watchdog_stats.iwdg_reset)
+        YLIB_LOGE("reset by IWDG, timer task stalled");
+
+    timer = OS_TIMER_CREATE(watchdog_timer, "wdg", pdMS_TO_TICKS(WATCHDOG_PERIOD_MS), pdTRUE, NULL,
+                            watchdog_timer_callback);
+    (void)xTimerStart(timer, 0);
+#endif
+
+#if WATCHDOG_IWDG_MS
+    if (yDrvIwdgStart(WATCHDOG_IWDG_MS) != YDRV_OK)
+        return -1;
+    watchdog_stats.iwdg_ms = WATCHDOG_IWDG_MS;
+#endif
+    return 0;
+}
+YDEV_INIT_EXPORT(WatchdogInit, YDEV_INIT_DEVICE);
+
+// ==================== 公共函数 ====================
+
+int32_t WatchdogRegister(const char *name, uint32_t deadline_ms)
+{
+    int32_t id = -1;
+    uint32_t i;
+
+    if (deadline_ms <= WATCHDOG_PERIOD_MS)
+        return -1;
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < WATCHDOG_TASKS_MAX; i++)
+    {
+        if (!watchdog_slot[i].active)
+        {
+            watchdog_slot[i].name = name;
+            watchdog_slot[i].deadline_ms = deadline_ms;
+            watchdog_slot[i].last_ms = (uint32_t)yDevGetTimeMS();
+            watchdog_slot[i].checkins = 0;
+            watchdog_slot[i].worst_ms = 0;
+            watchdog_slot[i].suspended = 0;
+            watchdog_slot[i].active = 1;
+            id = (int32_t)i;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+    return id;
+}
+
+void WatchdogCheckin(int32_t id)
+{
+    if ((uint32_t)id >= WATCHDOG_TASKS_MAX)
+        return;
+    watchdog_slot[id].last_ms = (uint32_t)yDevGetTimeMS();
+    watchdog_slot[id].checkins++;
+}
+
+void WatchdogSuspend(int32_t id, uint8_t suspend)
+{
+    if ((uint32_t)id >= WATCHDOG_TASKS_MAX)
+        return;
+    if (!suspend)
+        watchdog_slot[id].last_ms = (uint32_t)yDevGetTimeMS();
+    watchdog_slot[id].suspended = suspend ? 1U : 0U;
+}
+
+int32_t WatchdogGetInfo(int32_t id, WatchdogInfo_t *info)
+{
+    WatchdogSlot_t *slot;
+    uint32_t last;
+
+    if (((uint32_t)id >= WATCHDOG_TASKS_MAX) || !watchdog_slot[id].active)
+        return -1;
+
+    slot = &watchdog_slot[id];
+    last = slot->last_ms;
+    info->name = slot->name;
+    info->deadline_ms = slot->deadline_ms;
+    info->age_ms = (uint32_t)yDevGetTimeMS() - last;
+    info->worst_ms = slot->worst_ms;
+    info->checkins = slot->checkins;
+    info->suspended = slot->suspended;
+    return 0;
+}
+
+void WatchdogGetStats(WatchdogStats_t *stats)
+{
+    *stats = watchdog_stats;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file bench_items.c
+ * @brief 基准测试固件的测试项
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 以YLIB_BENCH登记yLib数据结构、内存操作和驱动路径的测试项，由bench_main.c逐项运行；
+ * 名称与1-app中shell的bench命令相同的项测量同一段代码，两边的结果可以直接对比
+ *
+ * @par 使用约束:
+ * 测试体在关中断时运行，不能调用RTOS接口；需要设备的项在准备函数中查找设备，未找到时测试体为空
+ */
+// ==================== 包含文件 ====================
+#include <stdint.h>
+#include "yDev.h"
+#include "yDev_gpio.h"
+#include "yDrv_gpio.h"
+#include "yLib_bench.h"
+#include "yLib_bitmap.h"
+#include "yLib_crc.h"
+#include "yLib_heap.h"
+#include "yLib_memops.h"
+#include "yLib_rbtree.h"
+#include "yLib_ring.h"
+#include "board.h"
+
+// ==================== 私有宏定义 ====================
+#define BENCH_TREE_NODES 31U    /**< rbtree测试中树的节点数，插入删除的是第32个 */
+#define BENCH_BITMAP_BITS 256U  /**< bitmap测试的位数 */
+
+// ==================== 私有类型 ====================
+
+/**
+ * @brief rbtree测试节点
+ */
+typedef struct
+{
+    struct ylib_rb_node node; /*!< 树节点 */
+    uint32_t key;             /*!< 键 */
+} BenchTreeNode_t;
+
+// ==================== 私有变量 ====================
+
+static uint32_t bench_ring_buffer[8];                           /**< ring测试的队列存储 */
+static struct ylib_ring bench_ring;                             /**< ring测试的队列 */
+static uint8_t bench_mem[256];                                  /**< 内存操作测试的缓冲区 */
+static BenchTreeNode_t bench_tree_nodes[BENCH_TREE_NODES + 1U]; /**< rbtree测试节点，最后一个反复插入删除 */
+static struct ylib_rb_root bench_tree;                          /**< rbtree测试的树 */
+static uint32_t bench_bitmap[BENCH_BITMAP_BITS / 32U];          /**< bitmap测试的位图 */
+static void *bench_key;                                         /**< gpio和dispatch测试的设备，未找到时为NULL */
+static volatile uint32_t bench_sink;                            /**< 测试结果写到这里，防止被优化掉 */
+
+/**
+ * @brief 按键设备配置
+ * @note 与1-app的key0相同的引脚和模式，供gpio和dispatch测试读取
+ */
+static yDevConfig_Gpio_t bench_key_config = {
+    .base = {
+        .type = YDEV_TYPE_GPIO,
+        .name = BOARD_KEY0_NAME,
+    },
+    .drv_config = {
+        .pin = BOARD_KEY0_IN_PIN,
+        .mode = YDRV_GPIO_MODE_INPUT,
+        .pupd = YDRV_GPIO_PUPD_PULLUP,
+        .speed = YDRV_GPIO_SPEED_LEVEL3,
+    },
+};
+
+static yDevHandle_Gpio_t bench_key_handle; /**< 按键设备句柄 */
+
+// ==================== 设备登记 ====================
+
+/**
+ * @brief 登记按键设备
+ * @retval 0 成功，-1 失败
+ */
+static int32_t BenchKeyInit(void)
+{
+    return (yDevInitStatic(&bench_key_config, &bench_key_handle) == YDEV_OK) ? 0 : -1;
+}
+YDEV_INIT_EXPORT(BenchKeyInit, YDEV_INIT_DEVICE);
+
+// ==================== yLib测试项 ====================
+
+static void bench_ring_setup(void)
+{
+    (void)ylib_ring_init(&bench_ring, bench_ring_buffer, sizeof(bench_ring_buffer) / sizeof(bench_ring_buffer[0]));
+}
+
+/**
+ * @brief 环形队列一次入队加出队
+ */
+YLIB_BENCH_SETUP(ring, bench_ring_setup)
+{
+    uint32_t value = bench_sink;
+
+    (void)ylib_ring_enqueue(&bench_ring, &value, sizeof(value));
+    (void)ylib_ring_dequeue(&bench_ring, &value, sizeof(value));
+    bench_sink = value;
+}
+
+#if !YLIB_NO_HEAP_AFTER_INIT
+/**
+ * @brief 堆分配再释放32字节
+ */
+YLIB_BENCH(heap)
+{
+    void *ptr = ylib_malloc(32);
+
+    ylib_free(ptr);
+    bench_sink = (uint32_t)ptr;
+}
+#endif
+
+/**
+ * @brief 对齐拷贝64字节
+ */
+YLIB_BENCH(memcpy64)
+{
+    (void)ylib_memcpy(&bench_mem[128], bench_mem, 64);
+}
+
+/**
+ * @brief 对齐填充64字节
+ */
+YLIB_BENCH(memset64)
+{
+    (void)ylib_memset(&bench_mem[128], (int)(bench_sink & 0xFF), 64);
+}
+
+/**
+ * @brief 64字节CRC-16，经注册的后端计算
+ */
+YLIB_BENCH(crc16)
+{
+    bench_sink = ylib_crc16(YLIB_CRC16_INIT, bench_mem, 64);
+}
+
+/**
+ * @brief 按键插入rbtree
+ * @param entry 新节点
+ */
+static void bench_tree_insert(BenchTreeNode_t *entry)
+{
+    struct ylib_rb_node **link = &bench_tree.rb_node;
+    struct ylib_rb_node *parent = NULL;
+    BenchTreeNode_t *cur;
+
+    while (*link != NULL)
+    {
+        parent = *link;
+        cur = ylib_rb_entry(parent, BenchTreeNode_t, node);
+        link = (entry->key < cur->key) ? &parent->rb_left : &parent->rb_right;
+    }
+    ylib_rb_link_node(&entry->node, parent, link);
+    ylib_rb_insert_color(&entry->node, &bench_tree);
+}
+
+/**
+ * @brief 建立BENCH_TREE_NODES个节点的树，键为偶数，测试节点的键为奇数落在中间
+ */
+static void bench_tree_setup(void)
+{
+    uint32_t i;
+
+    bench_tree = YLIB_RB_ROOT;
+    for (i = 0; i < BENCH_TREE_NODES; i++)
+    {
+        bench_tree_nodes[i].key = i * 2U;
+        bench_tree_insert(&bench_tree_nodes[i]);
+    }
+    bench_tree_nodes[BENCH_TREE_NODES].key = BENCH_TREE_NODES;
+}
+
+/**
+ * @brief 在31个节点的树中插入再删除一个节点
+ */
+YLIB_BENCH_SETUP(rbtree, bench_tree_setup)
+{
+    bench_tree_insert(&bench_tree_nodes[BENCH_TREE_NODES]);
+    ylib_rb_erase(&bench_tree_nodes[BENCH_TREE_NODES].node, &bench_tree);
+}
+
+/**
+ * @brief 前255位置位，只有最后一位为0
+ */
+static void bench_bitmap_setup(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < BENCH_BITMAP_BITS / 32U; i++)
+    {
+        bench_bitmap[i] = 0xFFFFFFFFU;
+    }
+    bench_bitmap[BENCH_BITMAP_BITS / 32U - 1U] = 0x7FFFFFFFU;
+}
+
+/**
+ * @brief 在256位中查找唯一的0位，最坏情况的线性扫描
+ */
+YLIB_BENCH_SETUP(bitmap, bench_bitmap_setup)
+{
+    bench_sink = ylib_bitmap_find_first_zero(bench_bitmap, BENCH_BITMAP_BITS);
+}
+
+// ==================== 驱动路径测试项 ====================
+
+static void bench_key_setup(void)
+{
+    bench_key = yDevFind(BOARD_KEY0_NAME);
+}
+
+/**
+ * @brief 直接经yDrv读一次GPIO
+ */
+YLIB_BENCH_SETUP(gpio, bench_key_setup)
+{
+    if (bench_key != NULL)
+    {
+        bench_sink = (uint32_t)yDrvGpioRead(&bench_key_handle.drv_handle);
+    }
+}
+
+/**
+ * @brief 经yDev接口读一次GPIO，与gpio项的差即设备分发开销
+ */
+YLIB_BENCH_SETUP(dispatch, bench_key_setup)
+{
+    uint32_t value;
+
+    if ((bench_key != NULL) && (yDevRead(bench_key, &value, sizeof(value)) > 0))
+    {
+        bench_sink = value;
+    }
+}
+
+/**
+ * @brief 让EXTI4_15挂起后开中断，测量中断进入、分发和返回
+ * @note 没有挂起的EXTI线时分发函数直接返回
+ */
+static void bench_exti_setup(void)
+{
+    NVIC_EnableIRQ(EXTI4_15_IRQn);
+}
+
+YLIB_BENCH_SETUP(exti, bench_exti_setup)
+{
+    NVIC_SetPendingIRQ(EXTI4_15_IRQn);
+    __enable_irq();
+    __ISB();
+    __disable_irq();
+}
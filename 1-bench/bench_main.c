@@ -0,0 +1,225 @@
+/**
+ * @file bench_main.c
+ * @brief 基准测试固件入口
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * ylab_bench固件用这里的最小运行器代替1-app：只创建一个测试任务，
+ * 反复运行全部YLIB_BENCH测试项，结果以PERF帧从串口发出，由tools/perf_check.py --listen接收
+ *
+ * @par 运行环境:
+ * - 不创建闪烁、shell、日志等应用任务，测试任务之外只有空闲任务和定时器任务
+ * - 只执行YDEV_INIT_DEVICE级别(切换到运行时钟、登记设备)，不执行后台初始化
+ * - 每个样本在ylib_bench_run中关中断测量，两轮之间串口发送和SysTick不影响结果
+ * - 串口不用DMA和发送队列，逐字节查询发送，发送期间不产生串口中断
+ *
+ * @par 输出格式:
+ * 帧格式与frame.c相同(0x00分隔、COBS编码、CRC-16/CCITT-FALSE)，帧号和负载与perfsuite一致：
+ * 每项一帧PERF_KIND_CYCLES，名称为bench.<测试名>，值为中位数；每轮最后一帧PERF_KIND_END，
+ * 名称为主频，值为本轮结果数
+ */
+// ==================== 包含文件 ====================
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "os_static.h"
+#include "yDev.h"
+#include "yDev_usart.h"
+#include "yDrv_fault.h"
+#include "yLib_bench.h"
+#include "yLib_crc.h"
+#include "board.h"
+
+// ==================== 私有宏定义 ====================
+#define BENCH_TASK_PRIO 2        /**< 测试任务优先级，高于空闲任务即可 */
+#define BENCH_STK_SIZE 512       /**< 测试任务堆栈大小(字) */
+#define BENCH_BAUD 115200U       /**< 结果串口波特率，与1-app的shell串口相同 */
+#define BENCH_PERIOD_MS 1000U    /**< 两轮之间的间隔，上位机随时连接都能在一轮内收到完整结果 */
+#define BENCH_TX_TIMEOUT_MS 100U /**< 单帧发送超时 */
+
+#define BENCH_PERF_FRAME_ID 0x50U   /**< 与serialshell.h的PERF_FRAME_ID相同 */
+#define BENCH_PERF_KIND_CYCLES 0U   /**< 与PERF_KIND_CYCLES相同 */
+#define BENCH_PERF_KIND_END 0xFFU   /**< 与PERF_KIND_END相同 */
+#define BENCH_PERF_NAME_MAX 24U     /**< 与PERF_NAME_MAX相同 */
+
+/**
+ * @brief 编码后的最大帧长
+ * @note 分隔符2 + 帧号1 + 负载5+名称 + CRC2，加COBS编码字节1，负载短于254字节
+ */
+#define BENCH_FRAME_MAX (2U + 1U + 5U + BENCH_PERF_NAME_MAX + 2U + 1U)
+
+// ==================== 私有变量 ====================
+
+OS_TASK_DEFINE(bench_task, BENCH_STK_SIZE); /**< 测试任务堆栈和TCB */
+
+/**
+ * @brief 结果串口配置
+ * @note 与1-app的shell串口同一外设和引脚，不配置DMA和流控
+ */
+static yDevConfig_Usart_t bench_usart_config =
+    {
+        .base = {
+            .type = YDEV_TYPE_USART,           /*!< 设备类型：USART */
+            .name = BOARD_UART3_NAME,          /*!< 注册名 */
+            .timeOutMs = BENCH_TX_TIMEOUT_MS,  /*!< 查询发送超时 */
+        },
+        .drv_config = {
+            .usartId = BOARD_UART3_PERIPH,        /*!< USART编号 */
+            .txPin = BOARD_UART3_TX_PIN,          /*!< 发送引脚 */
+            .rxPin = BOARD_UART3_RX_PIN,          /*!< 接收引脚 */
+            .txAF = BOARD_UART3_TX_AF,            /*!< 发送引脚复用功能 */
+            .rxAF = BOARD_UART3_RX_AF,            /*!< 接收引脚复用功能 */
+            .rtsPin = YDRV_PINNULL,               /*!< RTS引脚：未使用 */
+            .ctsPin = YDRV_PINNULL,               /*!< CTS引脚：未使用 */
+            .flowControl = YDRV_USART_FLOW_NONE,  /*!< 流控：无 */
+            .baudRate = BENCH_BAUD,               /*!< 波特率 */
+            .dataBits = YDRV_USART_DATA_8BIT,     /*!< 数据位：8位 */
+            .stopBits = YDRV_USART_STOP_1BIT,     /*!< 停止位：1位 */
+            .parity = YDRV_USART_PARITY_NONE,     /*!< 校验位：无 */
+            .direction = YDRV_USART_DIR_TX_RX,    /*!< 方向：收发双向 */
+            .mode = YDRV_USART_MODE_ASYNCHRONOUS, /*!< 模式：异步 */
+        },
+};
+
+static yDevHandle_Usart_t bench_usart;        /**< 结果串口句柄 */
+static uint8_t bench_frame[BENCH_FRAME_MAX]; /**< 帧编码缓冲区 */
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 编码并发送一帧PERF结果
+ * @param kind BENCH_PERF_KIND_xxx
+ * @param name 名称，超过BENCH_PERF_NAME_MAX的部分截掉
+ * @param value 数值
+ * @note COBS编码与frame.c的prv_EncodePut相同，帧短于254字节，不会出现满块
+ */
+static void BenchReport(uint8_t kind, const char *name, uint32_t value)
+{
+    uint8_t body[1U + 5U + BENCH_PERF_NAME_MAX + 2U];
+    uint32_t len = strlen(name);
+    uint32_t code_pos;
+    uint32_t out;
+    uint8_t code;
+    uint16_t crc;
+    uint32_t i;
+
+    if (len > BENCH_PERF_NAME_MAX)
+    {
+        len = BENCH_PERF_NAME_MAX;
+    }
+    body[0] = BENCH_PERF_FRAME_ID;
+    body[1] = kind;
+    body[2] = (uint8_t)value;
+    body[3] = (uint8_t)(value >> 8);
+    body[4] = (uint8_t)(value >> 16);
+    body[5] = (uint8_t)(value >> 24);
+    memcpy(&body[6], name, len);
+    len += 6U;
+    crc = ylib_crc16(YLIB_CRC16_INIT, body, len);
+    body[len++] = (uint8_t)(crc & 0xFF);
+    body[len++] = (uint8_t)(crc >> 8);
+
+    // 帧头分隔符，接收端从这里同步
+    bench_frame[0] = 0;
+    code_pos = 1;
+    out = 2;
+    code = 1;
+    for (i = 0; i < len; i++)
+    {
+        if (body[i] != 0)
+        {
+            bench_frame[out++] = body[i];
+            code++;
+            continue;
+        }
+        bench_frame[code_pos] = code;
+        code_pos = out++;
+        code = 1;
+    }
+    bench_frame[code_pos] = code;
+    bench_frame[out++] = 0;
+
+    (void)yDevWrite(&bench_usart, bench_frame, out);
+}
+
+/**
+ * @brief 运行一轮全部测试项
+ * @retval uint32_t 成功的测试项数
+ */
+static uint32_t BenchRound(void)
+{
+    const struct ylib_bench *bench;
+    struct ylib_bench_result result;
+    char label[BENCH_PERF_NAME_MAX + 1U];
+    uint32_t count = 0;
+    unsigned int index;
+
+    for (index = 0; (bench = ylib_bench_iterate(index)) != NULL; index++)
+    {
+        if (ylib_bench_run(bench, 0, &result) != 0)
+        {
+            continue;
+        }
+        snprintf(label, sizeof(label), "bench.%s", bench->name);
+        BenchReport(BENCH_PERF_KIND_CYCLES, label, result.median);
+        count++;
+    }
+
+    snprintf(label, sizeof(label), "%luMHz", (unsigned long)(SystemCoreClock / 1000000U));
+    BenchReport(BENCH_PERF_KIND_END, label, count);
+
+    return count;
+}
+
+/**
+ * @brief 测试任务
+ * @param pvParameters 任务参数（未使用）
+ *
+ * @par 功能描述:
+ * 完成设备级初始化后按BENCH_PERIOD_MS周期反复运行全部测试项；
+ * 结果串口初始化失败时仍然运行，便于用调试器查看
+ */
+static void BenchTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    // 切换到运行时钟、登记设备，测试项的准备函数在此之后才能找到设备
+    (void)yDevInitRun(YDEV_INIT_DEVICE);
+    (void)yDevInitStatic(&bench_usart_config, &bench_usart);
+
+    for (;;)
+    {
+        (void)BenchRound();
+        vTaskDelay(pdMS_TO_TICKS(BENCH_PERIOD_MS));
+    }
+}
+
+/**
+ * @brief 任务堆栈溢出回调
+ * @param xTask 溢出的任务
+ * @param pcTaskName 任务名
+ * @note 记录故障后复位
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    yDrvFaultLog(YDRV_FAULT_STACK_OVERFLOW, (uint32_t)xTask, pcTaskName);
+}
+
+/**
+ * @brief 程序主入口函数
+ * @return int 返回值（正常情况下不会返回）
+ */
+int main(void)
+{
+    // 系统底层初始化
+    yLabInit();
+
+    (void)OS_TASK_CREATE(bench_task, BenchTask, "Bench", NULL, BENCH_TASK_PRIO);
+    vTaskStartScheduler();
+
+    // 正常情况下不会执行到这里
+    return 0;
+}
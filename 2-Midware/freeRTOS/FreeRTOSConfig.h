@@ -36,7 +36,7 @@
  * - 硬件平台：STM32G0 系列 (Cortex-M0+)
  * - 内核版本：FreeRTOS V11.1.0
  * - 调度算法：抢占式调度
- * - 堆管理：动态内存分配 (heap_4.c)
+ * - 堆管理：动态内存分配 (heap_ylib.c，与yLib共用链接脚本划出的堆区)
  * - 系统节拍：1000Hz (1ms)
  *
  * 更多信息请参考：
@@ -53,6 +53,7 @@
 /* 硬件描述相关定义 *********************************************************/
 /******************************************************************************/
 extern uint32_t SystemCoreClock;
+extern uint32_t yDrvGetTimeUs(void);
 
 /* CPU时钟频率配置 (configCPU_CLOCK_HZ)
  * 在大多数情况下，configCPU_CLOCK_HZ 必须设置为驱动内核周期性滴答中断的
@@ -118,10 +119,26 @@ extern uint32_t SystemCoreClock;
 /* 低功耗无滴答模式 (configUSE_TICKLESS_IDLE)
  * 设置为 1：使用低功耗无滴答模式，在空闲时停止滴答中断以节省功耗
  * 设置为 0：滴答中断始终运行
- * 注意：并非所有 FreeRTOS 移植都支持无滴答模式
+ * 注意：并非所有 FreeRTOS 移植都支持无滴答模式；STOP 期间调试器会断开连接
  * 参考：https://www.freertos.org/low-power-tickless-rtos.html
  */
-#define configUSE_TICKLESS_IDLE 0
+#define configUSE_TICKLESS_IDLE 1
+
+/* 进入低功耗前的最短空闲时间 (configEXPECTED_IDLE_TIME_BEFORE_SLEEP)
+ * 无滴答空闲的实现见 yDev.c 的 vPortSuppressTicksAndSleep：SysTick 停止，RTC 唤醒定时器
+ * (LSI) 定时唤醒 STOP1；唤醒后 HSE 起振和 PLL 锁定需要约 1~2ms，空闲时间太短时不值得进入
+ */
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 5
+
+/* 中断运行模式 (OS_IRQ_RUN_ENABLE，os_irqrun.h)
+ * 设置为 1：不启动调度器，工作队列和定时轮改由一个最低优先级的软件中断执行，
+ *          SCR.SLEEPONEXIT 使内核在中断之间留在 Sleep，不回到线程模式
+ * 设置为 0：工作队列和定时轮由 work_ylib.c/timer_ylib.c 的任务驱动
+ * 注意：开启后依赖任务的模块(shell、busjob、yDev阻塞接口等)不可用，应用只用异步接口和工作项
+ */
+#ifndef OS_IRQ_RUN_ENABLE
+#define OS_IRQ_RUN_ENABLE 0
+#endif
 
 /* 最大任务优先级数量 (configMAX_PRIORITIES)
  * 设置可用任务优先级的数量。任务可分配的优先级范围为 0 到 (configMAX_PRIORITIES - 1)
@@ -179,8 +196,11 @@ extern uint32_t SystemCoreClock;
  * configTASK_NOTIFICATION_ARRAY_ENTRIES 设置数组中的索引数量。
  * 参考：https://www.freertos.org/RTOS-task-notifications.html
  * 默认值为 1（如果未定义）
+ * 索引0用于驱动传输完成等一般唤醒，索引1用于总线作业调度(YDEV_BUSJOB_NOTIFY_INDEX)，
+ * 索引2用于事件标志(os_event.h的OS_EVENT_NOTIFY_INDEX)，索引3用于驱动等待队列(YDEV_WAITQ_NOTIFY_INDEX)，
+ * 索引4用于串口发送队列等待空间(YDEV_USART_TX_NOTIFY_INDEX)
  */
-#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 5
 
 /* 队列注册表大小 (configQUEUE_REGISTRY_SIZE)
  * 设置可从队列注册表引用的队列和信号量的最大数量。
@@ -200,8 +220,21 @@ extern uint32_t SystemCoreClock;
  * configNUM_THREAD_LOCAL_STORAGE_POINTERS 设置数组中的索引数量。
  * 参考：https://www.freertos.org/thread-local-storage-pointers.html
  * 默认值为 0（如果未定义）
+ * 当前设置：索引0保存任务的yLib线性分配器(YLIB_ARENA_TLS_INDEX)，
+ * 索引1保存任务正在处理的请求延迟上下文(LATENCY_TLS_INDEX)，
+ * 开启OS_MPU_ENABLE时索引2保存任务的MPU区域组(OS_MPU_TLS_INDEX)
  */
-#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 0
+#ifndef OS_MPU_ENABLE
+#define OS_MPU_ENABLE 0 // 按任务切换的MPU区域(os_mpu.h)：堆栈保护、DMA缓冲区和外设窗口
+#endif
+#define LATENCY_TLS_INDEX 1
+#define OS_MPU_TLS_INDEX 2
+
+#if OS_MPU_ENABLE
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 3
+#else
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 2
+#endif
 
 /* 迷你列表项使用配置 (configUSE_MINI_LIST_ITEM)
  * 当 configUSE_MINI_LIST_ITEM 设置为 0 时，MiniListItem_t 和 ListItem_t 是相同的。
@@ -336,6 +369,7 @@ extern uint32_t SystemCoreClock;
  * 注意：堆将出现在 .bss 段中
  * 当前设置：80KB (80 * 1024 = 81920 字节)
  * 参考：https://www.freertos.org/a00111.html
+ * 注意：当前使用heap_ylib.c，堆大小由链接脚本中.bss之后剩余的RAM决定，此值不再生效
  */
 #define configTOTAL_HEAP_SIZE ((size_t)(10 * 1024))
 
@@ -415,7 +449,7 @@ extern uint32_t SystemCoreClock;
  * 应用程序编写者负责为任何设置为 1 的钩子提供钩子函数。
  * 参考：https://www.freertos.org/a00016.html
  */
-#define configUSE_IDLE_HOOK 0                // 空闲任务钩子
+#define configUSE_IDLE_HOOK 1                // 空闲任务钩子，heap_ylib.c中巡检堆和内存分区
 #define configUSE_TICK_HOOK 0                // 滴答中断钩子
 #define configUSE_MALLOC_FAILED_HOOK 0       // 内存分配失败钩子
 #define configUSE_DAEMON_TASK_STARTUP_HOOK 0 // 守护任务启动钩子
@@ -444,8 +478,10 @@ extern uint32_t SystemCoreClock;
  * 当 configCHECK_FOR_STACK_OVERFLOW 设置为 1 时，应用程序编写者必须提供堆栈溢出回调。
  * 参考：https://www.freertos.org/Stacks-and-stack-overflow-checking.html
  * 默认值为 0（如果未定义）
+ * 当前配置：方法2，任务创建时整个堆栈填充0xA5，切换时检查堆栈末端16字节；
+ * 溢出回调vApplicationStackOverflowHook(main.c)记录故障后复位
  */
-#define configCHECK_FOR_STACK_OVERFLOW 0
+#define configCHECK_FOR_STACK_OVERFLOW 2
 
 /******************************************************************************/
 /* 运行时和任务统计收集相关定义 *********************************************/
@@ -457,15 +493,20 @@ extern uint32_t SystemCoreClock;
  * 如果设置为 1，应用程序编写者需要提供时钟源
  * 默认值为 0（如果未定义）
  * 参考：https://www.freertos.org/rtos-run-time-stats.html
+ *
+ * 时钟源为 TIM17 的 1MHz 微秒时间戳，yDrvInit 中已启动，不需要额外配置；
+ * 32 位计数约 71.6 分钟回绕，按两次采样的差值计算占用率(shell 的 top 命令)时不受影响
  */
-#define configGENERATE_RUN_TIME_STATS 0
+#define configGENERATE_RUN_TIME_STATS 1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE() yDrvGetTimeUs()
 
 /* 跟踪设施使能配置 (configUSE_TRACE_FACILITY)
  * 设置为 1：包含跟踪和可视化函数及工具使用的额外任务结构成员
  * 设置为 0：从结构中排除额外信息
  * 默认值为 0（如果未定义）
  */
-#define configUSE_TRACE_FACILITY 0
+#define configUSE_TRACE_FACILITY 1
 
 /* 统计格式化函数使能 (configUSE_STATS_FORMATTING_FUNCTIONS)
  * 设置为 1：在构建中包含 vTaskList() 和 vTaskGetRunTimeStats() 函数
@@ -512,14 +553,16 @@ extern uint32_t SystemCoreClock;
  *   （例如，"vAssertCalled( __FILE__, __LINE__ )"）
  * - 或者它可以简单地禁用中断并在循环中停留，以在调试器中查看失败行
  *
- * 当前配置：禁用中断并进入无限循环，便于调试器中断点调试
+ * 当前配置：交给 yDrv_fault 记录断言故障后复位，参数只有行号，pc 为断言所在函数中的地址，
+ * 不保存文件名以节省 Flash；重启后由 shell 的 fault/crashdump 命令查看。
+ * 调试时把 YDRV_FAULT_RESET 定义为 0，记录后停在原地
  */
-#define configASSERT(x)           \
-    if ((x) == 0)                 \
-    {                             \
-        taskDISABLE_INTERRUPTS(); \
-        for (;;)                  \
-            ;                     \
+void yDrvFaultAssert(uint32_t line) __attribute__((noreturn));
+
+#define configASSERT(x)                       \
+    if ((x) == 0)                             \
+    {                                         \
+        yDrvFaultAssert((uint32_t)__LINE__);  \
     }
 
 /******************************************************************************/
@@ -533,7 +576,7 @@ extern uint32_t SystemCoreClock;
  * 默认值为 0（如果未定义）
  * 仅由 FreeRTOS Cortex-M MPU 移植使用，不适用于标准 ARMv7-M Cortex-M 移植
  *
- * 注意：STM32G0 系列（Cortex-M0+）不支持 MPU，此配置对本平台无效
+ * 注意：本项目不使用 FreeRTOS 的 MPU 移植(configENABLE_MPU 为 0)，此配置无效
  */
 #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS 0
 
@@ -542,7 +585,7 @@ extern uint32_t SystemCoreClock;
  * 仅由 FreeRTOS Cortex-M MPU 移植使用，不适用于标准 ARMv7-M Cortex-M 移植。
  * 默认值为 8（如果未定义）
  *
- * 注意：STM32G0 系列（Cortex-M0+）不支持 MPU，此配置对本平台无效
+ * 注意：本项目不使用 FreeRTOS 的 MPU 移植(configENABLE_MPU 为 0)，此配置无效
  */
 #define configTOTAL_MPU_REGIONS 8
 
@@ -687,8 +730,9 @@ extern uint32_t SystemCoreClock;
  * 以提供空闲任务和定时器任务分别使用的内存。
  * 应用程序可以通过将 configKERNEL_PROVIDED_STATIC_MEMORY 设置为 0 或保持未定义
  * 来提供自己的 vApplicationGetIdleTaskMemory() 和 vApplicationGetTimerTaskMemory() 实现。
+ * 当前配置：由os_static.c提供，空闲和定时器任务的堆栈放在.os_stack段并登记大小
  */
-#define configKERNEL_PROVIDED_STATIC_MEMORY 1
+#define configKERNEL_PROVIDED_STATIC_MEMORY 0
 
 /******************************************************************************/
 /* ARMv8-M 移植特定配置定义 ************************************************/
@@ -716,7 +760,9 @@ extern uint32_t SystemCoreClock;
  * 设置为 1：启用内存保护单元 (MPU)
  * 设置为 0：保持内存保护单元禁用状态
  *
- * 注意：STM32G0 系列是 Cortex-M0+ 内核，不支持 MPU，此配置对本平台无效
+ * 注意：STM32G0 的 Cortex-M0+ 带 8 个区域的 MPU，但 FreeRTOS 的 MPU 移植要求任务以非特权级运行、
+ * 内核调用经 SVC 包装，开销和改动都大；本项目保持为 0，所有任务以特权级运行，
+ * 由 OS_MPU_ENABLE 在任务切换时更换每个任务的堆栈保护和窗口区域(os_mpu.h)
  */
 #define configENABLE_MPU 0
 
@@ -788,15 +834,69 @@ extern uint32_t SystemCoreClock;
 #define INCLUDE_vTaskDelay 1                  // 任务延迟 API
 #define INCLUDE_xTaskGetSchedulerState 1      // 获取调度器状态 API
 #define INCLUDE_xTaskGetCurrentTaskHandle 1   // 获取当前任务句柄 API
-#define INCLUDE_uxTaskGetStackHighWaterMark 0 // 获取任务堆栈高水位标记 API
-#define INCLUDE_xTaskGetIdleTaskHandle 0      // 获取空闲任务句柄 API
+#define INCLUDE_uxTaskGetStackHighWaterMark 1 // 获取任务堆栈高水位标记 API
+#define INCLUDE_xTaskGetIdleTaskHandle 1      // 获取空闲任务句柄 API
 #define INCLUDE_eTaskGetState 0               // 获取任务状态 API
 #define INCLUDE_xEventGroupSetBitFromISR 1    // 从 ISR 设置事件组位 API
-#define INCLUDE_xTimerPendFunctionCall 0      // 定时器挂起函数调用 API
+#define INCLUDE_xTimerPendFunctionCall 1      // 定时器挂起函数调用 API
 #define INCLUDE_xTaskAbortDelay 0             // 中止任务延迟 API
 #define INCLUDE_xTaskGetHandle 0              // 通过名称获取任务句柄 API
+#define INCLUDE_xSemaphoreGetMutexHolder 1    // 获取互斥量持有者 API(os_lock等待统计)
 #define INCLUDE_xTaskResumeFromISR 1          // 从 ISR 恢复任务 API
 
+/******************************************************************************/
+/* 跟踪钩子定义 ***************************************************************/
+/******************************************************************************/
+
+/* 内核事件写入 yLib_trace 二进制记录(shell 的 trace 命令控制开始/停止和导出)
+ * 未开始记录时每个钩子只有一次掩码读取和判断；任务编号为 uxTCBNumber，
+ * 导出时与任务名一起发给解码器；SysTick 中断由滴答事件代替 ISR 事件
+ */
+#include "yLib_trace.h"
+
+/* 任务切入次数，按 uxTCBNumber 计数(os_static.c)，power 命令据此给出任务的唤醒次数；
+ * 编号不小于 OS_SWITCH_COUNT_MAX 的任务(删除后重建的任务编号递增)不计，0=不统计
+ */
+#ifndef OS_SWITCH_COUNT_MAX
+#define OS_SWITCH_COUNT_MAX 16
+#endif
+#if (OS_SWITCH_COUNT_MAX > 0)
+extern volatile uint32_t os_switch_count[OS_SWITCH_COUNT_MAX];
+#define OS_SWITCH_COUNT(number)                                                        \
+    do                                                                                 \
+    {                                                                                  \
+        if ((number) < OS_SWITCH_COUNT_MAX)                                            \
+            os_switch_count[(number)]++;                                               \
+    } while (0)
+#else
+#define OS_SWITCH_COUNT(number) ((void)0)
+#endif
+
+#if OS_MPU_ENABLE
+/* 切入任务时装载它的MPU区域组，与已装载的组相同时只有一次比较 */
+void OsMpuSwitch(const void *set);
+#define traceTASK_SWITCHED_IN()                                                        \
+    do                                                                                 \
+    {                                                                                  \
+        OsMpuSwitch(pxCurrentTCB->pvThreadLocalStoragePointers[OS_MPU_TLS_INDEX]);     \
+        OS_SWITCH_COUNT(pxCurrentTCB->uxTCBNumber);                                    \
+        YLIB_TRACE(YLIB_TRACE_EV_TASK_IN, pxCurrentTCB->uxTCBNumber);                  \
+    } while (0)
+#else
+#define traceTASK_SWITCHED_IN()                                                        \
+    do                                                                                 \
+    {                                                                                  \
+        OS_SWITCH_COUNT(pxCurrentTCB->uxTCBNumber);                                    \
+        YLIB_TRACE(YLIB_TRACE_EV_TASK_IN, pxCurrentTCB->uxTCBNumber);                  \
+    } while (0)
+#endif
+#define traceTASK_CREATE(pxNewTCB) YLIB_TRACE(YLIB_TRACE_EV_TASK_CREATE, (pxNewTCB)->uxTCBNumber)
+#define traceTASK_INCREMENT_TICK(xTickCount) YLIB_TRACE(YLIB_TRACE_EV_TICK, (xTickCount))
+#define traceQUEUE_SEND(pxQueue) YLIB_TRACE(YLIB_TRACE_EV_QUEUE_SEND, (uintptr_t)(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) YLIB_TRACE(YLIB_TRACE_EV_QUEUE_SEND, (uintptr_t)(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue) YLIB_TRACE(YLIB_TRACE_EV_QUEUE_RECV, (uintptr_t)(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) YLIB_TRACE(YLIB_TRACE_EV_QUEUE_RECV, (uintptr_t)(pxQueue))
+
 /* FreeRTOS 移植中断处理程序到 CMSIS 标准名称的映射定义 */
 #define vPortSVCHandler SVC_Handler         // SVC 中断处理程序映射
 #define xPortPendSVHandler PendSV_Handler   // PendSV 中断处理程序映射
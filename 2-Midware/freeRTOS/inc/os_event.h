@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ * @file       os_event.h
+ * @brief      中断到任务的事件标志
+ * @note       中断以一次或运算置位，前后只关几条指令的中断(M0+没有LDREX/STREX)；
+ *             只在标志由全0变为非0时通知等待的任务，同一事件在任务处理前重复发生时自然合并，
+ *             不再重复通知；任务一次取出并清除全部标志。
+ *             通知使用独立的任务通知索引，不与驱动的传输完成通知混用
+ ******************************************************************************
+ */
+#ifndef OS_EVENT_H
+#define OS_EVENT_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef OS_EVENT_NOTIFY_INDEX
+#define OS_EVENT_NOTIFY_INDEX (2) /* 事件标志使用的任务通知索引 */
+#endif
+
+_Static_assert(OS_EVENT_NOTIFY_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES, "event notify index out of range");
+
+/**
+ * @brief 事件标志
+ */
+typedef struct
+{
+    volatile uint32_t bits; /* 待处理的标志 */
+    TaskHandle_t task;      /* 等待的任务，NULL时只置位不通知 */
+} OsEvent_t;
+
+/**
+ * @brief 事件标志静态初始化
+ */
+#define OS_EVENT_INIT() {0, NULL}
+
+/**
+ * @brief 绑定等待的任务并清除标志
+ * @param task 之后调用OsEventWait的任务
+ */
+static inline void OsEventInit(OsEvent_t *event, TaskHandle_t task)
+{
+    event->bits = 0;
+    event->task = task;
+}
+
+/**
+ * @brief 关中断或运算，返回置位前的值
+ */
+static inline uint32_t OsEventOr(volatile uint32_t *bits, uint32_t set)
+{
+    uint32_t primask;
+    uint32_t old;
+
+    __asm volatile("mrs %0, primask\n"
+                   "cpsid i"
+                   : "=r"(primask)
+                   :
+                   : "memory");
+    old = *bits;
+    *bits = old | set;
+    __asm volatile("msr primask, %0" : : "r"(primask) : "memory");
+
+    return old;
+}
+
+/**
+ * @brief 中断中置位
+ * @param bits 置位的标志
+ * @param woken 需要切换任务时置为pdTRUE，由调用者在中断退出前portYIELD_FROM_ISR
+ */
+static inline void OsEventSetFromISR(OsEvent_t *event, uint32_t bits, BaseType_t *woken)
+{
+    if ((OsEventOr(&event->bits, bits) == 0U) && (event->task != NULL))
+    {
+        vTaskNotifyGiveIndexedFromISR(event->task, OS_EVENT_NOTIFY_INDEX, woken);
+    }
+}
+
+/**
+ * @brief 取出并清除全部标志，不等待
+ * @return 取出的标志
+ */
+static inline uint32_t OsEventTake(OsEvent_t *event)
+{
+    uint32_t primask;
+    uint32_t bits;
+
+    __asm volatile("mrs %0, primask\n"
+                   "cpsid i"
+                   : "=r"(primask)
+                   :
+                   : "memory");
+    bits = event->bits;
+    event->bits = 0;
+    __asm volatile("msr primask, %0" : : "r"(primask) : "memory");
+
+    return bits;
+}
+
+/**
+ * @brief 置位，任务和中断中都可以调用
+ * @param bits 置位的标志
+ * @note 中断中调用时在返回前完成任务切换请求
+ */
+void OsEventSet(OsEvent_t *event, uint32_t bits);
+
+/**
+ * @brief 等待任一标志并取出全部标志
+ * @param ticks 最长等待时间，portMAX_DELAY为一直等待
+ * @return 取出的标志，超时返回0
+ * @note 只能由绑定的任务调用；合并留下的多余通知只会让本函数多检查一次标志
+ */
+uint32_t OsEventWait(OsEvent_t *event, TickType_t ticks);
+
+#endif /* OS_EVENT_H */
@@ -0,0 +1,34 @@
+/**
+ ******************************************************************************
+ * @file       os_irqrun.h
+ * @brief      中断运行模式
+ * @note       OS_IRQ_RUN_ENABLE为1时不启动调度器：yLib工作队列和定时轮由一个最低优先级的
+ *             软件中断(yDrvSwiInit)执行，DMA等完成中断里提交工作项或由yDevAsyncWorkDone转交，
+ *             退出时尾链进入软件中断；SCR.SLEEPONEXIT使内核在中断之间直接回到Sleep，
+ *             唤醒到再次睡眠只有中断进入和退出的开销。
+ *             定时轮不按节拍推进：软件中断处理完后按ylib_timer_wheel_idle设定下一次挂起的毫秒时刻，
+ *             没有定时器时不再唤醒；TIM17毫秒中断保留，提供时间和到期比较。
+ *             限制：
+ *             - 依赖任务的模块(shell、busjob、yDev阻塞读写的任务等待等)不可用
+ *             - 工作函数和定时器回调在中断中执行，不能阻塞，应尽快返回，较长的处理拆成多个工作项
+ *             - 调度器未启动时FreeRTOS临界区退出后不开中断，在中断中使用会保持关中断到返回线程模式
+ *             - 只进入Sleep，不进入STOP
+ ******************************************************************************
+ */
+#ifndef OS_IRQRUN_H
+#define OS_IRQRUN_H
+
+#include "FreeRTOS.h"
+
+#if OS_IRQ_RUN_ENABLE
+
+/**
+ * @brief 进入中断运行
+ * @note 在main中完成设备初始化后调用，代替vTaskStartScheduler，不返回；
+ *       之前提交的工作项和启动的定时器在第一次软件中断中处理
+ */
+void OsIrqRunStart(void) __attribute__((noreturn));
+
+#endif /* OS_IRQ_RUN_ENABLE */
+
+#endif /* OS_IRQRUN_H */
@@ -0,0 +1,101 @@
+/**
+ ******************************************************************************
+ * @file       os_lock.h
+ * @brief      带等待统计的互斥锁
+ * @note       在FreeRTOS互斥锁(优先级继承)外记录获得次数、需要等待的次数、超时次数和最长等待，
+ *             最长等待时同时记下当时的持有者任务名，用来找出造成优先级反转的一方；
+ *             无竞争时只多一次不阻塞的获取，等待路径才读时间和持有者。
+ *             所有锁串在一个链表上，shell的locks命令逐个列出
+ ******************************************************************************
+ */
+#ifndef OS_LOCK_H
+#define OS_LOCK_H
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "os_static.h"
+
+#ifndef OS_LOCK_NAME_LEN
+#define OS_LOCK_NAME_LEN (8) /* 统计中保存的持有者任务名长度(含结尾0) */
+#endif
+
+/**
+ * @brief 锁的等待统计
+ */
+typedef struct
+{
+    uint32_t takes;                   /* 获得次数 */
+    uint32_t contended;               /* 需要等待的次数，含超时 */
+    uint32_t timeouts;                /* 等待超时次数 */
+    uint32_t wait_ms;                 /* 累计等待时间 */
+    uint32_t max_wait_ms;             /* 最长等待 */
+    char max_owner[OS_LOCK_NAME_LEN]; /* 最长等待时的持有者 */
+} OsLockStats_t;
+
+/**
+ * @brief 互斥锁
+ */
+typedef struct OsLock
+{
+    SemaphoreHandle_t mutex; /* FreeRTOS互斥锁，NULL为未初始化 */
+    StaticSemaphore_t sem;   /* 互斥锁控制块 */
+    const char *name;        /* 锁名，须在锁的生存期内有效 */
+    struct OsLock *next;     /* 锁链表 */
+    OsLockStats_t stats;     /* 等待统计 */
+} OsLock_t;
+
+/**
+ * @brief 定义锁，控制块随其他内核对象放在.os_object段
+ */
+#define OS_LOCK_DEFINE(name) static OsLock_t name OS_OBJECT_SECTION
+
+/**
+ * @brief 创建互斥锁并加入锁链表
+ * @param lock 锁
+ * @param name 锁名(通常为字符串常量)
+ * @note 重复初始化同一把锁时不做任何事
+ */
+void OsLockInit(OsLock_t *lock, const char *name);
+
+/**
+ * @brief 锁是否已初始化
+ */
+static inline int OsLockReady(const OsLock_t *lock)
+{
+    return lock->mutex != NULL;
+}
+
+/**
+ * @brief 获取锁
+ * @param lock 锁
+ * @param ticks 最长等待(节拍)，portMAX_DELAY一直等待
+ * @return pdTRUE已获得，pdFALSE超时
+ * @note 等待期间持有者继承等待者的优先级；等待时间以系统节拍计，不足一个节拍的等待记为0
+ */
+BaseType_t OsLockTake(OsLock_t *lock, TickType_t ticks);
+
+/**
+ * @brief 释放锁
+ */
+static inline void OsLockGive(OsLock_t *lock)
+{
+    (void)xSemaphoreGive(lock->mutex);
+}
+
+/**
+ * @brief 读取统计
+ * @param lock 锁
+ * @param stats 输出
+ * @param reset 非0时读取后清零
+ */
+void OsLockGetStats(OsLock_t *lock, OsLockStats_t *stats, uint8_t reset);
+
+/**
+ * @brief 遍历锁链表
+ * @param prev 上一把锁，NULL从头开始
+ * @return 下一把锁，没有时返回NULL
+ * @note 锁只加入不移除，遍历不需要加锁
+ */
+OsLock_t *OsLockNext(const OsLock_t *prev);
+
+#endif /* OS_LOCK_H */
@@ -0,0 +1,79 @@
+/**
+ ******************************************************************************
+ * @file       os_mpu.h
+ * @brief      按任务切换的MPU区域
+ * @note       OS_MPU_ENABLE为1时，OsTaskCreate创建的任务各有一组区域(yDrvMpuSet_t)，
+ *             组内区域7为堆栈底部的只读保护区，其余三个由使用者按任务开放DMA缓冲区或外设窗口；
+ *             全局区域0~3对所有任务生效，用来先把这些范围收紧。
+ *             区域组的指针放在任务的线程本地存储中，任务切换钩子比较指针，
+ *             与已装载的组相同时不写寄存器，不同时写入四个区域共八个寄存器
+ ******************************************************************************
+ */
+#ifndef OS_MPU_H
+#define OS_MPU_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if OS_MPU_ENABLE
+
+#include "yDrv_mpu.h"
+
+_Static_assert(OS_MPU_TLS_INDEX < configNUM_THREAD_LOCAL_STORAGE_POINTERS, "mpu tls index out of range");
+
+/**
+ * @brief 任务可自行设置的区域数，不含堆栈保护
+ */
+#define OS_MPU_TASK_REGIONS (YDRV_MPU_SET_REGIONS - 1U)
+
+/**
+ * @brief 为任务分配区域组并设置堆栈保护
+ * @param task 任务句柄
+ * @param stack 堆栈起始地址
+ * @param stack_words 堆栈大小(字)
+ * @return 0成功，-1区域组用完或堆栈太小
+ * @note 由OsTaskCreate调用；同一堆栈再次创建的任务沿用原区域组
+ */
+int32_t OsMpuTaskAttach(TaskHandle_t task, const StackType_t *stack, uint32_t stack_words);
+
+/**
+ * @brief 设置任务的一个区域
+ * @param task 任务句柄，NULL为当前任务
+ * @param index 区域序号(0~OS_MPU_TASK_REGIONS-1)
+ * @param base 起始地址
+ * @param size 长度(字节)，0为关闭该区域
+ * @param access 访问权限
+ * @param attr YDRV_MPU_ATTR_xxx组合
+ * @return 0成功，-1参数错误或任务没有区域组
+ * @note 任务区域优先于全局区域，可以把全局只读的DMA缓冲区对拥有者重新开放为读写
+ */
+int32_t OsMpuTaskRegion(TaskHandle_t task, uint32_t index, uint32_t base, uint32_t size,
+                        yDrvMpuAccess_t access, uint32_t attr);
+
+/**
+ * @brief 设置全局区域
+ * @param index 区域编号(0~YDRV_MPU_GLOBAL_REGIONS-1)
+ * @param base 起始地址
+ * @param size 长度(字节)，0为关闭该区域
+ * @param access 访问权限
+ * @param attr YDRV_MPU_ATTR_xxx组合
+ * @return 0成功，-1参数错误
+ */
+int32_t OsMpuGlobalRegion(uint32_t index, uint32_t base, uint32_t size, yDrvMpuAccess_t access, uint32_t attr);
+
+/**
+ * @brief 使能MPU
+ * @note 在调度器启动前调用，之前创建的任务已带有堆栈保护
+ */
+void OsMpuStart(void);
+
+/**
+ * @brief 任务切换钩子
+ * @param set 切入任务的区域组，NULL为没有区域组
+ * @note 由traceTASK_SWITCHED_IN在PendSV中调用
+ */
+void OsMpuSwitch(const void *set);
+
+#endif /* OS_MPU_ENABLE */
+
+#endif /* OS_MPU_H */
@@ -0,0 +1,198 @@
+/**
+ ******************************************************************************
+ * @file       os_static.h
+ * @brief      FreeRTOS任务和内核对象的静态存储
+ * @note       任务堆栈放在.os_stack段，TCB、队列、定时器、信号量的控制块和队列存储放在
+ *             .os_object段，两段紧接.bss由启动代码一起清零，链接时按段统计大小，
+ *             构建后由tools/ram_report.py列出每个对象；
+ *             单例对象用OS_xxx_DEFINE/OS_xxx_CREATE，每个设备实例一份的对象用
+ *             OS_xxx_POOL_DEFINE定义固定槽位，按拥有者(设备句柄)占用和释放；
+ *             任务经OsTaskCreate创建时登记堆栈大小，供堆栈用量报告查询；
+ *             开启OS_MPU_ENABLE时同时设置堆栈底部的MPU保护区(os_mpu.h)
+ ******************************************************************************
+ */
+#ifndef OS_STATIC_H
+#define OS_STATIC_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION != 1)
+#error "os_static.h requires configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+#define OS_OBJECT_SECTION __attribute__((section(".os_object"), aligned(4))) /* 控制块和队列存储 */
+#define OS_STACK_SECTION __attribute__((section(".os_stack"), aligned(8)))   /* 任务堆栈，按AAPCS对齐8字节 */
+
+#define OS_ARRAY_LEN(array) (sizeof(array) / sizeof((array)[0]))
+
+#ifndef OS_TASK_MAX
+#define OS_TASK_MAX (12) /* 登记堆栈大小的任务数上限，含空闲和定时器任务 */
+#endif
+
+/**
+ * @brief 创建静态任务并登记堆栈大小
+ * @note 参数同xTaskCreateStatic，同一堆栈重复创建时覆盖原登记
+ */
+TaskHandle_t OsTaskCreate(TaskFunction_t entry, const char *name, uint32_t stack_words, void *param,
+                          UBaseType_t prio, StackType_t *stack, StaticTask_t *tcb);
+
+/**
+ * @brief 查询任务堆栈大小
+ * @param stack_base 堆栈起始地址(TaskStatus_t::pxStackBase)
+ * @return 堆栈大小(字)，未登记返回0
+ */
+uint32_t OsTaskStackDepth(const StackType_t *stack_base);
+
+/**
+ * @brief 查询任务切入次数
+ * @param number 任务编号(TaskStatus_t::xTaskNumber)
+ * @return 切入次数，超出OS_SWITCH_COUNT_MAX或未统计时返回0
+ */
+uint32_t OsTaskSwitchCount(UBaseType_t number);
+
+/* ===== 单例对象 ===== */
+
+/**
+ * @brief 定义任务的堆栈和TCB
+ * @param name 对象名，生成name##_stack和name##_tcb
+ * @param stack_words 堆栈大小(字)
+ */
+#define OS_TASK_DEFINE(name, stack_words)                                                                            \
+    static StackType_t name##_stack[(stack_words)] OS_STACK_SECTION;                                                 \
+    static StaticTask_t name##_tcb OS_OBJECT_SECTION
+
+/**
+ * @brief 在OS_TASK_DEFINE的存储上创建任务
+ * @return 任务句柄，静态创建不会失败
+ */
+#define OS_TASK_CREATE(name, entry, task_name, param, prio)                                                          \
+    OsTaskCreate((entry), (task_name), (uint32_t)OS_ARRAY_LEN(name##_stack), (param), (prio), name##_stack,          \
+                 &name##_tcb)
+
+/**
+ * @brief 定义队列的控制块和存储
+ * @param type 元素类型
+ * @param length 队列深度
+ */
+#define OS_QUEUE_DEFINE(name, type, length)                                                                          \
+    static type name##_storage[(length)] OS_OBJECT_SECTION;                                                          \
+    static StaticQueue_t name##_queue OS_OBJECT_SECTION
+
+#define OS_QUEUE_CREATE(name)                                                                                        \
+    xQueueCreateStatic((UBaseType_t)OS_ARRAY_LEN(name##_storage), (UBaseType_t)sizeof(name##_storage[0]),            \
+                       (uint8_t *)name##_storage, &name##_queue)
+
+/**
+ * @brief 定义软件定时器的控制块
+ */
+#define OS_TIMER_DEFINE(name) static StaticTimer_t name##_timer OS_OBJECT_SECTION
+
+#define OS_TIMER_CREATE(name, timer_name, period, reload, id, callback)                                              \
+    xTimerCreateStatic((timer_name), (period), (reload), (id), (callback), &name##_timer)
+
+/**
+ * @brief 定义互斥锁/信号量的控制块
+ */
+#define OS_MUTEX_DEFINE(name) static StaticSemaphore_t name##_sem OS_OBJECT_SECTION
+
+#define OS_MUTEX_CREATE(name) xSemaphoreCreateMutexStatic(&name##_sem)
+#define OS_RECURSIVE_MUTEX_CREATE(name) xSemaphoreCreateRecursiveMutexStatic(&name##_sem)
+
+/* ===== 按拥有者分配的对象池 ===== */
+
+/**
+ * @brief 定义任务池，每个槽位一份堆栈和TCB
+ * @param count 槽位数
+ */
+#define OS_TASK_POOL_DEFINE(name, count, stack_words)                                                                \
+    static StackType_t name##_stack[(count)][(stack_words)] OS_STACK_SECTION;                                        \
+    static StaticTask_t name##_tcb[(count)] OS_OBJECT_SECTION;                                                       \
+    static void *name##_owner[(count)]
+
+#define OS_TASK_POOL_CREATE(name, slot, entry, task_name, param, prio)                                               \
+    OsTaskCreate((entry), (task_name), (uint32_t)OS_ARRAY_LEN(name##_stack[0]), (param), (prio),                     \
+                 name##_stack[(slot)], &name##_tcb[(slot)])
+
+#define OS_TIMER_POOL_DEFINE(name, count)                                                                            \
+    static StaticTimer_t name##_timer[(count)] OS_OBJECT_SECTION;                                                    \
+    static void *name##_owner[(count)]
+
+#define OS_TIMER_POOL_CREATE(name, slot, timer_name, period, reload, id, callback)                                   \
+    xTimerCreateStatic((timer_name), (period), (reload), (id), (callback), &name##_timer[(slot)])
+
+#define OS_MUTEX_POOL_DEFINE(name, count)                                                                            \
+    static StaticSemaphore_t name##_sem[(count)] OS_OBJECT_SECTION;                                                  \
+    static void *name##_owner[(count)]
+
+#define OS_MUTEX_POOL_CREATE(name, slot) xSemaphoreCreateMutexStatic(&name##_sem[(slot)])
+#define OS_RECURSIVE_MUTEX_POOL_CREATE(name, slot) xSemaphoreCreateRecursiveMutexStatic(&name##_sem[(slot)])
+
+/**
+ * @brief 占用池中的槽位
+ * @param name 池名
+ * @param owner 拥有者，同一拥有者重复占用时返回原槽位
+ * @return 槽位号，池满返回-1
+ */
+#define OS_POOL_CLAIM(name, owner) OsStaticClaim(name##_owner, (uint32_t)OS_ARRAY_LEN(name##_owner), (owner))
+
+/**
+ * @brief 释放拥有者占用的槽位，对象须已删除
+ */
+#define OS_POOL_RELEASE(name, owner) OsStaticRelease(name##_owner, (uint32_t)OS_ARRAY_LEN(name##_owner), (owner))
+
+/**
+ * @brief 槽位占用实现，关中断查找，调度器启动前后均可调用
+ */
+static inline int32_t OsStaticClaim(void **owners, uint32_t count, void *owner)
+{
+    UBaseType_t mask;
+    int32_t slot = -1;
+    uint32_t i;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    for (i = 0; i < count; i++)
+    {
+        if (owners[i] == owner)
+        {
+            slot = (int32_t)i;
+            break;
+        }
+        if ((owners[i] == NULL) && (slot < 0))
+        {
+            slot = (int32_t)i;
+        }
+    }
+    if (slot >= 0)
+    {
+        owners[slot] = owner;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return slot;
+}
+
+/**
+ * @brief 槽位释放实现
+ * @note 静态任务被其他任务删除时TCB立即脱离内核链表，定时器删除命令在服务任务
+ *       (最高优先级)中先于后续创建处理，释放后槽位可以立即复用
+ */
+static inline void OsStaticRelease(void **owners, uint32_t count, void *owner)
+{
+    UBaseType_t mask;
+    uint32_t i;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    for (i = 0; i < count; i++)
+    {
+        if (owners[i] == owner)
+        {
+            owners[i] = NULL;
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+#endif /* OS_STATIC_H */
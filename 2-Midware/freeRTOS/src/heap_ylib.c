@@ -0,0 +1,151 @@
+/**
+ ******************************************************************************
+ * @file       heap_ylib.c
+ * @brief      以yLib堆实现FreeRTOS内存管理接口
+ * @note       替代heap_4.c：FreeRTOS内核对象、任务栈与ylib_malloc共用链接脚本划出的同一个堆区，
+ *             不再各自预留静态数组；内核分配计入YLIB_HEAP_OWNER_RTOS；
+ *             同时借助线程本地存储指针提供任务线性分配器(yLib_arena)的绑定，
+ *             并在空闲任务钩子中增量巡检堆和内存分区
+ ******************************************************************************
+ */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "yLib_arena.h"
+#include "yLib_heap.h"
+#include "yLib_mempool.h"
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+#define configHEAP_CLEAR_MEMORY_ON_FREE 0
+#endif
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+    void *pvReturn = ylib_malloc_from(xWantedSize, YLIB_HEAP_OWNER_RTOS, __builtin_return_address(0));
+
+    traceMALLOC(pvReturn, xWantedSize);
+
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+    if (pvReturn == NULL)
+        vApplicationMallocFailedHook();
+#endif
+    return pvReturn;
+}
+
+void vPortFree(void *pv)
+{
+    if (pv == NULL)
+        return;
+#if (configHEAP_CLEAR_MEMORY_ON_FREE == 1)
+    memset(pv, 0, ylib_malloc_size(pv));
+#endif
+    traceFREE(pv, ylib_malloc_size(pv));
+    ylib_free_from(pv, __builtin_return_address(0));
+}
+
+void *pvPortCalloc(size_t xNum, size_t xSize)
+{
+    void *pv;
+
+    if (xSize != 0 && xNum > ((size_t)-1) / xSize)
+        return NULL;
+    pv = pvPortMalloc(xNum * xSize);
+    if (pv != NULL)
+        memset(pv, 0, xNum * xSize);
+    return pv;
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return ylib_get_free_heap_size();
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+    return ylib_get_minimum_ever_free_heap_size();
+}
+
+void vPortInitialiseBlocks(void)
+{
+    /* 堆在首次分配时初始化 */
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats)
+{
+#if configHEAP_STATS_ENABLE
+    ylib_heap_stats_t stats;
+
+    ylib_get_heap_stats(&stats);
+    pxHeapStats->xAvailableHeapSpaceInBytes = stats.free_heap_size;
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = stats.max_block_size;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = stats.min_block_size;
+    pxHeapStats->xNumberOfFreeBlocks = stats.number_of_free_blocks;
+    pxHeapStats->xMinimumEverFreeBytesRemaining = stats.minimum_ever_free_heap_size;
+    pxHeapStats->xNumberOfSuccessfulAllocations = stats.successful_allocations;
+    pxHeapStats->xNumberOfSuccessfulFrees = stats.successful_frees;
+#else
+    memset(pxHeapStats, 0, sizeof(*pxHeapStats));
+    pxHeapStats->xAvailableHeapSpaceInBytes = ylib_get_free_heap_size();
+#endif
+}
+
+void vPortHeapResetState(void)
+{
+    /* 重新初始化会丢弃所有已分配块，只能在重启调度器前、所有对象都已删除后调用 */
+    ylib_heap_init(NULL, 0);
+}
+
+#if (configUSE_IDLE_HOOK == 1)
+/**
+ * @brief 空闲任务钩子：每次巡检少量堆块或内存分区空闲块
+ * @note 堆查完一整遍后转去查内存分区，交替进行；发现损坏后记录第一处并停止巡检
+ */
+void vApplicationIdleHook(void)
+{
+#if configHEAP_CHECK_ENABLE && YLIB_HEAP_SCRUB_BUDGET
+    static bool scrub_pools = false;
+
+    if (!scrub_pools)
+        scrub_pools = (ylib_heap_scrub(YLIB_HEAP_SCRUB_BUDGET) == 1);
+    else
+        scrub_pools = (YLibMemScrub(YLIB_HEAP_SCRUB_BUDGET) != 1);
+#endif
+}
+#endif
+
+#if (configNUM_THREAD_LOCAL_STORAGE_POINTERS > YLIB_ARENA_TLS_INDEX)
+void ylib_arena_task_bind(ylib_arena_t *arena)
+{
+    vTaskSetThreadLocalStoragePointer(NULL, YLIB_ARENA_TLS_INDEX, arena);
+}
+
+ylib_arena_t *ylib_arena_task(void)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+        return NULL;
+    return (ylib_arena_t *)pvTaskGetThreadLocalStoragePointer(NULL, YLIB_ARENA_TLS_INDEX);
+}
+#else
+void ylib_arena_task_bind(ylib_arena_t *arena)
+{
+    (void)arena;
+}
+
+ylib_arena_t *ylib_arena_task(void)
+{
+    return NULL;
+}
+#endif
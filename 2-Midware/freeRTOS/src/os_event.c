@@ -0,0 +1,50 @@
+/**
+ ******************************************************************************
+ * @file       os_event.c
+ * @brief      中断到任务的事件标志
+ * @note       等待时先查标志再阻塞，阻塞前到达的置位已经发出通知，不会丢失唤醒；
+ *             任务取走标志后留下的通知计数只造成一次空唤醒，按剩余时间继续等待
+ ******************************************************************************
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "os_event.h"
+
+void OsEventSet(OsEvent_t *event, uint32_t bits)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (xPortIsInsideInterrupt())
+    {
+        OsEventSetFromISR(event, bits, &woken);
+        portYIELD_FROM_ISR(woken);
+        return;
+    }
+
+    if ((OsEventOr(&event->bits, bits) == 0U) && (event->task != NULL))
+        xTaskNotifyGiveIndexed(event->task, OS_EVENT_NOTIFY_INDEX);
+}
+
+uint32_t OsEventWait(OsEvent_t *event, TickType_t ticks)
+{
+    TimeOut_t timeout;
+    uint32_t bits;
+
+    vTaskSetTimeOutState(&timeout);
+    for (;;)
+    {
+        bits = OsEventTake(event);
+        if ((bits != 0U) || (xTaskCheckForTimeOut(&timeout, &ticks) != pdFALSE))
+            return bits;
+        (void)ulTaskNotifyTakeIndexed(OS_EVENT_NOTIFY_INDEX, pdTRUE, ticks);
+    }
+}
@@ -0,0 +1,243 @@
+/**
+ ******************************************************************************
+ * @file       os_irqrun.c
+ * @brief      中断运行模式：软件中断执行工作队列和定时轮
+ * @note       代替work_ylib.c和timer_ylib.c实现yLib的适配接口；队列和定时轮操作很短，
+ *             直接关中断保护，工作函数和定时器回调在软件中断中、关中断外执行。
+ *             定时轮记录已计入的毫秒时刻，每次操作前按经过的节拍补推进，
+ *             处理完后只在下一个有事可做的节拍挂起软件中断
+ ******************************************************************************
+ */
+
+#include "FreeRTOS.h"
+
+#include "os_irqrun.h"
+#include "yLib_work.h"
+#include "yLib_timer.h"
+#include "yDrv_basic.h"
+
+#if OS_IRQ_RUN_ENABLE
+
+static struct ylib_work_queue irqrun_queue[YLIB_WORK_PRIOS];
+static struct ylib_timer_wheel irqrun_wheel;
+static uint32_t irqrun_wheel_ms; /* 已计入定时轮的毫秒时刻 */
+static uint8_t irqrun_ready;     /* 队列和定时轮已初始化 */
+
+/**
+ * @brief 队列和定时轮初始化，进入中断运行前也可提交和启动
+ */
+static void irqrun_setup(void)
+{
+    unsigned int i;
+
+    if (irqrun_ready)
+        return;
+    for (i = 0; i < YLIB_WORK_PRIOS; i++)
+        ylib_work_queue_init(&irqrun_queue[i]);
+    ylib_timer_wheel_init(&irqrun_wheel, 0);
+    irqrun_wheel_ms = yDrvGetTimeMs();
+    irqrun_ready = 1;
+}
+
+/**
+ * @brief 按经过的毫秒推进定时轮，调用者关中断
+ * @note 定时轮为空时直接跳过经过的节拍，长时间睡眠后不逐拍推进
+ */
+static void irqrun_wheel_sync(void)
+{
+    uint32_t elapsed = (yDrvGetTimeMs() - irqrun_wheel_ms) / YLIB_TIMER_TICK_MS;
+
+    if (elapsed == 0)
+        return;
+    irqrun_wheel_ms += elapsed * YLIB_TIMER_TICK_MS;
+    if (ylib_timer_wheel_idle(&irqrun_wheel) == YLIB_TIMER_IDLE_FOREVER)
+        irqrun_wheel.now += elapsed;
+    else
+        ylib_timer_wheel_advance(&irqrun_wheel, irqrun_wheel.now + elapsed - 1);
+}
+
+/**
+ * @brief 按定时轮设定软件中断的下一次挂起，调用者关中断
+ * @note 节拍now在irqrun_wheel_ms之后一个节拍推进，跳过idle个空节拍
+ */
+static void irqrun_wheel_arm(void)
+{
+    uint32_t idle;
+
+    if (!ylib_list_empty(&irqrun_wheel.expired))
+    {
+        yDrvSwiTrigger();
+        return;
+    }
+
+    idle = ylib_timer_wheel_idle(&irqrun_wheel);
+    if (idle == YLIB_TIMER_IDLE_FOREVER)
+        yDrvSwiCancelAt();
+    else
+        yDrvSwiTriggerAt(irqrun_wheel_ms + (idle + 1U) * YLIB_TIMER_TICK_MS);
+}
+
+/**
+ * @brief 取出优先级最高的工作项，调用者关中断
+ */
+static struct ylib_work *irqrun_work_take(void)
+{
+    struct ylib_work *work;
+    unsigned int i;
+
+    for (i = 0; i < YLIB_WORK_PRIOS; i++)
+    {
+        work = ylib_work_queue_take(&irqrun_queue[i]);
+        if (work != NULL)
+            return work;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 软件中断：先执行到期的定时器，再按优先级执行工作项，都取空后设定下一次挂起
+ * @note 每执行一项都重新从到期定时器开始取，高优先级的工作项不会被一串低优先级的工作项延后；
+ *       执行期间其他中断的提交会再次挂起软件中断，退出后立即重新进入
+ */
+static void irqrun_swi_handler(void)
+{
+    struct ylib_timer *timer;
+    struct ylib_work *work;
+    ylib_work_func_t func;
+    void *arg;
+    UBaseType_t mask;
+
+    for (;;)
+    {
+        func = NULL;
+        arg = NULL;
+
+        mask = portSET_INTERRUPT_MASK_FROM_ISR();
+        irqrun_wheel_sync();
+        timer = ylib_timer_wheel_expired(&irqrun_wheel);
+        if (timer != NULL)
+        {
+            func = timer->func;
+            arg = timer->arg;
+        }
+        else
+        {
+            work = irqrun_work_take();
+            if (work == NULL)
+            {
+                irqrun_wheel_arm();
+                portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+                break;
+            }
+            func = work->func;
+            arg = work->arg;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+        if (func != NULL)
+            func(arg);
+    }
+}
+
+void OsIrqRunStart(void)
+{
+    yDrvStatus_t status;
+    UBaseType_t mask;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    irqrun_setup();
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    status = yDrvSwiInit(irqrun_swi_handler);
+    configASSERT(status == YDRV_OK);
+    (void)status;
+
+    // 处理进入前提交的工作项和到期的定时器，之后由提交和定时轮挂起
+    yDrvSwiTrigger();
+    yDrvIrqRunEnter();
+}
+
+int ylib_work_service_init(void)
+{
+    UBaseType_t mask;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    irqrun_setup();
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return 0;
+}
+
+int ylib_work_post(struct ylib_work *work)
+{
+    UBaseType_t mask;
+    int ret;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    irqrun_setup();
+    ret = ylib_work_queue_add(&irqrun_queue[work->prio], work);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    if (ret > 0)
+        yDrvSwiTrigger();
+    return (ret >= 0) ? 1 : 0;
+}
+
+int ylib_work_cancel(struct ylib_work *work)
+{
+    UBaseType_t mask;
+    int ret;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    irqrun_setup();
+    ret = ylib_work_queue_del(&irqrun_queue[work->prio], work);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+int ylib_work_stats(unsigned int prio, struct ylib_work_queue *stats)
+{
+    UBaseType_t mask;
+
+    if (prio >= YLIB_WORK_PRIOS)
+        return -1;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    irqrun_setup();
+    *stats = irqrun_queue[prio];
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return 0;
+}
+
+int ylib_timer_service_init(void)
+{
+    return ylib_work_service_init();
+}
+
+void ylib_timer_start(struct ylib_timer *timer, uint32_t timeout_ms, uint32_t period_ms)
+{
+    UBaseType_t mask;
+    uint32_t ticks = (timeout_ms + YLIB_TIMER_TICK_MS - 1) / YLIB_TIMER_TICK_MS;
+
+    // 定时轮只在有事时推进，先补上经过的节拍，超时从现在算起
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    irqrun_setup();
+    irqrun_wheel_sync();
+    timer->period = (period_ms + YLIB_TIMER_TICK_MS - 1) / YLIB_TIMER_TICK_MS;
+    ylib_timer_wheel_add(&irqrun_wheel, timer, irqrun_wheel.now + ticks);
+    irqrun_wheel_arm();
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+int ylib_timer_stop(struct ylib_timer *timer)
+{
+    UBaseType_t mask;
+    int ret;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    irqrun_setup();
+    ret = ylib_timer_wheel_del(timer);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+#endif /* OS_IRQ_RUN_ENABLE */
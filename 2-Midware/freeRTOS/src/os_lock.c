@@ -0,0 +1,104 @@
+/**
+ ******************************************************************************
+ * @file       os_lock.c
+ * @brief      带等待统计的互斥锁
+ * @note       统计在临界区内更新，超时的等待者不持有锁，不能靠锁本身保护统计
+ ******************************************************************************
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "os_lock.h"
+
+#include <string.h>
+
+static OsLock_t *os_lock_list; /* 锁链表，新加入的在前 */
+
+void OsLockInit(OsLock_t *lock, const char *name)
+{
+    if (lock->mutex != NULL)
+        return;
+
+    memset(&lock->stats, 0, sizeof(lock->stats));
+    lock->name = name;
+    lock->mutex = xSemaphoreCreateMutexStatic(&lock->sem);
+
+    taskENTER_CRITICAL();
+    lock->next = os_lock_list;
+    os_lock_list = lock;
+    taskEXIT_CRITICAL();
+}
+
+BaseType_t OsLockTake(OsLock_t *lock, TickType_t ticks)
+{
+    OsLockStats_t *stats = &lock->stats;
+    char owner[OS_LOCK_NAME_LEN] = "-";
+    TaskHandle_t holder;
+    TickType_t start;
+    uint32_t wait_ms;
+    BaseType_t ret;
+
+    if (xSemaphoreTake(lock->mutex, 0) == pdTRUE)
+    {
+        taskENTER_CRITICAL();
+        stats->takes++;
+        taskEXIT_CRITICAL();
+        return pdTRUE;
+    }
+
+    // 持有者可能在取名之前已经释放，此时记为"-"
+    start = xTaskGetTickCount();
+    taskENTER_CRITICAL();
+    holder = xSemaphoreGetMutexHolder(lock->mutex);
+    if (holder != NULL)
+    {
+        strncpy(owner, pcTaskGetName(holder), sizeof(owner) - 1U);
+        owner[sizeof(owner) - 1U] = '\0';
+    }
+    taskEXIT_CRITICAL();
+
+    ret = (ticks != 0) ? xSemaphoreTake(lock->mutex, ticks) : pdFALSE;
+    wait_ms = (uint32_t)(xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+
+    taskENTER_CRITICAL();
+    stats->contended++;
+    stats->wait_ms += wait_ms;
+    if (ret == pdTRUE)
+    {
+        stats->takes++;
+    }
+    else
+    {
+        stats->timeouts++;
+    }
+    if (wait_ms > stats->max_wait_ms)
+    {
+        stats->max_wait_ms = wait_ms;
+        memcpy(stats->max_owner, owner, sizeof(stats->max_owner));
+    }
+    taskEXIT_CRITICAL();
+
+    return ret;
+}
+
+void OsLockGetStats(OsLock_t *lock, OsLockStats_t *stats, uint8_t reset)
+{
+    taskENTER_CRITICAL();
+    *stats = lock->stats;
+    if (reset != 0)
+        memset(&lock->stats, 0, sizeof(lock->stats));
+    taskEXIT_CRITICAL();
+}
+
+OsLock_t *OsLockNext(const OsLock_t *prev)
+{
+    return (prev == NULL) ? os_lock_list : prev->next;
+}
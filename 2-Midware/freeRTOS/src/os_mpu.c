@@ -0,0 +1,126 @@
+/**
+ ******************************************************************************
+ * @file       os_mpu.c
+ * @brief      按任务切换的MPU区域
+ * @note       区域组与堆栈一一对应，放在静态表中，任务删除后保留，同一堆栈再次创建时沿用；
+ *             没有区域组的任务(空闲、定时器)切入时装载全部关闭的组，只有全局区域生效
+ ******************************************************************************
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "os_static.h"
+#include "os_mpu.h"
+
+#if OS_MPU_ENABLE
+
+/**
+ * @brief 区域组表
+ */
+struct os_mpu_slot {
+    const StackType_t *stack; /* 对应的堆栈，NULL为空闲 */
+    yDrvMpuSet_t set;         /* 区域组 */
+};
+
+static struct os_mpu_slot os_mpu_slot[OS_TASK_MAX];
+static yDrvMpuSet_t os_mpu_none;               /* 没有区域组的任务使用 */
+static const yDrvMpuSet_t *os_mpu_loaded;      /* 当前装载的区域组 */
+
+int32_t OsMpuTaskAttach(TaskHandle_t task, const StackType_t *stack, uint32_t stack_words)
+{
+    struct os_mpu_slot *slot = NULL;
+    yDrvMpuRegion_t guard;
+    unsigned int i;
+
+    if ((task == NULL) ||
+        (yDrvMpuGuardMake(&guard, stack, stack_words * (uint32_t)sizeof(StackType_t)) != YDRV_OK))
+        return -1;
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < OS_TASK_MAX; i++)
+    {
+        if (os_mpu_slot[i].stack == stack)
+        {
+            slot = &os_mpu_slot[i];
+            break;
+        }
+        if ((os_mpu_slot[i].stack == NULL) && (slot == NULL))
+            slot = &os_mpu_slot[i];
+    }
+    if (slot != NULL)
+    {
+        if (slot->stack != stack)
+            yDrvMpuSetClear(&slot->set);
+        slot->stack = stack;
+        slot->set.region[YDRV_MPU_SET_GUARD] = guard;
+        vTaskSetThreadLocalStoragePointer(task, OS_MPU_TLS_INDEX, &slot->set);
+        os_mpu_loaded = NULL; // 组内容可能正被使用，下次切换时重新装载
+    }
+    taskEXIT_CRITICAL();
+
+    return (slot != NULL) ? 0 : -1;
+}
+
+int32_t OsMpuTaskRegion(TaskHandle_t task, uint32_t index, uint32_t base, uint32_t size,
+                        yDrvMpuAccess_t access, uint32_t attr)
+{
+    yDrvMpuSet_t *set;
+    yDrvMpuRegion_t region;
+
+    if ((index >= OS_MPU_TASK_REGIONS) ||
+        (yDrvMpuRegionMake(&region, YDRV_MPU_SET_BASE + index, base, size, access, attr) != YDRV_OK))
+        return -1;
+
+    set = (yDrvMpuSet_t *)pvTaskGetThreadLocalStoragePointer(task, OS_MPU_TLS_INDEX);
+    if (set == NULL)
+        return -1;
+
+    taskENTER_CRITICAL();
+    set->region[index] = region;
+    if (set == os_mpu_loaded)
+        yDrvMpuLoadSet(set);
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+int32_t OsMpuGlobalRegion(uint32_t index, uint32_t base, uint32_t size, yDrvMpuAccess_t access, uint32_t attr)
+{
+    yDrvMpuRegion_t region;
+
+    if ((index >= YDRV_MPU_GLOBAL_REGIONS) ||
+        (yDrvMpuRegionMake(&region, index, base, size, access, attr) != YDRV_OK))
+        return -1;
+
+    yDrvMpuWrite(&region);
+    return 0;
+}
+
+void OsMpuStart(void)
+{
+    yDrvMpuSetClear(&os_mpu_none);
+    yDrvMpuLoadSet(&os_mpu_none);
+    os_mpu_loaded = &os_mpu_none;
+    yDrvMpuEnable(1);
+}
+
+void OsMpuSwitch(const void *set)
+{
+    const yDrvMpuSet_t *next = (set != NULL) ? (const yDrvMpuSet_t *)set : &os_mpu_none;
+
+    if (next != os_mpu_loaded)
+    {
+        yDrvMpuLoadSet(next);
+        os_mpu_loaded = next;
+    }
+}
+
+#endif /* OS_MPU_ENABLE */
@@ -0,0 +1,126 @@
+/**
+ ******************************************************************************
+ * @file       os_static.c
+ * @brief      静态任务的堆栈登记，以及空闲和定时器任务的静态存储
+ * @note       TaskStatus_t只给出堆栈起始地址，不含大小；任务创建时按起始地址登记大小，
+ *             堆栈用量报告据此算出已用比例。任务删除后登记保留，同一堆栈再次创建时覆盖
+ ******************************************************************************
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "os_static.h"
+#include "os_mpu.h"
+
+/**
+ * @brief 堆栈登记
+ */
+struct os_stack_info {
+    const StackType_t *base; /* 堆栈起始地址 */
+    uint32_t depth;          /* 堆栈大小(字) */
+};
+
+static struct os_stack_info os_stack_info[OS_TASK_MAX];
+
+#if (OS_SWITCH_COUNT_MAX > 0)
+/* 任务切入次数，由traceTASK_SWITCHED_IN递增 */
+volatile uint32_t os_switch_count[OS_SWITCH_COUNT_MAX];
+#endif
+
+OS_TASK_DEFINE(os_idle, configMINIMAL_STACK_SIZE);
+#if (configUSE_TIMERS == 1)
+OS_TASK_DEFINE(os_timer, configTIMER_TASK_STACK_DEPTH);
+#endif
+
+/**
+ * @brief 登记堆栈大小，登记表满时忽略
+ */
+static void os_stack_register(const StackType_t *base, uint32_t depth)
+{
+    UBaseType_t mask;
+    struct os_stack_info *slot = NULL;
+    unsigned int i;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    for (i = 0; i < OS_TASK_MAX; i++)
+    {
+        if (os_stack_info[i].base == base)
+        {
+            slot = &os_stack_info[i];
+            break;
+        }
+        if ((os_stack_info[i].base == NULL) && (slot == NULL))
+            slot = &os_stack_info[i];
+    }
+    if (slot != NULL)
+    {
+        slot->base = base;
+        slot->depth = depth;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+TaskHandle_t OsTaskCreate(TaskFunction_t entry, const char *name, uint32_t stack_words, void *param,
+                          UBaseType_t prio, StackType_t *stack, StaticTask_t *tcb)
+{
+    TaskHandle_t task;
+
+    os_stack_register(stack, stack_words);
+    task = xTaskCreateStatic(entry, name, stack_words, param, prio, stack, tcb);
+#if OS_MPU_ENABLE
+    (void)OsMpuTaskAttach(task, stack, stack_words);
+#endif
+    return task;
+}
+
+uint32_t OsTaskStackDepth(const StackType_t *stack_base)
+{
+    unsigned int i;
+
+    for (i = 0; i < OS_TASK_MAX; i++)
+    {
+        if (os_stack_info[i].base == stack_base)
+            return os_stack_info[i].depth;
+    }
+    return 0;
+}
+
+uint32_t OsTaskSwitchCount(UBaseType_t number)
+{
+#if (OS_SWITCH_COUNT_MAX > 0)
+    if (number < OS_SWITCH_COUNT_MAX)
+        return os_switch_count[number];
+#else
+    (void)number;
+#endif
+    return 0;
+}
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   configSTACK_DEPTH_TYPE *puxIdleTaskStackSize)
+{
+    os_stack_register(os_idle_stack, OS_ARRAY_LEN(os_idle_stack));
+    *ppxIdleTaskTCBBuffer = &os_idle_tcb;
+    *ppxIdleTaskStackBuffer = os_idle_stack;
+    *puxIdleTaskStackSize = OS_ARRAY_LEN(os_idle_stack);
+}
+
+#if (configUSE_TIMERS == 1)
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer,
+                                    configSTACK_DEPTH_TYPE *puxTimerTaskStackSize)
+{
+    os_stack_register(os_timer_stack, OS_ARRAY_LEN(os_timer_stack));
+    *ppxTimerTaskTCBBuffer = &os_timer_tcb;
+    *ppxTimerTaskStackBuffer = os_timer_stack;
+    *puxTimerTaskStackSize = OS_ARRAY_LEN(os_timer_stack);
+}
+#endif
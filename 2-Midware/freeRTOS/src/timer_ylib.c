@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file       timer_ylib.c
+ * @brief      以一个FreeRTOS定时器驱动yLib定时轮
+ * @note       FreeRTOS软件定时器按到期时间排序插入，启动/停止为O(n)且经过命令队列；
+ *             大量协议重传、按键消抖、空闲挂起等超时改挂在定时轮上，只占用一个周期为
+ *             YLIB_TIMER_TICK_MS的FreeRTOS定时器；定时轮操作很短，直接关中断保护，
+ *             到期回调在定时器服务任务中逐个取出后在关中断外执行
+ ******************************************************************************
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "os_static.h"
+#include "yLib_timer.h"
+
+#if (configUSE_TIMERS == 1) && !OS_IRQ_RUN_ENABLE
+
+/* 定时轮节拍对应的系统节拍数 */
+#define TIMER_WHEEL_TICKS pdMS_TO_TICKS(YLIB_TIMER_TICK_MS)
+
+static struct ylib_timer_wheel timer_wheel;
+static TimerHandle_t timer_wheel_handle;
+OS_TIMER_DEFINE(timer_wheel_handle);
+static TickType_t timer_wheel_last; /* 已计入定时轮的系统节拍 */
+
+/**
+ * @brief 驱动定时器回调：按经过的系统节拍推进定时轮并执行到期回调
+ * @note 服务任务被延迟时一次推进多个节拍，不丢失超时
+ */
+static void timer_wheel_tick(TimerHandle_t xTimer)
+{
+    struct ylib_timer *timer;
+    ylib_timer_func_t func;
+    void *arg;
+    UBaseType_t mask;
+    TickType_t elapsed;
+
+    (void)xTimer;
+
+    elapsed = (xTaskGetTickCount() - timer_wheel_last) / TIMER_WHEEL_TICKS;
+    timer_wheel_last += elapsed * TIMER_WHEEL_TICKS;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    if (elapsed != 0)
+        ylib_timer_wheel_advance(&timer_wheel, timer_wheel.now + elapsed - 1);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    for (;;)
+    {
+        mask = portSET_INTERRUPT_MASK_FROM_ISR();
+        timer = ylib_timer_wheel_expired(&timer_wheel);
+        if (timer != NULL)
+        {
+            func = timer->func;
+            arg = timer->arg;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+        if (timer == NULL)
+            break;
+        if (func != NULL)
+            func(arg);
+    }
+}
+
+int ylib_timer_service_init(void)
+{
+    if (timer_wheel_handle != NULL)
+        return 0;
+
+    ylib_timer_wheel_init(&timer_wheel, 0);
+    timer_wheel_last = xTaskGetTickCount();
+    timer_wheel_handle =
+        OS_TIMER_CREATE(timer_wheel_handle, "twheel", TIMER_WHEEL_TICKS, pdTRUE, NULL, timer_wheel_tick);
+    if (timer_wheel_handle == NULL)
+        return -1;
+    if (xTimerStart(timer_wheel_handle, portMAX_DELAY) != pdPASS)
+        return -1;
+    return 0;
+}
+
+void ylib_timer_start(struct ylib_timer *timer, uint32_t timeout_ms, uint32_t period_ms)
+{
+    UBaseType_t mask;
+    uint32_t ticks = (timeout_ms + YLIB_TIMER_TICK_MS - 1) / YLIB_TIMER_TICK_MS;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    timer->period = (period_ms + YLIB_TIMER_TICK_MS - 1) / YLIB_TIMER_TICK_MS;
+    ylib_timer_wheel_add(&timer_wheel, timer, timer_wheel.now + ticks);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+int ylib_timer_stop(struct ylib_timer *timer)
+{
+    UBaseType_t mask;
+    int ret;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    ret = ylib_timer_wheel_del(timer);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+#endif /* configUSE_TIMERS == 1 && !OS_IRQ_RUN_ENABLE */
@@ -0,0 +1,158 @@
+/**
+ ******************************************************************************
+ * @file       work_ylib.c
+ * @brief      yLib工作队列的FreeRTOS工作任务
+ * @note       每个队列一个工作任务，空闲时阻塞在任务通知上；提交只在队列由空变为非空时
+ *             发通知，工作任务每次唤醒后把队列取空再等待，之间到达的提交不会丢失唤醒；
+ *             队列操作很短，直接关中断保护，工作函数在关中断外执行，可以阻塞
+ ******************************************************************************
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "os_static.h"
+#include "yLib_work.h"
+
+#if !OS_IRQ_RUN_ENABLE
+
+_Static_assert(YLIB_WORK_TASK_PRIO - YLIB_WORK_PRIOS + 1 > tskIDLE_PRIORITY, "work task priority below idle");
+_Static_assert(YLIB_WORK_TASK_PRIO < configMAX_PRIORITIES, "work task priority out of range");
+
+static struct ylib_work_queue work_queue[YLIB_WORK_PRIOS];
+static TaskHandle_t work_task[YLIB_WORK_PRIOS];
+static StackType_t work_stack[YLIB_WORK_PRIOS][YLIB_WORK_STACK_SIZE] OS_STACK_SECTION;
+static StaticTask_t work_tcb[YLIB_WORK_PRIOS] OS_OBJECT_SECTION;
+static uint8_t work_ready; /* 队列已初始化 */
+
+/**
+ * @brief 队列初始化，服务启动前也可提交
+ */
+static void work_queue_setup(void)
+{
+    unsigned int i;
+
+    if (work_ready)
+        return;
+    for (i = 0; i < YLIB_WORK_PRIOS; i++)
+        ylib_work_queue_init(&work_queue[i]);
+    work_ready = 1;
+}
+
+/**
+ * @brief 工作任务：取空队列后等待通知
+ */
+static void work_task_entry(void *param)
+{
+    struct ylib_work_queue *queue = (struct ylib_work_queue *)param;
+    struct ylib_work *work;
+    ylib_work_func_t func;
+    void *arg;
+    UBaseType_t mask;
+
+    for (;;)
+    {
+        mask = portSET_INTERRUPT_MASK_FROM_ISR();
+        work = ylib_work_queue_take(queue);
+        if (work != NULL)
+        {
+            func = work->func;
+            arg = work->arg;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+        if (work == NULL)
+        {
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        if (func != NULL)
+            func(arg);
+    }
+}
+
+int ylib_work_service_init(void)
+{
+    char name[] = "work0";
+    UBaseType_t mask;
+    unsigned int i;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    work_queue_setup();
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    for (i = 0; i < YLIB_WORK_PRIOS; i++)
+    {
+        if (work_task[i] != NULL)
+            continue;
+        name[4] = (char)('0' + i);
+        work_task[i] = OsTaskCreate(work_task_entry, name, YLIB_WORK_STACK_SIZE, &work_queue[i],
+                                    YLIB_WORK_TASK_PRIO - i, work_stack[i], &work_tcb[i]);
+        if (work_task[i] == NULL)
+            return -1;
+    }
+    return 0;
+}
+
+int ylib_work_post(struct ylib_work *work)
+{
+    BaseType_t woken = pdFALSE;
+    TaskHandle_t task;
+    UBaseType_t mask;
+    int ret;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    work_queue_setup();
+    ret = ylib_work_queue_add(&work_queue[work->prio], work);
+    task = work_task[work->prio];
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    if ((ret > 0) && (task != NULL))
+    {
+        if (xPortIsInsideInterrupt())
+        {
+            vTaskNotifyGiveFromISR(task, &woken);
+            portYIELD_FROM_ISR(woken);
+        }
+        else
+        {
+            xTaskNotifyGive(task);
+        }
+    }
+    return (ret >= 0) ? 1 : 0;
+}
+
+int ylib_work_cancel(struct ylib_work *work)
+{
+    UBaseType_t mask;
+    int ret;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    work_queue_setup();
+    ret = ylib_work_queue_del(&work_queue[work->prio], work);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+int ylib_work_stats(unsigned int prio, struct ylib_work_queue *stats)
+{
+    UBaseType_t mask;
+
+    if (prio >= YLIB_WORK_PRIOS)
+        return -1;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    work_queue_setup();
+    *stats = work_queue[prio];
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return 0;
+}
+
+#endif /* !OS_IRQ_RUN_ENABLE */
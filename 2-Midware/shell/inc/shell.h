@@ -69,6 +69,12 @@
 #define SHELL_CMD_READ_ONLY \
     (1 << 14)
 
+/**
+ * @brief 长命令，可交给工作任务执行(SHELL_SUPPORT_BACKGROUND)
+ */
+#define SHELL_CMD_LONG \
+    (1 << 15)
+
 /**
  * @brief 命令参数数量
  */
@@ -383,6 +389,23 @@ typedef enum
 #endif
 } ShellCommandType;
 
+/**
+ * @brief 参数类型
+ *        解析输入时按参数的首字符和前缀确定，执行函数形式命令时据此转换，不再重新扫描参数
+ */
+typedef enum
+{
+    SHELL_PARAM_STRING = 0, /**< 字符串 */
+    SHELL_PARAM_QUOTED,     /**< 双引号字符串，首尾引号已去掉 */
+    SHELL_PARAM_CHAR,       /**< 单引号字符 */
+    SHELL_PARAM_VAR,        /**< $变量 */
+    SHELL_PARAM_DEC,        /**< 十进制整数 */
+    SHELL_PARAM_HEX,        /**< 0x十六进制整数 */
+    SHELL_PARAM_OCT,        /**< 0开头八进制整数 */
+    SHELL_PARAM_BIN,        /**< 0b二进制整数 */
+    SHELL_PARAM_FLOAT,      /**< 浮点数 */
+} ShellParamType;
+
 /**
  * @brief Shell定义
  */
@@ -406,6 +429,8 @@ typedef struct shell_def
         unsigned short cursor;                   /**< 当前光标位置 */
         char *buffer;                            /**< 输入缓冲 */
         char *param[SHELL_PARAMETER_MAX_NUMBER]; /**< 参数 */
+        unsigned short paramLength[SHELL_PARAMETER_MAX_NUMBER]; /**< 参数长度 */
+        unsigned char paramType[SHELL_PARAMETER_MAX_NUMBER];    /**< 参数类型(ShellParamType) */
         size_t bufferSize;                       /**< 输入缓冲大小 */
         unsigned short paramCount;               /**< 参数数量 */
         int keyValue;                            /**< 输入按键键值 */
@@ -424,12 +449,32 @@ typedef struct shell_def
         void *base;           /**< 命令表基址 */
         unsigned short count; /**< 命令数量 */
     } commandList;
+#if SHELL_OUTPUT_BUFFER > 0
+    struct
+    {
+        char buffer[SHELL_OUTPUT_BUFFER]; /**< 输出缓冲 */
+        unsigned short length;            /**< 缓冲中待写出的长度 */
+    } output;
+#endif /** SHELL_OUTPUT_BUFFER > 0 */
     struct
     {
         unsigned char isChecked : 1; /**< 密码校验通过 */
         unsigned char isActive : 1;  /**< 当前活动Shell */
         unsigned char tabFlag : 1;   /**< tab标志 */
+        unsigned char isScript : 1;  /**< 正在执行脚本 */
     } status;
+#if SHELL_SUPPORT_SCRIPT == 1
+    struct shell_script *script; /**< 接收中的脚本，为NULL时正常处理输入 */
+#endif /** SHELL_SUPPORT_SCRIPT == 1 */
+#if SHELL_SUPPORT_BACKGROUND == 1
+    struct
+    {
+        struct shell_command *command; /**< 交给工作任务的命令 */
+        volatile unsigned char busy;   /**< 命令正在工作任务中执行，输入只处理ctrl+c */
+        volatile unsigned char cancel; /**< 执行期间收到ctrl+c */
+    } background;
+    int (*exec)(struct shell_def *); /**< 通知工作任务执行长命令，返回0成功，为NULL时在当前任务执行 */
+#endif /** SHELL_SUPPORT_BACKGROUND == 1 */
     int32_t (*read)(void *, uint16_t);        /**< shell读函数 */
     int32_t (*write)(const void *, uint16_t); /**< shell写函数 */
 #if SHELL_USING_LOCK == 1
@@ -452,7 +497,7 @@ typedef struct shell_command
             unsigned char enableUnchecked : 1; /**< 在未校验密码的情况下可用 */
             unsigned char disableReturn : 1;   /**< 禁用返回值输出 */
             unsigned char readOnly : 1;        /**< 只读 */
-            unsigned char reserve : 1;         /**< 保留 */
+            unsigned char isLong : 1;          /**< 长命令 */
             unsigned char paramNum : 4;        /**< 参数数量 */
         } attrs;
         int value;
@@ -512,10 +557,18 @@ typedef struct
 
 #define shellDeInit(shell) shellRemove(shell)
 
+#if SHELL_SUPPORT_BACKGROUND == 1
+#define shellBusy(_shell) ((_shell)->background.busy)
+#else
+#define shellBusy(_shell) 0
+#endif /** SHELL_SUPPORT_BACKGROUND == 1 */
+
 void shellInit(Shell *shell, char *buffer, uint16_t size);
+void shellSetBuffer(Shell *shell, char *buffer, uint16_t size);
 void shellRemove(Shell *shell);
 unsigned short shellWriteString(Shell *shell, const char *string);
 void shellPrint(Shell *shell, const char *fmt, ...);
+void shellFlush(Shell *shell);
 void shellScan(Shell *shell, char *fmt, ...);
 Shell *shellGetCurrent(void);
 void shellHandler(Shell *shell, char data);
@@ -523,6 +576,31 @@ void shellWriteEndLine(Shell *shell, char *buffer, int len);
 void shellTask(void *param);
 int shellRun(Shell *shell, const char *cmd);
 
+#if SHELL_SUPPORT_BACKGROUND == 1
+void shellBackgroundRun(Shell *shell);
+#endif /** SHELL_SUPPORT_BACKGROUND == 1 */
+unsigned char shellCancelled(Shell *shell);
+
+#if SHELL_SUPPORT_SCRIPT == 1
+/**
+ * @brief shell脚本执行状态
+ */
+typedef struct shell_script
+{
+    unsigned short line;       /**< 已处理的行数 */
+    unsigned short executed;   /**< 已执行的命令数 */
+    unsigned short failed;     /**< 失败的命令数 */
+    unsigned short stopLine;   /**< 出错停止的行号，0为未停止 */
+    unsigned char stopOnError; /**< 出错后停止执行 */
+    unsigned char overflow;    /**< 当前行超过输入缓冲 */
+    char last;                 /**< 上一个输入字节 */
+} ShellScript;
+
+void shellScriptStart(ShellScript *script, unsigned char stopOnError);
+void shellScriptFeed(Shell *shell, ShellScript *script, const char *data, unsigned short length);
+int shellScriptEnd(Shell *shell, ShellScript *script);
+#endif /** SHELL_SUPPORT_SCRIPT == 1 */
+
 #if SHELL_USING_COMPANION == 1
 /**
  * @brief shell伴生对象定义
@@ -167,6 +167,38 @@
 #define SHELL_PRINT_BUFFER 128
 #endif /** SHELL_PRINT_BUFFER */
 
+#ifndef SHELL_OUTPUT_BUFFER
+/**
+ * @brief shell输出缓冲大小
+ *        回显、提示符和命令输出先写入shell对象的输出缓冲，缓冲满或调用`shellFlush()`时
+ *        一次调用`shell->write`写出，为0时每次输出直接调用`shell->write`
+ * @note 调用`shellHandler()`处理完一批输入后需要调用`shellFlush()`，`shellTask()`每个字节后自动写出；
+ *       命令中长时间等待前应调用`shellFlush()`，否则已输出的内容要等命令结束才能看到
+ */
+#define SHELL_OUTPUT_BUFFER 128
+#endif /** SHELL_OUTPUT_BUFFER */
+
+#ifndef SHELL_SUPPORT_SCRIPT
+/**
+ * @brief 支持脚本模式
+ *        使能后，`script`命令进入脚本接收模式，之后输入的命令不回显，以单独一行`.`结束后
+ *        连续执行，不输出提示符和返回值，只输出失败的行和汇总；也可以用`shellScriptFeed()`
+ *        执行存储在Flash等位置的脚本
+ */
+#define SHELL_SUPPORT_SCRIPT 1
+#endif /** SHELL_SUPPORT_SCRIPT */
+
+#ifndef SHELL_SUPPORT_BACKGROUND
+/**
+ * @brief 支持长命令在工作任务中执行
+ *        使能后，带`SHELL_CMD_LONG`属性的命令从命令行输入时交给`shell->exec`，由它通知
+ *        工作任务调用`shellBackgroundRun()`执行，shell任务继续处理输入；执行期间ctrl+c
+ *        置位取消标志，命令用`shellCancelled()`查询并提前结束，其他输入丢弃
+ * @note `shell->exec`为NULL时长命令照常在当前任务中执行；执行期间各会话的其他命令提示忙
+ */
+#define SHELL_SUPPORT_BACKGROUND 1
+#endif /** SHELL_SUPPORT_BACKGROUND */
+
 #ifndef SHELL_SCAN_BUFFER
 /**
  * @brief shell格式化输入的缓冲大小
@@ -257,6 +289,25 @@
 #define SHELL_USING_FUNC_SIGNATURE 0
 #endif /** SHELL_USING_FUNC_SIGNATURE */
 
+#ifndef SHELL_CMD_INDEX_MAX
+/**
+ * @brief 命令名排序索引容量
+ *        `shellInit()`时把命令、变量和用户按名称排序，查找命令和tab补全按二分查找，
+ *        每项2字节；定义超过此数量时退回线性查找
+ */
+#define SHELL_CMD_INDEX_MAX 128
+#endif /** SHELL_CMD_INDEX_MAX */
+
+#ifndef SHELL_KEY_INDEX_MAX
+/**
+ * @brief 按键索引容量
+ *        `shellInit()`时把命令表中的按键定义登记到索引并记录各按键首字节，
+ *        输入字节不是任何按键的首字节且不在按键序列中时直接作为普通字符处理，
+ *        按键定义超过此数量时退回遍历整个命令表
+ */
+#define SHELL_KEY_INDEX_MAX 16
+#endif /** SHELL_KEY_INDEX_MAX */
+
 #ifndef SHELL_SUPPORT_ARRAY_PARAM
 /**
  * @brief 支持数组参数
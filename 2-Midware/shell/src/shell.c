@@ -76,6 +76,15 @@ enum
 #if SHELL_EXEC_UNDEF_FUNC == 1
     SHELL_TEXT_PARAM_ERROR, /**< 参数错误 */
 #endif
+#if SHELL_SUPPORT_SCRIPT == 1
+    SHELL_TEXT_SCRIPT_HINT,      /**< 脚本输入提示 */
+    SHELL_TEXT_SCRIPT_NOT_FOUND, /**< 脚本命令未找到 */
+    SHELL_TEXT_SCRIPT_TOO_LONG,  /**< 脚本命令过长 */
+#endif
+#if SHELL_SUPPORT_BACKGROUND == 1
+    SHELL_TEXT_BUSY,      /**< 工作任务中有命令在执行 */
+    SHELL_TEXT_CANCELLED, /**< 命令被ctrl+c取消 */
+#endif
 };
 
 static const char *shellText[] =
@@ -137,6 +146,20 @@ static const char *shellText[] =
         [SHELL_TEXT_PARAM_ERROR] =
             "Parameter error\r\n",
 #endif
+#if SHELL_SUPPORT_SCRIPT == 1
+        [SHELL_TEXT_SCRIPT_HINT] =
+            "end with a single '.' line, ctrl+c to abort\r\n",
+        [SHELL_TEXT_SCRIPT_NOT_FOUND] =
+            "not found",
+        [SHELL_TEXT_SCRIPT_TOO_LONG] =
+            "too long",
+#endif
+#if SHELL_SUPPORT_BACKGROUND == 1
+        [SHELL_TEXT_BUSY] =
+            "another command is running\r\n",
+        [SHELL_TEXT_CANCELLED] =
+            "cancelled\r\n",
+#endif
 };
 
 unsigned char pairedChars[][2] = {
@@ -156,8 +179,34 @@ unsigned char pairedChars[][2] = {
  */
 static Shell *shellList[SHELL_MAX_NUMBER] = {NULL};
 
+/**
+ * @brief 命令表索引
+ *        命令表是链接段中的常量，所有shell共用一份索引，第一个shell初始化时建立
+ */
+static struct
+{
+    void *base; /**< 建立索引时的命令表基址 */
+    struct
+    {
+        unsigned short index[SHELL_CMD_INDEX_MAX]; /**< 命令、变量和用户按名称排序的下标 */
+        unsigned short count;                      /**< 已排序的定义数量，超过SHELL_CMD_INDEX_MAX时线性查找 */
+    } sorted;
+    struct
+    {
+        unsigned short index[SHELL_KEY_INDEX_MAX]; /**< 按键定义在命令表中的下标 */
+        unsigned short count;                      /**< 按键定义数量，超过SHELL_KEY_INDEX_MAX时遍历整个命令表 */
+        uint32_t first[8];                         /**< 按键首字节位图 */
+    } keys;
+} shellIndex;
+
 static void shellAdd(Shell *shell);
+static void shellBuildKeyIndex(Shell *shell);
+static void shellBuildSortedIndex(Shell *shell);
+static const char *shellGetCommandName(ShellCommand *command);
+static unsigned short shellSortedLowerBound(Shell *shell, const char *name, unsigned short length);
 static void shellWritePrompt(Shell *shell, unsigned char newline);
+static void shellCursorBack(Shell *shell, unsigned short count);
+static void shellReplaceLine(Shell *shell, const char *text, unsigned short length);
 static void shellWriteReturnValue(Shell *shell, int value);
 static int shellShowVar(Shell *shell, ShellCommand *command);
 void shellSetUser(Shell *shell, const ShellCommand *user);
@@ -166,19 +215,25 @@ ShellCommand *shellSeekCommand(Shell *shell,
                                ShellCommand *base,
                                unsigned short compareLength);
 static void shellWriteCommandHelp(Shell *shell, char *cmd);
+#if SHELL_SUPPORT_SCRIPT == 1
+static void shellScriptInput(Shell *shell, char data);
+#endif
+#if SHELL_SUPPORT_BACKGROUND == 1
+static unsigned char shellBackgroundBusy(void);
+#endif
 
 /**
- * @brief shell 初始化
+ * @brief 设置shell输入和历史记录缓冲区
  *
  * @param shell shell对象
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小
+ * @note 当前输入行和历史记录清空，用户和已注册的shell不变
  */
-void shellInit(Shell *shell, char *buffer, uint16_t size)
+void shellSetBuffer(Shell *shell, char *buffer, uint16_t size)
 {
     shell->parser.length = 0;
     shell->parser.cursor = 0;
-    shell->info.user = NULL;
-    shell->status.isChecked = 1;
-
     shell->parser.buffer = buffer;
     shell->parser.bufferSize = size / (SHELL_HISTORY_MAX_NUMBER + 1);
 
@@ -191,6 +246,30 @@ void shellInit(Shell *shell, char *buffer, uint16_t size)
         shell->history.item[i] = buffer + shell->parser.bufferSize * (i + 1);
     }
 #endif /** SHELL_HISTORY_MAX_NUMBER > 0 */
+}
+
+/**
+ * @brief shell 初始化
+ *
+ * @param shell shell对象
+ */
+void shellInit(Shell *shell, char *buffer, uint16_t size)
+{
+    shell->info.user = NULL;
+    shell->status.isChecked = 1;
+#if SHELL_SUPPORT_SCRIPT == 1
+    shell->script = NULL;
+#endif /** SHELL_SUPPORT_SCRIPT == 1 */
+#if SHELL_OUTPUT_BUFFER > 0
+    shell->output.length = 0;
+#endif /** SHELL_OUTPUT_BUFFER > 0 */
+#if SHELL_SUPPORT_BACKGROUND == 1
+    shell->background.command = NULL;
+    shell->background.busy = 0;
+    shell->background.cancel = 0;
+#endif /** SHELL_SUPPORT_BACKGROUND == 1 */
+
+    shellSetBuffer(shell, buffer, size);
 
 #if SHELL_USING_CMD_EXPORT == 1
 #if defined(__CC_ARM) || (defined(__ARMCC_VERSION) && __ARMCC_VERSION >= 6000000)
@@ -211,6 +290,12 @@ void shellInit(Shell *shell, char *buffer, uint16_t size)
     shell->commandList.count = shellCommandCount;
 #endif
 
+    if (shellIndex.base != shell->commandList.base)
+    {
+        shellBuildKeyIndex(shell);
+        shellBuildSortedIndex(shell);
+        shellIndex.base = shell->commandList.base;
+    }
     shellAdd(shell);
 
     shellSetUser(shell, shellSeekCommand(shell,
@@ -218,6 +303,7 @@ void shellInit(Shell *shell, char *buffer, uint16_t size)
                                          shell->commandList.base,
                                          0));
     shellWritePrompt(shell, 1);
+    shellFlush(shell);
 }
 
 /**
@@ -237,6 +323,107 @@ static void shellAdd(Shell *shell)
     }
 }
 
+/**
+ * @brief 建立按键索引
+ *
+ * @param shell shell对象
+ *
+ * @note 按命令表顺序登记按键定义，匹配顺序与遍历命令表相同
+ */
+static void shellBuildKeyIndex(Shell *shell)
+{
+    ShellCommand *base = (ShellCommand *)shell->commandList.base;
+    unsigned char first;
+
+    shellIndex.keys.count = 0;
+    memset(shellIndex.keys.first, 0, sizeof(shellIndex.keys.first));
+    for (unsigned short i = 0; i < shell->commandList.count; i++)
+    {
+        if (base[i].attr.attrs.type != SHELL_TYPE_KEY)
+        {
+            continue;
+        }
+        if (shellIndex.keys.count < SHELL_KEY_INDEX_MAX)
+        {
+            shellIndex.keys.index[shellIndex.keys.count] = i;
+        }
+        shellIndex.keys.count++;
+        first = (unsigned char)((unsigned int)base[i].data.key.value >> 24);
+        shellIndex.keys.first[first >> 5] |= 1UL << (first & 0x1F);
+    }
+}
+
+/**
+ * @brief 建立命令名排序索引
+ *
+ * @param shell shell对象
+ *
+ * @note 插入排序只在第一个shell初始化时执行一次，同名定义保持命令表中的先后顺序
+ */
+static void shellBuildSortedIndex(Shell *shell)
+{
+    ShellCommand *base = (ShellCommand *)shell->commandList.base;
+    unsigned short count = 0;
+    unsigned short j;
+    const char *name;
+
+    for (unsigned short i = 0; i < shell->commandList.count; i++)
+    {
+        if (base[i].attr.attrs.type == SHELL_TYPE_KEY)
+        {
+            continue;
+        }
+        if (count >= SHELL_CMD_INDEX_MAX)
+        {
+            count = SHELL_CMD_INDEX_MAX + 1;
+            break;
+        }
+        name = shellGetCommandName(&base[i]);
+        for (j = count; j > 0 && strcmp(shellGetCommandName(&base[shellIndex.sorted.index[j - 1]]), name) > 0; j--)
+        {
+            shellIndex.sorted.index[j] = shellIndex.sorted.index[j - 1];
+        }
+        shellIndex.sorted.index[j] = i;
+        count++;
+    }
+    shellIndex.sorted.count = count;
+}
+
+/**
+ * @brief 在排序索引中查找第一个不小于name的位置
+ *
+ * @param shell shell对象
+ * @param name 名称
+ * @param length 比较长度，0为完整比较
+ *
+ * @return unsigned short 排序索引中的位置
+ */
+static unsigned short shellSortedLowerBound(Shell *shell, const char *name, unsigned short length)
+{
+    ShellCommand *base = (ShellCommand *)shell->commandList.base;
+    unsigned short low = 0;
+    unsigned short high = shellIndex.sorted.count;
+    unsigned short mid;
+    const char *item;
+    int cmp;
+
+    while (low < high)
+    {
+        mid = low + (high - low) / 2;
+        item = shellGetCommandName(&base[shellIndex.sorted.index[mid]]);
+        cmp = length ? strncmp(item, name, length) : strcmp(item, name);
+        if (cmp < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
 /**
  * @brief 移除shell
  *
@@ -259,6 +446,10 @@ void shellRemove(Shell *shell)
  * @brief 获取当前活动shell
  *
  * @return Shell* 当前活动shell对象
+ *
+ * @note 命令执行期间所在shell为活动状态；多个shell由同一任务处理时
+ *       同一时刻只有一个在执行命令，返回的就是命令所在的shell；
+ *       工作任务执行长命令期间其他会话不执行命令，同样只有一个活动shell
  */
 Shell *shellGetCurrent(void)
 {
@@ -272,6 +463,52 @@ Shell *shellGetCurrent(void)
     return NULL;
 }
 
+/**
+ * @brief shell输出数据
+ *        使用输出缓冲时追加到缓冲，放不下时先写出缓冲，超过缓冲大小的数据直接写出
+ *
+ * @param shell shell对象
+ * @param data 数据
+ * @param length 数据长度
+ */
+static void shellOutput(Shell *shell, const char *data, unsigned short length)
+{
+#if SHELL_OUTPUT_BUFFER > 0
+    if (length > SHELL_OUTPUT_BUFFER - shell->output.length)
+    {
+        shellFlush(shell);
+    }
+    if (length >= SHELL_OUTPUT_BUFFER)
+    {
+        shell->write(data, length);
+        return;
+    }
+    memcpy(&shell->output.buffer[shell->output.length], data, length);
+    shell->output.length += length;
+#else
+    shell->write(data, length);
+#endif /** SHELL_OUTPUT_BUFFER > 0 */
+}
+
+/**
+ * @brief shell写出输出缓冲
+ *
+ * @param shell shell对象
+ */
+void shellFlush(Shell *shell)
+{
+#if SHELL_OUTPUT_BUFFER > 0
+    SHELL_ASSERT(shell && shell->write, return);
+    if (shell->output.length > 0)
+    {
+        shell->write(shell->output.buffer, shell->output.length);
+        shell->output.length = 0;
+    }
+#else
+    (void)shell;
+#endif /** SHELL_OUTPUT_BUFFER > 0 */
+}
+
 /**
  * @brief shell写字符
  *
@@ -280,7 +517,7 @@ Shell *shellGetCurrent(void)
  */
 static void shellWriteByte(Shell *shell, char data)
 {
-    shell->write(&data, 1);
+    shellOutput(shell, &data, 1);
 }
 
 /**
@@ -300,7 +537,8 @@ unsigned short shellWriteString(Shell *shell, const char *string)
     {
         count++;
     }
-    return shell->write((char *)string, count);
+    shellOutput(shell, string, count);
+    return count;
 }
 
 /**
@@ -324,12 +562,12 @@ static unsigned short shellWriteCommandDesc(Shell *shell, const char *string)
 
     if (count > 36)
     {
-        shell->write((char *)string, 36);
-        shell->write("...", 3);
+        shellOutput(shell, string, 36);
+        shellOutput(shell, "...", 3);
     }
     else
     {
-        shell->write((char *)string, count);
+        shellOutput(shell, string, count);
     }
     return count > 36 ? 36 : 39;
 }
@@ -343,6 +581,12 @@ static unsigned short shellWriteCommandDesc(Shell *shell, const char *string)
  */
 static void shellWritePrompt(Shell *shell, unsigned char newline)
 {
+#if SHELL_SUPPORT_SCRIPT == 1
+    if (shell->script != NULL)
+    {
+        return;
+    }
+#endif
     if (shell->status.isChecked)
     {
         if (newline)
@@ -383,7 +627,7 @@ void shellPrint(Shell *shell, const char *fmt, ...)
     {
         len = SHELL_PRINT_BUFFER;
     }
-    shell->write(buffer, len);
+    shellOutput(shell, buffer, len);
 }
 #endif
 
@@ -409,7 +653,8 @@ void shellScan(Shell *shell, char *fmt, ...)
         {
             if (shell->read(&buffer[index], 1) == 1)
             {
-                shell->write(&buffer[index], 1);
+                shellOutput(shell, &buffer[index], 1);
+                shellFlush(shell);
                 index++;
             }
         } while (buffer[index - 1] != '\r' && buffer[index - 1] != '\n' && index < SHELL_SCAN_BUFFER);
@@ -761,11 +1006,96 @@ void shellDeleteCommandLine(Shell *shell, unsigned char length)
  */
 void shellClearCommandLine(Shell *shell)
 {
-    for (short i = shell->parser.length - shell->parser.cursor; i > 0; i--)
+    shellCursorBack(shell, shell->parser.cursor);
+    for (unsigned short i = 0; i < shell->parser.length; i++)
     {
         shellWriteByte(shell, ' ');
     }
-    shellDeleteCommandLine(shell, shell->parser.length);
+    shellCursorBack(shell, shell->parser.length);
+}
+
+/**
+ * @brief shell光标左移
+ *        移动较远时用ANSI光标左移序列代替逐个退格
+ *
+ * @param shell shell对象
+ * @param count 移动的字符数
+ */
+static void shellCursorBack(Shell *shell, unsigned short count)
+{
+    char sequence[8];
+    unsigned char length = 0;
+    unsigned short value = count;
+
+    if (count <= 4)
+    {
+        while (count--)
+        {
+            shellWriteByte(shell, '\b');
+        }
+        return;
+    }
+
+    /* "\033[nD"，数字从后往前填 */
+    sequence[7] = 'D';
+    length = 7;
+    do
+    {
+        sequence[--length] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    sequence[--length] = '[';
+    sequence[--length] = '\033';
+    shellOutput(shell, &sequence[length], (unsigned short)(sizeof(sequence) - length));
+}
+
+/**
+ * @brief shell替换整行输入
+ *        只重画与原内容不同的后缀，原内容更长时用空格覆盖多出的部分，光标停在行尾
+ *
+ * @param shell shell对象
+ * @param text 新内容，不能指向输入缓冲
+ * @param length 新内容长度
+ */
+static void shellReplaceLine(Shell *shell, const char *text, unsigned short length)
+{
+    unsigned short common = 0;
+
+    if (length > shell->parser.bufferSize - 1)
+    {
+        length = shell->parser.bufferSize - 1;
+    }
+    while (common < length && common < shell->parser.length
+           && shell->parser.buffer[common] == text[common])
+    {
+        common++;
+    }
+
+    /* 光标移到第一个不同的字符处 */
+    if (shell->parser.cursor > common)
+    {
+        shellCursorBack(shell, shell->parser.cursor - common);
+    }
+    else if (shell->parser.cursor < common)
+    {
+        shellOutput(shell, &shell->parser.buffer[shell->parser.cursor],
+                    common - shell->parser.cursor);
+    }
+
+    shellOutput(shell, &text[common], length - common);
+    if (shell->parser.length > length)
+    {
+        for (unsigned short i = length; i < shell->parser.length; i++)
+        {
+            shellWriteByte(shell, ' ');
+        }
+        shellCursorBack(shell, shell->parser.length - length);
+    }
+
+    memcpy(&shell->parser.buffer[common], &text[common], length - common);
+    shell->parser.buffer[length] = 0;
+    shell->parser.length = length;
+    shell->parser.cursor = length;
 }
 
 /**
@@ -927,38 +1257,139 @@ int shellSplit(char *string, unsigned short strLen, char *array[], char splitKey
 }
 
 /**
- * @brief shell 解析参数
+ * @brief shell 按参数开头判断类型
  *
- * @param shell shell对象
+ * @param p 参数首字符
+ * @param end 输入结束位置
+ *
+ * @return ShellParamType 参数类型，数字中出现小数点时由调用者改为浮点
  */
-static void shellParserParam(Shell *shell)
+static unsigned char shellParamType(const char *p, const char *end)
 {
-    shell->parser.paramCount =
-        shellSplit(shell->parser.buffer, shell->parser.length,
-                   shell->parser.param, ' ', SHELL_PARAMETER_MAX_NUMBER);
+    if (*p == '\'')
+    {
+        return SHELL_PARAM_CHAR;
+    }
+    if (*p == '$')
+    {
+        return (p + 1 < end && p[1] != ' ') ? SHELL_PARAM_VAR : SHELL_PARAM_STRING;
+    }
+    if (*p == '-')
+    {
+        p++;
+    }
+    else if (*p < '0' || *p > '9')
+    {
+        return SHELL_PARAM_STRING;
+    }
+    if (p < end && *p == '0')
+    {
+        if (p + 1 < end && (p[1] == 'x' || p[1] == 'X'))
+        {
+            return SHELL_PARAM_HEX;
+        }
+        if (p + 1 < end && (p[1] == 'b' || p[1] == 'B'))
+        {
+            return SHELL_PARAM_BIN;
+        }
+        return SHELL_PARAM_OCT;
+    }
+    return SHELL_PARAM_DEC;
 }
 
 /**
- * @brief shell去除字符串参数头尾的双引号
+ * @brief shell 解析参数
+ *        一遍扫描输入缓冲，按空格切分的同时记录每个参数的位置、长度和类型；
+ *        双引号开头的参数去掉首尾引号，引号和数组括号内的空格不切分，反斜杠后的字符不参与切分和配对
  *
  * @param shell shell对象
  */
-static void shellRemoveParamQuotes(Shell *shell)
+static void shellParserParam(Shell *shell)
 {
-    unsigned short paramLength;
-    for (unsigned short i = 0; i < shell->parser.paramCount; i++)
+    char *p = shell->parser.buffer;
+    char *end = p + shell->parser.length;
+    char *start;
+    char *quote;
+    unsigned short count = 0;
+    unsigned char depth;
+    unsigned char type;
+
+    while (count < SHELL_PARAMETER_MAX_NUMBER)
     {
-        if (shell->parser.param[i][0] == '\"')
+        while (p < end && *p == ' ')
+        {
+            p++;
+        }
+        if (p >= end)
+        {
+            break;
+        }
+
+        start = p;
+        quote = NULL;
+        depth = 0;
+        if (*p == '\"')
+        {
+            /* 引号字符串：找到结尾引号，紧跟空格或输入结束时去掉首尾引号 */
+            start = ++p;
+            while (p < end && *p != '\"')
+            {
+                p += (*p == '\\' && p + 1 < end) ? 2 : 1;
+            }
+            if (p < end)
+            {
+                quote = p++;
+            }
+            type = SHELL_PARAM_QUOTED;
+        }
+        else
         {
-            shell->parser.param[i][0] = 0;
-            shell->parser.param[i] = &shell->parser.param[i][1];
+            type = shellParamType(p, end);
         }
-        paramLength = strlen(shell->parser.param[i]);
-        if (shell->parser.param[i][paramLength - 1] == '\"')
+
+        while (p < end && (*p != ' ' || depth != 0))
         {
-            shell->parser.param[i][paramLength - 1] = 0;
+            if (*p == '\\' && p + 1 < end)
+            {
+                p += 2;
+                continue;
+            }
+            if (*p == '\"')
+            {
+                depth ^= 0x01;
+            }
+#if SHELL_SUPPORT_ARRAY_PARAM == 1
+            else if (*p == '[' && !(depth & 0x01))
+            {
+                depth += 0x02;
+            }
+            else if (*p == ']' && depth >= 0x02 && !(depth & 0x01))
+            {
+                depth -= 0x02;
+            }
+#endif /** SHELL_SUPPORT_ARRAY_PARAM == 1 */
+            else if (*p == '.' && type >= SHELL_PARAM_DEC && p + 1 < end && p[1] != ' ')
+            {
+                type = SHELL_PARAM_FLOAT;
+            }
+            p++;
+        }
+
+        /* 结尾引号后还有字符时整体作为参数，只去掉开头引号 */
+        if (quote != NULL && quote + 1 == p)
+        {
+            p = quote;
+        }
+        shell->parser.param[count] = start;
+        shell->parser.paramLength[count] = (unsigned short)(p - start);
+        shell->parser.paramType[count] = type;
+        count++;
+        if (p < end)
+        {
+            *p++ = 0;
         }
     }
+    shell->parser.paramCount = count;
 }
 
 /**
@@ -976,8 +1407,30 @@ ShellCommand *shellSeekCommand(Shell *shell,
                                unsigned short compareLength)
 {
     const char *name;
-    unsigned short count = shell->commandList.count -
-                           ((size_t)base - (size_t)shell->commandList.base) / sizeof(ShellCommand);
+    unsigned short offset = ((size_t)base - (size_t)shell->commandList.base) / sizeof(ShellCommand);
+    unsigned short count = shell->commandList.count - offset;
+
+    /* 二分查找同名范围，范围内取命令表中最靠前的有权限定义，与线性查找结果一致 */
+    if (shellIndex.sorted.count <= SHELL_CMD_INDEX_MAX)
+    {
+        ShellCommand *list = (ShellCommand *)shell->commandList.base;
+        ShellCommand *found = NULL;
+        for (unsigned short k = shellSortedLowerBound(shell, cmd, compareLength); k < shellIndex.sorted.count; k++)
+        {
+            unsigned short i = shellIndex.sorted.index[k];
+            name = shellGetCommandName(&list[i]);
+            if ((compareLength ? strncmp(name, cmd, compareLength) : strcmp(name, cmd)) != 0)
+            {
+                break;
+            }
+            if (i >= offset && (found == NULL || &list[i] < found) && shellCheckPermission(shell, &list[i]) == 0)
+            {
+                found = &list[i];
+            }
+        }
+        return found;
+    }
+
     for (unsigned short i = 0; i < count; i++)
     {
         if (base[i].attr.attrs.type == SHELL_TYPE_KEY || shellCheckPermission(shell, &base[i]) != 0)
@@ -1185,12 +1638,13 @@ unsigned int shellRunCommand(Shell *shell, ShellCommand *command)
 {
     int returnValue = 0;
     shell->status.isActive = 1;
+    /* 命令执行时间不定，先写出回显 */
+    shellFlush(shell);
     if (command->attr.attrs.type == SHELL_TYPE_CMD_MAIN)
     {
-        shellRemoveParamQuotes(shell);
         int (*func)(int, char **) = command->data.cmd.function;
         returnValue = func(shell->parser.paramCount, shell->parser.param);
-        if (!command->attr.attrs.disableReturn)
+        if (!command->attr.attrs.disableReturn && !shell->status.isScript)
         {
             shellWriteReturnValue(shell, returnValue);
         }
@@ -1201,7 +1655,7 @@ unsigned int shellRunCommand(Shell *shell, ShellCommand *command)
                                   command,
                                   shell->parser.paramCount,
                                   shell->parser.param);
-        if (!command->attr.attrs.disableReturn)
+        if (!command->attr.attrs.disableReturn && !shell->status.isScript)
         {
             shellWriteReturnValue(shell, returnValue);
         }
@@ -1349,20 +1803,14 @@ static void shellHistory(Shell *shell, signed char dir)
     {
         return;
     }
-    shellClearCommandLine(shell);
     if (shell->history.offset == 0)
     {
-        shell->parser.cursor = shell->parser.length = 0;
+        shellReplaceLine(shell, "", 0);
     }
     else
     {
-        if ((shell->parser.length = shellStringCopy(shell->parser.buffer,
-                                                    shell->history.item[(shell->history.record + SHELL_HISTORY_MAX_NUMBER + shell->history.offset) % SHELL_HISTORY_MAX_NUMBER])) == 0)
-        {
-            return;
-        }
-        shell->parser.cursor = shell->parser.length;
-        shellWriteString(shell, shell->parser.buffer);
+        const char *item = shell->history.item[(shell->history.record + SHELL_HISTORY_MAX_NUMBER + shell->history.offset) % SHELL_HISTORY_MAX_NUMBER];
+        shellReplaceLine(shell, item, (unsigned short)strlen(item));
     }
 }
 #endif /** SHELL_HISTORY_MAX_NUMBER > 0 */
@@ -1411,14 +1859,32 @@ void shellExec(Shell *shell)
                                                  shell->parser.param[0],
                                                  shell->commandList.base,
                                                  0);
-        if (command != NULL)
+        if (command == NULL)
         {
-            shellRunCommand(shell, command);
+            shellWriteString(shell, shellText[SHELL_TEXT_CMD_NOT_FOUND]);
+            return;
         }
-        else
+#if SHELL_SUPPORT_BACKGROUND == 1
+        /* 工作任务中的命令可能正在用shellGetCurrent，不再让其他会话的命令成为活动shell */
+        if (shellBackgroundBusy())
         {
-            shellWriteString(shell, shellText[SHELL_TEXT_CMD_NOT_FOUND]);
+            shellWriteString(shell, shellText[SHELL_TEXT_BUSY]);
+            return;
         }
+        /* 只有命令行输入的长命令交给工作任务，命令中调用的shellRun和脚本需要等待结果 */
+        if (command->attr.attrs.isLong && shell->exec && !shell->status.isActive && !shell->status.isScript)
+        {
+            shell->background.command = command;
+            shell->background.cancel = 0;
+            shell->background.busy = 1;
+            if (shell->exec(shell) == 0)
+            {
+                return;
+            }
+            shell->background.busy = 0;
+        }
+#endif /** SHELL_SUPPORT_BACKGROUND == 1 */
+        shellRunCommand(shell, command);
     }
     else
     {
@@ -1426,6 +1892,63 @@ void shellExec(Shell *shell)
     }
 }
 
+#if SHELL_SUPPORT_BACKGROUND == 1
+/**
+ * @brief 是否有shell的命令在工作任务中执行
+ *
+ * @return unsigned char 1 有，0 没有
+ */
+static unsigned char shellBackgroundBusy(void)
+{
+    for (short i = 0; i < SHELL_MAX_NUMBER; i++)
+    {
+        if (shellList[i] && shellList[i]->background.busy)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 在工作任务中执行交给它的长命令
+ *        输出返回值和提示符并写出后才清除忙标志，此前shell任务不写这个shell的输出缓冲
+ *
+ * @param shell shell对象
+ */
+void shellBackgroundRun(Shell *shell)
+{
+    SHELL_ASSERT(shell && shell->background.busy, return);
+    shellRunCommand(shell, shell->background.command);
+    if (shell->background.cancel)
+    {
+        shellWriteString(shell, shellText[SHELL_TEXT_CANCELLED]);
+    }
+    shellWritePrompt(shell, 1);
+    shellFlush(shell);
+    shell->background.command = NULL;
+    shell->background.busy = 0;
+}
+#endif /** SHELL_SUPPORT_BACKGROUND == 1 */
+
+/**
+ * @brief 命令是否被取消
+ *        长命令在循环中查询，返回1时尽快结束；在shell任务中执行的命令收不到ctrl+c，总是返回0
+ *
+ * @param shell shell对象
+ *
+ * @return unsigned char 1 已取消，0 继续
+ */
+unsigned char shellCancelled(Shell *shell)
+{
+#if SHELL_SUPPORT_BACKGROUND == 1
+    return (shell && shell->background.cancel) ? 1 : 0;
+#else
+    (void)shell;
+    return 0;
+#endif /** SHELL_SUPPORT_BACKGROUND == 1 */
+}
+
 #if SHELL_HISTORY_MAX_NUMBER > 0
 /**
  * @brief shell上方向键输入
@@ -1502,8 +2025,23 @@ void shellTab(Shell *shell)
     {
         shell->parser.buffer[shell->parser.length] = 0;
         ShellCommand *base = (ShellCommand *)shell->commandList.base;
-        for (short i = 0; i < shell->commandList.count; i++)
+
+        /* 有排序索引时只遍历前缀相同的连续范围，按名称顺序列出 */
+        unsigned char sorted = shellIndex.sorted.count <= SHELL_CMD_INDEX_MAX;
+        unsigned short first = 0;
+        unsigned short last = shell->commandList.count;
+        if (sorted)
         {
+            first = shellSortedLowerBound(shell, shell->parser.buffer, shell->parser.length);
+            last = shellIndex.sorted.count;
+        }
+        for (unsigned short k = first; k < last; k++)
+        {
+            unsigned short i = sorted ? shellIndex.sorted.index[k] : k;
+            if (sorted && strncmp(shellGetCommandName(&base[i]), shell->parser.buffer, shell->parser.length) != 0)
+            {
+                break;
+            }
             if (shellCheckPermission(shell, &base[i]) == 0 && shellStringCompare(shell->parser.buffer,
                                                                                  (char *)shellGetCommandName(&base[i])) == shell->parser.length)
             {
@@ -1529,23 +2067,22 @@ void shellTab(Shell *shell)
         }
         if (matchNum == 1)
         {
-            shellClearCommandLine(shell);
+            /* 唯一匹配时只补出缺少的后缀 */
+            const char *name = shellGetCommandName(&base[lastMatchIndex]);
+            shellReplaceLine(shell, name, (unsigned short)strlen(name));
         }
-        if (matchNum != 0)
+        else
         {
             shell->parser.length =
                 shellStringCopy(shell->parser.buffer,
                                 (char *)shellGetCommandName(&base[lastMatchIndex]));
-        }
-        if (matchNum > 1)
-        {
             shellListItem(shell, &base[lastMatchIndex]);
             shellWritePrompt(shell, 1);
             shell->parser.length = maxMatch;
+            shell->parser.buffer[shell->parser.length] = 0;
+            shell->parser.cursor = shell->parser.length;
+            shellWriteString(shell, shell->parser.buffer);
         }
-        shell->parser.buffer[shell->parser.length] = 0;
-        shell->parser.cursor = shell->parser.length;
-        shellWriteString(shell, shell->parser.buffer);
     }
 
     if (SHELL_GET_TICK())
@@ -1612,7 +2149,11 @@ SHELL_EXPORT_KEY(SHELL_CMD_PERMISSION(0) | SHELL_CMD_ENABLE_UNCHECKED,
 void shellEnter(Shell *shell)
 {
     shellExec(shell);
-    shellWritePrompt(shell, 1);
+    /* 交给工作任务的命令结束后由工作任务输出提示符 */
+    if (!shellBusy(shell))
+    {
+        shellWritePrompt(shell, 1);
+    }
 }
 #if SHELL_ENTER_LF == 1
 SHELL_EXPORT_KEY(SHELL_CMD_PERMISSION(0) | SHELL_CMD_ENABLE_UNCHECKED,
@@ -1688,6 +2229,28 @@ void shellHandler(Shell *shell, char data)
     SHELL_ASSERT(data, return);
     SHELL_LOCK(shell);
 
+#if SHELL_SUPPORT_SCRIPT == 1
+    if (shell->script != NULL)
+    {
+        shellScriptInput(shell, data);
+        SHELL_UNLOCK(shell);
+        return;
+    }
+#endif
+
+#if SHELL_SUPPORT_BACKGROUND == 1
+    /* 工作任务在用输入缓冲中的参数和输出缓冲，只记录ctrl+c */
+    if (shell->background.busy)
+    {
+        if (data == 0x03)
+        {
+            shell->background.cancel = 1;
+        }
+        SHELL_UNLOCK(shell);
+        return;
+    }
+#endif
+
 #if SHELL_LOCK_TIMEOUT > 0
     if (shell->info.user->data.user.password && strlen(shell->info.user->data.user.password) != 0 && SHELL_GET_TICK())
     {
@@ -1717,10 +2280,19 @@ void shellHandler(Shell *shell, char data)
         keyFilter = 0xFF000000;
     }
 
-    /* 遍历ShellCommand列表，尝试进行按键键值匹配 */
+    /* 不在按键序列中且不是任何按键的首字节时不需要匹配 */
+    unsigned short count = 0;
+    unsigned char first = (unsigned char)data;
+    if (shell->parser.keyValue != 0x00000000 || (shellIndex.keys.first[first >> 5] & (1UL << (first & 0x1F))) != 0)
+    {
+        count = (shellIndex.keys.count <= SHELL_KEY_INDEX_MAX) ? shellIndex.keys.count : shell->commandList.count;
+    }
+
+    /* 遍历按键索引(按键定义过多时遍历整个命令表)，尝试进行按键键值匹配 */
     ShellCommand *base = (ShellCommand *)shell->commandList.base;
-    for (short i = 0; i < shell->commandList.count; i++)
+    for (unsigned short k = 0; k < count; k++)
     {
+        unsigned short i = (shellIndex.keys.count <= SHELL_KEY_INDEX_MAX) ? shellIndex.keys.index[k] : k;
         /* 判断是否是按键定义并验证权限 */
         if (base[i].attr.attrs.type == SHELL_TYPE_KEY && shellCheckPermission(shell, &(base[i])) == 0)
         {
@@ -1763,7 +2335,7 @@ void shellWriteEndLine(Shell *shell, char *buffer, int len)
     {
         shellWriteString(shell, shellText[SHELL_TEXT_CLEAR_LINE]);
     }
-    shell->write(buffer, len);
+    shellOutput(shell, buffer, len);
 
     if (!shell->status.isActive)
     {
@@ -1771,12 +2343,10 @@ void shellWriteEndLine(Shell *shell, char *buffer, int len)
         if (shell->parser.length > 0)
         {
             shellWriteString(shell, shell->parser.buffer);
-            for (short i = 0; i < shell->parser.length - shell->parser.cursor; i++)
-            {
-                shellWriteByte(shell, '\b');
-            }
+            shellCursorBack(shell, shell->parser.length - shell->parser.cursor);
         }
     }
+    shellFlush(shell);
     SHELL_UNLOCK(shell);
 }
 #endif /** SHELL_SUPPORT_END_LINE == 1 */
@@ -1798,6 +2368,7 @@ void shellTask(void *param)
         if (shell->read && shell->read(&data, 1) == 1)
         {
             shellHandler(shell, data);
+            shellFlush(shell);
         }
 #if SHELL_TASK_WHILE == 1
     }
@@ -1904,11 +2475,243 @@ int shellRun(Shell *shell, const char *cmd)
     {
         shell->parser.length = shellStringCopy(shell->parser.buffer, (char *)cmd);
         shellExec(shell);
+        shellFlush(shell);
         shell->status.isActive = active;
         return 0;
     }
 }
 
+#if SHELL_SUPPORT_SCRIPT == 1
+/**
+ * @brief shell写十进制数
+ *
+ * @param shell shell对象
+ * @param value 数值
+ */
+static void shellWriteDec(Shell *shell, int value)
+{
+    char buffer[12] = "00000000000";
+    shellWriteString(shell, &buffer[11 - shellToDec(value, buffer)]);
+}
+
+/**
+ * @brief shell脚本执行一行
+ *        `#`开头的行为注释，出错停止后只计行号
+ *
+ * @param shell shell对象
+ * @param script 脚本状态
+ */
+static void shellScriptRunLine(Shell *shell, ShellScript *script)
+{
+    ShellCommand *command;
+    const char *error = NULL;
+    int value = 0;
+
+    script->line++;
+    shell->parser.buffer[shell->parser.length] = 0;
+    if (script->stopLine != 0 || shell->parser.buffer[0] == '#')
+    {
+        shell->parser.length = shell->parser.cursor = 0;
+        script->overflow = 0;
+        return;
+    }
+
+    if (script->overflow)
+    {
+        error = shellText[SHELL_TEXT_SCRIPT_TOO_LONG];
+    }
+    else
+    {
+        shellParserParam(shell);
+        shell->parser.length = shell->parser.cursor = 0;
+        if (shell->parser.paramCount == 0)
+        {
+            return;
+        }
+        command = shellSeekCommand(shell,
+                                   shell->parser.param[0],
+                                   shell->commandList.base,
+                                   0);
+        if (command == NULL)
+        {
+            error = shellText[SHELL_TEXT_SCRIPT_NOT_FOUND];
+        }
+        else
+        {
+            /* 脚本可能由命令启动，恢复外层的活动和脚本标志 */
+            char active = shell->status.isActive;
+            char isScript = shell->status.isScript;
+            shell->status.isScript = 1;
+            value = (int)shellRunCommand(shell, command);
+            shell->status.isScript = isScript;
+            shell->status.isActive = active;
+        }
+    }
+    shell->parser.length = shell->parser.cursor = 0;
+    script->overflow = 0;
+    script->executed++;
+
+    if (error == NULL && value == 0)
+    {
+        return;
+    }
+    script->failed++;
+    shellWriteString(shell, "line ");
+    shellWriteDec(shell, script->line);
+    shellWriteString(shell, ": ");
+    if (error != NULL)
+    {
+        shellWriteString(shell, error);
+    }
+    else
+    {
+        shellWriteString(shell, "return ");
+        shellWriteDec(shell, value);
+    }
+    shellWriteString(shell, "\r\n");
+    if (script->stopOnError)
+    {
+        script->stopLine = script->line;
+    }
+}
+
+/**
+ * @brief shell脚本开始
+ *
+ * @param script 脚本状态
+ * @param stopOnError 命令失败后停止执行后续命令
+ */
+void shellScriptStart(ShellScript *script, unsigned char stopOnError)
+{
+    SHELL_ASSERT(script, return);
+    memset(script, 0, sizeof(ShellScript));
+    script->stopOnError = stopOnError;
+}
+
+/**
+ * @brief shell脚本输入数据
+ *        按`\r`、`\n`或`\r\n`分行，每行收齐后立即执行，数据可以分多次输入
+ *
+ * @param shell shell对象
+ * @param script 脚本状态
+ * @param data 脚本数据
+ * @param length 数据长度
+ *
+ * @note 行数据暂存在shell的输入缓冲中，在命令中调用时，调用后不能再使用该命令的参数
+ */
+void shellScriptFeed(Shell *shell, ShellScript *script, const char *data, unsigned short length)
+{
+    SHELL_ASSERT(shell && script && data, return);
+    for (unsigned short i = 0; i < length; i++)
+    {
+        if (data[i] == '\n' && script->last == '\r')
+        {
+            /* \r\n只算一个换行 */
+        }
+        else if (data[i] == '\r' || data[i] == '\n')
+        {
+            shellScriptRunLine(shell, script);
+        }
+        else if (shell->parser.length < shell->parser.bufferSize - 1)
+        {
+            shell->parser.buffer[shell->parser.length++] = data[i];
+        }
+        else
+        {
+            script->overflow = 1;
+        }
+        script->last = data[i];
+    }
+}
+
+/**
+ * @brief shell脚本结束
+ *        执行没有换行结尾的最后一行，输出执行汇总
+ *
+ * @param shell shell对象
+ * @param script 脚本状态
+ *
+ * @return int 失败的命令数
+ */
+int shellScriptEnd(Shell *shell, ShellScript *script)
+{
+    SHELL_ASSERT(shell && script, return -1);
+    if (shell->parser.length > 0 || script->overflow)
+    {
+        shellScriptRunLine(shell, script);
+    }
+    shellWriteString(shell, "script: ");
+    shellWriteDec(shell, script->executed);
+    shellWriteString(shell, " executed, ");
+    shellWriteDec(shell, script->failed);
+    shellWriteString(shell, " failed");
+    if (script->stopLine != 0)
+    {
+        shellWriteString(shell, ", stopped at line ");
+        shellWriteDec(shell, script->stopLine);
+    }
+    shellWriteString(shell, "\r\n");
+    shellFlush(shell);
+    return script->failed;
+}
+
+/**
+ * @brief shell脚本接收模式输入
+ *        不回显，单独一行`.`结束接收并输出汇总，ctrl+c放弃未执行的部分
+ *
+ * @param shell shell对象
+ * @param data 输入数据
+ */
+static void shellScriptInput(Shell *shell, char data)
+{
+    ShellScript *script = shell->script;
+
+    if (data == 0x03)
+    {
+        shell->script = NULL;
+        shell->parser.length = shell->parser.cursor = 0;
+        shellWriteString(shell, "^C");
+        shellWritePrompt(shell, 1);
+        return;
+    }
+    if ((data == '\r' || data == '\n') && shell->parser.length == 1 && shell->parser.buffer[0] == '.')
+    {
+        shell->script = NULL;
+        shell->parser.length = shell->parser.cursor = 0;
+        shellScriptEnd(shell, script);
+        shellWritePrompt(shell, 0);
+        return;
+    }
+    shellScriptFeed(shell, script, &data, 1);
+}
+
+/**
+ * @brief shell进入脚本接收模式(shell调用)
+ *
+ * @param argc 参数个数
+ * @param argv 参数，`-e`为命令失败后停止
+ * @return int 返回值
+ */
+int shellScriptCommand(int argc, char *argv[])
+{
+    /* 同一时间只有一个shell在接收脚本 */
+    static ShellScript script;
+    Shell *shell = shellGetCurrent();
+
+    if (shell == NULL || shell->status.isScript)
+    {
+        return -1;
+    }
+    shellScriptStart(&script, argc > 1 && strcmp(argv[1], "-e") == 0);
+    shell->script = &script;
+    shellWriteString(shell, shellText[SHELL_TEXT_SCRIPT_HINT]);
+    return 0;
+}
+SHELL_EXPORT_CMD(
+    SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN) | SHELL_CMD_DISABLE_RETURN,
+    script, shellScriptCommand, run commands in batch [-e]);
+#endif /** SHELL_SUPPORT_SCRIPT == 1 */
+
 #if SHELL_EXEC_UNDEF_FUNC == 1
 /**
  * @brief shell执行未定义函数
@@ -251,14 +251,14 @@ static char* shellExtParseString(char *string)
 
 
 /**
- * @brief 解析数字参数
+ * @brief 按已知进制解析数字参数
  * 
  * @param string 字符串参数
+ * @param type 进制
  * @return size_t 解析出的数字
  */
-static size_t shellExtParseNumber(char *string)
+static size_t shellExtParseNumberType(char *string, ShellNumType type)
 {
-    ShellNumType type = NUM_TYPE_DEC;
     char radix = 10;
     char *p = string;
     char offset = 0;
@@ -272,8 +272,6 @@ static size_t shellExtParseNumber(char *string)
         sign = -1;
     }
 
-    type = shellExtNumType(string + ((sign == -1) ? 1 : 0));
-
     switch ((char)type)
     {
     case NUM_TYPE_HEX:
@@ -321,6 +319,18 @@ static size_t shellExtParseNumber(char *string)
 }
 
 
+/**
+ * @brief 解析数字参数
+ * 
+ * @param string 字符串参数
+ * @return size_t 解析出的数字
+ */
+static size_t shellExtParseNumber(char *string)
+{
+    return shellExtParseNumberType(string, shellExtNumType(string + ((*string == '-') ? 1 : 0)));
+}
+
+
 /**
  * @brief 解析变量参数
  * 
@@ -450,6 +460,50 @@ int shellExtParsePara(Shell *shell, char *string, char *type, size_t *result)
 }
 
 
+/**
+ * @brief 按解析输入时记录的类型转换参数
+ * 
+ * @param shell shell对象
+ * @param string 参数
+ * @param paramType 参数类型(ShellParamType)
+ * @param result 解析结果
+ * 
+ * @return int 0 解析成功 --1 解析失败
+ */
+static int shellExtParseToken(Shell *shell, char *string, unsigned char paramType, size_t *result)
+{
+    static const unsigned char numType[] = {
+        NUM_TYPE_DEC, NUM_TYPE_HEX, NUM_TYPE_OCT, NUM_TYPE_BIN, NUM_TYPE_FLOAT
+    };
+
+    switch (paramType)
+    {
+    case SHELL_PARAM_CHAR:
+        *result = (size_t)shellExtParseChar(string);
+        return 0;
+    case SHELL_PARAM_VAR:
+        return shellExtParseVar(shell, string, result);
+    case SHELL_PARAM_DEC:
+    case SHELL_PARAM_HEX:
+    case SHELL_PARAM_OCT:
+    case SHELL_PARAM_BIN:
+    case SHELL_PARAM_FLOAT:
+        *result = shellExtParseNumberType(string, (ShellNumType)numType[paramType - SHELL_PARAM_DEC]);
+        return 0;
+    case SHELL_PARAM_QUOTED:
+        *result = (size_t)shellExtParseString(string);
+        return 0;
+    default:
+        if (*string)
+        {
+            *result = (size_t)shellExtParseString(string);
+            return 0;
+        }
+        return -1;
+    }
+}
+
+
 #if SHELL_USING_FUNC_SIGNATURE == 1
 /**
  * @brief 清理参数
@@ -641,7 +695,7 @@ int shellGetArrayParamSize(void *param)
  * @param shell shell对象
  * @param command 命令
  * @param argc 参数个数
- * @param argv 参数
+ * @param argv 参数，指向shell->parser.param中的某一项时类型取自对应的shell->parser.paramType
  * @return int 返回值
  */
 int shellExtRun(Shell *shell, ShellCommand *command, int argc, char *argv[])
@@ -650,6 +704,7 @@ int shellExtRun(Shell *shell, ShellCommand *command, int argc, char *argv[])
     size_t params[SHELL_PARAMETER_MAX_NUMBER] = {0};
     int paramNum = command->attr.attrs.paramNum > (argc - 1) ? 
         command->attr.attrs.paramNum : (argc - 1);
+    size_t typeBase = ((size_t)argv - (size_t)shell->parser.param) / sizeof(char *);
 #if SHELL_USING_FUNC_SIGNATURE == 1
     char type[16];
     int index = 0;
@@ -677,7 +732,16 @@ int shellExtRun(Shell *shell, ShellCommand *command, int argc, char *argv[])
         else
     #endif /** SHELL_USING_FUNC_SIGNATURE == 1 */
         {
-            if (shellExtParsePara(shell, argv[i + 1], NULL, &params[i]) != 0)
+            if (typeBase + i + 1 < SHELL_PARAMETER_MAX_NUMBER
+                && argv + i + 1 == &shell->parser.param[typeBase + i + 1])
+            {
+                if (shellExtParseToken(shell, argv[i + 1],
+                                       shell->parser.paramType[typeBase + i + 1], &params[i]) != 0)
+                {
+                    return -1;
+                }
+            }
+            else if (shellExtParsePara(shell, argv[i + 1], NULL, &params[i]) != 0)
             {
                 return -1;
             }
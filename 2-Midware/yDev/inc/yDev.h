@@ -33,6 +33,9 @@ extern "C"
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "yDev_config.h"
+#include "yLib_work.h"
+#include "yLib_list.h"
 
     // ==================== 基础类型定义 ====================
 
@@ -67,10 +70,20 @@ extern "C"
         YDEV_TYPE_USART,     /*!< USART串口通信设备 */
         YDEV_TYPE_SPI,       /*!< SPI串行外设接口设备 */
         YDEV_TYPE_25Q,       /*!< 25Q闪存设备 */
-
-        YDEV_TYPE_IIC, /*!< IIC总线接口设备 */
-        YDEV_TYPE_DMA, /*!< DMA直接内存访问设备 */
-        YDEV_TYPE_MAX  /*!< 设备类型最大值 */
+        YDEV_TYPE_25Q_FTL,   /*!< 25Q闪存磨损均衡转换层设备 */
+        YDEV_TYPE_SPI_SLAVE, /*!< SPI从机设备 */
+        YDEV_TYPE_GPIO_PORT, /*!< GPIO端口组设备(同一端口多引脚并行读写) */
+        YDEV_TYPE_TIM,       /*!< 定时器设备(PWM输出/输入捕获/单脉冲) */
+        YDEV_TYPE_ADC,       /*!< ADC流式采样设备(多通道扫描/DMA双缓冲) */
+
+        YDEV_TYPE_IIC,       /*!< IIC总线接口设备 */
+        YDEV_TYPE_DMA,       /*!< DMA直接内存访问设备 */
+        YDEV_TYPE_IFLASH,    /*!< 片内Flash数据区设备 */
+        YDEV_TYPE_FILE,      /*!< 文件系统中的文件 */
+        YDEV_TYPE_25Q_ARRAY, /*!< 多片25Q条带阵列设备 */
+        YDEV_TYPE_PBUS,      /*!< 8080/6800并行总线设备 */
+        YDEV_TYPE_KEYPAD,    /*!< 矩阵键盘扫描设备 */
+        YDEV_TYPE_MAX        /*!< 设备类型最大值 */
     } yDevType_t;
 
     /**
@@ -85,7 +98,9 @@ extern "C"
         YDEV_STATE_INITIALIZED,       /*!< 设备已初始化状态 */
         YDEV_STATE_OPENED,            /*!< 设备已打开状态 */
         YDEV_STATE_BUSY,              /*!< 设备忙碌状态 */
-        YDEV_STATE_ERROR              /*!< 设备错误状态 */
+        YDEV_STATE_SUSPENDED,         /*!< 设备已挂起(外设时钟关闭或外部器件掉电) */
+        YDEV_STATE_ERROR,             /*!< 设备错误状态 */
+        YDEV_STATE_DEFERRED           /*!< 已登记未初始化，首次访问时初始化(yDevInitLazy) */
     } yDevState_t;
 
     /**
@@ -102,6 +117,15 @@ extern "C"
         YDEV_MODE_NONBLOCK = 0x04 /*!< 非阻塞模式 */
     } yDevMode_t;
 
+    /**
+     * @brief 等待队列，操作函数见yDev_waitq.h
+     * @note 等待者记录在等待任务的栈上，队列本身只有一个链表头
+     */
+    typedef struct
+    {
+        struct ylib_list_head waiters; /*!< 按到达顺序排列的等待者 */
+    } yDevWaitQueue_t;
+
     // ==================== 设备操作函数指针 ====================
 
     /**
@@ -136,7 +160,7 @@ extern "C"
      * @param buffer 读取数据缓冲区指针
      * @param size 期望读取的字节数
      * @retval int32_t 实际读取的字节数，负数表示错误
-     * @note 用于从设备读取数据
+     * @note 用于从设备读取数据，长度不限于64KB，驱动内部按硬件限制分段
      * @brief 设备读取函数指针类型
      * @param handle 设备句柄指针
      * @param buffer 读取数据缓冲区指针
@@ -144,7 +168,7 @@ extern "C"
      * @retval int32_t 实际读取的字节数，负数表示错误
      * @note 用于从设备读取数据
      */
-    typedef int32_t (*yDevReadFunc_t)(void *handle, void *buffer, uint16_t size);
+    typedef int32_t (*yDevReadFunc_t)(void *handle, void *buffer, size_t size);
 
     /**
      * @brief 设备写入函数指针类型
@@ -152,7 +176,7 @@ extern "C"
      * @param buffer 写入数据缓冲区指针
      * @param size 期望写入的字节数
      * @retval int32_t 实际写入的字节数，负数表示错误
-     * @note 用于向设备写入数据
+     * @note 用于向设备写入数据，长度不限于64KB，驱动内部按硬件限制分段
      * @brief 设备写入函数指针类型
      * @param handle 设备句柄指针
      * @param buffer 写入数据缓冲区指针
@@ -160,7 +184,7 @@ extern "C"
      * @retval int32_t 实际写入的字节数，负数表示错误
      * @note 用于向设备写入数据
      */
-    typedef int32_t (*yDevWriteFunc_t)(void *handle, const void *buffer, uint16_t size);
+    typedef int32_t (*yDevWriteFunc_t)(void *handle, const void *buffer, size_t size);
 
     /**
      * @brief 设备控制函数指针类型
@@ -178,6 +202,77 @@ extern "C"
      */
     typedef yDevStatus_t (*yDevIoctlFunc_t)(void *handle, uint32_t cmd, void *arg);
 
+    /**
+     * @brief 设备异步读取函数指针类型
+     * @param handle 设备句柄指针
+     * @param buffer 读取数据缓冲区指针，完成前必须保持有效
+     * @param size 期望读取的字节数
+     * @retval yDevStatus_t 启动状态，YDEV_OK表示传输已启动或已完成
+     * @note 传输结束时驱动调用yDevAsyncComplete，启动失败时不得调用
+     */
+    typedef yDevStatus_t (*yDevReadAsyncFunc_t)(void *handle, void *buffer, size_t size);
+
+    /**
+     * @brief 设备异步写入函数指针类型
+     * @param handle 设备句柄指针
+     * @param buffer 写入数据缓冲区指针，完成前必须保持有效
+     * @param size 期望写入的字节数
+     * @retval yDevStatus_t 启动状态，YDEV_OK表示传输已启动或已完成
+     * @note 传输结束时驱动调用yDevAsyncComplete，启动失败时不得调用
+     */
+    typedef yDevStatus_t (*yDevWriteAsyncFunc_t)(void *handle, const void *buffer, size_t size);
+
+    /**
+     * @brief 向量读写分段描述符
+     * @note 写入时base指向的数据只读，读取时写入base
+     */
+    typedef struct
+    {
+        void *base; /*!< 分段缓冲区 */
+        size_t len; /*!< 分段字节数 */
+    } yDevIoVec_t;
+
+    /**
+     * @brief 零拷贝缓冲区链，定义见yLib_pbuf.h
+     */
+    struct ylib_pbuf;
+
+    /**
+     * @brief 设备向量读取函数指针类型
+     * @param handle 设备句柄指针
+     * @param iov 分段描述符数组
+     * @param count 分段数量
+     * @retval int32_t 实际读取的总字节数，负数表示错误
+     * @note 各分段按顺序填充，等同于对拼接后的缓冲区做一次读取
+     */
+    typedef int32_t (*yDevReadvFunc_t)(void *handle, const yDevIoVec_t *iov, uint32_t count);
+
+    /**
+     * @brief 设备向量写入函数指针类型
+     * @param handle 设备句柄指针
+     * @param iov 分段描述符数组
+     * @param count 分段数量
+     * @retval int32_t 实际写入的总字节数，负数表示错误
+     * @note 各分段按顺序发出，等同于对拼接后的缓冲区做一次写入
+     */
+    typedef int32_t (*yDevWritevFunc_t)(void *handle, const yDevIoVec_t *iov, uint32_t count);
+
+    /**
+     * @brief 设备挂起函数指针类型
+     * @param handle 设备句柄指针
+     * @retval yDevStatus_t 设备操作状态，YDEV_BUSY表示当前不能挂起
+     * @note 关闭外设时钟、外部器件进入掉电模式等，配置保留在句柄中
+     */
+    typedef yDevStatus_t (*yDevSuspendFunc_t)(void *handle);
+
+    /**
+     * @brief 设备恢复函数指针类型
+     * @param handle 设备句柄指针
+     * @retval yDevStatus_t 设备操作状态
+     * @note 撤销挂起，返回后设备可以直接读写
+     */
+    typedef yDevStatus_t (*yDevResumeFunc_t)(void *handle);
+
     // ==================== 设备操作结构体 ====================
 
     /**
@@ -194,8 +289,113 @@ extern "C"
         yDevReadFunc_t read;     // 读取函数
         yDevWriteFunc_t write;   // 写入函数
         yDevIoctlFunc_t ioctl;   // 控制函数// 操作函数表
+        yDevReadAsyncFunc_t read_async;   /*!< 异步读取函数指针，NULL表示不支持 */
+        yDevWriteAsyncFunc_t write_async; /*!< 异步写入函数指针，NULL表示不支持 */
+        yDevReadvFunc_t readv;            /*!< 向量读取函数指针，NULL时逐段调用read */
+        yDevWritevFunc_t writev;          /*!< 向量写入函数指针，NULL时逐段调用write */
+        yDevSuspendFunc_t suspend;        /*!< 挂起函数指针，NULL表示不支持电源管理 */
+        yDevResumeFunc_t resume;          /*!< 恢复函数指针 */
     } yDevOps_t;
 
+    // ==================== 异步传输类型定义 ====================
+
+    /**
+     * @brief 异步传输方向
+     * @note 每个设备句柄每个方向同时只有一个异步传输
+     */
+    typedef enum
+    {
+        YDEV_ASYNC_READ = 0, /*!< 异步读取 */
+        YDEV_ASYNC_WRITE,    /*!< 异步写入 */
+        YDEV_ASYNC_MAX       /*!< 方向数量 */
+    } yDevAsyncDir_t;
+
+    /**
+     * @brief 异步传输完成回调函数类型
+     * @param arg 用户参数
+     * @param status 传输结果
+     * @param len 实际传输的字节数
+     * @note 可能在中断中执行，不得阻塞；回调中可以启动同方向的下一次传输
+     */
+    typedef void (*yDevAsyncCallback_t)(void *arg, yDevStatus_t status, uint32_t len);
+
+    /**
+     * @brief 异步传输状态
+     */
+    typedef struct
+    {
+        yDevAsyncCallback_t callback; /*!< 完成回调，可为NULL */
+        void *arg;                    /*!< 回调参数 */
+        uint32_t size;                /*!< 请求的字节数 */
+        volatile uint32_t len;        /*!< 实际传输的字节数 */
+        volatile yDevStatus_t status; /*!< 传输结果，进行中为YDEV_BUSY */
+        volatile uint8_t pending;     /*!< 传输进行中标志 */
+    } yDevAsync_t;
+
+    /**
+     * @brief 转交工作项的异步完成
+     * @note 以yDevAsyncWorkDone为完成回调、本结构为回调参数，完成时只记录结果并提交工作项，
+     *       处理放在工作项中执行；中断运行模式(OS_IRQ_RUN_ENABLE)下工作项在软件中断中执行
+     */
+    typedef struct
+    {
+        struct ylib_work work;        /*!< 完成时提交的工作项，参数为本结构 */
+        volatile yDevStatus_t status; /*!< 传输结果 */
+        volatile uint32_t len;        /*!< 实际传输的字节数 */
+    } yDevAsyncWork_t;
+
+    // ==================== 操作统计类型定义 ====================
+
+    /**
+     * @brief 统计的操作类别
+     * @note 向量读写分别计入读取和写入
+     */
+    typedef enum
+    {
+        YDEV_STAT_READ = 0, /*!< 读取 */
+        YDEV_STAT_WRITE,    /*!< 写入 */
+        YDEV_STAT_IOCTL,    /*!< 控制 */
+        YDEV_STAT_MAX       /*!< 类别数量 */
+    } yDevStatOp_t;
+
+    /**
+     * @brief 单类操作的统计
+     * @note 耗时以微秒计，包含挂起设备的恢复时间，不含等待句柄锁的时间
+     */
+    typedef struct
+    {
+        uint32_t count;    /*!< 调用次数 */
+        uint32_t bytes;    /*!< 成功传输的字节数，控制操作为0 */
+        uint32_t errors;   /*!< 返回负数或非YDEV_OK的次数 */
+        uint32_t min_us;   /*!< 最短耗时，没有调用时为0xFFFFFFFF */
+        uint32_t max_us;   /*!< 最长耗时 */
+        uint32_t total_us; /*!< 累计耗时，除以count得平均值 */
+    } yDevOpStats_t;
+
+    /**
+     * @brief 设备唤醒统计
+     * @note 处于OPENED或BUSY状态的时间计为唤醒，挂起、延迟初始化和出错的时间不计；
+     *       不支持挂起的设备从初始化起一直计为唤醒
+     */
+    typedef struct
+    {
+        uint64_t awake_us; /*!< 累计唤醒时间(微秒) */
+        uint32_t wakes;    /*!< 从挂起恢复和延迟初始化的次数 */
+        uint32_t since_us; /*!< 未计入部分的起点，读取接口已计入，调用者不使用 */
+    } yDevPmUsage_t;
+
+    /**
+     * @brief CPU睡眠统计
+     * @note 运行时间为上电时间减去两项睡眠时间
+     */
+    typedef struct
+    {
+        uint64_t sleep_us; /*!< 普通睡眠(WFI，外设时钟照常)的累计时间(微秒) */
+        uint64_t stop_us;  /*!< STOP模式的累计时间(微秒) */
+        uint32_t sleeps;   /*!< 普通睡眠次数 */
+        uint32_t stops;    /*!< 进入STOP模式的次数 */
+    } yDevPmCpuStats_t;
+
     // ==================== 设备句柄结构体 ====================
 
     /**
@@ -205,7 +405,9 @@ extern "C"
     {
         yDevType_t type; // 设备类型
         uint32_t timeOutMs;
-        // uint32_t use_mutex; // 是否使用锁
+        uint32_t use_mutex; /*!< 非0时为句柄创建互斥锁，多个任务访问同一设备时串行化(需YDEV_USE_MUTEX) */
+        const char *name;   /*!< 注册名(如"uart3")，初始化时登记到设备注册表，NULL表示不注册 */
+        uint32_t idle_ms;   /*!< 空闲多久后由yDevPmProcess自动挂起(毫秒)，0表示不自动挂起，须同时设置name */
     } yDevConfig_t;
 
     /**
@@ -213,10 +415,28 @@ extern "C"
      */
     typedef struct
     {
-        uint32_t index;
+        uint32_t index; /*!< 操作表序号，即设备类型 */
         uint32_t timeOutMs;
         uint32_t errno;
-        // void *mutex; // 互斥锁（可选）
+#if YDEV_USE_MUTEX
+        void *mutex; /*!< 句柄互斥锁(递归，带优先级继承)，NULL表示不加锁 */
+#endif
+        yDevAsync_t async[YDEV_ASYNC_MAX]; /*!< 读写两个方向的异步传输状态 */
+        yDevWaitQueue_t waitq;             /*!< 在yDevWait中等待的任务，可有多个 */
+        volatile uint32_t revents;         /*!< 驱动登记、尚未被yDevPoll取走的就绪事件 */
+        void *volatile poll_task;          /*!< 在yDevPoll中等待的任务句柄 */
+        volatile yDevState_t state;        /*!< 设备状态 */
+        volatile uint32_t active;          /*!< 进行中的操作数(含异步传输)，非0时不挂起 */
+        uint32_t idle_ms;                  /*!< 自动挂起空闲时间(毫秒)，0表示不自动挂起 */
+        volatile uint32_t last_ms;         /*!< 最近一次操作结束的时间 */
+        void *config;                      /*!< 延迟初始化的配置，首次访问时交给驱动，须一直有效 */
+        volatile uint32_t refs;            /*!< 引用计数，打开加一、yDevDeinitStatic减一，归零时反初始化 */
+#if YDEV_STATS_ENABLE
+        yDevOpStats_t op_stats[YDEV_STAT_MAX]; /*!< 读写和控制的操作统计 */
+#endif
+#if YDEV_PM_ACCOUNT
+        yDevPmUsage_t pm_usage; /*!< 唤醒时间和次数 */
+#endif
     } yDevHandle_t;
 
 // ==================== yDev基础配置初始化宏 ====================
@@ -246,6 +466,64 @@ extern "C"
 #define YDEV_IOCTL_BASE 0x8000
 #define YDEV_IOCTL_GET_STATUS (YDEV_IOCTL_BASE + 0)
 #define YDEV_IOCTL_RESET (YDEV_IOCTL_BASE + 1)
+#define YDEV_IOCTL_POLL (YDEV_IOCTL_BASE + 2) /**< 查询当前就绪事件(arg: uint32_t*)，由yDevPoll调用 */
+
+// ==================== 就绪事件定义 ====================
+
+/**
+ * @brief yDevPoll就绪事件
+ */
+#define YDEV_POLLIN (1UL << 0)   /**< 有数据可读，或异步读取结束 */
+#define YDEV_POLLOUT (1UL << 1)  /**< 可以写入，或异步写入结束 */
+#define YDEV_POLLERR (1UL << 2)  /**< 异步传输失败，不需要在关注事件中指定 */
+#define YDEV_POLLWAKE (1UL << 3) /**< 由yDevPollWake登记，不需要在关注事件中指定 */
+
+/**
+ * @brief yDevPoll只查询不等待的超时值
+ */
+#define YDEV_POLL_NOWAIT (0xFFFFFFFFUL)
+
+/**
+ * @brief yDevPmProcess没有待挂起设备时的返回值
+ */
+#define YDEV_PM_NEVER (0xFFFFFFFFUL)
+
+// ==================== 分级初始化 ====================
+
+/**
+ * @brief 初始化级别，按数值顺序执行
+ * @note 级别写在段名中由链接脚本排序，须为数字字面量
+ */
+#define YDEV_INIT_BOARD 0    /**< yLabInit末尾，调度器启动前，不能调用RTOS接口 */
+#define YDEV_INIT_DEVICE 1   /**< 启动任务中、创建应用任务前，只做登记和快速初始化 */
+#define YDEV_INIT_DEFERRED 2 /**< 应用任务创建后以低优先级执行，慢速器件的探测和自检 */
+#define YDEV_INIT_LEVEL_MAX 3
+
+    /**
+     * @brief 初始化表项
+     */
+    typedef struct
+    {
+        int32_t (*init)(void); /*!< 初始化函数，返回负数表示失败 */
+        const char *name;      /*!< 函数名 */
+        uint32_t level;        /*!< 初始化级别 */
+    } yDevInitEntry_t;
+
+#define YDEV_INIT_SECTION(_level) ".ydev_init." #_level
+
+/**
+ * @brief 导出初始化函数
+ * @param _func 初始化函数，int32_t (*)(void)
+ * @param _level 初始化级别YDEV_INIT_xxx
+ * @note 同一级别内的执行顺序由链接顺序决定，有先后依赖的步骤放在同一个函数中
+ */
+#define YDEV_INIT_EXPORT(_func, _level)                                                     \
+    YLIB_USED const yDevInitEntry_t ydev_init_##_func YLIB_SECTION(YDEV_INIT_SECTION(_level)) = \
+        {                                                                                   \
+            .init = _func,                                                                  \
+            .name = #_func,                                                                 \
+            .level = (_level),                                                              \
+    }
 
     // ==================== 核心API函数 ====================
 
@@ -254,16 +532,68 @@ extern "C"
      * @param config 配置参数
      * @param handle 设备句柄
      * @retval 设备状态
+     * @note 配置了name且同一句柄已用该名称打开时只增加引用计数，不重新初始化硬件
      */
     yDevStatus_t yDevInitStatic(void *config, void *handle);
 
     /**
-     * @brief 反初始化设备
+     * @brief 释放设备
      * @param handle 设备句柄
      * @retval 设备状态
+     * @note 每次成功的yDevInitStatic、yDevInitLazy或yDevOpen对应一次调用，
+     *       最后一次释放时才调用驱动反初始化；反初始化失败时保留这次引用
      */
     yDevStatus_t yDevDeinitStatic(void *handle);
 
+    /**
+     * @brief 按名称打开已登记的设备
+     * @param name 设备名
+     * @retval void* 设备句柄，未登记或正在关闭时返回NULL
+     * @note 只增加引用计数，不访问硬件；用完后调用yDevDeinitStatic释放
+     */
+    void *yDevOpen(const char *name);
+
+    /**
+     * @brief 登记设备，推迟到首次访问时初始化
+     * @param config 配置参数，须一直有效
+     * @param handle 设备句柄
+     * @retval 设备状态
+     * @note 只查找驱动并登记名称，不访问硬件；首次经yDev接口读写、控制或yDevProbe时调用驱动初始化，
+     *       失败时保持延迟状态，下次访问重试；多个任务可能同时首次访问时须配置use_mutex
+     */
+    yDevStatus_t yDevInitLazy(void *config, void *handle);
+
+    /**
+     * @brief 完成延迟的初始化
+     * @param handle 设备句柄
+     * @retval 设备状态，已初始化时直接返回YDEV_OK
+     */
+    yDevStatus_t yDevProbe(void *handle);
+
+    /**
+     * @brief 执行一个级别的初始化函数
+     * @param level 初始化级别YDEV_INIT_xxx
+     * @retval 失败的函数数
+     * @note 记录每个函数的耗时和该级别完成的时间，shell的boot命令查看
+     */
+    uint32_t yDevInitRun(uint32_t level);
+
+    /**
+     * @brief 遍历初始化表
+     * @param index 表项序号，从0开始
+     * @param us 输出该函数的耗时(微秒)，未执行时为0，可为NULL
+     * @param ret 输出该函数的返回值，可为NULL
+     * @retval 表项，超出范围时返回NULL
+     */
+    const yDevInitEntry_t *yDevInitIterate(uint32_t index, uint32_t *us, int32_t *ret);
+
+    /**
+     * @brief 获取级别完成的时间
+     * @param level 初始化级别
+     * @retval 完成时的微秒时间戳，尚未完成时返回0
+     */
+    uint32_t yDevInitDoneUs(uint32_t level);
+
     /**
      * @brief 读取设备数据
      * @param handle 设备句柄
@@ -271,7 +601,7 @@ extern "C"
      * @param size 读取大小
      * @retval 实际读取的字节数，负数表示错误
      */
-    size_t yDevRead(void *handle, void *buffer, size_t size);
+    int32_t yDevRead(void *handle, void *buffer, size_t size);
 
     /**
      * @brief 写入设备数据
@@ -280,7 +610,38 @@ extern "C"
      * @param size 写入大小
      * @retval 实际写入的字节数，负数表示错误
      */
-    size_t yDevWrite(void *handle, const void *buffer, size_t size);
+    int32_t yDevWrite(void *handle, const void *buffer, size_t size);
+
+    /**
+     * @brief 向量读取设备数据
+     * @param handle 设备句柄
+     * @param iov 分段描述符数组
+     * @param count 分段数量
+     * @retval 实际读取的总字节数，负数表示错误
+     * @note 驱动提供readv时整组一次传输，否则逐段读取，某段读取不足时停止
+     */
+    int32_t yDevReadv(void *handle, const yDevIoVec_t *iov, uint32_t count);
+
+    /**
+     * @brief 向量写入设备数据
+     * @param handle 设备句柄
+     * @param iov 分段描述符数组
+     * @param count 分段数量
+     * @retval 实际写入的总字节数，负数表示错误
+     * @note 用于头部、载荷、校验分处不同缓冲区时免拷贝拼接；
+     *       驱动提供writev时整组一次传输，否则逐段写入，某段写入不足时停止
+     */
+    int32_t yDevWritev(void *handle, const yDevIoVec_t *iov, uint32_t count);
+
+    /**
+     * @brief 写入一条零拷贝缓冲区链
+     * @param handle 设备句柄
+     * @param p 缓冲区链(ylib_pbuf_t)，调用者保留引用，返回后可释放
+     * @retval 实际写入的总字节数，负数表示错误
+     * @note 各段直接作为yDevWritev的分段，不拷贝到中间缓冲区；
+     *       超过YDEV_PBUF_IOV_MAX段时分批写入，批与批之间可能插入其他任务的写入
+     */
+    int32_t yDevWritePbuf(void *handle, const struct ylib_pbuf *p);
 
     /**
      * @brief 设备控制
@@ -291,10 +652,287 @@ extern "C"
      */
     yDevStatus_t yDevIoctl(void *handle, uint32_t cmd, void *arg);
 
+    /**
+     * @brief 启动异步读取
+     * @param handle 设备句柄
+     * @param buffer 读取缓冲区，完成前必须保持有效
+     * @param size 读取大小
+     * @param callback 完成回调，可为NULL
+     * @param arg 回调参数
+     * @retval yDevStatus_t 启动状态
+     *         - YDEV_OK: 已启动，结果由回调或yDevWait给出
+     *         - YDEV_BUSY: 上一次异步读取尚未完成
+     *         - YDEV_NOT_SUPPORTED: 设备不支持异步读取
+     */
+    yDevStatus_t yDevReadAsync(void *handle, void *buffer, size_t size,
+                               yDevAsyncCallback_t callback, void *arg);
+
+    /**
+     * @brief 启动异步写入
+     * @param handle 设备句柄
+     * @param buffer 写入缓冲区，完成前必须保持有效
+     * @param size 写入大小
+     * @param callback 完成回调，可为NULL
+     * @param arg 回调参数
+     * @retval yDevStatus_t 启动状态，含义同yDevReadAsync
+     */
+    yDevStatus_t yDevWriteAsync(void *handle, const void *buffer, size_t size,
+                                yDevAsyncCallback_t callback, void *arg);
+
+    /**
+     * @brief 等待设备上的异步传输全部结束
+     * @param handle 设备句柄
+     * @param timeOutMs 超时时间(毫秒)，0表示一直等待
+     * @retval yDevStatus_t 等待结果
+     *         - YDEV_OK: 全部传输成功
+     *         - YDEV_TIMEOUT: 超时，传输仍在进行
+     *         - 其他: 第一个失败方向的传输结果
+     * @note 调度器运行时在任务通知上阻塞，同一时刻只能有一个任务等待同一设备
+     */
+    yDevStatus_t yDevWait(void *handle, uint32_t timeOutMs);
+
+    /**
+     * @brief 等待多个设备中任意一个就绪
+     * @param handles 设备句柄数组
+     * @param events 每个设备关注的事件(YDEV_POLLIN/YDEV_POLLOUT)
+     * @param revents 输出每个设备的就绪事件，未就绪为0
+     * @param n 设备数量
+     * @param timeOutMs 超时时间(毫秒)，0表示一直等待，YDEV_POLL_NOWAIT表示只查询一次
+     * @retval int32_t 就绪的设备数量，0表示超时，负数表示参数错误
+     * @note 驱动在中断中登记事件并唤醒等待任务，一个任务即可服务多个设备；
+     *       同一时刻只能有一个任务poll同一设备
+     */
+    int32_t yDevPoll(void *const handles[], const uint32_t events[], uint32_t revents[],
+                     uint32_t n, uint32_t timeOutMs);
+
+    /**
+     * @brief 唤醒在设备上poll的任务
+     * @param handle 设备句柄
+     * @retval 无
+     * @note 为设备登记YDEV_POLLWAKE，等待中的yDevPoll立即返回；没有任务等待时留到下次poll；
+     *       用于让设备的服务任务处理数据以外的请求，例如更换缓冲区
+     */
+    void yDevPollWake(void *handle);
+
+    // ==================== 设备注册表 ====================
+
+    /**
+     * @brief 按名称注册设备句柄
+     * @param name 设备名，须在注册期间保持有效(通常为字符串常量)
+     * @param handle 已初始化的设备句柄
+     * @retval yDevStatus_t 注册状态
+     *         - YDEV_OK: 注册成功，同一句柄重复注册同名也返回成功
+     *         - YDEV_BUSY: 名称已被其他句柄占用
+     *         - YDEV_NO_MEMORY: 注册表已满(YDEV_REGISTRY_MAX)
+     * @note 配置了name的设备由yDevInitStatic自动注册，yDevDeinitStatic自动注销
+     */
+    yDevStatus_t yDevRegister(const char *name, void *handle);
+
+    /**
+     * @brief 注销设备句柄
+     * @param handle 设备句柄
+     * @retval 无
+     */
+    void yDevUnregister(void *handle);
+
+    /**
+     * @brief 按名称查找设备句柄
+     * @param name 设备名
+     * @retval void* 设备句柄，未找到时返回NULL
+     * @note 注册表按名称有序，二分查找
+     */
+    void *yDevFind(const char *name);
+
+    /**
+     * @brief 按序号遍历已注册的设备
+     * @param index 序号，从0开始
+     * @param name 输出设备名，可为NULL
+     * @retval void* 设备句柄，序号超出注册数量时返回NULL
+     * @note 按名称字典序返回，遍历期间注册或注销设备会改变序号
+     */
+    void *yDevIterate(uint32_t index, const char **name);
+
+    /**
+     * @brief 获取设备类型
+     * @param handle 已初始化的设备句柄
+     * @retval yDevType_t 设备类型，句柄为NULL时返回YDEV_TYPE_MAX
+     */
+    yDevType_t yDevGetType(void *handle);
+
+    /**
+     * @brief 查询异步传输是否进行中
+     * @param handle 设备句柄
+     * @param dir 传输方向
+     * @retval 1=进行中, 0=空闲
+     */
+    uint8_t yDevAsyncIsBusy(void *handle, yDevAsyncDir_t dir);
+
+    /**
+     * @brief 唤醒协程的异步完成回调
+     * @param arg 等待的协程(struct ylib_coro *)
+     * @param status 传输结果，写入协程的result
+     * @param len 实际传输的字节数，写入协程的value
+     * @note 在协程中启动异步传输后等待完成，一个工作任务即可服务多路传输：
+     * @code
+     * if (yDevReadAsync(dev, buf, n, yDevAsyncWakeCoro, co) == YDEV_OK)
+     *     YLIB_CORO_WAIT_UNTIL(co, !yDevAsyncIsBusy(dev, YDEV_ASYNC_READ));
+     * // co->result为传输结果，co->value为实际字节数
+     * @endcode
+     */
+    void yDevAsyncWakeCoro(void *arg, yDevStatus_t status, uint32_t len);
+
+    /**
+     * @brief 初始化转交工作项的异步完成
+     * @param aw 异步完成结构，通常嵌入使用者的上下文，工作函数中用container_of取回
+     * @param func 工作函数，参数为aw
+     * @param prio 工作队列号
+     * @retval 无
+     */
+    void yDevAsyncWorkInit(yDevAsyncWork_t *aw, ylib_work_func_t func, unsigned int prio);
+
+    /**
+     * @brief 提交工作项的异步完成回调
+     * @param arg 异步完成结构(yDevAsyncWork_t *)
+     * @param status 传输结果，写入aw->status
+     * @param len 实际传输的字节数，写入aw->len
+     * @note 驱动的完成中断里只剩一次入队，不需要协程也能把处理移出中断：
+     * @code
+     * yDevAsyncWorkInit(&ctx->rx_done, rx_done_work, 1);
+     * yDevReadAsync(dev, ctx->buf, n, yDevAsyncWorkDone, &ctx->rx_done);
+     * @endcode
+     */
+    void yDevAsyncWorkDone(void *arg, yDevStatus_t status, uint32_t len);
+
+    // ==================== 操作统计 ====================
+
+    /**
+     * @brief 读取设备操作统计
+     * @param handle 设备句柄
+     * @param stats 输出的统计数组，按yDevStatOp_t排列
+     * @retval yDevStatus_t 读取状态，关闭YDEV_STATS_ENABLE时返回YDEV_NOT_SUPPORTED
+     */
+    yDevStatus_t yDevGetOpStats(void *handle, yDevOpStats_t stats[YDEV_STAT_MAX]);
+
+    /**
+     * @brief 清零设备操作统计
+     * @param handle 设备句柄
+     * @retval 无
+     */
+    void yDevResetOpStats(void *handle);
+
+    // ==================== 电源管理 ====================
+
+    /**
+     * @brief 挂起设备
+     * @param handle 设备句柄
+     * @retval yDevStatus_t 挂起状态
+     *         - YDEV_OK: 已挂起或本来已挂起
+     *         - YDEV_BUSY: 有进行中的操作，或驱动当前不能挂起
+     *         - YDEV_NOT_SUPPORTED: 驱动没有挂起入口
+     * @note 挂起后的第一次读写、控制或异步传输自动恢复设备
+     */
+    yDevStatus_t yDevSuspend(void *handle);
+
+    /**
+     * @brief 恢复设备
+     * @param handle 设备句柄
+     * @retval yDevStatus_t 恢复状态，未挂起时直接返回YDEV_OK
+     */
+    yDevStatus_t yDevResume(void *handle);
+
+    /**
+     * @brief 获取设备状态
+     * @param handle 设备句柄
+     * @retval yDevState_t 设备状态，句柄为NULL时返回YDEV_STATE_UNINITIALIZED
+     */
+    yDevState_t yDevGetState(void *handle);
+
+    /**
+     * @brief 挂起空闲超时的设备
+     * @retval uint32_t 距离下一个设备到期的毫秒数，没有待挂起设备时返回YDEV_PM_NEVER
+     * @note 遍历设备注册表，idle_ms非0且空闲时间已到的设备调用驱动挂起入口；
+     *       驱动挂起时可能访问总线，须在任务中周期调用，不能在中断或空闲钩子中调用；
+     *       同时重试被否决的系统时钟切换
+     */
+    uint32_t yDevPmProcess(void);
+
+    /**
+     * @brief 查询能否进入STOP模式
+     * @retval uint8_t 1=所有已注册设备空闲且支持挂起的设备均已挂起, 0=不能进入
+     * @note 供低功耗无滴答空闲的睡眠前处理调用，不支持挂起的设备只要求没有进行中的操作
+     */
+    uint8_t yDevPmCanStop(void);
+
+    /**
+     * @brief 读取设备唤醒统计
+     * @param handle 设备句柄
+     * @param usage 输出，包含截至调用时刻仍处于唤醒的时间
+     * @retval yDevStatus_t 读取状态，关闭YDEV_PM_ACCOUNT时返回YDEV_NOT_SUPPORTED
+     */
+    yDevStatus_t yDevPmGetUsage(void *handle, yDevPmUsage_t *usage);
+
+    /**
+     * @brief 读取CPU睡眠统计
+     * @param stats 输出
+     * @retval yDevStatus_t 读取状态，关闭YDEV_PM_ACCOUNT或未使用无滴答空闲时返回YDEV_NOT_SUPPORTED
+     */
+    yDevStatus_t yDevPmGetCpuStats(yDevPmCpuStats_t *stats);
+
+    /**
+     * @brief 清零所有已注册设备的唤醒统计和CPU睡眠统计
+     * @retval 无
+     * @note 清零后唤醒中的设备从调用时刻重新计时
+     */
+    void yDevPmResetUsage(void);
+
+    /**
+     * @brief 请求不低于指定等级的系统时钟
+     * @param level 时钟等级(yDrvClockLevel_t)，数值小的频率高
+     * @retval yDevStatus_t 请求状态
+     *         - YDEV_OK: 已运行在该等级或更高频率
+     *         - YDEV_BUSY: 驱动否决了升频，请求未登记，稍后重试
+     *         - YDEV_INVALID_PARAM: 等级无效
+     * @note 按等级计数，系统时钟取所有请求中最快的等级，没有请求时取空闲等级；与yDevClockRelease成对调用
+     */
+    yDevStatus_t yDevClockRequest(uint32_t level);
+
+    /**
+     * @brief 释放系统时钟请求
+     * @param level 请求时的等级
+     * @note 降频被驱动否决时由yDevPmProcess重试
+     */
+    void yDevClockRelease(uint32_t level);
+
+    /**
+     * @brief 设置没有请求时的系统时钟等级
+     * @param level 时钟等级(yDrvClockLevel_t)，默认YDEV_CLOCK_IDLE_LEVEL
+     * @retval yDevStatus_t 设置状态，切换被否决时返回YDEV_BUSY，等级已保存，由yDevPmProcess重试
+     */
+    yDevStatus_t yDevClockSetIdle(uint32_t level);
+
+    /**
+     * @brief 获取空闲等级和各等级的请求计数
+     * @param count 输出各等级的请求数，YDRV_CLOCK_LEVEL_MAX项，可为NULL
+     * @retval uint32_t 空闲等级
+     */
+    uint32_t yDevClockGetRequests(uint16_t *count);
+
     yDevStatus_t yLabInit(void);
 
+    /**
+     * @brief 获取系统毫秒计数
+     * @retval 上电以来的毫秒数
+     * @note 32位回绕，超时判断使用无符号减法(yDevGetTimeMS() - start) >= timeout
+     */
     size_t yDevGetTimeMS(void);
 
+    /**
+     * @brief 获取微秒时间戳
+     * @retval 上电以来的微秒数
+     * @note 1MHz分辨率，约71.6分钟回绕，计算时间差使用无符号减法
+     */
+    uint32_t yDevGetTimeUS(void);
+
 #define YDEV_ERRNO_NO_ERROR (0)            // 设备未初始化错误
 #define YDEV_ERRNO_NOT_FOUND (1UL << 0UL)  // 设备未找到错误
 #define YDEV_ERRNO_NOT_INIT (1UL << 1UL)   // 设备未初始化错误
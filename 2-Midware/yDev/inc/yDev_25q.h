@@ -16,6 +16,7 @@
  * - 硬件写保护功能
  * - 状态寄存器读写
  * - 设备ID和JEDEC ID读取
+ * - 可选的页读缓存和小块写入写回缓冲
  * - 与底层yDrv SPI驱动的适配
  */
 
@@ -30,6 +31,7 @@ extern "C"
 // ==================== 包含文件 ====================
 #include "yDev.h"
 #include "yDrv_spi.h"
+#include "yDev_spibus.h"
 #include "yDrv_dma.h"
     // ==================== 25Q设备特定定义 ====================
 
@@ -50,20 +52,49 @@ extern "C"
      */
     typedef enum
     {
-        YDEV_25Q_CMD_WRITE_ENABLE = 0x06,  /*!< 写使能 */
-        YDEV_25Q_CMD_WRITE_DISABLE = 0x04, /*!< 写禁止 */
-        YDEV_25Q_CMD_PAGE_PROGRAM = 0x02,  /*!< 页编程 */
-
-        YDEV_25Q_CMD_READ_DATA = 0x03, /*!< 读数据 */
-
-        YDEV_25Q_CMD_SECTOR_ERASE = 0x20, /*!< 扇区擦除 (4KB) */
-        YDEV_25Q_CMD_BLOCK_ERASE = 0xD8,  /*!< 块擦除 (64KB) */
-
-        YDEV_25Q_CMD_READ_STATUS_REG1 = 0x05, /*!< 读状态寄存器1 */
+        YDEV_25Q_CMD_WRITE_ENABLE = 0x06,      /*!< 写使能 */
+        YDEV_25Q_CMD_WRITE_DISABLE = 0x04,     /*!< 写禁止 */
+        YDEV_25Q_CMD_PAGE_PROGRAM = 0x02,      /*!< 页编程 */
+        YDEV_25Q_CMD_QUAD_PAGE_PROGRAM = 0x32, /*!< 四线页编程(1-1-4)，需QSPI后端且SR2的QE置位 */
+
+        YDEV_25Q_CMD_READ_DATA = 0x03,          /*!< 读数据 */
+        YDEV_25Q_CMD_FAST_READ = 0x0B,          /*!< 快速读数据 (地址后跟一个空字节) */
+        YDEV_25Q_CMD_FAST_READ_QUAD_OUT = 0x6B, /*!< 四线输出快速读(1-1-4，8个空周期) */
+        YDEV_25Q_CMD_FAST_READ_QUAD_IO = 0xEB,  /*!< 四线地址和数据快速读(1-4-4，模式字节加4个空周期) */
+
+        YDEV_25Q_CMD_SECTOR_ERASE = 0x20,    /*!< 扇区擦除 (4KB) */
+        YDEV_25Q_CMD_BLOCK_ERASE = 0xD8,     /*!< 块擦除 (64KB) */
+        YDEV_25Q_CMD_BLOCK_ERASE_32K = 0x52, /*!< 块擦除 (32KB) */
+        YDEV_25Q_CMD_CHIP_ERASE = 0xC7,      /*!< 全片擦除 */
+        YDEV_25Q_CMD_ERASE_SUSPEND = 0x75,   /*!< 擦除/编程挂起 */
+        YDEV_25Q_CMD_ERASE_RESUME = 0x7A,    /*!< 擦除/编程恢复 */
+
+        YDEV_25Q_CMD_READ_STATUS_REG1 = 0x05,   /*!< 读状态寄存器1 */
+        YDEV_25Q_CMD_READ_STATUS_REG2 = 0x35,   /*!< 读状态寄存器2 */
+        YDEV_25Q_CMD_READ_STATUS_REG3 = 0x15,   /*!< 读状态寄存器3 */
+        YDEV_25Q_CMD_WRITE_STATUS_REG1 = 0x01,  /*!< 写状态寄存器1 */
+        YDEV_25Q_CMD_WRITE_STATUS_REG2 = 0x31,  /*!< 写状态寄存器2 */
+        YDEV_25Q_CMD_WRITE_STATUS_REG3 = 0x11,  /*!< 写状态寄存器3 */
+        YDEV_25Q_CMD_VOLATILE_SR_ENABLE = 0x50, /*!< 易失性状态寄存器写使能 */
+        YDEV_25Q_CMD_READ_UNIQUE_ID = 0x4B,     /*!< 读唯一ID (命令后跟四个空字节) */
+
+        YDEV_25Q_CMD_READ_SFDP = 0x5A, /*!< 读SFDP参数表 (地址后跟一个空字节) */
+
+        YDEV_25Q_CMD_POWER_DOWN = 0xB9,         /*!< 进入深度掉电 */
+        YDEV_25Q_CMD_RELEASE_POWER_DOWN = 0xAB, /*!< 退出深度掉电 */
 
         YDEV_25Q_CMD_READ_MANUFACTURER_ID = 0x90 /*!< 读制造商ID */
     } yDev25qCmd_t;
 
+    /**
+     * @brief 25Q基本参数定义
+     */
+#define YDEV_25Q_PAGE_SIZE (256)         /*!< 标准页大小 (字节) */
+#define YDEV_25Q_SECTOR_SIZE (4096)      /*!< 标准扇区大小 (字节) */
+#define YDEV_25Q_HALF_BLOCK_SIZE (32768) /*!< 32KB块大小 (字节) */
+#define YDEV_25Q_BLOCK_SIZE (65536)      /*!< 64KB块大小 (字节) */
+#define YDEV_25Q_DMA_MAX_SIZE (65535)    /*!< 单次DMA最大传输字节数 (CNDTR为16位) */
+
     /**
      * @brief yDev 25Q设备配置结构体
      * @note 包含yDev基础配置和25Q特定的SPI配置参数
@@ -87,22 +118,345 @@ extern "C"
         uint32_t misoAF;
         uint32_t mosiAF;
         uint32_t csAF;
+
+        uint8_t dmaEnable;             /*!< 批量读取使用DMA，0=禁用 */
+        yDrvDmaChannel_t rxDmaChannel; /*!< SPI接收DMA通道，可为YDRV_DMA_CHANNEL_AUTO */
+        yDrvDmaChannel_t txDmaChannel; /*!< SPI发送DMA通道(发送填充字节)，可为YDRV_DMA_CHANNEL_AUTO */
+
+        uint8_t fastRead;     /*!< 使用快速读取(0x0B)，支持更高SPI时钟，0=标准读取(0x03) */
+        uint8_t verify;       /*!< 编程和擦除后读回校验(yDev25qWriteAsync除外)，0=关闭 */
+        uint32_t autoSleepMs; /*!< 空闲多久后自动进入深度掉电(毫秒)，0=关闭 */
+
+        yDevSpiBus_t *bus; /*!< 挂接的共享SPI总线，NULL=独占spiId；非NULL时只使用csPin和speed */
     } yDevConfig_25q_t;
 
+    /**
+     * @brief 25Q擦除类型数量 (SFDP最多描述4种擦除类型)
+     */
+#define YDEV_25Q_ERASE_TYPE_MAX (4)
+
+    /**
+     * @brief 25Q全片擦除在几何参数数组中的索引
+     */
+#define YDEV_25Q_ERASE_TYPE_CHIP (YDEV_25Q_ERASE_TYPE_MAX)
+
+    /**
+     * @brief 25Q芯片几何参数结构体
+     * @note 优先由SFDP基本参数表填充，读取失败时使用W25Q默认值
+     */
+    typedef struct
+    {
+        uint32_t eraseSize[YDEV_25Q_ERASE_TYPE_MAX + 1];      /*!< 各擦除类型大小(字节)，0=不支持，按从小到大排列，末项为全片擦除 */
+        uint32_t eraseTypMs[YDEV_25Q_ERASE_TYPE_MAX + 1];     /*!< 各擦除类型典型耗时(毫秒) */
+        uint32_t eraseTimeoutMs[YDEV_25Q_ERASE_TYPE_MAX + 1]; /*!< 各擦除类型最大耗时(毫秒) */
+        uint8_t eraseCmd[YDEV_25Q_ERASE_TYPE_MAX + 1];        /*!< 各擦除类型命令 */
+        uint8_t fastRead;                                 /*!< 支持快速读取(0x0B) */
+        uint8_t quadRead;                                 /*!< 支持的四线读取，bit0=1-1-4(0x6B)，bit1=1-4-4(0xEB) */
+        uint8_t fromSfdp;                                 /*!< 参数来自SFDP，0=默认值 */
+    } yDev25qGeometry_t;
+
+    /**
+     * @brief 25Q异步写入完成回调函数类型
+     * @param arg 用户回调参数
+     * @param status 写入结果，YDEV_OK表示全部数据已编程完成
+     * @note 在FreeRTOS定时器服务任务中调用，不得长时间阻塞
+     */
+    typedef void (*yDev25qAsyncCallback_t)(void *arg, yDevStatus_t status);
+
+    /**
+     * @brief 25Q异步写入状态结构体
+     */
+    typedef struct
+    {
+        const uint8_t *buffer;           /*!< 待编程数据指针 */
+        uint32_t address;                /*!< 下一页编程地址 */
+        uint32_t remain;                 /*!< 剩余未编程字节数 */
+        uint32_t start_tick;             /*!< 当前页编程开始时刻 */
+        yDev25qAsyncCallback_t callback; /*!< 完成回调函数 */
+        void *arg;                       /*!< 完成回调参数 */
+        void *timer;                     /*!< BUSY轮询软件定时器 */
+        volatile uint8_t busy;           /*!< 异步写入进行中标志 */
+    } yDev25qAsync_t;
+
+    /**
+     * @brief 25Q空闲自动掉电状态结构体
+     * @note 每次访问释放总线时记录时刻，单次定时器到期后若空闲已满ms则发送0xB9，
+     *       下一次访问在总线加锁时发送0xAB并等待tRES1，调用者无感知
+     */
+    typedef struct
+    {
+        void *timer;            /*!< 空闲检查单次定时器 */
+        uint32_t ms;            /*!< 空闲多久后掉电(毫秒)，0=关闭 */
+        volatile uint32_t last; /*!< 最近一次释放总线的系统节拍 */
+        uint32_t count;         /*!< 自动掉电次数 */
+    } yDev25qSleep_t;
+
+    /**
+     * @brief 25Q状态寄存器读写参数(YDEV_25Q_IOCTL_READ_STATUS_REG/WRITE_STATUS_REG)
+     */
+    typedef struct
+    {
+        uint8_t reg;          /*!< 寄存器号1~3 */
+        uint8_t value;        /*!< 写入值，读取时输出 */
+        uint8_t flagVolatile; /*!< 写入时使用易失性写使能(0x50)，掉电后恢复原值，不磨损 */
+    } yDev25qStatusReg_t;
+
+    /**
+     * @brief 25Q后台擦除队列深度
+     */
+#ifndef YDEV_25Q_ERASE_QUEUE_DEPTH
+#define YDEV_25Q_ERASE_QUEUE_DEPTH (4)
+#endif
+
+    /**
+     * @brief 25Q后台擦除请求结构体
+     */
+    typedef struct
+    {
+        uint32_t address; /*!< 待擦除起始地址 (扇区对齐) */
+        uint32_t size;    /*!< 剩余待擦除大小 (扇区整数倍) */
+    } yDev25qEraseJob_t;
+
+    /**
+     * @brief 25Q后台读取请求结构体
+     * @note 由yDevReadAsync提交，在后台擦除工作任务中执行
+     */
+    typedef struct
+    {
+        uint8_t *volatile buffer; /*!< 读取目标缓冲区，NULL表示没有请求 */
+        uint32_t address;         /*!< 读取起始地址 */
+        uint32_t size;            /*!< 读取大小 */
+    } yDev25qReadJob_t;
+
+    /**
+     * @brief 25Q后台擦除状态结构体
+     */
+    typedef struct
+    {
+        yDev25qEraseJob_t queue[YDEV_25Q_ERASE_QUEUE_DEPTH]; /*!< 擦除请求队列 */
+        uint8_t head;                                        /*!< 队首索引 */
+        uint8_t count;                                       /*!< 队列中请求数 */
+        volatile uint8_t active;                             /*!< 后台擦除进行中标志 */
+        void *task;                                          /*!< 擦除工作任务句柄 */
+        yDev25qReadJob_t read;                               /*!< 后台读取请求，优先于擦除执行 */
+    } yDev25qErase_t;
+
+    /**
+     * @brief 25Q读缓存单个句柄最大行数
+     */
+#ifndef YDEV_25Q_CACHE_LINE_MAX
+#define YDEV_25Q_CACHE_LINE_MAX (8)
+#endif
+
+    /**
+     * @brief 25Q读缓存行结构体
+     * @note 每行缓存一整页，由yLib静态内存分区统一分配
+     */
+    typedef struct
+    {
+        uint32_t tag;                     /*!< 缓存页起始地址，0xFFFFFFFF=无效 */
+        uint32_t stamp;                   /*!< 最近访问时间戳，用于LRU替换 */
+        uint8_t data[YDEV_25Q_PAGE_SIZE]; /*!< 页数据 */
+    } yDev25qCacheLine_t;
+
+    /**
+     * @brief 25Q读缓存状态结构体
+     */
+    typedef struct
+    {
+        yDev25qCacheLine_t *line[YDEV_25Q_CACHE_LINE_MAX]; /*!< 缓存行指针 */
+        uint8_t count;                                     /*!< 已分配缓存行数，0=缓存关闭 */
+        uint32_t clock;                                    /*!< LRU时间戳计数 */
+        uint32_t hit;                                      /*!< 命中计数 */
+        uint32_t miss;                                     /*!< 未命中计数 */
+    } yDev25qCache_t;
+
+    /**
+     * @brief 25Q读缓存统计信息
+     * @note 用于YDEV_25Q_IOCTL_CACHE_STATS
+     */
+    typedef struct
+    {
+        uint32_t lines; /*!< 已分配缓存行数 */
+        uint32_t hit;   /*!< 命中计数 */
+        uint32_t miss;  /*!< 未命中计数 */
+    } yDev25qCacheStats_t;
+
+    /**
+     * @brief 25Q写回缓冲单个句柄最大页数
+     */
+#ifndef YDEV_25Q_WBACK_PAGE_MAX
+#define YDEV_25Q_WBACK_PAGE_MAX (2)
+#endif
+
+    /**
+     * @brief 25Q写回缓冲状态结构体
+     * @note 缓冲页与读缓存共用静态内存分区；页内未写入的字节保持0xFF，
+     *       同一字节重复写入时按位与，与NOR直接编程两次的结果相同
+     */
+    typedef struct
+    {
+        yDev25qCacheLine_t *line[YDEV_25Q_WBACK_PAGE_MAX]; /*!< 缓冲页，tag为页地址，0xFFFFFFFF=空闲 */
+        uint16_t lo[YDEV_25Q_WBACK_PAGE_MAX];              /*!< 页内待编程范围起点 */
+        uint16_t hi[YDEV_25Q_WBACK_PAGE_MAX];              /*!< 页内待编程范围终点(不含)，等于起点表示无数据 */
+        uint8_t count;                                     /*!< 已分配页数，0=关闭 */
+        volatile uint8_t due;                              /*!< 超时到期，等待工作任务写出 */
+        uint32_t clock;                                    /*!< LRU时间戳计数 */
+        uint32_t timeoutMs;                                /*!< 数据在缓冲中的最长停留时间(毫秒)，0=不限 */
+        void *timer;                                       /*!< 超时单次定时器 */
+        uint32_t writes;                                   /*!< 写入缓冲的次数 */
+        uint32_t programs;                                 /*!< 页编程次数，含整页直接编程 */
+        uint32_t timeouts;                                 /*!< 超时写出次数 */
+    } yDev25qWback_t;
+
+    /**
+     * @brief 25Q写回缓冲设置
+     * @note 用于YDEV_25Q_IOCTL_WBACK_ENABLE，返回时改为实际生效的值
+     */
+    typedef struct
+    {
+        uint32_t pages;     /*!< 缓冲页数，0=写出全部数据后关闭 */
+        uint32_t timeoutMs; /*!< 超时写出时间(毫秒)，0=只在页满、换页和冲刷时写出 */
+    } yDev25qWbackConfig_t;
+
+    /**
+     * @brief 25Q写回缓冲统计信息
+     * @note 用于YDEV_25Q_IOCTL_WBACK_STATS
+     */
+    typedef struct
+    {
+        uint32_t pages;    /*!< 已分配缓冲页数 */
+        uint32_t writes;   /*!< 写入缓冲的次数 */
+        uint32_t programs; /*!< 页编程次数 */
+        uint32_t timeouts; /*!< 超时写出次数 */
+    } yDev25qWbackStats_t;
+
+    /**
+     * @brief 25Q顺序读取预读单个句柄最大页数
+     */
+#ifndef YDEV_25Q_PREFETCH_PAGE_MAX
+#define YDEV_25Q_PREFETCH_PAGE_MAX (4)
+#endif
+
+    /**
+     * @brief 25Q顺序读取预读状态结构体
+     * @note 预读页与读缓存共用静态内存分区，按环形首尾相接：line[(head + i) % count]
+     *       保存address + i * YDEV_25Q_PAGE_SIZE起的一页；全部字段在总线锁内访问
+     */
+    typedef struct
+    {
+        yDev25qCacheLine_t *line[YDEV_25Q_PREFETCH_PAGE_MAX]; /*!< 预读页 */
+        uint8_t count;                                        /*!< 已分配页数，0=关闭 */
+        uint8_t head;                                         /*!< 保存address起始数据的页序号 */
+        volatile uint8_t pending;                             /*!< 已请求工作任务补充预读 */
+        uint32_t address;                                     /*!< 缓冲数据起始地址 */
+        uint32_t valid;                                       /*!< 缓冲有效字节数，0=无数据 */
+        uint32_t next;                                        /*!< 上次读取的结束地址，用于识别顺序读取 */
+        uint32_t issued;                                      /*!< 工作任务执行的预读次数 */
+        uint32_t hit;                                         /*!< 全部由预读缓冲提供的读取次数 */
+        uint32_t miss;                                        /*!< 顺序读取中仍需访问芯片的次数 */
+    } yDev25qPrefetch_t;
+
+    /**
+     * @brief 25Q顺序读取预读统计信息
+     * @note 用于YDEV_25Q_IOCTL_PREFETCH_STATS
+     */
+    typedef struct
+    {
+        uint32_t pages;  /*!< 已分配预读页数 */
+        uint32_t issued; /*!< 预读次数 */
+        uint32_t hit;    /*!< 全部由预读缓冲提供的读取次数 */
+        uint32_t miss;   /*!< 顺序读取中仍需访问芯片的次数 */
+    } yDev25qPrefetchStats_t;
+
+    /**
+     * @brief 25Q SPI传输耗时直方图桶数
+     * @note hist[0]统计不足1us的传输，hist[n]统计[2^(n-1), 2^n)us，最后一桶包含更长的传输
+     */
+#define YDEV_25Q_STATS_BUCKETS (16)
+
+    /**
+     * @brief 25Q SPI传输统计
+     * @note 用于YDEV_25Q_IOCTL_SPI_STATS，每次调用DMA、中断或轮询传输引擎记一次
+     */
+    typedef struct
+    {
+        uint32_t bytes;                          /*!< 实际传输的字节数 */
+        uint32_t transfers;                      /*!< 传输次数 */
+        uint32_t dma;                            /*!< DMA传输次数 */
+        uint32_t irq;                            /*!< 中断传输次数 */
+        uint32_t polled;                         /*!< 轮询传输次数 */
+        uint32_t shortCount;                     /*!< 实际字节数少于请求的传输次数 */
+        uint32_t timeouts;                       /*!< DMA/中断等待超时次数 */
+        uint32_t maxUs;                          /*!< 最长单次传输耗时(微秒) */
+        uint32_t hist[YDEV_25Q_STATS_BUCKETS];   /*!< 传输耗时log2直方图 */
+    } yDev25qSpiStats_t;
+
+    /**
+     * @brief 25Q SPI速率等级数量 (YDRV_SPI_SPEED_LEVEL0~LEVEL7)
+     */
+#define YDEV_25Q_SPEED_LEVEL_NUM (8)
+
+    /**
+     * @brief 25Q SPI时钟校准结果
+     * @note 用于YDEV_25Q_IOCTL_SPEED_TUNE
+     */
+    typedef struct
+    {
+        uint8_t level;    /*!< 选定的速率等级(0~7，对应YDRV_SPI_SPEED_LEVELn) */
+        uint8_t fastest;  /*!< 通过校验的最快速率等级，0xFF表示全部失败 */
+        uint8_t passMask; /*!< 各速率等级校验结果位图，bit n对应LEVELn */
+    } yDev25qSpeedTune_t;
+
+    /**
+     * @brief 25Q数据传输方式
+     * @note 用于YDEV_25Q_IOCTL_XFER_MODE；指定方式只限制数据段，命令和状态字节仍用轮询，
+     *       指定的方式不可用时退回轮询
+     */
+    typedef enum
+    {
+        YDEV_25Q_XFER_AUTO = 0, /*!< 按长度选择DMA、中断或轮询 */
+        YDEV_25Q_XFER_POLLED,   /*!< 只用轮询 */
+        YDEV_25Q_XFER_IRQ,      /*!< 不用DMA，中等及以上长度走中断 */
+        YDEV_25Q_XFER_DMA,      /*!< 不用中断，大块走DMA */
+        YDEV_25Q_XFER_MAX       /*!< 方式数量 */
+    } yDev25qXferMode_t;
+
     /**
      * @brief yDev 25Q设备句柄结构体
      * @note 包含yDev基础句柄和25Q特定的SPI句柄及设备信息
      */
     typedef struct
     {
-        yDevHandle_t base;          /*!< yDev基础句柄结构体 */
-        yDrvSpiHandle_t spi_handle; /*!< SPI底层驱动句柄 */
-        uint32_t address;           /*!< 当前操作地址 */
-        uint32_t align;             /*!< 写入对齐大小 */
-        uint32_t size;              /*!< Flash总大小 */
-        yDev25qType_t chip_type;    /*!< 芯片型号 */
-        uint16_t device_id;         /*!< 设备ID */
-        uint8_t manufacturer_id;    /*!< 制造商ID */
+        yDevHandle_t base;              /*!< yDev基础句柄结构体 */
+        yDrvSpiHandle_t spi_handle;     /*!< SPI底层驱动句柄(独占总线时使用) */
+        yDrvSpiHandle_t *spi;           /*!< 当前使用的SPI句柄，指向spi_handle或共享总线句柄 */
+        yDevSpiBusDevice_t bus_device;  /*!< 共享总线器件，bus为NULL表示独占总线 */
+        uint32_t address;               /*!< 当前操作地址 */
+        uint32_t align;                 /*!< 写入对齐大小 */
+        uint32_t size;                  /*!< Flash总大小 */
+        yDev25qType_t chip_type;        /*!< 芯片型号 */
+        uint16_t device_id;             /*!< 设备ID */
+        uint8_t manufacturer_id;        /*!< 制造商ID */
+        uint8_t flagDma;                /*!< DMA读取可用标志 */
+        uint8_t flagIrq;                /*!< 中断传输可用标志 */
+        uint8_t xferMode;               /*!< 数据传输方式限制(yDev25qXferMode_t) */
+        uint8_t flagFastRead;           /*!< 快速读取使能标志 */
+        uint8_t flagVerify;             /*!< 编程和擦除后读回校验标志 */
+        uint8_t speedLevel;             /*!< 当前SPI速率等级(0~7) */
+        volatile uint8_t flagDmaDone;   /*!< DMA/中断传输完成标志(中断中置位) */
+        void *dma_wait_task;            /*!< 等待DMA/中断传输完成的任务句柄 */
+        yDev25qAsync_t async;           /*!< 异步写入状态 */
+        yDev25qGeometry_t geometry;     /*!< 芯片几何参数 */
+        yDev25qCache_t cache;           /*!< 页读缓存 */
+        yDev25qWback_t wback;           /*!< 小块写入的写回缓冲 */
+        yDev25qPrefetch_t prefetch;     /*!< 顺序读取预读缓冲 */
+        yDev25qSpiStats_t stats;        /*!< SPI传输统计 */
+        yDev25qErase_t erase;           /*!< 后台擦除状态 */
+        yDev25qSleep_t sleep;           /*!< 空闲自动掉电状态 */
+        yDevBusSched_t sched;           /*!< 独占总线时的作业调度器，共享总线时使用总线的调度器 */
+        volatile uint8_t flagPowerDown; /*!< 芯片深度掉电标志，总线加锁时先唤醒 */
+        uint8_t flagSpiOff;             /*!< 挂起时关闭了独占SPI的时钟 */
     } yDevHandle_25q_t;
 
     // =============== yDev 25Q配置初始化宏 ====================
@@ -115,7 +469,6 @@ extern "C"
     ((yDevConfig_25q_t){                              \
         .base = YDEV_CONFIG_DEFAULT(),                \
         .spiId = YDRV_SPI_1,                          \
-        .direction = YDRV_SPI_DIR_2LINES_FULL_DUPLEX, \
         .dataBits = 8,                                \
         .crc = 0,                                     \
         .csMode = YDRV_SPI_CS_SOFT,                   \
@@ -124,20 +477,30 @@ extern "C"
         .misoPin = YDRV_PINNULL,                      \
         .mosiPin = YDRV_PINNULL,                      \
         .csPin = YDRV_PINNULL,                        \
-        .sckAF = 0,                                   \
-        .misoAF = 0,                                  \
-        .mosiAF = 0,                                  \
-        .csAF = 0})
+        .sckAF = YDRV_GPIO_AF_AUTO,                   \
+        .misoAF = YDRV_GPIO_AF_AUTO,                  \
+        .mosiAF = YDRV_GPIO_AF_AUTO,                  \
+        .csAF = YDRV_GPIO_AF_AUTO,                    \
+        .dmaEnable = 0,                               \
+        .rxDmaChannel = YDRV_DMA_CHANNEL_MAX,         \
+        .txDmaChannel = YDRV_DMA_CHANNEL_MAX,         \
+        .fastRead = 0,                                \
+        .verify = 0,                                  \
+        .autoSleepMs = 0,                             \
+        .bus = NULL})
 
     /**
      * @brief yDev 25Q句柄结构体默认初始化宏
      * @note 提供安全的默认初始化值
      */
-#define YDEV_25Q_HANDLE_DEFAULT()                \
-    {                                            \
-        .base = YDEV_HANDLE_DEFAULT(),           \
-        .spi_handle = YDRV_SPI_HANDLE_DEFAULT(), \
-        .chip_type = YDEV_25Q_TYPE_UNKNOWN}
+#define YDEV_25Q_HANDLE_DEFAULT()                   \
+    {                                               \
+        .base = YDEV_HANDLE_DEFAULT(),              \
+        .spi_handle = YDRV_SPI_HANDLE_DEFAULT(),    \
+        .chip_type = YDEV_25Q_TYPE_UNKNOWN,         \
+        .flagDma = 0,                               \
+        .flagIrq = 0,                               \
+        .flagFastRead = 0}
 
     // ==================== yDev 25Q初始化函数 ====================
 
@@ -157,6 +520,80 @@ extern "C"
      */
     void yDev25qHandleStructInit(yDevHandle_25q_t *handle);
 
+    // ==================== yDev 25Q读取函数 ====================
+
+    /**
+     * @brief 25Q设备长度读取
+     * @param handle 25Q设备句柄指针
+     * @param address 读取起始地址
+     * @param buffer 读取数据缓冲区指针
+     * @param size 读取数据大小 (32位，可一次读取整个镜像)
+     * @retval int32_t 实际读取的字节数，-1表示错误
+     * @note 指定地址读取，单次片选内连续读取，完成后handle->address指向下一字节；
+     *       开启预读后，与上次读取首尾相接的读取先从预读缓冲取数据，并请求工作任务补充下一段
+     */
+    int32_t yDev25qRead(yDevHandle_25q_t *handle, uint32_t address, void *buffer, uint32_t size);
+
+    // ==================== yDev 25Q异步写入函数 ====================
+
+    /**
+     * @brief 启动25Q异步写入
+     * @param handle 25Q设备句柄指针
+     * @param address 写入起始地址
+     * @param buffer 写入数据缓冲区指针，完成回调前必须保持有效
+     * @param size 写入数据大小
+     * @param callback 完成回调函数，可为NULL
+     * @param arg 完成回调参数
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 第一页已发出，其余页在后台依次编程
+     *         - YDEV_BUSY: 上一次异步写入尚未完成
+     *         - YDEV_INVALID_PARAM: 参数或地址无效
+     * @note 只编程目标字节范围，不做读-改-写，目标区域应已擦除
+     * @note 异步写入期间同步读写和ioctl返回忙错误
+     */
+    yDevStatus_t yDev25qWriteAsync(yDevHandle_25q_t *handle,
+                                   uint32_t address,
+                                   const void *buffer,
+                                   uint32_t size,
+                                   yDev25qAsyncCallback_t callback,
+                                   void *arg);
+
+    /**
+     * @brief 查询25Q异步写入是否进行中
+     * @param handle 25Q设备句柄指针
+     * @retval 1=进行中, 0=空闲
+     */
+    YLIB_INLINE uint8_t yDev25qIsAsyncBusy(yDevHandle_25q_t *handle)
+    {
+        return handle->async.busy;
+    }
+
+    // ==================== yDev 25Q后台擦除函数 ====================
+
+    /**
+     * @brief 提交25Q后台擦除请求
+     * @param handle 25Q设备句柄指针
+     * @param address 擦除起始地址，自动向下对齐到扇区边界
+     * @param size 擦除大小，自动向上对齐到扇区边界
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 请求已入队，由低优先级工作任务执行
+     *         - YDEV_BUSY: 队列已满或异步写入进行中
+     *         - YDEV_INVALID_PARAM: 参数或地址无效
+     *         - YDEV_ERROR: 工作任务创建失败
+     * @note 擦除期间的读取通过擦除挂起(0x75)/恢复(0x7A)完成，写入等待擦除队列清空
+     */
+    yDevStatus_t yDev25qEraseAsync(yDevHandle_25q_t *handle, uint32_t address, uint32_t size);
+
+    /**
+     * @brief 查询25Q后台擦除是否进行中
+     * @param handle 25Q设备句柄指针
+     * @retval 1=进行中, 0=空闲
+     */
+    YLIB_INLINE uint8_t yDev25qIsEraseBusy(yDevHandle_25q_t *handle)
+    {
+        return handle->erase.active;
+    }
+
 // ==================== 25Q设备IOCTL命令定义 ====================
 
 /**
@@ -168,16 +605,59 @@ extern "C"
 #define YDEV_25Q_IOCTL_SECTOR_ERASE (YDEV_25Q_IOCTL_BASE + 2)      /**< 扇区擦除 */
 #define YDEV_25Q_IOCTL_BLOCK_ERASE_32K (YDEV_25Q_IOCTL_BASE + 3)   /**< 32KB块擦除 */
 #define YDEV_25Q_IOCTL_BLOCK_ERASE_64K (YDEV_25Q_IOCTL_BASE + 4)   /**< 64KB块擦除 */
-#define YDEV_25Q_IOCTL_WRITE_ENABLE (YDEV_25Q_IOCTL_BASE + 5)      /**< 写使能 */
-#define YDEV_25Q_IOCTL_WRITE_DISABLE (YDEV_25Q_IOCTL_BASE + 6)     /**< 写禁止 */
-#define YDEV_25Q_IOCTL_POWER_DOWN (YDEV_25Q_IOCTL_BASE + 7)        /**< 进入掉电模式 */
+#define YDEV_25Q_IOCTL_WRITE_ENABLE (YDEV_25Q_IOCTL_BASE + 5)      /**< 写使能(0x06)，用于自定义命令序列 */
+#define YDEV_25Q_IOCTL_WRITE_DISABLE (YDEV_25Q_IOCTL_BASE + 6)     /**< 写禁止(0x04) */
+#define YDEV_25Q_IOCTL_POWER_DOWN (YDEV_25Q_IOCTL_BASE + 7)        /**< 进入掉电模式，之后的任何访问自动唤醒 */
 #define YDEV_25Q_IOCTL_POWER_UP (YDEV_25Q_IOCTL_BASE + 8)          /**< 退出掉电模式 */
-#define YDEV_25Q_IOCTL_READ_JEDEC_ID (YDEV_25Q_IOCTL_BASE + 9)     /**< 读取JEDEC ID */
-#define YDEV_25Q_IOCTL_READ_UNIQUE_ID (YDEV_25Q_IOCTL_BASE + 10)   /**< 读取唯一ID */
-#define YDEV_25Q_IOCTL_READ_STATUS_REG (YDEV_25Q_IOCTL_BASE + 11)  /**< 读取状态寄存器 */
-#define YDEV_25Q_IOCTL_WRITE_STATUS_REG (YDEV_25Q_IOCTL_BASE + 12) /**< 写入状态寄存器 */
-#define YDEV_25Q_IOCTL_SET_PROTECTION (YDEV_25Q_IOCTL_BASE + 13)   /**< 设置写保护 */
-#define YDEV_25Q_IOCTL_CLEAR_PROTECTION (YDEV_25Q_IOCTL_BASE + 14) /**< 清除写保护 */
+#define YDEV_25Q_IOCTL_READ_JEDEC_ID (YDEV_25Q_IOCTL_BASE + 9)     /**< 读取JEDEC ID(arg: uint32_t*) */
+#define YDEV_25Q_IOCTL_READ_UNIQUE_ID (YDEV_25Q_IOCTL_BASE + 10)   /**< 读取64位唯一ID(arg: uint8_t[8]，高字节在前) */
+#define YDEV_25Q_IOCTL_READ_STATUS_REG (YDEV_25Q_IOCTL_BASE + 11)  /**< 读取状态寄存器(arg: yDev25qStatusReg_t*) */
+#define YDEV_25Q_IOCTL_WRITE_STATUS_REG (YDEV_25Q_IOCTL_BASE + 12) /**< 写入状态寄存器并回读确认(arg: yDev25qStatusReg_t*) */
+#define YDEV_25Q_IOCTL_SET_PROTECTION (YDEV_25Q_IOCTL_BASE + 13)   /**< 设置写保护(arg: uint32_t*，SR1的TB/SEC/BP2~0五位，NULL=全片) */
+#define YDEV_25Q_IOCTL_CLEAR_PROTECTION (YDEV_25Q_IOCTL_BASE + 14) /**< 清除写保护(BP/TB/SEC和CMP清零) */
+#define YDEV_25Q_IOCTL_ERASE_RANGE (YDEV_25Q_IOCTL_BASE + 15)      /**< 任意范围擦除 */
+#define YDEV_25Q_IOCTL_CACHE_ENABLE (YDEV_25Q_IOCTL_BASE + 16)     /**< 设置读缓存行数(arg: uint32_t*，0=关闭) */
+#define YDEV_25Q_IOCTL_CACHE_STATS (YDEV_25Q_IOCTL_BASE + 17)      /**< 读取缓存统计(arg: yDev25qCacheStats_t*) */
+#define YDEV_25Q_IOCTL_CACHE_INVALIDATE (YDEV_25Q_IOCTL_BASE + 18) /**< 清空读缓存 */
+#define YDEV_25Q_IOCTL_SPEED_TUNE (YDEV_25Q_IOCTL_BASE + 19)       /**< 校准SPI时钟并选用最快可靠速率(arg: yDev25qSpeedTune_t*，可为NULL) */
+#define YDEV_25Q_IOCTL_SET_SPEED (YDEV_25Q_IOCTL_BASE + 20)        /**< 设置SPI速率等级(arg: uint32_t*，0~7) */
+#define YDEV_25Q_IOCTL_SPI_STATS (YDEV_25Q_IOCTL_BASE + 21)        /**< 读取SPI传输统计(arg: yDev25qSpiStats_t*) */
+#define YDEV_25Q_IOCTL_SPI_STATS_RESET (YDEV_25Q_IOCTL_BASE + 22)  /**< 清零SPI传输统计 */
+#define YDEV_25Q_IOCTL_JOB_DEADLINE (YDEV_25Q_IOCTL_BASE + 23)     /**< 设置作业类别默认截止时间(arg: yDevBusJobDeadline_t*) */
+#define YDEV_25Q_IOCTL_JOB_STATS (YDEV_25Q_IOCTL_BASE + 24)        /**< 读取并清零总线作业统计(arg: yDevBusJobStats_t[YDEV_BUSJOB_CLASS_MAX]) */
+#define YDEV_25Q_IOCTL_XFER_MODE (YDEV_25Q_IOCTL_BASE + 25)        /**< 限制数据传输方式(arg: uint32_t*，yDev25qXferMode_t)，用于性能测试 */
+#define YDEV_25Q_IOCTL_VERIFY (YDEV_25Q_IOCTL_BASE + 26)           /**< 编程和擦除后读回校验(arg: uint32_t*，0=关闭)，失败置YDEV_25Q_ERRNO_VERIFY_FAIL */
+#define YDEV_25Q_IOCTL_AUTO_SLEEP (YDEV_25Q_IOCTL_BASE + 27)       /**< 设置空闲自动深度掉电时间(arg: uint32_t*，毫秒，0=关闭) */
+#define YDEV_25Q_IOCTL_MAP (YDEV_25Q_IOCTL_BASE + 28)              /**< 取存储器映射地址(arg: yDev25qMap_t*)，本平台范围有效时总是返回YDEV_NOT_SUPPORTED */
+#define YDEV_25Q_IOCTL_WBACK_ENABLE (YDEV_25Q_IOCTL_BASE + 29)     /**< 设置写回缓冲(arg: yDev25qWbackConfig_t*)，先写出已缓冲的数据 */
+#define YDEV_25Q_IOCTL_WBACK_FLUSH (YDEV_25Q_IOCTL_BASE + 30)      /**< 写出写回缓冲中的全部数据 */
+#define YDEV_25Q_IOCTL_WBACK_STATS (YDEV_25Q_IOCTL_BASE + 31)      /**< 读取写回缓冲统计(arg: yDev25qWbackStats_t*) */
+#define YDEV_25Q_IOCTL_PREFETCH (YDEV_25Q_IOCTL_BASE + 32)         /**< 设置顺序读取预读页数(arg: uint32_t*，0=关闭)，返回实际分配的页数 */
+#define YDEV_25Q_IOCTL_PREFETCH_STATS (YDEV_25Q_IOCTL_BASE + 33)   /**< 读取预读统计(arg: yDev25qPrefetchStats_t*) */
+
+    /**
+     * @brief 25Q范围擦除IOCTL参数
+     * @note 用于YDEV_25Q_IOCTL_ERASE_RANGE；扇区/块擦除IOCTL参数为uint32_t起始地址
+     */
+    typedef struct
+    {
+        uint32_t address; /*!< 擦除起始地址 */
+        uint32_t size;    /*!< 擦除大小 */
+    } yDev25qEraseRange_t;
+
+    /**
+     * @brief 25Q存储器映射IOCTL参数
+     * @note 用于YDEV_25Q_IOCTL_MAP；映射成功时资源可以直接按地址读取，不经缓冲区拷贝。
+     *       STM32G0没有QSPI，Flash只经SPI访问，本平台上范围有效时总是返回YDEV_NOT_SUPPORTED且ptr为NULL，
+     *       范围越界时返回YDEV_INVALID_PARAM；调用者应退回yDev25qRead，
+     *       以后带QSPI映射的平台实现该命令时调用代码不需要修改
+     */
+    typedef struct
+    {
+        uint32_t address; /*!< Flash起始地址 */
+        uint32_t size;    /*!< 需要访问的字节数 */
+        const void *ptr;  /*!< 输出映射地址，不支持时为NULL */
+    } yDev25qMap_t;
 
     // ==================== 25Q错误代码定义 ====================
 
@@ -206,14 +686,6 @@ extern "C"
 
     // ==================== 25Q常用常量定义 ====================
 
-    /**
-     * @brief 25Q基本参数定义
-     */
-#define YDEV_25Q_PAGE_SIZE (256)         /*!< 标准页大小 (字节) */
-#define YDEV_25Q_SECTOR_SIZE (4096)      /*!< 标准扇区大小 (字节) */
-#define YDEV_25Q_HALF_BLOCK_SIZE (32768) /*!< 32KB块大小 (字节) */
-#define YDEV_25Q_BLOCK_SIZE (65536)      /*!< 64KB块大小 (字节) */
-
     /**
      * @brief 25Q常用时间定义 (毫秒)
      */
@@ -224,6 +696,8 @@ extern "C"
 #define YDEV_25Q_TIMEOUT_CHIP_ERASE (40000)     /*!< 芯片擦除超时时间 */
 #define YDEV_25Q_TIMEOUT_WRITE_ENABLE (1)       /*!< 写使能超时时间 */
 #define YDEV_25Q_TIMEOUT_POWER_DOWN (3)         /*!< 掉电模式超时时间 */
+#define YDEV_25Q_TIMEOUT_WRITE_STATUS (15)      /*!< 非易失状态寄存器写入超时时间(tW) */
+#define YDEV_25Q_TIME_RELEASE_US (30)           /*!< 退出掉电后到可以访问的等待时间(微秒)，覆盖常见型号的tRES1 */
 
     /**
      * @brief 25q JEDEC ID掩码定义
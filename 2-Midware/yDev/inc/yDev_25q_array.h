@@ -0,0 +1,233 @@
+/**
+ * @file yDev_25q_array.h
+ * @brief 多片25Q Flash条带阵列设备头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 把挂在不同SPI上的多片25Q组合成一个线性地址空间，按条带单元轮流分布到各片，
+ * 一次写入在各片上同时编程，擦除排在各片自己的队列中，与其他片的编程重叠
+ *
+ * @par 地址映射:
+ * 线性地址按stripe切成单元，第u个单元位于第u % chips片的(u / chips) * stripe处；
+ * 同一片上的单元在片内连续，所以一次写入在每片上都是一段连续的页编程
+ *
+ * @par 主要特性:
+ * - 每片一个通道，通道按操作队列顺序独立推进，写入用25Q异步页编程流水线，
+ *   一片的单元编程完成后通知推进任务，由推进任务发起该片的下一个单元
+ * - 写入期间各片的SPI数据装载和页编程时间互相重叠，吞吐量接近单片的chips倍
+ * - 后台擦除(YDEV_25Q_ARRAY_ERASE_ASYNC)只排入队列，先完成手头写入的片先开始擦除，
+ *   之后的写入在该片擦除完成后继续，其他片不必等待
+ * - stripe等于扇区时一个线性扇区只在一片上，顺序记录时下一扇区的擦除与当前扇区的编程在不同片上进行
+ *
+ * @par 使用约束:
+ * - 各片须为已登记的25Q设备，YDEV_25Q_MAX不小于片数(每片需要自己的异步写入定时器)
+ * - 写入只编程不擦除，目标区域应已擦除；读取按单元依次读各片
+ * - 线性容量为最小片容量乘片数，按擦除单元向下取整
+ */
+
+#ifndef YDEV_25Q_ARRAY_H
+#define YDEV_25Q_ARRAY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDev_25q.h"
+
+    // ==================== 25Q阵列常量定义 ====================
+
+    /**
+     * @brief 阵列最多片数
+     */
+#ifndef YDEV_25Q_ARRAY_CHIPS
+#define YDEV_25Q_ARRAY_CHIPS (2)
+#endif
+
+    /**
+     * @brief 操作队列深度，包括正在执行的写入和排队的后台擦除
+     */
+#ifndef YDEV_25Q_ARRAY_QUEUE
+#define YDEV_25Q_ARRAY_QUEUE (4)
+#endif
+
+    /**
+     * @brief 阵列实例数上限，每个实例一个推进任务和一个轮询定时器
+     */
+#ifndef YDEV_25Q_ARRAY_MAX
+#define YDEV_25Q_ARRAY_MAX (1)
+#endif
+
+    /**
+     * @brief 推进任务优先级，片忙等待期间查询状态寄存器，不宜高于实时任务
+     */
+#ifndef YDEV_25Q_ARRAY_TASK_PRIO
+#define YDEV_25Q_ARRAY_TASK_PRIO (2)
+#endif
+
+    /**
+     * @brief 推进任务堆栈大小(字)，发起单元经25Q锁、DMA和总线作业路径
+     */
+#ifndef YDEV_25Q_ARRAY_TASK_STACK
+#define YDEV_25Q_ARRAY_TASK_STACK (192)
+#endif
+
+    // ==================== 25Q阵列类型定义 ====================
+
+    /**
+     * @brief yDev 25Q阵列设备配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;                             /*!< yDev基础配置结构体 */
+        yDevHandle_25q_t *chip[YDEV_25Q_ARRAY_CHIPS]; /*!< 各片25Q设备句柄，已登记即可 */
+        uint8_t chips;                                 /*!< 片数，2~YDEV_25Q_ARRAY_CHIPS */
+        uint32_t stripe;                               /*!< 条带单元(字节)，2的幂，页~扇区，0使用一页 */
+    } yDevConfig_25qArray_t;
+
+    /**
+     * @brief 阵列操作
+     */
+    typedef struct
+    {
+        uint8_t type;                      /*!< 操作类型 */
+        uint8_t pending;                   /*!< 尚未完成的通道位图 */
+        yDevStatus_t status;               /*!< 操作结果，任一通道失败即失败 */
+        const uint8_t *buffer;             /*!< 写入数据 */
+        uint32_t address;                  /*!< 线性起始地址 */
+        uint32_t size;                     /*!< 线性长度 */
+        volatile yDevStatus_t *result;     /*!< 完成时写入结果，NULL不回报 */
+        void *waiter;                      /*!< 完成时通知的任务 */
+    } yDev25qArrayOp_t;
+
+    /**
+     * @brief 阵列通道(每片一个)
+     */
+    typedef struct
+    {
+        void *owner;             /*!< 所属阵列句柄，异步写入回调参数 */
+        yDevHandle_25q_t *chip;  /*!< 25Q设备句柄 */
+        uint32_t seq;            /*!< 正在执行的操作序号 */
+        uint32_t next;           /*!< 当前写入中本片下一个单元的线性地址 */
+        uint8_t started;         /*!< 当前操作已开始 */
+        uint8_t inflight;        /*!< 有一个单元正在异步编程 */
+        uint8_t erasing;         /*!< 已提交后台擦除，等待完成 */
+        uint8_t index;           /*!< 通道号，即片号 */
+        volatile uint8_t done;   /*!< 单元编程已完成，等推进任务处理 */
+        yDevStatus_t unitStatus; /*!< 已完成单元的编程结果 */
+    } yDev25qArrayLane_t;
+
+    /**
+     * @brief 阵列运行统计
+     */
+    typedef struct
+    {
+        uint32_t writes;                         /*!< 完成的写入操作数 */
+        uint32_t erases;                         /*!< 完成的擦除操作数 */
+        uint32_t bytes[YDEV_25Q_ARRAY_CHIPS];    /*!< 各片编程的字节数 */
+        uint32_t units[YDEV_25Q_ARRAY_CHIPS];    /*!< 各片发起的单元编程次数 */
+        uint32_t retries;                        /*!< 片忙(擦除未完成)推迟发起的次数 */
+        uint32_t overlaps;                       /*!< 推进时一片在擦除而另一片在编程的次数 */
+        uint32_t errors;                         /*!< 失败的操作数 */
+    } yDev25qArrayStats_t;
+
+    /**
+     * @brief yDev 25Q阵列设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;                              /*!< yDev基础句柄结构体 */
+        yDev25qArrayLane_t lane[YDEV_25Q_ARRAY_CHIPS];  /*!< 各片通道 */
+        yDev25qArrayOp_t op[YDEV_25Q_ARRAY_QUEUE];      /*!< 操作队列 */
+        volatile uint32_t head;                         /*!< 下一个入队序号 */
+        volatile uint32_t tail;                         /*!< 最旧未完成操作序号 */
+        uint32_t address;                               /*!< 当前操作线性地址 */
+        uint32_t size;                                  /*!< 线性容量 */
+        uint32_t stripe;                                /*!< 条带单元 */
+        uint32_t eraseUnit;                             /*!< 线性擦除单元 */
+        uint8_t chips;                                  /*!< 片数 */
+        void *task;                                     /*!< 推进任务 */
+        void *timer;                                    /*!< 片忙重试和擦除完成轮询定时器 */
+        yDev25qArrayStats_t stats;                      /*!< 运行统计 */
+    } yDevHandle_25qArray_t;
+
+    /**
+     * @brief 阵列信息(YDEV_25Q_ARRAY_GET_INFO)
+     */
+    typedef struct
+    {
+        uint32_t size;      /*!< 线性容量 */
+        uint32_t stripe;    /*!< 条带单元 */
+        uint32_t eraseUnit; /*!< 擦除地址和长度的对齐单位 */
+        uint8_t chips;      /*!< 片数 */
+    } yDev25qArrayInfo_t;
+
+/**
+ * @brief 25Q阵列配置结构体默认值
+ */
+#define YDEV_25Q_ARRAY_CONFIG_DEFAULT()        \
+    ((yDevConfig_25qArray_t){                 \
+        .base = {.type = YDEV_TYPE_25Q_ARRAY}, \
+        .chips = 2,                            \
+        .stripe = 0,                           \
+    })
+
+/**
+ * @brief 25Q阵列句柄结构体默认值
+ */
+#define YDEV_25Q_ARRAY_HANDLE_DEFAULT() \
+    ((yDevHandle_25qArray_t){           \
+        .base = YDEV_HANDLE_DEFAULT(),  \
+        .task = NULL,                   \
+        .timer = NULL,                  \
+    })
+
+    // ==================== 25Q阵列函数声明 ====================
+
+    /**
+     * @brief 初始化25Q阵列配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDev25qArrayConfigStructInit(yDevConfig_25qArray_t *config);
+
+    /**
+     * @brief 初始化25Q阵列句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDev25qArrayHandleStructInit(yDevHandle_25qArray_t *handle);
+
+/**
+ * @brief 25Q阵列设备错误码(base.errno)
+ */
+#define YDEV_25Q_ARRAY_ERRNO_NONE (0UL)          /*!< 无错误 */
+#define YDEV_25Q_ARRAY_ERRNO_ALIGN (1UL << (3))  /*!< 擦除范围未按擦除单元对齐 */
+#define YDEV_25Q_ARRAY_ERRNO_RANGE (1UL << (4))  /*!< 访问超出线性容量 */
+#define YDEV_25Q_ARRAY_ERRNO_FULL (1UL << (5))   /*!< 操作队列已满 */
+#define YDEV_25Q_ARRAY_ERRNO_CHIP (1UL << (6))   /*!< 某片读写或擦除失败 */
+
+/**
+ * @brief 25Q阵列设备IOCTL命令
+ * - YDEV_25Q_ARRAY_ERASE: 擦除并等待完成(arg: yDev25qEraseRange_t*，线性地址，按eraseUnit对齐)
+ * - YDEV_25Q_ARRAY_ERASE_ASYNC: 排入后台擦除后立即返回(arg: yDev25qEraseRange_t*)，队列满返回YDEV_BUSY
+ * - YDEV_25Q_ARRAY_SYNC: 等待队列中的操作全部完成(arg: NULL)
+ * - YDEV_25Q_ARRAY_GET_INFO: 获取阵列信息(arg: yDev25qArrayInfo_t*)
+ * - YDEV_25Q_ARRAY_GET_STATS: 获取运行统计(arg: yDev25qArrayStats_t*)
+ */
+#define YDEV_25Q_ARRAY_IOCTL_BASE (YDEV_IOCTL_BASE + 0xB00)
+#define YDEV_25Q_ARRAY_ERASE (YDEV_25Q_ARRAY_IOCTL_BASE + 0)
+#define YDEV_25Q_ARRAY_ERASE_ASYNC (YDEV_25Q_ARRAY_IOCTL_BASE + 1)
+#define YDEV_25Q_ARRAY_SYNC (YDEV_25Q_ARRAY_IOCTL_BASE + 2)
+#define YDEV_25Q_ARRAY_GET_INFO (YDEV_25Q_ARRAY_IOCTL_BASE + 3)
+#define YDEV_25Q_ARRAY_GET_STATS (YDEV_25Q_ARRAY_IOCTL_BASE + 4)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_25Q_ARRAY_H */
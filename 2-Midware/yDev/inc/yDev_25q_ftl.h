@@ -0,0 +1,159 @@
+/**
+ * @file yDev_25q_ftl.h
+ * @brief 25Q Flash磨损均衡转换层(FTL)设备头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 在yDev 25Q设备之上提供逻辑扇区地址空间，写入重映射到预擦除的物理扇区，
+ * 旧物理扇区交给后台擦除，写入路径基本不再等待擦除
+ *
+ * @par 主要特性:
+ * - 逻辑扇区到物理扇区映射，挂载时从物理扇区头重建
+ * - 写入数据可直接编程(只有1变0)时原地写入，不重映射
+ * - 写入内容与原数据相同时跳过编程
+ * - 动态磨损均衡: 分配擦除次数最少的空闲扇区
+ * - 静态磨损均衡: 冷数据扇区与高擦除次数空闲扇区差值超限时迁移冷数据
+ *
+ * @par 存储布局:
+ * - 每个物理扇区第一页为扇区头: 擦除后立即写入的擦除记录(魔术字、擦除次数)、
+ *   分配标记，以及数据写完后写入的映射记录(逻辑扇区号、序号)
+ * - 其余页为逻辑扇区数据，逻辑扇区大小为YDEV_25Q_FTL_SECTOR_SIZE
+ */
+
+#ifndef YDEV_25Q_FTL_H
+#define YDEV_25Q_FTL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDev_25q.h"
+
+    // ==================== 25Q FTL常量定义 ====================
+
+    /**
+     * @brief 静态磨损均衡触发阈值(擦除次数差)
+     */
+#ifndef YDEV_25Q_FTL_WEAR_DELTA
+#define YDEV_25Q_FTL_WEAR_DELTA (32)
+#endif
+
+#define YDEV_25Q_FTL_MAGIC (0x33544659UL)                                     /*!< 扇区头魔术字 "YFT3"(擦除记录与映射记录分开) */
+#define YDEV_25Q_FTL_HEADER_SIZE (YDEV_25Q_PAGE_SIZE)                         /*!< 扇区头占用一页 */
+#define YDEV_25Q_FTL_SECTOR_SIZE (YDEV_25Q_SECTOR_SIZE - YDEV_25Q_FTL_HEADER_SIZE) /*!< 逻辑扇区大小 */
+#define YDEV_25Q_FTL_UNMAPPED (0xFFFFU)                                       /*!< 未映射标记 */
+
+    // ==================== 25Q FTL类型定义 ====================
+
+    /**
+     * @brief 25Q FTL物理扇区状态
+     */
+    typedef enum
+    {
+        YDEV_25Q_FTL_STATE_STALE = 0, /*!< 内容无效，等待擦除 */
+        YDEV_25Q_FTL_STATE_ERASED,    /*!< 已擦除(或已提交后台擦除)，可分配 */
+        YDEV_25Q_FTL_STATE_MAPPED,    /*!< 已映射到逻辑扇区 */
+    } yDev25qFtlState_t;
+
+    /**
+     * @brief 25Q FTL物理扇区信息
+     */
+    typedef struct
+    {
+        uint32_t eraseCount; /*!< 擦除次数 */
+        uint32_t seq;        /*!< 映射序号，挂载时用于选出同一逻辑扇区的最新副本 */
+        uint8_t state;       /*!< 扇区状态 yDev25qFtlState_t */
+        uint8_t pending;     /*!< 已提交后台擦除，擦除记录尚未写入 */
+    } yDev25qFtlSector_t;
+
+    /**
+     * @brief 25Q FTL状态信息
+     * @note 用于YDEV_25Q_FTL_IOCTL_GET_INFO
+     */
+    typedef struct
+    {
+        uint32_t sectorSize;   /*!< 逻辑扇区大小 */
+        uint16_t logicalCount; /*!< 逻辑扇区数 */
+        uint16_t freeCount;    /*!< 可分配物理扇区数 */
+        uint16_t staleCount;   /*!< 待擦除物理扇区数 */
+        uint32_t minErase;     /*!< 最小擦除次数 */
+        uint32_t maxErase;     /*!< 最大擦除次数 */
+    } yDev25qFtlInfo_t;
+
+    /**
+     * @brief yDev 25Q FTL配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;       /*!< yDev基础配置结构体 */
+        yDevHandle_25q_t *flash; /*!< 已初始化的25Q设备句柄 */
+        uint32_t baseAddress;    /*!< FTL区域起始地址(扇区对齐) */
+        uint16_t sectorCount;    /*!< FTL区域物理扇区数 */
+        uint16_t spareCount;     /*!< 预留空闲物理扇区数，至少1个 */
+    } yDevConfig_25qFtl_t;
+
+    /**
+     * @brief yDev 25Q FTL设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;          /*!< yDev基础句柄结构体 */
+        yDevHandle_25q_t *flash;    /*!< 25Q设备句柄 */
+        uint32_t baseAddress;       /*!< FTL区域起始地址 */
+        uint32_t address;           /*!< 当前逻辑字节地址 */
+        uint32_t size;              /*!< 逻辑地址空间大小 */
+        uint32_t seq;               /*!< 最大映射序号 */
+        uint16_t physCount;         /*!< 物理扇区数 */
+        uint16_t logicalCount;      /*!< 逻辑扇区数 */
+        uint16_t *map;              /*!< 逻辑扇区到物理扇区映射表 */
+        yDev25qFtlSector_t *sector; /*!< 物理扇区信息表 */
+#if YLIB_NO_HEAP_AFTER_INIT
+        uint8_t page[YDEV_25Q_PAGE_SIZE]; /*!< 任务没有线性分配器时重映射用的页缓冲区，代替堆 */
+#endif
+    } yDevHandle_25qFtl_t;
+
+    // =============== yDev 25Q FTL配置初始化宏 ====================
+
+    /**
+     * @brief yDev 25Q FTL配置结构体默认初始化宏
+     */
+#define YDEV_25Q_FTL_CONFIG_DEFAULT()          \
+    ((yDevConfig_25qFtl_t){                    \
+        .base = {.type = YDEV_TYPE_25Q_FTL},   \
+        .flash = NULL,                         \
+        .baseAddress = 0,                      \
+        .sectorCount = 0,                      \
+        .spareCount = 2})
+
+    /**
+     * @brief yDev 25Q FTL句柄结构体默认初始化宏
+     */
+#define YDEV_25Q_FTL_HANDLE_DEFAULT()  \
+    {                                  \
+        .base = YDEV_HANDLE_DEFAULT(), \
+        .flash = NULL,                 \
+        .map = NULL,                   \
+        .sector = NULL}
+
+// ==================== 25Q FTL IOCTL命令定义 ====================
+
+/**
+ * @brief 25Q FTL设备IOCTL命令
+ */
+#define YDEV_25Q_FTL_IOCTL_BASE (YDEV_IOCTL_BASE + 0x280)
+
+#define YDEV_25Q_FTL_IOCTL_GET_INFO (YDEV_25Q_FTL_IOCTL_BASE + 1) /**< 读取状态(arg: yDev25qFtlInfo_t*) */
+#define YDEV_25Q_FTL_IOCTL_TRIM (YDEV_25Q_FTL_IOCTL_BASE + 2)     /**< 释放逻辑扇区(arg: uint32_t*逻辑扇区号) */
+#define YDEV_25Q_FTL_IOCTL_FORMAT (YDEV_25Q_FTL_IOCTL_BASE + 3)   /**< 清空全部映射 */
+#define YDEV_25Q_FTL_IOCTL_RECLAIM (YDEV_25Q_FTL_IOCTL_BASE + 4)  /**< 提交待擦除扇区到后台擦除 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_25Q_FTL_H */
@@ -0,0 +1,151 @@
+/**
+ * @file yDev_adc.h
+ * @brief yDev ADC流式采样设备驱动头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 基于yDev框架的ADC设备，定时器触发多通道扫描，循环DMA双缓冲连续采样
+ *
+ * @par 主要特性:
+ * - 同步读取：返回最近一帧完整的序列结果，不需要中断
+ * - 异步读取：等待下一个写满的半块并复制到用户缓冲区，完成回调中可立即启动下一次读取
+ * - 驱动配置中的回调仍然有效，在中断中直接拿到半块指针，零拷贝处理
+ * - 任务零拷贝：YDEV_ADC_ACQUIRE取最早写满的半块指针，处理完YDEV_ADC_RELEASE，
+ *   由ylib_dblbuf记录DMA正在写哪一半，任务来迟时跳过被覆盖的半块并计数
+ * - 采样全程由硬件完成，CPU每半块只处理一次中断
+ */
+
+#ifndef YDEV_ADC_H
+#define YDEV_ADC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDrv_adc.h"
+#include "yLib_dblbuf.h"
+
+    // ==================== ADC设备特定定义 ====================
+
+    /**
+     * @brief yDev ADC设备配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;          /*!< yDev基础配置结构体 */
+        yDrvAdcConfig_t drv_config; /*!< ADC底层驱动配置结构体 */
+    } yDevConfig_Adc_t;
+
+    /**
+     * @brief yDev ADC设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;          /*!< yDev基础句柄结构体 */
+        yDrvAdcHandle_t drv_handle; /*!< ADC底层驱动句柄 */
+        yDrvAdcCallback_t callback; /*!< 用户配置的驱动回调，设备回调中转调用 */
+        void *arg;                  /*!< 用户回调参数 */
+        void *volatile async_buf;   /*!< 等待中的异步读取缓冲区，NULL表示没有 */
+        uint32_t async_size;        /*!< 异步读取缓冲区字节数 */
+        volatile uint32_t dropped;  /*!< 无人接收而丢弃的半块数 */
+        ylib_dblbuf_t stream;       /*!< 两个半块的登记，任务零拷贝取块时使用 */
+        uint8_t zero_copy;          /*!< 已有任务以YDEV_ADC_ACQUIRE取块，半块不再计入dropped */
+    } yDevHandle_Adc_t;
+
+    /**
+     * @brief ADC运行统计
+     */
+    typedef struct
+    {
+        uint32_t blocks;   /*!< 已写满的半块数 */
+        uint32_t dropped;  /*!< 既没有异步读取也没有用户回调而丢弃的半块数 */
+        uint32_t overruns; /*!< 溢出重启次数 */
+        uint32_t late;     /*!< 零拷贝取块来迟，DMA写入未释放半块的次数 */
+        uint32_t skipped;  /*!< 零拷贝取块时跳过的已覆盖半块数 */
+    } yDevAdcStats_t;
+
+// ==================== yDev ADC配置初始化宏 ====================
+
+/**
+ * @brief yDev ADC配置结构体默认初始化宏
+ */
+#define YDEV_ADC_CONFIG_DEFAULT()                \
+    ((yDevConfig_Adc_t){                         \
+        .base = {.type = YDEV_TYPE_ADC},         \
+        .drv_config = YDRV_ADC_CONFIG_DEFAULT(), \
+    })
+
+/**
+ * @brief yDev ADC句柄结构体默认初始化宏
+ */
+#define YDEV_ADC_HANDLE_DEFAULT()                \
+    ((yDevHandle_Adc_t){                         \
+        .base = YDEV_HANDLE_DEFAULT(),           \
+        .drv_handle = YDRV_ADC_HANDLE_DEFAULT(), \
+        .callback = NULL,                        \
+        .arg = NULL,                             \
+        .async_buf = NULL,                       \
+        .async_size = 0,                         \
+        .dropped = 0,                            \
+        .zero_copy = 0,                          \
+    })
+
+    // ==================== ADC设备API ====================
+
+    /**
+     * @brief 初始化ADC配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDevAdcConfigStructInit(yDevConfig_Adc_t *config);
+
+    /**
+     * @brief 初始化ADC句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDevAdcHandleStructInit(yDevHandle_Adc_t *handle);
+
+    // ==================== 快速访问内联函数 ====================
+
+    /**
+     * @brief 快速读取最近一帧序列结果
+     * @param handle ADC设备句柄
+     * @param frame 输出缓冲区，至少为序列通道数个半字
+     * @retval yDrvStatus_t 操作状态，含义同yDrvAdcReadFrame
+     * @note 绕过yDev框架
+     */
+    YLIB_INLINE yDrvStatus_t yDevAdcReadFrameFast(yDevHandle_Adc_t *handle, uint16_t *frame)
+    {
+        return yDrvAdcReadFrame(&handle->drv_handle, frame);
+    }
+
+/**
+ * @brief ADC设备IOCTL命令
+ * - YDEV_ADC_START: 从缓冲区开头启动流式采样(arg: NULL)
+ * - YDEV_ADC_STOP: 停止采样，等待中的异步读取以错误结束(arg: NULL)
+ * - YDEV_ADC_GET_BLOCK_SIZE: 获取每个半块的字节数(arg: uint32_t*)
+ * - YDEV_ADC_GET_FRAME_HZ: 获取TIM6触发时的实际序列频率(arg: uint32_t*)
+ * - YDEV_ADC_GET_STATS: 获取运行统计(arg: yDevAdcStats_t*)
+ * - YDEV_ADC_ACQUIRE: 取最早写满的半块(arg: const uint16_t**)，没有时返回YDEV_BUSY，重复取得同一块
+ * - YDEV_ADC_RELEASE: 释放取得的半块(arg: NULL)，持有期间被DMA覆盖时返回YDEV_ERROR，处理结果应丢弃
+ */
+#define YDEV_ADC_IOCTL_BASE (YDEV_IOCTL_BASE + 0x700)
+#define YDEV_ADC_START (YDEV_ADC_IOCTL_BASE + 0)
+#define YDEV_ADC_STOP (YDEV_ADC_IOCTL_BASE + 1)
+#define YDEV_ADC_GET_BLOCK_SIZE (YDEV_ADC_IOCTL_BASE + 2)
+#define YDEV_ADC_GET_FRAME_HZ (YDEV_ADC_IOCTL_BASE + 3)
+#define YDEV_ADC_GET_STATS (YDEV_ADC_IOCTL_BASE + 4)
+#define YDEV_ADC_ACQUIRE (YDEV_ADC_IOCTL_BASE + 5)
+#define YDEV_ADC_RELEASE (YDEV_ADC_IOCTL_BASE + 6)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_ADC_H */
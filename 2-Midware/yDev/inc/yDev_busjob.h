@@ -0,0 +1,167 @@
+/**
+ * @file yDev_busjob.h
+ * @brief 总线作业调度头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 代替总线互斥锁，等待总线的任务作为作业按类别和截止时间排队，总线释放时交给最紧急的作业；
+ * 长作业(整片擦除、多页写入)在安全点检查是否有更紧急的作业在等待，有则让出总线后重新排队
+ *
+ * @par 主要特性:
+ * - 类别小的优先，同类别按截止时间先后(EDF)，等待队列为yLib_pqueue索引堆
+ * - 作业提交时给出相对截止时间，0使用类别默认值；开始时已过截止时间计为一次错过
+ * - 持有者优先级低于等待者时临时提升到等待者的优先级，释放时恢复，等同互斥锁的优先级继承
+ * - 等待和让出通过任务通知数组的YDEV_BUSJOB_NOTIFY_INDEX号条目，不占用默认通知
+ * - 按类别统计执行次数、错过次数、让出次数、最大等待和最大超出时间，
+ *   以及遇到总线被占用的次数、超时次数和最长等待时的持有者，用来定位优先级反转的来源
+ *
+ * @par 使用约束:
+ * 只能在任务中使用，同一任务不能嵌套持有同一总线；调度器启动前直接获得总线
+ */
+
+#ifndef YDEV_BUSJOB_H
+#define YDEV_BUSJOB_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yLib_pqueue.h"
+
+    // ==================== 总线作业类型定义 ====================
+
+    /**
+     * @brief 作业类别，数值小的先执行
+     */
+    typedef enum
+    {
+        YDEV_BUSJOB_URGENT = 0,   /*!< 截止时间严格的读取、传感器采样 */
+        YDEV_BUSJOB_READ,         /*!< 普通读取和控制命令 */
+        YDEV_BUSJOB_WRITE,        /*!< 页编程 */
+        YDEV_BUSJOB_ERASE,        /*!< 同步擦除 */
+        YDEV_BUSJOB_BACKGROUND,   /*!< 后台擦除、缓存预取等维护工作 */
+        YDEV_BUSJOB_CLASS_MAX     /*!< 类别数量 */
+    } yDevBusJobClass_t;
+
+    /**
+     * @brief 单个类别的调度统计
+     */
+    typedef struct
+    {
+        uint32_t runs;                             /*!< 获得总线的次数，让出后重新获得不计 */
+        uint32_t misses;                           /*!< 获得总线时已超过截止时间的次数 */
+        uint32_t preempts;                         /*!< 在安全点让出总线的次数 */
+        uint32_t max_wait_ms;                      /*!< 提交到获得总线的最长等待 */
+        uint32_t max_late_ms;                      /*!< 获得总线时超出截止时间的最大值 */
+        uint32_t contended;                        /*!< 提交时总线被占用的次数，含超时 */
+        uint32_t timeouts;                         /*!< 等待超时的次数 */
+        char max_wait_owner[YDEV_BUSJOB_NAME_LEN]; /*!< 最长等待的作业提交时的持有者任务名 */
+    } yDevBusJobStats_t;
+
+    /**
+     * @brief 类别默认截止时间设置参数
+     */
+    typedef struct
+    {
+        uint32_t cls;         /*!< 作业类别(yDevBusJobClass_t) */
+        uint32_t deadline_ms; /*!< 相对截止时间(毫秒) */
+    } yDevBusJobDeadline_t;
+
+    /**
+     * @brief 总线作业调度器，嵌入在总线或独占总线的设备句柄中
+     */
+    typedef struct
+    {
+        struct ylib_pq queue;                                  /*!< 等待的作业 */
+        struct ylib_pq_node *heap[YDEV_BUSJOB_QUEUE_MAX];      /*!< 等待队列存储 */
+        void *owner;                                           /*!< 持有总线的任务，NULL为空闲 */
+        uint32_t deadline;                                     /*!< 持有者作业的截止时间 */
+        uint8_t cls;                                           /*!< 持有者作业的类别 */
+        uint8_t boosted;                                       /*!< 持有者优先级已被提升 */
+        uint8_t base_prio;                                     /*!< 持有者提升前的优先级 */
+        uint32_t deadline_ms[YDEV_BUSJOB_CLASS_MAX];           /*!< 各类别默认相对截止时间 */
+        yDevBusJobStats_t stats[YDEV_BUSJOB_CLASS_MAX];        /*!< 各类别统计 */
+    } yDevBusSched_t;
+
+    // ==================== 总线作业函数声明 ====================
+
+    /**
+     * @brief 初始化调度器
+     * @param sched 调度器指针
+     * @note 默认截止时间见YDEV_BUSJOB_DEADLINE_*_MS
+     */
+    void yDevBusSchedInit(yDevBusSched_t *sched);
+
+    /**
+     * @brief 提交作业并等待获得总线
+     * @param sched 调度器指针
+     * @param cls 作业类别
+     * @param deadline_ms 相对截止时间(毫秒)，0使用类别默认值
+     * @param timeOutMs 等待总线的超时时间(毫秒)
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 已获得总线
+     *         - YDEV_TIMEOUT: 等待超时
+     *         - YDEV_NO_MEMORY: 等待队列已满(YDEV_BUSJOB_QUEUE_MAX)
+     */
+    yDevStatus_t yDevBusJobBegin(yDevBusSched_t *sched, yDevBusJobClass_t cls, uint32_t deadline_ms,
+                                 uint32_t timeOutMs);
+
+    /**
+     * @brief 作业结束，释放总线给最紧急的等待作业
+     * @param sched 调度器指针
+     */
+    void yDevBusJobEnd(yDevBusSched_t *sched);
+
+    /**
+     * @brief 是否有比持有者更紧急的作业在等待
+     * @param sched 调度器指针
+     * @param limit 只考虑类别小于该值的作业，YDEV_BUSJOB_CLASS_MAX为不限
+     * @retval 1 应在安全点让出，0 无需让出
+     * @note 同类别不抢占，截止时间只决定排队顺序；limit用于让出期间器件只允许部分操作的情况，
+     *       如擦除挂起期间不能编程被擦除的扇区
+     */
+    uint8_t yDevBusJobPreemptPending(yDevBusSched_t *sched, yDevBusJobClass_t limit);
+
+    /**
+     * @brief 安全点让出总线
+     * @param sched 调度器指针
+     * @param limit 只让给类别小于该值的作业，YDEV_BUSJOB_CLASS_MAX为不限
+     * @retval 1 已让出并重新获得总线，总线参数可能已被其他器件改变；0 无需让出
+     * @note 持有者作业保持原类别和截止时间重新排队，不计入执行次数
+     */
+    uint8_t yDevBusJobYield(yDevBusSched_t *sched, yDevBusJobClass_t limit);
+
+    /**
+     * @brief 持有总线时等待，有更紧急的作业提交时提前返回
+     * @param sched 调度器指针
+     * @param ms 最长等待时间(毫秒)
+     * @note 用于长作业轮询芯片忙标志的间隔，返回后用yDevBusJobPreemptPending判断原因，残留的唤醒只造成一次提前返回
+     */
+    void yDevBusJobSleep(yDevBusSched_t *sched, uint32_t ms);
+
+    /**
+     * @brief 设置类别默认截止时间
+     * @param sched 调度器指针
+     * @param deadline 类别和截止时间
+     * @retval yDevStatus_t 操作状态
+     */
+    yDevStatus_t yDevBusJobSetDeadline(yDevBusSched_t *sched, const yDevBusJobDeadline_t *deadline);
+
+    /**
+     * @brief 读取统计
+     * @param sched 调度器指针
+     * @param stats 输出数组，YDEV_BUSJOB_CLASS_MAX项
+     * @param reset 非0时读取后清零
+     */
+    void yDevBusJobGetStats(yDevBusSched_t *sched, yDevBusJobStats_t *stats, uint8_t reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_BUSJOB_H */
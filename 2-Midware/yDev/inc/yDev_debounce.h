@@ -0,0 +1,121 @@
+/**
+ * @file yDev_debounce.h
+ * @brief GPIO边沿捕获与消抖服务头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 为多个GPIO输入提供统一的边沿捕获和消抖，消抖后的电平变化以事件形式经队列交给使用者
+ *
+ * @par 工作方式:
+ * - EXTI回调只记录(线号, 电平, 微秒时间戳)并放入环形缓冲区，中断内不做消抖计算
+ * - 一个周期软件定时器取出记录，每个引脚最后一次边沿之后保持稳定达到各自的消抖时间，
+ *   且稳定电平与上次上报的不同，才产生一个事件
+ * - 事件时间戳为这一串抖动中第一个边沿的时间，反映真实的按下/松开时刻
+ * - 所有引脚共用一个定时器和一个队列，不需要每个引脚一个定时器
+ */
+
+#ifndef YDEV_DEBOUNCE_H
+#define YDEV_DEBOUNCE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDev_gpio.h"
+
+    // ==================== 消抖服务类型定义 ====================
+
+    /**
+     * @brief 消抖后的边沿方向
+     */
+    typedef enum
+    {
+        YDEV_DEBOUNCE_EDGE_FALLING = 0, /*!< 稳定为低电平 */
+        YDEV_DEBOUNCE_EDGE_RISING = 1,  /*!< 稳定为高电平 */
+    } yDevDebounceEdge_t;
+
+    /**
+     * @brief 消抖事件
+     */
+    typedef struct
+    {
+        yDevHandle_Gpio_t *gpio; /*!< 产生事件的GPIO设备句柄 */
+        uint8_t line;            /*!< EXTI线号(引脚号0-15) */
+        uint8_t edge;            /*!< 边沿方向，yDevDebounceEdge_t */
+        uint16_t bounces;        /*!< 这一串抖动中捕获到的边沿数 */
+        uint32_t time_us;        /*!< 第一个边沿的微秒时间戳 */
+    } yDevDebounceEvent_t;
+
+/**
+ * @brief yDevDebounceGet一直等待的超时值
+ */
+#define YDEV_DEBOUNCE_WAIT_FOREVER (0xFFFFFFFFUL)
+
+    // ==================== 消抖服务API ====================
+
+    /**
+     * @brief 启动消抖服务
+     * @retval yDevStatus_t 启动状态
+     *         - YDEV_OK: 启动成功，重复调用直接返回成功
+     *         - YDEV_NO_MEMORY: 事件队列或定时器创建失败
+     * @note 创建事件队列和周期为YDEV_DEBOUNCE_TICK_MS的软件定时器，须在调度器启动后或任务中调用
+     */
+    yDevStatus_t yDevDebounceInit(void);
+
+    /**
+     * @brief 将GPIO输入加入消抖服务
+     * @param gpio 已初始化为输入模式的GPIO设备句柄
+     * @param debounce_ms 消抖时间(毫秒)，最后一个边沿之后保持稳定的时间
+     * @param prio EXTI中断优先级
+     * @retval yDevStatus_t 添加状态
+     *         - YDEV_OK: 已添加，按当前引脚电平作为初始稳定电平
+     *         - YDEV_BUSY: 该EXTI线已被其他引脚占用
+     *         - YDEV_NO_MEMORY: 引脚数已达YDEV_DEBOUNCE_MAX
+     * @note 以双沿触发注册EXTI回调，会覆盖该引脚原有的回调
+     */
+    yDevStatus_t yDevDebounceAdd(yDevHandle_Gpio_t *gpio, uint32_t debounce_ms, uint32_t prio);
+
+    /**
+     * @brief 将GPIO输入移出消抖服务
+     * @param gpio GPIO设备句柄
+     * @retval yDevStatus_t 移除状态，未添加时返回YDEV_DEVICE_NOT_FOUND
+     * @note 注销EXTI回调，尚未处理的边沿被丢弃
+     */
+    yDevStatus_t yDevDebounceRemove(yDevHandle_Gpio_t *gpio);
+
+    /**
+     * @brief 获取一个消抖事件
+     * @param event 输出的事件
+     * @param timeOutMs 超时时间(毫秒)，0表示不等待，YDEV_DEBOUNCE_WAIT_FOREVER表示一直等待
+     * @retval yDevStatus_t 获取状态，超时返回YDEV_TIMEOUT，服务未启动返回YDEV_NOT_INITIALIZED
+     */
+    yDevStatus_t yDevDebounceGet(yDevDebounceEvent_t *event, uint32_t timeOutMs);
+
+    /**
+     * @brief 查询因缓冲区满而丢弃的记录和事件数
+     * @param lost_edges 输出丢弃的边沿记录数，可为NULL
+     * @param lost_events 输出丢弃的消抖事件数，可为NULL
+     * @retval 无
+     * @note 丢弃边沿记录只影响抖动计数和首边沿时间，稳定电平在定时器中重新读取，不会丢失
+     */
+    void yDevDebounceGetLost(uint32_t *lost_edges, uint32_t *lost_events);
+
+    /**
+     * @brief 设置新事件通知函数
+     * @param notify 通知函数，NULL表示不通知
+     * @retval 无
+     * @note 在定时器任务中、本周期的事件全部入队后调用一次，函数内可以用0超时取事件，
+     *       不能阻塞；使用者不需要为等待事件单独建任务
+     */
+    void yDevDebounceSetNotify(void (*notify)(void));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_DEBOUNCE_H */
@@ -1,19 +1,21 @@
 /**
  * @file yDev_dma.h
- * @brief yDev DMA设备驱动头文件
- * @version 2.0
+ * @brief yDev DMA内存拷贝设备头文件
+ * @version 2.1
  * @date 2025
  * @author YLab Development Team
  *
  * @par 功能描述:
- * 提供基于yDrv的DMA设备抽象层接口，支持多种传输模式和配置选项
+ * 基于yDrv DMA的内存到内存拷贝引擎，大块数据搬移不占用CPU
  *
  * @par 主要特性:
- * - 支持内存到内存、内存到外设、外设到内存传输
- * - 支持正常模式和循环模式
- * - 完整的中断管理和回调机制
- * - 统一的错误处理和状态查询
- * - 支持多通道并发操作
+ * - 初始化时自动分配空闲DMA通道
+ * - 源、目标地址和长度4字节对齐时使用32位传输，否则使用8位传输
+ * - 超过65535个数据项的拷贝在传输完成中断中分段续传
+ * - 长度小于交叉点时直接用CPU memcpy，交叉点在初始化时实测
+ * - 支持完成回调异步拷贝和阻塞等待拷贝
+ * - 引擎忙时退回CPU memcpy，拷贝请求不会失败
+ * - 设置读写窗口后可用yDevRead/yDevWrite及其异步版本在窗口与缓冲区之间拷贝
  */
 
 #ifndef YDEV_DMA_H
@@ -28,76 +30,142 @@ extern "C"
 #include "yDrv_dma.h"
 #include "yDev.h"
 
-    // ==================== DMA设备特定定义 ====================
+    // ==================== DMA设备类型定义 ====================
+
+    /**
+     * @brief DMA拷贝完成回调函数类型
+     * @param arg 用户参数
+     * @param status 拷贝结果
+     * @note DMA拷贝时在传输完成中断中执行，CPU拷贝时在调用者上下文中执行
+     */
+    typedef void (*yDevDmaCallback_t)(void *arg, yDevStatus_t status);
+
+    /**
+     * @brief DMA拷贝请求
+     * @note 用于YDEV_DMA_IOCTL_COPY，源和目标区域不能重叠
+     */
+    typedef struct
+    {
+        void *dst;                  /*!< 目标地址 */
+        const void *src;            /*!< 源地址 */
+        uint32_t len;               /*!< 拷贝字节数 */
+        yDevDmaCallback_t callback; /*!< 完成回调，NULL表示阻塞等待完成 */
+        void *arg;                  /*!< 回调参数 */
+    } yDevDmaCopy_t;
+
+    /**
+     * @brief DMA设备读写窗口
+     * @note 用于YDEV_DMA_IOCTL_SET_WINDOW；读取从窗口拷贝到用户缓冲区，写入反之，
+     *       读写位置从窗口起始开始，每次读写后向后推进
+     */
+    typedef struct
+    {
+        void *base;    /*!< 窗口起始地址 */
+        uint32_t size; /*!< 窗口字节数 */
+    } yDevDmaWindow_t;
+
+    /**
+     * @brief DMA拷贝统计信息
+     * @note 用于YDEV_DMA_IOCTL_GET_STATS
+     */
+    typedef struct
+    {
+        uint32_t dma_copies; /*!< DMA完成的拷贝次数 */
+        uint32_t dma_bytes;  /*!< DMA拷贝的字节数 */
+        uint32_t cpu_copies; /*!< 退回CPU的拷贝次数(短拷贝或引擎忙) */
+        uint32_t cpu_bytes;  /*!< CPU拷贝的字节数 */
+        uint32_t errors;     /*!< 传输错误次数 */
+    } yDevDmaStats_t;
 
     /**
      * @brief yDev DMA设备配置结构体
-     * @note 包含yDev基础配置和DMA特定的驱动配置参数
      */
     typedef struct
     {
         yDevConfig_t base;          /*!< yDev基础配置结构体 */
-        yDrvDmaConfig_t drv_config; /*!< DMA底层驱动配置结构体 */
+        yDrvDmaChannel_t channel;   /*!< DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配 */
+        yDrvDmaPriority_t priority; /*!< DMA通道优先级 */
+        uint32_t prio;              /*!< 传输完成中断优先级 */
+        uint32_t crossover;         /*!< CPU/DMA交叉点字节数，0表示初始化时实测 */
     } yDevConfig_Dma_t;
 
-    // ==================== DMA设备句柄结构体 ====================
-
     /**
      * @brief yDev DMA设备句柄结构体
-     * @note 包含yDev基础句柄和DMA特定的驱动句柄
      */
     typedef struct
     {
-        yDevHandle_t base;          /*!< yDev基础句柄结构体 */
-        yDrvDmaHandle_t drv_handle; // yDrv的DMA驱动句柄
+        yDevHandle_t base;            /*!< yDev基础句柄结构体 */
+        yDrvDmaHandle_t drv_handle;   /*!< yDrv DMA驱动句柄 */
+        uint8_t *dst;                 /*!< 下一段目标地址 */
+        const uint8_t *src;           /*!< 下一段源地址 */
+        uint32_t remain;              /*!< 当前段之后剩余的字节数 */
+        uint32_t total;               /*!< 本次拷贝总字节数 */
+        uint8_t shift;                /*!< 数据项宽度(0=8位, 2=32位) */
+        volatile uint8_t busy;        /*!< 拷贝进行中 */
+        volatile yDevStatus_t status; /*!< 最近一次拷贝结果 */
+        yDevDmaCallback_t callback;   /*!< 完成回调 */
+        void *arg;                    /*!< 回调参数 */
+        void *wait_task;              /*!< 阻塞等待完成的任务 */
+        uint32_t crossover;           /*!< CPU/DMA交叉点字节数 */
+        yDevDmaStats_t stats;         /*!< 拷贝统计 */
+        uint8_t *window;              /*!< 读写窗口起始地址，NULL表示未设置 */
+        uint32_t window_size;         /*!< 读写窗口字节数 */
+        uint32_t offset;              /*!< 窗口内的读写位置 */
     } yDevHandle_Dma_t;
 
-    // ==================== DMA设备状态枚举类型 ====================
+    // ==================== yDev DMA配置初始化宏 ====================
+
+    /**
+     * @brief yDev DMA配置结构体默认初始化宏
+     */
+#define YDEV_DMA_CONFIG_DEFAULT()          \
+    ((yDevConfig_Dma_t){                   \
+        .base = {.type = YDEV_TYPE_DMA},   \
+        .channel = YDRV_DMA_CHANNEL_AUTO,  \
+        .priority = YDRV_DMA_PRIORITY_LOW, \
+        .prio = YDRV_IRQ_PRIO_DMA,         \
+        .crossover = 0})
+
+    /**
+     * @brief yDev DMA句柄结构体默认初始化宏
+     */
+#define YDEV_DMA_HANDLE_DEFAULT()                \
+    {                                            \
+        .base = YDEV_HANDLE_DEFAULT(),           \
+        .drv_handle = YDRV_DMA_HANDLE_DEFAULT(), \
+        .busy = 0}
 
 // ==================== DMA设备IOCTL命令定义 ====================
 
 /**
  * @brief DMA设备IOCTL命令
  */
-#define YDEV_DMA_IOCTL_BASE (YDEV_IOCTL_BASE + 0x200)
-#define YDEV_DMA_IOCTL_START (YDEV_DMA_IOCTL_BASE + 1)         /**< 启动传输 */
-#define YDEV_DMA_IOCTL_STOP (YDEV_DMA_IOCTL_BASE + 2)          /**< 停止传输 */
-#define YDEV_DMA_IOCTL_PAUSE (YDEV_DMA_IOCTL_BASE + 3)         /**< 暂停传输 */
-#define YDEV_DMA_IOCTL_RESUME (YDEV_DMA_IOCTL_BASE + 4)        /**< 恢复传输 */
-#define YDEV_DMA_IOCTL_GET_STATUS (YDEV_DMA_IOCTL_BASE + 5)    /**< 获取状态 */
-#define YDEV_DMA_IOCTL_GET_REMAINING (YDEV_DMA_IOCTL_BASE + 6) /**< 获取剩余传输量 */
-#define YDEV_DMA_IOCTL_SET_CALLBACK (YDEV_DMA_IOCTL_BASE + 7)  /**< 设置回调函数 */
-#define YDEV_DMA_IOCTL_CLEAR_ERRORS (YDEV_DMA_IOCTL_BASE + 8)  /**< 清除错误标志 */
-#define YDEV_DMA_IOCTL_GET_ERRORS (YDEV_DMA_IOCTL_BASE + 9)    /**< 获取错误标志 */
-
-// ==================== DMA错误代码定义 ====================
+#define YDEV_DMA_IOCTL_BASE (YDEV_IOCTL_BASE + 0x400)
+#define YDEV_DMA_IOCTL_COPY (YDEV_DMA_IOCTL_BASE + 1)          /**< 拷贝内存，参数yDevDmaCopy_t */
+#define YDEV_DMA_IOCTL_IS_BUSY (YDEV_DMA_IOCTL_BASE + 2)       /**< 查询拷贝进行中，参数uint32_t */
+#define YDEV_DMA_IOCTL_GET_CROSSOVER (YDEV_DMA_IOCTL_BASE + 3) /**< 读取交叉点字节数，参数uint32_t */
+#define YDEV_DMA_IOCTL_SET_CROSSOVER (YDEV_DMA_IOCTL_BASE + 4) /**< 设置交叉点字节数，参数uint32_t */
+#define YDEV_DMA_IOCTL_GET_STATS (YDEV_DMA_IOCTL_BASE + 5)     /**< 读取拷贝统计，参数yDevDmaStats_t */
+#define YDEV_DMA_IOCTL_SET_WINDOW (YDEV_DMA_IOCTL_BASE + 6)    /**< 设置读写窗口并回到起始，参数yDevDmaWindow_t */
+#define YDEV_DMA_IOCTL_SEEK (YDEV_DMA_IOCTL_BASE + 7)          /**< 设置窗口内读写位置，参数uint32_t */
 
-/**
- * @brief DMA错误代码定义
- * @note 错误代码采用位掩码方式定义，可以进行位运算组合
- */
-#define YDEV_DMA_ERRNO_NONE (0UL)                // 无错误
-#define YDEV_DMA_ERRNO_TRANSFER_ERROR (1UL << 0) // 传输错误
-#define YDEV_DMA_ERRNO_HALF_TRANSFER (1UL << 1)  // 半传输完成
-#define YDEV_DMA_ERRNO_FULL_TRANSFER (1UL << 2)  // 全传输完成
-#define YDEV_DMA_ERRNO_TIMEOUT (1UL << 3)        // 超时错误
-#define YDEV_DMA_ERRNO_INVALID_PARAM (1UL << 4)  // 无效参数错误
-
-#define YDEV_DMA_ERRNO_BUSY (1UL << 6)  // 设备忙错误
-#define YDEV_DMA_ERRNO_ABORT (1UL << 7) // 传输中止错误
-
-// 错误掩码定义
-#define YDEV_DMA_ERRNO_HW_MASK (YDEV_DMA_ERRNO_TRANSFER_ERROR)                                                                                                // 硬件错误掩码
-#define YDEV_DMA_ERRNO_SW_MASK (YDEV_DMA_ERRNO_TIMEOUT | YDEV_DMA_ERRNO_INVALID_PARAM | YDEV_DMA_ERRNO_NOT_INIT | YDEV_DMA_ERRNO_BUSY | YDEV_DMA_ERRNO_ABORT) // 软件错误掩码
-#define YDEV_DMA_ERRNO_ALL_MASK (YDEV_DMA_ERRNO_HW_MASK | YDEV_DMA_ERRNO_SW_MASK | YDEV_DMA_ERRNO_HALF_TRANSFER | YDEV_DMA_ERRNO_FULL_TRANSFER)               // 所有错误掩码
-
-// 错误检查宏
-#define YDEV_DMA_IS_HW_ERROR(errno) (((errno) & YDEV_DMA_ERRNO_HW_MASK) != 0) // 检查是否有硬件错误
-#define YDEV_DMA_IS_SW_ERROR(errno) (((errno) & YDEV_DMA_ERRNO_SW_MASK) != 0) // 检查是否有软件错误
-#define YDEV_DMA_HAS_ERROR(errno, error) (((errno) & (error)) != 0)           // 检查指定错误是否发生
+    // ==================== DMA设备函数声明 ====================
+
+    /**
+     * @brief 使用默认DMA引擎拷贝内存
+     * @param dst 目标地址
+     * @param src 源地址
+     * @param len 拷贝字节数
+     * @param callback 完成回调，NULL表示阻塞等待完成
+     * @param arg 回调参数
+     * @retval yDevStatus_t 拷贝状态，异步拷贝时为启动状态
+     * @note 默认引擎为第一个初始化成功的DMA设备；没有引擎时使用CPU memcpy
+     */
+    yDevStatus_t yDevDmaMemcpy(void *dst, const void *src, uint32_t len,
+                               yDevDmaCallback_t callback, void *arg);
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* YDEV_DMA_H */
\ No newline at end of file
+#endif /* YDEV_DMA_H */
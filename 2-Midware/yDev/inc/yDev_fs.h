@@ -0,0 +1,361 @@
+/**
+ * @file yDev_fs.h
+ * @brief 基于25Q Flash的掉电安全文件系统头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 在yDev 25Q设备的读写擦除接口之上实现按名称存放数据块的小型文件系统，
+ * 打开的文件是YDEV_TYPE_FILE设备，直接用yDevRead/yDevWrite/yDevIoctl访问
+ *
+ * @par 主要特性:
+ * - 数据写时复制：改写已有数据时写到新块，提交元数据之前原内容保持不变
+ * - 元数据对：两个扇区轮流使用，文件记录追加写入当前扇区，写满时压缩到另一扇区，
+ *   新扇区的扇区头最后写入，掉电时总有一个完整的版本
+ * - 提交合并：写入只更新RAM中的文件状态，sync/关闭时才追加一条文件记录，
+ *   小数据追加不会每次都写目录
+ * - 预读窗口分配：按位图在滑动窗口中找空闲块，窗口在存储区内循环前进，
+ *   起点随元数据版本变化，擦除均匀分布到全部数据块
+ * - 读缓存、每个打开文件的写缓存和预读位图都从挂载时创建的yLib内存池中分配
+ *
+ * @par 存储布局:
+ * - 块0/块1: 元数据对，扇区头(16字节) + 文件记录
+ * - 文件记录: 记录头(12字节) + 文件名 + 数据块号数组，按4字节对齐
+ * - 块2起: 数据块，每个文件最多YDEV_FS_FILE_BLOCKS块
+ *
+ * @par 使用示例:
+ * @code
+ * static yDevFs_t fs;
+ * static yDevHandle_File_t file;
+ * yDevFsConfig_t fs_config = {.flash = &flash, .baseAddress = 0x63000, .blockCount = 13};
+ * yDevConfig_File_t file_config = YDEV_FILE_CONFIG_DEFAULT();
+ *
+ * (void)yDevFsMount(&fs, &fs_config);
+ * file_config.fs = &fs;
+ * file_config.path = "calib";
+ * file_config.flags = YDEV_FS_O_RDWR | YDEV_FS_O_CREAT;
+ * if (yDevInitStatic(&file_config, &file) == YDEV_OK)
+ * {
+ *     (void)yDevWrite(&file, data, len);
+ *     (void)yDevDeinitStatic(&file); // 关闭时提交
+ * }
+ * @endcode
+ */
+
+#ifndef YDEV_FS_H
+#define YDEV_FS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDev_25q.h"
+#include "yLib_mempool.h"
+
+    // ==================== 文件系统常量定义 ====================
+
+    /**
+     * @brief 文件名最大长度(字节，不含结束符)
+     */
+#ifndef YDEV_FS_NAME_MAX
+#define YDEV_FS_NAME_MAX (24)
+#endif
+
+    /**
+     * @brief 单个文件最多占用的数据块数，决定文件大小上限
+     */
+#ifndef YDEV_FS_FILE_BLOCKS
+#define YDEV_FS_FILE_BLOCKS (16)
+#endif
+
+    /**
+     * @brief 同时挂载的文件系统数，每个占用一个互斥锁
+     */
+#ifndef YDEV_FS_MAX
+#define YDEV_FS_MAX (1)
+#endif
+
+#define YDEV_FS_BLOCK_SIZE YDEV_25Q_SECTOR_SIZE           /*!< 块大小，等于25Q扇区 */
+#define YDEV_FS_FILE_SIZE_MAX (YDEV_FS_FILE_BLOCKS * YDEV_FS_BLOCK_SIZE) /*!< 文件大小上限 */
+#define YDEV_FS_SUPER_MAGIC (0x31534659UL)                /*!< 元数据扇区头魔术字 "YFS1" */
+#define YDEV_FS_RECORD_MAGIC (0x4653U)                    /*!< 文件记录魔术字 "SF" */
+#define YDEV_FS_SUPER_SIZE (16)                           /*!< 元数据扇区头大小 */
+#define YDEV_FS_RECORD_HEADER_SIZE (12)                   /*!< 文件记录头大小 */
+#define YDEV_FS_META_BLOCKS (2)                           /*!< 元数据对占用的块数 */
+
+    /**
+     * @brief 打开标志
+     */
+#define YDEV_FS_O_RDONLY (0x01U) /*!< 只读 */
+#define YDEV_FS_O_WRONLY (0x02U) /*!< 只写 */
+#define YDEV_FS_O_RDWR (0x03U)   /*!< 读写 */
+#define YDEV_FS_O_CREAT (0x04U)  /*!< 不存在时创建 */
+#define YDEV_FS_O_TRUNC (0x08U)  /*!< 打开时截断为0 */
+#define YDEV_FS_O_APPEND (0x10U) /*!< 每次写入前定位到文件末尾 */
+
+    // ==================== 文件系统类型定义 ====================
+
+    /**
+     * @brief 文件系统配置结构体
+     */
+    typedef struct
+    {
+        yDevHandle_25q_t *flash; /*!< 已初始化的25Q设备句柄 */
+        uint32_t baseAddress;    /*!< 存储区起始地址(扇区对齐) */
+        uint16_t blockCount;     /*!< 存储区块数，至少3块 */
+        uint16_t cacheSize;      /*!< 读写缓存大小(字节)，2的幂且整除块大小，0使用默认值256 */
+        uint16_t lookahead;      /*!< 预读窗口块数，32的倍数，0使用默认值32 */
+        uint8_t filesMax;        /*!< 最多文件数，0使用默认值16 */
+        uint8_t openMax;         /*!< 最多同时打开的文件数，0使用默认值2 */
+    } yDevFsConfig_t;
+
+    /**
+     * @brief 目录索引项
+     */
+    typedef struct
+    {
+        uint32_t hash;    /*!< 文件名哈希 */
+        uint32_t address; /*!< 最新文件记录的Flash地址 */
+    } yDevFsEntry_t;
+
+    /**
+     * @brief 文件系统统计
+     */
+    typedef struct
+    {
+        uint32_t commits;     /*!< 追加的文件记录数 */
+        uint32_t compactions; /*!< 元数据压缩次数 */
+        uint32_t erases;      /*!< 擦除的块数 */
+        uint32_t cows;        /*!< 写时复制的块数 */
+        uint32_t scans;       /*!< 预读窗口重建次数 */
+        uint32_t cacheHits;   /*!< 读缓存命中次数 */
+        uint32_t cacheMisses; /*!< 读缓存未命中次数 */
+        uint16_t files;       /*!< 文件数 */
+        uint16_t blocksUsed;  /*!< 已提交文件和元数据对占用的块数 */
+        uint16_t blockCount;  /*!< 存储区块数 */
+        uint16_t metaUsed;    /*!< 当前元数据扇区已用字节数 */
+    } yDevFsStats_t;
+
+    /**
+     * @brief 文件信息
+     */
+    typedef struct
+    {
+        char name[YDEV_FS_NAME_MAX + 1]; /*!< 文件名 */
+        uint32_t size;                   /*!< 已提交的大小 */
+        uint16_t blocks;                 /*!< 占用的数据块数 */
+    } yDevFsInfo_t;
+
+    struct yDevHandle_File;
+
+    /**
+     * @brief 文件系统句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_25q_t *flash;       /*!< 25Q设备句柄 */
+        uint32_t baseAddress;          /*!< 存储区起始地址 */
+        uint16_t blockCount;           /*!< 存储区块数 */
+        uint16_t cacheSize;            /*!< 缓存大小 */
+        uint16_t lookahead;            /*!< 预读窗口块数 */
+        uint8_t filesMax;              /*!< 最多文件数 */
+        uint8_t metaBlock;             /*!< 当前元数据块(0/1) */
+        uint32_t rev;                  /*!< 当前元数据版本 */
+        uint32_t metaUsed;             /*!< 当前元数据块追加偏移 */
+        uint16_t allocStart;           /*!< 预读窗口起点(数据块序号) */
+        uint16_t allocOffset;          /*!< 窗口内下一个待检查的位置 */
+        uint16_t allocSeen;            /*!< 上次成功分配以来检查过的块数 */
+        uint16_t files;                /*!< 索引中的文件数 */
+        uint32_t *lookaheadMap;        /*!< 预读位图，1表示占用 */
+        uint8_t *rcache;               /*!< 读缓存 */
+        uint32_t rcacheAddress;        /*!< 读缓存对应的Flash地址，0xFFFFFFFF无效 */
+        ylib_mempool_t *pool;          /*!< 缓存和位图的内存池 */
+        yDevFsEntry_t *entry;          /*!< 目录索引 */
+        struct yDevHandle_File *open;  /*!< 打开的文件链表 */
+        void *mutex;                   /*!< 互斥锁 */
+        yDevFsStats_t stats;           /*!< 统计 */
+        uint8_t mounted;               /*!< 挂载标志 */
+    } yDevFs_t;
+
+    /**
+     * @brief yDev 文件设备配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base; /*!< yDev基础配置结构体 */
+        yDevFs_t *fs;      /*!< 已挂载的文件系统 */
+        const char *path;  /*!< 文件名，不超过YDEV_FS_NAME_MAX */
+        uint8_t flags;     /*!< 打开标志 YDEV_FS_O_xxx */
+    } yDevConfig_File_t;
+
+    /**
+     * @brief yDev 文件设备句柄结构体
+     */
+    typedef struct yDevHandle_File
+    {
+        yDevHandle_t base;                     /*!< yDev基础句柄结构体 */
+        yDevFs_t *fs;                          /*!< 所在文件系统 */
+        struct yDevHandle_File *next;          /*!< 打开文件链表 */
+        uint8_t *pcache;                       /*!< 写缓存 */
+        uint16_t pcacheBlock;                  /*!< 写缓存对应的块 */
+        uint16_t pcacheOffset;                 /*!< 写缓存对应的块内偏移 */
+        uint16_t pcacheLen;                    /*!< 写缓存中的字节数 */
+        uint16_t nblocks;                      /*!< 数据块数 */
+        uint16_t block[YDEV_FS_FILE_BLOCKS];   /*!< 数据块号 */
+        uint32_t size;                         /*!< 当前大小(含未提交的写入) */
+        uint32_t pos;                          /*!< 读写位置 */
+        uint8_t flags;                         /*!< 打开标志 */
+        uint8_t dirty;                         /*!< 有未提交的修改 */
+        uint8_t tailErased;                    /*!< 末块中文件末尾之后的空间确认已擦除 */
+        uint8_t nameLen;                       /*!< 文件名长度 */
+        char name[YDEV_FS_NAME_MAX + 1];       /*!< 文件名 */
+    } yDevHandle_File_t;
+
+    /**
+     * @brief 定位参数
+     */
+    typedef struct
+    {
+        int32_t offset; /*!< 偏移 */
+        uint8_t whence; /*!< 0文件开头，1当前位置，2文件末尾 */
+    } yDevFsSeek_t;
+
+// ==================== yDev 文件设备配置初始化宏 ====================
+
+/**
+ * @brief yDev 文件设备配置结构体默认初始化宏
+ */
+#define YDEV_FILE_CONFIG_DEFAULT()        \
+    ((yDevConfig_File_t){                 \
+        .base = {.type = YDEV_TYPE_FILE}, \
+        .fs = NULL,                       \
+        .path = NULL,                     \
+        .flags = YDEV_FS_O_RDONLY,        \
+    })
+
+/**
+ * @brief yDev 文件设备句柄结构体默认初始化宏
+ */
+#define YDEV_FILE_HANDLE_DEFAULT()     \
+    ((yDevHandle_File_t){              \
+        .base = YDEV_HANDLE_DEFAULT(), \
+        .fs = NULL,                    \
+        .next = NULL,                  \
+        .pcache = NULL,                \
+    })
+
+    // ==================== 文件系统函数声明 ====================
+
+    /**
+     * @brief 挂载文件系统
+     * @param fs 文件系统句柄指针
+     * @param config 配置指针
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 挂载成功
+     *         - YDEV_INVALID_PARAM: 参数无效
+     *         - YDEV_NO_MEMORY: 缓存或索引内存不足
+     *         - YDEV_ERROR: Flash访问失败
+     * @note 没有有效元数据块时自动格式化；最新元数据块末尾有掉电写坏的记录时先压缩
+     */
+    yDevStatus_t yDevFsMount(yDevFs_t *fs, const yDevFsConfig_t *config);
+
+    /**
+     * @brief 卸载文件系统
+     * @param fs 文件系统句柄指针
+     * @retval yDevStatus_t 操作状态，仍有打开的文件时返回YDEV_BUSY
+     */
+    yDevStatus_t yDevFsUnmount(yDevFs_t *fs);
+
+    /**
+     * @brief 格式化文件系统
+     * @param fs 已挂载的文件系统句柄指针
+     * @retval yDevStatus_t 操作状态，仍有打开的文件时返回YDEV_BUSY
+     * @note 只擦除元数据对，数据块在分配时擦除
+     */
+    yDevStatus_t yDevFsFormat(yDevFs_t *fs);
+
+    /**
+     * @brief 删除文件
+     * @param fs 文件系统句柄指针
+     * @param name 文件名
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 已追加删除记录
+     *         - YDEV_ERROR: 文件不存在或Flash写入失败
+     *         - YDEV_BUSY: 文件正在打开
+     */
+    yDevStatus_t yDevFsRemove(yDevFs_t *fs, const char *name);
+
+    /**
+     * @brief 查询文件信息
+     * @param fs 文件系统句柄指针
+     * @param name 文件名
+     * @param info 输出
+     * @retval yDevStatus_t 操作状态，文件不存在返回YDEV_ERROR
+     */
+    yDevStatus_t yDevFsStat(yDevFs_t *fs, const char *name, yDevFsInfo_t *info);
+
+    /**
+     * @brief 按序号列出文件
+     * @param fs 文件系统句柄指针
+     * @param index 序号，从0开始
+     * @param info 输出
+     * @retval yDevStatus_t 操作状态，序号超出文件数返回YDEV_ERROR
+     * @note 删除文件会使后面的序号前移
+     */
+    yDevStatus_t yDevFsDir(yDevFs_t *fs, uint32_t index, yDevFsInfo_t *info);
+
+    /**
+     * @brief 读取统计
+     * @param fs 文件系统句柄指针
+     * @param stats 输出
+     */
+    void yDevFsGetStats(yDevFs_t *fs, yDevFsStats_t *stats);
+
+    /**
+     * @brief 初始化文件设备配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDevFileConfigStructInit(yDevConfig_File_t *config);
+
+    /**
+     * @brief 初始化文件设备句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDevFileHandleStructInit(yDevHandle_File_t *handle);
+
+/**
+ * @brief 文件设备错误码(base.errno)
+ */
+#define YDEV_FILE_ERRNO_NONE (0UL)             /*!< 无错误 */
+#define YDEV_FILE_ERRNO_NOT_FOUND (1UL << (3)) /*!< 文件不存在且未指定CREAT */
+#define YDEV_FILE_ERRNO_NO_SPACE (1UL << (4))  /*!< 没有空闲块或超出文件大小上限 */
+#define YDEV_FILE_ERRNO_ACCESS (1UL << (5))    /*!< 打开标志不允许该操作 */
+#define YDEV_FILE_ERRNO_IO (1UL << (6))        /*!< Flash访问失败 */
+#define YDEV_FILE_ERRNO_FULL (1UL << (7))      /*!< 文件数或打开数达到上限 */
+
+/**
+ * @brief 文件设备IOCTL命令
+ * - YDEV_FILE_SEEK: 定位(arg: yDevFsSeek_t*)，不能超出文件末尾
+ * - YDEV_FILE_TELL: 获取读写位置(arg: uint32_t*)
+ * - YDEV_FILE_SIZE: 获取当前大小(arg: uint32_t*)
+ * - YDEV_FILE_SYNC: 刷新写缓存并提交文件记录(arg: NULL)
+ * - YDEV_FILE_TRUNCATE: 截断到指定大小(arg: uint32_t*)，不能大于当前大小
+ */
+#define YDEV_FILE_IOCTL_BASE (YDEV_IOCTL_BASE + 0xA00)
+#define YDEV_FILE_SEEK (YDEV_FILE_IOCTL_BASE + 0)
+#define YDEV_FILE_TELL (YDEV_FILE_IOCTL_BASE + 1)
+#define YDEV_FILE_SIZE (YDEV_FILE_IOCTL_BASE + 2)
+#define YDEV_FILE_SYNC (YDEV_FILE_IOCTL_BASE + 3)
+#define YDEV_FILE_TRUNCATE (YDEV_FILE_IOCTL_BASE + 4)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_FS_H */
@@ -15,6 +15,7 @@
  * - 中断回调机制支持
  * - 错误处理和状态查询
  * - 与底层yDrv GPIO驱动的适配
+ * - GPIO端口组设备，同一端口多引脚一次寄存器访问并行读写
  */
 
 #ifndef YDEV_GPIO_H
@@ -72,6 +73,43 @@ extern "C"
         .drv_handle = YDRV_GPIO_HANDLE_DEFAULT(), \
     })
 
+    /**
+     * @brief yDev GPIO端口组设备配置结构体
+     * @note 同一端口上的多个引脚作为一个设备，读写的数值第i位对应组内第i个引脚
+     */
+    typedef struct
+    {
+        yDevConfig_t base;               /*!< yDev基础配置结构体 */
+        yDrvGpioPortConfig_t drv_config; /*!< GPIO端口组底层驱动配置结构体 */
+    } yDevConfig_GpioPort_t;
+
+    /**
+     * @brief yDev GPIO端口组设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;               /*!< yDev基础句柄结构体 */
+        yDrvGpioPortHandle_t drv_handle; /*!< GPIO端口组底层驱动句柄 */
+    } yDevHandle_GpioPort_t;
+
+/**
+ * @brief yDev GPIO端口组配置结构体默认初始化宏
+ */
+#define YDEV_GPIO_PORT_CONFIG_DEFAULT()                \
+    ((yDevConfig_GpioPort_t){                          \
+        .base = {.type = YDEV_TYPE_GPIO_PORT},         \
+        .drv_config = YDRV_GPIO_PORT_CONFIG_DEFAULT(), \
+    })
+
+/**
+ * @brief yDev GPIO端口组句柄结构体默认初始化宏
+ */
+#define YDEV_GPIO_PORT_HANDLE_DEFAULT()                \
+    ((yDevHandle_GpioPort_t){                          \
+        .base = YDEV_HANDLE_DEFAULT(),                 \
+        .drv_handle = YDRV_GPIO_PORT_HANDLE_DEFAULT(), \
+    })
+
     // ==================== yDev GPIO初始化函数 ====================
 
     /**
@@ -88,6 +126,106 @@ extern "C"
      */
     void yDevGpioHandleStructInit(yDevHandle_Gpio_t *handle);
 
+    /**
+     * @brief 初始化yDev GPIO端口组配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDevGpioPortConfigStructInit(yDevConfig_GpioPort_t *config);
+
+    /**
+     * @brief 初始化yDev GPIO端口组句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDevGpioPortHandleStructInit(yDevHandle_GpioPort_t *handle);
+
+    // ==================== GPIO快速访问函数 ====================
+
+    /**
+     * @brief 快速写GPIO引脚
+     * @param handle 已初始化的GPIO设备句柄
+     * @param value 0=低电平, 非0=高电平
+     * @retval 无
+     * @note 设备类型在编译期已知时使用，一次BSRR写入完成，不经过操作表分发和参数检查，
+     *       也不获取句柄锁(BSRR写入本身是原子的)；yDevWrite最终由同一函数完成写入
+     */
+    YLIB_INLINE void yDevGpioWriteFast(yDevHandle_Gpio_t *handle, uint32_t value)
+    {
+        uint32_t mask = handle->drv_handle.gpioInfo.pinMask;
+
+        handle->drv_handle.gpioInfo.port->BSRR = (value != 0) ? mask : (mask << 16);
+    }
+
+    /**
+     * @brief 快速读GPIO引脚
+     * @param handle 已初始化的GPIO设备句柄
+     * @retval uint32_t 0=低电平, 1=高电平
+     * @note 读取输入数据寄存器，与yDevRead结果相同
+     */
+    YLIB_INLINE uint32_t yDevGpioReadFast(yDevHandle_Gpio_t *handle)
+    {
+        return ((handle->drv_handle.gpioInfo.port->IDR & handle->drv_handle.gpioInfo.pinMask) != 0U) ? 1U : 0U;
+    }
+
+    /**
+     * @brief 快速翻转GPIO引脚
+     * @param handle 已初始化的GPIO设备句柄
+     * @retval 无
+     * @note 读输出寄存器后一次BSRR写入，同YDEV_GPIO_TOGGLE_PIN
+     */
+    YLIB_INLINE void yDevGpioToggleFast(yDevHandle_Gpio_t *handle)
+    {
+        yDrvGpioToggle(&handle->drv_handle);
+    }
+
+    // ==================== GPIO端口组快速访问函数 ====================
+
+    /**
+     * @brief 快速写GPIO端口组
+     * @param handle 已初始化的GPIO端口组设备句柄
+     * @param value 组内数值，第i位对应组内第i个引脚
+     * @retval 无
+     * @note 置位和复位合并为一次BSRR写入，组内引脚同时变化；
+     *       不经过操作表分发，也不获取句柄锁，yDevWrite最终由同一函数完成写入
+     */
+    YLIB_INLINE void yDevGpioPortWriteFast(yDevHandle_GpioPort_t *handle, uint32_t value)
+    {
+        yDrvGpioPortWrite(&handle->drv_handle, value);
+    }
+
+    /**
+     * @brief 快速读GPIO端口组
+     * @param handle 已初始化的GPIO端口组设备句柄
+     * @retval uint32_t 组内数值，一次IDR读取，与yDevRead结果相同
+     */
+    YLIB_INLINE uint32_t yDevGpioPortReadFast(yDevHandle_GpioPort_t *handle)
+    {
+        return yDrvGpioPortRead(&handle->drv_handle);
+    }
+
+    /**
+     * @brief 快速置位GPIO端口组中的指定位
+     * @param handle 已初始化的GPIO端口组设备句柄
+     * @param bits 需要置高的组内位，其余位保持不变
+     * @retval 无
+     */
+    YLIB_INLINE void yDevGpioPortSetFast(yDevHandle_GpioPort_t *handle, uint32_t bits)
+    {
+        yDrvGpioPortSetBits(&handle->drv_handle, bits);
+    }
+
+    /**
+     * @brief 快速复位GPIO端口组中的指定位
+     * @param handle 已初始化的GPIO端口组设备句柄
+     * @param bits 需要置低的组内位，其余位保持不变
+     * @retval 无
+     */
+    YLIB_INLINE void yDevGpioPortClearFast(yDevHandle_GpioPort_t *handle, uint32_t bits)
+    {
+        yDrvGpioPortClearBits(&handle->drv_handle, bits);
+    }
+
     // ==================== GPIO设备IOCTL命令定义 ====================
 
     /**
@@ -109,6 +247,21 @@ extern "C"
 #define YDEV_GPIO_SET_EXIT (YDEV_GPIO_IOCTL_BASE + 5)
 #define YDEV_GPIO_UNREGISTER_EXIT (YDEV_GPIO_IOCTL_BASE + 6)
 
+    /**
+     * @brief GPIO端口组设备IOCTL命令
+     *
+     * @par 命令说明:
+     * - YDEV_GPIO_PORT_SET_BITS: 置高指定组内位(arg: uint32_t*)
+     * - YDEV_GPIO_PORT_CLEAR_BITS: 置低指定组内位(arg: uint32_t*)
+     * - YDEV_GPIO_PORT_TOGGLE_BITS: 翻转指定组内位(arg: uint32_t*)
+     * - YDEV_GPIO_PORT_GET_MASK: 获取组内有效位掩码(arg: uint32_t*)
+     */
+#define YDEV_GPIO_PORT_IOCTL_BASE (YDEV_IOCTL_BASE + 0x500)
+#define YDEV_GPIO_PORT_SET_BITS (YDEV_GPIO_PORT_IOCTL_BASE + 0)
+#define YDEV_GPIO_PORT_CLEAR_BITS (YDEV_GPIO_PORT_IOCTL_BASE + 1)
+#define YDEV_GPIO_PORT_TOGGLE_BITS (YDEV_GPIO_PORT_IOCTL_BASE + 2)
+#define YDEV_GPIO_PORT_GET_MASK (YDEV_GPIO_PORT_IOCTL_BASE + 3)
+
 #ifdef __cplusplus
 }
 #endif
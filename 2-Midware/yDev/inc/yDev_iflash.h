@@ -0,0 +1,188 @@
+/**
+ * @file yDev_iflash.h
+ * @brief yDev 片内Flash数据区设备驱动头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 基于yDev框架的片内Flash设备，把链接脚本保留在Flash末尾的数据区(IFLASH_DATA)
+ * 或指定的页对齐区域当作可读写的存储设备，地址为区域内偏移
+ *
+ * @par 主要特性:
+ * - 读取直接从映射地址拷贝
+ * - 写入以8字节双字为单位，整行(256字节)走快速编程，末尾不足一个双字时以0xFF补齐
+ * - 同步擦除和后台擦除：后台擦除由低优先级任务逐页执行，页与页之间让出CPU
+ * - 写入和擦除都在挂起调度器后执行，同一时刻只有一个Flash操作
+ *
+ * @par 使用约束:
+ * G070只有一个Bank，不能边执行边擦写：擦除一页(典型22ms)期间Flash中的代码全部停顿，
+ * 只有RAM中的中断继续响应。后台擦除只是把停顿拆成逐页、放到空闲时段，
+ * 对实时性敏感的中断须放入RAM(YLIB_RAMFUNC)；后台擦除尚未完成的页不能写入
+ */
+
+#ifndef YDEV_IFLASH_H
+#define YDEV_IFLASH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDrv_flash.h"
+
+    // ==================== 片内Flash设备特定定义 ====================
+
+    /**
+     * @brief 后台擦除完成回调
+     * @param arg 用户参数
+     * @param status 擦除结果，YDEV_OK或YDEV_ERROR
+     * @note 在擦除任务中调用，队列中的页全部擦完后调用一次
+     */
+    typedef void (*yDevIflashCallback_t)(void *arg, yDevStatus_t status);
+
+    /**
+     * @brief yDev 片内Flash设备配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;             /*!< yDev基础配置结构体 */
+        uint32_t address;              /*!< 区域起始地址(页对齐)，0表示使用链接脚本保留的数据区 */
+        uint32_t size;                 /*!< 区域大小(页的整数倍，最多32页) */
+        yDevIflashCallback_t callback; /*!< 后台擦除完成回调，NULL表示不通知 */
+        void *arg;                     /*!< 回调参数 */
+    } yDevConfig_Iflash_t;
+
+    /**
+     * @brief 片内Flash运行统计
+     */
+    typedef struct
+    {
+        uint32_t erases;     /*!< 擦除的页数(含后台擦除) */
+        uint32_t bytes;      /*!< 编程的字节数 */
+        uint32_t errors;     /*!< 擦除和编程失败次数 */
+        uint32_t last_error; /*!< 最近一次失败时FLASH_SR的错误位 */
+    } yDevIflashStats_t;
+
+    /**
+     * @brief yDev 片内Flash设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;                  /*!< yDev基础句柄结构体 */
+        uint32_t start;                     /*!< 区域起始地址 */
+        uint32_t size;                      /*!< 区域大小 */
+        uint32_t address;                   /*!< 当前操作偏移 */
+        volatile uint32_t erase_pending;    /*!< 等待后台擦除的页位图，第n位对应区域内第n页 */
+        volatile yDevStatus_t erase_status; /*!< 本轮后台擦除的结果 */
+        void *erase_task;                   /*!< 后台擦除任务句柄 */
+        yDevIflashCallback_t callback;      /*!< 后台擦除完成回调 */
+        void *arg;                          /*!< 回调参数 */
+        yDevIflashStats_t stats;            /*!< 运行统计 */
+    } yDevHandle_Iflash_t;
+
+    /**
+     * @brief 擦除范围
+     * @note 偏移和长度按页向外扩展
+     */
+    typedef struct
+    {
+        uint32_t offset; /*!< 区域内偏移 */
+        uint32_t size;   /*!< 字节数 */
+    } yDevIflashRange_t;
+
+/**
+ * @brief 区域最多页数，受后台擦除位图宽度限制
+ */
+#define YDEV_IFLASH_PAGES_MAX (32U)
+
+// ==================== yDev 片内Flash配置初始化宏 ====================
+
+/**
+ * @brief yDev 片内Flash配置结构体默认初始化宏
+ */
+#define YDEV_IFLASH_CONFIG_DEFAULT()        \
+    ((yDevConfig_Iflash_t){                 \
+        .base = {.type = YDEV_TYPE_IFLASH}, \
+        .address = 0,                       \
+        .size = 0,                          \
+        .callback = NULL,                   \
+        .arg = NULL,                        \
+    })
+
+/**
+ * @brief yDev 片内Flash句柄结构体默认初始化宏
+ */
+#define YDEV_IFLASH_HANDLE_DEFAULT()   \
+    ((yDevHandle_Iflash_t){            \
+        .base = YDEV_HANDLE_DEFAULT(), \
+        .start = 0,                    \
+        .size = 0,                     \
+        .address = 0,                  \
+        .erase_pending = 0,            \
+        .erase_status = YDEV_OK,       \
+        .erase_task = NULL,            \
+        .callback = NULL,              \
+        .arg = NULL,                   \
+    })
+
+    // ==================== 片内Flash设备API ====================
+
+    /**
+     * @brief 初始化片内Flash配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDevIflashConfigStructInit(yDevConfig_Iflash_t *config);
+
+    /**
+     * @brief 初始化片内Flash句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDevIflashHandleStructInit(yDevHandle_Iflash_t *handle);
+
+    // ==================== 快速访问内联函数 ====================
+
+    /**
+     * @brief 取区域内偏移的映射地址
+     * @param handle 片内Flash设备句柄
+     * @param offset 区域内偏移
+     * @retval 只读指针，可直接读取
+     */
+    YLIB_INLINE const void *yDevIflashPtr(const yDevHandle_Iflash_t *handle, uint32_t offset)
+    {
+        return (const void *)(handle->start + offset);
+    }
+
+/**
+ * @brief 片内Flash设备错误码(base.errno)
+ */
+#define YDEV_IFLASH_ERRNO_NONE (0UL)             /*!< 无错误 */
+#define YDEV_IFLASH_ERRNO_ALIGN (1UL << (3))     /*!< 写入偏移未按双字对齐 */
+#define YDEV_IFLASH_ERRNO_RANGE (1UL << (4))     /*!< 访问超出区域 */
+#define YDEV_IFLASH_ERRNO_PENDING (1UL << (5))   /*!< 写入的页还在等待后台擦除 */
+#define YDEV_IFLASH_ERRNO_PROGRAM (1UL << (6))   /*!< 编程失败，目标未擦除或写保护 */
+#define YDEV_IFLASH_ERRNO_ERASE (1UL << (7))     /*!< 擦除失败 */
+#define YDEV_IFLASH_ERRNO_NO_MEMORY (1UL << (8)) /*!< 后台擦除任务槽位不足 */
+
+/**
+ * @brief 片内Flash设备IOCTL命令
+ * - YDEV_IFLASH_ERASE: 同步擦除(arg: yDevIflashRange_t*)，逐页挂起调度器执行
+ * - YDEV_IFLASH_ERASE_ASYNC: 加入后台擦除(arg: yDevIflashRange_t*)，立即返回
+ * - YDEV_IFLASH_ERASE_PENDING: 获取尚未擦除的页位图(arg: uint32_t*)，0表示后台擦除已完成
+ * - YDEV_IFLASH_GET_STATS: 获取运行统计(arg: yDevIflashStats_t*)
+ */
+#define YDEV_IFLASH_IOCTL_BASE (YDEV_IOCTL_BASE + 0x900)
+#define YDEV_IFLASH_ERASE (YDEV_IFLASH_IOCTL_BASE + 0)
+#define YDEV_IFLASH_ERASE_ASYNC (YDEV_IFLASH_IOCTL_BASE + 1)
+#define YDEV_IFLASH_ERASE_PENDING (YDEV_IFLASH_IOCTL_BASE + 2)
+#define YDEV_IFLASH_GET_STATS (YDEV_IFLASH_IOCTL_BASE + 3)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_IFLASH_H */
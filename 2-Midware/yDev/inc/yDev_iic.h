@@ -0,0 +1,176 @@
+/**
+ * @file yDev_iic.h
+ * @brief yDev IIC主机设备驱动头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 基于yDev框架的IIC主机设备，一个句柄对应总线上的一个从机地址
+ *
+ * @par 主要特性:
+ * - 同步读写：任务中等待传输结束中断，超时由base.timeOutMs控制，调度器启动前轮询
+ * - 寄存器访问：YDEV_IIC_TRANSFER一次完成"写寄存器地址-重复起始-读数据"
+ * - 异步读写：启动后立即返回，结束时在中断中通知完成
+ * - 超时、总线错误和总线被占用时自动执行总线恢复
+ */
+
+#ifndef YDEV_IIC_H
+#define YDEV_IIC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDrv_i2c.h"
+
+    // ==================== IIC设备特定定义 ====================
+
+    /**
+     * @brief yDev IIC设备配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;          /*!< yDev基础配置结构体 */
+        yDrvI2cConfig_t drv_config; /*!< I2C底层驱动配置结构体 */
+        uint16_t addr;              /*!< 7位从机地址 */
+    } yDevConfig_Iic_t;
+
+    /**
+     * @brief IIC运行统计
+     */
+    typedef struct
+    {
+        uint32_t transfers;  /*!< 完成的传输次数(含失败) */
+        uint32_t nacks;      /*!< 未应答次数 */
+        uint32_t busErrors;  /*!< 总线错误和仲裁丢失次数 */
+        uint32_t timeouts;   /*!< 同步传输超时次数 */
+        uint32_t recoveries; /*!< 总线恢复次数 */
+    } yDevIicStats_t;
+
+    /**
+     * @brief yDev IIC设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;          /*!< yDev基础句柄结构体 */
+        yDrvI2cHandle_t drv_handle; /*!< I2C底层驱动句柄 */
+        yDrvI2cCallback_t callback; /*!< 用户配置的驱动回调，设备回调中转调用 */
+        void *arg;                  /*!< 用户回调参数 */
+        uint16_t addr;              /*!< 7位从机地址 */
+        volatile uint8_t async_dir; /*!< 进行中的异步传输方向，YDEV_IIC_ASYNC_NONE表示没有 */
+        uint32_t async_len;         /*!< 异步传输字节数 */
+        void *volatile wait_task;   /*!< 等待同步传输结束的任务句柄 */
+        yDevIicStats_t stats;       /*!< 运行统计 */
+    } yDevHandle_Iic_t;
+
+    /**
+     * @brief IIC寄存器访问描述
+     * @note wlen和rlen任一为0时只执行另一段，两者都为0时只探测从机地址
+     */
+    typedef struct
+    {
+        const void *wbuf; /*!< 写段数据，通常为寄存器地址 */
+        uint32_t wlen;    /*!< 写段字节数 */
+        void *rbuf;       /*!< 读段缓冲区 */
+        uint32_t rlen;    /*!< 读段字节数 */
+    } yDevIicXfer_t;
+
+/**
+ * @brief 没有进行中的异步传输
+ */
+#define YDEV_IIC_ASYNC_NONE (0xFFU)
+
+// ==================== yDev IIC配置初始化宏 ====================
+
+/**
+ * @brief yDev IIC配置结构体默认初始化宏
+ */
+#define YDEV_IIC_CONFIG_DEFAULT()                \
+    ((yDevConfig_Iic_t){                         \
+        .base = {.type = YDEV_TYPE_IIC},         \
+        .drv_config = YDRV_I2C_CONFIG_DEFAULT(), \
+        .addr = 0,                               \
+    })
+
+/**
+ * @brief yDev IIC句柄结构体默认初始化宏
+ */
+#define YDEV_IIC_HANDLE_DEFAULT()                \
+    ((yDevHandle_Iic_t){                         \
+        .base = YDEV_HANDLE_DEFAULT(),           \
+        .drv_handle = YDRV_I2C_HANDLE_DEFAULT(), \
+        .callback = NULL,                        \
+        .arg = NULL,                             \
+        .addr = 0,                               \
+        .async_dir = YDEV_IIC_ASYNC_NONE,        \
+        .async_len = 0,                          \
+        .wait_task = NULL,                       \
+    })
+
+    // ==================== IIC设备API ====================
+
+    /**
+     * @brief 初始化IIC配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDevIicConfigStructInit(yDevConfig_Iic_t *config);
+
+    /**
+     * @brief 初始化IIC句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDevIicHandleStructInit(yDevHandle_Iic_t *handle);
+
+    // ==================== 快速访问内联函数 ====================
+
+    /**
+     * @brief 快速启动一次传输
+     * @param handle IIC设备句柄
+     * @param xfer 传输描述
+     * @retval yDrvStatus_t 启动状态，含义同yDrvI2cTransfer
+     * @note 绕过yDev框架和互斥锁，不等待结束；结束时照常更新统计并转调驱动配置中的回调
+     */
+    YLIB_INLINE yDrvStatus_t yDevIicTransferFast(yDevHandle_Iic_t *handle, const yDevIicXfer_t *xfer)
+    {
+        return yDrvI2cTransfer(&handle->drv_handle, handle->addr,
+                               (const uint8_t *)xfer->wbuf, xfer->wlen,
+                               (uint8_t *)xfer->rbuf, xfer->rlen);
+    }
+
+/**
+ * @brief IIC设备错误码(base.errno)
+ */
+#define YDEV_IIC_ERRNO_NONE (0UL)           /*!< 无错误 */
+#define YDEV_IIC_ERRNO_NACK (1UL << (3))    /*!< 从机未应答 */
+#define YDEV_IIC_ERRNO_BUS (1UL << (4))     /*!< 总线错误或仲裁丢失 */
+#define YDEV_IIC_ERRNO_TIMEOUT (1UL << (5)) /*!< 同步传输超时 */
+#define YDEV_IIC_ERRNO_STUCK (1UL << (6))   /*!< 总线恢复后SDA仍被拉低 */
+
+/**
+ * @brief IIC设备IOCTL命令
+ * - YDEV_IIC_TRANSFER: 同步执行写-读组合传输(arg: yDevIicXfer_t*)
+ * - YDEV_IIC_SET_ADDR: 设置7位从机地址(arg: uint16_t*)
+ * - YDEV_IIC_SET_SPEED: 修改总线速率(arg: yDrvI2cSpeed_t*)
+ * - YDEV_IIC_PROBE: 探测从机是否应答(arg: NULL)，未应答返回YDEV_ERROR
+ * - YDEV_IIC_RECOVER: 执行总线恢复(arg: NULL)
+ * - YDEV_IIC_GET_STATS: 获取运行统计(arg: yDevIicStats_t*)
+ */
+#define YDEV_IIC_IOCTL_BASE (YDEV_IOCTL_BASE + 0x800)
+#define YDEV_IIC_TRANSFER (YDEV_IIC_IOCTL_BASE + 0)
+#define YDEV_IIC_SET_ADDR (YDEV_IIC_IOCTL_BASE + 1)
+#define YDEV_IIC_SET_SPEED (YDEV_IIC_IOCTL_BASE + 2)
+#define YDEV_IIC_PROBE (YDEV_IIC_IOCTL_BASE + 3)
+#define YDEV_IIC_RECOVER (YDEV_IIC_IOCTL_BASE + 4)
+#define YDEV_IIC_GET_STATS (YDEV_IIC_IOCTL_BASE + 5)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_IIC_H */
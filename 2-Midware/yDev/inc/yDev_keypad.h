@@ -0,0 +1,196 @@
+/**
+ * @file yDev_keypad.h
+ * @brief yDev 矩阵键盘扫描设备头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 由定时器节拍和DMA完成行扫描和列采样的矩阵键盘，按键事件放入设备内的事件队列，
+ * 使用者以yDevRead取事件，以yDevPoll等待，不需要扫描任务
+ *
+ * @par 工作方式:
+ * - TIM14 PWM的比较事件(下降沿)经两个DMAMUX请求生成器同时请求两个DMA通道：
+ *   采样通道(优先级高)先把列端口IDR存入采样缓冲区，行通道再把下一行的BSRR值写入行端口，
+ *   每行有一个完整的定时器周期稳定后才被采样
+ * - 采样缓冲区为两轮扫描的双缓冲，DMA半传输/传输完成中断各处理一整轮，每轮扫描只进一次中断
+ * - 消抖为每行一组按列的位并行计数器，同一电平连续4轮才翻转，没有按键变化时每行只有几条指令
+ *
+ * @par 使用约束:
+ * - 行引脚在同一端口(开漏输出，低为选中)，列引脚在同一端口(上拉输入，低为按下)
+ * - 占用TIM14、两个请求生成器和两个DMA通道；不处理多键同时按下时的鬼键
+ */
+
+#ifndef YDEV_KEYPAD_H
+#define YDEV_KEYPAD_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDrv_gpio.h"
+#include "yDrv_tim.h"
+#include "yDrv_dma.h"
+
+    // ==================== 矩阵键盘常量定义 ====================
+
+    /**
+     * @brief 最多行数
+     */
+#ifndef YDEV_KEYPAD_ROWS_MAX
+#define YDEV_KEYPAD_ROWS_MAX (8)
+#endif
+
+    /**
+     * @brief 最多列数，列位图为8位
+     */
+#define YDEV_KEYPAD_COLS_MAX (8)
+
+    /**
+     * @brief 事件队列深度(2的幂)
+     */
+#ifndef YDEV_KEYPAD_EVENT_LEN
+#define YDEV_KEYPAD_EVENT_LEN (16)
+#endif
+
+    // ==================== 矩阵键盘类型定义 ====================
+
+    /**
+     * @brief yDev矩阵键盘设备配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;    /*!< yDev基础配置结构体 */
+        yDrvGpioPin_t rowPin; /*!< 行端口组最低位引脚 */
+        uint16_t rowMask;     /*!< 行引脚掩码(相对rowPin)，从低位起依次为第0、1...行 */
+        yDrvGpioPin_t colPin; /*!< 列端口组最低位引脚 */
+        uint16_t colMask;     /*!< 列引脚掩码(相对colPin)，从低位起依次为第0、1...列 */
+        uint32_t rowHz;       /*!< 行切换频率(16~100000Hz)，整轮扫描频率为rowHz/行数 */
+        uint32_t prio;        /*!< 采样DMA中断优先级 */
+    } yDevConfig_Keypad_t;
+
+    /**
+     * @brief 按键事件
+     */
+    typedef struct
+    {
+        uint8_t key;      /*!< 键号，行号*列数+列号 */
+        uint8_t row;      /*!< 行号 */
+        uint8_t col;      /*!< 列号 */
+        uint8_t pressed;  /*!< 1为按下，0为松开 */
+        uint32_t time_us; /*!< 消抖完成时的微秒时间戳 */
+    } yDevKeypadEvent_t;
+
+    /**
+     * @brief 矩阵键盘运行统计(YDEV_KEYPAD_GET_STATS)
+     */
+    typedef struct
+    {
+        uint32_t scans;  /*!< 完成的整轮扫描数 */
+        uint32_t events; /*!< 产生的按键事件数 */
+        uint32_t lost;   /*!< 事件队列满丢弃的事件数 */
+    } yDevKeypadStats_t;
+
+    /**
+     * @brief yDev矩阵键盘设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;                              /*!< yDev基础句柄结构体 */
+        yDrvGpioPortHandle_t row;                       /*!< 行端口组 */
+        yDrvGpioPortHandle_t col;                       /*!< 列端口组 */
+        yDrvTimHandle_t tim;                            /*!< 行节拍定时器TIM14 */
+        yDrvDmaGenHandle_t sampleGen;                   /*!< 采样请求生成器 */
+        yDrvDmaGenHandle_t rowGen;                      /*!< 行请求生成器 */
+        yDrvDmaHandle_t sampleDma;                      /*!< 采样DMA通道 */
+        yDrvDmaHandle_t rowDma;                         /*!< 行DMA通道 */
+        uint32_t rowBsrr[YDEV_KEYPAD_ROWS_MAX];         /*!< 第k项为选中第k+1行的BSRR值(DMA源) */
+        uint16_t sample[2 * YDEV_KEYPAD_ROWS_MAX];      /*!< 列IDR采样双缓冲(DMA目标) */
+        uint16_t colBit[YDEV_KEYPAD_COLS_MAX];          /*!< 各列在IDR中的位 */
+        uint8_t state[YDEV_KEYPAD_ROWS_MAX];            /*!< 各行消抖后的按下位图 */
+        uint8_t cnt0[YDEV_KEYPAD_ROWS_MAX];             /*!< 消抖计数器低位 */
+        uint8_t cnt1[YDEV_KEYPAD_ROWS_MAX];             /*!< 消抖计数器高位 */
+        yDevKeypadEvent_t event[YDEV_KEYPAD_EVENT_LEN]; /*!< 事件队列 */
+        volatile uint32_t head;                         /*!< 事件队列读位置 */
+        volatile uint32_t tail;                         /*!< 事件队列写位置 */
+        yDevKeypadStats_t stats;                        /*!< 运行统计 */
+        uint8_t rows;                                   /*!< 行数 */
+        uint8_t cols;                                   /*!< 列数 */
+        uint8_t colShift;                               /*!< 列引脚连续时的移位量，0xFF为不连续 */
+        uint8_t running;                                /*!< 扫描进行中 */
+    } yDevHandle_Keypad_t;
+
+/**
+ * @brief 矩阵键盘配置结构体默认值
+ * @note 默认1kHz行切换，4x4键盘每4ms扫描一轮，消抖时间16ms
+ */
+#define YDEV_KEYPAD_CONFIG_DEFAULT()           \
+    ((yDevConfig_Keypad_t){                    \
+        .base = {.type = YDEV_TYPE_KEYPAD},    \
+        .rowPin = YDRV_PINNULL,                \
+        .rowMask = 0x0F,                       \
+        .colPin = YDRV_PINNULL,                \
+        .colMask = 0x0F,                       \
+        .rowHz = 1000,                         \
+        .prio = YDRV_IRQ_PRIO_BUTTON,          \
+    })
+
+/**
+ * @brief 矩阵键盘句柄结构体默认值
+ */
+#define YDEV_KEYPAD_HANDLE_DEFAULT()                 \
+    ((yDevHandle_Keypad_t){                          \
+        .base = YDEV_HANDLE_DEFAULT(),               \
+        .row = YDRV_GPIO_PORT_HANDLE_DEFAULT(),      \
+        .col = YDRV_GPIO_PORT_HANDLE_DEFAULT(),      \
+        .tim = YDRV_TIM_HANDLE_DEFAULT(),            \
+        .sampleGen = YDRV_DMA_GEN_HANDLE_DEFAULT(),  \
+        .rowGen = YDRV_DMA_GEN_HANDLE_DEFAULT(),     \
+        .sampleDma = YDRV_DMA_HANDLE_DEFAULT(),      \
+        .rowDma = YDRV_DMA_HANDLE_DEFAULT(),         \
+    })
+
+    // ==================== 矩阵键盘函数声明 ====================
+
+    /**
+     * @brief 初始化矩阵键盘配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDevKeypadConfigStructInit(yDevConfig_Keypad_t *config);
+
+    /**
+     * @brief 初始化矩阵键盘句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDevKeypadHandleStructInit(yDevHandle_Keypad_t *handle);
+
+/**
+ * @brief 矩阵键盘设备错误码(base.errno)
+ */
+#define YDEV_KEYPAD_ERRNO_NONE (0UL)        /*!< 无错误 */
+#define YDEV_KEYPAD_ERRNO_DMA (1UL << (3))  /*!< DMA传输错误，扫描已停止 */
+#define YDEV_KEYPAD_ERRNO_LOST (1UL << (4)) /*!< 事件队列满，有事件被丢弃 */
+
+/**
+ * @brief 矩阵键盘设备IOCTL命令
+ * - YDEV_KEYPAD_START: 启动扫描，初始化后已启动(arg: NULL)
+ * - YDEV_KEYPAD_STOP: 停止扫描，行全部释放，进入STOP模式前调用(arg: NULL)
+ * - YDEV_KEYPAD_GET_STATE: 获取消抖后的按下位图，第key位为键号key(arg: uint64_t*)
+ * - YDEV_KEYPAD_GET_STATS: 获取运行统计(arg: yDevKeypadStats_t*)
+ */
+#define YDEV_KEYPAD_IOCTL_BASE (YDEV_IOCTL_BASE + 0xD00)
+#define YDEV_KEYPAD_START (YDEV_KEYPAD_IOCTL_BASE + 0)
+#define YDEV_KEYPAD_STOP (YDEV_KEYPAD_IOCTL_BASE + 1)
+#define YDEV_KEYPAD_GET_STATE (YDEV_KEYPAD_IOCTL_BASE + 2)
+#define YDEV_KEYPAD_GET_STATS (YDEV_KEYPAD_IOCTL_BASE + 3)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_KEYPAD_H */
@@ -0,0 +1,190 @@
+/**
+ * @file yDev_kv.h
+ * @brief 基于25Q Flash的日志结构键值存储头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 在yDev 25Q设备的读写擦除接口之上实现追加写入的键值存储，
+ * 更新一个键只需一次追加编程，不再擦除重写整个扇区
+ *
+ * @par 主要特性:
+ * - 追加写入记录，删除以墓碑记录表示
+ * - RAM中以红黑树索引有效键，查找不扫描Flash
+ * - 扇区写满时滚动到下一空闲扇区，按最旧扇区回收，擦除均匀分布在存储区
+ * - 挂载时顺序扫描记录头重建索引，扫描时间与存储区大小成正比
+ * - 记录带CRC校验，掉电写坏的记录在挂载时被丢弃
+ *
+ * @par 存储布局:
+ * - 扇区头(16字节): 魔术字 + 扇区序号
+ * - 记录: 记录头(8字节) + 键 + 值，按4字节对齐，不跨扇区
+ */
+
+#ifndef YDEV_KV_H
+#define YDEV_KV_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDev_25q.h"
+#include "yLib_rbtree.h"
+
+    // ==================== KV存储常量定义 ====================
+
+    /**
+     * @brief 键最大长度(字节，不含结束符)
+     */
+#ifndef YDEV_KV_KEY_MAX
+#define YDEV_KV_KEY_MAX (32)
+#endif
+
+    /**
+     * @brief 值最大长度(字节)
+     */
+#ifndef YDEV_KV_VALUE_MAX
+#define YDEV_KV_VALUE_MAX (256)
+#endif
+
+#define YDEV_KV_SECTOR_MAGIC (0x31564B59UL) /*!< 扇区头魔术字 "YKV1" */
+#define YDEV_KV_RECORD_MAGIC (0x4B56U)      /*!< 记录头魔术字 "VK" */
+#define YDEV_KV_SECTOR_HEADER_SIZE (16)     /*!< 扇区头大小 */
+#define YDEV_KV_RECORD_HEADER_SIZE (8)      /*!< 记录头大小 */
+
+    // ==================== KV存储类型定义 ====================
+
+    /**
+     * @brief KV存储配置结构体
+     */
+    typedef struct
+    {
+        yDevHandle_25q_t *flash; /*!< 已初始化的25Q设备句柄 */
+        uint32_t baseAddress;    /*!< 存储区起始地址(扇区对齐) */
+        uint16_t sectorCount;    /*!< 存储区扇区数，至少2个 */
+        void *sectorBuffer;      /*!< 扇区信息数组(sectorCount个yDevKvSector_t)，NULL时从堆分配 */
+        void *indexBuffer;       /*!< 索引节点数组(indexCount个yDevKvIndex_t)，NULL时每个键从堆分配 */
+        uint16_t indexCount;     /*!< 索引节点数，即键数上限 */
+    } yDevKvConfig_t;
+
+    /**
+     * @brief KV存储扇区状态
+     */
+    typedef enum
+    {
+        YDEV_KV_SECTOR_UNKNOWN = 0, /*!< 未写扇区头，擦除状态未知，启用前需擦除 */
+        YDEV_KV_SECTOR_ERASED,      /*!< 已擦除，可直接启用 */
+        YDEV_KV_SECTOR_USED,        /*!< 已启用，含有记录 */
+    } yDevKvSectorState_t;
+
+    /**
+     * @brief KV存储扇区信息结构体
+     */
+    typedef struct
+    {
+        uint32_t seq;        /*!< 扇区序号，越大越新 */
+        uint16_t used;       /*!< 已写入字节数(含扇区头) */
+        uint8_t state;       /*!< 扇区状态 yDevKvSectorState_t */
+    } yDevKvSector_t;
+
+    /**
+     * @brief KV存储索引节点
+     */
+    typedef struct
+    {
+        struct ylib_rb_node node; /*!< 红黑树节点 */
+        uint32_t hash;            /*!< 键哈希值 */
+        uint32_t address;         /*!< 最新记录的Flash地址 */
+    } yDevKvIndex_t;
+
+    /**
+     * @brief KV存储句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_25q_t *flash;  /*!< 25Q设备句柄 */
+        uint32_t baseAddress;     /*!< 存储区起始地址 */
+        uint16_t sectorCount;     /*!< 存储区扇区数 */
+        uint16_t active;          /*!< 当前追加写入的扇区 */
+        uint32_t seq;             /*!< 最大扇区序号 */
+        uint32_t count;           /*!< 有效键数量 */
+        yDevKvSector_t *sector;   /*!< 扇区信息数组 */
+        struct ylib_rb_root root; /*!< 键索引红黑树 */
+        yDevKvIndex_t *indexFree; /*!< 静态索引节点的空闲链表，借用rb_right链接 */
+        uint8_t indexStatic;      /*!< 1=索引节点来自indexBuffer */
+        uint8_t sectorStatic;     /*!< 1=扇区信息数组来自sectorBuffer */
+        uint8_t mounted;          /*!< 挂载标志 */
+    } yDevKv_t;
+
+    // ==================== KV存储函数声明 ====================
+
+    /**
+     * @brief 挂载KV存储
+     * @param kv KV存储句柄指针
+     * @param config KV存储配置指针
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 挂载成功，索引已重建
+     *         - YDEV_INVALID_PARAM: 参数无效
+     *         - YDEV_NO_MEMORY: 索引内存不足
+     *         - YDEV_ERROR: Flash访问失败
+     * @note 存储区无有效扇区时自动格式化；
+     *       提供sectorBuffer和indexBuffer时挂载后的读写不使用堆，键数超过indexCount时写入返回YDEV_NO_MEMORY
+     */
+    yDevStatus_t yDevKvMount(yDevKv_t *kv, const yDevKvConfig_t *config);
+
+    /**
+     * @brief 卸载KV存储
+     * @param kv KV存储句柄指针
+     * @retval yDevStatus_t 操作状态
+     * @note 释放RAM索引，Flash内容保持不变
+     */
+    yDevStatus_t yDevKvUnmount(yDevKv_t *kv);
+
+    /**
+     * @brief 格式化KV存储
+     * @param kv KV存储句柄指针
+     * @retval yDevStatus_t 操作状态
+     * @note 擦除全部扇区并清空索引
+     */
+    yDevStatus_t yDevKvFormat(yDevKv_t *kv);
+
+    /**
+     * @brief 写入键值
+     * @param kv KV存储句柄指针
+     * @param key 键字符串
+     * @param value 值数据指针
+     * @param len 值长度，不超过YDEV_KV_VALUE_MAX
+     * @retval yDevStatus_t 操作状态
+     * @note 追加一条记录，当前扇区写满时滚动扇区并按需回收最旧扇区
+     */
+    yDevStatus_t yDevKvSet(yDevKv_t *kv, const char *key, const void *value, uint16_t len);
+
+    /**
+     * @brief 读取键值
+     * @param kv KV存储句柄指针
+     * @param key 键字符串
+     * @param value 值缓冲区指针
+     * @param size 值缓冲区大小
+     * @retval int32_t 值的实际长度，-1表示键不存在或读取失败
+     * @note 值长度大于缓冲区时只拷贝size字节，返回值仍为实际长度
+     */
+    int32_t yDevKvGet(yDevKv_t *kv, const char *key, void *value, uint16_t size);
+
+    /**
+     * @brief 删除键
+     * @param kv KV存储句柄指针
+     * @param key 键字符串
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 已追加墓碑记录
+     *         - YDEV_ERROR: 键不存在或Flash写入失败
+     */
+    yDevStatus_t yDevKvDelete(yDevKv_t *kv, const char *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_KV_H */
@@ -0,0 +1,186 @@
+/**
+ * @file yDev_pbus.h
+ * @brief yDev 8080/6800并行总线设备头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 用GPIO实现8080或6800时序的并行总线，用于驱动并口LCD等外设
+ *
+ * @par 主要特性:
+ * - 数据线为同一端口上连续的8位或4位，每个数据一次BSRR写入；WR/E与数据线同端口时
+ *   数据和选通有效沿合并为一次写入
+ * - DMA模式：选通由定时器单脉冲加重复计数器产生，恰好每字节一个脉冲，每个脉冲的比较事件
+ *   请求DMA把下一个字节写入ODR的对应字节，整帧刷新不需要CPU参与
+ * - 写入使用当前D/C电平，YDEV_PBUS_COMMAND发送命令字节加参数
+ * - 4位总线每字节先发高半字节再发低半字节
+ *
+ * @par 使用约束:
+ * - DMA模式要求8位数据线从引脚0或引脚8开始(ODR按字节写入不影响端口上的其他引脚)，
+ *   WR/E为定时器通道引脚，定时器须有重复计数器(TIM1/TIM15/TIM16)
+ * - 选通脉宽(strobe.pulse)须大于DMA响应时间加外设建立时间，脉冲前的间隔(strobe.delay)
+ *   对应数据保持时间
+ */
+
+#ifndef YDEV_PBUS_H
+#define YDEV_PBUS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDrv_gpio.h"
+#include "yDrv_tim.h"
+
+    // ==================== 并行总线类型定义 ====================
+
+    /**
+     * @brief 总线时序
+     */
+    typedef enum
+    {
+        YDEV_PBUS_MODE_8080 = 0, /*!< 8080：WR/RD低有效，上升沿锁存 */
+        YDEV_PBUS_MODE_6800,     /*!< 6800：E高有效，下降沿锁存，R/W高为读 */
+    } yDevPbusMode_t;
+
+    /**
+     * @brief yDev并行总线设备配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;      /*!< yDev基础配置结构体 */
+        yDrvGpioPin_t data;     /*!< 数据线最低位引脚，其余数据线在同一端口上依次相邻 */
+        uint8_t width;          /*!< 数据线位数，8或4 */
+        uint8_t mode;           /*!< 总线时序 yDevPbusMode_t */
+        yDrvGpioPin_t wr;       /*!< 8080为WR，6800为E；DMA模式下须为strobe定时器通道引脚 */
+        yDrvGpioPin_t rd;       /*!< 8080为RD，6800为R/W；YDRV_PINNULL为只写总线 */
+        yDrvGpioPin_t dc;       /*!< D/C(RS)，高为数据；YDRV_PINNULL不使用 */
+        yDrvGpioPin_t cs;       /*!< 片选，低有效；YDRV_PINNULL为常选 */
+        uint8_t cpuDelay;       /*!< CPU选通时每个电平保持的空循环数，慢速外设使用，0为最快 */
+        uint8_t useDma;         /*!< 非0时使用定时器选通和DMA写入 */
+        uint32_t dmaMin;        /*!< 写入不少于该字节数时走DMA，更短的由CPU写 */
+        yDrvTimConfig_t strobe; /*!< 选通定时器：timId/channel/pinAF/tickHz/delay/pulse/dma.priority有效 */
+    } yDevConfig_Pbus_t;
+
+    /**
+     * @brief yDev并行总线设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;            /*!< yDev基础句柄结构体 */
+        yDrvGpioPortHandle_t data;    /*!< 数据线端口组 */
+        yDrvGpioHandle_t wr;          /*!< WR/E */
+        yDrvGpioHandle_t rd;          /*!< RD或R/W，port为NULL表示未配置 */
+        yDrvGpioHandle_t dc;          /*!< D/C，port为NULL表示未配置 */
+        yDrvGpioHandle_t cs;          /*!< 片选，port为NULL表示未配置 */
+        yDrvTimHandle_t tim;          /*!< 选通定时器，instance为NULL表示不使用DMA */
+        volatile uint8_t *odr;        /*!< DMA写入地址，数据线所在的ODR字节 */
+        uint32_t strobeOn;            /*!< 选通有效的BSRR值 */
+        uint32_t strobeOff;           /*!< 选通无效的BSRR值 */
+        uint32_t strobeMerge;         /*!< 与数据同端口时并入数据写入的选通有效位，否则为0 */
+        uint32_t moderMask;           /*!< 数据线的MODER位 */
+        uint32_t moderOut;            /*!< 数据线为输出时的MODER值 */
+        const uint8_t *next;          /*!< DMA下一段数据 */
+        volatile uint32_t remain;     /*!< DMA剩余字节数 */
+        uint32_t chunk;               /*!< DMA当前段字节数 */
+        uint32_t total;               /*!< 本次DMA写入的总字节数 */
+        uint32_t chunkMax;            /*!< 单段最大字节数，由定时器重复计数器决定 */
+        uint32_t dmaMin;              /*!< 走DMA的最小写入长度 */
+        void *volatile waiter;        /*!< 等待同步DMA写入完成的任务 */
+        volatile yDevStatus_t result; /*!< DMA写入结果 */
+        volatile uint8_t busy;        /*!< DMA写入进行中 */
+        uint8_t async;                /*!< 当前DMA写入为异步写入 */
+        uint8_t width;                /*!< 数据线位数 */
+        uint8_t mode;                 /*!< 总线时序 */
+        uint8_t cpuDelay;             /*!< CPU选通延时空循环数 */
+    } yDevHandle_Pbus_t;
+
+    /**
+     * @brief 命令写入参数(YDEV_PBUS_COMMAND)
+     */
+    typedef struct
+    {
+        uint8_t cmd;          /*!< 命令字节，D/C为低时写入 */
+        const uint8_t *param; /*!< 参数，D/C为高时写入，可为NULL */
+        uint32_t len;         /*!< 参数字节数 */
+    } yDevPbusCommand_t;
+
+/**
+ * @brief 并行总线配置结构体默认值
+ * @note 默认8080时序、8位数据线，不使用DMA；DMA模式默认TIM1，64MHz计数时钟下
+ *       每字节周期14个计数(约4.5MB/s)
+ */
+#define YDEV_PBUS_CONFIG_DEFAULT()                  \
+    ((yDevConfig_Pbus_t){                           \
+        .base = {.type = YDEV_TYPE_PBUS},           \
+        .data = YDRV_PINNULL,                       \
+        .width = 8,                                 \
+        .mode = YDEV_PBUS_MODE_8080,                \
+        .wr = YDRV_PINNULL,                         \
+        .rd = YDRV_PINNULL,                         \
+        .dc = YDRV_PINNULL,                         \
+        .cs = YDRV_PINNULL,                         \
+        .cpuDelay = 0,                              \
+        .useDma = 0,                                \
+        .dmaMin = 32,                               \
+        .strobe = YDRV_TIM_CONFIG_DEFAULT(),        \
+    })
+
+/**
+ * @brief 并行总线句柄结构体默认值
+ */
+#define YDEV_PBUS_HANDLE_DEFAULT()                 \
+    ((yDevHandle_Pbus_t){                          \
+        .base = YDEV_HANDLE_DEFAULT(),             \
+        .data = YDRV_GPIO_PORT_HANDLE_DEFAULT(),   \
+        .wr = YDRV_GPIO_HANDLE_DEFAULT(),          \
+        .rd = YDRV_GPIO_HANDLE_DEFAULT(),          \
+        .dc = YDRV_GPIO_HANDLE_DEFAULT(),          \
+        .cs = YDRV_GPIO_HANDLE_DEFAULT(),          \
+        .tim = YDRV_TIM_HANDLE_DEFAULT(),          \
+    })
+
+    // ==================== 并行总线函数声明 ====================
+
+    /**
+     * @brief 初始化并行总线配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDevPbusConfigStructInit(yDevConfig_Pbus_t *config);
+
+    /**
+     * @brief 初始化并行总线句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDevPbusHandleStructInit(yDevHandle_Pbus_t *handle);
+
+/**
+ * @brief 并行总线设备错误码(base.errno)
+ */
+#define YDEV_PBUS_ERRNO_NONE (0UL)           /*!< 无错误 */
+#define YDEV_PBUS_ERRNO_DMA (1UL << (3))     /*!< DMA传输错误 */
+#define YDEV_PBUS_ERRNO_TIMEOUT (1UL << (4)) /*!< 等待DMA写入完成超时 */
+#define YDEV_PBUS_ERRNO_BUSY (1UL << (5))    /*!< 上一次DMA写入未完成 */
+
+/**
+ * @brief 并行总线设备IOCTL命令
+ * - YDEV_PBUS_SET_DC: 设置之后读写使用的D/C电平(arg: uint32_t*，0为命令，1为数据)
+ * - YDEV_PBUS_COMMAND: 发送命令字节和参数，结束后D/C为数据(arg: yDevPbusCommand_t*)
+ * - YDEV_PBUS_SYNC: 等待进行中的DMA写入完成(arg: NULL)
+ */
+#define YDEV_PBUS_IOCTL_BASE (YDEV_IOCTL_BASE + 0xC00)
+#define YDEV_PBUS_SET_DC (YDEV_PBUS_IOCTL_BASE + 0)
+#define YDEV_PBUS_COMMAND (YDEV_PBUS_IOCTL_BASE + 1)
+#define YDEV_PBUS_SYNC (YDEV_PBUS_IOCTL_BASE + 2)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_PBUS_H */
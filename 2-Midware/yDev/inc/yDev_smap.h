@@ -0,0 +1,172 @@
+/**
+ * @file yDev_smap.h
+ * @brief 基于25Q Flash的持久化扇区状态表头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 为FTL、KV、日志等上层记录一段存储区内每个扇区的状态(已擦除/部分写入/写满)，
+ * 状态表保存在保留的两个扇区中，挂载时读取几页即可恢复，不需要扫描整个存储区
+ *
+ * @par 主要特性:
+ * - 每扇区2位，16MB器件(4096扇区)的状态表为1KB
+ * - 状态变化以4字节日志条目追加，不擦除
+ * - 日志写满时把完整状态表压缩到另一个表扇区，表头最后写入，掉电时旧表仍有效
+ * - 挂载时间与状态表大小加日志长度成正比，与存储区大小无关
+ *
+ * @par 存储布局:
+ * - 表扇区A/B，各占一个扇区，两者中序号较大且校验通过的一个有效
+ * - 表头(32字节): 魔术字 + 序号 + 存储区地址 + 扇区数 + CRC
+ * - 状态表: 紧跟表头，YDEV_SMAP_BYTES(扇区数)字节
+ * - 日志: 状态表之后按4字节对齐到扇区末尾，全0xFF的条目表示日志结束
+ *
+ * @par 使用约束:
+ * 状态表只记录上层告诉它的状态，不跟踪25Q驱动的擦写；
+ * 向"更脏"方向的变化(ERASED→PARTIAL/FULL)须在编程之前记录，
+ * 变为ERASED须在擦除完成之后记录，掉电时表中的状态只会比实际更保守
+ */
+
+#ifndef YDEV_SMAP_H
+#define YDEV_SMAP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDev_25q.h"
+
+    // ==================== 扇区状态表常量定义 ====================
+
+#define YDEV_SMAP_MAGIC (0x31504D53UL)  /*!< 表头魔术字 "SMP1" */
+#define YDEV_SMAP_HEADER_SIZE (32)      /*!< 表头大小 */
+#define YDEV_SMAP_JOURNAL_MIN (16)      /*!< 日志最少条目数，不足时拒绝挂载 */
+
+    /**
+     * @brief 状态表字节数
+     * @param count 扇区数
+     */
+#define YDEV_SMAP_BYTES(count) (((uint32_t)(count) + 3U) / 4U)
+
+    // ==================== 扇区状态表类型定义 ====================
+
+    /**
+     * @brief 扇区状态
+     */
+    typedef enum
+    {
+        YDEV_SMAP_UNKNOWN = 0, /*!< 未知，新建状态表的初始值，使用前需擦除或扫描 */
+        YDEV_SMAP_ERASED,      /*!< 已擦除，可直接编程 */
+        YDEV_SMAP_PARTIAL,     /*!< 部分写入，尾部可能仍可追加 */
+        YDEV_SMAP_FULL,        /*!< 已写满 */
+    } yDevSmapState_t;
+
+    /**
+     * @brief 扇区状态表配置结构体
+     */
+    typedef struct
+    {
+        yDevHandle_25q_t *flash; /*!< 已初始化的25Q设备句柄 */
+        uint32_t mapAddress;     /*!< 表扇区A地址(扇区对齐)，表扇区B紧随其后，不能与存储区重叠 */
+        uint32_t baseAddress;    /*!< 存储区起始地址(扇区对齐) */
+        uint16_t sectorCount;    /*!< 存储区扇区数 */
+        void *mapBuffer;         /*!< 状态表缓冲区(YDEV_SMAP_BYTES(sectorCount)字节)，NULL时从堆分配 */
+    } yDevSmapConfig_t;
+
+    /**
+     * @brief 扇区状态表句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_25q_t *flash; /*!< 25Q设备句柄 */
+        uint32_t mapAddress;     /*!< 表扇区A地址 */
+        uint32_t baseAddress;    /*!< 存储区起始地址 */
+        uint16_t sectorCount;    /*!< 存储区扇区数 */
+        uint8_t copy;            /*!< 当前有效的表扇区，0=A，1=B */
+        uint32_t seq;            /*!< 当前表序号 */
+        uint16_t journal;        /*!< 下一条日志条目序号 */
+        uint16_t journalMax;     /*!< 日志条目容量 */
+        uint32_t compactions;    /*!< 挂载以来的压缩次数 */
+        uint8_t *map;            /*!< 状态表，每字节4个扇区，低位在前 */
+        uint8_t mapStatic;       /*!< 1=状态表来自mapBuffer */
+        uint8_t formatted;       /*!< 1=挂载时未找到有效状态表，已新建为全UNKNOWN */
+        uint8_t mounted;         /*!< 挂载标志 */
+    } yDevSmap_t;
+
+    // ==================== 扇区状态表函数声明 ====================
+
+    /**
+     * @brief 挂载扇区状态表
+     * @param smap 状态表句柄指针
+     * @param config 配置指针
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 挂载成功
+     *         - YDEV_INVALID_PARAM: 参数无效或扇区数过多，日志容量不足YDEV_SMAP_JOURNAL_MIN
+     *         - YDEV_NO_MEMORY: 状态表内存不足
+     *         - YDEV_ERROR: Flash访问失败
+     * @note 两个表扇区都无效，或表头记录的存储区与配置不符时新建全UNKNOWN的状态表并置formatted，
+     *       调用者据此做一次全扫描或擦除后用yDevSmapSet/yDevSmapFormat写入真实状态
+     */
+    yDevStatus_t yDevSmapMount(yDevSmap_t *smap, const yDevSmapConfig_t *config);
+
+    /**
+     * @brief 卸载扇区状态表
+     * @param smap 状态表句柄指针
+     * @retval yDevStatus_t 操作状态
+     * @note 日志随写随落盘，卸载不需要写Flash
+     */
+    yDevStatus_t yDevSmapUnmount(yDevSmap_t *smap);
+
+    /**
+     * @brief 把全部扇区设为同一状态
+     * @param smap 状态表句柄指针
+     * @param state 扇区状态
+     * @retval yDevStatus_t 操作状态
+     * @note 写入一份新的完整状态表，不擦除存储区
+     */
+    yDevStatus_t yDevSmapFormat(yDevSmap_t *smap, yDevSmapState_t state);
+
+    /**
+     * @brief 读取扇区状态
+     * @param smap 状态表句柄指针
+     * @param sector 存储区内的扇区序号
+     * @retval yDevSmapState_t 扇区状态，越界或未挂载时为YDEV_SMAP_UNKNOWN
+     * @note 只读RAM，不访问Flash
+     */
+    yDevSmapState_t yDevSmapGet(yDevSmap_t *smap, uint16_t sector);
+
+    /**
+     * @brief 设置扇区状态
+     * @param smap 状态表句柄指针
+     * @param sector 存储区内的扇区序号
+     * @param state 扇区状态
+     * @retval yDevStatus_t 操作状态
+     * @note 状态未变时不写Flash；否则追加一条日志，日志写满时压缩到另一个表扇区
+     */
+    yDevStatus_t yDevSmapSet(yDevSmap_t *smap, uint16_t sector, yDevSmapState_t state);
+
+    /**
+     * @brief 查找指定状态的扇区
+     * @param smap 状态表句柄指针
+     * @param state 扇区状态
+     * @param from 起始扇区序号
+     * @retval int32_t 从from起第一个该状态的扇区序号，-1表示没有
+     */
+    int32_t yDevSmapFind(yDevSmap_t *smap, yDevSmapState_t state, uint16_t from);
+
+    /**
+     * @brief 统计指定状态的扇区数
+     * @param smap 状态表句柄指针
+     * @param state 扇区状态
+     * @retval uint32_t 扇区数
+     */
+    uint32_t yDevSmapCount(yDevSmap_t *smap, yDevSmapState_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_SMAP_H */
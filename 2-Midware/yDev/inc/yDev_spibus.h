@@ -0,0 +1,285 @@
+/**
+ * @file yDev_spibus.h
+ * @brief 共享SPI总线管理头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 总线对象独占一个SPI外设实例和总线作业调度器，多个器件挂接在同一总线上，
+ * 各自保存片选引脚、时钟模式和速率，不同任务中的器件访问按事务串行执行
+ *
+ * @par 主要特性:
+ * - 事务开始时持有总线，等待的任务按作业类别和截止时间排队(yDev_busjob)
+ * - 器件参数与上一次事务不同时才重新配置SPI，同一器件连续访问无切换开销
+ * - 片选引脚由总线在事务内切换，器件之间不会争抢片选
+ * - 总线统一登记中断和DMA传输引擎，按长度选择轮询、中断或DMA
+ * - 批量事务在一次总线作业内访问多个器件，DMA完成中断中切换片选接续下一个器件
+ */
+
+#ifndef YDEV_SPIBUS_H
+#define YDEV_SPIBUS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDrv_spi.h"
+#include "yDev_busjob.h"
+
+    // ==================== SPI总线类型定义 ====================
+
+    /**
+     * @brief SPI总线配置结构体
+     */
+    typedef struct
+    {
+        yDrvSpiId_t spiId;             /*!< SPI外设实例，YDRV_SPI_SOFT为GPIO模拟 */
+        yDrvGpioPin_t sckPin;          /*!< SCK引脚 */
+        yDrvGpioPin_t misoPin;         /*!< MISO引脚 */
+        yDrvGpioPin_t mosiPin;         /*!< MOSI引脚 */
+        uint32_t sckAF;                /*!< SCK复用功能 */
+        uint32_t misoAF;               /*!< MISO复用功能 */
+        uint32_t mosiAF;               /*!< MOSI复用功能 */
+        uint8_t dmaEnable;             /*!< 大块传输使用DMA，0=禁用 */
+        yDrvDmaChannel_t rxDmaChannel; /*!< SPI接收DMA通道 */
+        yDrvDmaChannel_t txDmaChannel; /*!< SPI发送DMA通道 */
+        uint32_t timeOutMs;            /*!< 单次中断/DMA传输超时时间(毫秒) */
+    } yDevSpiBusConfig_t;
+
+    /**
+     * @brief SPI总线结构体
+     */
+    typedef struct
+    {
+        yDrvSpiHandle_t spi;                  /*!< 共享SPI驱动句柄 */
+        yDevBusSched_t sched;                 /*!< 总线作业调度器 */
+        const void *owner;                    /*!< 当前持有总线的器件 */
+        yDrvSpiClockPolarity_t polarity;      /*!< 当前生效的时钟极性 */
+        yDrvSpiClockPhase_t phase;            /*!< 当前生效的时钟相位 */
+        yDrvSpiSpeedLevel_t speed;            /*!< 当前生效的速率等级 */
+        uint32_t timeOutMs;                   /*!< 单次中断/DMA传输超时时间 */
+        void *wait_task;                      /*!< 等待传输完成的任务句柄 */
+        void *batch;                          /*!< 进行中的批量事务(yDevSpiBusBatchItem_t数组) */
+        volatile uint32_t batchIndex;         /*!< 批量事务当前项，在DMA中断中推进 */
+        uint32_t batchEnd;                    /*!< 本段DMA链的结束项(不含) */
+        volatile uint8_t flagDone;            /*!< 传输完成标志(中断中置位) */
+        uint8_t flagIrq;                      /*!< 中断传输可用标志 */
+        uint8_t flagDma;                      /*!< DMA传输可用标志 */
+        uint8_t flagReady;                    /*!< 总线已初始化标志 */
+    } yDevSpiBus_t;
+
+    /**
+     * @brief SPI总线器件配置结构体
+     */
+    typedef struct
+    {
+        yDrvGpioPin_t csPin;             /*!< 器件片选引脚(低有效) */
+        yDrvSpiClockPolarity_t polarity; /*!< 器件时钟极性 */
+        yDrvSpiClockPhase_t phase;       /*!< 器件时钟相位 */
+        yDrvSpiSpeedLevel_t speed;       /*!< 器件速率等级 */
+    } yDevSpiBusDeviceConfig_t;
+
+    /**
+     * @brief SPI总线器件结构体
+     */
+    typedef struct
+    {
+        yDevSpiBus_t *bus;               /*!< 所属总线 */
+        yDrvGpioInfo_t csPinInfo;        /*!< 片选引脚信息 */
+        yDrvSpiClockPolarity_t polarity; /*!< 器件时钟极性 */
+        yDrvSpiClockPhase_t phase;       /*!< 器件时钟相位 */
+        yDrvSpiSpeedLevel_t speed;       /*!< 器件速率等级 */
+    } yDevSpiBusDevice_t;
+
+    /**
+     * @brief SPI总线事务分段结构体
+     */
+    typedef struct
+    {
+        const void *tx; /*!< 发送缓冲区，NULL表示发送0xFF */
+        void *rx;       /*!< 接收缓冲区，NULL表示丢弃 */
+        uint32_t len;   /*!< 分段字节数 */
+    } yDevSpiBusXfer_t;
+
+    /**
+     * @brief SPI总线批量事务中的一项
+     * @note 每项为一个器件的一次完整片选周期，分段在传输完成前必须保持有效
+     */
+    typedef struct
+    {
+        yDevSpiBusDevice_t *device; /*!< 器件 */
+        const yDrvSpiSeg_t *seg;    /*!< 片选周期内的分段，16位帧时长度为偶数 */
+        uint32_t count;             /*!< 分段数量 */
+        uint32_t timeUs;            /*!< 输出：片选释放时的微秒时间戳 */
+        yDevStatus_t status;        /*!< 输出：本项结果 */
+    } yDevSpiBusBatchItem_t;
+
+    // =============== SPI总线配置初始化宏 ====================
+
+    /**
+     * @brief SPI总线配置结构体默认初始化宏
+     */
+#define YDEV_SPIBUS_CONFIG_DEFAULT()          \
+    ((yDevSpiBusConfig_t){                    \
+        .spiId = YDRV_SPI_1,                  \
+        .sckPin = YDRV_PINNULL,               \
+        .misoPin = YDRV_PINNULL,              \
+        .mosiPin = YDRV_PINNULL,              \
+        .sckAF = YDRV_GPIO_AF_AUTO,           \
+        .misoAF = YDRV_GPIO_AF_AUTO,          \
+        .mosiAF = YDRV_GPIO_AF_AUTO,          \
+        .dmaEnable = 0,                       \
+        .rxDmaChannel = YDRV_DMA_CHANNEL_MAX, \
+        .txDmaChannel = YDRV_DMA_CHANNEL_MAX, \
+        .timeOutMs = 100})
+
+    /**
+     * @brief SPI总线器件配置结构体默认初始化宏
+     */
+#define YDEV_SPIBUS_DEVICE_CONFIG_DEFAULT()  \
+    ((yDevSpiBusDeviceConfig_t){             \
+        .csPin = YDRV_PINNULL,               \
+        .polarity = YDRV_SPI_POLARITY_LOW,   \
+        .phase = YDRV_SPI_PHASE_1EDGE,       \
+        .speed = YDRV_SPI_SPEED_LEVEL3})
+
+    // ==================== SPI总线函数声明 ====================
+
+    /**
+     * @brief 初始化SPI总线
+     * @param bus 总线结构体指针
+     * @param config 总线配置指针
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 初始化成功
+     *         - YDEV_INVALID_PARAM: 参数无效
+     *         - YDEV_NO_MEMORY: 互斥锁创建失败
+     *         - YDEV_ERROR: SPI初始化失败
+     * @note 中断传输总是尝试登记，DMA按配置启用，失败时对应长度退回轮询
+     */
+    yDevStatus_t yDevSpiBusInit(yDevSpiBus_t *bus, const yDevSpiBusConfig_t *config);
+
+    /**
+     * @brief 反初始化SPI总线
+     * @param bus 总线结构体指针
+     * @retval yDevStatus_t 操作状态
+     * @note 调用前应先分离全部器件
+     */
+    yDevStatus_t yDevSpiBusDeInit(yDevSpiBus_t *bus);
+
+    /**
+     * @brief 挂接器件到SPI总线
+     * @param bus 总线结构体指针
+     * @param device 器件结构体指针
+     * @param config 器件配置指针
+     * @retval yDevStatus_t 操作状态
+     * @note 片选引脚配置为推挽输出并置高
+     */
+    yDevStatus_t yDevSpiBusAttach(yDevSpiBus_t *bus,
+                                  yDevSpiBusDevice_t *device,
+                                  const yDevSpiBusDeviceConfig_t *config);
+
+    /**
+     * @brief 从SPI总线分离器件
+     * @param device 器件结构体指针
+     * @retval yDevStatus_t 操作状态
+     */
+    yDevStatus_t yDevSpiBusDetach(yDevSpiBusDevice_t *device);
+
+    /**
+     * @brief 获取SPI总线
+     * @param device 器件结构体指针
+     * @param timeOutMs 等待总线的超时时间(毫秒)
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 已持有总线，器件参数已生效
+     *         - YDEV_TIMEOUT: 等待总线超时
+     * @note 器件参数与当前总线参数不同时才重新配置SPI；
+     *       调度器未启动时不加锁，只切换器件参数
+     * @note 持有期间总线SPI句柄的片选指向该器件，可直接使用yDrvSpiCsControl
+     */
+    yDevStatus_t yDevSpiBusLock(yDevSpiBusDevice_t *device, uint32_t timeOutMs);
+
+    /**
+     * @brief 按作业类别和截止时间获取SPI总线
+     * @param device 器件结构体指针
+     * @param cls 作业类别
+     * @param deadlineMs 相对截止时间(毫秒)，0使用类别默认值
+     * @param timeOutMs 等待总线的超时时间(毫秒)
+     * @retval yDevStatus_t 操作状态，见yDevBusJobBegin
+     * @note yDevSpiBusLock等同于YDEV_BUSJOB_READ类别、默认截止时间
+     */
+    yDevStatus_t yDevSpiBusLockJob(yDevSpiBusDevice_t *device,
+                                   yDevBusJobClass_t cls,
+                                   uint32_t deadlineMs,
+                                   uint32_t timeOutMs);
+
+    /**
+     * @brief 长作业的安全点，有更紧急的作业等待时让出总线
+     * @param device 器件结构体指针
+     * @param limit 只让给类别小于该值的作业，YDEV_BUSJOB_CLASS_MAX为不限
+     * @retval 1 已让出并重新获得总线(器件参数已重新生效)，0 未让出
+     * @note 只能在片选释放、器件处于可被其他器件打断的状态时调用
+     */
+    uint8_t yDevSpiBusYield(yDevSpiBusDevice_t *device, yDevBusJobClass_t limit);
+
+    /**
+     * @brief 释放SPI总线
+     * @param device 器件结构体指针
+     * @retval 无
+     */
+    void yDevSpiBusUnlock(yDevSpiBusDevice_t *device);
+
+    /**
+     * @brief 在已持有的总线上传输数据
+     * @param device 器件结构体指针
+     * @param tx 发送缓冲区，NULL表示发送0xFF
+     * @param rx 接收缓冲区，NULL表示丢弃
+     * @param len 传输字节数
+     * @retval int32_t 实际传输的字节数
+     * @note 不操作片选；按长度选择DMA、中断或打包轮询，中断/DMA时调用任务阻塞等待
+     */
+    int32_t yDevSpiBusTransfer(yDevSpiBusDevice_t *device, const void *tx, void *rx, uint32_t len);
+
+    /**
+     * @brief 执行一次完整的SPI总线事务
+     * @param device 器件结构体指针
+     * @param xfer 事务分段数组
+     * @param count 分段数量
+     * @param timeOutMs 等待总线的超时时间(毫秒)
+     * @retval yDevStatus_t 操作状态
+     * @note 获取总线、拉低片选、依次传输各分段、拉高片选、释放总线；
+     *       典型用法为命令分段加数据分段
+     */
+    yDevStatus_t yDevSpiBusTransaction(yDevSpiBusDevice_t *device,
+                                       const yDevSpiBusXfer_t *xfer,
+                                       uint32_t count,
+                                       uint32_t timeOutMs);
+
+    /**
+     * @brief 在一次总线作业内依次执行多个器件的事务
+     * @param bus 总线结构体指针
+     * @param item 事务数组，各项的device须挂接在该总线上
+     * @param count 事务数量
+     * @param cls 作业类别
+     * @param deadlineMs 相对截止时间(毫秒)，0使用类别默认值
+     * @param timeOutMs 等待总线的超时时间(毫秒)
+     * @retval yDevStatus_t 操作状态，见yDevBusJobBegin；获得总线后返回YDEV_OK，各项结果见item->status
+     * @note 启用DMA时，时钟模式和速率相同的相邻各项在DMA完成中断中切换片选并装载下一项，
+     *       整串只唤醒调用任务一次；参数不同的项在任务中重新配置SPI后开始新的一串；
+     *       未启用DMA或调度器未启动时逐项按yDevSpiBusTransfer传输
+     */
+    yDevStatus_t yDevSpiBusBatch(yDevSpiBus_t *bus,
+                                 yDevSpiBusBatchItem_t *item,
+                                 uint32_t count,
+                                 yDevBusJobClass_t cls,
+                                 uint32_t deadlineMs,
+                                 uint32_t timeOutMs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_SPIBUS_H */
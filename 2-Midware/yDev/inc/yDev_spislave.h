@@ -0,0 +1,194 @@
+/**
+ * @file yDev_spislave.h
+ * @brief yDev SPI从机设备头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * SPI外设作为从机接入主处理器，接收由循环DMA写入环形缓冲区，
+ * 应答数据在片选期间由DMA预装发送，整个传输过程没有逐字节中断
+ *
+ * @par 主要特性:
+ * - 接收DMA循环模式，半满/全满中断交替交付双缓冲的一半
+ * - 片选拉高(EXTI上升沿)时回调本帧在环形缓冲区中的位置和长度
+ * - 应答数据双缓冲，写入非活动的一半，下一帧开始前切换并重装发送DMA
+ * - 帧结束时通过RCC复位清空发送FIFO，丢弃上一帧未发出的预装数据
+ *
+ * @par 时序约束:
+ * 帧间隔(片选拉高到下一次拉低)需大于EXTI中断处理时间，否则下一帧开头的
+ * 应答数据来不及装载
+ */
+
+#ifndef YDEV_SPISLAVE_H
+#define YDEV_SPISLAVE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDrv_spi.h"
+#include "yDrv_gpio.h"
+#include "yDrv_dma.h"
+
+    // ==================== SPI从机类型定义 ====================
+
+    /**
+     * @brief SPI从机帧信息
+     * @note 帧数据位于接收环形缓冲区，可能在缓冲区末尾回绕
+     */
+    typedef struct
+    {
+        const uint8_t *buffer; /*!< 接收环形缓冲区首地址 */
+        uint32_t size;         /*!< 环形缓冲区大小 */
+        uint32_t start;        /*!< 帧起始偏移 */
+        uint32_t len;          /*!< 帧长度 */
+    } yDevSpiSlaveFrame_t;
+
+    /**
+     * @brief SPI从机帧结束回调函数类型
+     * @param arg 用户参数
+     * @param frame 帧信息
+     * @note 在EXTI中断中执行
+     */
+    typedef void (*yDevSpiSlaveFrameCallback_t)(void *arg, const yDevSpiSlaveFrame_t *frame);
+
+    /**
+     * @brief SPI从机半缓冲就绪回调函数类型
+     * @param arg 用户参数
+     * @param data 已写满的半个缓冲区
+     * @param len 半个缓冲区长度
+     * @note 在DMA中断中执行，须在DMA写满另一半之前处理完
+     */
+    typedef void (*yDevSpiSlaveBlockCallback_t)(void *arg, const uint8_t *data, uint32_t len);
+
+    /**
+     * @brief SPI从机状态信息
+     * @note 用于YDEV_SPISLAVE_IOCTL_GET_STATS
+     */
+    typedef struct
+    {
+        uint32_t frames;  /*!< 已结束的帧数 */
+        uint32_t bytes;   /*!< 已接收的字节数 */
+        uint32_t replies; /*!< 已切换的应答次数 */
+    } yDevSpiSlaveStats_t;
+
+    /**
+     * @brief yDev SPI从机配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;                         /*!< yDev基础配置结构体 */
+        yDrvSpiId_t spiId;                         /*!< SPI外设实例(仅支持硬件SPI) */
+        yDrvGpioPin_t sckPin;                      /*!< SCK引脚 */
+        yDrvGpioPin_t misoPin;                     /*!< MISO引脚 */
+        yDrvGpioPin_t mosiPin;                     /*!< MOSI引脚 */
+        yDrvGpioPin_t nssPin;                      /*!< NSS引脚(硬件NSS输入，同时用于EXTI) */
+        uint32_t sckAF;                            /*!< SCK复用功能 */
+        uint32_t misoAF;                           /*!< MISO复用功能 */
+        uint32_t mosiAF;                           /*!< MOSI复用功能 */
+        uint32_t nssAF;                            /*!< NSS复用功能 */
+        yDrvSpiClockPolarity_t polarity;           /*!< 时钟极性 */
+        yDrvSpiClockPhase_t phase;                 /*!< 时钟相位 */
+        yDrvDmaChannel_t rxDmaChannel;             /*!< 接收DMA通道 */
+        yDrvDmaChannel_t txDmaChannel;             /*!< 发送DMA通道 */
+        uint8_t *rxBuffer;                         /*!< 接收环形缓冲区(双缓冲) */
+        uint32_t rxSize;                           /*!< 接收缓冲区大小(偶数，不超过65535) */
+        uint8_t *txBuffer;                         /*!< 应答双缓冲区，可为NULL */
+        uint32_t txSize;                           /*!< 应答缓冲区大小(两半各txSize/2) */
+        uint32_t prio;                             /*!< DMA和EXTI中断优先级 */
+        yDevSpiSlaveFrameCallback_t frameCallback; /*!< 帧结束回调，可为NULL */
+        yDevSpiSlaveBlockCallback_t blockCallback; /*!< 半缓冲就绪回调，可为NULL */
+        void *arg;                                 /*!< 回调参数 */
+    } yDevConfig_SpiSlave_t;
+
+    /**
+     * @brief yDev SPI从机句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;                         /*!< yDev基础句柄结构体 */
+        yDrvSpiHandle_t spi;                       /*!< SPI驱动句柄 */
+        yDrvGpioHandle_t nss;                      /*!< NSS引脚EXTI句柄 */
+        yDrvDmaHandle_t rxDma;                     /*!< 接收DMA句柄 */
+        yDrvDmaHandle_t txDma;                     /*!< 发送DMA句柄 */
+        uint8_t *rxBuffer;                         /*!< 接收环形缓冲区 */
+        uint32_t rxSize;                           /*!< 接收缓冲区大小 */
+        uint32_t readPos;                          /*!< 读取位置 */
+        volatile uint32_t frameStart;              /*!< 当前帧起始偏移 */
+        uint8_t *txBuffer;                         /*!< 应答双缓冲区 */
+        uint32_t txHalf;                           /*!< 应答缓冲区一半的大小 */
+        uint32_t txLen[2];                         /*!< 两半应答数据长度 */
+        volatile uint8_t txActive;                 /*!< 当前发送的一半 */
+        volatile uint8_t txPending;                /*!< 非活动一半已写入新应答 */
+        uint8_t txDummy;                           /*!< 无应答时发送的填充字节 */
+        uint8_t flagReady;                         /*!< 设备已启动标志 */
+        volatile uint8_t txAsync;                  /*!< 异步应答状态(0=无, 1=待生效, 2=发送中) */
+        uint8_t *volatile rxAsync;                 /*!< 异步读取目标缓冲区，NULL表示没有异步读取 */
+        yDevSpiSlaveFrameCallback_t frameCallback; /*!< 帧结束回调 */
+        yDevSpiSlaveBlockCallback_t blockCallback; /*!< 半缓冲就绪回调 */
+        void *arg;                                 /*!< 回调参数 */
+        yDevSpiSlaveStats_t stats;                 /*!< 状态统计 */
+    } yDevHandle_SpiSlave_t;
+
+    // =============== yDev SPI从机配置初始化宏 ====================
+
+    /**
+     * @brief yDev SPI从机配置结构体默认初始化宏
+     */
+#define YDEV_SPISLAVE_CONFIG_DEFAULT()              \
+    ((yDevConfig_SpiSlave_t){                       \
+        .base = {.type = YDEV_TYPE_SPI_SLAVE},      \
+        .spiId = YDRV_SPI_1,                        \
+        .sckPin = YDRV_PINNULL,                     \
+        .misoPin = YDRV_PINNULL,                    \
+        .mosiPin = YDRV_PINNULL,                    \
+        .nssPin = YDRV_PINNULL,                     \
+        .polarity = YDRV_SPI_POLARITY_LOW,          \
+        .phase = YDRV_SPI_PHASE_1EDGE,              \
+        .rxDmaChannel = YDRV_DMA_CHANNEL_MAX,       \
+        .txDmaChannel = YDRV_DMA_CHANNEL_MAX,       \
+        .rxBuffer = NULL,                           \
+        .rxSize = 0,                                \
+        .txBuffer = NULL,                           \
+        .txSize = 0,                                \
+        .prio = YDRV_IRQ_PRIO_SPI_SLAVE,            \
+        .frameCallback = NULL,                      \
+        .blockCallback = NULL,                      \
+        .arg = NULL})
+
+    /**
+     * @brief yDev SPI从机句柄结构体默认初始化宏
+     */
+#define YDEV_SPISLAVE_HANDLE_DEFAULT() \
+    {                                  \
+        .base = YDEV_HANDLE_DEFAULT(), \
+        .rxBuffer = NULL,              \
+        .txBuffer = NULL,              \
+        .flagReady = 0}
+
+// ==================== SPI从机IOCTL命令定义 ====================
+
+/**
+ * @brief SPI从机设备IOCTL命令
+ */
+#define YDEV_SPISLAVE_IOCTL_BASE (YDEV_IOCTL_BASE + 0x300)
+
+#define YDEV_SPISLAVE_IOCTL_GET_STATS (YDEV_SPISLAVE_IOCTL_BASE + 1) /**< 读取统计(arg: yDevSpiSlaveStats_t*) */
+#define YDEV_SPISLAVE_IOCTL_AVAILABLE (YDEV_SPISLAVE_IOCTL_BASE + 2) /**< 读取可读字节数(arg: uint32_t*) */
+#define YDEV_SPISLAVE_IOCTL_FLUSH (YDEV_SPISLAVE_IOCTL_BASE + 3)     /**< 丢弃未读取的接收数据 */
+
+    // ==================== SPI从机错误代码定义 ====================
+
+#define YDEV_SPISLAVE_ERRNO_NONE (0UL)          /*!< 无错误 */
+#define YDEV_SPISLAVE_ERRNO_DMA (1UL << (0))    /*!< DMA传输错误 */
+#define YDEV_SPISLAVE_ERRNO_REPLY (1UL << (1))  /*!< 应答数据超过半个应答缓冲区 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_SPISLAVE_H */
@@ -0,0 +1,176 @@
+/**
+ * @file yDev_tim.h
+ * @brief yDev定时器设备驱动头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 基于yDev框架的定时器单通道设备，提供PWM输出、输入捕获和单脉冲输出
+ *
+ * @par 主要特性:
+ * - 同步读写：读取最近一次捕获值，写入比较值(占空比)
+ * - 异步写入：PWM模式下按周期依次输出占空比表，表播放完成后通知
+ * - 异步读取：捕获模式下把指定次数的捕获值写入缓冲区，写满后通知
+ * - 控制命令启动循环突发输出和循环捕获，LED图案和频率测量全程由硬件完成，不需要任务唤醒
+ */
+
+#ifndef YDEV_TIM_H
+#define YDEV_TIM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+#include "yDrv_tim.h"
+
+    // ==================== 定时器设备特定定义 ====================
+
+    /**
+     * @brief yDev定时器设备配置结构体
+     */
+    typedef struct
+    {
+        yDevConfig_t base;          /*!< yDev基础配置结构体 */
+        yDrvTimConfig_t drv_config; /*!< 定时器底层驱动配置结构体 */
+    } yDevConfig_Tim_t;
+
+    /**
+     * @brief yDev定时器设备句柄结构体
+     */
+    typedef struct
+    {
+        yDevHandle_t base;          /*!< yDev基础句柄结构体 */
+        yDrvTimHandle_t drv_handle; /*!< 定时器底层驱动句柄 */
+        yDrvTimDmaConfig_t dma;     /*!< 用户DMA配置，异步传输结束后恢复 */
+        uint16_t *capture_buf;      /*!< 循环捕获缓冲区，YDEV_TIM_GET_FREQ使用 */
+        uint8_t async_dir;          /*!< 进行中的异步传输方向 yDevAsyncDir_t */
+    } yDevHandle_Tim_t;
+
+    /**
+     * @brief 单脉冲参数
+     */
+    typedef struct
+    {
+        uint32_t delay; /*!< 触发到脉冲开始的计数值(至少为1) */
+        uint32_t width; /*!< 脉宽计数值 */
+    } yDevTimPulse_t;
+
+    /**
+     * @brief DMA突发输出参数
+     * @note 表格按每个周期count个寄存器值排列，循环模式下反复播放
+     */
+    typedef struct
+    {
+        yDrvTimBurstBase_t base; /*!< 起始寄存器 */
+        uint32_t count;          /*!< 每个周期写入的寄存器数 */
+        const uint16_t *table;   /*!< 寄存器值表，运行期间必须保持有效 */
+        uint32_t len;            /*!< 表中半字总数 */
+    } yDevTimBurst_t;
+
+    /**
+     * @brief 循环捕获参数
+     */
+    typedef struct
+    {
+        uint16_t *buffer; /*!< 捕获值缓冲区，运行期间必须保持有效 */
+        uint32_t len;     /*!< 缓冲区半字数(至少为2) */
+    } yDevTimCapture_t;
+
+// ==================== yDev定时器配置初始化宏 ====================
+
+/**
+ * @brief yDev定时器配置结构体默认初始化宏
+ */
+#define YDEV_TIM_CONFIG_DEFAULT()                \
+    ((yDevConfig_Tim_t){                         \
+        .base = {.type = YDEV_TYPE_TIM},         \
+        .drv_config = YDRV_TIM_CONFIG_DEFAULT(), \
+    })
+
+/**
+ * @brief yDev定时器句柄结构体默认初始化宏
+ */
+#define YDEV_TIM_HANDLE_DEFAULT()                \
+    ((yDevHandle_Tim_t){                         \
+        .base = YDEV_HANDLE_DEFAULT(),           \
+        .drv_handle = YDRV_TIM_HANDLE_DEFAULT(), \
+        .capture_buf = NULL,                     \
+    })
+
+    // ==================== 定时器设备API ====================
+
+    /**
+     * @brief 初始化定时器配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDevTimConfigStructInit(yDevConfig_Tim_t *config);
+
+    /**
+     * @brief 初始化定时器句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDevTimHandleStructInit(yDevHandle_Tim_t *handle);
+
+    // ==================== 快速访问内联函数 ====================
+
+    /**
+     * @brief 快速设置比较值
+     * @param handle 定时器设备句柄
+     * @param value 比较值(计数值)
+     * @note 绕过yDev框架，PWM模式下在下一个周期生效
+     */
+    YLIB_INLINE void yDevTimSetCompareFast(yDevHandle_Tim_t *handle, uint32_t value)
+    {
+        yDrvTimSetCompare(&handle->drv_handle, value);
+    }
+
+    /**
+     * @brief 快速读取最近一次捕获值
+     * @param handle 定时器设备句柄
+     * @retval uint32_t 捕获值
+     */
+    YLIB_INLINE uint32_t yDevTimGetCaptureFast(yDevHandle_Tim_t *handle)
+    {
+        return yDrvTimGetCapture(&handle->drv_handle);
+    }
+
+/**
+ * @brief 定时器设备IOCTL命令
+ * - YDEV_TIM_START: 启动计数器和通道(arg: NULL)
+ * - YDEV_TIM_STOP: 停止计数器，输出回到无效电平(arg: NULL)
+ * - YDEV_TIM_SET_PERIOD: 设置周期计数值(arg: uint32_t*)
+ * - YDEV_TIM_SET_COMPARE: 设置比较值(arg: uint32_t*)
+ * - YDEV_TIM_SET_PULSE: 设置单脉冲延时和脉宽(arg: yDevTimPulse_t*)
+ * - YDEV_TIM_TRIGGER: 触发一次单脉冲(arg: NULL)
+ * - YDEV_TIM_BURST_START: 启动DMA突发输出(arg: yDevTimBurst_t*)
+ * - YDEV_TIM_CAPTURE_START: 启动DMA捕获(arg: yDevTimCapture_t*)
+ * - YDEV_TIM_DMA_STOP: 停止突发输出或DMA捕获(arg: NULL)
+ * - YDEV_TIM_GET_INTERVAL: 获取最近两次捕获间隔的计数值(arg: uint32_t*)
+ * - YDEV_TIM_GET_FREQ: 由最近两次捕获间隔计算频率，单位0.001Hz(arg: uint32_t*)
+ * - YDEV_TIM_GET_TICK_HZ: 获取实际计数时钟频率(arg: uint32_t*)
+ */
+#define YDEV_TIM_IOCTL_BASE (YDEV_IOCTL_BASE + 0x600)
+#define YDEV_TIM_START (YDEV_TIM_IOCTL_BASE + 0)
+#define YDEV_TIM_STOP (YDEV_TIM_IOCTL_BASE + 1)
+#define YDEV_TIM_SET_PERIOD (YDEV_TIM_IOCTL_BASE + 2)
+#define YDEV_TIM_SET_COMPARE (YDEV_TIM_IOCTL_BASE + 3)
+#define YDEV_TIM_SET_PULSE (YDEV_TIM_IOCTL_BASE + 4)
+#define YDEV_TIM_TRIGGER (YDEV_TIM_IOCTL_BASE + 5)
+#define YDEV_TIM_BURST_START (YDEV_TIM_IOCTL_BASE + 6)
+#define YDEV_TIM_CAPTURE_START (YDEV_TIM_IOCTL_BASE + 7)
+#define YDEV_TIM_DMA_STOP (YDEV_TIM_IOCTL_BASE + 8)
+#define YDEV_TIM_GET_INTERVAL (YDEV_TIM_IOCTL_BASE + 9)
+#define YDEV_TIM_GET_FREQ (YDEV_TIM_IOCTL_BASE + 10)
+#define YDEV_TIM_GET_TICK_HZ (YDEV_TIM_IOCTL_BASE + 11)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_TIM_H */
@@ -41,6 +41,148 @@ extern "C"
         yDrvUsartConfig_t drv_config; /*!< USART底层驱动配置结构体 */
     } yDevConfig_Usart_t;
 
+    /**
+     * @brief yDev USART发送队列配置结构体
+     * @note 用于YDEV_USART_IOCTL_SET_SEND_QUEUE；RS-485配置dePin时DE由硬件随发送自动切换，
+     *       请求整帧写入队列后即可直接等待接收流上的应答；
+     *       已有队列时先等待原队列发完(受base.timeOutMs限制)，再换用新的缓冲区，原缓冲区由调用者释放
+     */
+    typedef struct
+    {
+        yDrvDmaChannel_t channel; /*!< 发送DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配 */
+        uint8_t *buffer;          /*!< 发送环形缓冲区 */
+        uint32_t size;            /*!< 环形缓冲区大小，可用容量为size-1 */
+        uint32_t prio;            /*!< 发送DMA完成中断优先级 */
+        uint8_t block;            /*!< 队列满时等待空间，0=立即返回已写入的字节数 */
+    } yDevUsartTxQueueConfig_t;
+
+    /**
+     * @brief USART共享发送缓冲区释放回调函数类型
+     * @param arg 用户参数
+     * @note 最后一个端口发送完成时调用，可能在DMA完成中断中执行
+     */
+    typedef void (*yDevUsartSharedRelease_t)(void *arg);
+
+    /**
+     * @brief USART共享发送缓冲区
+     * @note 用于yDevUsartWriteShared，多个端口的发送DMA直接读取同一块数据，不拷贝进各自队列；
+     *       每个接收该缓冲区的端口持有一个引用，发送完成后释放，引用归零时调用release
+     */
+    typedef struct
+    {
+        const uint8_t *data;              /*!< 发送数据，释放前保持有效且不可修改 */
+        uint32_t len;                     /*!< 数据长度，1~65535 */
+        volatile uint32_t refs;           /*!< 引用计数，由yDevUsartWriteShared管理 */
+        yDevUsartSharedRelease_t release; /*!< 释放回调，可为NULL */
+        void *arg;                        /*!< 释放回调参数 */
+    } yDevUsartShared_t;
+
+    /**
+     * @brief yDev USART发送队列结构体
+     * @note 写入由任务推进head，DMA完成中断推进tail，单写者无需加锁
+     */
+    typedef struct
+    {
+        uint8_t *buffer;                    /*!< 发送环形缓冲区 */
+        uint32_t size;                      /*!< 环形缓冲区大小 */
+        volatile uint32_t head;             /*!< 写入位置 */
+        volatile uint32_t tail;             /*!< DMA发送位置 */
+        volatile uint32_t chunk;            /*!< 当前DMA传输长度 */
+        volatile uint8_t busy;              /*!< DMA传输进行中 */
+        uint8_t block;                      /*!< 队列满时等待空间 */
+        void *volatile wait_task;           /*!< 等待空间的任务句柄 */
+        volatile uint32_t async;            /*!< 异步写入完成前还须发出的字节数，0表示没有异步写入 */
+        yDevUsartShared_t *volatile shared; /*!< 排队中的共享缓冲区，NULL表示没有 */
+        volatile uint32_t mark;             /*!< 共享缓冲区插入的队列位置，tail到达后发送 */
+        volatile uint8_t ext;               /*!< 当前DMA传输的是共享缓冲区 */
+    } yDevUsartTxQueue_t;
+
+    /**
+     * @brief USART接收数据通知回调函数类型
+     * @param arg 用户参数
+     * @note 在中断中执行，用于唤醒处理任务
+     */
+    typedef void (*yDevUsartRxNotify_t)(void *arg);
+
+    /**
+     * @brief yDev USART接收流配置结构体
+     * @note 用于YDEV_USART_IOCTL_SET_RECEIVE_STREAM；
+     *       已有接收流时停止原通道后换用新的缓冲区，原缓冲区中未读的数据丢弃，
+     *       调用者须保证此时没有读取方持有yDevUsartRxPeek取得的区间；
+     *       drv_config.rxTimeout非0时以接收超时代替空闲中断，notify在帧间隔达到设定位数时调用
+     */
+    typedef struct
+    {
+        yDrvDmaChannel_t channel;   /*!< 接收DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配 */
+        uint8_t *buffer;            /*!< DMA循环接收缓冲区 */
+        uint32_t size;              /*!< 缓冲区大小(不超过65535) */
+        uint32_t prio;              /*!< 空闲(接收超时)中断和DMA半满/全满中断优先级 */
+        yDevUsartRxNotify_t notify; /*!< 收到数据时的通知回调，可为NULL */
+        void *arg;                  /*!< 通知回调参数 */
+    } yDevUsartRxStreamConfig_t;
+
+    /**
+     * @brief yDev USART接收流结构体
+     * @note DMA循环写入缓冲区，读取方直接在缓冲区内解析后提交消费长度；
+     *       空闲、半满、全满中断都推进累计接收计数，两次观测间隔不超过半个缓冲区，
+     *       累计接收与累计消费之差超过缓冲区大小即为溢出
+     */
+    typedef struct
+    {
+        uint8_t *buffer;            /*!< DMA循环接收缓冲区 */
+        uint32_t size;              /*!< 缓冲区大小 */
+        uint32_t read;              /*!< 读取位置 */
+        uint32_t consumed;          /*!< 累计消费字节数 */
+        volatile uint32_t write;    /*!< 中断中记录的DMA写入位置 */
+        volatile uint32_t received; /*!< 中断中记录的累计接收字节数 */
+        uint32_t overruns;          /*!< 累计溢出次数 */
+        uint32_t lost;              /*!< 溢出时丢弃的累计字节数 */
+        yDevUsartRxNotify_t notify; /*!< 收到数据时的通知回调 */
+        void *arg;                  /*!< 通知回调参数 */
+        uint8_t *volatile async;    /*!< 异步读取目标缓冲区，NULL表示没有异步读取 */
+    } yDevUsartRxStream_t;
+
+    /**
+     * @brief USART接收流可读数据区间
+     * @note 数据在缓冲区末尾回绕时分为两段，第二段从缓冲区起始开始
+     */
+    typedef struct
+    {
+        const uint8_t *data[2]; /*!< 两段数据起始地址 */
+        uint32_t len[2];        /*!< 两段数据长度，未使用的段为0 */
+    } yDevUsartRxSpan_t;
+
+    /**
+     * @brief USART端口统计信息
+     * @note 用于YDEV_USART_IOCTL_GET_STATS
+     */
+    typedef struct
+    {
+        uint32_t rx_bytes;      /*!< 累计接收字节数 */
+        uint32_t tx_bytes;      /*!< 累计发送字节数 */
+        uint32_t ore;           /*!< 硬件溢出错误次数 */
+        uint32_t fe;            /*!< 帧错误次数 */
+        uint32_t ne;            /*!< 噪声错误次数 */
+        uint32_t pe;            /*!< 奇偶校验错误次数 */
+        uint32_t overruns;      /*!< 接收流溢出次数(读取方来不及处理) */
+        uint32_t lost;          /*!< 接收流溢出丢弃的字节数 */
+        uint32_t rx_high_water; /*!< 接收流未读数据的历史最大值 */
+        uint32_t rx_size;       /*!< 接收流缓冲区大小，未配置接收流时为0 */
+        uint32_t tx_high_water; /*!< 发送队列未发出数据的历史最大值 */
+        uint32_t tx_size;       /*!< 发送队列缓冲区大小，未配置发送队列时为0 */
+    } yDevUsartStats_t;
+
+    /**
+     * @brief USART自动波特率检测参数
+     * @note 用于YDEV_USART_IOCTL_AUTO_BAUD
+     */
+    typedef struct
+    {
+        yDrvUsartAutoBaud_t mode; /*!< 检测模式，对端须先发送符合模式的字符 */
+        uint32_t timeOutMs;       /*!< 等待测量字符的超时时间，0为一直等待 */
+        uint32_t baudRate;        /*!< 输出：检测到的波特率 */
+    } yDevUsartAutoBaud_t;
+
     /**
      * @brief yDev USART设备句柄结构体
      * @note 包含yDev基础句柄和USART特定的驱动句柄及缓冲区管理信息
@@ -51,6 +193,9 @@ extern "C"
         yDrvUsartHandle_t drv_handle;  /*!< USART底层驱动句柄 */
         yDrvDmaHandle_t rx_dma_handle; /*!< 接收DMA句柄 */
         yDrvDmaHandle_t tx_dma_handle; /*!< 发送DMA句柄 */
+        yDevUsartTxQueue_t tx_queue;   /*!< DMA发送队列，buffer为NULL时写入走轮询 */
+        yDevUsartRxStream_t rx_stream; /*!< DMA接收流，buffer为NULL时读取走轮询 */
+        yDevUsartStats_t stats;        /*!< yDev层维护的计数，错误计数由驱动层累加 */
     } yDevHandle_Usart_t;
 
     // ==================== yDev USART配置初始化宏 ====================
@@ -74,7 +219,9 @@ extern "C"
         .base = YDEV_HANDLE_DEFAULT(),              \
         .drv_handle = YDRV_USART_HANDLE_DEFAULT(),  \
         .rx_dma_handle = YDRV_DMA_HANDLE_DEFAULT(), \
-        .tx_dma_handle = YDRV_DMA_HANDLE_DEFAULT()})
+        .tx_dma_handle = YDRV_DMA_HANDLE_DEFAULT(), \
+        .tx_queue = {.buffer = NULL},               \
+        .rx_stream = {.buffer = NULL}})
 
     // ==================== yDev USART初始化函数 ====================
 
@@ -107,6 +254,49 @@ extern "C"
         return yDrvDmaCurLenGet(&handle->rx_dma_handle);
     }
 
+    // ==================== yDev USART接收流函数 ====================
+
+    /**
+     * @brief 查看接收流中的可读数据
+     * @param handle USART设备句柄指针
+     * @param span 输出的数据区间，最多两段，直接指向接收缓冲区
+     * @retval uint32_t 可读字节总数
+     * @note 不移动读取位置；发生溢出时先丢弃被覆盖的数据，从当前写入位置重新开始
+     */
+    uint32_t yDevUsartRxPeek(yDevHandle_Usart_t *handle, yDevUsartRxSpan_t *span);
+
+    /**
+     * @brief 提交接收流的消费长度
+     * @param handle USART设备句柄指针
+     * @param len 已处理的字节数，超过可读长度时按可读长度处理
+     * @retval 无
+     */
+    void yDevUsartRxConsume(yDevHandle_Usart_t *handle, uint32_t len);
+
+    /**
+     * @brief 从接收流拷贝数据
+     * @param handle USART设备句柄指针
+     * @param buffer 目标缓冲区
+     * @param len 最大拷贝长度
+     * @retval uint32_t 实际拷贝的字节数
+     * @note 最多两次memcpy，拷贝后自动消费
+     */
+    uint32_t yDevUsartRxCopy(yDevHandle_Usart_t *handle, void *buffer, uint32_t len);
+
+    // ==================== yDev USART多端口发送函数 ====================
+
+    /**
+     * @brief 把同一个共享缓冲区排入多个端口的DMA发送队列
+     * @param ports 端口句柄数组，元素可为NULL(跳过)
+     * @param count 端口数量
+     * @param shared 共享缓冲区，refs由本函数初始化
+     * @retval int32_t 接收该缓冲区的端口数，-1表示参数错误
+     * @note 各端口须已配置发送队列；缓冲区排在端口队列已有数据之后，各端口DMA并行发送，
+     *       最后一个端口发完时调用release。每个端口同时只能排一个共享缓冲区，
+     *       上一个未发完时按队列的block设置等待或跳过该端口；没有端口接收时release在返回前调用
+     */
+    int32_t yDevUsartWriteShared(yDevHandle_Usart_t *const *ports, uint32_t count, yDevUsartShared_t *shared);
+
 // ==================== USART设备IOCTL命令定义 ====================
 
 /**
@@ -125,6 +315,17 @@ extern "C"
 #define YDEV_USART_IOCTL_ENABLE_RECEIVE_DMA (YDEV_USART_IOCTL_BASE + 17)  /**< 使能接收DMA */
 #define YDEV_USART_IOCTL_DISABLE_SEND_DMA (YDEV_USART_IOCTL_BASE + 18)    /**< 禁用发送DMA */
 #define YDEV_USART_IOCTL_DISABLE_RECEIVE_DMA (YDEV_USART_IOCTL_BASE + 19) /**< 禁用接收DMA */
+#define YDEV_USART_IOCTL_SET_SEND_QUEUE (YDEV_USART_IOCTL_BASE + 20)      /**< 设置DMA发送队列(arg: yDevUsartTxQueueConfig_t*) */
+#define YDEV_USART_IOCTL_GET_SEND_PENDING (YDEV_USART_IOCTL_BASE + 21)    /**< 读取队列中未发出的字节数(arg: uint32_t*) */
+#define YDEV_USART_IOCTL_SET_RECEIVE_STREAM (YDEV_USART_IOCTL_BASE + 22)  /**< 设置DMA接收流(arg: yDevUsartRxStreamConfig_t*) */
+#define YDEV_USART_IOCTL_GET_RECEIVE_OVERRUNS (YDEV_USART_IOCTL_BASE + 23) /**< 读取接收流累计溢出次数(arg: uint32_t*) */
+#define YDEV_USART_IOCTL_GET_RECEIVE_LOST (YDEV_USART_IOCTL_BASE + 24)     /**< 读取接收流溢出丢弃的累计字节数(arg: uint32_t*) */
+#define YDEV_USART_IOCTL_SET_BAUD (YDEV_USART_IOCTL_BASE + 25)             /**< 运行时修改波特率，不重新初始化(arg: uint32_t*) */
+#define YDEV_USART_IOCTL_GET_BAUD (YDEV_USART_IOCTL_BASE + 26)             /**< 读取当前波特率(arg: uint32_t*) */
+#define YDEV_USART_IOCTL_AUTO_BAUD (YDEV_USART_IOCTL_BASE + 27)            /**< 硬件自动波特率检测，仅USART1/USART2(arg: yDevUsartAutoBaud_t*) */
+#define YDEV_USART_IOCTL_GET_STATS (YDEV_USART_IOCTL_BASE + 28)            /**< 读取端口统计(arg: yDevUsartStats_t*) */
+#define YDEV_USART_IOCTL_RESET_STATS (YDEV_USART_IOCTL_BASE + 29)          /**< 清零端口统计和接收流溢出计数 */
+#define YDEV_USART_IOCTL_WRITE_SHARED (YDEV_USART_IOCTL_BASE + 30)         /**< 排入共享缓冲区，由yDevUsartWriteShared使用(arg: yDevUsartShared_t*) */
 
     // ==================== USART错误代码定义 ====================
 
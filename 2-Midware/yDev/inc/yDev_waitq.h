@@ -0,0 +1,100 @@
+/**
+ * @file yDev_waitq.h
+ * @brief 驱动等待队列头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 代替驱动句柄中单个的等待任务指针，多个任务可以同时等待同一条件；
+ * 等待者记录是挂在yDevWaitQueue_t链表上的侵入式节点，位于等待任务自己的栈上，不需要动态内存
+ *
+ * @par 主要特性:
+ * - 唤醒一个时按到达顺序(FIFO)，唤醒全部时一次摘下所有等待者
+ * - 唤醒可在任务或中断中调用，被唤醒的等待者在临界区内出队并标记，超时与唤醒竞争时以标记为准
+ * - 等待使用任务通知数组的YDEV_WAITQ_NOTIFY_INDEX号条目，不占用默认通知
+ * - 等待者先入队再检查条件，检查和阻塞之间到达的唤醒由通知计数保留，不会丢失
+ *
+ * @par 使用约束:
+ * 等待只能在任务中调用；调度器启动前轮询条件
+ */
+
+#ifndef YDEV_WAITQ_H
+#define YDEV_WAITQ_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDev.h"
+
+// ==================== 等待队列宏定义 ====================
+
+/**
+ * @brief 等待队列静态初始化
+ * @param name 等待队列变量名
+ */
+#define YDEV_WAITQ_INIT(name) {.waiters = YLIB_LIST_HEAD_INIT((name).waiters)}
+
+    // ==================== 等待队列类型定义 ====================
+
+    /**
+     * @brief 等待条件
+     * @param arg yDevWaitqWait传入的参数
+     * @retval 1 条件已满足，0 继续等待
+     * @note 可能在唤醒之前、之后或没有唤醒时被调用，只能读取状态
+     */
+    typedef uint8_t (*yDevWaitCond_t)(void *arg);
+
+    // ==================== 等待队列函数声明 ====================
+
+    /**
+     * @brief 初始化等待队列
+     * @param wq 等待队列指针
+     */
+    void yDevWaitqInit(yDevWaitQueue_t *wq);
+
+    /**
+     * @brief 等待条件满足
+     * @param wq 等待队列指针
+     * @param cond 等待条件，NULL表示等待一次唤醒
+     * @param arg 条件参数
+     * @param timeOutMs 超时时间(毫秒)，0表示一直等待
+     * @retval yDevStatus_t 操作状态
+     *         - YDEV_OK: 条件已满足或已被唤醒
+     *         - YDEV_TIMEOUT: 等待超时
+     *         - YDEV_INVALID_PARAM: 参数错误
+     * @note 被唤醒后重新检查条件，不满足时重新排到队尾；调度器启动前轮询条件，cond为NULL时直接超时
+     */
+    yDevStatus_t yDevWaitqWait(yDevWaitQueue_t *wq, yDevWaitCond_t cond, void *arg, uint32_t timeOutMs);
+
+    /**
+     * @brief 唤醒最早到达的一个等待者
+     * @param wq 等待队列指针
+     * @retval uint32_t 唤醒的等待者数量，0或1
+     * @note 可在中断中调用
+     */
+    uint32_t yDevWaitqWakeOne(yDevWaitQueue_t *wq);
+
+    /**
+     * @brief 唤醒全部等待者
+     * @param wq 等待队列指针
+     * @retval uint32_t 唤醒的等待者数量
+     * @note 可在中断中调用；临界区内逐个摘下，持续时间随等待者数量增长
+     */
+    uint32_t yDevWaitqWakeAll(yDevWaitQueue_t *wq);
+
+    /**
+     * @brief 是否有任务在等待
+     * @param wq 等待队列指针
+     * @retval 1 有等待者，0 队列为空
+     */
+    uint8_t yDevWaitqActive(yDevWaitQueue_t *wq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDEV_WAITQ_H */
@@ -20,260 +20,2659 @@
 #include <stdlib.h>
 #include "yDev.h"
 #include "yLib_def.h"
+#include "yLib_trace.h"
+#include "yLib_log.h"
+#include "yLib_bench.h"
+#include "yLib_probe.h"
+#include "yLib_coro.h"
+#include "yLib_pbuf.h"
 #include "yDrv_basic.h"
+#include "yDrv_crc.h"
+#include "yDrv_dma.h"
+#include "yDrv_clock.h"
 #include "yDev_def.h"
+#include "yDev_waitq.h"
 
-// ==================== 设备操作表边界标记 ====================
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "os_static.h"
+
+// ==================== 句柄锁宏 ====================
+
+/**
+ * @brief 句柄加锁/解锁
+ * @note 关闭YDEV_USE_MUTEX时展开为常量，读写路径没有额外开销
+ */
+#if YDEV_USE_MUTEX
+#define YDEV_LOCK(_handle) yDev_Lock(_handle)
+#define YDEV_UNLOCK(_handle, _locked) yDev_Unlock((_handle), (_locked))
+#else
+#define YDEV_LOCK(_handle) (0U)
+#define YDEV_UNLOCK(_handle, _locked) ((void)(_locked))
+#endif
+
+// ==================== 操作统计宏 ====================
+
+/**
+ * @brief 操作计时起点和统计记录
+ * @note 关闭YDEV_STATS_ENABLE时不读取时间戳，分发路径与未统计时相同；
+ *       同时写入跟踪记录，开始事件的参数为句柄地址|操作类型(句柄4字节对齐，低2位空闲)
+ */
+#define YDEV_TRACE_BEGIN(_handle, _op) YLIB_TRACE(YLIB_TRACE_EV_DEV_BEGIN, (uint32_t)(uintptr_t)(_handle) | (uint32_t)(_op))
+#define YDEV_TRACE_END(_ret) YLIB_TRACE(YLIB_TRACE_EV_DEV_END, (_ret))
+#if YDEV_STATS_ENABLE
+#define YDEV_STATS_BEGIN(_handle, _op) (YDEV_TRACE_BEGIN(_handle, _op), yDevGetTimeUS())
+#define YDEV_STATS_END(_handle, _op, _start, _ret) \
+    (YDEV_TRACE_END(_ret), yDev_StatsRecord((_handle), (_op), (_start), (_ret)))
+#else
+#define YDEV_STATS_BEGIN(_handle, _op) (YDEV_TRACE_BEGIN(_handle, _op), 0U)
+#define YDEV_STATS_END(_handle, _op, _start, _ret) (YDEV_TRACE_END(_ret), (void)(_start))
+#endif
+
+// ==================== 设备操作表 ====================
+
+/**
+ * @brief 各类型驱动导出的操作表
+ * @note 弱引用，驱动未链接时地址为NULL；符号名由YDEV_OPS_EXPORT_xxx按类型生成
+ */
+extern const yDevOps_t ydev_YDEV_TYPE_GPIO_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_USART_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_SPI_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_25Q_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_25Q_FTL_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_SPI_SLAVE_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_GPIO_PORT_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_TIM_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_ADC_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_IIC_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_DMA_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_IFLASH_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_FILE_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_25Q_ARRAY_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_PBUS_ops YLIB_WEAK;
+extern const yDevOps_t ydev_YDEV_TYPE_KEYPAD_ops YLIB_WEAK;
+
+/**
+ * @brief 未初始化句柄的操作表
+ * @note 句柄的index默认为0，指向该表时各入口为空，类型为YDEV_TYPE_MAX
+ */
+static const yDevOps_t ydev_none_ops =
+    {
+        .type = YDEV_TYPE_MAX,
+};
+
+/**
+ * @brief 按设备类型索引的操作表
+ * @note 句柄的index即设备类型，查找不需要遍历，也不随链接顺序变化；
+ *       新增设备类型时在此补充一项
+ */
+static const yDevOps_t *const ydev_ops_table[YDEV_TYPE_MAX] = {
+    [YDEV_TYPE_START] = &ydev_none_ops,
+    [YDEV_TYPE_GPIO] = &ydev_YDEV_TYPE_GPIO_ops,
+    [YDEV_TYPE_USART] = &ydev_YDEV_TYPE_USART_ops,
+    [YDEV_TYPE_SPI] = &ydev_YDEV_TYPE_SPI_ops,
+    [YDEV_TYPE_25Q] = &ydev_YDEV_TYPE_25Q_ops,
+    [YDEV_TYPE_25Q_FTL] = &ydev_YDEV_TYPE_25Q_FTL_ops,
+    [YDEV_TYPE_SPI_SLAVE] = &ydev_YDEV_TYPE_SPI_SLAVE_ops,
+    [YDEV_TYPE_GPIO_PORT] = &ydev_YDEV_TYPE_GPIO_PORT_ops,
+    [YDEV_TYPE_TIM] = &ydev_YDEV_TYPE_TIM_ops,
+    [YDEV_TYPE_ADC] = &ydev_YDEV_TYPE_ADC_ops,
+    [YDEV_TYPE_IIC] = &ydev_YDEV_TYPE_IIC_ops,
+    [YDEV_TYPE_DMA] = &ydev_YDEV_TYPE_DMA_ops,
+    [YDEV_TYPE_IFLASH] = &ydev_YDEV_TYPE_IFLASH_ops,
+    [YDEV_TYPE_FILE] = &ydev_YDEV_TYPE_FILE_ops,
+    [YDEV_TYPE_25Q_ARRAY] = &ydev_YDEV_TYPE_25Q_ARRAY_ops,
+    [YDEV_TYPE_PBUS] = &ydev_YDEV_TYPE_PBUS_ops,
+    [YDEV_TYPE_KEYPAD] = &ydev_YDEV_TYPE_KEYPAD_ops,
+};
+
+// ==================== 分级初始化表 ====================
+
+/**
+ * @brief 初始化表起止地址
+ * @note 链接脚本把.ydev_init.<级别>段按名称排序后在前后定义这两个符号；
+ *       不用两个标记对象，链接时优化会把不同对象之间的地址比较当作恒定结果
+ */
+extern const yDevInitEntry_t __ydev_init_start[];
+extern const yDevInitEntry_t __ydev_init_end[];
+
+/**
+ * @brief 各初始化函数的耗时(微秒)和返回值，按表项序号
+ */
+static uint32_t ydev_init_us[YDEV_INIT_MAX];
+static int32_t ydev_init_ret[YDEV_INIT_MAX];
+
+/**
+ * @brief 各级别完成的时间(微秒)
+ */
+static uint32_t ydev_init_done[YDEV_INIT_LEVEL_MAX];
+
+// ==================== 设备注册表 ====================
+
+/**
+ * @brief 设备注册表条目
+ */
+typedef struct
+{
+    const char *name;     /*!< 设备名 */
+    yDevHandle_t *handle; /*!< 设备句柄 */
+} yDevRegEntry_t;
+
+/**
+ * @brief 设备注册表，按名称字典序排列
+ */
+static yDevRegEntry_t ydev_registry[YDEV_REGISTRY_MAX];
+
+/**
+ * @brief 已注册的设备数量
+ */
+static uint32_t ydev_registry_count = 0;
+
+// ==================== 系统时钟请求 ====================
+
+/**
+ * @brief 各时钟等级的请求计数
+ */
+static uint16_t ydev_clock_count[YDRV_CLOCK_LEVEL_MAX];
+
+/**
+ * @brief 没有请求时的时钟等级
+ */
+static uint32_t ydev_clock_idle = YDEV_CLOCK_IDLE_LEVEL;
+
+#if YDEV_PM_ACCOUNT && (configUSE_TICKLESS_IDLE == 1)
+/**
+ * @brief CPU睡眠统计，由无滴答空闲在关中断时更新
+ */
+static yDevPmCpuStats_t ydev_pm_cpu;
+#endif
+
+#if YDEV_USE_MUTEX
+/**
+ * @brief 句柄互斥锁，按句柄占用槽位
+ */
+OS_MUTEX_POOL_DEFINE(ydev_mutex, YDEV_MUTEX_MAX);
+#endif
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 占用异步传输状态并启动驱动
+ * @param handle 设备句柄指针
+ * @param dir 传输方向
+ * @param buffer 数据缓冲区
+ * @param size 传输大小
+ * @param callback 完成回调
+ * @param arg 回调参数
+ * @retval yDevStatus_t 启动状态
+ * @note 先在临界区内检查并置位进行中标志，驱动启动失败时撤销
+ */
+static yDevStatus_t yDev_AsyncStart(yDevHandle_t *handle, yDevAsyncDir_t dir, const void *buffer, size_t size,
+                                    yDevAsyncCallback_t callback, void *arg);
+
+/**
+ * @brief 逐段执行向量读写
+ * @param handle 设备句柄指针
+ * @param dev_ops 设备操作表
+ * @param iov 分段描述符数组
+ * @param count 分段数量
+ * @param flag_write 非0表示写入
+ * @retval int32_t 实际传输的总字节数，第一段即失败时返回该段的错误码
+ * @note 驱动未提供向量读写入口时使用，某段传输不足时停止
+ */
+static int32_t yDev_IovLoop(void *handle, const yDevOps_t *dev_ops, const yDevIoVec_t *iov,
+                            uint32_t count, uint8_t flag_write);
+
+/**
+ * @brief 计算向量读写总长度
+ * @param iov 分段描述符数组
+ * @param count 分段数量
+ * @retval int32_t 总字节数，超出返回值范围或分段无效时返回-1
+ */
+static int32_t yDev_IovTotal(const yDevIoVec_t *iov, uint32_t count);
+
+/**
+ * @brief 唤醒等待中的任务
+ * @param task 任务句柄，NULL时不操作
+ * @retval 无
+ * @note 中断中调用时用FromISR接口并在退出中断时切换
+ */
+static void yDev_NotifyTask(void *task);
+
+/**
+ * @brief yDevWait的等待条件
+ * @param arg 设备句柄
+ * @retval 1 两个方向都没有进行中的异步传输
+ */
+static uint8_t yDev_AsyncIdle(void *arg);
+
+/**
+ * @brief 扫描一组设备的就绪事件
+ * @param handles 设备句柄数组
+ * @param events 关注的事件数组
+ * @param revents 输出的就绪事件数组
+ * @param n 设备数量
+ * @retval uint32_t 就绪的设备数量
+ * @note 合并驱动登记的事件和YDEV_IOCTL_POLL查询到的当前状态，报告后清除登记
+ */
+static uint32_t yDev_PollScan(void *const handles[], const uint32_t events[], uint32_t revents[], uint32_t n);
+
+/**
+ * @brief 在注册表中二分查找名称
+ * @param name 设备名
+ * @param found 输出是否找到
+ * @retval uint32_t 找到时为条目序号，否则为按序插入的位置
+ * @note 调用者须在临界区内调用
+ */
+static uint32_t yDev_RegistrySearch(const char *name, uint8_t *found);
+
+/**
+ * @brief 登记一个进行中的操作
+ * @param handle 设备句柄指针
+ * @param dev_ops 设备操作表
+ * @retval yDevStatus_t YDEV_OK表示设备可用，挂起的设备在这里恢复
+ * @note 中断中遇到挂起的设备不恢复，返回YDEV_BUSY；失败时不登记
+ */
+static yDevStatus_t yDev_PmGet(yDevHandle_t *handle, const yDevOps_t *dev_ops);
+
+/**
+ * @brief 结束一个进行中的操作
+ * @param handle 设备句柄指针
+ * @retval 无
+ * @note 最后一个操作结束时记录空闲起点，可在中断中调用
+ */
+static void yDev_PmPut(yDevHandle_t *handle);
+
+/**
+ * @brief 挂起空闲的设备
+ * @param handle 设备句柄指针
+ * @param dev_ops 设备操作表
+ * @param idle_ms 要求的最短空闲时间(毫秒)，0表示不检查
+ * @retval yDevStatus_t 挂起状态
+ * @note 持句柄锁检查空闲并调用驱动挂起入口
+ */
+static yDevStatus_t yDev_PmSuspend(yDevHandle_t *handle, const yDevOps_t *dev_ops, uint32_t idle_ms);
+
+/**
+ * @brief 按请求计数切换系统时钟
+ * @retval yDevStatus_t 切换状态，被驱动否决时返回YDEV_BUSY
+ * @note 调用者挂起调度器，请求计数和切换不被其他任务打断
+ */
+static yDevStatus_t yDev_ClockUpdate(void);
+
+/**
+ * @brief 查找驱动、填写句柄并登记名称
+ * @param dev_config 配置参数
+ * @param dev_handle 设备句柄
+ * @param ops 输出驱动操作表
+ * @retval yDevStatus_t 准备状态，失败时已撤销登记
+ */
+static yDevStatus_t yDev_InitPrepare(yDevConfig_t *dev_config, yDevHandle_t *dev_handle, const yDevOps_t **ops);
+
+/**
+ * @brief 撤销yDev_InitPrepare的登记和互斥锁
+ * @param dev_handle 设备句柄
+ * @retval 无
+ */
+static void yDev_InitUndo(yDevHandle_t *dev_handle);
+
+/**
+ * @brief 已打开的设备增加一次引用
+ * @param dev_handle 设备句柄
+ * @retval 1 已引用，0 设备未打开或正在反初始化
+ */
+static uint8_t yDev_Attach(yDevHandle_t *dev_handle);
+
+/**
+ * @brief 同名设备已由同一句柄打开时增加一次引用
+ * @param dev_config 配置参数
+ * @param dev_handle 设备句柄
+ * @retval 1 已引用，无需初始化，0 需要初始化
+ */
+static uint8_t yDev_AttachNamed(const yDevConfig_t *dev_config, yDevHandle_t *dev_handle);
+
+#if YDEV_STATS_ENABLE
+/**
+ * @brief 记录一次操作的统计
+ * @param handle 设备句柄指针
+ * @param op 操作类别
+ * @param start 计时起点(微秒)
+ * @param ret 操作结果，非负为传输字节数，负数为错误
+ * @retval 无
+ * @note 临界区内更新，未加锁的句柄被多个任务同时访问时计数也不会丢失
+ */
+static void yDev_StatsRecord(yDevHandle_t *handle, yDevStatOp_t op, uint32_t start, int32_t ret);
+
+/**
+ * @brief 清零统计数组
+ * @param stats 统计数组
+ * @retval 无
+ */
+static void yDev_StatsClear(yDevOpStats_t *stats);
+#endif
+
+#if YDEV_PM_ACCOUNT
+/**
+ * @brief 计入唤醒时间并更新起点
+ * @param handle 设备句柄指针
+ * @param awake 1=起点到现在处于唤醒，计入累计值；0=只更新起点，用于唤醒开始
+ * @retval 无
+ * @note 调用者须在临界区内、改变状态之前调用
+ */
+static void yDev_PmAccount(yDevHandle_t *handle, uint8_t awake);
+#endif
+
+#if YDEV_USE_MUTEX
+/**
+ * @brief 获取句柄互斥锁
+ * @param handle 设备句柄指针
+ * @retval uint8_t 1=已加锁, 0=未加锁
+ * @note 没有锁、在中断中或调度器未运行时不加锁，直接返回0
+ */
+static uint8_t yDev_Lock(yDevHandle_t *handle);
+
+/**
+ * @brief 释放句柄互斥锁
+ * @param handle 设备句柄指针
+ * @param locked yDev_Lock的返回值
+ * @retval 无
+ */
+static void yDev_Unlock(yDevHandle_t *handle, uint8_t locked);
+#endif
+
+// ==================== 私有函数实现 ====================
+
+#if YDEV_USE_MUTEX
+/**
+ * @brief 获取句柄互斥锁实现
+ */
+static uint8_t yDev_Lock(yDevHandle_t *handle)
+{
+    if ((handle->mutex == NULL) || (__get_IPSR() != 0U) ||
+        (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+    {
+        return 0;
+    }
+
+    (void)xSemaphoreTakeRecursive((SemaphoreHandle_t)handle->mutex, portMAX_DELAY);
+    return 1;
+}
+
+/**
+ * @brief 释放句柄互斥锁实现
+ */
+static void yDev_Unlock(yDevHandle_t *handle, uint8_t locked)
+{
+    if (locked != 0)
+    {
+        (void)xSemaphoreGiveRecursive((SemaphoreHandle_t)handle->mutex);
+    }
+}
+#endif
+
+#if YDEV_STATS_ENABLE
+/**
+ * @brief 记录操作统计实现
+ */
+static void yDev_StatsRecord(yDevHandle_t *handle, yDevStatOp_t op, uint32_t start, int32_t ret)
+{
+    yDevOpStats_t *stats;
+    uint32_t elapsed;
+    uint32_t primask;
+
+    elapsed = yDevGetTimeUS() - start;
+    stats = &handle->op_stats[op];
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    stats->count++;
+    if (ret < 0)
+    {
+        stats->errors++;
+    }
+    else
+    {
+        stats->bytes += (uint32_t)ret;
+    }
+    if (elapsed < stats->min_us)
+    {
+        stats->min_us = elapsed;
+    }
+    if (elapsed > stats->max_us)
+    {
+        stats->max_us = elapsed;
+    }
+    stats->total_us += elapsed;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 清零统计数组实现
+ */
+static void yDev_StatsClear(yDevOpStats_t *stats)
+{
+    uint32_t op;
+
+    memset(stats, 0, sizeof(yDevOpStats_t) * YDEV_STAT_MAX);
+    for (op = 0; op < YDEV_STAT_MAX; op++)
+    {
+        stats[op].min_us = 0xFFFFFFFFUL;
+    }
+}
+#endif
+
+#if YDEV_PM_ACCOUNT
+/**
+ * @brief 计入唤醒时间实现
+ */
+static void yDev_PmAccount(yDevHandle_t *handle, uint8_t awake)
+{
+    uint32_t now;
+
+    now = yDevGetTimeUS();
+    if (awake != 0)
+    {
+        handle->pm_usage.awake_us += now - handle->pm_usage.since_us;
+    }
+    handle->pm_usage.since_us = now;
+}
+#endif
+
+/**
+ * @brief 登记进行中的操作实现
+ */
+static yDevStatus_t yDev_PmGet(yDevHandle_t *handle, const yDevOps_t *dev_ops)
+{
+    yDevStatus_t status;
+    yDevState_t state;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    handle->active++;
+    state = handle->state;
+    if ((state != YDEV_STATE_SUSPENDED) && (state != YDEV_STATE_ERROR) && (state != YDEV_STATE_DEFERRED))
+    {
+        handle->state = YDEV_STATE_BUSY;
+    }
+    __set_PRIMASK(primask);
+
+    if ((state != YDEV_STATE_SUSPENDED) && (state != YDEV_STATE_ERROR) && (state != YDEV_STATE_DEFERRED))
+    {
+        return YDEV_OK;
+    }
+
+    // 挂起、上次恢复失败或尚未初始化：恢复和初始化可能访问总线，不能在中断中进行
+    if (__get_IPSR() != 0U)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        handle->active--;
+        __set_PRIMASK(primask);
+        return YDEV_BUSY;
+    }
+
+    if (state == YDEV_STATE_DEFERRED)
+    {
+        status = dev_ops->init(handle->config, handle);
+    }
+    else
+    {
+        status = (dev_ops->resume != NULL) ? dev_ops->resume(handle) : YDEV_OK;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (status == YDEV_OK)
+    {
+#if YDEV_PM_ACCOUNT
+        yDev_PmAccount(handle, 0);
+        handle->pm_usage.wakes++;
+#endif
+        handle->state = YDEV_STATE_BUSY;
+    }
+    else
+    {
+        handle->active--;
+        // 下一次操作重试恢复，初始化失败的保持延迟状态重试初始化
+        handle->state = (state == YDEV_STATE_DEFERRED) ? YDEV_STATE_DEFERRED : YDEV_STATE_ERROR;
+    }
+    __set_PRIMASK(primask);
+
+    return status;
+}
+
+/**
+ * @brief 结束进行中的操作实现
+ */
+static void yDev_PmPut(yDevHandle_t *handle)
+{
+    uint32_t now;
+    uint32_t primask;
+
+    now = (uint32_t)yDevGetTimeMS();
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (handle->active != 0)
+    {
+        handle->active--;
+    }
+    if ((handle->active == 0) && (handle->state == YDEV_STATE_BUSY))
+    {
+        handle->state = YDEV_STATE_OPENED;
+    }
+    handle->last_ms = now;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 挂起空闲设备实现
+ */
+static yDevStatus_t yDev_PmSuspend(yDevHandle_t *handle, const yDevOps_t *dev_ops, uint32_t idle_ms)
+{
+    yDevStatus_t status;
+    uint32_t primask;
+    uint32_t now;
+    uint8_t flag_suspend;
+    uint8_t locked;
+
+    // 持锁期间其他任务的读写停在加锁处，不会撞上挂起中的设备
+    locked = YDEV_LOCK(handle);
+    now = (uint32_t)yDevGetTimeMS();
+    flag_suspend = 0;
+    status = YDEV_OK;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if ((handle->active != 0) || (handle->state == YDEV_STATE_BUSY) ||
+        ((idle_ms != 0) && ((now - handle->last_ms) < idle_ms)))
+    {
+        status = YDEV_BUSY;
+    }
+    else if (handle->state == YDEV_STATE_OPENED)
+    {
+        handle->state = YDEV_STATE_SUSPENDED;
+        flag_suspend = 1;
+    }
+    else if (handle->state != YDEV_STATE_SUSPENDED)
+    {
+        status = (handle->state == YDEV_STATE_ERROR) ? YDEV_ERROR : YDEV_NOT_INITIALIZED;
+    }
+    __set_PRIMASK(primask);
+
+    if (flag_suspend != 0)
+    {
+        status = dev_ops->suspend(handle);
+        if (status != YDEV_OK)
+        {
+            handle->state = YDEV_STATE_OPENED;
+        }
+#if YDEV_PM_ACCOUNT
+        else
+        {
+            // 驱动挂起入口的执行时间计为唤醒
+            primask = __get_PRIMASK();
+            __disable_irq();
+            yDev_PmAccount(handle, 1);
+            __set_PRIMASK(primask);
+        }
+#endif
+    }
+    YDEV_UNLOCK(handle, locked);
+
+    return status;
+}
+
+/**
+ * @brief 占用异步传输状态并启动驱动实现
+ */
+static yDevStatus_t yDev_AsyncStart(yDevHandle_t *handle, yDevAsyncDir_t dir, const void *buffer, size_t size,
+                                    yDevAsyncCallback_t callback, void *arg)
+{
+    const yDevOps_t *dev_ops;
+    yDevAsync_t *async;
+    yDevStatus_t status;
+    uint32_t primask;
+    uint8_t locked;
+
+    // 参数有效性检查，长度须能由int32_t返回值表示
+    if ((handle == NULL) || (buffer == NULL) || (size == 0) || (size > (size_t)INT32_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    dev_ops = ydev_ops_table[handle->index]; // 直接定位到对应的操作表
+    if (((dir == YDEV_ASYNC_READ) && (dev_ops->read_async == NULL)) ||
+        ((dir == YDEV_ASYNC_WRITE) && (dev_ops->write_async == NULL)))
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    // 1. 占用该方向，完成回调中重新启动时也经过这里
+    async = &handle->async[dir];
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (async->pending != 0)
+    {
+        __set_PRIMASK(primask);
+        return YDEV_BUSY;
+    }
+    async->pending = 1;
+    __set_PRIMASK(primask);
+
+    async->callback = callback;
+    async->arg = arg;
+    async->size = (uint32_t)size;
+    async->len = 0;
+    async->status = YDEV_BUSY;
+
+    // 2. 启动驱动，驱动可能在返回前就已调用yDevAsyncComplete；
+    //    传输结束前设备计为活动，由yDevAsyncComplete释放
+    locked = YDEV_LOCK(handle);
+    status = yDev_PmGet(handle, dev_ops);
+    if (status == YDEV_OK)
+    {
+        if (dir == YDEV_ASYNC_READ)
+        {
+            status = dev_ops->read_async(handle, (void *)buffer, size);
+        }
+        else
+        {
+            status = dev_ops->write_async(handle, buffer, size);
+        }
+        if (status != YDEV_OK)
+        {
+            yDev_PmPut(handle);
+        }
+    }
+    YDEV_UNLOCK(handle, locked);
+
+    if (status != YDEV_OK)
+    {
+        async->status = status;
+        async->pending = 0;
+    }
+
+    return status;
+}
+
+// ==================== 核心API实现 ====================
+
+/**
+ * @brief yLab系统初始化
+ * @retval yDevStatus_t 初始化状态
+ * @retval YDEV_OK 初始化成功
+ * @note 初始化yLab系统，包括底层yDrv驱动初始化和TIM17系统时基，
+ *       并把硬件CRC单元注册为ylib_crc32/ylib_crc16的后端
+ */
+yDevStatus_t yLabInit(void)
+{
+    // 初始化底层驱动
+    yDrvInit();
+
+    // 硬件CRC后端
+    yDrvCrcRegisterYlib();
+
+#if (configUSE_TICKLESS_IDLE == 1)
+    // 无滴答空闲的STOP唤醒源
+    yDrvStopInit();
+#endif
+
+#if YLIB_TRACE_ENABLE
+    // 跟踪记录时间戳
+    ylib_trace_register_clock(yDrvGetTimeUs, 1000000U);
+#endif
+
+#if YLIB_LOG_ENABLE
+    // 日志时间戳
+    ylib_log_register_clock(yDrvGetTimeUs, 1000000U);
+#endif
+
+    // 微基准测试的周期计数
+    ylib_bench_register_clock(yDrvCycleNow, yDrvCycleSince);
+
+#if YLIB_PROBE_ENABLE
+    // 耗时探针的微秒时钟
+    ylib_probe_register_clock(yDrvGetTimeUs);
+#endif
+
+    (void)yDevInitRun(YDEV_INIT_BOARD);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 执行一个级别的初始化函数
+ * @param level 初始化级别
+ * @return uint32_t 失败的函数数
+ *
+ * @par 功能描述:
+ * 表按级别排序，遍历到更高级别时停止；超出YDEV_INIT_MAX的表项照常执行，只是不记录耗时
+ */
+uint32_t yDevInitRun(uint32_t level)
+{
+    const yDevInitEntry_t *entry;
+    uint32_t failed = 0;
+    uint32_t index;
+    uint32_t start;
+    int32_t ret;
+
+    if (level >= YDEV_INIT_LEVEL_MAX)
+    {
+        return 0;
+    }
+
+    for (entry = __ydev_init_start, index = 0; (entry < __ydev_init_end) && (entry->level <= level);
+         entry++, index++)
+    {
+        if (entry->level != level)
+        {
+            continue;
+        }
+
+        start = yDevGetTimeUS();
+        ret = entry->init();
+        if (index < YDEV_INIT_MAX)
+        {
+            ydev_init_us[index] = yDevGetTimeUS() - start;
+            ydev_init_ret[index] = ret;
+        }
+        if (ret < 0)
+        {
+            failed++;
+        }
+    }
+    ydev_init_done[level] = yDevGetTimeUS();
+
+    return failed;
+}
+
+/**
+ * @brief 遍历初始化表
+ * @param index 表项序号
+ * @param us 输出耗时
+ * @param ret 输出返回值
+ * @return const yDevInitEntry_t* 表项，超出范围时返回NULL
+ */
+const yDevInitEntry_t *yDevInitIterate(uint32_t index, uint32_t *us, int32_t *ret)
+{
+    const yDevInitEntry_t *entry = __ydev_init_start + index;
+
+    if (entry >= __ydev_init_end)
+    {
+        return NULL;
+    }
+    if (us != NULL)
+    {
+        *us = (index < YDEV_INIT_MAX) ? ydev_init_us[index] : 0;
+    }
+    if (ret != NULL)
+    {
+        *ret = (index < YDEV_INIT_MAX) ? ydev_init_ret[index] : 0;
+    }
+    return entry;
+}
+
+/**
+ * @brief 获取级别完成的时间
+ * @param level 初始化级别
+ * @return uint32_t 完成时的微秒时间戳，尚未完成时为0
+ */
+uint32_t yDevInitDoneUs(uint32_t level)
+{
+    return (level < YDEV_INIT_LEVEL_MAX) ? ydev_init_done[level] : 0;
+}
+
+/**
+ * @brief 静态初始化设备
+ * @param config 设备配置参数指针
+ * @param handle 设备句柄指针
+ * @retval yDevStatus_t 初始化状态
+ * @retval YDEV_OK 初始化成功
+ * @retval YDEV_INVALID_PARAM 参数无效
+ * @retval YDEV_NOT_SUPPORTED 设备类型不支持
+ * @note 根据配置参数初始化指定类型的设备，查找对应的设备操作表并调用初始化函数；
+ *       配置了name且该名称已由同一句柄打开时只增加引用计数，不再初始化硬件
+ */
+yDevStatus_t yDevInitStatic(void *config, void *handle)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    yDevStatus_t status;
+
+    // 参数有效性检查
+    if ((config == NULL) || (handle == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    if (yDev_AttachNamed((const yDevConfig_t *)config, dev_handle) != 0)
+    {
+        return YDEV_OK;
+    }
+    status = yDev_InitPrepare((yDevConfig_t *)config, dev_handle, &dev_ops);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+
+    status = dev_ops->init(config, handle);
+    if (status == YDEV_OK)
+    {
+#if YDEV_PM_ACCOUNT
+        yDev_PmAccount(dev_handle, 0);
+#endif
+        dev_handle->state = YDEV_STATE_OPENED;
+    }
+    else
+    {
+        dev_handle->state = YDEV_STATE_UNINITIALIZED;
+        yDev_InitUndo(dev_handle);
+    }
+    return status;
+}
+
+/**
+ * @brief 登记设备，推迟到首次访问时初始化
+ * @param config 配置参数
+ * @param handle 设备句柄
+ * @return yDevStatus_t 登记状态
+ *
+ * @par 功能描述:
+ * 与yDevInitStatic相同地查找驱动、登记名称和创建互斥锁，只是不调用驱动初始化；
+ * 启动时慢速器件(如需要探测和校准的外部Flash)不占用启动路径
+ */
+yDevStatus_t yDevInitLazy(void *config, void *handle)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    yDevStatus_t status;
+
+    if ((config == NULL) || (handle == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    if (yDev_AttachNamed((const yDevConfig_t *)config, dev_handle) != 0)
+    {
+        return YDEV_OK;
+    }
+    status = yDev_InitPrepare((yDevConfig_t *)config, dev_handle, &dev_ops);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+
+    dev_handle->config = config;
+    dev_handle->state = YDEV_STATE_DEFERRED;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 完成延迟的初始化
+ * @param handle 设备句柄
+ * @return yDevStatus_t 初始化状态
+ */
+yDevStatus_t yDevProbe(void *handle)
+{
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    if (((yDevHandle_t *)handle)->state != YDEV_STATE_DEFERRED)
+    {
+        return YDEV_OK;
+    }
+
+    // 与一次空操作相同，登记时初始化
+    return yDevResume(handle);
+}
+
+/**
+ * @brief 按名称打开已登记的设备
+ * @param name 设备名
+ * @return void* 设备句柄，未登记或正在关闭时返回NULL
+ *
+ * @par 功能描述:
+ * 只增加引用计数，不访问硬件；延迟初始化的设备仍在首次访问时初始化
+ */
+void *yDevOpen(const char *name)
+{
+    yDevHandle_t *dev_handle;
+
+    dev_handle = (yDevHandle_t *)yDevFind(name);
+    if ((dev_handle == NULL) || (yDev_Attach(dev_handle) == 0))
+    {
+        return NULL;
+    }
+
+    return dev_handle;
+}
+
+/**
+ * @brief 已打开的设备增加一次引用实现
+ * @note 计数归零后到反初始化完成之间拒绝引用，关闭中的设备不会被重新打开
+ */
+static uint8_t yDev_Attach(yDevHandle_t *dev_handle)
+{
+    uint32_t primask;
+    uint8_t ok = 0;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if ((dev_handle->refs != 0) && (dev_handle->state != YDEV_STATE_UNINITIALIZED))
+    {
+        dev_handle->refs++;
+        ok = 1;
+    }
+    __set_PRIMASK(primask);
+
+    return ok;
+}
+
+/**
+ * @brief 同名设备已由同一句柄打开时增加一次引用实现
+ * @note 只认注册表中的句柄，未登记的句柄内容可能是未初始化的栈数据
+ */
+static uint8_t yDev_AttachNamed(const yDevConfig_t *dev_config, yDevHandle_t *dev_handle)
+{
+    if ((dev_config->name == NULL) || (yDevFind(dev_config->name) != dev_handle))
+    {
+        return 0;
+    }
+
+    return yDev_Attach(dev_handle);
+}
+
+/**
+ * @brief 查找驱动、填写句柄并登记名称实现
+ */
+static yDevStatus_t yDev_InitPrepare(yDevConfig_t *dev_config, yDevHandle_t *dev_handle, const yDevOps_t **ops)
+{
+    const yDevOps_t *dev_ops;
+    yDevStatus_t status;
+#if YDEV_USE_MUTEX
+    int32_t slot;
+#endif
+
+    // 按类型直接定位操作表
+    if ((uint32_t)dev_config->type >= YDEV_TYPE_MAX)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    dev_ops = ydev_ops_table[dev_config->type];
+    if (dev_ops == NULL)
+    {
+        dev_handle->errno = YDEV_ERRNO_NOT_FOUND;
+        return YDEV_ERROR; // 该类型的驱动未链接
+    }
+
+    dev_handle->index = (uint32_t)dev_config->type;
+    dev_handle->timeOutMs = 10;
+    dev_handle->errno = YDEV_ERRNO_NO_ERROR;
+    memset(dev_handle->async, 0, sizeof(dev_handle->async));
+    yDevWaitqInit(&dev_handle->waitq);
+    dev_handle->revents = 0;
+    dev_handle->poll_task = NULL;
+    dev_handle->state = YDEV_STATE_INITIALIZED;
+    dev_handle->active = 0;
+    dev_handle->idle_ms = dev_config->idle_ms;
+    dev_handle->last_ms = (uint32_t)yDevGetTimeMS();
+    dev_handle->config = NULL;
+    dev_handle->refs = 1;
+#if YDEV_STATS_ENABLE
+    yDev_StatsClear(dev_handle->op_stats);
+#endif
+#if YDEV_PM_ACCOUNT
+    memset(&dev_handle->pm_usage, 0, sizeof(dev_handle->pm_usage));
+#endif
+    if (dev_ops->init == NULL)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    // 先占用名称，重名或注册表满时不初始化硬件
+    if (dev_config->name != NULL)
+    {
+        status = yDevRegister(dev_config->name, dev_handle);
+        if (status != YDEV_OK)
+        {
+            return status;
+        }
+    }
+#if YDEV_USE_MUTEX
+    // 递归锁：驱动在操作中经yDev接口访问自身时不会死锁
+    dev_handle->mutex = NULL;
+    if (dev_config->use_mutex != 0)
+    {
+        slot = OS_POOL_CLAIM(ydev_mutex, dev_handle);
+        if (slot < 0)
+        {
+            yDevUnregister(dev_handle);
+            return YDEV_NO_MEMORY;
+        }
+        dev_handle->mutex = (void *)OS_RECURSIVE_MUTEX_POOL_CREATE(ydev_mutex, slot);
+    }
+#endif
+    *ops = dev_ops;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 撤销登记和互斥锁实现
+ */
+static void yDev_InitUndo(yDevHandle_t *dev_handle)
+{
+    dev_handle->refs = 0;
+#if YDEV_USE_MUTEX
+    if (dev_handle->mutex != NULL)
+    {
+        vSemaphoreDelete((SemaphoreHandle_t)dev_handle->mutex);
+        dev_handle->mutex = NULL;
+        OS_POOL_RELEASE(ydev_mutex, dev_handle);
+    }
+#endif
+    yDevUnregister(dev_handle);
+}
+
+/**
+ * @brief 反初始化设备
+ * @param handle 设备句柄
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 功能描述:
+ * 释放一次引用，最后一次释放时反初始化设备并释放相关资源
+ */
+yDevStatus_t yDevDeinitStatic(void *handle)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    yDevStatus_t status;
+    uint32_t primask;
+    uint32_t refs;
+    uint8_t locked;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    dev_ops = ydev_ops_table[dev_handle->index]; // 直接定位到对应的操作表
+
+    if (dev_ops->deinit == NULL)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    // 还有其他使用者时只减少引用；计数归零后新的打开被拒绝，直到反初始化结束
+    primask = __get_PRIMASK();
+    __disable_irq();
+    refs = dev_handle->refs;
+    if (refs != 0)
+    {
+        dev_handle->refs = refs - 1U;
+    }
+    __set_PRIMASK(primask);
+    if (refs > 1U)
+    {
+        return YDEV_OK;
+    }
+    // 持锁反初始化，等待其他任务的读写先结束；挂起的设备先恢复，驱动反初始化时可能访问硬件
+    locked = YDEV_LOCK(dev_handle);
+    if (dev_handle->state == YDEV_STATE_DEFERRED)
+    {
+        // 尚未初始化，没有需要驱动释放的资源
+        dev_handle->state = YDEV_STATE_UNINITIALIZED;
+        YDEV_UNLOCK(dev_handle, locked);
+        yDev_InitUndo(dev_handle);
+        return YDEV_OK;
+    }
+    status = yDev_PmGet(dev_handle, dev_ops);
+    if (status == YDEV_OK)
+    {
+        status = dev_ops->deinit(handle);
+        if (status == YDEV_OK)
+        {
+#if YDEV_PM_ACCOUNT
+            yDev_PmAccount(dev_handle, 1);
+#endif
+            dev_handle->state = YDEV_STATE_UNINITIALIZED;
+            dev_handle->active = 0;
+        }
+        else
+        {
+            yDev_PmPut(dev_handle);
+        }
+    }
+    YDEV_UNLOCK(dev_handle, locked);
+    if (status != YDEV_OK)
+    {
+        dev_handle->refs = refs; // 反初始化失败，设备仍可使用
+        return status;
+    }
+
+    yDev_InitUndo(dev_handle);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 从设备读取数据
+ * @param handle 设备句柄
+ * @param buffer 读取缓冲区
+ * @param size 期望读取的字节数
+ * @return int32_t 实际读取的字节数，0表示未读取到数据，负数表示错误
+ *
+ * @par 功能描述:
+ * 从指定设备读取数据到缓冲区，返回实际读取的字节数；
+ * 长度整体交给驱动，1MB级的连续读取也只需一次调用
+ */
+int32_t yDevRead(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    int32_t ret;
+    uint32_t start;
+    uint8_t locked;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return 0; // 成功操作了0个数据
+    }
+    if (size > (size_t)INT32_MAX)
+    {
+        return -1; // 返回值无法表示
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    dev_ops = ydev_ops_table[dev_handle->index]; // 直接定位到对应的操作表
+
+    if (dev_ops->read == NULL)
+    {
+        return 0; // 不支持读操作
+    }
+
+    locked = YDEV_LOCK(dev_handle);
+    start = YDEV_STATS_BEGIN(dev_handle, YDEV_STAT_READ);
+    if (yDev_PmGet(dev_handle, dev_ops) != YDEV_OK)
+    {
+        YDEV_STATS_END(dev_handle, YDEV_STAT_READ, start, -1);
+        YDEV_UNLOCK(dev_handle, locked);
+        return -1;
+    }
+    ret = dev_ops->read(handle, buffer, size);
+    yDev_PmPut(dev_handle);
+    YDEV_STATS_END(dev_handle, YDEV_STAT_READ, start, ret);
+    YDEV_UNLOCK(dev_handle, locked);
+
+    return ret;
+}
+
+/**
+ * @brief 向设备写入数据
+ * @param handle 设备句柄
+ * @param buffer 写入缓冲区
+ * @param size 期望写入的字节数
+ * @return int32_t 实际写入的字节数，0表示未写入数据，负数表示错误
+ *
+ * @par 功能描述:
+ * 将缓冲区的数据写入到指定设备，返回实际写入的字节数；
+ * 长度整体交给驱动，1MB级的连续写入也只需一次调用
+ */
+int32_t yDevWrite(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    int32_t ret;
+    uint32_t start;
+    uint8_t locked;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return 0; // 成功操作了0个数据
+    }
+    if (size > (size_t)INT32_MAX)
+    {
+        return -1; // 返回值无法表示
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    dev_ops = ydev_ops_table[dev_handle->index]; // 直接定位到对应的操作表
+
+    if (dev_ops->write == NULL)
+    {
+        return 0; // 不支持写操作
+    }
+
+    locked = YDEV_LOCK(dev_handle);
+    start = YDEV_STATS_BEGIN(dev_handle, YDEV_STAT_WRITE);
+    if (yDev_PmGet(dev_handle, dev_ops) != YDEV_OK)
+    {
+        YDEV_STATS_END(dev_handle, YDEV_STAT_WRITE, start, -1);
+        YDEV_UNLOCK(dev_handle, locked);
+        return -1;
+    }
+    ret = dev_ops->write(handle, buffer, size);
+    yDev_PmPut(dev_handle);
+    YDEV_STATS_END(dev_handle, YDEV_STAT_WRITE, start, ret);
+    YDEV_UNLOCK(dev_handle, locked);
+
+    return ret;
+}
+
+/**
+ * @brief 逐段执行向量读写实现
+ */
+static int32_t yDev_IovLoop(void *handle, const yDevOps_t *dev_ops, const yDevIoVec_t *iov,
+                            uint32_t count, uint8_t flag_write)
+{
+    int32_t total;
+    int32_t ret;
+    uint32_t i;
+
+    total = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (iov[i].len == 0)
+        {
+            continue;
+        }
+
+        ret = (flag_write != 0) ? dev_ops->write(handle, iov[i].base, iov[i].len)
+                                : dev_ops->read(handle, iov[i].base, iov[i].len);
+        if (ret < 0)
+        {
+            return (total > 0) ? total : ret;
+        }
+
+        total += ret;
+        if ((size_t)ret != iov[i].len)
+        {
+            break;
+        }
+    }
+
+    return total;
+}
+
+/**
+ * @brief 计算向量读写总长度实现
+ */
+static int32_t yDev_IovTotal(const yDevIoVec_t *iov, uint32_t count)
+{
+    size_t total;
+    uint32_t i;
+
+    total = 0;
+    for (i = 0; i < count; i++)
+    {
+        if ((iov[i].len != 0) && (iov[i].base == NULL))
+        {
+            return -1;
+        }
+        if (iov[i].len > ((size_t)INT32_MAX - total))
+        {
+            return -1; // 返回值无法表示
+        }
+        total += iov[i].len;
+    }
+
+    return (int32_t)total;
+}
+
+/**
+ * @brief 向量读取设备数据
+ * @param handle 设备句柄
+ * @param iov 分段描述符数组
+ * @param count 分段数量
+ * @return int32_t 实际读取的总字节数，0表示未读取到数据，负数表示错误
+ *
+ * @par 功能描述:
+ * 按顺序填充各分段；驱动提供readv时整组交给驱动一次完成，
+ * 否则逐段调用read
+ */
+int32_t yDevReadv(void *handle, const yDevIoVec_t *iov, uint32_t count)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    int32_t total;
+    uint32_t start;
+    uint8_t locked;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (iov == NULL) || (count == 0))
+    {
+        return 0;
+    }
+    total = yDev_IovTotal(iov, count);
+    if (total <= 0)
+    {
+        return total;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    dev_ops = ydev_ops_table[dev_handle->index];
+
+    // 整组在一次加锁内完成，逐段回退时其他任务也不会插在分段之间
+    locked = YDEV_LOCK(dev_handle);
+    start = YDEV_STATS_BEGIN(dev_handle, YDEV_STAT_READ);
+    if (yDev_PmGet(dev_handle, dev_ops) != YDEV_OK)
+    {
+        YDEV_STATS_END(dev_handle, YDEV_STAT_READ, start, -1);
+        YDEV_UNLOCK(dev_handle, locked);
+        return -1;
+    }
+    if (dev_ops->readv != NULL)
+    {
+        total = dev_ops->readv(handle, iov, count);
+    }
+    else if (dev_ops->read != NULL)
+    {
+        total = yDev_IovLoop(handle, dev_ops, iov, count, 0);
+    }
+    else
+    {
+        total = 0; // 不支持读操作
+    }
+    yDev_PmPut(dev_handle);
+    YDEV_STATS_END(dev_handle, YDEV_STAT_READ, start, total);
+    YDEV_UNLOCK(dev_handle, locked);
+
+    return total;
+}
+
+/**
+ * @brief 向量写入设备数据
+ * @param handle 设备句柄
+ * @param iov 分段描述符数组
+ * @param count 分段数量
+ * @return int32_t 实际写入的总字节数，0表示未写入数据，负数表示错误
+ *
+ * @par 功能描述:
+ * 按顺序发出各分段；驱动提供writev时整组交给驱动一次完成，
+ * 否则逐段调用write
+ */
+int32_t yDevWritev(void *handle, const yDevIoVec_t *iov, uint32_t count)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    int32_t total;
+    uint32_t start;
+    uint8_t locked;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (iov == NULL) || (count == 0))
+    {
+        return 0;
+    }
+    total = yDev_IovTotal(iov, count);
+    if (total <= 0)
+    {
+        return total;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    dev_ops = ydev_ops_table[dev_handle->index];
+
+    // 整组在一次加锁内完成，逐段回退时其他任务也不会插在分段之间
+    locked = YDEV_LOCK(dev_handle);
+    start = YDEV_STATS_BEGIN(dev_handle, YDEV_STAT_WRITE);
+    if (yDev_PmGet(dev_handle, dev_ops) != YDEV_OK)
+    {
+        YDEV_STATS_END(dev_handle, YDEV_STAT_WRITE, start, -1);
+        YDEV_UNLOCK(dev_handle, locked);
+        return -1;
+    }
+    if (dev_ops->writev != NULL)
+    {
+        total = dev_ops->writev(handle, iov, count);
+    }
+    else if (dev_ops->write != NULL)
+    {
+        total = yDev_IovLoop(handle, dev_ops, iov, count, 1);
+    }
+    else
+    {
+        total = 0; // 不支持写操作
+    }
+    yDev_PmPut(dev_handle);
+    YDEV_STATS_END(dev_handle, YDEV_STAT_WRITE, start, total);
+    YDEV_UNLOCK(dev_handle, locked);
+
+    return total;
+}
+
+/**
+ * @brief 写入一条零拷贝缓冲区链
+ * @param handle 设备句柄
+ * @param p 缓冲区链
+ * @return int32_t 实际写入的总字节数，负数表示错误
+ *
+ * @par 功能描述:
+ * 把链中各段填成分段描述符交给yDevWritev，每批最多YDEV_PBUF_IOV_MAX段，
+ * 某批写入不足时停止
+ */
+int32_t yDevWritePbuf(void *handle, const struct ylib_pbuf *p)
+{
+    yDevIoVec_t iov[YDEV_PBUF_IOV_MAX];
+    uint32_t count;
+    uint32_t expect;
+    int32_t total;
+    int32_t ret;
+
+    total = 0;
+    while (p != NULL)
+    {
+        count = 0;
+        expect = 0;
+        for (; (p != NULL) && (count < YDEV_PBUF_IOV_MAX); p = p->next)
+        {
+            if (p->len == 0)
+            {
+                continue;
+            }
+            iov[count].base = p->payload;
+            iov[count].len = p->len;
+            expect += p->len;
+            count++;
+        }
+        if (count == 0)
+        {
+            break;
+        }
+
+        ret = yDevWritev(handle, iov, count);
+        if (ret < 0)
+        {
+            return (total > 0) ? total : ret;
+        }
+        total += ret;
+        if ((uint32_t)ret < expect)
+        {
+            break;
+        }
+    }
+
+    return total;
+}
+
+/**
+ * @brief 设备控制操作
+ * @param handle 设备句柄
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 功能描述:
+ * 执行设备特定的控制操作，如配置参数、状态查询等
+ */
+yDevStatus_t yDevIoctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    yDevStatus_t status;
+    uint32_t start;
+    uint8_t locked;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    dev_ops = ydev_ops_table[dev_handle->index]; // 直接定位到对应的操作表
+
+    if (dev_ops->ioctl == NULL)
+    {
+        return YDEV_NOT_SUPPORTED; // 不支持控制操作
+    }
+
+    locked = YDEV_LOCK(dev_handle);
+    start = YDEV_STATS_BEGIN(dev_handle, YDEV_STAT_IOCTL);
+    status = yDev_PmGet(dev_handle, dev_ops);
+    if (status == YDEV_OK)
+    {
+        status = dev_ops->ioctl(handle, cmd, arg);
+        yDev_PmPut(dev_handle);
+    }
+    YDEV_STATS_END(dev_handle, YDEV_STAT_IOCTL, start, (status == YDEV_OK) ? 0 : -1);
+    YDEV_UNLOCK(dev_handle, locked);
+
+    return status;
+}
+
+/**
+ * @brief 启动异步读取
+ * @param handle 设备句柄
+ * @param buffer 读取缓冲区
+ * @param size 期望读取的字节数
+ * @param callback 完成回调
+ * @param arg 回调参数
+ * @return yDevStatus_t 启动状态
+ *
+ * @par 功能描述:
+ * 启动成功后立即返回，读取结果通过完成回调或yDevWait获取
+ */
+yDevStatus_t yDevReadAsync(void *handle, void *buffer, size_t size,
+                           yDevAsyncCallback_t callback, void *arg)
+{
+    return yDev_AsyncStart((yDevHandle_t *)handle, YDEV_ASYNC_READ, buffer, size, callback, arg);
+}
+
+/**
+ * @brief 启动异步写入
+ * @param handle 设备句柄
+ * @param buffer 写入缓冲区
+ * @param size 期望写入的字节数
+ * @param callback 完成回调
+ * @param arg 回调参数
+ * @return yDevStatus_t 启动状态
+ *
+ * @par 功能描述:
+ * 启动成功后立即返回，写入结果通过完成回调或yDevWait获取
+ */
+yDevStatus_t yDevWriteAsync(void *handle, const void *buffer, size_t size,
+                            yDevAsyncCallback_t callback, void *arg)
+{
+    return yDev_AsyncStart((yDevHandle_t *)handle, YDEV_ASYNC_WRITE, buffer, size, callback, arg);
+}
+
+/**
+ * @brief 异步传输结束通知
+ * @param handle 设备句柄
+ * @param dir 传输方向
+ * @param status 传输结果
+ * @param len 实际传输的字节数
+ * @return 无
+ *
+ * @par 功能描述:
+ * 进行中标志在回调之前清除，回调中可直接启动下一次传输；
+ * 中断中调用时用FromISR接口唤醒等待任务并在退出中断时切换
+ */
+void yDevAsyncComplete(void *handle, yDevAsyncDir_t dir, yDevStatus_t status, uint32_t len)
+{
+    yDevHandle_t *dev_handle;
+    yDevAsync_t *async;
+    yDevAsyncCallback_t callback;
+    void *arg;
+    uint32_t events;
+
+    if ((handle == NULL) || (dir >= YDEV_ASYNC_MAX))
+    {
+        return;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    async = &dev_handle->async[dir];
+    if (async->pending == 0)
+    {
+        return;
+    }
+
+    callback = async->callback;
+    arg = async->arg;
+    async->len = len;
+    async->status = status;
+    async->pending = 0;
+    yDev_PmPut(dev_handle); // 回调中启动下一次传输前先释放本次的活动计数
+
+    if (callback != NULL)
+    {
+        callback(arg, status, len);
+    }
+
+    (void)yDevWaitqWakeAll(&dev_handle->waitq);
+
+    // 传输结束同时作为就绪事件，poll中的任务可以统一处理完成
+    events = (dir == YDEV_ASYNC_READ) ? YDEV_POLLIN : YDEV_POLLOUT;
+    if (status != YDEV_OK)
+    {
+        events |= YDEV_POLLERR;
+    }
+    yDevPollSignal(handle, events);
+}
+
+/**
+ * @brief yDevWait的等待条件实现
+ */
+static uint8_t yDev_AsyncIdle(void *arg)
+{
+    yDevHandle_t *dev_handle = (yDevHandle_t *)arg;
+
+    return ((dev_handle->async[YDEV_ASYNC_READ].pending == 0) &&
+            (dev_handle->async[YDEV_ASYNC_WRITE].pending == 0))
+               ? 1
+               : 0;
+}
+
+/**
+ * @brief 唤醒等待任务实现
+ */
+static void yDev_NotifyTask(void *task)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (task == NULL)
+    {
+        return;
+    }
+    if (__get_IPSR() != 0U)
+    {
+        vTaskNotifyGiveFromISR((TaskHandle_t)task, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    else
+    {
+        xTaskNotifyGive((TaskHandle_t)task);
+    }
+}
+
+/**
+ * @brief 就绪事件通知
+ * @param handle 设备句柄
+ * @param events 登记的就绪事件
+ * @return 无
+ *
+ * @par 功能描述:
+ * 事件在临界区内并入句柄，随后唤醒yDevPoll中的任务；
+ * 任务在扫描前已登记，扫描和阻塞之间到达的通知由通知计数保留
+ */
+void yDevPollSignal(void *handle, uint32_t events)
+{
+    yDevHandle_t *dev_handle;
+    uint32_t primask;
+
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    if (events != 0)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        dev_handle->revents |= events;
+        __set_PRIMASK(primask);
+    }
+
+    yDev_NotifyTask(dev_handle->poll_task);
+}
+
+/**
+ * @brief 唤醒poll任务
+ * @param handle 设备句柄
+ * @return 无
+ */
+void yDevPollWake(void *handle)
+{
+    yDevPollSignal(handle, YDEV_POLLWAKE);
+}
+
+/**
+ * @brief 扫描就绪事件实现
+ */
+static uint32_t yDev_PollScan(void *const handles[], const uint32_t events[], uint32_t revents[], uint32_t n)
+{
+    yDevHandle_t *dev_handle;
+    const yDevOps_t *dev_ops;
+    uint32_t primask;
+    uint32_t state;
+    uint32_t mask;
+    uint32_t ready;
+    uint32_t i;
+
+    ready = 0;
+    for (i = 0; i < n; i++)
+    {
+        revents[i] = 0;
+        dev_handle = (yDevHandle_t *)handles[i];
+        if (dev_handle == NULL)
+        {
+            continue;
+        }
+
+        // 1. 驱动能报告当前状态时以查询结果为准，不支持时为0；
+        //    只读查询不经过句柄锁，其他任务阻塞写入时也能立即返回
+        state = 0;
+        dev_ops = ydev_ops_table[dev_handle->index];
+        if ((dev_ops->ioctl == NULL) || (dev_ops->ioctl(dev_handle, YDEV_IOCTL_POLL, &state) != YDEV_OK))
+        {
+            state = 0;
+        }
+
+        // 2. 取走登记的关注事件，未关注的留给以后
+        mask = events[i] | YDEV_POLLERR | YDEV_POLLWAKE;
+        primask = __get_PRIMASK();
+        __disable_irq();
+        state |= dev_handle->revents;
+        dev_handle->revents &= ~mask;
+        __set_PRIMASK(primask);
+
+        revents[i] = state & mask;
+        if (revents[i] != 0)
+        {
+            ready++;
+        }
+    }
+
+    return ready;
+}
+
+/**
+ * @brief 等待多个设备就绪
+ * @param handles 设备句柄数组
+ * @param events 关注的事件数组
+ * @param revents 输出的就绪事件数组
+ * @param n 设备数量
+ * @param timeOutMs 超时时间(毫秒)，0表示一直等待，YDEV_POLL_NOWAIT表示不等待
+ * @return int32_t 就绪的设备数量，0表示超时，-1表示参数错误
+ *
+ * @par 功能描述:
+ * 先在所有设备上登记当前任务再扫描，没有就绪时阻塞在任务通知上，
+ * 任一设备的驱动通知后重新扫描；调度器未启动时轮询
+ */
+int32_t yDevPoll(void *const handles[], const uint32_t events[], uint32_t revents[],
+                 uint32_t n, uint32_t timeOutMs)
+{
+    uint32_t start_time;
+    uint32_t elapsed;
+    uint32_t ready;
+    uint8_t flag_task;
+    TickType_t wait;
+    void *task;
+    uint32_t i;
+
+    if ((handles == NULL) || (events == NULL) || (revents == NULL) || (n == 0))
+    {
+        return -1;
+    }
+
+    flag_task = ((timeOutMs != YDEV_POLL_NOWAIT) &&
+                 (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+                    ? 1
+                    : 0;
+    task = NULL;
+    if (flag_task != 0)
+    {
+        task = (void *)xTaskGetCurrentTaskHandle();
+        for (i = 0; i < n; i++)
+        {
+            if (handles[i] != NULL)
+            {
+                ((yDevHandle_t *)handles[i])->poll_task = task;
+            }
+        }
+        (void)ulTaskNotifyTake(pdTRUE, 0); // 清除残留通知，先登记再扫描不会漏掉事件
+    }
+
+    start_time = (uint32_t)yDevGetTimeMS();
+    for (;;)
+    {
+        ready = yDev_PollScan(handles, events, revents, n);
+        if ((ready != 0) || (timeOutMs == YDEV_POLL_NOWAIT))
+        {
+            break;
+        }
+        elapsed = (uint32_t)yDevGetTimeMS() - start_time;
+        if ((timeOutMs != 0) && (elapsed >= timeOutMs))
+        {
+            break;
+        }
+        if (flag_task != 0)
+        {
+            wait = (timeOutMs == 0) ? portMAX_DELAY : (pdMS_TO_TICKS(timeOutMs - elapsed) + 1U);
+            (void)ulTaskNotifyTake(pdTRUE, wait);
+        }
+    }
+
+    if (flag_task != 0)
+    {
+        for (i = 0; i < n; i++)
+        {
+            if ((handles[i] != NULL) && (((yDevHandle_t *)handles[i])->poll_task == task))
+            {
+                ((yDevHandle_t *)handles[i])->poll_task = NULL;
+            }
+        }
+    }
+
+    return (int32_t)ready;
+}
+
+/**
+ * @brief 等待异步传输结束
+ * @param handle 设备句柄
+ * @param timeOutMs 超时时间(毫秒)，0表示一直等待
+ * @return yDevStatus_t 等待结果
+ *
+ * @par 功能描述:
+ * 两个方向都空闲时返回；多个任务可同时等待，传输结束时全部唤醒；调度器未启动时轮询进行中标志
+ */
+yDevStatus_t yDevWait(void *handle, uint32_t timeOutMs)
+{
+    yDevHandle_t *dev_handle;
+    yDevStatus_t status;
+    uint32_t dir;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    dev_handle = (yDevHandle_t *)handle;
+    status = yDevWaitqWait(&dev_handle->waitq, yDev_AsyncIdle, dev_handle, timeOutMs);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+
+    // 返回第一个失败方向的结果
+    for (dir = 0; dir < YDEV_ASYNC_MAX; dir++)
+    {
+        if ((dev_handle->async[dir].status != YDEV_OK) &&
+            (dev_handle->async[dir].status != YDEV_BUSY))
+        {
+            return dev_handle->async[dir].status;
+        }
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 注册表二分查找实现
+ */
+static uint32_t yDev_RegistrySearch(const char *name, uint8_t *found)
+{
+    uint32_t low;
+    uint32_t high;
+    uint32_t mid;
+    int cmp;
+
+    low = 0;
+    high = ydev_registry_count;
+    while (low < high)
+    {
+        mid = (low + high) / 2U;
+        cmp = strcmp(name, ydev_registry[mid].name);
+        if (cmp == 0)
+        {
+            *found = 1;
+            return mid;
+        }
+        if (cmp < 0)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1U;
+        }
+    }
+
+    *found = 0;
+    return low;
+}
+
+/**
+ * @brief 按名称注册设备句柄
+ * @param name 设备名
+ * @param handle 设备句柄
+ * @return yDevStatus_t 注册状态
+ *
+ * @par 功能描述:
+ * 按名称有序插入，条目少，临界区内移动数组即可
+ */
+yDevStatus_t yDevRegister(const char *name, void *handle)
+{
+    uint32_t primask;
+    uint32_t pos;
+    uint8_t found;
+    yDevStatus_t status;
+
+    if ((name == NULL) || (handle == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pos = yDev_RegistrySearch(name, &found);
+    if (found != 0)
+    {
+        status = (ydev_registry[pos].handle == (yDevHandle_t *)handle) ? YDEV_OK : YDEV_BUSY;
+    }
+    else if (ydev_registry_count >= YDEV_REGISTRY_MAX)
+    {
+        status = YDEV_NO_MEMORY;
+    }
+    else
+    {
+        memmove(&ydev_registry[pos + 1U], &ydev_registry[pos],
+                (ydev_registry_count - pos) * sizeof(ydev_registry[0]));
+        ydev_registry[pos].name = name;
+        ydev_registry[pos].handle = (yDevHandle_t *)handle;
+        ydev_registry_count++;
+        status = YDEV_OK;
+    }
+    __set_PRIMASK(primask);
+
+    return status;
+}
+
+/**
+ * @brief 注销设备句柄
+ * @param handle 设备句柄
+ * @return 无
+ */
+void yDevUnregister(void *handle)
+{
+    uint32_t primask;
+    uint32_t i;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (i = 0; i < ydev_registry_count; i++)
+    {
+        if (ydev_registry[i].handle == (yDevHandle_t *)handle)
+        {
+            ydev_registry_count--;
+            memmove(&ydev_registry[i], &ydev_registry[i + 1U],
+                    (ydev_registry_count - i) * sizeof(ydev_registry[0]));
+            break;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 按名称查找设备句柄
+ * @param name 设备名
+ * @return void* 设备句柄，未找到返回NULL
+ */
+void *yDevFind(const char *name)
+{
+    yDevHandle_t *handle;
+    uint32_t primask;
+    uint32_t pos;
+    uint8_t found;
+
+    if (name == NULL)
+    {
+        return NULL;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pos = yDev_RegistrySearch(name, &found);
+    handle = (found != 0) ? ydev_registry[pos].handle : NULL;
+    __set_PRIMASK(primask);
+
+    return handle;
+}
+
+/**
+ * @brief 按序号遍历已注册的设备
+ * @param index 序号
+ * @param name 输出设备名
+ * @return void* 设备句柄，序号超出范围返回NULL
+ */
+void *yDevIterate(uint32_t index, const char **name)
+{
+    yDevHandle_t *handle;
+    uint32_t primask;
+
+    handle = NULL;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (index < ydev_registry_count)
+    {
+        handle = ydev_registry[index].handle;
+        if (name != NULL)
+        {
+            *name = ydev_registry[index].name;
+        }
+    }
+    __set_PRIMASK(primask);
+
+    return handle;
+}
+
+/**
+ * @brief 获取设备类型
+ * @param handle 设备句柄
+ * @return yDevType_t 设备类型
+ */
+yDevType_t yDevGetType(void *handle)
+{
+    if (handle == NULL)
+    {
+        return YDEV_TYPE_MAX;
+    }
+
+    return ydev_ops_table[((yDevHandle_t *)handle)->index]->type;
+}
 
 /**
- * @brief 设备操作表结束标记
- * @note 用于标记设备操作表的结束位置，便于运行时遍历操作表
+ * @brief 查询异步传输是否进行中
+ * @param handle 设备句柄
+ * @param dir 传输方向
+ * @return uint8_t 1=进行中, 0=空闲
  */
-const yDevOps_t ydev_end_ops YLIB_SECTION(".ydev_ops_end") =
+uint8_t yDevAsyncIsBusy(void *handle, yDevAsyncDir_t dir)
+{
+    if ((handle == NULL) || (dir >= YDEV_ASYNC_MAX))
     {
-        .type = YDEV_TYPE_MAX, /*!< 设备类型标记为最大值 */
-        .init = NULL,          /*!< 初始化函数指针为空 */
-        .deinit = NULL,        /*!< 反初始化函数指针为空 */
-        .read = NULL,          /*!< 读取函数指针为空 */
-        .write = NULL,         /*!< 写入函数指针为空 */
-        .ioctl = NULL,         /*!< 控制函数指针为空 */
-};
+        return 0;
+    }
+
+    return ((yDevHandle_t *)handle)->async[dir].pending;
+}
 
 /**
- * @brief 设备操作表起始标记
- * @note 用于标记设备操作表的起始位置，便于运行时遍历操作表
+ * @brief 唤醒协程的异步完成回调
+ * @param arg 等待的协程
+ * @param status 传输结果
+ * @param len 实际传输的字节数
+ * @return 无
  */
-const yDevOps_t ydev_start_ops YLIB_SECTION(".ydev_ops_start") =
-    {
-        .type = YDEV_TYPE_START,
-        .init = NULL,
-        .deinit = NULL, /*!< 反初始化函数指针为空 */
-        .read = NULL,   /*!< 读取函数指针为空 */
-        .write = NULL,  /*!< 写入函数指针为空 */
-        .ioctl = NULL,  /*!< 控制函数指针为空 */
-};
+void yDevAsyncWakeCoro(void *arg, yDevStatus_t status, uint32_t len)
+{
+    ylib_coro_complete((struct ylib_coro *)arg, (int32_t)status, len);
+}
 
-// ==================== 局部变量定义 ====================
+/**
+ * @brief 初始化转交工作项的异步完成
+ * @param aw 异步完成结构
+ * @param func 工作函数
+ * @param prio 工作队列号
+ * @return 无
+ */
+void yDevAsyncWorkInit(yDevAsyncWork_t *aw, ylib_work_func_t func, unsigned int prio)
+{
+    ylib_work_init(&aw->work, func, aw, prio);
+    aw->status = YDEV_OK;
+    aw->len = 0;
+}
 
 /**
- * @brief 系统时间计数器
- * @note 用于记录系统运行时间，单位为毫秒
+ * @brief 提交工作项的异步完成回调
+ * @param arg 异步完成结构
+ * @param status 传输结果
+ * @param len 实际传输的字节数
+ * @return 无
  */
-static size_t ydev_time_ms;
+void yDevAsyncWorkDone(void *arg, yDevStatus_t status, uint32_t len)
+{
+    yDevAsyncWork_t *aw = (yDevAsyncWork_t *)arg;
 
-// ==================== 核心API实现 ====================
+    aw->status = status;
+    aw->len = len;
+    (void)ylib_work_post(&aw->work);
+}
 
 /**
- * @brief yLab系统初始化
- * @retval yDevStatus_t 初始化状态
- * @retval YDEV_OK 初始化成功
- * @note 初始化yLab系统，包括底层yDrv驱动初始化
+ * @brief 读取设备操作统计
+ * @param handle 设备句柄
+ * @param stats 输出的统计数组
+ * @return yDevStatus_t 读取状态
+ *
+ * @par 功能描述:
+ * 临界区内整体拷贝，得到的各项计数彼此一致
  */
-yDevStatus_t yLabInit(void)
+yDevStatus_t yDevGetOpStats(void *handle, yDevOpStats_t stats[YDEV_STAT_MAX])
 {
-    // 初始化底层驱动
-    yDrvInit();
+#if YDEV_STATS_ENABLE
+    uint32_t primask;
+
+    if ((handle == NULL) || (stats == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    memcpy(stats, ((yDevHandle_t *)handle)->op_stats, sizeof(yDevOpStats_t) * YDEV_STAT_MAX);
+    __set_PRIMASK(primask);
 
-    // 初始化系统时间计数器
-    ydev_time_ms = 0;
     return YDEV_OK;
+#else
+    (void)handle;
+    (void)stats;
+    return YDEV_NOT_SUPPORTED;
+#endif
 }
 
 /**
- * @brief 静态初始化设备
- * @param config 设备配置参数指针
- * @param handle 设备句柄指针
- * @retval yDevStatus_t 初始化状态
- * @retval YDEV_OK 初始化成功
- * @retval YDEV_INVALID_PARAM 参数无效
- * @retval YDEV_NOT_SUPPORTED 设备类型不支持
- * @note 根据配置参数初始化指定类型的设备，查找对应的设备操作表并调用初始化函数
+ * @brief 清零设备操作统计
+ * @param handle 设备句柄
+ * @return 无
  */
-yDevStatus_t yDevInitStatic(void *config, void *handle)
+void yDevResetOpStats(void *handle)
+{
+#if YDEV_STATS_ENABLE
+    uint32_t primask;
+
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    yDev_StatsClear(((yDevHandle_t *)handle)->op_stats);
+    __set_PRIMASK(primask);
+#else
+    (void)handle;
+#endif
+}
+
+/**
+ * @brief 挂起设备
+ * @param handle 设备句柄
+ * @return yDevStatus_t 挂起状态
+ */
+yDevStatus_t yDevSuspend(void *handle)
 {
-    yDevConfig_t *dev_config;
-    yDevHandle_t *dev_handle;
     const yDevOps_t *dev_ops;
 
-    // 参数有效性检查
-    if ((config == NULL) || (handle == NULL))
+    if (handle == NULL)
     {
         return YDEV_INVALID_PARAM;
     }
 
-    dev_config = (yDevConfig_t *)config;
-    dev_handle = (yDevHandle_t *)handle;
-    dev_ops = (&ydev_start_ops) + 1;
-
-    // 遍历设备操作表，查找匹配的设备类型
-    for (int idx = 0; dev_ops < &ydev_end_ops; dev_ops++, idx++)
+    dev_ops = ydev_ops_table[((yDevHandle_t *)handle)->index];
+    if (dev_ops->suspend == NULL)
     {
-        if (dev_ops->type == dev_config->type)
-        {
-            dev_handle->index = idx;
-            dev_handle->timeOutMs = 10;
-            dev_handle->errno = YDEV_ERRNO_NO_ERROR;
-            if (dev_ops->init != NULL)
-            {
-                return dev_ops->init(config, handle);
-            }
-            else
-            {
-                return YDEV_NOT_SUPPORTED;
-            }
-        }
+        return YDEV_NOT_SUPPORTED;
     }
-    dev_handle->errno = YDEV_ERRNO_NOT_FOUND;
-    return YDEV_ERROR; // 未找到匹配的设备类型
+
+    return yDev_PmSuspend((yDevHandle_t *)handle, dev_ops, 0);
 }
 
 /**
- * @brief 反初始化设备
+ * @brief 恢复设备
  * @param handle 设备句柄
- * @return yDevStatus_t 操作状态
+ * @return yDevStatus_t 恢复状态
  *
  * @par 功能描述:
- * 反初始化指定的设备，释放相关资源
+ * 与一次空操作相同：登记时恢复，结束时重新开始计算空闲时间
  */
-yDevStatus_t yDevDeinitStatic(void *handle)
+yDevStatus_t yDevResume(void *handle)
 {
     yDevHandle_t *dev_handle;
-    const yDevOps_t *dev_ops;
+    yDevStatus_t status;
+    uint8_t locked;
 
-    // 参数有效性检查
     if (handle == NULL)
     {
         return YDEV_INVALID_PARAM;
     }
 
     dev_handle = (yDevHandle_t *)handle;
-    dev_ops = &ydev_start_ops + 1 + dev_handle->index; // 直接定位到对应的操作表
-
-    if (dev_ops->deinit != NULL)
+    locked = YDEV_LOCK(dev_handle);
+    status = yDev_PmGet(dev_handle, ydev_ops_table[dev_handle->index]);
+    if (status == YDEV_OK)
     {
-        return dev_ops->deinit(handle);
+        yDev_PmPut(dev_handle);
     }
-    else
+    YDEV_UNLOCK(dev_handle, locked);
+
+    return status;
+}
+
+/**
+ * @brief 获取设备状态
+ * @param handle 设备句柄
+ * @return yDevState_t 设备状态
+ */
+yDevState_t yDevGetState(void *handle)
+{
+    if (handle == NULL)
     {
-        return YDEV_NOT_SUPPORTED;
+        return YDEV_STATE_UNINITIALIZED;
     }
+
+    return ((yDevHandle_t *)handle)->state;
 }
 
 /**
- * @brief 从设备读取数据
- * @param handle 设备句柄
- * @param buffer 读取缓冲区
- * @param size 期望读取的字节数
- * @return size_t 实际读取的字节数，0表示未读取到数据
+ * @brief 挂起空闲超时的设备
+ * @return uint32_t 距离下一个设备到期的毫秒数
  *
  * @par 功能描述:
- * 从指定设备读取数据到缓冲区，返回实际读取的字节数
+ * 只遍历注册表中的设备；驱动暂时不能挂起(YDEV_BUSY)的设备下一个空闲周期后再试，
+ * 不支持挂起的设备(如配置了接收流的串口)跳过；
+ * 同时把唤醒中设备的时间计入累计值，微秒时间戳回绕前总会计入一次
  */
-size_t yDevRead(void *handle, void *buffer, size_t size)
+uint32_t yDevPmProcess(void)
 {
-    yDevHandle_t *dev_handle;
+    yDevHandle_t *handle;
     const yDevOps_t *dev_ops;
+    yDevStatus_t status;
+    uint32_t idle;
+    uint32_t remain;
+    uint32_t next;
+    uint32_t index;
+#if YDEV_PM_ACCOUNT
+    uint32_t primask;
+#endif
 
-    // 参数有效性检查
-    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    // 重试被否决的降频
+    vTaskSuspendAll();
+    (void)yDev_ClockUpdate();
+    (void)xTaskResumeAll();
+
+    next = YDEV_PM_NEVER;
+    for (index = 0; (handle = (yDevHandle_t *)yDevIterate(index, NULL)) != NULL; index++)
     {
-        return 0; // 成功操作了0个数据
+#if YDEV_PM_ACCOUNT
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if ((handle->state == YDEV_STATE_OPENED) || (handle->state == YDEV_STATE_BUSY))
+        {
+            yDev_PmAccount(handle, 1);
+        }
+        __set_PRIMASK(primask);
+#endif
+        dev_ops = ydev_ops_table[handle->index];
+        if ((handle->idle_ms == 0) || (dev_ops->suspend == NULL) ||
+            (handle->state == YDEV_STATE_SUSPENDED) || (handle->state == YDEV_STATE_DEFERRED))
+        {
+            continue;
+        }
+
+        idle = (uint32_t)yDevGetTimeMS() - handle->last_ms;
+        if ((handle->active == 0) && (idle >= handle->idle_ms))
+        {
+            status = yDev_PmSuspend(handle, dev_ops, handle->idle_ms);
+            if ((status == YDEV_OK) || (status == YDEV_NOT_SUPPORTED))
+            {
+                continue;
+            }
+            remain = handle->idle_ms;
+        }
+        else
+        {
+            remain = (handle->active != 0) ? handle->idle_ms : (handle->idle_ms - idle);
+        }
+
+        if (remain < next)
+        {
+            next = remain;
+        }
     }
 
-    dev_handle = (yDevHandle_t *)handle;
-    dev_ops = &ydev_start_ops + 1 + dev_handle->index; // 直接定位到对应的操作表
+    return next;
+}
+
+/**
+ * @brief 查询能否进入STOP模式
+ * @return uint8_t 1=可以进入, 0=不能进入
+ */
+uint8_t yDevPmCanStop(void)
+{
+    yDevHandle_t *handle;
+    const yDevOps_t *dev_ops;
+    uint32_t index;
 
-    if (dev_ops->read != NULL)
+    // STOP下DMA停止，未注册为设备的使用者(如CRC的DMA)也要等传输结束
+    if (yDrvDmaIsIdle() == 0)
     {
-        return dev_ops->read(handle, buffer, size);
+        return 0;
     }
-    else
+
+    for (index = 0; (handle = (yDevHandle_t *)yDevIterate(index, NULL)) != NULL; index++)
     {
-        return 0; // 不支持读操作
+        dev_ops = ydev_ops_table[handle->index];
+        // 延迟初始化的设备还没有访问过硬件，与已挂起相同
+        if ((handle->active != 0) ||
+            ((dev_ops->suspend != NULL) && (handle->state != YDEV_STATE_SUSPENDED) &&
+             (handle->state != YDEV_STATE_DEFERRED)))
+        {
+            return 0;
+        }
     }
+
+    return 1;
 }
 
 /**
- * @brief 向设备写入数据
+ * @brief 读取设备唤醒统计
  * @param handle 设备句柄
- * @param buffer 写入缓冲区
- * @param size 期望写入的字节数
- * @return size_t 实际写入的字节数，0表示未写入数据
+ * @param usage 输出
+ * @return yDevStatus_t 读取状态
  *
  * @par 功能描述:
- * 将缓冲区的数据写入到指定设备，返回实际写入的字节数
+ * 临界区内拷贝，唤醒中的设备补上起点到现在的时间，不改变句柄中的累计值
  */
-size_t yDevWrite(void *handle, const void *buffer, size_t size)
+yDevStatus_t yDevPmGetUsage(void *handle, yDevPmUsage_t *usage)
 {
+#if YDEV_PM_ACCOUNT
     yDevHandle_t *dev_handle;
-    const yDevOps_t *dev_ops;
+    uint32_t primask;
+    uint32_t now;
 
-    // 参数有效性检查
-    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    if ((handle == NULL) || (usage == NULL))
     {
-        return 0; // 成功操作了0个数据
+        return YDEV_INVALID_PARAM;
     }
 
     dev_handle = (yDevHandle_t *)handle;
-    dev_ops = &ydev_start_ops + 1 + dev_handle->index; // 直接定位到对应的操作表
+    primask = __get_PRIMASK();
+    __disable_irq();
+    now = yDevGetTimeUS();
+    *usage = dev_handle->pm_usage;
+    if ((dev_handle->state == YDEV_STATE_OPENED) || (dev_handle->state == YDEV_STATE_BUSY))
+    {
+        usage->awake_us += now - usage->since_us;
+    }
+    __set_PRIMASK(primask);
+    usage->since_us = now;
+
+    return YDEV_OK;
+#else
+    (void)handle;
+    (void)usage;
+    return YDEV_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief 读取CPU睡眠统计
+ * @param stats 输出
+ * @return yDevStatus_t 读取状态
+ */
+yDevStatus_t yDevPmGetCpuStats(yDevPmCpuStats_t *stats)
+{
+#if YDEV_PM_ACCOUNT && (configUSE_TICKLESS_IDLE == 1)
+    uint32_t primask;
 
-    if (dev_ops->write != NULL)
+    if (stats == NULL)
     {
-        return dev_ops->write(handle, buffer, size);
+        return YDEV_INVALID_PARAM;
     }
-    else
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = ydev_pm_cpu;
+    __set_PRIMASK(primask);
+
+    return YDEV_OK;
+#else
+    (void)stats;
+    return YDEV_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief 清零唤醒统计和CPU睡眠统计
+ * @return 无
+ */
+void yDevPmResetUsage(void)
+{
+#if YDEV_PM_ACCOUNT
+    yDevHandle_t *handle;
+    uint32_t primask;
+    uint32_t index;
+
+    for (index = 0; (handle = (yDevHandle_t *)yDevIterate(index, NULL)) != NULL; index++)
     {
-        return 0; // 不支持写操作
+        primask = __get_PRIMASK();
+        __disable_irq();
+        handle->pm_usage.awake_us = 0;
+        handle->pm_usage.wakes = 0;
+        handle->pm_usage.since_us = yDevGetTimeUS();
+        __set_PRIMASK(primask);
     }
+#if (configUSE_TICKLESS_IDLE == 1)
+    primask = __get_PRIMASK();
+    __disable_irq();
+    memset(&ydev_pm_cpu, 0, sizeof(ydev_pm_cpu));
+    __set_PRIMASK(primask);
+#endif
+#endif
 }
 
 /**
- * @brief 设备控制操作
- * @param handle 设备句柄
- * @param cmd 控制命令
- * @param arg 命令参数
- * @return yDevStatus_t 操作状态
+ * @brief 按请求计数切换系统时钟
+ * @return yDevStatus_t 切换状态
+ */
+static yDevStatus_t yDev_ClockUpdate(void)
+{
+    uint32_t level;
+
+    // 数值小的等级频率高，取请求中最快的，没有比空闲等级更快的请求时取空闲等级
+    for (level = 0; level < ydev_clock_idle; level++)
+    {
+        if (ydev_clock_count[level] != 0)
+        {
+            break;
+        }
+    }
+
+    if (level == (uint32_t)yDrvClockGet())
+    {
+        return YDEV_OK;
+    }
+    return (yDrvClockSet((yDrvClockLevel_t)level) == YDRV_OK) ? YDEV_OK : YDEV_BUSY;
+}
+
+/**
+ * @brief 切换到没有请求时的时钟等级
+ * @return int32_t 0成功，-1切换被否决(由yDevPmProcess重试)
  *
  * @par 功能描述:
- * 执行设备特定的控制操作，如配置参数、状态查询等
+ * 上电等级(YDRV_CLOCK_BOOT_LEVEL)为HSI时调度器启动前不等待HSE，
+ * HSE在上电时已开始起振，到这里通常只需等待PLL锁定
  */
-yDevStatus_t yDevIoctl(void *handle, uint32_t cmd, void *arg)
+static int32_t yDev_ClockBoot(void)
 {
-    yDevHandle_t *dev_handle;
-    const yDevOps_t *dev_ops;
+    yDevStatus_t status;
 
-    // 参数有效性检查
-    if (handle == NULL)
+    vTaskSuspendAll();
+    status = yDev_ClockUpdate();
+    (void)xTaskResumeAll();
+
+    // 停在HSI等级时按当前等级重新配置，关闭上电时提前启动的HSE
+    if (yDrvClockGet() != YDRV_CLOCK_64MHZ)
     {
-        return YDEV_INVALID_PARAM;
+        yDrvClockRestore();
     }
 
-    dev_handle = (yDevHandle_t *)handle;
-    dev_ops = &ydev_start_ops + 1 + dev_handle->index; // 直接定位到对应的操作表
+    return (status == YDEV_OK) ? 0 : -1;
+}
+YDEV_INIT_EXPORT(yDev_ClockBoot, YDEV_INIT_DEVICE);
+
+/**
+ * @brief 请求不低于指定等级的系统时钟
+ * @param level 时钟等级
+ * @return yDevStatus_t 请求状态
+ *
+ * @par 功能描述:
+ * 计数和切换在调度器挂起下进行；升频被否决时撤销本次计数，调用者不会在低频下误以为已满足
+ */
+yDevStatus_t yDevClockRequest(uint32_t level)
+{
+    yDevStatus_t status;
+
+    if (level >= YDRV_CLOCK_LEVEL_MAX)
+    {
+        return YDEV_INVALID_PARAM;
+    }
 
-    if (dev_ops->ioctl != NULL)
+    vTaskSuspendAll();
+    ydev_clock_count[level]++;
+    status = yDev_ClockUpdate();
+    if ((status != YDEV_OK) && ((uint32_t)yDrvClockGet() > level))
     {
-        return dev_ops->ioctl(handle, cmd, arg);
+        ydev_clock_count[level]--;
     }
     else
     {
-        return YDEV_NOT_SUPPORTED; // 不支持控制操作
+        status = YDEV_OK;
     }
+    (void)xTaskResumeAll();
+
+    return status;
 }
 
 /**
- * @brief 设备控制操作
- * @param handle 设备句柄
- * @param cmd 控制命令
- * @param arg 命令参数
- * @return yDevStatus_t 操作状态
+ * @brief 释放系统时钟请求
+ * @param level 请求时的等级
+ */
+void yDevClockRelease(uint32_t level)
+{
+    if ((level >= YDRV_CLOCK_LEVEL_MAX) || (ydev_clock_count[level] == 0))
+    {
+        return;
+    }
+
+    vTaskSuspendAll();
+    ydev_clock_count[level]--;
+    (void)yDev_ClockUpdate();
+    (void)xTaskResumeAll();
+}
+
+/**
+ * @brief 设置没有请求时的系统时钟等级
+ * @param level 时钟等级
+ * @return yDevStatus_t 设置状态
+ */
+yDevStatus_t yDevClockSetIdle(uint32_t level)
+{
+    yDevStatus_t status;
+
+    if (level >= YDRV_CLOCK_LEVEL_MAX)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    vTaskSuspendAll();
+    ydev_clock_idle = level;
+    status = yDev_ClockUpdate();
+    (void)xTaskResumeAll();
+
+    return status;
+}
+
+/**
+ * @brief 获取空闲等级和各等级的请求计数
+ * @param count 输出各等级的请求数，可为NULL
+ * @return uint32_t 空闲等级
+ */
+uint32_t yDevClockGetRequests(uint16_t *count)
+{
+    uint32_t level;
+
+    if (count != NULL)
+    {
+        for (level = 0; level < YDRV_CLOCK_LEVEL_MAX; level++)
+        {
+            count[level] = ydev_clock_count[level];
+        }
+    }
+    return ydev_clock_idle;
+}
+
+#if (configUSE_TICKLESS_IDLE == 1)
+/**
+ * @brief 无滴答空闲
+ * @param xExpectedIdleTime 距离下一个任务解除阻塞的滴答数
  *
  * @par 功能描述:
- * 执行设备特定的控制操作，如配置参数、状态查询等
+ * 替换移植层的弱定义，由空闲任务在调度器挂起时调用：停止SysTick，
+ * 以RTC唤醒定时器进入STOP1，唤醒后按实际睡眠时间推进滴答计数；
+ * 有任务就绪、设备未挂起或DMA在传输时退化为普通睡眠，SysTick照常运行
+ */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    uint32_t slept;
+    TickType_t ticks;
+#if YDEV_PM_ACCOUNT
+    uint32_t start;
+#endif
+
+    __disable_irq();
+
+    if ((eTaskConfirmSleepModeStatus() == eAbortSleep) || (yDevPmCanStop() == 0))
+    {
+#if YDEV_PM_ACCOUNT
+        // 关中断时唤醒的中断尚未执行，两次时间戳之间只有睡眠
+        start = yDevGetTimeUS();
+#endif
+        __DSB();
+        __WFI();
+#if YDEV_PM_ACCOUNT
+        ydev_pm_cpu.sleep_us += yDevGetTimeUS() - start;
+        ydev_pm_cpu.sleeps++;
+#endif
+        __enable_irq();
+        return;
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    if (yDrvEnterStop((uint32_t)xExpectedIdleTime * portTICK_PERIOD_MS, &slept) != YDRV_OK)
+    {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        __enable_irq();
+        return;
+    }
+
+#if YDEV_PM_ACCOUNT
+    ydev_pm_cpu.stop_us += (uint64_t)slept * 1000U;
+    ydev_pm_cpu.stops++;
+#endif
+
+    // 重新开始一个完整的滴答周期，不足一个滴答的部分舍去
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    ticks = (TickType_t)(slept / portTICK_PERIOD_MS);
+    if (ticks > xExpectedIdleTime)
+    {
+        ticks = xExpectedIdleTime;
+    }
+    if (ticks != 0)
+    {
+        vTaskStepTick(ticks);
+    }
+
+    __enable_irq();
+}
+#endif
+
+/**
+ * @brief 获取系统毫秒计数
+ * @return size_t 上电以来的毫秒数
+ *
+ * @par 功能描述:
+ * 由yDrv的TIM17时基提供，调度器启动前和关闭调度时同样递增；
+ * 32位回绕，超时判断须写成(yDevGetTimeMS() - start) >= timeout
  */
 size_t yDevGetTimeMS(void)
 {
-    return ydev_time_ms;
+    return (size_t)yDrvGetTimeMs();
+}
+
+/**
+ * @brief 获取微秒时间戳
+ * @return uint32_t 上电以来的微秒数
+ *
+ * @par 功能描述:
+ * 由TIM17的1MHz计数扩展为32位，用于传输耗时统计和基准测试，约71.6分钟回绕
+ */
+uint32_t yDevGetTimeUS(void)
+{
+    return yDrvGetTimeUs();
 }
 
 // ==================== yDev结构体基础初始化函数实现 ====================
@@ -286,6 +2685,9 @@ void yDevConfigStructInit(yDevConfig_t *config)
     }
 
     config->type = YDEV_TYPE_MAX;
+    config->use_mutex = 0;
+    config->name = NULL;
+    config->idle_ms = 0;
 }
 
 void yDevHandleStructInit(yDevHandle_t *handle)
@@ -297,4 +2699,22 @@ void yDevHandleStructInit(yDevHandle_t *handle)
 
     handle->index = 0;
     handle->timeOutMs = 0;
+    memset(handle->async, 0, sizeof(handle->async));
+    yDevWaitqInit(&handle->waitq);
+    handle->revents = 0;
+    handle->poll_task = NULL;
+    handle->state = YDEV_STATE_UNINITIALIZED;
+    handle->active = 0;
+    handle->idle_ms = 0;
+    handle->last_ms = 0;
+    handle->refs = 0;
+#if YDEV_USE_MUTEX
+    handle->mutex = NULL;
+#endif
+#if YDEV_STATS_ENABLE
+    yDev_StatsClear(handle->op_stats);
+#endif
+#if YDEV_PM_ACCOUNT
+    memset(&handle->pm_usage, 0, sizeof(handle->pm_usage));
+#endif
 }
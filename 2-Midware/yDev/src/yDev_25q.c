@@ -33,6 +33,17 @@
 #include "yDev_25q.h"
 #include "yDev_def.h"
 #include "yDrv_spi.h"
+#include "yDrv_dma.h"
+#include "yDev_dma.h"
+#include "yDrv_crc.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "os_static.h"
+
+#include "yLib_mempool.h"
+#include "yLib_probe.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -55,6 +66,41 @@ static const uint32_t IdentifyChip25q[YDEV_25Q_TYPE_UNKNOWN] = {
     [YDEV_25Q_TYPE_W25Q128] = 0xEF4019, // W25Q128
 };
 
+#if (YDEV_25Q_CACHE_POOL_LINES > 0)
+/**
+ * @brief 读缓存行静态内存分区
+ * @note 所有25Q句柄共用，首次开启缓存时创建
+ */
+YLIB_MEM_PARTITION_DECLARE(ydev_25q_cache, yDev25qCacheLine_t, YDEV_25Q_CACHE_POOL_LINES);
+static YLIB_MEM *ydev_25q_cache_pool = NULL;
+#endif
+
+/**
+ * @brief 等待芯片就绪的耗时，含编程和擦除完成前的轮询
+ */
+YLIB_PROBE_DEFINE(flash_busy);
+
+/**
+ * @brief 后台工作任务和异步写入定时器的静态存储
+ * @note 按句柄占用槽位，同一句柄重新初始化时取回原槽位，反初始化删除对象后释放
+ */
+OS_TASK_POOL_DEFINE(ydev_25q_task, YDEV_25Q_MAX, YDEV_25Q_ERASE_TASK_STACK);
+OS_TIMER_POOL_DEFINE(ydev_25q_timer, YDEV_25Q_MAX);
+OS_TIMER_POOL_DEFINE(ydev_25q_sleep, YDEV_25Q_MAX);
+OS_TIMER_POOL_DEFINE(ydev_25q_wback, YDEV_25Q_MAX);
+
+// SPI速率等级表，下标即速率等级，越大越快
+static const yDrvSpiSpeedLevel_t SpeedLevel25q[YDEV_25Q_SPEED_LEVEL_NUM] = {
+    YDRV_SPI_SPEED_LEVEL0,
+    YDRV_SPI_SPEED_LEVEL1,
+    YDRV_SPI_SPEED_LEVEL2,
+    YDRV_SPI_SPEED_LEVEL3,
+    YDRV_SPI_SPEED_LEVEL4,
+    YDRV_SPI_SPEED_LEVEL5,
+    YDRV_SPI_SPEED_LEVEL6,
+    YDRV_SPI_SPEED_LEVEL7,
+};
+
 // ==================== 私有函数声明 ====================
 
 /**
@@ -67,6 +113,17 @@ static const uint32_t IdentifyChip25q[YDEV_25Q_TYPE_UNKNOWN] = {
  * @note 进行SPI双向数据传输，支持单独发送或接收
  */
 static int32_t yDev25q_Spi_Transfer(yDevHandle_25q_t *handle, const void *tx_data, void *rx_buff, uint32_t size);
+
+/**
+ * @brief 25Q SPI分段传输函数
+ * @param handle 25Q设备句柄指针
+ * @param seg 分段描述符数组
+ * @param count 分段数量
+ * @retval int32_t 实际传输的总字节数
+ * @note 调用前CS须已选中；DMA可用且总长度达到阈值时整条链由DMA首尾相接搬运，
+ *       否则逐段调用yDev25q_Spi_Transfer
+ */
+static int32_t yDev25q_Spi_TransferSg(yDevHandle_25q_t *handle, const yDrvSpiSeg_t *seg, uint32_t count);
 /**
  * @brief 读取25Q Flash状态寄存器
  * @param handle 25Q设备句柄指针
@@ -111,30 +168,55 @@ static yDev25qType_t yDev25q_IdentifyChip(uint32_t jedec_id);
 /**
  * @brief 25Q Flash页编程操作
  * @param handle 25Q设备句柄指针
- * @param start_address 页编程起始地址 (必须页对齐)
- * @param data 页编程数据指针 (固定256字节)
+ * @param start_address 页编程起始地址
+ * @param data 页编程数据指针
+ * @param size 页编程数据大小，start_address + size 不得跨页
  * @retval yDrvStatus_t 操作状态
  *         - YDRV_OK: 页编程成功
  *         - YDRV_INVALID_PARAM: 参数无效
  *         - YDRV_TIMEOUT: 操作超时
  *         - YDRV_ERROR: SPI通信错误
- * @note 执行25Q Flash的页编程操作，地址必须页对齐，数据大小固定为256字节
+ * @note 执行25Q Flash的页编程操作并等待完成，只编程目标字节范围
  */
-static yDrvStatus_t yDev25q_WritePage(yDevHandle_25q_t *handle, uint32_t start_address, const uint8_t *data);
+static yDrvStatus_t yDev25q_WritePage(yDevHandle_25q_t *handle, uint32_t start_address,
+                                      const uint8_t *data, uint32_t size);
 
 /**
- * @brief 25Q脏数据检查操作
+ * @brief 启动25Q Flash页编程(不等待完成)
  * @param handle 25Q设备句柄指针
- * @param start_address 检查起始地址
- * @param size 检查数据大小
+ * @param start_address 编程起始地址
+ * @param data 编程数据指针
+ * @param size 编程数据大小，start_address + size 不得跨页
  * @retval yDrvStatus_t 操作状态
- * @retval YDRV_OK 数据干净（全部为0xFF）
- * @retval YDRV_ERROR 发现脏数据（非0xFF数据）
- * @retval YDRV_INVALID_PARAM 参数无效
- * @retval YDRV_TIMEOUT 操作超时
- * @note 读取指定地址范围的数据，检查是否存在脏数据，发现脏数据立即停止
+ *         - YDRV_OK: 命令和数据已发出，芯片进入编程状态
+ *         - YDRV_ERROR: SPI通信错误
+ * @note 调用方需保证芯片空闲，编程完成需通过BUSY位确认
+ */
+static yDrvStatus_t yDev25q_ProgramStart(yDevHandle_25q_t *handle, uint32_t start_address,
+                                         const uint8_t *data, uint32_t size);
+
+/**
+ * @brief 25Q读回校验准备实现
+ * @param handle 25Q设备句柄指针
+ * @param data 期望数据，NULL表示擦除后的0xFF
+ * @param size 校验长度
+ * @param expect 输出期望数据的CRC
+ * @retval uint8_t 1=已占用CRC单元，读回由DMA直接写入CRC；0=读回后逐块比较
+ */
+static uint8_t yDev25q_VerifyPrepare(yDevHandle_25q_t *handle, const uint8_t *data, uint32_t size, uint32_t *expect);
+
+/**
+ * @brief 25Q读回校验实现
+ * @param handle 25Q设备句柄指针
+ * @param address 校验起始地址
+ * @param data 期望数据，NULL表示擦除后的0xFF
+ * @param size 校验长度
+ * @param flag_crc yDev25q_VerifyPrepare的返回值
+ * @param expect 期望数据的CRC
+ * @retval yDrvStatus_t 操作状态，不一致时置YDEV_25Q_ERRNO_VERIFY_FAIL
  */
-// static yDrvStatus_t yDev25q_CheckDirty(yDevHandle_25q_t *handle, uint32_t start_address, uint32_t size);
+static yDrvStatus_t yDev25q_Verify(yDevHandle_25q_t *handle, uint32_t address, const uint8_t *data, uint32_t size,
+                                   uint8_t flag_crc, uint32_t expect);
 
 /**
  * @brief 25Q Flash擦除操作
@@ -151,806 +233,4733 @@ static yDrvStatus_t yDev25q_WritePage(yDevHandle_25q_t *handle, uint32_t start_a
  */
 static yDrvStatus_t yDev25q_Erase(yDevHandle_25q_t *handle, uint32_t start_address, uint32_t size);
 
-// ==================== 25Q配置和句柄初始化函数 ====================
+/**
+ * @brief 25Q擦除方式选择
+ * @param handle 25Q设备句柄指针
+ * @param address 当前擦除地址 (扇区对齐)
+ * @param remain 剩余擦除大小 (扇区整数倍)
+ * @retval uint8_t 本次使用的擦除类型索引 (geometry.eraseSize等数组下标)
+ * @note 以最小预期擦除耗时为目标混合4K/32K/64K命令，整片范围时比较全片擦除，同步擦除与后台擦除共用
+ */
+static uint8_t yDev25q_ErasePlan(yDevHandle_25q_t *handle, uint32_t address, uint32_t remain);
 
 /**
- * @brief 初始化25Q设备配置结构体
- * @param config 25Q设备配置结构体指针
- * @note 将配置结构体初始化为默认值，用户需要根据实际硬件修改引脚配置
+ * @brief 25Q几何参数填充默认值
+ * @param geometry 几何参数结构体指针
+ * @note 默认值对应W25Q系列：4KB/32KB/64KB擦除、256字节页
  */
-void yDev25qConfigStructInit(yDevConfig_25q_t *config)
-{
-    if (config == NULL)
-    {
-        return;
-    }
+static void yDev25q_GeometryDefault(yDev25qGeometry_t *geometry);
 
-    // 初始化基础配置
-    yDevConfigStructInit(&config->base);
+/**
+ * @brief 读取25Q SFDP数据
+ * @param handle 25Q设备句柄指针
+ * @param address SFDP地址
+ * @param buffer 数据缓冲区指针
+ * @param size 读取大小
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_SfdpRead(yDevHandle_25q_t *handle, uint32_t address, void *buffer, uint32_t size);
 
-    // 初始化25Q特定配置为默认值
-    config->spiId = YDRV_SPI_SOFT;         // 默认使用软件SPI
-    config->dataBits = 8;                  // 8位数据
-    config->crc = 0;                       // 不使用CRC
-    config->csMode = YDRV_SPI_CS_SOFT;     // 软件控制CS
-    config->speed = YDRV_SPI_SPEED_LEVEL0; // 默认速度等级0
+/**
+ * @brief 解析25Q SFDP基本参数表
+ * @param handle 25Q设备句柄指针
+ * @retval yDrvStatus_t 操作状态
+ *         - YDRV_OK: 已从SFDP填充几何参数和容量
+ *         - YDRV_ERROR: 芯片不支持SFDP或参数表无效，几何参数保持默认值
+ * @note 解析JESD216基本参数表的容量(DW2)、擦除类型(DW8/9)、擦除耗时(DW10)和页编程耗时(DW11)
+ */
+static yDrvStatus_t yDev25q_ReadSfdp(yDevHandle_25q_t *handle);
 
-    // 默认引脚配置（用户需要根据实际硬件修改）
-    config->sckPin = YDRV_PINNULL;  // SCK引脚
-    config->misoPin = YDRV_PINNULL; // MISO引脚
-    config->mosiPin = YDRV_PINNULL; // MOSI引脚
-    config->csPin = YDRV_PINNULL;   // CS引脚
+/**
+ * @brief SFDP擦除耗时字段转换为毫秒
+ * @param count 耗时计数字段 (5位)
+ * @param unit 单位字段 (2位)
+ * @retval uint32_t 耗时(毫秒)
+ */
+static uint32_t yDev25q_SfdpEraseTime(uint32_t count, uint32_t unit);
 
-    // 默认复用功能
-    config->sckAF = 0;  // 复用功能0
-    config->misoAF = 0; // 复用功能0
-    config->mosiAF = 0; // 复用功能0
-    config->csAF = 0;   // 复用功能0
-}
+/**
+ * @brief 启动25Q擦除操作(不等待完成)
+ * @param handle 25Q设备句柄指针
+ * @param address 擦除地址
+ * @param cmd 擦除命令
+ * @retval yDrvStatus_t 操作状态
+ * @note 写使能和擦除命令各占一次片选周期，调用方需保证芯片空闲
+ */
+static yDrvStatus_t yDev25q_EraseStart(yDevHandle_25q_t *handle, uint32_t address, uint8_t cmd);
 
 /**
- * @brief 初始化25Q设备句柄结构体
- * @param handle 25Q设备句柄结构体指针
- * @note 将句柄结构体初始化为默认值
+ * @brief 25Q发送单字节命令
+ * @param handle 25Q设备句柄指针
+ * @param cmd 命令字节
+ * @retval yDrvStatus_t 操作状态
  */
-void yDev25qHandleStructInit(yDevHandle_25q_t *handle)
-{
-    if (handle == NULL)
-    {
-        return;
-    }
+static yDrvStatus_t yDev25q_SendCmd(yDevHandle_25q_t *handle, uint8_t cmd);
 
-    // 初始化基础句柄和SPI句柄
-    yDevHandleStructInit(&handle->base);
-    yDrvSpiHandleStructInit(&handle->spi_handle);
+/**
+ * @brief 25Q进入深度掉电
+ * @param handle 25Q设备句柄指针
+ * @param flag_spi_off 非0时同时关闭独占SPI的时钟
+ * @retval yDrvStatus_t 操作状态，芯片编程或擦除中返回YDRV_BUSY
+ * @note 调用方须持有总线锁
+ */
+static yDrvStatus_t yDev25q_PowerDown(yDevHandle_25q_t *handle, uint8_t flag_spi_off);
 
-    // 初始化25Q特定参数为默认值
-    handle->chip_type = YDEV_25Q_TYPE_UNKNOWN;
-    handle->size = 0;
-    handle->align = 0;
-    handle->address = 0;
-}
+/**
+ * @brief 25Q退出深度掉电
+ * @param handle 25Q设备句柄指针
+ * @retval yDrvStatus_t 操作状态
+ * @note 调用方须持有总线锁；先恢复SPI时钟，发送释放命令后等待tRES1
+ */
+static yDrvStatus_t yDev25q_PowerUp(yDevHandle_25q_t *handle);
 
-// ==================== 25Q设备操作函数实现 ====================
+/**
+ * @brief 写入25Q状态寄存器实现
+ * @param handle 25Q设备句柄指针
+ * @param reg 寄存器号1~3
+ * @param value 写入值
+ * @param flag_volatile 非0时使用易失性写使能，不等待tW
+ * @retval yDrvStatus_t 操作状态，回读与写入值不同时置YDEV_25Q_ERRNO_WRITE_PROTECTED
+ */
+static yDrvStatus_t yDev25q_WriteStatus(yDevHandle_25q_t *handle, uint8_t reg, uint8_t value, uint8_t flag_volatile);
 
 /**
- * @brief 25Q设备初始化
- * @param config 25Q设备配置参数指针
+ * @brief 读取25Q 64位唯一ID实现
  * @param handle 25Q设备句柄指针
- * @retval yDevStatus_t 初始化状态
- *         - YDEV_OK: 初始化成功
- *         - YDEV_INVALID_PARAM: 参数无效
- *         - YDEV_ERROR: 初始化失败
- * @note 初始化25Q设备，配置底层SPI驱动参数并识别芯片型号
+ * @param id 输出8字节ID
+ * @retval yDrvStatus_t 操作状态
  */
-static yDevStatus_t yDev_25q_Init(void *config, void *handle)
-{
-    yDevConfig_25q_t *config_25q;
-    yDevHandle_25q_t *handle_25q;
-    yDrvSpiConfig_t spi_config;
-    uint32_t jedec_id;
+static yDrvStatus_t yDev25q_ReadUniqueId(yDevHandle_25q_t *handle, uint8_t *id);
 
-    // 参数有效性检查
-    if ((handle == NULL) || (config == NULL))
-    {
-        return YDEV_INVALID_PARAM;
-    }
+/**
+ * @brief 25Q空闲自动掉电定时器回调实现
+ * @param timer 定时器句柄，ID为25Q设备句柄
+ */
+static void yDev25q_SleepTimerCallback(TimerHandle_t timer);
 
-    handle_25q = (yDevHandle_25q_t *)handle;
-    config_25q = (yDevConfig_25q_t *)config;
+/**
+ * @brief 以读取类别获取25Q SPI总线
+ * @param handle 25Q设备句柄指针
+ * @note 调度器未运行时直接返回；芯片掉电时加锁后先唤醒
+ */
+static void yDev25q_Lock(yDevHandle_25q_t *handle);
 
-    // 构建SPI配置
-    yDrvSpiConfigStructInit(&spi_config);
-    spi_config.spiId = config_25q->spiId;
-    spi_config.direction = YDRV_SPI_DIR_2LINES_FULL_DUPLEX; // 默认全双工
-    spi_config.dataBits = config_25q->dataBits;
-    spi_config.crc = config_25q->crc;
-    spi_config.mode = YDRV_SPI_MODE_MASTER;
-    spi_config.polarity = YDRV_SPI_POLARITY_LOW;
-    spi_config.phase = YDRV_SPI_PHASE_1EDGE;
-    spi_config.csMode = config_25q->csMode;
-    spi_config.speed = config_25q->speed;
-    spi_config.bitOrder = YDRV_SPI_BITORDER_MSB;
-    spi_config.sckPin = config_25q->sckPin;
-    spi_config.misoPin = config_25q->misoPin;
-    spi_config.mosiPin = config_25q->mosiPin;
-    spi_config.csPin = config_25q->csPin;
-    spi_config.sckAF = config_25q->sckAF;
-    spi_config.misoAF = config_25q->misoAF;
-    spi_config.mosiAF = config_25q->mosiAF;
-    spi_config.csAF = config_25q->csAF;
+/**
+ * @brief 按作业类别获取25Q SPI总线
+ * @param handle 25Q设备句柄指针
+ * @param cls 作业类别，在总线等待队列中按类别和截止时间排序
+ * @note 等待队列满时稍后重试，不会返回未持有总线的状态
+ */
+static void yDev25q_LockJob(yDevHandle_25q_t *handle, yDevBusJobClass_t cls);
 
-    // 初始化SPI驱动
-    if (yDrvSpiInitStatic(&spi_config, &handle_25q->spi_handle) != YDRV_OK)
-    {
-        return YDEV_ERROR;
-    }
+/**
+ * @brief 不等待地获取25Q SPI总线
+ * @param handle 25Q设备句柄指针
+ * @retval yDrvStatus_t YDRV_OK已持有总线，YDRV_BUSY总线被占用
+ * @note 供定时器服务任务使用，不能在其中阻塞；芯片掉电时加锁后先唤醒
+ */
+static yDrvStatus_t yDev25q_TryLock(yDevHandle_25q_t *handle);
 
-    // 读取JEDEC ID并识别芯片型号
-    jedec_id = yDev25qReadJedecId(handle_25q);
-    handle_25q->chip_type = yDev25q_IdentifyChip(jedec_id);
+/**
+ * @brief 释放25Q SPI总线
+ * @param handle 25Q设备句柄指针
+ */
+static void yDev25q_Unlock(yDevHandle_25q_t *handle);
 
-    // 根据芯片型号识别结果设置Flash大小
-    if (handle_25q->chip_type == YDEV_25Q_TYPE_UNKNOWN)
-    {
-        handle_25q->base.errno = YDEV_25Q_ERRNO_CHIP_NOT_FOUND;
-        yDrvSpiDeInitStatic(&handle_25q->spi_handle);
-        return YDEV_ERROR;
-    }
+/**
+ * @brief 取25Q所在总线的作业调度器
+ * @param handle 25Q设备句柄指针
+ * @return 共享总线时为总线的调度器，独占总线时为句柄内的调度器
+ */
+static yDevBusSched_t *yDev25q_Sched(yDevHandle_25q_t *handle);
 
-    // 根据JEDEC ID计算Flash容量
-    // JEDEC ID格式: [制造商ID(8位)][设备类型(8位)][容量ID(8位)]
-    // 容量ID对应关系: 0x15=2MB, 0x16=4MB, 0x17=8MB, 0x18=16MB, 0x19=32MB
-    uint8_t capacity_id = jedec_id & 0xFF;
-    if (capacity_id >= 0x10 && capacity_id <= 0x20)
-    {
-        handle_25q->size = 1UL << capacity_id; // 2^capacity_id 字节
-    }
-    else
-    {
-        handle_25q->size = 2 * 1024 * 1024; // 默认2MB
-    }
+/**
+ * @brief 数据段是否可用DMA
+ * @param handle 25Q设备句柄指针
+ * @return DMA可用且传输方式未限制为轮询或中断时为1
+ */
+static uint8_t yDev25q_UseDma(yDevHandle_25q_t *handle);
 
-    return YDEV_OK;
-}
+/**
+ * @brief 数据段是否可用中断
+ * @param handle 25Q设备句柄指针
+ * @return 中断可用且传输方式未限制为轮询或DMA时为1
+ */
+static uint8_t yDev25q_UseIrq(yDevHandle_25q_t *handle);
 
 /**
- * @brief 25Q设备反初始化
+ * @brief 25Q长作业的安全点，有更紧急的作业等待时让出总线
  * @param handle 25Q设备句柄指针
- * @retval yDevStatus_t 操作状态
- *         - YDEV_OK: 反初始化成功
- *         - YDEV_INVALID_PARAM: 参数无效
- *         - YDEV_ERROR: 反初始化失败
- * @note 释放25Q设备资源，反初始化底层SPI驱动
+ * @param limit 只让给类别小于该值的作业
+ * @retval uint8_t 1=已让出并重新获得总线, 0=未让出
+ * @note 调用方须持有总线且芯片不在编程中；让出期间芯片可能被掉电，重新获得后先唤醒
  */
-static yDevStatus_t yDev_25q_Deinit(void *handle)
-{
-    yDevHandle_25q_t *handle_25q;
+static uint8_t yDev25q_Yield(yDevHandle_25q_t *handle, yDevBusJobClass_t limit);
 
-    // 参数有效性检查
-    if (handle == NULL)
-    {
-        return YDEV_INVALID_PARAM;
-    }
+/**
+ * @brief 等待同步擦除完成
+ * @param handle 25Q设备句柄指针
+ * @param timeout_ms 擦除超时时间(毫秒)，不含挂起让出的时间
+ * @retval yDrvStatus_t 操作状态
+ * @note 轮询间隙有读取类作业等待时挂起擦除并让出总线，恢复后继续等待
+ */
+static yDrvStatus_t yDev25q_EraseWait(yDevHandle_25q_t *handle, uint32_t timeout_ms);
 
-    handle_25q = (yDevHandle_25q_t *)handle;
+/**
+ * @brief 挂起25Q后台擦除
+ * @param handle 25Q设备句柄指针
+ * @retval uint8_t 1=已挂起需恢复, 0=无需挂起
+ */
+static uint8_t yDev25q_EraseSuspend(yDevHandle_25q_t *handle);
 
-    // 反初始化SPI驱动
-    if (yDrvSpiDeInitStatic(&handle_25q->spi_handle) != YDRV_OK)
-    {
-        return YDEV_ERROR;
-    }
+/**
+ * @brief 25Q等待后台擦除完成
+ * @param handle 25Q设备句柄指针
+ * @note 调度器未运行时工作任务不会推进，改为在调用者中忙等
+ */
+static void yDev25q_EraseWaitIdle(yDevHandle_25q_t *handle);
 
-    // 重置设备状态
-    handle_25q->chip_type = YDEV_25Q_TYPE_UNKNOWN;
-    handle_25q->size = 0;
+/**
+ * @brief 25Q后台擦除工作任务
+ * @param arg 25Q设备句柄指针
+ * @note 低优先级任务，逐个扇区/块执行队列中的擦除请求
+ */
+static void yDev25q_EraseTask(void *arg);
 
-    return YDEV_OK;
-}
+/**
+ * @brief 按需创建25Q后台工作任务
+ * @param handle 25Q设备句柄指针
+ * @retval yDevStatus_t 操作状态
+ * @note 没有总线互斥锁时不能与其他任务并发访问芯片，返回YDEV_NOT_SUPPORTED
+ */
+static yDevStatus_t yDev25q_WorkerStart(yDevHandle_25q_t *handle);
 
 /**
- * @brief 25Q设备读取操作
+ * @brief 在工作任务中执行后台读取请求
  * @param handle 25Q设备句柄指针
- * @param buffer 读取数据缓冲区指针
+ * @note 没有请求时直接返回；读取擦除中的区域时与前台读取一样挂起擦除
+ */
+static void yDev25q_WorkerRead(yDevHandle_25q_t *handle);
+
+/**
+ * @brief yDev异步写入完成回调
+ * @param arg 25Q设备句柄指针
+ * @param status 写入结果
+ * @note 推进当前操作地址并通知yDev核心
+ */
+static void yDev25q_DevWriteDone(void *arg, yDevStatus_t status);
+
+/**
+ * @brief 25Q读取数据
+ * @param handle 25Q设备句柄指针
+ * @param read_buff 读取数据缓冲区指针
  * @param size 读取数据大小
  * @retval int32_t 实际读取的字节数，-1表示错误
- * @note 从25Q Flash中读取数据，使用设备句柄中的address字段作为起始地址
+ * @note 从handle->address开始读取并推进地址，调用方须完成参数检查并持有总线锁
  */
-static int32_t yDev_25q_Read(void *handle, void *buffer, uint16_t size)
-{
-    yDevHandle_25q_t *handle_25q;
-    uint8_t *read_buff;
-    uint32_t start_time;
-    uint32_t index;
-    uint8_t write_data;
-    uint8_t read_cmd[4];
-    uint32_t len;
+static int32_t yDev25q_ReadData(yDevHandle_25q_t *handle, uint8_t *read_buff, uint32_t size);
 
-    // 参数有效性检查
-    if ((handle == NULL) || (buffer == NULL) || (size == 0))
-    {
-        return -1;
-    }
+/**
+ * @brief 设置25Q SPI速率等级
+ * @param handle 25Q设备句柄指针
+ * @param level 速率等级(0~7)
+ * @retval yDrvStatus_t 操作状态
+ * @note 共享总线时同步更新器件参数和总线当前参数
+ */
+static yDrvStatus_t yDev25q_SetSpeed(yDevHandle_25q_t *handle, uint8_t level);
 
-    handle_25q = (yDevHandle_25q_t *)handle;
-    read_buff = (uint8_t *)buffer;
+/**
+ * @brief 校准25Q SPI时钟
+ * @param handle 25Q设备句柄指针
+ * @param result 校准结果指针，可为NULL
+ * @retval yDrvStatus_t 操作状态
+ * @note 最低速率读取JEDEC ID和存储区首部数据作为参考，再从最快速率向下逐级比对；
+ *       最快通过等级不是硬件上限时退一级留出余量
+ * @note 调用前须持有总线锁
+ */
+static yDrvStatus_t yDev25q_SpeedTune(yDevHandle_25q_t *handle, yDev25qSpeedTune_t *result);
 
-    // 检查地址有效性
-    if ((handle_25q->address + size) > handle_25q->size)
+/**
+ * @brief 25Q写入数据
+ * @param handle 25Q设备句柄指针
+ * @param write_buff 写入数据缓冲区指针
+ * @param size 写入数据大小
+ * @retval int32_t 实际写入的字节数，-1表示错误
+ * @note 从handle->address开始按页写入并推进地址，调用方须完成参数检查并持有总线锁
+ */
+static int32_t yDev25q_WriteData(yDevHandle_25q_t *handle, const uint8_t *write_buff, uint32_t size);
+
+/**
+ * @brief 设置25Q读缓存行数
+ * @param handle 25Q设备句柄指针
+ * @param lines 缓存行数，0=关闭缓存
+ * @retval uint32_t 实际分配的缓存行数
+ * @note 先释放已有缓存行，再从共享内存分区申请，分区不足时按实际可用行数开启
+ */
+static uint32_t yDev25q_CacheSetup(yDevHandle_25q_t *handle, uint32_t lines);
+
+/**
+ * @brief 25Q经缓存读取数据
+ * @param handle 25Q设备句柄指针
+ * @param read_buff 读取数据缓冲区指针
+ * @param size 读取数据大小
+ * @retval int32_t 实际读取的字节数，-1表示错误
+ * @note 按页查找缓存，未命中时整页读入最久未使用的缓存行
+ */
+static int32_t yDev25q_CacheRead(yDevHandle_25q_t *handle, uint8_t *read_buff, uint32_t size);
+
+/**
+ * @brief 使25Q读缓存中指定范围失效
+ * @param handle 25Q设备句柄指针
+ * @param address 起始地址
+ * @param size 范围大小
+ * @retval 无
+ */
+static void yDev25q_CacheInvalidate(yDevHandle_25q_t *handle, uint32_t address, uint32_t size);
+
+/**
+ * @brief 设置25Q写回缓冲页数
+ * @param handle 25Q设备句柄指针
+ * @param pages 缓冲页数，0=关闭
+ * @retval uint32_t 实际分配的页数
+ * @note 调用方须先写出已缓冲的数据；与读缓存共用内存分区，分区不足时按实际可用页数开启
+ */
+static uint32_t yDev25q_WbackSetup(yDevHandle_25q_t *handle, uint32_t pages);
+
+/**
+ * @brief 25Q经写回缓冲写入数据
+ * @param handle 25Q设备句柄指针
+ * @param write_buff 写入数据缓冲区指针
+ * @param size 写入数据大小
+ * @retval int32_t 实际写入(含缓冲)的字节数，-1表示错误
+ * @note 从handle->address开始，不在缓冲中的整页直接编程，其余并入缓冲页，页满即写出；
+ *       没有空闲缓冲页时先写出最久未写入的页
+ */
+static int32_t yDev25q_WbackWrite(yDevHandle_25q_t *handle, const uint8_t *write_buff, uint32_t size);
+
+/**
+ * @brief 写出25Q写回缓冲中的全部数据
+ * @param handle 25Q设备句柄指针
+ * @retval yDrvStatus_t 操作状态，任何一页编程失败返回错误
+ * @note 调用方须持有总线锁；失败的页同样被丢弃，错误记入errno
+ */
+static yDrvStatus_t yDev25q_WbackFlush(yDevHandle_25q_t *handle);
+
+/**
+ * @brief 写出25Q写回缓冲的一页
+ * @param handle 25Q设备句柄指针
+ * @param i 缓冲页序号
+ * @retval yDrvStatus_t 操作状态
+ * @note 无论成功与否都清空该页，失败记入errno
+ */
+static yDrvStatus_t yDev25q_WbackFlushLine(yDevHandle_25q_t *handle, uint32_t i);
+
+/**
+ * @brief 用写回缓冲中的数据修正读出的数据
+ * @param handle 25Q设备句柄指针
+ * @param address 读取起始地址
+ * @param buffer 已读出的数据
+ * @param size 数据大小
+ * @note 按位与缓冲中的字节，结果即写出后Flash中的内容
+ */
+static void yDev25q_WbackOverlay(yDevHandle_25q_t *handle, uint32_t address, uint8_t *buffer, uint32_t size);
+
+/**
+ * @brief 丢弃写回缓冲中落在擦除范围内的页
+ * @param handle 25Q设备句柄指针
+ * @param address 擦除起始地址
+ * @param size 擦除大小
+ * @note 擦除前写入的数据本来就会被擦除，不必写出
+ */
+static void yDev25q_WbackDrop(yDevHandle_25q_t *handle, uint32_t address, uint32_t size);
+
+/**
+ * @brief 25Q写回缓冲超时定时器回调
+ * @param timer 定时器句柄，ID为25Q设备句柄
+ * @note 在定时器服务任务中执行，只通知工作任务写出
+ */
+static void yDev25q_WbackTimerCallback(TimerHandle_t timer);
+
+/**
+ * @brief 在工作任务中写出超时的写回缓冲
+ * @param handle 25Q设备句柄指针
+ */
+static void yDev25q_WorkerFlush(yDevHandle_25q_t *handle);
+
+/**
+ * @brief 设置25Q顺序读取预读页数
+ * @param handle 25Q设备句柄指针
+ * @param pages 预读页数，0=关闭
+ * @retval uint32_t 实际分配的页数
+ * @note 调用方须持有总线锁；与读缓存共用内存分区，分区不足时按实际可用页数开启
+ */
+static uint32_t yDev25q_PrefetchSetup(yDevHandle_25q_t *handle, uint32_t pages);
+
+/**
+ * @brief 从25Q预读缓冲读取数据
+ * @param handle 25Q设备句柄指针
+ * @param address 读取起始地址
+ * @param read_buff 读取数据缓冲区指针
+ * @param size 读取数据大小
+ * @retval uint32_t 从缓冲取得的字节数，起始地址不在缓冲中时为0
+ * @note 调用方须持有总线锁；只取从起始地址开始连续命中的部分
+ */
+static uint32_t yDev25q_PrefetchRead(yDevHandle_25q_t *handle, uint32_t address, uint8_t *read_buff, uint32_t size);
+
+/**
+ * @brief 根据本次读取推进25Q预读窗口
+ * @param handle 25Q设备句柄指针
+ * @param address 本次读取起始地址
+ * @param size 本次读取的字节数
+ * @note 调用方须持有总线锁；顺序读取时丢弃已读过的页，空出一半以上的页时请求工作任务补充，
+ *       非顺序读取时撤销未执行的补充请求
+ */
+static void yDev25q_PrefetchAdvance(yDevHandle_25q_t *handle, uint32_t address, uint32_t size);
+
+/**
+ * @brief 使25Q预读缓冲中指定范围失效
+ * @param handle 25Q设备句柄指针
+ * @param address 起始地址
+ * @param size 范围大小
+ * @note 范围与缓冲重叠时清空整个缓冲并撤销补充请求，下一次顺序读取重新开始预读
+ */
+static void yDev25q_PrefetchInvalidate(yDevHandle_25q_t *handle, uint32_t address, uint32_t size);
+
+/**
+ * @brief 在工作任务中补充25Q预读缓冲
+ * @param handle 25Q设备句柄指针
+ * @note 以后台作业持锁，一次片选把窗口之后的数据读入空闲页，长度达到阈值时整条链走DMA
+ */
+static void yDev25q_WorkerPrefetch(yDevHandle_25q_t *handle);
+
+/**
+ * @brief 初始化25Q DMA读取通道
+ * @param config 25Q设备配置结构体指针
+ * @param handle 25Q设备句柄指针
+ * @retval yDrvStatus_t 操作状态
+ * @note 由SPI驱动DMA传输引擎管理收发通道和中断，成功后置位flagDma
+ */
+static yDrvStatus_t yDev25q_DmaInit(yDevConfig_25q_t *config, yDevHandle_25q_t *handle);
+
+/**
+ * @brief 25Q DMA批量传输数据
+ * @param handle 25Q设备句柄指针
+ * @param tx_data 发送数据缓冲区指针，为NULL时发送0xFF
+ * @param rx_buff 接收数据缓冲区指针，为NULL时丢弃接收数据
+ * @param size 传输数据大小 (不超过YDEV_25Q_DMA_MAX_SIZE)
+ * @retval int32_t 实际传输的字节数
+ * @note 调用前CS须保持选中；调度器运行时调用任务阻塞等待完成通知
+ */
+static int32_t yDev25q_DmaTransfer(yDevHandle_25q_t *handle, const void *tx_data, void *rx_buff, uint32_t size);
+
+/**
+ * @brief 25Q DMA分段传输数据
+ * @param handle 25Q设备句柄指针
+ * @param seg 分段描述符数组 (每段不超过YDEV_25Q_DMA_MAX_SIZE)
+ * @param count 分段数量
+ * @param total 各分段总字节数
+ * @retval int32_t 实际传输的字节数
+ * @note 调用前CS须保持选中；调度器运行时调用任务阻塞等待完成通知
+ */
+static int32_t yDev25q_DmaTransferSg(yDevHandle_25q_t *handle, const yDrvSpiSeg_t *seg, uint32_t count, uint32_t total);
+
+/**
+ * @brief 25Q中断驱动传输数据
+ * @param handle 25Q设备句柄指针
+ * @param tx_data 发送数据缓冲区指针，为NULL时发送0xFF
+ * @param rx_buff 接收数据缓冲区指针，为NULL时丢弃接收数据
+ * @param size 传输数据大小
+ * @retval int32_t 实际传输的字节数
+ * @note 仅在调度器运行时使用，调用任务阻塞等待完成通知，期间CPU可执行其他任务
+ */
+static int32_t yDev25q_ItTransfer(yDevHandle_25q_t *handle, const void *tx_data, void *rx_buff, uint32_t size);
+
+/**
+ * @brief 等待25Q异步传输完成
+ * @param handle 25Q设备句柄指针
+ * @param flag_wait 非0表示阻塞等待任务通知，0表示轮询完成标志
+ * @retval 无
+ */
+static void yDev25q_TransferWait(yDevHandle_25q_t *handle, uint8_t flag_wait);
+
+/**
+ * @brief 记录一次25Q SPI传输统计
+ * @param handle 25Q设备句柄指针
+ * @param counter 传输方式计数器指针(dma/irq/polled)
+ * @param request 请求的字节数
+ * @param done 实际传输的字节数
+ * @param start 传输开始时的yDevGetTimeUS时间戳
+ * @retval 无
+ */
+static void yDev25q_StatsRecord(yDevHandle_25q_t *handle, uint32_t *counter,
+                                uint32_t request, uint32_t done, uint32_t start);
+
+/**
+ * @brief 25Q DMA/中断传输完成回调
+ * @param arg 25Q设备句柄指针
+ * @param status 传输结果
+ * @note 在DMA或SPI中断中执行，置位完成标志并唤醒等待任务
+ */
+static void yDev25q_DmaRxCallback(void *arg, yDrvStatus_t status);
+
+/**
+ * @brief 25Q异步写入发起下一页编程
+ * @param handle 25Q设备句柄指针
+ * @retval yDrvStatus_t 操作状态
+ * @note 按页边界切分剩余数据，只编程目标字节范围
+ */
+static yDrvStatus_t yDev25q_AsyncIssuePage(yDevHandle_25q_t *handle);
+
+/**
+ * @brief 25Q异步写入结束处理
+ * @param handle 25Q设备句柄指针
+ * @param status 写入结果
+ * @note 停止轮询定时器、清除忙标志并调用完成回调
+ */
+static void yDev25q_AsyncFinish(yDevHandle_25q_t *handle, yDevStatus_t status);
+
+/**
+ * @brief 25Q异步写入轮询定时器回调
+ * @param timer FreeRTOS软件定时器句柄
+ * @note 在定时器服务任务中执行，以较粗的周期查询BUSY位并推进页编程流水线；
+ *       只尝试一次获取总线，被占用时跳过本周期，不阻塞定时器服务任务
+ */
+static void yDev25q_AsyncTimerCallback(TimerHandle_t timer);
+
+// ==================== 25Q配置和句柄初始化函数 ====================
+
+/**
+ * @brief 初始化25Q设备配置结构体
+ * @param config 25Q设备配置结构体指针
+ * @note 将配置结构体初始化为默认值，用户需要根据实际硬件修改引脚配置
+ */
+void yDev25qConfigStructInit(yDevConfig_25q_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础配置
+    yDevConfigStructInit(&config->base);
+
+    // 初始化25Q特定配置为默认值
+    config->spiId = YDRV_SPI_SOFT;         // 默认使用软件SPI
+    config->dataBits = 8;                  // 8位数据
+    config->crc = 0;                       // 不使用CRC
+    config->csMode = YDRV_SPI_CS_SOFT;     // 软件控制CS
+    config->speed = YDRV_SPI_SPEED_LEVEL0; // 默认速度等级0
+
+    // 默认引脚配置（用户需要根据实际硬件修改）
+    config->sckPin = YDRV_PINNULL;  // SCK引脚
+    config->misoPin = YDRV_PINNULL; // MISO引脚
+    config->mosiPin = YDRV_PINNULL; // MOSI引脚
+    config->csPin = YDRV_PINNULL;   // CS引脚
+
+    // 默认复用功能
+    config->sckAF = YDRV_GPIO_AF_AUTO;  // 按引脚查复用表
+    config->misoAF = YDRV_GPIO_AF_AUTO; // 按引脚查复用表
+    config->mosiAF = YDRV_GPIO_AF_AUTO; // 按引脚查复用表
+    config->csAF = YDRV_GPIO_AF_AUTO;   // 按引脚查复用表
+
+    // 默认不使用DMA读取
+    config->dmaEnable = 0;
+
+    // 默认使用标准读取命令
+    config->fastRead = 0;
+    config->verify = 0;
+    config->rxDmaChannel = YDRV_DMA_CHANNEL_MAX;
+    config->txDmaChannel = YDRV_DMA_CHANNEL_MAX;
+}
+
+/**
+ * @brief 初始化25Q设备句柄结构体
+ * @param handle 25Q设备句柄结构体指针
+ * @note 将句柄结构体初始化为默认值
+ */
+void yDev25qHandleStructInit(yDevHandle_25q_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础句柄和SPI句柄
+    yDevHandleStructInit(&handle->base);
+    yDrvSpiHandleStructInit(&handle->spi_handle);
+    handle->spi = &handle->spi_handle;
+    memset(&handle->bus_device, 0, sizeof(handle->bus_device));
+
+    // 初始化25Q特定参数为默认值
+    handle->chip_type = YDEV_25Q_TYPE_UNKNOWN;
+    handle->size = 0;
+    handle->align = 0;
+    handle->address = 0;
+
+    // 初始化DMA相关参数
+    handle->flagDma = 0;
+    handle->flagIrq = 0;
+    handle->xferMode = YDEV_25Q_XFER_AUTO;
+    handle->flagFastRead = 0;
+    handle->flagVerify = 0;
+    handle->flagDmaDone = 0;
+    handle->dma_wait_task = NULL;
+
+    // 初始化异步写入状态
+    memset(&handle->async, 0, sizeof(handle->async));
+
+    // 初始化后台擦除状态
+    memset(&handle->erase, 0, sizeof(handle->erase));
+
+    // 空闲自动掉电默认关闭
+    memset(&handle->sleep, 0, sizeof(handle->sleep));
+
+    // 几何参数默认值，初始化时由SFDP覆盖
+    yDev25q_GeometryDefault(&handle->geometry);
+
+    // 读缓存和写回缓冲默认关闭，通过ioctl开启
+    memset(&handle->cache, 0, sizeof(handle->cache));
+    memset(&handle->wback, 0, sizeof(handle->wback));
+    memset(&handle->prefetch, 0, sizeof(handle->prefetch));
+
+    // 上电状态
+    handle->flagPowerDown = 0;
+    handle->flagSpiOff = 0;
+}
+
+// ==================== 25Q设备操作函数实现 ====================
+
+/**
+ * @brief 25Q设备初始化
+ * @param config 25Q设备配置参数指针
+ * @param handle 25Q设备句柄指针
+ * @retval yDevStatus_t 初始化状态
+ *         - YDEV_OK: 初始化成功
+ *         - YDEV_INVALID_PARAM: 参数无效
+ *         - YDEV_ERROR: 初始化失败
+ * @note 初始化25Q设备，配置底层SPI驱动参数并识别芯片型号
+ */
+static yDevStatus_t yDev_25q_Init(void *config, void *handle)
+{
+    yDevConfig_25q_t *config_25q;
+    yDevHandle_25q_t *handle_25q;
+    yDrvSpiConfig_t spi_config;
+    yDevSpiBusDeviceConfig_t bus_config;
+    uint32_t jedec_id;
+    int32_t slot;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    handle_25q = (yDevHandle_25q_t *)handle;
+    config_25q = (yDevConfig_25q_t *)config;
+
+    // 构建SPI配置
+    yDrvSpiConfigStructInit(&spi_config);
+    spi_config.spiId = config_25q->spiId;
+    spi_config.direction = YDRV_SPI_DIR_2LINES_FULL_DUPLEX; // 默认全双工
+    spi_config.dataBits = config_25q->dataBits;
+    spi_config.crc = config_25q->crc;
+    spi_config.mode = YDRV_SPI_MODE_MASTER;
+    spi_config.polarity = YDRV_SPI_POLARITY_LOW;
+    spi_config.phase = YDRV_SPI_PHASE_1EDGE;
+    spi_config.csMode = config_25q->csMode;
+    spi_config.speed = config_25q->speed;
+    spi_config.bitOrder = YDRV_SPI_BITORDER_MSB;
+    spi_config.sckPin = config_25q->sckPin;
+    spi_config.misoPin = config_25q->misoPin;
+    spi_config.mosiPin = config_25q->mosiPin;
+    spi_config.csPin = config_25q->csPin;
+    spi_config.sckAF = config_25q->sckAF;
+    spi_config.misoAF = config_25q->misoAF;
+    spi_config.mosiAF = config_25q->mosiAF;
+    spi_config.csAF = config_25q->csAF;
+
+    // 初始化SPI驱动，挂接共享总线时只配置本器件片选和速率
+    handle_25q->spi = &handle_25q->spi_handle;
+    memset(&handle_25q->bus_device, 0, sizeof(handle_25q->bus_device));
+    if (config_25q->bus != NULL)
+    {
+        bus_config = YDEV_SPIBUS_DEVICE_CONFIG_DEFAULT();
+        bus_config.csPin = config_25q->csPin;
+        bus_config.speed = config_25q->speed;
+        if (yDevSpiBusAttach(config_25q->bus, &handle_25q->bus_device, &bus_config) != YDEV_OK)
+        {
+            return YDEV_ERROR;
+        }
+        handle_25q->spi = &config_25q->bus->spi;
+    }
+    else if (yDrvSpiInitStatic(&spi_config, &handle_25q->spi_handle) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    // 记录当前速率等级
+    handle_25q->speedLevel = 0;
+    for (uint8_t i = 0; i < YDEV_25Q_SPEED_LEVEL_NUM; i++)
+    {
+        if (SpeedLevel25q[i] == config_25q->speed)
+        {
+            handle_25q->speedLevel = i;
+            break;
+        }
+    }
+
+    // 读取JEDEC ID并识别芯片型号，共享总线时持有总线完成识别
+    memset(&handle_25q->erase, 0, sizeof(handle_25q->erase));
+    memset(&handle_25q->stats, 0, sizeof(handle_25q->stats));
+    yDevBusSchedInit(&handle_25q->sched);
+    handle_25q->size = 0;
+    yDev25q_Lock(handle_25q);
+    jedec_id = yDev25qReadJedecId(handle_25q);
+    handle_25q->chip_type = yDev25q_IdentifyChip(jedec_id);
+
+    // 读取SFDP参数表获取几何参数，未知型号只要SFDP有效也可使用
+    yDev25q_GeometryDefault(&handle_25q->geometry);
+    if ((yDev25q_ReadSfdp(handle_25q) != YDRV_OK) &&
+        (handle_25q->chip_type == YDEV_25Q_TYPE_UNKNOWN))
+    {
+        yDev25q_Unlock(handle_25q);
+        handle_25q->base.errno = YDEV_25Q_ERRNO_CHIP_NOT_FOUND;
+        if (handle_25q->bus_device.bus != NULL)
+        {
+            yDevSpiBusDetach(&handle_25q->bus_device);
+        }
+        else
+        {
+            yDrvSpiDeInitStatic(handle_25q->spi);
+        }
+        return YDEV_ERROR;
+    }
+    yDev25q_Unlock(handle_25q);
+
+    // 根据JEDEC ID计算Flash容量
+    // JEDEC ID格式: [制造商ID(8位)][设备类型(8位)][容量ID(8位)]
+    // 容量ID对应关系: 0x15=2MB, 0x16=4MB, 0x17=8MB, 0x18=16MB, 0x19=32MB
+    // SFDP提供容量时以SFDP为准
+    uint8_t capacity_id = jedec_id & 0xFF;
+    if (handle_25q->size != 0)
+    {
+        // 容量已由SFDP给出
+    }
+    else if (capacity_id >= 0x10 && capacity_id <= 0x20)
+    {
+        handle_25q->size = 1UL << capacity_id; // 2^capacity_id 字节
+    }
+    else
+    {
+        handle_25q->size = 2 * 1024 * 1024; // 默认2MB
+    }
+
+    // 读缓存和预读默认关闭
+    memset(&handle_25q->cache, 0, sizeof(handle_25q->cache));
+    memset(&handle_25q->prefetch, 0, sizeof(handle_25q->prefetch));
+
+    // 全片擦除单元大小即芯片容量
+    handle_25q->geometry.eraseSize[YDEV_25Q_ERASE_TYPE_CHIP] = handle_25q->size;
+
+    // 后台擦除任务在首次提交擦除请求时创建
+
+    // 创建异步写入轮询定时器，实例数超过YDEV_25Q_MAX时异步写入接口不可用
+    memset(&handle_25q->async, 0, sizeof(handle_25q->async));
+    slot = OS_POOL_CLAIM(ydev_25q_timer, handle_25q);
+    if (slot >= 0)
+    {
+        handle_25q->async.timer = (void *)OS_TIMER_POOL_CREATE(ydev_25q_timer,
+                                                               slot,
+                                                               "25qAsync",
+                                                               pdMS_TO_TICKS(YDEV_25Q_ASYNC_POLL_MS),
+                                                               pdTRUE,
+                                                               handle_25q,
+                                                               yDev25q_AsyncTimerCallback);
+    }
+
+    // 创建空闲自动掉电定时器，由每次释放总线启动
+    memset(&handle_25q->sleep, 0, sizeof(handle_25q->sleep));
+    handle_25q->sleep.ms = config_25q->autoSleepMs;
+    slot = OS_POOL_CLAIM(ydev_25q_sleep, handle_25q);
+    if (slot >= 0)
+    {
+        handle_25q->sleep.timer = (void *)OS_TIMER_POOL_CREATE(ydev_25q_sleep,
+                                                               slot,
+                                                               "25qSleep",
+                                                               1,
+                                                               pdFALSE,
+                                                               handle_25q,
+                                                               yDev25q_SleepTimerCallback);
+    }
+
+    // 创建写回缓冲超时定时器，开启缓冲时设置周期
+    memset(&handle_25q->wback, 0, sizeof(handle_25q->wback));
+    slot = OS_POOL_CLAIM(ydev_25q_wback, handle_25q);
+    if (slot >= 0)
+    {
+        handle_25q->wback.timer = (void *)OS_TIMER_POOL_CREATE(ydev_25q_wback,
+                                                               slot,
+                                                               "25qWback",
+                                                               1,
+                                                               pdFALSE,
+                                                               handle_25q,
+                                                               yDev25q_WbackTimerCallback);
+    }
+
+    // 选择读取命令
+    handle_25q->flagFastRead = ((config_25q->fastRead != 0) && (handle_25q->geometry.fastRead != 0)) ? 1 : 0;
+    handle_25q->flagVerify = (config_25q->verify != 0) ? 1 : 0;
+
+    // 共享总线的中断和DMA传输引擎由总线登记
+    if (handle_25q->bus_device.bus != NULL)
+    {
+        handle_25q->flagIrq = config_25q->bus->flagIrq;
+        handle_25q->flagDma = config_25q->bus->flagDma;
+        return YDEV_OK;
+    }
+
+    // 硬件SPI登记中断传输，失败时中等长度传输退回轮询
+    handle_25q->flagIrq = 0;
+    if ((config_25q->spiId == YDRV_SPI_1) || (config_25q->spiId == YDRV_SPI_2))
+    {
+        if (yDrvSpiItInit(handle_25q->spi, YDEV_25Q_SPI_IRQ_PRIO) == YDRV_OK)
+        {
+            handle_25q->flagIrq = 1;
+        }
+    }
+
+    // 配置DMA批量读取，失败时退回轮询读取
+    handle_25q->flagDma = 0;
+    if (config_25q->dmaEnable != 0)
+    {
+        if (yDev25q_DmaInit(config_25q, handle_25q) != YDRV_OK)
+        {
+            handle_25q->flagDma = 0;
+        }
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 25Q设备反初始化
+ * @param handle 25Q设备句柄指针
+ * @retval yDevStatus_t 操作状态
+ *         - YDEV_OK: 反初始化成功
+ *         - YDEV_INVALID_PARAM: 参数无效
+ *         - YDEV_ERROR: 反初始化失败
+ * @note 释放25Q设备资源，反初始化底层SPI驱动
+ */
+static yDevStatus_t yDev_25q_Deinit(void *handle)
+{
+    yDevHandle_25q_t *handle_25q;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    handle_25q = (yDevHandle_25q_t *)handle;
+
+    // 异步读写或后台擦除进行中不允许反初始化
+    if ((handle_25q->async.busy != 0) || (handle_25q->erase.active != 0) ||
+        (handle_25q->erase.read.buffer != NULL))
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_BUSY;
+        return YDEV_BUSY;
+    }
+
+    // 写出并归还写回缓冲和预读页，工作任务删除前完成
+    yDev25q_LockJob(handle_25q, YDEV_BUSJOB_WRITE);
+    (void)yDev25q_WbackFlush(handle_25q);
+    yDev25q_WbackSetup(handle_25q, 0);
+    yDev25q_PrefetchSetup(handle_25q, 0);
+    yDev25q_Unlock(handle_25q);
+
+    // 删除后台擦除任务
+    if (handle_25q->erase.task != NULL)
+    {
+        vTaskDelete((TaskHandle_t)handle_25q->erase.task);
+        handle_25q->erase.task = NULL;
+    }
+    OS_POOL_RELEASE(ydev_25q_task, handle_25q);
+
+    // 删除异步写入定时器
+    if (handle_25q->async.timer != NULL)
+    {
+        xTimerDelete((TimerHandle_t)handle_25q->async.timer, portMAX_DELAY);
+        handle_25q->async.timer = NULL;
+    }
+    OS_POOL_RELEASE(ydev_25q_timer, handle_25q);
+
+    // 删除空闲自动掉电定时器
+    if (handle_25q->sleep.timer != NULL)
+    {
+        xTimerDelete((TimerHandle_t)handle_25q->sleep.timer, portMAX_DELAY);
+        handle_25q->sleep.timer = NULL;
+    }
+    OS_POOL_RELEASE(ydev_25q_sleep, handle_25q);
+
+    // 删除写回缓冲超时定时器
+    if (handle_25q->wback.timer != NULL)
+    {
+        xTimerDelete((TimerHandle_t)handle_25q->wback.timer, portMAX_DELAY);
+        handle_25q->wback.timer = NULL;
+    }
+    OS_POOL_RELEASE(ydev_25q_wback, handle_25q);
+
+    // 释放DMA通道和中断传输，共享总线的传输引擎归总线所有
+    if ((handle_25q->flagDma != 0) && (handle_25q->bus_device.bus == NULL))
+    {
+        yDrvSpiDmaDeInit(handle_25q->spi);
+    }
+    if ((handle_25q->flagIrq != 0) && (handle_25q->bus_device.bus == NULL))
+    {
+        yDrvSpiItDeInit(handle_25q->spi);
+    }
+    handle_25q->flagDma = 0;
+    handle_25q->flagIrq = 0;
+
+    // 归还读缓存行
+    yDev25q_CacheSetup(handle_25q, 0);
+
+    // 反初始化SPI驱动，共享总线时只分离本器件
+    if (handle_25q->bus_device.bus != NULL)
+    {
+        yDevSpiBusDetach(&handle_25q->bus_device);
+        handle_25q->spi = &handle_25q->spi_handle;
+    }
+    else if (yDrvSpiDeInitStatic(handle_25q->spi) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    // 重置设备状态
+    handle_25q->chip_type = YDEV_25Q_TYPE_UNKNOWN;
+    handle_25q->size = 0;
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 25Q设备读取操作
+ * @param handle 25Q设备句柄指针
+ * @param buffer 读取数据缓冲区指针
+ * @param size 读取数据大小
+ * @retval int32_t 实际读取的字节数，-1表示错误
+ * @note 从25Q Flash中读取数据，使用设备句柄中的address字段作为起始地址
+ */
+static int32_t yDev_25q_Read(void *handle, void *buffer, size_t size)
+{
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return -1;
+    }
+
+    return yDev25qRead((yDevHandle_25q_t *)handle, ((yDevHandle_25q_t *)handle)->address, buffer, size);
+}
+
+/**
+ * @brief 25Q设备长度读取
+ * @param handle_25q 25Q设备句柄指针
+ * @param address 读取起始地址
+ * @param buffer 读取数据缓冲区指针
+ * @param size 读取数据大小 (32位)
+ * @retval int32_t 实际读取的字节数，-1表示错误
+ * @note 单次片选内连续读取，读取完成后handle->address指向下一字节
+ */
+int32_t yDev25qRead(yDevHandle_25q_t *handle_25q, uint32_t address, void *buffer, uint32_t size)
+{
+    uint32_t done;
+    int32_t ret;
+    uint8_t suspended;
+
+    // 参数有效性检查
+    if ((handle_25q == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return -1;
+    }
+
+    handle_25q->address = address;
+
+    // 异步写入占用SPI总线
+    if (handle_25q->async.busy != 0)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_BUSY;
+        return -1;
+    }
+
+    // 检查地址有效性
+    if ((handle_25q->address + size) > handle_25q->size)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return -1;
+    }
+
+    // 后台擦除进行中时挂起擦除，读取完成后恢复
+    yDev25q_Lock(handle_25q);
+
+    // 预读缓冲命中的部分不访问芯片，剩余部分照常读取
+    done = yDev25q_PrefetchRead(handle_25q, address, (uint8_t *)buffer, size);
+    handle_25q->address = address + done;
+    ret = (int32_t)done;
+    if (done < size)
+    {
+        suspended = yDev25q_EraseSuspend(handle_25q);
+        if ((handle_25q->cache.count != 0) &&
+            ((size - done) <= (uint32_t)handle_25q->cache.count * YDEV_25Q_PAGE_SIZE))
+        {
+            // 小块读取经页缓存，大块顺序读取直接旁路避免冲刷缓存
+            ret = yDev25q_CacheRead(handle_25q, (uint8_t *)buffer + done, size - done);
+        }
+        else
+        {
+            ret = yDev25q_ReadData(handle_25q, (uint8_t *)buffer + done, size - done);
+        }
+        if (suspended != 0)
+        {
+            yDev25q_SendCmd(handle_25q, YDEV_25Q_CMD_ERASE_RESUME);
+        }
+        if (ret >= 0)
+        {
+            ret += (int32_t)done;
+        }
+        else if (done != 0)
+        {
+            ret = (int32_t)done;
+        }
+    }
+    if (ret > 0)
+    {
+        // 写回缓冲中尚未编程的数据覆盖读出的旧内容
+        yDev25q_WbackOverlay(handle_25q, address, (uint8_t *)buffer, (uint32_t)ret);
+        yDev25q_PrefetchAdvance(handle_25q, address, (uint32_t)ret);
+    }
+    yDev25q_Unlock(handle_25q);
+
+    return ret;
+}
+
+/**
+ * @brief 25Q读取数据实现
+ * @param handle_25q 25Q设备句柄指针
+ * @param read_buff 读取数据缓冲区指针
+ * @param size 读取数据大小
+ * @retval int32_t 实际读取的字节数，-1表示错误
+ */
+static int32_t yDev25q_ReadData(yDevHandle_25q_t *handle_25q, uint8_t *read_buff, uint32_t size)
+{
+    uint32_t index;
+    uint32_t chunk;
+    uint32_t done;
+    uint8_t read_cmd[5];
+    uint32_t cmd_len;
+
+    // 等待芯片就绪
+    if (yDev25q_WaitBusy(handle_25q, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+        return -1;
+    }
+
+    // 构建读取命令，快速读取在地址后附加一个空字节
+    yDrvSpiCsControl(handle_25q->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    read_cmd[0] = (handle_25q->flagFastRead != 0) ? YDEV_25Q_CMD_FAST_READ : YDEV_25Q_CMD_READ_DATA;
+    read_cmd[1] = (handle_25q->address >> 16) & 0xFF; // 地址高字节
+    read_cmd[2] = (handle_25q->address >> 8) & 0xFF;  // 地址中字节
+    read_cmd[3] = handle_25q->address & 0xFF;         // 地址低字节
+    read_cmd[4] = 0xFF;                               // 快速读取空字节
+    cmd_len = (handle_25q->flagFastRead != 0) ? 5 : 4;
+
+    if (yDev25q_Spi_Transfer(handle_25q, read_cmd, NULL, cmd_len) != (int32_t)cmd_len) // 发送读取命令和地址
+    {
+        yDrvSpiCsControl(handle_25q->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle_25q->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+        return -1;
+    }
+
+    // 大块读取使用DMA搬运数据，超过单次DMA长度时在同一片选内分段搬运
+    if ((yDev25q_UseDma(handle_25q) != 0) && (size >= YDEV_25Q_DMA_THRESHOLD))
+    {
+        index = 0;
+        while (index < size)
+        {
+            chunk = ((size - index) > YDEV_25Q_DMA_MAX_SIZE) ? YDEV_25Q_DMA_MAX_SIZE : (size - index);
+            done = (uint32_t)yDev25q_DmaTransfer(handle_25q, NULL, &read_buff[index], chunk);
+            index += done;
+            if (done != chunk)
+            {
+                handle_25q->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+                break;
+            }
+        }
+        yDrvSpiCsControl(handle_25q->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle_25q->address += index;
+        return (int32_t)index;
+    }
+
+    // 中短读取由SPI传输函数按长度选择中断或轮询
+    index = (uint32_t)yDev25q_Spi_Transfer(handle_25q, NULL, read_buff, size);
+    if (index != size)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+    }
+
+    yDrvSpiCsControl(handle_25q->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+
+    // 更新位置
+    handle_25q->address += index;
+
+    return (int32_t)index;
+}
+
+/**
+ * @brief 25Q设备向量读取操作
+ * @param handle 25Q设备句柄指针
+ * @param iov 分段描述符数组
+ * @param count 分段数量
+ * @retval int32_t 实际读取的总字节数，-1表示错误
+ * @note 从handle->address开始，一条读取命令后各分段在同一片选内首尾相接接收，
+ *       总长达到阈值时整条链由DMA搬运；不经过页缓存。
+ *       分段数超过YDEV_25Q_IOV_MAX或单段超过单次DMA长度时逐段读取
+ */
+static int32_t yDev_25q_Readv(void *handle, const yDevIoVec_t *iov, uint32_t count)
+{
+    yDevHandle_25q_t *handle_25q = (yDevHandle_25q_t *)handle;
+    yDrvSpiSeg_t seg[YDEV_25Q_IOV_MAX + 1];
+    uint8_t read_cmd[5];
+    uint32_t cmd_len;
+    uint32_t total;
+    uint32_t n;
+    uint32_t i;
+    int32_t ret;
+    int32_t done;
+    uint8_t suspended;
+
+    // 1. 构建分段链：命令+地址为第一段，后接各接收分段
+    cmd_len = (handle_25q->flagFastRead != 0) ? 5 : 4;
+    total = 0;
+    n = 1;
+    for (i = 0; i < count; i++)
+    {
+        if (iov[i].len == 0)
+        {
+            continue;
+        }
+        if ((n > YDEV_25Q_IOV_MAX) || (iov[i].len > YDEV_25Q_DMA_MAX_SIZE))
+        {
+            break;
+        }
+        seg[n].tx = NULL;
+        seg[n].rx = iov[i].base;
+        seg[n].len = (uint32_t)iov[i].len;
+        total += seg[n].len;
+        n++;
+    }
+
+    // 链放不下时逐段读取
+    if (i < count)
+    {
+        done = 0;
+        for (i = 0; i < count; i++)
+        {
+            if (iov[i].len == 0)
+            {
+                continue;
+            }
+            ret = yDev_25q_Read(handle, iov[i].base, iov[i].len);
+            if (ret < 0)
+            {
+                return (done > 0) ? done : ret;
+            }
+            done += ret;
+            if ((size_t)ret != iov[i].len)
+            {
+                break;
+            }
+        }
+        return done;
+    }
+
+    // 2. 与单次读取相同的状态和地址检查
+    if (handle_25q->async.busy != 0)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_BUSY;
+        return -1;
+    }
+    if ((handle_25q->address + total) > handle_25q->size)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return -1;
+    }
+
+    read_cmd[0] = (handle_25q->flagFastRead != 0) ? YDEV_25Q_CMD_FAST_READ : YDEV_25Q_CMD_READ_DATA;
+    read_cmd[1] = (handle_25q->address >> 16) & 0xFF; // 地址高字节
+    read_cmd[2] = (handle_25q->address >> 8) & 0xFF;  // 地址中字节
+    read_cmd[3] = handle_25q->address & 0xFF;         // 地址低字节
+    read_cmd[4] = 0xFF;                               // 快速读取空字节
+    seg[0].tx = read_cmd;
+    seg[0].rx = NULL;
+    seg[0].len = cmd_len;
+
+    // 3. 一次片选完成整条链，后台擦除进行中时挂起
+    yDev25q_Lock(handle_25q);
+    suspended = yDev25q_EraseSuspend(handle_25q);
+    if (yDev25q_WaitBusy(handle_25q, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+        done = -1;
+    }
+    else
+    {
+        yDrvSpiCsControl(handle_25q->spi, YDRV_SPI_CS_SELECT);
+        done = yDev25q_Spi_TransferSg(handle_25q, seg, n) - (int32_t)cmd_len;
+        yDrvSpiCsControl(handle_25q->spi, YDRV_SPI_CS_DESELECT);
+        if (done < 0)
+        {
+            handle_25q->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+            done = -1;
+        }
+        else
+        {
+            if ((uint32_t)done != total)
+            {
+                handle_25q->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+            }
+            for (i = 1, total = 0; (i < n) && (total < (uint32_t)done); i++)
+            {
+                yDev25q_WbackOverlay(handle_25q, handle_25q->address + total, (uint8_t *)seg[i].rx,
+                                     ((uint32_t)done - total < seg[i].len) ? (uint32_t)done - total : seg[i].len);
+                total += seg[i].len;
+            }
+            handle_25q->address += (uint32_t)done;
+        }
+    }
+    if (suspended != 0)
+    {
+        yDev25q_SendCmd(handle_25q, YDEV_25Q_CMD_ERASE_RESUME);
+    }
+    yDev25q_Unlock(handle_25q);
+
+    return done;
+}
+
+/**
+ * @brief 25Q设备写入操作 (页编程)
+ * @param handle 25Q设备句柄指针
+ * @param buffer 写入数据缓冲区指针
+ * @param size 写入数据大小
+ * @retval int32_t 实际写入的字节数，-1表示错误
+ * @note 向25Q Flash写入数据，自动处理页边界和写使能
+ * @note 使用设备句柄中的address字段作为起始地址
+ */
+static int32_t yDev_25q_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_25q_t *handle_25q;
+    int32_t ret;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return -1;
+    }
+
+    handle_25q = (yDevHandle_25q_t *)handle;
+
+    // 异步写入占用SPI总线
+    if (handle_25q->async.busy != 0)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_BUSY;
+        return -1;
+    }
+    // 检查地址有效性
+    if ((handle_25q->address + size) > handle_25q->size)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return -1;
+    }
+
+    // 等待已提交的后台擦除完成，保证擦除与写入顺序
+    yDev25q_EraseWaitIdle(handle_25q);
+
+    yDev25q_LockJob(handle_25q, YDEV_BUSJOB_WRITE);
+    if (handle_25q->wback.count != 0)
+    {
+        ret = yDev25q_WbackWrite(handle_25q, (const uint8_t *)buffer, size);
+    }
+    else
+    {
+        ret = yDev25q_WriteData(handle_25q, (const uint8_t *)buffer, size);
+    }
+    yDev25q_Unlock(handle_25q);
+
+    return ret;
+}
+
+/**
+ * @brief 25Q设备异步读取操作
+ * @param handle 25Q设备句柄指针
+ * @param buffer 读取数据缓冲区指针
+ * @param size 读取数据大小
+ * @retval yDevStatus_t 启动状态
+ * @note 请求交给后台工作任务执行，调用者不等待SPI传输；
+ *       工作任务优先级较低，读取在高优先级任务让出CPU后进行
+ */
+static yDevStatus_t yDev_25q_ReadAsync(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_25q_t *handle_25q = (yDevHandle_25q_t *)handle;
+    yDevStatus_t status;
+
+    // 检查地址有效性
+    if ((handle_25q->address + size) > handle_25q->size)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return YDEV_INVALID_PARAM;
+    }
+
+    status = yDev25q_WorkerStart(handle_25q);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+
+    // 缓冲区指针最后写入，工作任务看到非NULL时其余字段已就绪
+    handle_25q->erase.read.address = handle_25q->address;
+    handle_25q->erase.read.size = size;
+    handle_25q->erase.read.buffer = (uint8_t *)buffer;
+    handle_25q->address += size;
+    xTaskNotifyGive((TaskHandle_t)handle_25q->erase.task);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 25Q设备异步写入操作
+ * @param handle 25Q设备句柄指针
+ * @param buffer 写入数据缓冲区指针
+ * @param size 写入数据大小
+ * @retval yDevStatus_t 启动状态
+ * @note 基于yDev25qWriteAsync的页编程流水线，完成通知在定时器服务任务中发出；
+ *       只编程不擦除，目标区域应已擦除
+ */
+static yDevStatus_t yDev_25q_WriteAsync(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_25q_t *handle_25q = (yDevHandle_25q_t *)handle;
+
+    return yDev25qWriteAsync(handle_25q, handle_25q->address, buffer, size,
+                             yDev25q_DevWriteDone, handle_25q);
+}
+
+/**
+ * @brief 25Q写入数据实现
+ * @param handle_25q 25Q设备句柄指针
+ * @param write_buff 写入数据缓冲区指针
+ * @param size 写入数据大小
+ * @retval int32_t 实际写入的字节数，-1表示错误
+ */
+static int32_t yDev25q_WriteData(yDevHandle_25q_t *handle_25q, const uint8_t *write_buff, uint32_t size)
+{
+    uint32_t current_address;
+    uint32_t total_written;
+    uint32_t page_offset;
+    uint32_t write_size;
+
+    total_written = 0;
+    current_address = handle_25q->address;
+
+    // 按页写入数据循环
+    while (total_written < size)
+    {
+        // 计算当前页内偏移和本次写入大小
+        page_offset = current_address % YDEV_25Q_PAGE_SIZE;
+        write_size = YDEV_25Q_PAGE_SIZE - page_offset;
+        if (write_size > (size - total_written))
+        {
+            write_size = size - total_written;
+        }
+
+        // 只编程目标字节范围：NOR编程只能把1变0，旧数据原样重编程不改变内容，
+        // 读出整页再回写与直接编程目标范围结果相同，因此不再暂存整页
+        if (yDev25q_WritePage(handle_25q, current_address, &write_buff[total_written], write_size) != YDRV_OK)
+        {
+            handle_25q->base.errno |= YDEV_25Q_ERRNO_WRITE_FAIL;
+            return -1;
+        }
+
+        // 更新计数器和地址
+        total_written += write_size;
+        current_address += write_size;
+
+        // 页之间是安全点，更紧急的作业先执行
+        if (total_written < size)
+        {
+            (void)yDev25q_Yield(handle_25q, YDEV_BUSJOB_CLASS_MAX);
+        }
+    }
+
+    // 更新设备地址
+    handle_25q->address = current_address;
+
+    return (int32_t)total_written;
+}
+
+/**
+ * @brief 25Q设备控制操作
+ * @param handle 25Q设备句柄指针
+ * @param cmd 控制命令
+ * @param arg 命令参数指针
+ * @retval yDevStatus_t 操作状态
+ *         - YDEV_OK: 操作成功
+ *         - YDEV_INVALID_PARAM: 参数无效
+ *         - YDEV_NOT_SUPPORTED: 不支持的命令
+ *         - YDEV_ERROR: 操作失败
+ * @note 执行25Q设备的控制操作，如芯片擦除、读取JEDEC ID等
+ */
+static yDevStatus_t yDev_25q_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_25q_t *handle_25q;
+    yDev25qEraseRange_t range;
+    yDevStatus_t status;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    handle_25q = (yDevHandle_25q_t *)handle;
+
+    // 异步写入占用SPI总线
+    if (handle_25q->async.busy != 0)
+    {
+        handle_25q->base.errno = YDEV_25Q_ERRNO_BUSY;
+        return YDEV_BUSY;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_25Q_IOCTL_CHIP_ERASE:
+        // 全片擦除操作
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_LockJob(handle_25q, YDEV_BUSJOB_ERASE);
+        status = (yDev25q_Erase(handle_25q, 0, handle_25q->size) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_SECTOR_ERASE:
+    case YDEV_25Q_IOCTL_BLOCK_ERASE_32K:
+    case YDEV_25Q_IOCTL_BLOCK_ERASE_64K:
+        // 擦除arg指定地址所在的扇区/块
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        range.size = (cmd == YDEV_25Q_IOCTL_SECTOR_ERASE)      ? YDEV_25Q_SECTOR_SIZE
+                     : (cmd == YDEV_25Q_IOCTL_BLOCK_ERASE_32K) ? YDEV_25Q_HALF_BLOCK_SIZE
+                                                               : YDEV_25Q_BLOCK_SIZE;
+        range.address = *((uint32_t *)arg) & ~(range.size - 1);
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_LockJob(handle_25q, YDEV_BUSJOB_ERASE);
+        status = (yDev25q_Erase(handle_25q, range.address, range.size) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_ERASE_RANGE:
+        // 任意范围擦除，由擦除规划选择最省时的命令组合
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        range = *((yDev25qEraseRange_t *)arg);
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_LockJob(handle_25q, YDEV_BUSJOB_ERASE);
+        status = (yDev25q_Erase(handle_25q, range.address, range.size) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_CACHE_ENABLE:
+        // 设置读缓存行数
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_Lock(handle_25q);
+        *((uint32_t *)arg) = yDev25q_CacheSetup(handle_25q, *((uint32_t *)arg));
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_CACHE_STATS:
+        // 读取缓存统计
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        ((yDev25qCacheStats_t *)arg)->lines = handle_25q->cache.count;
+        ((yDev25qCacheStats_t *)arg)->hit = handle_25q->cache.hit;
+        ((yDev25qCacheStats_t *)arg)->miss = handle_25q->cache.miss;
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_SPI_STATS:
+        // 读取SPI传输统计
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_Lock(handle_25q);
+        memcpy(arg, &handle_25q->stats, sizeof(handle_25q->stats));
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_SPI_STATS_RESET:
+        // 清零SPI传输统计
+        yDev25q_Lock(handle_25q);
+        memset(&handle_25q->stats, 0, sizeof(handle_25q->stats));
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_JOB_DEADLINE:
+        // 设置作业类别默认截止时间，共享总线时作用于整条总线
+        return yDevBusJobSetDeadline(yDev25q_Sched(handle_25q), (const yDevBusJobDeadline_t *)arg);
+
+    case YDEV_25Q_IOCTL_JOB_STATS:
+        // 读取并清零总线作业统计
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDevBusJobGetStats(yDev25q_Sched(handle_25q), (yDevBusJobStats_t *)arg, 1);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_WBACK_ENABLE:
+        // 先写出已缓冲的数据再重新分配；超时写出需要后台工作任务
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_LockJob(handle_25q, YDEV_BUSJOB_WRITE);
+        status = (yDev25q_WbackFlush(handle_25q) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+        ((yDev25qWbackConfig_t *)arg)->pages = yDev25q_WbackSetup(handle_25q, ((yDev25qWbackConfig_t *)arg)->pages);
+        if ((handle_25q->wback.count == 0) || (handle_25q->wback.timer == NULL) ||
+            (yDev25q_WorkerStart(handle_25q) != YDEV_OK))
+        {
+            ((yDev25qWbackConfig_t *)arg)->timeoutMs = 0;
+        }
+        handle_25q->wback.timeoutMs = ((yDev25qWbackConfig_t *)arg)->timeoutMs;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_WBACK_FLUSH:
+        // 写出全部缓冲页，保证之前的写入已编程
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_LockJob(handle_25q, YDEV_BUSJOB_WRITE);
+        status = (yDev25q_WbackFlush(handle_25q) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_WBACK_STATS:
+        // 读取写回缓冲统计
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        ((yDev25qWbackStats_t *)arg)->pages = handle_25q->wback.count;
+        ((yDev25qWbackStats_t *)arg)->writes = handle_25q->wback.writes;
+        ((yDev25qWbackStats_t *)arg)->programs = handle_25q->wback.programs;
+        ((yDev25qWbackStats_t *)arg)->timeouts = handle_25q->wback.timeouts;
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_PREFETCH:
+        // 设置预读页数，补充预读由后台工作任务执行
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        if ((*((uint32_t *)arg) != 0) && (yDev25q_WorkerStart(handle_25q) != YDEV_OK))
+        {
+            *((uint32_t *)arg) = 0;
+            return YDEV_NOT_SUPPORTED;
+        }
+        yDev25q_Lock(handle_25q);
+        *((uint32_t *)arg) = yDev25q_PrefetchSetup(handle_25q, *((uint32_t *)arg));
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_PREFETCH_STATS:
+        // 读取预读统计
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        ((yDev25qPrefetchStats_t *)arg)->pages = handle_25q->prefetch.count;
+        ((yDev25qPrefetchStats_t *)arg)->issued = handle_25q->prefetch.issued;
+        ((yDev25qPrefetchStats_t *)arg)->hit = handle_25q->prefetch.hit;
+        ((yDev25qPrefetchStats_t *)arg)->miss = handle_25q->prefetch.miss;
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_CACHE_INVALIDATE:
+        // 清空读缓存
+        yDev25q_Lock(handle_25q);
+        yDev25q_CacheInvalidate(handle_25q, 0, handle_25q->size);
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_SPEED_TUNE:
+        // 校准SPI时钟，芯片需空闲
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_Lock(handle_25q);
+        status = (yDev25q_SpeedTune(handle_25q, (yDev25qSpeedTune_t *)arg) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_VERIFY:
+        // 开关读回校验，加锁保证不改变进行中的编程
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_Lock(handle_25q);
+        handle_25q->flagVerify = (*((uint32_t *)arg) != 0) ? 1 : 0;
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_XFER_MODE:
+        // 限制数据传输方式，加锁保证不改变进行中的传输
+        if ((arg == NULL) || (*((uint32_t *)arg) >= YDEV_25Q_XFER_MAX))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_Lock(handle_25q);
+        handle_25q->xferMode = (uint8_t)*((uint32_t *)arg);
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_SET_SPEED:
+        // 设置SPI速率等级
+        if ((arg == NULL) || (*((uint32_t *)arg) >= YDEV_25Q_SPEED_LEVEL_NUM))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_Lock(handle_25q);
+        status = (yDev25q_SetSpeed(handle_25q, (uint8_t)*((uint32_t *)arg)) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_POWER_DOWN:
+        // 芯片进入深度掉电，SPI时钟保持
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_Lock(handle_25q);
+        status = (yDev25q_PowerDown(handle_25q, 0) == YDRV_OK) ? YDEV_OK : YDEV_BUSY;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_POWER_UP:
+        // 加锁即唤醒
+        yDev25q_Lock(handle_25q);
+        status = (handle_25q->flagPowerDown == 0) ? YDEV_OK : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_AUTO_SLEEP:
+        // 设置空闲自动掉电时间，下次释放总线时按新时间启动
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        if (handle_25q->sleep.timer == NULL)
+        {
+            return YDEV_NOT_SUPPORTED;
+        }
+        yDev25q_Lock(handle_25q);
+        handle_25q->sleep.ms = *((uint32_t *)arg);
+        if (handle_25q->sleep.ms == 0)
+        {
+            (void)xTimerStop((TimerHandle_t)handle_25q->sleep.timer, portMAX_DELAY);
+        }
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_MAP:
+        // 只检查范围；本平台的Flash在SPI总线上，不能映射，总是返回不支持，调用者退回yDev25qRead
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        ((yDev25qMap_t *)arg)->ptr = NULL;
+        if ((((yDev25qMap_t *)arg)->address >= handle_25q->size) ||
+            (((yDev25qMap_t *)arg)->size > handle_25q->size - ((yDev25qMap_t *)arg)->address))
+        {
+            handle_25q->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+            return YDEV_INVALID_PARAM;
+        }
+        return YDEV_NOT_SUPPORTED;
+
+    case YDEV_25Q_IOCTL_WRITE_ENABLE:
+    case YDEV_25Q_IOCTL_WRITE_DISABLE:
+        // 单字节命令，芯片空闲时发送
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_Lock(handle_25q);
+        status = ((yDev25q_WaitBusy(handle_25q, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) == YDRV_OK) &&
+                  (yDev25q_SendCmd(handle_25q, (cmd == YDEV_25Q_IOCTL_WRITE_ENABLE) ? YDEV_25Q_CMD_WRITE_ENABLE
+                                                                                 : YDEV_25Q_CMD_WRITE_DISABLE) == YDRV_OK))
+                     ? YDEV_OK
+                     : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_READ_STATUS_REG:
+        // 读取状态寄存器，擦除进行中也可读取(BUSY位为1)
+        if ((arg == NULL) || (((yDev25qStatusReg_t *)arg)->reg < 1) || (((yDev25qStatusReg_t *)arg)->reg > 3))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_Lock(handle_25q);
+        ((yDev25qStatusReg_t *)arg)->value =
+            yDev25q_ReadReg(handle_25q, (((yDev25qStatusReg_t *)arg)->reg == 1)   ? YDEV_25Q_CMD_READ_STATUS_REG1
+                                        : (((yDev25qStatusReg_t *)arg)->reg == 2) ? YDEV_25Q_CMD_READ_STATUS_REG2
+                                                                                  : YDEV_25Q_CMD_READ_STATUS_REG3);
+        yDev25q_Unlock(handle_25q);
+        return YDEV_OK;
+
+    case YDEV_25Q_IOCTL_WRITE_STATUS_REG:
+        // 写入状态寄存器
+        if ((arg == NULL) || (((yDev25qStatusReg_t *)arg)->reg < 1) || (((yDev25qStatusReg_t *)arg)->reg > 3))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_Lock(handle_25q);
+        status = (yDev25q_WriteStatus(handle_25q,
+                                      ((yDev25qStatusReg_t *)arg)->reg,
+                                      ((yDev25qStatusReg_t *)arg)->value,
+                                      ((yDev25qStatusReg_t *)arg)->flagVolatile) == YDRV_OK)
+                     ? YDEV_OK
+                     : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_SET_PROTECTION:
+    case YDEV_25Q_IOCTL_CLEAR_PROTECTION:
+        // SR1的BP0~2/TB/SEC(bit2~6)决定保护范围，CMP(SR2 bit6)取反范围；SRP位保持不变
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_Lock(handle_25q);
+        status = YDEV_OK;
+        if ((yDev25q_ReadReg(handle_25q, YDEV_25Q_CMD_READ_STATUS_REG2) & 0x40) != 0)
+        {
+            status = (yDev25q_WriteStatus(handle_25q, 2,
+                                          yDev25q_ReadReg(handle_25q, YDEV_25Q_CMD_READ_STATUS_REG2) & (uint8_t)~0x40,
+                                          0) == YDRV_OK)
+                         ? YDEV_OK
+                         : YDEV_ERROR;
+        }
+        if (status == YDEV_OK)
+        {
+            range.address = (cmd == YDEV_25Q_IOCTL_CLEAR_PROTECTION) ? 0
+                            : (arg != NULL)                         ? (*((uint32_t *)arg) & 0x1F)
+                                                                    : 0x07; // BP2~0全1覆盖全片
+            status = (yDev25q_WriteStatus(handle_25q, 1,
+                                          (uint8_t)((yDev25q_ReadReg(handle_25q, YDEV_25Q_CMD_READ_STATUS_REG1) & ~0x7C) |
+                                                    (range.address << 2)),
+                                          0) == YDRV_OK)
+                         ? YDEV_OK
+                         : YDEV_ERROR;
+        }
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_READ_UNIQUE_ID:
+        // 读取64位唯一ID
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev25q_EraseWaitIdle(handle_25q);
+        yDev25q_Lock(handle_25q);
+        status = (yDev25q_ReadUniqueId(handle_25q, (uint8_t *)arg) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+        yDev25q_Unlock(handle_25q);
+        return status;
+
+    case YDEV_25Q_IOCTL_READ_JEDEC_ID:
+        // 读取JEDEC ID
+        if (arg != NULL)
+        {
+            yDev25q_EraseWaitIdle(handle_25q);
+            yDev25q_Lock(handle_25q);
+            *((uint32_t *)arg) = yDev25qReadJedecId(handle_25q);
+            yDev25q_Unlock(handle_25q);
+            return YDEV_OK;
+        }
+        return YDEV_INVALID_PARAM;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+/**
+ * @brief 25Q设备挂起
+ * @param handle 25Q设备句柄指针
+ * @retval yDevStatus_t 操作状态
+ *         - YDEV_OK: 芯片已进入深度掉电
+ *         - YDEV_BUSY: 异步读写、后台擦除或芯片编程进行中
+ * @note 独占总线时同时关闭SPI时钟，共享总线的时钟归总线所有
+ */
+static yDevStatus_t yDev_25q_Suspend(void *handle)
+{
+    yDevHandle_25q_t *handle_25q;
+    yDrvStatus_t status;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    handle_25q = (yDevHandle_25q_t *)handle;
+    if ((handle_25q->async.busy != 0) || (handle_25q->erase.active != 0) ||
+        (handle_25q->erase.read.buffer != NULL))
+    {
+        return YDEV_BUSY;
+    }
+
+    // 挂起前写出缓冲的数据，低功耗期间复位不丢失
+    yDev25q_LockJob(handle_25q, YDEV_BUSJOB_WRITE);
+    (void)yDev25q_WbackFlush(handle_25q);
+    status = yDev25q_PowerDown(handle_25q, (handle_25q->bus_device.bus == NULL) ? 1 : 0);
+    yDev25q_Unlock(handle_25q);
+
+    return (status == YDRV_OK) ? YDEV_OK : YDEV_BUSY;
+}
+
+/**
+ * @brief 25Q设备恢复
+ * @param handle 25Q设备句柄指针
+ * @retval yDevStatus_t 操作状态
+ * @note 唤醒在总线加锁时完成，直接调用驱动接口访问已挂起的芯片同样会先唤醒
+ */
+static yDevStatus_t yDev_25q_Resume(void *handle)
+{
+    yDevHandle_25q_t *handle_25q;
+    yDevStatus_t status;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    handle_25q = (yDevHandle_25q_t *)handle;
+    yDev25q_Lock(handle_25q);
+    status = (handle_25q->flagPowerDown == 0) ? YDEV_OK : YDEV_ERROR;
+    yDev25q_Unlock(handle_25q);
+
+    return status;
+}
+
+// ==================== 25Q异步写入接口实现 ====================
+
+/**
+ * @brief 启动25Q异步写入
+ * @param handle 25Q设备句柄指针
+ * @param address 写入起始地址
+ * @param buffer 写入数据缓冲区指针，完成回调前必须保持有效
+ * @param size 写入数据大小
+ * @param callback 完成回调函数，可为NULL
+ * @param arg 完成回调参数
+ * @retval yDevStatus_t 操作状态
+ * @note 发出第一页编程后立即返回，后续页由软件定时器在芯片就绪后依次发起
+ * @note 只编程目标字节范围，不做读-改-写，目标区域应已擦除
+ */
+yDevStatus_t yDev25qWriteAsync(yDevHandle_25q_t *handle,
+                               uint32_t address,
+                               const void *buffer,
+                               uint32_t size,
+                               yDev25qAsyncCallback_t callback,
+                               void *arg)
+{
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (handle->async.timer == NULL)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    if ((address + size) > handle->size)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return YDEV_INVALID_PARAM;
+    }
+
+    if ((handle->async.busy != 0) || (handle->erase.active != 0))
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_BUSY;
+        return YDEV_BUSY;
+    }
+
+    // 确认芯片空闲后再占用流水线
+    yDev25q_Lock(handle);
+    if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    {
+        yDev25q_Unlock(handle);
+        handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+        return YDEV_TIMEOUT;
+    }
+
+    handle->async.buffer = (const uint8_t *)buffer;
+    handle->async.address = address;
+    handle->async.remain = size;
+    handle->async.callback = callback;
+    handle->async.arg = arg;
+    handle->async.busy = 1;
+
+    // 发起第一页编程
+    if (yDev25q_AsyncIssuePage(handle) != YDRV_OK)
+    {
+        yDev25q_Unlock(handle);
+        handle->async.busy = 0;
+        handle->base.errno = YDEV_25Q_ERRNO_WRITE_FAIL;
+        return YDEV_ERROR;
+    }
+    yDev25q_Unlock(handle);
+
+    // 启动BUSY轮询定时器
+    if (xTimerStart((TimerHandle_t)handle->async.timer, 0) != pdPASS)
+    {
+        handle->async.busy = 0;
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+// ==================== 25Q后台擦除接口实现 ====================
+
+/**
+ * @brief 提交25Q后台擦除请求
+ * @param handle 25Q设备句柄指针
+ * @param address 擦除起始地址，自动向下对齐到扇区边界
+ * @param size 擦除大小，自动向上对齐到扇区边界
+ * @retval yDevStatus_t 操作状态
+ * @note 首次调用时创建低优先级擦除工作任务
+ */
+yDevStatus_t yDev25qEraseAsync(yDevHandle_25q_t *handle, uint32_t address, uint32_t size)
+{
+    yDev25qEraseJob_t *job;
+    yDevStatus_t status;
+    uint32_t start;
+    uint32_t align;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (size == 0))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if ((address + size) > handle->size)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (handle->async.busy != 0)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_BUSY;
+        return YDEV_BUSY;
+    }
+
+    // 按需创建擦除工作任务
+    status = yDev25q_WorkerStart(handle);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+
+    // 按最小擦除单元对齐后入队
+    align = handle->geometry.eraseSize[0];
+    start = address & ~(align - 1);
+    yDev25q_Lock(handle);
+    if (handle->erase.count >= YDEV_25Q_ERASE_QUEUE_DEPTH)
+    {
+        yDev25q_Unlock(handle);
+        handle->base.errno = YDEV_25Q_ERRNO_BUSY;
+        return YDEV_BUSY;
+    }
+    job = &handle->erase.queue[(handle->erase.head + handle->erase.count) % YDEV_25Q_ERASE_QUEUE_DEPTH];
+    job->address = start;
+    job->size = ((address + size + align - 1) & ~(align - 1)) - start;
+    handle->erase.count++;
+    handle->erase.active = 1;
+    yDev25q_Unlock(handle);
+
+    // 唤醒工作任务
+    xTaskNotifyGive((TaskHandle_t)handle->erase.task);
+
+    return YDEV_OK;
+}
+
+// ==================== 25Q私有函数实现 ====================
+
+/**
+ * @brief 25Q SPI数据传输函数实现
+ * @param handle 25Q设备句柄指针
+ * @param tx_data 发送数据缓冲区指针，为NULL时发送临时数据
+ * @param rx_buff 接收数据缓冲区指针，为NULL时丢弃接收数据
+ * @param size 传输数据大小
+ * @retval int32_t 实际传输的字节数
+ * @note 按长度选择传输方式：大块走DMA，中等长度走中断，命令和状态字节走打包轮询
+ */
+static int32_t yDev25q_Spi_Transfer(yDevHandle_25q_t *handle,
+                                    const void *tx_data,
+                                    void *rx_buff,
+                                    uint32_t size)
+{
+    // 1. 按长度选择DMA或中断传输
+    if ((yDev25q_UseDma(handle) != 0) && (size >= YDEV_25Q_DMA_THRESHOLD) && (size <= YDEV_25Q_DMA_MAX_SIZE))
+    {
+        return yDev25q_DmaTransfer(handle, tx_data, rx_buff, size);
+    }
+
+    if ((yDev25q_UseIrq(handle) != 0) && (size >= YDEV_25Q_IRQ_THRESHOLD) &&
+        (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        return yDev25q_ItTransfer(handle, tx_data, rx_buff, size);
+    }
+
+    // 2. 其余长度使用阻塞批量传输(硬件SPI打包访问DR，软件SPI由GPIO模拟)
+#if YDEV_25Q_SPI_STATS
+    uint32_t start = yDevGetTimeUS();
+    uint32_t done = yDrvSpiTransferPolled(handle->spi, tx_data, rx_buff, size);
+    yDev25q_StatsRecord(handle, &handle->stats.polled, size, done, start);
+    return (int32_t)done;
+#else
+    return (int32_t)yDrvSpiTransferPolled(handle->spi, tx_data, rx_buff, size);
+#endif
+}
+
+/**
+ * @brief 25Q SPI分段传输函数实现
+ * @param handle 25Q设备句柄指针
+ * @param seg 分段描述符数组
+ * @param count 分段数量
+ * @retval int32_t 实际传输的总字节数
+ */
+static int32_t yDev25q_Spi_TransferSg(yDevHandle_25q_t *handle, const yDrvSpiSeg_t *seg, uint32_t count)
+{
+    uint32_t total;
+    uint32_t done;
+    uint32_t i;
+
+    total = 0;
+    for (i = 0; i < count; i++)
+    {
+        total += seg[i].len;
+    }
+
+    // 1. 整条链交给DMA，分段间不拷贝、不重新选择传输方式
+    if ((yDev25q_UseDma(handle) != 0) && (total >= YDEV_25Q_DMA_THRESHOLD))
+    {
+        return yDev25q_DmaTransferSg(handle, seg, count, total);
+    }
+
+    // 2. 逐段传输，每段按自身长度选择中断或轮询
+    done = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (yDev25q_Spi_Transfer(handle, seg[i].tx, seg[i].rx, seg[i].len) != (int32_t)seg[i].len)
+        {
+            break;
+        }
+        done += seg[i].len;
+    }
+
+    return (int32_t)done;
+}
+
+/**
+ * @brief 读取25Q Flash状态寄存器实现
+ * @param handle 25Q设备句柄指针
+ * @param reg 状态寄存器命令字节
+ * @retval uint8_t 状态寄存器的值，读取失败时返回0xFF
+ * @note 通过SPI发送寄存器读取命令并接收状态值
+ */
+static uint8_t yDev25q_ReadReg(yDevHandle_25q_t *handle, uint8_t reg)
+{
+    uint8_t write_data[2];
+    uint8_t read_data[2];
+
+    write_data[0] = reg;                      // 状态寄存器读取命令
+    write_data[1] = 0xFF;                     // 读取数据填充
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+
+    if (yDev25q_Spi_Transfer(handle, write_data, read_data, 2) != 2) // 发送命令并接收数据
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        return 0xFF;                              // 读取失败
+    }
+
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+    return read_data[1];
+}
+
+/**
+ * @brief 等待25Q Flash芯片就绪实现
+ * @param handle 25Q设备句柄指针
+ * @param timeout_ms 超时时间(毫秒)
+ * @retval yDrvStatus_t 操作状态
+ * @note 根据芯片类型选择对应的状态寄存器和BUSY位检查
+ */
+static yDrvStatus_t yDev25q_WaitBusy(yDevHandle_25q_t *handle, uint32_t timeout_ms)
+{
+    uint32_t start_time;
+    uint8_t status;
+    uint8_t reg_cmd;
+    uint8_t busy_mask;
+
+    YLIB_PROBE_BEGIN(flash_busy);
+
+    // 25系列SPI NOR的BUSY(WIP)位统一位于状态寄存器1的bit0
+    reg_cmd = YDEV_25Q_CMD_READ_STATUS_REG1;
+    busy_mask = YDEV_25Q_STATUS_W25Q_BUSY;
+
+    // 轮询检查BUSY位直到芯片就绪或超时
+    start_time = yDevGetTimeMS();
+    do
+    {
+        status = yDev25q_ReadReg(handle, reg_cmd);
+        if ((status & busy_mask) == 0)
+        {
+            YLIB_PROBE_END(flash_busy);
+            return YDRV_OK; // 芯片就绪
+        }
+    } while ((yDevGetTimeMS() - start_time) <= timeout_ms);
+
+    YLIB_PROBE_END(flash_busy);
+    return YDRV_TIMEOUT; // 超时
+}
+
+/**
+ * @brief 根据JEDEC ID识别芯片型号实现
+ * @param jedec_id JEDEC ID值
+ * @retval yDev25qType_t 芯片型号枚举值
+ * @note 遍历已知芯片ID表进行匹配识别
+ */
+static yDev25qType_t yDev25q_IdentifyChip(uint32_t jedec_id)
+{
+    // 遍历芯片ID表进行匹配
+    for (yDev25qType_t i = YDEV_25Q_TYPE_W25Q16; i < YDEV_25Q_TYPE_UNKNOWN; i++)
+    {
+        if (IdentifyChip25q[i] == jedec_id)
+        {
+            return i;
+        }
+    }
+    return YDEV_25Q_TYPE_UNKNOWN;
+}
+
+/**
+ * @brief 读取25Q设备JEDEC ID实现
+ * @param handle 25Q设备句柄指针
+ * @retval uint32_t JEDEC ID值，读取失败时返回0
+ * @note 发送0x9F命令读取3字节JEDEC ID
+ */
+static uint32_t yDev25qReadJedecId(yDevHandle_25q_t *handle)
+{
+    uint8_t cmd[4] = {0x9F, 0xFF, 0xFF, 0xFF}; // JEDEC ID读取命令
+    uint8_t jedec_data[4] = {0};               // 用于存储读取的JEDEC ID数据
+    uint32_t jedec_id = 0;
+
+    // 读取3字节JEDEC ID数据
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中
+    if (yDev25q_Spi_Transfer(handle, &cmd, &jedec_data[0], 4) != 4)
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        return 0;
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+
+    // 组合24位JEDEC ID
+    jedec_id = ((uint32_t)jedec_data[1] << 16) |
+               ((uint32_t)jedec_data[2] << 8) |
+               (uint32_t)jedec_data[3];
+    return jedec_id;
+}
+
+/**
+ * @brief 设置25Q SPI速率等级实现
+ * @param handle 25Q设备句柄指针
+ * @param level 速率等级(0~7)
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_SetSpeed(yDevHandle_25q_t *handle, uint8_t level)
+{
+    yDrvStatus_t ret;
+
+    if (level >= YDEV_25Q_SPEED_LEVEL_NUM)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 共享总线时按器件时钟模式切换，并同步总线当前参数，避免下次事务误判
+    if (handle->bus_device.bus != NULL)
+    {
+        ret = yDrvSpiSetFormat(handle->spi,
+                               handle->bus_device.polarity,
+                               handle->bus_device.phase,
+                               SpeedLevel25q[level]);
+        if (ret != YDRV_OK)
+        {
+            return ret;
+        }
+        handle->bus_device.speed = SpeedLevel25q[level];
+        handle->bus_device.bus->speed = SpeedLevel25q[level];
+    }
+    else
+    {
+        ret = yDrvSpiSetFormat(handle->spi,
+                               YDRV_SPI_POLARITY_LOW,
+                               YDRV_SPI_PHASE_1EDGE,
+                               SpeedLevel25q[level]);
+        if (ret != YDRV_OK)
+        {
+            return ret;
+        }
+    }
+
+    handle->speedLevel = level;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 校准25Q SPI时钟实现
+ * @param handle 25Q设备句柄指针
+ * @param result 校准结果指针，可为NULL
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_SpeedTune(yDevHandle_25q_t *handle, yDev25qSpeedTune_t *result)
+{
+    uint8_t ref[YDEV_25Q_TUNE_SIZE];
+    uint8_t buff[YDEV_25Q_TUNE_SIZE];
+    uint32_t ref_id;
+    uint32_t address;
+    uint8_t pass_mask = 0;
+    uint8_t fastest = 0xFF;
+    uint8_t level;
+    uint8_t pass;
+
+    // 最低速率读取参考数据，参考数据读取失败说明连线或芯片本身有问题
+    address = handle->address;
+    if (yDev25q_SetSpeed(handle, 0) != YDRV_OK)
+    {
+        return YDRV_ERROR;
+    }
+    ref_id = yDev25qReadJedecId(handle);
+    handle->address = 0;
+    if ((ref_id == 0) || (ref_id == 0xFFFFFF) ||
+        (yDev25q_ReadData(handle, ref, sizeof(ref)) != (int32_t)sizeof(ref)))
+    {
+        handle->address = address;
+        return YDRV_ERROR;
+    }
+
+    // 从最快速率向下逐级比对，每级多轮读取，任一轮不一致即判定失败
+    for (level = YDEV_25Q_SPEED_LEVEL_NUM; level-- > 0;)
+    {
+        if (yDev25q_SetSpeed(handle, level) != YDRV_OK)
+        {
+            continue;
+        }
+
+        pass = 1;
+        for (uint32_t round = 0; (round < YDEV_25Q_TUNE_ROUNDS) && (pass != 0); round++)
+        {
+            handle->address = 0;
+            memset(buff, 0, sizeof(buff));
+            if ((yDev25qReadJedecId(handle) != ref_id) ||
+                (yDev25q_ReadData(handle, buff, sizeof(buff)) != (int32_t)sizeof(buff)) ||
+                (memcmp(buff, ref, sizeof(buff)) != 0))
+            {
+                pass = 0;
+            }
+        }
+
+        if (pass != 0)
+        {
+            pass_mask |= (uint8_t)(1U << level);
+            if (fastest == 0xFF)
+            {
+                fastest = level;
+            }
+        }
+    }
+
+    // 最快通过等级不是硬件上限时退一级，留出温度和电压漂移余量
+    level = 0;
+    if (fastest != 0xFF)
+    {
+        level = fastest;
+        if ((level > 0) && (level < (YDEV_25Q_SPEED_LEVEL_NUM - 1)) &&
+            ((pass_mask & (1U << (level - 1))) != 0))
+        {
+            level--;
+        }
+    }
+    yDev25q_SetSpeed(handle, level);
+    handle->address = address;
+
+    if (result != NULL)
+    {
+        result->level = level;
+        result->fastest = fastest;
+        result->passMask = pass_mask;
+    }
+
+    return (fastest != 0xFF) ? YDRV_OK : YDRV_ERROR;
+}
+
+/**
+ * @brief 25Q Flash页编程操作实现
+ * @param handle 25Q设备句柄指针
+ * @param start_address 页编程起始地址
+ * @param write_data 页编程数据指针
+ * @retval yDrvStatus_t 操作状态
+ * @note 执行完整的页编程流程：等待就绪->写使能->发送命令和地址->发送数据->等待完成
+ */
+static yDrvStatus_t yDev25q_WritePage(yDevHandle_25q_t *handle,
+                                      uint32_t start_address,
+                                      const uint8_t *write_data,
+                                      uint32_t size)
+{
+    yDrvStatus_t status;
+    uint32_t expect = 0;
+    uint8_t flag_crc = 0;
+
+    // 1. 等待芯片就绪
+    if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+        return YDRV_TIMEOUT;
+    }
+
+    // 2. 写使能并发送页编程命令、地址和数据
+    status = yDev25q_ProgramStart(handle, start_address, write_data, size);
+    if (status != YDRV_OK)
+    {
+        return status;
+    }
+
+    // 3. 芯片内部编程期间计算源数据CRC
+    if (handle->flagVerify != 0)
+    {
+        flag_crc = yDev25q_VerifyPrepare(handle, write_data, size, &expect);
+    }
+
+    // 4. 等待页编程完成
+    if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    {
+        if (flag_crc != 0)
+        {
+            (void)yDrvCrcStreamEnd();
+        }
+        handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+        return YDRV_TIMEOUT;
+    }
+
+    // 5. 读回校验
+    if (handle->flagVerify != 0)
+    {
+        return yDev25q_Verify(handle, start_address, write_data, size, flag_crc, expect);
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 启动25Q Flash页编程实现
+ * @param handle 25Q设备句柄指针
+ * @param start_address 编程起始地址
+ * @param write_data 编程数据指针
+ * @param size 编程数据大小 (不得跨页)
+ * @retval yDrvStatus_t 操作状态
+ * @note 写使能和页编程命令各占一次片选周期，发送完数据即返回，不等待BUSY清零
+ */
+static yDrvStatus_t yDev25q_ProgramStart(yDevHandle_25q_t *handle,
+                                         uint32_t start_address,
+                                         const uint8_t *write_data,
+                                         uint32_t size)
+{
+    uint8_t write_cmd[4];
+    yDrvSpiSeg_t seg[2];
+
+    // 1. 发送写使能命令
+    write_cmd[0] = YDEV_25Q_CMD_WRITE_ENABLE;
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if (yDev25q_Spi_Transfer(handle, write_cmd, NULL, 1) != 1)
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+        return YDRV_ERROR;
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中，写使能生效
+
+    // 2. 构建页编程命令和地址
+    write_cmd[0] = YDEV_25Q_CMD_PAGE_PROGRAM;    // 页编程命令
+    write_cmd[1] = (start_address >> 16) & 0xFF; // 地址高字节
+    write_cmd[2] = (start_address >> 8) & 0xFF;  // 地址中字节
+    write_cmd[3] = start_address & 0xFF;         // 地址低字节
+
+    // 3. 命令地址与调用者数据作为两段在同一片选周期内发送，数据不拷贝
+    seg[0].tx = write_cmd;
+    seg[0].rx = NULL;
+    seg[0].len = 4;
+    seg[1].tx = write_data;
+    seg[1].rx = NULL;
+    seg[1].len = size;
+
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if (yDev25q_Spi_TransferSg(handle, seg, 2) != (int32_t)(size + 4))
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+        return YDRV_ERROR;
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中，芯片开始内部编程
+
+    // 页已被编程，使缓存失效
+    yDev25q_CacheInvalidate(handle, start_address, size);
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q读回校验准备实现
+ * @note 只有读回能走DMA时才占用CRC单元，短数据和无DMA时逐块比较更省事
+ */
+static uint8_t yDev25q_VerifyPrepare(yDevHandle_25q_t *handle, const uint8_t *data, uint32_t size, uint32_t *expect)
+{
+    static const uint8_t erased[32] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    };
+    uint32_t chunk;
+
+    if ((yDev25q_UseDma(handle) == 0) || (size < YDEV_25Q_DMA_THRESHOLD) || (yDrvCrcStreamBegin() != YDRV_OK))
+    {
+        return 0;
+    }
+
+    if (data != NULL)
+    {
+        *expect = yDrvCrcAccumulate(data, size);
+    }
+    else
+    {
+        while (size > 0)
+        {
+            chunk = (size > sizeof(erased)) ? sizeof(erased) : size;
+            *expect = yDrvCrcAccumulate(erased, chunk);
+            size -= chunk;
+        }
+    }
+
+    // 读回从初始值重新开始
+    yDrvCrcReset();
+    return 1;
+}
+
+/**
+ * @brief 25Q读回校验实现
+ * @note 占用CRC单元时接收DMA直接写入CRC数据寄存器，读回数据不经过RAM；
+ *       否则经小缓冲区分块读回并逐字节比较
+ */
+static yDrvStatus_t yDev25q_Verify(yDevHandle_25q_t *handle, uint32_t address, const uint8_t *data, uint32_t size,
+                                   uint8_t flag_crc, uint32_t expect)
+{
+    uint8_t read_cmd[5];
+    uint8_t buffer[32];
+    uint32_t cmd_len;
+    uint32_t index;
+    uint32_t chunk;
+    uint32_t i;
+    uint8_t flag_ok;
+
+    read_cmd[0] = (handle->flagFastRead != 0) ? YDEV_25Q_CMD_FAST_READ : YDEV_25Q_CMD_READ_DATA;
+    read_cmd[1] = (address >> 16) & 0xFF;
+    read_cmd[2] = (address >> 8) & 0xFF;
+    read_cmd[3] = address & 0xFF;
+    read_cmd[4] = 0xFF;
+    cmd_len = (handle->flagFastRead != 0) ? 5 : 4;
+
+    flag_ok = 1;
+    index = 0;
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if (yDev25q_Spi_Transfer(handle, read_cmd, NULL, cmd_len) != (int32_t)cmd_len)
+    {
+        flag_ok = 0;
+    }
+    else if (flag_crc != 0)
+    {
+        // 数据段接收缓冲为NULL，DMA按字节写入CRC数据寄存器
+        yDrvSpiDmaSetRxSink(handle->spi, yDrvCrcStreamTarget());
+        while (index < size)
+        {
+            chunk = ((size - index) > YDEV_25Q_DMA_MAX_SIZE) ? YDEV_25Q_DMA_MAX_SIZE : (size - index);
+            if (yDev25q_DmaTransfer(handle, NULL, NULL, chunk) != (int32_t)chunk)
+            {
+                flag_ok = 0;
+                break;
+            }
+            index += chunk;
+        }
+        yDrvSpiDmaSetRxSink(handle->spi, NULL);
+    }
+    else
+    {
+        while ((flag_ok != 0) && (index < size))
+        {
+            chunk = ((size - index) > sizeof(buffer)) ? sizeof(buffer) : (size - index);
+            if (yDev25q_Spi_Transfer(handle, NULL, buffer, chunk) != (int32_t)chunk)
+            {
+                flag_ok = 0;
+                break;
+            }
+            for (i = 0; i < chunk; i++)
+            {
+                if (buffer[i] != ((data != NULL) ? data[index + i] : 0xFF))
+                {
+                    flag_ok = 0;
+                    break;
+                }
+            }
+            index += chunk;
+        }
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+
+    if ((flag_crc != 0) && (yDrvCrcStreamEnd() != expect))
+    {
+        flag_ok = 0;
+    }
+    if (flag_ok == 0)
+    {
+        handle->base.errno |= YDEV_25Q_ERRNO_VERIFY_FAIL;
+        return YDRV_ERROR;
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q Flash擦除操作实现
+ * @param handle 25Q设备句柄指针
+ * @param start_address 擦除起始地址
+ * @param size 擦除数据大小
+ * @retval yDrvStatus_t 操作状态
+ * @note 自动选择最优擦除方式：64KB块擦除优先，不足部分使用4KB扇区擦除
+ * @note 地址自动对齐到扇区边界
+ */
+static yDrvStatus_t yDev25q_Erase(yDevHandle_25q_t *handle, uint32_t start_address, uint32_t size)
+{
+    uint32_t current_address;
+    uint32_t remaining_size;
+    uint32_t erase_size;
+    uint32_t timeout_ms;
+    uint32_t align;
+    uint32_t expect = 0;
+    uint8_t erase_type;
+
+    // 参数有效性检查
+    if (handle == NULL || size == 0)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 检查地址有效性
+    if ((start_address + size) > handle->size)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 将起始地址对齐到最小擦除单元边界
+    align = handle->geometry.eraseSize[0];
+    current_address = start_address & ~(align - 1);
+
+    // 计算需要擦除的总大小（包含对齐产生的额外部分）
+    remaining_size = ((start_address + size + align - 1) & ~(align - 1)) - current_address;
+
+    while (remaining_size > 0)
+    {
+        // 选择本次擦除方式
+        erase_type = yDev25q_ErasePlan(handle, current_address, remaining_size);
+        erase_size = handle->geometry.eraseSize[erase_type];
+        timeout_ms = handle->geometry.eraseTimeoutMs[erase_type];
+
+        // 等待芯片就绪
+        if (yDev25q_WaitBusy(handle, timeout_ms) != YDRV_OK)
+        {
+            handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+            return YDRV_TIMEOUT;
+        }
+
+        // 发送写使能和擦除命令
+        if (yDev25q_EraseStart(handle, current_address, handle->geometry.eraseCmd[erase_type]) != YDRV_OK)
+        {
+            return YDRV_ERROR;
+        }
+
+        // 等待擦除完成，期间可挂起擦除让读取先执行
+        if (yDev25q_EraseWait(handle, timeout_ms) != YDRV_OK)
+        {
+            handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+            return YDRV_TIMEOUT;
+        }
+
+        // 读回校验全部为0xFF，失败时不标记为已擦除
+        if (handle->flagVerify != 0)
+        {
+            if (yDev25q_Verify(handle, current_address, NULL, erase_size,
+                               yDev25q_VerifyPrepare(handle, NULL, erase_size, &expect), expect) != YDRV_OK)
+            {
+                handle->base.errno |= YDEV_25Q_ERRNO_ERASE_FAIL;
+                yDev25q_CacheInvalidate(handle, current_address, erase_size);
+                return YDRV_ERROR;
+            }
+        }
+
+        // 挂起期间的读取可能缓存了中间状态数据
+        yDev25q_CacheInvalidate(handle, current_address, erase_size);
+
+        // 更新地址和剩余大小
+        current_address += erase_size;
+        remaining_size -= erase_size;
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q擦除方式选择实现
+ * @param handle 25Q设备句柄指针
+ * @param address 当前擦除地址 (扇区对齐)
+ * @param remain 剩余擦除大小 (扇区整数倍)
+ * @retval uint8_t 本次使用的擦除类型索引
+ */
+static uint8_t yDev25q_ErasePlan(yDevHandle_25q_t *handle, uint32_t address, uint32_t remain)
+{
+    yDev25qGeometry_t *geometry;
+    uint32_t best[YDEV_25Q_ERASE_TYPE_MAX];
+    uint32_t split;
+    int32_t top;
+    int32_t i;
+
+    geometry = &handle->geometry;
+
+    // 1. 计算每种擦除单元的最小预期耗时：整块擦除或拆分为下一级单元
+    best[0] = geometry->eraseTypMs[0];
+    for (top = 1; (top < YDEV_25Q_ERASE_TYPE_MAX) && (geometry->eraseSize[top] != 0); top++)
+    {
+        split = (geometry->eraseSize[top] / geometry->eraseSize[top - 1]) * best[top - 1];
+        best[top] = (geometry->eraseTypMs[top] < split) ? geometry->eraseTypMs[top] : split;
+    }
+    top--;
+
+    // 2. 范围覆盖整个芯片且全片擦除更快时使用全片擦除
+    if ((address == 0) && (remain >= handle->size) &&
+        (geometry->eraseSize[YDEV_25Q_ERASE_TYPE_CHIP] != 0) &&
+        (geometry->eraseTypMs[YDEV_25Q_ERASE_TYPE_CHIP] <
+         (handle->size / geometry->eraseSize[top]) * best[top]))
+    {
+        return YDEV_25Q_ERASE_TYPE_CHIP;
+    }
+
+    // 3. 选择地址对齐且不超出剩余范围的最大擦除单元
+    for (i = top; i > 0; i--)
+    {
+        if ((remain >= geometry->eraseSize[i]) &&
+            ((address % geometry->eraseSize[i]) == 0))
+        {
+            break;
+        }
+    }
+
+    // 4. 整块擦除慢于拆分时退到下一级单元
+    while ((i > 0) &&
+           (geometry->eraseTypMs[i] > (geometry->eraseSize[i] / geometry->eraseSize[i - 1]) * best[i - 1]))
+    {
+        i--;
+    }
+
+    return (uint8_t)i;
+}
+
+/**
+ * @brief 启动25Q擦除操作实现
+ * @param handle 25Q设备句柄指针
+ * @param address 擦除地址
+ * @param cmd 擦除命令
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_EraseStart(yDevHandle_25q_t *handle, uint32_t address, uint8_t cmd)
+{
+    uint8_t erase_cmd[4];
+    uint32_t len;
+
+    // 1. 发送写使能命令
+    erase_cmd[0] = YDEV_25Q_CMD_WRITE_ENABLE;
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if (yDev25q_Spi_Transfer(handle, erase_cmd, NULL, 1) != 1)
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+        return YDRV_ERROR;
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中，写使能生效
+
+    // 2. 发送擦除命令和地址，全片擦除不带地址
+    erase_cmd[0] = cmd;
+    erase_cmd[1] = (address >> 16) & 0xFF; // 地址高字节
+    erase_cmd[2] = (address >> 8) & 0xFF;  // 地址中字节
+    erase_cmd[3] = address & 0xFF;         // 地址低字节
+    len = (cmd == YDEV_25Q_CMD_CHIP_ERASE) ? 1 : 4;
+
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if (yDev25q_Spi_Transfer(handle, erase_cmd, NULL, len) != (int32_t)len)
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+        return YDRV_ERROR;
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中，芯片开始内部擦除
+
+    // 擦除区域缓存失效
+    if (cmd == YDEV_25Q_CMD_CHIP_ERASE)
+    {
+        yDev25q_CacheInvalidate(handle, 0, handle->size);
+        yDev25q_WbackDrop(handle, 0, handle->size);
+    }
+    else
+    {
+        for (len = 0; len < YDEV_25Q_ERASE_TYPE_MAX; len++)
+        {
+            if (handle->geometry.eraseCmd[len] == cmd)
+            {
+                yDev25q_CacheInvalidate(handle, address, handle->geometry.eraseSize[len]);
+                yDev25q_WbackDrop(handle, address, handle->geometry.eraseSize[len]);
+                break;
+            }
+        }
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q发送单字节命令实现
+ * @param handle 25Q设备句柄指针
+ * @param cmd 命令字节
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_SendCmd(yDevHandle_25q_t *handle, uint8_t cmd)
+{
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if (yDev25q_Spi_Transfer(handle, &cmd, NULL, 1) != 1)
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+        return YDRV_ERROR;
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 以读取类别获取25Q SPI总线实现
+ * @param handle 25Q设备句柄指针
+ */
+static void yDev25q_Lock(yDevHandle_25q_t *handle)
+{
+    yDev25q_LockJob(handle, YDEV_BUSJOB_READ);
+}
+
+/**
+ * @brief 按作业类别获取25Q SPI总线实现
+ * @param handle 25Q设备句柄指针
+ * @param cls 作业类别
+ */
+static void yDev25q_LockJob(yDevHandle_25q_t *handle, yDevBusJobClass_t cls)
+{
+    yDevStatus_t status;
+
+    for (;;)
+    {
+        if (handle->bus_device.bus != NULL)
+        {
+            status = yDevSpiBusLockJob(&handle->bus_device, cls, 0, portMAX_DELAY);
+        }
+        else
+        {
+            status = yDevBusJobBegin(&handle->sched, cls, 0, portMAX_DELAY);
+        }
+        if (status == YDEV_OK)
+        {
+            break;
+        }
+        vTaskDelay(1);
+    }
+
+    // 所有芯片访问都经过总线锁，在这里唤醒即可覆盖全部入口
+    if (handle->flagPowerDown != 0)
+    {
+        (void)yDev25q_PowerUp(handle);
+    }
+}
+
+/**
+ * @brief 不等待地获取25Q SPI总线实现
+ * @param handle 25Q设备句柄指针
+ */
+static yDrvStatus_t yDev25q_TryLock(yDevHandle_25q_t *handle)
+{
+    yDevStatus_t status;
+
+    if (handle->bus_device.bus != NULL)
+    {
+        status = yDevSpiBusLockJob(&handle->bus_device, YDEV_BUSJOB_READ, 0, 0);
+    }
+    else
+    {
+        status = yDevBusJobBegin(&handle->sched, YDEV_BUSJOB_READ, 0, 0);
+    }
+    if (status != YDEV_OK)
+    {
+        return YDRV_BUSY;
+    }
+
+    if (handle->flagPowerDown != 0)
+    {
+        (void)yDev25q_PowerUp(handle);
+    }
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q进入深度掉电实现
+ * @param handle 25Q设备句柄指针
+ * @param flag_spi_off 非0时同时关闭SPI时钟
+ */
+static yDrvStatus_t yDev25q_PowerDown(yDevHandle_25q_t *handle, uint8_t flag_spi_off)
+{
+    if (handle->flagPowerDown != 0)
+    {
+        return YDRV_OK;
+    }
+
+    // 掉电命令在编程/擦除期间被忽略
+    if ((yDev25q_ReadReg(handle, YDEV_25Q_CMD_READ_STATUS_REG1) & YDEV_25Q_STATUS_W25Q_BUSY) != 0)
+    {
+        return YDRV_BUSY;
+    }
+    if (yDev25q_SendCmd(handle, YDEV_25Q_CMD_POWER_DOWN) != YDRV_OK)
+    {
+        return YDRV_ERROR;
+    }
+    handle->flagPowerDown = 1;
+
+    if ((flag_spi_off != 0) && (yDrvSpiSuspend(handle->spi) == YDRV_OK))
+    {
+        handle->flagSpiOff = 1;
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q退出深度掉电实现
+ * @param handle 25Q设备句柄指针
+ */
+static yDrvStatus_t yDev25q_PowerUp(yDevHandle_25q_t *handle)
+{
+    uint32_t start_time;
+
+    if (handle->flagSpiOff != 0)
+    {
+        (void)yDrvSpiResume(handle->spi);
+        handle->flagSpiOff = 0;
+    }
+
+    if (yDev25q_SendCmd(handle, YDEV_25Q_CMD_RELEASE_POWER_DOWN) != YDRV_OK)
+    {
+        return YDRV_ERROR;
+    }
+
+    // tRES1期间芯片不响应命令
+    start_time = yDevGetTimeUS();
+    while ((yDevGetTimeUS() - start_time) < YDEV_25Q_TIME_RELEASE_US)
+    {
+    }
+    handle->flagPowerDown = 0;
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q空闲自动掉电定时器回调实现
+ * @note 在定时器服务任务中执行，不等待总线：总线被占用或有后台操作时说明不空闲，顺延检查
+ */
+static void yDev25q_SleepTimerCallback(TimerHandle_t timer)
+{
+    yDevHandle_25q_t *handle;
+    TickType_t period;
+    TickType_t idle;
+    yDevStatus_t status;
+
+    handle = (yDevHandle_25q_t *)pvTimerGetTimerID(timer);
+    if ((handle->sleep.ms == 0) || (handle->flagPowerDown != 0))
+    {
+        return;
+    }
+
+    period = pdMS_TO_TICKS(handle->sleep.ms) + 1;
+    idle = xTaskGetTickCount() - (TickType_t)handle->sleep.last;
+    if (idle < period)
+    {
+        (void)xTimerChangePeriod(timer, period - idle, 0);
+        return;
+    }
+    if ((handle->async.busy != 0) || (handle->erase.active != 0) || (handle->erase.read.buffer != NULL) ||
+        (yDev25q_Sched(handle)->owner != NULL))
+    {
+        (void)xTimerChangePeriod(timer, period, 0);
+        return;
+    }
+
+    // 只尝试一次，不等待也不唤醒
+    if (handle->bus_device.bus != NULL)
+    {
+        status = yDevSpiBusLockJob(&handle->bus_device, YDEV_BUSJOB_BACKGROUND, 0, 0);
+    }
+    else
+    {
+        status = yDevBusJobBegin(&handle->sched, YDEV_BUSJOB_BACKGROUND, 0, 0);
+    }
+    if (status != YDEV_OK)
+    {
+        (void)xTimerChangePeriod(timer, period, 0);
+        return;
+    }
+
+    // 独占总线时同时关闭SPI时钟，芯片编程未结束时掉电命令无效，下次访问后再试
+    if (yDev25q_PowerDown(handle, (handle->bus_device.bus == NULL) ? 1 : 0) == YDRV_OK)
+    {
+        handle->sleep.count++;
+    }
+    yDev25q_Unlock(handle);
+}
+
+/**
+ * @brief 写入25Q状态寄存器实现
+ */
+static yDrvStatus_t yDev25q_WriteStatus(yDevHandle_25q_t *handle, uint8_t reg, uint8_t value, uint8_t flag_volatile)
+{
+    static const uint8_t cmd_write[3] = {YDEV_25Q_CMD_WRITE_STATUS_REG1,
+                                         YDEV_25Q_CMD_WRITE_STATUS_REG2,
+                                         YDEV_25Q_CMD_WRITE_STATUS_REG3};
+    static const uint8_t cmd_read[3] = {YDEV_25Q_CMD_READ_STATUS_REG1,
+                                        YDEV_25Q_CMD_READ_STATUS_REG2,
+                                        YDEV_25Q_CMD_READ_STATUS_REG3};
+    uint8_t tx[2];
+
+    if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+        return YDRV_TIMEOUT;
+    }
+
+    // 易失性写使能(0x50)只改变寄存器的易失副本，非易失写入需要写使能(0x06)并等待tW
+    if (yDev25q_SendCmd(handle, (flag_volatile != 0) ? YDEV_25Q_CMD_VOLATILE_SR_ENABLE
+                                                     : YDEV_25Q_CMD_WRITE_ENABLE) != YDRV_OK)
+    {
+        return YDRV_ERROR;
+    }
+
+    tx[0] = cmd_write[reg - 1];
+    tx[1] = value;
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if (yDev25q_Spi_Transfer(handle, tx, NULL, 2) != 2)
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+        return YDRV_ERROR;
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中，开始写入
+
+    if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_WRITE_STATUS) != YDRV_OK)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+        return YDRV_TIMEOUT;
+    }
+
+    // 状态寄存器保护(SRP)或只读位使写入无效
+    if (yDev25q_ReadReg(handle, cmd_read[reg - 1]) != value)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_WRITE_PROTECTED;
+        return YDRV_ERROR;
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 读取25Q 64位唯一ID实现
+ */
+static yDrvStatus_t yDev25q_ReadUniqueId(yDevHandle_25q_t *handle, uint8_t *id)
+{
+    uint8_t tx[13] = {YDEV_25Q_CMD_READ_UNIQUE_ID, 0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t rx[13];
+
+    // 命令后四个空字节，之后8字节ID
+    memset(&tx[5], 0xFF, 8);
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if (yDev25q_Spi_Transfer(handle, tx, rx, sizeof(tx)) != (int32_t)sizeof(tx))
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+        return YDRV_ERROR;
+    }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+
+    memcpy(id, &rx[5], 8);
+    return YDRV_OK;
+}
+
+/**
+ * @brief 释放25Q SPI总线互斥锁实现
+ * @param handle 25Q设备句柄指针
+ */
+static void yDev25q_Unlock(yDevHandle_25q_t *handle)
+{
+    // 记录最近访问时刻，定时器未运行时启动，运行中的定时器到期后按最近时刻顺延
+    if ((handle->sleep.ms != 0) && (handle->sleep.timer != NULL) && (handle->flagPowerDown == 0))
+    {
+        handle->sleep.last = (uint32_t)xTaskGetTickCount();
+        if (xTimerIsTimerActive((TimerHandle_t)handle->sleep.timer) == pdFALSE)
+        {
+            (void)xTimerChangePeriod((TimerHandle_t)handle->sleep.timer, pdMS_TO_TICKS(handle->sleep.ms) + 1, 0);
+        }
+    }
+
+    if (handle->bus_device.bus != NULL)
+    {
+        yDevSpiBusUnlock(&handle->bus_device);
+        return;
+    }
+
+    yDevBusJobEnd(&handle->sched);
+}
+
+/**
+ * @brief 取25Q所在总线的作业调度器实现
+ * @param handle 25Q设备句柄指针
+ * @return 作业调度器指针
+ */
+static yDevBusSched_t *yDev25q_Sched(yDevHandle_25q_t *handle)
+{
+    return (handle->bus_device.bus != NULL) ? &handle->bus_device.bus->sched : &handle->sched;
+}
+
+/**
+ * @brief 数据段是否可用DMA实现
+ * @param handle 25Q设备句柄指针
+ * @return 1=可用, 0=不可用
+ */
+static uint8_t yDev25q_UseDma(yDevHandle_25q_t *handle)
+{
+    return (handle->flagDma != 0) &&
+           ((handle->xferMode == YDEV_25Q_XFER_AUTO) || (handle->xferMode == YDEV_25Q_XFER_DMA));
+}
+
+/**
+ * @brief 数据段是否可用中断实现
+ * @param handle 25Q设备句柄指针
+ * @return 1=可用, 0=不可用
+ */
+static uint8_t yDev25q_UseIrq(yDevHandle_25q_t *handle)
+{
+    return (handle->flagIrq != 0) &&
+           ((handle->xferMode == YDEV_25Q_XFER_AUTO) || (handle->xferMode == YDEV_25Q_XFER_IRQ));
+}
+
+/**
+ * @brief 25Q长作业安全点实现
+ * @param handle 25Q设备句柄指针
+ * @param limit 只让给类别小于该值的作业
+ * @retval uint8_t 1=已让出并重新获得总线, 0=未让出
+ */
+static uint8_t yDev25q_Yield(yDevHandle_25q_t *handle, yDevBusJobClass_t limit)
+{
+    uint8_t yielded;
+
+    if (handle->bus_device.bus != NULL)
+    {
+        yielded = yDevSpiBusYield(&handle->bus_device, limit);
+    }
+    else
+    {
+        yielded = yDevBusJobYield(&handle->sched, limit);
+    }
+
+    if ((yielded != 0) && (handle->flagPowerDown != 0))
+    {
+        (void)yDev25q_PowerUp(handle);
+    }
+    return yielded;
+}
+
+/**
+ * @brief 等待同步擦除完成实现
+ * @param handle 25Q设备句柄指针
+ * @param timeout_ms 擦除超时时间(毫秒)
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_EraseWait(yDevHandle_25q_t *handle, uint32_t timeout_ms)
+{
+    yDevBusSched_t *sched;
+    TickType_t start_tick;
+    TickType_t suspend_tick;
+
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+    {
+        return yDev25q_WaitBusy(handle, timeout_ms);
+    }
+
+    sched = yDev25q_Sched(handle);
+    start_tick = xTaskGetTickCount();
+    for (;;)
+    {
+        if ((yDev25q_ReadReg(handle, YDEV_25Q_CMD_READ_STATUS_REG1) & YDEV_25Q_STATUS_W25Q_BUSY) == 0)
+        {
+            return YDRV_OK;
+        }
+        if ((xTaskGetTickCount() - start_tick) > pdMS_TO_TICKS(timeout_ms))
+        {
+            return YDRV_TIMEOUT;
+        }
+
+        // 擦除挂起期间不能编程被擦除的扇区，只让给读取类作业
+        yDevBusJobSleep(sched, YDEV_25Q_ERASE_POLL_MS);
+        if ((yDevBusJobPreemptPending(sched, YDEV_BUSJOB_WRITE) == 0) ||
+            (yDev25q_SendCmd(handle, YDEV_25Q_CMD_ERASE_SUSPEND) != YDRV_OK))
+        {
+            continue;
+        }
+        suspend_tick = xTaskGetTickCount();
+        (void)yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM);
+        (void)yDev25q_Yield(handle, YDEV_BUSJOB_WRITE);
+        if (yDev25q_SendCmd(handle, YDEV_25Q_CMD_ERASE_RESUME) != YDRV_OK)
+        {
+            return YDRV_ERROR;
+        }
+        start_tick += xTaskGetTickCount() - suspend_tick;
+    }
+}
+
+/**
+ * @brief 挂起25Q后台擦除实现
+ * @param handle 25Q设备句柄指针
+ * @retval uint8_t 1=已挂起需恢复, 0=无需挂起
+ * @note 调用方须持有总线锁；挂起后等待BUSY清零(典型tSUS 20us)
+ */
+static uint8_t yDev25q_EraseSuspend(yDevHandle_25q_t *handle)
+{
+    if (handle->erase.active == 0)
+    {
+        return 0;
+    }
+
+    // 芯片未在擦除中，无需挂起
+    if ((yDev25q_ReadReg(handle, YDEV_25Q_CMD_READ_STATUS_REG1) & YDEV_25Q_STATUS_W25Q_BUSY) == 0)
+    {
+        return 0;
+    }
+
+    if (yDev25q_SendCmd(handle, YDEV_25Q_CMD_ERASE_SUSPEND) != YDRV_OK)
+    {
+        return 0;
+    }
+
+    // 等待挂起生效
+    yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM);
+
+    return 1;
+}
+
+/**
+ * @brief 25Q等待后台擦除完成实现
+ * @param handle 25Q设备句柄指针
+ * @note 写入和同步擦除前调用，保证与已入队的擦除请求顺序一致
+ */
+static void yDev25q_EraseWaitIdle(yDevHandle_25q_t *handle)
+{
+    yDev25qEraseJob_t *job;
+    BaseType_t state;
+
+    if (handle->erase.active == 0)
+    {
+        return;
+    }
+
+    state = xTaskGetSchedulerState();
+    if (state == taskSCHEDULER_NOT_STARTED)
+    {
+        // 工作任务尚未运行过，在调用者中按入队顺序同步执行，同步擦除忙等BUSY位
+        yDev25q_LockJob(handle, YDEV_BUSJOB_ERASE);
+        while (handle->erase.count != 0)
+        {
+            job = &handle->erase.queue[handle->erase.head];
+            if (yDev25q_Erase(handle, job->address, job->size) != YDRV_OK)
+            {
+                handle->base.errno |= YDEV_25Q_ERRNO_ERASE_FAIL;
+            }
+            handle->erase.head = (handle->erase.head + 1) % YDEV_25Q_ERASE_QUEUE_DEPTH;
+            handle->erase.count--;
+        }
+        handle->erase.active = 0;
+        yDev25q_Unlock(handle);
+        return;
+    }
+    if (state != taskSCHEDULER_RUNNING)
+    {
+        // 调度器挂起时工作任务可能正执行到一半，不能接管队列，只忙等片上的擦除结束
+        (void)yDev25q_WaitBusy(handle, handle->geometry.eraseTimeoutMs[YDEV_25Q_ERASE_TYPE_CHIP]);
+        return;
+    }
+
+    while (handle->erase.active != 0)
+    {
+        vTaskDelay(pdMS_TO_TICKS(YDEV_25Q_ERASE_POLL_MS));
+    }
+}
+
+/**
+ * @brief 25Q后台擦除工作任务实现
+ * @param arg 25Q设备句柄指针
+ */
+static void yDev25q_EraseTask(void *arg)
+{
+    yDevHandle_25q_t *handle;
+    yDev25qEraseJob_t *job;
+    uint32_t erase_address;
+    uint32_t erase_size;
+    uint32_t timeout_ms;
+    uint32_t expect = 0;
+    TickType_t start_tick;
+    uint8_t erase_type;
+    uint8_t busy;
+
+    handle = (yDevHandle_25q_t *)arg;
+
+    for (;;)
+    {
+        // 等待新的擦除或读取请求
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for (;;)
+        {
+            yDev25q_WorkerRead(handle);
+            yDev25q_WorkerFlush(handle);
+            yDev25q_WorkerPrefetch(handle);
+
+            yDev25q_LockJob(handle, YDEV_BUSJOB_BACKGROUND);
+            if (handle->erase.count == 0)
+            {
+                handle->erase.active = 0;
+                yDev25q_Unlock(handle);
+                break;
+            }
+
+            // 取队首请求并选择擦除方式
+            job = &handle->erase.queue[handle->erase.head];
+            erase_address = job->address;
+            erase_type = yDev25q_ErasePlan(handle, erase_address, job->size);
+            erase_size = handle->geometry.eraseSize[erase_type];
+            timeout_ms = handle->geometry.eraseTimeoutMs[erase_type];
+
+            if ((yDev25q_WaitBusy(handle, timeout_ms) != YDRV_OK) ||
+                (yDev25q_EraseStart(handle, erase_address, handle->geometry.eraseCmd[erase_type]) != YDRV_OK))
+            {
+                // 启动失败，丢弃该请求
+                handle->base.errno |= YDEV_25Q_ERRNO_ERASE_FAIL;
+                handle->erase.head = (handle->erase.head + 1) % YDEV_25Q_ERASE_QUEUE_DEPTH;
+                handle->erase.count--;
+                yDev25q_Unlock(handle);
+                continue;
+            }
+            yDev25q_Unlock(handle);
+
+            // 先休眠典型擦除耗时，再周期查询BUSY位，轮询间隙其他任务可挂起擦除进行读取
+            start_tick = xTaskGetTickCount();
+            vTaskDelay(pdMS_TO_TICKS(handle->geometry.eraseTypMs[erase_type]));
+            do
+            {
+                vTaskDelay(pdMS_TO_TICKS(YDEV_25Q_ERASE_POLL_MS));
+                yDev25q_WorkerRead(handle); // 读取请求不等整个擦除结束
+                yDev25q_WorkerPrefetch(handle);
+                yDev25q_LockJob(handle, YDEV_BUSJOB_BACKGROUND);
+                busy = yDev25q_ReadReg(handle, YDEV_25Q_CMD_READ_STATUS_REG1) & YDEV_25Q_STATUS_W25Q_BUSY;
+                yDev25q_Unlock(handle);
+            } while ((busy != 0) &&
+                     ((xTaskGetTickCount() - start_tick) <= pdMS_TO_TICKS(timeout_ms)));
+
+            yDev25q_LockJob(handle, YDEV_BUSJOB_BACKGROUND);
+            if (busy != 0)
+            {
+                handle->base.errno |= YDEV_25Q_ERRNO_TIMEOUT;
+            }
+            else if ((handle->flagVerify != 0) &&
+                     (yDev25q_Verify(handle, erase_address, NULL, erase_size,
+                                     yDev25q_VerifyPrepare(handle, NULL, erase_size, &expect), expect) != YDRV_OK))
+            {
+                handle->base.errno |= YDEV_25Q_ERRNO_ERASE_FAIL;
+            }
+            // 擦除期间挂起读取可能缓存了中间状态数据
+            yDev25q_CacheInvalidate(handle, erase_address, erase_size);
+
+            // 推进请求，完成后出队
+            job->address += erase_size;
+            job->size -= erase_size;
+            if (job->size == 0)
+            {
+                handle->erase.head = (handle->erase.head + 1) % YDEV_25Q_ERASE_QUEUE_DEPTH;
+                handle->erase.count--;
+            }
+            yDev25q_Unlock(handle);
+        }
+    }
+}
+
+/**
+ * @brief 按需创建25Q后台工作任务实现
+ */
+static yDevStatus_t yDev25q_WorkerStart(yDevHandle_25q_t *handle)
+{
+    int32_t slot;
+
+#if (YDEV_25Q_BG_ERASE_ENABLE == 0)
+    if (handle->bus_device.bus == NULL)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+#endif
+
+    if (handle->erase.task == NULL)
+    {
+        slot = OS_POOL_CLAIM(ydev_25q_task, handle);
+        if (slot < 0)
+        {
+            handle->base.errno = YDEV_25Q_ERRNO_NO_MEMORY;
+            return YDEV_ERROR;
+        }
+        handle->erase.task = (void *)OS_TASK_POOL_CREATE(ydev_25q_task,
+                                                         slot,
+                                                         yDev25q_EraseTask,
+                                                         "25qErase",
+                                                         handle,
+                                                         YDEV_25Q_ERASE_TASK_PRIO);
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 在工作任务中执行后台读取请求实现
+ */
+static void yDev25q_WorkerRead(yDevHandle_25q_t *handle)
+{
+    uint8_t *buffer;
+    uint32_t size;
+    int32_t ret;
+
+    buffer = handle->erase.read.buffer;
+    if (buffer == NULL)
+    {
+        return;
+    }
+
+    size = handle->erase.read.size;
+    ret = yDev25qRead(handle, handle->erase.read.address, buffer, size);
+    handle->erase.read.buffer = NULL;
+
+    yDevAsyncComplete(handle, YDEV_ASYNC_READ,
+                      (ret == (int32_t)size) ? YDEV_OK : YDEV_ERROR,
+                      (ret > 0) ? (uint32_t)ret : 0);
+}
+
+/**
+ * @brief 25Q写回缓冲超时定时器回调实现
+ * @note 编程需要总线锁，交给工作任务执行
+ */
+static void yDev25q_WbackTimerCallback(TimerHandle_t timer)
+{
+    yDevHandle_25q_t *handle;
+
+    handle = (yDevHandle_25q_t *)pvTimerGetTimerID(timer);
+    handle->wback.due = 1;
+    if (handle->erase.task != NULL)
+    {
+        xTaskNotifyGive((TaskHandle_t)handle->erase.task);
+    }
+}
+
+/**
+ * @brief 在工作任务中写出超时的写回缓冲实现
+ */
+static void yDev25q_WorkerFlush(yDevHandle_25q_t *handle)
+{
+    if (handle->wback.due == 0)
+    {
+        return;
+    }
+
+    yDev25q_LockJob(handle, YDEV_BUSJOB_BACKGROUND);
+    handle->wback.due = 0;
+    (void)yDev25q_WbackFlush(handle);
+    handle->wback.timeouts++;
+    yDev25q_Unlock(handle);
+}
+
+/**
+ * @brief 在工作任务中补充25Q预读缓冲实现
+ * @note 请求之后窗口可能已被读取推进或失效，持锁后按当时的状态计算要读的范围
+ */
+static void yDev25q_WorkerPrefetch(yDevHandle_25q_t *handle)
+{
+    yDev25qPrefetch_t *pf = &handle->prefetch;
+    yDrvSpiSeg_t seg[YDEV_25Q_PREFETCH_PAGE_MAX + 1];
+    uint8_t read_cmd[5];
+    uint32_t address;
+    uint32_t used;
+    uint32_t len;
+    uint32_t n;
+    int32_t done;
+    uint8_t suspended;
+
+    if (pf->pending == 0)
+    {
+        return;
+    }
+
+    // 异步写入在中断中占用总线，放弃本次补充
+    yDev25q_LockJob(handle, YDEV_BUSJOB_BACKGROUND);
+    if ((pf->pending == 0) || (pf->count == 0) || (handle->async.busy != 0))
+    {
+        pf->pending = 0;
+        yDev25q_Unlock(handle);
+        return;
+    }
+    pf->pending = 0;
+
+    // 1. 窗口之后的数据依次读入空闲页，末页不满只会出现在芯片末尾
+    used = (pf->valid + YDEV_25Q_PAGE_SIZE - 1) / YDEV_25Q_PAGE_SIZE;
+    address = pf->address + pf->valid;
+    if (((pf->valid % YDEV_25Q_PAGE_SIZE) != 0) || (used >= pf->count) || (address >= handle->size))
+    {
+        yDev25q_Unlock(handle);
+        return;
+    }
+    len = (pf->count - used) * YDEV_25Q_PAGE_SIZE;
+    if (len > (handle->size - address))
+    {
+        len = handle->size - address;
+    }
+
+    read_cmd[0] = (handle->flagFastRead != 0) ? YDEV_25Q_CMD_FAST_READ : YDEV_25Q_CMD_READ_DATA;
+    read_cmd[1] = (address >> 16) & 0xFF; // 地址高字节
+    read_cmd[2] = (address >> 8) & 0xFF;  // 地址中字节
+    read_cmd[3] = address & 0xFF;         // 地址低字节
+    read_cmd[4] = 0xFF;                   // 快速读取空字节
+    seg[0].tx = read_cmd;
+    seg[0].rx = NULL;
+    seg[0].len = (handle->flagFastRead != 0) ? 5 : 4;
+    for (n = 1; len > 0; n++)
+    {
+        seg[n].tx = NULL;
+        seg[n].rx = pf->line[(pf->head + used + n - 1) % pf->count]->data;
+        seg[n].len = (len > YDEV_25Q_PAGE_SIZE) ? YDEV_25Q_PAGE_SIZE : len;
+        len -= seg[n].len;
+    }
+
+    // 2. 一次片选完成整条链，后台擦除进行中时挂起
+    suspended = yDev25q_EraseSuspend(handle);
+    done = -1;
+    if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) == YDRV_OK)
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT);
+        done = yDev25q_Spi_TransferSg(handle, seg, n) - (int32_t)seg[0].len;
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT);
+    }
+    if (suspended != 0)
+    {
+        yDev25q_SendCmd(handle, YDEV_25Q_CMD_ERASE_RESUME);
+    }
+
+    // 3. 只接受整页，传输不完整时丢弃不足一页的尾部，由读取方直接访问芯片
+    if (done > 0)
+    {
+        if (((uint32_t)done + address) < handle->size)
+        {
+            done -= done % YDEV_25Q_PAGE_SIZE;
+        }
+        pf->valid += (uint32_t)done;
+    }
+    pf->issued++;
+    yDev25q_Unlock(handle);
+}
+
+/**
+ * @brief yDev异步写入完成回调实现
+ */
+static void yDev25q_DevWriteDone(void *arg, yDevStatus_t status)
+{
+    yDevHandle_25q_t *handle = (yDevHandle_25q_t *)arg;
+    uint32_t len = 0;
+
+    // 成功时async.address已推进到最后一页之后
+    if (status == YDEV_OK)
+    {
+        handle->address = handle->async.address;
+        len = handle->base.async[YDEV_ASYNC_WRITE].size;
+    }
+
+    yDevAsyncComplete(handle, YDEV_ASYNC_WRITE, status, len);
+}
+
+/**
+ * @brief 初始化25Q DMA读取通道实现
+ * @param config 25Q设备配置结构体指针
+ * @param handle 25Q设备句柄指针
+ * @retval yDrvStatus_t 操作状态
+ * @note 接收通道优先级高于发送通道，避免接收FIFO溢出
+ */
+static yDrvStatus_t yDev25q_DmaInit(yDevConfig_25q_t *config, yDevHandle_25q_t *handle)
+{
+    // 软件SPI不支持DMA
+    if ((config->spiId != YDRV_SPI_1) && (config->spiId != YDRV_SPI_2))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    if (yDrvSpiDmaInit(handle->spi,
+                       config->rxDmaChannel,
+                       config->txDmaChannel,
+                       YDEV_25Q_DMA_IRQ_PRIO) != YDRV_OK)
+    {
+        return YDRV_ERROR;
+    }
+
+    handle->flagDma = 1;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q DMA批量传输数据实现
+ * @param handle 25Q设备句柄指针
+ * @param tx_data 发送数据缓冲区指针
+ * @param rx_buff 接收数据缓冲区指针
+ * @param size 传输数据大小
+ * @retval int32_t 实际传输的字节数
+ */
+static int32_t yDev25q_DmaTransfer(yDevHandle_25q_t *handle, const void *tx_data, void *rx_buff, uint32_t size)
+{
+    yDrvSpiSeg_t seg;
+
+    if (size > YDEV_25Q_DMA_MAX_SIZE)
+    {
+        size = YDEV_25Q_DMA_MAX_SIZE;
+    }
+
+    seg.tx = tx_data;
+    seg.rx = rx_buff;
+    seg.len = size;
+
+    return yDev25q_DmaTransferSg(handle, &seg, 1, size);
+}
+
+/**
+ * @brief 25Q DMA分段传输数据实现
+ * @param handle 25Q设备句柄指针
+ * @param seg 分段描述符数组
+ * @param count 分段数量
+ * @param total 各分段总字节数
+ * @retval int32_t 实际传输的字节数
+ * @note 按参考手册顺序启动：先接收通道和RXDMAEN，再发送通道和TXDMAEN
+ */
+static int32_t yDev25q_DmaTransferSg(yDevHandle_25q_t *handle, const yDrvSpiSeg_t *seg, uint32_t count, uint32_t total)
+{
+    uint32_t remain;
+    uint8_t flag_wait;
+#if YDEV_25Q_SPI_STATS
+    uint32_t start = yDevGetTimeUS();
+#endif
+
+    // 1. 记录等待任务，调度器未启动时退回轮询完成标志
+    flag_wait = (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) ? 1 : 0;
+    handle->flagDmaDone = 0;
+    handle->dma_wait_task = (flag_wait != 0) ? (void *)xTaskGetCurrentTaskHandle() : NULL;
+    if (flag_wait != 0)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, 0); // 清除残留通知
+    }
+
+    // 2. 启动传输，发送缓冲为NULL的分段由SPI驱动发送0xFF产生读时钟
+    if (yDrvSpiTransferDmaSg(handle->spi, seg, count, yDev25q_DmaRxCallback, handle) != YDRV_OK)
+    {
+        handle->dma_wait_task = NULL;
+        return 0;
+    }
+
+    // 3. 等待全部分段完成
+    yDev25q_TransferWait(handle, flag_wait);
+
+    // 4. 超时则中止传输，统计已接收字节
+    remain = 0;
+    if (handle->flagDmaDone == 0)
+    {
+        remain = yDrvSpiTransferDmaAbort(handle->spi);
+#if YDEV_25Q_SPI_STATS
+        handle->stats.timeouts++;
+#endif
+    }
+    else if (handle->spi->dma.status != YDRV_OK)
+    {
+        remain = total;
+    }
+    handle->dma_wait_task = NULL;
+
+#if YDEV_25Q_SPI_STATS
+    yDev25q_StatsRecord(handle, &handle->stats.dma, total, total - remain, start);
+#endif
+    return (int32_t)(total - remain);
+}
+
+/**
+ * @brief 25Q中断驱动传输数据实现
+ * @param handle 25Q设备句柄指针
+ * @param tx_data 发送数据缓冲区指针
+ * @param rx_buff 接收数据缓冲区指针
+ * @param size 传输数据大小
+ * @retval int32_t 实际传输的字节数
+ */
+static int32_t yDev25q_ItTransfer(yDevHandle_25q_t *handle, const void *tx_data, void *rx_buff, uint32_t size)
+{
+    uint32_t remain;
+#if YDEV_25Q_SPI_STATS
+    uint32_t start = yDevGetTimeUS();
+#endif
+
+    // 1. 记录等待任务并清除残留通知
+    handle->flagDmaDone = 0;
+    handle->dma_wait_task = (void *)xTaskGetCurrentTaskHandle();
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+
+    // 2. 启动传输，完成回调与DMA共用
+    if (yDrvSpiTransferIt(handle->spi, tx_data, rx_buff, size, yDev25q_DmaRxCallback, handle) != YDRV_OK)
     {
-        handle_25q->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
-        return -1;
+        handle->dma_wait_task = NULL;
+        return 0;
     }
 
-    // 等待芯片就绪
-    if (yDev25q_WaitBusy(handle_25q, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    // 3. 等待完成，超时则中止传输
+    yDev25q_TransferWait(handle, 1);
+
+    remain = 0;
+    if (handle->flagDmaDone == 0)
     {
-        handle_25q->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
-        return -1;
+        remain = yDrvSpiTransferItAbort(handle->spi);
+#if YDEV_25Q_SPI_STATS
+        handle->stats.timeouts++;
+#endif
+    }
+    else if (handle->spi->it.status != YDRV_OK)
+    {
+        remain = size;
     }
+    handle->dma_wait_task = NULL;
 
-    // 构建读取命令
-    yDrvSpiCsControl(&handle_25q->spi_handle, 1); // 选中芯片(CS拉低)
-    read_cmd[0] = YDEV_25Q_CMD_READ_DATA;
-    read_cmd[1] = (handle_25q->address >> 16) & 0xFF; // 地址高字节
-    read_cmd[2] = (handle_25q->address >> 8) & 0xFF;  // 地址中字节
-    read_cmd[3] = handle_25q->address & 0xFF;         // 地址低字节
+#if YDEV_25Q_SPI_STATS
+    yDev25q_StatsRecord(handle, &handle->stats.irq, size, size - remain, start);
+#endif
+    return (int32_t)(size - remain);
+}
+
+/**
+ * @brief 记录一次25Q SPI传输统计实现
+ * @param handle 25Q设备句柄指针
+ * @param counter 传输方式计数器指针
+ * @param request 请求的字节数
+ * @param done 实际传输的字节数
+ * @param start 传输开始时的微秒时间戳
+ * @retval 无
+ */
+static void yDev25q_StatsRecord(yDevHandle_25q_t *handle, uint32_t *counter,
+                                uint32_t request, uint32_t done, uint32_t start)
+{
+    uint32_t us;
+    uint32_t bucket;
 
-    if (yDev25q_Spi_Transfer(handle_25q, read_cmd, NULL, 4) != 4) // 发送读取命令和地址
+    us = yDevGetTimeUS() - start;
+
+    (*counter)++;
+    handle->stats.transfers++;
+    handle->stats.bytes += done;
+    if (done != request)
     {
-        yDrvSpiCsControl(&handle_25q->spi_handle, 0); // 取消选中
-        handle_25q->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-        return -1;
+        handle->stats.shortCount++;
+    }
+    if (us > handle->stats.maxUs)
+    {
+        handle->stats.maxUs = us;
+    }
+
+    // 桶号为耗时的有效位数
+    bucket = 0;
+    while ((us != 0) && (bucket < (YDEV_25Q_STATS_BUCKETS - 1)))
+    {
+        us >>= 1;
+        bucket++;
+    }
+    handle->stats.hist[bucket]++;
+}
+
+/**
+ * @brief 等待25Q异步传输完成实现
+ * @param handle 25Q设备句柄指针
+ * @param flag_wait 非0表示阻塞等待任务通知
+ */
+static void yDev25q_TransferWait(yDevHandle_25q_t *handle, uint8_t flag_wait)
+{
+    uint32_t start_time;
+
+    if (flag_wait != 0)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(handle->base.timeOutMs));
+        return;
     }
 
-    // 逐字节读取数据
     start_time = yDevGetTimeMS();
-    write_data = 0xFF; // 发送空数据以时钟Flash输出数据
-    index = 0;
+    while ((handle->flagDmaDone == 0) &&
+           ((yDevGetTimeMS() - start_time) <= handle->base.timeOutMs))
+    {
+    }
+}
 
-    while (index < size)
+/**
+ * @brief 25Q DMA/中断传输完成回调实现
+ * @param arg 25Q设备句柄指针
+ * @param status 传输结果
+ */
+static void yDev25q_DmaRxCallback(void *arg, yDrvStatus_t status)
+{
+    yDevHandle_25q_t *handle;
+    BaseType_t woken;
+
+    (void)status;
+    handle = (yDevHandle_25q_t *)arg;
+    woken = pdFALSE;
+    handle->flagDmaDone = 1;
+
+    if (handle->dma_wait_task != NULL)
+    {
+        vTaskNotifyGiveFromISR((TaskHandle_t)handle->dma_wait_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 25Q异步写入发起下一页编程实现
+ * @param handle 25Q设备句柄指针
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_AsyncIssuePage(yDevHandle_25q_t *handle)
+{
+    uint32_t write_size;
+
+    // 本次编程不跨页
+    write_size = YDEV_25Q_PAGE_SIZE - (handle->async.address % YDEV_25Q_PAGE_SIZE);
+    if (write_size > handle->async.remain)
+    {
+        write_size = handle->async.remain;
+    }
+
+    if (yDev25q_ProgramStart(handle, handle->async.address, handle->async.buffer, write_size) != YDRV_OK)
+    {
+        return YDRV_ERROR;
+    }
+
+    handle->async.buffer += write_size;
+    handle->async.address += write_size;
+    handle->async.remain -= write_size;
+    handle->async.start_tick = (uint32_t)xTaskGetTickCount();
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 25Q异步写入结束处理实现
+ * @param handle 25Q设备句柄指针
+ * @param status 写入结果
+ */
+static void yDev25q_AsyncFinish(yDevHandle_25q_t *handle, yDevStatus_t status)
+{
+    xTimerStop((TimerHandle_t)handle->async.timer, 0);
+    handle->async.busy = 0;
+
+    if (handle->async.callback != NULL)
+    {
+        handle->async.callback(handle->async.arg, status);
+    }
+}
+
+/**
+ * @brief 25Q异步写入轮询定时器回调实现
+ * @param timer FreeRTOS软件定时器句柄
+ */
+static void yDev25q_AsyncTimerCallback(TimerHandle_t timer)
+{
+    yDevHandle_25q_t *handle;
+    uint8_t flag_busy;
+    uint8_t flag_issue;
+    yDrvStatus_t issue;
+
+    handle = (yDevHandle_25q_t *)pvTimerGetTimerID(timer);
+    if ((handle == NULL) || (handle->async.busy == 0))
+    {
+        return;
+    }
+
+    // 持锁访问芯片，完成回调在解锁后调用，回调中可再次访问本设备；
+    // 总线被其他任务占用时不等待，定时器自动重装，下个周期再查询，不拖住其他软件定时器
+    issue = YDRV_OK;
+    if (yDev25q_TryLock(handle) != YDRV_OK)
+    {
+        return;
+    }
+    flag_busy = ((yDev25q_ReadReg(handle, YDEV_25Q_CMD_READ_STATUS_REG1) & YDEV_25Q_STATUS_W25Q_BUSY) != 0) ? 1 : 0;
+    flag_issue = ((flag_busy == 0) && (handle->async.remain != 0)) ? 1 : 0;
+    if (flag_issue != 0)
+    {
+        issue = yDev25q_AsyncIssuePage(handle); // 发起下一页编程
+    }
+    yDev25q_Unlock(handle);
+
+    // 芯片仍在编程，检查本页是否超时
+    if (flag_busy != 0)
     {
-        // 检查超时
-        if (yDevGetTimeMS() - start_time > handle_25q->base.timeOutMs)
+        if (((uint32_t)xTaskGetTickCount() - handle->async.start_tick) >
+            pdMS_TO_TICKS(YDEV_25Q_TIMEOUT_PAGE_PROGRAM))
         {
-            yDrvSpiCsControl(&handle_25q->spi_handle, 0); // 取消选中(CS拉高)
-            handle_25q->address += index;
-            handle_25q->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
-            return (int32_t)index;
+            handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
+            yDev25q_AsyncFinish(handle, YDEV_TIMEOUT);
         }
+        return;
+    }
 
-        // 发送空字节并读取数据
-        len = yDrvSpiWriteByte(&handle_25q->spi_handle, &write_data);
-        if (len == 0)
+    if (flag_issue != 0)
+    {
+        if (issue != YDRV_OK)
         {
-            continue; // 如果写入失败，重试
+            handle->base.errno = YDEV_25Q_ERRNO_WRITE_FAIL;
+            yDev25q_AsyncFinish(handle, YDEV_ERROR);
         }
+        return;
+    }
 
-        len = yDrvSpiReadByte(&handle_25q->spi_handle, &read_buff[index]);
-        index += len;
+    // 全部数据已编程完成
+    yDev25q_AsyncFinish(handle, YDEV_OK);
+}
+
+/**
+ * @brief 25Q几何参数填充默认值实现
+ * @param geometry 几何参数结构体指针
+ */
+static void yDev25q_GeometryDefault(yDev25qGeometry_t *geometry)
+{
+    memset(geometry, 0, sizeof(*geometry));
+
+    geometry->eraseSize[0] = YDEV_25Q_SECTOR_SIZE;
+    geometry->eraseCmd[0] = YDEV_25Q_CMD_SECTOR_ERASE;
+    geometry->eraseTypMs[0] = 45;
+    geometry->eraseTimeoutMs[0] = YDEV_25Q_TIMEOUT_SECTOR_ERASE;
+
+    geometry->eraseSize[1] = YDEV_25Q_HALF_BLOCK_SIZE;
+    geometry->eraseCmd[1] = YDEV_25Q_CMD_BLOCK_ERASE_32K;
+    geometry->eraseTypMs[1] = 120;
+    geometry->eraseTimeoutMs[1] = YDEV_25Q_TIMEOUT_BLOCK_ERASE_32K;
+
+    geometry->eraseSize[2] = YDEV_25Q_BLOCK_SIZE;
+    geometry->eraseCmd[2] = YDEV_25Q_CMD_BLOCK_ERASE;
+    geometry->eraseTypMs[2] = 150;
+    geometry->eraseTimeoutMs[2] = YDEV_25Q_TIMEOUT_BLOCK_ERASE_64K;
+
+    geometry->eraseCmd[YDEV_25Q_ERASE_TYPE_CHIP] = YDEV_25Q_CMD_CHIP_ERASE;
+    geometry->eraseTypMs[YDEV_25Q_ERASE_TYPE_CHIP] = YDEV_25Q_TIMEOUT_CHIP_ERASE / 4;
+    geometry->eraseTimeoutMs[YDEV_25Q_ERASE_TYPE_CHIP] = YDEV_25Q_TIMEOUT_CHIP_ERASE;
+    geometry->fastRead = 1;
+    geometry->quadRead = 0x03;
+}
+
+/**
+ * @brief 读取25Q SFDP数据实现
+ * @param handle 25Q设备句柄指针
+ * @param address SFDP地址
+ * @param buffer 数据缓冲区指针
+ * @param size 读取大小
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_SfdpRead(yDevHandle_25q_t *handle, uint32_t address, void *buffer, uint32_t size)
+{
+    uint8_t read_cmd[5];
+
+    read_cmd[0] = YDEV_25Q_CMD_READ_SFDP;
+    read_cmd[1] = (address >> 16) & 0xFF; // 地址高字节
+    read_cmd[2] = (address >> 8) & 0xFF;  // 地址中字节
+    read_cmd[3] = address & 0xFF;         // 地址低字节
+    read_cmd[4] = 0xFF;                   // 空字节
+
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_SELECT); // 选中芯片
+    if ((yDev25q_Spi_Transfer(handle, read_cmd, NULL, 5) != 5) ||
+        (yDev25q_Spi_Transfer(handle, NULL, buffer, size) != (int32_t)size))
+    {
+        yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
+        return YDRV_ERROR;
     }
+    yDrvSpiCsControl(handle->spi, YDRV_SPI_CS_DESELECT); // 取消选中
 
-    yDrvSpiCsControl(&handle_25q->spi_handle, 0); // 取消选中(CS拉高)
+    return YDRV_OK;
+}
 
-    // 更新位置
-    handle_25q->address += index;
+/**
+ * @brief SFDP擦除耗时字段转换为毫秒
+ * @param count 耗时计数字段 (5位)
+ * @param unit 单位字段 (2位: 1ms/16ms/128ms/1s)
+ * @retval uint32_t 耗时(毫秒)
+ */
+static uint32_t yDev25q_SfdpEraseTime(uint32_t count, uint32_t unit)
+{
+    static const uint16_t unit_ms[4] = {1, 16, 128, 1000};
 
-    return (int32_t)index;
+    return (count + 1) * unit_ms[unit & 0x03];
 }
 
 /**
- * @brief 25Q设备写入操作 (页编程)
+ * @brief 解析25Q SFDP基本参数表实现
  * @param handle 25Q设备句柄指针
- * @param buffer 写入数据缓冲区指针
- * @param size 写入数据大小
- * @retval int32_t 实际写入的字节数，-1表示错误
- * @note 向25Q Flash写入数据，自动处理页边界和写使能
- * @note 使用设备句柄中的address字段作为起始地址
+ * @retval yDrvStatus_t 操作状态
  */
-static int32_t yDev_25q_Write(void *handle, const void *buffer, uint16_t size)
+static yDrvStatus_t yDev25q_ReadSfdp(yDevHandle_25q_t *handle)
 {
-    yDevHandle_25q_t *handle_25q;
-    const uint8_t *write_buff;
-    uint32_t current_address;
-    uint32_t total_written;
-    uint32_t page_offset;
-    uint32_t write_size;
+    yDev25qGeometry_t geometry;
+    uint8_t header[16];
+    uint32_t dword[11];
+    uint32_t table_addr;
+    uint32_t table_len;
+    uint32_t density;
+    uint32_t multiplier;
+    uint32_t erase_size;
+    uint32_t i, j;
+    uint8_t count;
 
-    // 参数有效性检查
-    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    // 1. 读取SFDP头和第一个参数头(基本参数表)
+    if (yDev25q_SfdpRead(handle, 0, header, sizeof(header)) != YDRV_OK)
     {
-        return -1;
+        return YDRV_ERROR;
     }
 
-    handle_25q = (yDevHandle_25q_t *)handle;
-    write_buff = (const uint8_t *)buffer;
-    total_written = 0;
-    // 检查地址有效性
-    if ((handle_25q->address + size) > handle_25q->size)
+    if ((header[0] != 'S') || (header[1] != 'F') || (header[2] != 'D') || (header[3] != 'P') ||
+        (header[8] != 0x00))
     {
-        handle_25q->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
-        return -1;
+        return YDRV_ERROR;
     }
 
-    current_address = handle_25q->address;
+    table_len = header[11];
+    table_addr = (uint32_t)header[12] | ((uint32_t)header[13] << 8) | ((uint32_t)header[14] << 16);
+    if (table_len < 9)
+    {
+        return YDRV_ERROR;
+    }
+    if (table_len > (sizeof(dword) / sizeof(dword[0])))
+    {
+        table_len = sizeof(dword) / sizeof(dword[0]);
+    }
 
-    // 按页写入数据循环
-    while (total_written < size)
+    // 2. 读取基本参数表 (小端DWORD)
+    memset(dword, 0, sizeof(dword));
+    if (yDev25q_SfdpRead(handle, table_addr, dword, table_len * 4) != YDRV_OK)
     {
-        // 计算当前页内偏移和本次写入大小
-        page_offset = current_address % YDEV_25Q_PAGE_SIZE;
-        write_size = YDEV_25Q_PAGE_SIZE - page_offset;
-        if (write_size > (size - total_written))
+        return YDRV_ERROR;
+    }
+
+    // 3. 容量 (DW2): bit31=0时为位数-1，否则为2^N位
+    density = dword[1];
+    if ((density & 0x80000000UL) == 0)
+    {
+        handle->size = (density + 1) / 8;
+    }
+    else if ((density & 0x7FFFFFFFUL) >= 3 && (density & 0x7FFFFFFFUL) < 35)
+    {
+        handle->size = 1UL << ((density & 0x7FFFFFFFUL) - 3);
+    }
+    else
+    {
+        return YDRV_ERROR;
+    }
+
+    // 4. 擦除类型 (DW8/DW9): 每种类型为 [大小指数N][命令]
+    yDev25q_GeometryDefault(&geometry);
+    memset(geometry.eraseSize, 0, sizeof(geometry.eraseSize));
+    count = 0;
+    for (i = 0; i < YDEV_25Q_ERASE_TYPE_MAX; i++)
+    {
+        uint32_t field = (dword[7 + i / 2] >> ((i % 2) * 16)) & 0xFFFF;
+        uint32_t erase_time;
+        uint32_t erase_max;
+
+        if ((field & 0xFF) == 0)
         {
-            write_size = size - total_written;
+            continue;
         }
+        erase_size = 1UL << (field & 0xFF);
 
-        // 处理非对齐写入 (读取-修改-写入)
-        if ((page_offset != 0) ||
-            (write_size != YDEV_25Q_PAGE_SIZE))
+        // 擦除耗时 (DW10, JESD216A及以上)
+        erase_time = geometry.eraseTypMs[(count < 3) ? count : 2];
+        erase_max = YDEV_25Q_TIMEOUT_BLOCK_ERASE_64K;
+        if (table_len >= 10)
         {
-            uint8_t page_buffer[YDEV_25Q_PAGE_SIZE];
-            uint32_t page_start = current_address & ~(YDEV_25Q_PAGE_SIZE - 1);
+            multiplier = 2 * ((dword[9] & 0x0F) + 1);
+            erase_time = yDev25q_SfdpEraseTime((dword[9] >> (4 + i * 7)) & 0x1F,
+                                               (dword[9] >> (9 + i * 7)) & 0x03);
+            erase_max = erase_time * multiplier;
+        }
 
-            // 保存当前地址并读取整页数据
-            uint32_t saved_address = handle_25q->address;
-            handle_25q->address = page_start;
-            if (yDev_25q_Read(handle, page_buffer, YDEV_25Q_PAGE_SIZE) != YDEV_25Q_PAGE_SIZE)
-            {
-                handle_25q->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-                return -1;
-            }
+        // 按擦除大小升序插入
+        for (j = count; (j > 0) && (geometry.eraseSize[j - 1] > erase_size); j--)
+        {
+            geometry.eraseSize[j] = geometry.eraseSize[j - 1];
+            geometry.eraseCmd[j] = geometry.eraseCmd[j - 1];
+            geometry.eraseTypMs[j] = geometry.eraseTypMs[j - 1];
+            geometry.eraseTimeoutMs[j] = geometry.eraseTimeoutMs[j - 1];
+        }
+        geometry.eraseSize[j] = erase_size;
+        geometry.eraseCmd[j] = (uint8_t)(field >> 8);
+        geometry.eraseTypMs[j] = erase_time;
+        geometry.eraseTimeoutMs[j] = erase_max;
+        count++;
+    }
+    if (count == 0)
+    {
+        return YDRV_ERROR;
+    }
 
-            // 修改页数据并写入整页
-            memcpy(&page_buffer[page_offset], &write_buff[total_written], write_size);
-            if (yDev25q_WritePage(handle_25q, page_start, page_buffer) != YDRV_OK)
-            {
-                handle_25q->base.errno = YDEV_25Q_ERRNO_WRITE_FAIL;
-                return -1;
-            }
+    // 5. 页大小和全片擦除耗时 (DW11)；编程按YDEV_25Q_PAGE_SIZE分页，页更小的器件会在页内回绕，不能使用
+    if (table_len >= 11)
+    {
+        static const uint32_t chip_unit_ms[4] = {16, 256, 4000, 64000};
 
-            handle_25q->address = saved_address; // 恢复地址
-        }
-        else
+        if ((1UL << ((dword[10] >> 4) & 0x0F)) < YDEV_25Q_PAGE_SIZE)
         {
-            // 整页写入
-            if (yDev25q_WritePage(handle_25q, current_address, &write_buff[total_written]) != YDRV_OK)
-            {
-                handle_25q->base.errno = YDEV_25Q_ERRNO_WRITE_FAIL;
-                return -1;
-            }
+            return YDRV_ERROR;
         }
-
-        // 更新计数器和地址
-        total_written += write_size;
-        current_address += write_size;
+        geometry.eraseTypMs[YDEV_25Q_ERASE_TYPE_CHIP] =
+            (((dword[10] >> 24) & 0x1F) + 1) * chip_unit_ms[(dword[10] >> 29) & 0x03];
+        geometry.eraseTimeoutMs[YDEV_25Q_ERASE_TYPE_CHIP] =
+            geometry.eraseTypMs[YDEV_25Q_ERASE_TYPE_CHIP] * 2 * (((dword[10] >> 0) & 0x0F) + 1);
     }
 
-    // 更新设备地址
-    handle_25q->address = current_address;
+    // 6. 1-1-1快速读取为SFDP器件的基本能力，四线读取见DW1 bit22(1-1-4)和bit21(1-4-4)
+    geometry.fastRead = 1;
+    geometry.quadRead = (uint8_t)((((dword[0] >> 22) & 0x01) << 0) | (((dword[0] >> 21) & 0x01) << 1));
+    geometry.fromSfdp = 1;
+    handle->geometry = geometry;
 
-    return (int32_t)total_written;
+    return YDRV_OK;
 }
 
 /**
- * @brief 25Q设备控制操作
+ * @brief 设置25Q读缓存行数实现
  * @param handle 25Q设备句柄指针
- * @param cmd 控制命令
- * @param arg 命令参数指针
- * @retval yDevStatus_t 操作状态
- *         - YDEV_OK: 操作成功
- *         - YDEV_INVALID_PARAM: 参数无效
- *         - YDEV_NOT_SUPPORTED: 不支持的命令
- *         - YDEV_ERROR: 操作失败
- * @note 执行25Q设备的控制操作，如芯片擦除、读取JEDEC ID等
+ * @param lines 缓存行数，0=关闭缓存
+ * @retval uint32_t 实际分配的缓存行数
  */
-static yDevStatus_t yDev_25q_Ioctl(void *handle, uint32_t cmd, void *arg)
+static uint32_t yDev25q_CacheSetup(yDevHandle_25q_t *handle, uint32_t lines)
 {
-    yDevHandle_25q_t *handle_25q;
+#if (YDEV_25Q_CACHE_POOL_LINES > 0)
+    yDev25qCacheLine_t *line;
+    uint8_t err;
+    uint32_t i;
 
-    // 参数有效性检查
-    if (handle == NULL)
+    // 归还已有缓存行
+    for (i = 0; i < handle->cache.count; i++)
     {
-        return YDEV_INVALID_PARAM;
+        YLibMemPut(ydev_25q_cache_pool, handle->cache.line[i]);
+        handle->cache.line[i] = NULL;
     }
+    handle->cache.count = 0;
 
-    handle_25q = (yDevHandle_25q_t *)handle;
-
-    switch (cmd)
+    if (lines == 0)
     {
-    case YDEV_25Q_IOCTL_CHIP_ERASE:
-        // 全片擦除操作
-        return yDev25q_Erase(handle_25q, 0, handle_25q->size);
+        return 0;
+    }
 
-    case YDEV_25Q_IOCTL_READ_JEDEC_ID:
-        // 读取JEDEC ID
-        if (arg != NULL)
+    // 首次使用时创建共享内存分区
+    if (ydev_25q_cache_pool == NULL)
+    {
+        (void)ydev_25q_cache_mem_partition;
+        ydev_25q_cache_pool = YLIB_MEM_PARTITION_INIT(ydev_25q_cache, yDev25qCacheLine_t,
+                                                      YDEV_25Q_CACHE_POOL_LINES, &err);
+        if (ydev_25q_cache_pool == NULL)
         {
-            *((uint32_t *)arg) = yDev25qReadJedecId(handle_25q);
-            return YDEV_OK;
+            return 0;
         }
-        return YDEV_INVALID_PARAM;
+    }
 
-    default:
-        return YDEV_NOT_SUPPORTED;
+    if (lines > YDEV_25Q_CACHE_LINE_MAX)
+    {
+        lines = YDEV_25Q_CACHE_LINE_MAX;
     }
-}
 
-// ==================== 25Q私有函数实现 ====================
+    // 申请缓存行，分区不足时按已申请行数开启
+    for (i = 0; i < lines; i++)
+    {
+        line = (yDev25qCacheLine_t *)YLibMemGet(ydev_25q_cache_pool, &err);
+        if (line == NULL)
+        {
+            break;
+        }
+        line->tag = 0xFFFFFFFFUL;
+        line->stamp = 0;
+        handle->cache.line[i] = line;
+    }
+    handle->cache.count = (uint8_t)i;
+    handle->cache.clock = 0;
+
+    return i;
+#else
+    (void)handle;
+    (void)lines;
+    return 0;
+#endif
+}
 
 /**
- * @brief 25Q SPI数据传输函数实现
+ * @brief 25Q经缓存读取数据实现
  * @param handle 25Q设备句柄指针
- * @param tx_data 发送数据缓冲区指针，为NULL时发送临时数据
- * @param rx_buff 接收数据缓冲区指针，为NULL时丢弃接收数据
- * @param size 传输数据大小
- * @retval int32_t 实际传输的字节数
- * @note 进行SPI双向数据传输，支持单独发送或接收
+ * @param read_buff 读取数据缓冲区指针
+ * @param size 读取数据大小
+ * @retval int32_t 实际读取的字节数，-1表示错误
  */
-static int32_t yDev25q_Spi_Transfer(yDevHandle_25q_t *handle,
-                                    const void *tx_data,
-                                    void *rx_buff,
-                                    uint32_t size)
+static int32_t yDev25q_CacheRead(yDevHandle_25q_t *handle, uint8_t *read_buff, uint32_t size)
 {
-    uint32_t start_time;
-    uint32_t index;
+    yDev25qCacheLine_t *line;
+    uint32_t address;
+    uint32_t page;
+    uint32_t offset;
     uint32_t len;
-    const uint8_t *write_buff;
-    uint8_t *read_buff;
-    uint32_t temp_data;
-    uint8_t flag;
-
-    // 设置发送和接收缓冲区指针
-    write_buff = (tx_data == NULL) ? (const uint8_t *)&temp_data : (const uint8_t *)tx_data;
-    read_buff = (rx_buff == NULL) ? (uint8_t *)&temp_data : (uint8_t *)rx_buff;
+    uint32_t index;
+    uint32_t i;
 
-    // 开始计时
-    start_time = yDevGetTimeMS();
+    address = handle->address;
     index = 0;
-    temp_data = 0xFF; // 默认发送0xFF
-    flag = 1;
 
-    // 逐字节传输数据
     while (index < size)
     {
-        // 检查超时
-        if (yDevGetTimeMS() - start_time > handle->base.timeOutMs)
+        page = address & ~(YDEV_25Q_PAGE_SIZE - 1);
+        offset = address - page;
+        len = YDEV_25Q_PAGE_SIZE - offset;
+        if (len > (size - index))
         {
-            return (int32_t)index;
+            len = size - index;
         }
 
-        // 发送一个字节
-        if (flag == 1)
+        // 查找命中行，同时记录最久未使用的行
+        line = handle->cache.line[0];
+        for (i = 0; i < handle->cache.count; i++)
         {
-            len = yDrvSpiWriteByte(&handle->spi_handle, write_buff);
-            if (len == 0)
+            if (handle->cache.line[i]->tag == page)
+            {
+                line = handle->cache.line[i];
+                break;
+            }
+            if (handle->cache.line[i]->stamp < line->stamp)
             {
-                continue; // 发送失败，重试
+                line = handle->cache.line[i];
             }
-            flag = 0; // 标记发送成功
-            write_buff += ((tx_data == NULL) ? 0 : len);
         }
-        // 更新发送指针和接收数据
-        len = yDrvSpiReadByte(&handle->spi_handle, read_buff);
-        if (len == 0)
+
+        if (i < handle->cache.count)
+        {
+            handle->cache.hit++;
+        }
+        else
         {
-            continue; // 发送失败，重试
+            // 未命中，整页读入替换行
+            handle->cache.miss++;
+            line->tag = 0xFFFFFFFFUL;
+            handle->address = page;
+            if (yDev25q_ReadData(handle, line->data, YDEV_25Q_PAGE_SIZE) != YDEV_25Q_PAGE_SIZE)
+            {
+                handle->address = address;
+                return (index == 0) ? -1 : (int32_t)index;
+            }
+            line->tag = page;
         }
-        flag = 1; // 标记发送成功
-        read_buff += ((rx_buff == NULL) ? 0 : len);
+
+        line->stamp = ++handle->cache.clock;
+        (void)yDevDmaMemcpy(&read_buff[index], &line->data[offset], len, NULL, NULL);
         index += len;
+        address += len;
     }
 
+    handle->address = address;
     return (int32_t)index;
 }
+
 /**
- * @brief 读取25Q Flash状态寄存器实现
+ * @brief 使25Q读缓存中指定范围失效实现
  * @param handle 25Q设备句柄指针
- * @param reg 状态寄存器命令字节
- * @retval uint8_t 状态寄存器的值，读取失败时返回0xFF
- * @note 通过SPI发送寄存器读取命令并接收状态值
+ * @param address 起始地址
+ * @param size 范围大小
  */
-static uint8_t yDev25q_ReadReg(yDevHandle_25q_t *handle, uint8_t reg)
+static void yDev25q_CacheInvalidate(yDevHandle_25q_t *handle, uint32_t address, uint32_t size)
 {
-    uint8_t write_data[2];
-    uint8_t read_data[2];
-
-    write_data[0] = reg;                      // 状态寄存器读取命令
-    write_data[1] = 0xFF;                     // 读取数据填充
-    yDrvSpiCsControl(&handle->spi_handle, 0); // 选中芯片
+    uint32_t start;
+    uint32_t i;
 
-    if (yDev25q_Spi_Transfer(handle, write_data, read_data, 2) != 2) // 发送命令并接收数据
+    start = address & ~(YDEV_25Q_PAGE_SIZE - 1);
+    for (i = 0; i < handle->cache.count; i++)
     {
-        yDrvSpiCsControl(&handle->spi_handle, 0); // 取消选中
-        return 0xFF;                              // 读取失败
+        if ((handle->cache.line[i]->tag >= start) &&
+            (handle->cache.line[i]->tag < (address + size)))
+        {
+            handle->cache.line[i]->tag = 0xFFFFFFFFUL;
+            handle->cache.line[i]->stamp = 0; // 失效行优先被替换
+        }
     }
 
-    yDrvSpiCsControl(&handle->spi_handle, 1); // 取消选中
-    return read_data[1];
+    // 预读缓冲与读缓存在同样的时机失效
+    yDev25q_PrefetchInvalidate(handle, address, size);
 }
 
 /**
- * @brief 等待25Q Flash芯片就绪实现
+ * @brief 设置25Q顺序读取预读页数实现
  * @param handle 25Q设备句柄指针
- * @param timeout_ms 超时时间(毫秒)
- * @retval yDrvStatus_t 操作状态
- * @note 根据芯片类型选择对应的状态寄存器和BUSY位检查
+ * @param pages 预读页数，0=关闭
+ * @retval uint32_t 实际分配的页数
  */
-static yDrvStatus_t yDev25q_WaitBusy(yDevHandle_25q_t *handle, uint32_t timeout_ms)
+static uint32_t yDev25q_PrefetchSetup(yDevHandle_25q_t *handle, uint32_t pages)
 {
-    uint32_t start_time;
-    uint8_t status;
-    uint8_t reg_cmd;
-    uint8_t busy_mask;
+#if (YDEV_25Q_CACHE_POOL_LINES > 0)
+    yDev25qCacheLine_t *line;
+    uint8_t err;
+    uint32_t i;
 
-    // 根据芯片类型确定状态寄存器和BUSY位
-    switch (IdentifyChip25q[handle->chip_type] & 0xFF0000)
+    // 归还已有预读页，丢弃缓冲数据和未执行的请求
+    for (i = 0; i < handle->prefetch.count; i++)
     {
-    case 0xEF0000:                             // W25Q系列芯片
-        reg_cmd = 0x05;                        // 状态寄存器1读取命令
-        busy_mask = YDEV_25Q_STATUS_W25Q_BUSY; // BUSY位掩码
-        break;
-    default:
-        return YDRV_INVALID_PARAM; // 不支持的芯片类型
+        YLibMemPut(ydev_25q_cache_pool, handle->prefetch.line[i]);
+        handle->prefetch.line[i] = NULL;
     }
+    handle->prefetch.count = 0;
+    handle->prefetch.head = 0;
+    handle->prefetch.pending = 0;
+    handle->prefetch.valid = 0;
+    handle->prefetch.next = 0xFFFFFFFFUL;
 
-    // 轮询检查BUSY位直到芯片就绪或超时
-    start_time = yDevGetTimeMS();
-    do
+    if (pages == 0)
     {
-        status = yDev25q_ReadReg(handle, reg_cmd);
-        if ((status & busy_mask) == 0)
+        return 0;
+    }
+
+    // 首次使用时创建共享内存分区
+    if (ydev_25q_cache_pool == NULL)
+    {
+        (void)ydev_25q_cache_mem_partition;
+        ydev_25q_cache_pool = YLIB_MEM_PARTITION_INIT(ydev_25q_cache, yDev25qCacheLine_t,
+                                                      YDEV_25Q_CACHE_POOL_LINES, &err);
+        if (ydev_25q_cache_pool == NULL)
         {
-            return YDRV_OK; // 芯片就绪
+            return 0;
         }
-    } while ((yDevGetTimeMS() - start_time) <= timeout_ms);
+    }
 
-    return YDRV_TIMEOUT; // 超时
+    if (pages > YDEV_25Q_PREFETCH_PAGE_MAX)
+    {
+        pages = YDEV_25Q_PREFETCH_PAGE_MAX;
+    }
+
+    // 申请预读页，分区不足时按已申请页数开启
+    for (i = 0; i < pages; i++)
+    {
+        line = (yDev25qCacheLine_t *)YLibMemGet(ydev_25q_cache_pool, &err);
+        if (line == NULL)
+        {
+            break;
+        }
+        line->tag = 0xFFFFFFFFUL;
+        line->stamp = 0;
+        handle->prefetch.line[i] = line;
+    }
+    handle->prefetch.count = (uint8_t)i;
+
+    return i;
+#else
+    (void)handle;
+    (void)pages;
+    return 0;
+#endif
 }
 
 /**
- * @brief 根据JEDEC ID识别芯片型号实现
- * @param jedec_id JEDEC ID值
- * @retval yDev25qType_t 芯片型号枚举值
- * @note 遍历已知芯片ID表进行匹配识别
+ * @brief 从25Q预读缓冲读取数据实现
+ * @param handle 25Q设备句柄指针
+ * @param address 读取起始地址
+ * @param read_buff 读取数据缓冲区指针
+ * @param size 读取数据大小
+ * @retval uint32_t 从缓冲取得的字节数
  */
-static yDev25qType_t yDev25q_IdentifyChip(uint32_t jedec_id)
+static uint32_t yDev25q_PrefetchRead(yDevHandle_25q_t *handle, uint32_t address, uint8_t *read_buff, uint32_t size)
 {
-    // 遍历芯片ID表进行匹配
-    for (yDev25qType_t i = YDEV_25Q_TYPE_W25Q16; i < YDEV_25Q_TYPE_UNKNOWN; i++)
+    yDev25qPrefetch_t *pf = &handle->prefetch;
+    uint32_t offset;
+    uint32_t index;
+    uint32_t len;
+    uint32_t n;
+
+    if ((pf->valid == 0) || (address < pf->address) || (address >= (pf->address + pf->valid)))
     {
-        if (IdentifyChip25q[i] == jedec_id)
+        return 0;
+    }
+
+    offset = address - pf->address;
+    n = pf->valid - offset;
+    if (n > size)
+    {
+        n = size;
+    }
+
+    // 按页拷贝，环形缓冲中相邻的地址可能落在不相邻的页
+    for (index = 0; index < n; index += len)
+    {
+        len = YDEV_25Q_PAGE_SIZE - (offset % YDEV_25Q_PAGE_SIZE);
+        if (len > (n - index))
         {
-            return i;
+            len = n - index;
         }
+        (void)yDevDmaMemcpy(&read_buff[index],
+                            &pf->line[(pf->head + offset / YDEV_25Q_PAGE_SIZE) % pf->count]->data[offset % YDEV_25Q_PAGE_SIZE],
+                            len, NULL, NULL);
+        offset += len;
     }
-    return YDEV_25Q_TYPE_UNKNOWN;
+
+    return n;
 }
 
 /**
- * @brief 读取25Q设备JEDEC ID实现
+ * @brief 根据本次读取推进25Q预读窗口实现
  * @param handle 25Q设备句柄指针
- * @retval uint32_t JEDEC ID值，读取失败时返回0
- * @note 发送0x9F命令读取3字节JEDEC ID
+ * @param address 本次读取起始地址
+ * @param size 本次读取的字节数
  */
-static uint32_t yDev25qReadJedecId(yDevHandle_25q_t *handle)
+static void yDev25q_PrefetchAdvance(yDevHandle_25q_t *handle, uint32_t address, uint32_t size)
 {
-    uint8_t cmd[4] = {0x9F, 0xFF, 0xFF, 0xFF}; // JEDEC ID读取命令
-    uint8_t jedec_data[4] = {0};               // 用于存储读取的JEDEC ID数据
-    uint32_t jedec_id = 0;
+    yDev25qPrefetch_t *pf = &handle->prefetch;
+    uint32_t drop;
+    uint32_t used;
 
-    // 读取3字节JEDEC ID数据
-    yDrvSpiCsControl(&handle->spi_handle, 0); // 选中
-    if (yDev25q_Spi_Transfer(handle, &cmd, &jedec_data[0], 4) != 4)
+    if (pf->count == 0)
     {
-        yDrvSpiCsControl(&handle->spi_handle, 1); // 取消选中
-        return 0;
+        return;
     }
-    yDrvSpiCsControl(&handle->spi_handle, 1); // 取消选中
 
-    // 组合24位JEDEC ID
-    jedec_id = ((uint32_t)jedec_data[1] << 16) |
-               ((uint32_t)jedec_data[2] << 8) |
-               (uint32_t)jedec_data[3];
-    return jedec_id;
+    // 1. 不与上次读取首尾相接，不是顺序读取
+    if (address != pf->next)
+    {
+        pf->next = address + size;
+        pf->pending = 0;
+        return;
+    }
+    pf->next = address + size;
+    if ((pf->valid != 0) && ((address + size) <= (pf->address + pf->valid)))
+    {
+        pf->hit++;
+    }
+    else
+    {
+        pf->miss++;
+    }
+
+    // 2. 丢弃已读过的整页；窗口已落在读取位置之后或之前时从读取位置重新开始
+    if ((pf->next >= pf->address) && (pf->next <= (pf->address + pf->valid)))
+    {
+        drop = (pf->next - pf->address) / YDEV_25Q_PAGE_SIZE;
+        pf->head = (uint8_t)((pf->head + drop) % pf->count);
+        pf->address += drop * YDEV_25Q_PAGE_SIZE;
+        pf->valid -= drop * YDEV_25Q_PAGE_SIZE;
+    }
+    else
+    {
+        pf->head = 0;
+        pf->address = pf->next;
+        pf->valid = 0;
+    }
+
+    // 3. 空出一半以上的页时请求补充，读取方处理本次数据时下一段已在传输
+    used = (pf->valid + YDEV_25Q_PAGE_SIZE - 1) / YDEV_25Q_PAGE_SIZE;
+    if ((pf->pending == 0) && (handle->erase.task != NULL) &&
+        ((pf->address + pf->valid) < handle->size) && (((pf->count - used) * 2) >= pf->count))
+    {
+        pf->pending = 1;
+        xTaskNotifyGive((TaskHandle_t)handle->erase.task);
+    }
 }
 
 /**
- * @brief 25Q Flash页编程操作实现
+ * @brief 使25Q预读缓冲中指定范围失效实现
  * @param handle 25Q设备句柄指针
- * @param start_address 页编程起始地址
- * @param write_data 页编程数据指针
- * @retval yDrvStatus_t 操作状态
- * @note 执行完整的页编程流程：等待就绪->写使能->发送命令和地址->发送数据->等待完成
+ * @param address 起始地址
+ * @param size 范围大小
  */
-static yDrvStatus_t yDev25q_WritePage(yDevHandle_25q_t *handle,
-                                      uint32_t start_address,
-                                      const uint8_t *write_data)
+static void yDev25q_PrefetchInvalidate(yDevHandle_25q_t *handle, uint32_t address, uint32_t size)
 {
-    uint8_t write_cmd[4];
+    yDev25qPrefetch_t *pf = &handle->prefetch;
 
-    // 1. 等待芯片就绪
-    if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    if ((pf->valid != 0) && (address < (pf->address + pf->valid)) && ((address + size) > pf->address))
     {
-        handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
-        return YDRV_TIMEOUT;
+        pf->pending = 0;
+        pf->valid = 0;
+        pf->next = 0xFFFFFFFFUL;
     }
+}
+
+/**
+ * @brief 设置25Q写回缓冲页数实现
+ * @param handle 25Q设备句柄指针
+ * @param pages 缓冲页数，0=关闭
+ * @retval uint32_t 实际分配的页数
+ */
+static uint32_t yDev25q_WbackSetup(yDevHandle_25q_t *handle, uint32_t pages)
+{
+#if (YDEV_25Q_CACHE_POOL_LINES > 0)
+    yDev25qCacheLine_t *line;
+    uint8_t err;
+    uint32_t i;
 
-    // 2. 发送写使能命令
-    write_cmd[0] = YDEV_25Q_CMD_WRITE_ENABLE; // 写使能命令
-    yDrvSpiCsControl(&handle->spi_handle, 0); // 选中芯片(CS拉低)
-    if (yDev25q_Spi_Transfer(handle, &write_cmd[0], NULL, 4) != 4)
+    // 归还已有缓冲页
+    for (i = 0; i < handle->wback.count; i++)
     {
-        yDrvSpiCsControl(&handle->spi_handle, 1); // 取消选中
-        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-        return YDRV_ERROR;
+        YLibMemPut(ydev_25q_cache_pool, handle->wback.line[i]);
+        handle->wback.line[i] = NULL;
     }
+    handle->wback.count = 0;
 
-    // 3. 发送页编程命令和地址
-    write_cmd[0] = YDEV_25Q_CMD_PAGE_PROGRAM;    // 页编程命令
-    write_cmd[1] = (start_address >> 16) & 0xFF; // 地址高字节
-    write_cmd[2] = (start_address >> 8) & 0xFF;  // 地址中字节
-    write_cmd[3] = start_address & 0xFF;         // 地址低字节
+    if (pages == 0)
+    {
+        return 0;
+    }
 
-    if (yDev25q_Spi_Transfer(handle, write_cmd, NULL, 4) != 4)
+    // 首次使用时创建共享内存分区
+    if (ydev_25q_cache_pool == NULL)
     {
-        yDrvSpiCsControl(&handle->spi_handle, 1); // 取消选中
-        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-        return YDRV_ERROR;
+        (void)ydev_25q_cache_mem_partition;
+        ydev_25q_cache_pool = YLIB_MEM_PARTITION_INIT(ydev_25q_cache, yDev25qCacheLine_t,
+                                                      YDEV_25Q_CACHE_POOL_LINES, &err);
+        if (ydev_25q_cache_pool == NULL)
+        {
+            return 0;
+        }
     }
 
-    // 4. 发送页数据
-    if (yDev25q_Spi_Transfer(handle, write_data, NULL, YDEV_25Q_PAGE_SIZE) != YDEV_25Q_PAGE_SIZE)
+    if (pages > YDEV_25Q_WBACK_PAGE_MAX)
     {
-        yDrvSpiCsControl(&handle->spi_handle, 0); // 取消选中
-        handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-        return YDRV_ERROR;
+        pages = YDEV_25Q_WBACK_PAGE_MAX;
     }
 
-    // 5. 等待页编程完成
-    if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_PAGE_PROGRAM) != YDRV_OK)
+    // 申请缓冲页，分区不足时按已申请页数开启
+    for (i = 0; i < pages; i++)
     {
-        handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
-        return YDRV_TIMEOUT;
+        line = (yDev25qCacheLine_t *)YLibMemGet(ydev_25q_cache_pool, &err);
+        if (line == NULL)
+        {
+            break;
+        }
+        memset(line->data, 0xFF, YDEV_25Q_PAGE_SIZE);
+        line->tag = 0xFFFFFFFFUL;
+        line->stamp = 0;
+        handle->wback.line[i] = line;
+        handle->wback.lo[i] = 0;
+        handle->wback.hi[i] = 0;
     }
-    yDrvSpiCsControl(&handle->spi_handle, 1); // 取消选中(CS拉高)
+    handle->wback.count = (uint8_t)i;
+    handle->wback.clock = 0;
 
-    return YDRV_OK;
+    return i;
+#else
+    (void)handle;
+    (void)pages;
+    return 0;
+#endif
 }
 
-// 删除未使用的yDev25q_CheckDirty函数
+/**
+ * @brief 写出25Q写回缓冲的一页实现
+ * @param handle 25Q设备句柄指针
+ * @param i 缓冲页序号
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev25q_WbackFlushLine(yDevHandle_25q_t *handle, uint32_t i)
+{
+    yDev25qCacheLine_t *line = handle->wback.line[i];
+    yDrvStatus_t status = YDRV_OK;
+    uint32_t lo = handle->wback.lo[i];
+    uint32_t hi = handle->wback.hi[i];
+
+    if (hi > lo)
+    {
+        status = yDev25q_WritePage(handle, line->tag + lo, &line->data[lo], hi - lo);
+        if (status != YDRV_OK)
+        {
+            handle->base.errno |= YDEV_25Q_ERRNO_WRITE_FAIL;
+        }
+        handle->wback.programs++;
+        memset(&line->data[lo], 0xFF, hi - lo);
+    }
+    line->tag = 0xFFFFFFFFUL;
+    line->stamp = 0;
+    handle->wback.lo[i] = 0;
+    handle->wback.hi[i] = 0;
+
+    return status;
+}
 
 /**
- * @brief 25Q Flash擦除操作实现
+ * @brief 写出25Q写回缓冲中的全部数据实现
  * @param handle 25Q设备句柄指针
- * @param start_address 擦除起始地址
- * @param size 擦除数据大小
  * @retval yDrvStatus_t 操作状态
- * @note 自动选择最优擦除方式：64KB块擦除优先，不足部分使用4KB扇区擦除
- * @note 地址自动对齐到扇区边界
  */
-static yDrvStatus_t yDev25q_Erase(yDevHandle_25q_t *handle, uint32_t start_address, uint32_t size)
+static yDrvStatus_t yDev25q_WbackFlush(yDevHandle_25q_t *handle)
 {
-    uint32_t current_address;
-    uint32_t remaining_size;
-    uint32_t erase_address;
-    uint32_t erase_size;
-    uint8_t write_enable_cmd;
-    uint8_t erase_cmd[4];
+    yDrvStatus_t status = YDRV_OK;
+    uint32_t i;
 
-    // 参数有效性检查
-    if (handle == NULL || size == 0)
+    for (i = 0; i < handle->wback.count; i++)
     {
-        return YDRV_INVALID_PARAM;
+        if (yDev25q_WbackFlushLine(handle, i) != YDRV_OK)
+        {
+            status = YDRV_ERROR;
+        }
     }
 
-    // 检查地址有效性
-    if ((start_address + size) > handle->size)
+    // 缓冲已空，停止超时
+    handle->wback.due = 0;
+    if (handle->wback.timer != NULL)
     {
-        handle->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
-        return YDRV_INVALID_PARAM;
+        (void)xTimerStop((TimerHandle_t)handle->wback.timer, 0);
     }
 
-    // 将起始地址对齐到扇区边界（4KB对齐）
-    current_address = start_address & ~(YDEV_25Q_SECTOR_SIZE - 1);
+    return status;
+}
 
-    // 计算需要擦除的总大小（包含对齐产生的额外部分）
-    remaining_size = ((start_address + size + YDEV_25Q_SECTOR_SIZE - 1) &
-                      ~(YDEV_25Q_SECTOR_SIZE - 1)) -
-                     current_address;
-    write_enable_cmd = YDEV_25Q_CMD_WRITE_ENABLE;
+/**
+ * @brief 25Q经写回缓冲写入数据实现
+ * @param handle 25Q设备句柄指针
+ * @param write_buff 写入数据缓冲区指针
+ * @param size 写入数据大小
+ * @retval int32_t 实际写入(含缓冲)的字节数，-1表示错误
+ */
+static int32_t yDev25q_WbackWrite(yDevHandle_25q_t *handle, const uint8_t *write_buff, uint32_t size)
+{
+    yDev25qCacheLine_t *line;
+    uint32_t address;
+    uint32_t page;
+    uint32_t offset;
+    uint32_t len;
+    uint32_t index;
+    uint32_t slot;
+    uint32_t i;
 
-    // 擦除循环：优先使用64KB块擦除，剩余部分使用4KB扇区擦除
-    while (remaining_size > 0)
+    address = handle->address;
+    index = 0;
+
+    while (index < size)
     {
-        // 判断是否可以进行64KB块擦除
-        if (remaining_size >= YDEV_25Q_BLOCK_SIZE &&
-            (current_address % YDEV_25Q_BLOCK_SIZE) == 0)
+        page = address & ~(YDEV_25Q_PAGE_SIZE - 1);
+        offset = address - page;
+        len = YDEV_25Q_PAGE_SIZE - offset;
+        if (len > (size - index))
         {
-            // 执行64KB块擦除
-            erase_address = current_address;
-            erase_size = YDEV_25Q_BLOCK_SIZE;
-
-            // 发送写使能命令
-            yDrvSpiCsControl(&handle->spi_handle, 0); // 选中芯片
-            if (yDev25q_Spi_Transfer(handle, &write_enable_cmd, NULL, 1) != 1)
-            {
-                yDrvSpiCsControl(&handle->spi_handle, 1); // 取消选中
-                handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-                return YDRV_ERROR;
-            }
+            len = size - index;
+        }
 
-            // 等待芯片就绪
-            if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_BLOCK_ERASE_64K) != YDRV_OK)
+        // 查找该页的缓冲，同时记录空闲页或最久未写入的页
+        slot = 0;
+        for (i = 0; i < handle->wback.count; i++)
+        {
+            line = handle->wback.line[i];
+            if (line->tag == page)
             {
-                handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
-                return YDRV_TIMEOUT;
+                slot = i;
+                break;
             }
-
-            // 发送64KB块擦除命令
-            erase_cmd[0] = YDEV_25Q_CMD_BLOCK_ERASE;
-            erase_cmd[1] = (erase_address >> 16) & 0xFF; // 地址高字节
-            erase_cmd[2] = (erase_address >> 8) & 0xFF;  // 地址中字节
-            erase_cmd[3] = erase_address & 0xFF;         // 地址低字节
-
-            if (yDev25q_Spi_Transfer(handle, erase_cmd, NULL, 4) != 4)
+            if (line->stamp < handle->wback.line[slot]->stamp)
             {
-                yDrvSpiCsControl(&handle->spi_handle, 0); // 取消选中
-                handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-                return YDRV_ERROR;
+                slot = i;
             }
-            yDrvSpiCsControl(&handle->spi_handle, 1); // 取消选中
+        }
 
-            // 等待块擦除完成
-            if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_BLOCK_ERASE_64K) != YDRV_OK)
+        if ((i == handle->wback.count) && (len == YDEV_25Q_PAGE_SIZE))
+        {
+            // 整页且未缓冲，直接编程
+            handle->wback.programs++;
+            if (yDev25q_WritePage(handle, address, &write_buff[index], len) != YDRV_OK)
             {
-                handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
-                return YDRV_TIMEOUT;
+                handle->base.errno |= YDEV_25Q_ERRNO_WRITE_FAIL;
+                handle->address = address;
+                return (index == 0) ? -1 : (int32_t)index;
             }
         }
         else
         {
-            // 执行4KB扇区擦除
-            erase_address = current_address;
-            erase_size = YDEV_25Q_SECTOR_SIZE;
-
-            // 等待芯片就绪
-            if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_SECTOR_ERASE) != YDRV_OK)
+            if (i == handle->wback.count)
             {
-                handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
-                return YDRV_TIMEOUT;
+                // 换页：先写出被替换的页
+                if (yDev25q_WbackFlushLine(handle, slot) != YDRV_OK)
+                {
+                    handle->address = address;
+                    return (index == 0) ? -1 : (int32_t)index;
+                }
+                handle->wback.line[slot]->tag = page;
+                handle->wback.lo[slot] = (uint16_t)offset;
+                handle->wback.hi[slot] = (uint16_t)offset;
             }
 
-            // 发送写使能命令
-            yDrvSpiCsControl(&handle->spi_handle, 1); // 选中芯片
-            if (yDev25q_Spi_Transfer(handle, &write_enable_cmd, NULL, 1) != 1)
+            // 并入缓冲，同一字节按位与
+            line = handle->wback.line[slot];
+            for (i = 0; i < len; i++)
             {
-                yDrvSpiCsControl(&handle->spi_handle, 0); // 取消选中
-                handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-                return YDRV_ERROR;
+                line->data[offset + i] &= write_buff[index + i];
             }
-            yDrvSpiCsControl(&handle->spi_handle, 0); // 取消选中
-
-            // 发送4KB扇区擦除命令
-            yDrvSpiCsControl(&handle->spi_handle, 1); // 选中芯片
-            erase_cmd[0] = YDEV_25Q_CMD_SECTOR_ERASE;
-            erase_cmd[1] = (erase_address >> 16) & 0xFF; // 地址高字节
-            erase_cmd[2] = (erase_address >> 8) & 0xFF;  // 地址中字节
-            erase_cmd[3] = erase_address & 0xFF;         // 地址低字节
-
-            if (yDev25q_Spi_Transfer(handle, erase_cmd, NULL, 4) != 4)
+            if (offset < handle->wback.lo[slot])
             {
-                yDrvSpiCsControl(&handle->spi_handle, 0); // 取消选中
-                handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
-                return YDRV_ERROR;
+                handle->wback.lo[slot] = (uint16_t)offset;
+            }
+            if ((offset + len) > handle->wback.hi[slot])
+            {
+                handle->wback.hi[slot] = (uint16_t)(offset + len);
             }
-            yDrvSpiCsControl(&handle->spi_handle, 0); // 取消选中
+            line->stamp = ++handle->wback.clock;
+            handle->wback.writes++;
 
-            // 等待扇区擦除完成
-            if (yDev25q_WaitBusy(handle, YDEV_25Q_TIMEOUT_SECTOR_ERASE) != YDRV_OK)
+            // 整页已写满时立即写出，否则启动超时
+            if ((handle->wback.lo[slot] == 0) && (handle->wback.hi[slot] == YDEV_25Q_PAGE_SIZE))
             {
-                handle->base.errno = YDEV_25Q_ERRNO_TIMEOUT;
-                return YDRV_TIMEOUT;
+                if (yDev25q_WbackFlushLine(handle, slot) != YDRV_OK)
+                {
+                    handle->address = address;
+                    return (index == 0) ? -1 : (int32_t)index;
+                }
+            }
+            else if ((handle->wback.timeoutMs != 0) &&
+                     (xTimerIsTimerActive((TimerHandle_t)handle->wback.timer) == pdFALSE))
+            {
+                (void)xTimerChangePeriod((TimerHandle_t)handle->wback.timer,
+                                         pdMS_TO_TICKS(handle->wback.timeoutMs) + 1, 0);
             }
         }
 
-        // 更新地址和剩余大小
-        current_address += erase_size;
-        remaining_size -= erase_size;
+        index += len;
+        address += len;
     }
 
-    return YDRV_OK;
+    handle->address = address;
+    return (int32_t)index;
+}
+
+/**
+ * @brief 用写回缓冲中的数据修正读出的数据实现
+ * @param handle 25Q设备句柄指针
+ * @param address 读取起始地址
+ * @param buffer 已读出的数据
+ * @param size 数据大小
+ */
+static void yDev25q_WbackOverlay(yDevHandle_25q_t *handle, uint32_t address, uint8_t *buffer, uint32_t size)
+{
+    yDev25qCacheLine_t *line;
+    uint32_t start;
+    uint32_t end;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < handle->wback.count; i++)
+    {
+        line = handle->wback.line[i];
+        start = line->tag + handle->wback.lo[i];
+        end = line->tag + handle->wback.hi[i];
+        if ((end <= start) || (end <= address) || (start >= (address + size)))
+        {
+            continue;
+        }
+        start = MAX(start, address);
+        end = MIN(end, address + size);
+        for (j = start; j < end; j++)
+        {
+            buffer[j - address] &= line->data[j - line->tag];
+        }
+    }
+}
+
+/**
+ * @brief 丢弃写回缓冲中落在擦除范围内的页实现
+ * @param handle 25Q设备句柄指针
+ * @param address 擦除起始地址
+ * @param size 擦除大小
+ */
+static void yDev25q_WbackDrop(yDevHandle_25q_t *handle, uint32_t address, uint32_t size)
+{
+    yDev25qCacheLine_t *line;
+    uint32_t i;
+
+    for (i = 0; i < handle->wback.count; i++)
+    {
+        line = handle->wback.line[i];
+        if ((line->tag >= address) && (line->tag < (address + size)))
+        {
+            memset(line->data, 0xFF, YDEV_25Q_PAGE_SIZE);
+            line->tag = 0xFFFFFFFFUL;
+            line->stamp = 0;
+            handle->wback.lo[i] = 0;
+            handle->wback.hi[i] = 0;
+        }
+    }
 }
 
 // ==================== 25Q设备操作导出 ====================
 
-YDEV_OPS_EXPORT_EX(
-    YDEV_TYPE_25Q,   // 设备类型
-    yDev_25q_Init,   // 初始化函数
-    yDev_25q_Deinit, // 反初始化函数
-    yDev_25q_Read,   // 读取函数
-    yDev_25q_Write,  // 写入函数
-    yDev_25q_Ioctl)  // 控制函数
+YDEV_OPS_EXPORT_PM(
+    YDEV_TYPE_25Q,       // 设备类型
+    yDev_25q_Init,       // 初始化函数
+    yDev_25q_Deinit,     // 反初始化函数
+    yDev_25q_Read,       // 读取函数
+    yDev_25q_Write,      // 写入函数
+    yDev_25q_Ioctl,      // 控制函数
+    yDev_25q_ReadAsync,  // 异步读取函数
+    yDev_25q_WriteAsync, // 异步写入函数
+    yDev_25q_Readv,      // 向量读取函数
+    NULL,                // 向量写入函数
+    yDev_25q_Suspend,    // 挂起函数
+    yDev_25q_Resume)     // 恢复函数
 
 // 恢复编译器警告
 #pragma GCC diagnostic pop
@@ -0,0 +1,848 @@
+/**
+ * @file yDev_25q_array.c
+ * @brief 多片25Q Flash条带阵列设备实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 以YDEV_TYPE_25Q_ARRAY设备类型注册，读写使用线性地址，按条带单元分布到各片25Q
+ *
+ * @par 实现说明:
+ * - 写入和擦除作为操作排入环形队列，每片一个通道按队列顺序推进，通道之间互不等待
+ * - 推进只在每个阵列自己的推进任务中执行：发起单元要取25Q锁并等待片就绪，
+ *   不能放在定时器服务任务中；入队、各片的异步写入完成回调(在定时器服务任务中)
+ *   和周期轮询定时器都只通知推进任务，不做阻塞操作
+ * - 片忙重试和后台擦除完成检测由周期定时器通知推进任务轮询
+ * - 操作在所有通道完成后按入队顺序退队，退队时回报结果并通知等待的任务
+ * - 同步写入和擦除在调用任务中等待，不能在定时器服务任务或推进任务中调用
+ *
+ * @par 更新历史:
+ * - v1.0 (2025): 初始版本
+ */
+
+// ==================== 包含文件 ====================
+
+// 禁用特定的编译器警告
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wenum-conversion"
+
+#include "yDev_25q_array.h"
+#include "yDev_def.h"
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "os_static.h"
+
+// ==================== 私有宏定义 ====================
+
+/**
+ * @brief 操作类型
+ */
+#define YDEV_25Q_ARRAY_OP_WRITE (0) /*!< 编程 */
+#define YDEV_25Q_ARRAY_OP_ERASE (1) /*!< 擦除 */
+#define YDEV_25Q_ARRAY_OP_SYNC (2)  /*!< 屏障，之前的操作全部完成后完成 */
+
+/**
+ * @brief 等待结果时的结果初值，操作完成后不会取此值
+ */
+#define YDEV_25Q_ARRAY_PENDING (YDEV_BUSY)
+
+/**
+ * @brief 推进任务的静态存储
+ * @note 按句柄占用槽位，反初始化删除任务后释放
+ */
+OS_TASK_POOL_DEFINE(ydev_25q_array_task, YDEV_25Q_ARRAY_MAX, YDEV_25Q_ARRAY_TASK_STACK);
+
+/**
+ * @brief 轮询定时器的静态存储
+ * @note 按句柄占用槽位，反初始化删除定时器后释放
+ */
+OS_TIMER_POOL_DEFINE(ydev_25q_array_timer, YDEV_25Q_ARRAY_MAX);
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 推进所有通道并退队已完成的操作
+ * @param handle 阵列句柄指针
+ * @retval 无
+ * @note 只在推进任务中调用
+ */
+static void yDev25qArray_Pump(yDevHandle_25qArray_t *handle);
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 线性地址转换为片内地址
+ * @param handle 阵列句柄指针
+ * @param address 线性地址
+ * @param chip 输出片号
+ * @retval uint32_t 片内地址
+ */
+static uint32_t yDev25qArray_Map(yDevHandle_25qArray_t *handle, uint32_t address, uint8_t *chip)
+{
+    uint32_t unit = address / handle->stripe;
+
+    *chip = (uint8_t)(unit % handle->chips);
+    return (unit / handle->chips) * handle->stripe + (address % handle->stripe);
+}
+
+/**
+ * @brief 求本片在线性范围内的第一个条带单元
+ * @param handle 阵列句柄指针
+ * @param index 片号
+ * @param address 线性起始地址
+ * @retval uint32_t 单元内起始线性地址(首个单元可能不从单元边界开始)
+ */
+static uint32_t yDev25qArray_First(yDevHandle_25qArray_t *handle, uint8_t index, uint32_t address)
+{
+    uint32_t unit = address / handle->stripe;
+    uint32_t skip = (index + handle->chips - (unit % handle->chips)) % handle->chips;
+
+    return (skip == 0) ? address : (unit + skip) * handle->stripe;
+}
+
+/**
+ * @brief 通道完成当前操作
+ * @param handle 阵列句柄指针
+ * @param lane 通道指针
+ * @param status 本通道结果
+ * @retval 无
+ */
+static void yDev25qArray_LaneDone(yDevHandle_25qArray_t *handle, yDev25qArrayLane_t *lane, yDevStatus_t status)
+{
+    yDev25qArrayOp_t *op = &handle->op[lane->seq % YDEV_25Q_ARRAY_QUEUE];
+
+    if (status != YDEV_OK)
+    {
+        op->status = YDEV_ERROR;
+    }
+    op->pending &= (uint8_t)~(1U << lane->index);
+    lane->seq++;
+    lane->started = 0;
+}
+
+/**
+ * @brief 单元异步编程完成回调
+ * @param arg 通道指针
+ * @param status 编程结果
+ * @retval 无
+ * @note 在定时器服务任务中、25Q异步写入忙标志清除后调用，只记录结果并通知推进任务，
+ *       发起下一个单元要取锁等待，不能在这里做
+ */
+static void yDev25qArray_UnitDone(void *arg, yDevStatus_t status)
+{
+    yDev25qArrayLane_t *lane = (yDev25qArrayLane_t *)arg;
+    yDevHandle_25qArray_t *handle = (yDevHandle_25qArray_t *)lane->owner;
+
+    lane->unitStatus = status;
+    lane->done = 1;
+    xTaskNotifyGive((TaskHandle_t)handle->task);
+}
+
+/**
+ * @brief 通道发起写入操作的下一个单元
+ * @param handle 阵列句柄指针
+ * @param lane 通道指针
+ * @param op 操作指针
+ * @retval uint8_t 1=本通道需等待(单元编程中或片忙)，0=本操作在本通道已完成
+ */
+static uint8_t yDev25qArray_LaneWrite(yDevHandle_25qArray_t *handle, yDev25qArrayLane_t *lane, yDev25qArrayOp_t *op)
+{
+    uint32_t end = op->address + op->size;
+    uint32_t length;
+    uint32_t address;
+    uint8_t chip;
+    yDevStatus_t status;
+
+    if (lane->started == 0)
+    {
+        lane->next = yDev25qArray_First(handle, lane->index, op->address);
+        lane->started = 1;
+    }
+    if (lane->next >= end)
+    {
+        yDev25qArray_LaneDone(handle, lane, YDEV_OK);
+        return 0;
+    }
+
+    // 本单元剩余部分，不跨单元边界
+    length = handle->stripe - (lane->next % handle->stripe);
+    if (length > (end - lane->next))
+    {
+        length = end - lane->next;
+    }
+    address = yDev25qArray_Map(handle, lane->next, &chip);
+
+    status = yDev25qWriteAsync(lane->chip,
+                               address,
+                               op->buffer + (lane->next - op->address),
+                               length,
+                               yDev25qArray_UnitDone,
+                               lane);
+    if (status == YDEV_BUSY)
+    {
+        // 片上还有其他来源的后台擦除，由轮询定时器重试
+        handle->stats.retries++;
+        return 1;
+    }
+    if (status != YDEV_OK)
+    {
+        yDev25qArray_LaneDone(handle, lane, status);
+        return 0;
+    }
+
+    lane->inflight = 1;
+    handle->stats.units[lane->index]++;
+    handle->stats.bytes[lane->index] += length;
+    // 本片下一个单元在chips个单元之后
+    lane->next = (lane->next - (lane->next % handle->stripe)) + handle->stripe * handle->chips;
+    return 1;
+}
+
+/**
+ * @brief 通道执行擦除操作
+ * @param handle 阵列句柄指针
+ * @param lane 通道指针
+ * @param op 操作指针
+ * @retval uint8_t 1=本通道需等待，0=本操作在本通道已完成
+ */
+static uint8_t yDev25qArray_LaneErase(yDevHandle_25qArray_t *handle, yDev25qArrayLane_t *lane, yDev25qArrayOp_t *op)
+{
+    uint32_t first;
+    uint32_t units;
+    uint32_t end = op->address + op->size;
+    uint8_t chip;
+    yDevStatus_t status;
+
+    if (lane->erasing != 0)
+    {
+        if (yDev25qIsEraseBusy(lane->chip) != 0)
+        {
+            return 1;
+        }
+        lane->erasing = 0;
+        yDev25qArray_LaneDone(handle, lane, YDEV_OK);
+        return 0;
+    }
+
+    // 本片在范围内的单元在片内连续
+    first = yDev25qArray_First(handle, lane->index, op->address);
+    if (first >= end)
+    {
+        yDev25qArray_LaneDone(handle, lane, YDEV_OK);
+        return 0;
+    }
+    units = ((end - first) / handle->stripe + handle->chips - 1) / handle->chips;
+
+    status = yDev25qEraseAsync(lane->chip, yDev25qArray_Map(handle, first, &chip), units * handle->stripe);
+    if (status == YDEV_BUSY)
+    {
+        handle->stats.retries++;
+        return 1;
+    }
+    if (status != YDEV_OK)
+    {
+        yDev25qArray_LaneDone(handle, lane, status);
+        return 0;
+    }
+
+    lane->erasing = 1;
+    return 1;
+}
+
+/**
+ * @brief 推进一个通道，直到需要等待或队列中没有本通道的操作
+ * @param handle 阵列句柄指针
+ * @param lane 通道指针
+ * @retval 无
+ */
+static void yDev25qArray_Advance(yDevHandle_25qArray_t *handle, yDev25qArrayLane_t *lane)
+{
+    yDev25qArrayOp_t *op;
+
+    // 先处理完成回调记下的单元结果，通道状态只在推进任务中修改
+    if (lane->done != 0)
+    {
+        lane->done = 0;
+        lane->inflight = 0;
+        if (lane->unitStatus != YDEV_OK)
+        {
+            yDev25qArray_LaneDone(handle, lane, lane->unitStatus);
+        }
+    }
+
+    while ((lane->inflight == 0) && (lane->seq != handle->head))
+    {
+        op = &handle->op[lane->seq % YDEV_25Q_ARRAY_QUEUE];
+        if ((op->pending & (1U << lane->index)) == 0)
+        {
+            lane->seq++;
+            lane->started = 0;
+            continue;
+        }
+
+        if (op->type == YDEV_25Q_ARRAY_OP_WRITE)
+        {
+            if (yDev25qArray_LaneWrite(handle, lane, op) != 0)
+            {
+                return;
+            }
+        }
+        else if (op->type == YDEV_25Q_ARRAY_OP_ERASE)
+        {
+            if (yDev25qArray_LaneErase(handle, lane, op) != 0)
+            {
+                return;
+            }
+        }
+        else
+        {
+            yDev25qArray_LaneDone(handle, lane, YDEV_OK);
+        }
+    }
+}
+
+static void yDev25qArray_Pump(yDevHandle_25qArray_t *handle)
+{
+    yDev25qArrayOp_t *op;
+    uint8_t erasing = 0;
+    uint8_t programming = 0;
+    uint8_t i;
+
+    for (i = 0; i < handle->chips; i++)
+    {
+        yDev25qArray_Advance(handle, &handle->lane[i]);
+        erasing |= handle->lane[i].erasing;
+        programming |= handle->lane[i].inflight;
+    }
+    if ((erasing != 0) && (programming != 0))
+    {
+        handle->stats.overlaps++;
+    }
+
+    // 按入队顺序退队
+    while ((handle->tail != handle->head) && (handle->op[handle->tail % YDEV_25Q_ARRAY_QUEUE].pending == 0))
+    {
+        op = &handle->op[handle->tail % YDEV_25Q_ARRAY_QUEUE];
+        if (op->status != YDEV_OK)
+        {
+            handle->stats.errors++;
+        }
+        else if (op->type == YDEV_25Q_ARRAY_OP_WRITE)
+        {
+            handle->stats.writes++;
+        }
+        else if (op->type == YDEV_25Q_ARRAY_OP_ERASE)
+        {
+            handle->stats.erases++;
+        }
+        if (op->result != NULL)
+        {
+            *op->result = op->status;
+        }
+        if (op->waiter != NULL)
+        {
+            xTaskNotifyGive((TaskHandle_t)op->waiter);
+        }
+        handle->tail++;
+    }
+
+    // 有未完成的操作时保持轮询
+    if (handle->tail != handle->head)
+    {
+        if (xTimerIsTimerActive((TimerHandle_t)handle->timer) == pdFALSE)
+        {
+            (void)xTimerStart((TimerHandle_t)handle->timer, 0);
+        }
+    }
+    else
+    {
+        (void)xTimerStop((TimerHandle_t)handle->timer, 0);
+    }
+}
+
+/**
+ * @brief 轮询定时器回调
+ * @param timer 定时器句柄，ID为阵列句柄
+ * @retval 无
+ * @note 在定时器服务任务中执行，只通知推进任务
+ */
+static void yDev25qArray_TimerCallback(TimerHandle_t timer)
+{
+    yDevHandle_25qArray_t *handle = (yDevHandle_25qArray_t *)pvTimerGetTimerID(timer);
+
+    xTaskNotifyGive((TaskHandle_t)handle->task);
+}
+
+/**
+ * @brief 推进任务
+ * @param arg 阵列句柄指针
+ * @retval 无
+ */
+static void yDev25qArray_Task(void *arg)
+{
+    yDevHandle_25qArray_t *handle = (yDevHandle_25qArray_t *)arg;
+
+    for (;;)
+    {
+        // 入队、单元完成和轮询定时器的通知合并为一次推进
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        yDev25qArray_Pump(handle);
+    }
+}
+
+/**
+ * @brief 操作入队
+ * @param handle 阵列句柄指针
+ * @param type 操作类型
+ * @param address 线性起始地址
+ * @param buffer 写入数据，完成前必须保持有效
+ * @param size 线性长度
+ * @param result 完成时写入结果，NULL不回报
+ * @retval yDevStatus_t YDEV_OK已入队，YDEV_BUSY队列已满
+ */
+static yDevStatus_t yDev25qArray_Submit(yDevHandle_25qArray_t *handle,
+                                        uint8_t type,
+                                        uint32_t address,
+                                        const void *buffer,
+                                        uint32_t size,
+                                        volatile yDevStatus_t *result)
+{
+    yDev25qArrayOp_t *op;
+
+    taskENTER_CRITICAL();
+    if ((handle->head - handle->tail) >= YDEV_25Q_ARRAY_QUEUE)
+    {
+        taskEXIT_CRITICAL();
+        handle->base.errno = YDEV_25Q_ARRAY_ERRNO_FULL;
+        return YDEV_BUSY;
+    }
+    op = &handle->op[handle->head % YDEV_25Q_ARRAY_QUEUE];
+    op->type = type;
+    op->pending = (uint8_t)((1U << handle->chips) - 1);
+    op->status = YDEV_OK;
+    op->buffer = (const uint8_t *)buffer;
+    op->address = address;
+    op->size = size;
+    op->result = result;
+    op->waiter = (result != NULL) ? (void *)xTaskGetCurrentTaskHandle() : NULL;
+    handle->head++;
+    taskEXIT_CRITICAL();
+
+    xTaskNotifyGive((TaskHandle_t)handle->task);
+    return YDEV_OK;
+}
+
+/**
+ * @brief 操作入队并等待完成
+ * @param handle 阵列句柄指针
+ * @param type 操作类型
+ * @param address 线性起始地址
+ * @param buffer 写入数据
+ * @param size 线性长度
+ * @retval yDevStatus_t 操作结果
+ */
+static yDevStatus_t yDev25qArray_Run(yDevHandle_25qArray_t *handle,
+                                     uint8_t type,
+                                     uint32_t address,
+                                     const void *buffer,
+                                     uint32_t size)
+{
+    volatile yDevStatus_t result = YDEV_25Q_ARRAY_PENDING;
+    yDevStatus_t status;
+
+    (void)ulTaskNotifyTake(pdTRUE, 0); // 清除残留通知，先登记再等待不会漏掉完成通知
+
+    // 队列满时等待已有操作退队
+    while ((status = yDev25qArray_Submit(handle, type, address, buffer, size, &result)) == YDEV_BUSY)
+    {
+        vTaskDelay(pdMS_TO_TICKS(YDEV_25Q_ASYNC_POLL_MS) + 1);
+    }
+
+    while (result == YDEV_25Q_ARRAY_PENDING)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(handle->base.timeOutMs) + 1);
+    }
+    if (result != YDEV_OK)
+    {
+        handle->base.errno = YDEV_25Q_ARRAY_ERRNO_CHIP;
+    }
+    return result;
+}
+
+/**
+ * @brief 检查擦除范围
+ * @param handle 阵列句柄指针
+ * @param range 擦除范围
+ * @retval yDevStatus_t 检查结果
+ */
+static yDevStatus_t yDev25qArray_CheckErase(yDevHandle_25qArray_t *handle, const yDev25qEraseRange_t *range)
+{
+    if (range == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    if (((range->address % handle->eraseUnit) != 0) || ((range->size % handle->eraseUnit) != 0) ||
+        (range->size == 0))
+    {
+        handle->base.errno = YDEV_25Q_ARRAY_ERRNO_ALIGN;
+        return YDEV_INVALID_PARAM;
+    }
+    if ((range->address > handle->size) || (range->size > (handle->size - range->address)))
+    {
+        handle->base.errno = YDEV_25Q_ARRAY_ERRNO_RANGE;
+        return YDEV_INVALID_PARAM;
+    }
+    return YDEV_OK;
+}
+
+// ==================== yDev接口实现 ====================
+
+/**
+ * @brief 25Q阵列设备初始化实现
+ */
+static yDevStatus_t yDev_25qArray_Init(void *config, void *handle)
+{
+    yDevConfig_25qArray_t *config_array;
+    yDevHandle_25qArray_t *handle_array;
+    uint32_t chipSize = 0xFFFFFFFFUL;
+    uint32_t stripe;
+    int32_t slot;
+    uint8_t i;
+
+    // 参数有效性检查
+    if ((config == NULL) || (handle == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    config_array = (yDevConfig_25qArray_t *)config;
+    handle_array = (yDevHandle_25qArray_t *)handle;
+
+    stripe = (config_array->stripe == 0) ? YDEV_25Q_PAGE_SIZE : config_array->stripe;
+    if ((config_array->chips < 2) || (config_array->chips > YDEV_25Q_ARRAY_CHIPS) ||
+        (stripe < YDEV_25Q_PAGE_SIZE) || (stripe > YDEV_25Q_SECTOR_SIZE) || ((stripe & (stripe - 1)) != 0))
+    {
+        handle_array->base.errno = YDEV_25Q_ARRAY_ERRNO_RANGE;
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 各片先完成初始化，异步写入需要各自的定时器
+    for (i = 0; i < config_array->chips; i++)
+    {
+        if (config_array->chip[i] == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        if (yDevProbe(config_array->chip[i]) != YDEV_OK)
+        {
+            handle_array->base.errno = YDEV_25Q_ARRAY_ERRNO_CHIP;
+            return YDEV_ERROR;
+        }
+        if (config_array->chip[i]->async.timer == NULL)
+        {
+            return YDEV_NOT_SUPPORTED;
+        }
+        if (config_array->chip[i]->size < chipSize)
+        {
+            chipSize = config_array->chip[i]->size;
+        }
+    }
+
+    memset(handle_array->lane, 0, sizeof(handle_array->lane));
+    memset(&handle_array->stats, 0, sizeof(handle_array->stats));
+    for (i = 0; i < config_array->chips; i++)
+    {
+        handle_array->lane[i].owner = handle_array;
+        handle_array->lane[i].chip = config_array->chip[i];
+        handle_array->lane[i].index = i;
+    }
+    handle_array->head = 0;
+    handle_array->tail = 0;
+    handle_array->address = 0;
+    handle_array->chips = config_array->chips;
+    handle_array->stripe = stripe;
+    // 条带小于扇区时一个片内扇区分散在chips个线性扇区中，擦除须整组进行
+    handle_array->eraseUnit = (stripe == YDEV_25Q_SECTOR_SIZE) ? YDEV_25Q_SECTOR_SIZE
+                                                                : YDEV_25Q_SECTOR_SIZE * config_array->chips;
+    handle_array->size = chipSize * config_array->chips;
+    handle_array->size -= handle_array->size % handle_array->eraseUnit;
+
+    if (handle_array->timer == NULL)
+    {
+        slot = OS_POOL_CLAIM(ydev_25q_array_timer, handle_array);
+        if (slot < 0)
+        {
+            handle_array->base.errno = YDEV_25Q_ARRAY_ERRNO_FULL;
+            return YDEV_NO_MEMORY;
+        }
+        handle_array->timer = (void *)OS_TIMER_POOL_CREATE(ydev_25q_array_timer,
+                                                           slot,
+                                                           "25qArray",
+                                                           pdMS_TO_TICKS(YDEV_25Q_ASYNC_POLL_MS) + 1,
+                                                           pdTRUE,
+                                                           handle_array,
+                                                           yDev25qArray_TimerCallback);
+        if (handle_array->timer == NULL)
+        {
+            OS_POOL_RELEASE(ydev_25q_array_timer, handle_array);
+            return YDEV_ERROR;
+        }
+    }
+
+    if (handle_array->task == NULL)
+    {
+        slot = OS_POOL_CLAIM(ydev_25q_array_task, handle_array);
+        if (slot < 0)
+        {
+            handle_array->base.errno = YDEV_25Q_ARRAY_ERRNO_FULL;
+            return YDEV_NO_MEMORY;
+        }
+        handle_array->task = (void *)OS_TASK_POOL_CREATE(ydev_25q_array_task,
+                                                         slot,
+                                                         yDev25qArray_Task,
+                                                         "25qArray",
+                                                         handle_array,
+                                                         YDEV_25Q_ARRAY_TASK_PRIO);
+        if (handle_array->task == NULL)
+        {
+            OS_POOL_RELEASE(ydev_25q_array_task, handle_array);
+            return YDEV_ERROR;
+        }
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 25Q阵列设备反初始化实现
+ */
+static yDevStatus_t yDev_25qArray_Deinit(void *handle)
+{
+    yDevHandle_25qArray_t *handle_array = (yDevHandle_25qArray_t *)handle;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 等待队列中的操作完成
+    if (handle_array->tail != handle_array->head)
+    {
+        (void)yDev25qArray_Run(handle_array, YDEV_25Q_ARRAY_OP_SYNC, 0, NULL, 0);
+    }
+
+    if (handle_array->timer != NULL)
+    {
+        xTimerDelete((TimerHandle_t)handle_array->timer, portMAX_DELAY);
+        handle_array->timer = NULL;
+    }
+    OS_POOL_RELEASE(ydev_25q_array_timer, handle_array);
+    if (handle_array->task != NULL)
+    {
+        vTaskDelete((TaskHandle_t)handle_array->task);
+        handle_array->task = NULL;
+    }
+    OS_POOL_RELEASE(ydev_25q_array_task, handle_array);
+    return YDEV_OK;
+}
+
+/**
+ * @brief 25Q阵列设备读取实现
+ * @note 按条带单元依次读取各片，片上有单元正在编程时等待其完成
+ */
+static int32_t yDev_25qArray_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_25qArray_t *handle_array = (yDevHandle_25qArray_t *)handle;
+    uint8_t *dst = (uint8_t *)buffer;
+    uint32_t done = 0;
+    uint32_t length;
+    uint32_t address;
+    uint8_t chip;
+
+    if ((handle == NULL) || (buffer == NULL))
+    {
+        return -1;
+    }
+    if ((handle_array->address > handle_array->size) || (size > (handle_array->size - handle_array->address)))
+    {
+        handle_array->base.errno = YDEV_25Q_ARRAY_ERRNO_RANGE;
+        return -1;
+    }
+
+    while (done < size)
+    {
+        length = handle_array->stripe - (handle_array->address % handle_array->stripe);
+        if (length > (size - done))
+        {
+            length = size - done;
+        }
+        address = yDev25qArray_Map(handle_array, handle_array->address, &chip);
+
+        while (yDev25qIsAsyncBusy(handle_array->lane[chip].chip) != 0)
+        {
+            vTaskDelay(1);
+        }
+        if (yDev25qRead(handle_array->lane[chip].chip, address, dst + done, length) != (int32_t)length)
+        {
+            handle_array->base.errno = YDEV_25Q_ARRAY_ERRNO_CHIP;
+            return -1;
+        }
+
+        handle_array->address += length;
+        done += length;
+    }
+
+    return (int32_t)done;
+}
+
+/**
+ * @brief 25Q阵列设备写入实现
+ * @note 各片同时编程各自的单元，全部完成后返回
+ */
+static int32_t yDev_25qArray_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_25qArray_t *handle_array = (yDevHandle_25qArray_t *)handle;
+
+    if ((handle == NULL) || (buffer == NULL))
+    {
+        return -1;
+    }
+    if ((handle_array->address > handle_array->size) || (size > (handle_array->size - handle_array->address)))
+    {
+        handle_array->base.errno = YDEV_25Q_ARRAY_ERRNO_RANGE;
+        return -1;
+    }
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    if (yDev25qArray_Run(handle_array, YDEV_25Q_ARRAY_OP_WRITE, handle_array->address, buffer, size) != YDEV_OK)
+    {
+        return -1;
+    }
+
+    handle_array->address += size;
+    return (int32_t)size;
+}
+
+/**
+ * @brief 25Q阵列设备控制实现
+ */
+static yDevStatus_t yDev_25qArray_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_25qArray_t *handle_array = (yDevHandle_25qArray_t *)handle;
+    yDev25qEraseRange_t *range = (yDev25qEraseRange_t *)arg;
+    yDev25qArrayInfo_t *info;
+    yDevStatus_t status;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_25Q_ARRAY_ERASE:
+        status = yDev25qArray_CheckErase(handle_array, range);
+        if (status != YDEV_OK)
+        {
+            return status;
+        }
+        return yDev25qArray_Run(handle_array, YDEV_25Q_ARRAY_OP_ERASE, range->address, NULL, range->size);
+
+    case YDEV_25Q_ARRAY_ERASE_ASYNC:
+        status = yDev25qArray_CheckErase(handle_array, range);
+        if (status != YDEV_OK)
+        {
+            return status;
+        }
+        return yDev25qArray_Submit(handle_array, YDEV_25Q_ARRAY_OP_ERASE, range->address, NULL, range->size, NULL);
+
+    case YDEV_25Q_ARRAY_SYNC:
+        return yDev25qArray_Run(handle_array, YDEV_25Q_ARRAY_OP_SYNC, 0, NULL, 0);
+
+    case YDEV_25Q_ARRAY_GET_INFO:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        info = (yDev25qArrayInfo_t *)arg;
+        info->size = handle_array->size;
+        info->stripe = handle_array->stripe;
+        info->eraseUnit = handle_array->eraseUnit;
+        info->chips = handle_array->chips;
+        return YDEV_OK;
+
+    case YDEV_25Q_ARRAY_GET_STATS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        taskENTER_CRITICAL();
+        memcpy(arg, &handle_array->stats, sizeof(handle_array->stats));
+        taskEXIT_CRITICAL();
+        return YDEV_OK;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+// ==================== 公共函数实现 ====================
+
+void yDev25qArrayConfigStructInit(yDevConfig_25qArray_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础配置
+    yDevConfigStructInit(&config->base);
+    config->base.type = YDEV_TYPE_25Q_ARRAY;
+
+    memset(config->chip, 0, sizeof(config->chip));
+    config->chips = 2;
+    config->stripe = 0;
+}
+
+void yDev25qArrayHandleStructInit(yDevHandle_25qArray_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础句柄
+    yDevHandleStructInit(&handle->base);
+
+    memset(handle->lane, 0, sizeof(handle->lane));
+    memset(&handle->stats, 0, sizeof(handle->stats));
+    handle->head = 0;
+    handle->tail = 0;
+    handle->address = 0;
+    handle->size = 0;
+    handle->stripe = 0;
+    handle->eraseUnit = 0;
+    handle->chips = 0;
+    handle->task = NULL;
+    handle->timer = NULL;
+}
+
+// ==================== 25Q阵列设备操作导出 ====================
+
+YDEV_OPS_EXPORT_EX(
+    YDEV_TYPE_25Q_ARRAY,  // 设备类型
+    yDev_25qArray_Init,   // 初始化函数
+    yDev_25qArray_Deinit, // 反初始化函数
+    yDev_25qArray_Read,   // 读取函数
+    yDev_25qArray_Write,  // 写入函数
+    yDev_25qArray_Ioctl)  // 控制函数
+
+// 恢复编译器警告
+#pragma GCC diagnostic pop
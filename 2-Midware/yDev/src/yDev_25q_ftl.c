@@ -0,0 +1,1019 @@
+/**
+ * @file yDev_25q_ftl.c
+ * @brief 25Q Flash磨损均衡转换层(FTL)设备实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 以YDEV_TYPE_25Q_FTL设备类型注册，读写使用逻辑字节地址，
+ * 按逻辑扇区映射到25Q物理扇区
+ *
+ * @par 主要功能:
+ * - 写入可原地编程时直接写入，否则合并旧数据写入新的预擦除扇区
+ * - 擦除后写入带擦除次数的擦除记录，重启后空闲扇区不必重新擦除，擦除次数不丢失
+ * - 分配时先写分配标记再写数据，数据页写完后写映射记录，掉电时半写副本无有效映射，挂载时作废
+ * - 擦除记录和映射记录各带CRC-32，编程被打断而写坏的记录按无效处理
+ * - 挂载时同一逻辑扇区存在多个副本时取序号最大者，其余作废
+ * - 作废扇区提交25Q后台擦除，队列满时留待下次写入再提交
+ * - 分配擦除次数最少的空闲扇区，并按阈值迁移冷数据
+ *
+ * @par 使用说明:
+ * - 接口不可重入，多任务访问时由调用者串行化
+ * - 无有效擦除记录的物理扇区按作废处理，首次挂载会擦除整个FTL区域
+ * - 后台擦除的扇区在擦除队列清空后补写擦除记录，补写前掉电的扇区下次挂载重新擦除
+ *
+ * @par 更新历史:
+ * - v1.0 (2025): 初始版本
+ */
+
+// ==================== 包含文件 ====================
+
+// 禁用特定的编译器警告
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wenum-conversion"
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+#include "yDev_25q_ftl.h"
+#include "yDev_def.h"
+#include "yLib_arena.h"
+#include "yLib_crc.h"
+
+#include <stddef.h>
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define YDEV_25Q_FTL_COMPARE_CHUNK (64) /*!< 原地写入判定时的分块比较大小 */
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 擦除记录(Flash布局)，擦除后立即写入
+ */
+typedef struct
+{
+    uint32_t magic;      /*!< YDEV_25Q_FTL_MAGIC */
+    uint32_t eraseCount; /*!< 擦除次数 */
+    uint32_t crc;        /*!< 以上字段的CRC-32 */
+} yDev25qFtlEraseRecord_t;
+
+/**
+ * @brief 映射记录(Flash布局)，数据写完后写入
+ */
+typedef struct
+{
+    uint16_t lsn;      /*!< 逻辑扇区号 */
+    uint16_t reserved; /*!< 保留，保持擦除值0xFF */
+    uint32_t seq;      /*!< 映射序号 */
+    uint32_t crc;      /*!< 以上字段的CRC-32 */
+} yDev25qFtlMapRecord_t;
+
+/**
+ * @brief 物理扇区头结构(Flash布局)
+ */
+typedef struct
+{
+    yDev25qFtlEraseRecord_t erase; /*!< 擦除记录 */
+    uint32_t used;                 /*!< 分配标记，0xFFFFFFFF为未使用，编程数据前写0 */
+    yDev25qFtlMapRecord_t map;     /*!< 映射记录 */
+} yDev25qFtlHeader_t;
+
+/**
+ * @brief 记录CRC覆盖的长度
+ */
+#define YDEV_25Q_FTL_ERASE_CRC_LEN (offsetof(yDev25qFtlEraseRecord_t, crc))
+#define YDEV_25Q_FTL_MAP_CRC_LEN (offsetof(yDev25qFtlMapRecord_t, crc))
+
+/**
+ * @brief 未使用的分配标记
+ */
+#define YDEV_25Q_FTL_UNUSED (0xFFFFFFFFUL)
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 获取物理扇区起始地址
+ * @param handle FTL句柄指针
+ * @param phys 物理扇区号
+ * @retval uint32_t Flash地址
+ */
+static uint32_t yDev25qFtl_PhysAddress(yDevHandle_25qFtl_t *handle, uint16_t phys);
+
+/**
+ * @brief 向25Q写入数据
+ * @param handle FTL句柄指针
+ * @param address Flash地址
+ * @param data 数据指针
+ * @param size 数据大小
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev25qFtl_Program(yDevHandle_25qFtl_t *handle, uint32_t address, const void *data, uint32_t size);
+
+/**
+ * @brief 写入擦除记录
+ * @param handle FTL句柄指针
+ * @param phys 物理扇区号(已擦除)
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev25qFtl_WriteRecord(yDevHandle_25qFtl_t *handle, uint16_t phys);
+
+/**
+ * @brief 为后台擦除的扇区补写擦除记录
+ * @param handle FTL句柄指针
+ * @note 写入会等待擦除队列清空
+ */
+static void yDev25qFtl_FlushRecords(yDevHandle_25qFtl_t *handle);
+
+/**
+ * @brief 同步擦除一个物理扇区
+ * @param handle FTL句柄指针
+ * @param phys 物理扇区号
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev25qFtl_EraseNow(yDevHandle_25qFtl_t *handle, uint16_t phys);
+
+/**
+ * @brief 将作废扇区提交后台擦除
+ * @param handle FTL句柄指针
+ * @note 队列满或后台擦除不可用时停止，剩余扇区保持作废状态
+ */
+static void yDev25qFtl_Reclaim(yDevHandle_25qFtl_t *handle);
+
+/**
+ * @brief 分配一个空闲物理扇区
+ * @param handle FTL句柄指针
+ * @param phys 输出物理扇区号
+ * @retval yDevStatus_t 操作状态
+ * @note 优先擦除次数最少的已擦除扇区，没有时同步擦除一个作废扇区
+ */
+static yDevStatus_t yDev25qFtl_Alloc(yDevHandle_25qFtl_t *handle, uint16_t *phys);
+
+/**
+ * @brief 将逻辑扇区重映射到新物理扇区
+ * @param handle FTL句柄指针
+ * @param lsn 逻辑扇区号
+ * @param target 目标物理扇区(已擦除)
+ * @param offset 新数据在逻辑扇区内的偏移
+ * @param data 新数据，NULL表示只搬移旧数据
+ * @param size 新数据大小
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev25qFtl_Remap(yDevHandle_25qFtl_t *handle,
+                                     uint16_t lsn,
+                                     uint16_t target,
+                                     uint32_t offset,
+                                     const uint8_t *data,
+                                     uint32_t size);
+
+/**
+ * @brief 静态磨损均衡
+ * @param handle FTL句柄指针
+ * @note 擦除次数最少的映射扇区与擦除次数最多的空闲扇区差值超过阈值时，
+ *       把冷数据迁移到磨损多的扇区，释放磨损少的扇区给热数据使用
+ */
+static void yDev25qFtl_WearLevel(yDevHandle_25qFtl_t *handle);
+
+/**
+ * @brief 写入逻辑扇区内的一段数据
+ * @param handle FTL句柄指针
+ * @param lsn 逻辑扇区号
+ * @param offset 扇区内偏移
+ * @param data 数据指针
+ * @param size 数据大小(不跨扇区)
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev25qFtl_WriteSector(yDevHandle_25qFtl_t *handle,
+                                           uint16_t lsn,
+                                           uint32_t offset,
+                                           const uint8_t *data,
+                                           uint32_t size);
+
+/**
+ * @brief 扫描物理扇区头重建映射
+ * @param handle FTL句柄指针
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev25qFtl_Mount(yDevHandle_25qFtl_t *handle);
+
+/**
+ * @brief 释放FTL句柄资源
+ * @param handle FTL句柄指针
+ */
+static void yDev25qFtl_Release(yDevHandle_25qFtl_t *handle);
+
+/**
+ * @brief 25Q FTL设备初始化
+ * @param config FTL配置结构体指针
+ * @param handle FTL句柄指针
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_25qFtl_Init(void *config, void *handle);
+
+/**
+ * @brief 25Q FTL设备反初始化
+ * @param handle FTL句柄指针
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_25qFtl_Deinit(void *handle);
+
+/**
+ * @brief 25Q FTL设备读取
+ * @param handle FTL句柄指针
+ * @param buffer 读取缓冲区
+ * @param size 读取大小
+ * @retval int32_t 实际读取的字节数，-1表示错误
+ * @note 从handle->address逻辑地址读取，未映射扇区读出0xFF
+ */
+static int32_t yDev_25qFtl_Read(void *handle, void *buffer, size_t size);
+
+/**
+ * @brief 25Q FTL设备写入
+ * @param handle FTL句柄指针
+ * @param buffer 写入数据
+ * @param size 写入大小
+ * @retval int32_t 实际写入的字节数，-1表示错误
+ * @note 写入handle->address逻辑地址，调用者无需擦除
+ */
+static int32_t yDev_25qFtl_Write(void *handle, const void *buffer, size_t size);
+
+/**
+ * @brief 25Q FTL设备控制
+ * @param handle FTL句柄指针
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_25qFtl_Ioctl(void *handle, uint32_t cmd, void *arg);
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 物理扇区地址计算实现
+ */
+static uint32_t yDev25qFtl_PhysAddress(yDevHandle_25qFtl_t *handle, uint16_t phys)
+{
+    return handle->baseAddress + (uint32_t)phys * YDEV_25Q_SECTOR_SIZE;
+}
+
+/**
+ * @brief 25Q写入实现
+ */
+static yDevStatus_t yDev25qFtl_Program(yDevHandle_25qFtl_t *handle, uint32_t address, const void *data, uint32_t size)
+{
+    handle->flash->address = address;
+    if (yDevWrite(handle->flash, data, size) != (int32_t)size)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_WRITE_FAIL;
+        return YDEV_ERROR;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 擦除记录写入实现
+ */
+static yDevStatus_t yDev25qFtl_WriteRecord(yDevHandle_25qFtl_t *handle, uint16_t phys)
+{
+    yDev25qFtlEraseRecord_t record;
+
+    record.magic = YDEV_25Q_FTL_MAGIC;
+    record.eraseCount = handle->sector[phys].eraseCount;
+    record.crc = ylib_crc32(YLIB_CRC32_INIT, &record, YDEV_25Q_FTL_ERASE_CRC_LEN);
+    if (yDev25qFtl_Program(handle, yDev25qFtl_PhysAddress(handle, phys), &record, sizeof(record)) != YDEV_OK)
+    {
+        handle->sector[phys].state = YDEV_25Q_FTL_STATE_STALE;
+        return YDEV_ERROR;
+    }
+    handle->sector[phys].pending = 0;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 擦除记录补写实现
+ */
+static void yDev25qFtl_FlushRecords(yDevHandle_25qFtl_t *handle)
+{
+    uint16_t i;
+
+    for (i = 0; i < handle->physCount; i++)
+    {
+        if ((handle->sector[i].state == YDEV_25Q_FTL_STATE_ERASED) && (handle->sector[i].pending != 0))
+        {
+            (void)yDev25qFtl_WriteRecord(handle, i);
+        }
+    }
+}
+
+/**
+ * @brief 同步擦除实现
+ */
+static yDevStatus_t yDev25qFtl_EraseNow(yDevHandle_25qFtl_t *handle, uint16_t phys)
+{
+    uint32_t address = yDev25qFtl_PhysAddress(handle, phys);
+
+    if (yDevIoctl(handle->flash, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK)
+    {
+        handle->base.errno = YDEV_25Q_ERRNO_ERASE_FAIL;
+        return YDEV_ERROR;
+    }
+    handle->sector[phys].eraseCount++;
+    handle->sector[phys].state = YDEV_25Q_FTL_STATE_ERASED;
+    return yDev25qFtl_WriteRecord(handle, phys);
+}
+
+/**
+ * @brief 作废扇区回收实现
+ */
+static void yDev25qFtl_Reclaim(yDevHandle_25qFtl_t *handle)
+{
+    uint16_t i;
+
+    // 上一轮提交的擦除全部完成后才补写记录，写入不会在这里等待擦除
+    if (yDev25qIsEraseBusy(handle->flash) == 0)
+    {
+        yDev25qFtl_FlushRecords(handle);
+    }
+
+    for (i = 0; i < handle->physCount; i++)
+    {
+        if (handle->sector[i].state != YDEV_25Q_FTL_STATE_STALE)
+        {
+            continue;
+        }
+        // 25Q驱动保证后续写入排在已提交擦除之后，提交即可视为已擦除
+        if (yDev25qEraseAsync(handle->flash, yDev25qFtl_PhysAddress(handle, i), YDEV_25Q_SECTOR_SIZE) != YDEV_OK)
+        {
+            return;
+        }
+        handle->sector[i].eraseCount++;
+        handle->sector[i].state = YDEV_25Q_FTL_STATE_ERASED;
+        handle->sector[i].pending = 1;
+    }
+}
+
+/**
+ * @brief 空闲扇区分配实现
+ */
+static yDevStatus_t yDev25qFtl_Alloc(yDevHandle_25qFtl_t *handle, uint16_t *phys)
+{
+    uint16_t erased = YDEV_25Q_FTL_UNMAPPED;
+    uint16_t stale = YDEV_25Q_FTL_UNMAPPED;
+    uint16_t i;
+
+    for (i = 0; i < handle->physCount; i++)
+    {
+        if ((handle->sector[i].state == YDEV_25Q_FTL_STATE_ERASED) &&
+            ((erased == YDEV_25Q_FTL_UNMAPPED) || (handle->sector[i].eraseCount < handle->sector[erased].eraseCount)))
+        {
+            erased = i;
+        }
+        else if ((handle->sector[i].state == YDEV_25Q_FTL_STATE_STALE) &&
+                 ((stale == YDEV_25Q_FTL_UNMAPPED) || (handle->sector[i].eraseCount < handle->sector[stale].eraseCount)))
+        {
+            stale = i;
+        }
+    }
+
+    if (erased == YDEV_25Q_FTL_UNMAPPED)
+    {
+        // 后台擦除跟不上时才在写入路径上同步擦除
+        if ((stale == YDEV_25Q_FTL_UNMAPPED) || (yDev25qFtl_EraseNow(handle, stale) != YDEV_OK))
+        {
+            handle->base.errno |= YDEV_25Q_ERRNO_NO_MEMORY;
+            return YDEV_NO_MEMORY;
+        }
+        erased = stale;
+    }
+
+    *phys = erased;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 重映射逐页合并实现
+ * @param page 一页大小的临时缓冲区
+ */
+static yDevStatus_t yDev25qFtl_RemapPages(yDevHandle_25qFtl_t *handle,
+                                          uint16_t lsn,
+                                          uint16_t target,
+                                          uint32_t offset,
+                                          const uint8_t *data,
+                                          uint32_t size,
+                                          uint8_t *page)
+{
+    yDev25qFtlMapRecord_t record;
+    uint16_t old = handle->map[lsn];
+    uint32_t header = yDev25qFtl_PhysAddress(handle, target);
+    uint32_t base = header + YDEV_25Q_FTL_HEADER_SIZE;
+    uint32_t used = 0;
+    uint32_t pos;
+    uint32_t from;
+    uint32_t to;
+    uint32_t i;
+
+    // 后台擦除的扇区先补写擦除记录(等待擦除完成)，再写分配标记，之后掉电该扇区按作废处理
+    if ((handle->sector[target].pending != 0) && (yDev25qFtl_WriteRecord(handle, target) != YDEV_OK))
+    {
+        return YDEV_ERROR;
+    }
+    if (yDev25qFtl_Program(handle, header + offsetof(yDev25qFtlHeader_t, used), &used, sizeof(used)) != YDEV_OK)
+    {
+        handle->sector[target].state = YDEV_25Q_FTL_STATE_STALE;
+        return YDEV_ERROR;
+    }
+
+    // 逐页合并旧数据与新数据，全0xFF页不编程
+    for (pos = 0; pos < YDEV_25Q_FTL_SECTOR_SIZE; pos += YDEV_25Q_PAGE_SIZE)
+    {
+        if (old != YDEV_25Q_FTL_UNMAPPED)
+        {
+            if (yDev25qRead(handle->flash,
+                            yDev25qFtl_PhysAddress(handle, old) + YDEV_25Q_FTL_HEADER_SIZE + pos,
+                            page, YDEV_25Q_PAGE_SIZE) != YDEV_25Q_PAGE_SIZE)
+            {
+                handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+                return YDEV_ERROR;
+            }
+        }
+        else
+        {
+            memset(page, 0xFF, YDEV_25Q_PAGE_SIZE);
+        }
+
+        if ((data != NULL) && (offset < (pos + YDEV_25Q_PAGE_SIZE)) && ((offset + size) > pos))
+        {
+            from = (offset > pos) ? offset : pos;
+            to = ((offset + size) < (pos + YDEV_25Q_PAGE_SIZE)) ? (offset + size) : (pos + YDEV_25Q_PAGE_SIZE);
+            memcpy(&page[from - pos], &data[from - offset], to - from);
+        }
+
+        for (i = 0; (i < YDEV_25Q_PAGE_SIZE) && (page[i] == 0xFF); i++)
+        {
+        }
+        if ((i < YDEV_25Q_PAGE_SIZE) &&
+            (yDev25qFtl_Program(handle, base + pos, page, YDEV_25Q_PAGE_SIZE) != YDEV_OK))
+        {
+            handle->sector[target].state = YDEV_25Q_FTL_STATE_STALE;
+            return YDEV_ERROR;
+        }
+    }
+
+    // 数据写完后写映射记录，副本从此刻起生效
+    record.lsn = lsn;
+    record.reserved = 0xFFFFU;
+    record.seq = handle->seq + 1;
+    record.crc = ylib_crc32(YLIB_CRC32_INIT, &record, YDEV_25Q_FTL_MAP_CRC_LEN);
+    if (yDev25qFtl_Program(handle, header + offsetof(yDev25qFtlHeader_t, map), &record, sizeof(record)) != YDEV_OK)
+    {
+        handle->sector[target].state = YDEV_25Q_FTL_STATE_STALE;
+        return YDEV_ERROR;
+    }
+
+    handle->seq = record.seq;
+    handle->sector[target].seq = record.seq;
+    handle->sector[target].state = YDEV_25Q_FTL_STATE_MAPPED;
+    handle->map[lsn] = target;
+    if (old != YDEV_25Q_FTL_UNMAPPED)
+    {
+        handle->sector[old].state = YDEV_25Q_FTL_STATE_STALE;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 重映射实现
+ * @note 页缓冲区优先取自当前任务的线性分配器，未绑定或空间不足时从堆申请，不占用任务栈；
+ *       堆封闭模式下改用句柄中的页缓冲区，由设备锁保证独占
+ */
+static yDevStatus_t yDev25qFtl_Remap(yDevHandle_25qFtl_t *handle,
+                                     uint16_t lsn,
+                                     uint16_t target,
+                                     uint32_t offset,
+                                     const uint8_t *data,
+                                     uint32_t size)
+{
+    ylib_arena_t *arena = ylib_arena_task();
+    YLIB_ARENA_SCOPE(scope, arena);
+    yDevStatus_t status;
+    uint8_t *page = (arena != NULL) ? (uint8_t *)ylib_arena_alloc(arena, YDEV_25Q_PAGE_SIZE) : NULL;
+    uint8_t *heap_page = NULL;
+
+#if YLIB_NO_HEAP_AFTER_INIT
+    if (page == NULL)
+    {
+        page = handle->page;
+    }
+#endif
+    if (page == NULL)
+    {
+        page = heap_page = (uint8_t *)YDEV_MALLOC(YDEV_25Q_PAGE_SIZE);
+        if (page == NULL)
+        {
+            handle->base.errno = YDEV_25Q_ERRNO_NO_MEMORY;
+            return YDEV_ERROR;
+        }
+    }
+
+    status = yDev25qFtl_RemapPages(handle, lsn, target, offset, data, size, page);
+
+    if (heap_page != NULL)
+    {
+        YDEV_FREE(heap_page);
+    }
+    return status;
+}
+
+/**
+ * @brief 静态磨损均衡实现
+ */
+static void yDev25qFtl_WearLevel(yDevHandle_25qFtl_t *handle)
+{
+    uint16_t cold = YDEV_25Q_FTL_UNMAPPED;
+    uint16_t worn = YDEV_25Q_FTL_UNMAPPED;
+    uint16_t lsn;
+    uint16_t i;
+
+    for (i = 0; i < handle->physCount; i++)
+    {
+        if ((handle->sector[i].state == YDEV_25Q_FTL_STATE_MAPPED) &&
+            ((cold == YDEV_25Q_FTL_UNMAPPED) || (handle->sector[i].eraseCount < handle->sector[cold].eraseCount)))
+        {
+            cold = i;
+        }
+        else if ((handle->sector[i].state == YDEV_25Q_FTL_STATE_ERASED) &&
+                 ((worn == YDEV_25Q_FTL_UNMAPPED) || (handle->sector[i].eraseCount > handle->sector[worn].eraseCount)))
+        {
+            worn = i;
+        }
+    }
+
+    if ((cold == YDEV_25Q_FTL_UNMAPPED) || (worn == YDEV_25Q_FTL_UNMAPPED) ||
+        (handle->sector[worn].eraseCount <= (handle->sector[cold].eraseCount + YDEV_25Q_FTL_WEAR_DELTA)))
+    {
+        return;
+    }
+
+    for (lsn = 0; lsn < handle->logicalCount; lsn++)
+    {
+        if (handle->map[lsn] == cold)
+        {
+            (void)yDev25qFtl_Remap(handle, lsn, worn, 0, NULL, 0);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 逻辑扇区写入实现
+ */
+static yDevStatus_t yDev25qFtl_WriteSector(yDevHandle_25qFtl_t *handle,
+                                           uint16_t lsn,
+                                           uint32_t offset,
+                                           const uint8_t *data,
+                                           uint32_t size)
+{
+    uint8_t chunk[YDEV_25Q_FTL_COMPARE_CHUNK];
+    uint16_t phys = handle->map[lsn];
+    uint32_t address;
+    uint32_t pos;
+    uint32_t len;
+    uint32_t i;
+    uint8_t same = 1;
+    uint8_t programmable = 1;
+    yDevStatus_t status;
+
+    if (phys != YDEV_25Q_FTL_UNMAPPED)
+    {
+        // 比较旧数据: 相同则跳过，只需1变0则原地编程
+        address = yDev25qFtl_PhysAddress(handle, phys) + YDEV_25Q_FTL_HEADER_SIZE + offset;
+        for (pos = 0; (pos < size) && (programmable != 0); pos += len)
+        {
+            len = ((size - pos) > sizeof(chunk)) ? sizeof(chunk) : (size - pos);
+            if (yDev25qRead(handle->flash, address + pos, chunk, len) != (int32_t)len)
+            {
+                handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+                return YDEV_ERROR;
+            }
+            for (i = 0; i < len; i++)
+            {
+                if (chunk[i] != data[pos + i])
+                {
+                    same = 0;
+                }
+                if ((chunk[i] & data[pos + i]) != data[pos + i])
+                {
+                    programmable = 0;
+                    break;
+                }
+            }
+        }
+
+        if (programmable != 0)
+        {
+            return (same != 0) ? YDEV_OK : yDev25qFtl_Program(handle, address, data, size);
+        }
+    }
+
+    status = yDev25qFtl_Alloc(handle, &phys);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+    status = yDev25qFtl_Remap(handle, lsn, phys, offset, data, size);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+
+    yDev25qFtl_WearLevel(handle);
+    yDev25qFtl_Reclaim(handle);
+    return YDEV_OK;
+}
+
+/**
+ * @brief 映射重建实现
+ */
+static yDevStatus_t yDev25qFtl_Mount(yDevHandle_25qFtl_t *handle)
+{
+    yDev25qFtlHeader_t header;
+    uint32_t minErase = 0xFFFFFFFFUL;
+    uint16_t prev;
+    uint16_t i;
+    uint32_t j;
+
+    for (i = 0; i < handle->logicalCount; i++)
+    {
+        handle->map[i] = YDEV_25Q_FTL_UNMAPPED;
+    }
+
+    for (i = 0; i < handle->physCount; i++)
+    {
+        if (yDev25qRead(handle->flash, yDev25qFtl_PhysAddress(handle, i), &header, sizeof(header)) != (int32_t)sizeof(header))
+        {
+            handle->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+            return YDEV_ERROR;
+        }
+
+        handle->sector[i].state = YDEV_25Q_FTL_STATE_STALE;
+        handle->sector[i].pending = 0;
+        handle->sector[i].seq = 0;
+        handle->sector[i].eraseCount = 0xFFFFFFFFUL;
+        if ((header.erase.magic != YDEV_25Q_FTL_MAGIC) ||
+            (header.erase.crc != ylib_crc32(YLIB_CRC32_INIT, &header.erase, YDEV_25Q_FTL_ERASE_CRC_LEN)))
+        {
+            continue;
+        }
+
+        handle->sector[i].eraseCount = header.erase.eraseCount;
+        if (header.erase.eraseCount < minErase)
+        {
+            minErase = header.erase.eraseCount;
+        }
+
+        // 未写分配标记的扇区擦除后没有编程过，直接可用
+        if (header.used == YDEV_25Q_FTL_UNUSED)
+        {
+            for (j = 0; (j < sizeof(header.map)) && (((const uint8_t *)&header.map)[j] == 0xFF); j++)
+            {
+            }
+            if (j == sizeof(header.map))
+            {
+                handle->sector[i].state = YDEV_25Q_FTL_STATE_ERASED;
+            }
+            continue;
+        }
+
+        if ((header.map.crc != ylib_crc32(YLIB_CRC32_INIT, &header.map, YDEV_25Q_FTL_MAP_CRC_LEN)) ||
+            (header.map.lsn >= handle->logicalCount))
+        {
+            continue;
+        }
+
+        // 同一逻辑扇区保留序号最大的副本
+        prev = handle->map[header.map.lsn];
+        if ((prev != YDEV_25Q_FTL_UNMAPPED) && (handle->sector[prev].seq > header.map.seq))
+        {
+            continue;
+        }
+        if (prev != YDEV_25Q_FTL_UNMAPPED)
+        {
+            handle->sector[prev].state = YDEV_25Q_FTL_STATE_STALE;
+        }
+        handle->map[header.map.lsn] = i;
+        handle->sector[i].state = YDEV_25Q_FTL_STATE_MAPPED;
+        handle->sector[i].seq = header.map.seq;
+        if (header.map.seq > handle->seq)
+        {
+            handle->seq = header.map.seq;
+        }
+    }
+
+    // 无擦除记录的扇区擦除次数未知，按已知最小值计
+    if (minErase == 0xFFFFFFFFUL)
+    {
+        minErase = 0;
+    }
+    for (i = 0; i < handle->physCount; i++)
+    {
+        if (handle->sector[i].eraseCount == 0xFFFFFFFFUL)
+        {
+            handle->sector[i].eraseCount = minErase;
+        }
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 句柄资源释放实现
+ */
+static void yDev25qFtl_Release(yDevHandle_25qFtl_t *handle)
+{
+    if (handle->map != NULL)
+    {
+        YDEV_FREE(handle->map);
+        handle->map = NULL;
+    }
+    if (handle->sector != NULL)
+    {
+        YDEV_FREE(handle->sector);
+        handle->sector = NULL;
+    }
+}
+
+// ==================== yDev接口实现 ====================
+
+/**
+ * @brief 25Q FTL设备初始化实现
+ */
+static yDevStatus_t yDev_25qFtl_Init(void *config, void *handle)
+{
+    yDevConfig_25qFtl_t *config_ftl;
+    yDevHandle_25qFtl_t *handle_ftl;
+    yDevStatus_t status;
+
+    // 参数有效性检查
+    if ((config == NULL) || (handle == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    config_ftl = (yDevConfig_25qFtl_t *)config;
+    handle_ftl = (yDevHandle_25qFtl_t *)handle;
+
+    if ((config_ftl->flash == NULL) || (config_ftl->spareCount == 0) ||
+        (config_ftl->sectorCount <= config_ftl->spareCount) ||
+        (config_ftl->sectorCount >= YDEV_25Q_FTL_UNMAPPED) ||
+        ((config_ftl->baseAddress % YDEV_25Q_SECTOR_SIZE) != 0) ||
+        ((config_ftl->baseAddress + (uint32_t)config_ftl->sectorCount * YDEV_25Q_SECTOR_SIZE) > config_ftl->flash->size))
+    {
+        handle_ftl->base.errno = YDEV_25Q_ERRNO_INVALID_PARAM;
+        return YDEV_INVALID_PARAM;
+    }
+
+    handle_ftl->flash = config_ftl->flash;
+    handle_ftl->baseAddress = config_ftl->baseAddress;
+    handle_ftl->address = 0;
+    handle_ftl->seq = 0;
+    handle_ftl->physCount = config_ftl->sectorCount;
+    handle_ftl->logicalCount = (uint16_t)(config_ftl->sectorCount - config_ftl->spareCount);
+    handle_ftl->size = (uint32_t)handle_ftl->logicalCount * YDEV_25Q_FTL_SECTOR_SIZE;
+
+    handle_ftl->map = (uint16_t *)YDEV_MALLOC(sizeof(uint16_t) * handle_ftl->logicalCount);
+    handle_ftl->sector = (yDev25qFtlSector_t *)YDEV_MALLOC(sizeof(yDev25qFtlSector_t) * handle_ftl->physCount);
+    if ((handle_ftl->map == NULL) || (handle_ftl->sector == NULL))
+    {
+        yDev25qFtl_Release(handle_ftl);
+        handle_ftl->base.errno = YDEV_25Q_ERRNO_NO_MEMORY;
+        return YDEV_NO_MEMORY;
+    }
+
+    status = yDev25qFtl_Mount(handle_ftl);
+    if (status != YDEV_OK)
+    {
+        yDev25qFtl_Release(handle_ftl);
+        return status;
+    }
+
+    yDev25qFtl_Reclaim(handle_ftl);
+    return YDEV_OK;
+}
+
+/**
+ * @brief 25Q FTL设备反初始化实现
+ */
+static yDevStatus_t yDev_25qFtl_Deinit(void *handle)
+{
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 擦除次数在下次挂载时从擦除记录恢复，后台擦除的扇区在这里补写
+    if (((yDevHandle_25qFtl_t *)handle)->sector != NULL)
+    {
+        yDev25qFtl_FlushRecords((yDevHandle_25qFtl_t *)handle);
+    }
+    yDev25qFtl_Release((yDevHandle_25qFtl_t *)handle);
+    return YDEV_OK;
+}
+
+/**
+ * @brief 25Q FTL设备读取实现
+ */
+static int32_t yDev_25qFtl_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_25qFtl_t *handle_ftl;
+    uint8_t *out;
+    uint32_t done;
+    uint32_t offset;
+    uint32_t len;
+    uint16_t lsn;
+    uint16_t phys;
+
+    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return -1;
+    }
+
+    handle_ftl = (yDevHandle_25qFtl_t *)handle;
+    out = (uint8_t *)buffer;
+    if ((handle_ftl->map == NULL) || ((handle_ftl->address + size) > handle_ftl->size))
+    {
+        handle_ftl->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return -1;
+    }
+
+    for (done = 0; done < size; done += len)
+    {
+        lsn = (uint16_t)(handle_ftl->address / YDEV_25Q_FTL_SECTOR_SIZE);
+        offset = handle_ftl->address % YDEV_25Q_FTL_SECTOR_SIZE;
+        len = YDEV_25Q_FTL_SECTOR_SIZE - offset;
+        if (len > (size - done))
+        {
+            len = size - done;
+        }
+
+        phys = handle_ftl->map[lsn];
+        if (phys == YDEV_25Q_FTL_UNMAPPED)
+        {
+            memset(&out[done], 0xFF, len);
+        }
+        else if (yDev25qRead(handle_ftl->flash,
+                             yDev25qFtl_PhysAddress(handle_ftl, phys) + YDEV_25Q_FTL_HEADER_SIZE + offset,
+                             &out[done], len) != (int32_t)len)
+        {
+            handle_ftl->base.errno = YDEV_25Q_ERRNO_SPI_ERROR;
+            return -1;
+        }
+        handle_ftl->address += len;
+    }
+
+    return (int32_t)done;
+}
+
+/**
+ * @brief 25Q FTL设备写入实现
+ */
+static int32_t yDev_25qFtl_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_25qFtl_t *handle_ftl;
+    const uint8_t *in;
+    uint32_t done;
+    uint32_t offset;
+    uint32_t len;
+
+    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return -1;
+    }
+
+    handle_ftl = (yDevHandle_25qFtl_t *)handle;
+    in = (const uint8_t *)buffer;
+    if ((handle_ftl->map == NULL) || ((handle_ftl->address + size) > handle_ftl->size))
+    {
+        handle_ftl->base.errno = YDEV_25Q_ERRNO_INVALID_ADDRESS;
+        return -1;
+    }
+
+    for (done = 0; done < size; done += len)
+    {
+        offset = handle_ftl->address % YDEV_25Q_FTL_SECTOR_SIZE;
+        len = YDEV_25Q_FTL_SECTOR_SIZE - offset;
+        if (len > (size - done))
+        {
+            len = size - done;
+        }
+
+        if (yDev25qFtl_WriteSector(handle_ftl,
+                                   (uint16_t)(handle_ftl->address / YDEV_25Q_FTL_SECTOR_SIZE),
+                                   offset, &in[done], len) != YDEV_OK)
+        {
+            return (done > 0) ? (int32_t)done : -1;
+        }
+        handle_ftl->address += len;
+    }
+
+    return (int32_t)done;
+}
+
+/**
+ * @brief 25Q FTL设备控制实现
+ */
+static yDevStatus_t yDev_25qFtl_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_25qFtl_t *handle_ftl;
+    yDev25qFtlInfo_t *info;
+    uint32_t lsn;
+    uint16_t i;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    handle_ftl = (yDevHandle_25qFtl_t *)handle;
+    if (handle_ftl->map == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_25Q_FTL_IOCTL_GET_INFO:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        info = (yDev25qFtlInfo_t *)arg;
+        info->sectorSize = YDEV_25Q_FTL_SECTOR_SIZE;
+        info->logicalCount = handle_ftl->logicalCount;
+        info->freeCount = 0;
+        info->staleCount = 0;
+        info->minErase = 0xFFFFFFFFUL;
+        info->maxErase = 0;
+        for (i = 0; i < handle_ftl->physCount; i++)
+        {
+            info->freeCount += (handle_ftl->sector[i].state == YDEV_25Q_FTL_STATE_ERASED) ? 1 : 0;
+            info->staleCount += (handle_ftl->sector[i].state == YDEV_25Q_FTL_STATE_STALE) ? 1 : 0;
+            if (handle_ftl->sector[i].eraseCount < info->minErase)
+            {
+                info->minErase = handle_ftl->sector[i].eraseCount;
+            }
+            if (handle_ftl->sector[i].eraseCount > info->maxErase)
+            {
+                info->maxErase = handle_ftl->sector[i].eraseCount;
+            }
+        }
+        return YDEV_OK;
+
+    case YDEV_25Q_FTL_IOCTL_TRIM:
+        // 擦除完成前掉电，挂载后该逻辑扇区仍会恢复旧内容
+        if ((arg == NULL) || (*((uint32_t *)arg) >= handle_ftl->logicalCount))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        lsn = *((uint32_t *)arg);
+        if (handle_ftl->map[lsn] != YDEV_25Q_FTL_UNMAPPED)
+        {
+            handle_ftl->sector[handle_ftl->map[lsn]].state = YDEV_25Q_FTL_STATE_STALE;
+            handle_ftl->map[lsn] = YDEV_25Q_FTL_UNMAPPED;
+            yDev25qFtl_Reclaim(handle_ftl);
+        }
+        return YDEV_OK;
+
+    case YDEV_25Q_FTL_IOCTL_FORMAT:
+        for (i = 0; i < handle_ftl->logicalCount; i++)
+        {
+            handle_ftl->map[i] = YDEV_25Q_FTL_UNMAPPED;
+        }
+        for (i = 0; i < handle_ftl->physCount; i++)
+        {
+            if (handle_ftl->sector[i].state == YDEV_25Q_FTL_STATE_MAPPED)
+            {
+                handle_ftl->sector[i].state = YDEV_25Q_FTL_STATE_STALE;
+            }
+        }
+        yDev25qFtl_Reclaim(handle_ftl);
+        return YDEV_OK;
+
+    case YDEV_25Q_FTL_IOCTL_RECLAIM:
+        yDev25qFtl_Reclaim(handle_ftl);
+        return YDEV_OK;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+// ==================== 25Q FTL设备操作导出 ====================
+
+YDEV_OPS_EXPORT_EX(
+    YDEV_TYPE_25Q_FTL,  // 设备类型
+    yDev_25qFtl_Init,   // 初始化函数
+    yDev_25qFtl_Deinit, // 反初始化函数
+    yDev_25qFtl_Read,   // 读取函数
+    yDev_25qFtl_Write,  // 写入函数
+    yDev_25qFtl_Ioctl)  // 控制函数
+
+// 恢复编译器警告
+#pragma GCC diagnostic pop
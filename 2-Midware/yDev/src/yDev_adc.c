@@ -0,0 +1,399 @@
+/**
+ * @file yDev_adc.c
+ * @brief yDev ADC流式采样设备驱动实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现基于yDev框架的ADC设备，把底层双缓冲半块事件映射到异步读取接口
+ *
+ * @par 实现说明:
+ * - 设备始终接管驱动回调，在其中完成异步读取并转调用户回调
+ * - 异步读取只登记缓冲区，下一个半块写满时在DMA中断中复制并通知完成
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_adc.h"
+#include "yDev_def.h"
+#include <string.h>
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 驱动事件回调
+ * @param arg ADC设备句柄
+ * @param event 事件类型
+ * @param block 写满的半块
+ * @param len 半块半字数
+ * @note 在DMA或ADC中断中执行
+ */
+static void yDev_Adc_Event(void *arg, yDrvAdcEvent_t event, const uint16_t *block, uint32_t len)
+{
+    yDevHandle_Adc_t *adc_handle = (yDevHandle_Adc_t *)arg;
+    void *buf = adc_handle->async_buf;
+    uint32_t size;
+
+    if (adc_handle->callback != NULL)
+    {
+        adc_handle->callback(adc_handle->arg, event, block, len);
+    }
+
+    switch (event)
+    {
+    case YDRV_ADC_EVENT_BLOCK:
+        (void)ylib_dblbuf_produce(&adc_handle->stream, (block == adc_handle->drv_handle.buffer) ? 0U : 1U);
+        if (buf == NULL)
+        {
+            if ((adc_handle->callback == NULL) && (adc_handle->zero_copy == 0U))
+            {
+                adc_handle->dropped++;
+            }
+            return;
+        }
+        size = len * sizeof(uint16_t);
+        if (size > adc_handle->async_size)
+        {
+            size = adc_handle->async_size;
+        }
+        memcpy(buf, block, size);
+        adc_handle->async_buf = NULL;
+        yDevAsyncComplete(adc_handle, YDEV_ASYNC_READ, YDEV_OK, size);
+        break;
+
+    case YDRV_ADC_EVENT_ERROR:
+        adc_handle->async_buf = NULL;
+        yDevAsyncComplete(adc_handle, YDEV_ASYNC_READ, YDEV_ERROR, 0);
+        break;
+
+    case YDRV_ADC_EVENT_OVERRUN:
+    default:
+        break; // 等待中的读取取重启后的第一个半块
+    }
+}
+
+/**
+ * @brief 停止采样并结束等待中的异步读取
+ * @param adc_handle ADC设备句柄
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t yDev_Adc_Stop(yDevHandle_Adc_t *adc_handle)
+{
+    yDrvStatus_t status = yDrvAdcStop(&adc_handle->drv_handle);
+
+    adc_handle->async_buf = NULL;
+    yDevAsyncComplete(adc_handle, YDEV_ASYNC_READ, YDEV_ERROR, 0);
+
+    return status;
+}
+
+// ==================== ADC设备操作函数 ====================
+
+/**
+ * @brief ADC设备初始化
+ * @param config ADC设备配置参数
+ * @param handle ADC设备句柄
+ * @return yDevStatus_t 初始化状态
+ *
+ * @par 功能描述:
+ * 校准并配置ADC，不开始采样，由YDEV_ADC_START启动
+ */
+static yDevStatus_t yDev_Adc_Init(void *config, void *handle)
+{
+    yDevConfig_Adc_t *adc_config;
+    yDevHandle_Adc_t *adc_handle;
+    yDrvAdcConfig_t drv_config;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    adc_handle = (yDevHandle_Adc_t *)handle;
+    adc_config = (yDevConfig_Adc_t *)config;
+
+    // 设备接管驱动回调，用户回调由设备回调转调
+    drv_config = adc_config->drv_config;
+    drv_config.callback = yDev_Adc_Event;
+    drv_config.arg = adc_handle;
+
+    if (yDrvAdcInitStatic(&drv_config, &adc_handle->drv_handle) != YDRV_OK)
+    {
+        adc_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_ERROR;
+    }
+
+    adc_handle->callback = adc_config->drv_config.callback;
+    adc_handle->arg = adc_config->drv_config.arg;
+    adc_handle->async_buf = NULL;
+    adc_handle->async_size = 0;
+    adc_handle->dropped = 0;
+    adc_handle->zero_copy = 0;
+    (void)ylib_dblbuf_init(&adc_handle->stream, adc_handle->drv_handle.buffer,
+                           yDrvAdcGetBlockLen(&adc_handle->drv_handle) * sizeof(uint16_t), 2U);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief ADC设备反初始化
+ * @param handle ADC设备句柄
+ * @return yDevStatus_t 操作状态
+ * @note 等待中的异步读取以错误结束
+ */
+static yDevStatus_t yDev_Adc_Deinit(void *handle)
+{
+    yDevHandle_Adc_t *adc_handle;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    adc_handle = (yDevHandle_Adc_t *)handle;
+
+    (void)yDev_Adc_Stop(adc_handle);
+    if (yDrvAdcDeInitStatic(&adc_handle->drv_handle) != YDRV_OK)
+    {
+        adc_handle->base.errno = YDEV_ERRNO_NOT_DEINIT;
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+void yDevAdcConfigStructInit(yDevConfig_Adc_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础配置
+    yDevConfigStructInit(&config->base);
+    config->base.type = YDEV_TYPE_ADC;
+
+    // 初始化驱动配置
+    yDrvAdcConfigStructInit(&config->drv_config);
+}
+
+void yDevAdcHandleStructInit(yDevHandle_Adc_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础句柄
+    yDevHandleStructInit(&handle->base);
+
+    // 初始化驱动句柄
+    yDrvAdcHandleStructInit(&handle->drv_handle);
+    handle->callback = NULL;
+    handle->arg = NULL;
+    handle->async_buf = NULL;
+    handle->async_size = 0;
+    handle->dropped = 0;
+    handle->zero_copy = 0;
+}
+
+/**
+ * @brief ADC设备读取操作
+ * @param handle ADC设备句柄
+ * @param buffer 读取缓冲区(uint16_t数组)
+ * @param size 缓冲区大小，至少为序列通道数个半字
+ * @return int32_t 实际读取的字节数，0表示尚无完整的一帧，-1表示错误
+ *
+ * @par 功能描述:
+ * 按序列顺序返回最近一帧转换结果，只读缓冲区，不影响流式采样
+ */
+static int32_t yDev_Adc_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Adc_t *adc_handle;
+    uint32_t frame_size;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (((uint32_t)buffer & 1U) != 0U))
+    {
+        return -1;
+    }
+
+    adc_handle = (yDevHandle_Adc_t *)handle;
+    frame_size = adc_handle->drv_handle.channelNum * sizeof(uint16_t);
+    if ((adc_handle->drv_handle.instance == NULL) || (size < frame_size))
+    {
+        return -1;
+    }
+
+    switch (yDevAdcReadFrameFast(adc_handle, (uint16_t *)buffer))
+    {
+    case YDRV_OK:
+        return (int32_t)frame_size;
+    case YDRV_BUSY:
+        return 0;
+    default:
+        return -1; // 未在采样
+    }
+}
+
+/**
+ * @brief ADC设备异步读取
+ * @param handle ADC设备句柄
+ * @param buffer 半块缓冲区(uint16_t数组)
+ * @param size 字节数，超过半块大小时只写入一个半块
+ * @return yDevStatus_t 启动状态
+ *
+ * @par 功能描述:
+ * 下一个半块写满后复制到缓冲区并通知完成，完成长度为实际复制的字节数；
+ * 采样须已启动，完成回调中再次读取即可不间断地取得每一个半块
+ */
+static yDevStatus_t yDev_Adc_ReadAsync(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Adc_t *adc_handle = (yDevHandle_Adc_t *)handle;
+
+    if ((buffer == NULL) || (size == 0U) || ((size & 1U) != 0U) || (((uint32_t)buffer & 1U) != 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if ((adc_handle->drv_handle.instance == NULL) || (adc_handle->drv_handle.running == 0U))
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    // 先写长度再发布缓冲区，中断看到缓冲区时长度已有效
+    adc_handle->async_size = size;
+    adc_handle->async_buf = buffer;
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief ADC设备控制操作
+ * @param handle ADC设备句柄
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 支持的命令:
+ * - YDEV_ADC_START/YDEV_ADC_STOP: 启动/停止流式采样
+ * - YDEV_ADC_GET_BLOCK_SIZE/YDEV_ADC_GET_FRAME_HZ: 半块大小和序列频率
+ * - YDEV_ADC_GET_STATS: 运行统计
+ * - YDEV_ADC_ACQUIRE/YDEV_ADC_RELEASE: 任务零拷贝取块和释放
+ * - YDEV_IOCTL_GET_STATUS: 获取设备状态
+ * - YDEV_IOCTL_RESET: 停止采样
+ */
+static yDevStatus_t yDev_Adc_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_Adc_t *adc_handle;
+    yDrvAdcHandle_t *drv;
+    yDevAdcStats_t *stats;
+    yDrvStatus_t status;
+    void *block;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    adc_handle = (yDevHandle_Adc_t *)handle;
+    drv = &adc_handle->drv_handle;
+    if (drv->instance == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_ADC_START:
+        adc_handle->dropped = 0;
+        ylib_dblbuf_reset(&adc_handle->stream);
+        status = yDrvAdcStart(drv);
+        break;
+
+    case YDEV_ADC_STOP:
+    case YDEV_IOCTL_RESET:
+        status = yDev_Adc_Stop(adc_handle);
+        break;
+
+    case YDEV_ADC_GET_BLOCK_SIZE:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = yDrvAdcGetBlockLen(drv) * sizeof(uint16_t);
+        return YDEV_OK;
+
+    case YDEV_ADC_GET_FRAME_HZ:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = drv->frameHz;
+        return YDEV_OK;
+
+    case YDEV_ADC_GET_STATS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        stats = (yDevAdcStats_t *)arg;
+        stats->blocks = drv->blocks;
+        stats->dropped = adc_handle->dropped;
+        stats->overruns = drv->overruns;
+        stats->late = adc_handle->stream.overruns;
+        stats->skipped = adc_handle->stream.late;
+        return YDEV_OK;
+
+    case YDEV_ADC_ACQUIRE:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        adc_handle->zero_copy = 1;
+        block = ylib_dblbuf_acquire(&adc_handle->stream);
+        *(const uint16_t **)arg = (const uint16_t *)block;
+        return (block != NULL) ? YDEV_OK : YDEV_BUSY;
+
+    case YDEV_ADC_RELEASE:
+        return (ylib_dblbuf_release(&adc_handle->stream) != 0) ? YDEV_OK : YDEV_ERROR;
+
+    case YDEV_IOCTL_GET_STATUS:
+        if (arg != NULL)
+        {
+            *(yDevStatus_t *)arg = YDEV_OK;
+            return YDEV_OK;
+        }
+        return YDEV_INVALID_PARAM;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    switch (status)
+    {
+    case YDRV_OK:
+        return YDEV_OK;
+    case YDRV_BUSY:
+        return YDEV_BUSY;
+    case YDRV_INVALID_PARAM:
+        return YDEV_INVALID_PARAM;
+    default:
+        return YDEV_ERROR;
+    }
+}
+
+// ==================== 设备操作表导出 ====================
+
+YDEV_OPS_EXPORT_ASYNC(
+    YDEV_TYPE_ADC,      // 设备类型
+    yDev_Adc_Init,      // 初始化函数
+    yDev_Adc_Deinit,    // 反初始化函数
+    yDev_Adc_Read,      // 读取函数
+    NULL,               // 写入函数(不支持)
+    yDev_Adc_Ioctl,     // 控制函数
+    yDev_Adc_ReadAsync, // 异步读取函数
+    NULL)               // 异步写入函数
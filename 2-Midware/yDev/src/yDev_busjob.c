@@ -0,0 +1,410 @@
+/**
+ * @file yDev_busjob.c
+ * @brief 总线作业调度实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 等待者节点在等待任务自己的栈上，入队、出队和移交在临界区内完成；
+ * 释放总线时直接把持有者改为队首任务再通知它，被唤醒的任务只检查granted标志，
+ * 不会出现释放后被其他新提交的作业抢先的情况
+ *
+ * @par 实现说明:
+ * - 时间以系统节拍保存，截止时间比较用有符号差值，节拍计数回绕不影响顺序
+ * - 更紧急类别的作业提交时通知持有者，使其在yDevBusJobSleep中提前醒来
+ * - 通知可能在持有者不睡眠时到达，残留计数只造成一次提前返回，等待处均循环检查条件
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_busjob.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <string.h>
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 等待总线的作业，位于等待任务的栈上
+ */
+typedef struct
+{
+    struct ylib_pq_node node;           /*!< 等待队列节点 */
+    TickType_t deadline;                /*!< 截止时间(节拍) */
+    TickType_t submit;                  /*!< 提交时间(节拍) */
+    TaskHandle_t task;                  /*!< 等待任务 */
+    UBaseType_t prio;                   /*!< 等待任务的优先级 */
+    uint8_t cls;                        /*!< 作业类别 */
+    uint8_t resumed;                    /*!< 让出后重新排队，获得总线时不计入统计 */
+    volatile uint8_t granted;           /*!< 已获得总线 */
+    char blocker[YDEV_BUSJOB_NAME_LEN]; /*!< 提交时的持有者任务名 */
+} yDevBusJobWaiter_t;
+
+// ==================== 私有宏定义 ====================
+#define YDEV_BUSJOB_LESS(a, b) \
+    (((a)->cls != (b)->cls) ? ((a)->cls < (b)->cls) : ((int32_t)((a)->deadline - (b)->deadline) < 0))
+
+YLIB_PQ_DEFINE(ydev_busjob_pq, yDevBusJobWaiter_t, node, YDEV_BUSJOB_LESS)
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 作业获得总线时更新统计
+ * @note 在临界区内调用
+ */
+static void yDevBusJob_Account(yDevBusSched_t *sched, const yDevBusJobWaiter_t *job, TickType_t now)
+{
+    yDevBusJobStats_t *stats = &sched->stats[job->cls];
+    uint32_t wait_ms = (uint32_t)(now - job->submit) * portTICK_PERIOD_MS;
+    int32_t late = (int32_t)(now - job->deadline);
+
+    stats->runs++;
+    if (wait_ms > stats->max_wait_ms)
+    {
+        stats->max_wait_ms = wait_ms;
+        memcpy(stats->max_wait_owner, job->blocker, sizeof(stats->max_wait_owner));
+    }
+    if (late > 0)
+    {
+        stats->misses++;
+        if ((uint32_t)late * portTICK_PERIOD_MS > stats->max_late_ms)
+        {
+            stats->max_late_ms = (uint32_t)late * portTICK_PERIOD_MS;
+        }
+    }
+}
+
+/**
+ * @brief 持有者优先级低于队首等待者时提升持有者
+ * @note 在临界区内调用，只提升不降低，恢复在移交总线时进行
+ */
+static void yDevBusJob_Inherit(yDevBusSched_t *sched)
+{
+    yDevBusJobWaiter_t *head = ydev_busjob_pq_peek(&sched->queue);
+    UBaseType_t prio;
+
+    if ((head == NULL) || (sched->owner == NULL))
+    {
+        return;
+    }
+    prio = uxTaskPriorityGet((TaskHandle_t)sched->owner);
+    if (head->prio > prio)
+    {
+        if (sched->boosted == 0)
+        {
+            sched->base_prio = (uint8_t)prio;
+            sched->boosted = 1;
+        }
+        vTaskPrioritySet((TaskHandle_t)sched->owner, head->prio);
+    }
+}
+
+/**
+ * @brief 队首作业是否应抢占持有者
+ * @note 在临界区内调用
+ */
+static uint8_t yDevBusJob_Preempt(yDevBusSched_t *sched, yDevBusJobClass_t limit)
+{
+    yDevBusJobWaiter_t *head = ydev_busjob_pq_peek(&sched->queue);
+
+    return ((head != NULL) && (head->cls < sched->cls) && (head->cls < (uint8_t)limit)) ? 1 : 0;
+}
+
+/**
+ * @brief 把总线从当前持有者移交给队首作业，队列为空时总线空闲
+ * @note 在临界区内调用，持有者为当前任务
+ */
+static void yDevBusJob_Handover(yDevBusSched_t *sched)
+{
+    yDevBusJobWaiter_t *next;
+
+    if (sched->boosted != 0)
+    {
+        vTaskPrioritySet(NULL, sched->base_prio);
+        sched->boosted = 0;
+    }
+
+    next = ydev_busjob_pq_pop(&sched->queue);
+    if (next == NULL)
+    {
+        sched->owner = NULL;
+        return;
+    }
+
+    sched->owner = next->task;
+    sched->cls = next->cls;
+    sched->deadline = next->deadline;
+    if (next->resumed == 0)
+    {
+        yDevBusJob_Account(sched, next, xTaskGetTickCount());
+    }
+    next->granted = 1;
+    yDevBusJob_Inherit(sched);
+    xTaskNotifyGiveIndexed(next->task, YDEV_BUSJOB_NOTIFY_INDEX);
+}
+
+/**
+ * @brief 等待被移交总线
+ * @param ticks 超时时间(节拍)，portMAX_DELAY为一直等待
+ * @retval 1 已获得总线，0 超时
+ */
+static uint8_t yDevBusJob_Wait(yDevBusSched_t *sched, yDevBusJobWaiter_t *job, TickType_t ticks)
+{
+    TimeOut_t timeout;
+    uint8_t granted;
+
+    vTaskSetTimeOutState(&timeout);
+    while (job->granted == 0)
+    {
+        if (xTaskCheckForTimeOut(&timeout, &ticks) != pdFALSE)
+        {
+            break;
+        }
+        (void)ulTaskNotifyTakeIndexed(YDEV_BUSJOB_NOTIFY_INDEX, pdTRUE, ticks);
+    }
+
+    // 超时与移交竞争时以granted为准
+    taskENTER_CRITICAL();
+    granted = job->granted;
+    if (granted == 0)
+    {
+        (void)ydev_busjob_pq_remove(&sched->queue, job);
+    }
+    taskEXIT_CRITICAL();
+    return granted;
+}
+
+// ==================== 公共函数实现 ====================
+
+/**
+ * @brief 初始化调度器实现
+ * @param sched 调度器指针
+ */
+void yDevBusSchedInit(yDevBusSched_t *sched)
+{
+    memset(sched, 0, sizeof(*sched));
+    ylib_pq_init(&sched->queue, sched->heap, YDEV_BUSJOB_QUEUE_MAX);
+    sched->deadline_ms[YDEV_BUSJOB_URGENT] = YDEV_BUSJOB_DEADLINE_URGENT_MS;
+    sched->deadline_ms[YDEV_BUSJOB_READ] = YDEV_BUSJOB_DEADLINE_READ_MS;
+    sched->deadline_ms[YDEV_BUSJOB_WRITE] = YDEV_BUSJOB_DEADLINE_WRITE_MS;
+    sched->deadline_ms[YDEV_BUSJOB_ERASE] = YDEV_BUSJOB_DEADLINE_ERASE_MS;
+    sched->deadline_ms[YDEV_BUSJOB_BACKGROUND] = YDEV_BUSJOB_DEADLINE_BACKGROUND_MS;
+}
+
+/**
+ * @brief 提交作业并等待获得总线实现
+ * @param sched 调度器指针
+ * @param cls 作业类别
+ * @param deadline_ms 相对截止时间(毫秒)
+ * @param timeOutMs 等待总线的超时时间(毫秒)
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevBusJobBegin(yDevBusSched_t *sched, yDevBusJobClass_t cls, uint32_t deadline_ms,
+                             uint32_t timeOutMs)
+{
+    yDevBusJobWaiter_t job;
+    TaskHandle_t self;
+
+    if ((sched == NULL) || ((uint32_t)cls >= YDEV_BUSJOB_CLASS_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+    {
+        return YDEV_OK;
+    }
+
+    self = xTaskGetCurrentTaskHandle();
+    ylib_pq_node_init(&job.node);
+    job.submit = xTaskGetTickCount();
+    job.deadline = job.submit + pdMS_TO_TICKS((deadline_ms != 0) ? deadline_ms : sched->deadline_ms[cls]);
+    job.task = self;
+    job.prio = uxTaskPriorityGet(NULL);
+    job.cls = (uint8_t)cls;
+    job.resumed = 0;
+    job.granted = 0;
+    job.blocker[0] = '\0';
+
+    taskENTER_CRITICAL();
+    if (sched->owner == NULL)
+    {
+        sched->owner = self;
+        sched->cls = job.cls;
+        sched->deadline = job.deadline;
+        yDevBusJob_Account(sched, &job, job.submit);
+        taskEXIT_CRITICAL();
+        return YDEV_OK;
+    }
+    if (ydev_busjob_pq_push(&sched->queue, &job) != 0)
+    {
+        taskEXIT_CRITICAL();
+        return YDEV_NO_MEMORY;
+    }
+    sched->stats[job.cls].contended++;
+    (void)strncpy(job.blocker, pcTaskGetName((TaskHandle_t)sched->owner), sizeof(job.blocker) - 1U);
+    job.blocker[sizeof(job.blocker) - 1U] = '\0';
+    yDevBusJob_Inherit(sched);
+    if (job.cls < sched->cls)
+    {
+        // 唤醒在yDevBusJobSleep中的持有者，由它在安全点让出
+        xTaskNotifyGiveIndexed((TaskHandle_t)sched->owner, YDEV_BUSJOB_NOTIFY_INDEX);
+    }
+    taskEXIT_CRITICAL();
+
+    if (yDevBusJob_Wait(sched, &job, pdMS_TO_TICKS(timeOutMs)) == 0)
+    {
+        taskENTER_CRITICAL();
+        sched->stats[job.cls].timeouts++;
+        taskEXIT_CRITICAL();
+        return YDEV_TIMEOUT;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 作业结束实现
+ * @param sched 调度器指针
+ */
+void yDevBusJobEnd(yDevBusSched_t *sched)
+{
+    if ((sched == NULL) || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    if (sched->owner == (void *)xTaskGetCurrentTaskHandle())
+    {
+        yDevBusJob_Handover(sched);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 是否有更紧急的作业在等待实现
+ * @param sched 调度器指针
+ * @param limit 只考虑类别小于该值的作业
+ * @retval 1 应让出，0 无需让出
+ */
+uint8_t yDevBusJobPreemptPending(yDevBusSched_t *sched, yDevBusJobClass_t limit)
+{
+    uint8_t pending;
+
+    if ((sched == NULL) || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+    {
+        return 0;
+    }
+
+    taskENTER_CRITICAL();
+    pending = yDevBusJob_Preempt(sched, limit);
+    taskEXIT_CRITICAL();
+    return pending;
+}
+
+/**
+ * @brief 安全点让出总线实现
+ * @param sched 调度器指针
+ * @param limit 只让给类别小于该值的作业
+ * @retval 1 已让出并重新获得总线，0 无需让出
+ */
+uint8_t yDevBusJobYield(yDevBusSched_t *sched, yDevBusJobClass_t limit)
+{
+    yDevBusJobWaiter_t job;
+
+    if (yDevBusJobPreemptPending(sched, limit) == 0)
+    {
+        return 0;
+    }
+
+    ylib_pq_node_init(&job.node);
+    job.submit = xTaskGetTickCount();
+    job.task = xTaskGetCurrentTaskHandle();
+    job.resumed = 1;
+    job.granted = 0;
+
+    taskENTER_CRITICAL();
+    if ((sched->owner != (void *)job.task) || (yDevBusJob_Preempt(sched, limit) == 0))
+    {
+        taskEXIT_CRITICAL();
+        return 0;
+    }
+    job.cls = sched->cls;
+    job.deadline = sched->deadline;
+    job.prio = (sched->boosted != 0) ? sched->base_prio : uxTaskPriorityGet(NULL);
+    sched->stats[job.cls].preempts++;
+
+    // 先移交再入队，队首一定是更紧急的作业，出队后必有空位
+    yDevBusJob_Handover(sched);
+    (void)ydev_busjob_pq_push(&sched->queue, &job);
+    yDevBusJob_Inherit(sched);
+    taskEXIT_CRITICAL();
+
+    (void)yDevBusJob_Wait(sched, &job, portMAX_DELAY);
+    return 1;
+}
+
+/**
+ * @brief 持有总线时等待实现
+ * @param sched 调度器指针
+ * @param ms 最长等待时间(毫秒)
+ */
+void yDevBusJobSleep(yDevBusSched_t *sched, uint32_t ms)
+{
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+
+    if (ticks == 0)
+    {
+        ticks = 1;
+    }
+    if ((sched == NULL) || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+    {
+        vTaskDelay(ticks);
+        return;
+    }
+    if (yDevBusJobPreemptPending(sched, YDEV_BUSJOB_CLASS_MAX) != 0)
+    {
+        return;
+    }
+    (void)ulTaskNotifyTakeIndexed(YDEV_BUSJOB_NOTIFY_INDEX, pdTRUE, ticks);
+}
+
+/**
+ * @brief 设置类别默认截止时间实现
+ * @param sched 调度器指针
+ * @param deadline 类别和截止时间
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevBusJobSetDeadline(yDevBusSched_t *sched, const yDevBusJobDeadline_t *deadline)
+{
+    if ((sched == NULL) || (deadline == NULL) || (deadline->cls >= YDEV_BUSJOB_CLASS_MAX) ||
+        (deadline->deadline_ms == 0))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    sched->deadline_ms[deadline->cls] = deadline->deadline_ms;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 读取统计实现
+ * @param sched 调度器指针
+ * @param stats 输出数组
+ * @param reset 非0时读取后清零
+ */
+void yDevBusJobGetStats(yDevBusSched_t *sched, yDevBusJobStats_t *stats, uint8_t reset)
+{
+    if ((sched == NULL) || (stats == NULL))
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    memcpy(stats, sched->stats, sizeof(sched->stats));
+    if (reset != 0)
+    {
+        memset(sched->stats, 0, sizeof(sched->stats));
+    }
+    taskEXIT_CRITICAL();
+}
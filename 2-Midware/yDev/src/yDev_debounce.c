@@ -0,0 +1,387 @@
+/**
+ * @file yDev_debounce.c
+ * @brief GPIO边沿捕获与消抖服务实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * EXTI回调把边沿记录放入共享环形缓冲区，周期定时器统一消抖并把稳定的电平变化投递到事件队列
+ *
+ * @par 实现说明:
+ * - 中断内只读时间戳和输入寄存器，关中断入队，几条指令即返回
+ * - 定时器回调在定时器任务中执行，先取空环形缓冲区，再检查各引脚是否已稳定
+ * - 稳定电平在定时器中重新读取输入寄存器，抖动中采到的电平只用于计数
+ *
+ * @par 更新历史:
+ * - v1.0 (2025): 初始版本
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_debounce.h"
+#include "yDev_def.h"
+#include "yLib_ring.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "os_static.h"
+
+#include <string.h>
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 中断中记录的边沿
+ */
+typedef struct
+{
+    uint8_t line;     /*!< EXTI线号 */
+    uint8_t level;    /*!< 中断时采到的电平 */
+    uint16_t reserve; /*!< 保留 */
+    uint32_t time_us; /*!< 微秒时间戳 */
+} yDevDebounceEdgeRec_t;
+
+/**
+ * @brief 单个引脚的消抖状态
+ */
+typedef struct
+{
+    yDevHandle_Gpio_t *gpio; /*!< GPIO设备句柄，NULL表示空闲 */
+    uint32_t debounce_us;    /*!< 消抖时间(微秒) */
+    uint32_t first_us;       /*!< 这一串抖动的第一个边沿时间 */
+    uint32_t last_us;        /*!< 最近一个边沿时间 */
+    uint16_t bounces;        /*!< 这一串抖动的边沿数 */
+    uint8_t pending;         /*!< 有尚未稳定的边沿 */
+    uint8_t stable;          /*!< 最近一次上报的稳定电平 */
+} yDevDebounceSlot_t;
+
+// ==================== 私有变量 ====================
+
+/**
+ * @brief 边沿记录环形缓冲区，所有EXTI中断共用
+ * @note 生产者在关中断状态下入队，消费者只有定时器任务
+ */
+static DECLARE_YLIB_RING(yDevDebounceEdgeRec_t, YDEV_DEBOUNCE_RING_SIZE) debounce_ring;
+
+/**
+ * @brief 引脚消抖状态表
+ */
+static yDevDebounceSlot_t debounce_slot[YDEV_DEBOUNCE_MAX];
+
+/**
+ * @brief EXTI线号到消抖状态的映射，NULL表示未使用
+ */
+static yDevDebounceSlot_t *debounce_line[16];
+
+static QueueHandle_t debounce_queue = NULL; /*!< 消抖事件队列 */
+static TimerHandle_t debounce_timer = NULL; /*!< 消抖周期定时器，启动成功后才赋值 */
+
+OS_QUEUE_DEFINE(debounce_queue, yDevDebounceEvent_t, YDEV_DEBOUNCE_QUEUE_LEN); /*!< 事件队列存储 */
+OS_TIMER_DEFINE(debounce_timer);                                               /*!< 定时器存储 */
+
+static volatile uint32_t debounce_lost_edges = 0;  /*!< 环形缓冲区满丢弃的记录数 */
+static volatile uint32_t debounce_overflow = 0;    /*!< 有记录被丢弃，待定时器整体重查 */
+static volatile uint32_t debounce_lost_events = 0; /*!< 事件队列满丢弃的事件数 */
+static void (*debounce_notify)(void) = NULL;       /*!< 有新事件入队时的通知函数 */
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief EXTI边沿回调
+ * @param arg 引脚消抖状态
+ * @note 中断中执行，只记录不处理
+ */
+static void yDev_Debounce_EdgeIsr(void *arg)
+{
+    yDevDebounceSlot_t *slot = (yDevDebounceSlot_t *)arg;
+    yDevDebounceEdgeRec_t rec;
+    uint32_t primask;
+
+    rec.line = slot->gpio->drv_handle.gpioInfo.pinIndex;
+    rec.level = (uint8_t)yDevGpioReadFast(slot->gpio);
+    rec.reserve = 0;
+
+    // 不同优先级的EXTI中断可能互相抢占，关中断保证单生产者
+    primask = __get_PRIMASK();
+    __disable_irq();
+    rec.time_us = yDevGetTimeUS();
+    if (ylib_ring_enqueue(&debounce_ring.ring, &rec, sizeof(rec)) == 0)
+    {
+        debounce_lost_edges++;
+        debounce_overflow = 1;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 消抖周期定时器回调
+ * @param timer 定时器句柄
+ * @note 在定时器任务中执行
+ */
+static void yDev_Debounce_TimerCallback(TimerHandle_t timer)
+{
+    yDevDebounceEdgeRec_t rec;
+    yDevDebounceSlot_t *slot;
+    yDevDebounceEvent_t event;
+    uint32_t now;
+    uint32_t level;
+    uint32_t queued = 0;
+
+    (void)timer;
+
+    // 取出全部边沿记录
+    while (ylib_ring_dequeue(&debounce_ring.ring, &rec, sizeof(rec)) != 0)
+    {
+        slot = debounce_line[rec.line & 0x0FU];
+        if (slot == NULL)
+        {
+            continue;
+        }
+        if (slot->pending == 0)
+        {
+            slot->pending = 1;
+            slot->first_us = rec.time_us;
+            slot->bounces = 0;
+        }
+        slot->last_us = rec.time_us;
+        if (slot->bounces < 0xFFFFU)
+        {
+            slot->bounces++;
+        }
+    }
+
+    now = yDevGetTimeUS();
+
+    // 有记录被丢弃时，所有引脚从现在起重新计时
+    if (debounce_overflow != 0)
+    {
+        debounce_overflow = 0;
+        for (uint32_t i = 0; i < YDEV_DEBOUNCE_MAX; i++)
+        {
+            slot = &debounce_slot[i];
+            if (slot->gpio == NULL)
+            {
+                continue;
+            }
+            if (slot->pending == 0)
+            {
+                slot->pending = 1;
+                slot->first_us = now;
+                slot->bounces = 0;
+            }
+            slot->last_us = now;
+        }
+    }
+
+    // 最后一个边沿之后已稳定足够长时间的引脚，电平变化时上报
+    for (uint32_t i = 0; i < YDEV_DEBOUNCE_MAX; i++)
+    {
+        slot = &debounce_slot[i];
+        if ((slot->gpio == NULL) || (slot->pending == 0) ||
+            ((now - slot->last_us) < slot->debounce_us))
+        {
+            continue;
+        }
+
+        slot->pending = 0;
+        level = yDevGpioReadFast(slot->gpio);
+        if (level == slot->stable)
+        {
+            continue; // 抖动后回到原电平
+        }
+        slot->stable = (uint8_t)level;
+
+        event.gpio = slot->gpio;
+        event.line = slot->gpio->drv_handle.gpioInfo.pinIndex;
+        event.edge = (level != 0) ? YDEV_DEBOUNCE_EDGE_RISING : YDEV_DEBOUNCE_EDGE_FALLING;
+        event.bounces = slot->bounces;
+        event.time_us = slot->first_us;
+        if (xQueueSend(debounce_queue, &event, 0) != pdPASS)
+        {
+            debounce_lost_events++;
+        }
+        else
+        {
+            queued++;
+        }
+    }
+
+    if ((queued != 0U) && (debounce_notify != NULL))
+    {
+        debounce_notify();
+    }
+}
+
+// ==================== 公共API实现 ====================
+
+yDevStatus_t yDevDebounceInit(void)
+{
+    TimerHandle_t timer;
+
+    if (debounce_timer != NULL)
+    {
+        return YDEV_OK;
+    }
+
+    INIT_YLIB_RING(debounce_ring);
+    memset(debounce_slot, 0, sizeof(debounce_slot));
+    memset(debounce_line, 0, sizeof(debounce_line));
+
+    if (debounce_queue == NULL)
+    {
+        debounce_queue = OS_QUEUE_CREATE(debounce_queue);
+    }
+
+    // 启动命令未发出时定时器不被内核引用，下次初始化在同一存储上重新创建
+    timer = OS_TIMER_CREATE(debounce_timer,
+                            "debounce",
+                            pdMS_TO_TICKS(YDEV_DEBOUNCE_TICK_MS),
+                            pdTRUE,
+                            NULL,
+                            yDev_Debounce_TimerCallback);
+    if (xTimerStart(timer, 0) != pdPASS)
+    {
+        return YDEV_NO_MEMORY;
+    }
+    debounce_timer = timer;
+
+    return YDEV_OK;
+}
+
+yDevStatus_t yDevDebounceAdd(yDevHandle_Gpio_t *gpio, uint32_t debounce_ms, uint32_t prio)
+{
+    yDevDebounceSlot_t *slot = NULL;
+    yDrvGpioExtiConfig_t exti;
+    uint32_t line;
+
+    // 参数有效性检查
+    if ((gpio == NULL) || (gpio->drv_handle.gpioInfo.port == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (debounce_timer == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    line = gpio->drv_handle.gpioInfo.pinIndex;
+    if (debounce_line[line] != NULL)
+    {
+        return (debounce_line[line]->gpio == gpio) ? YDEV_OK : YDEV_BUSY;
+    }
+
+    for (uint32_t i = 0; i < YDEV_DEBOUNCE_MAX; i++)
+    {
+        if (debounce_slot[i].gpio == NULL)
+        {
+            slot = &debounce_slot[i];
+            break;
+        }
+    }
+    if (slot == NULL)
+    {
+        return YDEV_NO_MEMORY;
+    }
+
+    // 以当前电平为初始稳定电平
+    slot->debounce_us = debounce_ms * 1000U;
+    slot->pending = 0;
+    slot->bounces = 0;
+    slot->stable = (uint8_t)yDevGpioReadFast(gpio);
+    slot->gpio = gpio;
+    debounce_line[line] = slot;
+
+    exti = YDRV_GPIO_EXTI_CONFIG_DEFAULT();
+    exti.trigger = YDRV_GPIO_EXTI_TRIGGER_RISING_FALLING;
+    exti.prio = prio;
+    exti.function = yDev_Debounce_EdgeIsr;
+    exti.arg = slot;
+    exti.enable = 1;
+    if (yDevIoctl(gpio, YDEV_GPIO_REGISTER_EXIT, &exti) != YDEV_OK)
+    {
+        debounce_line[line] = NULL;
+        slot->gpio = NULL;
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+yDevStatus_t yDevDebounceRemove(yDevHandle_Gpio_t *gpio)
+{
+    yDrvGpioExtiConfig_t exti;
+    yDevDebounceSlot_t *slot;
+    uint32_t line;
+
+    // 参数有效性检查
+    if (gpio == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    line = gpio->drv_handle.gpioInfo.pinIndex;
+    slot = debounce_line[line & 0x0FU];
+    if ((slot == NULL) || (slot->gpio != gpio))
+    {
+        return YDEV_DEVICE_NOT_FOUND;
+    }
+
+    exti = YDRV_GPIO_EXTI_CONFIG_DEFAULT();
+    exti.trigger = YDRV_GPIO_EXTI_TRIGGER_RISING_FALLING;
+    exti.function = yDev_Debounce_EdgeIsr;
+    exti.arg = slot;
+    (void)yDrvGpioUnregisterHandler(&gpio->drv_handle, &exti);
+
+    // 定时器任务中可能正在使用该状态，挂起调度器后释放
+    vTaskSuspendAll();
+    debounce_line[line] = NULL;
+    slot->gpio = NULL;
+    slot->pending = 0;
+    (void)xTaskResumeAll();
+
+    return YDEV_OK;
+}
+
+yDevStatus_t yDevDebounceGet(yDevDebounceEvent_t *event, uint32_t timeOutMs)
+{
+    TickType_t ticks;
+
+    // 参数有效性检查
+    if (event == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (debounce_queue == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    ticks = (timeOutMs == YDEV_DEBOUNCE_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeOutMs);
+    if (xQueueReceive(debounce_queue, event, ticks) != pdPASS)
+    {
+        return YDEV_TIMEOUT;
+    }
+
+    return YDEV_OK;
+}
+
+void yDevDebounceGetLost(uint32_t *lost_edges, uint32_t *lost_events)
+{
+    if (lost_edges != NULL)
+    {
+        *lost_edges = debounce_lost_edges;
+    }
+    if (lost_events != NULL)
+    {
+        *lost_events = debounce_lost_events;
+    }
+}
+
+void yDevDebounceSetNotify(void (*notify)(void))
+{
+    debounce_notify = notify;
+}
@@ -56,8 +56,8 @@ extern "C"
      *
      * @par 实现原理:
      * - 使用编译器段属性将操作表放入.ydev_ops段
-     * - 运行时通过遍历该段来发现所有已注册的设备
-     * - 提供设备驱动的自动注册机制
+     * - 符号名ydev_<类型>_ops由类型生成，yDev.c以弱引用按类型建立指针表，查找不需要遍历
+     * - 同一类型重复导出在链接时报重复定义
      */
 #define YDEV_OPS_EXPORT_EX(_type, _init, _deinit, _read, _write, _ioctl)     \
     YLIB_USED const yDevOps_t ydev_##_type##_ops YLIB_SECTION(".ydev_ops") = \
@@ -69,7 +69,115 @@ extern "C"
             .write = _write,                                                 \
             .ioctl = _ioctl};
 
-    // extern size_t ydev_time_ms;
+    /**
+     * @brief 设备操作表导出宏(带异步读写)
+     * @param _type 设备类型名称标识
+     * @param _init 设备初始化函数名
+     * @param _deinit 设备反初始化函数名
+     * @param _read 设备读取函数名
+     * @param _write 设备写入函数名
+     * @param _ioctl 设备控制函数名
+     * @param _read_async 设备异步读取函数名，可为NULL
+     * @param _write_async 设备异步写入函数名，可为NULL
+     * @note 与YDEV_OPS_EXPORT_EX相同，另外填写异步读写入口
+     */
+#define YDEV_OPS_EXPORT_ASYNC(_type, _init, _deinit, _read, _write, _ioctl,   \
+                              _read_async, _write_async)                      \
+    YLIB_USED const yDevOps_t ydev_##_type##_ops YLIB_SECTION(".ydev_ops") = \
+        {                                                                    \
+            .type = _type,                                                   \
+            .init = _init,                                                   \
+            .deinit = _deinit,                                               \
+            .read = _read,                                                   \
+            .write = _write,                                                 \
+            .ioctl = _ioctl,                                                 \
+            .read_async = _read_async,                                       \
+            .write_async = _write_async};
+
+    /**
+     * @brief 设备操作表导出宏(带异步和向量读写)
+     * @param _type 设备类型名称标识
+     * @param _init 设备初始化函数名
+     * @param _deinit 设备反初始化函数名
+     * @param _read 设备读取函数名
+     * @param _write 设备写入函数名
+     * @param _ioctl 设备控制函数名
+     * @param _read_async 设备异步读取函数名，可为NULL
+     * @param _write_async 设备异步写入函数名，可为NULL
+     * @param _readv 设备向量读取函数名，可为NULL
+     * @param _writev 设备向量写入函数名，可为NULL
+     * @note 与YDEV_OPS_EXPORT_ASYNC相同，另外填写向量读写入口
+     */
+#define YDEV_OPS_EXPORT_VEC(_type, _init, _deinit, _read, _write, _ioctl,     \
+                            _read_async, _write_async, _readv, _writev)       \
+    YLIB_USED const yDevOps_t ydev_##_type##_ops YLIB_SECTION(".ydev_ops") = \
+        {                                                                    \
+            .type = _type,                                                   \
+            .init = _init,                                                   \
+            .deinit = _deinit,                                               \
+            .read = _read,                                                   \
+            .write = _write,                                                 \
+            .ioctl = _ioctl,                                                 \
+            .read_async = _read_async,                                       \
+            .write_async = _write_async,                                     \
+            .readv = _readv,                                                 \
+            .writev = _writev};
+
+    /**
+     * @brief 设备操作表导出宏(带异步、向量读写和电源管理)
+     * @param _type 设备类型名称标识
+     * @param _init 设备初始化函数名
+     * @param _deinit 设备反初始化函数名
+     * @param _read 设备读取函数名
+     * @param _write 设备写入函数名
+     * @param _ioctl 设备控制函数名
+     * @param _read_async 设备异步读取函数名，可为NULL
+     * @param _write_async 设备异步写入函数名，可为NULL
+     * @param _readv 设备向量读取函数名，可为NULL
+     * @param _writev 设备向量写入函数名，可为NULL
+     * @param _suspend 设备挂起函数名
+     * @param _resume 设备恢复函数名
+     * @note 与YDEV_OPS_EXPORT_VEC相同，另外填写挂起和恢复入口
+     */
+#define YDEV_OPS_EXPORT_PM(_type, _init, _deinit, _read, _write, _ioctl,      \
+                           _read_async, _write_async, _readv, _writev,        \
+                           _suspend, _resume)                                 \
+    YLIB_USED const yDevOps_t ydev_##_type##_ops YLIB_SECTION(".ydev_ops") = \
+        {                                                                    \
+            .type = _type,                                                   \
+            .init = _init,                                                   \
+            .deinit = _deinit,                                               \
+            .read = _read,                                                   \
+            .write = _write,                                                 \
+            .ioctl = _ioctl,                                                 \
+            .read_async = _read_async,                                       \
+            .write_async = _write_async,                                     \
+            .readv = _readv,                                                 \
+            .writev = _writev,                                               \
+            .suspend = _suspend,                                             \
+            .resume = _resume};
+
+    /**
+     * @brief 异步传输结束通知
+     * @param handle 设备句柄指针
+     * @param dir 传输方向
+     * @param status 传输结果
+     * @param len 实际传输的字节数
+     * @retval 无
+     * @note 由驱动在传输结束时调用，可在中断或任务中调用；
+     *       依次记录结果、清除进行中标志、调用完成回调并唤醒yDevWait中的任务
+     */
+    void yDevAsyncComplete(void *handle, yDevAsyncDir_t dir, yDevStatus_t status, uint32_t len);
+
+    /**
+     * @brief 就绪事件通知
+     * @param handle 设备句柄指针
+     * @param events 登记的就绪事件，0表示只唤醒
+     * @retval 无
+     * @note 由驱动在数据到达、发送空间释放等时刻调用，可在中断或任务中调用；
+     *       有YDEV_IOCTL_POLL可查询当前状态的驱动传0即可，避免登记过时的事件
+     */
+    void yDevPollSignal(void *handle, uint32_t events);
 
     /**
      * @brief 初始化yDev配置结构体为默认值
@@ -1,510 +1,831 @@
 /**
  * @file yDev_dma.c
- * @brief yDev DMA设备驱动实现
- * @version 2.0
+ * @brief yDev DMA内存拷贝设备实现
+ * @version 2.1
  * @date 2025
  * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现基于yDev框架的内存到内存DMA拷贝引擎
+ *
+ * @par 主要功能:
+ * - 对齐的拷贝使用32位数据项，尾部不足4字节的部分由CPU拷贝
+ * - 每段最多65535个数据项，传输完成中断中启动下一段
+ * - 初始化时用SysTick计数实测CPU与DMA拷贝耗时，得到交叉点
+ * - 完成回调异步拷贝，或在任务通知上阻塞等待
+ * - 读写窗口上的同步和yDev异步读写
+ *
+ * @par 更新历史:
+ * - v2.1 (2025): 重写为内存拷贝引擎
  */
 
+// ==================== 包含文件 ====================
 #include "yDev_dma.h"
+#include "yDev_def.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
 #include <string.h>
 
-// ==================== 基础函数实现 ====================
+// ==================== 私有宏定义 ====================
+
+/**
+ * @brief 单段最大数据项数
+ */
+#define YDEV_DMA_CHUNK_MAX (0xFFFFUL)
+
+// ==================== 静态变量定义 ====================
+
+/**
+ * @brief 默认拷贝引擎
+ * @note 第一个初始化成功的DMA设备，供yDevDmaMemcpy使用
+ */
+static yDevHandle_Dma_t *dma_default = NULL;
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 启动下一段DMA传输
+ * @param handle DMA设备句柄指针
+ * @retval 无
+ * @note 段长度为剩余数据项数和65535中的较小值
+ */
+static void yDev_Dma_StartChunk(yDevHandle_Dma_t *handle);
+
+/**
+ * @brief 结束本次拷贝
+ * @param handle DMA设备句柄指针
+ * @param status 拷贝结果
+ * @retval 无
+ * @note 在中断中执行，清除忙标志后调用完成回调或唤醒等待任务
+ */
+static void yDev_Dma_Finish(yDevHandle_Dma_t *handle, yDevStatus_t status);
+
+/**
+ * @brief 传输完成中断回调
+ * @param arg DMA设备句柄指针
+ * @retval 无
+ */
+static void yDev_Dma_CompleteIrq(void *arg);
+
+/**
+ * @brief 传输错误中断回调
+ * @param arg DMA设备句柄指针
+ * @retval 无
+ */
+static void yDev_Dma_ErrorIrq(void *arg);
+
+/**
+ * @brief CPU拷贝并调用完成回调
+ * @param handle DMA设备句柄指针，可为NULL
+ * @param copy 拷贝请求
+ * @retval yDevStatus_t 拷贝状态
+ */
+static yDevStatus_t yDev_Dma_CpuCopy(yDevHandle_Dma_t *handle, const yDevDmaCopy_t *copy);
+
+/**
+ * @brief 执行一次拷贝请求
+ * @param handle DMA设备句柄指针
+ * @param copy 拷贝请求
+ * @retval yDevStatus_t 拷贝状态，异步拷贝时为启动状态
+ * @note 短拷贝、引擎忙或在中断中阻塞调用时退回CPU拷贝
+ */
+static yDevStatus_t yDev_Dma_Copy(yDevHandle_Dma_t *handle, const yDevDmaCopy_t *copy);
+
+/**
+ * @brief 实测CPU/DMA交叉点
+ * @param handle DMA设备句柄指针
+ * @retval uint32_t 交叉点字节数
+ * @note 关中断轮询完成标志，在注册中断回调之前调用；
+ *       从YDEV_DMA_CALIB_MIN开始倍增长度，DMA耗时不超过CPU耗时的第一个长度即交叉点
+ */
+static uint32_t yDev_Dma_Calibrate(yDevHandle_Dma_t *handle);
+
+/**
+ * @brief 测量一次拷贝耗时
+ * @param handle DMA设备句柄指针
+ * @param dst 目标地址
+ * @param src 源地址
+ * @param len 拷贝字节数
+ * @param flag_dma 非0表示DMA拷贝，0表示CPU拷贝
+ * @retval uint32_t 耗时(SysTick计数)
+ */
+static uint32_t yDev_Dma_Measure(yDevHandle_Dma_t *handle, void *dst, const void *src,
+                                 uint32_t len, uint8_t flag_dma);
+
+/**
+ * @brief 在读写窗口和用户缓冲区之间拷贝
+ * @param handle DMA设备句柄指针
+ * @param buffer 用户缓冲区
+ * @param size 请求字节数
+ * @param flag_write 非0表示写入窗口，0表示从窗口读取
+ * @param callback 完成回调，NULL表示阻塞等待完成
+ * @param len 输出实际拷贝的字节数，超出窗口的部分被截断
+ * @retval yDevStatus_t 拷贝状态，异步拷贝时为启动状态
+ * @note 启动前推进读写位置
+ */
+static yDevStatus_t yDev_Dma_WindowCopy(yDevHandle_Dma_t *handle, void *buffer, uint32_t size,
+                                        uint8_t flag_write, yDevDmaCallback_t callback, uint32_t *len);
+
+/**
+ * @brief 异步读取完成回调
+ * @param arg DMA设备句柄指针
+ * @param status 拷贝结果
+ * @retval 无
+ */
+static void yDev_Dma_ReadDone(void *arg, yDevStatus_t status);
+
+/**
+ * @brief 异步写入完成回调
+ * @param arg DMA设备句柄指针
+ * @param status 拷贝结果
+ * @retval 无
+ */
+static void yDev_Dma_WriteDone(void *arg, yDevStatus_t status);
 
-static yDevStatus_t yDevDmaInitStatic(void *config, void *handle)
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 启动下一段DMA传输实现
+ */
+static void yDev_Dma_StartChunk(yDevHandle_Dma_t *handle)
 {
-    yDrvStatus_t drv_status;
-    yDevConfig_Dma_t *dma_config;
-    yDevHandle_Dma_t *dma_handle;
+    yDrvDmaDataWidth_t width;
+    uint32_t items;
 
-    // 参数有效性检查
-    if (config == NULL || handle == NULL)
+    items = handle->remain >> handle->shift;
+    if (items > YDEV_DMA_CHUNK_MAX)
     {
-        return YDEV_ERROR;
+        items = YDEV_DMA_CHUNK_MAX;
     }
+    width = (handle->shift != 0) ? YDRV_DMA_WIDTH_32BIT : YDRV_DMA_WIDTH_8BIT;
 
-    dma_config = (yDevConfig_Dma_t *)config;
-    dma_handle = (yDevHandle_Dma_t *)handle;
+    yDrvDmaTransDisable(&handle->drv_handle);
+    yDrvDmaSrcBufferSet(&handle->drv_handle, (void *)handle->src, width);
+    yDrvDmaDstBufferSet(&handle->drv_handle, handle->dst, width);
+    yDrvDmaDstBufferLen(&handle->drv_handle, items);
+    yDrvDmaClearFlags(&handle->drv_handle);
 
-    // 初始化底层DMA驱动
-    drv_status = yDrvDmaInitStatic(&dma_config->drv_config, &dma_handle->drv_handle);
-    if (drv_status != YDRV_OK)
-    {
-        dma_handle->base.errno = YDEV_ERRNO_NOT_INIT;
-        return YDEV_ERROR;
-    }
+    handle->src += items << handle->shift;
+    handle->dst += items << handle->shift;
+    handle->remain -= items << handle->shift;
 
-    return YDEV_OK;
+    yDrvDmaTransEnable(&handle->drv_handle);
 }
 
-static yDevStatus_t yDevDmaDeInitStatic(void *handle)
+/**
+ * @brief 结束本次拷贝实现
+ */
+static void yDev_Dma_Finish(yDevHandle_Dma_t *handle, yDevStatus_t status)
 {
-    yDevHandle_Dma_t *dma_handle;
+    yDevDmaCallback_t callback;
+    BaseType_t woken = pdFALSE;
 
-    // 参数有效性检查
-    if (handle == NULL)
+    yDrvDmaTransDisable(&handle->drv_handle);
+
+    if (status == YDEV_OK)
     {
-        return YDEV_INVALID_PARAM;
+        handle->stats.dma_copies++;
+        handle->stats.dma_bytes += handle->total;
+    }
+    else
+    {
+        handle->stats.errors++;
     }
 
-    dma_handle = (yDevHandle_Dma_t *)handle;
+    callback = handle->callback;
+    handle->callback = NULL;
+    handle->status = status;
+    handle->busy = 0;
 
-    // 调用底层yDrv反初始化DMA
-    if (yDrvDmaDeInitStatic(&dma_handle->drv_handle) != YDRV_OK)
+    if (callback != NULL)
     {
-        dma_handle->base.errno = YDEV_ERRNO_NOT_DEINIT;
-        return YDEV_ERROR;
+        callback(handle->arg, status);
     }
-
-    return YDEV_OK;
+    else if (handle->wait_task != NULL)
+    {
+        vTaskNotifyGiveFromISR((TaskHandle_t)handle->wait_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
 }
 
-// ==================== yDev DMA初始化函数实现 ====================
-
-void yDevDmaConfigStructInit(yDevConfig_Dma_t *config)
+/**
+ * @brief 传输完成中断回调实现
+ */
+static void yDev_Dma_CompleteIrq(void *arg)
 {
-    if (config == NULL)
+    yDevHandle_Dma_t *handle = (yDevHandle_Dma_t *)arg;
+
+    if (handle->busy == 0)
     {
         return;
     }
 
-    // 初始化基础配置
-    yDevConfigStructInit(&config->base);
-
-    // 初始化驱动配置
-    yDrvDmaConfigStructInit(&config->drv_config);
-}
-
-void yDevDmaHandleStructInit(yDevHandle_Dma_t *handle)
-{
-    if (handle == NULL)
+    if (handle->remain != 0)
     {
+        yDev_Dma_StartChunk(handle);
         return;
     }
 
-    // 初始化基础句柄
-    yDevHandleStructInit(&handle->base);
-
-    // 初始化驱动句柄
-    yDrvDmaHandleStructInit(&handle->drv_handle);
+    yDev_Dma_Finish(handle, YDEV_OK);
 }
 
 /**
- * @brief GPIO设备读取操作
- * @param handle GPIO设备句柄
- * @param buffer 读取缓冲区
- * @param size 缓冲区大小
- * @return int32_t 实际读取的字节数，-1表示错误
- *
- * @par 功能描述:
- * 读取GPIO引脚的当前状态，将状态值写入缓冲区
- * 状态值：0表示低电平，非0表示高电平
+ * @brief 传输错误中断回调实现
  */
-static yDevStatus_t yDevDmaWrite(void *handle, void *buffer, uint16_t size)
+static void yDev_Dma_ErrorIrq(void *arg)
 {
-    yDevHandle_Dma_t *dma_handle;
-    uint32_t *data_buffer;
+    yDevHandle_Dma_t *handle = (yDevHandle_Dma_t *)arg;
 
-    // 参数有效性检查
-    if ((handle == NULL) || (buffer == NULL) || (size != sizeof(uint32_t)))
+    if (handle->busy == 0)
     {
-        return -1; // 返回错误
+        return;
     }
 
-    dma_handle = (yDevHandle_Dma_t *)handle;
-    data_buffer = (uint32_t *)buffer;
-
-    // 调用底层yDrv读取DMA数据
-    *data_buffer = (uint32_t)
-        yDrvDmaRead(&dma_handle->drv_handle);
-
-    return sizeof(uint32_t); // 返回实际读取的字节数
+    yDev_Dma_Finish(handle, YDEV_ERROR);
 }
 
-static yDevStatus_t yDevDmaRead(void *handle, const void *buffer, uint16_t size)
+/**
+ * @brief CPU拷贝实现
+ */
+static yDevStatus_t yDev_Dma_CpuCopy(yDevHandle_Dma_t *handle, const yDevDmaCopy_t *copy)
 {
-    yDevHandle_Dma_t *dma_handle = (yDevHandle_Dma_t *)handle;
+    memcpy(copy->dst, copy->src, copy->len);
 
-    // 参数有效性检查
-    if (dma_handle == NULL || buffer == NULL || size == 0)
+    if (handle != NULL)
     {
-        return YDEV_ERROR;
+        handle->stats.cpu_copies++;
+        handle->stats.cpu_bytes += copy->len;
     }
 
-    // 检查设备状态
-    if (dma_handle->base.state != YDEV_STATE_READY)
+    if (copy->callback != NULL)
     {
-        dma_handle->base.errno = YDEV_DMA_ERRNO_NOT_INIT;
-        return YDEV_ERROR;
+        copy->callback(copy->arg, YDEV_OK);
     }
-
-    // TODO: 实现DMA读取操作
-    // 这里应该配置DMA传输，从源地址读取数据到buffer
-
     return YDEV_OK;
 }
 
-static yDevStatus_t yDevDmaIoctl(void *handle, uint32_t cmd, void *arg)
+/**
+ * @brief 执行拷贝请求实现
+ */
+static yDevStatus_t yDev_Dma_Copy(yDevHandle_Dma_t *handle, const yDevDmaCopy_t *copy)
 {
-    yDevHandle_Dma_t *dma_handle = (yDevHandle_Dma_t *)handle;
+    uint32_t primask;
+    uint32_t tail;
+    uint8_t flag_wait;
+    uint8_t flag_done;
+    uint8_t shift;
+    uint32_t start_time;
+    uint32_t taken = 0;
 
-    // 参数有效性检查
-    if (dma_handle == NULL)
+    if ((copy->dst == NULL) || (copy->src == NULL))
     {
-        return YDEV_ERROR;
+        return YDEV_INVALID_PARAM;
     }
 
-    switch (cmd)
+    // 1. 短拷贝和中断中的阻塞拷贝直接用CPU
+    if ((copy->len < handle->crossover) || (copy->len < 4U) ||
+        ((copy->callback == NULL) && (__get_IPSR() != 0U)))
     {
-    case YDEV_DMA_IOCTL_START:
-        return yDevDmaStartTransfer(dma_handle, (const yDevDmaTransferConfig_t *)arg);
+        return yDev_Dma_CpuCopy(handle, copy);
+    }
 
-    case YDEV_DMA_IOCTL_STOP:
-        return yDevDmaStopTransfer(dma_handle);
+    // 2. 占用引擎，忙时退回CPU拷贝
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (handle->busy != 0)
+    {
+        __set_PRIMASK(primask);
+        return yDev_Dma_CpuCopy(handle, copy);
+    }
+    handle->busy = 1;
+    __set_PRIMASK(primask);
 
-    case YDEV_DMA_IOCTL_PAUSE:
-        return yDevDmaPauseTransfer(dma_handle);
+    // 3. 地址都4字节对齐时按字传输，末尾不足一个字的部分先由CPU拷贝
+    shift = ((((uint32_t)copy->dst | (uint32_t)copy->src) & 0x3U) == 0U) ? 2U : 0U;
+    tail = copy->len & ((1UL << shift) - 1U);
+    if (tail != 0)
+    {
+        memcpy((uint8_t *)copy->dst + copy->len - tail,
+               (const uint8_t *)copy->src + copy->len - tail,
+               tail);
+    }
 
-    case YDEV_DMA_IOCTL_RESUME:
-        return yDevDmaResumeTransfer(dma_handle);
+    flag_wait = ((copy->callback == NULL) &&
+                 (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+                    ? 1
+                    : 0;
+    handle->dst = (uint8_t *)copy->dst;
+    handle->src = (const uint8_t *)copy->src;
+    handle->remain = copy->len - tail;
+    handle->total = copy->len;
+    handle->shift = shift;
+    handle->status = YDEV_BUSY;
+    handle->callback = copy->callback;
+    handle->arg = copy->arg;
+    handle->wait_task = (flag_wait != 0) ? (void *)xTaskGetCurrentTaskHandle() : NULL;
+    if (flag_wait != 0)
+    {
+        taken = ulTaskNotifyTake(pdTRUE, 0); // 清除残留通知，结束后归还
+    }
 
-    case YDEV_DMA_IOCTL_GET_STATUS:
-        return yDevDmaGetStatus(dma_handle, (yDevDmaStatus_t *)arg);
+    // 4. 启动第一段，异步拷贝到此返回
+    yDev_Dma_StartChunk(handle);
+    if (copy->callback != NULL)
+    {
+        return YDEV_OK;
+    }
 
-    case YDEV_DMA_IOCTL_GET_REMAINING:
-        if (arg != NULL)
+    // 5. 阻塞等待完成，其他来源的通知不会提前结束等待
+    if (flag_wait != 0)
+    {
+        start_time = (uint32_t)xTaskGetTickCount();
+        while ((handle->busy != 0) &&
+               (((uint32_t)xTaskGetTickCount() - start_time) < pdMS_TO_TICKS(handle->base.timeOutMs)))
         {
-            *(uint32_t *)arg = yDevDmaGetRemainingCount(dma_handle);
-            return YDEV_OK;
+            taken += ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(handle->base.timeOutMs));
         }
-        return YDEV_ERROR;
-
-    case YDEV_DMA_IOCTL_SET_CALLBACK:
-        return yDevDmaSetCallback(dma_handle, (const yDevDmaCallbackConfig_t *)arg);
+    }
+    else
+    {
+        start_time = yDevGetTimeMS();
+        while ((handle->busy != 0) &&
+               ((yDevGetTimeMS() - start_time) <= handle->base.timeOutMs))
+        {
+        }
+    }
 
-    case YDEV_DMA_IOCTL_CLEAR_ERRORS:
-        return yDevDmaClearErrors(dma_handle, *(uint32_t *)arg);
+    // 6. 超时则中止传输
+    primask = __get_PRIMASK();
+    __disable_irq();
+    flag_done = (handle->busy == 0) ? 1 : 0;
+    if (flag_done == 0)
+    {
+        yDrvDmaTransDisable(&handle->drv_handle);
+        handle->status = YDEV_TIMEOUT;
+        handle->stats.errors++;
+        handle->busy = 0;
+    }
+    handle->wait_task = NULL;
+    __set_PRIMASK(primask);
 
-    case YDEV_DMA_IOCTL_GET_ERRORS:
-        if (arg != NULL)
+    // 7. 完成通知之外的通知属于任务的其他等待者，归还一次
+    if (flag_wait != 0)
+    {
+        taken += ulTaskNotifyTake(pdTRUE, 0);
+        if (taken > flag_done)
         {
-            *(uint32_t *)arg = yDevDmaGetErrors(dma_handle);
-            return YDEV_OK;
+            xTaskNotifyGive(xTaskGetCurrentTaskHandle());
         }
-        return YDEV_ERROR;
-
-    default:
-        dma_handle->base.errno = YDEV_DMA_ERRNO_INVALID_PARAM;
-        return YDEV_ERROR;
     }
-}
 
-// ==================== 私有函数实现 ====================
+    return handle->status;
+}
 
-static void prv_DmaCompleteCallback(void *arg)
+/**
+ * @brief 窗口拷贝实现
+ */
+static yDevStatus_t yDev_Dma_WindowCopy(yDevHandle_Dma_t *handle, void *buffer, uint32_t size,
+                                        uint8_t flag_write, yDevDmaCallback_t callback, uint32_t *len)
 {
-    yDevHandle_Dma_t *handle = (yDevHandle_Dma_t *)arg;
+    yDevDmaCopy_t copy;
+    uint8_t *pos;
 
-    if (handle == NULL)
+    *len = 0;
+    if ((handle->window == NULL) || (buffer == NULL))
     {
-        return;
+        return YDEV_NOT_INITIALIZED;
     }
 
-    // 设置完成标志（这是正常的传输完成，不是错误）
-    dma_handle->errors |= YDEV_DMA_ERRNO_FULL_TRANSFER;
-    dma_handle->base.errno |= YDEV_DMA_ERRNO_FULL_TRANSFER;
-
-    // 设置设备状态为就绪
-    dma_handle->base.state = YDEV_STATE_READY;
-
-    // 调用用户回调
-    if (dma_handle->callbacks.complete_callback != NULL)
+    if (size > (handle->window_size - handle->offset))
     {
-        dma_handle->callbacks.complete_callback(dma_handle->callbacks.callback_arg);
+        size = handle->window_size - handle->offset;
     }
+    pos = &handle->window[handle->offset];
+    handle->offset += size;
+    *len = size;
+
+    copy.dst = (flag_write != 0) ? (void *)pos : buffer;
+    copy.src = (flag_write != 0) ? (const void *)buffer : (const void *)pos;
+    copy.len = size;
+    copy.callback = callback;
+    copy.arg = handle;
+
+    return yDev_Dma_Copy(handle, &copy);
 }
 
-static void prv_DmaHalfCompleteCallback(void *arg)
+/**
+ * @brief 异步读取完成回调实现
+ */
+static void yDev_Dma_ReadDone(void *arg, yDevStatus_t status)
 {
     yDevHandle_Dma_t *handle = (yDevHandle_Dma_t *)arg;
 
-    if (handle == NULL)
-    {
-        return;
-    }
-
-    // 设置半完成标志（这是正常的半传输完成，不是错误）
-    dma_handle->errors |= YDEV_DMA_ERRNO_HALF_TRANSFER;
-    dma_handle->base.errno |= YDEV_DMA_ERRNO_HALF_TRANSFER;
-
-    // 调用用户回调
-    if (dma_handle->callbacks.half_complete_callback != NULL)
-    {
-        dma_handle->callbacks.half_complete_callback(dma_handle->callbacks.callback_arg);
-    }
+    yDevAsyncComplete(handle, YDEV_ASYNC_READ, status,
+                      (status == YDEV_OK) ? handle->base.async[YDEV_ASYNC_READ].size : 0);
 }
 
-static void prv_DmaErrorCallback(void *arg)
+/**
+ * @brief 异步写入完成回调实现
+ */
+static void yDev_Dma_WriteDone(void *arg, yDevStatus_t status)
 {
     yDevHandle_Dma_t *handle = (yDevHandle_Dma_t *)arg;
 
-    if (handle == NULL)
-    {
-        return;
-    }
+    yDevAsyncComplete(handle, YDEV_ASYNC_WRITE, status,
+                      (status == YDEV_OK) ? handle->base.async[YDEV_ASYNC_WRITE].size : 0);
+}
 
-    // 设置错误标志
-    dma_handle->errors |= YDEV_DMA_ERRNO_TRANSFER_ERROR;
-    dma_handle->base.errno |= YDEV_DMA_ERRNO_TRANSFER_ERROR;
-    dma_handle->error_count++;
+/**
+ * @brief 测量拷贝耗时实现
+ */
+static uint32_t yDev_Dma_Measure(yDevHandle_Dma_t *handle, void *dst, const void *src,
+                                 uint32_t len, uint8_t flag_dma)
+{
+    uint32_t start;
+    uint32_t end;
+    uint32_t period;
 
-    // 设置设备状态为错误
-    dma_handle->base.state = YDEV_STATE_ERROR;
+    period = SysTick->LOAD + 1U;
+    start = SysTick->VAL;
 
-    // 调用用户回调
-    if (dma_handle->callbacks.error_callback != NULL)
+    if (flag_dma != 0)
     {
-        dma_handle->callbacks.error_callback(dma_handle->callbacks.callback_arg);
+        handle->dst = (uint8_t *)dst;
+        handle->src = (const uint8_t *)src;
+        handle->remain = len;
+        handle->shift = 2;
+        yDev_Dma_StartChunk(handle);
+        while (yDrvDmaIsTransComplete(&handle->drv_handle) == 0U)
+        {
+        }
+        yDrvDmaTransDisable(&handle->drv_handle);
+        yDrvDmaClearFlags(&handle->drv_handle);
     }
+    else
+    {
+        memcpy(dst, src, len);
+    }
+
+    end = SysTick->VAL;
+
+    // SysTick向下计数，测量区间不超过一个重装周期
+    return (start >= end) ? (start - end) : (start + period - end);
 }
 
-static yDevStatus_t prv_ValidateTransferConfig(const yDevDmaTransferConfig_t *config)
+/**
+ * @brief 实测交叉点实现
+ */
+static uint32_t yDev_Dma_Calibrate(yDevHandle_Dma_t *handle)
 {
-    // 检查地址是否为空
-    if (config->src_addr == 0 || config->dst_addr == 0)
+    uint32_t crossover = YDEV_DMA_CROSSOVER_DEFAULT;
+    uint32_t ctrl;
+    uint32_t load;
+    uint32_t primask;
+    uint32_t cpu;
+    uint32_t dma;
+    uint32_t len;
+    uint32_t *buffer;
+
+    buffer = (uint32_t *)YDEV_MALLOC(YDEV_DMA_CALIB_MAX * 2U);
+    if (buffer == NULL)
     {
-        return YDEV_ERROR;
+        return crossover;
     }
+    memset(buffer, 0x5A, YDEV_DMA_CALIB_MAX);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
 
-    // 检查数据长度
-    if (config->data_length == 0)
+    // 调度器启动前SysTick未运行，临时作为自由运行计数器
+    ctrl = SysTick->CTRL;
+    load = SysTick->LOAD;
+    if ((ctrl & SysTick_CTRL_ENABLE_Msk) == 0U)
     {
-        return YDEV_ERROR;
+        SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+        SysTick->VAL = 0;
+        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
     }
 
-    // 检查地址对齐
-    switch (config->src_width)
+    crossover = YDEV_DMA_CALIB_MAX;
+    for (len = YDEV_DMA_CALIB_MIN; len <= YDEV_DMA_CALIB_MAX; len <<= 1)
     {
-    case YDRV_DMA_WIDTH_16BIT:
-        if (config->src_addr % 2 != 0)
-            return YDEV_ERROR;
-        break;
-    case YDRV_DMA_WIDTH_32BIT:
-        if (config->src_addr % 4 != 0)
-            return YDEV_ERROR;
-        break;
-    default:
-        break;
+        cpu = yDev_Dma_Measure(handle, &buffer[YDEV_DMA_CALIB_MAX / 4U], buffer, len, 0);
+        dma = yDev_Dma_Measure(handle, &buffer[YDEV_DMA_CALIB_MAX / 4U], buffer, len, 1);
+        if (dma <= cpu)
+        {
+            crossover = len;
+            break;
+        }
     }
 
-    switch (config->dst_width)
+    if ((ctrl & SysTick_CTRL_ENABLE_Msk) == 0U)
     {
-    case YDRV_DMA_WIDTH_16BIT:
-        if (config->dst_addr % 2 != 0)
-            return YDEV_ERROR;
-        break;
-    case YDRV_DMA_WIDTH_32BIT:
-        if (config->dst_addr % 4 != 0)
-            return YDEV_ERROR;
-        break;
-    default:
-        break;
+        SysTick->CTRL = ctrl;
+        SysTick->LOAD = load;
+        SysTick->VAL = 0;
     }
 
-    return YDEV_OK;
+    __set_PRIMASK(primask);
+
+    YDEV_FREE(buffer);
+    return crossover;
 }
 
-// ==================== 扩展功能函数实现 ====================
+// ==================== yDev DMA设备操作函数 ====================
 
 /**
- * @brief 启动DMA传输
+ * @brief DMA拷贝设备初始化
+ * @param config DMA设备配置参数指针
  * @param handle DMA设备句柄指针
- * @param config 传输配置指针
- * @retval yDev状态
+ * @retval yDevStatus_t 初始化状态
+ * @retval YDEV_OK 初始化成功
+ * @retval YDEV_INVALID_PARAM 参数无效
+ * @retval YDEV_ERROR 初始化失败
+ * @note 依次分配内存到内存通道、实测交叉点、注册完成和错误中断
  */
-yDevStatus_t yDevDmaStartTransfer(yDevHandle_Dma_t *handle, const yDevDmaTransferConfig_t *config)
+static yDevStatus_t yDev_Dma_Init(void *config, void *handle)
 {
-    if (handle == NULL || config == NULL)
+    yDevConfig_Dma_t *dma_config;
+    yDevHandle_Dma_t *dma_handle;
+    yDrvDmaConfig_t drv_config;
+    yDrvDmaExtiConfig_t exti_config;
+
+    // 参数有效性检查
+    if ((config == NULL) || (handle == NULL))
     {
-        return YDEV_ERROR;
+        return YDEV_INVALID_PARAM;
     }
 
-    // 验证传输配置
-    if (prv_ValidateTransferConfig(config) != YDEV_OK)
+    dma_config = (yDevConfig_Dma_t *)config;
+    dma_handle = (yDevHandle_Dma_t *)handle;
+    if (dma_config->base.timeOutMs != 0)
     {
-        handle->base.errno = YDEV_DMA_ERRNO_INVALID_PARAM;
-        return YDEV_ERROR;
+        dma_handle->base.timeOutMs = dma_config->base.timeOutMs;
     }
 
-    // 检查设备状态
-    if (handle->base.state != YDEV_STATE_READY)
+    // 1. 内存到内存通道，源地址为外设端，目标地址为存储器端
+    drv_config = YDRV_DMA_CONFIG_DEFAULT();
+    drv_config.channel = dma_config->channel;
+    drv_config.request = YDRV_DMA_REQ_MEM2MEM;
+    drv_config.priority = dma_config->priority;
+    drv_config.src_width = YDRV_DMA_WIDTH_32BIT;
+    drv_config.dst_width = YDRV_DMA_WIDTH_32BIT;
+    drv_config.owner = "m2m";
+    if (yDrvDmaInitStatic(&drv_config, &dma_handle->drv_handle, YDRV_DMA_DIR_M2M) != YDRV_OK)
     {
-        handle->base.errno = YDEV_DMA_ERRNO_NOT_INIT;
+        dma_handle->base.errno = YDEV_ERRNO_NOT_INIT;
         return YDEV_ERROR;
     }
 
-    // 设置设备为忙碌状态
-    handle->base.state = YDEV_STATE_BUSY;
+    dma_handle->busy = 0;
+    dma_handle->status = YDEV_OK;
+    dma_handle->callback = NULL;
+    dma_handle->wait_task = NULL;
+    dma_handle->window = NULL;
+    dma_handle->window_size = 0;
+    dma_handle->offset = 0;
+    memset(&dma_handle->stats, 0, sizeof(dma_handle->stats));
 
-    // TODO: 调用底层驱动启动传输
-    // yDrvStatus_t drv_status = yDrvDmaStartTransfer(&handle->drv_handle, config);
+    // 2. 交叉点
+    dma_handle->crossover = (dma_config->crossover != 0) ? dma_config->crossover
+                                                         : yDev_Dma_Calibrate(dma_handle);
 
-    return YDEV_OK;
-}
+    // 3. 完成和错误中断驱动分段续传
+    exti_config = YDRV_DMA_EXTI_CONFIG_DEFAULT();
+    exti_config.prio = dma_config->prio;
+    exti_config.arg = dma_handle;
+    exti_config.enable = 1;
 
-/**
- * @brief 停止DMA传输
- * @param handle DMA设备句柄指针
- * @retval yDev状态
- */
-yDevStatus_t yDevDmaStopTransfer(yDevHandle_Dma_t *handle)
-{
-    if (handle == NULL)
+    exti_config.trigger = YDRV_DMA_EXTI_TC;
+    exti_config.function = yDev_Dma_CompleteIrq;
+    if (yDrvDmaRegisterCallback(&dma_handle->drv_handle, &exti_config) != YDRV_OK)
     {
+        yDrvDmaDeInitStatic(&dma_handle->drv_handle);
+        return YDEV_ERROR;
+    }
+    exti_config.trigger = YDRV_DMA_EXTI_TE;
+    exti_config.function = yDev_Dma_ErrorIrq;
+    if (yDrvDmaRegisterCallback(&dma_handle->drv_handle, &exti_config) != YDRV_OK)
+    {
+        yDrvDmaDeInitStatic(&dma_handle->drv_handle);
         return YDEV_ERROR;
     }
 
-    // TODO: 调用底层驱动停止传输
-    // yDrvDmaStopTransfer(&handle->drv_handle);
-
-    // 设置设备状态为就绪
-    handle->base.state = YDEV_STATE_READY;
+    if (dma_default == NULL)
+    {
+        dma_default = dma_handle;
+    }
 
     return YDEV_OK;
 }
 
 /**
- * @brief 暂停DMA传输
+ * @brief DMA拷贝设备反初始化
  * @param handle DMA设备句柄指针
- * @retval yDev状态
+ * @retval yDevStatus_t 操作状态
+ * @note 未完成的拷贝被中止，不调用完成回调
  */
-yDevStatus_t yDevDmaPauseTransfer(yDevHandle_Dma_t *handle)
+static yDevStatus_t yDev_Dma_Deinit(void *handle)
 {
+    yDevHandle_Dma_t *dma_handle;
+
+    // 参数有效性检查
     if (handle == NULL)
     {
+        return YDEV_INVALID_PARAM;
+    }
+
+    dma_handle = (yDevHandle_Dma_t *)handle;
+
+    if (dma_default == dma_handle)
+    {
+        dma_default = NULL;
+    }
+
+    if (yDrvDmaDeInitStatic(&dma_handle->drv_handle) != YDRV_OK)
+    {
+        dma_handle->base.errno = YDEV_ERRNO_NOT_DEINIT;
         return YDEV_ERROR;
     }
+    dma_handle->busy = 0;
+    dma_handle->callback = NULL;
 
-    // TODO: 调用底层驱动暂停传输
-    // yDrvDmaPauseTransfer(&handle->drv_handle);
+    // 被中止的异步读写按失败结束，避免等待任务永久阻塞
+    yDevAsyncComplete(dma_handle, YDEV_ASYNC_READ, YDEV_ERROR, 0);
+    yDevAsyncComplete(dma_handle, YDEV_ASYNC_WRITE, YDEV_ERROR, 0);
 
     return YDEV_OK;
 }
 
 /**
- * @brief 恢复DMA传输
+ * @brief DMA设备读取操作
  * @param handle DMA设备句柄指针
- * @retval yDev状态
+ * @param buffer 读取缓冲区
+ * @param size 读取大小
+ * @retval int32_t 实际读取的字节数，-1表示错误
+ * @note 从读写窗口的当前位置拷贝，阻塞到拷贝完成
  */
-yDevStatus_t yDevDmaResumeTransfer(yDevHandle_Dma_t *handle)
+static int32_t yDev_Dma_Read(void *handle, void *buffer, size_t size)
 {
-    if (handle == NULL)
+    uint32_t len;
+
+    if (yDev_Dma_WindowCopy((yDevHandle_Dma_t *)handle, buffer, size, 0, NULL, &len) != YDEV_OK)
     {
-        return YDEV_ERROR;
+        return -1;
     }
-
-    // TODO: 调用底层驱动恢复传输
-    // yDrvDmaResumeTransfer(&handle->drv_handle);
-
-    return YDEV_OK;
+    return (int32_t)len;
 }
 
 /**
- * @brief 获取DMA传输状态
+ * @brief DMA设备写入操作
  * @param handle DMA设备句柄指针
- * @param status 状态输出指针
- * @retval yDev状态
+ * @param buffer 写入缓冲区
+ * @param size 写入大小
+ * @retval int32_t 实际写入的字节数，-1表示错误
+ * @note 拷贝到读写窗口的当前位置，阻塞到拷贝完成
  */
-yDevStatus_t yDevDmaGetStatus(yDevHandle_Dma_t *handle, yDevDmaStatus_t *status)
+static int32_t yDev_Dma_Write(void *handle, const void *buffer, size_t size)
 {
-    if (handle == NULL || status == NULL)
+    uint32_t len;
+
+    if (yDev_Dma_WindowCopy((yDevHandle_Dma_t *)handle, (void *)buffer, size, 1, NULL, &len) != YDEV_OK)
     {
-        return YDEV_ERROR;
+        return -1;
     }
-
-    // TODO: 从底层驱动获取状态
-    // *status = yDrvDmaGetStatus(&handle->drv_handle);
-
-    return YDEV_OK;
+    return (int32_t)len;
 }
 
 /**
- * @brief 获取DMA剩余传输数量
+ * @brief DMA设备异步读取操作
  * @param handle DMA设备句柄指针
- * @retval 剩余传输数量
+ * @param buffer 读取缓冲区
+ * @param size 读取大小，不得超出窗口剩余长度
+ * @retval yDevStatus_t 启动状态
+ * @note 引擎忙或拷贝短于交叉点时由CPU拷贝，返回前即已完成
  */
-uint32_t yDevDmaGetRemainingCount(yDevHandle_Dma_t *handle)
+static yDevStatus_t yDev_Dma_ReadAsync(void *handle, void *buffer, size_t size)
 {
-    if (handle == NULL)
+    yDevHandle_Dma_t *dma_handle = (yDevHandle_Dma_t *)handle;
+    uint32_t len;
+
+    if ((dma_handle->window != NULL) && (size > (dma_handle->window_size - dma_handle->offset)))
     {
-        return 0;
+        return YDEV_INVALID_PARAM;
     }
-
-    // TODO: 从底层驱动获取剩余传输数量
-    // return yDrvDmaGetRemainingCount(&handle->drv_handle);
-
-    return 0;
+    return yDev_Dma_WindowCopy(dma_handle, buffer, size, 0, yDev_Dma_ReadDone, &len);
 }
 
 /**
- * @brief 设置DMA回调函数
+ * @brief DMA设备异步写入操作
  * @param handle DMA设备句柄指针
- * @param callbacks 回调函数配置指针
- * @retval yDev状态
+ * @param buffer 写入缓冲区
+ * @param size 写入大小，不得超出窗口剩余长度
+ * @retval yDevStatus_t 启动状态
+ * @note 引擎忙或拷贝短于交叉点时由CPU拷贝，返回前即已完成
  */
-yDevStatus_t yDevDmaSetCallback(yDevHandle_Dma_t *handle, const yDevDmaCallbackConfig_t *callbacks)
+static yDevStatus_t yDev_Dma_WriteAsync(void *handle, const void *buffer, size_t size)
 {
-    if (handle == NULL || callbacks == NULL)
+    yDevHandle_Dma_t *dma_handle = (yDevHandle_Dma_t *)handle;
+    uint32_t len;
+
+    if ((dma_handle->window != NULL) && (size > (dma_handle->window_size - dma_handle->offset)))
     {
-        return YDEV_ERROR;
+        return YDEV_INVALID_PARAM;
     }
-
-    // 复制回调函数配置
-    memcpy(&handle->callbacks, callbacks, sizeof(yDevDmaCallbackConfig_t));
-
-    return YDEV_OK;
+    return yDev_Dma_WindowCopy(dma_handle, (void *)buffer, size, 1, yDev_Dma_WriteDone, &len);
 }
 
 /**
- * @brief 清除DMA错误标志
+ * @brief DMA拷贝设备控制操作
  * @param handle DMA设备句柄指针
- * @param error_mask 错误掩码
- * @retval yDev状态
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @retval yDevStatus_t 操作状态
  */
-yDevStatus_t yDevDmaClearErrors(yDevHandle_Dma_t *handle, uint32_t error_mask)
+static yDevStatus_t yDev_Dma_Ioctl(void *handle, uint32_t cmd, void *arg)
 {
-    if (handle == NULL)
+    yDevHandle_Dma_t *dma_handle;
+
+    if ((handle == NULL) || (arg == NULL))
     {
-        return YDEV_ERROR;
+        return YDEV_INVALID_PARAM;
     }
 
-    // 清除指定的错误标志
-    handle->errors &= ~error_mask;
-    handle->base.errno &= ~error_mask;
+    dma_handle = (yDevHandle_Dma_t *)handle;
 
-    // 如果没有错误了，恢复设备状态
-    if (handle->errors == YDEV_DMA_ERRNO_NONE)
+    switch (cmd)
     {
-        if (handle->base.state == YDEV_STATE_ERROR)
+    case YDEV_DMA_IOCTL_COPY:
+        return yDev_Dma_Copy(dma_handle, (const yDevDmaCopy_t *)arg);
+    case YDEV_DMA_IOCTL_IS_BUSY:
+        *(uint32_t *)arg = dma_handle->busy;
+        return YDEV_OK;
+    case YDEV_DMA_IOCTL_GET_CROSSOVER:
+        *(uint32_t *)arg = dma_handle->crossover;
+        return YDEV_OK;
+    case YDEV_DMA_IOCTL_SET_CROSSOVER:
+        dma_handle->crossover = *(const uint32_t *)arg;
+        return YDEV_OK;
+    case YDEV_DMA_IOCTL_GET_STATS:
+        *(yDevDmaStats_t *)arg = dma_handle->stats;
+        return YDEV_OK;
+    case YDEV_DMA_IOCTL_SET_WINDOW:
+        if (dma_handle->busy != 0)
         {
-            handle->base.state = YDEV_STATE_READY;
+            return YDEV_BUSY;
         }
+        dma_handle->window = (uint8_t *)((const yDevDmaWindow_t *)arg)->base;
+        dma_handle->window_size = (dma_handle->window != NULL) ? ((const yDevDmaWindow_t *)arg)->size : 0;
+        dma_handle->offset = 0;
+        return YDEV_OK;
+    case YDEV_DMA_IOCTL_SEEK:
+        if (*(const uint32_t *)arg > dma_handle->window_size)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        dma_handle->offset = *(const uint32_t *)arg;
+        return YDEV_OK;
+    default:
+        return YDEV_NOT_SUPPORTED;
     }
-
-    return YDEV_OK;
 }
 
+// ==================== 公共API实现 ====================
+
 /**
- * @brief 获取DMA错误标志
- * @param handle DMA设备句柄指针
- * @retval 错误标志
+ * @brief 使用默认DMA引擎拷贝内存实现
  */
-uint32_t yDevDmaGetErrors(yDevHandle_Dma_t *handle)
+yDevStatus_t yDevDmaMemcpy(void *dst, const void *src, uint32_t len,
+                           yDevDmaCallback_t callback, void *arg)
 {
-    if (handle == NULL)
+    yDevDmaCopy_t copy = {
+        .dst = dst,
+        .src = src,
+        .len = len,
+        .callback = callback,
+        .arg = arg,
+    };
+
+    if (dma_default == NULL)
     {
-        return YDEV_DMA_ERRNO_INVALID_PARAM;
+        if ((dst == NULL) || (src == NULL))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        return yDev_Dma_CpuCopy(NULL, &copy);
     }
 
-    return handle->errors;
-}
\ No newline at end of file
+    return yDev_Dma_Copy(dma_default, &copy);
+}
+
+YDEV_OPS_EXPORT_ASYNC(
+    YDEV_TYPE_DMA,       // 设备类型
+    yDev_Dma_Init,       // 初始化函数
+    yDev_Dma_Deinit,     // 反初始化函数
+    yDev_Dma_Read,       // 读取函数
+    yDev_Dma_Write,      // 写入函数
+    yDev_Dma_Ioctl,      // 控制函数
+    yDev_Dma_ReadAsync,  // 异步读取函数
+    yDev_Dma_WriteAsync) // 异步写入函数
@@ -0,0 +1,1658 @@
+/**
+ * @file yDev_fs.c
+ * @brief 基于25Q Flash的掉电安全文件系统实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 文件由元数据对中的文件记录描述(文件名、大小、数据块号数组)，同名的后一条记录覆盖前一条，
+ * RAM目录索引保存每个文件最新记录的地址；打开的文件在RAM中维护自己的块数组和大小，
+ * 提交时整条追加，提交之前Flash上的旧记录和旧数据块保持不变
+ *
+ * @par 实现说明:
+ * - 在文件末尾追加时直接编程末块的擦除区域，末块擦除状态未知(挂载后首次追加)时先检查，
+ *   不是全0xFF则复制到新块；改写已有数据总是复制整块到新块
+ * - 旧块在提交后才不被任何记录引用，预读位图重建时只标记目录索引和打开文件引用的块，
+ *   两次提交之间被替换的块不会被提前分配
+ * - 元数据块写满时把索引中的记录复制到另一块，最后写扇区头；压缩失败时重新扫描原块
+ * - 挂载扫描遇到写坏的记录或记录之后不是擦除状态时立即压缩，之后的追加只在擦除区进行
+ *
+ * @par 使用说明:
+ * - 文件系统接口和文件读写由每个文件系统的互斥锁串行化
+ * - 同一文件同时只能打开一次
+ * - 元数据对固定在存储区前两块，每次压缩擦除其中一块，擦除次数约为提交数除以每块可容纳的记录数
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_fs.h"
+#include "yDev_def.h"
+#include "yLib_crc.h"
+#include <stddef.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "os_static.h"
+
+// ==================== 私有宏定义 ====================
+#define YDEV_FS_FLAG_DELETED (0x01U)     /*!< 记录标志: 删除 */
+#define YDEV_FS_CACHE_DEFAULT (256U)     /*!< 默认缓存大小 */
+#define YDEV_FS_LOOKAHEAD_DEFAULT (32U)  /*!< 默认预读窗口块数 */
+#define YDEV_FS_FILES_DEFAULT (16U)      /*!< 默认最多文件数 */
+#define YDEV_FS_OPEN_DEFAULT (2U)        /*!< 默认最多打开文件数 */
+#define YDEV_FS_ADDRESS_NONE (0xFFFFFFFFUL) /*!< 读缓存无效 */
+
+/**
+ * @brief 文件记录按4字节对齐后的总长度
+ */
+#define YDEV_FS_RECORD_SIZE(nameLen, nblocks) \
+    ((YDEV_FS_RECORD_HEADER_SIZE + (((uint32_t)(nameLen) + 1U) & ~1U) + 2U * (uint32_t)(nblocks) + 3U) & ~3U)
+
+/**
+ * @brief 文件记录中块号数组的偏移
+ */
+#define YDEV_FS_RECORD_BLOCKS(nameLen) (YDEV_FS_RECORD_HEADER_SIZE + (((uint32_t)(nameLen) + 1U) & ~1U))
+
+#define YDEV_FS_RECORD_MAX YDEV_FS_RECORD_SIZE(YDEV_FS_NAME_MAX, YDEV_FS_FILE_BLOCKS) /*!< 最长文件记录 */
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 元数据扇区头结构(Flash布局)
+ */
+typedef struct
+{
+    uint32_t magic;       /*!< YDEV_FS_SUPER_MAGIC */
+    uint32_t rev;         /*!< 元数据版本，越大越新 */
+    uint32_t reserved[2]; /*!< 保留，保持擦除值0xFF */
+} yDevFsSuper_t;
+
+/**
+ * @brief 文件记录头结构(Flash布局)
+ */
+typedef struct
+{
+    uint16_t magic;   /*!< YDEV_FS_RECORD_MAGIC，0xFFFF表示剩余空间未写入 */
+    uint8_t nameLen;  /*!< 文件名长度 */
+    uint8_t flags;    /*!< 记录标志 */
+    uint16_t nblocks; /*!< 数据块数 */
+    uint16_t crc;     /*!< 除本字段外整条记录(不含对齐填充)的CRC16-CCITT */
+    uint32_t size;    /*!< 文件大小 */
+} yDevFsRecordHeader_t;
+
+/**
+ * @brief 文件记录缓冲区，按最长记录分配
+ */
+typedef union
+{
+    yDevFsRecordHeader_t header;
+    uint8_t raw[YDEV_FS_RECORD_MAX];
+} yDevFsRecord_t;
+
+_Static_assert(sizeof(yDevFsSuper_t) == YDEV_FS_SUPER_SIZE, "super header layout");
+_Static_assert(sizeof(yDevFsRecordHeader_t) == YDEV_FS_RECORD_HEADER_SIZE, "record header layout");
+
+// ==================== 私有变量 ====================
+
+/**
+ * @brief 文件系统互斥锁，按文件系统占用槽位
+ */
+OS_MUTEX_POOL_DEFINE(ydev_fs_mutex, YDEV_FS_MAX);
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 计算文件名的FNV-1a哈希
+ */
+static uint32_t yDevFs_Hash(const char *name, uint32_t len)
+{
+    uint32_t hash = 2166136261UL;
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * @brief 块起始地址
+ */
+static uint32_t yDevFs_BlockAddress(yDevFs_t *fs, uint16_t block)
+{
+    return fs->baseAddress + (uint32_t)block * YDEV_FS_BLOCK_SIZE;
+}
+
+/**
+ * @brief 经读缓存读取
+ * @note 对齐的整行直接读取，不占用缓存
+ */
+static yDevStatus_t yDevFs_Read(yDevFs_t *fs, uint32_t address, void *buffer, uint32_t size)
+{
+    uint8_t *out = (uint8_t *)buffer;
+    uint32_t line;
+    uint32_t offset;
+    uint32_t chunk;
+
+    while (size > 0)
+    {
+        line = address & ~((uint32_t)fs->cacheSize - 1U);
+        offset = address - line;
+
+        if ((fs->rcacheAddress != line) && (offset == 0U) && (size >= fs->cacheSize))
+        {
+            chunk = size & ~((uint32_t)fs->cacheSize - 1U);
+            if (yDev25qRead(fs->flash, address, out, chunk) != (int32_t)chunk)
+            {
+                return YDEV_ERROR;
+            }
+        }
+        else
+        {
+            if (fs->rcacheAddress != line)
+            {
+                fs->rcacheAddress = YDEV_FS_ADDRESS_NONE;
+                if (yDev25qRead(fs->flash, line, fs->rcache, fs->cacheSize) != (int32_t)fs->cacheSize)
+                {
+                    return YDEV_ERROR;
+                }
+                fs->rcacheAddress = line;
+                fs->stats.cacheMisses++;
+            }
+            else
+            {
+                fs->stats.cacheHits++;
+            }
+            chunk = fs->cacheSize - offset;
+            if (chunk > size)
+            {
+                chunk = size;
+            }
+            memcpy(out, fs->rcache + offset, chunk);
+        }
+
+        out += chunk;
+        address += chunk;
+        size -= chunk;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 读缓存与写入范围重叠时作废
+ */
+static void yDevFs_Invalidate(yDevFs_t *fs, uint32_t address, uint32_t size)
+{
+    if ((fs->rcacheAddress != YDEV_FS_ADDRESS_NONE) &&
+        (fs->rcacheAddress < address + size) && (address < fs->rcacheAddress + fs->cacheSize))
+    {
+        fs->rcacheAddress = YDEV_FS_ADDRESS_NONE;
+    }
+}
+
+/**
+ * @brief 编程已擦除区域
+ */
+static yDevStatus_t yDevFs_Program(yDevFs_t *fs, uint32_t address, const void *data, uint32_t size)
+{
+    yDevFs_Invalidate(fs, address, size);
+    fs->flash->address = address;
+    if (yDevWrite(fs->flash, data, size) != (int32_t)size)
+    {
+        return YDEV_ERROR;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 同步擦除一块
+ */
+static yDevStatus_t yDevFs_Erase(yDevFs_t *fs, uint16_t block)
+{
+    uint32_t address = yDevFs_BlockAddress(fs, block);
+
+    yDevFs_Invalidate(fs, address, YDEV_FS_BLOCK_SIZE);
+    if (yDevIoctl(fs->flash, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+    fs->stats.erases++;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 检查一段Flash是否为擦除状态
+ * @param buffer 临时缓冲区，cacheSize字节
+ * @retval int32_t 1全为0xFF，0不是，-1读取失败
+ */
+static int32_t yDevFs_IsErased(yDevFs_t *fs, uint32_t address, uint32_t size, uint8_t *buffer)
+{
+    uint32_t chunk;
+    uint32_t i;
+
+    while (size > 0)
+    {
+        chunk = (size > fs->cacheSize) ? fs->cacheSize : size;
+        if (yDev25qRead(fs->flash, address, buffer, chunk) != (int32_t)chunk)
+        {
+            return -1;
+        }
+        for (i = 0; i < chunk; i++)
+        {
+            if (buffer[i] != 0xFFU)
+            {
+                return 0;
+            }
+        }
+        address += chunk;
+        size -= chunk;
+    }
+    return 1;
+}
+
+/**
+ * @brief 计算记录CRC，跳过CRC字段和对齐填充
+ */
+static uint16_t yDevFs_RecordCrc(const yDevFsRecord_t *record)
+{
+    uint32_t end = YDEV_FS_RECORD_BLOCKS(record->header.nameLen) + 2U * (uint32_t)record->header.nblocks;
+    uint16_t crc;
+
+    crc = ylib_crc16(YLIB_CRC16_INIT, record->raw, offsetof(yDevFsRecordHeader_t, crc));
+    return ylib_crc16(crc, &record->raw[offsetof(yDevFsRecordHeader_t, size)],
+                      end - offsetof(yDevFsRecordHeader_t, size));
+}
+
+/**
+ * @brief 记录中的块号数组
+ */
+static const uint16_t *yDevFs_RecordBlocks(const yDevFsRecord_t *record)
+{
+    return (const uint16_t *)(const void *)&record->raw[YDEV_FS_RECORD_BLOCKS(record->header.nameLen)];
+}
+
+/**
+ * @brief 读取并校验记录
+ * @retval int32_t 1有效记录，0擦除状态，-1损坏或读取失败
+ */
+static int32_t yDevFs_ReadRecord(yDevFs_t *fs, uint32_t address, uint32_t limit, yDevFsRecord_t *record)
+{
+    yDevFsRecordHeader_t *header = &record->header;
+    const uint16_t *blocks;
+    uint32_t size;
+    uint16_t i;
+
+    if ((address + YDEV_FS_RECORD_HEADER_SIZE) > limit)
+    {
+        return 0;
+    }
+    if (yDevFs_Read(fs, address, header, YDEV_FS_RECORD_HEADER_SIZE) != YDEV_OK)
+    {
+        return -1;
+    }
+    if ((header->magic == 0xFFFFU) && (header->nameLen == 0xFFU) && (header->flags == 0xFFU) &&
+        (header->nblocks == 0xFFFFU) && (header->crc == 0xFFFFU) && (header->size == 0xFFFFFFFFUL))
+    {
+        return 0;
+    }
+    if ((header->magic != YDEV_FS_RECORD_MAGIC) || (header->nameLen == 0U) ||
+        (header->nameLen > YDEV_FS_NAME_MAX) || (header->nblocks > YDEV_FS_FILE_BLOCKS))
+    {
+        return -1;
+    }
+    size = YDEV_FS_RECORD_SIZE(header->nameLen, header->nblocks);
+    if ((address + size) > limit)
+    {
+        return -1;
+    }
+    if (yDevFs_Read(fs, address + YDEV_FS_RECORD_HEADER_SIZE, &record->raw[YDEV_FS_RECORD_HEADER_SIZE],
+                    size - YDEV_FS_RECORD_HEADER_SIZE) != YDEV_OK)
+    {
+        return -1;
+    }
+    if (yDevFs_RecordCrc(record) != header->crc)
+    {
+        return -1;
+    }
+
+    // CRC正确但内容越界的记录按损坏处理，不能让它的块号进入分配器
+    if ((header->size > (uint32_t)header->nblocks * YDEV_FS_BLOCK_SIZE) ||
+        ((header->nblocks > 0U) && (header->size <= ((uint32_t)header->nblocks - 1U) * YDEV_FS_BLOCK_SIZE) &&
+         ((header->flags & YDEV_FS_FLAG_DELETED) == 0U)))
+    {
+        return -1;
+    }
+    blocks = yDevFs_RecordBlocks(record);
+    for (i = 0; i < header->nblocks; i++)
+    {
+        if ((blocks[i] < YDEV_FS_META_BLOCKS) || (blocks[i] >= fs->blockCount))
+        {
+            return -1;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 按文件名查找目录索引
+ * @retval int32_t 索引序号，-1不存在
+ */
+static int32_t yDevFs_Find(yDevFs_t *fs, const char *name, uint8_t nameLen)
+{
+    yDevFsRecordHeader_t header;
+    char stored[YDEV_FS_NAME_MAX];
+    uint32_t hash = yDevFs_Hash(name, nameLen);
+    uint16_t i;
+
+    for (i = 0; i < fs->files; i++)
+    {
+        if (fs->entry[i].hash != hash)
+        {
+            continue;
+        }
+        if ((yDevFs_Read(fs, fs->entry[i].address, &header, sizeof(header)) != YDEV_OK) ||
+            (header.nameLen != nameLen) ||
+            (yDevFs_Read(fs, fs->entry[i].address + YDEV_FS_RECORD_HEADER_SIZE, stored, nameLen) != YDEV_OK))
+        {
+            continue;
+        }
+        if (memcmp(stored, name, nameLen) == 0)
+        {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 更新目录索引
+ * @param deleted 1删除该文件，0插入或更新
+ */
+static yDevStatus_t yDevFs_IndexUpdate(yDevFs_t *fs, const char *name, uint8_t nameLen, uint32_t address,
+                                       uint8_t deleted)
+{
+    int32_t index = yDevFs_Find(fs, name, nameLen);
+
+    if (index >= 0)
+    {
+        if (deleted != 0U)
+        {
+            // 末项前移填补，索引顺序不重要
+            fs->files--;
+            fs->entry[index] = fs->entry[fs->files];
+        }
+        else
+        {
+            fs->entry[index].address = address;
+        }
+        return YDEV_OK;
+    }
+    if (deleted != 0U)
+    {
+        return YDEV_OK;
+    }
+    if (fs->files >= fs->filesMax)
+    {
+        return YDEV_NO_MEMORY;
+    }
+    fs->entry[fs->files].hash = yDevFs_Hash(name, nameLen);
+    fs->entry[fs->files].address = address;
+    fs->files++;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 扫描元数据块重建目录索引
+ * @param torn 输出，1表示末尾有写坏的记录或未擦净的空间
+ */
+static yDevStatus_t yDevFs_Scan(yDevFs_t *fs, uint8_t *torn)
+{
+    yDevFsRecord_t record;
+    uint32_t start = yDevFs_BlockAddress(fs, fs->metaBlock);
+    uint32_t limit = start + YDEV_FS_BLOCK_SIZE;
+    uint32_t address = start + YDEV_FS_SUPER_SIZE;
+    uint32_t tail;
+    yDevStatus_t status;
+    int32_t result;
+
+    fs->files = 0;
+    *torn = 0;
+    while (1)
+    {
+        result = yDevFs_ReadRecord(fs, address, limit, &record);
+        if (result == 0)
+        {
+            // 记录头读到擦除值时，写到一半的记录可能在同一页的后面留下了已编程的字节
+            tail = limit - address;
+            if (tail > YDEV_FS_RECORD_MAX)
+            {
+                tail = YDEV_FS_RECORD_MAX;
+            }
+            if (yDevFs_IsErased(fs, address, tail, record.raw) != 1)
+            {
+                *torn = 1;
+            }
+            break;
+        }
+        if (result < 0)
+        {
+            *torn = 1;
+            break;
+        }
+        status = yDevFs_IndexUpdate(fs, (const char *)&record.raw[YDEV_FS_RECORD_HEADER_SIZE],
+                                    record.header.nameLen, address,
+                                    (record.header.flags & YDEV_FS_FLAG_DELETED) ? 1U : 0U);
+        if (status != YDEV_OK)
+        {
+            return status;
+        }
+        address += YDEV_FS_RECORD_SIZE(record.header.nameLen, record.header.nblocks);
+    }
+
+    fs->metaUsed = address - start;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 把目录索引中的记录压缩到另一个元数据块
+ * @note 新块的扇区头最后写入；失败时重新扫描原块恢复索引
+ */
+static yDevStatus_t yDevFs_Compact(yDevFs_t *fs)
+{
+    yDevFsRecord_t record;
+    yDevFsSuper_t super;
+    uint8_t target = (uint8_t)(fs->metaBlock ^ 1U);
+    uint32_t start = yDevFs_BlockAddress(fs, target);
+    uint32_t limit = yDevFs_BlockAddress(fs, fs->metaBlock) + YDEV_FS_BLOCK_SIZE;
+    uint32_t offset = YDEV_FS_SUPER_SIZE;
+    uint32_t size;
+    uint8_t torn;
+    uint16_t i;
+
+    if (yDevFs_Erase(fs, target) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    for (i = 0; i < fs->files; i++)
+    {
+        if (yDevFs_ReadRecord(fs, fs->entry[i].address, limit, &record) != 1)
+        {
+            break;
+        }
+        size = YDEV_FS_RECORD_SIZE(record.header.nameLen, record.header.nblocks);
+        if (yDevFs_Program(fs, start + offset, record.raw, size) != YDEV_OK)
+        {
+            break;
+        }
+        fs->entry[i].address = start + offset;
+        offset += size;
+    }
+
+    super.magic = YDEV_FS_SUPER_MAGIC;
+    super.rev = fs->rev + 1U;
+    super.reserved[0] = 0xFFFFFFFFUL;
+    super.reserved[1] = 0xFFFFFFFFUL;
+    if ((i != fs->files) || (yDevFs_Program(fs, start, &super, sizeof(super)) != YDEV_OK))
+    {
+        (void)yDevFs_Scan(fs, &torn);
+        fs->metaUsed = YDEV_FS_BLOCK_SIZE; // 原块不再追加，下次提交重试压缩
+        return YDEV_ERROR;
+    }
+
+    fs->metaBlock = target;
+    fs->rev = super.rev;
+    fs->metaUsed = offset;
+    fs->stats.compactions++;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 追加一条记录到当前元数据块
+ * @param address 输出记录地址
+ */
+static yDevStatus_t yDevFs_Append(yDevFs_t *fs, const yDevFsRecord_t *record, uint32_t *address)
+{
+    uint32_t size = YDEV_FS_RECORD_SIZE(record->header.nameLen, record->header.nblocks);
+
+    if ((fs->metaUsed + size) > YDEV_FS_BLOCK_SIZE)
+    {
+        if (yDevFs_Compact(fs) != YDEV_OK)
+        {
+            return YDEV_ERROR;
+        }
+        if ((fs->metaUsed + size) > YDEV_FS_BLOCK_SIZE)
+        {
+            return YDEV_NO_MEMORY;
+        }
+    }
+
+    *address = yDevFs_BlockAddress(fs, fs->metaBlock) + fs->metaUsed;
+    if (yDevFs_Program(fs, *address, record->raw, size) != YDEV_OK)
+    {
+        // 写了一半的记录后面不能再追加
+        fs->metaUsed = YDEV_FS_BLOCK_SIZE;
+        return YDEV_ERROR;
+    }
+    fs->metaUsed += size;
+    fs->stats.commits++;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 组装文件记录
+ */
+static void yDevFs_RecordBuild(yDevFsRecord_t *record, const char *name, uint8_t nameLen, uint8_t flags,
+                               uint32_t size, const uint16_t *blocks, uint16_t nblocks)
+{
+    uint32_t total = YDEV_FS_RECORD_SIZE(nameLen, nblocks);
+
+    memset(record->raw, 0xFF, total);
+    record->header.magic = YDEV_FS_RECORD_MAGIC;
+    record->header.nameLen = nameLen;
+    record->header.flags = flags;
+    record->header.nblocks = nblocks;
+    record->header.size = size;
+    memcpy(&record->raw[YDEV_FS_RECORD_HEADER_SIZE], name, nameLen);
+    if (nblocks > 0U)
+    {
+        memcpy(&record->raw[YDEV_FS_RECORD_BLOCKS(nameLen)], blocks, 2U * (uint32_t)nblocks);
+    }
+    record->header.crc = yDevFs_RecordCrc(record);
+}
+
+/**
+ * @brief 在预读位图中标记一个块
+ */
+static void yDevFs_Mark(yDevFs_t *fs, uint16_t block)
+{
+    uint16_t dataCount = (uint16_t)(fs->blockCount - YDEV_FS_META_BLOCKS);
+    uint32_t rel;
+
+    rel = ((uint32_t)block - YDEV_FS_META_BLOCKS + dataCount - fs->allocStart) % dataCount;
+    if (rel < fs->lookahead)
+    {
+        fs->lookaheadMap[rel / 32U] |= 1UL << (rel % 32U);
+    }
+}
+
+/**
+ * @brief 重建预读位图
+ * @note 标记已提交记录和打开文件引用的全部块
+ */
+static yDevStatus_t yDevFs_Rebuild(yDevFs_t *fs)
+{
+    yDevFsRecord_t record;
+    yDevHandle_File_t *file;
+    const uint16_t *blocks;
+    uint32_t limit = yDevFs_BlockAddress(fs, fs->metaBlock) + YDEV_FS_BLOCK_SIZE;
+    uint16_t i;
+    uint16_t j;
+
+    memset(fs->lookaheadMap, 0, fs->lookahead / 8U);
+    for (i = 0; i < fs->files; i++)
+    {
+        if (yDevFs_ReadRecord(fs, fs->entry[i].address, limit, &record) != 1)
+        {
+            return YDEV_ERROR;
+        }
+        blocks = yDevFs_RecordBlocks(&record);
+        for (j = 0; j < record.header.nblocks; j++)
+        {
+            yDevFs_Mark(fs, blocks[j]);
+        }
+    }
+    for (file = fs->open; file != NULL; file = file->next)
+    {
+        for (j = 0; j < file->nblocks; j++)
+        {
+            yDevFs_Mark(fs, file->block[j]);
+        }
+    }
+    fs->stats.scans++;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 分配并擦除一个数据块
+ * @retval yDevStatus_t YDEV_NO_MEMORY表示没有空闲块
+ */
+static yDevStatus_t yDevFs_Alloc(yDevFs_t *fs, uint16_t *block)
+{
+    uint16_t dataCount = (uint16_t)(fs->blockCount - YDEV_FS_META_BLOCKS);
+    uint16_t window = (fs->lookahead < dataCount) ? fs->lookahead : dataCount;
+    uint16_t rel;
+
+    while (1)
+    {
+        while (fs->allocOffset < window)
+        {
+            rel = fs->allocOffset++;
+            fs->allocSeen++;
+            if ((fs->lookaheadMap[rel / 32U] & (1UL << (rel % 32U))) == 0U)
+            {
+                fs->lookaheadMap[rel / 32U] |= 1UL << (rel % 32U);
+                fs->allocSeen = 0;
+                *block = (uint16_t)(YDEV_FS_META_BLOCKS + (fs->allocStart + rel) % dataCount);
+                return yDevFs_Erase(fs, *block);
+            }
+        }
+
+        // 整个存储区都看过一遍仍没有空闲块
+        if (fs->allocSeen >= dataCount)
+        {
+            fs->allocSeen = 0;
+            return YDEV_NO_MEMORY;
+        }
+
+        fs->allocStart = (uint16_t)((fs->allocStart + window) % dataCount);
+        fs->allocOffset = 0;
+        if (yDevFs_Rebuild(fs) != YDEV_OK)
+        {
+            fs->allocOffset = window;
+            return YDEV_ERROR;
+        }
+    }
+}
+
+/**
+ * @brief 写入元数据对的初始版本
+ */
+static yDevStatus_t yDevFs_FormatMeta(yDevFs_t *fs)
+{
+    yDevFsSuper_t super;
+
+    if ((yDevFs_Erase(fs, 0) != YDEV_OK) || (yDevFs_Erase(fs, 1) != YDEV_OK))
+    {
+        return YDEV_ERROR;
+    }
+    super.magic = YDEV_FS_SUPER_MAGIC;
+    super.rev = fs->rev + 1U;
+    super.reserved[0] = 0xFFFFFFFFUL;
+    super.reserved[1] = 0xFFFFFFFFUL;
+    if (yDevFs_Program(fs, yDevFs_BlockAddress(fs, 0), &super, sizeof(super)) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    fs->metaBlock = 0;
+    fs->rev = super.rev;
+    fs->metaUsed = YDEV_FS_SUPER_SIZE;
+    fs->files = 0;
+    fs->allocOffset = fs->lookahead;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 释放挂载时分配的资源
+ */
+static void yDevFs_Release(yDevFs_t *fs)
+{
+    if (fs->pool != NULL)
+    {
+        ylib_mempool_destroy(fs->pool);
+        fs->pool = NULL;
+    }
+    if (fs->entry != NULL)
+    {
+        YDEV_FREE(fs->entry);
+        fs->entry = NULL;
+    }
+    if (fs->mutex != NULL)
+    {
+        vSemaphoreDelete((SemaphoreHandle_t)fs->mutex);
+        fs->mutex = NULL;
+        OS_POOL_RELEASE(ydev_fs_mutex, fs);
+    }
+    fs->rcache = NULL;
+    fs->lookaheadMap = NULL;
+}
+
+/**
+ * @brief 加锁
+ */
+static void yDevFs_Lock(yDevFs_t *fs)
+{
+    (void)xSemaphoreTake((SemaphoreHandle_t)fs->mutex, portMAX_DELAY);
+}
+
+/**
+ * @brief 解锁
+ */
+static void yDevFs_Unlock(yDevFs_t *fs)
+{
+    (void)xSemaphoreGive((SemaphoreHandle_t)fs->mutex);
+}
+
+/**
+ * @brief 刷新文件写缓存
+ */
+static yDevStatus_t yDevFs_Flush(yDevHandle_File_t *file)
+{
+    yDevFs_t *fs = file->fs;
+
+    if (file->pcacheLen == 0U)
+    {
+        return YDEV_OK;
+    }
+    if (yDevFs_Program(fs, yDevFs_BlockAddress(fs, file->pcacheBlock) + file->pcacheOffset, file->pcache,
+                       file->pcacheLen) != YDEV_OK)
+    {
+        file->pcacheLen = 0;
+        file->base.errno |= YDEV_FILE_ERRNO_IO;
+        return YDEV_ERROR;
+    }
+    file->pcacheLen = 0;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 提交文件记录
+ */
+static yDevStatus_t yDevFs_Commit(yDevHandle_File_t *file)
+{
+    yDevFs_t *fs = file->fs;
+    yDevFsRecord_t record;
+    uint32_t address;
+    yDevStatus_t status;
+
+    if (yDevFs_Flush(file) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+    if (file->dirty == 0U)
+    {
+        return YDEV_OK;
+    }
+    if ((yDevFs_Find(fs, file->name, file->nameLen) < 0) && (fs->files >= fs->filesMax))
+    {
+        file->base.errno |= YDEV_FILE_ERRNO_FULL;
+        return YDEV_NO_MEMORY;
+    }
+
+    yDevFs_RecordBuild(&record, file->name, file->nameLen, 0, file->size, file->block, file->nblocks);
+    status = yDevFs_Append(fs, &record, &address);
+    if (status != YDEV_OK)
+    {
+        file->base.errno |= YDEV_FILE_ERRNO_IO;
+        return status;
+    }
+    (void)yDevFs_IndexUpdate(fs, file->name, file->nameLen, address, 0);
+    file->dirty = 0;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 把一个数据块复制到新块，同时写入一段新数据
+ * @param index 文件内块序号
+ * @param offset 新数据的块内偏移，不大于该块的有效长度
+ * @param data 新数据，len为0时只复制
+ * @note 写缓存须已刷新，复制时借用为临时缓冲区
+ */
+static yDevStatus_t yDevFs_Cow(yDevHandle_File_t *file, uint16_t index, uint32_t offset, const uint8_t *data,
+                               uint32_t len)
+{
+    yDevFs_t *fs = file->fs;
+    uint32_t extent;
+    uint32_t end;
+    uint32_t pos;
+    uint32_t chunk;
+    uint32_t from;
+    uint32_t to;
+    uint32_t oldAddress;
+    uint32_t newAddress;
+    uint16_t block;
+    yDevStatus_t status;
+
+    extent = file->size - (uint32_t)index * YDEV_FS_BLOCK_SIZE;
+    if (extent > YDEV_FS_BLOCK_SIZE)
+    {
+        extent = YDEV_FS_BLOCK_SIZE;
+    }
+    end = (offset + len > extent) ? offset + len : extent;
+
+    status = yDevFs_Alloc(fs, &block);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+    oldAddress = yDevFs_BlockAddress(fs, file->block[index]);
+    newAddress = yDevFs_BlockAddress(fs, block);
+
+    for (pos = 0; pos < end; pos += chunk)
+    {
+        chunk = end - pos;
+        if (chunk > fs->cacheSize)
+        {
+            chunk = fs->cacheSize;
+        }
+        if ((pos < extent) &&
+            (yDevFs_Read(fs, oldAddress + pos, file->pcache, ((extent - pos) < chunk) ? extent - pos : chunk) !=
+             YDEV_OK))
+        {
+            return YDEV_ERROR;
+        }
+        from = (pos > offset) ? pos : offset;
+        to = ((pos + chunk) < (offset + len)) ? pos + chunk : offset + len;
+        if (from < to)
+        {
+            memcpy(file->pcache + (from - pos), data + (from - offset), to - from);
+        }
+        if (yDevFs_Program(fs, newAddress + pos, file->pcache, chunk) != YDEV_OK)
+        {
+            return YDEV_ERROR;
+        }
+    }
+
+    file->block[index] = block;
+    if (index == file->nblocks - 1U)
+    {
+        file->tailErased = 1;
+    }
+    fs->stats.cows++;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 在文件末尾追加数据，经写缓存合并编程
+ * @note 调用前末块中追加位置之后须为擦除状态
+ */
+static yDevStatus_t yDevFs_AppendData(yDevHandle_File_t *file, uint16_t block, uint32_t offset, const uint8_t *data,
+                                      uint32_t len)
+{
+    uint32_t chunk;
+
+    if ((file->pcacheLen != 0U) &&
+        ((file->pcacheBlock != block) || ((uint32_t)file->pcacheOffset + file->pcacheLen != offset)))
+    {
+        if (yDevFs_Flush(file) != YDEV_OK)
+        {
+            return YDEV_ERROR;
+        }
+    }
+
+    while (len > 0)
+    {
+        if (file->pcacheLen == 0U)
+        {
+            file->pcacheBlock = block;
+            file->pcacheOffset = (uint16_t)offset;
+        }
+        chunk = file->fs->cacheSize - file->pcacheLen;
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+        memcpy(file->pcache + file->pcacheLen, data, chunk);
+        file->pcacheLen = (uint16_t)(file->pcacheLen + chunk);
+        if ((file->pcacheLen == file->fs->cacheSize) && (yDevFs_Flush(file) != YDEV_OK))
+        {
+            return YDEV_ERROR;
+        }
+        data += chunk;
+        offset += chunk;
+        len -= chunk;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 写入一段不跨块的数据
+ */
+static yDevStatus_t yDevFs_WriteChunk(yDevHandle_File_t *file, const uint8_t *data, uint32_t len)
+{
+    yDevFs_t *fs = file->fs;
+    uint16_t index = (uint16_t)(file->pos / YDEV_FS_BLOCK_SIZE);
+    uint32_t offset = file->pos % YDEV_FS_BLOCK_SIZE;
+    uint16_t block;
+    uint8_t fresh = 0;
+    yDevStatus_t status;
+    int32_t erased;
+
+    if (index >= YDEV_FS_FILE_BLOCKS)
+    {
+        return YDEV_NO_MEMORY;
+    }
+
+    if (index == file->nblocks)
+    {
+        // 位置在末块之后的块边界上，追加新块
+        status = yDevFs_Alloc(fs, &block);
+        if (status != YDEV_OK)
+        {
+            return status;
+        }
+        file->block[file->nblocks++] = block;
+        file->tailErased = 1;
+        fresh = 1;
+    }
+    else if (file->pos < file->size)
+    {
+        // 改写已有数据
+        if (yDevFs_Flush(file) != YDEV_OK)
+        {
+            return YDEV_ERROR;
+        }
+        status = yDevFs_Cow(file, index, offset, data, len);
+        if (status != YDEV_OK)
+        {
+            return status;
+        }
+        if (file->pos + len > file->size)
+        {
+            file->size = file->pos + len;
+        }
+        return YDEV_OK;
+    }
+    else if (file->tailErased == 0U)
+    {
+        // 末块中文件末尾之后的内容未知，可能是掉电前未提交的写入
+        if (yDevFs_Flush(file) != YDEV_OK)
+        {
+            return YDEV_ERROR;
+        }
+        erased = yDevFs_IsErased(fs, yDevFs_BlockAddress(fs, file->block[index]) + offset,
+                                 YDEV_FS_BLOCK_SIZE - offset, file->pcache);
+        if (erased < 0)
+        {
+            return YDEV_ERROR;
+        }
+        if (erased == 0)
+        {
+            status = yDevFs_Cow(file, index, offset, NULL, 0);
+            if (status != YDEV_OK)
+            {
+                return status;
+            }
+        }
+        file->tailErased = 1;
+    }
+
+    if (yDevFs_AppendData(file, file->block[index], offset, data, len) != YDEV_OK)
+    {
+        // 新块上一个字节也没写进去时退回，记录中的块数和大小保持一致
+        if ((fresh != 0U) && (file->size <= (uint32_t)index * YDEV_FS_BLOCK_SIZE))
+        {
+            file->nblocks--;
+        }
+        return YDEV_ERROR;
+    }
+    file->size = file->pos + len;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 读取目录索引项对应的文件信息
+ */
+static yDevStatus_t yDevFs_Info(yDevFs_t *fs, uint32_t index, yDevFsInfo_t *info)
+{
+    yDevFsRecord_t record;
+    uint32_t limit = yDevFs_BlockAddress(fs, fs->metaBlock) + YDEV_FS_BLOCK_SIZE;
+
+    if ((index >= fs->files) || (yDevFs_ReadRecord(fs, fs->entry[index].address, limit, &record) != 1))
+    {
+        return YDEV_ERROR;
+    }
+    memcpy(info->name, &record.raw[YDEV_FS_RECORD_HEADER_SIZE], record.header.nameLen);
+    info->name[record.header.nameLen] = '\0';
+    info->size = record.header.size;
+    info->blocks = record.header.nblocks;
+    return YDEV_OK;
+}
+
+// ==================== 文件设备操作 ====================
+
+/**
+ * @brief 文件设备初始化(打开文件)
+ * @param config 文件设备配置参数
+ * @param handle 文件设备句柄
+ * @return yDevStatus_t 初始化状态
+ */
+static yDevStatus_t yDev_File_Init(void *config, void *handle)
+{
+    yDevConfig_File_t *file_config;
+    yDevHandle_File_t *file;
+    yDevHandle_File_t *other;
+    yDevFsRecord_t record;
+    yDevFs_t *fs;
+    size_t nameLen;
+    int32_t index;
+    uint32_t limit;
+
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    file = (yDevHandle_File_t *)handle;
+    file_config = (yDevConfig_File_t *)config;
+    fs = file_config->fs;
+    if ((fs == NULL) || (fs->mounted == 0U) || (file_config->path == NULL) ||
+        ((file_config->flags & YDEV_FS_O_RDWR) == 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    nameLen = strlen(file_config->path);
+    if ((nameLen == 0U) || (nameLen > YDEV_FS_NAME_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    file->fs = fs;
+    file->next = NULL;
+    file->pcache = NULL;
+    file->pcacheLen = 0;
+    file->pos = 0;
+    file->flags = file_config->flags;
+    file->nameLen = (uint8_t)nameLen;
+    memcpy(file->name, file_config->path, nameLen);
+    file->name[nameLen] = '\0';
+
+    yDevFs_Lock(fs);
+    for (other = fs->open; other != NULL; other = other->next)
+    {
+        if ((other->nameLen == file->nameLen) && (memcmp(other->name, file->name, nameLen) == 0))
+        {
+            yDevFs_Unlock(fs);
+            return YDEV_BUSY;
+        }
+    }
+
+    index = yDevFs_Find(fs, file->name, file->nameLen);
+    if (index < 0)
+    {
+        if ((file->flags & YDEV_FS_O_CREAT) == 0U)
+        {
+            file->base.errno |= YDEV_FILE_ERRNO_NOT_FOUND;
+            yDevFs_Unlock(fs);
+            return YDEV_ERROR;
+        }
+        if (fs->files >= fs->filesMax)
+        {
+            file->base.errno |= YDEV_FILE_ERRNO_FULL;
+            yDevFs_Unlock(fs);
+            return YDEV_NO_MEMORY;
+        }
+        file->size = 0;
+        file->nblocks = 0;
+        file->dirty = 1; // 关闭时即使没有写入也留下空文件
+    }
+    else
+    {
+        limit = yDevFs_BlockAddress(fs, fs->metaBlock) + YDEV_FS_BLOCK_SIZE;
+        if (yDevFs_ReadRecord(fs, fs->entry[index].address, limit, &record) != 1)
+        {
+            file->base.errno |= YDEV_FILE_ERRNO_IO;
+            yDevFs_Unlock(fs);
+            return YDEV_ERROR;
+        }
+        file->size = record.header.size;
+        file->nblocks = record.header.nblocks;
+        memcpy(file->block, yDevFs_RecordBlocks(&record), 2U * (uint32_t)file->nblocks);
+        file->dirty = 0;
+    }
+    file->tailErased = 0;
+
+    if (((file->flags & YDEV_FS_O_TRUNC) != 0U) && ((file->flags & YDEV_FS_O_WRONLY) != 0U) &&
+        (file->size != 0U))
+    {
+        file->size = 0;
+        file->nblocks = 0;
+        file->dirty = 1;
+    }
+
+    file->pcache = (uint8_t *)ylib_mempool_alloc(fs->pool);
+    if (file->pcache == NULL)
+    {
+        file->base.errno |= YDEV_FILE_ERRNO_FULL;
+        yDevFs_Unlock(fs);
+        return YDEV_NO_MEMORY;
+    }
+
+    file->next = fs->open;
+    fs->open = file;
+    yDevFs_Unlock(fs);
+    return YDEV_OK;
+}
+
+/**
+ * @brief 文件设备反初始化(关闭文件)
+ * @param handle 文件设备句柄
+ * @return yDevStatus_t 提交结果，失败时文件仍然关闭，Flash上保持上一次提交的内容
+ */
+static yDevStatus_t yDev_File_Deinit(void *handle)
+{
+    yDevHandle_File_t *file;
+    yDevHandle_File_t **link;
+    yDevFs_t *fs;
+    yDevStatus_t status;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    file = (yDevHandle_File_t *)handle;
+    fs = file->fs;
+    yDevFs_Lock(fs);
+    status = yDevFs_Commit(file);
+    for (link = &fs->open; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == file)
+        {
+            *link = file->next;
+            break;
+        }
+    }
+    (void)ylib_mempool_free(fs->pool, file->pcache);
+    file->pcache = NULL;
+    file->next = NULL;
+    yDevFs_Unlock(fs);
+    return status;
+}
+
+/**
+ * @brief 文件设备读取
+ * @param handle 文件设备句柄
+ * @param buffer 读取缓冲区
+ * @param size 读取字节数
+ * @return int32_t 实际读取的字节数，到达文件末尾返回0，-1表示错误
+ */
+static int32_t yDev_File_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_File_t *file;
+    yDevFs_t *fs;
+    uint8_t *out = (uint8_t *)buffer;
+    uint32_t done = 0;
+    uint32_t offset;
+    uint32_t chunk;
+
+    if ((handle == NULL) || (buffer == NULL))
+    {
+        return -1;
+    }
+
+    file = (yDevHandle_File_t *)handle;
+    fs = file->fs;
+    if ((file->flags & YDEV_FS_O_RDONLY) == 0U)
+    {
+        file->base.errno |= YDEV_FILE_ERRNO_ACCESS;
+        return -1;
+    }
+
+    yDevFs_Lock(fs);
+    if (yDevFs_Flush(file) != YDEV_OK)
+    {
+        yDevFs_Unlock(fs);
+        return -1;
+    }
+    if (size > file->size - file->pos)
+    {
+        size = file->size - file->pos;
+    }
+    while (done < size)
+    {
+        offset = file->pos % YDEV_FS_BLOCK_SIZE;
+        chunk = YDEV_FS_BLOCK_SIZE - offset;
+        if (chunk > size - done)
+        {
+            chunk = (uint32_t)size - done;
+        }
+        if (yDevFs_Read(fs, yDevFs_BlockAddress(fs, file->block[file->pos / YDEV_FS_BLOCK_SIZE]) + offset,
+                        out + done, chunk) != YDEV_OK)
+        {
+            file->base.errno |= YDEV_FILE_ERRNO_IO;
+            break;
+        }
+        file->pos += chunk;
+        done += chunk;
+    }
+    yDevFs_Unlock(fs);
+
+    return ((done == 0U) && (size != 0U)) ? -1 : (int32_t)done;
+}
+
+/**
+ * @brief 文件设备写入
+ * @param handle 文件设备句柄
+ * @param buffer 写入数据
+ * @param size 写入字节数
+ * @return int32_t 实际写入的字节数，-1表示错误
+ *
+ * @par 功能描述:
+ * 只修改RAM中的文件状态，SYNC或关闭时提交；空间不足时返回已写入的部分
+ */
+static int32_t yDev_File_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_File_t *file;
+    yDevFs_t *fs;
+    const uint8_t *in = (const uint8_t *)buffer;
+    uint32_t done = 0;
+    uint32_t chunk;
+    yDevStatus_t status = YDEV_OK;
+
+    if ((handle == NULL) || (buffer == NULL))
+    {
+        return -1;
+    }
+
+    file = (yDevHandle_File_t *)handle;
+    fs = file->fs;
+    if ((file->flags & YDEV_FS_O_WRONLY) == 0U)
+    {
+        file->base.errno |= YDEV_FILE_ERRNO_ACCESS;
+        return -1;
+    }
+
+    yDevFs_Lock(fs);
+    if ((file->flags & YDEV_FS_O_APPEND) != 0U)
+    {
+        file->pos = file->size;
+    }
+    while (done < size)
+    {
+        chunk = YDEV_FS_BLOCK_SIZE - file->pos % YDEV_FS_BLOCK_SIZE;
+        if (chunk > size - done)
+        {
+            chunk = (uint32_t)size - done;
+        }
+        status = yDevFs_WriteChunk(file, in + done, chunk);
+        if (status != YDEV_OK)
+        {
+            file->base.errno |= (status == YDEV_NO_MEMORY) ? YDEV_FILE_ERRNO_NO_SPACE : YDEV_FILE_ERRNO_IO;
+            break;
+        }
+        file->pos += chunk;
+        file->dirty = 1;
+        done += chunk;
+    }
+    yDevFs_Unlock(fs);
+
+    return ((done == 0U) && (size != 0U)) ? -1 : (int32_t)done;
+}
+
+/**
+ * @brief 文件设备控制
+ * @param handle 文件设备句柄
+ * @param cmd 控制命令 YDEV_FILE_xxx
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_File_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_File_t *file;
+    yDevFsSeek_t *seek;
+    yDevFs_t *fs;
+    yDevStatus_t status = YDEV_OK;
+    int32_t base;
+    int32_t pos;
+    uint32_t size;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    if ((arg == NULL) && (cmd != YDEV_FILE_SYNC))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    file = (yDevHandle_File_t *)handle;
+    fs = file->fs;
+    yDevFs_Lock(fs);
+    switch (cmd)
+    {
+    case YDEV_FILE_SEEK:
+        seek = (yDevFsSeek_t *)arg;
+        base = (seek->whence == 0U) ? 0 : (seek->whence == 1U) ? (int32_t)file->pos : (int32_t)file->size;
+        pos = base + seek->offset;
+        if ((seek->whence > 2U) || (pos < 0) || ((uint32_t)pos > file->size))
+        {
+            status = YDEV_INVALID_PARAM;
+            break;
+        }
+        file->pos = (uint32_t)pos;
+        break;
+
+    case YDEV_FILE_TELL:
+        *(uint32_t *)arg = file->pos;
+        break;
+
+    case YDEV_FILE_SIZE:
+        *(uint32_t *)arg = file->size;
+        break;
+
+    case YDEV_FILE_SYNC:
+        status = yDevFs_Commit(file);
+        break;
+
+    case YDEV_FILE_TRUNCATE:
+        size = *(uint32_t *)arg;
+        if ((file->flags & YDEV_FS_O_WRONLY) == 0U)
+        {
+            file->base.errno |= YDEV_FILE_ERRNO_ACCESS;
+            status = YDEV_PERMISSION_DENIED;
+            break;
+        }
+        if (size > file->size)
+        {
+            status = YDEV_INVALID_PARAM;
+            break;
+        }
+        if (size == file->size)
+        {
+            break;
+        }
+        status = yDevFs_Flush(file);
+        if (status != YDEV_OK)
+        {
+            break;
+        }
+        // 被截掉的内容仍留在末块中，之后的追加要先确认擦除状态
+        file->nblocks = (uint16_t)((size + YDEV_FS_BLOCK_SIZE - 1U) / YDEV_FS_BLOCK_SIZE);
+        file->size = size;
+        file->tailErased = 0;
+        if (file->pos > size)
+        {
+            file->pos = size;
+        }
+        file->dirty = 1;
+        break;
+
+    default:
+        status = YDEV_NOT_SUPPORTED;
+        break;
+    }
+    yDevFs_Unlock(fs);
+    return status;
+}
+
+// ==================== 公共函数实现 ====================
+
+yDevStatus_t yDevFsMount(yDevFs_t *fs, const yDevFsConfig_t *config)
+{
+    yDevFsSuper_t super[YDEV_FS_META_BLOCKS];
+    uint8_t valid[YDEV_FS_META_BLOCKS];
+    uint16_t dataCount;
+    yDevStatus_t status;
+    int32_t slot;
+    uint8_t torn = 0;
+    uint8_t i;
+
+    if ((fs == NULL) || (config == NULL) || (config->flash == NULL) ||
+        ((config->baseAddress % YDEV_FS_BLOCK_SIZE) != 0U) || (config->blockCount < YDEV_FS_META_BLOCKS + 1U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    memset(fs, 0, sizeof(*fs));
+    fs->flash = config->flash;
+    fs->baseAddress = config->baseAddress;
+    fs->blockCount = config->blockCount;
+    fs->cacheSize = (config->cacheSize != 0U) ? config->cacheSize : YDEV_FS_CACHE_DEFAULT;
+    fs->lookahead = (config->lookahead != 0U) ? config->lookahead : YDEV_FS_LOOKAHEAD_DEFAULT;
+    fs->filesMax = (config->filesMax != 0U) ? config->filesMax : YDEV_FS_FILES_DEFAULT;
+    fs->rcacheAddress = YDEV_FS_ADDRESS_NONE;
+
+    // 压缩后的元数据块必须放得下全部文件的最长记录
+    if ((fs->cacheSize < 16U) || (fs->cacheSize > YDEV_FS_BLOCK_SIZE) ||
+        ((fs->cacheSize & (fs->cacheSize - 1U)) != 0U) || ((fs->lookahead % 32U) != 0U) ||
+        ((fs->lookahead / 8U) > fs->cacheSize) ||
+        (YDEV_FS_SUPER_SIZE + (uint32_t)fs->filesMax * YDEV_FS_RECORD_MAX > YDEV_FS_BLOCK_SIZE))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    slot = OS_POOL_CLAIM(ydev_fs_mutex, fs);
+    if (slot < 0)
+    {
+        return YDEV_NO_MEMORY;
+    }
+    fs->mutex = (void *)OS_MUTEX_POOL_CREATE(ydev_fs_mutex, slot);
+
+    // 读缓存、预读位图和每个打开文件的写缓存共用一个按缓存大小分块的内存池
+    fs->pool = ylib_mempool_create(fs->cacheSize,
+                                   2U + ((config->openMax != 0U) ? config->openMax : YDEV_FS_OPEN_DEFAULT));
+    fs->entry = (yDevFsEntry_t *)YDEV_MALLOC(sizeof(yDevFsEntry_t) * fs->filesMax);
+    if ((fs->pool == NULL) || (fs->entry == NULL))
+    {
+        yDevFs_Release(fs);
+        return YDEV_NO_MEMORY;
+    }
+    fs->rcache = (uint8_t *)ylib_mempool_alloc(fs->pool);
+    fs->lookaheadMap = (uint32_t *)ylib_mempool_alloc(fs->pool);
+
+    for (i = 0; i < YDEV_FS_META_BLOCKS; i++)
+    {
+        valid[i] = (yDevFs_Read(fs, yDevFs_BlockAddress(fs, i), &super[i], sizeof(super[i])) == YDEV_OK) &&
+                   (super[i].magic == YDEV_FS_SUPER_MAGIC);
+    }
+
+    if (!valid[0] && !valid[1])
+    {
+        status = yDevFs_FormatMeta(fs);
+    }
+    else
+    {
+        // 两块都有效时取版本较新的一块，版本号按回绕比较
+        fs->metaBlock = (valid[1] && (!valid[0] || ((int32_t)(super[1].rev - super[0].rev) > 0))) ? 1U : 0U;
+        fs->rev = super[fs->metaBlock].rev;
+        status = yDevFs_Scan(fs, &torn);
+        if ((status == YDEV_OK) && (torn != 0U))
+        {
+            status = yDevFs_Compact(fs);
+        }
+    }
+    if (status != YDEV_OK)
+    {
+        yDevFs_Release(fs);
+        return status;
+    }
+
+    // 分配起点随版本变化，每次上电从不同位置开始使用数据块
+    dataCount = (uint16_t)(fs->blockCount - YDEV_FS_META_BLOCKS);
+    fs->allocStart = (uint16_t)(yDevFs_Hash((const char *)&fs->rev, sizeof(fs->rev)) % dataCount);
+    fs->allocOffset = fs->lookahead;
+    fs->mounted = 1;
+    return YDEV_OK;
+}
+
+yDevStatus_t yDevFsUnmount(yDevFs_t *fs)
+{
+    if ((fs == NULL) || (fs->mounted == 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    yDevFs_Lock(fs);
+    if (fs->open != NULL)
+    {
+        yDevFs_Unlock(fs);
+        return YDEV_BUSY;
+    }
+    fs->mounted = 0;
+    yDevFs_Unlock(fs);
+    yDevFs_Release(fs);
+    return YDEV_OK;
+}
+
+yDevStatus_t yDevFsFormat(yDevFs_t *fs)
+{
+    yDevStatus_t status;
+
+    if ((fs == NULL) || (fs->mounted == 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    yDevFs_Lock(fs);
+    status = (fs->open != NULL) ? YDEV_BUSY : yDevFs_FormatMeta(fs);
+    yDevFs_Unlock(fs);
+    return status;
+}
+
+yDevStatus_t yDevFsRemove(yDevFs_t *fs, const char *name)
+{
+    yDevHandle_File_t *file;
+    yDevFsRecord_t record;
+    uint32_t address;
+    size_t nameLen;
+    yDevStatus_t status;
+
+    if ((fs == NULL) || (fs->mounted == 0U) || (name == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    nameLen = strlen(name);
+    if ((nameLen == 0U) || (nameLen > YDEV_FS_NAME_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    yDevFs_Lock(fs);
+    for (file = fs->open; file != NULL; file = file->next)
+    {
+        if ((file->nameLen == nameLen) && (memcmp(file->name, name, nameLen) == 0))
+        {
+            yDevFs_Unlock(fs);
+            return YDEV_BUSY;
+        }
+    }
+    if (yDevFs_Find(fs, name, (uint8_t)nameLen) < 0)
+    {
+        yDevFs_Unlock(fs);
+        return YDEV_ERROR;
+    }
+
+    // 删除记录提交后原数据块才不再被引用
+    yDevFs_RecordBuild(&record, name, (uint8_t)nameLen, YDEV_FS_FLAG_DELETED, 0, NULL, 0);
+    status = yDevFs_Append(fs, &record, &address);
+    if (status == YDEV_OK)
+    {
+        (void)yDevFs_IndexUpdate(fs, name, (uint8_t)nameLen, address, 1);
+    }
+    yDevFs_Unlock(fs);
+    return status;
+}
+
+yDevStatus_t yDevFsStat(yDevFs_t *fs, const char *name, yDevFsInfo_t *info)
+{
+    size_t nameLen;
+    int32_t index;
+    yDevStatus_t status;
+
+    if ((fs == NULL) || (fs->mounted == 0U) || (name == NULL) || (info == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    nameLen = strlen(name);
+    if ((nameLen == 0U) || (nameLen > YDEV_FS_NAME_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    yDevFs_Lock(fs);
+    index = yDevFs_Find(fs, name, (uint8_t)nameLen);
+    status = (index < 0) ? YDEV_ERROR : yDevFs_Info(fs, (uint32_t)index, info);
+    yDevFs_Unlock(fs);
+    return status;
+}
+
+yDevStatus_t yDevFsDir(yDevFs_t *fs, uint32_t index, yDevFsInfo_t *info)
+{
+    yDevStatus_t status;
+
+    if ((fs == NULL) || (fs->mounted == 0U) || (info == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    yDevFs_Lock(fs);
+    status = yDevFs_Info(fs, index, info);
+    yDevFs_Unlock(fs);
+    return status;
+}
+
+void yDevFsGetStats(yDevFs_t *fs, yDevFsStats_t *stats)
+{
+    yDevFsRecordHeader_t header;
+    uint16_t i;
+
+    if ((fs == NULL) || (stats == NULL))
+    {
+        return;
+    }
+    if (fs->mounted == 0U)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    yDevFs_Lock(fs);
+    *stats = fs->stats;
+    stats->files = fs->files;
+    stats->blockCount = fs->blockCount;
+    stats->metaUsed = (uint16_t)fs->metaUsed;
+    stats->blocksUsed = YDEV_FS_META_BLOCKS;
+    for (i = 0; i < fs->files; i++)
+    {
+        if (yDevFs_Read(fs, fs->entry[i].address, &header, sizeof(header)) == YDEV_OK)
+        {
+            stats->blocksUsed = (uint16_t)(stats->blocksUsed + header.nblocks);
+        }
+    }
+    yDevFs_Unlock(fs);
+}
+
+void yDevFileConfigStructInit(yDevConfig_File_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础配置
+    yDevConfigStructInit(&config->base);
+    config->base.type = YDEV_TYPE_FILE;
+
+    config->fs = NULL;
+    config->path = NULL;
+    config->flags = YDEV_FS_O_RDONLY;
+}
+
+void yDevFileHandleStructInit(yDevHandle_File_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础句柄
+    yDevHandleStructInit(&handle->base);
+
+    handle->fs = NULL;
+    handle->next = NULL;
+    handle->pcache = NULL;
+    handle->pcacheLen = 0;
+    handle->nblocks = 0;
+    handle->size = 0;
+    handle->pos = 0;
+    handle->flags = 0;
+    handle->dirty = 0;
+    handle->tailErased = 0;
+    handle->nameLen = 0;
+    handle->name[0] = '\0';
+}
+
+// ==================== 设备操作表导出 ====================
+
+YDEV_OPS_EXPORT_EX(
+    YDEV_TYPE_FILE,   // 设备类型
+    yDev_File_Init,   // 初始化函数
+    yDev_File_Deinit, // 反初始化函数
+    yDev_File_Read,   // 读取函数
+    yDev_File_Write,  // 写入函数
+    yDev_File_Ioctl)  // 控制函数
@@ -13,6 +13,7 @@
  * - GPIO状态控制和查询
  * - 外部中断注册和处理
  * - 与底层yDrv GPIO驱动的适配
+ * - GPIO端口组的并行读写
  */
 
 // ==================== 包含文件 ====================
@@ -130,7 +131,7 @@ void yDevGpioHandleStructInit(yDevHandle_Gpio_t *handle)
  * 读取GPIO引脚的当前状态，将状态值写入缓冲区
  * 状态值：0表示低电平，非0表示高电平
  */
-static int32_t yDev_Gpio_Read(void *handle, void *buffer, uint16_t size)
+static int32_t yDev_Gpio_Read(void *handle, void *buffer, size_t size)
 {
     yDevHandle_Gpio_t *gpio_handle;
     uint32_t *state_buffer;
@@ -144,8 +145,8 @@ static int32_t yDev_Gpio_Read(void *handle, void *buffer, uint16_t size)
     gpio_handle = (yDevHandle_Gpio_t *)handle;
     state_buffer = (uint32_t *)buffer;
 
-    // 调用底层yDrv读取GPIO引脚状态
-    *state_buffer = (uint32_t)yDrvGpioRead(&gpio_handle->drv_handle);
+    // 与快速访问函数共用同一实现
+    *state_buffer = yDevGpioReadFast(gpio_handle);
 
     return sizeof(uint32_t); // 返回实际读取的字节数
 }
@@ -161,12 +162,10 @@ static int32_t yDev_Gpio_Read(void *handle, void *buffer, uint16_t size)
  * 设置GPIO引脚的输出状态
  * 写入值：0设置为低电平，非0设置为高电平
  */
-static int32_t yDev_Gpio_Write(void *handle, const void *buffer, uint16_t size)
+static int32_t yDev_Gpio_Write(void *handle, const void *buffer, size_t size)
 {
     yDevHandle_Gpio_t *gpio_handle;
     const uint32_t *state_buffer;
-    yDrvPinState_t pin_state;
-    yDrvStatus_t result;
 
     // 参数有效性检查
     if ((handle == NULL) || (buffer == NULL) || (size != sizeof(uint32_t)))
@@ -176,18 +175,14 @@ static int32_t yDev_Gpio_Write(void *handle, const void *buffer, uint16_t size)
 
     gpio_handle = (yDevHandle_Gpio_t *)handle;
     state_buffer = (const uint32_t *)buffer;
-
-    // 转换状态值
-    pin_state = (*state_buffer != 0) ? YDRV_PIN_SET : YDRV_PIN_RESET;
-
-    // 调用底层yDrv设置GPIO引脚状态
-    result = yDrvGpioWrite(&gpio_handle->drv_handle, pin_state);
-
-    if (result != YDRV_OK)
+    if (gpio_handle->drv_handle.gpioInfo.port == NULL)
     {
-        return -1; // 返回错误
+        return -1; // 未初始化
     }
 
+    // 与快速访问函数共用同一实现
+    yDevGpioWriteFast(gpio_handle, *state_buffer);
+
     return sizeof(uint32_t); // 返回实际写入的字节数
 }
 
@@ -294,3 +289,243 @@ YDEV_OPS_EXPORT_EX(
     yDev_Gpio_Read,   // 读取函数
     yDev_Gpio_Write,  // 写入函数
     yDev_Gpio_Ioctl)  // 控制函数
+
+// ==================== GPIO端口组设备操作函数 ====================
+
+/**
+ * @brief GPIO端口组设备初始化
+ * @param config GPIO端口组设备配置参数
+ * @param handle GPIO端口组设备句柄
+ * @return yDevStatus_t 初始化状态
+ */
+static yDevStatus_t yDev_GpioPort_Init(void *config, void *handle)
+{
+    yDevConfig_GpioPort_t *port_config;
+    yDevHandle_GpioPort_t *port_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    port_handle = (yDevHandle_GpioPort_t *)handle;
+    port_config = (yDevConfig_GpioPort_t *)config;
+
+    if (yDrvGpioPortInitStatic(&port_config->drv_config, &port_handle->drv_handle) != YDRV_OK)
+    {
+        port_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief GPIO端口组设备反初始化
+ * @param handle GPIO端口组设备句柄
+ * @return yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_GpioPort_Deinit(void *handle)
+{
+    yDevHandle_GpioPort_t *port_handle;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    port_handle = (yDevHandle_GpioPort_t *)handle;
+
+    if (yDrvGpioPortDeInitStatic(&port_handle->drv_handle) != YDRV_OK)
+    {
+        port_handle->base.errno = YDEV_ERRNO_NOT_DEINIT;
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+void yDevGpioPortConfigStructInit(yDevConfig_GpioPort_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础配置
+    yDevConfigStructInit(&config->base);
+    config->base.type = YDEV_TYPE_GPIO_PORT;
+
+    // 初始化驱动配置
+    yDrvGpioPortConfigStructInit(&config->drv_config);
+}
+
+void yDevGpioPortHandleStructInit(yDevHandle_GpioPort_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础句柄
+    yDevHandleStructInit(&handle->base);
+
+    // 初始化驱动句柄
+    yDrvGpioPortHandleStructInit(&handle->drv_handle);
+}
+
+/**
+ * @brief GPIO端口组设备读取操作
+ * @param handle GPIO端口组设备句柄
+ * @param buffer 读取缓冲区(uint32_t)
+ * @param size 缓冲区大小，必须为sizeof(uint32_t)
+ * @return int32_t 实际读取的字节数，-1表示错误
+ *
+ * @par 功能描述:
+ * 一次读取输入数据寄存器，组内第i个引脚的电平写入第i位
+ */
+static int32_t yDev_GpioPort_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_GpioPort_t *port_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size != sizeof(uint32_t)))
+    {
+        return -1;
+    }
+
+    port_handle = (yDevHandle_GpioPort_t *)handle;
+    if (port_handle->drv_handle.port == NULL)
+    {
+        return -1; // 未初始化
+    }
+
+    *(uint32_t *)buffer = yDevGpioPortReadFast(port_handle);
+
+    return sizeof(uint32_t);
+}
+
+/**
+ * @brief GPIO端口组设备写入操作
+ * @param handle GPIO端口组设备句柄
+ * @param buffer 写入缓冲区(uint32_t)
+ * @param size 缓冲区大小，必须为sizeof(uint32_t)
+ * @return int32_t 实际写入的字节数，-1表示错误
+ *
+ * @par 功能描述:
+ * 第i位决定组内第i个引脚的电平，置位和复位在一次BSRR写入中完成
+ */
+static int32_t yDev_GpioPort_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_GpioPort_t *port_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size != sizeof(uint32_t)))
+    {
+        return -1;
+    }
+
+    port_handle = (yDevHandle_GpioPort_t *)handle;
+    if (port_handle->drv_handle.port == NULL)
+    {
+        return -1; // 未初始化
+    }
+
+    yDevGpioPortWriteFast(port_handle, *(const uint32_t *)buffer);
+
+    return sizeof(uint32_t);
+}
+
+/**
+ * @brief GPIO端口组设备控制操作
+ * @param handle GPIO端口组设备句柄
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 支持的命令:
+ * - YDEV_GPIO_PORT_SET_BITS: 置高指定组内位
+ * - YDEV_GPIO_PORT_CLEAR_BITS: 置低指定组内位
+ * - YDEV_GPIO_PORT_TOGGLE_BITS: 翻转指定组内位
+ * - YDEV_GPIO_PORT_GET_MASK: 获取组内有效位掩码
+ * - YDEV_IOCTL_GET_STATUS: 获取设备状态
+ * - YDEV_IOCTL_RESET: 重置设备
+ */
+static yDevStatus_t yDev_GpioPort_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_GpioPort_t *port_handle;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    port_handle = (yDevHandle_GpioPort_t *)handle;
+    if (port_handle->drv_handle.port == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_GPIO_PORT_SET_BITS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDrvGpioPortSetBits(&port_handle->drv_handle, *(uint32_t *)arg);
+        return YDEV_OK;
+
+    case YDEV_GPIO_PORT_CLEAR_BITS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDrvGpioPortClearBits(&port_handle->drv_handle, *(uint32_t *)arg);
+        return YDEV_OK;
+
+    case YDEV_GPIO_PORT_TOGGLE_BITS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDrvGpioPortToggleBits(&port_handle->drv_handle, *(uint32_t *)arg);
+        return YDEV_OK;
+
+    case YDEV_GPIO_PORT_GET_MASK:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = port_handle->drv_handle.mask >> port_handle->drv_handle.shift;
+        return YDEV_OK;
+
+    case YDEV_IOCTL_GET_STATUS:
+        if (arg != NULL)
+        {
+            *(yDevStatus_t *)arg = YDEV_OK;
+            return YDEV_OK;
+        }
+        return YDEV_INVALID_PARAM;
+
+    case YDEV_IOCTL_RESET:
+        return YDEV_OK;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+/**
+ * @brief 导出GPIO端口组设备操作表
+ */
+YDEV_OPS_EXPORT_EX(
+    YDEV_TYPE_GPIO_PORT,  // 设备类型
+    yDev_GpioPort_Init,   // 初始化函数
+    yDev_GpioPort_Deinit, // 反初始化函数
+    yDev_GpioPort_Read,   // 读取函数
+    yDev_GpioPort_Write,  // 写入函数
+    yDev_GpioPort_Ioctl)  // 控制函数
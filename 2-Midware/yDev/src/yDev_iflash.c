@@ -0,0 +1,547 @@
+/**
+ * @file yDev_iflash.c
+ * @brief yDev 片内Flash数据区设备驱动实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现基于yDev框架的片内Flash设备，读取直接拷贝映射地址，写入和擦除调用yDrv_flash
+ *
+ * @par 实现说明:
+ * - 每个双字段、每一页的擦写都在挂起调度器后执行，擦写之间任务照常切换，
+ *   后台擦除任务与前台写入不会同时操作Flash控制寄存器
+ * - 后台擦除按页位图排队，擦除任务每次只擦一页，随后休眠YDEV_IFLASH_ERASE_GAP_MS，
+ *   把一次多页擦除的停顿拆散到空闲时段；同步擦除会顺带清除对应页的排队位
+ * - 写入跨到尚在排队的页时拒绝，避免先写后擦丢失数据
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_iflash.h"
+#include "yDev_def.h"
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "os_static.h"
+
+// ==================== 私有定义 ====================
+
+/**
+ * @brief 链接脚本在Flash末尾保留的数据区
+ */
+extern const uint8_t __iflash_data_start[];
+extern const uint8_t __iflash_data_end[];
+
+/**
+ * @brief 后台擦除任务的静态存储
+ * @note 按句柄占用槽位，反初始化删除任务后释放
+ */
+OS_TASK_POOL_DEFINE(ydev_iflash_task, YDEV_IFLASH_MAX, YDEV_IFLASH_ERASE_TASK_STACK);
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 计算一段范围覆盖的页位图
+ * @param iflash_handle 片内Flash设备句柄
+ * @param offset 区域内偏移
+ * @param size 字节数
+ * @retval 页位图，范围为空或超出区域时返回0
+ */
+static uint32_t yDev_Iflash_PageMask(const yDevHandle_Iflash_t *iflash_handle, uint32_t offset, uint32_t size)
+{
+    uint32_t first;
+    uint32_t last;
+
+    if ((size == 0U) || (offset >= iflash_handle->size) || (size > (iflash_handle->size - offset)))
+    {
+        return 0;
+    }
+
+    first = offset / YDRV_FLASH_PAGE_SIZE;
+    last = (offset + size - 1U) / YDRV_FLASH_PAGE_SIZE;
+    return ((last >= 31U) ? 0xFFFFFFFFUL : ((1UL << (last + 1U)) - 1UL)) & ~((1UL << first) - 1UL);
+}
+
+/**
+ * @brief 擦除区域内的一页
+ * @param iflash_handle 片内Flash设备句柄
+ * @param page 区域内页号
+ * @retval YDEV_OK 成功
+ * @retval YDEV_ERROR 擦除失败
+ * @note 挂起调度器执行，返回后清除该页的排队位
+ */
+static yDevStatus_t yDev_Iflash_ErasePage(yDevHandle_Iflash_t *iflash_handle, uint32_t page)
+{
+    yDrvStatus_t ret;
+
+    vTaskSuspendAll();
+    ret = yDrvFlashErasePage(yDrvFlashPageOf(iflash_handle->start) + page);
+    iflash_handle->erase_pending &= ~(1UL << page);
+    if (ret == YDRV_OK)
+    {
+        iflash_handle->stats.erases++;
+    }
+    else
+    {
+        iflash_handle->stats.errors++;
+        iflash_handle->stats.last_error = yDrvFlashTakeError();
+        iflash_handle->base.errno |= YDEV_IFLASH_ERRNO_ERASE;
+    }
+    (void)xTaskResumeAll();
+
+    return (ret == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+}
+
+/**
+ * @brief 编程一段双字对齐的数据
+ * @param iflash_handle 片内Flash设备句柄
+ * @param offset 区域内偏移，8字节对齐
+ * @param data 数据
+ * @param size 字节数，8的整数倍
+ * @retval YDEV_OK 成功
+ * @retval YDEV_ERROR 编程失败
+ * @note 挂起调度器执行，调用者按行切分控制单次挂起时间
+ */
+static yDevStatus_t yDev_Iflash_Program(yDevHandle_Iflash_t *iflash_handle, uint32_t offset,
+                                        const void *data, uint32_t size)
+{
+    yDrvStatus_t ret;
+
+    vTaskSuspendAll();
+    ret = yDrvFlashProgram(iflash_handle->start + offset, data, size);
+    if (ret == YDRV_OK)
+    {
+        iflash_handle->stats.bytes += size;
+    }
+    else
+    {
+        iflash_handle->stats.errors++;
+        iflash_handle->stats.last_error = yDrvFlashTakeError();
+        iflash_handle->base.errno |= YDEV_IFLASH_ERRNO_PROGRAM;
+    }
+    (void)xTaskResumeAll();
+
+    return (ret == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+}
+
+/**
+ * @brief 后台擦除任务
+ * @param arg 片内Flash设备句柄
+ */
+static void yDev_Iflash_EraseTask(void *arg)
+{
+    yDevHandle_Iflash_t *iflash_handle = (yDevHandle_Iflash_t *)arg;
+    yDevStatus_t status;
+    uint32_t pending;
+    uint32_t page;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while ((pending = iflash_handle->erase_pending) != 0U)
+        {
+            // 每次只擦编号最小的一页，然后让出CPU
+            page = 0;
+            while ((pending & (1UL << page)) == 0U)
+            {
+                page++;
+            }
+            if (yDev_Iflash_ErasePage(iflash_handle, page) != YDEV_OK)
+            {
+                iflash_handle->erase_status = YDEV_ERROR;
+            }
+            if (iflash_handle->erase_pending != 0U)
+            {
+                vTaskDelay(pdMS_TO_TICKS(YDEV_IFLASH_ERASE_GAP_MS));
+            }
+        }
+
+        taskENTER_CRITICAL();
+        status = iflash_handle->erase_status;
+        iflash_handle->erase_status = YDEV_OK;
+        taskEXIT_CRITICAL();
+
+        if (iflash_handle->callback != NULL)
+        {
+            iflash_handle->callback(iflash_handle->arg, status);
+        }
+    }
+}
+
+/**
+ * @brief 排队后台擦除，按需创建擦除任务
+ * @param iflash_handle 片内Flash设备句柄
+ * @param mask 页位图
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_Iflash_EraseAsync(yDevHandle_Iflash_t *iflash_handle, uint32_t mask)
+{
+    int32_t slot;
+
+    if (iflash_handle->erase_task == NULL)
+    {
+        slot = OS_POOL_CLAIM(ydev_iflash_task, iflash_handle);
+        if (slot < 0)
+        {
+            iflash_handle->base.errno |= YDEV_IFLASH_ERRNO_NO_MEMORY;
+            return YDEV_ERROR;
+        }
+        iflash_handle->erase_task = (void *)OS_TASK_POOL_CREATE(ydev_iflash_task,
+                                                                slot,
+                                                                yDev_Iflash_EraseTask,
+                                                                "iflashErase",
+                                                                iflash_handle,
+                                                                YDEV_IFLASH_ERASE_TASK_PRIO);
+    }
+
+    taskENTER_CRITICAL();
+    iflash_handle->erase_pending |= mask;
+    taskEXIT_CRITICAL();
+    xTaskNotifyGive((TaskHandle_t)iflash_handle->erase_task);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 片内Flash设备初始化
+ * @param config 片内Flash设备配置参数
+ * @param handle 片内Flash设备句柄
+ * @return yDevStatus_t 初始化状态
+ */
+static yDevStatus_t yDev_Iflash_Init(void *config, void *handle)
+{
+    yDevConfig_Iflash_t *iflash_config;
+    yDevHandle_Iflash_t *iflash_handle;
+    uint32_t start;
+    uint32_t size;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    iflash_handle = (yDevHandle_Iflash_t *)handle;
+    iflash_config = (yDevConfig_Iflash_t *)config;
+
+    // 未指定区域时使用链接脚本保留的数据区
+    start = iflash_config->address;
+    size = iflash_config->size;
+    if (start == 0U)
+    {
+        start = (uint32_t)__iflash_data_start;
+        size = (uint32_t)(__iflash_data_end - __iflash_data_start);
+    }
+
+    if ((size == 0U) || ((start % YDRV_FLASH_PAGE_SIZE) != 0U) || ((size % YDRV_FLASH_PAGE_SIZE) != 0U) ||
+        ((size / YDRV_FLASH_PAGE_SIZE) > YDEV_IFLASH_PAGES_MAX) || (start < FLASH_BASE) ||
+        (size > FLASH_SIZE) || ((start - FLASH_BASE) > (FLASH_SIZE - size)))
+    {
+        iflash_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_INVALID_PARAM;
+    }
+
+    iflash_handle->start = start;
+    iflash_handle->size = size;
+    iflash_handle->address = 0;
+    iflash_handle->erase_pending = 0;
+    iflash_handle->erase_status = YDEV_OK;
+    iflash_handle->callback = iflash_config->callback;
+    iflash_handle->arg = iflash_config->arg;
+    memset(&iflash_handle->stats, 0, sizeof(iflash_handle->stats));
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 片内Flash设备反初始化
+ * @param handle 片内Flash设备句柄
+ * @return yDevStatus_t 操作状态
+ * @note 排队中的后台擦除被放弃
+ */
+static yDevStatus_t yDev_Iflash_Deinit(void *handle)
+{
+    yDevHandle_Iflash_t *iflash_handle;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    iflash_handle = (yDevHandle_Iflash_t *)handle;
+
+    // 擦除任务只在两页之间或空闲时被删除，挂起调度器期间不会切换到这里
+    if (iflash_handle->erase_task != NULL)
+    {
+        vTaskDelete((TaskHandle_t)iflash_handle->erase_task);
+        iflash_handle->erase_task = NULL;
+    }
+    OS_POOL_RELEASE(ydev_iflash_task, iflash_handle);
+
+    iflash_handle->erase_pending = 0;
+    iflash_handle->start = 0;
+    iflash_handle->size = 0;
+
+    return YDEV_OK;
+}
+
+void yDevIflashConfigStructInit(yDevConfig_Iflash_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础配置
+    yDevConfigStructInit(&config->base);
+    config->base.type = YDEV_TYPE_IFLASH;
+
+    config->address = 0;
+    config->size = 0;
+    config->callback = NULL;
+    config->arg = NULL;
+}
+
+void yDevIflashHandleStructInit(yDevHandle_Iflash_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础句柄
+    yDevHandleStructInit(&handle->base);
+
+    handle->start = 0;
+    handle->size = 0;
+    handle->address = 0;
+    handle->erase_pending = 0;
+    handle->erase_status = YDEV_OK;
+    handle->erase_task = NULL;
+    handle->callback = NULL;
+    handle->arg = NULL;
+    memset(&handle->stats, 0, sizeof(handle->stats));
+}
+
+/**
+ * @brief 片内Flash设备读取操作
+ * @param handle 片内Flash设备句柄
+ * @param buffer 读取缓冲区
+ * @param size 读取字节数
+ * @return int32_t 实际读取的字节数，-1表示错误
+ *
+ * @par 功能描述:
+ * 从handle->address开始读取，完成后address指向下一字节；排队擦除的页读到的是擦除前的数据
+ */
+static int32_t yDev_Iflash_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Iflash_t *iflash_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0U))
+    {
+        return -1;
+    }
+
+    iflash_handle = (yDevHandle_Iflash_t *)handle;
+    if (iflash_handle->start == 0U)
+    {
+        return -1;
+    }
+    if (yDev_Iflash_PageMask(iflash_handle, iflash_handle->address, size) == 0U)
+    {
+        iflash_handle->base.errno |= YDEV_IFLASH_ERRNO_RANGE;
+        return -1;
+    }
+
+    memcpy(buffer, yDevIflashPtr(iflash_handle, iflash_handle->address), size);
+    iflash_handle->address += size;
+
+    return (int32_t)size;
+}
+
+/**
+ * @brief 片内Flash设备写入操作
+ * @param handle 片内Flash设备句柄
+ * @param buffer 写入数据
+ * @param size 写入字节数
+ * @return int32_t 实际写入的字节数，-1表示错误
+ *
+ * @par 功能描述:
+ * 从handle->address(8字节对齐)开始编程，目标须已擦除；按行切分，行对齐的整行走快速编程，
+ * 末尾不足一个双字时以0xFF补齐，完成后address指向补齐后的下一个双字
+ */
+static int32_t yDev_Iflash_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_Iflash_t *iflash_handle;
+    const uint8_t *src = (const uint8_t *)buffer;
+    uint8_t tail[YDRV_FLASH_PROG_SIZE];
+    uint32_t offset;
+    uint32_t left;
+    uint32_t chunk;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0U))
+    {
+        return -1;
+    }
+
+    iflash_handle = (yDevHandle_Iflash_t *)handle;
+    if (iflash_handle->start == 0U)
+    {
+        return -1;
+    }
+
+    offset = iflash_handle->address;
+    if ((offset % YDRV_FLASH_PROG_SIZE) != 0U)
+    {
+        iflash_handle->base.errno |= YDEV_IFLASH_ERRNO_ALIGN;
+        return -1;
+    }
+    chunk = yDev_Iflash_PageMask(iflash_handle, offset, size);
+    if (chunk == 0U)
+    {
+        iflash_handle->base.errno |= YDEV_IFLASH_ERRNO_RANGE;
+        return -1;
+    }
+    if ((chunk & iflash_handle->erase_pending) != 0U)
+    {
+        iflash_handle->base.errno |= YDEV_IFLASH_ERRNO_PENDING;
+        return -1;
+    }
+
+    left = size;
+    while (left >= YDRV_FLASH_PROG_SIZE)
+    {
+        // 每次最多写到行末，单次挂起调度器不超过一行的编程时间
+        chunk = YDRV_FLASH_ROW_SIZE - (offset % YDRV_FLASH_ROW_SIZE);
+        if (chunk > left)
+        {
+            chunk = left & ~(YDRV_FLASH_PROG_SIZE - 1U);
+        }
+        if (yDev_Iflash_Program(iflash_handle, offset, src, chunk) != YDEV_OK)
+        {
+            return -1;
+        }
+        offset += chunk;
+        src += chunk;
+        left -= chunk;
+    }
+
+    if (left > 0U)
+    {
+        memset(tail, YDRV_FLASH_ERASED, sizeof(tail));
+        memcpy(tail, src, left);
+        if (yDev_Iflash_Program(iflash_handle, offset, tail, sizeof(tail)) != YDEV_OK)
+        {
+            return -1;
+        }
+        offset += sizeof(tail);
+    }
+
+    iflash_handle->address = offset;
+    return (int32_t)size;
+}
+
+/**
+ * @brief 片内Flash设备控制操作
+ * @param handle 片内Flash设备句柄
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 支持的命令:
+ * - YDEV_IFLASH_ERASE/YDEV_IFLASH_ERASE_ASYNC: 同步擦除、后台擦除
+ * - YDEV_IFLASH_ERASE_PENDING: 尚未擦除的页位图
+ * - YDEV_IFLASH_GET_STATS: 运行统计
+ * - YDEV_IOCTL_GET_STATUS: 有排队擦除时为YDEV_BUSY
+ */
+static yDevStatus_t yDev_Iflash_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_Iflash_t *iflash_handle;
+    const yDevIflashRange_t *range;
+    yDevStatus_t status = YDEV_OK;
+    uint32_t mask;
+    uint32_t page;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    iflash_handle = (yDevHandle_Iflash_t *)handle;
+    if (iflash_handle->start == 0U)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_IFLASH_ERASE:
+    case YDEV_IFLASH_ERASE_ASYNC:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        range = (const yDevIflashRange_t *)arg;
+        mask = yDev_Iflash_PageMask(iflash_handle, range->offset, range->size);
+        if (mask == 0U)
+        {
+            iflash_handle->base.errno |= YDEV_IFLASH_ERRNO_RANGE;
+            return YDEV_INVALID_PARAM;
+        }
+        if (cmd == YDEV_IFLASH_ERASE_ASYNC)
+        {
+            return yDev_Iflash_EraseAsync(iflash_handle, mask);
+        }
+        for (page = 0; mask != 0U; page++, mask >>= 1)
+        {
+            if (((mask & 1U) != 0U) && (yDev_Iflash_ErasePage(iflash_handle, page) != YDEV_OK))
+            {
+                status = YDEV_ERROR;
+            }
+        }
+        return status;
+
+    case YDEV_IFLASH_ERASE_PENDING:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = iflash_handle->erase_pending;
+        return YDEV_OK;
+
+    case YDEV_IFLASH_GET_STATS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(yDevIflashStats_t *)arg = iflash_handle->stats;
+        return YDEV_OK;
+
+    case YDEV_IOCTL_GET_STATUS:
+        if (arg != NULL)
+        {
+            *(yDevStatus_t *)arg = (iflash_handle->erase_pending != 0U) ? YDEV_BUSY : YDEV_OK;
+            return YDEV_OK;
+        }
+        return YDEV_INVALID_PARAM;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+// ==================== 设备操作表导出 ====================
+
+YDEV_OPS_EXPORT_EX(
+    YDEV_TYPE_IFLASH,   // 设备类型
+    yDev_Iflash_Init,   // 初始化函数
+    yDev_Iflash_Deinit, // 反初始化函数
+    yDev_Iflash_Read,   // 读取函数
+    yDev_Iflash_Write,  // 写入函数
+    yDev_Iflash_Ioctl)  // 控制函数
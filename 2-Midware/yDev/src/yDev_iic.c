@@ -0,0 +1,617 @@
+/**
+ * @file yDev_iic.c
+ * @brief yDev IIC主机设备驱动实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现基于yDev框架的IIC主机设备，把底层中断/DMA传输映射为同步和异步接口
+ *
+ * @par 实现说明:
+ * - 设备始终接管驱动回调，在其中统计结果、完成异步传输、唤醒等待任务并转调用户回调
+ * - 启动前关中断占用传输槽，同步和异步传输互斥，结束回调据此区分通知对象
+ * - 同步传输超时或总线错误后在任务中执行总线恢复，中断中不做忙等待
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_iic.h"
+#include "yDev_def.h"
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================== 私有定义 ====================
+
+/**
+ * @brief 同步传输占用标记，与异步方向共用async_dir
+ */
+#define YDEV_IIC_SYNC (0xFEU)
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 驱动传输结束回调
+ * @param arg IIC设备句柄
+ * @param result 传输结果
+ * @note 在I2C中断中执行
+ */
+static void yDev_Iic_Done(void *arg, yDrvI2cResult_t result)
+{
+    yDevHandle_Iic_t *iic_handle = (yDevHandle_Iic_t *)arg;
+    BaseType_t woken = pdFALSE;
+    uint8_t dir = iic_handle->async_dir;
+
+    iic_handle->stats.transfers++;
+    switch (result)
+    {
+    case YDRV_I2C_RESULT_OK:
+        break;
+    case YDRV_I2C_RESULT_NACK:
+        iic_handle->stats.nacks++;
+        break;
+    default:
+        iic_handle->stats.busErrors++;
+        break;
+    }
+
+    // 异步传输先释放占用再通知，完成回调中可以启动下一次传输
+    if ((dir == YDEV_ASYNC_READ) || (dir == YDEV_ASYNC_WRITE))
+    {
+        iic_handle->async_dir = YDEV_IIC_ASYNC_NONE;
+        yDevAsyncComplete(iic_handle, (yDevAsyncDir_t)dir,
+                          (result == YDRV_I2C_RESULT_OK) ? YDEV_OK : YDEV_ERROR,
+                          (result == YDRV_I2C_RESULT_OK) ? iic_handle->async_len : 0U);
+    }
+
+    if (iic_handle->wait_task != NULL)
+    {
+        vTaskNotifyGiveFromISR((TaskHandle_t)iic_handle->wait_task, &woken);
+    }
+
+    if (iic_handle->callback != NULL)
+    {
+        iic_handle->callback(iic_handle->arg, result);
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 占用传输槽
+ * @param iic_handle IIC设备句柄
+ * @param owner YDEV_IIC_SYNC或异步方向
+ * @retval yDevStatus_t YDEV_OK或已有传输YDEV_BUSY
+ */
+static yDevStatus_t yDev_Iic_Claim(yDevHandle_Iic_t *iic_handle, uint8_t owner)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if ((iic_handle->async_dir != YDEV_IIC_ASYNC_NONE) || yDrvI2cIsBusy(&iic_handle->drv_handle))
+    {
+        __set_PRIMASK(primask);
+        return YDEV_BUSY;
+    }
+    iic_handle->async_dir = owner;
+    __set_PRIMASK(primask);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 总线恢复并统计
+ * @param iic_handle IIC设备句柄
+ * @retval yDevStatus_t YDEV_OK或SDA仍被拉低YDEV_ERROR
+ */
+static yDevStatus_t yDev_Iic_Recover(yDevHandle_Iic_t *iic_handle)
+{
+    iic_handle->stats.recoveries++;
+    if (yDrvI2cRecover(&iic_handle->drv_handle) != YDRV_OK)
+    {
+        iic_handle->base.errno |= YDEV_IIC_ERRNO_STUCK;
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 启动传输，总线被占用时恢复后重试一次
+ * @param iic_handle IIC设备句柄
+ * @param xfer 传输描述
+ * @retval yDevStatus_t 启动状态
+ */
+static yDevStatus_t yDev_Iic_Start(yDevHandle_Iic_t *iic_handle, const yDevIicXfer_t *xfer)
+{
+    yDrvStatus_t status = yDevIicTransferFast(iic_handle, xfer);
+
+    // 驱动空闲却返回忙，说明SCL/SDA被拉低或上次传输异常中断；恢复需要忙等待，只在任务中进行
+    if ((status == YDRV_BUSY) && (__get_IPSR() == 0U))
+    {
+        (void)yDev_Iic_Recover(iic_handle);
+        status = yDevIicTransferFast(iic_handle, xfer);
+    }
+
+    switch (status)
+    {
+    case YDRV_OK:
+        return YDEV_OK;
+    case YDRV_BUSY:
+        return YDEV_BUSY;
+    case YDRV_INVALID_PARAM:
+        return YDEV_INVALID_PARAM;
+    default:
+        return YDEV_ERROR;
+    }
+}
+
+/**
+ * @brief 同步执行一次传输
+ * @param iic_handle IIC设备句柄
+ * @param xfer 传输描述
+ * @retval yDevStatus_t 传输结果
+ *         - YDEV_OK: 传输完成
+ *         - YDEV_ERROR: 未应答或总线错误，见base.errno
+ *         - YDEV_TIMEOUT: 超时，已中止并恢复总线
+ *         - YDEV_BUSY: 已有传输进行中
+ * @note 调度器运行时等待任务通知，否则轮询；超时由base.timeOutMs控制，0表示一直等待
+ */
+static yDevStatus_t yDev_Iic_Xfer(yDevHandle_Iic_t *iic_handle, const yDevIicXfer_t *xfer)
+{
+    yDrvI2cHandle_t *drv = &iic_handle->drv_handle;
+    uint32_t timeout = iic_handle->base.timeOutMs;
+    uint32_t scheduler;
+    uint32_t start_time;
+    uint32_t timed_out = 0;
+    yDevStatus_t status;
+
+    if (yDev_Iic_Claim(iic_handle, YDEV_IIC_SYNC) != YDEV_OK)
+    {
+        return YDEV_BUSY;
+    }
+
+    // 1. 先登记等待任务并清除旧通知，再启动传输
+    scheduler = ((xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) && (__get_IPSR() == 0U)) ? 1U : 0U;
+    if (scheduler)
+    {
+        iic_handle->wait_task = (void *)xTaskGetCurrentTaskHandle();
+        (void)ulTaskNotifyTake(pdTRUE, 0);
+    }
+
+    status = yDev_Iic_Start(iic_handle, xfer);
+    if (status != YDEV_OK)
+    {
+        iic_handle->wait_task = NULL;
+        iic_handle->async_dir = YDEV_IIC_ASYNC_NONE;
+        return status;
+    }
+
+    // 2. 等待结束中断
+    if (scheduler)
+    {
+        if (yDrvI2cIsBusy(drv) &&
+            (ulTaskNotifyTake(pdTRUE, (timeout == 0U) ? portMAX_DELAY : pdMS_TO_TICKS(timeout)) == 0U) &&
+            yDrvI2cIsBusy(drv))
+        {
+            timed_out = 1;
+        }
+        iic_handle->wait_task = NULL;
+    }
+    else
+    {
+        start_time = (uint32_t)yDevGetTimeMS();
+        while (yDrvI2cIsBusy(drv))
+        {
+            if ((timeout != 0U) && ((uint32_t)yDevGetTimeMS() - start_time >= timeout))
+            {
+                timed_out = 1;
+                break;
+            }
+        }
+    }
+
+    // 3. 超时中止并恢复，从机可能正拉住SDA
+    if (timed_out)
+    {
+        (void)yDrvI2cAbort(drv);
+        iic_handle->stats.timeouts++;
+        iic_handle->base.errno |= YDEV_IIC_ERRNO_TIMEOUT;
+        (void)yDev_Iic_Recover(iic_handle);
+        iic_handle->async_dir = YDEV_IIC_ASYNC_NONE;
+        return YDEV_TIMEOUT;
+    }
+
+    switch ((yDrvI2cResult_t)drv->result)
+    {
+    case YDRV_I2C_RESULT_OK:
+        status = YDEV_OK;
+        break;
+    case YDRV_I2C_RESULT_NACK:
+        iic_handle->base.errno |= YDEV_IIC_ERRNO_NACK;
+        status = YDEV_ERROR;
+        break;
+    case YDRV_I2C_RESULT_ABORT:
+        status = YDEV_ERROR;
+        break;
+    default:
+        iic_handle->base.errno |= YDEV_IIC_ERRNO_BUS;
+        (void)yDev_Iic_Recover(iic_handle);
+        status = YDEV_ERROR;
+        break;
+    }
+
+    iic_handle->async_dir = YDEV_IIC_ASYNC_NONE;
+
+    return status;
+}
+
+/**
+ * @brief 启动异步传输
+ * @param iic_handle IIC设备句柄
+ * @param dir 传输方向
+ * @param xfer 传输描述
+ * @param size 完成时报告的字节数
+ * @retval yDevStatus_t 启动状态
+ */
+static yDevStatus_t yDev_Iic_StartAsync(yDevHandle_Iic_t *iic_handle, yDevAsyncDir_t dir,
+                                        const yDevIicXfer_t *xfer, uint32_t size)
+{
+    yDevStatus_t status;
+
+    if (iic_handle->drv_handle.instance == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    if (yDev_Iic_Claim(iic_handle, (uint8_t)dir) != YDEV_OK)
+    {
+        return YDEV_BUSY;
+    }
+
+    iic_handle->async_len = size;
+    status = yDev_Iic_Start(iic_handle, xfer);
+    if (status != YDEV_OK)
+    {
+        iic_handle->async_dir = YDEV_IIC_ASYNC_NONE;
+    }
+
+    return status;
+}
+
+// ==================== IIC设备操作函数 ====================
+
+/**
+ * @brief IIC设备初始化
+ * @param config IIC设备配置参数
+ * @param handle IIC设备句柄
+ * @return yDevStatus_t 初始化状态
+ */
+static yDevStatus_t yDev_Iic_Init(void *config, void *handle)
+{
+    yDevConfig_Iic_t *iic_config;
+    yDevHandle_Iic_t *iic_handle;
+    yDrvI2cConfig_t drv_config;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    iic_handle = (yDevHandle_Iic_t *)handle;
+    iic_config = (yDevConfig_Iic_t *)config;
+
+    if (iic_config->addr > 0x7FU)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 设备接管驱动回调，用户回调由设备回调转调
+    drv_config = iic_config->drv_config;
+    drv_config.callback = yDev_Iic_Done;
+    drv_config.arg = iic_handle;
+
+    if (yDrvI2cInitStatic(&drv_config, &iic_handle->drv_handle) != YDRV_OK)
+    {
+        iic_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_ERROR;
+    }
+
+    iic_handle->callback = iic_config->drv_config.callback;
+    iic_handle->arg = iic_config->drv_config.arg;
+    iic_handle->addr = iic_config->addr;
+    iic_handle->async_dir = YDEV_IIC_ASYNC_NONE;
+    iic_handle->async_len = 0;
+    iic_handle->wait_task = NULL;
+    memset(&iic_handle->stats, 0, sizeof(iic_handle->stats));
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief IIC设备反初始化
+ * @param handle IIC设备句柄
+ * @return yDevStatus_t 操作状态
+ * @note 进行中的异步传输以错误结束
+ */
+static yDevStatus_t yDev_Iic_Deinit(void *handle)
+{
+    yDevHandle_Iic_t *iic_handle;
+    uint8_t dir;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    iic_handle = (yDevHandle_Iic_t *)handle;
+    dir = iic_handle->async_dir;
+
+    if (yDrvI2cDeInitStatic(&iic_handle->drv_handle) != YDRV_OK)
+    {
+        iic_handle->base.errno = YDEV_ERRNO_NOT_DEINIT;
+        return YDEV_ERROR;
+    }
+
+    iic_handle->async_dir = YDEV_IIC_ASYNC_NONE;
+    if ((dir == YDEV_ASYNC_READ) || (dir == YDEV_ASYNC_WRITE))
+    {
+        yDevAsyncComplete(iic_handle, (yDevAsyncDir_t)dir, YDEV_ERROR, 0);
+    }
+
+    return YDEV_OK;
+}
+
+void yDevIicConfigStructInit(yDevConfig_Iic_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础配置
+    yDevConfigStructInit(&config->base);
+    config->base.type = YDEV_TYPE_IIC;
+
+    // 初始化驱动配置
+    yDrvI2cConfigStructInit(&config->drv_config);
+    config->addr = 0;
+}
+
+void yDevIicHandleStructInit(yDevHandle_Iic_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础句柄
+    yDevHandleStructInit(&handle->base);
+
+    // 初始化驱动句柄
+    yDrvI2cHandleStructInit(&handle->drv_handle);
+    handle->callback = NULL;
+    handle->arg = NULL;
+    handle->addr = 0;
+    handle->async_dir = YDEV_IIC_ASYNC_NONE;
+    handle->async_len = 0;
+    handle->wait_task = NULL;
+    memset(&handle->stats, 0, sizeof(handle->stats));
+}
+
+/**
+ * @brief IIC设备读取操作
+ * @param handle IIC设备句柄
+ * @param buffer 读取缓冲区
+ * @param size 读取字节数(1~65535)
+ * @return int32_t 实际读取的字节数，-1表示错误
+ *
+ * @par 功能描述:
+ * 从当前从机地址直接读取，读寄存器请使用YDEV_IIC_TRANSFER
+ */
+static int32_t yDev_Iic_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Iic_t *iic_handle;
+    yDevIicXfer_t xfer;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0U))
+    {
+        return -1;
+    }
+
+    iic_handle = (yDevHandle_Iic_t *)handle;
+    if (iic_handle->drv_handle.instance == NULL)
+    {
+        return -1;
+    }
+
+    xfer.wbuf = NULL;
+    xfer.wlen = 0;
+    xfer.rbuf = buffer;
+    xfer.rlen = size;
+
+    return (yDev_Iic_Xfer(iic_handle, &xfer) == YDEV_OK) ? (int32_t)size : -1;
+}
+
+/**
+ * @brief IIC设备写入操作
+ * @param handle IIC设备句柄
+ * @param buffer 写入数据
+ * @param size 写入字节数(1~65535)
+ * @return int32_t 实际写入的字节数，-1表示错误
+ */
+static int32_t yDev_Iic_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_Iic_t *iic_handle;
+    yDevIicXfer_t xfer;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0U))
+    {
+        return -1;
+    }
+
+    iic_handle = (yDevHandle_Iic_t *)handle;
+    if (iic_handle->drv_handle.instance == NULL)
+    {
+        return -1;
+    }
+
+    xfer.wbuf = buffer;
+    xfer.wlen = size;
+    xfer.rbuf = NULL;
+    xfer.rlen = 0;
+
+    return (yDev_Iic_Xfer(iic_handle, &xfer) == YDEV_OK) ? (int32_t)size : -1;
+}
+
+/**
+ * @brief IIC设备异步读取
+ * @param handle IIC设备句柄
+ * @param buffer 读取缓冲区，完成前必须保持有效
+ * @param size 读取字节数(1~65535)
+ * @return yDevStatus_t 启动状态
+ */
+static yDevStatus_t yDev_Iic_ReadAsync(void *handle, void *buffer, size_t size)
+{
+    yDevIicXfer_t xfer = {.wbuf = NULL, .wlen = 0, .rbuf = buffer, .rlen = size};
+
+    if ((buffer == NULL) || (size == 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    return yDev_Iic_StartAsync((yDevHandle_Iic_t *)handle, YDEV_ASYNC_READ, &xfer, size);
+}
+
+/**
+ * @brief IIC设备异步写入
+ * @param handle IIC设备句柄
+ * @param buffer 写入数据，完成前必须保持有效
+ * @param size 写入字节数(1~65535)
+ * @return yDevStatus_t 启动状态
+ */
+static yDevStatus_t yDev_Iic_WriteAsync(void *handle, const void *buffer, size_t size)
+{
+    yDevIicXfer_t xfer = {.wbuf = buffer, .wlen = size, .rbuf = NULL, .rlen = 0};
+
+    if ((buffer == NULL) || (size == 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    return yDev_Iic_StartAsync((yDevHandle_Iic_t *)handle, YDEV_ASYNC_WRITE, &xfer, size);
+}
+
+/**
+ * @brief IIC设备控制操作
+ * @param handle IIC设备句柄
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 支持的命令:
+ * - YDEV_IIC_TRANSFER: 写-读组合传输
+ * - YDEV_IIC_SET_ADDR/YDEV_IIC_SET_SPEED: 从机地址和总线速率
+ * - YDEV_IIC_PROBE/YDEV_IIC_RECOVER: 探测从机、总线恢复
+ * - YDEV_IIC_GET_STATS: 运行统计
+ * - YDEV_IOCTL_GET_STATUS: 获取设备状态
+ * - YDEV_IOCTL_RESET: 空闲时恢复总线
+ */
+static yDevStatus_t yDev_Iic_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_Iic_t *iic_handle;
+    yDevIicXfer_t probe = {0};
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    iic_handle = (yDevHandle_Iic_t *)handle;
+    if (iic_handle->drv_handle.instance == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_IIC_TRANSFER:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        return yDev_Iic_Xfer(iic_handle, (const yDevIicXfer_t *)arg);
+
+    case YDEV_IIC_SET_ADDR:
+        if ((arg == NULL) || (*(uint16_t *)arg > 0x7FU))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        iic_handle->addr = *(uint16_t *)arg;
+        return YDEV_OK;
+
+    case YDEV_IIC_SET_SPEED:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        switch (yDrvI2cSetSpeed(&iic_handle->drv_handle, *(yDrvI2cSpeed_t *)arg))
+        {
+        case YDRV_OK:
+            return YDEV_OK;
+        case YDRV_BUSY:
+            return YDEV_BUSY;
+        default:
+            return YDEV_INVALID_PARAM;
+        }
+
+    case YDEV_IIC_PROBE:
+        return yDev_Iic_Xfer(iic_handle, &probe);
+
+    case YDEV_IIC_RECOVER:
+    case YDEV_IOCTL_RESET:
+        if (iic_handle->async_dir != YDEV_IIC_ASYNC_NONE)
+        {
+            return YDEV_BUSY;
+        }
+        return yDev_Iic_Recover(iic_handle);
+
+    case YDEV_IIC_GET_STATS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(yDevIicStats_t *)arg = iic_handle->stats;
+        return YDEV_OK;
+
+    case YDEV_IOCTL_GET_STATUS:
+        if (arg != NULL)
+        {
+            *(yDevStatus_t *)arg = yDrvI2cIsBusy(&iic_handle->drv_handle) ? YDEV_BUSY : YDEV_OK;
+            return YDEV_OK;
+        }
+        return YDEV_INVALID_PARAM;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+// ==================== 设备操作表导出 ====================
+
+YDEV_OPS_EXPORT_ASYNC(
+    YDEV_TYPE_IIC,       // 设备类型
+    yDev_Iic_Init,       // 初始化函数
+    yDev_Iic_Deinit,     // 反初始化函数
+    yDev_Iic_Read,       // 读取函数
+    yDev_Iic_Write,      // 写入函数
+    yDev_Iic_Ioctl,      // 控制函数
+    yDev_Iic_ReadAsync,  // 异步读取函数
+    yDev_Iic_WriteAsync) // 异步写入函数
@@ -0,0 +1,647 @@
+/**
+ * @file yDev_keypad.c
+ * @brief yDev 矩阵键盘扫描设备实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 行切换和列采样全部由TIM14节拍触发的DMA完成，CPU只在每轮扫描结束时进一次中断做消抖
+ *
+ * @par 实现说明:
+ * - 行表第k项选中第k+1行：第k个比较事件先采样第k行，再切到第k+1行，采样缓冲区第k项对应第k%行数行
+ * - 启动前由CPU选中第0行，计数器从0开始，第一个下降沿即采样第0行
+ * - 消抖计数器为两个位平面，每位对应一列，某列的采样与稳定电平连续4轮不同时翻转并产生事件
+ * - 事件队列为单生产者(DMA中断)单消费者(读取任务)环形缓冲区，不需要关中断
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_keypad.h"
+#include "yDev_def.h"
+
+#include <string.h>
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 启动扫描
+ * @param keypad_handle 矩阵键盘句柄
+ * @retval yDevStatus_t 启动状态
+ */
+static yDevStatus_t yDev_Keypad_Start(yDevHandle_Keypad_t *keypad_handle);
+
+/**
+ * @brief 停止扫描，行全部释放
+ * @param keypad_handle 矩阵键盘句柄
+ */
+static void yDev_Keypad_Stop(yDevHandle_Keypad_t *keypad_handle);
+
+/**
+ * @brief 释放初始化中已占用的资源
+ * @param keypad_handle 矩阵键盘句柄
+ */
+static void yDev_Keypad_Release(yDevHandle_Keypad_t *keypad_handle);
+
+/**
+ * @brief 处理一整轮扫描的采样
+ * @param keypad_handle 矩阵键盘句柄
+ * @param sample 本轮各行的列IDR采样
+ * @note DMA中断中执行
+ */
+static void yDev_Keypad_Scan(yDevHandle_Keypad_t *keypad_handle, const uint16_t *sample);
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 处理一整轮扫描的采样实现
+ */
+static void yDev_Keypad_Scan(yDevHandle_Keypad_t *keypad_handle, const uint16_t *sample)
+{
+    yDevKeypadEvent_t *event;
+    uint32_t row;
+    uint32_t col;
+    uint32_t idr;
+    uint8_t raw;
+    uint8_t change;
+    uint8_t ct0;
+    uint8_t ct1;
+    uint8_t signal = 0;
+
+    for (row = 0; row < keypad_handle->rows; row++)
+    {
+        // 1. 列采样转为按下位图，上拉输入低为按下
+        idr = ~(uint32_t)sample[row];
+        if (keypad_handle->colShift != 0xFFU)
+        {
+            raw = (uint8_t)((idr >> keypad_handle->colShift) & ((1UL << keypad_handle->cols) - 1U));
+        }
+        else
+        {
+            raw = 0;
+            for (col = 0; col < keypad_handle->cols; col++)
+            {
+                if ((idr & keypad_handle->colBit[col]) != 0U)
+                {
+                    raw |= (uint8_t)(1U << col);
+                }
+            }
+        }
+
+        // 2. 位并行消抖：与稳定电平相同的列计数器复位，不同的列计数，第4轮翻转
+        change = keypad_handle->state[row] ^ raw;
+        ct0 = (uint8_t)~(keypad_handle->cnt0[row] & change);
+        ct1 = (uint8_t)(ct0 ^ (keypad_handle->cnt1[row] & change));
+        keypad_handle->cnt0[row] = ct0;
+        keypad_handle->cnt1[row] = ct1;
+        change &= ct0 & ct1;
+        if (change == 0U)
+        {
+            continue;
+        }
+        keypad_handle->state[row] ^= change;
+
+        // 3. 每个翻转的列产生一个事件
+        for (col = 0; change != 0U; col++, change >>= 1)
+        {
+            if ((change & 1U) == 0U)
+            {
+                continue;
+            }
+            keypad_handle->stats.events++;
+            if ((keypad_handle->tail - keypad_handle->head) >= YDEV_KEYPAD_EVENT_LEN)
+            {
+                keypad_handle->stats.lost++;
+                keypad_handle->base.errno |= YDEV_KEYPAD_ERRNO_LOST;
+                continue;
+            }
+            event = &keypad_handle->event[keypad_handle->tail & (YDEV_KEYPAD_EVENT_LEN - 1U)];
+            event->key = (uint8_t)(row * keypad_handle->cols + col);
+            event->row = (uint8_t)row;
+            event->col = (uint8_t)col;
+            event->pressed = (uint8_t)((keypad_handle->state[row] >> col) & 1U);
+            event->time_us = yDevGetTimeUS();
+            keypad_handle->tail++;
+            signal = 1;
+        }
+    }
+
+    keypad_handle->stats.scans++;
+    if (signal != 0U)
+    {
+        yDevPollSignal(keypad_handle, 0);
+    }
+}
+
+/**
+ * @brief 采样DMA半传输中断，采样缓冲区前半为一整轮
+ * @param arg 矩阵键盘句柄
+ */
+static void yDev_Keypad_HalfIrq(void *arg)
+{
+    yDevHandle_Keypad_t *keypad_handle = (yDevHandle_Keypad_t *)arg;
+
+    yDev_Keypad_Scan(keypad_handle, &keypad_handle->sample[0]);
+}
+
+/**
+ * @brief 采样DMA传输完成中断，采样缓冲区后半为一整轮
+ * @param arg 矩阵键盘句柄
+ */
+static void yDev_Keypad_FullIrq(void *arg)
+{
+    yDevHandle_Keypad_t *keypad_handle = (yDevHandle_Keypad_t *)arg;
+
+    yDev_Keypad_Scan(keypad_handle, &keypad_handle->sample[keypad_handle->rows]);
+}
+
+/**
+ * @brief 采样DMA传输错误中断
+ * @param arg 矩阵键盘句柄
+ * @note 行和采样失去对应关系，停止扫描，由使用者重新启动
+ */
+static void yDev_Keypad_ErrorIrq(void *arg)
+{
+    yDevHandle_Keypad_t *keypad_handle = (yDevHandle_Keypad_t *)arg;
+
+    yDev_Keypad_Stop(keypad_handle);
+    keypad_handle->base.errno |= YDEV_KEYPAD_ERRNO_DMA;
+    yDevPollSignal(keypad_handle, YDEV_POLLERR);
+}
+
+/**
+ * @brief 启动扫描实现
+ */
+static yDevStatus_t yDev_Keypad_Start(yDevHandle_Keypad_t *keypad_handle)
+{
+    uint32_t row;
+
+    if (keypad_handle->running != 0U)
+    {
+        return YDEV_OK;
+    }
+
+    // 1. 消抖状态从全部松开开始，启动时已按住的键在4轮后上报按下
+    for (row = 0; row < keypad_handle->rows; row++)
+    {
+        keypad_handle->state[row] = 0;
+        keypad_handle->cnt0[row] = 0xFF;
+        keypad_handle->cnt1[row] = 0xFF;
+    }
+
+    // 2. 行表最后一项选中第0行，由CPU先写入
+    keypad_handle->row.port->BSRR = keypad_handle->rowBsrr[keypad_handle->rows - 1U];
+
+    // 3. 两个通道从缓冲区起点开始，先使能DMA和生成器，再启动定时器
+    yDrvDmaTransDisable(&keypad_handle->sampleDma);
+    yDrvDmaTransDisable(&keypad_handle->rowDma);
+    yDrvDmaDstBufferLen(&keypad_handle->sampleDma, 2U * keypad_handle->rows);
+    yDrvDmaDstBufferLen(&keypad_handle->rowDma, keypad_handle->rows);
+    yDrvDmaClearFlags(&keypad_handle->sampleDma);
+    yDrvDmaClearFlags(&keypad_handle->rowDma);
+    yDrvDmaTransEnable(&keypad_handle->sampleDma);
+    yDrvDmaTransEnable(&keypad_handle->rowDma);
+    yDrvDmaGenEnable(&keypad_handle->sampleGen);
+    yDrvDmaGenEnable(&keypad_handle->rowGen);
+
+    keypad_handle->running = 1;
+    if (yDrvTimStart(&keypad_handle->tim) != YDRV_OK)
+    {
+        yDev_Keypad_Stop(keypad_handle);
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 停止扫描实现
+ * @note 先关生成器再停定时器，关闭通道输出产生的边沿不会再请求DMA
+ */
+static void yDev_Keypad_Stop(yDevHandle_Keypad_t *keypad_handle)
+{
+    yDrvDmaGenDisable(&keypad_handle->sampleGen);
+    yDrvDmaGenDisable(&keypad_handle->rowGen);
+    (void)yDrvTimStop(&keypad_handle->tim);
+    yDrvDmaTransDisable(&keypad_handle->sampleDma);
+    yDrvDmaTransDisable(&keypad_handle->rowDma);
+    keypad_handle->row.port->BSRR = keypad_handle->row.mask;
+    keypad_handle->running = 0;
+}
+
+/**
+ * @brief 释放初始化中已占用的资源实现
+ */
+static void yDev_Keypad_Release(yDevHandle_Keypad_t *keypad_handle)
+{
+    if (keypad_handle->sampleDma.index < YDRV_DMA_CHANNEL_MAX)
+    {
+        (void)yDrvDmaDeInitStatic(&keypad_handle->sampleDma);
+    }
+    if (keypad_handle->rowDma.index < YDRV_DMA_CHANNEL_MAX)
+    {
+        (void)yDrvDmaDeInitStatic(&keypad_handle->rowDma);
+    }
+    if (keypad_handle->sampleGen.index < YDRV_DMA_GEN_MAX)
+    {
+        (void)yDrvDmaGenDeInit(&keypad_handle->sampleGen);
+    }
+    if (keypad_handle->rowGen.index < YDRV_DMA_GEN_MAX)
+    {
+        (void)yDrvDmaGenDeInit(&keypad_handle->rowGen);
+    }
+    if (keypad_handle->tim.instance != NULL)
+    {
+        (void)yDrvTimDeInitStatic(&keypad_handle->tim);
+    }
+    if (keypad_handle->row.port != NULL)
+    {
+        (void)yDrvGpioPortDeInitStatic(&keypad_handle->row);
+    }
+    if (keypad_handle->col.port != NULL)
+    {
+        (void)yDrvGpioPortDeInitStatic(&keypad_handle->col);
+    }
+
+    keypad_handle->sampleDma = YDRV_DMA_HANDLE_DEFAULT();
+    keypad_handle->rowDma = YDRV_DMA_HANDLE_DEFAULT();
+    keypad_handle->sampleGen = YDRV_DMA_GEN_HANDLE_DEFAULT();
+    keypad_handle->rowGen = YDRV_DMA_GEN_HANDLE_DEFAULT();
+    keypad_handle->tim = YDRV_TIM_HANDLE_DEFAULT();
+    keypad_handle->row = YDRV_GPIO_PORT_HANDLE_DEFAULT();
+    keypad_handle->col = YDRV_GPIO_PORT_HANDLE_DEFAULT();
+}
+
+// ==================== 矩阵键盘设备操作函数 ====================
+
+/**
+ * @brief 矩阵键盘设备初始化
+ * @param config 矩阵键盘设备配置参数
+ * @param handle 矩阵键盘设备句柄
+ * @return yDevStatus_t 初始化状态
+ *
+ * @par 功能描述:
+ * 配置行列端口组、TIM14节拍、两个请求生成器和两个DMA通道，初始化完成后即开始扫描
+ */
+static yDevStatus_t yDev_Keypad_Init(void *config, void *handle)
+{
+    yDevConfig_Keypad_t *keypad_config;
+    yDevHandle_Keypad_t *keypad_handle;
+    yDrvGpioPortConfig_t port_config;
+    yDrvTimConfig_t tim_config;
+    yDrvDmaGenConfig_t gen_config;
+    yDrvDmaConfig_t dma_config;
+    yDrvDmaExtiConfig_t dma_exti;
+    uint16_t row_bit[YDEV_KEYPAD_ROWS_MAX];
+    uint32_t bit;
+    uint32_t n;
+    uint32_t k;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    keypad_handle = (yDevHandle_Keypad_t *)handle;
+    keypad_config = (yDevConfig_Keypad_t *)config;
+
+    keypad_handle->rows = (uint8_t)__builtin_popcount(keypad_config->rowMask);
+    keypad_handle->cols = (uint8_t)__builtin_popcount(keypad_config->colMask);
+    if ((keypad_handle->rows == 0U) || (keypad_handle->rows > YDEV_KEYPAD_ROWS_MAX) ||
+        (keypad_handle->cols == 0U) || (keypad_handle->cols > YDEV_KEYPAD_COLS_MAX) ||
+        (keypad_config->rowHz < 16U) || (keypad_config->rowHz > 100000U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    keypad_handle->row = YDRV_GPIO_PORT_HANDLE_DEFAULT();
+    keypad_handle->col = YDRV_GPIO_PORT_HANDLE_DEFAULT();
+    keypad_handle->tim = YDRV_TIM_HANDLE_DEFAULT();
+    keypad_handle->sampleGen = YDRV_DMA_GEN_HANDLE_DEFAULT();
+    keypad_handle->rowGen = YDRV_DMA_GEN_HANDLE_DEFAULT();
+    keypad_handle->sampleDma = YDRV_DMA_HANDLE_DEFAULT();
+    keypad_handle->rowDma = YDRV_DMA_HANDLE_DEFAULT();
+    keypad_handle->head = 0;
+    keypad_handle->tail = 0;
+    keypad_handle->running = 0;
+    memset(&keypad_handle->stats, 0, sizeof(keypad_handle->stats));
+
+    // 1. 行开漏输出，初始化后全部释放；列上拉输入
+    port_config = YDRV_GPIO_PORT_CONFIG_DEFAULT();
+    port_config.pin = keypad_config->rowPin;
+    port_config.mask = keypad_config->rowMask;
+    port_config.mode = YDRV_GPIO_MODE_OUTPUT_OD;
+    if (yDrvGpioPortInitStatic(&port_config, &keypad_handle->row) != YDRV_OK)
+    {
+        keypad_handle->row = YDRV_GPIO_PORT_HANDLE_DEFAULT();
+        return YDEV_INVALID_PARAM;
+    }
+    keypad_handle->row.port->BSRR = keypad_handle->row.mask;
+
+    port_config.pin = keypad_config->colPin;
+    port_config.mask = keypad_config->colMask;
+    port_config.mode = YDRV_GPIO_MODE_INPUT;
+    port_config.pupd = YDRV_GPIO_PUPD_PULLUP;
+    if (yDrvGpioPortInitStatic(&port_config, &keypad_handle->col) != YDRV_OK)
+    {
+        keypad_handle->col = YDRV_GPIO_PORT_HANDLE_DEFAULT();
+        yDev_Keypad_Release(keypad_handle);
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 2. 行表和列位：第k项选中第k+1行；列引脚连续时整体移位取列位图
+    for (bit = 0, n = 0; bit < 16U; bit++)
+    {
+        if ((keypad_handle->row.mask & (1UL << bit)) != 0U)
+        {
+            row_bit[n++] = (uint16_t)(1UL << bit);
+        }
+    }
+    for (k = 0; k < keypad_handle->rows; k++)
+    {
+        n = row_bit[(k + 1U) % keypad_handle->rows];
+        keypad_handle->rowBsrr[k] = (n << 16) | (keypad_handle->row.mask & ~n);
+    }
+    for (bit = 0, n = 0; bit < 16U; bit++)
+    {
+        if ((keypad_handle->col.mask & (1UL << bit)) != 0U)
+        {
+            keypad_handle->colBit[n++] = (uint16_t)(1UL << bit);
+        }
+    }
+    keypad_handle->colShift = (keypad_config->colMask == ((1UL << keypad_handle->cols) - 1U))
+                                  ? keypad_handle->col.shift
+                                  : 0xFFU;
+
+    // 3. TIM14节拍，比较事件在周期中点，只用作请求生成器的触发信号
+    tim_config = YDRV_TIM_CONFIG_DEFAULT();
+    tim_config.timId = YDRV_TIM_14;
+    tim_config.channel = YDRV_TIM_CH1;
+    tim_config.mode = YDRV_TIM_MODE_PWM;
+    tim_config.pin = YDRV_PINNULL;
+    tim_config.tickHz = 1000000U;
+    tim_config.period = 1000000U / keypad_config->rowHz;
+    tim_config.pulse = tim_config.period / 2U;
+    if (yDrvTimInitStatic(&tim_config, &keypad_handle->tim) != YDRV_OK)
+    {
+        keypad_handle->tim = YDRV_TIM_HANDLE_DEFAULT();
+        yDev_Keypad_Release(keypad_handle);
+        return YDEV_ERROR;
+    }
+
+    // 4. 两个请求生成器都由比较事件的下降沿触发
+    gen_config = YDRV_DMA_GEN_CONFIG_DEFAULT();
+    gen_config.signal = YDRV_DMA_SIGNAL_TIM14_OC;
+    gen_config.edge = YDRV_DMA_EDGE_FALLING;
+    gen_config.nbreq = 1;
+    gen_config.prio = keypad_config->prio;
+    gen_config.owner = "keypad";
+    if ((yDrvDmaGenInit(&gen_config, &keypad_handle->sampleGen) != YDRV_OK) ||
+        (yDrvDmaGenInit(&gen_config, &keypad_handle->rowGen) != YDRV_OK))
+    {
+        yDev_Keypad_Release(keypad_handle);
+        return YDEV_BUSY;
+    }
+
+    // 5. 采样通道优先级高于行通道，同一事件中先采样后切行
+    dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    dma_config.request = keypad_handle->sampleGen.request;
+    dma_config.priority = YDRV_DMA_PRIORITY_VERY_HIGH;
+    dma_config.mode = YDRV_DMA_MODE_CIRCULAR;
+    dma_config.dst_width = YDRV_DMA_WIDTH_16BIT;
+    dma_config.dst_buffer = keypad_handle->sample;
+    dma_config.trans_len = 2U * keypad_handle->rows;
+    dma_config.owner = "keypad";
+    if (yDrvDmaInitStatic(&dma_config, &keypad_handle->sampleDma, YDRV_DMA_DIR_P2M) != YDRV_OK)
+    {
+        keypad_handle->sampleDma = YDRV_DMA_HANDLE_DEFAULT();
+        yDev_Keypad_Release(keypad_handle);
+        return YDEV_BUSY;
+    }
+    yDrvDmaSrcBufferSet(&keypad_handle->sampleDma, (void *)&keypad_handle->col.port->IDR, YDRV_DMA_WIDTH_16BIT);
+    LL_DMA_SetPeriphIncMode(keypad_handle->sampleDma.DmaInfo.dma, keypad_handle->sampleDma.DmaInfo.channel,
+                            LL_DMA_PERIPH_NOINCREMENT);
+
+    dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    dma_config.request = keypad_handle->rowGen.request;
+    dma_config.priority = YDRV_DMA_PRIORITY_HIGH;
+    dma_config.mode = YDRV_DMA_MODE_CIRCULAR;
+    dma_config.src_width = YDRV_DMA_WIDTH_32BIT;
+    dma_config.src_buffer = keypad_handle->rowBsrr;
+    dma_config.trans_len = keypad_handle->rows;
+    dma_config.owner = "keypad";
+    if (yDrvDmaInitStatic(&dma_config, &keypad_handle->rowDma, YDRV_DMA_DIR_M2P) != YDRV_OK)
+    {
+        keypad_handle->rowDma = YDRV_DMA_HANDLE_DEFAULT();
+        yDev_Keypad_Release(keypad_handle);
+        return YDEV_BUSY;
+    }
+    yDrvDmaSrcBufferSet(&keypad_handle->rowDma, (void *)&keypad_handle->row.port->BSRR, YDRV_DMA_WIDTH_32BIT);
+    LL_DMA_SetPeriphIncMode(keypad_handle->rowDma.DmaInfo.dma, keypad_handle->rowDma.DmaInfo.channel,
+                            LL_DMA_PERIPH_NOINCREMENT);
+
+    // 6. 采样DMA每半个缓冲区(一整轮)进一次中断
+    dma_exti = YDRV_DMA_EXTI_CONFIG_DEFAULT();
+    dma_exti.prio = keypad_config->prio;
+    dma_exti.arg = keypad_handle;
+    dma_exti.enable = 1;
+    dma_exti.trigger = YDRV_DMA_EXTI_HT;
+    dma_exti.function = yDev_Keypad_HalfIrq;
+    yDrvDmaRegisterCallback(&keypad_handle->sampleDma, &dma_exti);
+    dma_exti.trigger = YDRV_DMA_EXTI_TC;
+    dma_exti.function = yDev_Keypad_FullIrq;
+    yDrvDmaRegisterCallback(&keypad_handle->sampleDma, &dma_exti);
+    dma_exti.trigger = YDRV_DMA_EXTI_TE;
+    dma_exti.function = yDev_Keypad_ErrorIrq;
+    yDrvDmaRegisterCallback(&keypad_handle->sampleDma, &dma_exti);
+
+    if (yDev_Keypad_Start(keypad_handle) != YDEV_OK)
+    {
+        yDev_Keypad_Release(keypad_handle);
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 矩阵键盘设备反初始化
+ * @param handle 矩阵键盘设备句柄
+ * @return yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_Keypad_Deinit(void *handle)
+{
+    yDevHandle_Keypad_t *keypad_handle;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    keypad_handle = (yDevHandle_Keypad_t *)handle;
+    if (keypad_handle->row.port == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    yDev_Keypad_Stop(keypad_handle);
+    yDev_Keypad_Release(keypad_handle);
+
+    return YDEV_OK;
+}
+
+void yDevKeypadConfigStructInit(yDevConfig_Keypad_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    *config = YDEV_KEYPAD_CONFIG_DEFAULT();
+}
+
+void yDevKeypadHandleStructInit(yDevHandle_Keypad_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    memset(handle, 0, sizeof(yDevHandle_Keypad_t));
+    *handle = YDEV_KEYPAD_HANDLE_DEFAULT();
+}
+
+/**
+ * @brief 矩阵键盘设备读取操作
+ * @param handle 矩阵键盘设备句柄
+ * @param buffer 事件缓冲区(yDevKeypadEvent_t数组)
+ * @param size 缓冲区字节数，至少一个事件
+ * @return int32_t 读取的字节数(事件大小的整数倍)，0表示没有事件，-1表示错误
+ * @note 不等待，没有事件时用yDevPoll等待YDEV_POLLIN
+ */
+static int32_t yDev_Keypad_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Keypad_t *keypad_handle;
+    yDevKeypadEvent_t *event;
+    uint32_t head;
+    uint32_t count = 0;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size < sizeof(yDevKeypadEvent_t)))
+    {
+        return -1;
+    }
+
+    keypad_handle = (yDevHandle_Keypad_t *)handle;
+    if (keypad_handle->row.port == NULL)
+    {
+        return -1;
+    }
+
+    event = (yDevKeypadEvent_t *)buffer;
+    head = keypad_handle->head;
+    while ((count < (size / sizeof(yDevKeypadEvent_t))) && (head != keypad_handle->tail))
+    {
+        event[count++] = keypad_handle->event[head & (YDEV_KEYPAD_EVENT_LEN - 1U)];
+        head++;
+    }
+    keypad_handle->head = head;
+
+    return (int32_t)(count * sizeof(yDevKeypadEvent_t));
+}
+
+/**
+ * @brief 矩阵键盘设备控制操作
+ * @param handle 矩阵键盘设备句柄
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 支持的命令:
+ * - YDEV_KEYPAD_START/STOP: 启动/停止扫描
+ * - YDEV_KEYPAD_GET_STATE: 获取按下位图
+ * - YDEV_KEYPAD_GET_STATS: 获取运行统计
+ * - YDEV_IOCTL_POLL: 有未读事件时为YDEV_POLLIN
+ */
+static yDevStatus_t yDev_Keypad_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_Keypad_t *keypad_handle;
+    uint64_t state;
+    uint32_t row;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    keypad_handle = (yDevHandle_Keypad_t *)handle;
+    if (keypad_handle->row.port == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_KEYPAD_START:
+        return yDev_Keypad_Start(keypad_handle);
+
+    case YDEV_KEYPAD_STOP:
+        if (keypad_handle->running != 0U)
+        {
+            yDev_Keypad_Stop(keypad_handle);
+        }
+        return YDEV_OK;
+
+    case YDEV_KEYPAD_GET_STATE:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        state = 0;
+        for (row = 0; row < keypad_handle->rows; row++)
+        {
+            state |= (uint64_t)keypad_handle->state[row] << (row * keypad_handle->cols);
+        }
+        *(uint64_t *)arg = state;
+        return YDEV_OK;
+
+    case YDEV_KEYPAD_GET_STATS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(yDevKeypadStats_t *)arg = keypad_handle->stats;
+        return YDEV_OK;
+
+    case YDEV_IOCTL_POLL:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = (keypad_handle->head != keypad_handle->tail) ? YDEV_POLLIN : 0U;
+        return YDEV_OK;
+
+    case YDEV_IOCTL_GET_STATUS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(yDevStatus_t *)arg = (keypad_handle->running != 0U) ? YDEV_OK : YDEV_NOT_INITIALIZED;
+        return YDEV_OK;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+// ==================== 设备操作表导出 ====================
+
+YDEV_OPS_EXPORT_EX(
+    YDEV_TYPE_KEYPAD,   // 设备类型
+    yDev_Keypad_Init,   // 初始化函数
+    yDev_Keypad_Deinit, // 反初始化函数
+    yDev_Keypad_Read,   // 读取函数
+    NULL,               // 写入函数
+    yDev_Keypad_Ioctl); // 控制函数
@@ -0,0 +1,1034 @@
+/**
+ * @file yDev_kv.c
+ * @brief 基于25Q Flash的日志结构键值存储实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 在yDev 25Q设备之上实现追加写入的键值存储，记录顺序写入当前扇区，
+ * RAM红黑树索引每个有效键的最新记录地址
+ *
+ * @par 主要功能:
+ * - 挂载时按扇区序号顺序扫描记录，后写入者覆盖先写入者，墓碑删除键
+ * - 写入/删除只追加一条记录，记录头+键+值尽量合并为一次编程，长记录先写记录头，
+ *   CRC覆盖键+值，值未写完时记录校验失败，挂载时按记录头长度跳过
+ * - 挂载时检查当前扇区剩余空间全为0xFF，写入中断留下的脏数据之后不再追加
+ * - 扇区写满后滚动到空闲扇区，无空闲扇区时回收序号最小的扇区
+ * - 回收时只搬移索引中仍指向该扇区的记录，墓碑随最旧扇区一起丢弃
+ * - 回收扇区通过后台擦除释放，后台擦除不可用时回退为同步擦除
+ *
+ * @par 使用说明:
+ * - 接口不可重入，多任务访问时由调用者串行化
+ * - 存储区必须扇区对齐，调用前25Q设备需已初始化
+ *
+ * @par 更新历史:
+ * - v1.0 (2025): 初始版本
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_kv.h"
+#include "yDev_def.h"
+#include "yLib_crc.h"
+
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define YDEV_KV_FLAG_TOMBSTONE (0x01U) /*!< 记录标志: 墓碑(删除) */
+#define YDEV_KV_COPY_CHUNK (64)        /*!< 回收搬移与CRC校验的分块大小 */
+
+/**
+ * @brief 记录按4字节对齐后的总长度
+ */
+#define YDEV_KV_RECORD_SIZE(keyLen, valLen) \
+    ((YDEV_KV_RECORD_HEADER_SIZE + (uint32_t)(keyLen) + (uint32_t)(valLen) + 3U) & ~3U)
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 扇区头结构(Flash布局)
+ */
+typedef struct
+{
+    uint32_t magic;       /*!< YDEV_KV_SECTOR_MAGIC */
+    uint32_t seq;         /*!< 扇区序号 */
+    uint32_t reserved[2]; /*!< 保留，保持擦除值0xFF */
+} yDevKvSectorHeader_t;
+
+/**
+ * @brief 记录头结构(Flash布局)
+ */
+typedef struct
+{
+    uint16_t magic;  /*!< YDEV_KV_RECORD_MAGIC，0xFFFF表示扇区剩余空间未写入 */
+    uint8_t keyLen;  /*!< 键长度 */
+    uint8_t flags;   /*!< 记录标志 */
+    uint16_t valLen; /*!< 值长度 */
+    uint16_t crc;    /*!< 键+值的CRC16-CCITT */
+} yDevKvRecordHeader_t;
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 计算键的FNV-1a哈希
+ * @param key 键数据
+ * @param len 键长度
+ * @retval uint32_t 哈希值
+ */
+static uint32_t yDevKv_Hash(const char *key, uint32_t len);
+
+/**
+ * @brief 获取扇区起始地址
+ * @param kv KV存储句柄指针
+ * @param index 扇区索引
+ * @retval uint32_t Flash地址
+ */
+static uint32_t yDevKv_SectorAddress(yDevKv_t *kv, uint16_t index);
+
+/**
+ * @brief 向Flash追加写入数据
+ * @param kv KV存储句柄指针
+ * @param address 写入地址
+ * @param data 数据指针
+ * @param size 数据大小
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDevKv_Program(yDevKv_t *kv, uint32_t address, const void *data, uint32_t size);
+
+/**
+ * @brief 擦除单个扇区
+ * @param kv KV存储句柄指针
+ * @param index 扇区索引
+ * @param background 1=优先提交后台擦除, 0=同步擦除
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDevKv_EraseSector(yDevKv_t *kv, uint16_t index, uint8_t background);
+
+/**
+ * @brief 比较键与索引节点指向的记录键
+ * @param kv KV存储句柄指针
+ * @param entry 索引节点
+ * @param key 键数据
+ * @param keyLen 键长度
+ * @retval int 比较结果，<0/0/>0
+ * @note 先比较长度再比较内容，记录键从Flash读取
+ */
+static int yDevKv_KeyCompare(yDevKv_t *kv, yDevKvIndex_t *entry, const char *key, uint8_t keyLen);
+
+/**
+ * @brief 查找键的索引节点
+ * @param kv KV存储句柄指针
+ * @param key 键数据
+ * @param keyLen 键长度
+ * @param hash 键哈希
+ * @retval yDevKvIndex_t* 索引节点，NULL表示不存在
+ */
+static yDevKvIndex_t *yDevKv_Find(yDevKv_t *kv, const char *key, uint8_t keyLen, uint32_t hash);
+
+/**
+ * @brief 更新键的索引
+ * @param kv KV存储句柄指针
+ * @param key 键数据
+ * @param keyLen 键长度
+ * @param address 最新记录地址
+ * @param tombstone 1=删除键, 0=插入或更新
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDevKv_IndexUpdate(yDevKv_t *kv, const char *key, uint8_t keyLen, uint32_t address, uint8_t tombstone);
+
+/**
+ * @brief 释放全部索引节点
+ * @param kv KV存储句柄指针
+ */
+static void yDevKv_IndexClear(yDevKv_t *kv);
+
+/**
+ * @brief 读取并校验记录
+ * @param kv KV存储句柄指针
+ * @param address 记录地址
+ * @param limit 所在扇区结束地址
+ * @param header 输出记录头
+ * @retval int32_t 1=有效记录, 0=空闲空间, -1=记录头损坏, -2=记录内容校验失败
+ */
+static int32_t yDevKv_ReadRecord(yDevKv_t *kv, uint32_t address, uint32_t limit, yDevKvRecordHeader_t *header);
+
+/**
+ * @brief 扫描扇区记录并更新索引
+ * @param kv KV存储句柄指针
+ * @param index 扇区索引
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDevKv_ScanSector(yDevKv_t *kv, uint16_t index);
+
+/**
+ * @brief 检查扇区剩余空间是否全为擦除值
+ * @param kv KV存储句柄指针
+ * @param index 扇区索引
+ * @retval yDevStatus_t 操作状态
+ * @note 有未擦除字节时把扇区记为写满，下次追加滚动到新扇区
+ */
+static yDevStatus_t yDevKv_CheckTail(yDevKv_t *kv, uint16_t index);
+
+/**
+ * @brief 启用一个空闲扇区作为当前扇区
+ * @param kv KV存储句柄指针
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDevKv_Roll(yDevKv_t *kv);
+
+/**
+ * @brief 回收序号最小的扇区
+ * @param kv KV存储句柄指针
+ * @retval yDevStatus_t 操作状态
+ * @note 将仍有效的记录搬移到当前扇区后擦除原扇区
+ */
+static yDevStatus_t yDevKv_Collect(yDevKv_t *kv);
+
+/**
+ * @brief 追加一条记录
+ * @param kv KV存储句柄指针
+ * @param key 键数据
+ * @param keyLen 键长度
+ * @param value 值数据
+ * @param valLen 值长度
+ * @param flags 记录标志
+ * @param address 输出记录地址
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDevKv_Append(yDevKv_t *kv,
+                                  const char *key,
+                                  uint8_t keyLen,
+                                  const void *value,
+                                  uint16_t valLen,
+                                  uint8_t flags,
+                                  uint32_t *address);
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief FNV-1a哈希实现
+ */
+static uint32_t yDevKv_Hash(const char *key, uint32_t len)
+{
+    uint32_t hash = 2166136261UL;
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * @brief 扇区地址计算实现
+ */
+static uint32_t yDevKv_SectorAddress(yDevKv_t *kv, uint16_t index)
+{
+    return kv->baseAddress + (uint32_t)index * YDEV_25Q_SECTOR_SIZE;
+}
+
+/**
+ * @brief Flash追加写入实现
+ */
+static yDevStatus_t yDevKv_Program(yDevKv_t *kv, uint32_t address, const void *data, uint32_t size)
+{
+    // 目标区域已擦除，25Q写入路径只编程目标字节范围
+    kv->flash->address = address;
+    if (yDevWrite(kv->flash, data, size) != (int32_t)size)
+    {
+        return YDEV_ERROR;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 扇区擦除实现
+ */
+static yDevStatus_t yDevKv_EraseSector(yDevKv_t *kv, uint16_t index, uint8_t background)
+{
+    uint32_t address = yDevKv_SectorAddress(kv, index);
+
+    // 后台擦除与后续写入由25Q驱动保证顺序
+    if ((background == 0) ||
+        (yDev25qEraseAsync(kv->flash, address, YDEV_25Q_SECTOR_SIZE) != YDEV_OK))
+    {
+        if (yDevIoctl(kv->flash, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK)
+        {
+            return YDEV_ERROR;
+        }
+    }
+
+    kv->sector[index].state = YDEV_KV_SECTOR_ERASED;
+    kv->sector[index].used = 0;
+    kv->sector[index].seq = 0;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 键比较实现
+ */
+static int yDevKv_KeyCompare(yDevKv_t *kv, yDevKvIndex_t *entry, const char *key, uint8_t keyLen)
+{
+    yDevKvRecordHeader_t header;
+    char stored[YDEV_KV_KEY_MAX];
+
+    if (yDev25qRead(kv->flash, entry->address, &header, sizeof(header)) != (int32_t)sizeof(header))
+    {
+        return -1;
+    }
+    if (header.keyLen != keyLen)
+    {
+        return (int)keyLen - (int)header.keyLen;
+    }
+    if (yDev25qRead(kv->flash, entry->address + YDEV_KV_RECORD_HEADER_SIZE, stored, keyLen) != keyLen)
+    {
+        return -1;
+    }
+    return memcmp(key, stored, keyLen);
+}
+
+/**
+ * @brief 索引查找实现
+ */
+static yDevKvIndex_t *yDevKv_Find(yDevKv_t *kv, const char *key, uint8_t keyLen, uint32_t hash)
+{
+    struct ylib_rb_node *node = kv->root.rb_node;
+    yDevKvIndex_t *entry;
+    int result;
+
+    while (node != NULL)
+    {
+        entry = ylib_rb_entry(node, yDevKvIndex_t, node);
+        if (hash != entry->hash)
+        {
+            result = (hash < entry->hash) ? -1 : 1;
+        }
+        else
+        {
+            result = yDevKv_KeyCompare(kv, entry, key, keyLen);
+        }
+
+        if (result == 0)
+        {
+            return entry;
+        }
+        node = (result < 0) ? node->rb_left : node->rb_right;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 取一个索引节点，有静态节点池时从池中取
+ */
+static yDevKvIndex_t *yDevKv_IndexAlloc(yDevKv_t *kv)
+{
+    yDevKvIndex_t *entry;
+
+    if (kv->indexStatic == 0)
+    {
+        return (yDevKvIndex_t *)YDEV_MALLOC(sizeof(yDevKvIndex_t));
+    }
+    entry = kv->indexFree;
+    if (entry != NULL)
+    {
+        kv->indexFree = (yDevKvIndex_t *)(void *)entry->node.rb_right;
+    }
+    return entry;
+}
+
+/**
+ * @brief 归还索引节点
+ */
+static void yDevKv_IndexFree(yDevKv_t *kv, yDevKvIndex_t *entry)
+{
+    if (kv->indexStatic == 0)
+    {
+        YDEV_FREE(entry);
+        return;
+    }
+    entry->node.rb_right = &kv->indexFree->node;
+    kv->indexFree = entry;
+}
+
+/**
+ * @brief 索引更新实现
+ */
+static yDevStatus_t yDevKv_IndexUpdate(yDevKv_t *kv, const char *key, uint8_t keyLen, uint32_t address, uint8_t tombstone)
+{
+    struct ylib_rb_node **link = &kv->root.rb_node;
+    struct ylib_rb_node *parent = NULL;
+    yDevKvIndex_t *entry;
+    uint32_t hash = yDevKv_Hash(key, keyLen);
+    int result;
+
+    while (*link != NULL)
+    {
+        parent = *link;
+        entry = ylib_rb_entry(parent, yDevKvIndex_t, node);
+        if (hash != entry->hash)
+        {
+            result = (hash < entry->hash) ? -1 : 1;
+        }
+        else
+        {
+            result = yDevKv_KeyCompare(kv, entry, key, keyLen);
+        }
+
+        if (result == 0)
+        {
+            // 已存在: 删除或指向新记录
+            if (tombstone != 0)
+            {
+                ylib_rb_erase(&entry->node, &kv->root);
+                yDevKv_IndexFree(kv, entry);
+                kv->count--;
+            }
+            else
+            {
+                entry->address = address;
+            }
+            return YDEV_OK;
+        }
+        link = (result < 0) ? &parent->rb_left : &parent->rb_right;
+    }
+
+    if (tombstone != 0)
+    {
+        return YDEV_OK;
+    }
+
+    entry = yDevKv_IndexAlloc(kv);
+    if (entry == NULL)
+    {
+        return YDEV_NO_MEMORY;
+    }
+    entry->hash = hash;
+    entry->address = address;
+    ylib_rb_link_node(&entry->node, parent, link);
+    ylib_rb_insert_color(&entry->node, &kv->root);
+    kv->count++;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 索引释放实现
+ */
+static void yDevKv_IndexClear(yDevKv_t *kv)
+{
+    struct ylib_rb_node *node;
+
+    while ((node = ylib_rb_first(&kv->root)) != NULL)
+    {
+        ylib_rb_erase(node, &kv->root);
+        yDevKv_IndexFree(kv, ylib_rb_entry(node, yDevKvIndex_t, node));
+    }
+    kv->count = 0;
+}
+
+/**
+ * @brief 记录读取校验实现
+ */
+static int32_t yDevKv_ReadRecord(yDevKv_t *kv, uint32_t address, uint32_t limit, yDevKvRecordHeader_t *header)
+{
+    uint8_t chunk[YDEV_KV_COPY_CHUNK];
+    uint32_t remain;
+    uint32_t offset;
+    uint32_t size;
+    uint16_t crc;
+
+    if ((address + YDEV_KV_RECORD_HEADER_SIZE) > limit)
+    {
+        return 0;
+    }
+    if (yDev25qRead(kv->flash, address, header, sizeof(*header)) != (int32_t)sizeof(*header))
+    {
+        return -1;
+    }
+
+    // 擦除状态的记录头表示扇区剩余空间未写入
+    if ((header->magic == 0xFFFFU) && (header->keyLen == 0xFFU) &&
+        (header->flags == 0xFFU) && (header->valLen == 0xFFFFU))
+    {
+        return 0;
+    }
+    if ((header->magic != YDEV_KV_RECORD_MAGIC) ||
+        (header->keyLen == 0) || (header->keyLen > YDEV_KV_KEY_MAX) ||
+        (header->valLen > YDEV_KV_VALUE_MAX) ||
+        ((address + YDEV_KV_RECORD_SIZE(header->keyLen, header->valLen)) > limit))
+    {
+        return -1;
+    }
+
+    // 分块校验键+值，避免在栈上放置整条记录
+    crc = YLIB_CRC16_INIT;
+    remain = (uint32_t)header->keyLen + header->valLen;
+    offset = address + YDEV_KV_RECORD_HEADER_SIZE;
+    while (remain > 0)
+    {
+        size = (remain > sizeof(chunk)) ? sizeof(chunk) : remain;
+        if (yDev25qRead(kv->flash, offset, chunk, size) != (int32_t)size)
+        {
+            return -1;
+        }
+        crc = ylib_crc16(crc, chunk, size);
+        offset += size;
+        remain -= size;
+    }
+
+    return (crc == header->crc) ? 1 : -2;
+}
+
+/**
+ * @brief 扇区扫描实现
+ */
+static yDevStatus_t yDevKv_ScanSector(yDevKv_t *kv, uint16_t index)
+{
+    yDevKvRecordHeader_t header;
+    char key[YDEV_KV_KEY_MAX];
+    uint32_t start = yDevKv_SectorAddress(kv, index);
+    uint32_t limit = start + YDEV_25Q_SECTOR_SIZE;
+    uint32_t address = start + YDEV_KV_SECTOR_HEADER_SIZE;
+    yDevStatus_t status;
+    int32_t result;
+
+    while (1)
+    {
+        result = yDevKv_ReadRecord(kv, address, limit, &header);
+        if (result == 0)
+        {
+            break;
+        }
+        if (result == -1)
+        {
+            // 记录头损坏时无法确定后续记录位置，扇区不再追加
+            address = limit;
+            break;
+        }
+        if (result == 1)
+        {
+            if (yDev25qRead(kv->flash, address + YDEV_KV_RECORD_HEADER_SIZE, key, header.keyLen) != header.keyLen)
+            {
+                return YDEV_ERROR;
+            }
+            status = yDevKv_IndexUpdate(kv, key, header.keyLen, address,
+                                        (header.flags & YDEV_KV_FLAG_TOMBSTONE) ? 1 : 0);
+            if (status != YDEV_OK)
+            {
+                return status;
+            }
+        }
+        // 校验失败的记录(掉电写入中断)跳过，长度仍可信
+        address += YDEV_KV_RECORD_SIZE(header.keyLen, header.valLen);
+    }
+
+    kv->sector[index].used = (uint16_t)(address - start);
+    return YDEV_OK;
+}
+
+/**
+ * @brief 剩余空间检查实现
+ */
+static yDevStatus_t yDevKv_CheckTail(yDevKv_t *kv, uint16_t index)
+{
+    uint8_t chunk[YDEV_KV_COPY_CHUNK];
+    uint32_t address = yDevKv_SectorAddress(kv, index) + kv->sector[index].used;
+    uint32_t limit = yDevKv_SectorAddress(kv, index) + YDEV_25Q_SECTOR_SIZE;
+    uint32_t size;
+    uint32_t i;
+
+    while (address < limit)
+    {
+        size = ((limit - address) > sizeof(chunk)) ? sizeof(chunk) : (limit - address);
+        if (yDev25qRead(kv->flash, address, chunk, size) != (int32_t)size)
+        {
+            return YDEV_ERROR;
+        }
+        for (i = 0; i < size; i++)
+        {
+            if (chunk[i] != 0xFF)
+            {
+                kv->sector[index].used = YDEV_25Q_SECTOR_SIZE;
+                return YDEV_OK;
+            }
+        }
+        address += size;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 扇区滚动实现
+ */
+static yDevStatus_t yDevKv_Roll(yDevKv_t *kv)
+{
+    yDevKvSectorHeader_t header;
+    uint16_t i;
+    uint16_t index;
+
+    // 从当前扇区之后顺序查找空闲扇区，擦除均匀分布
+    for (i = 1; i <= kv->sectorCount; i++)
+    {
+        index = (uint16_t)((kv->active + i) % kv->sectorCount);
+        if (kv->sector[index].state != YDEV_KV_SECTOR_USED)
+        {
+            break;
+        }
+    }
+    if (i > kv->sectorCount)
+    {
+        return YDEV_NO_MEMORY;
+    }
+
+    if ((kv->sector[index].state == YDEV_KV_SECTOR_UNKNOWN) &&
+        (yDevKv_EraseSector(kv, index, 0) != YDEV_OK))
+    {
+        return YDEV_ERROR;
+    }
+
+    memset(&header, 0xFF, sizeof(header));
+    header.magic = YDEV_KV_SECTOR_MAGIC;
+    header.seq = kv->seq + 1;
+    if (yDevKv_Program(kv, yDevKv_SectorAddress(kv, index), &header, sizeof(header)) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    kv->seq = header.seq;
+    kv->active = index;
+    kv->sector[index].seq = header.seq;
+    kv->sector[index].used = YDEV_KV_SECTOR_HEADER_SIZE;
+    kv->sector[index].state = YDEV_KV_SECTOR_USED;
+
+    // 保证始终留有一个空闲扇区，下次滚动不会无处可写
+    for (i = 0; i < kv->sectorCount; i++)
+    {
+        if (kv->sector[i].state != YDEV_KV_SECTOR_USED)
+        {
+            return YDEV_OK;
+        }
+    }
+    return yDevKv_Collect(kv);
+}
+
+/**
+ * @brief 扇区回收实现
+ */
+static yDevStatus_t yDevKv_Collect(yDevKv_t *kv)
+{
+    uint8_t chunk[YDEV_KV_COPY_CHUNK];
+    yDevKvRecordHeader_t header;
+    struct ylib_rb_node *node;
+    yDevKvIndex_t *entry;
+    yDevKvSector_t *active;
+    uint32_t start;
+    uint32_t limit;
+    uint32_t target;
+    uint32_t offset;
+    uint32_t remain;
+    uint32_t size;
+    uint16_t victim;
+    uint16_t i;
+
+    // 选择序号最小的扇区，其中的墓碑已没有更旧的记录需要遮盖
+    victim = kv->active;
+    for (i = 0; i < kv->sectorCount; i++)
+    {
+        if ((kv->sector[i].state == YDEV_KV_SECTOR_USED) && (i != kv->active) &&
+            ((victim == kv->active) || (kv->sector[i].seq < kv->sector[victim].seq)))
+        {
+            victim = i;
+        }
+    }
+    if (victim == kv->active)
+    {
+        return YDEV_NO_MEMORY;
+    }
+
+    start = yDevKv_SectorAddress(kv, victim);
+    limit = start + YDEV_25Q_SECTOR_SIZE;
+    active = &kv->sector[kv->active];
+
+    // 搬移索引中仍指向回收扇区的记录
+    for (node = ylib_rb_first(&kv->root); node != NULL; node = ylib_rb_next(node))
+    {
+        entry = ylib_rb_entry(node, yDevKvIndex_t, node);
+        if ((entry->address < start) || (entry->address >= limit))
+        {
+            continue;
+        }
+
+        if (yDev25qRead(kv->flash, entry->address, &header, sizeof(header)) != (int32_t)sizeof(header))
+        {
+            return YDEV_ERROR;
+        }
+        remain = YDEV_KV_RECORD_SIZE(header.keyLen, header.valLen);
+        if (((uint32_t)active->used + remain) > YDEV_25Q_SECTOR_SIZE)
+        {
+            return YDEV_NO_MEMORY;
+        }
+
+        target = yDevKv_SectorAddress(kv, kv->active) + active->used;
+        offset = 0;
+        while (offset < remain)
+        {
+            size = ((remain - offset) > sizeof(chunk)) ? sizeof(chunk) : (remain - offset);
+            if ((yDev25qRead(kv->flash, entry->address + offset, chunk, size) != (int32_t)size) ||
+                (yDevKv_Program(kv, target + offset, chunk, size) != YDEV_OK))
+            {
+                return YDEV_ERROR;
+            }
+            offset += size;
+        }
+
+        entry->address = target;
+        active->used = (uint16_t)(active->used + remain);
+    }
+
+    return yDevKv_EraseSector(kv, victim, 1);
+}
+
+/**
+ * @brief 记录追加实现
+ */
+static yDevStatus_t yDevKv_Append(yDevKv_t *kv,
+                                  const char *key,
+                                  uint8_t keyLen,
+                                  const void *value,
+                                  uint16_t valLen,
+                                  uint8_t flags,
+                                  uint32_t *address)
+{
+    uint8_t buffer[YDEV_KV_RECORD_HEADER_SIZE + YDEV_KV_KEY_MAX + YDEV_KV_COPY_CHUNK];
+    yDevKvRecordHeader_t header;
+    uint32_t total = YDEV_KV_RECORD_SIZE(keyLen, valLen);
+    uint32_t target;
+    uint16_t rolls;
+
+    // 当前扇区放不下时滚动，回收可能腾出空间也可能需要再滚动一次
+    for (rolls = 0; ((uint32_t)kv->sector[kv->active].used + total) > YDEV_25Q_SECTOR_SIZE; rolls++)
+    {
+        if ((rolls >= kv->sectorCount) || (yDevKv_Roll(kv) != YDEV_OK))
+        {
+            return YDEV_NO_MEMORY;
+        }
+    }
+
+    header.magic = YDEV_KV_RECORD_MAGIC;
+    header.keyLen = keyLen;
+    header.flags = flags;
+    header.valLen = valLen;
+    header.crc = ylib_crc16(ylib_crc16(YLIB_CRC16_INIT, key, keyLen), value, valLen);
+
+    target = yDevKv_SectorAddress(kv, kv->active) + kv->sector[kv->active].used;
+    memcpy(buffer, &header, sizeof(header));
+    memcpy(&buffer[sizeof(header)], key, keyLen);
+
+    if ((sizeof(header) + keyLen + valLen) <= sizeof(buffer))
+    {
+        // 短记录合并为一次编程
+        if (valLen > 0)
+        {
+            memcpy(&buffer[sizeof(header) + keyLen], value, valLen);
+        }
+        if (yDevKv_Program(kv, target, buffer, sizeof(header) + keyLen + valLen) != YDEV_OK)
+        {
+            return YDEV_ERROR;
+        }
+    }
+    else if ((yDevKv_Program(kv, target, buffer, sizeof(header) + keyLen) != YDEV_OK) ||
+             (yDevKv_Program(kv, target + sizeof(header) + keyLen, value, valLen) != YDEV_OK))
+    {
+        // 长记录先写头再写值，掉电时记录校验失败但长度可信，后续空间不会被当作空闲
+        return YDEV_ERROR;
+    }
+
+    kv->sector[kv->active].used = (uint16_t)(kv->sector[kv->active].used + total);
+    *address = target;
+    return YDEV_OK;
+}
+
+// ==================== 公共函数实现 ====================
+
+/**
+ * @brief 挂载KV存储实现
+ */
+yDevStatus_t yDevKvMount(yDevKv_t *kv, const yDevKvConfig_t *config)
+{
+    yDevKvSectorHeader_t header;
+    yDevStatus_t status;
+    uint32_t last;
+    uint16_t next;
+    uint16_t valid;
+    uint16_t i;
+
+    // 参数有效性检查
+    if ((kv == NULL) || (config == NULL) || (config->flash == NULL) ||
+        (config->sectorCount < 2) ||
+        ((config->baseAddress % YDEV_25Q_SECTOR_SIZE) != 0) ||
+        ((config->baseAddress + (uint32_t)config->sectorCount * YDEV_25Q_SECTOR_SIZE) > config->flash->size))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    memset(kv, 0, sizeof(*kv));
+    kv->flash = config->flash;
+    kv->baseAddress = config->baseAddress;
+    kv->sectorCount = config->sectorCount;
+    kv->root = YLIB_RB_ROOT;
+
+    // 静态节点池在挂载时串成空闲链表，之后的增删不再使用堆
+    if (config->indexBuffer != NULL)
+    {
+        kv->indexStatic = 1;
+        for (i = 0; i < config->indexCount; i++)
+        {
+            yDevKv_IndexFree(kv, (yDevKvIndex_t *)config->indexBuffer + i);
+        }
+    }
+
+    if (config->sectorBuffer != NULL)
+    {
+        kv->sector = (yDevKvSector_t *)config->sectorBuffer;
+        kv->sectorStatic = 1;
+    }
+    else
+    {
+        kv->sector = (yDevKvSector_t *)YDEV_MALLOC(sizeof(yDevKvSector_t) * kv->sectorCount);
+    }
+    if (kv->sector == NULL)
+    {
+        return YDEV_NO_MEMORY;
+    }
+    memset(kv->sector, 0, sizeof(yDevKvSector_t) * kv->sectorCount);
+
+    // 读取扇区头
+    valid = 0;
+    for (i = 0; i < kv->sectorCount; i++)
+    {
+        if (yDev25qRead(kv->flash, yDevKv_SectorAddress(kv, i), &header, sizeof(header)) != (int32_t)sizeof(header))
+        {
+            yDevKvUnmount(kv);
+            return YDEV_ERROR;
+        }
+        if ((header.magic == YDEV_KV_SECTOR_MAGIC) && (header.seq != 0) && (header.seq != 0xFFFFFFFFUL))
+        {
+            kv->sector[i].state = YDEV_KV_SECTOR_USED;
+            kv->sector[i].seq = header.seq;
+            valid++;
+        }
+    }
+
+    kv->mounted = 1;
+    if (valid == 0)
+    {
+        status = yDevKvFormat(kv);
+        if (status != YDEV_OK)
+        {
+            yDevKvUnmount(kv);
+        }
+        return status;
+    }
+
+    // 按序号从旧到新扫描，后写入的记录覆盖先写入的记录
+    last = 0;
+    while (valid-- > 0)
+    {
+        next = kv->sectorCount;
+        for (i = 0; i < kv->sectorCount; i++)
+        {
+            if ((kv->sector[i].state == YDEV_KV_SECTOR_USED) && (kv->sector[i].seq > last) &&
+                ((next == kv->sectorCount) || (kv->sector[i].seq < kv->sector[next].seq)))
+            {
+                next = i;
+            }
+        }
+
+        status = yDevKv_ScanSector(kv, next);
+        if (status != YDEV_OK)
+        {
+            yDevKvUnmount(kv);
+            return status;
+        }
+        last = kv->sector[next].seq;
+        kv->active = next;
+    }
+    kv->seq = last;
+
+    // 只有当前扇区会继续追加
+    status = yDevKv_CheckTail(kv, kv->active);
+    if (status != YDEV_OK)
+    {
+        yDevKvUnmount(kv);
+        return status;
+    }
+
+    // 回收过程中掉电会留下没有空闲扇区的状态，重新完成回收
+    for (i = 0; i < kv->sectorCount; i++)
+    {
+        if (kv->sector[i].state != YDEV_KV_SECTOR_USED)
+        {
+            return YDEV_OK;
+        }
+    }
+    status = yDevKv_Collect(kv);
+    if (status != YDEV_OK)
+    {
+        yDevKvUnmount(kv);
+    }
+    return status;
+}
+
+/**
+ * @brief 卸载KV存储实现
+ */
+yDevStatus_t yDevKvUnmount(yDevKv_t *kv)
+{
+    if (kv == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    yDevKv_IndexClear(kv);
+    if ((kv->sector != NULL) && (kv->sectorStatic == 0))
+    {
+        YDEV_FREE(kv->sector);
+    }
+    kv->sector = NULL;
+    kv->mounted = 0;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 格式化KV存储实现
+ */
+yDevStatus_t yDevKvFormat(yDevKv_t *kv)
+{
+    yDev25qEraseRange_t range;
+    uint16_t i;
+
+    if ((kv == NULL) || (kv->mounted == 0))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    range.address = kv->baseAddress;
+    range.size = (uint32_t)kv->sectorCount * YDEV_25Q_SECTOR_SIZE;
+    if (yDevIoctl(kv->flash, YDEV_25Q_IOCTL_ERASE_RANGE, &range) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    yDevKv_IndexClear(kv);
+    for (i = 0; i < kv->sectorCount; i++)
+    {
+        kv->sector[i].state = YDEV_KV_SECTOR_ERASED;
+        kv->sector[i].used = 0;
+        kv->sector[i].seq = 0;
+    }
+
+    // 从最后一个扇区滚动，首个启用的是扇区0
+    kv->seq = 0;
+    kv->active = (uint16_t)(kv->sectorCount - 1);
+    return yDevKv_Roll(kv);
+}
+
+/**
+ * @brief 写入键值实现
+ */
+yDevStatus_t yDevKvSet(yDevKv_t *kv, const char *key, const void *value, uint16_t len)
+{
+    uint32_t address;
+    size_t keyLen;
+    yDevStatus_t status;
+
+    if ((kv == NULL) || (kv->mounted == 0) || (key == NULL) ||
+        ((value == NULL) && (len != 0)) || (len > YDEV_KV_VALUE_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    keyLen = strlen(key);
+    if ((keyLen == 0) || (keyLen > YDEV_KV_KEY_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    status = yDevKv_Append(kv, key, (uint8_t)keyLen, value, len, 0, &address);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+    return yDevKv_IndexUpdate(kv, key, (uint8_t)keyLen, address, 0);
+}
+
+/**
+ * @brief 读取键值实现
+ */
+int32_t yDevKvGet(yDevKv_t *kv, const char *key, void *value, uint16_t size)
+{
+    yDevKvRecordHeader_t header;
+    yDevKvIndex_t *entry;
+    size_t keyLen;
+    uint16_t copy;
+
+    if ((kv == NULL) || (kv->mounted == 0) || (key == NULL) || ((value == NULL) && (size != 0)))
+    {
+        return -1;
+    }
+    keyLen = strlen(key);
+    if ((keyLen == 0) || (keyLen > YDEV_KV_KEY_MAX))
+    {
+        return -1;
+    }
+
+    entry = yDevKv_Find(kv, key, (uint8_t)keyLen, yDevKv_Hash(key, keyLen));
+    if (entry == NULL)
+    {
+        return -1;
+    }
+    if (yDev25qRead(kv->flash, entry->address, &header, sizeof(header)) != (int32_t)sizeof(header))
+    {
+        return -1;
+    }
+
+    copy = (header.valLen < size) ? header.valLen : size;
+    if ((copy > 0) &&
+        (yDev25qRead(kv->flash, entry->address + YDEV_KV_RECORD_HEADER_SIZE + keyLen, value, copy) != copy))
+    {
+        return -1;
+    }
+    return header.valLen;
+}
+
+/**
+ * @brief 删除键实现
+ */
+yDevStatus_t yDevKvDelete(yDevKv_t *kv, const char *key)
+{
+    uint32_t address;
+    size_t keyLen;
+    yDevStatus_t status;
+
+    if ((kv == NULL) || (kv->mounted == 0) || (key == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    keyLen = strlen(key);
+    if ((keyLen == 0) || (keyLen > YDEV_KV_KEY_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (yDevKv_Find(kv, key, (uint8_t)keyLen, yDevKv_Hash(key, keyLen)) == NULL)
+    {
+        return YDEV_ERROR;
+    }
+
+    status = yDevKv_Append(kv, key, (uint8_t)keyLen, NULL, 0, YDEV_KV_FLAG_TOMBSTONE, &address);
+    if (status != YDEV_OK)
+    {
+        return status;
+    }
+    return yDevKv_IndexUpdate(kv, key, (uint8_t)keyLen, address, 1);
+}
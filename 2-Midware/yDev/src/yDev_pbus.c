@@ -0,0 +1,869 @@
+/**
+ * @file yDev_pbus.c
+ * @brief yDev 8080/6800并行总线设备实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现基于GPIO的并行总线设备，短数据由CPU逐字节选通，长数据由定时器脉冲串和DMA写入
+ *
+ * @par 实现说明:
+ * - CPU写入：每个数据一次BSRR写入数据线(同端口时同时拉有效选通)，再一次写入释放选通
+ * - DMA写入：WR/E引脚空闲时为GPIO输出，写入期间切换为定时器复用功能；定时器单脉冲模式的
+ *   重复计数器使脉冲数与字节数严格相等，完成后输出停在无效电平，不会多出选通
+ * - 超过重复计数器范围的写入分段，每段在DMA完成中断中等最后一个脉冲结束后启动下一段
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_pbus.h"
+#include "yDev_def.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <string.h>
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 选通延时
+ * @param loops 空循环数
+ */
+static void yDev_Pbus_Delay(uint32_t loops);
+
+/**
+ * @brief CPU选通写入一个总线数据
+ * @param pbus_handle 并行总线句柄
+ * @param value 总线数据，4位总线只用低4位
+ */
+static void yDev_Pbus_Cycle(yDevHandle_Pbus_t *pbus_handle, uint32_t value);
+
+/**
+ * @brief CPU写入数据
+ * @param pbus_handle 并行总线句柄
+ * @param data 数据
+ * @param len 字节数
+ */
+static void yDev_Pbus_WriteCpu(yDevHandle_Pbus_t *pbus_handle, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 设置片选电平
+ * @param pbus_handle 并行总线句柄
+ * @param level 0为选中
+ */
+static void yDev_Pbus_Cs(yDevHandle_Pbus_t *pbus_handle, uint32_t level);
+
+/**
+ * @brief 设置D/C电平
+ * @param pbus_handle 并行总线句柄
+ * @param level 0为命令，1为数据
+ */
+static void yDev_Pbus_Dc(yDevHandle_Pbus_t *pbus_handle, uint32_t level);
+
+/**
+ * @brief 启动DMA写入
+ * @param pbus_handle 并行总线句柄
+ * @param data 数据，完成前保持有效
+ * @param len 字节数
+ * @param async 非0时完成后通知yDev异步写入
+ * @retval yDevStatus_t 启动状态
+ */
+static yDevStatus_t yDev_Pbus_DmaStart(yDevHandle_Pbus_t *pbus_handle, const uint8_t *data, uint32_t len,
+                                       uint8_t async);
+
+/**
+ * @brief 启动DMA写入的下一段
+ * @param pbus_handle 并行总线句柄
+ * @retval yDrvStatus_t 启动状态
+ */
+static yDrvStatus_t yDev_Pbus_DmaNext(yDevHandle_Pbus_t *pbus_handle);
+
+/**
+ * @brief 结束DMA写入
+ * @param pbus_handle 并行总线句柄
+ * @param status 写入结果
+ * @note 任务和中断中都可调用；选通引脚切回GPIO输出并释放片选
+ */
+static void yDev_Pbus_DmaFinish(yDevHandle_Pbus_t *pbus_handle, yDevStatus_t status);
+
+/**
+ * @brief 选通定时器DMA中断回调
+ * @param arg 并行总线句柄
+ * @param event DMA中断类型
+ */
+static void yDev_Pbus_DmaEvent(void *arg, yDrvDmaExti_t event);
+
+/**
+ * @brief DMA写入并等待完成
+ * @param pbus_handle 并行总线句柄
+ * @param data 数据
+ * @param len 字节数
+ * @retval int32_t 写入的字节数，-1表示启动失败
+ */
+static int32_t yDev_Pbus_DmaWrite(yDevHandle_Pbus_t *pbus_handle, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 等待进行中的DMA写入完成
+ * @param pbus_handle 并行总线句柄
+ * @retval yDevStatus_t 等待结果，超时时中止写入
+ */
+static yDevStatus_t yDev_Pbus_Sync(yDevHandle_Pbus_t *pbus_handle);
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 选通延时实现
+ */
+static void yDev_Pbus_Delay(uint32_t loops)
+{
+    volatile uint32_t i;
+
+    for (i = loops; i != 0U; i--)
+    {
+    }
+}
+
+/**
+ * @brief CPU选通写入一个总线数据实现
+ */
+static void yDev_Pbus_Cycle(yDevHandle_Pbus_t *pbus_handle, uint32_t value)
+{
+    uint32_t bits;
+
+    // 数据和同端口的选通有效沿一次写入，锁存发生在释放沿
+    bits = (value << pbus_handle->data.shift) & pbus_handle->data.mask;
+    pbus_handle->data.port->BSRR = bits | ((pbus_handle->data.mask & ~bits) << 16) | pbus_handle->strobeMerge;
+    if (pbus_handle->strobeMerge == 0U)
+    {
+        pbus_handle->wr.gpioInfo.port->BSRR = pbus_handle->strobeOn;
+    }
+    if (pbus_handle->cpuDelay != 0U)
+    {
+        yDev_Pbus_Delay(pbus_handle->cpuDelay);
+    }
+    pbus_handle->wr.gpioInfo.port->BSRR = pbus_handle->strobeOff;
+    if (pbus_handle->cpuDelay != 0U)
+    {
+        yDev_Pbus_Delay(pbus_handle->cpuDelay);
+    }
+}
+
+/**
+ * @brief CPU写入数据实现
+ */
+static void yDev_Pbus_WriteCpu(yDevHandle_Pbus_t *pbus_handle, const uint8_t *data, uint32_t len)
+{
+    uint32_t i;
+
+    if (pbus_handle->width == 4U)
+    {
+        for (i = 0; i < len; i++)
+        {
+            yDev_Pbus_Cycle(pbus_handle, (uint32_t)data[i] >> 4);
+            yDev_Pbus_Cycle(pbus_handle, (uint32_t)data[i] & 0x0FU);
+        }
+        return;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        yDev_Pbus_Cycle(pbus_handle, data[i]);
+    }
+}
+
+/**
+ * @brief CPU读取数据
+ * @param pbus_handle 并行总线句柄
+ * @param data 输出缓冲区
+ * @param len 字节数
+ * @note 数据线临时切为输入；8080每字节一个RD脉冲，6800在R/W为高时每字节一个E脉冲
+ */
+static void yDev_Pbus_ReadCpu(yDevHandle_Pbus_t *pbus_handle, uint8_t *data, uint32_t len)
+{
+    GPIO_TypeDef *port = pbus_handle->data.port;
+    GPIO_TypeDef *strobe;
+    uint32_t on;
+    uint32_t off;
+    uint32_t value;
+    uint32_t primask;
+    uint32_t i;
+    uint32_t n;
+
+    // 1. 数据线切为输入，MODER与其他引脚共用，读改写期间关中断
+    primask = __get_PRIMASK();
+    __disable_irq();
+    port->MODER &= ~pbus_handle->moderMask;
+    __set_PRIMASK(primask);
+
+    if (pbus_handle->mode == YDEV_PBUS_MODE_8080)
+    {
+        strobe = pbus_handle->rd.gpioInfo.port;
+        on = (uint32_t)pbus_handle->rd.gpioInfo.pinMask << 16;
+        off = pbus_handle->rd.gpioInfo.pinMask;
+    }
+    else
+    {
+        pbus_handle->rd.gpioInfo.port->BSRR = pbus_handle->rd.gpioInfo.pinMask; // R/W为读
+        strobe = pbus_handle->wr.gpioInfo.port;
+        on = pbus_handle->strobeOn;
+        off = pbus_handle->strobeOff;
+    }
+
+    // 2. 每个总线数据一个选通脉冲，有效期间等待外设输出稳定后采样
+    for (i = 0; i < len; i++)
+    {
+        value = 0;
+        for (n = (pbus_handle->width == 4U) ? 2U : 1U; n != 0U; n--)
+        {
+            strobe->BSRR = on;
+            yDev_Pbus_Delay((uint32_t)pbus_handle->cpuDelay + 2U);
+            value = (value << 4) | ((port->IDR & pbus_handle->data.mask) >> pbus_handle->data.shift);
+            strobe->BSRR = off;
+            yDev_Pbus_Delay(pbus_handle->cpuDelay);
+        }
+        data[i] = (uint8_t)value;
+    }
+
+    // 3. 恢复写方向
+    if (pbus_handle->mode == YDEV_PBUS_MODE_6800)
+    {
+        pbus_handle->rd.gpioInfo.port->BRR = pbus_handle->rd.gpioInfo.pinMask;
+    }
+    primask = __get_PRIMASK();
+    __disable_irq();
+    port->MODER = (port->MODER & ~pbus_handle->moderMask) | pbus_handle->moderOut;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 设置片选电平实现
+ */
+static void yDev_Pbus_Cs(yDevHandle_Pbus_t *pbus_handle, uint32_t level)
+{
+    if (pbus_handle->cs.gpioInfo.port != NULL)
+    {
+        pbus_handle->cs.gpioInfo.port->BSRR = (level != 0U) ? pbus_handle->cs.gpioInfo.pinMask
+                                                            : ((uint32_t)pbus_handle->cs.gpioInfo.pinMask << 16);
+    }
+}
+
+/**
+ * @brief 设置D/C电平实现
+ */
+static void yDev_Pbus_Dc(yDevHandle_Pbus_t *pbus_handle, uint32_t level)
+{
+    if (pbus_handle->dc.gpioInfo.port != NULL)
+    {
+        pbus_handle->dc.gpioInfo.port->BSRR = (level != 0U) ? pbus_handle->dc.gpioInfo.pinMask
+                                                            : ((uint32_t)pbus_handle->dc.gpioInfo.pinMask << 16);
+    }
+}
+
+/**
+ * @brief 启动DMA写入实现
+ */
+static yDevStatus_t yDev_Pbus_DmaStart(yDevHandle_Pbus_t *pbus_handle, const uint8_t *data, uint32_t len,
+                                       uint8_t async)
+{
+    if (pbus_handle->busy != 0U)
+    {
+        pbus_handle->base.errno |= YDEV_PBUS_ERRNO_BUSY;
+        return YDEV_BUSY;
+    }
+
+    pbus_handle->next = data;
+    pbus_handle->remain = len;
+    pbus_handle->total = len;
+    pbus_handle->async = async;
+    pbus_handle->result = YDEV_BUSY;
+    pbus_handle->busy = 1;
+
+    // 定时器通道已使能，输出为无效电平，切换复用功能时选通线不跳变
+    yDev_Pbus_Cs(pbus_handle, 0);
+    LL_GPIO_SetPinMode(pbus_handle->wr.gpioInfo.port, pbus_handle->wr.gpioInfo.pinMask, LL_GPIO_MODE_ALTERNATE);
+
+    if (yDev_Pbus_DmaNext(pbus_handle) != YDRV_OK)
+    {
+        pbus_handle->async = 0;
+        yDev_Pbus_DmaFinish(pbus_handle, YDEV_ERROR);
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 启动DMA写入的下一段实现
+ */
+static yDrvStatus_t yDev_Pbus_DmaNext(yDevHandle_Pbus_t *pbus_handle)
+{
+    pbus_handle->chunk = (pbus_handle->remain > pbus_handle->chunkMax) ? pbus_handle->chunkMax : pbus_handle->remain;
+
+    return yDrvTimPulseDmaStart(&pbus_handle->tim, pbus_handle->odr, pbus_handle->next, pbus_handle->chunk);
+}
+
+/**
+ * @brief 结束DMA写入实现
+ */
+static void yDev_Pbus_DmaFinish(yDevHandle_Pbus_t *pbus_handle, yDevStatus_t status)
+{
+    LL_GPIO_SetPinMode(pbus_handle->wr.gpioInfo.port, pbus_handle->wr.gpioInfo.pinMask, LL_GPIO_MODE_OUTPUT);
+    yDev_Pbus_Cs(pbus_handle, 1);
+
+    pbus_handle->result = status;
+    pbus_handle->busy = 0;
+    if (pbus_handle->async != 0U)
+    {
+        pbus_handle->async = 0;
+        yDevAsyncComplete(pbus_handle, YDEV_ASYNC_WRITE, status, pbus_handle->total - pbus_handle->remain);
+    }
+}
+
+/**
+ * @brief 选通定时器DMA中断回调实现
+ */
+static void yDev_Pbus_DmaEvent(void *arg, yDrvDmaExti_t event)
+{
+    yDevHandle_Pbus_t *pbus_handle = (yDevHandle_Pbus_t *)arg;
+    BaseType_t woken = pdFALSE;
+    yDevStatus_t status;
+
+    if (event == YDRV_DMA_EXTI_HT)
+    {
+        return;
+    }
+
+    if (event == YDRV_DMA_EXTI_TC)
+    {
+        // 最后一个字节已写到端口，其选通脉冲最多还剩一个周期
+        while (yDrvTimIsRunning(&pbus_handle->tim) != 0U)
+        {
+        }
+        pbus_handle->next += pbus_handle->chunk;
+        pbus_handle->remain -= pbus_handle->chunk;
+        if ((pbus_handle->remain != 0U) && (yDev_Pbus_DmaNext(pbus_handle) == YDRV_OK))
+        {
+            return;
+        }
+        status = (pbus_handle->remain == 0U) ? YDEV_OK : YDEV_ERROR;
+    }
+    else
+    {
+        // 传输错误时脉冲串可能还很长，直接停止定时器
+        (void)yDrvTimStop(&pbus_handle->tim);
+        pbus_handle->base.errno |= YDEV_PBUS_ERRNO_DMA;
+        status = YDEV_ERROR;
+    }
+
+    yDev_Pbus_DmaFinish(pbus_handle, status);
+    if (pbus_handle->waiter != NULL)
+    {
+        vTaskNotifyGiveFromISR((TaskHandle_t)pbus_handle->waiter, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 等待进行中的DMA写入完成实现
+ */
+static yDevStatus_t yDev_Pbus_Sync(yDevHandle_Pbus_t *pbus_handle)
+{
+    TickType_t wait;
+    uint32_t primask;
+
+    if (pbus_handle->busy == 0U)
+    {
+        return YDEV_OK;
+    }
+
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+    {
+        while (pbus_handle->busy != 0U)
+        {
+        }
+        return pbus_handle->result;
+    }
+
+    wait = (pbus_handle->base.timeOutMs == 0) ? portMAX_DELAY : pdMS_TO_TICKS(pbus_handle->base.timeOutMs);
+    pbus_handle->waiter = (void *)xTaskGetCurrentTaskHandle();
+    (void)ulTaskNotifyTake(pdTRUE, 0); // 清除残留通知
+    if ((pbus_handle->busy != 0U) && (ulTaskNotifyTake(pdTRUE, wait) == 0))
+    {
+        // 超时中止：停止选通和DMA，与完成中断互斥
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (pbus_handle->busy != 0U)
+        {
+            (void)yDrvTimStop(&pbus_handle->tim);
+            yDrvDmaTransDisable(&pbus_handle->tim.dma);
+            pbus_handle->tim.dmaActive = 0;
+            pbus_handle->base.errno |= YDEV_PBUS_ERRNO_TIMEOUT;
+            yDev_Pbus_DmaFinish(pbus_handle, YDEV_TIMEOUT);
+        }
+        __set_PRIMASK(primask);
+    }
+    pbus_handle->waiter = NULL;
+
+    return pbus_handle->result;
+}
+
+/**
+ * @brief DMA写入并等待完成实现
+ */
+static int32_t yDev_Pbus_DmaWrite(yDevHandle_Pbus_t *pbus_handle, const uint8_t *data, uint32_t len)
+{
+    if (yDev_Pbus_DmaStart(pbus_handle, data, len, 0) != YDEV_OK)
+    {
+        return -1;
+    }
+
+    if (yDev_Pbus_Sync(pbus_handle) != YDEV_OK)
+    {
+        return (int32_t)(pbus_handle->total - pbus_handle->remain);
+    }
+
+    return (int32_t)len;
+}
+
+// ==================== 并行总线设备操作函数 ====================
+
+/**
+ * @brief 并行总线设备初始化
+ * @param config 并行总线设备配置参数
+ * @param handle 并行总线设备句柄
+ * @return yDevStatus_t 初始化状态
+ *
+ * @par 功能描述:
+ * 配置数据线和控制线为输出并置为无效电平；DMA模式下初始化选通定时器并使能通道，
+ * 使复用功能切换时引脚已由定时器驱动在无效电平
+ */
+static yDevStatus_t yDev_Pbus_Init(void *config, void *handle)
+{
+    yDevConfig_Pbus_t *pbus_config;
+    yDevHandle_Pbus_t *pbus_handle;
+    yDrvGpioPortConfig_t port_config;
+    yDrvGpioConfig_t pin_config;
+    yDrvTimConfig_t tim_config;
+    uint32_t i;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    pbus_handle = (yDevHandle_Pbus_t *)handle;
+    pbus_config = (yDevConfig_Pbus_t *)config;
+
+    if (((pbus_config->width != 8U) && (pbus_config->width != 4U)) || (pbus_config->mode > YDEV_PBUS_MODE_6800) ||
+        (pbus_config->data == YDRV_PINNULL) || (pbus_config->wr == YDRV_PINNULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    pbus_handle->width = pbus_config->width;
+    pbus_handle->mode = pbus_config->mode;
+    pbus_handle->cpuDelay = pbus_config->cpuDelay;
+    pbus_handle->dmaMin = (pbus_config->dmaMin == 0U) ? 1U : pbus_config->dmaMin;
+    pbus_handle->busy = 0;
+    pbus_handle->async = 0;
+    pbus_handle->waiter = NULL;
+    pbus_handle->result = YDEV_OK;
+    pbus_handle->odr = NULL;
+    pbus_handle->chunkMax = 0;
+
+    // 1. 数据线
+    port_config = YDRV_GPIO_PORT_CONFIG_DEFAULT();
+    port_config.pin = pbus_config->data;
+    port_config.mask = (pbus_config->width == 8U) ? 0xFFU : 0x0FU;
+    port_config.mode = YDRV_GPIO_MODE_OUTPUT_PP;
+    port_config.speed = YDRV_GPIO_SPEED_LEVEL3;
+    if (yDrvGpioPortInitStatic(&port_config, &pbus_handle->data) != YDRV_OK)
+    {
+        pbus_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_INVALID_PARAM;
+    }
+    pbus_handle->moderMask = 0;
+    pbus_handle->moderOut = 0;
+    for (i = 0; i < 16U; i++)
+    {
+        if ((pbus_handle->data.mask & (1UL << i)) != 0U)
+        {
+            pbus_handle->moderMask |= 3UL << (i * 2U);
+            pbus_handle->moderOut |= 1UL << (i * 2U);
+        }
+    }
+
+    // 2. 控制线，先置无效电平再切为输出
+    pin_config = YDRV_GPIO_CONFIG_DEFAULT();
+    pin_config.mode = YDRV_GPIO_MODE_OUTPUT_PP;
+    pin_config.speed = YDRV_GPIO_SPEED_LEVEL3;
+
+    pin_config.pin = pbus_config->wr;
+    if (yDrvParseGpio(pbus_config->wr, &pbus_handle->wr.gpioInfo) != YDRV_OK)
+    {
+        (void)yDrvGpioPortDeInitStatic(&pbus_handle->data);
+        pbus_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_INVALID_PARAM;
+    }
+    if (pbus_config->mode == YDEV_PBUS_MODE_8080)
+    {
+        pbus_handle->strobeOn = (uint32_t)pbus_handle->wr.gpioInfo.pinMask << 16;
+        pbus_handle->strobeOff = pbus_handle->wr.gpioInfo.pinMask;
+    }
+    else
+    {
+        pbus_handle->strobeOn = pbus_handle->wr.gpioInfo.pinMask;
+        pbus_handle->strobeOff = (uint32_t)pbus_handle->wr.gpioInfo.pinMask << 16;
+    }
+    pbus_handle->wr.gpioInfo.port->BSRR = pbus_handle->strobeOff;
+    (void)yDrvGpioInitStatic(&pin_config, &pbus_handle->wr);
+    pbus_handle->strobeMerge = (pbus_handle->wr.gpioInfo.port == pbus_handle->data.port) ? pbus_handle->strobeOn : 0U;
+
+    pbus_handle->rd = YDRV_GPIO_HANDLE_DEFAULT();
+    if ((pbus_config->rd != YDRV_PINNULL) && (yDrvParseGpio(pbus_config->rd, &pbus_handle->rd.gpioInfo) == YDRV_OK))
+    {
+        // 8080的RD高为无效，6800的R/W低为写
+        pin_config.pin = pbus_config->rd;
+        pbus_handle->rd.gpioInfo.port->BSRR = (pbus_config->mode == YDEV_PBUS_MODE_8080)
+                                                  ? pbus_handle->rd.gpioInfo.pinMask
+                                                  : ((uint32_t)pbus_handle->rd.gpioInfo.pinMask << 16);
+        (void)yDrvGpioInitStatic(&pin_config, &pbus_handle->rd);
+    }
+
+    pbus_handle->dc = YDRV_GPIO_HANDLE_DEFAULT();
+    if ((pbus_config->dc != YDRV_PINNULL) && (yDrvParseGpio(pbus_config->dc, &pbus_handle->dc.gpioInfo) == YDRV_OK))
+    {
+        pin_config.pin = pbus_config->dc;
+        pbus_handle->dc.gpioInfo.port->BSRR = pbus_handle->dc.gpioInfo.pinMask;
+        (void)yDrvGpioInitStatic(&pin_config, &pbus_handle->dc);
+    }
+
+    pbus_handle->cs = YDRV_GPIO_HANDLE_DEFAULT();
+    if ((pbus_config->cs != YDRV_PINNULL) && (yDrvParseGpio(pbus_config->cs, &pbus_handle->cs.gpioInfo) == YDRV_OK))
+    {
+        pin_config.pin = pbus_config->cs;
+        pbus_handle->cs.gpioInfo.port->BSRR = pbus_handle->cs.gpioInfo.pinMask;
+        (void)yDrvGpioInitStatic(&pin_config, &pbus_handle->cs);
+    }
+
+    // 3. DMA选通定时器，数据须占ODR的一个完整字节
+    pbus_handle->tim = YDRV_TIM_HANDLE_DEFAULT();
+    if (pbus_config->useDma == 0U)
+    {
+        return YDEV_OK;
+    }
+    if ((pbus_config->width != 8U) || ((pbus_handle->data.shift != 0U) && (pbus_handle->data.shift != 8U)))
+    {
+        pbus_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_INVALID_PARAM;
+    }
+
+    tim_config = pbus_config->strobe;
+    tim_config.mode = YDRV_TIM_MODE_ONE_PULSE;
+    tim_config.pin = pbus_config->wr;
+    tim_config.openDrain = 0;
+    tim_config.polarity = (pbus_config->mode == YDEV_PBUS_MODE_8080) ? YDRV_TIM_POLARITY_LOW : YDRV_TIM_POLARITY_HIGH;
+    tim_config.dma.circular = 0;
+    tim_config.dma.callback = yDev_Pbus_DmaEvent;
+    tim_config.dma.arg = pbus_handle;
+    if (yDrvTimInitStatic(&tim_config, &pbus_handle->tim) != YDRV_OK)
+    {
+        pbus_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_ERROR;
+    }
+    pbus_handle->chunkMax = yDrvTimPulseDmaMax(&pbus_handle->tim);
+    if (pbus_handle->chunkMax == 0U)
+    {
+        (void)yDrvTimDeInitStatic(&pbus_handle->tim);
+        pbus_handle->tim = YDRV_TIM_HANDLE_DEFAULT();
+        pbus_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    // 单脉冲模式下启动只使能通道；定时器初始化把引脚设为复用功能，空闲时切回GPIO输出
+    (void)yDrvTimStart(&pbus_handle->tim);
+    LL_GPIO_SetPinMode(pbus_handle->wr.gpioInfo.port, pbus_handle->wr.gpioInfo.pinMask, LL_GPIO_MODE_OUTPUT);
+    pbus_handle->odr = (volatile uint8_t *)&pbus_handle->data.port->ODR + (pbus_handle->data.shift / 8U);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 并行总线设备反初始化
+ * @param handle 并行总线设备句柄
+ * @return yDevStatus_t 操作状态
+ * @note 进行中的DMA写入以错误结束
+ */
+static yDevStatus_t yDev_Pbus_Deinit(void *handle)
+{
+    yDevHandle_Pbus_t *pbus_handle;
+    uint32_t primask;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    pbus_handle = (yDevHandle_Pbus_t *)handle;
+
+    if (pbus_handle->tim.instance != NULL)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (pbus_handle->busy != 0U)
+        {
+            (void)yDrvTimStop(&pbus_handle->tim);
+            yDev_Pbus_DmaFinish(pbus_handle, YDEV_ERROR);
+        }
+        __set_PRIMASK(primask);
+        (void)yDrvTimDeInitStatic(&pbus_handle->tim);
+        pbus_handle->tim = YDRV_TIM_HANDLE_DEFAULT();
+    }
+
+    (void)yDrvGpioPortDeInitStatic(&pbus_handle->data);
+    (void)yDrvGpioDeInitStatic(&pbus_handle->wr);
+    if (pbus_handle->rd.gpioInfo.port != NULL)
+    {
+        (void)yDrvGpioDeInitStatic(&pbus_handle->rd);
+    }
+    if (pbus_handle->dc.gpioInfo.port != NULL)
+    {
+        (void)yDrvGpioDeInitStatic(&pbus_handle->dc);
+    }
+    if (pbus_handle->cs.gpioInfo.port != NULL)
+    {
+        (void)yDrvGpioDeInitStatic(&pbus_handle->cs);
+    }
+
+    return YDEV_OK;
+}
+
+void yDevPbusConfigStructInit(yDevConfig_Pbus_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    *config = YDEV_PBUS_CONFIG_DEFAULT();
+}
+
+void yDevPbusHandleStructInit(yDevHandle_Pbus_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    memset(handle, 0, sizeof(yDevHandle_Pbus_t));
+    *handle = YDEV_PBUS_HANDLE_DEFAULT();
+}
+
+/**
+ * @brief 并行总线设备读取操作
+ * @param handle 并行总线设备句柄
+ * @param buffer 读取缓冲区
+ * @param size 读取字节数
+ * @return int32_t 实际读取的字节数，-1表示错误或只写总线
+ * @note 使用当前D/C电平，由CPU选通
+ */
+static int32_t yDev_Pbus_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Pbus_t *pbus_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return -1;
+    }
+
+    pbus_handle = (yDevHandle_Pbus_t *)handle;
+    if ((pbus_handle->data.port == NULL) || (pbus_handle->rd.gpioInfo.port == NULL) ||
+        (yDev_Pbus_Sync(pbus_handle) != YDEV_OK))
+    {
+        return -1;
+    }
+
+    yDev_Pbus_Cs(pbus_handle, 0);
+    yDev_Pbus_ReadCpu(pbus_handle, (uint8_t *)buffer, (uint32_t)size);
+    yDev_Pbus_Cs(pbus_handle, 1);
+
+    return (int32_t)size;
+}
+
+/**
+ * @brief 并行总线设备写入操作
+ * @param handle 并行总线设备句柄
+ * @param buffer 写入缓冲区
+ * @param size 写入字节数
+ * @return int32_t 实际写入的字节数，-1表示错误
+ * @note 使用当前D/C电平；DMA模式下不少于dmaMin的写入由DMA完成，任务等待期间不占用CPU
+ */
+static int32_t yDev_Pbus_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_Pbus_t *pbus_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size == 0))
+    {
+        return -1;
+    }
+
+    pbus_handle = (yDevHandle_Pbus_t *)handle;
+    if ((pbus_handle->data.port == NULL) || (yDev_Pbus_Sync(pbus_handle) != YDEV_OK))
+    {
+        return -1;
+    }
+
+    if ((pbus_handle->tim.instance != NULL) && (size >= pbus_handle->dmaMin))
+    {
+        return yDev_Pbus_DmaWrite(pbus_handle, (const uint8_t *)buffer, (uint32_t)size);
+    }
+
+    yDev_Pbus_Cs(pbus_handle, 0);
+    yDev_Pbus_WriteCpu(pbus_handle, (const uint8_t *)buffer, (uint32_t)size);
+    yDev_Pbus_Cs(pbus_handle, 1);
+
+    return (int32_t)size;
+}
+
+/**
+ * @brief 并行总线设备异步写入
+ * @param handle 并行总线设备句柄
+ * @param buffer 写入缓冲区，完成前保持有效
+ * @param size 写入字节数
+ * @return yDevStatus_t 启动状态
+ *
+ * @par 功能描述:
+ * DMA模式下启动后立即返回，整帧写完后在DMA中断中通知完成；
+ * 没有DMA或长度小于dmaMin时由CPU写完后直接完成
+ */
+static yDevStatus_t yDev_Pbus_WriteAsync(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_Pbus_t *pbus_handle = (yDevHandle_Pbus_t *)handle;
+
+    if ((buffer == NULL) || (size == 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    if (pbus_handle->data.port == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+    if (pbus_handle->busy != 0U)
+    {
+        return YDEV_BUSY;
+    }
+
+    if ((pbus_handle->tim.instance != NULL) && (size >= pbus_handle->dmaMin))
+    {
+        return yDev_Pbus_DmaStart(pbus_handle, (const uint8_t *)buffer, (uint32_t)size, 1);
+    }
+
+    yDev_Pbus_Cs(pbus_handle, 0);
+    yDev_Pbus_WriteCpu(pbus_handle, (const uint8_t *)buffer, (uint32_t)size);
+    yDev_Pbus_Cs(pbus_handle, 1);
+    yDevAsyncComplete(pbus_handle, YDEV_ASYNC_WRITE, YDEV_OK, (uint32_t)size);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 并行总线设备控制操作
+ * @param handle 并行总线设备句柄
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 支持的命令:
+ * - YDEV_PBUS_SET_DC: 设置D/C电平
+ * - YDEV_PBUS_COMMAND: 命令字节加参数，片选在整个命令期间保持
+ * - YDEV_PBUS_SYNC: 等待DMA写入完成
+ * - YDEV_IOCTL_GET_STATUS: 获取设备状态，DMA写入进行中为YDEV_BUSY
+ */
+static yDevStatus_t yDev_Pbus_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_Pbus_t *pbus_handle;
+    yDevPbusCommand_t *command;
+    yDevStatus_t status;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    pbus_handle = (yDevHandle_Pbus_t *)handle;
+    if (pbus_handle->data.port == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_PBUS_SET_DC:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        status = yDev_Pbus_Sync(pbus_handle);
+        yDev_Pbus_Dc(pbus_handle, *(uint32_t *)arg);
+        return status;
+
+    case YDEV_PBUS_COMMAND:
+        command = (yDevPbusCommand_t *)arg;
+        if ((command == NULL) || ((command->param == NULL) && (command->len != 0U)))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        status = yDev_Pbus_Sync(pbus_handle);
+        if (status != YDEV_OK)
+        {
+            return status;
+        }
+
+        yDev_Pbus_Cs(pbus_handle, 0);
+        yDev_Pbus_Dc(pbus_handle, 0);
+        yDev_Pbus_WriteCpu(pbus_handle, &command->cmd, 1);
+        yDev_Pbus_Dc(pbus_handle, 1);
+        if ((pbus_handle->tim.instance != NULL) && (command->len >= pbus_handle->dmaMin))
+        {
+            // DMA写入结束时释放片选
+            return (yDev_Pbus_DmaWrite(pbus_handle, command->param, command->len) == (int32_t)command->len)
+                       ? YDEV_OK
+                       : YDEV_ERROR;
+        }
+        yDev_Pbus_WriteCpu(pbus_handle, command->param, command->len);
+        yDev_Pbus_Cs(pbus_handle, 1);
+        return YDEV_OK;
+
+    case YDEV_PBUS_SYNC:
+        return yDev_Pbus_Sync(pbus_handle);
+
+    case YDEV_IOCTL_GET_STATUS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(yDevStatus_t *)arg = (pbus_handle->busy != 0U) ? YDEV_BUSY : YDEV_OK;
+        return YDEV_OK;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+// ==================== 设备操作表导出 ====================
+
+YDEV_OPS_EXPORT_ASYNC(
+    YDEV_TYPE_PBUS,        // 设备类型
+    yDev_Pbus_Init,        // 初始化函数
+    yDev_Pbus_Deinit,      // 反初始化函数
+    yDev_Pbus_Read,        // 读取函数
+    yDev_Pbus_Write,       // 写入函数
+    yDev_Pbus_Ioctl,       // 控制函数
+    NULL,                  // 异步读取函数
+    yDev_Pbus_WriteAsync); // 异步写入函数
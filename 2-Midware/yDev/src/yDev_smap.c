@@ -0,0 +1,466 @@
+/**
+ * @file yDev_smap.c
+ * @brief 基于25Q Flash的持久化扇区状态表实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * RAM中保存完整状态表，Flash中保存一份状态表快照和其后的变化日志；
+ * 挂载时读取快照再按顺序重放日志，日志写满时把RAM状态表压缩为新快照
+ *
+ * @par 主要功能:
+ * - 日志条目: 扇区序号(16位) + 状态(8位) + 校验(8位)，掉电写坏的条目在重放时跳过
+ * - 压缩写入另一个表扇区: 擦除 → 状态表 → 表头，表头带序号和CRC，最后写入
+ * - 两个表扇区中选序号较大且CRC正确的一个，新快照写到一半掉电时仍用旧快照和它的日志
+ *
+ * @par 使用说明:
+ * - 接口不可重入，多任务访问时由调用者串行化
+ * - 表扇区和存储区必须扇区对齐，调用前25Q设备需已初始化
+ *
+ * @par 更新历史:
+ * - v1.0 (2025): 初始版本
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_smap.h"
+#include "yDev_def.h"
+#include "yLib_crc.h"
+
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define YDEV_SMAP_ENTRY_EMPTY (0xFFFFFFFFUL) /*!< 未写入的日志条目 */
+#define YDEV_SMAP_REPLAY_CHUNK (16)          /*!< 重放日志时每次读取的条目数 */
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 表头结构(Flash布局)，后16字节保留为擦除值
+ */
+typedef struct
+{
+    uint32_t magic;       /*!< YDEV_SMAP_MAGIC */
+    uint32_t seq;         /*!< 表序号，越大越新 */
+    uint32_t baseAddress; /*!< 存储区起始地址 */
+    uint16_t sectorCount; /*!< 存储区扇区数 */
+    uint16_t crc;         /*!< 表头前14字节+状态表的CRC16-CCITT */
+} yDevSmapHeader_t;
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 获取表扇区地址
+ * @param smap 状态表句柄指针
+ * @param copy 表扇区，0=A，1=B
+ * @retval uint32_t Flash地址
+ */
+static uint32_t yDevSmap_CopyAddress(yDevSmap_t *smap, uint8_t copy)
+{
+    return smap->mapAddress + (uint32_t)copy * YDEV_25Q_SECTOR_SIZE;
+}
+
+/**
+ * @brief 获取日志在表扇区内的偏移
+ * @param count 扇区数
+ * @retval uint32_t 偏移
+ */
+static uint32_t yDevSmap_JournalOffset(uint16_t count)
+{
+    return YDEV_SMAP_HEADER_SIZE + ((YDEV_SMAP_BYTES(count) + 3U) & ~3U);
+}
+
+/**
+ * @brief 计算日志条目的校验字节
+ */
+static uint8_t yDevSmap_EntryCheck(uint16_t sector, uint8_t state)
+{
+    return (uint8_t)~((uint8_t)sector ^ (uint8_t)(sector >> 8) ^ state);
+}
+
+/**
+ * @brief 写入RAM状态表
+ */
+static void yDevSmap_Store(yDevSmap_t *smap, uint16_t sector, uint8_t state)
+{
+    uint8_t shift = (uint8_t)((sector & 0x03U) * 2U);
+
+    smap->map[sector >> 2] = (uint8_t)((smap->map[sector >> 2] & ~(0x03U << shift)) | ((uint32_t)state << shift));
+}
+
+/**
+ * @brief 读取RAM状态表
+ */
+static uint8_t yDevSmap_Load(yDevSmap_t *smap, uint16_t sector)
+{
+    return (uint8_t)((smap->map[sector >> 2] >> ((sector & 0x03U) * 2U)) & 0x03U);
+}
+
+/**
+ * @brief 计算表头和状态表的CRC
+ */
+static uint16_t yDevSmap_Crc(yDevSmap_t *smap, const yDevSmapHeader_t *header)
+{
+    uint16_t crc;
+
+    crc = ylib_crc16(YLIB_CRC16_INIT, header, offsetof(yDevSmapHeader_t, crc));
+    return ylib_crc16(crc, smap->map, YDEV_SMAP_BYTES(smap->sectorCount));
+}
+
+/**
+ * @brief 向Flash写入数据
+ * @note 目标区域已擦除，25Q写入路径只编程目标字节范围
+ */
+static yDevStatus_t yDevSmap_Program(yDevSmap_t *smap, uint32_t address, const void *data, uint32_t size)
+{
+    smap->flash->address = address;
+    if (yDevWrite(smap->flash, data, size) != (int32_t)size)
+    {
+        return YDEV_ERROR;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 把RAM状态表压缩为另一个表扇区中的新快照
+ * @retval yDevStatus_t 操作状态，失败时当前表扇区和日志位置不变
+ */
+static yDevStatus_t yDevSmap_Compact(yDevSmap_t *smap)
+{
+    yDevSmapHeader_t header;
+    uint8_t target = (uint8_t)(smap->copy ^ 1U);
+    uint32_t address = yDevSmap_CopyAddress(smap, target);
+
+    // 表头最后写入，之前掉电时目标扇区没有魔术字，旧快照仍有效
+    if (yDevIoctl(smap->flash, YDEV_25Q_IOCTL_SECTOR_ERASE, &address) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+    if (yDevSmap_Program(smap, address + YDEV_SMAP_HEADER_SIZE, smap->map, YDEV_SMAP_BYTES(smap->sectorCount)) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    header.magic = YDEV_SMAP_MAGIC;
+    header.seq = smap->seq + 1U;
+    header.baseAddress = smap->baseAddress;
+    header.sectorCount = smap->sectorCount;
+    header.crc = yDevSmap_Crc(smap, &header);
+    if (yDevSmap_Program(smap, address, &header, sizeof(header)) != YDEV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    smap->copy = target;
+    smap->seq = header.seq;
+    smap->journal = 0;
+    smap->compactions++;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 读取并校验一个表扇区的快照
+ * @param smap 状态表句柄指针
+ * @param copy 表扇区
+ * @param header 已读出的表头
+ * @retval yDevStatus_t YDEV_OK表示快照有效并已读入RAM状态表
+ */
+static yDevStatus_t yDevSmap_LoadCopy(yDevSmap_t *smap, uint8_t copy, const yDevSmapHeader_t *header)
+{
+    uint32_t bytes = YDEV_SMAP_BYTES(smap->sectorCount);
+
+    if (yDev25qRead(smap->flash, yDevSmap_CopyAddress(smap, copy) + YDEV_SMAP_HEADER_SIZE, smap->map, bytes) != (int32_t)bytes)
+    {
+        return YDEV_ERROR;
+    }
+    if (yDevSmap_Crc(smap, header) != header->crc)
+    {
+        return YDEV_ERROR;
+    }
+    return YDEV_OK;
+}
+
+/**
+ * @brief 按顺序重放当前表扇区的日志
+ * @retval yDevStatus_t 操作状态
+ * @note 遇到第一个未写入的条目停止，校验失败或越界的条目跳过但占用位置
+ */
+static yDevStatus_t yDevSmap_Replay(yDevSmap_t *smap)
+{
+    uint32_t entry[YDEV_SMAP_REPLAY_CHUNK];
+    uint32_t address;
+    uint16_t sector;
+    uint16_t n;
+    uint16_t i;
+    uint8_t state;
+
+    address = yDevSmap_CopyAddress(smap, smap->copy) + yDevSmap_JournalOffset(smap->sectorCount);
+    smap->journal = 0;
+    while (smap->journal < smap->journalMax)
+    {
+        n = (uint16_t)(smap->journalMax - smap->journal);
+        if (n > YDEV_SMAP_REPLAY_CHUNK)
+        {
+            n = YDEV_SMAP_REPLAY_CHUNK;
+        }
+        if (yDev25qRead(smap->flash, address + (uint32_t)smap->journal * 4U, entry, (uint32_t)n * 4U) != (int32_t)(n * 4U))
+        {
+            return YDEV_ERROR;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            if (entry[i] == YDEV_SMAP_ENTRY_EMPTY)
+            {
+                return YDEV_OK;
+            }
+            smap->journal++;
+
+            sector = (uint16_t)entry[i];
+            state = (uint8_t)(entry[i] >> 16);
+            if ((sector < smap->sectorCount) && (state <= YDEV_SMAP_FULL) &&
+                ((uint8_t)(entry[i] >> 24) == yDevSmap_EntryCheck(sector, state)))
+            {
+                yDevSmap_Store(smap, sector, state);
+            }
+        }
+    }
+
+    return YDEV_OK;
+}
+
+// ==================== 公共函数 ====================
+
+/**
+ * @brief 挂载扇区状态表实现
+ */
+yDevStatus_t yDevSmapMount(yDevSmap_t *smap, const yDevSmapConfig_t *config)
+{
+    yDevSmapHeader_t header[2];
+    uint32_t mapEnd;
+    uint32_t baseEnd;
+    uint8_t order[2];
+    uint8_t valid[2];
+    uint8_t i;
+    yDevStatus_t status;
+
+    // 参数有效性检查，表扇区不能落在存储区内
+    if ((smap == NULL) || (config == NULL) || (config->flash == NULL) || (config->sectorCount == 0) ||
+        ((config->mapAddress % YDEV_25Q_SECTOR_SIZE) != 0) ||
+        ((config->baseAddress % YDEV_25Q_SECTOR_SIZE) != 0))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    mapEnd = config->mapAddress + 2U * YDEV_25Q_SECTOR_SIZE;
+    baseEnd = config->baseAddress + (uint32_t)config->sectorCount * YDEV_25Q_SECTOR_SIZE;
+    if ((mapEnd > config->flash->size) || (baseEnd > config->flash->size) ||
+        ((config->mapAddress < baseEnd) && (config->baseAddress < mapEnd)) ||
+        (yDevSmap_JournalOffset(config->sectorCount) + YDEV_SMAP_JOURNAL_MIN * 4U > YDEV_25Q_SECTOR_SIZE))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    memset(smap, 0, sizeof(*smap));
+    smap->flash = config->flash;
+    smap->mapAddress = config->mapAddress;
+    smap->baseAddress = config->baseAddress;
+    smap->sectorCount = config->sectorCount;
+    smap->journalMax = (uint16_t)((YDEV_25Q_SECTOR_SIZE - yDevSmap_JournalOffset(config->sectorCount)) / 4U);
+
+    if (config->mapBuffer != NULL)
+    {
+        smap->map = (uint8_t *)config->mapBuffer;
+        smap->mapStatic = 1;
+    }
+    else
+    {
+        smap->map = (uint8_t *)YDEV_MALLOC(YDEV_SMAP_BYTES(smap->sectorCount));
+    }
+    if (smap->map == NULL)
+    {
+        return YDEV_NO_MEMORY;
+    }
+
+    // 读取两个表头，只接受描述同一存储区的
+    for (i = 0; i < 2; i++)
+    {
+        if (yDev25qRead(smap->flash, yDevSmap_CopyAddress(smap, i), &header[i], sizeof(header[i])) != (int32_t)sizeof(header[i]))
+        {
+            yDevSmapUnmount(smap);
+            return YDEV_ERROR;
+        }
+        valid[i] = ((header[i].magic == YDEV_SMAP_MAGIC) && (header[i].seq != 0) && (header[i].seq != 0xFFFFFFFFUL) &&
+                    (header[i].baseAddress == smap->baseAddress) && (header[i].sectorCount == smap->sectorCount))
+                       ? 1
+                       : 0;
+    }
+
+    // 先试序号较大的快照，CRC不对时退回另一个
+    order[0] = ((valid[1] != 0) && ((valid[0] == 0) || (header[1].seq > header[0].seq))) ? 1 : 0;
+    order[1] = (uint8_t)(order[0] ^ 1U);
+    smap->mounted = 1;
+    for (i = 0; i < 2; i++)
+    {
+        if ((valid[order[i]] == 0) || (yDevSmap_LoadCopy(smap, order[i], &header[order[i]]) != YDEV_OK))
+        {
+            continue;
+        }
+
+        smap->copy = order[i];
+        smap->seq = header[order[i]].seq;
+        status = yDevSmap_Replay(smap);
+        if (status != YDEV_OK)
+        {
+            yDevSmapUnmount(smap);
+        }
+        return status;
+    }
+
+    // 没有可用快照，新建全UNKNOWN的状态表，写到A
+    smap->copy = 1;
+    smap->seq = 0;
+    smap->formatted = 1;
+    status = yDevSmapFormat(smap, YDEV_SMAP_UNKNOWN);
+    if (status != YDEV_OK)
+    {
+        yDevSmapUnmount(smap);
+    }
+    return status;
+}
+
+/**
+ * @brief 卸载扇区状态表实现
+ */
+yDevStatus_t yDevSmapUnmount(yDevSmap_t *smap)
+{
+    if (smap == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if ((smap->map != NULL) && (smap->mapStatic == 0))
+    {
+        YDEV_FREE(smap->map);
+    }
+    smap->map = NULL;
+    smap->mounted = 0;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 把全部扇区设为同一状态实现
+ */
+yDevStatus_t yDevSmapFormat(yDevSmap_t *smap, yDevSmapState_t state)
+{
+    if ((smap == NULL) || (smap->mounted == 0) || (state > YDEV_SMAP_FULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 每字节4个扇区，0x55倍数即4个相同的2位状态
+    memset(smap->map, (int)((uint32_t)state * 0x55U), YDEV_SMAP_BYTES(smap->sectorCount));
+    return yDevSmap_Compact(smap);
+}
+
+/**
+ * @brief 读取扇区状态实现
+ */
+yDevSmapState_t yDevSmapGet(yDevSmap_t *smap, uint16_t sector)
+{
+    if ((smap == NULL) || (smap->mounted == 0) || (sector >= smap->sectorCount))
+    {
+        return YDEV_SMAP_UNKNOWN;
+    }
+
+    return (yDevSmapState_t)yDevSmap_Load(smap, sector);
+}
+
+/**
+ * @brief 设置扇区状态实现
+ */
+yDevStatus_t yDevSmapSet(yDevSmap_t *smap, uint16_t sector, yDevSmapState_t state)
+{
+    uint32_t entry;
+    uint32_t address;
+    uint8_t old;
+    yDevStatus_t status;
+
+    if ((smap == NULL) || (smap->mounted == 0) || (sector >= smap->sectorCount) || (state > YDEV_SMAP_FULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    old = yDevSmap_Load(smap, sector);
+    if (old == (uint8_t)state)
+    {
+        return YDEV_OK;
+    }
+
+    yDevSmap_Store(smap, sector, (uint8_t)state);
+    if (smap->journal >= smap->journalMax)
+    {
+        // 新快照已包含这次变化，不再写日志
+        status = yDevSmap_Compact(smap);
+    }
+    else
+    {
+        // 写失败的位置可能已部分编程，同样跳过，不在上面重写
+        entry = (uint32_t)sector | ((uint32_t)state << 16) | ((uint32_t)yDevSmap_EntryCheck(sector, (uint8_t)state) << 24);
+        address = yDevSmap_CopyAddress(smap, smap->copy) + yDevSmap_JournalOffset(smap->sectorCount) + (uint32_t)smap->journal * 4U;
+        smap->journal++;
+        status = yDevSmap_Program(smap, address, &entry, sizeof(entry));
+    }
+
+    if (status != YDEV_OK)
+    {
+        yDevSmap_Store(smap, sector, old);
+    }
+    return status;
+}
+
+/**
+ * @brief 查找指定状态的扇区实现
+ */
+int32_t yDevSmapFind(yDevSmap_t *smap, yDevSmapState_t state, uint16_t from)
+{
+    uint32_t sector;
+
+    if ((smap == NULL) || (smap->mounted == 0))
+    {
+        return -1;
+    }
+
+    for (sector = from; sector < smap->sectorCount; sector++)
+    {
+        if (yDevSmap_Load(smap, (uint16_t)sector) == (uint8_t)state)
+        {
+            return (int32_t)sector;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief 统计指定状态的扇区数实现
+ */
+uint32_t yDevSmapCount(yDevSmap_t *smap, yDevSmapState_t state)
+{
+    uint32_t count = 0;
+    uint16_t sector;
+
+    if ((smap == NULL) || (smap->mounted == 0))
+    {
+        return 0;
+    }
+
+    for (sector = 0; sector < smap->sectorCount; sector++)
+    {
+        if (yDevSmap_Load(smap, sector) == (uint8_t)state)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
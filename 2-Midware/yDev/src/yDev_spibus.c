@@ -0,0 +1,647 @@
+/**
+ * @file yDev_spibus.c
+ * @brief 共享SPI总线管理实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 总线对象初始化一次SPI外设并持有作业调度器，挂接的器件通过加锁获取总线，
+ * 加锁时按需切换时钟模式/速率并把总线句柄的片选指向当前器件
+ *
+ * @par 主要功能:
+ * - 总线初始化/反初始化，统一登记中断和DMA传输引擎
+ * - 器件挂接/分离，片选引脚配置为推挽输出
+ * - 加锁时比较器件参数与当前总线参数，只在不同时调用yDrvSpiSetFormat
+ * - 总线内传输按长度选择DMA、中断或打包轮询
+ * - 完整事务: 加锁、片选、分段传输、释放片选、解锁
+ * - 批量事务: 一次加锁访问多个器件，参数相同的相邻器件由DMA中断接续
+ *
+ * @par 使用说明:
+ * - 总线须在挂接器件前初始化，器件分离后才可反初始化总线
+ * - 中断和DMA传输完成回调在中断中执行，只唤醒等待任务
+ *
+ * @par 更新历史:
+ * - v1.0 (2025): 初始版本
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_spibus.h"
+#include "yDev_def.h"
+#include "yDrv_gpio.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+#define YDEV_SPIBUS_DMA_MAX_SIZE (65535) /*!< 单次DMA最大传输字节数 (CNDTR为16位) */
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 切换总线参数到指定器件
+ * @param device 器件结构体指针
+ * @retval 无
+ * @note 参数与当前总线参数相同时不访问SPI寄存器
+ */
+static void yDevSpiBus_Select(yDevSpiBusDevice_t *device);
+
+/**
+ * @brief 启动异步传输并等待完成
+ * @param bus 总线结构体指针
+ * @param tx 发送缓冲区
+ * @param rx 接收缓冲区
+ * @param len 传输字节数
+ * @param flagDma 非0使用DMA，0使用中断
+ * @retval int32_t 实际传输的字节数
+ * @note 调用任务阻塞等待完成通知，超时则中止传输
+ */
+static int32_t yDevSpiBus_AsyncTransfer(yDevSpiBus_t *bus, const void *tx, void *rx, uint32_t len, uint8_t flagDma);
+
+/**
+ * @brief SPI总线中断/DMA传输完成回调
+ * @param arg 总线结构体指针
+ * @param status 传输结果
+ * @note 在中断中执行，置位完成标志并唤醒等待任务
+ */
+static void yDevSpiBus_DoneCallback(void *arg, yDrvStatus_t status);
+
+/**
+ * @brief 批量事务DMA完成回调
+ * @param arg 总线结构体指针
+ * @param status 传输结果
+ * @note 在DMA中断中执行，释放当前项片选，本串还有剩余项时选中下一项并启动传输，
+ *       全部结束后唤醒等待任务
+ */
+static void yDevSpiBus_BatchCallback(void *arg, yDrvStatus_t status);
+
+/**
+ * @brief 两个器件的时钟模式和速率是否相同
+ */
+static uint8_t yDevSpiBus_SameFormat(const yDevSpiBusDevice_t *a, const yDevSpiBusDevice_t *b);
+
+// ==================== SPI总线公共函数实现 ====================
+
+/**
+ * @brief 初始化SPI总线实现
+ * @param bus 总线结构体指针
+ * @param config 总线配置指针
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevSpiBusInit(yDevSpiBus_t *bus, const yDevSpiBusConfig_t *config)
+{
+    yDrvSpiConfig_t spi_config;
+
+    if ((bus == NULL) || (config == NULL) ||
+        (config->spiId >= YDRV_SPI_MAX))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    memset(bus, 0, sizeof(*bus));
+
+    // 1. 初始化SPI外设，片选由总线按器件切换
+    yDrvSpiConfigStructInit(&spi_config);
+    spi_config.spiId = config->spiId;
+    spi_config.direction = YDRV_SPI_DIR_2LINES_FULL_DUPLEX;
+    spi_config.dataBits = 8;
+    spi_config.mode = YDRV_SPI_MODE_MASTER;
+    spi_config.polarity = YDRV_SPI_POLARITY_LOW;
+    spi_config.phase = YDRV_SPI_PHASE_1EDGE;
+    spi_config.csMode = YDRV_SPI_CS_SOFT;
+    spi_config.speed = YDRV_SPI_SPEED_LEVEL0;
+    spi_config.bitOrder = YDRV_SPI_BITORDER_MSB;
+    spi_config.sckPin = config->sckPin;
+    spi_config.misoPin = config->misoPin;
+    spi_config.mosiPin = config->mosiPin;
+    spi_config.sckAF = config->sckAF;
+    spi_config.misoAF = config->misoAF;
+    spi_config.mosiAF = config->mosiAF;
+    if (yDrvSpiInitStatic(&spi_config, &bus->spi) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+    bus->polarity = YDRV_SPI_POLARITY_LOW;
+    bus->phase = YDRV_SPI_PHASE_1EDGE;
+    bus->speed = YDRV_SPI_SPEED_LEVEL0;
+    bus->timeOutMs = config->timeOutMs;
+
+    // 2. 初始化总线作业调度器
+    yDevBusSchedInit(&bus->sched);
+
+    // 3. 登记中断和DMA传输引擎，失败时退回轮询
+    bus->flagIrq = (yDrvSpiItInit(&bus->spi, YDEV_SPIBUS_IRQ_PRIO) == YDRV_OK) ? 1 : 0;
+    if (config->dmaEnable != 0)
+    {
+        bus->flagDma = (yDrvSpiDmaInit(&bus->spi,
+                                       config->rxDmaChannel,
+                                       config->txDmaChannel,
+                                       YDEV_SPIBUS_IRQ_PRIO) == YDRV_OK)
+                           ? 1
+                           : 0;
+    }
+
+    bus->flagReady = 1;
+    return YDEV_OK;
+}
+
+/**
+ * @brief 反初始化SPI总线实现
+ * @param bus 总线结构体指针
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevSpiBusDeInit(yDevSpiBus_t *bus)
+{
+    if ((bus == NULL) || (bus->flagReady == 0))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (bus->flagDma != 0)
+    {
+        yDrvSpiDmaDeInit(&bus->spi);
+        bus->flagDma = 0;
+    }
+    if (bus->flagIrq != 0)
+    {
+        yDrvSpiItDeInit(&bus->spi);
+        bus->flagIrq = 0;
+    }
+
+    // 片选引脚属于器件，不随总线反初始化
+    bus->spi.csPinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
+    yDrvSpiDeInitStatic(&bus->spi);
+
+    bus->owner = NULL;
+    bus->flagReady = 0;
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 挂接器件到SPI总线实现
+ * @param bus 总线结构体指针
+ * @param device 器件结构体指针
+ * @param config 器件配置指针
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevSpiBusAttach(yDevSpiBus_t *bus,
+                              yDevSpiBusDevice_t *device,
+                              const yDevSpiBusDeviceConfig_t *config)
+{
+    yDrvGpioConfig_t gpio_config;
+    yDrvGpioHandle_t gpio_handle;
+
+    if ((bus == NULL) || (bus->flagReady == 0) || (device == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 片选引脚推挽输出，空闲为高
+    gpio_config = YDRV_GPIO_CONFIG_DEFAULT();
+    gpio_config.pin = config->csPin;
+    gpio_config.mode = YDRV_GPIO_MODE_OUTPUT_PP;
+    gpio_config.speed = YDRV_GPIO_SPEED_LEVEL3;
+    gpio_config.pupd = YDRV_GPIO_PUPD_PULLUP;
+    gpio_handle = YDRV_GPIO_HANDLE_DEFAULT();
+    if (yDrvGpioInitStatic(&gpio_config, &gpio_handle) != YDRV_OK)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    yDrvGpioSet(&gpio_handle);
+
+    device->bus = bus;
+    device->csPinInfo = gpio_handle.gpioInfo;
+    device->polarity = config->polarity;
+    device->phase = config->phase;
+    device->speed = config->speed;
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 从SPI总线分离器件实现
+ * @param device 器件结构体指针
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevSpiBusDetach(yDevSpiBusDevice_t *device)
+{
+    if ((device == NULL) || (device->bus == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (device->bus->owner == device)
+    {
+        device->bus->owner = NULL;
+    }
+    device->bus = NULL;
+    device->csPinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 获取SPI总线实现
+ * @param device 器件结构体指针
+ * @param timeOutMs 等待总线的超时时间
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevSpiBusLock(yDevSpiBusDevice_t *device, uint32_t timeOutMs)
+{
+    return yDevSpiBusLockJob(device, YDEV_BUSJOB_READ, 0, timeOutMs);
+}
+
+/**
+ * @brief 按作业类别获取SPI总线实现
+ * @param device 器件结构体指针
+ * @param cls 作业类别
+ * @param deadlineMs 相对截止时间
+ * @param timeOutMs 等待总线的超时时间
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevSpiBusLockJob(yDevSpiBusDevice_t *device,
+                               yDevBusJobClass_t cls,
+                               uint32_t deadlineMs,
+                               uint32_t timeOutMs)
+{
+    yDevStatus_t ret;
+
+    if ((device == NULL) || (device->bus == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    ret = yDevBusJobBegin(&device->bus->sched, cls, deadlineMs, timeOutMs);
+    if (ret != YDEV_OK)
+    {
+        return ret;
+    }
+
+    yDevSpiBus_Select(device);
+    return YDEV_OK;
+}
+
+/**
+ * @brief 长作业安全点实现
+ * @param device 器件结构体指针
+ * @param limit 只让给类别小于该值的作业
+ * @retval 1 已让出并重新获得总线，0 未让出
+ */
+uint8_t yDevSpiBusYield(yDevSpiBusDevice_t *device, yDevBusJobClass_t limit)
+{
+    if ((device == NULL) || (device->bus == NULL))
+    {
+        return 0;
+    }
+    if (yDevBusJobYield(&device->bus->sched, limit) == 0)
+    {
+        return 0;
+    }
+
+    // 其他器件期间可能改变了总线参数
+    yDevSpiBus_Select(device);
+    return 1;
+}
+
+/**
+ * @brief 释放SPI总线实现
+ * @param device 器件结构体指针
+ */
+void yDevSpiBusUnlock(yDevSpiBusDevice_t *device)
+{
+    if ((device == NULL) || (device->bus == NULL))
+    {
+        return;
+    }
+
+    yDevBusJobEnd(&device->bus->sched);
+}
+
+/**
+ * @brief 在已持有的总线上传输数据实现
+ * @param device 器件结构体指针
+ * @param tx 发送缓冲区
+ * @param rx 接收缓冲区
+ * @param len 传输字节数
+ * @retval int32_t 实际传输的字节数
+ */
+int32_t yDevSpiBusTransfer(yDevSpiBusDevice_t *device, const void *tx, void *rx, uint32_t len)
+{
+    yDevSpiBus_t *bus;
+    uint8_t flag_running;
+
+    if ((device == NULL) || (device->bus == NULL) || (len == 0))
+    {
+        return 0;
+    }
+    bus = device->bus;
+    flag_running = (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) ? 1 : 0;
+
+    if ((flag_running != 0) && (bus->flagDma != 0) &&
+        (len >= YDEV_SPIBUS_DMA_THRESHOLD) && (len <= YDEV_SPIBUS_DMA_MAX_SIZE))
+    {
+        return yDevSpiBus_AsyncTransfer(bus, tx, rx, len, 1);
+    }
+
+    if ((flag_running != 0) && (bus->flagIrq != 0) && (len >= YDEV_SPIBUS_IRQ_THRESHOLD))
+    {
+        return yDevSpiBus_AsyncTransfer(bus, tx, rx, len, 0);
+    }
+
+    return (int32_t)yDrvSpiTransferPolled(&bus->spi, tx, rx, len);
+}
+
+/**
+ * @brief 执行一次完整的SPI总线事务实现
+ * @param device 器件结构体指针
+ * @param xfer 事务分段数组
+ * @param count 分段数量
+ * @param timeOutMs 等待总线的超时时间
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevSpiBusTransaction(yDevSpiBusDevice_t *device,
+                                   const yDevSpiBusXfer_t *xfer,
+                                   uint32_t count,
+                                   uint32_t timeOutMs)
+{
+    yDevStatus_t ret;
+    uint32_t i;
+
+    if ((xfer == NULL) || (count == 0))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    ret = yDevSpiBusLock(device, timeOutMs);
+    if (ret != YDEV_OK)
+    {
+        return ret;
+    }
+
+    yDrvSpiCsControl(&device->bus->spi, YDRV_SPI_CS_SELECT);
+    for (i = 0; i < count; i++)
+    {
+        if (yDevSpiBusTransfer(device, xfer[i].tx, xfer[i].rx, xfer[i].len) != (int32_t)xfer[i].len)
+        {
+            ret = YDEV_TIMEOUT;
+            break;
+        }
+    }
+    yDrvSpiCsControl(&device->bus->spi, YDRV_SPI_CS_DESELECT);
+
+    yDevSpiBusUnlock(device);
+    return ret;
+}
+
+/**
+ * @brief 批量事务实现
+ * @param bus 总线结构体指针
+ * @param item 事务数组
+ * @param count 事务数量
+ * @param cls 作业类别
+ * @param deadlineMs 相对截止时间
+ * @param timeOutMs 等待总线的超时时间
+ * @retval yDevStatus_t 操作状态
+ */
+yDevStatus_t yDevSpiBusBatch(yDevSpiBus_t *bus,
+                             yDevSpiBusBatchItem_t *item,
+                             uint32_t count,
+                             yDevBusJobClass_t cls,
+                             uint32_t deadlineMs,
+                             uint32_t timeOutMs)
+{
+    yDevStatus_t ret;
+    uint32_t i;
+    uint32_t end;
+    uint32_t k;
+
+    if ((bus == NULL) || (bus->flagReady == 0) || (item == NULL) || (count == 0))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    ret = yDevBusJobBegin(&bus->sched, cls, deadlineMs, timeOutMs);
+    if (ret != YDEV_OK)
+    {
+        return ret;
+    }
+
+    i = 0;
+    while (i < count)
+    {
+        yDevSpiBus_Select(item[i].device);
+
+        if ((bus->flagDma == 0) || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+        {
+            // 逐项传输
+            item[i].status = YDEV_OK;
+            yDrvSpiCsControl(&bus->spi, YDRV_SPI_CS_SELECT);
+            for (k = 0; k < item[i].count; k++)
+            {
+                if (yDevSpiBusTransfer(item[i].device, item[i].seg[k].tx, item[i].seg[k].rx, item[i].seg[k].len) !=
+                    (int32_t)item[i].seg[k].len)
+                {
+                    item[i].status = YDEV_TIMEOUT;
+                    break;
+                }
+            }
+            yDrvSpiCsControl(&bus->spi, YDRV_SPI_CS_DESELECT);
+            item[i].timeUs = yDrvGetTimeUs();
+            i++;
+            continue;
+        }
+
+        // 参数相同的相邻项组成一串，由DMA中断接续
+        for (end = i + 1; (end < count) && yDevSpiBus_SameFormat(item[end].device, item[i].device); end++)
+        {
+        }
+        for (k = i; k < end; k++)
+        {
+            item[k].status = YDEV_TIMEOUT;
+        }
+
+        bus->batch = item;
+        bus->batchIndex = i;
+        bus->batchEnd = end;
+        bus->flagDone = 0;
+        bus->wait_task = (void *)xTaskGetCurrentTaskHandle();
+        (void)ulTaskNotifyTake(pdTRUE, 0);
+
+        yDrvSpiCsControl(&bus->spi, YDRV_SPI_CS_SELECT);
+        if (yDrvSpiTransferDmaSg(&bus->spi, item[i].seg, item[i].count, yDevSpiBus_BatchCallback, bus) != YDRV_OK)
+        {
+            yDrvSpiCsControl(&bus->spi, YDRV_SPI_CS_DESELECT);
+            item[i].status = YDEV_ERROR;
+            bus->wait_task = NULL;
+            i++;
+            continue;
+        }
+
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(bus->timeOutMs * (end - i)));
+        if (bus->flagDone == 0)
+        {
+            // 超时，当前项及之后的项保持YDEV_TIMEOUT
+            (void)yDrvSpiTransferDmaAbort(&bus->spi);
+            yDrvSpiCsControl(&bus->spi, YDRV_SPI_CS_DESELECT);
+        }
+        bus->wait_task = NULL;
+        bus->batch = NULL;
+        i = end;
+    }
+
+    yDevBusJobEnd(&bus->sched);
+    return YDEV_OK;
+}
+
+// ==================== SPI总线私有函数实现 ====================
+
+/**
+ * @brief 切换总线参数到指定器件实现
+ * @param device 器件结构体指针
+ */
+static void yDevSpiBus_Select(yDevSpiBusDevice_t *device)
+{
+    yDevSpiBus_t *bus = device->bus;
+
+    if ((bus->polarity != device->polarity) ||
+        (bus->phase != device->phase) ||
+        (bus->speed != device->speed))
+    {
+        if (yDrvSpiSetFormat(&bus->spi, device->polarity, device->phase, device->speed) == YDRV_OK)
+        {
+            bus->polarity = device->polarity;
+            bus->phase = device->phase;
+            bus->speed = device->speed;
+        }
+    }
+
+    bus->spi.csPinInfo = device->csPinInfo;
+    bus->spi.csCtrl = YDRV_SPI_CS_CTRL_SOFT;
+    bus->owner = device;
+}
+
+/**
+ * @brief 启动异步传输并等待完成实现
+ * @param bus 总线结构体指针
+ * @param tx 发送缓冲区
+ * @param rx 接收缓冲区
+ * @param len 传输字节数
+ * @param flagDma 非0使用DMA
+ * @retval int32_t 实际传输的字节数
+ */
+static int32_t yDevSpiBus_AsyncTransfer(yDevSpiBus_t *bus, const void *tx, void *rx, uint32_t len, uint8_t flagDma)
+{
+    yDrvStatus_t status;
+    uint32_t remain;
+
+    // 1. 记录等待任务并清除残留通知
+    bus->flagDone = 0;
+    bus->wait_task = (void *)xTaskGetCurrentTaskHandle();
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+
+    // 2. 启动传输
+    if (flagDma != 0)
+    {
+        status = yDrvSpiTransferDma(&bus->spi, tx, rx, len, yDevSpiBus_DoneCallback, bus);
+    }
+    else
+    {
+        status = yDrvSpiTransferIt(&bus->spi, tx, rx, len, yDevSpiBus_DoneCallback, bus);
+    }
+    if (status != YDRV_OK)
+    {
+        bus->wait_task = NULL;
+        return 0;
+    }
+
+    // 3. 等待完成，超时则中止传输
+    (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(bus->timeOutMs));
+
+    remain = 0;
+    if (bus->flagDone == 0)
+    {
+        remain = (flagDma != 0) ? yDrvSpiTransferDmaAbort(&bus->spi) : yDrvSpiTransferItAbort(&bus->spi);
+    }
+    else if (((flagDma != 0) ? bus->spi.dma.status : bus->spi.it.status) != YDRV_OK)
+    {
+        remain = len;
+    }
+    bus->wait_task = NULL;
+
+    return (int32_t)(len - remain);
+}
+
+/**
+ * @brief SPI总线中断/DMA传输完成回调实现
+ * @param arg 总线结构体指针
+ * @param status 传输结果
+ */
+static void yDevSpiBus_DoneCallback(void *arg, yDrvStatus_t status)
+{
+    yDevSpiBus_t *bus;
+    BaseType_t woken;
+
+    (void)status;
+    bus = (yDevSpiBus_t *)arg;
+    woken = pdFALSE;
+    bus->flagDone = 1;
+
+    if (bus->wait_task != NULL)
+    {
+        vTaskNotifyGiveFromISR((TaskHandle_t)bus->wait_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 批量事务DMA完成回调实现
+ * @param arg 总线结构体指针
+ * @param status 传输结果
+ */
+static void yDevSpiBus_BatchCallback(void *arg, yDrvStatus_t status)
+{
+    yDevSpiBus_t *bus;
+    yDevSpiBusBatchItem_t *item;
+    BaseType_t woken;
+
+    bus = (yDevSpiBus_t *)arg;
+    item = (yDevSpiBusBatchItem_t *)bus->batch + bus->batchIndex;
+
+    yDrvSpiCsControl(&bus->spi, YDRV_SPI_CS_DESELECT);
+    item->timeUs = yDrvGetTimeUs();
+    item->status = (status == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+
+    // 选中下一项并启动传输，启动失败的项跳过
+    while (++bus->batchIndex < bus->batchEnd)
+    {
+        item++;
+        bus->spi.csPinInfo = item->device->csPinInfo;
+        bus->owner = item->device;
+        yDrvSpiCsControl(&bus->spi, YDRV_SPI_CS_SELECT);
+        if (yDrvSpiTransferDmaSg(&bus->spi, item->seg, item->count, yDevSpiBus_BatchCallback, bus) == YDRV_OK)
+        {
+            return;
+        }
+        yDrvSpiCsControl(&bus->spi, YDRV_SPI_CS_DESELECT);
+        item->status = YDEV_ERROR;
+    }
+
+    woken = pdFALSE;
+    bus->flagDone = 1;
+    if (bus->wait_task != NULL)
+    {
+        vTaskNotifyGiveFromISR((TaskHandle_t)bus->wait_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 两个器件的时钟模式和速率是否相同实现
+ */
+static uint8_t yDevSpiBus_SameFormat(const yDevSpiBusDevice_t *a, const yDevSpiBusDevice_t *b)
+{
+    return ((a->polarity == b->polarity) && (a->phase == b->phase) && (a->speed == b->speed)) ? 1 : 0;
+}
@@ -0,0 +1,769 @@
+/**
+ * @file yDev_spislave.c
+ * @brief yDev SPI从机设备实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现基于yDev框架的SPI从机设备，接收和应答均由DMA完成
+ *
+ * @par 主要功能:
+ * - 接收DMA循环写入环形缓冲区，半满/全满时交付完成的一半
+ * - NSS上升沿结束当前帧，回调帧在环形缓冲区中的位置
+ * - 帧间复位SPI清空发送FIFO，重装下一帧的应答数据
+ * - 读接口按流方式取出环形缓冲区中的数据
+ *
+ * @par 更新历史:
+ * - v1.0 (2025): 初始版本
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_spislave.h"
+#include "yDev_def.h"
+
+#include <string.h>
+
+// ==================== 私有宏定义 ====================
+
+/**
+ * @brief 帧结束时等待接收FIFO被DMA取空的最大轮询次数
+ */
+#define YDEV_SPISLAVE_FIFO_SPIN (64U)
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 获取接收DMA当前写入位置
+ * @param handle SPI从机句柄指针
+ * @retval uint32_t 环形缓冲区中的写入偏移
+ */
+static uint32_t yDev_SpiSlave_RxPos(yDevHandle_SpiSlave_t *handle);
+
+/**
+ * @brief 重装发送DMA
+ * @param handle SPI从机句柄指针
+ * @retval 无
+ * @note 复位SPI清空发送FIFO中上一帧的预装数据，再从当前活动的一半开始发送
+ */
+static void yDev_SpiSlave_TxReload(yDevHandle_SpiSlave_t *handle);
+
+/**
+ * @brief NSS上升沿中断回调
+ * @param arg SPI从机句柄指针
+ * @retval 无
+ * @note 结束当前帧并为下一帧装载应答数据
+ */
+static void yDev_SpiSlave_NssIrq(void *arg);
+
+/**
+ * @brief 接收DMA半满中断回调
+ * @param arg SPI从机句柄指针
+ * @retval 无
+ */
+static void yDev_SpiSlave_RxHalfIrq(void *arg);
+
+/**
+ * @brief 接收DMA全满中断回调
+ * @param arg SPI从机句柄指针
+ * @retval 无
+ */
+static void yDev_SpiSlave_RxFullIrq(void *arg);
+
+/**
+ * @brief 接收DMA错误中断回调
+ * @param arg SPI从机句柄指针
+ * @retval 无
+ */
+static void yDev_SpiSlave_RxErrorIrq(void *arg);
+
+/**
+ * @brief SPI从机设备读取操作
+ * @param handle SPI从机句柄指针
+ * @param buffer 读取缓冲区
+ * @param size 缓冲区大小
+ * @retval int32_t 实际读取的字节数，-1表示错误
+ */
+static int32_t yDev_SpiSlave_Read(void *handle, void *buffer, size_t size);
+
+/**
+ * @brief 帧结束时推进异步读写
+ * @param handle SPI从机句柄指针
+ * @retval 无
+ * @note 在NSS中断中应答切换之前调用：发送中的异步应答已在本帧发出，
+ *       异步读取取走本帧及之前未读的数据
+ */
+static void yDev_SpiSlave_AsyncFrameEnd(yDevHandle_SpiSlave_t *handle);
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 获取接收DMA写入位置实现
+ */
+static uint32_t yDev_SpiSlave_RxPos(yDevHandle_SpiSlave_t *handle)
+{
+    uint32_t pos;
+
+    pos = handle->rxSize - yDrvDmaCurLenGet(&handle->rxDma);
+    if (pos >= handle->rxSize)
+    {
+        pos = 0;
+    }
+    return pos;
+}
+
+/**
+ * @brief 重装发送DMA实现
+ */
+static void yDev_SpiSlave_TxReload(yDevHandle_SpiSlave_t *handle)
+{
+    yDrvDmaTransDisable(&handle->txDma);
+    yDrvSpiFlush(&handle->spi);
+
+    if (handle->txBuffer != NULL)
+    {
+        yDrvDmaDstBufferSet(&handle->txDma,
+                            &handle->txBuffer[handle->txActive * handle->txHalf],
+                            YDRV_DMA_WIDTH_8BIT);
+        yDrvDmaDstBufferLen(&handle->txDma, handle->txHalf);
+    }
+    else
+    {
+        yDrvDmaDstBufferLen(&handle->txDma, 0xFFFF);
+    }
+
+    yDrvDmaClearFlags(&handle->txDma);
+    yDrvDmaTransEnable(&handle->txDma);
+}
+
+/**
+ * @brief NSS上升沿中断回调实现
+ */
+static void yDev_SpiSlave_NssIrq(void *arg)
+{
+    yDevHandle_SpiSlave_t *handle = (yDevHandle_SpiSlave_t *)arg;
+    yDevSpiSlaveFrame_t frame;
+    uint32_t spin;
+    uint32_t pos;
+    uint8_t idle;
+
+    // 1. 等待最后几帧从接收FIFO搬入内存
+    for (spin = 0; spin < YDEV_SPISLAVE_FIFO_SPIN; spin++)
+    {
+        if (yDrvSpiIsRxFifoEmpty(&handle->spi) == YDRV_OK)
+        {
+            break;
+        }
+    }
+
+    // 2. 计算本帧在环形缓冲区中的范围
+    pos = yDev_SpiSlave_RxPos(handle);
+    frame.buffer = handle->rxBuffer;
+    frame.size = handle->rxSize;
+    frame.start = handle->frameStart;
+    frame.len = (pos >= frame.start) ? (pos - frame.start) : (pos + handle->rxSize - frame.start);
+    handle->frameStart = pos;
+    handle->stats.frames++;
+    handle->stats.bytes += frame.len;
+    yDev_SpiSlave_AsyncFrameEnd(handle);
+    yDevPollSignal(handle, 0);
+
+    // 3. 选择下一帧的应答：有新应答则切换，否则清空已发送的一半，应答只发送一次
+    if (handle->txBuffer != NULL)
+    {
+        if (handle->txPending != 0)
+        {
+            handle->txActive ^= 1U;
+            handle->txPending = 0;
+            handle->stats.replies++;
+            if (handle->txAsync == 1U)
+            {
+                handle->txAsync = 2U; // 下一帧发出后完成
+            }
+        }
+        else
+        {
+            idle = handle->txActive;
+            if (handle->txLen[idle] != 0)
+            {
+                memset(&handle->txBuffer[idle * handle->txHalf], 0xFF, handle->txLen[idle]);
+                handle->txLen[idle] = 0;
+            }
+        }
+    }
+    yDev_SpiSlave_TxReload(handle);
+
+    if ((handle->frameCallback != NULL) && (frame.len != 0))
+    {
+        handle->frameCallback(handle->arg, &frame);
+    }
+}
+
+/**
+ * @brief 接收DMA半满中断回调实现
+ */
+static void yDev_SpiSlave_RxHalfIrq(void *arg)
+{
+    yDevHandle_SpiSlave_t *handle = (yDevHandle_SpiSlave_t *)arg;
+
+    if (handle->blockCallback != NULL)
+    {
+        handle->blockCallback(handle->arg, handle->rxBuffer, handle->rxSize / 2U);
+    }
+}
+
+/**
+ * @brief 接收DMA全满中断回调实现
+ */
+static void yDev_SpiSlave_RxFullIrq(void *arg)
+{
+    yDevHandle_SpiSlave_t *handle = (yDevHandle_SpiSlave_t *)arg;
+
+    if (handle->blockCallback != NULL)
+    {
+        handle->blockCallback(handle->arg, &handle->rxBuffer[handle->rxSize / 2U], handle->rxSize / 2U);
+    }
+}
+
+/**
+ * @brief 接收DMA错误中断回调实现
+ */
+static void yDev_SpiSlave_RxErrorIrq(void *arg)
+{
+    yDevHandle_SpiSlave_t *handle = (yDevHandle_SpiSlave_t *)arg;
+
+    handle->base.errno |= YDEV_SPISLAVE_ERRNO_DMA;
+}
+
+/**
+ * @brief 帧结束时推进异步读写实现
+ */
+static void yDev_SpiSlave_AsyncFrameEnd(yDevHandle_SpiSlave_t *handle)
+{
+    uint8_t *buffer;
+    int32_t len;
+
+    if (handle->txAsync == 2U)
+    {
+        handle->txAsync = 0;
+        yDevAsyncComplete(handle, YDEV_ASYNC_WRITE, YDEV_OK, handle->txLen[handle->txActive]);
+    }
+
+    buffer = handle->rxAsync;
+    if ((buffer != NULL) && (handle->readPos != handle->frameStart))
+    {
+        handle->rxAsync = NULL;
+        len = yDev_SpiSlave_Read(handle, buffer, handle->base.async[YDEV_ASYNC_READ].size);
+        yDevAsyncComplete(handle, YDEV_ASYNC_READ, YDEV_OK, (uint32_t)len);
+    }
+}
+
+// ==================== SPI从机设备操作函数实现 ====================
+
+/**
+ * @brief SPI从机设备初始化
+ * @param config SPI从机配置参数指针
+ * @param handle SPI从机句柄指针
+ * @retval yDevStatus_t 初始化状态
+ * @retval YDEV_OK 初始化成功
+ * @retval YDEV_INVALID_PARAM 参数无效
+ * @retval YDEV_ERROR 初始化失败
+ * @note 依次配置NSS中断引脚、SPI从机、接收循环DMA和发送DMA，最后复位SPI使FIFO为空
+ */
+static yDevStatus_t yDev_SpiSlave_Init(void *config, void *handle)
+{
+    yDevConfig_SpiSlave_t *slave_config;
+    yDevHandle_SpiSlave_t *slave_handle;
+    yDrvGpioConfig_t gpio_config;
+    yDrvSpiConfig_t spi_config;
+    yDrvDmaConfig_t dma_config;
+    yDrvDmaExtiConfig_t dma_exti;
+    yDrvGpioExtiConfig_t gpio_exti;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    slave_config = (yDevConfig_SpiSlave_t *)config;
+    slave_handle = (yDevHandle_SpiSlave_t *)handle;
+
+    if (((slave_config->spiId != YDRV_SPI_1) && (slave_config->spiId != YDRV_SPI_2)) ||
+        (slave_config->rxBuffer == NULL) ||
+        (slave_config->rxSize < 2U) || (slave_config->rxSize > 0xFFFFU) ||
+        ((slave_config->rxSize & 1U) != 0) ||
+        (slave_config->rxDmaChannel >= YDRV_DMA_CHANNEL_MAX) ||
+        (slave_config->txDmaChannel >= YDRV_DMA_CHANNEL_MAX) ||
+        (slave_config->rxDmaChannel == slave_config->txDmaChannel))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    if ((slave_config->txBuffer != NULL) &&
+        ((slave_config->txSize < 2U) || ((slave_config->txSize / 2U) > 0xFFFFU)))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    slave_handle->rxBuffer = slave_config->rxBuffer;
+    slave_handle->rxSize = slave_config->rxSize;
+    slave_handle->readPos = 0;
+    slave_handle->frameStart = 0;
+    slave_handle->txBuffer = slave_config->txBuffer;
+    slave_handle->txHalf = slave_config->txSize / 2U;
+    slave_handle->txLen[0] = 0;
+    slave_handle->txLen[1] = 0;
+    slave_handle->txActive = 0;
+    slave_handle->txPending = 0;
+    slave_handle->txDummy = 0xFF;
+    slave_handle->txAsync = 0;
+    slave_handle->rxAsync = NULL;
+    slave_handle->frameCallback = slave_config->frameCallback;
+    slave_handle->blockCallback = slave_config->blockCallback;
+    slave_handle->arg = slave_config->arg;
+    memset(&slave_handle->stats, 0, sizeof(slave_handle->stats));
+    if (slave_handle->txBuffer != NULL)
+    {
+        memset(slave_handle->txBuffer, 0xFF, slave_handle->txHalf * 2U);
+    }
+
+    // 1. NSS引脚先按输入初始化以取得EXTI中断号，随后由SPI切换为复用功能
+    gpio_config = YDRV_GPIO_CONFIG_DEFAULT();
+    gpio_config.pin = slave_config->nssPin;
+    gpio_config.pupd = YDRV_GPIO_PUPD_PULLUP;
+    if (yDrvGpioInitStatic(&gpio_config, &slave_handle->nss) != YDRV_OK)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 2. SPI从机，硬件NSS输入
+    yDrvSpiConfigStructInit(&spi_config);
+    spi_config.spiId = slave_config->spiId;
+    spi_config.mode = YDRV_SPI_MODE_SLAVE;
+    spi_config.direction = YDRV_SPI_DIR_2LINES_FULL_DUPLEX;
+    spi_config.dataBits = 8;
+    spi_config.crc = 0;
+    spi_config.polarity = slave_config->polarity;
+    spi_config.phase = slave_config->phase;
+    spi_config.csMode = YDRV_SPI_CS_HARD_INPUT;
+    spi_config.sckPin = slave_config->sckPin;
+    spi_config.misoPin = slave_config->misoPin;
+    spi_config.mosiPin = slave_config->mosiPin;
+    spi_config.csPin = slave_config->nssPin;
+    spi_config.sckAF = slave_config->sckAF;
+    spi_config.misoAF = slave_config->misoAF;
+    spi_config.mosiAF = slave_config->mosiAF;
+    spi_config.csAF = slave_config->nssAF;
+    if (yDrvSpiInitStatic(&spi_config, &slave_handle->spi) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    // 3. 接收DMA循环写入环形缓冲区
+    dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    dma_config.channel = slave_config->rxDmaChannel;
+    dma_config.request = (slave_config->spiId == YDRV_SPI_1) ? YDRV_DMA_REQ_SPI1_RX : YDRV_DMA_REQ_SPI2_RX;
+    dma_config.priority = YDRV_DMA_PRIORITY_VERY_HIGH;
+    dma_config.mode = YDRV_DMA_MODE_CIRCULAR;
+    dma_config.dst_buffer = slave_handle->rxBuffer;
+    dma_config.trans_len = slave_handle->rxSize;
+    if (yDrvDmaInitStatic(&dma_config, &slave_handle->rxDma, YDRV_DMA_DIR_P2M) != YDRV_OK)
+    {
+        yDrvSpiDeInitStatic(&slave_handle->spi);
+        return YDEV_ERROR;
+    }
+
+    // 4. 发送DMA，无应答缓冲区时固定发送填充字节
+    dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    dma_config.channel = slave_config->txDmaChannel;
+    dma_config.request = (slave_config->spiId == YDRV_SPI_1) ? YDRV_DMA_REQ_SPI1_TX : YDRV_DMA_REQ_SPI2_TX;
+    dma_config.priority = YDRV_DMA_PRIORITY_HIGH;
+    if (slave_handle->txBuffer != NULL)
+    {
+        dma_config.src_buffer = slave_handle->txBuffer;
+        dma_config.trans_len = slave_handle->txHalf;
+    }
+    else
+    {
+        dma_config.src_buffer = &slave_handle->txDummy;
+        dma_config.src_inc = YDRV_DMA_INC_DISABLE;
+        dma_config.trans_len = 0xFFFF;
+    }
+    if (yDrvDmaInitStatic(&dma_config, &slave_handle->txDma, YDRV_DMA_DIR_M2P) != YDRV_OK)
+    {
+        yDrvDmaDeInitStatic(&slave_handle->rxDma);
+        yDrvSpiDeInitStatic(&slave_handle->spi);
+        return YDEV_ERROR;
+    }
+
+    // 5. 接收DMA中断交付双缓冲的一半
+    dma_exti = YDRV_DMA_EXTI_CONFIG_DEFAULT();
+    dma_exti.prio = slave_config->prio;
+    dma_exti.arg = slave_handle;
+    dma_exti.enable = 1;
+    dma_exti.trigger = YDRV_DMA_EXTI_HT;
+    dma_exti.function = yDev_SpiSlave_RxHalfIrq;
+    yDrvDmaRegisterCallback(&slave_handle->rxDma, &dma_exti);
+    dma_exti.trigger = YDRV_DMA_EXTI_TC;
+    dma_exti.function = yDev_SpiSlave_RxFullIrq;
+    yDrvDmaRegisterCallback(&slave_handle->rxDma, &dma_exti);
+    dma_exti.trigger = YDRV_DMA_EXTI_TE;
+    dma_exti.function = yDev_SpiSlave_RxErrorIrq;
+    yDrvDmaRegisterCallback(&slave_handle->rxDma, &dma_exti);
+
+    // 6. 连接DMA请求，启动接收，复位SPI后装载首帧应答
+    yDrvSpiDmaRead(&slave_handle->spi, &slave_config->rxDmaChannel);
+    yDrvSpiDmaWrite(&slave_handle->spi, &slave_config->txDmaChannel);
+    yDrvDmaClearFlags(&slave_handle->rxDma);
+    yDrvDmaTransEnable(&slave_handle->rxDma);
+    yDev_SpiSlave_TxReload(slave_handle);
+
+    // 7. NSS上升沿结束一帧
+    gpio_exti = YDRV_GPIO_EXTI_CONFIG_DEFAULT();
+    gpio_exti.trigger = YDRV_GPIO_EXTI_TRIGGER_RISING;
+    gpio_exti.prio = slave_config->prio;
+    gpio_exti.function = yDev_SpiSlave_NssIrq;
+    gpio_exti.arg = slave_handle;
+    gpio_exti.enable = 1;
+    if (yDrvGpioRegisterCallback(&slave_handle->nss, &gpio_exti) != YDRV_OK)
+    {
+        yDrvSpiDmaStop(&slave_handle->spi);
+        yDrvDmaDeInitStatic(&slave_handle->txDma);
+        yDrvDmaDeInitStatic(&slave_handle->rxDma);
+        yDrvSpiDeInitStatic(&slave_handle->spi);
+        return YDEV_ERROR;
+    }
+
+    slave_handle->flagReady = 1;
+    return YDEV_OK;
+}
+
+/**
+ * @brief SPI从机设备反初始化
+ * @param handle SPI从机句柄指针
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_SpiSlave_Deinit(void *handle)
+{
+    yDevHandle_SpiSlave_t *slave_handle;
+    yDrvGpioExtiConfig_t gpio_exti;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    slave_handle = (yDevHandle_SpiSlave_t *)handle;
+    if (slave_handle->flagReady == 0)
+    {
+        return YDEV_OK;
+    }
+
+    gpio_exti = YDRV_GPIO_EXTI_CONFIG_DEFAULT();
+    gpio_exti.trigger = YDRV_GPIO_EXTI_TRIGGER_RISING;
+    gpio_exti.function = yDev_SpiSlave_NssIrq;
+    gpio_exti.arg = slave_handle;
+    yDrvGpioUnregisterHandler(&slave_handle->nss, &gpio_exti);
+    yDrvSpiDmaStop(&slave_handle->spi);
+    yDrvDmaUnregisterCallback(&slave_handle->rxDma, YDRV_DMA_EXTI_MAX);
+    yDrvDmaDeInitStatic(&slave_handle->txDma);
+    yDrvDmaDeInitStatic(&slave_handle->rxDma);
+    slave_handle->flagReady = 0;
+
+    // 不会再有帧结束，未完成的异步读写按失败结束
+    slave_handle->txAsync = 0;
+    slave_handle->rxAsync = NULL;
+    yDevAsyncComplete(slave_handle, YDEV_ASYNC_READ, YDEV_ERROR, 0);
+    yDevAsyncComplete(slave_handle, YDEV_ASYNC_WRITE, YDEV_ERROR, 0);
+
+    if (yDrvSpiDeInitStatic(&slave_handle->spi) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief SPI从机设备读取操作
+ * @param handle SPI从机句柄指针
+ * @param buffer 读取缓冲区
+ * @param size 缓冲区大小
+ * @retval int32_t 实际读取的字节数，-1表示错误
+ * @note 按流方式取出接收DMA已写入的数据，不区分帧边界；
+ *       读取不及时时DMA会覆盖未读数据
+ */
+static int32_t yDev_SpiSlave_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_SpiSlave_t *slave_handle;
+    uint8_t *dst;
+    uint32_t pos;
+    uint32_t count;
+    uint32_t copied;
+
+    if ((handle == NULL) || (buffer == NULL))
+    {
+        return -1;
+    }
+
+    slave_handle = (yDevHandle_SpiSlave_t *)handle;
+    if (slave_handle->flagReady == 0)
+    {
+        return -1;
+    }
+
+    dst = (uint8_t *)buffer;
+    pos = yDev_SpiSlave_RxPos(slave_handle);
+    copied = 0;
+    while ((copied < size) && (slave_handle->readPos != pos))
+    {
+        // 写入位置在读取位置之前时先读到缓冲区末尾
+        count = (pos > slave_handle->readPos) ? (pos - slave_handle->readPos)
+                                              : (slave_handle->rxSize - slave_handle->readPos);
+        if (count > (size - copied))
+        {
+            count = size - copied;
+        }
+        memcpy(&dst[copied], &slave_handle->rxBuffer[slave_handle->readPos], count);
+        copied += count;
+        slave_handle->readPos += count;
+        if (slave_handle->readPos >= slave_handle->rxSize)
+        {
+            slave_handle->readPos = 0;
+        }
+    }
+
+    return (int32_t)copied;
+}
+
+/**
+ * @brief SPI从机设备写入操作
+ * @param handle SPI从机句柄指针
+ * @param buffer 应答数据
+ * @param size 应答长度
+ * @retval int32_t 实际写入的字节数，-1表示错误
+ * @note 应答写入非活动的一半，在下一次NSS上升沿后生效；
+ *       新应答到来前再次写入会覆盖尚未生效的应答
+ */
+static int32_t yDev_SpiSlave_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_SpiSlave_t *slave_handle;
+    uint8_t *half;
+    uint8_t idle;
+
+    if ((handle == NULL) || (buffer == NULL))
+    {
+        return -1;
+    }
+
+    slave_handle = (yDevHandle_SpiSlave_t *)handle;
+    if ((slave_handle->flagReady == 0) || (slave_handle->txBuffer == NULL))
+    {
+        return -1;
+    }
+    if (size > slave_handle->txHalf)
+    {
+        slave_handle->base.errno |= YDEV_SPISLAVE_ERRNO_REPLY;
+        return -1;
+    }
+
+    // 先撤销待生效标志，中断不会在拷贝期间切换到这一半
+    slave_handle->txPending = 0;
+    idle = (uint8_t)(slave_handle->txActive ^ 1U);
+    half = &slave_handle->txBuffer[idle * slave_handle->txHalf];
+    memcpy(half, buffer, size);
+    if (slave_handle->txLen[idle] > size)
+    {
+        memset(&half[size], 0xFF, slave_handle->txLen[idle] - size);
+    }
+    slave_handle->txLen[idle] = size;
+    slave_handle->txPending = 1;
+
+    return (int32_t)size;
+}
+
+/**
+ * @brief SPI从机设备向量写入操作
+ * @param handle SPI从机句柄指针
+ * @param iov 应答分段描述符数组
+ * @param count 分段数量
+ * @retval int32_t 实际写入的总字节数，-1表示错误
+ * @note 各分段依次拼接到非活动的一半，整组作为一帧应答生效；
+ *       逐段写入会让后一段覆盖前一段，帧头、载荷、校验分处不同缓冲区时须用本接口
+ */
+static int32_t yDev_SpiSlave_Writev(void *handle, const yDevIoVec_t *iov, uint32_t count)
+{
+    yDevHandle_SpiSlave_t *slave_handle = (yDevHandle_SpiSlave_t *)handle;
+    uint8_t *half;
+    uint32_t total;
+    uint32_t i;
+    uint8_t idle;
+
+    if ((slave_handle->flagReady == 0) || (slave_handle->txBuffer == NULL))
+    {
+        return -1;
+    }
+
+    total = 0;
+    for (i = 0; i < count; i++)
+    {
+        total += (uint32_t)iov[i].len;
+    }
+    if (total > slave_handle->txHalf)
+    {
+        slave_handle->base.errno |= YDEV_SPISLAVE_ERRNO_REPLY;
+        return -1;
+    }
+
+    // 与单次写入相同：撤销待生效标志后拼接到空闲的一半
+    slave_handle->txPending = 0;
+    idle = (uint8_t)(slave_handle->txActive ^ 1U);
+    half = &slave_handle->txBuffer[idle * slave_handle->txHalf];
+    total = 0;
+    for (i = 0; i < count; i++)
+    {
+        memcpy(&half[total], iov[i].base, iov[i].len);
+        total += (uint32_t)iov[i].len;
+    }
+    if (slave_handle->txLen[idle] > total)
+    {
+        memset(&half[total], 0xFF, slave_handle->txLen[idle] - total);
+    }
+    slave_handle->txLen[idle] = total;
+    slave_handle->txPending = 1;
+
+    return (int32_t)total;
+}
+
+/**
+ * @brief SPI从机设备异步读取操作
+ * @param handle SPI从机句柄指针
+ * @param buffer 读取缓冲区
+ * @param size 缓冲区大小
+ * @retval yDevStatus_t 启动状态
+ * @note 已有未读数据时立即完成，否则在下一次NSS上升沿取走该帧数据；
+ *       完成长度为实际取出的字节数，不超过size
+ */
+static yDevStatus_t yDev_SpiSlave_ReadAsync(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_SpiSlave_t *slave_handle = (yDevHandle_SpiSlave_t *)handle;
+    uint32_t primask;
+    uint8_t flag_ready;
+    int32_t len;
+
+    if (slave_handle->flagReady == 0)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    // 与NSS中断互斥：已结束的帧在这里取走，否则登记给下一次帧结束
+    primask = __get_PRIMASK();
+    __disable_irq();
+    flag_ready = (slave_handle->readPos != slave_handle->frameStart) ? 1 : 0;
+    if (flag_ready == 0)
+    {
+        slave_handle->rxAsync = (uint8_t *)buffer;
+    }
+    __set_PRIMASK(primask);
+
+    if (flag_ready != 0)
+    {
+        len = yDev_SpiSlave_Read(slave_handle, buffer, size);
+        yDevAsyncComplete(slave_handle, YDEV_ASYNC_READ, YDEV_OK, (uint32_t)len);
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief SPI从机设备异步写入操作
+ * @param handle SPI从机句柄指针
+ * @param buffer 应答数据
+ * @param size 应答长度
+ * @retval yDevStatus_t 启动状态
+ * @note 应答在下一次NSS上升沿后生效，随后一帧结束时通知完成；
+ *       完成前再次写入同步应答会覆盖这次应答
+ */
+static yDevStatus_t yDev_SpiSlave_WriteAsync(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_SpiSlave_t *slave_handle = (yDevHandle_SpiSlave_t *)handle;
+
+    if (yDev_SpiSlave_Write(slave_handle, buffer, size) < 0)
+    {
+        return ((slave_handle->flagReady == 0) || (slave_handle->txBuffer == NULL)) ? YDEV_NOT_SUPPORTED
+                                                                                    : YDEV_INVALID_PARAM;
+    }
+    slave_handle->txAsync = 1U;
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief SPI从机设备控制操作
+ * @param handle SPI从机句柄指针
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_SpiSlave_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_SpiSlave_t *slave_handle;
+    uint32_t pos;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    slave_handle = (yDevHandle_SpiSlave_t *)handle;
+    if (slave_handle->flagReady == 0)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_SPISLAVE_IOCTL_GET_STATS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(yDevSpiSlaveStats_t *)arg = slave_handle->stats;
+        return YDEV_OK;
+    case YDEV_IOCTL_POLL:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        // 有已结束未读取的帧时可读；应答槽空闲(没有待生效的应答)时可写
+        *(uint32_t *)arg = ((slave_handle->readPos != slave_handle->frameStart) ? YDEV_POLLIN : 0) |
+                           (((slave_handle->txBuffer != NULL) && (slave_handle->txPending == 0)) ? YDEV_POLLOUT : 0);
+        return YDEV_OK;
+    case YDEV_SPISLAVE_IOCTL_AVAILABLE:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        pos = yDev_SpiSlave_RxPos(slave_handle);
+        *(uint32_t *)arg = (pos >= slave_handle->readPos) ? (pos - slave_handle->readPos)
+                                                          : (pos + slave_handle->rxSize - slave_handle->readPos);
+        return YDEV_OK;
+    case YDEV_SPISLAVE_IOCTL_FLUSH:
+        slave_handle->readPos = yDev_SpiSlave_RxPos(slave_handle);
+        return YDEV_OK;
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+}
+
+YDEV_OPS_EXPORT_VEC(
+    YDEV_TYPE_SPI_SLAVE,      // 设备类型
+    yDev_SpiSlave_Init,       // 初始化函数
+    yDev_SpiSlave_Deinit,     // 反初始化函数
+    yDev_SpiSlave_Read,       // 读取函数
+    yDev_SpiSlave_Write,      // 写入函数
+    yDev_SpiSlave_Ioctl,      // 控制函数
+    yDev_SpiSlave_ReadAsync,  // 异步读取函数
+    yDev_SpiSlave_WriteAsync, // 异步写入函数
+    NULL,                     // 向量读取函数
+    yDev_SpiSlave_Writev)     // 向量写入函数
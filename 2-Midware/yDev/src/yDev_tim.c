@@ -0,0 +1,482 @@
+/**
+ * @file yDev_tim.c
+ * @brief yDev定时器设备驱动实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现基于yDev框架的定时器设备，把底层PWM、捕获和单脉冲功能映射到统一的读写和控制接口
+ *
+ * @par 实现说明:
+ * - 异步读写临时把DMA切换为正常模式并挂上完成回调，结束后在中断中释放DMA通道并恢复用户配置
+ * - 循环突发输出和循环捕获沿用用户DMA配置，无回调时不开DMA中断
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_tim.h"
+#include "yDev_def.h"
+#include <string.h>
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 异步传输DMA回调
+ * @param arg 定时器设备句柄
+ * @param event DMA中断类型
+ * @note 在DMA中断中执行，传输完成或出错时释放DMA并通知yDev核心
+ */
+static void yDev_Tim_AsyncDmaEvent(void *arg, yDrvDmaExti_t event)
+{
+    yDevHandle_Tim_t *tim_handle = (yDevHandle_Tim_t *)arg;
+    yDevAsyncDir_t dir;
+    uint32_t len;
+
+    if (event == YDRV_DMA_EXTI_HT)
+    {
+        return;
+    }
+
+    dir = (yDevAsyncDir_t)tim_handle->async_dir;
+    len = (tim_handle->drv_handle.dmaLen - yDrvDmaCurLenGet(&tim_handle->drv_handle.dma)) * sizeof(uint16_t);
+
+    (void)yDrvTimDmaStop(&tim_handle->drv_handle);
+    tim_handle->drv_handle.dmaConfig = tim_handle->dma;
+
+    yDevAsyncComplete(tim_handle, dir,
+                      (event == YDRV_DMA_EXTI_TC) ? YDEV_OK : YDEV_ERROR,
+                      len);
+}
+
+/**
+ * @brief 为一次异步传输切换DMA配置
+ * @param tim_handle 定时器设备句柄
+ * @param dir 传输方向
+ */
+static void yDev_Tim_AsyncPrepare(yDevHandle_Tim_t *tim_handle, yDevAsyncDir_t dir)
+{
+    tim_handle->async_dir = (uint8_t)dir;
+    tim_handle->drv_handle.dmaConfig.circular = 0;
+    tim_handle->drv_handle.dmaConfig.callback = yDev_Tim_AsyncDmaEvent;
+    tim_handle->drv_handle.dmaConfig.arg = tim_handle;
+}
+
+// ==================== 定时器设备操作函数 ====================
+
+/**
+ * @brief 定时器设备初始化
+ * @param config 定时器设备配置参数
+ * @param handle 定时器设备句柄
+ * @return yDevStatus_t 初始化状态
+ *
+ * @par 功能描述:
+ * 配置时基和通道，计数器不启动，由YDEV_TIM_START或单脉冲触发开始工作
+ */
+static yDevStatus_t yDev_Tim_Init(void *config, void *handle)
+{
+    yDevConfig_Tim_t *tim_config;
+    yDevHandle_Tim_t *tim_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (config == NULL))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    tim_handle = (yDevHandle_Tim_t *)handle;
+    tim_config = (yDevConfig_Tim_t *)config;
+
+    if (yDrvTimInitStatic(&tim_config->drv_config, &tim_handle->drv_handle) != YDRV_OK)
+    {
+        tim_handle->base.errno = YDEV_ERRNO_NOT_INIT;
+        return YDEV_ERROR;
+    }
+
+    tim_handle->dma = tim_config->drv_config.dma;
+    tim_handle->capture_buf = NULL;
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 定时器设备反初始化
+ * @param handle 定时器设备句柄
+ * @return yDevStatus_t 操作状态
+ * @note 进行中的异步传输以错误结束
+ */
+static yDevStatus_t yDev_Tim_Deinit(void *handle)
+{
+    yDevHandle_Tim_t *tim_handle;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    tim_handle = (yDevHandle_Tim_t *)handle;
+
+    if (yDrvTimDeInitStatic(&tim_handle->drv_handle) != YDRV_OK)
+    {
+        tim_handle->base.errno = YDEV_ERRNO_NOT_DEINIT;
+        return YDEV_ERROR;
+    }
+
+    tim_handle->capture_buf = NULL;
+    yDevAsyncComplete(tim_handle, YDEV_ASYNC_READ, YDEV_ERROR, 0);
+    yDevAsyncComplete(tim_handle, YDEV_ASYNC_WRITE, YDEV_ERROR, 0);
+
+    return YDEV_OK;
+}
+
+void yDevTimConfigStructInit(yDevConfig_Tim_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础配置
+    yDevConfigStructInit(&config->base);
+    config->base.type = YDEV_TYPE_TIM;
+
+    // 初始化驱动配置
+    yDrvTimConfigStructInit(&config->drv_config);
+}
+
+void yDevTimHandleStructInit(yDevHandle_Tim_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    // 初始化基础句柄
+    yDevHandleStructInit(&handle->base);
+
+    // 初始化驱动句柄
+    yDrvTimHandleStructInit(&handle->drv_handle);
+    handle->capture_buf = NULL;
+    handle->async_dir = YDEV_ASYNC_READ;
+}
+
+/**
+ * @brief 定时器设备读取操作
+ * @param handle 定时器设备句柄
+ * @param buffer 读取缓冲区(uint32_t)
+ * @param size 缓冲区大小，必须为sizeof(uint32_t)
+ * @return int32_t 实际读取的字节数，-1表示错误
+ *
+ * @par 功能描述:
+ * 读取通道寄存器，捕获模式下为最近一次捕获值，输出模式下为当前比较值
+ */
+static int32_t yDev_Tim_Read(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Tim_t *tim_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size != sizeof(uint32_t)))
+    {
+        return -1;
+    }
+
+    tim_handle = (yDevHandle_Tim_t *)handle;
+    if (tim_handle->drv_handle.instance == NULL)
+    {
+        return -1; // 未初始化
+    }
+
+    *(uint32_t *)buffer = yDevTimGetCaptureFast(tim_handle);
+
+    return sizeof(uint32_t);
+}
+
+/**
+ * @brief 定时器设备写入操作
+ * @param handle 定时器设备句柄
+ * @param buffer 写入缓冲区(uint32_t比较值)
+ * @param size 缓冲区大小，必须为sizeof(uint32_t)
+ * @return int32_t 实际写入的字节数，-1表示错误
+ *
+ * @par 功能描述:
+ * 设置比较值，PWM模式下即有效电平计数值，在下一个周期生效
+ */
+static int32_t yDev_Tim_Write(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_Tim_t *tim_handle;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (buffer == NULL) || (size != sizeof(uint32_t)))
+    {
+        return -1;
+    }
+
+    tim_handle = (yDevHandle_Tim_t *)handle;
+    if (tim_handle->drv_handle.instance == NULL)
+    {
+        return -1; // 未初始化
+    }
+
+    yDevTimSetCompareFast(tim_handle, *(const uint32_t *)buffer);
+
+    return sizeof(uint32_t);
+}
+
+/**
+ * @brief 定时器设备异步读取
+ * @param handle 定时器设备句柄
+ * @param buffer 捕获值缓冲区(uint16_t数组)
+ * @param size 字节数，须为偶数
+ * @return yDevStatus_t 启动状态
+ *
+ * @par 功能描述:
+ * 捕获模式下由DMA把接下来size/2次捕获值写入缓冲区，写满后通知完成；
+ * 计数器须已启动，与循环捕获互斥
+ */
+static yDevStatus_t yDev_Tim_ReadAsync(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Tim_t *tim_handle = (yDevHandle_Tim_t *)handle;
+    yDrvStatus_t status;
+
+    if ((size == 0U) || ((size & 1U) != 0U) || (((uint32_t)buffer & 1U) != 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (tim_handle->drv_handle.instance == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    yDev_Tim_AsyncPrepare(tim_handle, YDEV_ASYNC_READ);
+    status = yDrvTimCaptureStart(&tim_handle->drv_handle, (uint16_t *)buffer, size / sizeof(uint16_t));
+    if (status != YDRV_OK)
+    {
+        tim_handle->drv_handle.dmaConfig = tim_handle->dma;
+        return (status == YDRV_BUSY) ? YDEV_BUSY : YDEV_NOT_SUPPORTED;
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 定时器设备异步写入
+ * @param handle 定时器设备句柄
+ * @param buffer 比较值表(uint16_t数组)
+ * @param size 字节数，须为偶数
+ * @return yDevStatus_t 启动状态
+ *
+ * @par 功能描述:
+ * PWM模式下每个周期从表中取一个比较值写入CCRx，整表播放完成后通知；
+ * 计数器须已启动，与循环突发输出互斥
+ */
+static yDevStatus_t yDev_Tim_WriteAsync(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_Tim_t *tim_handle = (yDevHandle_Tim_t *)handle;
+    yDrvStatus_t status;
+
+    if ((size == 0U) || ((size & 1U) != 0U) || (((uint32_t)buffer & 1U) != 0U))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    if (tim_handle->drv_handle.instance == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    yDev_Tim_AsyncPrepare(tim_handle, YDEV_ASYNC_WRITE);
+    status = yDrvTimBurstStart(&tim_handle->drv_handle,
+                               (yDrvTimBurstBase_t)(LL_TIM_DMABURST_BASEADDR_CCR1 +
+                                                    (tim_handle->drv_handle.channel << TIM_DCR_DBA_Pos)),
+                               1U,
+                               (const uint16_t *)buffer,
+                               size / sizeof(uint16_t));
+    if (status != YDRV_OK)
+    {
+        tim_handle->drv_handle.dmaConfig = tim_handle->dma;
+        return (status == YDRV_BUSY) ? YDEV_BUSY : YDEV_NOT_SUPPORTED;
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 定时器设备控制操作
+ * @param handle 定时器设备句柄
+ * @param cmd 控制命令
+ * @param arg 命令参数
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 支持的命令:
+ * - YDEV_TIM_START/YDEV_TIM_STOP: 启动/停止
+ * - YDEV_TIM_SET_PERIOD/YDEV_TIM_SET_COMPARE: 设置周期/比较值
+ * - YDEV_TIM_SET_PULSE/YDEV_TIM_TRIGGER: 单脉冲参数和触发
+ * - YDEV_TIM_BURST_START/YDEV_TIM_CAPTURE_START/YDEV_TIM_DMA_STOP: DMA突发输出和捕获
+ * - YDEV_TIM_GET_INTERVAL/YDEV_TIM_GET_FREQ/YDEV_TIM_GET_TICK_HZ: 捕获结果和计数时钟
+ * - YDEV_IOCTL_GET_STATUS: 获取设备状态
+ * - YDEV_IOCTL_RESET: 停止DMA和计数器
+ */
+static yDevStatus_t yDev_Tim_Ioctl(void *handle, uint32_t cmd, void *arg)
+{
+    yDevHandle_Tim_t *tim_handle;
+    yDrvTimHandle_t *drv;
+    yDrvStatus_t status;
+    uint32_t ticks;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    tim_handle = (yDevHandle_Tim_t *)handle;
+    drv = &tim_handle->drv_handle;
+    if (drv->instance == NULL)
+    {
+        return YDEV_NOT_INITIALIZED;
+    }
+
+    switch (cmd)
+    {
+    case YDEV_TIM_START:
+        status = yDrvTimStart(drv);
+        break;
+
+    case YDEV_TIM_STOP:
+        status = yDrvTimStop(drv);
+        break;
+
+    case YDEV_TIM_SET_PERIOD:
+        if ((arg == NULL) || (*(uint32_t *)arg == 0U) || (*(uint32_t *)arg > 0x10000U))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDrvTimSetPeriod(drv, *(uint32_t *)arg);
+        return YDEV_OK;
+
+    case YDEV_TIM_SET_COMPARE:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDrvTimSetCompare(drv, *(uint32_t *)arg);
+        return YDEV_OK;
+
+    case YDEV_TIM_SET_PULSE:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        status = yDrvTimSetPulse(drv, ((yDevTimPulse_t *)arg)->delay, ((yDevTimPulse_t *)arg)->width);
+        break;
+
+    case YDEV_TIM_TRIGGER:
+        status = yDrvTimTrigger(drv);
+        break;
+
+    case YDEV_TIM_BURST_START:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        status = yDrvTimBurstStart(drv,
+                                   ((yDevTimBurst_t *)arg)->base,
+                                   ((yDevTimBurst_t *)arg)->count,
+                                   ((yDevTimBurst_t *)arg)->table,
+                                   ((yDevTimBurst_t *)arg)->len);
+        break;
+
+    case YDEV_TIM_CAPTURE_START:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        status = yDrvTimCaptureStart(drv, ((yDevTimCapture_t *)arg)->buffer, ((yDevTimCapture_t *)arg)->len);
+        if (status == YDRV_OK)
+        {
+            tim_handle->capture_buf = ((yDevTimCapture_t *)arg)->buffer;
+        }
+        break;
+
+    case YDEV_TIM_DMA_STOP:
+        tim_handle->capture_buf = NULL;
+        status = yDrvTimDmaStop(drv);
+        break;
+
+    case YDEV_TIM_GET_INTERVAL:
+    case YDEV_TIM_GET_FREQ:
+        if ((arg == NULL) || (tim_handle->capture_buf == NULL))
+        {
+            return (arg == NULL) ? YDEV_INVALID_PARAM : YDEV_NOT_INITIALIZED;
+        }
+        status = yDrvTimCaptureInterval(drv, tim_handle->capture_buf, &ticks);
+        if (status != YDRV_OK)
+        {
+            break;
+        }
+        if (cmd == YDEV_TIM_GET_INTERVAL)
+        {
+            *(uint32_t *)arg = ticks;
+        }
+        else
+        {
+            // 0.001Hz分辨率，乘积超过32位
+            *(uint32_t *)arg = (ticks == 0U) ? 0U : (uint32_t)(((uint64_t)drv->tickHz * 1000U) / ticks);
+        }
+        break;
+
+    case YDEV_TIM_GET_TICK_HZ:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = drv->tickHz;
+        return YDEV_OK;
+
+    case YDEV_IOCTL_GET_STATUS:
+        if (arg != NULL)
+        {
+            *(yDevStatus_t *)arg = YDEV_OK;
+            return YDEV_OK;
+        }
+        return YDEV_INVALID_PARAM;
+
+    case YDEV_IOCTL_RESET:
+        tim_handle->capture_buf = NULL;
+        (void)yDrvTimDmaStop(drv);
+        status = yDrvTimStop(drv);
+        break;
+
+    default:
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    switch (status)
+    {
+    case YDRV_OK:
+        return YDEV_OK;
+    case YDRV_BUSY:
+        return YDEV_BUSY;
+    case YDRV_INVALID_PARAM:
+        return YDEV_INVALID_PARAM;
+    case YDRV_NOT_SUPPORTED:
+        return YDEV_NOT_SUPPORTED;
+    case YDRV_NOT_INITIALIZED:
+        return YDEV_NOT_INITIALIZED;
+    default:
+        return YDEV_ERROR;
+    }
+}
+
+// ==================== 设备操作表导出 ====================
+
+YDEV_OPS_EXPORT_ASYNC(
+    YDEV_TYPE_TIM,       // 设备类型
+    yDev_Tim_Init,       // 初始化函数
+    yDev_Tim_Deinit,     // 反初始化函数
+    yDev_Tim_Read,       // 读取函数
+    yDev_Tim_Write,      // 写入函数
+    yDev_Tim_Ioctl,      // 控制函数
+    yDev_Tim_ReadAsync,  // 异步读取函数
+    yDev_Tim_WriteAsync) // 异步写入函数
@@ -27,14 +27,828 @@
 #include "yDev_def.h"
 #include "yDrv_usart.h"
 
+#include "FreeRTOS.h"
+#include "task.h"
+
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
 
-// ==================== 私有变量 ====================
+// ==================== 私有变量 ====================
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 启动发送队列的下一段DMA传输
+ * @param usart_handle USART设备句柄指针
+ * @retval 无
+ * @note 只发送到缓冲区末尾为止的连续部分，回绕部分在完成中断中继续；
+ *       队列为空时清除busy标志
+ */
+static void yDev_Usart_TxStart(yDevHandle_Usart_t *usart_handle);
+
+/**
+ * @brief 发送DMA完成中断回调
+ * @param arg USART设备句柄指针
+ * @retval 无
+ * @note 释放已发送的空间，唤醒等待空间的任务并启动下一段传输
+ */
+static void yDev_Usart_TxDoneIrq(void *arg);
+
+/**
+ * @brief 发送DMA错误中断回调
+ * @param arg USART设备句柄指针
+ * @retval 无
+ * @note 记录错误并丢弃当前段，避免队列永久停在busy状态
+ */
+static void yDev_Usart_TxErrorIrq(void *arg);
+
+/**
+ * @brief 写入数据到DMA发送队列
+ * @param usart_handle USART设备句柄指针
+ * @param data 数据指针
+ * @param size 数据长度
+ * @retval int32_t 实际写入队列的字节数
+ * @note 非阻塞模式下队列满时立即返回；阻塞模式下等待DMA释放空间，
+ *       等待时间受base.timeOutMs限制，0表示一直等待
+ */
+static int32_t yDev_Usart_TxQueueWrite(yDevHandle_Usart_t *usart_handle, const uint8_t *data, size_t size);
+
+/**
+ * @brief 拷贝数据到DMA发送队列的环形缓冲区
+ * @param queue 发送队列指针
+ * @param head 写入起始位置
+ * @param data 数据指针
+ * @param count 数据长度，调用者保证不超过空闲空间
+ * @retval uint32_t 写入后的新位置，由调用者提交到queue->head
+ * @note 回绕时分两段拷贝
+ */
+static uint32_t yDev_Usart_TxQueueCopy(yDevUsartTxQueue_t *queue, uint32_t head, const uint8_t *data, uint32_t count);
+
+/**
+ * @brief 配置DMA发送队列
+ * @param usart_handle USART设备句柄指针
+ * @param config 发送队列配置指针
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_Usart_TxQueueSetup(yDevHandle_Usart_t *usart_handle, const yDevUsartTxQueueConfig_t *config);
+
+/**
+ * @brief 等待DMA发送队列发完
+ * @param usart_handle USART设备句柄指针
+ * @retval yDevStatus_t 操作状态
+ * @note 调用者持有句柄互斥锁，其他任务无法继续写入；等待时间受base.timeOutMs限制
+ */
+static yDevStatus_t yDev_Usart_TxQueueDrain(yDevHandle_Usart_t *usart_handle);
+
+/**
+ * @brief 获取接收DMA当前写入位置
+ * @param usart_handle USART设备句柄指针
+ * @retval uint32_t 接收缓冲区中的写入偏移
+ */
+static uint32_t yDev_Usart_RxPos(yDevHandle_Usart_t *usart_handle);
+
+/**
+ * @brief 获取接收流当前的累计接收字节数
+ * @param usart_handle USART设备句柄指针
+ * @param pos 输出的DMA写入位置
+ * @retval uint32_t 累计接收字节数
+ * @note 在中断记录的计数上加上之后DMA前进的距离，任务中调用
+ */
+static uint32_t yDev_Usart_RxReceived(yDevHandle_Usart_t *usart_handle, uint32_t *pos);
+
+/**
+ * @brief 接收流中断回调
+ * @param arg USART设备句柄指针
+ * @retval 无
+ * @note 空闲(或接收超时)、DMA半满和全满中断共用，推进累计接收计数并通知读取方；
+ *       三个中断优先级相同，不会互相抢占
+ */
+static void yDev_Usart_RxUpdateIrq(void *arg);
+
+/**
+ * @brief 配置DMA接收流
+ * @param usart_handle USART设备句柄指针
+ * @param config 接收流配置指针
+ * @retval yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_Usart_RxStreamSetup(yDevHandle_Usart_t *usart_handle, const yDevUsartRxStreamConfig_t *config);
+
+/**
+ * @brief 执行自动波特率检测
+ * @param usart_handle USART设备句柄指针
+ * @param param 检测参数，成功时写入检测到的波特率
+ * @retval yDevStatus_t 操作状态
+ * @note 每个系统节拍查询一次结果，等待期间不占用CPU
+ */
+static yDevStatus_t yDev_Usart_AutoBaud(yDevHandle_Usart_t *usart_handle, yDevUsartAutoBaud_t *param);
+
+/**
+ * @brief 汇总端口统计
+ * @param usart_handle USART设备句柄指针
+ * @param stats 输出的统计信息
+ * @retval 无
+ * @note 字节计数和高水位来自yDev层，接收错误来自驱动层中断计数
+ */
+static void yDev_Usart_GetStats(yDevHandle_Usart_t *usart_handle, yDevUsartStats_t *stats);
+
+/**
+ * @brief 尝试完成异步读取
+ * @param usart_handle USART设备句柄指针
+ * @retval 无
+ * @note 接收流中累计到请求长度时拷贝并通知完成；任务和接收流中断都会调用，
+ *       临界区内取走目标缓冲区，只有一方执行拷贝
+ */
+static void yDev_Usart_RxAsyncPoll(yDevHandle_Usart_t *usart_handle);
+
+/**
+ * @brief 把共享缓冲区排入发送队列
+ * @param usart_handle USART设备句柄指针
+ * @param shared 共享缓冲区
+ * @retval yDevStatus_t 排队状态，成功时端口持有一个引用
+ * @note 插在队列当前写入位置，之前的数据发完后DMA直接从共享缓冲区发送
+ */
+static yDevStatus_t yDev_Usart_TxQueueShared(yDevHandle_Usart_t *usart_handle, yDevUsartShared_t *shared);
+
+/**
+ * @brief 释放共享缓冲区的一个引用
+ * @param shared 共享缓冲区
+ * @retval 无
+ * @note 任务和中断中都可调用，引用归零时调用release
+ */
+static void yDev_Usart_SharedPut(yDevUsartShared_t *shared);
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 启动发送队列的下一段DMA传输实现
+ */
+static void yDev_Usart_TxStart(yDevHandle_Usart_t *usart_handle)
+{
+    yDevUsartTxQueue_t *queue = &usart_handle->tx_queue;
+    yDevUsartShared_t *shared;
+    const uint8_t *src;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t len;
+
+    head = queue->head;
+    tail = queue->tail;
+    shared = queue->shared;
+    if ((shared != NULL) && (tail == queue->mark))
+    {
+        // 共享缓冲区之前的数据已发完，DMA直接读取共享缓冲区
+        src = shared->data;
+        len = shared->len;
+        queue->ext = 1;
+    }
+    else if (head == tail)
+    {
+        queue->chunk = 0;
+        queue->busy = 0;
+        return;
+    }
+    else
+    {
+        // 有共享缓冲区排队时只发到插入位置
+        len = (head > tail) ? (head - tail) : (queue->size - tail);
+        if ((shared != NULL) && (queue->mark > tail) && (len > (queue->mark - tail)))
+        {
+            len = queue->mark - tail;
+        }
+        src = &queue->buffer[tail];
+    }
+    queue->chunk = len;
+    queue->busy = 1;
+
+    yDrvDmaTransDisable(&usart_handle->tx_dma_handle);
+    yDrvDmaDstBufferSet(&usart_handle->tx_dma_handle, (void *)src, YDRV_DMA_WIDTH_8BIT);
+    yDrvDmaDstBufferLen(&usart_handle->tx_dma_handle, len);
+    yDrvDmaClearFlags(&usart_handle->tx_dma_handle);
+    yDrvDmaTransEnable(&usart_handle->tx_dma_handle);
+}
+
+/**
+ * @brief 发送DMA完成中断回调实现
+ */
+static void yDev_Usart_TxDoneIrq(void *arg)
+{
+    yDevHandle_Usart_t *usart_handle = (yDevHandle_Usart_t *)arg;
+    yDevUsartTxQueue_t *queue = &usart_handle->tx_queue;
+    BaseType_t woken = pdFALSE;
+    yDevUsartShared_t *shared;
+    uint32_t tail;
+
+    usart_handle->stats.tx_bytes += queue->chunk;
+    if (queue->ext != 0)
+    {
+        // 共享缓冲区发完，释放本端口的引用，队列位置不变
+        shared = queue->shared;
+        queue->ext = 0;
+        queue->shared = NULL;
+        yDev_Usart_SharedPut(shared);
+    }
+    else
+    {
+        tail = queue->tail + queue->chunk;
+        if (tail >= queue->size)
+        {
+            tail -= queue->size;
+        }
+        queue->tail = tail;
+
+        // 异步写入的数据全部交给发送寄存器后通知完成
+        if (queue->async != 0)
+        {
+            if (queue->async <= queue->chunk)
+            {
+                queue->async = 0;
+                yDevAsyncComplete(usart_handle, YDEV_ASYNC_WRITE, YDEV_OK,
+                                  usart_handle->base.async[YDEV_ASYNC_WRITE].size);
+            }
+            else
+            {
+                queue->async -= queue->chunk;
+            }
+        }
+    }
+
+    if (queue->wait_task != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR((TaskHandle_t)queue->wait_task, YDEV_USART_TX_NOTIFY_INDEX, &woken);
+    }
+
+    yDev_Usart_TxStart(usart_handle);
+    yDevPollSignal(usart_handle, 0);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 发送DMA错误中断回调实现
+ */
+static void yDev_Usart_TxErrorIrq(void *arg)
+{
+    yDevHandle_Usart_t *usart_handle = (yDevHandle_Usart_t *)arg;
+
+    usart_handle->base.errno |= YDEV_USART_ERRNO_DMA;
+    yDev_Usart_TxDoneIrq(arg);
+}
+
+/**
+ * @brief 写入数据到DMA发送队列实现
+ */
+static int32_t yDev_Usart_TxQueueWrite(yDevHandle_Usart_t *usart_handle, const uint8_t *data, size_t size)
+{
+    yDevUsartTxQueue_t *queue = &usart_handle->tx_queue;
+    uint32_t written;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t space;
+    uint32_t count;
+    TickType_t wait;
+
+    wait = (usart_handle->base.timeOutMs == 0) ? portMAX_DELAY : pdMS_TO_TICKS(usart_handle->base.timeOutMs);
+    written = 0;
+    while (written < size)
+    {
+        head = queue->head;
+        tail = queue->tail;
+        space = (tail > head) ? (tail - head - 1U) : (queue->size - head + tail - 1U);
+
+        // 1. 队列已满：非阻塞直接返回，阻塞时等待完成中断释放空间
+        if (space == 0)
+        {
+            if (queue->block == 0)
+            {
+                usart_handle->base.errno |= YDEV_USART_ERRNO_BUFFER_FULL;
+                break;
+            }
+            if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+            {
+                while (queue->tail == tail)
+                {
+                }
+                continue;
+            }
+            queue->wait_task = (void *)xTaskGetCurrentTaskHandle();
+            (void)ulTaskNotifyTakeIndexed(YDEV_USART_TX_NOTIFY_INDEX, pdTRUE, 0);
+            if ((queue->tail == tail) && (ulTaskNotifyTakeIndexed(YDEV_USART_TX_NOTIFY_INDEX, pdTRUE, wait) == 0))
+            {
+                queue->wait_task = NULL;
+                usart_handle->base.errno |= YDEV_USART_ERRNO_TIMEOUT;
+                break;
+            }
+            queue->wait_task = NULL;
+            continue;
+        }
+
+        // 2. 拷贝到环形缓冲区
+        count = size - written;
+        if (count > space)
+        {
+            count = space;
+        }
+        queue->head = yDev_Usart_TxQueueCopy(queue, head, &data[written], count);
+        written += count;
+
+        // 未发出数据的历史最大值，用于评估缓冲区大小
+        count = queue->size - 1U - space + count;
+        if (count > usart_handle->stats.tx_high_water)
+        {
+            usart_handle->stats.tx_high_water = count;
+        }
+
+        // 3. DMA空闲时启动，正在传输时由完成中断接着发送新数据
+        if (queue->busy == 0)
+        {
+            yDev_Usart_TxStart(usart_handle);
+        }
+    }
+
+    return (int32_t)written;
+}
+
+/**
+ * @brief 拷贝数据到环形缓冲区实现
+ */
+static uint32_t yDev_Usart_TxQueueCopy(yDevUsartTxQueue_t *queue, uint32_t head, const uint8_t *data, uint32_t count)
+{
+    uint32_t first;
+
+    first = queue->size - head;
+    if (first > count)
+    {
+        first = count;
+    }
+    memcpy(&queue->buffer[head], data, first);
+    if (count > first)
+    {
+        memcpy(queue->buffer, &data[first], count - first);
+    }
+    head += count;
+    if (head >= queue->size)
+    {
+        head -= queue->size;
+    }
+
+    return head;
+}
+
+/**
+ * @brief 把共享缓冲区排入发送队列实现
+ */
+static yDevStatus_t yDev_Usart_TxQueueShared(yDevHandle_Usart_t *usart_handle, yDevUsartShared_t *shared)
+{
+    yDevUsartTxQueue_t *queue = &usart_handle->tx_queue;
+    uint32_t primask;
+    TickType_t wait;
+
+    if (queue->buffer == NULL)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    // 1. 上一个共享缓冲区未发完：非阻塞直接返回，阻塞时等待完成中断
+    wait = (usart_handle->base.timeOutMs == 0) ? portMAX_DELAY : pdMS_TO_TICKS(usart_handle->base.timeOutMs);
+    while (queue->shared != NULL)
+    {
+        if (queue->block == 0)
+        {
+            usart_handle->base.errno |= YDEV_USART_ERRNO_BUSY;
+            return YDEV_BUSY;
+        }
+        if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+        {
+            continue;
+        }
+        queue->wait_task = (void *)xTaskGetCurrentTaskHandle();
+        (void)ulTaskNotifyTakeIndexed(YDEV_USART_TX_NOTIFY_INDEX, pdTRUE, 0);
+        if ((queue->shared != NULL) && (ulTaskNotifyTakeIndexed(YDEV_USART_TX_NOTIFY_INDEX, pdTRUE, wait) == 0))
+        {
+            queue->wait_task = NULL;
+            usart_handle->base.errno |= YDEV_USART_ERRNO_TIMEOUT;
+            return YDEV_TIMEOUT;
+        }
+        queue->wait_task = NULL;
+    }
+
+    // 2. 插入位置、引用和启动与完成中断互斥
+    primask = __get_PRIMASK();
+    __disable_irq();
+    shared->refs++;
+    queue->mark = queue->head;
+    queue->shared = shared;
+    if (queue->busy == 0)
+    {
+        yDev_Usart_TxStart(usart_handle);
+    }
+    __set_PRIMASK(primask);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 释放共享缓冲区的一个引用实现
+ */
+static void yDev_Usart_SharedPut(yDevUsartShared_t *shared)
+{
+    uint32_t primask;
+    uint32_t refs;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    refs = --shared->refs;
+    __set_PRIMASK(primask);
+
+    if ((refs == 0) && (shared->release != NULL))
+    {
+        shared->release(shared->arg);
+    }
+}
+
+/**
+ * @brief 等待DMA发送队列发完实现
+ */
+static yDevStatus_t yDev_Usart_TxQueueDrain(yDevHandle_Usart_t *usart_handle)
+{
+    yDevUsartTxQueue_t *queue = &usart_handle->tx_queue;
+    uint32_t start_time = yDevGetTimeMS();
+
+    while ((queue->busy != 0) || (queue->head != queue->tail) || (queue->shared != NULL) || (queue->async != 0))
+    {
+        if ((usart_handle->base.timeOutMs != 0) && ((yDevGetTimeMS() - start_time) >= usart_handle->base.timeOutMs))
+        {
+            return YDEV_TIMEOUT;
+        }
+        if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+        {
+            vTaskDelay(1);
+        }
+    }
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 配置DMA发送队列实现
+ */
+static yDevStatus_t yDev_Usart_TxQueueSetup(yDevHandle_Usart_t *usart_handle, const yDevUsartTxQueueConfig_t *config)
+{
+    yDrvDmaConfig_t dma_config;
+    yDrvDmaExtiConfig_t exti_config;
+    yDrvDmaChannel_t channel;
+    yDevStatus_t status;
+
+    if ((config->buffer == NULL) || (config->size < 2U) ||
+        ((config->channel >= YDRV_DMA_CHANNEL_MAX) && (config->channel != YDRV_DMA_CHANNEL_AUTO)))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 0. 更换缓冲区：原队列发完后释放通道，之后按新配置重新申请
+    if (usart_handle->tx_queue.buffer != NULL)
+    {
+        status = yDev_Usart_TxQueueDrain(usart_handle);
+        if (status != YDEV_OK)
+        {
+            return status;
+        }
+        yDrvDmaDeInitStatic(&usart_handle->tx_dma_handle);
+        usart_handle->tx_queue.buffer = NULL;
+    }
+
+    // 1. 发送通道，外设地址和DMAMUX请求由驱动按USART实例设置
+    dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    dma_config.channel = config->channel;
+    dma_config.priority = YDRV_DMA_PRIORITY_MEDIUM;
+    dma_config.src_buffer = config->buffer;
+    dma_config.trans_len = 0;
+    dma_config.owner = "usart tx";
+    if (yDrvDmaInitStatic(&dma_config, &usart_handle->tx_dma_handle, YDRV_DMA_DIR_M2P) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+    channel = usart_handle->tx_dma_handle.index;
+    if (yDrvUsartDmaWrite(&usart_handle->drv_handle, &channel) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    // 2. 队列状态
+    usart_handle->tx_queue.buffer = config->buffer;
+    usart_handle->tx_queue.size = config->size;
+    usart_handle->tx_queue.head = 0;
+    usart_handle->tx_queue.tail = 0;
+    usart_handle->tx_queue.chunk = 0;
+    usart_handle->tx_queue.busy = 0;
+    usart_handle->tx_queue.block = config->block;
+    usart_handle->tx_queue.wait_task = NULL;
+    usart_handle->tx_queue.async = 0;
+    usart_handle->tx_queue.shared = NULL;
+    usart_handle->tx_queue.mark = 0;
+    usart_handle->tx_queue.ext = 0;
+
+    // 3. 完成和错误中断驱动队列前进
+    exti_config = YDRV_DMA_EXTI_CONFIG_DEFAULT();
+    exti_config.prio = config->prio;
+    exti_config.arg = usart_handle;
+    exti_config.enable = 1;
+    exti_config.trigger = YDRV_DMA_EXTI_TC;
+    exti_config.function = yDev_Usart_TxDoneIrq;
+    if (yDrvDmaRegisterCallback(&usart_handle->tx_dma_handle, &exti_config) != YDRV_OK)
+    {
+        usart_handle->tx_queue.buffer = NULL;
+        return YDEV_ERROR;
+    }
+    exti_config.trigger = YDRV_DMA_EXTI_TE;
+    exti_config.function = yDev_Usart_TxErrorIrq;
+    yDrvDmaRegisterCallback(&usart_handle->tx_dma_handle, &exti_config);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 汇总端口统计实现
+ */
+static void yDev_Usart_GetStats(yDevHandle_Usart_t *usart_handle, yDevUsartStats_t *stats)
+{
+    yDrvUsartErrorStats_t errors = {0};
+
+    *stats = usart_handle->stats;
+
+    yDrvUsartGetErrorStats(&usart_handle->drv_handle, &errors);
+    stats->ore += errors.ore;
+    stats->fe = errors.fe;
+    stats->ne = errors.ne;
+    stats->pe = errors.pe;
+
+    if (usart_handle->rx_stream.buffer != NULL)
+    {
+        stats->rx_bytes += usart_handle->rx_stream.received;
+        stats->overruns = usart_handle->rx_stream.overruns;
+        stats->lost = usart_handle->rx_stream.lost;
+        stats->rx_size = usart_handle->rx_stream.size;
+    }
+    if (usart_handle->tx_queue.buffer != NULL)
+    {
+        stats->tx_size = usart_handle->tx_queue.size;
+    }
+}
+
+/**
+ * @brief 自动波特率检测实现
+ */
+static yDevStatus_t yDev_Usart_AutoBaud(yDevHandle_Usart_t *usart_handle, yDevUsartAutoBaud_t *param)
+{
+    yDrvStatus_t status;
+    TickType_t start;
+    TickType_t wait;
+
+    status = yDrvUsartAutoBaudStart(&usart_handle->drv_handle, param->mode);
+    if (status == YDRV_NOT_SUPPORTED)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+    if (status != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+
+    start = xTaskGetTickCount();
+    wait = (param->timeOutMs == 0) ? portMAX_DELAY : pdMS_TO_TICKS(param->timeOutMs);
+    for (;;)
+    {
+        status = yDrvUsartAutoBaudPoll(&usart_handle->drv_handle, &param->baudRate);
+        if (status == YDRV_OK)
+        {
+            return YDEV_OK;
+        }
+        if (status != YDRV_BUSY)
+        {
+            return YDEV_ERROR;
+        }
+        if ((wait != portMAX_DELAY) && ((xTaskGetTickCount() - start) >= wait))
+        {
+            usart_handle->base.errno |= YDEV_USART_ERRNO_TIMEOUT;
+            return YDEV_TIMEOUT;
+        }
+        vTaskDelay(1);
+    }
+}
+
+/**
+ * @brief 获取接收DMA当前写入位置实现
+ */
+static uint32_t yDev_Usart_RxPos(yDevHandle_Usart_t *usart_handle)
+{
+    uint32_t pos;
+
+    pos = usart_handle->rx_stream.size - yDrvDmaCurLenGet(&usart_handle->rx_dma_handle);
+    if (pos >= usart_handle->rx_stream.size)
+    {
+        pos = 0;
+    }
+    return pos;
+}
+
+/**
+ * @brief 获取接收流当前的累计接收字节数实现
+ */
+static uint32_t yDev_Usart_RxReceived(yDevHandle_Usart_t *usart_handle, uint32_t *pos)
+{
+    yDevUsartRxStream_t *stream = &usart_handle->rx_stream;
+    uint32_t received;
+    uint32_t write;
+
+    // 读取期间中断可能更新计数，前后一致才使用
+    do
+    {
+        received = stream->received;
+        write = stream->write;
+    } while (received != stream->received);
+
+    *pos = yDev_Usart_RxPos(usart_handle);
+    return received + ((*pos >= write) ? (*pos - write) : (*pos + stream->size - write));
+}
+
+/**
+ * @brief 接收流中断回调实现
+ */
+static void yDev_Usart_RxUpdateIrq(void *arg)
+{
+    yDevHandle_Usart_t *usart_handle = (yDevHandle_Usart_t *)arg;
+    yDevUsartRxStream_t *stream = &usart_handle->rx_stream;
+    uint32_t index;
+    uint32_t pending;
+
+    index = yDev_Usart_RxPos(usart_handle);
+    if (index == stream->write)
+    {
+        return;
+    }
+
+    stream->received += (index > stream->write) ? (index - stream->write) : (index + stream->size - stream->write);
+    stream->write = index;
+
+    // 未读数据的历史最大值，用于评估缓冲区大小
+    pending = stream->received - stream->consumed;
+    if (pending > usart_handle->stats.rx_high_water)
+    {
+        usart_handle->stats.rx_high_water = pending;
+    }
+
+    if (stream->notify != NULL)
+    {
+        stream->notify(stream->arg);
+    }
+
+    yDev_Usart_RxAsyncPoll(usart_handle);
+    yDevPollSignal(usart_handle, 0);
+}
+
+/**
+ * @brief 配置DMA接收流实现
+ */
+static yDevStatus_t yDev_Usart_RxStreamSetup(yDevHandle_Usart_t *usart_handle, const yDevUsartRxStreamConfig_t *config)
+{
+    yDrvDmaConfig_t dma_config;
+    yDrvDmaExtiConfig_t dma_exti;
+    yDrvUsartExtiConfig_t exti_config;
+    yDrvDmaChannel_t channel;
+    uint32_t overruns = 0;
+    uint32_t lost = 0;
+
+    if ((config->buffer == NULL) || (config->size < 2U) || (config->size > 0xFFFFU) ||
+        ((config->channel >= YDRV_DMA_CHANNEL_MAX) && (config->channel != YDRV_DMA_CHANNEL_AUTO)))
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 0. 更换缓冲区：先停空闲中断再释放通道，累计计数并入统计，溢出计数延续
+    if (usart_handle->rx_stream.buffer != NULL)
+    {
+        if (usart_handle->rx_stream.async != NULL)
+        {
+            return YDEV_BUSY;
+        }
+        yDrvUsartUnregisterCallback(&usart_handle->drv_handle, YDRV_USART_EXTI_IDLE);
+        yDrvUsartUnregisterCallback(&usart_handle->drv_handle, YDRV_USART_EXTI_RTO);
+        yDrvDmaDeInitStatic(&usart_handle->rx_dma_handle);
+        usart_handle->stats.rx_bytes += usart_handle->rx_stream.received;
+        overruns = usart_handle->rx_stream.overruns;
+        lost = usart_handle->rx_stream.lost;
+        usart_handle->rx_stream.buffer = NULL;
+    }
+
+    // 1. 接收通道循环写入缓冲区，外设地址和DMAMUX请求由驱动按USART实例设置
+    dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    dma_config.channel = config->channel;
+    dma_config.priority = YDRV_DMA_PRIORITY_HIGH;
+    dma_config.mode = YDRV_DMA_MODE_CIRCULAR;
+    dma_config.dst_buffer = config->buffer;
+    dma_config.trans_len = config->size;
+    dma_config.owner = "usart rx";
+    if (yDrvDmaInitStatic(&dma_config, &usart_handle->rx_dma_handle, YDRV_DMA_DIR_P2M) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
+    channel = usart_handle->rx_dma_handle.index;
+    if (yDrvUsartDmaRead(&usart_handle->drv_handle, &channel) != YDRV_OK)
+    {
+        return YDEV_ERROR;
+    }
 
-// ==================== 私有函数声明 ====================
+    // 2. 接收流状态
+    usart_handle->rx_stream.buffer = config->buffer;
+    usart_handle->rx_stream.size = config->size;
+    usart_handle->rx_stream.read = 0;
+    usart_handle->rx_stream.consumed = 0;
+    usart_handle->rx_stream.write = 0;
+    usart_handle->rx_stream.received = 0;
+    usart_handle->rx_stream.overruns = overruns;
+    usart_handle->rx_stream.lost = lost;
+    usart_handle->rx_stream.notify = config->notify;
+    usart_handle->rx_stream.arg = config->arg;
+    usart_handle->rx_stream.async = NULL;
+
+    // 3. 半满/全满中断保证连续数据流中每半个缓冲区至少观测一次写入位置
+    dma_exti = YDRV_DMA_EXTI_CONFIG_DEFAULT();
+    dma_exti.prio = config->prio;
+    dma_exti.function = yDev_Usart_RxUpdateIrq;
+    dma_exti.arg = usart_handle;
+    dma_exti.enable = 1;
+    dma_exti.trigger = YDRV_DMA_EXTI_HT;
+    yDrvDmaRegisterCallback(&usart_handle->rx_dma_handle, &dma_exti);
+    dma_exti.trigger = YDRV_DMA_EXTI_TC;
+    yDrvDmaRegisterCallback(&usart_handle->rx_dma_handle, &dma_exti);
+
+    // 4. 启动接收，空闲中断在数据间隙推进写入位置；
+    //    驱动配置了rxTimeout时改用接收超时，线路空闲达到设定位数才通知，一次通知即一帧
+    yDrvDmaClearFlags(&usart_handle->rx_dma_handle);
+    yDrvDmaTransEnable(&usart_handle->rx_dma_handle);
+
+    exti_config = YDRV_USART_EXTI_CONFIG_DEFAULT();
+    exti_config.trigger = YDRV_USART_EXTI_RTO;
+    exti_config.prio = config->prio;
+    exti_config.function = yDev_Usart_RxUpdateIrq;
+    exti_config.arg = usart_handle;
+    exti_config.enable = 1;
+    if (yDrvUsartRegisterCallback(&usart_handle->drv_handle, &exti_config) != YDRV_OK)
+    {
+        exti_config.trigger = YDRV_USART_EXTI_IDLE;
+    }
+    if ((exti_config.trigger == YDRV_USART_EXTI_IDLE) &&
+        (yDrvUsartRegisterCallback(&usart_handle->drv_handle, &exti_config) != YDRV_OK))
+    {
+        yDrvDmaTransDisable(&usart_handle->rx_dma_handle);
+        yDrvDmaUnregisterCallback(&usart_handle->rx_dma_handle, YDRV_DMA_EXTI_MAX);
+        usart_handle->rx_stream.buffer = NULL;
+        return YDEV_ERROR;
+    }
+
+    // 5. 使能错误中断，驱动层计数并清除FE/NE/ORE/PE，不需要回调
+    exti_config.function = NULL;
+    exti_config.arg = NULL;
+    exti_config.trigger = YDRV_USART_EXTI_ERR;
+    yDrvUsartRegisterCallback(&usart_handle->drv_handle, &exti_config);
+    exti_config.trigger = YDRV_USART_EXTI_PE;
+    yDrvUsartRegisterCallback(&usart_handle->drv_handle, &exti_config);
+
+    // 6. 只用DMA接收时换用只检查IDLE/RTOF的中断入口，不满足条件时保持通用入口
+    yDrvUsartIdleFastPath(&usart_handle->drv_handle);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief 尝试完成异步读取实现
+ */
+static void yDev_Usart_RxAsyncPoll(yDevHandle_Usart_t *usart_handle)
+{
+    yDevUsartRxStream_t *stream = &usart_handle->rx_stream;
+    uint32_t size = usart_handle->base.async[YDEV_ASYNC_READ].size;
+    uint8_t *buffer;
+    uint32_t primask;
+    uint32_t write;
+    uint32_t len;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    buffer = stream->async;
+    if ((buffer == NULL) ||
+        ((yDev_Usart_RxReceived(usart_handle, &write) - stream->consumed) < size))
+    {
+        __set_PRIMASK(primask);
+        return;
+    }
+    stream->async = NULL;
+    __set_PRIMASK(primask);
+
+    // 溢出时Peek丢弃被覆盖的数据，拷贝长度不足按错误结束
+    len = yDevUsartRxCopy(usart_handle, buffer, size);
+    yDevAsyncComplete(usart_handle, YDEV_ASYNC_READ, (len == size) ? YDEV_OK : YDEV_ERROR, len);
+}
 
 // ==================== USART设备操作函数实现 ====================
 
@@ -87,6 +901,38 @@ static yDevStatus_t yDev_Usart_Deinit(void *handle)
 
     usart_handle = (yDevHandle_Usart_t *)handle;
 
+    // 中止未完成的异步传输，避免等待任务永久阻塞
+    usart_handle->rx_stream.async = NULL;
+    usart_handle->tx_queue.async = 0;
+    yDevAsyncComplete(usart_handle, YDEV_ASYNC_READ, YDEV_ERROR, 0);
+    yDevAsyncComplete(usart_handle, YDEV_ASYNC_WRITE, YDEV_ERROR, 0);
+
+    if (usart_handle->rx_stream.buffer != NULL)
+    {
+        yDrvUsartUnregisterCallback(&usart_handle->drv_handle, YDRV_USART_EXTI_IDLE);
+        yDrvUsartUnregisterCallback(&usart_handle->drv_handle, YDRV_USART_EXTI_RTO);
+        yDrvUsartUnregisterCallback(&usart_handle->drv_handle, YDRV_USART_EXTI_ERR);
+        yDrvUsartUnregisterCallback(&usart_handle->drv_handle, YDRV_USART_EXTI_PE);
+        yDrvDmaDeInitStatic(&usart_handle->rx_dma_handle);
+        usart_handle->rx_stream.buffer = NULL;
+    }
+
+    if (usart_handle->tx_queue.buffer != NULL)
+    {
+        yDrvDmaDeInitStatic(&usart_handle->tx_dma_handle);
+        usart_handle->tx_queue.buffer = NULL;
+
+        // 未发出的共享缓冲区归还引用，其他端口发完后仍能释放
+        if (usart_handle->tx_queue.shared != NULL)
+        {
+            yDevUsartShared_t *shared = usart_handle->tx_queue.shared;
+
+            usart_handle->tx_queue.shared = NULL;
+            usart_handle->tx_queue.ext = 0;
+            yDev_Usart_SharedPut(shared);
+        }
+    }
+
     if (yDrvUsartDeInitStatic(&usart_handle->drv_handle) != YDRV_OK)
     {
         return YDEV_ERROR;
@@ -123,6 +969,145 @@ void yDevUsartHandleStructInit(yDevHandle_Usart_t *handle)
 
     // 初始化驱动句柄
     yDrvUsartHandleStructInit(&handle->drv_handle);
+    handle->tx_dma_handle = YDRV_DMA_HANDLE_DEFAULT();
+    handle->rx_dma_handle = YDRV_DMA_HANDLE_DEFAULT();
+
+    // 未配置发送队列和接收流时读写走轮询
+    memset(&handle->tx_queue, 0, sizeof(handle->tx_queue));
+    memset(&handle->rx_stream, 0, sizeof(handle->rx_stream));
+    memset(&handle->stats, 0, sizeof(handle->stats));
+}
+
+// ==================== yDev USART多端口发送函数实现 ====================
+
+int32_t yDevUsartWriteShared(yDevHandle_Usart_t *const *ports, uint32_t count, yDevUsartShared_t *shared)
+{
+    int32_t queued;
+    uint32_t i;
+
+    if ((ports == NULL) || (shared == NULL) || (shared->data == NULL) || (shared->len == 0) ||
+        (shared->len > 0xFFFFU))
+    {
+        return -1;
+    }
+
+    // 排队期间自己持有一个引用，先排入的端口发完也不会提前释放
+    shared->refs = 1;
+    queued = 0;
+    for (i = 0; i < count; i++)
+    {
+        if ((ports[i] != NULL) && (yDevIoctl(ports[i], YDEV_USART_IOCTL_WRITE_SHARED, shared) == YDEV_OK))
+        {
+            queued++;
+        }
+    }
+    yDev_Usart_SharedPut(shared);
+
+    return queued;
+}
+
+// ==================== yDev USART接收流函数实现 ====================
+
+/**
+ * @brief 查看接收流中的可读数据实现
+ */
+uint32_t yDevUsartRxPeek(yDevHandle_Usart_t *handle, yDevUsartRxSpan_t *span)
+{
+    yDevUsartRxStream_t *stream;
+    uint32_t received;
+    uint32_t write;
+    uint32_t avail;
+
+    if ((handle == NULL) || (span == NULL) || (handle->rx_stream.buffer == NULL))
+    {
+        return 0;
+    }
+
+    stream = &handle->rx_stream;
+    received = yDev_Usart_RxReceived(handle, &write);
+    avail = received - stream->consumed;
+
+    // 未读数据超过缓冲区大小说明已被覆盖，整体丢弃后从写入位置继续
+    if (avail > stream->size)
+    {
+        stream->overruns++;
+        stream->lost += avail;
+        stream->consumed = received;
+        stream->read = write;
+        handle->base.errno |= YDEV_USART_ERRNO_BUFFER_FULL;
+        avail = 0;
+    }
+
+    span->data[0] = &stream->buffer[stream->read];
+    span->len[0] = stream->size - stream->read;
+    if (span->len[0] > avail)
+    {
+        span->len[0] = avail;
+    }
+    span->data[1] = stream->buffer;
+    span->len[1] = avail - span->len[0];
+
+    return avail;
+}
+
+/**
+ * @brief 提交接收流的消费长度实现
+ */
+void yDevUsartRxConsume(yDevHandle_Usart_t *handle, uint32_t len)
+{
+    yDevUsartRxStream_t *stream;
+    uint32_t write;
+    uint32_t avail;
+
+    if ((handle == NULL) || (handle->rx_stream.buffer == NULL))
+    {
+        return;
+    }
+
+    stream = &handle->rx_stream;
+    avail = yDev_Usart_RxReceived(handle, &write) - stream->consumed;
+    if (len > avail)
+    {
+        len = avail;
+    }
+
+    stream->consumed += len;
+    stream->read += len;
+    if (stream->read >= stream->size)
+    {
+        stream->read -= stream->size;
+    }
+}
+
+/**
+ * @brief 从接收流拷贝数据实现
+ */
+uint32_t yDevUsartRxCopy(yDevHandle_Usart_t *handle, void *buffer, uint32_t len)
+{
+    yDevUsartRxSpan_t span;
+    uint8_t *dst = (uint8_t *)buffer;
+    uint32_t first;
+    uint32_t second;
+
+    if ((buffer == NULL) || (yDevUsartRxPeek(handle, &span) == 0))
+    {
+        return 0;
+    }
+
+    first = (span.len[0] < len) ? span.len[0] : len;
+    memcpy(dst, span.data[0], first);
+    second = len - first;
+    if (second > span.len[1])
+    {
+        second = span.len[1];
+    }
+    if (second != 0)
+    {
+        memcpy(&dst[first], span.data[1], second);
+    }
+
+    yDevUsartRxConsume(handle, first + second);
+    return first + second;
 }
 
 /**
@@ -132,10 +1117,10 @@ void yDevUsartHandleStructInit(yDevHandle_Usart_t *handle)
  * @param size 缓冲区大小
  * @return int32_t 实际读取的字节数，-1表示错误
  */
-static int32_t yDev_Usart_Read(void *handle, void *buffer, uint16_t size)
+static int32_t yDev_Usart_Read(void *handle, void *buffer, size_t size)
 {
     yDevHandle_Usart_t *usart_handle;
-    uint16_t read_count;
+    uint32_t read_count;
     uint8_t *read_buff;
     int32_t read_res;
     size_t start_time;
@@ -156,6 +1141,12 @@ static int32_t yDev_Usart_Read(void *handle, void *buffer, uint16_t size)
         return -1;
     }
 
+    // 配置了接收流时直接从DMA缓冲区取出已收到的数据，不等待
+    if (usart_handle->rx_stream.buffer != NULL)
+    {
+        return (int32_t)yDevUsartRxCopy(usart_handle, buffer, size);
+    }
+
     usart_handle->base.errno &= (~YDEV_USART_ERRNO_ORE);
     start_time = yDevGetTimeMS();
     // 循环读取数据，直到读取完成或没有更多数据
@@ -166,20 +1157,22 @@ static int32_t yDev_Usart_Read(void *handle, void *buffer, uint16_t size)
             /* Clear Overrun Error flag*/
             yDrvUsartResetFlagORE(&usart_handle->drv_handle);
             usart_handle->base.errno = YDEV_USART_ERRNO_ORE;
-            return read_count;
+            usart_handle->stats.ore++;
+            return (int32_t)read_count;
         }
 
         read_res = yDrvUsartReadByte(&usart_handle->drv_handle,
                                      read_buff);
+        usart_handle->stats.rx_bytes += read_res;
         read_count += read_res;
         read_buff += read_res;
         if (yDevGetTimeMS() - start_time >= usart_handle->base.timeOutMs)
         {
-            return read_count;
+            return (int32_t)read_count;
         }
     }
 
-    return read_count;
+    return (int32_t)read_count;
 }
 
 /**
@@ -188,11 +1181,12 @@ static int32_t yDev_Usart_Read(void *handle, void *buffer, uint16_t size)
  * @param buffer 写入缓冲区
  * @param size 写入大小
  * @return int32_t 实际写入的字节数，-1表示错误
+ * @note 配置了发送队列时只拷贝到队列即返回，由DMA在后台发出
  */
-static int32_t yDev_Usart_Write(void *handle, const void *buffer, uint16_t size)
+static int32_t yDev_Usart_Write(void *handle, const void *buffer, size_t size)
 {
     yDevHandle_Usart_t *usart_handle;
-    uint16_t write_count;
+    uint32_t write_count;
     const uint8_t *write_buff;
     int32_t write_res;
     size_t start_time;
@@ -212,23 +1206,181 @@ static int32_t yDev_Usart_Write(void *handle, const void *buffer, uint16_t size)
         return -1;
     }
 
+    if (usart_handle->tx_queue.buffer != NULL)
+    {
+        return yDev_Usart_TxQueueWrite(usart_handle, write_buff, size);
+    }
+
     start_time = yDevGetTimeMS();
     while (write_count < size)
     {
         write_res = yDrvUsartWriteByte(&usart_handle->drv_handle,
                                        write_buff);
 
+        usart_handle->stats.tx_bytes += write_res;
         write_count += write_res;
         write_buff += write_res;
         if (yDevGetTimeMS() - start_time >= usart_handle->base.timeOutMs)
         {
-            return -1;
+            // 超时返回已发出的字节数，与队列写入一致
+            usart_handle->base.errno |= YDEV_USART_ERRNO_TIMEOUT;
+            return (int32_t)write_count;
         }
     }
 
     return (int32_t)write_count;
 }
 
+/**
+ * @brief USART设备异步读取操作
+ * @param handle USART设备句柄
+ * @param buffer 读取缓冲区
+ * @param size 读取大小，不超过接收流缓冲区大小
+ * @return yDevStatus_t 启动状态
+ * @note 需要先配置接收流；接收流中累计到size字节时在中断中拷贝并完成，
+ *       异步读取期间不要再用同步读取或Peek/Consume访问接收流
+ */
+static yDevStatus_t yDev_Usart_ReadAsync(void *handle, void *buffer, size_t size)
+{
+    yDevHandle_Usart_t *usart_handle = (yDevHandle_Usart_t *)handle;
+
+    if (usart_handle->rx_stream.buffer == NULL)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+    if (size > usart_handle->rx_stream.size)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    // 已收到的数据足够时在这里直接完成
+    usart_handle->rx_stream.async = (uint8_t *)buffer;
+    yDev_Usart_RxAsyncPoll(usart_handle);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief USART设备异步写入操作
+ * @param handle USART设备句柄
+ * @param buffer 写入缓冲区，拷贝进发送队列后即可复用
+ * @param size 写入大小
+ * @return yDevStatus_t 启动状态，队列空间不足时返回YDEV_BUSY
+ * @note 需要先配置发送队列；数据整体入队，队列中排在它之前的数据和它本身
+ *       都由DMA发出后在发送完成中断中通知完成
+ */
+static yDevStatus_t yDev_Usart_WriteAsync(void *handle, const void *buffer, size_t size)
+{
+    yDevHandle_Usart_t *usart_handle = (yDevHandle_Usart_t *)handle;
+    yDevUsartTxQueue_t *queue = &usart_handle->tx_queue;
+    uint32_t primask;
+    uint32_t pending;
+    uint32_t head;
+    uint32_t tail;
+
+    if (queue->buffer == NULL)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+
+    // 1. 登记完成前须发出的字节数，与完成中断推进tail互斥
+    primask = __get_PRIMASK();
+    __disable_irq();
+    head = queue->head;
+    tail = queue->tail;
+    pending = (head >= tail) ? (head - tail) : (queue->size - tail + head);
+    if ((queue->size - 1U - pending) < size)
+    {
+        __set_PRIMASK(primask);
+        usart_handle->base.errno |= YDEV_USART_ERRNO_BUFFER_FULL;
+        return YDEV_BUSY;
+    }
+    queue->async = pending + size;
+    __set_PRIMASK(primask);
+
+    // 2. 空间已确认足够，入队不会阻塞
+    (void)yDev_Usart_TxQueueWrite(usart_handle, (const uint8_t *)buffer, size);
+
+    return YDEV_OK;
+}
+
+/**
+ * @brief USART设备向量写入操作
+ * @param handle USART设备句柄
+ * @param iov 分段描述符数组
+ * @param count 分段数量
+ * @return int32_t 实际写入的总字节数，-1表示错误
+ * @note 配置了发送队列且空闲空间放得下整组时，各分段拷贝完成后一次提交队列
+ *       写入位置并启动DMA，整组在一次DMA传输中连续发出，其他写入不会插在分段之间；
+ *       放不下时逐段按普通写入排队
+ */
+static int32_t yDev_Usart_Writev(void *handle, const yDevIoVec_t *iov, uint32_t count)
+{
+    yDevHandle_Usart_t *usart_handle = (yDevHandle_Usart_t *)handle;
+    yDevUsartTxQueue_t *queue = &usart_handle->tx_queue;
+    uint32_t total;
+    uint32_t space;
+    uint32_t head;
+    uint32_t tail;
+    int32_t ret;
+    int32_t done;
+    uint32_t i;
+
+    if (yDrvUsartHandleIsValid(&usart_handle->drv_handle) != YDRV_OK)
+    {
+        return -1;
+    }
+
+    total = 0;
+    for (i = 0; i < count; i++)
+    {
+        total += (uint32_t)iov[i].len;
+    }
+
+    // 1. 整组放得下时只提交一次head，完成中断看到的是完整的一组数据
+    if (queue->buffer != NULL)
+    {
+        head = queue->head;
+        tail = queue->tail;
+        space = (tail > head) ? (tail - head - 1U) : (queue->size - head + tail - 1U);
+        if (total <= space)
+        {
+            for (i = 0; i < count; i++)
+            {
+                head = yDev_Usart_TxQueueCopy(queue, head, (const uint8_t *)iov[i].base, (uint32_t)iov[i].len);
+            }
+            queue->head = head;
+            if (queue->busy == 0)
+            {
+                yDev_Usart_TxStart(usart_handle);
+            }
+            return (int32_t)total;
+        }
+    }
+
+    // 2. 队列放不下或没有队列时逐段写入
+    done = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (iov[i].len == 0)
+        {
+            continue;
+        }
+        ret = yDev_Usart_Write(handle, iov[i].base, iov[i].len);
+        if (ret < 0)
+        {
+            return (done > 0) ? done : ret;
+        }
+        done += ret;
+        if ((size_t)ret != iov[i].len)
+        {
+            break;
+        }
+    }
+
+    return done;
+}
+
 /**
  * @brief USART设备控制操作
  * @param handle USART设备句柄
@@ -294,7 +1446,7 @@ static yDevStatus_t yDev_Usart_Ioctl(void *handle, uint32_t cmd, void *arg)
                 return YDEV_ERROR;
             }
             if (yDrvUsartDmaWrite(&usart_handle->drv_handle,
-                                  (yDrvDmaChannel_t *)arg) != YDRV_OK)
+                                  &usart_handle->tx_dma_handle.index) != YDRV_OK)
             {
                 return YDEV_ERROR;
             }
@@ -311,7 +1463,7 @@ static yDevStatus_t yDev_Usart_Ioctl(void *handle, uint32_t cmd, void *arg)
                 return YDEV_ERROR;
             }
             if (yDrvUsartDmaRead(&usart_handle->drv_handle,
-                                 (yDrvDmaChannel_t *)arg) != YDRV_OK)
+                                 &usart_handle->rx_dma_handle.index) != YDRV_OK)
             {
                 return YDEV_ERROR;
             }
@@ -342,15 +1494,185 @@ static yDevStatus_t yDev_Usart_Ioctl(void *handle, uint32_t cmd, void *arg)
             return YDEV_ERROR;
         }
         return YDEV_OK;
+    case YDEV_USART_IOCTL_SET_SEND_QUEUE:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        return yDev_Usart_TxQueueSetup(usart_handle, (const yDevUsartTxQueueConfig_t *)arg);
+    case YDEV_IOCTL_POLL:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        {
+            // 接收流有未读数据时可读；发送队列有空间或没有队列(轮询发送)时可写
+            uint32_t pos;
+            uint32_t head = usart_handle->tx_queue.head;
+            uint32_t tail = usart_handle->tx_queue.tail;
+            uint32_t state = 0;
+
+            if ((usart_handle->rx_stream.buffer != NULL) &&
+                (yDev_Usart_RxReceived(usart_handle, &pos) != usart_handle->rx_stream.consumed))
+            {
+                state |= YDEV_POLLIN;
+            }
+            if ((usart_handle->tx_queue.buffer == NULL) ||
+                (((head + 1U) % usart_handle->tx_queue.size) != tail))
+            {
+                state |= YDEV_POLLOUT;
+            }
+            *(uint32_t *)arg = state;
+        }
+        return YDEV_OK;
+    case YDEV_USART_IOCTL_GET_SEND_PENDING:
+        if ((arg == NULL) || (usart_handle->tx_queue.buffer == NULL))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        {
+            uint32_t head = usart_handle->tx_queue.head;
+            uint32_t tail = usart_handle->tx_queue.tail;
+            yDevUsartShared_t *shared = usart_handle->tx_queue.shared;
+            *(uint32_t *)arg = (head >= tail) ? (head - tail) : (usart_handle->tx_queue.size - tail + head);
+            if (shared != NULL)
+            {
+                *(uint32_t *)arg += shared->len;
+            }
+        }
+        return YDEV_OK;
+    case YDEV_USART_IOCTL_WRITE_SHARED:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        return yDev_Usart_TxQueueShared(usart_handle, (yDevUsartShared_t *)arg);
+    case YDEV_USART_IOCTL_SET_RECEIVE_STREAM:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        return yDev_Usart_RxStreamSetup(usart_handle, (const yDevUsartRxStreamConfig_t *)arg);
+    case YDEV_USART_IOCTL_GET_RECEIVE_OVERRUNS:
+        if ((arg == NULL) || (usart_handle->rx_stream.buffer == NULL))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = usart_handle->rx_stream.overruns;
+        return YDEV_OK;
+    case YDEV_USART_IOCTL_GET_RECEIVE_LOST:
+        if ((arg == NULL) || (usart_handle->rx_stream.buffer == NULL))
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = usart_handle->rx_stream.lost;
+        return YDEV_OK;
+    case YDEV_USART_IOCTL_SET_BAUD:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        // 发送队列中还有数据时修改波特率会让对端收到乱码
+        if (usart_handle->tx_queue.busy)
+        {
+            return YDEV_BUSY;
+        }
+        switch (yDrvUsartSetBaudRate(&usart_handle->drv_handle, *(uint32_t *)arg))
+        {
+        case YDRV_OK:
+            return YDEV_OK;
+        case YDRV_BUSY:
+            return YDEV_BUSY;
+        default:
+            return YDEV_INVALID_PARAM;
+        }
+    case YDEV_USART_IOCTL_GET_BAUD:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        *(uint32_t *)arg = yDrvUsartGetBaudRate(&usart_handle->drv_handle);
+        return YDEV_OK;
+    case YDEV_USART_IOCTL_AUTO_BAUD:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        return yDev_Usart_AutoBaud(usart_handle, (yDevUsartAutoBaud_t *)arg);
+    case YDEV_USART_IOCTL_GET_STATS:
+        if (arg == NULL)
+        {
+            return YDEV_INVALID_PARAM;
+        }
+        yDev_Usart_GetStats(usart_handle, (yDevUsartStats_t *)arg);
+        return YDEV_OK;
+    case YDEV_USART_IOCTL_RESET_STATS:
+        memset(&usart_handle->stats, 0, sizeof(usart_handle->stats));
+        usart_handle->rx_stream.overruns = 0;
+        usart_handle->rx_stream.lost = 0;
+        yDrvUsartResetErrorStats(&usart_handle->drv_handle);
+        return YDEV_OK;
     default:
         return YDEV_NOT_SUPPORTED;
     }
 }
 
-YDEV_OPS_EXPORT_EX(
-    YDEV_TYPE_USART,   // 设备类型
-    yDev_Usart_Init,   // 初始化函数
-    yDev_Usart_Deinit, // 反初始化函数
-    yDev_Usart_Read,   // 读取函数
-    yDev_Usart_Write,  // 写入函数
-    yDev_Usart_Ioctl)  // 控制函数
+/**
+ * @brief USART设备挂起
+ * @param handle USART设备句柄
+ * @return yDevStatus_t 操作状态
+ *
+ * @par 功能描述:
+ * 关闭USART时钟；配置了DMA接收流的串口随时可能收到数据，不能挂起
+ */
+static yDevStatus_t yDev_Usart_Suspend(void *handle)
+{
+    yDevHandle_Usart_t *usart_handle;
+
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    usart_handle = (yDevHandle_Usart_t *)handle;
+    if (usart_handle->rx_stream.buffer != NULL)
+    {
+        return YDEV_NOT_SUPPORTED;
+    }
+    if ((usart_handle->tx_queue.busy != 0) || (usart_handle->tx_queue.shared != NULL) ||
+        (usart_handle->tx_queue.head != usart_handle->tx_queue.tail))
+    {
+        return YDEV_BUSY;
+    }
+
+    return (yDrvUsartSuspend(&usart_handle->drv_handle) == YDRV_OK) ? YDEV_OK : YDEV_BUSY;
+}
+
+/**
+ * @brief USART设备恢复
+ * @param handle USART设备句柄
+ * @return yDevStatus_t 操作状态
+ */
+static yDevStatus_t yDev_Usart_Resume(void *handle)
+{
+    if (handle == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+
+    return (yDrvUsartResume(&((yDevHandle_Usart_t *)handle)->drv_handle) == YDRV_OK) ? YDEV_OK : YDEV_ERROR;
+}
+
+YDEV_OPS_EXPORT_PM(
+    YDEV_TYPE_USART,       // 设备类型
+    yDev_Usart_Init,       // 初始化函数
+    yDev_Usart_Deinit,     // 反初始化函数
+    yDev_Usart_Read,       // 读取函数
+    yDev_Usart_Write,      // 写入函数
+    yDev_Usart_Ioctl,      // 控制函数
+    yDev_Usart_ReadAsync,  // 异步读取函数
+    yDev_Usart_WriteAsync, // 异步写入函数
+    NULL,                  // 向量读取函数
+    yDev_Usart_Writev,     // 向量写入函数
+    yDev_Usart_Suspend,    // 挂起函数
+    yDev_Usart_Resume)     // 恢复函数
@@ -0,0 +1,264 @@
+/**
+ * @file yDev_waitq.c
+ * @brief 驱动等待队列实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 等待者节点在等待任务自己的栈上，入队、出队和唤醒标记在临界区内完成；
+ * 唤醒时先摘下节点再置woken，等待者结束时只在未被唤醒时自己出队，节点不会被摘两次
+ *
+ * @par 实现说明:
+ * - 通知在临界区内发出：退出临界区后等待者可能已超时返回，栈上的节点随即失效
+ * - 被唤醒后重新入队再检查条件，条件仍不满足时排到队尾，先到的等待者不会一直被后到的插队
+ * - 单个唤醒落在超时返回的等待者上时转交给下一个，不会因超时丢失
+ * - 残留的通知计数只造成一次提前返回，等待处循环检查条件
+ */
+
+// ==================== 包含文件 ====================
+#include "yDev_waitq.h"
+#include "yDrv_basic.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================== 私有类型定义 ====================
+
+/**
+ * @brief 等待者，位于等待任务的栈上
+ */
+typedef struct
+{
+    struct ylib_list_head node; /*!< 等待队列节点 */
+    TaskHandle_t task;          /*!< 等待任务 */
+    volatile uint8_t woken;     /*!< 已被唤醒并摘下 */
+} yDevWaiter_t;
+
+// ==================== 私有函数 ====================
+
+/**
+ * @brief 摘下并唤醒最早的等待者
+ * @param wq 等待队列指针
+ * @param hp 中断中调用时输出是否需要切换任务，任务中为NULL
+ * @retval 1 已唤醒，0 队列为空
+ * @note 在临界区内调用
+ */
+static uint32_t yDevWaitq_WakeFirst(yDevWaitQueue_t *wq, BaseType_t *hp)
+{
+    yDevWaiter_t *waiter;
+
+    if (ylib_list_empty(&wq->waiters))
+    {
+        return 0;
+    }
+
+    waiter = ylib_list_first_entry(&wq->waiters, yDevWaiter_t, node);
+    ylib_list_del_init(&waiter->node);
+    waiter->woken = 1;
+    if (hp != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR(waiter->task, YDEV_WAITQ_NOTIFY_INDEX, hp);
+    }
+    else
+    {
+        xTaskNotifyGiveIndexed(waiter->task, YDEV_WAITQ_NOTIFY_INDEX);
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 唤醒最多max个等待者
+ * @param wq 等待队列指针
+ * @param max 最多唤醒的数量
+ * @retval uint32_t 唤醒的数量
+ */
+static uint32_t yDevWaitq_Wake(yDevWaitQueue_t *wq, uint32_t max)
+{
+    BaseType_t hp = pdFALSE;
+    UBaseType_t mask;
+    uint32_t n = 0;
+
+    if (wq == NULL)
+    {
+        return 0;
+    }
+
+    if (__get_IPSR() != 0U)
+    {
+        mask = taskENTER_CRITICAL_FROM_ISR();
+        while ((n < max) && (yDevWaitq_WakeFirst(wq, &hp) != 0))
+        {
+            n++;
+        }
+        taskEXIT_CRITICAL_FROM_ISR(mask);
+        portYIELD_FROM_ISR(hp);
+    }
+    else
+    {
+        taskENTER_CRITICAL();
+        while ((n < max) && (yDevWaitq_WakeFirst(wq, NULL) != 0))
+        {
+            n++;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return n;
+}
+
+/**
+ * @brief 调度器启动前轮询条件
+ */
+static yDevStatus_t yDevWaitq_Poll(yDevWaitCond_t cond, void *arg, uint32_t timeOutMs)
+{
+    uint32_t start_time;
+
+    // 没有任务可唤醒，单纯等待唤醒无从满足
+    if (cond == NULL)
+    {
+        return YDEV_TIMEOUT;
+    }
+
+    start_time = (uint32_t)yDevGetTimeMS();
+    while (cond(arg) == 0)
+    {
+        if ((timeOutMs != 0) && (((uint32_t)yDevGetTimeMS() - start_time) >= timeOutMs))
+        {
+            return YDEV_TIMEOUT;
+        }
+    }
+
+    return YDEV_OK;
+}
+
+// ==================== 公共函数 ====================
+
+/**
+ * @brief 初始化等待队列实现
+ */
+void yDevWaitqInit(yDevWaitQueue_t *wq)
+{
+    if (wq == NULL)
+    {
+        return;
+    }
+
+    YLIB_INIT_LIST_HEAD(&wq->waiters);
+}
+
+/**
+ * @brief 等待条件满足实现
+ */
+yDevStatus_t yDevWaitqWait(yDevWaitQueue_t *wq, yDevWaitCond_t cond, void *arg, uint32_t timeOutMs)
+{
+    yDevWaiter_t waiter;
+    yDevStatus_t status = YDEV_OK;
+    TimeOut_t timeout;
+    TickType_t ticks;
+    uint8_t pass;
+
+    if (wq == NULL)
+    {
+        return YDEV_INVALID_PARAM;
+    }
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+    {
+        return yDevWaitq_Poll(cond, arg, timeOutMs);
+    }
+
+    waiter.task = xTaskGetCurrentTaskHandle();
+    waiter.woken = 0;
+    ticks = (timeOutMs == 0) ? portMAX_DELAY : (pdMS_TO_TICKS(timeOutMs) + 1U);
+    (void)ulTaskNotifyTakeIndexed(YDEV_WAITQ_NOTIFY_INDEX, pdTRUE, 0); // 清除上次等待残留的通知
+
+    // 先入队再检查条件，检查之后到达的唤醒由通知计数保留
+    taskENTER_CRITICAL();
+    ylib_list_add_tail(&waiter.node, &wq->waiters);
+    taskEXIT_CRITICAL();
+
+    vTaskSetTimeOutState(&timeout);
+    for (;;)
+    {
+        if (cond == NULL)
+        {
+            if (waiter.woken != 0)
+            {
+                break;
+            }
+        }
+        else if (cond(arg) != 0)
+        {
+            break;
+        }
+        if (xTaskCheckForTimeOut(&timeout, &ticks) != pdFALSE)
+        {
+            status = YDEV_TIMEOUT;
+            break;
+        }
+        (void)ulTaskNotifyTakeIndexed(YDEV_WAITQ_NOTIFY_INDEX, pdTRUE, ticks);
+
+        // 条件等待被唤醒后排回队尾，再检查条件
+        if ((cond != NULL) && (waiter.woken != 0))
+        {
+            taskENTER_CRITICAL();
+            waiter.woken = 0;
+            ylib_list_add_tail(&waiter.node, &wq->waiters);
+            taskEXIT_CRITICAL();
+        }
+    }
+
+    // 超时与唤醒竞争时以woken为准
+    pass = 0;
+    taskENTER_CRITICAL();
+    if (waiter.woken == 0)
+    {
+        ylib_list_del(&waiter.node);
+    }
+    else if (cond == NULL)
+    {
+        status = YDEV_OK;
+    }
+    else if (status != YDEV_OK)
+    {
+        pass = 1;
+    }
+    taskEXIT_CRITICAL();
+
+    if (pass != 0)
+    {
+        (void)yDevWaitqWakeOne(wq);
+    }
+
+    return status;
+}
+
+/**
+ * @brief 唤醒最早到达的一个等待者实现
+ */
+uint32_t yDevWaitqWakeOne(yDevWaitQueue_t *wq)
+{
+    return yDevWaitq_Wake(wq, 1);
+}
+
+/**
+ * @brief 唤醒全部等待者实现
+ */
+uint32_t yDevWaitqWakeAll(yDevWaitQueue_t *wq)
+{
+    return yDevWaitq_Wake(wq, UINT32_MAX);
+}
+
+/**
+ * @brief 是否有任务在等待实现
+ */
+uint8_t yDevWaitqActive(yDevWaitQueue_t *wq)
+{
+    if (wq == NULL)
+    {
+        return 0;
+    }
+
+    return ylib_list_empty(&wq->waiters) ? 0 : 1;
+}
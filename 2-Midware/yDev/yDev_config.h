@@ -6,4 +6,203 @@
 #define YDEV_MALLOC(size) pvPortMalloc(size)
 #define YDEV_FREE(ptr) vPortFree(ptr)
 
-#endif // YDEV_CONFIG_H
\ No newline at end of file
+/* ===== yDev核心 (yDev) ===== */
+#ifndef YDEV_USE_MUTEX
+#define YDEV_USE_MUTEX (1) /* 支持句柄互斥锁，配置use_mutex的句柄在读写和控制时加锁，0=不编译 */
+#endif
+
+#ifndef YDEV_MUTEX_MAX
+#define YDEV_MUTEX_MAX (4) /* 配置use_mutex的句柄数上限，互斥锁控制块静态分配，每个约80字节 */
+#endif
+
+#ifndef YDEV_REGISTRY_MAX
+#define YDEV_REGISTRY_MAX (8) /* 设备注册表最大条目数，每条8字节 */
+#endif
+
+#ifndef YDEV_STATS_ENABLE
+#define YDEV_STATS_ENABLE (1) /* 句柄读写和控制的次数、字节数、错误数和耗时统计，每个句柄72字节，0=不编译 */
+#endif
+
+#ifndef YDEV_PM_ACCOUNT
+#define YDEV_PM_ACCOUNT (1) /* 设备唤醒时长和次数、CPU睡眠和STOP时长统计，每个句柄16字节，0=不编译 */
+#endif
+
+#ifndef YDEV_CLOCK_IDLE_LEVEL
+#define YDEV_CLOCK_IDLE_LEVEL (0) /* 没有任务请求时的系统时钟等级(yDrvClockLevel_t)，0=保持64MHz */
+#endif
+
+#ifndef YDEV_INIT_MAX
+#define YDEV_INIT_MAX (16) /* 记录耗时的初始化表项数(YDEV_INIT_EXPORT)，每项8字节，超出的照常执行 */
+#endif
+
+#ifndef YDEV_PBUF_IOV_MAX
+#define YDEV_PBUF_IOV_MAX (8) /* yDevWritePbuf一次交给writev的段数，在栈上占8字节每段，更长的链分批写入 */
+#endif
+
+/* ===== GPIO消抖服务 (yDev_debounce) ===== */
+#ifndef YDEV_DEBOUNCE_MAX
+#define YDEV_DEBOUNCE_MAX (8) /* 消抖服务最多管理的引脚数 */
+#endif
+
+#ifndef YDEV_DEBOUNCE_RING_SIZE
+#define YDEV_DEBOUNCE_RING_SIZE (32) /* 中断边沿记录缓冲区条数(2的幂)，可存放SIZE-1条，每条8字节 */
+#endif
+
+#ifndef YDEV_DEBOUNCE_QUEUE_LEN
+#define YDEV_DEBOUNCE_QUEUE_LEN (8) /* 消抖事件队列深度 */
+#endif
+
+#ifndef YDEV_DEBOUNCE_TICK_MS
+#define YDEV_DEBOUNCE_TICK_MS (5) /* 消抖定时器周期(毫秒)，事件上报延迟不超过消抖时间加一个周期 */
+#endif
+
+/* ===== 25Q Flash设备 (yDev_25q) ===== */
+#ifndef YDEV_25Q_DMA_THRESHOLD
+#define YDEV_25Q_DMA_THRESHOLD (32) /* 读取长度不小于该值时走DMA，较短读取仍用轮询 */
+#endif
+
+#ifndef YDEV_25Q_DMA_IRQ_PRIO
+#define YDEV_25Q_DMA_IRQ_PRIO YDRV_IRQ_PRIO_SPI /* SPI接收DMA完成中断优先级 */
+#endif
+
+#ifndef YDEV_25Q_IRQ_THRESHOLD
+#define YDEV_25Q_IRQ_THRESHOLD (8) /* 传输长度不小于该值且调度器运行时走SPI中断，更短的命令字节仍用轮询 */
+#endif
+
+#ifndef YDEV_25Q_SPI_IRQ_PRIO
+#define YDEV_25Q_SPI_IRQ_PRIO YDRV_IRQ_PRIO_SPI /* SPI中断传输优先级 */
+#endif
+
+#ifndef YDEV_25Q_ASYNC_POLL_MS
+#define YDEV_25Q_ASYNC_POLL_MS (1) /* 异步写入BUSY轮询周期(毫秒)，典型页编程约0.7ms */
+#endif
+
+#ifndef YDEV_25Q_BG_ERASE_ENABLE
+#define YDEV_25Q_BG_ERASE_ENABLE (1) /* 使能后台擦除，独占SPI时由器件自己的作业调度器管理总线 */
+#endif
+
+#ifndef YDEV_25Q_ERASE_TASK_PRIO
+#define YDEV_25Q_ERASE_TASK_PRIO (1) /* 后台擦除/异步读取工作任务优先级 */
+#endif
+
+#ifndef YDEV_25Q_ERASE_TASK_STACK
+#define YDEV_25Q_ERASE_TASK_STACK (192) /* 后台擦除/异步读取工作任务堆栈大小(字)，异步读取经缓存和DMA路径 */
+#endif
+
+#ifndef YDEV_25Q_MAX
+#define YDEV_25Q_MAX (1) /* 25Q设备实例数上限，后台任务堆栈、锁和异步定时器按实例静态分配 */
+#endif
+
+#ifndef YDEV_25Q_ERASE_POLL_MS
+#define YDEV_25Q_ERASE_POLL_MS (5) /* 后台擦除BUSY轮询周期(毫秒) */
+#endif
+
+#ifndef YDEV_25Q_SPI_STATS
+#define YDEV_25Q_SPI_STATS (1) /* SPI传输统计和耗时直方图，0=不编译 */
+#endif
+
+#ifndef YDEV_25Q_TUNE_ROUNDS
+#define YDEV_25Q_TUNE_ROUNDS (8) /* SPI时钟校准时每个速率等级的校验轮数 */
+#endif
+
+#ifndef YDEV_25Q_TUNE_SIZE
+#define YDEV_25Q_TUNE_SIZE (64) /* SPI时钟校准每轮读取比对的数据字节数 */
+#endif
+
+#ifndef YDEV_25Q_IOV_MAX
+#define YDEV_25Q_IOV_MAX (8) /* 向量读取单次片选内的最大分段数，超过时逐段读取 */
+#endif
+
+#ifndef YDEV_25Q_CACHE_POOL_LINES
+#define YDEV_25Q_CACHE_POOL_LINES (4) /* 读缓存共享内存分区行数(每行一页)，0=不编译读缓存 */
+#endif
+
+/* ===== DMA内存拷贝 (yDev_dma) ===== */
+#ifndef YDEV_DMA_CROSSOVER_DEFAULT
+#define YDEV_DMA_CROSSOVER_DEFAULT (64) /* 无法实测时的CPU/DMA交叉点字节数 */
+#endif
+
+#ifndef YDEV_DMA_CALIB_MIN
+#define YDEV_DMA_CALIB_MIN (16) /* 交叉点实测起始长度(字节，4的倍数) */
+#endif
+
+#ifndef YDEV_DMA_CALIB_MAX
+#define YDEV_DMA_CALIB_MAX (512) /* 交叉点实测最大长度(字节)，实测时临时分配两倍大小的缓冲区 */
+#endif
+
+/* ===== 总线作业调度 (yDev_busjob) ===== */
+#ifndef YDEV_BUSJOB_QUEUE_MAX
+#define YDEV_BUSJOB_QUEUE_MAX (8) /* 每条总线同时等待的作业数上限，即同时访问总线的任务数 */
+#endif
+
+#ifndef YDEV_BUSJOB_NOTIFY_INDEX
+#define YDEV_BUSJOB_NOTIFY_INDEX (1) /* 等待总线和抢占请求使用的任务通知索引，须小于configTASK_NOTIFICATION_ARRAY_ENTRIES */
+#endif
+
+#ifndef YDEV_BUSJOB_NAME_LEN
+#define YDEV_BUSJOB_NAME_LEN (8) /* 统计中保存的持有者任务名长度(含结尾0) */
+#endif
+
+#ifndef YDEV_BUSJOB_DEADLINE_URGENT_MS
+#define YDEV_BUSJOB_DEADLINE_URGENT_MS (5) /* 紧急作业默认相对截止时间(毫秒) */
+#endif
+
+#ifndef YDEV_BUSJOB_DEADLINE_READ_MS
+#define YDEV_BUSJOB_DEADLINE_READ_MS (20) /* 读取作业默认相对截止时间(毫秒) */
+#endif
+
+#ifndef YDEV_BUSJOB_DEADLINE_WRITE_MS
+#define YDEV_BUSJOB_DEADLINE_WRITE_MS (100) /* 写入作业默认相对截止时间(毫秒) */
+#endif
+
+#ifndef YDEV_BUSJOB_DEADLINE_ERASE_MS
+#define YDEV_BUSJOB_DEADLINE_ERASE_MS (500) /* 同步擦除作业默认相对截止时间(毫秒) */
+#endif
+
+#ifndef YDEV_BUSJOB_DEADLINE_BACKGROUND_MS
+#define YDEV_BUSJOB_DEADLINE_BACKGROUND_MS (5000) /* 后台作业默认相对截止时间(毫秒) */
+#endif
+
+/* ===== 等待队列 (yDev_waitq) ===== */
+#ifndef YDEV_WAITQ_NOTIFY_INDEX
+#define YDEV_WAITQ_NOTIFY_INDEX (3) /* 等待队列使用的任务通知索引，须小于configTASK_NOTIFICATION_ARRAY_ENTRIES */
+#endif
+
+/* ===== 串口 (yDev_usart) ===== */
+#ifndef YDEV_USART_TX_NOTIFY_INDEX
+#define YDEV_USART_TX_NOTIFY_INDEX (4) /* 发送队列等待空间使用的任务通知索引，与调用任务自己的接收通知分开 */
+#endif
+
+/* ===== 共享SPI总线 (yDev_spibus) ===== */
+
+#ifndef YDEV_SPIBUS_IRQ_THRESHOLD
+#define YDEV_SPIBUS_IRQ_THRESHOLD (8) /* 总线传输长度不小于该值时走SPI中断 */
+#endif
+
+#ifndef YDEV_SPIBUS_DMA_THRESHOLD
+#define YDEV_SPIBUS_DMA_THRESHOLD (32) /* 总线传输长度不小于该值时走DMA */
+#endif
+
+#ifndef YDEV_SPIBUS_IRQ_PRIO
+#define YDEV_SPIBUS_IRQ_PRIO YDRV_IRQ_PRIO_SPI /* 总线SPI中断与DMA中断优先级 */
+#endif
+
+/* ===== 片内Flash数据区 (yDev_iflash) ===== */
+
+#ifndef YDEV_IFLASH_MAX
+#define YDEV_IFLASH_MAX (1) /* 片内Flash设备实例数上限，后台擦除任务堆栈按实例静态分配 */
+#endif
+
+#ifndef YDEV_IFLASH_ERASE_TASK_PRIO
+#define YDEV_IFLASH_ERASE_TASK_PRIO (1) /* 后台擦除任务优先级，只在更高优先级任务都阻塞时擦除 */
+#endif
+
+#ifndef YDEV_IFLASH_ERASE_TASK_STACK
+#define YDEV_IFLASH_ERASE_TASK_STACK (128) /* 后台擦除任务堆栈大小(字) */
+#endif
+
+#ifndef YDEV_IFLASH_ERASE_GAP_MS
+#define YDEV_IFLASH_ERASE_GAP_MS (5) /* 后台擦除相邻两页之间的间隔(毫秒)，让Flash中的代码追上积压的工作 */
+#endif
+
+#endif // YDEV_CONFIG_H
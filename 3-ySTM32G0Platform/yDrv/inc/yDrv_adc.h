@@ -0,0 +1,305 @@
+/**
+ * @file yDrv_adc.h
+ * @brief STM32G0 ADC流式采样驱动程序头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 提供STM32G0系列MCU ADC多通道扫描、硬件过采样和DMA双缓冲流式采样接口
+ *
+ * @par 主要特性:
+ * - 可编程序列(CHSELRMOD=1)，最多8个通道按任意顺序扫描
+ * - 硬件过采样2~256倍，右移0~8位，结果最宽16位
+ * - 定时器TRGO触发整条序列，TIM6由驱动按帧率配置，TIM1/TIM3/TIM15由对应定时器设备提供
+ * - 循环DMA写入双缓冲区，半传输/传输完成中断交付前半/后半块，采样全程不需要CPU
+ * - 溢出后自动重启序列，保证缓冲区内各通道排列不错位
+ *
+ * @par 速率估算:
+ * ADC时钟取PCLK/2(64MHz系统时钟下为32MHz)，12位采样时间1.5周期时每次转换14周期，
+ * 约2.28MSPS；输出采样率 = 帧率 × 通道数，过采样时每个输出占用ratio次转换
+ *
+ * @note 芯片只有一个ADC，同一时刻只能有一个句柄
+ * @note 固件库未包含ADC的LL/HAL驱动，寄存器直接按参考手册访问
+ */
+
+#ifndef YDRV_ADC_H
+#define YDRV_ADC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "stm32g0xx_ll_tim.h"
+#include "stm32g0xx_ll_bus.h"
+
+#include "yDrv_basic.h"
+#include "yDrv_dma.h"
+
+    // ==================== ADC配置枚举 ====================
+
+/**
+ * @brief 序列最大通道数
+ */
+#define YDRV_ADC_SEQ_MAX (8U)
+
+/**
+ * @brief 可编程序列支持的最大通道号
+ * @note 通道12/13/14分别为温度传感器、内部参考电压和VBAT/3
+ */
+#define YDRV_ADC_CHANNEL_MAX (14U)
+
+    /**
+     * @brief ADC分辨率枚举
+     */
+    typedef enum
+    {
+        YDRV_ADC_RES_12BIT = 0, /*!< 12位，转换12.5周期 */
+        YDRV_ADC_RES_10BIT,     /*!< 10位，转换10.5周期 */
+        YDRV_ADC_RES_8BIT,      /*!< 8位，转换8.5周期 */
+        YDRV_ADC_RES_6BIT,      /*!< 6位，转换6.5周期 */
+    } yDrvAdcResolution_t;
+
+    /**
+     * @brief 采样时间枚举(ADC时钟周期)
+     */
+    typedef enum
+    {
+        YDRV_ADC_SMP_1_5 = 0, /*!< 1.5周期 */
+        YDRV_ADC_SMP_3_5,     /*!< 3.5周期 */
+        YDRV_ADC_SMP_7_5,     /*!< 7.5周期 */
+        YDRV_ADC_SMP_12_5,    /*!< 12.5周期 */
+        YDRV_ADC_SMP_19_5,    /*!< 19.5周期 */
+        YDRV_ADC_SMP_39_5,    /*!< 39.5周期 */
+        YDRV_ADC_SMP_79_5,    /*!< 79.5周期 */
+        YDRV_ADC_SMP_160_5,   /*!< 160.5周期，内部通道建议使用 */
+    } yDrvAdcSampleTime_t;
+
+    /**
+     * @brief 过采样倍数枚举
+     */
+    typedef enum
+    {
+        YDRV_ADC_OVS_NONE = 0, /*!< 不过采样 */
+        YDRV_ADC_OVS_2,        /*!< 2倍 */
+        YDRV_ADC_OVS_4,        /*!< 4倍 */
+        YDRV_ADC_OVS_8,        /*!< 8倍 */
+        YDRV_ADC_OVS_16,       /*!< 16倍 */
+        YDRV_ADC_OVS_32,       /*!< 32倍 */
+        YDRV_ADC_OVS_64,       /*!< 64倍 */
+        YDRV_ADC_OVS_128,      /*!< 128倍 */
+        YDRV_ADC_OVS_256,      /*!< 256倍 */
+    } yDrvAdcOversample_t;
+
+    /**
+     * @brief 序列触发源枚举
+     * @note 每个触发事件转换整条序列，过采样时每个通道连续转换ratio次
+     */
+    typedef enum
+    {
+        YDRV_ADC_TRIG_TIM6 = 0,   /*!< TIM6_TRGO，由驱动按frameHz配置并启停 */
+        YDRV_ADC_TRIG_TIM1_TRGO2, /*!< TIM1_TRGO2，定时器由用户启动 */
+        YDRV_ADC_TRIG_TIM3,       /*!< TIM3_TRGO，定时器由用户启动 */
+        YDRV_ADC_TRIG_TIM15,      /*!< TIM15_TRGO，定时器由用户启动 */
+        YDRV_ADC_TRIG_CONTINUOUS, /*!< 连续转换，以ADC最高速率运行 */
+    } yDrvAdcTrigger_t;
+
+    /**
+     * @brief ADC事件枚举
+     */
+    typedef enum
+    {
+        YDRV_ADC_EVENT_BLOCK = 0, /*!< 半个缓冲区已写满，block/len有效 */
+        YDRV_ADC_EVENT_OVERRUN,   /*!< 转换溢出，序列已从缓冲区开头重新开始 */
+        YDRV_ADC_EVENT_ERROR,     /*!< DMA传输错误，采样已停止 */
+    } yDrvAdcEvent_t;
+
+    /**
+     * @brief ADC事件回调函数类型
+     * @param arg 注册时传入的参数
+     * @param event 事件类型
+     * @param block 已写满的半块首地址，按序列顺序逐帧排列，仅BLOCK事件有效
+     * @param len 半块中的半字数，仅BLOCK事件有效
+     * @note 在中断上下文中调用；下一个半块写满前必须处理完，否则数据被覆盖
+     */
+    typedef void (*yDrvAdcCallback_t)(void *arg, yDrvAdcEvent_t event, const uint16_t *block, uint32_t len);
+
+    // ==================== ADC配置和句柄结构体 ====================
+
+    /**
+     * @brief ADC配置结构体
+     */
+    typedef struct
+    {
+        uint8_t channels[YDRV_ADC_SEQ_MAX]; /*!< 扫描序列，通道号0~14 */
+        uint8_t channelNum;                 /*!< 序列通道数(1~8) */
+        yDrvAdcResolution_t resolution;     /*!< 分辨率 */
+        yDrvAdcSampleTime_t sampleTime;     /*!< 采样时间，所有通道相同 */
+        yDrvAdcOversample_t oversample;     /*!< 过采样倍数 */
+        uint8_t oversampleShift;            /*!< 过采样结果右移位数(0~8)，结果不得超过16位 */
+        yDrvAdcTrigger_t trigger;           /*!< 触发源 */
+        uint32_t frameHz;                   /*!< TIM6触发时的序列频率(Hz)，其他触发源忽略 */
+        uint16_t *buffer;                   /*!< 循环缓冲区，运行期间必须保持有效 */
+        uint32_t bufferLen;                 /*!< 缓冲区半字数，须为2×channelNum的整数倍且不超过65535 */
+        yDrvDmaChannel_t dmaChannel;        /*!< DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配 */
+        yDrvDmaPriority_t dmaPriority;      /*!< DMA通道优先级 */
+        uint32_t prio;                      /*!< DMA和ADC溢出中断优先级 */
+        yDrvAdcCallback_t callback;         /*!< 事件回调，NULL表示不开DMA中断 */
+        void *arg;                          /*!< 回调参数 */
+    } yDrvAdcConfig_t;
+
+    /**
+     * @brief ADC句柄结构体
+     */
+    typedef struct
+    {
+        ADC_TypeDef *instance;         /*!< ADC寄存器指针，NULL表示未初始化 */
+        uint16_t *buffer;              /*!< 循环缓冲区 */
+        uint32_t bufferLen;            /*!< 缓冲区半字数 */
+        uint32_t frameHz;              /*!< TIM6实际序列频率(Hz)，其他触发源为0 */
+        yDrvDmaHandle_t dma;           /*!< DMA通道句柄 */
+        yDrvDmaChannel_t dmaChannel;   /*!< DMA通道配置 */
+        yDrvDmaPriority_t dmaPriority; /*!< DMA通道优先级 */
+        uint32_t prio;                 /*!< 中断优先级 */
+        yDrvAdcCallback_t callback;    /*!< 事件回调 */
+        void *arg;                     /*!< 回调参数 */
+        volatile uint32_t blocks;      /*!< 已交付的半块数 */
+        volatile uint32_t overruns;    /*!< 溢出重启次数 */
+        uint8_t channelNum;            /*!< 序列通道数 */
+        uint8_t trigger;               /*!< 触发源 yDrvAdcTrigger_t */
+        volatile uint8_t running;      /*!< 采样进行中标志 */
+    } yDrvAdcHandle_t;
+
+// ==================== ADC初始化宏定义 ====================
+
+/**
+ * @brief ADC配置结构体默认初始化宏
+ * @note 默认单通道0，12位，不过采样，TIM6触发10kHz
+ */
+#define YDRV_ADC_CONFIG_DEFAULT()                   \
+    ((yDrvAdcConfig_t){                             \
+        .channels = {0},                            \
+        .channelNum = 1,                            \
+        .resolution = YDRV_ADC_RES_12BIT,           \
+        .sampleTime = YDRV_ADC_SMP_12_5,            \
+        .oversample = YDRV_ADC_OVS_NONE,            \
+        .oversampleShift = 0,                       \
+        .trigger = YDRV_ADC_TRIG_TIM6,              \
+        .frameHz = 10000U,                          \
+        .buffer = NULL,                             \
+        .bufferLen = 0,                             \
+        .dmaChannel = YDRV_DMA_CHANNEL_AUTO,        \
+        .dmaPriority = YDRV_DMA_PRIORITY_HIGH,      \
+        .prio = 2,                                  \
+        .callback = NULL,                           \
+        .arg = NULL,                                \
+    })
+
+/**
+ * @brief ADC句柄结构体默认初始化宏
+ */
+#define YDRV_ADC_HANDLE_DEFAULT()              \
+    ((yDrvAdcHandle_t){                        \
+        .instance = NULL,                      \
+        .buffer = NULL,                        \
+        .bufferLen = 0,                        \
+        .frameHz = 0,                          \
+        .dma = YDRV_DMA_HANDLE_DEFAULT(),      \
+        .dmaChannel = YDRV_DMA_CHANNEL_AUTO,   \
+        .dmaPriority = YDRV_DMA_PRIORITY_HIGH, \
+        .prio = 0,                             \
+        .callback = NULL,                      \
+        .arg = NULL,                           \
+        .blocks = 0,                           \
+        .overruns = 0,                         \
+        .channelNum = 0,                       \
+        .trigger = YDRV_ADC_TRIG_TIM6,         \
+        .running = 0,                          \
+    })
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 初始化ADC
+     * @param config 配置参数指针
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 初始化状态
+     *         - YDRV_OK: 已校准并使能，尚未开始采样
+     *         - YDRV_BUSY: ADC已被其他句柄使用
+     *         - YDRV_INVALID_PARAM: 序列、过采样位宽、缓冲区长度或帧率无效
+     *         - YDRV_ERROR: 校准、使能或序列配置超时
+     * @note 外部通道引脚复位后即为模拟模式，被改作他用的引脚须由调用者恢复
+     */
+    yDrvStatus_t yDrvAdcInitStatic(const yDrvAdcConfig_t *config, yDrvAdcHandle_t *handle);
+
+    /**
+     * @brief 反初始化ADC
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 反初始化状态
+     * @note 停止采样，关闭ADC、稳压器和TIM6时钟
+     */
+    yDrvStatus_t yDrvAdcDeInitStatic(yDrvAdcHandle_t *handle);
+
+    /**
+     * @brief 初始化ADC配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDrvAdcConfigStructInit(yDrvAdcConfig_t *config);
+
+    /**
+     * @brief 初始化ADC句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDrvAdcHandleStructInit(yDrvAdcHandle_t *handle);
+
+    /**
+     * @brief 启动流式采样
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     *         - YDRV_OK: 已启动
+     *         - YDRV_BUSY: 已在运行或DMA通道不可用
+     * @note 从缓冲区开头写入；TIM6触发时同时启动TIM6，其他定时器只设置TRGO为更新事件
+     */
+    yDrvStatus_t yDrvAdcStart(yDrvAdcHandle_t *handle);
+
+    /**
+     * @brief 停止流式采样
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     * @note 停止触发和转换并释放DMA通道
+     */
+    yDrvStatus_t yDrvAdcStop(yDrvAdcHandle_t *handle);
+
+    /**
+     * @brief 读取最近一帧完整的序列结果
+     * @param handle 句柄指针
+     * @param frame 输出缓冲区，至少channelNum个半字
+     * @retval yDrvStatus_t 操作状态
+     *         - YDRV_OK: 读取成功
+     *         - YDRV_BUSY: 启动后尚无完整的一帧
+     *         - YDRV_NOT_INITIALIZED: 未在采样
+     * @note 只读DMA剩余计数和缓冲区，不需要中断
+     */
+    yDrvStatus_t yDrvAdcReadFrame(yDrvAdcHandle_t *handle, uint16_t *frame);
+
+    // ==================== 内联函数 ====================
+
+    /**
+     * @brief 获取半块长度
+     * @param handle 句柄指针
+     * @retval uint32_t 每次BLOCK事件交付的半字数
+     */
+    YLIB_INLINE uint32_t yDrvAdcGetBlockLen(yDrvAdcHandle_t *handle)
+    {
+        return handle->bufferLen / 2U;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_ADC_H */
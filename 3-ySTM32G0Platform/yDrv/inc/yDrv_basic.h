@@ -210,6 +210,85 @@ extern "C"
         uint8_t flag;              /*!< 保留标志位，用于扩展功能 */
     } yDrvGpioInfo_t;
 
+    /**
+     * @brief 复用功能编号：按外设信号从引脚复用表中选择
+     */
+#define YDRV_GPIO_AF_AUTO (0xFFU)
+
+    /**
+     * @brief yDrvGpioSetupPins单次最多配置的引脚数
+     */
+#ifndef YDRV_GPIO_SETUP_MAX
+#define YDRV_GPIO_SETUP_MAX (8U)
+#endif
+
+    /**
+     * @brief 引脚复用的外设信号
+     * @note 同类外设按实例顺序排列，驱动以"实例号*每实例信号数"偏移取得本实例的信号
+     */
+    typedef enum
+    {
+        YDRV_GPIO_SIG_SPI1_SCK = 0, /*!< SPI1信号，每实例4个：SCK/MISO/MOSI/NSS */
+        YDRV_GPIO_SIG_SPI1_MISO,
+        YDRV_GPIO_SIG_SPI1_MOSI,
+        YDRV_GPIO_SIG_SPI1_NSS,
+        YDRV_GPIO_SIG_SPI2_SCK,
+        YDRV_GPIO_SIG_SPI2_MISO,
+        YDRV_GPIO_SIG_SPI2_MOSI,
+        YDRV_GPIO_SIG_SPI2_NSS,
+        YDRV_GPIO_SIG_USART1_TX,    /*!< USART1信号，每实例4个：TX/RX/RTS_DE/CTS */
+        YDRV_GPIO_SIG_USART1_RX,
+        YDRV_GPIO_SIG_USART1_RTS_DE,
+        YDRV_GPIO_SIG_USART1_CTS,
+        YDRV_GPIO_SIG_USART2_TX,
+        YDRV_GPIO_SIG_USART2_RX,
+        YDRV_GPIO_SIG_USART2_RTS_DE,
+        YDRV_GPIO_SIG_USART2_CTS,
+        YDRV_GPIO_SIG_USART3_TX,
+        YDRV_GPIO_SIG_USART3_RX,
+        YDRV_GPIO_SIG_USART3_RTS_DE,
+        YDRV_GPIO_SIG_USART3_CTS,
+        YDRV_GPIO_SIG_USART4_TX,
+        YDRV_GPIO_SIG_USART4_RX,
+        YDRV_GPIO_SIG_USART4_RTS_DE,
+        YDRV_GPIO_SIG_USART4_CTS,
+        YDRV_GPIO_SIG_I2C1_SCL,     /*!< I2C1信号，每实例2个：SCL/SDA */
+        YDRV_GPIO_SIG_I2C1_SDA,
+        YDRV_GPIO_SIG_I2C2_SCL,
+        YDRV_GPIO_SIG_I2C2_SDA,
+        YDRV_GPIO_SIG_TIM1_CH1,     /*!< TIM1通道1~4 */
+        YDRV_GPIO_SIG_TIM1_CH2,
+        YDRV_GPIO_SIG_TIM1_CH3,
+        YDRV_GPIO_SIG_TIM1_CH4,
+        YDRV_GPIO_SIG_TIM3_CH1,     /*!< TIM3通道1~4 */
+        YDRV_GPIO_SIG_TIM3_CH2,
+        YDRV_GPIO_SIG_TIM3_CH3,
+        YDRV_GPIO_SIG_TIM3_CH4,
+        YDRV_GPIO_SIG_TIM14_CH1,
+        YDRV_GPIO_SIG_TIM15_CH1,
+        YDRV_GPIO_SIG_TIM15_CH2,
+        YDRV_GPIO_SIG_TIM16_CH1,
+        YDRV_GPIO_SIG_TIM17_CH1,
+        YDRV_GPIO_SIG_MAX,          /*!< 信号数量 */
+    } yDrvGpioSignal_t;
+
+    /**
+     * @brief 批量引脚配置项
+     * @note 取值与LL_GPIO_InitTypeDef相同的LL宏
+     */
+    typedef struct
+    {
+        yDrvGpioPin_t pin;    /*!< 引脚 */
+        uint8_t mode;         /*!< LL_GPIO_MODE_xxx */
+        uint8_t speed;        /*!< LL_GPIO_SPEED_FREQ_xxx */
+        uint8_t outputType;   /*!< LL_GPIO_OUTPUT_xxx */
+        uint8_t pull;         /*!< LL_GPIO_PULL_xxx */
+        uint8_t af;           /*!< 复用功能编号，YDRV_GPIO_AF_AUTO按signal查表 */
+        uint8_t signal;       /*!< 外设信号(yDrvGpioSignal_t)，af为YDRV_GPIO_AF_AUTO时使用 */
+        uint8_t preset;       /*!< 切换模式前预置的输出电平：0=不改变，1=低，2=高 */
+        yDrvGpioInfo_t *info; /*!< 输出解析结果并置flag=1，可为NULL */
+    } yDrvGpioPinSetup_t;
+
     /**
      * @brief DMA通道枚举
      */
@@ -222,7 +301,8 @@ extern "C"
         YDRV_DMA1_CHANNEL5,
         YDRV_DMA1_CHANNEL6,
         YDRV_DMA1_CHANNEL7,
-        YDRV_DMA_CHANNEL_MAX
+        YDRV_DMA_CHANNEL_MAX,
+        YDRV_DMA_CHANNEL_AUTO /*!< 由yDrvDmaInitStatic按优先级分配空闲通道 */
     } yDrvDmaChannel_t;
 
     /**
@@ -280,6 +360,27 @@ extern "C"
      */
     int32_t yDrvIsGpioValid(yDrvGpioPin_t index);
 
+    /**
+     * @brief 查询引脚上外设信号的复用功能编号
+     * @param pin 引脚
+     * @param signal 外设信号
+     * @param af 输出复用功能编号
+     * @retval yDrvStatus_t 查询状态，该引脚不能复用为该信号时返回YDRV_INVALID_PARAM
+     * @note 复用表为Flash中的常量表
+     */
+    yDrvStatus_t yDrvGpioAfLookup(yDrvGpioPin_t pin, yDrvGpioSignal_t signal, uint32_t *af);
+
+    /**
+     * @brief 批量配置引脚
+     * @param setup 配置项数组
+     * @param count 配置项个数
+     * @retval yDrvStatus_t 配置状态，任一引脚无效或复用查表失败时不写任何寄存器
+     * @note 先解析全部引脚，再按端口合并，每个端口的OSPEEDR/OTYPER/PUPDR/AFR/MODER各写一次，
+     *       MODER最后写入，引脚切换时复用功能和输出电平已就绪；与LL_GPIO_Init相同，
+     *       不防护中断中对同一端口配置寄存器的并发修改
+     */
+    yDrvStatus_t yDrvGpioSetupPins(const yDrvGpioPinSetup_t *setup, uint32_t count);
+
     // ==================== DMA解析函数 ====================
 
     /**
@@ -330,6 +431,266 @@ extern "C"
      */
     yDrvStatus_t yDrvInit(void);
 
+    // ==================== 中断向量函数 ====================
+
+    /**
+     * @brief 中断向量表复制到SRAM
+     * @note 置1时yDrvInit把Flash中的向量表复制到SRAM(链接脚本.ram_vector段)并切换VTOR，
+     *       之后驱动可以在运行时替换外设中断入口；占用184字节RAM
+     */
+#ifndef YDRV_VECTOR_RAM
+#define YDRV_VECTOR_RAM 1
+#endif
+
+    /**
+     * @brief 中断入口函数类型
+     */
+    typedef void (*yDrvIrqHandler_t)(void);
+
+    /**
+     * @brief 替换外设中断入口
+     * @param irq 外设中断号
+     * @param handler 新的入口函数
+     * @retval 原来的入口函数，向量表不在SRAM或中断号无效时返回NULL且不替换
+     * @note 一次字写入完成替换，中断可以保持使能；下一次进入该中断即使用新入口
+     */
+    yDrvIrqHandler_t yDrvIrqSetHandler(IRQn_Type irq, yDrvIrqHandler_t handler);
+
+    // ==================== 中断优先级 ====================
+
+    /**
+     * @brief 中断优先级等级，按延迟要求划分
+     * @note G0只有2位优先级，0最高3最低；M0+上FreeRTOS临界区关闭全部中断，各等级都可以调用FromISR接口。
+     *       同一等级互不抢占，新增中断时按能容忍的延迟选择等级，不直接写数字
+     */
+#define YDRV_IRQ_LEVEL_CRITICAL (0U) /* 延迟即丢数据：串口接收 */
+#define YDRV_IRQ_LEVEL_EVENT (1U)    /* 外部事件边沿：按键、SPI从机片选 */
+#define YDRV_IRQ_LEVEL_TRANSFER (2U) /* 传输完成：DMA、SPI、I2C、串口发送 */
+#define YDRV_IRQ_LEVEL_SYSTEM (3U)   /* 时基和RTC唤醒，与内核PendSV/SysTick同级 */
+
+    /**
+     * @brief 各中断源的优先级分配表
+     * @note 可在编译选项中逐项覆盖；共享中断线(DMA1_Ch2_3、EXTI4_15等)取其上所有中断源中最高的等级
+     */
+#ifndef YDRV_IRQ_PRIO_UART_RX
+#define YDRV_IRQ_PRIO_UART_RX YDRV_IRQ_LEVEL_CRITICAL /* 串口空闲及接收DMA半满/全满 */
+#endif
+#ifndef YDRV_IRQ_PRIO_UART_TX
+#define YDRV_IRQ_PRIO_UART_TX YDRV_IRQ_LEVEL_TRANSFER /* 串口发送DMA完成 */
+#endif
+#ifndef YDRV_IRQ_PRIO_BUTTON
+#define YDRV_IRQ_PRIO_BUTTON YDRV_IRQ_LEVEL_EVENT /* 按键边沿，消抖由定时器完成 */
+#endif
+#ifndef YDRV_IRQ_PRIO_SPI_SLAVE
+#define YDRV_IRQ_PRIO_SPI_SLAVE YDRV_IRQ_LEVEL_EVENT /* SPI从机片选边沿和接收DMA */
+#endif
+#ifndef YDRV_IRQ_PRIO_SPI
+#define YDRV_IRQ_PRIO_SPI YDRV_IRQ_LEVEL_TRANSFER /* SPI主机中断传输和DMA完成 */
+#endif
+#ifndef YDRV_IRQ_PRIO_DMA
+#define YDRV_IRQ_PRIO_DMA YDRV_IRQ_LEVEL_SYSTEM /* 内存到内存DMA拷贝 */
+#endif
+#ifndef YDRV_IRQ_PRIO_TICK
+#define YDRV_IRQ_PRIO_TICK YDRV_IRQ_LEVEL_SYSTEM /* TIM17毫秒时基 */
+#endif
+#ifndef YDRV_IRQ_PRIO_RTC
+#define YDRV_IRQ_PRIO_RTC YDRV_IRQ_LEVEL_SYSTEM /* RTC唤醒定时器 */
+#endif
+#ifndef YDRV_IRQ_PRIO_PROF
+#define YDRV_IRQ_PRIO_PROF YDRV_IRQ_LEVEL_CRITICAL /* 采样分析器TIM16，须高于被采样的中断 */
+#endif
+#ifndef YDRV_IRQ_PRIO_LIN
+#define YDRV_IRQ_PRIO_LIN YDRV_IRQ_LEVEL_EVENT /* LIN时隙定时器TIM15和接收超时，两者同级互不抢占 */
+#endif
+#ifndef YDRV_IRQ_PRIO_SWI
+#define YDRV_IRQ_PRIO_SWI YDRV_IRQ_LEVEL_SYSTEM /* 软件中断，中断运行模式的工作队列和定时器 */
+#endif
+
+    /**
+     * @brief 设置外设中断优先级
+     * @param irq 外设中断号
+     * @param prio 优先级等级，超出范围时取最低等级
+     * @note 中断已使能时只会提高优先级：共享同一中断线的中断源取其中最高的等级，
+     *       后注册的低等级中断源不会降低先注册的高等级中断源
+     */
+    void yDrvIrqSetPriority(IRQn_Type irq, uint32_t prio);
+
+    // ==================== 中断延迟测量 ====================
+
+    /**
+     * @brief 可同时测量的中断数
+     */
+#ifndef YDRV_IRQ_LATENCY_MAX
+#define YDRV_IRQ_LATENCY_MAX (4U)
+#endif
+
+    /**
+     * @brief 一个中断的入口延迟统计(CPU周期)
+     */
+    typedef struct
+    {
+        IRQn_Type irq;            /*!< 中断号 */
+        yDrvIrqHandler_t handler; /*!< 原入口函数 */
+        GPIO_TypeDef *port;       /*!< 入口期间置高的调试引脚端口，NULL不输出 */
+        uint32_t pinMask;         /*!< 调试引脚掩码 */
+        uint32_t count;           /*!< 测得的样本数 */
+        uint32_t min;             /*!< 最小延迟 */
+        uint32_t max;             /*!< 最大延迟 */
+        uint32_t last;            /*!< 最近一次延迟 */
+    } yDrvIrqLatency_t;
+
+    /**
+     * @brief 在中断入口前插入测量包装
+     * @param irq 外设中断号
+     * @param port 调试引脚端口，NULL不输出；入口到原入口函数返回期间引脚为高，可用示波器或
+     *        定时器输入捕获测量外部事件(如串口起始位)到中断入口的延迟
+     * @param pinMask 调试引脚掩码，引脚须已配置为推挽输出
+     * @retval YDRV_OK 成功，统计清零
+     * @retval YDRV_NOT_SUPPORTED 向量表不在SRAM
+     * @retval YDRV_BUSY 测量槽已满
+     */
+    yDrvStatus_t yDrvIrqLatencyAttach(IRQn_Type irq, GPIO_TypeDef *port, uint32_t pinMask);
+
+    /**
+     * @brief 恢复原入口函数，释放测量槽
+     * @param irq 外设中断号
+     */
+    void yDrvIrqLatencyDetach(IRQn_Type irq);
+
+    /**
+     * @brief 测一次入口延迟
+     * @param irq 已插入测量包装的中断号
+     * @param cycles 输出从挂起到进入包装的周期数，可为NULL
+     * @retval YDRV_OK 成功
+     * @retval YDRV_INVALID_PARAM 未插入测量包装或中断未使能
+     * @retval YDRV_TIMEOUT 一个系统节拍内未进入中断
+     * @note 记录SysTick后软件挂起该中断，包装入口再读SysTick；延迟包括更高及同等级中断的执行和
+     *       关中断临界区，在Flash擦写等负载下反复调用可得到最坏值。原入口函数会在没有外设标志时
+     *       被调用一次，yDrv的中断入口都先检查标志，不受影响。须在线程中调用
+     */
+    yDrvStatus_t yDrvIrqLatencyProbe(IRQn_Type irq, uint32_t *cycles);
+
+    /**
+     * @brief 按序号取测量槽
+     * @param index 序号
+     * @retval 测量槽，未使用或超出范围返回NULL
+     */
+    const yDrvIrqLatency_t *yDrvIrqLatencyGet(uint32_t index);
+
+    // ==================== 系统时间函数 ====================
+
+    /**
+     * @brief 获取系统毫秒计数
+     * @retval 上电以来的毫秒数
+     * @note 32位回绕，计算时间差使用无符号减法(now - start)
+     */
+    uint32_t yDrvGetTimeMs(void);
+
+    /**
+     * @brief 获取微秒时间戳
+     * @retval 上电以来的微秒数
+     * @note 由TIM17的1MHz计数扩展为32位，约71.6分钟回绕，计算时间差使用无符号减法
+     */
+    uint32_t yDrvGetTimeUs(void);
+
+    /**
+     * @brief 读取周期计数
+     * @retval SysTick当前值
+     * @note SysTick以内核时钟递减计数，与yDrvCycleSince配合测量短于一个系统节拍的区间
+     */
+    uint32_t yDrvCycleNow(void);
+
+    /**
+     * @brief 计算经过的CPU周期数
+     * @param start yDrvCycleNow的返回值
+     * @retval 从start到现在的周期数
+     * @note 处理一次重装回绕，区间超过一个系统节拍时结果错误
+     */
+    uint32_t yDrvCycleSince(uint32_t start);
+
+    // ==================== 低功耗函数 ====================
+
+    /**
+     * @brief RTC唤醒定时器的LSI频率(Hz)
+     * @note LSI出厂精度较差，STOP期间的计时误差随之而来，唤醒后的毫秒计数按此频率补偿
+     */
+#ifndef YDRV_STOP_LSI_HZ
+#define YDRV_STOP_LSI_HZ (32000U)
+#endif
+
+    /**
+     * @brief 单次STOP的最长时间(毫秒)
+     * @note 受唤醒定时器16位计数(LSI/16)和RTC亚秒计数周期(约32.7秒)限制
+     */
+#define YDRV_STOP_MAX_MS (30000U)
+
+    /**
+     * @brief 初始化STOP模式的唤醒源
+     * @retval yDrv状态
+     * @note G070没有LPTIM，以LSI驱动RTC：唤醒定时器定时唤醒，亚秒计数测量实际睡眠时间；
+     *       会复位备份域，不能与其他RTC用法共存
+     */
+    yDrvStatus_t yDrvStopInit(void);
+
+    /**
+     * @brief 进入STOP1模式
+     * @param ms 最长睡眠时间(毫秒)，超过YDRV_STOP_MAX_MS时截断
+     * @param slept 输出实际睡眠的毫秒数，已计入yDrvGetTimeMs
+     * @retval yDrv状态
+     *         - YDRV_OK: 已睡眠并恢复
+     *         - YDRV_NOT_INITIALIZED: 未调用yDrvStopInit
+     *         - YDRV_INVALID_PARAM: 参数无效
+     * @note 须在关中断(PRIMASK)下调用，任意中断挂起即唤醒，返回后再开中断处理；
+     *       唤醒后按yDrv_clock的当前等级恢复系统时钟；调用者负责确认外设和DMA空闲
+     */
+    yDrvStatus_t yDrvEnterStop(uint32_t ms, uint32_t *slept);
+
+    // ==================== 软件中断 ====================
+
+    /**
+     * @brief 软件中断借用的外设中断线
+     * @note 选一个不使用其外设的中断线，只由软件挂起；默认TIM7，TIM7不能再作他用
+     */
+#ifndef YDRV_SWI_IRQ
+#define YDRV_SWI_IRQ TIM7_IRQn
+#endif
+
+    /**
+     * @brief 初始化软件中断
+     * @param handler 中断入口函数
+     * @retval yDrv状态
+     *         - YDRV_OK: 成功，中断已使能
+     *         - YDRV_INVALID_PARAM: handler为NULL
+     *         - YDRV_NOT_SUPPORTED: 向量表不在SRAM
+     * @note 优先级为YDRV_IRQ_PRIO_SWI，其他中断中挂起后在它们退出时尾链进入
+     */
+    yDrvStatus_t yDrvSwiInit(yDrvIrqHandler_t handler);
+
+    /**
+     * @brief 挂起软件中断
+     * @note 可在任意上下文调用，多次挂起在进入前合并为一次
+     */
+    void yDrvSwiTrigger(void);
+
+    /**
+     * @brief 在指定时刻挂起软件中断
+     * @param ms yDrvGetTimeMs的绝对时刻，已经过去时立即挂起
+     * @note 只保留一个时刻，再次调用覆盖之前的；由TIM17毫秒中断比较，到期挂起一次后解除
+     */
+    void yDrvSwiTriggerAt(uint32_t ms);
+
+    /**
+     * @brief 取消yDrvSwiTriggerAt设置的时刻
+     */
+    void yDrvSwiCancelAt(void);
+
+    /**
+     * @brief 进入中断运行
+     * @note 置位SCR.SLEEPONEXIT后WFI，此后中断退出时内核直接回到Sleep，不再返回线程模式，
+     *       所有工作都在中断中完成；不返回。毫秒时基照常运行，深度睡眠(STOP)不在此列
+     */
+    void yDrvIrqRunEnter(void) __attribute__((noreturn));
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,259 @@
+/**
+ * @file yDrv_bitbang.h
+ * @brief STM32G0 时序敏感协议位操作引擎头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 为1-Wire、WS2812等需要亚微秒级时序的单线协议提供RAM中按周期计数的时隙和定时器DMA波形输出
+ *
+ * @par 主要特性:
+ * - 时隙函数在RAM中执行，不受Flash等待周期影响；延时由3周期一圈的循环实现，
+ *   圈数按当前SystemCoreClock在进入RAM前算好，RAM中只有乘法和移位
+ * - 1-Wire只在对时序敏感的几微秒内关中断：写1和读时隙关中断不超过15us，
+ *   写0和复位的长低电平被中断拉长也在协议允许范围内，不关中断
+ * - WS2812由定时器PWM加更新事件DMA逐位写入比较值，双缓冲在半传输/传输完成中断中编码，
+ *   整个刷新过程不关中断，数据结束后自动输出复位低电平并停止
+ *
+ * @par 使用约束:
+ * - 1-Wire总线需要上拉电阻(约4.7k)，短总线可用内部上拉；系统时钟不低于8MHz
+ * - WS2812的定时器计数时钟固定16MHz，系统时钟为64MHz或16MHz时均可用
+ */
+
+#ifndef YDRV_BITBANG_H
+#define YDRV_BITBANG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "stm32g0xx_ll_gpio.h"
+
+#include "yDrv_basic.h"
+#include "yDrv_tim.h"
+
+    // ==================== 配置定义 ====================
+
+    /**
+     * @brief WS2812每半个缓冲区的位数，须为8的倍数
+     * @note 缓冲区共两半，每位一个半字；48位(两颗灯)一半时每60us进一次中断，占192字节
+     */
+#ifndef YDRV_WS2812_HALF_BITS
+#define YDRV_WS2812_HALF_BITS (48U)
+#endif
+
+    /**
+     * @brief WS2812数据结束后的复位低电平时间(us)，新款WS2812B要求不少于280us
+     */
+#ifndef YDRV_WS2812_RESET_US
+#define YDRV_WS2812_RESET_US (300U)
+#endif
+
+    // ==================== 1-Wire结构体 ====================
+
+    /**
+     * @brief 1-Wire总线配置结构体
+     */
+    typedef struct
+    {
+        yDrvGpioPin_t pin; /*!< 数据引脚，开漏输出 */
+        uint8_t pullUp;    /*!< 1=使能内部上拉，外部已有上拉时为0 */
+    } yDrvOneWireConfig_t;
+
+    /**
+     * @brief 1-Wire总线句柄结构体
+     */
+    typedef struct
+    {
+        yDrvGpioInfo_t pinInfo; /*!< 数据引脚信息 */
+        uint32_t loopsPerUs16;  /*!< 每微秒的延时圈数(乘16)，每次操作开始时按当前时钟更新 */
+    } yDrvOneWireHandle_t;
+
+/**
+ * @brief 1-Wire配置结构体默认初始化宏
+ */
+#define YDRV_ONEWIRE_CONFIG_DEFAULT() \
+    ((yDrvOneWireConfig_t){           \
+        .pin = YDRV_PINNULL,          \
+        .pullUp = 0,                  \
+    })
+
+/**
+ * @brief 1-Wire句柄结构体默认初始化宏
+ */
+#define YDRV_ONEWIRE_HANDLE_DEFAULT() \
+    ((yDrvOneWireHandle_t){           \
+        .pinInfo = {NULL, 0, 0, 0},   \
+        .loopsPerUs16 = 0,            \
+    })
+
+    // ==================== WS2812结构体 ====================
+
+    /**
+     * @brief WS2812刷新完成回调
+     * @param arg 启动时传入的参数
+     * @note 在DMA中断中调用，此时复位低电平已输出完毕，可以立即开始下一次刷新
+     */
+    typedef void (*yDrvWs2812Done_t)(void *arg);
+
+    /**
+     * @brief WS2812灯带配置结构体
+     */
+    typedef struct
+    {
+        yDrvTimId_t timId;          /*!< 定时器实例，须有DMA请求(TIM14除外) */
+        yDrvTimChannel_t channel;   /*!< 定时器通道 */
+        yDrvGpioPin_t pin;          /*!< 数据引脚 */
+        uint32_t pinAF;             /*!< 引脚复用功能编号 */
+        uint8_t openDrain;          /*!< 1=开漏输出(外部上拉到5V做电平转换)，0=推挽 */
+        yDrvDmaPriority_t priority; /*!< DMA通道优先级 */
+        uint32_t prio;              /*!< DMA中断优先级 */
+    } yDrvWs2812Config_t;
+
+    /**
+     * @brief WS2812灯带句柄结构体
+     */
+    typedef struct
+    {
+        yDrvTimHandle_t tim;                       /*!< PWM定时器 */
+        uint16_t slot[2U * YDRV_WS2812_HALF_BITS]; /*!< 每位一个比较值的双缓冲(DMA源) */
+        const uint8_t *data;                       /*!< 正在发送的GRB数据 */
+        uint32_t len;                              /*!< 数据字节数 */
+        uint32_t pos;                              /*!< 下一个待编码的字节 */
+        uint32_t idle;                             /*!< 数据结束后填入的全0半区数 */
+        uint32_t idleMax;                          /*!< 全0半区数达到该值时停止 */
+        yDrvWs2812Done_t done;                     /*!< 完成回调 */
+        void *arg;                                 /*!< 回调参数 */
+        volatile uint8_t busy;                     /*!< 刷新进行中 */
+    } yDrvWs2812Handle_t;
+
+/**
+ * @brief WS2812配置结构体默认初始化宏
+ */
+#define YDRV_WS2812_CONFIG_DEFAULT()              \
+    ((yDrvWs2812Config_t){                        \
+        .timId = YDRV_TIM_3,                      \
+        .channel = YDRV_TIM_CH1,                  \
+        .pin = YDRV_PINNULL,                      \
+        .pinAF = 0,                               \
+        .openDrain = 0,                           \
+        .priority = YDRV_DMA_PRIORITY_HIGH,       \
+        .prio = 1,                                \
+    })
+
+    // ==================== 1-Wire函数 ====================
+
+    /**
+     * @brief 初始化1-Wire总线
+     * @param config 配置参数指针
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 初始化状态，引脚无效返回YDRV_INVALID_PARAM
+     * @note 引脚配置为开漏输出并释放总线
+     */
+    yDrvStatus_t yDrvOneWireInit(const yDrvOneWireConfig_t *config, yDrvOneWireHandle_t *handle);
+
+    /**
+     * @brief 反初始化1-Wire总线，引脚恢复为模拟模式
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     */
+    yDrvStatus_t yDrvOneWireDeInit(yDrvOneWireHandle_t *handle);
+
+    /**
+     * @brief 发送复位脉冲并检测应答
+     * @param handle 句柄指针
+     * @retval uint8_t 1=有器件应答，0=总线上没有器件
+     * @note 约1ms，不关中断
+     */
+    uint8_t yDrvOneWireReset(yDrvOneWireHandle_t *handle);
+
+    /**
+     * @brief 写入字节
+     * @param handle 句柄指针
+     * @param data 数据
+     * @param len 字节数
+     * @note 低位先发，每位一个70us时隙，只在写1的6us低电平期间关中断
+     */
+    void yDrvOneWireWrite(yDrvOneWireHandle_t *handle, const uint8_t *data, uint32_t len);
+
+    /**
+     * @brief 读取字节
+     * @param handle 句柄指针
+     * @param data 输出缓冲区
+     * @param len 字节数
+     * @note 低位先收，每位从拉低到采样的15us内关中断
+     */
+    void yDrvOneWireRead(yDrvOneWireHandle_t *handle, uint8_t *data, uint32_t len);
+
+    /**
+     * @brief 读取一位，用于ROM搜索等按位交互
+     * @param handle 句柄指针
+     * @retval uint8_t 读到的位
+     */
+    uint8_t yDrvOneWireReadBit(yDrvOneWireHandle_t *handle);
+
+    /**
+     * @brief 写入一位
+     * @param handle 句柄指针
+     * @param bit 非0写1
+     */
+    void yDrvOneWireWriteBit(yDrvOneWireHandle_t *handle, uint32_t bit);
+
+    /**
+     * @brief 计算1-Wire CRC8(多项式x^8+x^5+x^4+1，低位先)
+     * @param data 数据
+     * @param len 字节数
+     * @retval uint8_t CRC值，数据含末尾CRC字节时结果为0表示校验通过
+     */
+    uint8_t yDrvOneWireCrc8(const uint8_t *data, uint32_t len);
+
+    // ==================== WS2812函数 ====================
+
+    /**
+     * @brief 初始化WS2812灯带
+     * @param config 配置参数指针
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 初始化状态
+     * @note 定时器以16MHz计数、20个计数(1.25us)为一位，空闲时输出低电平
+     */
+    yDrvStatus_t yDrvWs2812Init(const yDrvWs2812Config_t *config, yDrvWs2812Handle_t *handle);
+
+    /**
+     * @brief 反初始化WS2812灯带，进行中的刷新被中止
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     */
+    yDrvStatus_t yDrvWs2812DeInit(yDrvWs2812Handle_t *handle);
+
+    /**
+     * @brief 启动一次刷新
+     * @param handle 句柄指针
+     * @param grb 按灯排列的G、R、B字节，完成前必须保持有效
+     * @param len 字节数(灯数*3)
+     * @param done 完成回调，可为NULL
+     * @param arg 回调参数
+     * @retval yDrvStatus_t 启动状态
+     *         - YDRV_OK: 已启动，数据和复位低电平发送完后调用done
+     *         - YDRV_BUSY: 上一次刷新尚未完成
+     */
+    yDrvStatus_t yDrvWs2812Write(yDrvWs2812Handle_t *handle, const uint8_t *grb, uint32_t len,
+                                 yDrvWs2812Done_t done, void *arg);
+
+    /**
+     * @brief 查询刷新是否进行中
+     * @param handle 句柄指针
+     * @retval uint8_t 1=进行中，0=空闲
+     */
+    YLIB_INLINE uint8_t yDrvWs2812IsBusy(yDrvWs2812Handle_t *handle)
+    {
+        return handle->busy;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_BITBANG_H */
@@ -0,0 +1,137 @@
+/**
+ * @file yDrv_clock.h
+ * @brief STM32G0 系统时钟调频头文件
+ * @version 2.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 运行时在64MHz(HSE+PLL)和HSI16及其分频之间切换系统时钟，Flash等待周期随频率调整；
+ * 时钟相关的驱动注册通知，切换前确认可以切换，切换后按新频率重新计算分频
+ *
+ * @par 主要特性:
+ * - 切换前通知(PRE)在开中断下依次调用，任一返回非YDRV_OK即否决本次切换，已通知的收到ABORT
+ * - 升频时HSE起振和PLL锁定在临界区外完成，临界区内只有Flash等待周期、时钟源切换和寄存器重算
+ * - 切换后通知(POST)在临界区内调用，只允许改写外设寄存器，不能等待
+ * - 系统时基TIM17和SysTick由本模块直接重算，毫秒计数和RTOS节拍保持连续
+ * - AHB、APB固定不分频，PCLK等于SYSCLK
+ *
+ * @par 使用约束:
+ * yDrvClockSet不可重入，由yDev的时钟请求接口串行调用；STOP唤醒后按当前等级恢复时钟，不产生通知
+ */
+
+#ifndef YDRV_CLOCK_H
+#define YDRV_CLOCK_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // ==================== 包含文件 ====================
+#include "yDrv_basic.h"
+#include "yLib_list.h"
+
+    // ==================== 配置定义 ====================
+
+    /**
+     * @brief 上电时的时钟等级
+     * @note 默认HSI16：调度器启动前不等待HSE起振和PLL锁定，由yDev在设备初始化级别
+     *       切换到空闲等级(YDEV_CLOCK_IDLE_LEVEL)；设为YDRV_CLOCK_64MHZ时上电即等待PLL
+     */
+#ifndef YDRV_CLOCK_BOOT_LEVEL
+#define YDRV_CLOCK_BOOT_LEVEL YDRV_CLOCK_16MHZ
+#endif
+
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief 系统时钟等级，数值小的频率高
+     */
+    typedef enum
+    {
+        YDRV_CLOCK_64MHZ = 0, /*!< HSE 8MHz经PLL倍频，Flash 2个等待周期 */
+        YDRV_CLOCK_16MHZ,     /*!< HSI16，关闭HSE和PLL，Flash 0等待 */
+        YDRV_CLOCK_8MHZ,      /*!< HSI16二分频 */
+        YDRV_CLOCK_4MHZ,      /*!< HSI16四分频 */
+        YDRV_CLOCK_LEVEL_MAX  /*!< 等级数量 */
+    } yDrvClockLevel_t;
+
+    /**
+     * @brief 时钟切换通知事件
+     */
+    typedef enum
+    {
+        YDRV_CLOCK_PRE = 0, /*!< 即将切换，开中断，返回非YDRV_OK否决 */
+        YDRV_CLOCK_POST,    /*!< 已切换，临界区内，按新频率重算寄存器 */
+        YDRV_CLOCK_ABORT,   /*!< 已通过PRE但切换被其他驱动否决 */
+    } yDrvClockEvent_t;
+
+    /**
+     * @brief 时钟切换通知
+     * @note 由驱动静态定义，初始化时注册；回调参数中的频率为SYSCLK(Hz)
+     */
+    typedef struct
+    {
+        struct ylib_list_head node;                                           /*!< 通知链表节点 */
+        yDrvStatus_t (*callback)(yDrvClockEvent_t event, uint32_t oldHz,
+                                 uint32_t newHz, void *arg);                  /*!< 通知回调 */
+        void *arg;                                                            /*!< 回调参数 */
+    } yDrvClockNotifier_t;
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 注册时钟切换通知
+     * @param notifier 通知指针，已注册时忽略
+     */
+    void yDrvClockRegister(yDrvClockNotifier_t *notifier);
+
+    /**
+     * @brief 注销时钟切换通知
+     * @param notifier 通知指针
+     */
+    void yDrvClockUnregister(yDrvClockNotifier_t *notifier);
+
+    /**
+     * @brief 切换系统时钟等级
+     * @param level 目标等级
+     * @retval yDrv状态
+     *         - YDRV_OK: 已切换或已在该等级
+     *         - YDRV_BUSY: 被驱动否决，时钟未改变
+     *         - YDRV_INVALID_PARAM: 等级无效
+     * @note 在任务中调用，升频时等待HSE起振和PLL锁定
+     */
+    yDrvStatus_t yDrvClockSet(yDrvClockLevel_t level);
+
+    /**
+     * @brief 获取当前时钟等级
+     * @retval 当前等级
+     */
+    yDrvClockLevel_t yDrvClockGet(void);
+
+    /**
+     * @brief 获取等级对应的SYSCLK频率
+     * @param level 时钟等级
+     * @retval 频率(Hz)，等级无效时为0
+     */
+    uint32_t yDrvClockLevelHz(yDrvClockLevel_t level);
+
+    /**
+     * @brief 按当前等级重新配置时钟源
+     * @note 复位后和STOP唤醒后系统时钟为HSI16，由yDrv.c调用恢复；不通知驱动，不重算时基
+     */
+    void yDrvClockRestore(void);
+
+    /**
+     * @brief 上电时提前启动HSE
+     * @note yDrvClockRestore配置上电等级后由yDrv.c调用；上电等级为HSI时启动HSE但不等待，
+     *       之后升到64MHz只需等待PLL锁定；上电等级为64MHz时不做任何事
+     */
+    void yDrvClockBoot(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_CLOCK_H */
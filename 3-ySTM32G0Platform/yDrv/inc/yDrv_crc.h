@@ -0,0 +1,244 @@
+/**
+ * @file yDrv_crc.h
+ * @brief STM32G0 硬件CRC驱动程序头文件
+ * @version 2.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 提供STM32G0系列MCU硬件CRC计算单元的驱动接口
+ *
+ * @par 主要特性:
+ * - 支持7/8/16/32位可编程多项式和初始值
+ * - 支持输入/输出位反转
+ * - 按字写入数据寄存器，每4字节一次总线访问
+ * - CRC-32/CRC-16/CRC-8预设配置，输出异或由软件完成
+ * - DMA喂数，大块数据校验期间不占用CPU
+ * - 外设接收DMA可直接写入数据寄存器，读回数据不经过RAM即可得到CRC
+ * - 注册为yLib CRC硬件后端，ylib_crc32/ylib_crc16按需重配CRC单元
+ *
+ * @par 使用约束:
+ * CRC单元只有一个，直接接口不做互斥，多个任务共用时由上层加锁；
+ * yLib后端每段数据在临界区内完成并恢复原配置，但会打断未完成的yDrvCrcAccumulate分段计算；
+ * DMA计算期间yLib后端自动退回查表
+ */
+
+#ifndef YDRV_CRC_H
+#define YDRV_CRC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "stm32g0xx_ll_bus.h"
+
+#include "yDrv_basic.h"
+#include "yDrv_dma.h"
+
+    // ==================== CRC配置枚举 ====================
+
+    /**
+     * @brief CRC多项式位宽枚举
+     */
+    typedef enum
+    {
+        YDRV_CRC_POLY_32BIT = 0,                                      /*!< 32位多项式 */
+        YDRV_CRC_POLY_16BIT = CRC_CR_POLYSIZE_0,                      /*!< 16位多项式 */
+        YDRV_CRC_POLY_8BIT = CRC_CR_POLYSIZE_1,                       /*!< 8位多项式 */
+        YDRV_CRC_POLY_7BIT = (CRC_CR_POLYSIZE_0 | CRC_CR_POLYSIZE_1), /*!< 7位多项式 */
+    } yDrvCrcPolySize_t;
+
+    /**
+     * @brief CRC输入位反转枚举
+     */
+    typedef enum
+    {
+        YDRV_CRC_REV_IN_NONE = 0,                                  /*!< 不反转 */
+        YDRV_CRC_REV_IN_BYTE = CRC_CR_REV_IN_0,                    /*!< 按字节反转 */
+        YDRV_CRC_REV_IN_HALFWORD = CRC_CR_REV_IN_1,                /*!< 按半字反转 */
+        YDRV_CRC_REV_IN_WORD = (CRC_CR_REV_IN_0 | CRC_CR_REV_IN_1) /*!< 按字反转 */
+    } yDrvCrcRevIn_t;
+
+    // ==================== CRC配置结构体 ====================
+
+    /**
+     * @brief CRC初始化配置结构体
+     */
+    typedef struct
+    {
+        yDrvCrcPolySize_t polySize; /*!< 多项式位宽 */
+        uint32_t poly;              /*!< 多项式(不含最高位) */
+        uint32_t init;              /*!< 初始值 */
+        yDrvCrcRevIn_t revIn;       /*!< 输入位反转 */
+        uint8_t revOut;             /*!< 输出位反转 (0=否, 1=是) */
+        uint32_t xorOut;            /*!< 结果异或值，硬件不支持，由软件完成 */
+    } yDrvCrcConfig_t;
+
+/**
+ * @brief CRC-32预设
+ * @note CRC-32/ISO-HDLC(与zlib相同)：多项式0x04C11DB7，初始值0xFFFFFFFF，输入输出反转，结果取反
+ */
+#define YDRV_CRC_CONFIG_CRC32()           \
+    ((yDrvCrcConfig_t){                   \
+        .polySize = YDRV_CRC_POLY_32BIT,  \
+        .poly = 0x04C11DB7,               \
+        .init = 0xFFFFFFFF,               \
+        .revIn = YDRV_CRC_REV_IN_BYTE,    \
+        .revOut = 1,                      \
+        .xorOut = 0xFFFFFFFF,             \
+    })
+
+/**
+ * @brief CRC-16预设
+ * @note CRC-16/CCITT-FALSE：多项式0x1021，初始值0xFFFF，不反转
+ */
+#define YDRV_CRC_CONFIG_CRC16()           \
+    ((yDrvCrcConfig_t){                   \
+        .polySize = YDRV_CRC_POLY_16BIT,  \
+        .poly = 0x1021,                   \
+        .init = 0xFFFF,                   \
+        .revIn = YDRV_CRC_REV_IN_NONE,    \
+        .revOut = 0,                      \
+        .xorOut = 0,                      \
+    })
+
+/**
+ * @brief CRC-8预设
+ * @note CRC-8/SMBUS：多项式0x07，初始值0x00，不反转
+ */
+#define YDRV_CRC_CONFIG_CRC8()            \
+    ((yDrvCrcConfig_t){                   \
+        .polySize = YDRV_CRC_POLY_8BIT,   \
+        .poly = 0x07,                     \
+        .init = 0x00,                     \
+        .revIn = YDRV_CRC_REV_IN_NONE,    \
+        .revOut = 0,                      \
+        .xorOut = 0,                      \
+    })
+
+/**
+ * @brief CRC配置默认初始化宏
+ * @note 与YDRV_CRC_CONFIG_CRC16相同
+ */
+#define YDRV_CRC_CONFIG_DEFAULT() YDRV_CRC_CONFIG_CRC16()
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 初始化CRC单元
+     * @param config 配置参数指针
+     * @retval yDrv状态
+     * @note 使能CRC时钟并写入多项式、初始值和反转设置
+     */
+    yDrvStatus_t yDrvCrcInitStatic(const yDrvCrcConfig_t *config);
+
+    /**
+     * @brief 反初始化CRC单元
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvCrcDeInitStatic(void);
+
+    /**
+     * @brief 从初始值开始计算一段数据的CRC
+     * @param data 数据指针
+     * @param len 数据长度
+     * @retval CRC结果(按多项式位宽截取)
+     */
+    uint32_t yDrvCrcCalculate(const void *data, uint32_t len);
+
+    /**
+     * @brief 在上一次结果上累加一段数据的CRC
+     * @param data 数据指针
+     * @param len 数据长度
+     * @retval CRC结果(按多项式位宽截取)
+     * @note 用于分段计算，第一段须使用yDrvCrcCalculate
+     */
+    uint32_t yDrvCrcAccumulate(const void *data, uint32_t len);
+
+    /**
+     * @brief 初始化CRC的DMA喂数通道
+     * @param handle DMA句柄指针
+     * @param channel DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配
+     * @retval yDrv状态
+     * @note 内存到内存通道，源地址递增，目标固定为CRC数据寄存器
+     */
+    yDrvStatus_t yDrvCrcDmaInit(yDrvDmaHandle_t *handle, yDrvDmaChannel_t channel);
+
+    /**
+     * @brief 反初始化CRC的DMA喂数通道
+     * @param handle DMA句柄指针
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvCrcDmaDeInit(yDrvDmaHandle_t *handle);
+
+    /**
+     * @brief 启动DMA计算一段数据的CRC
+     * @param handle DMA句柄指针
+     * @param data 数据指针，传输完成前不能修改
+     * @param len 数据长度
+     * @retval YDRV_OK 已启动
+     * @retval YDRV_BUSY 上一次DMA计算未结束
+     * @retval YDRV_INVALID_PARAM 长度超过DMA单次传输上限
+     * @note 从初始值开始计算；输入按字节或字反转时DMA按字写入，前后不对齐的字节由CPU写入，
+     *       不反转和按半字反转时字写入顺序与字节流不一致，DMA按字节写入，长度上限65535
+     */
+    yDrvStatus_t yDrvCrcDmaStart(yDrvDmaHandle_t *handle, const void *data, uint32_t len);
+
+    /**
+     * @brief 结束DMA计算并取结果
+     * @param handle DMA句柄指针
+     * @param result 输出CRC结果(按多项式位宽截取)
+     * @retval YDRV_OK 完成
+     * @retval YDRV_BUSY 传输未完成
+     * @note 可在通道传输完成回调中调用，也可轮询直到返回YDRV_OK
+     */
+    yDrvStatus_t yDrvCrcDmaFinish(yDrvDmaHandle_t *handle, uint32_t *result);
+
+    /**
+     * @brief 占用CRC单元接收外设DMA直接写入的数据
+     * @retval YDRV_OK 已占用，数据寄存器复位为初始值
+     * @retval YDRV_BUSY DMA计算或其他占用进行中
+     * @note 外设接收DMA按字节写入yDrvCrcStreamTarget()，字节顺序与yDrvCrcCalculate的字节流相同；
+     *       占用期间可用yDrvCrcReset/yDrvCrcAccumulate，yLib后端退回查表
+     */
+    yDrvStatus_t yDrvCrcStreamBegin(void);
+
+    /**
+     * @brief 取结果并释放CRC单元
+     * @retval CRC结果(按多项式位宽截取)
+     */
+    uint32_t yDrvCrcStreamEnd(void);
+
+    /**
+     * @brief 注册为yLib CRC硬件后端
+     * @retval yDrv状态
+     * @note 使能CRC时钟；ylib_crc32/ylib_crc16每次调用按各自参数重配CRC单元，
+     *       每段数据结束后恢复yDrvCrcInitStatic设置的配置
+     */
+    yDrvStatus_t yDrvCrcRegisterYlib(void);
+
+    // ==================== 内联函数 ====================
+
+    /**
+     * @brief 复位CRC计算，数据寄存器恢复初始值
+     */
+    static inline void yDrvCrcReset(void)
+    {
+        CRC->CR |= CRC_CR_RESET;
+    }
+
+    /**
+     * @brief 外设DMA写入的目标地址(数据寄存器)
+     */
+    static inline void *yDrvCrcStreamTarget(void)
+    {
+        return (void *)&CRC->DR;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_CRC_H */
@@ -13,6 +13,9 @@
  * - 支持内存到内存、内存到外设、外设到内存传输
  * - 支持正常模式和循环模式
  * - 完整的中断管理系统
+ * - 通道动态分配，记录使用者，反初始化时释放通道和DMAMUX请求线
+ * - DMAMUX请求生成器和通道同步，由EXTI/TIM14 OC/LPTIM信号定速触发传输
+ * - 软件描述符链：超过65535项或不连续的传输由TC中断依次装载，整条链完成时回调一次
  * - 内联优化高频操作函数
  * - 统一的错误处理和状态查询
  */
@@ -234,6 +237,7 @@ extern "C"
 
     /**
      * @brief DMA数据位宽枚举
+     * @note 取值为外设端位宽编码，存储器端使用YDRV_DMA_MEM_WIDTH转换
      */
     typedef enum
     {
@@ -242,6 +246,12 @@ extern "C"
         YDRV_DMA_WIDTH_32BIT = LL_DMA_PDATAALIGN_WORD
     } yDrvDmaDataWidth_t;
 
+/**
+ * @brief 数据位宽转换为存储器端位宽编码
+ * @note CCR寄存器中MSIZE位于PSIZE之上两位
+ */
+#define YDRV_DMA_MEM_WIDTH(_width) ((uint32_t)(_width) << (DMA_CCR_MSIZE_Pos - DMA_CCR_PSIZE_Pos))
+
     /**
      * @brief DMA地址递增模式枚举
      */
@@ -251,6 +261,87 @@ extern "C"
         YDRV_DMA_INC_ENABLE
     } yDrvDmaIncrement_t;
 
+    /**
+     * @brief DMA中断类型枚举
+     */
+    typedef enum
+    {
+        YDRV_DMA_EXTI_TC = 0, // 传输完成中断
+        YDRV_DMA_EXTI_HT,     // 半传输中断
+        YDRV_DMA_EXTI_TE,     // 传输错误中断
+        YDRV_DMA_EXTI_MAX     // 所有中断
+    } yDrvDmaExti_t;
+
+    /**
+     * @brief DMA中断配置结构体
+     */
+    typedef struct
+    {
+        yDrvDmaExti_t trigger;
+        uint32_t prio;
+        void (*function)(void *para); // 回调函数指针
+        void *arg;                    // 回调函数参数
+        uint32_t enable;
+    } yDrvDmaExtiConfig_t;
+
+    /**
+     * @brief DMAMUX触发信号枚举
+     * @note 请求生成器和通道同步共用同一组输入；G0的DMAMUX没有定时器TRGO输入，
+     *       定时器定速传输直接使用YDRV_DMA_REQ_TIMx_UP请求信号，或由TIM14 OC触发请求生成器
+     */
+    typedef enum
+    {
+        YDRV_DMA_SIGNAL_EXTI0 = 0,       /*!< EXTI线0 */
+        YDRV_DMA_SIGNAL_EXTI1,           /*!< EXTI线1 */
+        YDRV_DMA_SIGNAL_EXTI2,           /*!< EXTI线2 */
+        YDRV_DMA_SIGNAL_EXTI3,           /*!< EXTI线3 */
+        YDRV_DMA_SIGNAL_EXTI4,           /*!< EXTI线4 */
+        YDRV_DMA_SIGNAL_EXTI5,           /*!< EXTI线5 */
+        YDRV_DMA_SIGNAL_EXTI6,           /*!< EXTI线6 */
+        YDRV_DMA_SIGNAL_EXTI7,           /*!< EXTI线7 */
+        YDRV_DMA_SIGNAL_EXTI8,           /*!< EXTI线8 */
+        YDRV_DMA_SIGNAL_EXTI9,           /*!< EXTI线9 */
+        YDRV_DMA_SIGNAL_EXTI10,          /*!< EXTI线10 */
+        YDRV_DMA_SIGNAL_EXTI11,          /*!< EXTI线11 */
+        YDRV_DMA_SIGNAL_EXTI12,          /*!< EXTI线12 */
+        YDRV_DMA_SIGNAL_EXTI13,          /*!< EXTI线13 */
+        YDRV_DMA_SIGNAL_EXTI14,          /*!< EXTI线14 */
+        YDRV_DMA_SIGNAL_EXTI15,          /*!< EXTI线15 */
+        YDRV_DMA_SIGNAL_DMAMUX_CH0 = 16, /*!< DMAMUX通道0事件(DMA1通道1) */
+        YDRV_DMA_SIGNAL_DMAMUX_CH1,      /*!< DMAMUX通道1事件(DMA1通道2) */
+        YDRV_DMA_SIGNAL_DMAMUX_CH2,      /*!< DMAMUX通道2事件(DMA1通道3) */
+        YDRV_DMA_SIGNAL_DMAMUX_CH3,      /*!< DMAMUX通道3事件(DMA1通道4) */
+#if defined(LPTIM1)
+        YDRV_DMA_SIGNAL_LPTIM1_OUT = 20, /*!< LPTIM1输出 */
+#endif                                   /* LPTIM1 */
+#if defined(LPTIM2)
+        YDRV_DMA_SIGNAL_LPTIM2_OUT = 21, /*!< LPTIM2输出 */
+#endif                                   /* LPTIM2 */
+        YDRV_DMA_SIGNAL_TIM14_OC = 22,   /*!< TIM14输出比较 */
+        YDRV_DMA_SIGNAL_MAX
+    } yDrvDmaSignal_t;
+
+    /**
+     * @brief DMAMUX触发边沿枚举
+     */
+    typedef enum
+    {
+        YDRV_DMA_EDGE_NONE = 0, /*!< 不响应触发信号 */
+        YDRV_DMA_EDGE_RISING,   /*!< 上升沿 */
+        YDRV_DMA_EDGE_FALLING,  /*!< 下降沿 */
+        YDRV_DMA_EDGE_BOTH      /*!< 双边沿 */
+    } yDrvDmaEdge_t;
+
+/**
+ * @brief DMAMUX请求生成器数量
+ */
+#define YDRV_DMA_GEN_MAX (4U)
+
+/**
+ * @brief 自动分配请求生成器
+ */
+#define YDRV_DMA_GEN_AUTO (0xFFU)
+
     // ==================== DMA配置结构体 ====================
 
     /**
@@ -258,7 +349,7 @@ extern "C"
      */
     typedef struct
     {
-        yDrvDmaChannel_t channel;     // DMA通道
+        yDrvDmaChannel_t channel;     // DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配
         yDrvDmaRequest_t request;     // DMA请求信号（DMAMUX）
         yDrvDmaPriority_t priority;   // 优先级
         yDrvDmaMode_t mode;           // 传输模式
@@ -269,8 +360,87 @@ extern "C"
         void *src_buffer;             // 源缓冲区地址
         void *dst_buffer;             // 目标缓冲区地址
         uint32_t trans_len;           // 缓冲区传输长度
+        const char *owner;            // 使用者名称，仅用于通道占用查询
     } yDrvDmaConfig_t;
 
+    /**
+     * @brief DMA通道占用信息结构体
+     */
+    typedef struct
+    {
+        const char *owner; // 使用者名称，未命名时为NULL
+        uint32_t request;  // 当前DMAMUX请求信号
+        uint32_t priority; // 当前优先级
+        uint8_t used;      // 通道已被分配
+        uint8_t enabled;   // 通道正在传输
+        uint32_t overrun;  // 同步事件溢出次数
+    } yDrvDmaChannelInfo_t;
+
+    /**
+     * @brief DMAMUX请求生成器配置结构体
+     * @note 生成器在触发信号的每个有效边沿产生nbreq个DMA请求，
+     *       DMA通道以生成器输出作为请求信号时，每个请求搬运一个数据项
+     */
+    typedef struct
+    {
+        uint8_t generator;      // 生成器编号(0~3)，YDRV_DMA_GEN_AUTO为自动分配
+        yDrvDmaSignal_t signal; // 触发信号
+        yDrvDmaEdge_t edge;     // 触发边沿
+        uint8_t nbreq;          // 每个触发事件产生的DMA请求数(1~32)
+        uint32_t prio;          // 溢出中断优先级
+        const char *owner;      // 使用者名称，仅用于占用查询
+    } yDrvDmaGenConfig_t;
+
+    /**
+     * @brief DMAMUX请求生成器句柄结构体
+     */
+    typedef struct
+    {
+        uint8_t index;            // 生成器编号，YDRV_DMA_GEN_MAX表示无效
+        yDrvDmaRequest_t request; // 生成器输出，作为DMA配置的request使用
+    } yDrvDmaGenHandle_t;
+
+    /**
+     * @brief DMAMUX请求生成器占用信息结构体
+     */
+    typedef struct
+    {
+        const char *owner; // 使用者名称，未命名时为NULL
+        uint32_t signal;   // 触发信号
+        uint32_t edge;     // 触发边沿
+        uint32_t nbreq;    // 每个触发事件产生的DMA请求数
+        uint32_t overrun;  // 触发溢出次数
+        uint8_t used;      // 生成器已被分配
+        uint8_t enabled;   // 生成器已使能
+    } yDrvDmaGenInfo_t;
+
+    /**
+     * @brief DMA通道同步配置结构体
+     * @note 同步使能后通道请求被阻塞，每个同步事件放行nbreq个请求；
+     *       event使能时通道每完成nbreq个请求输出一次事件，可作为其他通道或生成器的DMAMUX_CHx信号
+     */
+    typedef struct
+    {
+        yDrvDmaSignal_t signal; // 同步信号
+        yDrvDmaEdge_t edge;     // 同步边沿，YDRV_DMA_EDGE_NONE表示不同步
+        uint8_t nbreq;          // 每个同步事件放行的请求数(1~32)
+        uint8_t event;          // 使能通道事件输出
+        uint32_t prio;          // 溢出中断优先级
+    } yDrvDmaSyncConfig_t;
+
+    /**
+     * @brief DMA链式传输描述符
+     * @note G0的DMA没有硬件链表，由TC中断按next依次装载；length超过65535时自动分段，
+     *       地址按通道配置的位宽和递增模式推进。描述符在传输完成前必须保持有效，可以放在Flash中
+     */
+    typedef struct yDrvDmaDesc
+    {
+        const struct yDrvDmaDesc *next; // 下一个描述符，NULL表示链结束
+        uint32_t periph;                // 外设地址(M2M为源地址)，0表示接着上一段
+        uint32_t memory;                // 存储器地址(M2M为目标地址)
+        uint32_t length;                // 数据项数，0表示跳过
+    } yDrvDmaDesc_t;
+
     // ==================== DMA句柄结构体 ====================
 
     /**
@@ -278,8 +448,9 @@ extern "C"
      */
     typedef struct
     {
-        yDrvDmaInfo_t DmaInfo; // DMA控制器信息
-        IRQn_Type IRQ;         // 中断号
+        yDrvDmaInfo_t DmaInfo;  // DMA控制器信息
+        IRQn_Type IRQ;          // 中断号
+        yDrvDmaChannel_t index; // DMA通道索引
     } yDrvDmaHandle_t;
 
 // ==================== DMA初始化宏定义 ====================
@@ -288,31 +459,80 @@ extern "C"
  * @brief DMA配置结构体默认初始化宏
  * @note 提供一个安全的默认配置，适用于大多数应用场景
  */
-#define YDRV_DMA_CONFIG_DEFAULT()                                    \
-    ((yDrvDmaConfig_t){                                              \
-        .channel = YDRV_DMA_CHANNEL_1,     /* 默认使用DMA1通道1 */   \
-        .request = YDRV_DMA_REQ_MEM2MEM,   /* 默认内存到内存传输 */  \
-        .priority = YDRV_DMA_PRIORITY_LOW, /* 默认低优先级 */        \
-        .mode = YDRV_DMA_MODE_NORMAL,      /* 默认正常模式 */        \
-        .src_width = YDRV_DMA_WIDTH_8BIT,  /* 默认8位源数据位宽 */   \
-        .dst_width = YDRV_DMA_WIDTH_8BIT,  /* 默认8位目标数据位宽 */ \
-        .src_inc = YDRV_DMA_INC_ENABLE,    /* 默认源地址递增 */      \
-        .dst_inc = YDRV_DMA_INC_ENABLE,    /* 默认目标地址递增 */    \
-        .src_buffer = NULL,                /* 源缓冲区初始为空 */    \
-        .dst_buffer = NULL,                /* 目标缓冲区初始为空 */  \
+#define YDRV_DMA_CONFIG_DEFAULT()                                      \
+    ((yDrvDmaConfig_t){                                                \
+        .channel = YDRV_DMA_CHANNEL_AUTO,  /* 默认自动分配空闲通道 */  \
+        .request = YDRV_DMA_REQ_MEM2MEM,   /* 默认内存到内存传输 */    \
+        .priority = YDRV_DMA_PRIORITY_LOW, /* 默认低优先级 */          \
+        .mode = YDRV_DMA_MODE_NORMAL,      /* 默认正常模式 */          \
+        .src_width = YDRV_DMA_WIDTH_8BIT,  /* 默认8位源数据位宽 */     \
+        .dst_width = YDRV_DMA_WIDTH_8BIT,  /* 默认8位目标数据位宽 */   \
+        .src_inc = YDRV_DMA_INC_ENABLE,    /* 默认源地址递增 */        \
+        .dst_inc = YDRV_DMA_INC_ENABLE,    /* 默认目标地址递增 */      \
+        .src_buffer = NULL,                /* 源缓冲区初始为空 */      \
+        .dst_buffer = NULL,                /* 目标缓冲区初始为空 */    \
+        .owner = NULL,                     /* 使用者名称初始为空 */    \
     })
 
 /**
  * @brief DMA句柄结构体默认初始化宏
  * @note 初始化为安全的默认状态
  */
-#define YDRV_DMA_HANDLE_DEFAULT()                     \
-    ((yDrvDmaHandle_t){                               \
-        .DmaInfo = {                                  \
-            .dma = NULL,  /* DMA控制器指针初始为空 */ \
-            .channel = 0, /* 通道初始为0 */           \
-        },                                            \
-        .IRQ = 0, /* 中断号初始为0 */                 \
+#define YDRV_DMA_HANDLE_DEFAULT()                        \
+    ((yDrvDmaHandle_t){                                  \
+        .DmaInfo = {                                     \
+            .dma = NULL,  /* DMA控制器指针初始为空 */    \
+            .channel = 0, /* 通道初始为0 */              \
+        },                                               \
+        .IRQ = 0,                      /* 中断号初始为0 */ \
+        .index = YDRV_DMA_CHANNEL_MAX, /* 通道索引无效 */  \
+    })
+
+/**
+ * @brief DMA中断配置结构体默认初始化宏
+ * @note 提供安全的默认中断配置
+ */
+#define YDRV_DMA_EXTI_CONFIG_DEFAULT() \
+    ((yDrvDmaExtiConfig_t){            \
+        .trigger = YDRV_DMA_EXTI_MAX,  \
+        .prio = 0,                     \
+        .function = NULL,              \
+        .arg = NULL,                   \
+        .enable = 0,                   \
+    })
+
+/**
+ * @brief DMAMUX请求生成器配置结构体默认初始化宏
+ */
+#define YDRV_DMA_GEN_CONFIG_DEFAULT()             \
+    ((yDrvDmaGenConfig_t){                        \
+        .generator = YDRV_DMA_GEN_AUTO,           \
+        .signal = YDRV_DMA_SIGNAL_EXTI0,          \
+        .edge = YDRV_DMA_EDGE_RISING,             \
+        .nbreq = 1,                               \
+        .prio = 3,                                \
+        .owner = NULL,                            \
+    })
+
+/**
+ * @brief DMAMUX请求生成器句柄结构体默认初始化宏
+ */
+#define YDRV_DMA_GEN_HANDLE_DEFAULT()             \
+    ((yDrvDmaGenHandle_t){                        \
+        .index = YDRV_DMA_GEN_MAX,                \
+        .request = YDRV_DMA_REQ_MEM2MEM,          \
+    })
+
+/**
+ * @brief DMA通道同步配置结构体默认初始化宏
+ */
+#define YDRV_DMA_SYNC_CONFIG_DEFAULT()            \
+    ((yDrvDmaSyncConfig_t){                       \
+        .signal = YDRV_DMA_SIGNAL_EXTI0,          \
+        .edge = YDRV_DMA_EDGE_RISING,             \
+        .nbreq = 1,                               \
+        .event = 0,                               \
+        .prio = 3,                                \
     })
     // ==================== DMA基础函数 ====================
 
@@ -320,7 +540,10 @@ extern "C"
      * @brief 初始化DMA
      * @param config DMA配置指针
      * @param handle DMA句柄指针
+     * @param direction 传输方向
      * @retval yDrv状态
+     * @note 通道为YDRV_DMA_CHANNEL_AUTO时分配空闲通道，结果保存在handle->index；
+     *       指定通道已被其他句柄占用时返回YDRV_BUSY，没有空闲通道时返回YDRV_BUSY
      */
     yDrvStatus_t yDrvDmaInitStatic(const yDrvDmaConfig_t *config, yDrvDmaHandle_t *handle, yDrvDmaDirection_t direction);
 
@@ -328,9 +551,113 @@ extern "C"
      * @brief 反初始化DMA
      * @param handle DMA句柄指针
      * @retval yDrv状态
+     * @note 停止通道，关闭中断并清除回调，DMAMUX请求线恢复为MEM2MEM后释放通道
      */
     yDrvStatus_t yDrvDmaDeInitStatic(yDrvDmaHandle_t *handle);
 
+    /**
+     * @brief 查询DMA通道占用信息
+     * @param channel DMA通道
+     * @param info 输出的占用信息
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvDmaGetChannelInfo(yDrvDmaChannel_t channel, yDrvDmaChannelInfo_t *info);
+
+    /**
+     * @brief 查询是否所有DMA通道均已关闭
+     * @retval uint8_t 1=全部关闭, 0=有通道在传输
+     * @note STOP模式下DMA停止工作，进入STOP前据此判断
+     */
+    uint8_t yDrvDmaIsIdle(void);
+
+    // ==================== DMA中断管理函数 ====================
+
+    /**
+     * @brief 注册DMA中断回调函数
+     * @param handle DMA句柄指针
+     * @param exti 中断配置指针
+     * @retval yDrv状态
+     * @note 回调在中断上下文中执行，同时使能对应的通道中断和NVIC中断
+     */
+    yDrvStatus_t yDrvDmaRegisterCallback(yDrvDmaHandle_t *handle,
+                                         yDrvDmaExtiConfig_t *exti);
+
+    /**
+     * @brief 反注册DMA中断回调函数
+     * @param handle DMA句柄指针
+     * @param type 中断类型，YDRV_DMA_EXTI_MAX表示全部中断
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvDmaUnregisterCallback(yDrvDmaHandle_t *handle,
+                                           yDrvDmaExti_t type);
+
+    // ==================== DMAMUX请求生成器与同步函数 ====================
+
+    /**
+     * @brief 初始化DMAMUX请求生成器
+     * @param config 生成器配置指针
+     * @param handle 生成器句柄指针
+     * @retval yDrv状态
+     * @note 生成器初始化后处于关闭状态；以handle->request作为DMA配置的request初始化通道，
+     *       使能通道后再调用yDrvDmaGenEnable。例如TIM14 OC触发、M2P方向、外设地址为GPIOx->ODR、
+     *       循环模式，即可按定时器频率输出查找表而不进入中断
+     */
+    yDrvStatus_t yDrvDmaGenInit(const yDrvDmaGenConfig_t *config, yDrvDmaGenHandle_t *handle);
+
+    /**
+     * @brief 反初始化DMAMUX请求生成器
+     * @param handle 生成器句柄指针
+     * @retval yDrv状态
+     * @note 关闭生成器和溢出中断后释放生成器
+     */
+    yDrvStatus_t yDrvDmaGenDeInit(yDrvDmaGenHandle_t *handle);
+
+    /**
+     * @brief 查询DMAMUX请求生成器占用信息
+     * @param generator 生成器编号
+     * @param info 输出的占用信息
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvDmaGenGetInfo(uint32_t generator, yDrvDmaGenInfo_t *info);
+
+    /**
+     * @brief 配置DMA通道同步
+     * @param handle DMA句柄指针
+     * @param config 同步配置指针，NULL表示关闭同步和事件输出
+     * @retval yDrv状态
+     * @note 须在通道关闭时调用；同步信号每个有效边沿放行nbreq个外设请求，
+     *       例如SPI接收通道以EXTI线同步，ADC的DRDY引脚每次下降沿读取一个采样
+     */
+    yDrvStatus_t yDrvDmaSyncConfig(yDrvDmaHandle_t *handle, const yDrvDmaSyncConfig_t *config);
+
+    // ==================== DMA链式传输函数 ====================
+
+    /**
+     * @brief 启动链式传输
+     * @param handle DMA句柄指针，通道已按正常模式初始化
+     * @param desc 第一个描述符
+     * @retval yDrv状态
+     * @note 须先以yDrvDmaRegisterCallback注册TC回调，未注册返回YDRV_ERROR；
+     *       中间各段的TC由驱动在中断中装载下一段，不调用回调，整条链完成时调用一次TC回调；
+     *       HT回调按段触发；传输错误时链停止并调用TE回调
+     */
+    yDrvStatus_t yDrvDmaChainStart(yDrvDmaHandle_t *handle, const yDrvDmaDesc_t *desc);
+
+    /**
+     * @brief 停止链式传输
+     * @param handle DMA句柄指针
+     * @retval yDrv状态
+     * @note 关闭通道，不调用回调
+     */
+    yDrvStatus_t yDrvDmaChainStop(yDrvDmaHandle_t *handle);
+
+    /**
+     * @brief 查询链式传输是否进行中
+     * @param handle DMA句柄指针
+     * @retval uint8_t 1=进行中, 0=已完成或未启动
+     */
+    uint8_t yDrvDmaChainIsBusy(const yDrvDmaHandle_t *handle);
+
     /**
      * @brief 启动DMA传输
      * @param handle DMA句柄指针
@@ -351,7 +678,7 @@ extern "C"
         LL_DMA_SetMemoryAddress(handle->DmaInfo.dma, handle->DmaInfo.channel, (uint32_t)dst_buf);
         LL_DMA_SetMemorySize(handle->DmaInfo.dma,
                              handle->DmaInfo.channel,
-                             len);
+                             YDRV_DMA_MEM_WIDTH(len));
         return YDRV_OK;
     }
 
@@ -393,6 +720,50 @@ extern "C"
         return LL_DMA_GetDataLength(handle->DmaInfo.dma, handle->DmaInfo.channel);
     }
 
+    /**
+     * @brief 清除DMA通道全部中断标志（内联优化）
+     * @param handle DMA句柄指针
+     * @retval yDrv状态
+     * @note 启动新一次传输前调用，避免残留的TC/HT/TE标志误触发
+     */
+    YLIB_INLINE yDrvStatus_t yDrvDmaClearFlags(yDrvDmaHandle_t *handle)
+    {
+        WRITE_REG(handle->DmaInfo.dma->IFCR, DMA_IFCR_CGIF1 << (handle->DmaInfo.channel * 4U));
+        return YDRV_OK;
+    }
+
+    /**
+     * @brief 查询DMA通道传输完成标志（内联优化）
+     * @param handle DMA句柄指针
+     * @retval 1=传输完成, 0=未完成
+     */
+    YLIB_INLINE uint32_t yDrvDmaIsTransComplete(yDrvDmaHandle_t *handle)
+    {
+        return (READ_BIT(handle->DmaInfo.dma->ISR, DMA_ISR_TCIF1 << (handle->DmaInfo.channel * 4U)) != 0U) ? 1U : 0U;
+    }
+
+    /**
+     * @brief 使能DMAMUX请求生成器（内联优化）
+     * @param handle 生成器句柄指针
+     * @retval yDrv状态
+     */
+    YLIB_INLINE yDrvStatus_t yDrvDmaGenEnable(yDrvDmaGenHandle_t *handle)
+    {
+        LL_DMAMUX_EnableRequestGen(DMAMUX1, handle->index);
+        return YDRV_OK;
+    }
+
+    /**
+     * @brief 关闭DMAMUX请求生成器（内联优化）
+     * @param handle 生成器句柄指针
+     * @retval yDrv状态
+     */
+    YLIB_INLINE yDrvStatus_t yDrvDmaGenDisable(yDrvDmaGenHandle_t *handle)
+    {
+        LL_DMAMUX_DisableRequestGen(DMAMUX1, handle->index);
+        return YDRV_OK;
+    }
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,168 @@
+/**
+ * @file yDrv_fault.h
+ * @brief STM32G0 故障记录与主堆栈监视头文件
+ * @version 2.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 把HardFault、任务堆栈溢出等致命故障记录到复位后保留的RAM(.noinit段)，然后复位；
+ * 重新上电启动后由应用读取上一次的故障记录
+ *
+ * @par 主要特性:
+ * - HardFault时保存异常帧中的r0~r3、r12、PC、LR、xPSR和故障前的堆栈指针
+ * - 应用可注册采集钩子，在记录中附带当前任务名、堆状态、最近的跟踪事件等
+ * - configASSERT失败按断言故障记录，参数为行号
+ * - 记录带魔数和校验，上电后的随机内容不会被误认为故障
+ * - 累计故障次数跨复位保留，掉电后清零
+ * - 中断使用的主堆栈(MSP)在启动后填充，可查询历史最大用量
+ *
+ * @par 使用约束:
+ * 记录在关中断下写入，写完即复位，不依赖RTOS和外设；
+ * 主堆栈填充须在线程模式(没有中断嵌套)下调用，调度器启动后的第一个任务中调用即可
+ */
+
+#ifndef YDRV_FAULT_H
+#define YDRV_FAULT_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // ==================== 包含文件 ====================
+#include "yDrv_basic.h"
+
+    // ==================== 配置 ====================
+
+    /**
+     * @brief 记录故障后的动作
+     * @note 1=软件复位；0=关中断停在原地，便于调试器查看现场
+     */
+#ifndef YDRV_FAULT_RESET
+#define YDRV_FAULT_RESET (1)
+#endif
+
+    /**
+     * @brief 故障记录中名称的最大长度(含结束符)
+     */
+#define YDRV_FAULT_NAME_LEN (16U)
+
+    /**
+     * @brief 故障记录中应用附加数据的大小(字节)，须为4的倍数
+     * @note 记录整体放在.noinit段，增大时注意RAM占用
+     */
+#ifndef YDRV_FAULT_EXTRA_SIZE
+#define YDRV_FAULT_EXTRA_SIZE (256U)
+#endif
+
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief 故障类型
+     */
+    typedef enum
+    {
+        YDRV_FAULT_NONE = 0,       /*!< 无故障记录 */
+        YDRV_FAULT_HARDFAULT,      /*!< HardFault异常 */
+        YDRV_FAULT_STACK_OVERFLOW, /*!< 任务堆栈溢出 */
+        YDRV_FAULT_USER,           /*!< 应用主动记录 */
+        YDRV_FAULT_ASSERT,         /*!< configASSERT失败 */
+        YDRV_FAULT_WATCHDOG,       /*!< 任务心跳超时 */
+    } yDrvFaultType_t;
+
+    /**
+     * @brief 故障记录
+     */
+    typedef struct
+    {
+        uint32_t magic;                  /*!< 有效标记 */
+        uint32_t type;                   /*!< 故障类型(yDrvFaultType_t) */
+        uint32_t count;                  /*!< 上电以来的故障次数 */
+        uint32_t time_ms;                /*!< 故障时的毫秒计数 */
+        uint32_t r0;                     /*!< HardFault: 出错时的r0 */
+        uint32_t r1;                     /*!< HardFault: 出错时的r1 */
+        uint32_t r2;                     /*!< HardFault: 出错时的r2 */
+        uint32_t r3;                     /*!< HardFault: 出错时的r3 */
+        uint32_t r12;                    /*!< HardFault: 出错时的r12 */
+        uint32_t pc;                     /*!< HardFault: 出错指令地址；其他: 调用者地址 */
+        uint32_t lr;                     /*!< HardFault: 出错时的LR */
+        uint32_t psr;                    /*!< HardFault: 出错时的xPSR */
+        uint32_t sp;                     /*!< 出错前的堆栈指针 */
+        uint32_t arg;                    /*!< 附加参数，堆栈溢出时为任务句柄，断言时为行号，心跳超时时为超时毫秒数 */
+        char name[YDRV_FAULT_NAME_LEN];  /*!< 任务名等 */
+        uint32_t extra_len;              /*!< 附加数据长度 */
+        uint32_t extra[YDRV_FAULT_EXTRA_SIZE / 4U]; /*!< 采集钩子写入的附加数据 */
+        uint32_t check;                  /*!< 校验 */
+    } yDrvFaultRecord_t;
+
+    /**
+     * @brief 故障采集钩子
+     * @param record 已填好寄存器的记录，钩子可补充name(为空时)和extra/extra_len
+     * @note 在关中断的故障现场调用，只能读内存，不能调用RTOS阻塞接口和外设驱动；
+     *       钩子本身再出错时不再调用
+     */
+    typedef void (*yDrvFaultHook_t)(yDrvFaultRecord_t *record);
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 记录故障并复位
+     * @param type 故障类型
+     * @param arg 附加参数
+     * @param name 名称，可为NULL，超长截断
+     * @note 任何上下文均可调用，不返回
+     */
+    void yDrvFaultLog(yDrvFaultType_t type, uint32_t arg, const char *name) __attribute__((noreturn));
+
+    /**
+     * @brief 记录断言失败并复位
+     * @param line 断言所在行号
+     * @note 供configASSERT调用，pc为断言所在函数中的地址，不保存文件名以节省Flash
+     */
+    void yDrvFaultAssert(uint32_t line) __attribute__((noreturn));
+
+    /**
+     * @brief 注册故障采集钩子
+     * @param hook 钩子，NULL取消
+     */
+    void yDrvFaultRegisterHook(yDrvFaultHook_t hook);
+
+    /**
+     * @brief 检查记录是否完整有效
+     * @param record 记录，可以是从外部存储读回的副本
+     * @retval 1 有效，0 无效
+     */
+    uint8_t yDrvFaultValid(const yDrvFaultRecord_t *record);
+
+    /**
+     * @brief 读取上一次故障记录
+     * @param record 输出记录
+     * @retval 1 有记录，0 无记录(上电启动或已清除)
+     */
+    uint8_t yDrvFaultGet(yDrvFaultRecord_t *record);
+
+    /**
+     * @brief 清除故障记录，保留累计次数
+     */
+    void yDrvFaultClear(void);
+
+    /**
+     * @brief 填充主堆栈未使用部分
+     * @note 只填充当前MSP以下的部分，须在线程模式下调用
+     */
+    void yDrvMainStackPaint(void);
+
+    /**
+     * @brief 查询主堆栈用量
+     * @param size 输出主堆栈大小(字节)，可为NULL
+     * @retval 历史最大用量(字节)，未填充时返回0
+     * @note 主堆栈大小为链接脚本的_Min_Stack_Size，供启动代码和所有中断使用
+     */
+    uint32_t yDrvMainStackUsed(uint32_t *size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_FAULT_H */
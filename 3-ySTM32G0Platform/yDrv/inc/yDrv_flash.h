@@ -0,0 +1,99 @@
+/**
+ * @file yDrv_flash.h
+ * @brief STM32G0 片内Flash编程驱动程序头文件
+ * @version 2.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 提供STM32G0系列MCU片内Flash的页擦除和编程接口
+ *
+ * @par 主要特性:
+ * - 按2KB页擦除
+ * - 按64位双字编程，编程粒度为8字节
+ * - 256字节对齐的整行走快速编程(FSTPG)，省去逐双字的编程校验
+ * - 擦除和编程的启动、等待都在RAM中执行，等待期间保持开中断
+ *
+ * @par 使用约束:
+ * G070只有一个Bank，擦除或编程期间任何Flash取指和读取都会被挂起直到操作结束；
+ * 放在RAM中的中断(串口接收、EXTI等，见YLIB_RAMFUNC)和RAM向量表不受影响，
+ * Flash中的中断和任务在擦除期间(典型22ms)停顿。
+ * 快速编程一行期间关中断(约1.7ms)，要求HCLK不低于8MHz，且该行自擦除后未编程过；
+ * 接口不做互斥，多个任务共用时由上层加锁
+ */
+
+#ifndef YDRV_FLASH_H
+#define YDRV_FLASH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDrv_basic.h"
+
+    // ==================== Flash编译配置 ====================
+
+    /**
+     * @brief 整行编程使用快速编程
+     * @note 0=整行也逐双字编程，期间保持开中断，耗时更长
+     */
+#ifndef YDRV_FLASH_FAST_ENABLE
+#define YDRV_FLASH_FAST_ENABLE (1)
+#endif
+
+// ==================== Flash几何参数 ====================
+#define YDRV_FLASH_PAGE_SIZE (2048U)  /*!< 页大小，擦除单位 */
+#define YDRV_FLASH_ROW_SIZE (256U)    /*!< 行大小，快速编程单位 */
+#define YDRV_FLASH_PROG_SIZE (8U)     /*!< 双字大小，编程单位 */
+#define YDRV_FLASH_ERASED (0xFFU)     /*!< 擦除后的字节值 */
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 擦除一页
+     * @param page 页号，从Flash起始地址算起
+     * @retval YDRV_OK 成功
+     * @retval YDRV_INVALID_PARAM 页号超出Flash容量
+     * @retval YDRV_ERROR 写保护或其他编程错误
+     * @note 在RAM中等待擦除结束，返回时Flash已上锁
+     */
+    yDrvStatus_t yDrvFlashErasePage(uint32_t page);
+
+    /**
+     * @brief 编程一段数据
+     * @param address 目标地址，8字节对齐
+     * @param data 数据指针，无对齐要求
+     * @param size 字节数，8的整数倍
+     * @retval YDRV_OK 成功
+     * @retval YDRV_INVALID_PARAM 地址或长度未对齐、超出Flash容量
+     * @retval YDRV_ERROR 目标未擦除、写保护或其他编程错误
+     * @note 256字节对齐的整行且数据在RAM中按字对齐时走快速编程，其余逐双字编程；
+     *       出错时停在出错的双字或行
+     */
+    yDrvStatus_t yDrvFlashProgram(uint32_t address, const void *data, uint32_t size);
+
+    /**
+     * @brief 读取并清除最近一次操作的错误标志
+     * @retval FLASH_SR中的错误位，0表示没有错误
+     */
+    uint32_t yDrvFlashTakeError(void);
+
+    // ==================== 内联函数 ====================
+
+    /**
+     * @brief 取地址所在的页号
+     * @param address Flash地址
+     * @retval 页号
+     */
+    static inline uint32_t yDrvFlashPageOf(uint32_t address)
+    {
+        return (address - FLASH_BASE) / YDRV_FLASH_PAGE_SIZE;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_FLASH_H */
@@ -11,7 +11,7 @@
  * @par 主要特性:
  * - 支持所有GPIO端口(GPIOA-GPIOF)
  * - 支持多种工作模式：输入、输出、复用功能、模拟
- * - 支持EXTI外部中断管理
+ * - 支持EXTI外部中断管理，同一线可挂多个回调
  * - 内联优化高频操作函数
  * - 统一的错误处理和状态查询
  * - 高效的位操作和端口操作
@@ -140,6 +140,14 @@ extern "C"
         .IRQ = (IRQn_Type)0,         \
     })
 
+    /**
+     * @brief 共享EXTI线的附加回调总数
+     * @note 每条线每个边沿的第一个回调不占用，所有线共用
+     */
+#ifndef YDRV_GPIO_EXTI_CHAIN_MAX
+#define YDRV_GPIO_EXTI_CHAIN_MAX (4U)
+#endif
+
     /**
      * @brief EXTI外部中断配置结构体
      * @note 包含外部中断配置的全部参数
@@ -151,6 +159,7 @@ extern "C"
         void (*function)(void *para); /*!< 中断回调函数指针 */
         void *arg;                    /*!< 回调函数参数 */
         uint32_t enable;              /*!< 中断使能标志 */
+        uint32_t order;               /*!< 同一线上多个回调的执行顺序，小的先执行 */
     } yDrvGpioExtiConfig_t;
 
 /**
@@ -164,6 +173,55 @@ extern "C"
         .function = NULL,                         \
         .arg = NULL,                              \
         .enable = 0,                              \
+        .order = 0,                               \
+    })
+
+    /**
+     * @brief GPIO端口组配置结构体
+     * @note 同一端口上的多个引脚作为一组，按位并行读写
+     */
+    typedef struct
+    {
+        yDrvGpioPin_t pin;     /*!< 端口组最低位对应的引脚，决定端口和移位量 */
+        uint16_t mask;         /*!< 组内引脚掩码(相对pin)，第i位对应pin+i，如0xFF为连续8位 */
+        yDrvGpioMode_t mode;   /*!< GPIO工作模式 */
+        yDrvGpioSpeed_t speed; /*!< GPIO输出速度 */
+        yDrvGpioPuPd_t pupd;   /*!< GPIO上下拉配置 */
+    } yDrvGpioPortConfig_t;
+
+/**
+ * @brief GPIO端口组配置结构体默认初始化宏
+ */
+#define YDRV_GPIO_PORT_CONFIG_DEFAULT()  \
+    ((yDrvGpioPortConfig_t){             \
+        .pin = YDRV_PINNULL,             \
+        .mask = 0,                       \
+        .mode = YDRV_GPIO_MODE_INPUT,    \
+        .speed = YDRV_GPIO_SPEED_LEVEL0, \
+        .pupd = YDRV_GPIO_PUPD_NONE,     \
+    })
+
+    /**
+     * @brief GPIO端口组句柄结构体
+     * @note 掩码为端口内的绝对位置，读写时按shift对齐到第0位
+     */
+    typedef struct
+    {
+        GPIO_TypeDef *port; /*!< GPIO端口寄存器基地址指针 */
+        uint32_t mask;      /*!< 端口内引脚掩码 */
+        uint8_t shift;      /*!< 组内第0位在端口中的位置 */
+        uint8_t flag;       /*!< 初始化标志 */
+    } yDrvGpioPortHandle_t;
+
+/**
+ * @brief GPIO端口组句柄结构体默认初始化宏
+ */
+#define YDRV_GPIO_PORT_HANDLE_DEFAULT() \
+    ((yDrvGpioPortHandle_t){            \
+        .port = NULL,                   \
+        .mask = 0,                      \
+        .shift = 0,                     \
+        .flag = 0,                      \
     })
     // ==================== GPIO基础函数 ====================
 
@@ -276,6 +334,100 @@ extern "C"
         return yDrvGpioWrite(handle, YDRV_PIN_RESET);
     }
 
+    // ==================== GPIO端口组函数 ====================
+
+    /**
+     * @brief 初始化GPIO端口组
+     * @param config 端口组配置结构体指针
+     * @param handle 端口组句柄结构体指针
+     * @retval yDrv状态
+     * @note 组内引脚一次LL_GPIO_Init配置为相同模式，mask超出端口的16位时返回参数错误
+     */
+    yDrvStatus_t yDrvGpioPortInitStatic(yDrvGpioPortConfig_t *config, yDrvGpioPortHandle_t *handle);
+
+    /**
+     * @brief 反初始化GPIO端口组
+     * @param handle 端口组句柄结构体指针
+     * @retval yDrv状态
+     * @note 组内引脚恢复为模拟模式
+     */
+    yDrvStatus_t yDrvGpioPortDeInitStatic(yDrvGpioPortHandle_t *handle);
+
+    /**
+     * @brief 初始化GPIO端口组配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDrvGpioPortConfigStructInit(yDrvGpioPortConfig_t *config);
+
+    /**
+     * @brief 初始化GPIO端口组句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDrvGpioPortHandleStructInit(yDrvGpioPortHandle_t *handle);
+
+    /**
+     * @brief 写入GPIO端口组（内联优化）
+     * @param handle 已初始化的端口组句柄
+     * @param value 组内数值，第i位对应组内第i个引脚
+     * @retval 无
+     * @note 置位和复位合并为一次BSRR写入，组内引脚同时变化，不影响端口上的其他引脚
+     */
+    YLIB_INLINE void yDrvGpioPortWrite(yDrvGpioPortHandle_t *handle, uint32_t value)
+    {
+        uint32_t bits = (value << handle->shift) & handle->mask;
+
+        handle->port->BSRR = bits | ((handle->mask & ~bits) << 16);
+    }
+
+    /**
+     * @brief 读取GPIO端口组（内联优化）
+     * @param handle 已初始化的端口组句柄
+     * @retval uint32_t 组内数值，一次IDR读取后移位对齐
+     */
+    YLIB_INLINE uint32_t yDrvGpioPortRead(yDrvGpioPortHandle_t *handle)
+    {
+        return (handle->port->IDR & handle->mask) >> handle->shift;
+    }
+
+    /**
+     * @brief 置位GPIO端口组中的指定位（内联优化）
+     * @param handle 已初始化的端口组句柄
+     * @param bits 需要置高的组内位，其余位保持不变
+     * @retval 无
+     */
+    YLIB_INLINE void yDrvGpioPortSetBits(yDrvGpioPortHandle_t *handle, uint32_t bits)
+    {
+        handle->port->BSRR = (bits << handle->shift) & handle->mask;
+    }
+
+    /**
+     * @brief 复位GPIO端口组中的指定位（内联优化）
+     * @param handle 已初始化的端口组句柄
+     * @param bits 需要置低的组内位，其余位保持不变
+     * @retval 无
+     */
+    YLIB_INLINE void yDrvGpioPortClearBits(yDrvGpioPortHandle_t *handle, uint32_t bits)
+    {
+        handle->port->BRR = (bits << handle->shift) & handle->mask;
+    }
+
+    /**
+     * @brief 翻转GPIO端口组中的指定位（内联优化）
+     * @param handle 已初始化的端口组句柄
+     * @param bits 需要翻转的组内位
+     * @retval 无
+     * @note 读输出寄存器后一次BSRR写入，与LL_GPIO_TogglePin相同
+     */
+    YLIB_INLINE void yDrvGpioPortToggleBits(yDrvGpioPortHandle_t *handle, uint32_t bits)
+    {
+        uint32_t toggle = (bits << handle->shift) & handle->mask;
+        uint32_t odr = handle->port->ODR;
+
+        handle->port->BSRR = ((odr & toggle) << 16) | (~odr & toggle);
+    }
+
     // ==================== EXTI中断管理函数 ====================
 
     /**
@@ -306,20 +458,33 @@ extern "C"
 
     /**
      * @brief 注册GPIO中断回调函数
-     * @param pin GPIO引脚编号
-     * @param callback 回调函数
-     * @retval yDrv状态
+     * @param handle GPIO句柄
+     * @param exti 中断配置
+     * @retval yDrv状态，附加回调节点用尽时返回YDRV_BUSY
+     * @note 同一线同一边沿已有回调时加入回调链，按exti->order从小到大执行；
+     *       同一函数和参数重复注册只更新顺序。NVIC优先级以最后一次注册为准
      */
     yDrvStatus_t yDrvGpioRegisterCallback(yDrvGpioHandle_t *handle,
                                           yDrvGpioExtiConfig_t *exti);
 
     /**
      * @brief 注销GPIO中断回调函数
-     * @param pin GPIO引脚编号
+     * @param handle GPIO句柄
+     * @param trigger 边沿
      * @retval yDrv状态
+     * @note 移除该边沿上的全部回调
      */
     yDrvStatus_t yDrvGpioUnregisterCallback(yDrvGpioHandle_t *handle, yDrvGpioExti_t trigger);
 
+    /**
+     * @brief 注销单个GPIO中断回调
+     * @param handle GPIO句柄
+     * @param exti 注册时的配置，按trigger、function和arg匹配
+     * @retval yDrv状态
+     * @note 共享同一线的其他回调不受影响
+     */
+    yDrvStatus_t yDrvGpioUnregisterHandler(yDrvGpioHandle_t *handle, yDrvGpioExtiConfig_t *exti);
+
     /**
      * @brief 清除GPIO外部中断标志
      * @param pin GPIO引脚编号
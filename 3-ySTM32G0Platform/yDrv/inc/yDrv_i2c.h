@@ -0,0 +1,281 @@
+/**
+ * @file yDrv_i2c.h
+ * @brief STM32G0 I2C主机驱动程序头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 提供STM32G0系列MCU I2C1/I2C2主机模式的中断和DMA传输接口
+ *
+ * @par 主要特性:
+ * - 按I2C时钟和总线速率(100k/400k/1MHz)计算TIMINGR，不依赖预先生成的常量
+ * - 一次调用完成"写-重复起始-读"的寄存器访问，任一段可为空，两段都为空时只探测地址
+ * - 超过255字节的传输由NBYTES/RELOAD分段，DMA全程连续搬运，单次最多65535字节
+ * - 短传输走TXIS/RXNE中断，长传输走DMA，每次传输只在分段和结束时进入中断
+ * - 总线错误、仲裁丢失后软件复位外设，SDA被从机拉住时输出9个时钟并补发STOP
+ *
+ * @note 固件库未包含I2C的LL/HAL驱动，寄存器直接按参考手册访问
+ */
+
+#ifndef YDRV_I2C_H
+#define YDRV_I2C_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "stm32g0xx_ll_gpio.h"
+#include "stm32g0xx_ll_bus.h"
+
+#include "yDrv_basic.h"
+#include "yDrv_dma.h"
+
+    // ==================== I2C配置枚举 ====================
+
+    /**
+     * @brief I2C实例ID枚举
+     */
+    typedef enum
+    {
+        YDRV_I2C_1 = 0, /*!< I2C1 */
+        YDRV_I2C_2,     /*!< I2C2 */
+        YDRV_I2C_MAX
+    } yDrvI2cId_t;
+
+    /**
+     * @brief I2C总线速率枚举
+     */
+    typedef enum
+    {
+        YDRV_I2C_SPEED_100K = 100000U, /*!< 标准模式 */
+        YDRV_I2C_SPEED_400K = 400000U, /*!< 快速模式 */
+        YDRV_I2C_SPEED_1M = 1000000U,  /*!< 增强快速模式，同时打开引脚20mA驱动 */
+    } yDrvI2cSpeed_t;
+
+    /**
+     * @brief I2C传输结果枚举
+     */
+    typedef enum
+    {
+        YDRV_I2C_RESULT_OK = 0,    /*!< 传输完成 */
+        YDRV_I2C_RESULT_NACK,      /*!< 地址或数据未应答，已发出STOP */
+        YDRV_I2C_RESULT_BUS_ERROR, /*!< 总线错误(非法START/STOP) */
+        YDRV_I2C_RESULT_ARB_LOST,  /*!< 仲裁丢失 */
+        YDRV_I2C_RESULT_ABORT,     /*!< 被yDrvI2cAbort中止 */
+    } yDrvI2cResult_t;
+
+/**
+ * @brief 单次传输每段最大字节数(DMA长度寄存器16位)
+ */
+#define YDRV_I2C_XFER_MAX (0xFFFFU)
+
+    /**
+     * @brief 传输结束回调函数类型
+     * @param arg 注册时传入的参数
+     * @param result 传输结果
+     * @note 在I2C中断中调用，回调中可以启动下一次传输
+     */
+    typedef void (*yDrvI2cCallback_t)(void *arg, yDrvI2cResult_t result);
+
+    // ==================== I2C配置和句柄结构体 ====================
+
+    /**
+     * @brief I2C配置结构体
+     */
+    typedef struct
+    {
+        yDrvI2cId_t i2cId;             /*!< I2C实例 */
+        yDrvI2cSpeed_t speed;          /*!< 总线速率 */
+        yDrvGpioPin_t scl;             /*!< SCL引脚 */
+        yDrvGpioPin_t sda;             /*!< SDA引脚 */
+        uint32_t pinAF;                /*!< 引脚复用功能编号 */
+        uint8_t pullUp;                /*!< 打开引脚内部上拉，外部无上拉电阻时使用 */
+        uint32_t prio;                 /*!< I2C中断优先级 */
+        uint8_t useDma;                /*!< 1=申请收发DMA通道 */
+        yDrvDmaChannel_t txChannel;    /*!< 发送DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配 */
+        yDrvDmaChannel_t rxChannel;    /*!< 接收DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配 */
+        yDrvDmaPriority_t dmaPriority; /*!< DMA通道优先级 */
+        uint32_t dmaThreshold;         /*!< 单段长度不小于该值时走DMA，较短的走中断 */
+        yDrvI2cCallback_t callback;    /*!< 传输结束回调，可为NULL */
+        void *arg;                     /*!< 回调参数 */
+    } yDrvI2cConfig_t;
+
+    /**
+     * @brief I2C句柄结构体
+     */
+    typedef struct
+    {
+        I2C_TypeDef *instance;      /*!< I2C寄存器指针，NULL表示未初始化 */
+        IRQn_Type IRQ;              /*!< 中断号 */
+        uint32_t timing;            /*!< TIMINGR值 */
+        uint32_t speed;             /*!< 当前总线速率(Hz) */
+        yDrvGpioInfo_t sclInfo;     /*!< SCL引脚信息 */
+        yDrvGpioInfo_t sdaInfo;     /*!< SDA引脚信息 */
+        uint32_t pinAF;             /*!< 引脚复用功能编号 */
+        yDrvDmaHandle_t txDma;      /*!< 发送DMA句柄，未申请时dma为NULL */
+        yDrvDmaHandle_t rxDma;      /*!< 接收DMA句柄，未申请时dma为NULL */
+        uint32_t dmaThreshold;      /*!< DMA长度门限 */
+        yDrvI2cCallback_t callback; /*!< 传输结束回调 */
+        void *arg;                  /*!< 回调参数 */
+        const uint8_t *txBuf;       /*!< 写段数据 */
+        uint8_t *rxBuf;             /*!< 读段缓冲区 */
+        uint32_t txLen;             /*!< 写段字节数 */
+        uint32_t rxLen;             /*!< 读段字节数 */
+        uint32_t remain;            /*!< 当前段尚未编入NBYTES的字节数 */
+        uint16_t addr;              /*!< 7位从机地址 */
+        uint8_t i2cId;              /*!< I2C实例 yDrvI2cId_t */
+        uint8_t dmaOn;              /*!< 当前段使用DMA */
+        volatile uint8_t phase;     /*!< 传输阶段，0表示空闲 */
+        volatile uint8_t result;    /*!< 最近一次传输结果 yDrvI2cResult_t */
+    } yDrvI2cHandle_t;
+
+// ==================== I2C初始化宏定义 ====================
+
+/**
+ * @brief I2C配置结构体默认初始化宏
+ * @note 默认I2C1，400kHz，PB8/PB9，不使用DMA
+ */
+#define YDRV_I2C_CONFIG_DEFAULT()                \
+    ((yDrvI2cConfig_t){                          \
+        .i2cId = YDRV_I2C_1,                     \
+        .speed = YDRV_I2C_SPEED_400K,            \
+        .scl = YDRV_PINB8,                       \
+        .sda = YDRV_PINB9,                       \
+        .pinAF = 6,                              \
+        .pullUp = 0,                             \
+        .prio = 2,                               \
+        .useDma = 0,                             \
+        .txChannel = YDRV_DMA_CHANNEL_AUTO,      \
+        .rxChannel = YDRV_DMA_CHANNEL_AUTO,      \
+        .dmaPriority = YDRV_DMA_PRIORITY_MEDIUM, \
+        .dmaThreshold = 16,                      \
+        .callback = NULL,                        \
+        .arg = NULL,                             \
+    })
+
+/**
+ * @brief I2C句柄结构体默认初始化宏
+ */
+#define YDRV_I2C_HANDLE_DEFAULT()           \
+    ((yDrvI2cHandle_t){                     \
+        .instance = NULL,                   \
+        .timing = 0,                        \
+        .speed = 0,                         \
+        .txDma = YDRV_DMA_HANDLE_DEFAULT(), \
+        .rxDma = YDRV_DMA_HANDLE_DEFAULT(), \
+        .callback = NULL,                   \
+        .arg = NULL,                        \
+        .i2cId = YDRV_I2C_MAX,              \
+        .phase = 0,                         \
+        .result = YDRV_I2C_RESULT_OK,       \
+    })
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 初始化I2C主机
+     * @param config 配置参数指针
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 初始化状态
+     *         - YDRV_OK: 初始化成功
+     *         - YDRV_BUSY: 该实例已被其他句柄使用或DMA通道不可用
+     *         - YDRV_INVALID_PARAM: 实例或引脚无效，I2C时钟过低无法达到指定速率
+     */
+    yDrvStatus_t yDrvI2cInitStatic(const yDrvI2cConfig_t *config, yDrvI2cHandle_t *handle);
+
+    /**
+     * @brief 反初始化I2C主机
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 反初始化状态
+     * @note 中止进行中的传输(不调用回调)，释放DMA通道，引脚恢复为模拟模式
+     */
+    yDrvStatus_t yDrvI2cDeInitStatic(yDrvI2cHandle_t *handle);
+
+    /**
+     * @brief 初始化I2C配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDrvI2cConfigStructInit(yDrvI2cConfig_t *config);
+
+    /**
+     * @brief 初始化I2C句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDrvI2cHandleStructInit(yDrvI2cHandle_t *handle);
+
+    /**
+     * @brief 计算TIMINGR
+     * @param clock I2C内核时钟(Hz)
+     * @param speed 总线速率
+     * @param timing 输出TIMINGR值
+     * @retval yDrvStatus_t YDRV_OK或时钟过低YDRV_INVALID_PARAM
+     * @note 按规范的SCL高低电平最小时间、数据建立和保持时间，取满足要求的最小预分频
+     */
+    yDrvStatus_t yDrvI2cCalcTiming(uint32_t clock, yDrvI2cSpeed_t speed, uint32_t *timing);
+
+    /**
+     * @brief 运行时修改总线速率
+     * @param handle 句柄指针
+     * @param speed 总线速率
+     * @retval yDrvStatus_t 操作状态，传输进行中返回YDRV_BUSY
+     */
+    yDrvStatus_t yDrvI2cSetSpeed(yDrvI2cHandle_t *handle, yDrvI2cSpeed_t speed);
+
+    /**
+     * @brief 启动一次主机传输
+     * @param handle 句柄指针
+     * @param addr 7位从机地址
+     * @param txBuf 写段数据，txLen为0时可为NULL
+     * @param txLen 写段字节数(0~65535)
+     * @param rxBuf 读段缓冲区，rxLen为0时可为NULL
+     * @param rxLen 读段字节数(0~65535)
+     * @retval yDrvStatus_t 启动状态
+     *         - YDRV_OK: 已启动，结束时调用回调
+     *         - YDRV_BUSY: 上一次传输未结束或总线被占用
+     *         - YDRV_INVALID_PARAM: 参数无效
+     * @note 两段都不为空时写段结束后发重复起始进入读段，中间不释放总线；
+     *       缓冲区在回调之前必须保持有效
+     */
+    yDrvStatus_t yDrvI2cTransfer(yDrvI2cHandle_t *handle, uint16_t addr,
+                                 const uint8_t *txBuf, uint32_t txLen,
+                                 uint8_t *rxBuf, uint32_t rxLen);
+
+    /**
+     * @brief 中止进行中的传输
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     * @note 关闭中断和DMA请求并软件复位外设，不调用回调；用于超时处理
+     */
+    yDrvStatus_t yDrvI2cAbort(yDrvI2cHandle_t *handle);
+
+    /**
+     * @brief 总线恢复
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t YDRV_OK: SDA已释放；YDRV_ERROR: 9个时钟后SDA仍为低
+     * @note 中止传输，引脚临时切换为开漏输出，SDA为低时最多输出9个SCL时钟，再补发STOP，
+     *       最后恢复复用功能并软件复位外设；忙等待约100微秒，只能在任务中调用
+     */
+    yDrvStatus_t yDrvI2cRecover(yDrvI2cHandle_t *handle);
+
+    // ==================== 内联函数 ====================
+
+    /**
+     * @brief 查询传输是否进行中
+     * @param handle 句柄指针
+     * @retval uint32_t 1=进行中，0=空闲
+     */
+    YLIB_INLINE uint32_t yDrvI2cIsBusy(yDrvI2cHandle_t *handle)
+    {
+        return (handle->phase != 0U) ? 1U : 0U;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_I2C_H */
@@ -0,0 +1,171 @@
+/**
+ * @file yDrv_mpu.h
+ * @brief STM32G0 MPU驱动程序头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 按地址范围和访问权限生成ARMv6-M PMSA区域寄存器值，提供整组装载接口，
+ * 供任务切换时以最少的寄存器写入更换任务自己的区域
+ *
+ * @par 区域分配:
+ * - 区域0~3：全局区域，启动时设置一次，例如把DMA缓冲区设为只读、把外设窗口设为禁止访问
+ * - 区域4~7：任务区域组，任务切换时整组装载；编号大的区域优先，可以重新开放全局区域禁止的范围，
+ *   区域7固定用于堆栈保护
+ * - 未被任何区域覆盖的地址使用特权默认映射，即不设置区域时行为与关闭MPU相同
+ *
+ * @par 使用约束:
+ * - 任务都以特权级运行，权限只区分禁止访问、只读、读写
+ * - 区域对中断同样生效：全局只读的缓冲区在中断中也不能由CPU写入，DMA不受MPU限制
+ * - M0+的MPU故障升级为HardFault，由yDrv_fault记录；HardFault处理期间MPU不生效
+ * - 区域最小256字节，256字节及以上的区域可以按1/8关闭子区域，因此任意32字节对齐、
+ *   长度为32字节整数倍、且不跨越所在256字节以上对齐块的范围都可以用一个区域描述
+ */
+
+#ifndef YDRV_MPU_H
+#define YDRV_MPU_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDrv_basic.h"
+
+// ==================== 宏定义 ====================
+
+/**
+ * @brief 全局区域数
+ */
+#define YDRV_MPU_GLOBAL_REGIONS (4U)
+
+/**
+ * @brief 任务区域组的区域数
+ */
+#define YDRV_MPU_SET_REGIONS (4U)
+
+/**
+ * @brief 任务区域组的起始区域编号
+ */
+#define YDRV_MPU_SET_BASE (YDRV_MPU_GLOBAL_REGIONS)
+
+/**
+ * @brief 堆栈保护使用的任务区域(区域组内序号)
+ */
+#define YDRV_MPU_SET_GUARD (YDRV_MPU_SET_REGIONS - 1U)
+
+/**
+ * @brief 堆栈保护区大小(字节)
+ * @note 子区域的最小粒度
+ */
+#define YDRV_MPU_GUARD_SIZE (32U)
+
+#define YDRV_MPU_ATTR_NORMAL (0U)  /*!< 普通存储器(SRAM/Flash) */
+#define YDRV_MPU_ATTR_DEVICE (1U)  /*!< 外设，共享设备存储器 */
+#define YDRV_MPU_ATTR_XN (2U)      /*!< 禁止取指 */
+
+    // ==================== 类型定义 ====================
+
+    /**
+     * @brief 访问权限枚举
+     */
+    typedef enum
+    {
+        YDRV_MPU_NO_ACCESS = 0,  /*!< 禁止访问 */
+        YDRV_MPU_READ_ONLY,      /*!< 只读 */
+        YDRV_MPU_READ_WRITE,     /*!< 读写 */
+    } yDrvMpuAccess_t;
+
+    /**
+     * @brief 区域寄存器值
+     * @note rbar含VALID位和区域编号，写入时同时选择区域，不需要另写RNR；rasr为0表示关闭
+     */
+    typedef struct
+    {
+        uint32_t rbar; /*!< 基址寄存器值 */
+        uint32_t rasr; /*!< 属性和大小寄存器值 */
+    } yDrvMpuRegion_t;
+
+    /**
+     * @brief 任务区域组
+     * @note 对应区域4~7，任务切换时整组写入
+     */
+    typedef struct
+    {
+        yDrvMpuRegion_t region[YDRV_MPU_SET_REGIONS]; /*!< 区域寄存器值 */
+    } yDrvMpuSet_t;
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 生成区域寄存器值
+     * @param region 输出的寄存器值
+     * @param number 区域编号(0~7)
+     * @param base 起始地址，32字节对齐
+     * @param size 长度(字节)，32字节整数倍；为0时生成关闭的区域
+     * @param access 访问权限
+     * @param attr YDRV_MPU_ATTR_xxx组合
+     * @retval yDrv状态
+     * @note 选择能容纳范围的最小对齐块，以子区域精确覆盖范围；
+     *       范围不能用一个区域精确描述时返回YDRV_INVALID_PARAM
+     */
+    yDrvStatus_t yDrvMpuRegionMake(yDrvMpuRegion_t *region, uint32_t number, uint32_t base, uint32_t size,
+                                   yDrvMpuAccess_t access, uint32_t attr);
+
+    /**
+     * @brief 生成堆栈保护区域
+     * @param region 输出的寄存器值，区域编号为YDRV_MPU_SET_BASE + YDRV_MPU_SET_GUARD
+     * @param stack 堆栈起始(最低)地址
+     * @param size 堆栈大小(字节)
+     * @retval yDrv状态
+     * @note 保护区是堆栈底部第一个32字节对齐的32字节，只读：越界写入立即进入HardFault，
+     *       FreeRTOS的溢出检查和堆栈水位统计仍可读取底部的填充值
+     */
+    yDrvStatus_t yDrvMpuGuardMake(yDrvMpuRegion_t *region, const void *stack, uint32_t size);
+
+    /**
+     * @brief 把区域组清为全部关闭
+     * @param set 区域组
+     */
+    void yDrvMpuSetClear(yDrvMpuSet_t *set);
+
+    /**
+     * @brief 写入一个区域
+     * @param region 区域寄存器值
+     */
+    void yDrvMpuWrite(const yDrvMpuRegion_t *region);
+
+    /**
+     * @brief 使能/关闭MPU
+     * @param enable 1使能，0关闭
+     * @note 使能时开启特权默认映射，未被区域覆盖的地址照常访问；HardFault和NMI中不启用区域
+     */
+    void yDrvMpuEnable(uint32_t enable);
+
+    /**
+     * @brief 装载任务区域组
+     * @param set 区域组
+     * @note 在任务切换中调用，八次寄存器写入和一次DSB；PendSV异常返回时生效
+     */
+    YLIB_INLINE void yDrvMpuLoadSet(const yDrvMpuSet_t *set)
+    {
+        const yDrvMpuRegion_t *region = set->region;
+
+        MPU->RBAR = region[0].rbar;
+        MPU->RASR = region[0].rasr;
+        MPU->RBAR = region[1].rbar;
+        MPU->RASR = region[1].rasr;
+        MPU->RBAR = region[2].rbar;
+        MPU->RASR = region[2].rasr;
+        MPU->RBAR = region[3].rbar;
+        MPU->RASR = region[3].rasr;
+        __DSB();
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_MPU_H */
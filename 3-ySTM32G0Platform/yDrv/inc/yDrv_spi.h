@@ -30,6 +30,25 @@ extern "C"
 #include "stm32g0xx_ll_bus.h"
 
 #include "yDrv_basic.h"
+#include "yDrv_dma.h"
+
+    // ==================== SPI编译配置 ====================
+
+    /**
+     * @brief 软件模拟SPI传输函数放入RAM执行
+     * @note 1=放入.RamFunc段，避开Flash等待周期，换取确定的SCK时序
+     */
+#ifndef YDRV_SPI_SOFT_RAM
+#define YDRV_SPI_SOFT_RAM (0)
+#endif
+
+    /**
+     * @brief 阻塞模式DMA传输的最长等待时间(毫秒)
+     * @note 超时后中止传输并返回YDRV_TIMEOUT；需要SysTick中断推进毫秒计数
+     */
+#ifndef YDRV_SPI_DMA_TIMEOUT_MS
+#define YDRV_SPI_DMA_TIMEOUT_MS (100U)
+#endif
 
     // ==================== SPI配置枚举 ====================
 
@@ -92,6 +111,28 @@ extern "C"
         YDRV_SPI_CS_HARD_OUTPUT = LL_SPI_NSS_HARD_OUTPUT
     } yDrvSpiCsMode_t;
 
+    /**
+     * @brief SPI片选控制策略
+     * @note 由yDrvSpiInitStatic根据csMode和引脚配置选定，yDrvSpiCsControl按策略切换片选:
+     *       - SOFT: GPIO片选，BSRR单次写入，选中/取消各一次总线写(约2个CPU周期)
+     *       - HARD: 硬件NSS输出，片选跟随SPE，选中时置位SPE，取消时等待BSY清零后关闭SPI；
+     *               NSS拉低到首个SCK沿约半个SCK周期，末个SCK沿到NSS拉高不少于一个APB周期
+     *       - NONE: 不控制片选(从机模式、硬件NSS输入或未配置片选引脚)
+     */
+    typedef enum
+    {
+        YDRV_SPI_CS_CTRL_NONE = 0, /*!< 不控制片选 */
+        YDRV_SPI_CS_CTRL_SOFT,     /*!< GPIO软件片选 */
+        YDRV_SPI_CS_CTRL_HARD,     /*!< 硬件NSS输出，随SPE切换 */
+    } yDrvSpiCsCtrl_t;
+
+    /**
+     * @brief yDrvSpiCsControl的片选状态
+     * @note 所有策略下传输都须在SELECT和DESELECT之间进行：硬件NSS时SPE只在选中期间打开
+     */
+#define YDRV_SPI_CS_SELECT (0U)   /*!< 选中 */
+#define YDRV_SPI_CS_DESELECT (1U) /*!< 取消选中 */
+
     /**
      * @brief SPI波特率分频系数
      */
@@ -116,6 +157,66 @@ extern "C"
         YDRV_SPI_BITORDER_LSB = LL_SPI_LSB_FIRST
     } yDrvSpiBitOrder_t;
 
+    // ==================== SPI DMA传输结构体 ====================
+
+    /**
+     * @brief SPI DMA传输完成回调函数类型
+     * @param arg 注册时传入的参数
+     * @param status 传输结果，YDRV_OK表示成功，YDRV_ERROR表示DMA传输错误
+     * @note 在DMA中断上下文中调用
+     */
+    typedef void (*yDrvSpiDmaCallback_t)(void *arg, yDrvStatus_t status);
+
+    /**
+     * @brief SPI传输分段描述符
+     * @note 多个分段在同一片选周期内首尾相接传输，用于命令+地址+数据不拷贝拼接
+     */
+    typedef struct
+    {
+        const void *tx; /*!< 发送缓冲区，NULL表示发送0xFF填充 */
+        void *rx;       /*!< 接收缓冲区，NULL表示丢弃接收数据 */
+        uint32_t len;   /*!< 分段字节数(16位帧时为偶数) */
+    } yDrvSpiSeg_t;
+
+    /**
+     * @brief SPI DMA传输引擎状态结构体
+     */
+    typedef struct
+    {
+        yDrvDmaHandle_t rx;            /*!< 接收DMA通道句柄 */
+        yDrvDmaHandle_t tx;            /*!< 发送DMA通道句柄 */
+        yDrvSpiDmaCallback_t callback; /*!< 完成回调函数 */
+        void *arg;                     /*!< 完成回调参数 */
+        uint32_t frames;               /*!< 当前分段帧数 */
+        const yDrvSpiSeg_t *seg;       /*!< 分段链表(数组) */
+        uint32_t segCount;             /*!< 分段数量 */
+        uint32_t segIndex;             /*!< 当前分段索引 */
+        yDrvSpiSeg_t single;           /*!< 单段传输使用的内部描述符 */
+        volatile uint8_t busy;         /*!< 传输进行中标志 */
+        volatile uint8_t status;       /*!< 最近一次传输结果 yDrvStatus_t */
+        uint8_t flagReady;             /*!< DMA通道已配置标志 */
+        uint16_t txDummy;              /*!< 发送缓冲为NULL时发送的填充数据 */
+        uint16_t rxDummy;              /*!< 接收缓冲为NULL时的丢弃目标 */
+        void *rxSink;                  /*!< 接收缓冲为NULL时的写入目标(不递增)，NULL时丢弃到rxDummy */
+    } yDrvSpiDma_t;
+
+    /**
+     * @brief SPI中断传输状态结构体
+     * @note 完成回调与DMA传输共用yDrvSpiDmaCallback_t类型
+     */
+    typedef struct
+    {
+        const uint8_t *tx;             /*!< 发送数据指针，NULL表示发送0xFF填充 */
+        uint8_t *rx;                   /*!< 接收数据指针，NULL表示丢弃 */
+        volatile uint32_t txRemain;    /*!< 剩余待发送帧数 */
+        volatile uint32_t rxRemain;    /*!< 剩余待接收帧数 */
+        yDrvSpiDmaCallback_t callback; /*!< 完成回调函数 */
+        void *arg;                     /*!< 完成回调参数 */
+        volatile uint8_t busy;         /*!< 传输进行中标志 */
+        volatile uint8_t status;       /*!< 最近一次传输结果 yDrvStatus_t */
+        uint8_t flagReady;             /*!< 中断已注册标志 */
+    } yDrvSpiIt_t;
+
     // ==================== SPI配置和句柄结构体 ====================
 
     /**
@@ -144,8 +245,30 @@ extern "C"
         uint32_t misoAF;
         uint32_t mosiAF;
         uint32_t csAF;
+
+        uint8_t nssPulse; /*!< 硬件NSS输出时连续帧之间产生NSS脉冲(仅CPHA=0)，0=禁用 */
+        uint8_t csSetup;  /*!< 片选拉低后到首帧前的延时循环次数(每次约4个CPU周期) */
+        uint8_t csHold;   /*!< 末帧结束后到片选拉高前的延时循环次数(每次约4个CPU周期) */
     } yDrvSpiConfig_t;
 
+    /**
+     * @brief 软件模拟SPI状态结构体
+     * @note 引脚操作全部预先换算为BSRR写入值，传输循环内只有寄存器读写
+     */
+    typedef struct
+    {
+        GPIO_TypeDef *sckPort;  /*!< SCK端口 */
+        GPIO_TypeDef *mosiPort; /*!< MOSI端口 */
+        GPIO_TypeDef *misoPort; /*!< MISO端口 */
+        uint32_t sckLead;       /*!< SCK前沿BSRR写入值 */
+        uint32_t sckTrail;      /*!< SCK后沿(回到空闲电平)BSRR写入值 */
+        uint32_t mosiWord;      /*!< MOSI清零BSRR写入值，右移16位即置位值 */
+        uint32_t misoMask;      /*!< MISO引脚掩码，未配置MISO时为0(读到0) */
+        uint8_t delay;          /*!< SCK半周期延时循环次数 */
+        uint8_t cpha;           /*!< 0=前沿采样，1=后沿采样 */
+        uint8_t lsbFirst;       /*!< 低位先传输标志 */
+    } yDrvSpiSoft_t;
+
     /**
      * @brief SPI句柄结构体
      */
@@ -159,7 +282,12 @@ extern "C"
         yDrvGpioInfo_t mosiPinInfo;
         yDrvGpioInfo_t csPinInfo;
         uint8_t flagBtyeSend;
-        uint8_t flagCsControl; /*!< CS控制标志，0表示软件控制CS，1表示硬件控制CS */
+        uint8_t csCtrl;        /*!< 片选控制策略 yDrvSpiCsCtrl_t */
+        uint8_t csSetup;       /*!< 片选建立延时循环次数 */
+        uint8_t csHold;        /*!< 片选保持延时循环次数 */
+        yDrvSpiDma_t dma;      /*!< DMA传输引擎状态 */
+        yDrvSpiIt_t it;        /*!< 中断传输状态 */
+        yDrvSpiSoft_t soft;    /*!< 软件模拟SPI状态(spiId为YDRV_SPI_SOFT时有效) */
 
     } yDrvSpiHandle_t;
 
@@ -194,8 +322,226 @@ extern "C"
      */
     void yDrvSpiHandleStructInit(yDrvSpiHandle_t *handle);
 
+    /**
+     * @brief 修改SPI时钟模式和速率
+     * @param handle SPI句柄指针
+     * @param polarity 时钟极性
+     * @param phase 时钟相位
+     * @param speed 速率等级
+     * @retval yDrv状态
+     *         - YDRV_OK: 已生效
+     *         - YDRV_BUSY: DMA或中断传输进行中
+     * @note 等待发送FIFO排空和BSY清零后关闭SPI修改CR1，再重新使能；
+     *       用于多个器件共享同一SPI总线时切换器件参数
+     * @note 软件模拟SPI时只更新SCK边沿和半周期延时，SCK立即回到新的空闲电平
+     */
+    yDrvStatus_t yDrvSpiSetFormat(yDrvSpiHandle_t *handle,
+                                  yDrvSpiClockPolarity_t polarity,
+                                  yDrvSpiClockPhase_t phase,
+                                  yDrvSpiSpeedLevel_t speed);
+
+    /**
+     * @brief 挂起SPI，关闭外设时钟
+     * @param handle SPI句柄指针
+     * @retval yDrv状态
+     *         - YDRV_OK: 已关闭时钟
+     *         - YDRV_BUSY: DMA或中断传输进行中
+     * @note 等待最后一帧发送完成后关闭RCC时钟，寄存器配置在关闭时钟期间保持；
+     *       软件模拟SPI没有外设时钟，直接返回YDRV_OK
+     */
+    yDrvStatus_t yDrvSpiSuspend(yDrvSpiHandle_t *handle);
+
+    /**
+     * @brief 恢复SPI，重新打开外设时钟
+     * @param handle SPI句柄指针
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvSpiResume(yDrvSpiHandle_t *handle);
+
+    /**
+     * @brief 复位SPI外设并恢复配置
+     * @param handle SPI句柄指针
+     * @retval yDrv状态
+     * @note 通过RCC复位清空收发FIFO(关闭SPE不会清空发送FIFO)，随后恢复CR1/CR2/CRCPR；
+     *       从机模式下用于丢弃上一帧未发出的预装数据，DMA请求使能位一并恢复
+     */
+    yDrvStatus_t yDrvSpiFlush(yDrvSpiHandle_t *handle);
+
+    // ==================== SPI DMA配置函数 ====================
+
+    /**
+     * @brief 配置SPI DMA发送
+     * @param handle SPI句柄指针
+     * @param channel DMA通道指针
+     * @retval yDrv状态
+     * @note 设置外设地址和DMAMUX请求后立即使能TXDMAEN，调用前DMA通道应处于关闭状态
+     */
+    yDrvStatus_t yDrvSpiDmaWrite(yDrvSpiHandle_t *handle, yDrvDmaChannel_t *channel);
+
+    /**
+     * @brief 配置SPI DMA接收
+     * @param handle SPI句柄指针
+     * @param channel DMA通道指针
+     * @retval yDrv状态
+     * @note 设置外设地址和DMAMUX请求后立即使能RXDMAEN，调用前DMA通道应处于关闭状态
+     */
+    yDrvStatus_t yDrvSpiDmaRead(yDrvSpiHandle_t *handle, yDrvDmaChannel_t *channel);
+
+    /**
+     * @brief 配置SPI全双工DMA传输引擎
+     * @param handle SPI句柄指针
+     * @param rxChannel 接收DMA通道，可为YDRV_DMA_CHANNEL_AUTO
+     * @param txChannel 发送DMA通道，可为YDRV_DMA_CHANNEL_AUTO
+     * @param prio DMA中断优先级
+     * @retval yDrv状态
+     * @note 接收通道优先级高于发送通道，注册接收TC和收发TE中断
+     */
+    yDrvStatus_t yDrvSpiDmaInit(yDrvSpiHandle_t *handle,
+                                yDrvDmaChannel_t rxChannel,
+                                yDrvDmaChannel_t txChannel,
+                                uint32_t prio);
+
+    /**
+     * @brief 释放SPI DMA传输引擎
+     * @param handle SPI句柄指针
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvSpiDmaDeInit(yDrvSpiHandle_t *handle);
+
+    /**
+     * @brief 启动SPI全双工DMA传输
+     * @param handle SPI句柄指针
+     * @param tx 发送缓冲区，NULL表示发送0xFF填充
+     * @param rx 接收缓冲区，NULL表示丢弃接收数据
+     * @param len 传输字节数(16位帧时为偶数)，单次不超过65535帧
+     * @param callback 完成回调，NULL表示阻塞等待传输结束
+     * @param arg 完成回调参数
+     * @retval yDrv状态
+     *         - YDRV_OK: 已启动(回调模式)或已完成(阻塞模式)
+     *         - YDRV_BUSY: 上一次传输未结束
+     *         - YDRV_NOT_INITIALIZED: 未调用yDrvSpiDmaInit
+     *         - YDRV_INVALID_PARAM: 长度无效
+     *         - YDRV_ERROR: SPI未使能(硬件NSS片选未选中)
+     *         - YDRV_TIMEOUT: 阻塞模式超过YDRV_SPI_DMA_TIMEOUT_MS未完成，传输已中止
+     * @note 片选由调用者控制，回调中已关闭DMA请求并清空接收FIFO
+     */
+    yDrvStatus_t yDrvSpiTransferDma(yDrvSpiHandle_t *handle,
+                                    const void *tx,
+                                    void *rx,
+                                    uint32_t len,
+                                    yDrvSpiDmaCallback_t callback,
+                                    void *arg);
+
+    /**
+     * @brief 启动SPI分段DMA传输
+     * @param handle SPI句柄指针
+     * @param seg 分段描述符数组，传输完成前必须保持有效
+     * @param count 分段数量
+     * @param callback 完成回调，全部分段完成后在DMA中断中调用；为NULL时阻塞等待完成
+     * @param arg 完成回调参数
+     * @retval yDrv状态，阻塞模式超过YDRV_SPI_DMA_TIMEOUT_MS时中止传输并返回YDRV_TIMEOUT
+     * @note 每段接收完成中断中立即装载下一段，分段间无数据拷贝；
+     *       片选由调用者在整条链前后控制
+     */
+    yDrvStatus_t yDrvSpiTransferDmaSg(yDrvSpiHandle_t *handle,
+                                      const yDrvSpiSeg_t *seg,
+                                      uint32_t count,
+                                      yDrvSpiDmaCallback_t callback,
+                                      void *arg);
+
+    /**
+     * @brief 中止SPI DMA传输
+     * @param handle SPI句柄指针
+     * @retval uint32_t 中止时尚未接收的字节数
+     * @note 用于调用者等待超时，不调用完成回调
+     */
+    uint32_t yDrvSpiTransferDmaAbort(yDrvSpiHandle_t *handle);
+
+    /**
+     * @brief 查询SPI DMA传输是否进行中（内联优化）
+     * @param handle SPI句柄指针
+     * @retval 1=进行中, 0=空闲
+     */
+    YLIB_INLINE uint8_t yDrvSpiTransferDmaIsBusy(yDrvSpiHandle_t *handle)
+    {
+        return handle->dma.busy;
+    }
+
+    /**
+     * @brief 设置DMA接收写入目标（内联优化）
+     * @param handle SPI句柄指针
+     * @param sink 接收缓冲为NULL的分段写入的固定地址，如CRC数据寄存器；NULL恢复丢弃
+     * @note 只影响之后启动的分段，持有总线期间设置，释放总线前恢复为NULL
+     */
+    YLIB_INLINE void yDrvSpiDmaSetRxSink(yDrvSpiHandle_t *handle, void *sink)
+    {
+        handle->dma.rxSink = sink;
+    }
+
+    // ==================== SPI中断传输函数 ====================
+
+    /**
+     * @brief 注册SPI中断传输
+     * @param handle SPI句柄指针
+     * @param prio SPI中断优先级
+     * @retval yDrv状态
+     * @note 每个SPI实例同一时刻只能登记一个句柄
+     */
+    yDrvStatus_t yDrvSpiItInit(yDrvSpiHandle_t *handle, uint32_t prio);
+
+    /**
+     * @brief 注销SPI中断传输
+     * @param handle SPI句柄指针
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvSpiItDeInit(yDrvSpiHandle_t *handle);
+
+    /**
+     * @brief 启动SPI中断驱动传输
+     * @param handle SPI句柄指针
+     * @param tx 发送缓冲区，NULL表示发送0xFF填充
+     * @param rx 接收缓冲区，NULL表示丢弃接收数据
+     * @param len 传输字节数(16位帧时为偶数)
+     * @param callback 完成回调，在SPI中断中调用，可为NULL
+     * @param arg 完成回调参数
+     * @retval yDrv状态
+     *         - YDRV_OK: 已启动
+     *         - YDRV_BUSY: 上一次传输未结束
+     *         - YDRV_NOT_INITIALIZED: 未调用yDrvSpiItInit
+     *         - YDRV_ERROR: SPI未使能(硬件NSS片选未选中)
+     * @note RXNE/TXE中断逐帧搬运，发送最多领先接收两帧，避免接收FIFO溢出
+     */
+    yDrvStatus_t yDrvSpiTransferIt(yDrvSpiHandle_t *handle,
+                                   const void *tx,
+                                   void *rx,
+                                   uint32_t len,
+                                   yDrvSpiDmaCallback_t callback,
+                                   void *arg);
+
+    /**
+     * @brief 中止SPI中断传输
+     * @param handle SPI句柄指针
+     * @retval uint32_t 中止时尚未接收的字节数
+     * @note 不调用完成回调
+     */
+    uint32_t yDrvSpiTransferItAbort(yDrvSpiHandle_t *handle);
+
     // ==================== SPI数据传输函数 ====================
 
+    /**
+     * @brief SPI轮询批量传输（阻塞）
+     * @param handle SPI句柄指针
+     * @param tx 发送缓冲区，NULL表示发送0xFF填充
+     * @param rx 接收缓冲区，NULL表示丢弃接收数据
+     * @param len 传输字节数(16位帧时为偶数)
+     * @retval uint32_t 实际传输的字节数
+     * @note 8位帧时按16位访问DR一次搬运两帧(数据打包)，接收阈值临时切换为半满；
+     *       发送FIFO最多领先接收YDRV_SPI_PACK_AHEAD字节，接收FIFO不会溢出
+     * @note 主机模式下每次发送必然产生接收，SPI未使能时直接返回0
+     * @note 软件模拟SPI时由GPIO逐位收发，8位展开，速率由速率等级换算的半周期延时决定
+     */
+    uint32_t yDrvSpiTransferPolled(yDrvSpiHandle_t *handle, const void *tx, void *rx, uint32_t len);
+
     /**
      * @brief 发送单个字节（非阻塞，内联优化）
      * @param handle SPI句柄指针
@@ -248,30 +594,61 @@ extern "C"
     }
 
     /**
-     * @brief 接收单个字节（非阻塞，内联优化）
-     * @param handle USART句柄指针
-     * @param pData 接收数据指针
-     * @retval yDrv状态
+     * @brief 片选建立/保持延时（内联优化）
+     * @param loops 延时循环次数
+     * @retval 无
      */
-    YLIB_INLINE yDrvStatus_t yDrvSpiCsControl(yDrvSpiHandle_t *handle, uint8_t state)
+    YLIB_INLINE void yDrvSpiCsDelay(uint8_t loops)
     {
-        if (handle->flagCsControl == 0)
+        while (loops-- != 0)
         {
-            return YDRV_OK;
-        }
-
-        if (handle == NULL || handle->csPinInfo.flag == 0)
-        {
-            return YDRV_INVALID_PARAM;
+            __NOP();
         }
+    }
 
-        if (state == 0)
+    /**
+     * @brief 切换片选（内联优化）
+     * @param handle SPI句柄指针
+     * @param state 片选状态，YDRV_SPI_CS_SELECT或YDRV_SPI_CS_DESELECT
+     * @retval yDrv状态
+     * @note 按句柄的片选策略执行，策略在初始化时确定，这里不再做参数检查
+     */
+    YLIB_INLINE yDrvStatus_t yDrvSpiCsControl(yDrvSpiHandle_t *handle, uint8_t state)
+    {
+        if (handle->csCtrl == YDRV_SPI_CS_CTRL_SOFT)
         {
-            LL_GPIO_ResetOutputPin(handle->csPinInfo.port, handle->csPinInfo.pinMask);
+            // BSRR低16位置位、高16位复位，单次写入完成切换
+            if (state == YDRV_SPI_CS_SELECT)
+            {
+                handle->csPinInfo.port->BSRR = (uint32_t)handle->csPinInfo.pinMask << 16;
+                yDrvSpiCsDelay(handle->csSetup);
+            }
+            else
+            {
+                yDrvSpiCsDelay(handle->csHold);
+                handle->csPinInfo.port->BSRR = (uint32_t)handle->csPinInfo.pinMask;
+            }
         }
-        else
+        else if (handle->csCtrl == YDRV_SPI_CS_CTRL_HARD)
         {
-            LL_GPIO_SetOutputPin(handle->csPinInfo.port, handle->csPinInfo.pinMask);
+            // 硬件NSS跟随SPE，关闭前须等待最后一帧移出，关闭后丢弃接收FIFO残留
+            if (state == YDRV_SPI_CS_SELECT)
+            {
+                SET_BIT(handle->instance->CR1, SPI_CR1_SPE);
+                yDrvSpiCsDelay(handle->csSetup);
+            }
+            else
+            {
+                while (READ_BIT(handle->instance->SR, SPI_SR_FTLVL | SPI_SR_BSY) != 0)
+                {
+                }
+                yDrvSpiCsDelay(handle->csHold);
+                CLEAR_BIT(handle->instance->CR1, SPI_CR1_SPE);
+                while (READ_BIT(handle->instance->SR, SPI_SR_FRLVL) != 0)
+                {
+                    (void)*((__IO uint8_t *)&handle->instance->DR);
+                }
+            }
         }
 
         return YDRV_OK;
@@ -300,6 +677,17 @@ extern "C"
         return LL_SPI_IsActiveFlag_RXNE(handle->instance) ? YDRV_OK : YDRV_BUSY;
     }
 
+    /**
+     * @brief 检查接收FIFO是否为空
+     * @param handle SPI句柄指针
+     * @retval YDRV_OK=FIFO为空, YDRV_BUSY=FIFO中仍有数据
+     * @note 接收DMA运行时用于等待FIFO中的残留帧被DMA取走
+     */
+    YLIB_INLINE yDrvStatus_t yDrvSpiIsRxFifoEmpty(yDrvSpiHandle_t *handle)
+    {
+        return (LL_SPI_GetRxFIFOLevel(handle->instance) == LL_SPI_RX_FIFO_EMPTY) ? YDRV_OK : YDRV_BUSY;
+    }
+
     /**
      * @brief 检查SPI总线是否忙碌
      * @param handle SPI句柄指针
@@ -332,6 +720,18 @@ extern "C"
         LL_SPI_Disable(handle->instance);
     }
 
+    /**
+     * @brief 关闭SPI的DMA收发请求（内联优化）
+     * @param handle SPI句柄指针
+     * @retval 无
+     * @note DMA传输结束后调用，恢复轮询收发模式
+     */
+    YLIB_INLINE void yDrvSpiDmaStop(yDrvSpiHandle_t *handle)
+    {
+        LL_SPI_DisableDMAReq_TX(handle->instance);
+        LL_SPI_DisableDMAReq_RX(handle->instance);
+    }
+
     /**
      * @brief 检查SPI句柄是否有效（内联优化）
      * @param handle SPI句柄指针
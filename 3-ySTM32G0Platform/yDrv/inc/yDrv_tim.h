@@ -0,0 +1,451 @@
+/**
+ * @file yDrv_tim.h
+ * @brief STM32G0 通用定时器驱动程序头文件
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 提供STM32G0系列MCU定时器单通道的PWM输出、输入捕获和单脉冲驱动接口
+ *
+ * @par 主要特性:
+ * - 支持TIM1/TIM3/TIM14/TIM15/TIM16，TIM17作为系统时基不在此驱动管理范围内
+ * - PWM输出，DMA突发模式在每个更新事件改写ARR/CCRx等连续寄存器，硬件播放占空比表
+ * - 输入捕获，DMA把每次捕获值写入缓冲区，循环模式下任务不必唤醒即可随时计算频率
+ * - 单脉冲输出，可设置延时和脉宽，软件触发
+ * - 内联优化比较值和捕获值访问
+ */
+
+#ifndef YDRV_TIM_H
+#define YDRV_TIM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "stm32g0xx_ll_tim.h"
+#include "stm32g0xx_ll_gpio.h"
+#include "stm32g0xx_ll_bus.h"
+
+#include "yDrv_basic.h"
+#include "yDrv_dma.h"
+
+    // ==================== 定时器配置枚举 ====================
+
+    /**
+     * @brief 定时器实例ID枚举
+     * @note TIM17为系统时基，TIM6/TIM7没有输出通道，均不在此列
+     */
+    typedef enum
+    {
+        YDRV_TIM_1 = 0, /*!< TIM1，4通道，有DMA请求 */
+        YDRV_TIM_3,     /*!< TIM3，4通道，有DMA请求 */
+        YDRV_TIM_14,    /*!< TIM14，1通道，无DMA请求 */
+        YDRV_TIM_15,    /*!< TIM15，2通道，有DMA请求 */
+        YDRV_TIM_16,    /*!< TIM16，1通道，有DMA请求 */
+        YDRV_TIM_MAX
+    } yDrvTimId_t;
+
+    /**
+     * @brief 定时器通道枚举
+     */
+    typedef enum
+    {
+        YDRV_TIM_CH1 = 0,
+        YDRV_TIM_CH2,
+        YDRV_TIM_CH3,
+        YDRV_TIM_CH4,
+        YDRV_TIM_CH_MAX
+    } yDrvTimChannel_t;
+
+    /**
+     * @brief 定时器工作模式枚举
+     */
+    typedef enum
+    {
+        YDRV_TIM_MODE_PWM = 0,   /*!< PWM输出(PWM1模式，计数值小于比较值时为有效电平) */
+        YDRV_TIM_MODE_CAPTURE,   /*!< 输入捕获，计数器16位自由运行 */
+        YDRV_TIM_MODE_ONE_PULSE, /*!< 单脉冲输出(PWM2模式+OPM，延时后输出一个脉冲) */
+    } yDrvTimMode_t;
+
+    /**
+     * @brief 输出有效电平枚举
+     */
+    typedef enum
+    {
+        YDRV_TIM_POLARITY_HIGH = LL_TIM_OCPOLARITY_HIGH, /*!< 高电平有效 */
+        YDRV_TIM_POLARITY_LOW = LL_TIM_OCPOLARITY_LOW    /*!< 低电平有效 */
+    } yDrvTimPolarity_t;
+
+    /**
+     * @brief 输入捕获边沿枚举
+     */
+    typedef enum
+    {
+        YDRV_TIM_EDGE_RISING = LL_TIM_IC_POLARITY_RISING,   /*!< 上升沿捕获 */
+        YDRV_TIM_EDGE_FALLING = LL_TIM_IC_POLARITY_FALLING, /*!< 下降沿捕获 */
+        YDRV_TIM_EDGE_BOTH = LL_TIM_IC_POLARITY_BOTHEDGE    /*!< 双边沿捕获 */
+    } yDrvTimEdge_t;
+
+    /**
+     * @brief DMA突发传输起始寄存器枚举
+     * @note 每个更新事件从起始寄存器开始连续写入count个寄存器；
+     *       ARR、RCR、CCR1~CCR4地址连续，例如从ARR开始写3个即为ARR/RCR/CCR1；
+     *       TIM3没有RCR，对应位置的写入被忽略
+     */
+    typedef enum
+    {
+        YDRV_TIM_BURST_ARR = LL_TIM_DMABURST_BASEADDR_ARR,   /*!< 从ARR开始 */
+        YDRV_TIM_BURST_RCR = LL_TIM_DMABURST_BASEADDR_RCR,   /*!< 从RCR开始 */
+        YDRV_TIM_BURST_CCR1 = LL_TIM_DMABURST_BASEADDR_CCR1, /*!< 从CCR1开始 */
+        YDRV_TIM_BURST_CCR2 = LL_TIM_DMABURST_BASEADDR_CCR2, /*!< 从CCR2开始 */
+        YDRV_TIM_BURST_CCR3 = LL_TIM_DMABURST_BASEADDR_CCR3, /*!< 从CCR3开始 */
+        YDRV_TIM_BURST_CCR4 = LL_TIM_DMABURST_BASEADDR_CCR4  /*!< 从CCR4开始 */
+    } yDrvTimBurstBase_t;
+
+/**
+ * @brief DMA突发传输单次最多写入的寄存器数
+ */
+#define YDRV_TIM_BURST_MAX (18U)
+
+    // ==================== 定时器DMA结构体 ====================
+
+    /**
+     * @brief 定时器DMA中断回调函数类型
+     * @param arg 注册时传入的参数
+     * @param event 中断类型，YDRV_DMA_EXTI_HT/TC/TE
+     * @note 在DMA中断上下文中调用；循环模式下HT/TC分别表示缓冲区前半/后半段已更新
+     */
+    typedef void (*yDrvTimDmaCallback_t)(void *arg, yDrvDmaExti_t event);
+
+    /**
+     * @brief 定时器DMA配置结构体
+     */
+    typedef struct
+    {
+        yDrvDmaChannel_t channel;      /*!< DMA通道，YDRV_DMA_CHANNEL_AUTO为自动分配 */
+        yDrvDmaPriority_t priority;    /*!< DMA通道优先级 */
+        uint8_t circular;              /*!< 1=循环模式，缓冲区播放/写满后从头开始 */
+        uint32_t prio;                 /*!< DMA中断优先级，仅callback非NULL时使用 */
+        yDrvTimDmaCallback_t callback; /*!< DMA中断回调，NULL表示不开DMA中断 */
+        void *arg;                     /*!< 回调参数 */
+    } yDrvTimDmaConfig_t;
+
+    // ==================== 定时器配置和句柄结构体 ====================
+
+    /**
+     * @brief 定时器配置结构体
+     * @note 计数时钟为tickHz，周期和比较值均以计数时钟周期为单位
+     */
+    typedef struct
+    {
+        yDrvTimId_t timId;         /*!< 定时器实例 */
+        yDrvTimChannel_t channel;  /*!< 使用的通道 */
+        yDrvTimMode_t mode;        /*!< 工作模式 */
+        yDrvGpioPin_t pin;         /*!< 通道引脚，YDRV_PINNULL表示不配置引脚 */
+        uint32_t pinAF;            /*!< 引脚复用功能编号 */
+        uint8_t openDrain;         /*!< 输出模式下引脚开漏输出，0=推挽 */
+        uint32_t tickHz;           /*!< 计数时钟频率(Hz)，须能由定时器时钟整数分频得到 */
+        uint32_t period;           /*!< PWM周期计数值(1~65536)；捕获模式忽略，固定为65536 */
+        uint32_t pulse;            /*!< PWM有效电平计数值或单脉冲脉宽计数值 */
+        uint32_t delay;            /*!< 单脉冲触发到脉冲开始的计数值(至少为1) */
+        yDrvTimPolarity_t polarity; /*!< 输出有效电平 */
+        yDrvTimEdge_t edge;        /*!< 输入捕获边沿 */
+        uint8_t filter;            /*!< 输入捕获数字滤波(0~15)，见参考手册ICxF */
+        yDrvTimDmaConfig_t dma;    /*!< DMA配置，突发输出和捕获DMA使用 */
+    } yDrvTimConfig_t;
+
+    /**
+     * @brief 定时器句柄结构体
+     */
+    typedef struct
+    {
+        TIM_TypeDef *instance;         /*!< 定时器寄存器指针，NULL表示未初始化 */
+        volatile uint32_t *ccr;        /*!< 通道比较/捕获寄存器地址 */
+        uint32_t llChannel;            /*!< LL库通道编码 */
+        uint32_t tickHz;               /*!< 实际计数时钟频率(Hz) */
+        yDrvGpioInfo_t pinInfo;        /*!< 通道引脚信息 */
+        yDrvDmaHandle_t dma;           /*!< DMA通道句柄 */
+        yDrvTimDmaConfig_t dmaConfig;  /*!< DMA配置副本 */
+        uint32_t dmaLen;               /*!< 当前DMA缓冲区长度(半字) */
+        volatile uint32_t dmaWrap;     /*!< 循环DMA回绕次数(仅开TC中断时计数) */
+        uint8_t timId;                 /*!< 定时器实例 yDrvTimId_t */
+        uint8_t channel;               /*!< 通道 yDrvTimChannel_t */
+        uint8_t mode;                  /*!< 工作模式 yDrvTimMode_t */
+        uint8_t dmaActive;             /*!< DMA传输进行中标志 */
+    } yDrvTimHandle_t;
+
+// ==================== 定时器初始化宏定义 ====================
+
+/**
+ * @brief 定时器配置结构体默认初始化宏
+ * @note 默认TIM3通道1，1MHz计数时钟，1kHz PWM，占空比50%
+ */
+#define YDRV_TIM_CONFIG_DEFAULT()                         \
+    ((yDrvTimConfig_t){                                   \
+        .timId = YDRV_TIM_3,                              \
+        .channel = YDRV_TIM_CH1,                          \
+        .mode = YDRV_TIM_MODE_PWM,                        \
+        .pin = YDRV_PINNULL,                              \
+        .pinAF = 0,                                       \
+        .openDrain = 0,                                   \
+        .tickHz = 1000000U,                               \
+        .period = 1000U,                                  \
+        .pulse = 500U,                                    \
+        .delay = 1U,                                      \
+        .polarity = YDRV_TIM_POLARITY_HIGH,               \
+        .edge = YDRV_TIM_EDGE_RISING,                     \
+        .filter = 0,                                      \
+        .dma = {                                          \
+            .channel = YDRV_DMA_CHANNEL_AUTO,             \
+            .priority = YDRV_DMA_PRIORITY_MEDIUM,         \
+            .circular = 1,                                \
+            .prio = 3,                                    \
+            .callback = NULL,                             \
+            .arg = NULL,                                  \
+        },                                                \
+    })
+
+/**
+ * @brief 定时器句柄结构体默认初始化宏
+ */
+#define YDRV_TIM_HANDLE_DEFAULT()             \
+    ((yDrvTimHandle_t){                       \
+        .instance = NULL,                     \
+        .ccr = NULL,                          \
+        .llChannel = 0,                       \
+        .tickHz = 0,                          \
+        .dma = YDRV_DMA_HANDLE_DEFAULT(),     \
+        .dmaLen = 0,                          \
+        .dmaWrap = 0,                         \
+        .timId = YDRV_TIM_MAX,                \
+        .channel = YDRV_TIM_CH1,              \
+        .mode = YDRV_TIM_MODE_PWM,            \
+        .dmaActive = 0,                       \
+    })
+
+    // ==================== 公共函数声明 ====================
+
+    /**
+     * @brief 初始化定时器通道
+     * @param config 配置参数指针
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 初始化状态
+     *         - YDRV_OK: 初始化成功，计数器尚未启动
+     *         - YDRV_INVALID_PARAM: 实例或通道不存在，tickHz无法分频得到，周期超出16位
+     * @note 同一定时器的多个通道共用计数器，只能由一个句柄管理
+     */
+    yDrvStatus_t yDrvTimInitStatic(const yDrvTimConfig_t *config, yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 反初始化定时器通道
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 反初始化状态
+     * @note 停止DMA和计数器，引脚恢复为模拟模式，关闭定时器时钟
+     */
+    yDrvStatus_t yDrvTimDeInitStatic(yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 初始化定时器配置结构体为默认值
+     * @param config 配置结构体指针
+     * @retval 无
+     */
+    void yDrvTimConfigStructInit(yDrvTimConfig_t *config);
+
+    /**
+     * @brief 初始化定时器句柄结构体为默认值
+     * @param handle 句柄结构体指针
+     * @retval 无
+     */
+    void yDrvTimHandleStructInit(yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 启动定时器
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     * @note PWM和捕获模式使能通道并启动计数器；单脉冲模式只使能通道，由yDrvTimTrigger产生脉冲
+     * @note PWM模式先产生一次更新事件装载停止期间设置的周期和比较值，突发DMA已启动时同时取走表中第一组值
+     */
+    yDrvStatus_t yDrvTimStart(yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 停止定时器
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     * @note 停止计数器并关闭通道，输出回到无效电平；DMA传输不受影响，需要时先调用yDrvTimDmaStop
+     */
+    yDrvStatus_t yDrvTimStop(yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 触发一次单脉冲
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     *         - YDRV_OK: 已触发
+     *         - YDRV_BUSY: 上一个脉冲尚未结束
+     *         - YDRV_NOT_SUPPORTED: 非单脉冲模式
+     * @note 计数器清零后启动，到达周期末尾由硬件自动停止
+     */
+    yDrvStatus_t yDrvTimTrigger(yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 设置单脉冲延时和脉宽
+     * @param handle 句柄指针
+     * @param delay 触发到脉冲开始的计数值(至少为1)
+     * @param width 脉宽计数值
+     * @retval yDrvStatus_t 操作状态，delay+width超过65536返回YDRV_INVALID_PARAM
+     */
+    yDrvStatus_t yDrvTimSetPulse(yDrvTimHandle_t *handle, uint32_t delay, uint32_t width);
+
+    // ==================== 定时器DMA函数 ====================
+
+    /**
+     * @brief 启动DMA突发输出
+     * @param handle 句柄指针(PWM模式)
+     * @param base 每次突发写入的起始寄存器
+     * @param count 每次突发写入的寄存器数(1~YDRV_TIM_BURST_MAX)
+     * @param buffer 寄存器值表，按(base, base+1, ...)依次排列，完成前必须保持有效
+     * @param len 表中半字总数，须为count的整数倍且不超过65535
+     * @retval yDrvStatus_t 操作状态
+     *         - YDRV_OK: 已启动
+     *         - YDRV_BUSY: 已有DMA传输进行中
+     *         - YDRV_NOT_SUPPORTED: 非PWM模式或该定时器没有DMA请求(TIM14)
+     * @note 以更新事件为DMA请求，通过DMAR每个周期写入count个寄存器；
+     *       ARR和CCRx开启了预装载，写入的值在下一个周期生效，每组值恰好持续一个周期
+     * @note 循环模式下表格反复播放，全程不需要CPU参与
+     */
+    yDrvStatus_t yDrvTimBurstStart(yDrvTimHandle_t *handle,
+                                   yDrvTimBurstBase_t base,
+                                   uint32_t count,
+                                   const uint16_t *buffer,
+                                   uint32_t len);
+
+    /**
+     * @brief 启动捕获DMA
+     * @param handle 句柄指针(捕获模式)
+     * @param buffer 捕获值缓冲区，完成前必须保持有效
+     * @param len 缓冲区半字数(1~65535)，用于yDrvTimCaptureInterval时至少为2
+     * @retval yDrvStatus_t 操作状态
+     *         - YDRV_OK: 已启动
+     *         - YDRV_BUSY: 已有DMA传输进行中
+     *         - YDRV_NOT_SUPPORTED: 非捕获模式或该定时器没有DMA请求(TIM14)
+     * @note 以通道捕获事件为DMA请求，每次捕获把CCRx写入缓冲区下一个位置
+     */
+    yDrvStatus_t yDrvTimCaptureStart(yDrvTimHandle_t *handle, uint16_t *buffer, uint32_t len);
+
+    /**
+     * @brief 启动DMA脉冲串
+     * @param handle 句柄指针(单脉冲模式)
+     * @param periph 每个脉冲写入的外设地址，按字节写入，如GPIO ODR的低字节或高字节
+     * @param buffer 数据，第i个脉冲期间写入第i个字节，完成前必须保持有效
+     * @param len 脉冲数，TIM1为1~65535，TIM15/TIM16为1~256
+     * @retval yDrvStatus_t 操作状态
+     *         - YDRV_OK: 已启动
+     *         - YDRV_BUSY: 上一串尚未结束
+     *         - YDRV_NOT_SUPPORTED: 非单脉冲模式，或定时器没有重复计数器(TIM3/TIM14)
+     * @note 单脉冲模式加重复计数器，计数器在len个周期后由硬件停止，恰好输出len个脉冲；
+     *       每个脉冲有效沿的比较事件请求DMA写入一个字节，数据在脉冲有效期间更新、结束沿锁存，
+     *       脉宽须大于DMA响应时间与接收方建立时间之和
+     * @note DMA通道首次启动时分配并固定为正常模式，之后的启动只更新地址和长度，可在DMA完成回调中
+     *       启动下一串；DMA完成时最后一个脉冲尚未结束，yDrvTimIsRunning返回0后才算结束；
+     *       不再使用时调用yDrvTimDmaStop释放通道
+     */
+    yDrvStatus_t yDrvTimPulseDmaStart(yDrvTimHandle_t *handle, volatile void *periph, const uint8_t *buffer, uint32_t len);
+
+    /**
+     * @brief 获取单次DMA脉冲串的最大脉冲数
+     * @param handle 已初始化的句柄指针
+     * @retval uint32_t 最大脉冲数，0表示该定时器不支持脉冲串
+     */
+    uint32_t yDrvTimPulseDmaMax(yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 查询计数器是否在运行
+     * @param handle 已初始化的句柄指针
+     * @retval uint8_t 1=运行中，0=已停止(单脉冲模式下脉冲或脉冲串已结束)
+     */
+    uint8_t yDrvTimIsRunning(yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 停止定时器DMA传输
+     * @param handle 句柄指针
+     * @retval yDrvStatus_t 操作状态
+     * @note 关闭定时器DMA请求并释放DMA通道，计数器保持运行；
+     *       正常模式传输结束后通道仍被占用，同样须调用本函数释放后才能再次启动
+     */
+    yDrvStatus_t yDrvTimDmaStop(yDrvTimHandle_t *handle);
+
+    /**
+     * @brief 由循环捕获缓冲区计算最近一个捕获间隔
+     * @param handle 句柄指针
+     * @param buffer yDrvTimCaptureStart传入的缓冲区
+     * @param ticks 输出最近两次捕获之间的计数值
+     * @retval yDrvStatus_t 操作状态
+     *         - YDRV_OK: 计算成功
+     *         - YDRV_BUSY: 捕获次数不足两次
+     *         - YDRV_NOT_INITIALIZED: 捕获DMA未启动
+     * @note 只读DMA剩余计数和缓冲区，不需要中断；间隔超过65536个计数时结果回绕
+     */
+    yDrvStatus_t yDrvTimCaptureInterval(yDrvTimHandle_t *handle, const uint16_t *buffer, uint32_t *ticks);
+
+    // ==================== 内联函数 ====================
+
+    /**
+     * @brief 设置比较值
+     * @param handle 句柄指针
+     * @param value 比较值，PWM模式下即有效电平计数值，大于周期时输出恒为有效电平
+     * @note PWM模式开启了预装载，在下一个周期生效
+     */
+    YLIB_INLINE void yDrvTimSetCompare(yDrvTimHandle_t *handle, uint32_t value)
+    {
+        *handle->ccr = value;
+    }
+
+    /**
+     * @brief 读取最近一次捕获值
+     * @param handle 句柄指针
+     * @retval uint32_t 捕获值
+     * @note 捕获DMA运行时读取CCRx会清除捕获标志，不影响DMA请求
+     */
+    YLIB_INLINE uint32_t yDrvTimGetCapture(yDrvTimHandle_t *handle)
+    {
+        return *handle->ccr;
+    }
+
+    /**
+     * @brief 设置计数周期
+     * @param handle 句柄指针
+     * @param period 周期计数值(1~65536)
+     * @note ARR开启了预装载，在下一个周期生效
+     */
+    YLIB_INLINE void yDrvTimSetPeriod(yDrvTimHandle_t *handle, uint32_t period)
+    {
+        LL_TIM_SetAutoReload(handle->instance, period - 1U);
+    }
+
+    /**
+     * @brief 读取计数周期
+     * @param handle 句柄指针
+     * @retval uint32_t 周期计数值
+     */
+    YLIB_INLINE uint32_t yDrvTimGetPeriod(yDrvTimHandle_t *handle)
+    {
+        return LL_TIM_GetAutoReload(handle->instance) + 1U;
+    }
+
+    /**
+     * @brief 读取当前计数值
+     * @param handle 句柄指针
+     * @retval uint32_t 计数值
+     */
+    YLIB_INLINE uint32_t yDrvTimGetCounter(yDrvTimHandle_t *handle)
+    {
+        return LL_TIM_GetCounter(handle->instance);
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_TIM_H */
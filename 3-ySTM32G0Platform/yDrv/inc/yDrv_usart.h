@@ -12,6 +12,8 @@
  * - 支持USART1-6和UART4-5 (根据具体型号)
  * - 支持多种工作模式：UART、同步、智能卡、单线、IrDA、LIN
  * - 支持硬件流控制（RTS/CTS）
+ * - 支持RS-485硬件驱动使能（DE），收发切换无需软件介入
+ * - 支持接收超时（RTOR），以可调的线路空闲位数在硬件中判定帧边界
  * - 完整的中断管理系统
  * - 内联优化高频操作函数
  * - 统一的错误处理和状态查询
@@ -127,6 +129,54 @@ extern "C"
         YDRV_USART_MODE_LIN               /*!< LIN总线模式 */
     } yDrvUsartMode_t;
 
+    /**
+     * @brief USART过采样枚举
+     * @note 8倍过采样时最高波特率为时钟的1/8，噪声容限低于16倍过采样
+     */
+    typedef enum
+    {
+        YDRV_USART_OVERSAMPLING_16 = LL_USART_OVERSAMPLING_16, /*!< 16倍过采样，最高fck/16 */
+        YDRV_USART_OVERSAMPLING_8 = LL_USART_OVERSAMPLING_8    /*!< 8倍过采样，最高fck/8 */
+    } yDrvUsartOverSampling_t;
+
+    /**
+     * @brief USART自动波特率检测模式枚举
+     * @note 仅USART1/USART2支持自动波特率检测
+     */
+    typedef enum
+    {
+        YDRV_USART_AUTOBAUD_STARTBIT = LL_USART_AUTOBAUD_DETECT_ON_STARTBIT,       /*!< 测量起始位，首字节须以1开头 */
+        YDRV_USART_AUTOBAUD_FALLINGEDGE = LL_USART_AUTOBAUD_DETECT_ON_FALLINGEDGE, /*!< 测量下降沿间隔，首字节须为10xxxxxx */
+        YDRV_USART_AUTOBAUD_0X7F = LL_USART_AUTOBAUD_DETECT_ON_7F_FRAME,           /*!< 首字节为0x7F */
+        YDRV_USART_AUTOBAUD_0X55 = LL_USART_AUTOBAUD_DETECT_ON_55_FRAME            /*!< 首字节为0x55 */
+    } yDrvUsartAutoBaud_t;
+
+    /**
+     * @brief USART硬件FIFO阈值枚举
+     * @note 仅USART1/USART2支持FIFO模式，FIFO深度为8
+     */
+    typedef enum
+    {
+        YDRV_USART_FIFO_TH_1_8 = LL_USART_FIFOTHRESHOLD_1_8, /*!< FIFO达到1/8深度 */
+        YDRV_USART_FIFO_TH_1_4 = LL_USART_FIFOTHRESHOLD_1_4, /*!< FIFO达到1/4深度 */
+        YDRV_USART_FIFO_TH_1_2 = LL_USART_FIFOTHRESHOLD_1_2, /*!< FIFO达到1/2深度 */
+        YDRV_USART_FIFO_TH_3_4 = LL_USART_FIFOTHRESHOLD_3_4, /*!< FIFO达到3/4深度 */
+        YDRV_USART_FIFO_TH_7_8 = LL_USART_FIFOTHRESHOLD_7_8, /*!< FIFO达到7/8深度 */
+        YDRV_USART_FIFO_TH_8_8 = LL_USART_FIFOTHRESHOLD_8_8  /*!< FIFO满(接收)/空(发送) */
+    } yDrvUsartFifoThreshold_t;
+
+    /**
+     * @brief USART接收错误计数
+     * @note 使能PE/ERR中断后由中断处理累加，未注册回调时同样计数
+     */
+    typedef struct
+    {
+        uint32_t pe;  /*!< 奇偶校验错误次数 */
+        uint32_t fe;  /*!< 帧错误次数 */
+        uint32_t ne;  /*!< 噪声错误次数 */
+        uint32_t ore; /*!< 溢出错误次数 */
+    } yDrvUsartErrorStats_t;
+
     // ==================== USART配置结构体 ====================
 
     /**
@@ -137,47 +187,74 @@ extern "C"
     {
         yDrvUsartId_t usartId; /*!< USART实例ID */
 
-        uint32_t baudRate;                  /*!< 波特率设置 */
-        yDrvUsartDataBits_t dataBits;       /*!< 数据位数设置 */
-        yDrvUsartStopBits_t stopBits;       /*!< 停止位数设置 */
-        yDrvUsartParity_t parity;           /*!< 校验位设置 */
-        yDrvUsartDirection_t direction;     /*!< 传输方向设置 */
-        yDrvUsartFlowControl_t flowControl; /*!< 硬件流控设置 */
-        yDrvUsartMode_t mode;               /*!< USART工作模式 */
+        uint32_t baudRate;                    /*!< 波特率设置 */
+        yDrvUsartDataBits_t dataBits;         /*!< 数据位数设置 */
+        yDrvUsartStopBits_t stopBits;         /*!< 停止位数设置 */
+        yDrvUsartParity_t parity;             /*!< 校验位设置 */
+        yDrvUsartDirection_t direction;       /*!< 传输方向设置 */
+        yDrvUsartFlowControl_t flowControl;   /*!< 硬件流控设置 */
+        yDrvUsartMode_t mode;                 /*!< USART工作模式 */
+        yDrvUsartOverSampling_t overSampling; /*!< 过采样倍数 */
 
         yDrvGpioPin_t txPin;  /*!< TX发送引脚配置 */
         yDrvGpioPin_t rxPin;  /*!< RX接收引脚配置 */
         yDrvGpioPin_t rtsPin; /*!< RTS流控引脚配置 */
         yDrvGpioPin_t ctsPin; /*!< CTS流控引脚配置 */
+        yDrvGpioPin_t dePin;  /*!< RS-485 DE引脚(RTS引脚复用)，YDRV_PINNULL为不使用 */
 
         uint8_t txAF;  /*!< TX引脚复用功能选择 */
         uint8_t rxAF;  /*!< RX引脚复用功能选择 */
         uint8_t ctsAF; /*!< CTS引脚复用功能选择 */
         uint8_t rtsAF; /*!< RTS引脚复用功能选择 */
+        uint8_t deAF;  /*!< DE引脚复用功能选择 */
+
+        uint8_t dePolarity;     /*!< DE有效电平 (0=高电平有效, 1=低电平有效) */
+        uint8_t deAssertTime;   /*!< 起始位前DE提前有效时间，单位为1/16位(8倍过采样为1/8位)，0~31 */
+        uint8_t deDeassertTime; /*!< 最后停止位后DE保持时间，单位同上，0~31 */
+
+        uint8_t fifoEnable;                       /*!< 使能硬件FIFO(仅USART1/USART2) */
+        yDrvUsartFifoThreshold_t rxFifoThreshold; /*!< 接收FIFO阈值(RXFT中断) */
+        yDrvUsartFifoThreshold_t txFifoThreshold; /*!< 发送FIFO阈值(TXFT中断) */
+        uint8_t matchEnable;                      /*!< 使能字符匹配检测(CM中断) */
+        uint8_t matchChar;                        /*!< 匹配字符，如'\r' */
+        uint32_t rxTimeout;                       /*!< 接收超时位数(RTOR)，最后一个停止位后线路空闲这么多位置RTOF，
+                                                       0=不使用，仅USART1/USART2，最大0xFFFFFF */
     } yDrvUsartConfig_t;
 
 /**
  * @brief USART配置结构体默认初始化宏
  * @note 提供最常用的默认配置，适用于标准UART通信
  */
-#define YDRV_USART_CONFIG_DEFAULT()           \
-    ((yDrvUsartConfig_t){                     \
-        .usartId = YDRV_USART_MAX,            \
-        .txPin = YDRV_PINNULL,                \
-        .rxPin = YDRV_PINNULL,                \
-        .rtsPin = YDRV_PINNULL,               \
-        .ctsPin = YDRV_PINNULL,               \
-        .baudRate = 115200,                   \
-        .dataBits = YDRV_USART_DATA_8BIT,     \
-        .stopBits = YDRV_USART_STOP_1BIT,     \
-        .parity = YDRV_USART_PARITY_NONE,     \
-        .direction = YDRV_USART_DIR_TX_RX,    \
-        .flowControl = YDRV_USART_FLOW_NONE,  \
-        .mode = YDRV_USART_MODE_ASYNCHRONOUS, \
-        .txAF = 0,                            \
-        .rxAF = 0,                            \
-        .ctsAF = 0,                           \
-        .rtsAF = 0,                           \
+#define YDRV_USART_CONFIG_DEFAULT()                 \
+    ((yDrvUsartConfig_t){                           \
+        .usartId = YDRV_USART_MAX,                  \
+        .txPin = YDRV_PINNULL,                      \
+        .rxPin = YDRV_PINNULL,                      \
+        .rtsPin = YDRV_PINNULL,                     \
+        .ctsPin = YDRV_PINNULL,                     \
+        .dePin = YDRV_PINNULL,                      \
+        .baudRate = 115200,                         \
+        .dataBits = YDRV_USART_DATA_8BIT,           \
+        .stopBits = YDRV_USART_STOP_1BIT,           \
+        .parity = YDRV_USART_PARITY_NONE,           \
+        .direction = YDRV_USART_DIR_TX_RX,          \
+        .flowControl = YDRV_USART_FLOW_NONE,        \
+        .mode = YDRV_USART_MODE_ASYNCHRONOUS,       \
+        .overSampling = YDRV_USART_OVERSAMPLING_16, \
+        .txAF = YDRV_GPIO_AF_AUTO,                  \
+        .rxAF = YDRV_GPIO_AF_AUTO,                  \
+        .ctsAF = YDRV_GPIO_AF_AUTO,                 \
+        .rtsAF = YDRV_GPIO_AF_AUTO,                 \
+        .deAF = YDRV_GPIO_AF_AUTO,                  \
+        .dePolarity = 0,                            \
+        .deAssertTime = 0,                          \
+        .deDeassertTime = 0,                        \
+        .fifoEnable = 0,                            \
+        .rxFifoThreshold = YDRV_USART_FIFO_TH_1_8,  \
+        .txFifoThreshold = YDRV_USART_FIFO_TH_1_8,  \
+        .matchEnable = 0,                           \
+        .matchChar = 0,                             \
+        .rxTimeout = 0,                             \
     })
 
     // ==================== USART句柄结构体 ====================
@@ -192,23 +269,27 @@ extern "C"
         yDrvGpioInfo_t rxPinInfo;  // RX引脚（用于反初始化时复位GPIO）
         yDrvGpioInfo_t rtsPinInfo; // RTS引脚（用于反初始化时复位GPIO）
         yDrvGpioInfo_t ctsPinInfo; // CTS引脚（用于反初始化时复位GPIO）
+        yDrvGpioInfo_t dePinInfo;  // DE引脚（用于反初始化时复位GPIO）
         uint32_t flagBtyeSend;     // 是否使用uint16做数据
+        uint32_t overSampling;     // 过采样倍数（运行时重设波特率使用）
     } yDrvUsartHandle_t;
 
 /**
  * @brief USART句柄结构体默认初始化宏
  * @note 提供安全的默认初始化值
  */
-#define YDRV_USART_HANDLE_DEFAULT() \
-    ((yDrvUsartHandle_t){           \
-        .instance = NULL,           \
-        .IRQ = (IRQn_Type)0,        \
-        .usartId = YDRV_USART_MAX,  \
-        .txPinInfo = {NULL, 0},     \
-        .rxPinInfo = {NULL, 0},     \
-        .rtsPinInfo = {NULL, 0},    \
-        .ctsPinInfo = {NULL, 0},    \
-        .flagBtyeSend = 0,          \
+#define YDRV_USART_HANDLE_DEFAULT()                 \
+    ((yDrvUsartHandle_t){                           \
+        .instance = NULL,                           \
+        .IRQ = (IRQn_Type)0,                        \
+        .usartId = YDRV_USART_MAX,                  \
+        .txPinInfo = {NULL, 0},                     \
+        .rxPinInfo = {NULL, 0},                     \
+        .rtsPinInfo = {NULL, 0},                    \
+        .ctsPinInfo = {NULL, 0},                    \
+        .dePinInfo = {NULL, 0},                     \
+        .flagBtyeSend = 0,                          \
+        .overSampling = YDRV_USART_OVERSAMPLING_16, \
     })
 
     // ==================== USART中断管理 ====================
@@ -224,6 +305,10 @@ extern "C"
         YDRV_USART_EXTI_ERR,     // 错误中断（帧错误、噪声错误、溢出错误）
         YDRV_USART_EXTI_LBD,     // LIN断开检测中断
         YDRV_USART_EXTI_CTS,     // CTS状态变化中断
+        YDRV_USART_EXTI_CM,      // 字符匹配中断
+        YDRV_USART_EXTI_RXFT,    // 接收FIFO达到阈值中断（需使能FIFO）
+        YDRV_USART_EXTI_TXFT,    // 发送FIFO达到阈值中断（需使能FIFO）
+        YDRV_USART_EXTI_RTO,     // 接收超时中断（需配置rxTimeout）
         YDRV_USART_EXTI_MAX      // 所有中断
     } yDrvUsartExti_t;
 
@@ -269,6 +354,91 @@ extern "C"
      */
     yDrvStatus_t yDrvUsartDeInitStatic(yDrvUsartHandle_t *handle);
 
+    /**
+     * @brief 挂起USART，关闭外设时钟
+     * @param handle USART句柄指针
+     * @retval yDrv状态
+     *         - YDRV_OK: 已关闭时钟
+     *         - YDRV_BUSY: 发送未完成
+     * @note 寄存器配置在关闭时钟期间保持，关闭期间无法接收
+     */
+    yDrvStatus_t yDrvUsartSuspend(yDrvUsartHandle_t *handle);
+
+    /**
+     * @brief 恢复USART，重新打开外设时钟
+     * @param handle USART句柄指针
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvUsartResume(yDrvUsartHandle_t *handle);
+
+    /**
+     * @brief 运行时修改波特率
+     * @param handle USART句柄指针
+     * @param baudRate 新波特率
+     * @retval yDrv状态
+     *         - YDRV_OK: 已生效
+     *         - YDRV_BUSY: 发送未完成
+     *         - YDRV_INVALID_PARAM: 波特率超出当前过采样的范围
+     * @note 只关闭UE重写BRR，其他配置和DMA请求保持不变
+     */
+    yDrvStatus_t yDrvUsartSetBaudRate(yDrvUsartHandle_t *handle, uint32_t baudRate);
+
+    /**
+     * @brief 读取当前波特率
+     * @param handle USART句柄指针
+     * @retval uint32_t 由BRR和时钟计算的波特率，句柄无效时返回0
+     */
+    uint32_t yDrvUsartGetBaudRate(yDrvUsartHandle_t *handle);
+
+    /**
+     * @brief 启动自动波特率检测
+     * @param handle USART句柄指针
+     * @param mode 检测模式
+     * @retval yDrv状态
+     *         - YDRV_NOT_SUPPORTED: 该实例不支持
+     * @note 下一个接收字符用于测量，测量完成后硬件自动写入BRR
+     */
+    yDrvStatus_t yDrvUsartAutoBaudStart(yDrvUsartHandle_t *handle, yDrvUsartAutoBaud_t mode);
+
+    /**
+     * @brief 查询自动波特率检测结果
+     * @param handle USART句柄指针
+     * @param baudRate 检测成功时输出波特率，可为NULL
+     * @retval yDrv状态
+     *         - YDRV_OK: 检测完成
+     *         - YDRV_BUSY: 尚未收到测量字符
+     *         - YDRV_ERROR: 检测失败(波特率超出范围或字符不符合模式)
+     */
+    yDrvStatus_t yDrvUsartAutoBaudPoll(yDrvUsartHandle_t *handle, uint32_t *baudRate);
+
+    /**
+     * @brief 运行时修改接收超时
+     * @param handle USART句柄指针
+     * @param bits 线路空闲位数，0关闭接收超时
+     * @retval yDrv状态
+     *         - YDRV_NOT_SUPPORTED: 该实例不支持
+     *         - YDRV_INVALID_PARAM: 超过0xFFFFFF
+     * @note RTOR可在收发过程中改写，从下一个字符开始按新值计时；
+     *       帧间隔按字符计时，10位字符的3.5个字符即35位
+     */
+    yDrvStatus_t yDrvUsartSetRxTimeout(yDrvUsartHandle_t *handle, uint32_t bits);
+
+    /**
+     * @brief 设置LIN断开符检测长度
+     * @param handle USART句柄指针
+     * @param breakLength true=11位，false=10位
+     * @note 仅在LIN模式下有效；LBDL只在UE=0时可写，须在使能USART之前调用
+     */
+    void yDrvUsartSetLinBreakLength(yDrvUsartHandle_t *handle, bool breakLength);
+
+    /**
+     * @brief 发送LIN断开符
+     * @param handle USART句柄指针
+     * @note 仅在LIN模式下有效；置SBKRQ后立即返回，断开符在当前字符之后发出，
+     *       之后写入发送寄存器或FIFO的数据等断开符结束才发送，同步字节可以紧接着写入
+     */
+    void yDrvUsartSendLinBreak(yDrvUsartHandle_t *handle);
+
     /**
      * @brief 初始化USART配置结构体为默认值（内联优化）
      * @param config 配置结构体指针
@@ -456,6 +626,17 @@ extern "C"
     yDrvStatus_t yDrvUsartUnregisterCallback(yDrvUsartHandle_t *handle,
                                              yDrvUsartExti_t type);
 
+    /**
+     * @brief 为DMA接收安装只处理空闲和接收超时中断的入口
+     * @param handle USART句柄指针
+     * @retval yDrv状态
+     *         - YDRV_OK: 已安装，该中断向量只检查IDLE、RTOF和FE/NE/ORE/PE
+     *         - YDRV_NOT_SUPPORTED: 向量表不在SRAM，或共用该向量的USART使能了其他中断，仍使用通用入口
+     * @note 在注册完IDLE或RTO回调后调用；之后注册IDLE/RTO/PE/ERR以外的回调或反注册IDLE/RTO时
+     *       自动恢复通用入口
+     */
+    yDrvStatus_t yDrvUsartIdleFastPath(yDrvUsartHandle_t *handle);
+
     /**
      * @brief 获取USART溢出错误标志状态（内联优化）
      * @param handle USART句柄指针
@@ -480,6 +661,21 @@ extern "C"
         LL_USART_ClearFlag_ORE(handle->instance);
     }
 
+    /**
+     * @brief 读取接收错误计数
+     * @param handle USART句柄指针
+     * @param stats 输出的错误计数
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvUsartGetErrorStats(yDrvUsartHandle_t *handle, yDrvUsartErrorStats_t *stats);
+
+    /**
+     * @brief 清零接收错误计数
+     * @param handle USART句柄指针
+     * @retval yDrv状态
+     */
+    yDrvStatus_t yDrvUsartResetErrorStats(yDrvUsartHandle_t *handle);
+
     // ==================== USART DMA管理的函数 ====================
     /**
      * @brief 使能指定中断
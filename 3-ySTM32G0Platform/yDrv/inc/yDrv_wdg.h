@@ -0,0 +1,80 @@
+/**
+ * @file yDrv_wdg.h
+ * @brief STM32G0 独立看门狗驱动程序头文件
+ * @version 2.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 提供独立看门狗(IWDG)的启动、喂狗和复位原因查询接口
+ *
+ * @par 主要特性:
+ * - 按超时时间自动选择最小的预分频，重载值分辨率最高
+ * - 调试器暂停内核时看门狗同时暂停
+ * - 上电时读出并清除复位标志，之后随时可查询上一次是否为看门狗复位
+ *
+ * @par 使用约束:
+ * IWDG一旦启动只能由复位停止，STOP模式下继续计数，低功耗期间的唤醒间隔须短于超时时间；
+ * 时钟为LSI，出厂精度较差，超时时间按YDRV_IWDG_LSI_HZ估算，实际可能偏短约10%
+ */
+
+#ifndef YDRV_WDG_H
+#define YDRV_WDG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ==================== 包含文件 ====================
+#include "yDrv_basic.h"
+
+    // ==================== 配置 ====================
+
+    /**
+     * @brief 计算超时时间使用的LSI频率(Hz)
+     */
+#ifndef YDRV_IWDG_LSI_HZ
+#define YDRV_IWDG_LSI_HZ (32000U)
+#endif
+
+    /**
+     * @brief 最大超时时间(毫秒)，预分频256、重载值4095
+     */
+#define YDRV_IWDG_TIMEOUT_MAX ((4095UL * 256UL * 1000UL) / YDRV_IWDG_LSI_HZ)
+
+    // ==================== 函数声明 ====================
+
+    /**
+     * @brief 启动独立看门狗
+     * @param timeoutMs 超时时间(毫秒)，1~YDRV_IWDG_TIMEOUT_MAX
+     * @retval YDRV_OK 已启动
+     * @retval YDRV_INVALID_PARAM 超时时间超出范围
+     * @retval YDRV_TIMEOUT 预分频和重载值未能更新
+     * @note 已启动后再次调用只修改超时时间
+     */
+    yDrvStatus_t yDrvIwdgStart(uint32_t timeoutMs);
+
+    /**
+     * @brief 查询上一次复位是否由独立看门狗引起
+     * @retval 1 看门狗复位，0 其他原因
+     * @note 第一次调用时读出并清除RCC复位标志，之后返回同一结果
+     */
+    uint8_t yDrvIwdgWasReset(void);
+
+    // ==================== 内联函数 ====================
+
+    /**
+     * @brief 喂狗，计数器重新装入重载值
+     * @note 任何上下文均可调用
+     */
+    static inline void yDrvIwdgKick(void)
+    {
+        IWDG->KR = 0xAAAAU;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YDRV_WDG_H */
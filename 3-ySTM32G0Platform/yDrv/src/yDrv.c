@@ -13,6 +13,10 @@
  * - 系统时钟配置
  * - 驱动层统一初始化接口
  * - 硬件抽象层基础服务启动
+ * - TIM17系统时基：毫秒计数和1MHz微秒时间戳
+ * - STOP1低功耗：RTC唤醒定时器定时唤醒，唤醒后恢复时钟并补偿毫秒计数
+ * - 系统时钟等级由yDrv_clock管理，运行时可在64MHz和HSI16及其分频之间切换
+ * - 软件中断：借用空闲中断线，可立即或按毫秒时刻挂起；中断运行模式以SLEEPONEXIT常驻Sleep
  *
  * @par 更新历史:
  * - v2.0 (2025): 优化系统时钟配置，完善注释文档
@@ -26,18 +30,96 @@
 #include "stm32g0xx_ll_bus.h"
 #include "stm32g0xx_ll_system.h"
 #include "stm32g0xx_ll_utils.h"
+#include "stm32g0xx_ll_pwr.h"
+#include "stm32g0xx_ll_cortex.h"
 
 #include "yDrv_basic.h"
+#include "yDrv_clock.h"
+#include "yLib_trace.h"
+
+// ==================== 静态变量定义 ====================
+
+/**
+ * @brief 系统毫秒计数
+ * @note TIM17更新中断中递增，32位无符号回绕，比较时间差须使用无符号减法
+ */
+static volatile uint32_t ydrv_time_ms;
+
+/**
+ * @brief STOP唤醒源已初始化
+ */
+static uint8_t ydrv_stop_ready;
+
+/**
+ * @brief 软件中断的挂起时刻
+ * @note ydrv_swi_armed为1时TIM17中断比较，到期后清零
+ */
+static volatile uint32_t ydrv_swi_at;
+static volatile uint8_t ydrv_swi_armed;
+
+#if YDRV_VECTOR_RAM
+/**
+ * @brief 向量表项数：16个系统异常加最后一个外设中断USART3_4为止的外设中断
+ */
+#define YDRV_VECTOR_COUNT (16U + (uint32_t)USART3_4_IRQn + 1U)
+
+/**
+ * @brief Flash中的向量表(启动文件)，第一项为初始栈顶
+ */
+extern const uint32_t g_pfnVectors[];
+
+/**
+ * @brief SRAM中的向量表
+ * @note VTOR要求按表大小向上取2的幂对齐；.ram_vector段不清零，复制前内容无意义
+ */
+static volatile uint32_t ydrv_vectors[YDRV_VECTOR_COUNT] __attribute__((section(".ram_vector"), aligned(256)));
+
+/**
+ * @brief 向量表已切换到SRAM
+ */
+static uint8_t ydrv_vectors_ready;
+
+/**
+ * @brief 中断延迟测量槽，irq为0且handler为NULL表示空闲
+ */
+static yDrvIrqLatency_t ydrv_latency[YDRV_IRQ_LATENCY_MAX];
+
+/**
+ * @brief 正在测量的槽位和挂起时刻，槽位为YDRV_IRQ_LATENCY_MAX表示没有待测的挂起
+ */
+static volatile uint32_t ydrv_latency_armed = YDRV_IRQ_LATENCY_MAX;
+static volatile uint32_t ydrv_latency_stamp;
+#endif
 
 // ==================== 私有函数声明 ====================
 
 /**
  * @brief 系统时钟配置函数
  * @retval 无
- * @note 配置系统时钟为64MHz，基于内部或外部时钟源
+ * @note 按yDrv_clock的当前等级配置时钟源，上电为YDRV_CLOCK_BOOT_LEVEL
  */
 static void SystemClock_Config(void);
 
+/**
+ * @brief 读取RTC亚秒计数
+ * @retval uint32_t 亚秒计数，按1kHz递减
+ */
+static uint32_t yDrv_RtcSubSecond(void);
+
+#if YDRV_VECTOR_RAM
+/**
+ * @brief 向量表复制到SRAM并切换VTOR
+ * @retval 无
+ */
+static void yDrv_VectorRelocate(void);
+
+/**
+ * @brief 延迟测量包装入口
+ * @retval 无
+ */
+static void yDrv_IrqLatencyEntry(void);
+#endif
+
 // ==================== 公共函数实现 ====================
 
 /**
@@ -48,75 +130,598 @@ static void SystemClock_Config(void);
  */
 yDrvStatus_t yDrvInit(void)
 {
+#if YDRV_VECTOR_RAM
+    // 中断向量表切换到SRAM，之后的中断入口均可替换
+    yDrv_VectorRelocate();
+#endif
+
     // HAL库初始化
     HAL_Init();
 
     // 系统时钟配置
     SystemClock_Config();
 
+    // 上电等级不用HSE时让晶振先起振
+    yDrvClockBoot();
+
     return YDRV_OK;
 }
 
-// ==================== 私有函数实现 ====================
+/**
+ * @brief 替换外设中断入口
+ * @param irq 外设中断号
+ * @param handler 新的入口函数
+ * @retval yDrvIrqHandler_t 原来的入口函数，向量表不在SRAM或中断号无效时返回NULL
+ * @note 向量表项为字对齐的32位数，写入是原子的，取向量时要么是旧入口要么是新入口
+ */
+yDrvIrqHandler_t yDrvIrqSetHandler(IRQn_Type irq, yDrvIrqHandler_t handler)
+{
+#if YDRV_VECTOR_RAM
+    uint32_t index = 16U + (uint32_t)irq;
+    yDrvIrqHandler_t old;
+
+    if (!ydrv_vectors_ready || (irq < 0) || (index >= YDRV_VECTOR_COUNT) || (handler == NULL))
+    {
+        return NULL;
+    }
+
+    old = (yDrvIrqHandler_t)ydrv_vectors[index];
+    ydrv_vectors[index] = (uint32_t)handler;
+    __DSB();
+    return old;
+#else
+    (void)irq;
+    (void)handler;
+    return NULL;
+#endif
+}
 
 /**
- * @brief 系统时钟配置
+ * @brief 设置外设中断优先级
+ * @param irq 外设中断号
+ * @param prio 优先级等级
  * @retval 无
- * @note 配置系统时钟为64MHz，使用PLL倍频
- *       时钟配置参数：
- *       - 时钟源：HSI或HSE（根据硬件配置）
- *       - PLL配置：适配STM32G0系列
- *       - 系统时钟：64MHz
- *       - Flash延迟：根据频率自动配置
- *       - AHB分频：1 (64MHz)
- *       - APB分频：1 (64MHz)
- *       -APB2分频：1(64MHz) * /
+ * @note 共享中断线上已使能的高等级中断源不会被后注册的低等级中断源降级
  */
+void yDrvIrqSetPriority(IRQn_Type irq, uint32_t prio)
+{
+    if (prio > YDRV_IRQ_LEVEL_SYSTEM)
+    {
+        prio = YDRV_IRQ_LEVEL_SYSTEM;
+    }
+    if (NVIC_GetEnableIRQ(irq) && (NVIC_GetPriority(irq) < prio))
+    {
+        return;
+    }
+    NVIC_SetPriority(irq, prio);
+}
 
-static void SystemClock_Config(void)
+/**
+ * @brief 插入中断延迟测量包装
+ * @param irq 外设中断号
+ * @param port 调试引脚端口，可为NULL
+ * @param pinMask 调试引脚掩码
+ * @retval yDrvStatus_t 插入状态
+ */
+yDrvStatus_t yDrvIrqLatencyAttach(IRQn_Type irq, GPIO_TypeDef *port, uint32_t pinMask)
+{
+#if YDRV_VECTOR_RAM
+    yDrvIrqLatency_t *slot = NULL;
+    uint32_t i;
+
+    if (!ydrv_vectors_ready || (irq < 0))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    for (i = 0; i < YDRV_IRQ_LATENCY_MAX; i++)
+    {
+        if ((ydrv_latency[i].handler != NULL) && (ydrv_latency[i].irq == irq))
+        {
+            slot = &ydrv_latency[i]; // 已插入，只清零统计
+            break;
+        }
+        if ((slot == NULL) && (ydrv_latency[i].handler == NULL))
+        {
+            slot = &ydrv_latency[i];
+        }
+    }
+    if (slot == NULL)
+    {
+        return YDRV_BUSY;
+    }
+
+    slot->port = port;
+    slot->pinMask = pinMask;
+    slot->count = 0;
+    slot->min = UINT32_MAX;
+    slot->max = 0;
+    slot->last = 0;
+    if (slot->handler == NULL)
+    {
+        slot->irq = irq;
+        slot->handler = (yDrvIrqHandler_t)ydrv_vectors[16U + (uint32_t)irq];
+        __DSB();
+        (void)yDrvIrqSetHandler(irq, yDrv_IrqLatencyEntry);
+    }
+    return YDRV_OK;
+#else
+    (void)irq;
+    (void)port;
+    (void)pinMask;
+    return YDRV_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief 恢复原入口函数
+ * @param irq 外设中断号
+ * @retval 无
+ */
+void yDrvIrqLatencyDetach(IRQn_Type irq)
+{
+#if YDRV_VECTOR_RAM
+    uint32_t i;
+
+    for (i = 0; i < YDRV_IRQ_LATENCY_MAX; i++)
+    {
+        if ((ydrv_latency[i].handler != NULL) && (ydrv_latency[i].irq == irq))
+        {
+            (void)yDrvIrqSetHandler(irq, ydrv_latency[i].handler);
+            ydrv_latency[i].handler = NULL;
+            break;
+        }
+    }
+#else
+    (void)irq;
+#endif
+}
+
+/**
+ * @brief 测一次入口延迟
+ * @param irq 中断号
+ * @param cycles 输出周期数
+ * @retval yDrvStatus_t 测量状态
+ * @note 等待以SysTick一个重装周期为限，超过时包装入口按回绕算出的值不可信
+ */
+yDrvStatus_t yDrvIrqLatencyProbe(IRQn_Type irq, uint32_t *cycles)
+{
+#if YDRV_VECTOR_RAM
+    uint32_t index;
+    uint32_t start;
+
+    for (index = 0; index < YDRV_IRQ_LATENCY_MAX; index++)
+    {
+        if ((ydrv_latency[index].handler != NULL) && (ydrv_latency[index].irq == irq))
+        {
+            break;
+        }
+    }
+    if ((index >= YDRV_IRQ_LATENCY_MAX) || !NVIC_GetEnableIRQ(irq))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    ydrv_latency_armed = index;
+    start = yDrvCycleNow();
+    ydrv_latency_stamp = start;
+    NVIC_SetPendingIRQ(irq);
+
+    while (ydrv_latency_armed == index)
+    {
+        if (yDrvCycleSince(start) > SysTick->LOAD)
+        {
+            ydrv_latency_armed = YDRV_IRQ_LATENCY_MAX;
+            return YDRV_TIMEOUT;
+        }
+    }
+    if (cycles != NULL)
+    {
+        *cycles = ydrv_latency[index].last;
+    }
+    return YDRV_OK;
+#else
+    (void)irq;
+    (void)cycles;
+    return YDRV_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief 按序号取测量槽
+ * @param index 序号
+ * @retval const yDrvIrqLatency_t* 测量槽
+ */
+const yDrvIrqLatency_t *yDrvIrqLatencyGet(uint32_t index)
+{
+#if YDRV_VECTOR_RAM
+    if ((index < YDRV_IRQ_LATENCY_MAX) && (ydrv_latency[index].handler != NULL))
+    {
+        return &ydrv_latency[index];
+    }
+#else
+    (void)index;
+#endif
+    return NULL;
+}
+
+/**
+ * @brief 获取系统毫秒计数
+ * @retval uint32_t 上电以来的毫秒数
+ * @note 约49.7天回绕一次，(now - start)的无符号差值跨越回绕时仍然正确
+ */
+uint32_t yDrvGetTimeMs(void)
+{
+    return ydrv_time_ms;
+}
+
+/**
+ * @brief 获取微秒时间戳
+ * @retval uint32_t 上电以来的微秒数
+ * @note TIM17以1MHz计数、每1000个计数更新一次，时间戳为毫秒计数*1000加计数器当前值；
+ *       读取时更新中断已挂起但尚未执行则补上这1ms，约71.6分钟回绕一次
+ */
+uint32_t yDrvGetTimeUs(void)
+{
+    uint32_t primask;
+    uint32_t ms;
+    uint32_t cnt;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ms = ydrv_time_ms;
+    cnt = LL_TIM_GetCounter(TIM17);
+    if (LL_TIM_IsActiveFlag_UPDATE(TIM17))
+    {
+        // 计数器已回绕，重读计数值使其与补上的1ms属于同一周期
+        cnt = LL_TIM_GetCounter(TIM17);
+        ms++;
+    }
+    __set_PRIMASK(primask);
+
+    return ms * 1000U + cnt;
+}
+
+/**
+ * @brief 读取周期计数
+ * @retval uint32_t SysTick当前值
+ */
+uint32_t yDrvCycleNow(void)
+{
+    return SysTick->VAL;
+}
+
+/**
+ * @brief 计算经过的CPU周期数
+ * @param start yDrvCycleNow的返回值
+ * @retval uint32_t 经过的周期数
+ * @note SysTick向下计数，重装值随时钟档位变化，每次读取当前的LOAD
+ */
+uint32_t yDrvCycleSince(uint32_t start)
+{
+    uint32_t now = SysTick->VAL;
+
+    return (start >= now) ? (start - now) : (start + SysTick->LOAD + 1U - now);
+}
+
+/**
+ * @brief 初始化STOP模式的唤醒源
+ * @retval yDrvStatus_t 初始化状态
+ * @note RTC时钟选LSI，异步预分频得到1kHz亚秒计数(PREDIV_S=0x7FFF，约32.7秒一周)；
+ *       唤醒定时器时钟为RTCCLK/16，0.5ms分辨率；影子寄存器旁路，唤醒后无需等待同步
+ */
+yDrvStatus_t yDrvStopInit(void)
+{
+    uint32_t prediv_a;
+
+    prediv_a = (YDRV_STOP_LSI_HZ / 1000U) - 1U;
+    if (prediv_a > (RTC_PRER_PREDIV_A_Msk >> RTC_PRER_PREDIV_A_Pos))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // LSI
+    RCC->CSR |= RCC_CSR_LSION;
+    while ((RCC->CSR & RCC_CSR_LSIRDY) == 0)
+    {
+        // 等待LSI就绪
+    }
+
+    // RTC时钟源只能在备份域复位后修改
+    LL_PWR_EnableBkUpAccess();
+    if ((RCC->BDCR & RCC_BDCR_RTCSEL) != RCC_BDCR_RTCSEL_1)
+    {
+        RCC->BDCR |= RCC_BDCR_BDRST;
+        RCC->BDCR &= ~RCC_BDCR_BDRST;
+        RCC->BDCR = RCC_BDCR_RTCSEL_1;
+    }
+    RCC->BDCR |= RCC_BDCR_RTCEN;
+    RCC->APBENR1 |= RCC_APBENR1_RTCAPBEN;
+
+    // 解除写保护，进入初始化模式设置预分频(先PREDIV_S后PREDIV_A，分两次写)
+    RTC->WPR = 0xCAU;
+    RTC->WPR = 0x53U;
+    RTC->ICSR |= RTC_ICSR_INIT;
+    while ((RTC->ICSR & RTC_ICSR_INITF) == 0)
+    {
+        // 等待进入初始化模式
+    }
+    RTC->PRER = 0x7FFFU << RTC_PRER_PREDIV_S_Pos;
+    RTC->PRER |= prediv_a << RTC_PRER_PREDIV_A_Pos;
+    RTC->ICSR &= ~RTC_ICSR_INIT;
+
+    // 唤醒定时器：关闭后才能修改时钟选择和重装载值
+    RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUCKSEL);
+    while ((RTC->ICSR & RTC_ICSR_WUTWF) == 0)
+    {
+        // 等待唤醒定时器可写
+    }
+    RTC->CR |= RTC_CR_BYPSHAD | RTC_CR_WUTIE;
+    RTC->SCR = RTC_SCR_CWUTF;
+    RTC->WPR = 0xFFU;
+
+    // RTC唤醒事件经EXTI第19线(直接线，不需要边沿配置)
+    EXTI->IMR1 |= EXTI_IMR1_IM19;
+    NVIC_SetPriority(RTC_TAMP_IRQn, YDRV_IRQ_PRIO_RTC);
+    NVIC_EnableIRQ(RTC_TAMP_IRQn);
+
+    ydrv_stop_ready = 1;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 进入STOP1模式
+ * @param ms 最长睡眠时间(毫秒)
+ * @param slept 输出实际睡眠的毫秒数
+ * @retval yDrvStatus_t 睡眠状态
+ * @note 关中断时WFI照常被挂起的中断唤醒，唤醒源可能是唤醒定时器，也可能是EXTI引脚等；
+ *       实际时间以RTC亚秒计数为准，包含HSE起振和PLL锁定的时间
+ */
+yDrvStatus_t yDrvEnterStop(uint32_t ms, uint32_t *slept)
+{
+    uint32_t start;
+    uint32_t elapsed;
+
+    if ((slept == NULL) || (ms == 0))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+    if (ydrv_stop_ready == 0)
+    {
+        return YDRV_NOT_INITIALIZED;
+    }
+    if (ms > YDRV_STOP_MAX_MS)
+    {
+        ms = YDRV_STOP_MAX_MS;
+    }
+
+    // 唤醒定时器计数WUTR+1个RTCCLK/16周期
+    RTC->WPR = 0xCAU;
+    RTC->WPR = 0x53U;
+    RTC->CR &= ~RTC_CR_WUTE;
+    while ((RTC->ICSR & RTC_ICSR_WUTWF) == 0)
+    {
+        // 等待唤醒定时器可写
+    }
+    RTC->WUTR = ((ms * (YDRV_STOP_LSI_HZ / 16U)) / 1000U) - 1U;
+    RTC->SCR = RTC_SCR_CWUTF;
+    RTC->CR |= RTC_CR_WUTE;
+    RTC->WPR = 0xFFU;
+
+    start = yDrv_RtcSubSecond();
+
+    LL_PWR_SetPowerMode(LL_PWR_MODE_STOP1);
+    LL_LPM_EnableDeepSleep();
+    __DSB();
+    __WFI();
+    LL_LPM_EnableSleep();
+
+    // 唤醒后系统时钟为HSI16，恢复睡眠前的时钟等级，TIM17随之重新初始化
+    SystemClock_Config();
+
+    // 亚秒计数递减，按PREDIV_S+1取模
+    elapsed = (start - yDrv_RtcSubSecond()) & 0x7FFFU;
+    ydrv_time_ms += elapsed;
+    *slept = elapsed;
+
+    // 关闭唤醒定时器，清除本次唤醒留下的标志和挂起中断
+    RTC->WPR = 0xCAU;
+    RTC->WPR = 0x53U;
+    RTC->CR &= ~RTC_CR_WUTE;
+    RTC->SCR = RTC_SCR_CWUTF;
+    RTC->WPR = 0xFFU;
+    NVIC_ClearPendingIRQ(RTC_TAMP_IRQn);
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 初始化软件中断
+ * @param handler 中断入口函数
+ * @retval yDrvStatus_t 初始化状态
+ */
+yDrvStatus_t yDrvSwiInit(yDrvIrqHandler_t handler)
+{
+    if (handler == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+    if (yDrvIrqSetHandler(YDRV_SWI_IRQ, handler) == NULL)
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    ydrv_swi_armed = 0;
+    NVIC_ClearPendingIRQ(YDRV_SWI_IRQ);
+    yDrvIrqSetPriority(YDRV_SWI_IRQ, YDRV_IRQ_PRIO_SWI);
+    NVIC_EnableIRQ(YDRV_SWI_IRQ);
+    return YDRV_OK;
+}
+
+/**
+ * @brief 挂起软件中断
+ */
+void yDrvSwiTrigger(void)
+{
+    NVIC_SetPendingIRQ(YDRV_SWI_IRQ);
+}
+
+/**
+ * @brief 在指定时刻挂起软件中断
+ * @param ms 绝对时刻(毫秒)
+ * @note 与TIM17中断同级，关中断只为防止更高等级的调用者在两次写入之间被打断
+ */
+void yDrvSwiTriggerAt(uint32_t ms)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if ((int32_t)(ydrv_time_ms - ms) >= 0)
+    {
+        ydrv_swi_armed = 0;
+        NVIC_SetPendingIRQ(YDRV_SWI_IRQ);
+    }
+    else
+    {
+        ydrv_swi_at = ms;
+        ydrv_swi_armed = 1;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 取消软件中断的挂起时刻
+ */
+void yDrvSwiCancelAt(void)
+{
+    ydrv_swi_armed = 0;
+}
+
+/**
+ * @brief 进入中断运行
+ * @note 正常情况下中断退出后直接回到Sleep，不会执行到循环；只有中断在关中断(PRIMASK)状态下退出时，
+ *       挂起的中断唤醒内核回到这里，重新开中断后即可进入
+ */
+void yDrvIrqRunEnter(void)
 {
-    // 设置Flash延迟为2个等待周期（64MHz系统时钟需要）
-    LL_FLASH_SetLatency(LL_FLASH_LATENCY_2);
-    while (LL_FLASH_GetLatency() != LL_FLASH_LATENCY_2)
+    LL_LPM_EnableSleep();
+    LL_LPM_EnableSleepOnExit();
+    __DSB();
+    for (;;)
     {
-        // 等待Flash延迟设置完成
+        __enable_irq();
+        __WFI();
     }
+}
 
-    // 启用外部高速晶振(HSE)
-    LL_RCC_HSE_Enable();
-    while (LL_RCC_HSE_IsReady() != 1)
+// ==================== 私有函数实现 ====================
+
+#if YDRV_VECTOR_RAM
+/**
+ * @brief 向量表复制到SRAM并切换VTOR
+ * @note 复制期间仍使用Flash中的表，两份内容相同，不需要关中断；
+ *       DSB保证表写入完成后才切换，ISB保证之后的异常使用新表
+ */
+static void yDrv_VectorRelocate(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < YDRV_VECTOR_COUNT; i++)
     {
-        // 等待HSE就绪
+        ydrv_vectors[i] = g_pfnVectors[i];
     }
+    __DSB();
+    SCB->VTOR = (uint32_t)(uintptr_t)ydrv_vectors;
+    __DSB();
+    __ISB();
+    ydrv_vectors_ready = 1;
+}
 
-    // 配置主PLL：HSE作为输入源，M=1, N=16, R=2
-    // PLL输出频率 = HSE * N / (M * R) = 8MHz * 16 / (1 * 2) = 64MHz
-    LL_RCC_PLL_ConfigDomain_SYS(LL_RCC_PLLSOURCE_HSE, LL_RCC_PLLM_DIV_1, 16, LL_RCC_PLLR_DIV_2);
-    LL_RCC_PLL_Enable();
-    LL_RCC_PLL_EnableDomain_SYS();
-    while (LL_RCC_PLL_IsReady() != 1)
+/**
+ * @brief 延迟测量包装入口
+ * @retval 无
+ * @note 先读SysTick再查槽位，IPSR给出当前异常号；原入口执行期间调试引脚为高
+ */
+static void yDrv_IrqLatencyEntry(void)
+{
+    uint32_t cycles = yDrvCycleSince(ydrv_latency_stamp);
+    IRQn_Type irq = (IRQn_Type)((int32_t)(__get_IPSR() & 0x3FU) - 16);
+    yDrvIrqLatency_t *slot = NULL;
+    uint32_t i;
+
+    for (i = 0; i < YDRV_IRQ_LATENCY_MAX; i++)
     {
-        // 等待PLL就绪
+        if ((ydrv_latency[i].handler != NULL) && (ydrv_latency[i].irq == irq))
+        {
+            slot = &ydrv_latency[i];
+            break;
+        }
+    }
+    if (slot == NULL)
+    {
+        return; // 卸载后仍取到旧向量，中断会因标志未清再次进入新入口
     }
 
-    // 设置AHB预分频器为1（不分频）
-    LL_RCC_SetAHBPrescaler(LL_RCC_SYSCLK_DIV_1);
+    if (ydrv_latency_armed == i)
+    {
+        slot->last = cycles;
+        slot->count++;
+        if (cycles < slot->min)
+        {
+            slot->min = cycles;
+        }
+        if (cycles > slot->max)
+        {
+            slot->max = cycles;
+        }
+        ydrv_latency_armed = YDRV_IRQ_LATENCY_MAX;
+    }
 
-    // 切换系统时钟源到PLL
-    LL_RCC_SetSysClkSource(LL_RCC_SYS_CLKSOURCE_PLL);
-    while (LL_RCC_GetSysClkSource() != LL_RCC_SYS_CLKSOURCE_STATUS_PLL)
+    if (slot->port != NULL)
     {
-        // 等待系统时钟源切换完成
+        slot->port->BSRR = slot->pinMask;
     }
+    slot->handler();
+    if (slot->port != NULL)
+    {
+        slot->port->BRR = slot->pinMask;
+    }
+}
+#endif
+
+/**
+ * @brief 读取RTC亚秒计数
+ * @retval uint32_t 亚秒计数
+ * @note 影子寄存器已旁路，直接读计数器可能恰逢跳变，连续两次读数相同才采用
+ */
+static uint32_t yDrv_RtcSubSecond(void)
+{
+    uint32_t ssr;
+
+    do
+    {
+        ssr = RTC->SSR;
+    } while (ssr != RTC->SSR);
 
-    // 设置APB1预分频器为1（不分频）
-    LL_RCC_SetAPB1Prescaler(LL_RCC_APB1_DIV_1);
+    return ssr & RTC_SSR_SS_Msk;
+}
 
-    // 更新CMSIS系统时钟变量
-    LL_SetSystemCoreClock(64000000);
+/**
+ * @brief 系统时钟配置
+ * @retval 无
+ * @note 时钟源和Flash等待周期由yDrv_clock按当前等级配置，上电为YDRV_CLOCK_BOOT_LEVEL：
+ *       - 64MHz：HSE 8MHz经PLL(M=1, N=16, R=2)，Flash 2个等待周期
+ *       - 16/8/4MHz：HSI16及其分频，关闭HSE和PLL
+ *       - AHB、APB不分频
+ *       配置后按新的SystemCoreClock重新初始化TIM17时基
+ */
+static void SystemClock_Config(void)
+{
+    yDrvClockRestore();
 
     // 初始化系统滴答定时器
-    if (HAL_InitTick(TICK_INT_PRIORITY) != HAL_OK)
+    if (HAL_InitTick(YDRV_IRQ_PRIO_TICK) != HAL_OK)
     {
         while (1)
         {
@@ -153,9 +758,10 @@ void HAL_MspInit(void)
  *         @retval HAL_OK 初始化成功
  *         @retval HAL_ERROR 初始化失败
  * @note 定时器配置：
- *       - 时钟源：64MHz APB2时钟
- *       - 预分频：64 (得到1MHz计数时钟)
+ *       - 时钟源：APB定时器时钟，APB不分频时等于SystemCoreClock，运行时调频由yDrv_clock重算预分频
+ *       - 预分频：得到1MHz计数时钟，计数值即为微秒
  *       - 自动重装载：1000 (得到1ms周期)
+ *       HAL_Init时以HSI频率调用一次，切换到PLL后再调用一次，毫秒计数保持连续
  */
 HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
 {
@@ -171,22 +777,22 @@ HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
     NVIC_EnableIRQ(TIM17_IRQn);
 
     // 获取TIM17时钟频率
-    // TIM17位于APB2总线上，根据当前时钟配置获取频率
-    // 基于系统时钟配置：64MHz系统时钟，APB2分频器为1，所以APB2时钟为64MHz
-    uwTimclock = 64000000U;
+    // TIM17位于APB总线上，APB分频器为1时定时器时钟等于系统时钟
+    uwTimclock = SystemCoreClock;
 
     // 计算预分频器值，使TIM17计数时钟为1MHz
     uwPrescalerValue = (uwTimclock / 1000000U) - 1U;
 
     // 配置定时器参数
-    TIM_InitStruct.Prescaler = uwPrescalerValue;              // 预分频器: 63 (64MHz/64 = 1MHz)
+    TIM_InitStruct.Prescaler = uwPrescalerValue;              // 预分频器: 64MHz时为63 (64MHz/64 = 1MHz)
     TIM_InitStruct.CounterMode = LL_TIM_COUNTERMODE_UP;       // 向上计数模式
     TIM_InitStruct.Autoreload = (1000000U / 1000U) - 1U;      // 自动重装载值: 999 (1MHz/1000 = 1ms周期)
     TIM_InitStruct.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1; // 时钟分频: 不分频
     TIM_InitStruct.RepetitionCounter = 0;                     // 重复计数器: 0 (每次更新都产生中断)
 
-    // 初始化定时器
+    // 初始化定时器，LL_TIM_Init产生更新事件装载预分频器，清除该事件避免多计1ms
     LL_TIM_Init(TIM17, &TIM_InitStruct);
+    LL_TIM_ClearFlag_UPDATE(TIM17);
 
     // 禁用自动重装载预装载
     LL_TIM_DisableARRPreload(TIM17);
@@ -205,7 +811,7 @@ HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
  * @details 通过禁用TIM17更新中断来暂停系统滴答计数
  * @param 无
  * @return 无
- * @note 暂停期间HAL_GetTick()返回值将不会递增
+ * @note 暂停期间HAL_GetTick()和yDrvGetTimeMs()返回值将不会递增
  */
 void HAL_SuspendTick(void)
 {
@@ -226,6 +832,17 @@ void HAL_ResumeTick(void)
     LL_TIM_EnableIT_UPDATE(TIM17);
 }
 
+/**
+ * @brief 获取HAL滴答计数
+ * @details 替换HAL库的弱定义，HAL超时与yDrvGetTimeMs()共用同一个毫秒计数
+ * @param 无
+ * @return uint32_t 毫秒计数
+ */
+uint32_t HAL_GetTick(void)
+{
+    return ydrv_time_ms;
+}
+
 // ==================== 中断处理函数 ====================
 
 /**
@@ -233,7 +850,7 @@ void HAL_ResumeTick(void)
  * @details 处理TIM17更新中断，用于系统滴答计数
  * @param 无
  * @return 无
- * @note 此函数每1ms被调用一次，维护系统滴答计数器
+ * @note 此函数每1ms被调用一次，维护系统毫秒计数，取代HAL_IncTick
  */
 void TIM17_IRQHandler(void)
 {
@@ -243,7 +860,29 @@ void TIM17_IRQHandler(void)
         // 清除更新中断标志
         LL_TIM_ClearFlag_UPDATE(TIM17);
 
-        // 调用HAL滴答函数
-        HAL_IncTick();
+        // 递增系统毫秒计数
+        ydrv_time_ms++;
+
+        // 软件中断的挂起时刻到达
+        if (ydrv_swi_armed && ((int32_t)(ydrv_time_ms - ydrv_swi_at) >= 0))
+        {
+            ydrv_swi_armed = 0;
+            NVIC_SetPendingIRQ(YDRV_SWI_IRQ);
+        }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief RTC和TAMP中断处理函数
+ * @details 只用于STOP唤醒，清除唤醒定时器标志
+ * @param 无
+ * @return 无
+ */
+void RTC_TAMP_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    if (RTC->SR & RTC_SR_WUTF)
+    {
+        RTC->SCR = RTC_SCR_CWUTF;
+    }
+}
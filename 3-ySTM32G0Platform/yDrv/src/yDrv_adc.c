@@ -0,0 +1,668 @@
+/**
+ * @file yDrv_adc.c
+ * @brief STM32G0 ADC流式采样驱动程序实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现ADC多通道扫描、硬件过采样和定时器触发的循环DMA双缓冲采样
+ *
+ * @par 实现说明:
+ * - 时钟取同步模式PCLK/2，触发到采样的延迟固定，帧间隔只由定时器决定
+ * - 校准要求ADEN=0且DMAEN=0，因此先校准再写CFGR1；CHSELR在使能后写入并等待CCRDY
+ * - OVRMOD=0，溢出时DMA请求被阻塞，中断中停止转换并把DMA指针拨回缓冲区开头后重启，
+ *   缓冲区内每一帧始终按序列顺序对齐
+ * - 只有配置了回调时才注册DMA中断，无回调时采样全程没有中断
+ * - TIM6触发时注册时钟切换通知，按原计数频率重写预分频，不能整数分频的切换被否决
+ */
+
+#include <string.h> // For memset
+#include "yDrv_adc.h"
+#include "yDrv_clock.h"
+#include "yLib_trace.h"
+#include "stm32g0xx_ll_rcc.h"
+
+// ==================== 私有定义 ====================
+
+/**
+ * @brief 等待ADC状态位的最大轮询次数
+ */
+#define YDRV_ADC_TIMEOUT (100000U)
+
+/**
+ * @brief 内部通道号
+ */
+#define YDRV_ADC_CH_TEMP (12U)
+#define YDRV_ADC_CH_VREFINT (13U)
+#define YDRV_ADC_CH_VBAT (14U)
+
+/**
+ * @brief 可编程序列结束标记
+ */
+#define YDRV_ADC_SEQ_END (0xFU)
+
+/**
+ * @brief 各触发源的EXTSEL编码，见参考手册ADC外部触发表
+ */
+static const uint8_t adc_extsel[] = {
+    [YDRV_ADC_TRIG_TIM6] = 5U,       // TRG5
+    [YDRV_ADC_TRIG_TIM1_TRGO2] = 0U, // TRG0
+    [YDRV_ADC_TRIG_TIM3] = 3U,       // TRG3
+    [YDRV_ADC_TRIG_TIM15] = 4U,      // TRG4
+    [YDRV_ADC_TRIG_CONTINUOUS] = 0U, // 不使用外部触发
+};
+
+/**
+ * @brief 当前使用ADC的句柄，ADC中断使用
+ */
+static yDrvAdcHandle_t *adc_active = NULL;
+
+/**
+ * @brief TIM6计数频率，0为未使用TIM6触发
+ */
+static uint32_t adc_tick_hz = 0;
+
+/**
+ * @brief 系统时钟切换通知，TIM6触发时注册
+ */
+static yDrvClockNotifier_t adc_clock_notifier = {.callback = prv_ClockNotify};
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 获取定时器内核时钟频率
+ * @param sysclk 系统时钟频率(Hz)
+ * @retval uint32_t 时钟频率(Hz)
+ * @note APB不分频时等于HCLK，分频时为PCLK的两倍
+ */
+static uint32_t prv_GetTimClockFreq(uint32_t sysclk);
+
+/**
+ * @brief 系统时钟切换通知
+ * @note PRE确认新时钟能整数分频得到TIM6原计数频率，POST重写预分频，重装载值和帧率不变
+ */
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg);
+
+/**
+ * @brief 忙等待微秒延时
+ * @param us 延时(微秒)
+ * @note 只用于稳压器启动，按每次循环至少4个周期估算，实际延时偏长
+ */
+static void prv_DelayUs(uint32_t us);
+
+/**
+ * @brief 等待寄存器位达到指定状态
+ * @param reg 寄存器地址
+ * @param mask 位掩码
+ * @param set 1=等待置位，0=等待清零
+ * @retval yDrvStatus_t YDRV_OK或超时YDRV_ERROR
+ */
+static yDrvStatus_t prv_WaitBit(volatile uint32_t *reg, uint32_t mask, uint32_t set);
+
+/**
+ * @brief 停止进行中的转换
+ */
+static void prv_StopConversion(void);
+
+/**
+ * @brief 关闭ADC和相关时钟
+ */
+static void prv_Disable(void);
+
+/**
+ * @brief DMA传输完成中断回调，后半块写满
+ * @param arg ADC句柄指针
+ */
+static void prv_DmaTc(void *arg);
+
+/**
+ * @brief DMA半传输中断回调，前半块写满
+ * @param arg ADC句柄指针
+ */
+static void prv_DmaHt(void *arg);
+
+/**
+ * @brief DMA传输错误中断回调
+ * @param arg ADC句柄指针
+ */
+static void prv_DmaTe(void *arg);
+
+// ==================== 基础函数实现 ====================
+
+yDrvStatus_t yDrvAdcInitStatic(const yDrvAdcConfig_t *config, yDrvAdcHandle_t *handle)
+{
+    uint32_t cfgr1;
+    uint32_t chselr;
+    uint32_t ccr;
+    uint32_t clock = 0;
+    uint32_t psc = 0;
+    uint32_t reload = 0;
+
+    // 参数有效性检查
+    if (handle == NULL || config == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    yDrvAdcHandleStructInit(handle);
+
+    if ((config->channelNum == 0U) || (config->channelNum > YDRV_ADC_SEQ_MAX) ||
+        (config->resolution > YDRV_ADC_RES_6BIT) || (config->sampleTime > YDRV_ADC_SMP_160_5) ||
+        (config->oversample > YDRV_ADC_OVS_256) || (config->oversampleShift > 8U) ||
+        (config->trigger > YDRV_ADC_TRIG_CONTINUOUS) || (config->buffer == NULL) ||
+        (config->bufferLen == 0U) || (config->bufferLen > 0xFFFFU) ||
+        ((config->bufferLen % (2U * config->channelNum)) != 0U))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 过采样累加结果右移后不得超过16位数据寄存器
+    if ((12U - 2U * (uint32_t)config->resolution + (uint32_t)config->oversample) >
+        (16U + config->oversampleShift))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    chselr = 0;
+    ccr = 0;
+    for (uint32_t i = 0; i < YDRV_ADC_SEQ_MAX; i++)
+    {
+        uint32_t ch = (i < config->channelNum) ? config->channels[i] : YDRV_ADC_SEQ_END;
+
+        if ((i < config->channelNum) && (ch > YDRV_ADC_CHANNEL_MAX))
+        {
+            return YDRV_INVALID_PARAM;
+        }
+        chselr |= ch << (i * 4U);
+
+        ccr |= (ch == YDRV_ADC_CH_TEMP) ? ADC_CCR_TSEN : 0U;
+        ccr |= (ch == YDRV_ADC_CH_VREFINT) ? ADC_CCR_VREFEN : 0U;
+        ccr |= (ch == YDRV_ADC_CH_VBAT) ? ADC_CCR_VBATEN : 0U;
+    }
+
+    // TIM6按帧率分频：先取最小预分频，使重装载值不超过16位
+    if (config->trigger == YDRV_ADC_TRIG_TIM6)
+    {
+        clock = prv_GetTimClockFreq(SystemCoreClock);
+        if ((config->frameHz == 0U) || ((clock / config->frameHz) < 2U))
+        {
+            return YDRV_INVALID_PARAM;
+        }
+        reload = clock / config->frameHz;
+        psc = reload / 0x10000U + 1U;
+        reload /= psc;
+    }
+
+    if (adc_active != NULL)
+    {
+        return YDRV_BUSY;
+    }
+
+    // 1. 复位ADC，同步时钟PCLK/2
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_ADC);
+    LL_APB2_GRP1_ForceReset(LL_APB2_GRP1_PERIPH_ADC);
+    LL_APB2_GRP1_ReleaseReset(LL_APB2_GRP1_PERIPH_ADC);
+    ADC1->CFGR2 = ADC_CFGR2_CKMODE_0;
+
+    // 2. 稳压器启动后校准
+    SET_BIT(ADC1->CR, ADC_CR_ADVREGEN);
+    prv_DelayUs(20U);
+    SET_BIT(ADC1->CR, ADC_CR_ADCAL);
+    if (prv_WaitBit(&ADC1->CR, ADC_CR_ADCAL, 0) != YDRV_OK)
+    {
+        prv_Disable();
+        return YDRV_ERROR;
+    }
+
+    // 3. 可编程序列、循环DMA、触发方式
+    cfgr1 = ADC_CFGR1_DMAEN | ADC_CFGR1_DMACFG | ADC_CFGR1_CHSELRMOD |
+            ((uint32_t)config->resolution << ADC_CFGR1_RES_Pos);
+    if (config->trigger == YDRV_ADC_TRIG_CONTINUOUS)
+    {
+        cfgr1 |= ADC_CFGR1_CONT;
+    }
+    else
+    {
+        cfgr1 |= ADC_CFGR1_EXTEN_0 | ((uint32_t)adc_extsel[config->trigger] << ADC_CFGR1_EXTSEL_Pos);
+    }
+    ADC1->CFGR1 = cfgr1;
+
+    // 4. 过采样，一次触发内每个通道连续完成全部ratio次转换
+    if (config->oversample != YDRV_ADC_OVS_NONE)
+    {
+        ADC1->CFGR2 |= ADC_CFGR2_OVSE |
+                       (((uint32_t)config->oversample - 1U) << ADC_CFGR2_OVSR_Pos) |
+                       ((uint32_t)config->oversampleShift << ADC_CFGR2_OVSS_Pos);
+    }
+
+    ADC1->SMPR = (uint32_t)config->sampleTime << ADC_SMPR_SMP1_Pos; // SMPSEL全0，所有通道用SMP1
+    ADC1_COMMON->CCR = ccr;
+
+    // 5. 使能后写入序列
+    WRITE_REG(ADC1->ISR, ADC_ISR_ADRDY | ADC_ISR_CCRDY);
+    SET_BIT(ADC1->CR, ADC_CR_ADEN);
+    if (prv_WaitBit(&ADC1->ISR, ADC_ISR_ADRDY, 1) != YDRV_OK)
+    {
+        prv_Disable();
+        return YDRV_ERROR;
+    }
+    ADC1->CHSELR = chselr;
+    if (prv_WaitBit(&ADC1->ISR, ADC_ISR_CCRDY, 1) != YDRV_OK)
+    {
+        prv_Disable();
+        return YDRV_ERROR;
+    }
+    WRITE_REG(ADC1->ISR, ADC_ISR_CCRDY);
+
+    // 6. TIM6只产生TRGO，不使用中断
+    if (config->trigger == YDRV_ADC_TRIG_TIM6)
+    {
+        LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM6);
+        LL_TIM_DisableCounter(TIM6);
+        LL_TIM_SetPrescaler(TIM6, psc - 1U);
+        LL_TIM_SetAutoReload(TIM6, reload - 1U);
+        LL_TIM_GenerateEvent_UPDATE(TIM6);
+        LL_TIM_ClearFlag_UPDATE(TIM6);
+        LL_TIM_SetTriggerOutput(TIM6, LL_TIM_TRGO_UPDATE);
+        handle->frameHz = clock / (psc * reload);
+        adc_tick_hz = clock / psc;
+        yDrvClockRegister(&adc_clock_notifier);
+    }
+
+    handle->instance = ADC1;
+    handle->buffer = config->buffer;
+    handle->bufferLen = config->bufferLen;
+    handle->dmaChannel = config->dmaChannel;
+    handle->dmaPriority = config->dmaPriority;
+    handle->prio = config->prio;
+    handle->callback = config->callback;
+    handle->arg = config->arg;
+    handle->channelNum = config->channelNum;
+    handle->trigger = (uint8_t)config->trigger;
+    adc_active = handle;
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvAdcDeInitStatic(yDrvAdcHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->instance == NULL)
+    {
+        return YDRV_OK;
+    }
+
+    (void)yDrvAdcStop(handle);
+    prv_Disable();
+
+    if (handle->trigger == YDRV_ADC_TRIG_TIM6)
+    {
+        yDrvClockUnregister(&adc_clock_notifier);
+        adc_tick_hz = 0;
+        LL_APB1_GRP1_DisableClock(LL_APB1_GRP1_PERIPH_TIM6);
+    }
+
+    adc_active = NULL;
+    handle->instance = NULL;
+    return YDRV_OK;
+}
+
+void yDrvAdcConfigStructInit(yDrvAdcConfig_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    *config = YDRV_ADC_CONFIG_DEFAULT();
+}
+
+void yDrvAdcHandleStructInit(yDrvAdcHandle_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    memset(handle, 0, sizeof(yDrvAdcHandle_t));
+    *handle = YDRV_ADC_HANDLE_DEFAULT();
+}
+
+// ==================== 运行控制函数实现 ====================
+
+yDrvStatus_t yDrvAdcStart(yDrvAdcHandle_t *handle)
+{
+    yDrvDmaConfig_t dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    yDrvDmaExtiConfig_t exti;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->running)
+    {
+        return YDRV_BUSY;
+    }
+
+    // 1. 循环DMA，外设地址固定为DR
+    dma_config.channel = handle->dmaChannel;
+    dma_config.request = YDRV_DMA_REQ_ADC1;
+    dma_config.priority = handle->dmaPriority;
+    dma_config.mode = YDRV_DMA_MODE_CIRCULAR;
+    dma_config.src_width = YDRV_DMA_WIDTH_16BIT;
+    dma_config.dst_width = YDRV_DMA_WIDTH_16BIT;
+    dma_config.src_inc = YDRV_DMA_INC_DISABLE;
+    dma_config.dst_inc = YDRV_DMA_INC_ENABLE;
+    dma_config.dst_buffer = handle->buffer; // P2M使用目标缓冲区
+    dma_config.trans_len = handle->bufferLen;
+    dma_config.owner = "adc";
+
+    if (yDrvDmaInitStatic(&dma_config, &handle->dma, YDRV_DMA_DIR_P2M) != YDRV_OK)
+    {
+        handle->dma = YDRV_DMA_HANDLE_DEFAULT();
+        return YDRV_BUSY;
+    }
+
+    LL_DMA_SetPeriphAddress(handle->dma.DmaInfo.dma, handle->dma.DmaInfo.channel, (uint32_t)&ADC1->DR);
+    LL_DMA_SetPeriphSize(handle->dma.DmaInfo.dma, handle->dma.DmaInfo.channel, LL_DMA_PDATAALIGN_HALFWORD);
+    LL_DMA_SetPeriphIncMode(handle->dma.DmaInfo.dma, handle->dma.DmaInfo.channel, LL_DMA_PERIPH_NOINCREMENT);
+    yDrvDmaClearFlags(&handle->dma);
+
+    if (handle->callback != NULL)
+    {
+        exti.prio = handle->prio;
+        exti.arg = handle;
+        exti.enable = 1;
+
+        exti.trigger = YDRV_DMA_EXTI_HT;
+        exti.function = prv_DmaHt;
+        yDrvDmaRegisterCallback(&handle->dma, &exti);
+        exti.trigger = YDRV_DMA_EXTI_TC;
+        exti.function = prv_DmaTc;
+        yDrvDmaRegisterCallback(&handle->dma, &exti);
+        exti.trigger = YDRV_DMA_EXTI_TE;
+        exti.function = prv_DmaTe;
+        yDrvDmaRegisterCallback(&handle->dma, &exti);
+    }
+
+    // 2. 溢出中断用于重新对齐缓冲区
+    WRITE_REG(ADC1->ISR, ADC_ISR_OVR | ADC_ISR_EOC | ADC_ISR_EOS | ADC_ISR_EOSMP);
+    ADC1->IER = ADC_IER_OVRIE;
+    yDrvIrqSetPriority(ADC1_IRQn, handle->prio);
+    NVIC_ClearPendingIRQ(ADC1_IRQn);
+    NVIC_EnableIRQ(ADC1_IRQn);
+
+    handle->blocks = 0;
+    handle->overruns = 0;
+    handle->running = 1;
+    yDrvDmaTransEnable(&handle->dma);
+
+    // 3. 开始转换，外部触发时ADSTART只是允许触发
+    SET_BIT(ADC1->CR, ADC_CR_ADSTART);
+
+    switch (handle->trigger)
+    {
+    case YDRV_ADC_TRIG_TIM6:
+        LL_TIM_SetCounter(TIM6, 0);
+        LL_TIM_EnableCounter(TIM6);
+        break;
+    case YDRV_ADC_TRIG_TIM1_TRGO2:
+        LL_TIM_SetTriggerOutput2(TIM1, LL_TIM_TRGO2_UPDATE);
+        break;
+    case YDRV_ADC_TRIG_TIM3:
+        LL_TIM_SetTriggerOutput(TIM3, LL_TIM_TRGO_UPDATE);
+        break;
+#if defined(TIM15)
+    case YDRV_ADC_TRIG_TIM15:
+        LL_TIM_SetTriggerOutput(TIM15, LL_TIM_TRGO_UPDATE);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvAdcStop(yDrvAdcHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->running == 0U)
+    {
+        return YDRV_OK;
+    }
+
+    if (handle->trigger == YDRV_ADC_TRIG_TIM6)
+    {
+        LL_TIM_DisableCounter(TIM6);
+    }
+
+    // 先停止转换和溢出中断，再释放DMA通道
+    prv_StopConversion();
+    ADC1->IER = 0;
+    NVIC_DisableIRQ(ADC1_IRQn);
+
+    (void)yDrvDmaDeInitStatic(&handle->dma);
+    handle->dma = YDRV_DMA_HANDLE_DEFAULT();
+    handle->running = 0;
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvAdcReadFrame(yDrvAdcHandle_t *handle, uint16_t *frame)
+{
+    uint32_t len;
+    uint32_t num;
+    uint32_t pos;
+    uint32_t start;
+    uint32_t wrapped;
+
+    // 参数有效性检查
+    if (handle == NULL || frame == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((handle->running == 0U) || (handle->dma.DmaInfo.dma == NULL))
+    {
+        return YDRV_NOT_INITIALIZED;
+    }
+
+    len = handle->bufferLen;
+    num = handle->channelNum;
+
+    // 正在写入的帧的起始位置，上一帧即为最近的完整帧；
+    // 缓冲区至少两帧，复制几个半字期间上一帧不会被覆盖
+    pos = len - yDrvDmaCurLenGet(&handle->dma);
+    pos -= pos % num;
+    wrapped = (handle->blocks != 0U) ||
+              ((handle->callback == NULL) && yDrvDmaIsTransComplete(&handle->dma));
+    if ((pos == 0U) && !wrapped)
+    {
+        return YDRV_BUSY;
+    }
+
+    start = (pos + len - num) % len;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        frame[i] = handle->buffer[start + i];
+    }
+
+    return YDRV_OK;
+}
+
+// ==================== 私有函数实现 ====================
+
+static uint32_t prv_GetTimClockFreq(uint32_t sysclk)
+{
+    uint32_t apb = LL_RCC_GetAPB1Prescaler();
+
+    if (apb == LL_RCC_APB1_DIV_1)
+    {
+        return sysclk;
+    }
+
+    return __LL_RCC_CALC_PCLK1_FREQ(sysclk, apb) * 2U;
+}
+
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg)
+{
+    uint32_t clock;
+    uint32_t psc;
+    uint32_t cnt;
+
+    (void)oldHz;
+    (void)arg;
+
+    if (adc_tick_hz == 0U)
+    {
+        return YDRV_OK;
+    }
+
+    clock = prv_GetTimClockFreq((event == YDRV_CLOCK_PRE) ? newHz : SystemCoreClock);
+    psc = clock / adc_tick_hz;
+    if (event == YDRV_CLOCK_PRE)
+    {
+        // 不能整数分频时帧率会变，否决切换
+        if ((psc == 0U) || (psc > 0x10000U) || ((clock % adc_tick_hz) != 0U))
+        {
+            return YDRV_BUSY;
+        }
+    }
+    else if (event == YDRV_CLOCK_POST)
+    {
+        // 更新事件立即装载预分频；期间TRGO改为计数使能，UG不会多触发一帧，计数值写回保持帧间隔
+        cnt = LL_TIM_GetCounter(TIM6);
+        LL_TIM_SetTriggerOutput(TIM6, LL_TIM_TRGO_ENABLE);
+        LL_TIM_SetPrescaler(TIM6, psc - 1U);
+        LL_TIM_GenerateEvent_UPDATE(TIM6);
+        LL_TIM_SetCounter(TIM6, cnt);
+        LL_TIM_SetTriggerOutput(TIM6, LL_TIM_TRGO_UPDATE);
+    }
+
+    return YDRV_OK;
+}
+
+static void prv_DelayUs(uint32_t us)
+{
+    volatile uint32_t loops = (SystemCoreClock / 4000000U + 1U) * us;
+
+    while (loops != 0U)
+    {
+        loops--;
+    }
+}
+
+static yDrvStatus_t prv_WaitBit(volatile uint32_t *reg, uint32_t mask, uint32_t set)
+{
+    for (uint32_t i = 0; i < YDRV_ADC_TIMEOUT; i++)
+    {
+        if (((*reg & mask) != 0U) == (set != 0U))
+        {
+            return YDRV_OK;
+        }
+    }
+
+    return YDRV_ERROR;
+}
+
+static void prv_StopConversion(void)
+{
+    if (READ_BIT(ADC1->CR, ADC_CR_ADSTART) != 0U)
+    {
+        SET_BIT(ADC1->CR, ADC_CR_ADSTP);
+        (void)prv_WaitBit(&ADC1->CR, ADC_CR_ADSTP, 0);
+    }
+}
+
+static void prv_Disable(void)
+{
+    prv_StopConversion();
+    if (READ_BIT(ADC1->CR, ADC_CR_ADEN) != 0U)
+    {
+        SET_BIT(ADC1->CR, ADC_CR_ADDIS);
+        (void)prv_WaitBit(&ADC1->CR, ADC_CR_ADEN, 0);
+    }
+    ADC1_COMMON->CCR = 0;
+    CLEAR_BIT(ADC1->CR, ADC_CR_ADVREGEN);
+    LL_APB2_GRP1_DisableClock(LL_APB2_GRP1_PERIPH_ADC);
+}
+
+static void prv_DmaTc(void *arg)
+{
+    yDrvAdcHandle_t *handle = (yDrvAdcHandle_t *)arg;
+    uint32_t half = handle->bufferLen / 2U;
+
+    handle->blocks++;
+    handle->callback(handle->arg, YDRV_ADC_EVENT_BLOCK, handle->buffer + half, half);
+}
+
+static void prv_DmaHt(void *arg)
+{
+    yDrvAdcHandle_t *handle = (yDrvAdcHandle_t *)arg;
+
+    handle->blocks++;
+    handle->callback(handle->arg, YDRV_ADC_EVENT_BLOCK, handle->buffer, handle->bufferLen / 2U);
+}
+
+static void prv_DmaTe(void *arg)
+{
+    yDrvAdcHandle_t *handle = (yDrvAdcHandle_t *)arg;
+
+    // 通道已被硬件关闭，停止转换，DMA通道由yDrvAdcStop释放
+    prv_StopConversion();
+    handle->callback(handle->arg, YDRV_ADC_EVENT_ERROR, NULL, 0);
+}
+
+// ==================== 中断处理函数 ====================
+
+/**
+ * @brief ADC中断处理函数
+ * @note 只处理溢出：停止转换，DMA从缓冲区开头重新开始，再允许触发
+ */
+void ADC1_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    yDrvAdcHandle_t *handle = adc_active;
+
+    if (READ_BIT(ADC1->ISR, ADC_ISR_OVR) == 0U)
+    {
+        return;
+    }
+
+    if ((handle == NULL) || (handle->running == 0U))
+    {
+        WRITE_REG(ADC1->ISR, ADC_ISR_OVR);
+        return;
+    }
+
+    prv_StopConversion();
+    (void)ADC1->DR; // 丢弃残留结果，避免重启后立即产生错位的DMA请求
+
+    yDrvDmaTransDisable(&handle->dma);
+    yDrvDmaDstBufferLen(&handle->dma, handle->bufferLen);
+    yDrvDmaClearFlags(&handle->dma);
+    yDrvDmaTransEnable(&handle->dma);
+
+    WRITE_REG(ADC1->ISR, ADC_ISR_OVR | ADC_ISR_EOC | ADC_ISR_EOS | ADC_ISR_EOSMP);
+    handle->overruns++;
+    SET_BIT(ADC1->CR, ADC_CR_ADSTART);
+
+    if (handle->callback != NULL)
+    {
+        handle->callback(handle->arg, YDRV_ADC_EVENT_OVERRUN, NULL, 0);
+    }
+}
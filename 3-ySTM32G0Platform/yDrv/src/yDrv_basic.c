@@ -43,6 +43,73 @@ static GPIO_TypeDef *const gpioPortMap[] = {
 #endif
 };
 
+// ==================== 引脚复用表 ====================
+
+/**
+ * @brief 引脚复用表项
+ */
+typedef struct
+{
+    uint8_t pin;    /*!< 引脚(yDrvGpioPin_t) */
+    uint8_t signal; /*!< 外设信号(yDrvGpioSignal_t) */
+    uint8_t af;     /*!< 复用功能编号 */
+} prv_GpioAf_t;
+
+/**
+ * @brief STM32G070引脚复用表
+ * @note 摘自数据手册端口复用功能映射，只收录驱动用到的外设信号；按引脚排列，Flash常量
+ */
+static const prv_GpioAf_t prv_GpioAfTable[] = {
+    {YDRV_PINA0, YDRV_GPIO_SIG_SPI2_SCK, 0}, {YDRV_PINA0, YDRV_GPIO_SIG_USART2_CTS, 1}, {YDRV_PINA0, YDRV_GPIO_SIG_USART4_TX, 4},
+    {YDRV_PINA1, YDRV_GPIO_SIG_SPI1_SCK, 0}, {YDRV_PINA1, YDRV_GPIO_SIG_USART2_RTS_DE, 1}, {YDRV_PINA1, YDRV_GPIO_SIG_USART4_RX, 4},
+    {YDRV_PINA2, YDRV_GPIO_SIG_SPI1_MOSI, 0}, {YDRV_PINA2, YDRV_GPIO_SIG_USART2_TX, 1}, {YDRV_PINA2, YDRV_GPIO_SIG_TIM15_CH1, 5},
+    {YDRV_PINA3, YDRV_GPIO_SIG_SPI2_MISO, 0}, {YDRV_PINA3, YDRV_GPIO_SIG_USART2_RX, 1}, {YDRV_PINA3, YDRV_GPIO_SIG_TIM15_CH2, 5},
+    {YDRV_PINA4, YDRV_GPIO_SIG_SPI1_NSS, 0}, {YDRV_PINA4, YDRV_GPIO_SIG_SPI2_MOSI, 1}, {YDRV_PINA4, YDRV_GPIO_SIG_TIM14_CH1, 4},
+    {YDRV_PINA5, YDRV_GPIO_SIG_SPI1_SCK, 0}, {YDRV_PINA5, YDRV_GPIO_SIG_USART3_TX, 4},
+    {YDRV_PINA6, YDRV_GPIO_SIG_SPI1_MISO, 0}, {YDRV_PINA6, YDRV_GPIO_SIG_TIM3_CH1, 1}, {YDRV_PINA6, YDRV_GPIO_SIG_TIM16_CH1, 5},
+    {YDRV_PINA7, YDRV_GPIO_SIG_SPI1_MOSI, 0}, {YDRV_PINA7, YDRV_GPIO_SIG_TIM3_CH2, 1}, {YDRV_PINA7, YDRV_GPIO_SIG_TIM14_CH1, 4}, {YDRV_PINA7, YDRV_GPIO_SIG_TIM17_CH1, 5},
+    {YDRV_PINA8, YDRV_GPIO_SIG_SPI2_NSS, 1}, {YDRV_PINA8, YDRV_GPIO_SIG_TIM1_CH1, 2},
+    {YDRV_PINA9, YDRV_GPIO_SIG_USART1_TX, 1}, {YDRV_PINA9, YDRV_GPIO_SIG_TIM1_CH2, 2}, {YDRV_PINA9, YDRV_GPIO_SIG_SPI2_MISO, 4}, {YDRV_PINA9, YDRV_GPIO_SIG_I2C1_SCL, 6},
+    {YDRV_PINA10, YDRV_GPIO_SIG_SPI2_MOSI, 0}, {YDRV_PINA10, YDRV_GPIO_SIG_USART1_RX, 1}, {YDRV_PINA10, YDRV_GPIO_SIG_TIM1_CH3, 2}, {YDRV_PINA10, YDRV_GPIO_SIG_I2C1_SDA, 6},
+    {YDRV_PINA11, YDRV_GPIO_SIG_SPI1_MISO, 0}, {YDRV_PINA11, YDRV_GPIO_SIG_USART1_CTS, 1}, {YDRV_PINA11, YDRV_GPIO_SIG_TIM1_CH4, 2}, {YDRV_PINA11, YDRV_GPIO_SIG_I2C2_SCL, 6},
+    {YDRV_PINA12, YDRV_GPIO_SIG_SPI1_MOSI, 0}, {YDRV_PINA12, YDRV_GPIO_SIG_USART1_RTS_DE, 1}, {YDRV_PINA12, YDRV_GPIO_SIG_I2C2_SDA, 6},
+    {YDRV_PINA14, YDRV_GPIO_SIG_USART2_TX, 1},
+    {YDRV_PINA15, YDRV_GPIO_SIG_SPI1_NSS, 0}, {YDRV_PINA15, YDRV_GPIO_SIG_USART2_RX, 1}, {YDRV_PINA15, YDRV_GPIO_SIG_USART3_RTS_DE, 4},
+    {YDRV_PINB0, YDRV_GPIO_SIG_SPI1_NSS, 0}, {YDRV_PINB0, YDRV_GPIO_SIG_TIM3_CH3, 1}, {YDRV_PINB0, YDRV_GPIO_SIG_USART3_RX, 4},
+    {YDRV_PINB1, YDRV_GPIO_SIG_TIM14_CH1, 0}, {YDRV_PINB1, YDRV_GPIO_SIG_TIM3_CH4, 1}, {YDRV_PINB1, YDRV_GPIO_SIG_USART3_RTS_DE, 4},
+    {YDRV_PINB2, YDRV_GPIO_SIG_SPI2_MISO, 1}, {YDRV_PINB2, YDRV_GPIO_SIG_USART3_TX, 4},
+    {YDRV_PINB3, YDRV_GPIO_SIG_SPI1_SCK, 0}, {YDRV_PINB3, YDRV_GPIO_SIG_TIM1_CH2, 1}, {YDRV_PINB3, YDRV_GPIO_SIG_USART1_RTS_DE, 4},
+    {YDRV_PINB4, YDRV_GPIO_SIG_SPI1_MISO, 0}, {YDRV_PINB4, YDRV_GPIO_SIG_TIM3_CH1, 1}, {YDRV_PINB4, YDRV_GPIO_SIG_USART1_CTS, 4},
+    {YDRV_PINB5, YDRV_GPIO_SIG_SPI1_MOSI, 0}, {YDRV_PINB5, YDRV_GPIO_SIG_TIM3_CH2, 1},
+    {YDRV_PINB6, YDRV_GPIO_SIG_USART1_TX, 0}, {YDRV_PINB6, YDRV_GPIO_SIG_TIM1_CH3, 1}, {YDRV_PINB6, YDRV_GPIO_SIG_SPI2_MISO, 4}, {YDRV_PINB6, YDRV_GPIO_SIG_I2C1_SCL, 6},
+    {YDRV_PINB7, YDRV_GPIO_SIG_USART1_RX, 0}, {YDRV_PINB7, YDRV_GPIO_SIG_SPI2_MOSI, 1}, {YDRV_PINB7, YDRV_GPIO_SIG_I2C1_SDA, 6},
+    {YDRV_PINB8, YDRV_GPIO_SIG_SPI2_SCK, 1}, {YDRV_PINB8, YDRV_GPIO_SIG_TIM16_CH1, 2}, {YDRV_PINB8, YDRV_GPIO_SIG_USART3_TX, 4}, {YDRV_PINB8, YDRV_GPIO_SIG_I2C1_SCL, 6},
+    {YDRV_PINB9, YDRV_GPIO_SIG_TIM17_CH1, 2}, {YDRV_PINB9, YDRV_GPIO_SIG_USART3_RX, 4}, {YDRV_PINB9, YDRV_GPIO_SIG_SPI2_NSS, 5}, {YDRV_PINB9, YDRV_GPIO_SIG_I2C1_SDA, 6},
+    {YDRV_PINB10, YDRV_GPIO_SIG_USART3_TX, 4}, {YDRV_PINB10, YDRV_GPIO_SIG_SPI2_SCK, 5}, {YDRV_PINB10, YDRV_GPIO_SIG_I2C2_SCL, 6},
+    {YDRV_PINB11, YDRV_GPIO_SIG_SPI2_MOSI, 0}, {YDRV_PINB11, YDRV_GPIO_SIG_USART3_RX, 4}, {YDRV_PINB11, YDRV_GPIO_SIG_I2C2_SDA, 6},
+    {YDRV_PINB12, YDRV_GPIO_SIG_SPI2_NSS, 0},
+    {YDRV_PINB13, YDRV_GPIO_SIG_SPI2_SCK, 0}, {YDRV_PINB13, YDRV_GPIO_SIG_USART3_CTS, 4}, {YDRV_PINB13, YDRV_GPIO_SIG_I2C2_SCL, 6},
+    {YDRV_PINB14, YDRV_GPIO_SIG_SPI2_MISO, 0}, {YDRV_PINB14, YDRV_GPIO_SIG_USART3_RTS_DE, 4}, {YDRV_PINB14, YDRV_GPIO_SIG_TIM15_CH1, 5}, {YDRV_PINB14, YDRV_GPIO_SIG_I2C2_SDA, 6},
+    {YDRV_PINB15, YDRV_GPIO_SIG_SPI2_MOSI, 0}, {YDRV_PINB15, YDRV_GPIO_SIG_TIM15_CH2, 5},
+    {YDRV_PINC4, YDRV_GPIO_SIG_USART3_TX, 0}, {YDRV_PINC4, YDRV_GPIO_SIG_USART1_TX, 1},
+    {YDRV_PINC5, YDRV_GPIO_SIG_USART3_RX, 0}, {YDRV_PINC5, YDRV_GPIO_SIG_USART1_RX, 1},
+    {YDRV_PINC6, YDRV_GPIO_SIG_TIM3_CH1, 1},
+    {YDRV_PINC7, YDRV_GPIO_SIG_TIM3_CH2, 1},
+    {YDRV_PINC8, YDRV_GPIO_SIG_TIM3_CH3, 1}, {YDRV_PINC8, YDRV_GPIO_SIG_TIM1_CH1, 2},
+    {YDRV_PINC9, YDRV_GPIO_SIG_TIM3_CH4, 1}, {YDRV_PINC9, YDRV_GPIO_SIG_TIM1_CH2, 2},
+    {YDRV_PINC10, YDRV_GPIO_SIG_USART3_TX, 0}, {YDRV_PINC10, YDRV_GPIO_SIG_USART4_TX, 1}, {YDRV_PINC10, YDRV_GPIO_SIG_TIM1_CH3, 2},
+    {YDRV_PINC11, YDRV_GPIO_SIG_USART3_RX, 0}, {YDRV_PINC11, YDRV_GPIO_SIG_USART4_RX, 1}, {YDRV_PINC11, YDRV_GPIO_SIG_TIM1_CH4, 2},
+    {YDRV_PINC12, YDRV_GPIO_SIG_TIM14_CH1, 2},
+    {YDRV_PIND0, YDRV_GPIO_SIG_SPI2_NSS, 1}, {YDRV_PIND0, YDRV_GPIO_SIG_TIM16_CH1, 2},
+    {YDRV_PIND1, YDRV_GPIO_SIG_SPI2_SCK, 1}, {YDRV_PIND1, YDRV_GPIO_SIG_TIM17_CH1, 2},
+    {YDRV_PIND3, YDRV_GPIO_SIG_USART2_CTS, 0}, {YDRV_PIND3, YDRV_GPIO_SIG_SPI2_MISO, 1},
+    {YDRV_PIND4, YDRV_GPIO_SIG_USART2_RTS_DE, 0}, {YDRV_PIND4, YDRV_GPIO_SIG_SPI2_MOSI, 1},
+    {YDRV_PIND5, YDRV_GPIO_SIG_USART2_TX, 0}, {YDRV_PIND5, YDRV_GPIO_SIG_SPI1_MISO, 1},
+    {YDRV_PIND6, YDRV_GPIO_SIG_USART2_RX, 0}, {YDRV_PIND6, YDRV_GPIO_SIG_SPI1_MOSI, 1},
+    {YDRV_PIND8, YDRV_GPIO_SIG_USART3_TX, 0}, {YDRV_PIND8, YDRV_GPIO_SIG_SPI1_SCK, 1},
+    {YDRV_PIND9, YDRV_GPIO_SIG_USART3_RX, 0}, {YDRV_PIND9, YDRV_GPIO_SIG_SPI1_NSS, 1},
+};
+
 // ==================== 私有函数声明 ====================
 
 /**
@@ -124,6 +191,143 @@ yDrvStatus_t yDrvParseGpio(yDrvGpioPin_t index, yDrvGpioInfo_t *pGpioInfo)
     return YDRV_OK;
 }
 
+yDrvStatus_t yDrvGpioAfLookup(yDrvGpioPin_t pin, yDrvGpioSignal_t signal, uint32_t *af)
+{
+    uint32_t i;
+
+    if (af == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    for (i = 0; i < (sizeof(prv_GpioAfTable) / sizeof(prv_GpioAfTable[0])); i++)
+    {
+        if ((prv_GpioAfTable[i].pin == (uint8_t)pin) && (prv_GpioAfTable[i].signal == (uint8_t)signal))
+        {
+            *af = prv_GpioAfTable[i].af;
+            return YDRV_OK;
+        }
+    }
+
+    return YDRV_INVALID_PARAM;
+}
+
+yDrvStatus_t yDrvGpioSetupPins(const yDrvGpioPinSetup_t *setup, uint32_t count)
+{
+    yDrvGpioInfo_t info[YDRV_GPIO_SETUP_MAX];
+    uint32_t af[YDRV_GPIO_SETUP_MAX];
+    GPIO_TypeDef *port;
+    uint32_t moder_mask, moder;
+    uint32_t ospeedr_mask, ospeedr;
+    uint32_t pupdr_mask, pupdr;
+    uint32_t otyper_mask, otyper;
+    uint32_t afr_mask[2], afr[2];
+    uint32_t bsrr;
+    uint32_t done = 0;
+    uint32_t i, j, shift2, shift4;
+
+    if ((setup == NULL) || (count == 0U) || (count > YDRV_GPIO_SETUP_MAX))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 1. 先解析全部引脚和复用功能，任一失败则不改动寄存器
+    for (i = 0; i < count; i++)
+    {
+        if (yDrvParseGpio(setup[i].pin, &info[i]) != YDRV_OK)
+        {
+            return YDRV_INVALID_PARAM;
+        }
+        af[i] = setup[i].af;
+        if ((setup[i].mode == LL_GPIO_MODE_ALTERNATE) && (af[i] == YDRV_GPIO_AF_AUTO) &&
+            (yDrvGpioAfLookup(setup[i].pin, (yDrvGpioSignal_t)setup[i].signal, &af[i]) != YDRV_OK))
+        {
+            return YDRV_INVALID_PARAM;
+        }
+    }
+
+    // 2. 按端口合并，每个寄存器读改写一次
+    for (i = 0; i < count; i++)
+    {
+        if ((done & (1UL << i)) != 0U)
+        {
+            continue;
+        }
+
+        port = info[i].port;
+        moder_mask = moder = 0;
+        ospeedr_mask = ospeedr = 0;
+        pupdr_mask = pupdr = 0;
+        otyper_mask = otyper = 0;
+        afr_mask[0] = afr_mask[1] = afr[0] = afr[1] = 0;
+        bsrr = 0;
+
+        for (j = i; j < count; j++)
+        {
+            if (info[j].port != port)
+            {
+                continue;
+            }
+            done |= 1UL << j;
+
+            shift2 = (uint32_t)info[j].pinIndex * 2U;
+            shift4 = ((uint32_t)info[j].pinIndex & 7U) * 4U;
+            moder_mask |= 3UL << shift2;
+            moder |= ((uint32_t)setup[j].mode & 3U) << shift2;
+            pupdr_mask |= 3UL << shift2;
+            pupdr |= ((uint32_t)setup[j].pull & 3U) << shift2;
+            if ((setup[j].mode == LL_GPIO_MODE_OUTPUT) || (setup[j].mode == LL_GPIO_MODE_ALTERNATE))
+            {
+                ospeedr_mask |= 3UL << shift2;
+                ospeedr |= ((uint32_t)setup[j].speed & 3U) << shift2;
+                otyper_mask |= info[j].pinMask;
+                otyper |= (setup[j].outputType != 0U) ? info[j].pinMask : 0U;
+            }
+            if (setup[j].mode == LL_GPIO_MODE_ALTERNATE)
+            {
+                afr_mask[info[j].pinIndex >> 3] |= 0xFUL << shift4;
+                afr[info[j].pinIndex >> 3] |= (af[j] & 0xFU) << shift4;
+            }
+            if (setup[j].preset == 1U)
+            {
+                bsrr |= (uint32_t)info[j].pinMask << 16;
+            }
+            else if (setup[j].preset == 2U)
+            {
+                bsrr |= info[j].pinMask;
+            }
+
+            info[j].flag = 1;
+            if (setup[j].info != NULL)
+            {
+                *setup[j].info = info[j];
+            }
+        }
+
+        if (bsrr != 0U)
+        {
+            WRITE_REG(port->BSRR, bsrr);
+        }
+        if (ospeedr_mask != 0U)
+        {
+            MODIFY_REG(port->OSPEEDR, ospeedr_mask, ospeedr);
+            MODIFY_REG(port->OTYPER, otyper_mask, otyper);
+        }
+        MODIFY_REG(port->PUPDR, pupdr_mask, pupdr);
+        if (afr_mask[0] != 0U)
+        {
+            MODIFY_REG(port->AFR[0], afr_mask[0], afr[0]);
+        }
+        if (afr_mask[1] != 0U)
+        {
+            MODIFY_REG(port->AFR[1], afr_mask[1], afr[1]);
+        }
+        MODIFY_REG(port->MODER, moder_mask, moder);
+    }
+
+    return YDRV_OK;
+}
+
 int32_t yDrvIsGpioValid(yDrvGpioPin_t index)
 {
     if (index <= YDRV_PINNULL || index >= YDRV_PINMAX)
@@ -131,7 +335,7 @@ int32_t yDrvIsGpioValid(yDrvGpioPin_t index)
         return -1; // 参数错误
     }
 
-    uint8_t portIndex = index / 16;
+    uint8_t portIndex = ((uint32_t)index - 1) / 16;
 
     // 检查端口是否存在
     if (portIndex >= sizeof(gpioPortMap) / sizeof(gpioPortMap[0]) ||
@@ -0,0 +1,517 @@
+/**
+ * @file yDrv_bitbang.c
+ * @brief STM32G0 时序敏感协议位操作引擎实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现1-Wire的RAM时隙和WS2812的定时器DMA双缓冲编码
+ *
+ * @par 实现说明:
+ * - 1-Wire所有时隙由同一个RAM函数完成：拉低、释放、采样、恢复四段，前两段可选关中断；
+ *   RAM中不做除法(M0+的除法在Flash中的libgcc里)，圈数在Flash侧按SystemCoreClock算好
+ * - 延时循环为subs+bne，零等待RAM中每圈3个周期，64MHz下分辨率约47ns
+ * - WS2812每个半区的编码在DMA播放另一半区时完成，编码函数在RAM中，
+ *   64MHz下48位约需10us，远小于一个半区的60us播放时间
+ * - 数据结束后继续填全0半区输出低电平，已播放的全0半区覆盖复位时间后停止DMA
+ */
+
+#include "yDrv_bitbang.h"
+#include "stm32g0xx_ll_gpio.h"
+
+// ==================== 私有定义 ====================
+
+/**
+ * @brief 时序函数固定放入.RamFunc段，不随YLIB_RAMFUNC_ENABLE关闭
+ */
+#define YDRV_BITBANG_RAMFUNC __attribute__((section(".RamFunc"), noinline))
+
+/**
+ * @brief 延时循环每圈的周期数
+ */
+#define YDRV_BITBANG_LOOP_CYCLES (3U)
+
+/**
+ * @brief 1-Wire标准速率时序(us)
+ */
+#define YDRV_ONEWIRE_RESET_LOW (480U)   /*!< 复位低电平 */
+#define YDRV_ONEWIRE_RESET_SAMPLE (70U) /*!< 释放到采样应答 */
+#define YDRV_ONEWIRE_RESET_REST (410U)  /*!< 采样后等待应答结束 */
+#define YDRV_ONEWIRE_WRITE1_LOW (6U)    /*!< 写1低电平 */
+#define YDRV_ONEWIRE_WRITE1_REST (64U)  /*!< 写1释放后到时隙结束 */
+#define YDRV_ONEWIRE_WRITE0_LOW (60U)   /*!< 写0低电平 */
+#define YDRV_ONEWIRE_WRITE0_REST (10U)  /*!< 写0释放后恢复 */
+#define YDRV_ONEWIRE_READ_LOW (6U)      /*!< 读时隙起始低电平 */
+#define YDRV_ONEWIRE_READ_SAMPLE (9U)   /*!< 释放到采样，采样点距起始15us */
+#define YDRV_ONEWIRE_READ_REST (55U)    /*!< 采样后到时隙结束 */
+
+/**
+ * @brief WS2812位时序，计数时钟16MHz下的计数值
+ */
+#define YDRV_WS2812_TICK_HZ (16000000U)
+#define YDRV_WS2812_PERIOD (20U) /*!< 位周期1.25us */
+#define YDRV_WS2812_T0H (6U)     /*!< 0码高电平375ns */
+#define YDRV_WS2812_T1H (13U)    /*!< 1码高电平812ns */
+
+/**
+ * @brief WS2812复位时间对应的全0半区数(向上取整)
+ */
+#define YDRV_WS2812_RESET_HALVES \
+    (((YDRV_WS2812_RESET_US * 4U / 5U) + YDRV_WS2812_HALF_BITS - 1U) / YDRV_WS2812_HALF_BITS)
+
+#if (YDRV_WS2812_HALF_BITS % 8U) != 0U
+#error "YDRV_WS2812_HALF_BITS must be a multiple of 8"
+#endif
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 按圈数延时
+ * @param loops 圈数，0立即返回
+ */
+YDRV_BITBANG_RAMFUNC static void prv_Delay(uint32_t loops);
+
+/**
+ * @brief 执行一个1-Wire时隙
+ * @param port 引脚端口
+ * @param pin 引脚掩码
+ * @param low 拉低圈数
+ * @param sample 释放到采样的圈数
+ * @param rest 采样后到时隙结束的圈数
+ * @param mask 非0时拉低到采样期间关中断
+ * @retval uint32_t 采样时的引脚电平，非0为高
+ */
+YDRV_BITBANG_RAMFUNC static uint32_t prv_OneWireSlot(GPIO_TypeDef *port, uint32_t pin, uint32_t low,
+                                                     uint32_t sample, uint32_t rest, uint32_t mask);
+
+/**
+ * @brief 按当前系统时钟更新每微秒圈数
+ * @param handle 句柄指针
+ */
+static void prv_OneWireTiming(yDrvOneWireHandle_t *handle);
+
+/**
+ * @brief 微秒换算为圈数
+ * @param handle 句柄指针
+ * @param us 微秒
+ * @retval uint32_t 圈数
+ */
+static uint32_t prv_Loops(const yDrvOneWireHandle_t *handle, uint32_t us);
+
+/**
+ * @brief 以预先算好的圈数写一位
+ * @param handle 句柄指针
+ * @param bit 非0写1
+ */
+static void prv_OneWireWriteBit(const yDrvOneWireHandle_t *handle, uint32_t bit);
+
+/**
+ * @brief 以预先算好的圈数读一位
+ * @param handle 句柄指针
+ * @retval uint32_t 读到的位
+ */
+static uint32_t prv_OneWireReadBit(const yDrvOneWireHandle_t *handle);
+
+/**
+ * @brief 编码一个半区
+ * @param handle 灯带句柄指针
+ * @param slot 半区起始
+ * @note 没有数据可编码时填全0并计入idle
+ */
+YDRV_BITBANG_RAMFUNC static void prv_Ws2812Fill(yDrvWs2812Handle_t *handle, uint16_t *slot);
+
+/**
+ * @brief 定时器DMA回调，重填播放完的半区
+ * @param arg 灯带句柄指针
+ * @param event YDRV_DMA_EXTI_HT/TC/TE
+ */
+YDRV_BITBANG_RAMFUNC static void prv_Ws2812Event(void *arg, yDrvDmaExti_t event);
+
+/**
+ * @brief 结束刷新并调用完成回调
+ * @param handle 灯带句柄指针
+ */
+static void prv_Ws2812Finish(yDrvWs2812Handle_t *handle);
+
+// ==================== 1-Wire函数实现 ====================
+
+yDrvStatus_t yDrvOneWireInit(const yDrvOneWireConfig_t *config, yDrvOneWireHandle_t *handle)
+{
+    GPIO_TypeDef *port;
+    uint32_t pin;
+
+    // 参数有效性检查
+    if (config == NULL || handle == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    *handle = YDRV_ONEWIRE_HANDLE_DEFAULT();
+    if (yDrvParseGpio(config->pin, &handle->pinInfo) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    port = handle->pinInfo.port;
+    pin = handle->pinInfo.pinMask;
+
+    // 先置ODR为高，切换为输出时总线保持释放
+    LL_GPIO_SetOutputPin(port, pin);
+    LL_GPIO_SetPinOutputType(port, pin, LL_GPIO_OUTPUT_OPENDRAIN);
+    LL_GPIO_SetPinSpeed(port, pin, LL_GPIO_SPEED_FREQ_HIGH);
+    LL_GPIO_SetPinPull(port, pin, config->pullUp ? LL_GPIO_PULL_UP : LL_GPIO_PULL_NO);
+    LL_GPIO_SetPinMode(port, pin, LL_GPIO_MODE_OUTPUT);
+
+    prv_OneWireTiming(handle);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvOneWireDeInit(yDrvOneWireHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->pinInfo.port == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    LL_GPIO_SetPinMode(handle->pinInfo.port, handle->pinInfo.pinMask, LL_GPIO_MODE_ANALOG);
+    LL_GPIO_SetPinPull(handle->pinInfo.port, handle->pinInfo.pinMask, LL_GPIO_PULL_NO);
+    *handle = YDRV_ONEWIRE_HANDLE_DEFAULT();
+
+    return YDRV_OK;
+}
+
+uint8_t yDrvOneWireReset(yDrvOneWireHandle_t *handle)
+{
+    uint32_t level;
+
+    prv_OneWireTiming(handle);
+
+    // 应答脉冲持续60~240us，480us的低电平被中断拉长不影响器件
+    level = prv_OneWireSlot(handle->pinInfo.port, handle->pinInfo.pinMask,
+                            prv_Loops(handle, YDRV_ONEWIRE_RESET_LOW),
+                            prv_Loops(handle, YDRV_ONEWIRE_RESET_SAMPLE),
+                            prv_Loops(handle, YDRV_ONEWIRE_RESET_REST), 0);
+
+    return (level == 0U) ? 1U : 0U;
+}
+
+void yDrvOneWireWrite(yDrvOneWireHandle_t *handle, const uint8_t *data, uint32_t len)
+{
+    uint32_t i;
+    uint32_t bit;
+
+    prv_OneWireTiming(handle);
+
+    for (i = 0; i < len; i++)
+    {
+        for (bit = 0; bit < 8U; bit++)
+        {
+            prv_OneWireWriteBit(handle, (data[i] >> bit) & 1U);
+        }
+    }
+}
+
+void yDrvOneWireRead(yDrvOneWireHandle_t *handle, uint8_t *data, uint32_t len)
+{
+    uint32_t i;
+    uint32_t bit;
+    uint32_t value;
+
+    prv_OneWireTiming(handle);
+
+    for (i = 0; i < len; i++)
+    {
+        value = 0;
+        for (bit = 0; bit < 8U; bit++)
+        {
+            value |= prv_OneWireReadBit(handle) << bit;
+        }
+        data[i] = (uint8_t)value;
+    }
+}
+
+uint8_t yDrvOneWireReadBit(yDrvOneWireHandle_t *handle)
+{
+    prv_OneWireTiming(handle);
+
+    return (uint8_t)prv_OneWireReadBit(handle);
+}
+
+void yDrvOneWireWriteBit(yDrvOneWireHandle_t *handle, uint32_t bit)
+{
+    prv_OneWireTiming(handle);
+    prv_OneWireWriteBit(handle, bit);
+}
+
+uint8_t yDrvOneWireCrc8(const uint8_t *data, uint32_t len)
+{
+    uint32_t crc = 0;
+    uint32_t i;
+    uint32_t bit;
+
+    for (i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (bit = 0; bit < 8U; bit++)
+        {
+            crc = (crc & 1U) ? ((crc >> 1) ^ 0x8CU) : (crc >> 1);
+        }
+    }
+
+    return (uint8_t)crc;
+}
+
+// ==================== WS2812函数实现 ====================
+
+yDrvStatus_t yDrvWs2812Init(const yDrvWs2812Config_t *config, yDrvWs2812Handle_t *handle)
+{
+    yDrvTimConfig_t tim_config = YDRV_TIM_CONFIG_DEFAULT();
+    yDrvStatus_t status;
+
+    // 参数有效性检查
+    if (config == NULL || handle == NULL || config->pin == YDRV_PINNULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    handle->tim = YDRV_TIM_HANDLE_DEFAULT();
+    handle->data = NULL;
+    handle->len = 0;
+    handle->pos = 0;
+    handle->idle = 0;
+    handle->idleMax = YDRV_WS2812_RESET_HALVES + 2U;
+    handle->done = NULL;
+    handle->arg = NULL;
+    handle->busy = 0;
+
+    // 比较值0时输出恒低，作为空闲电平
+    tim_config.timId = config->timId;
+    tim_config.channel = config->channel;
+    tim_config.mode = YDRV_TIM_MODE_PWM;
+    tim_config.pin = config->pin;
+    tim_config.pinAF = config->pinAF;
+    tim_config.openDrain = config->openDrain;
+    tim_config.tickHz = YDRV_WS2812_TICK_HZ;
+    tim_config.period = YDRV_WS2812_PERIOD;
+    tim_config.pulse = 0;
+    tim_config.polarity = YDRV_TIM_POLARITY_HIGH;
+    tim_config.dma.priority = config->priority;
+    tim_config.dma.circular = 1;
+    tim_config.dma.prio = config->prio;
+    tim_config.dma.callback = prv_Ws2812Event;
+    tim_config.dma.arg = handle;
+
+    status = yDrvTimInitStatic(&tim_config, &handle->tim);
+    if (status != YDRV_OK)
+    {
+        return status;
+    }
+
+    return yDrvTimStart(&handle->tim);
+}
+
+yDrvStatus_t yDrvWs2812DeInit(yDrvWs2812Handle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->tim.instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    (void)yDrvTimDmaStop(&handle->tim);
+    (void)yDrvTimStop(&handle->tim);
+    handle->busy = 0;
+
+    return yDrvTimDeInitStatic(&handle->tim);
+}
+
+yDrvStatus_t yDrvWs2812Write(yDrvWs2812Handle_t *handle, const uint8_t *grb, uint32_t len,
+                             yDrvWs2812Done_t done, void *arg)
+{
+    yDrvStatus_t status;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->tim.instance == NULL || (grb == NULL && len != 0U))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->busy)
+    {
+        return YDRV_BUSY;
+    }
+
+    handle->data = grb;
+    handle->len = len;
+    handle->pos = 0;
+    handle->idle = 0;
+    handle->done = done;
+    handle->arg = arg;
+    handle->busy = 1;
+
+    // 两个半区都先编码好，之后每播放完一个半区重填一次
+    prv_Ws2812Fill(handle, &handle->slot[0]);
+    prv_Ws2812Fill(handle, &handle->slot[YDRV_WS2812_HALF_BITS]);
+
+    status = yDrvTimBurstStart(&handle->tim,
+                               (yDrvTimBurstBase_t)(YDRV_TIM_BURST_CCR1 + handle->tim.channel),
+                               1U, handle->slot, 2U * YDRV_WS2812_HALF_BITS);
+    if (status != YDRV_OK)
+    {
+        handle->busy = 0;
+    }
+
+    return status;
+}
+
+// ==================== 私有函数实现 ====================
+
+YDRV_BITBANG_RAMFUNC static void prv_Delay(uint32_t loops)
+{
+    if (loops == 0U)
+    {
+        return;
+    }
+
+    __asm volatile("1:                  \n"
+                   "    subs %0, %0, #1 \n"
+                   "    bne 1b          \n"
+                   : "+l"(loops)
+                   :
+                   : "cc");
+}
+
+YDRV_BITBANG_RAMFUNC static uint32_t prv_OneWireSlot(GPIO_TypeDef *port, uint32_t pin, uint32_t low,
+                                                     uint32_t sample, uint32_t rest, uint32_t mask)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t level;
+
+    if (mask)
+    {
+        __disable_irq();
+    }
+
+    port->BRR = pin;
+    prv_Delay(low);
+    port->BSRR = pin;
+    prv_Delay(sample);
+    level = port->IDR & pin;
+
+    if (mask)
+    {
+        __set_PRIMASK(primask);
+    }
+
+    prv_Delay(rest);
+
+    return level;
+}
+
+static void prv_OneWireTiming(yDrvOneWireHandle_t *handle)
+{
+    // 时钟切换后第一次操作即按新时钟计时
+    handle->loopsPerUs16 = (SystemCoreClock / 1000000U) * 16U / YDRV_BITBANG_LOOP_CYCLES;
+}
+
+static uint32_t prv_Loops(const yDrvOneWireHandle_t *handle, uint32_t us)
+{
+    return (us * handle->loopsPerUs16) >> 4;
+}
+
+static void prv_OneWireWriteBit(const yDrvOneWireHandle_t *handle, uint32_t bit)
+{
+    // 写1的低电平上限15us，必须关中断；写0的60us低电平可拉长到120us，不关中断
+    if (bit)
+    {
+        (void)prv_OneWireSlot(handle->pinInfo.port, handle->pinInfo.pinMask,
+                              prv_Loops(handle, YDRV_ONEWIRE_WRITE1_LOW), 0,
+                              prv_Loops(handle, YDRV_ONEWIRE_WRITE1_REST), 1);
+    }
+    else
+    {
+        (void)prv_OneWireSlot(handle->pinInfo.port, handle->pinInfo.pinMask,
+                              prv_Loops(handle, YDRV_ONEWIRE_WRITE0_LOW), 0,
+                              prv_Loops(handle, YDRV_ONEWIRE_WRITE0_REST), 0);
+    }
+}
+
+static uint32_t prv_OneWireReadBit(const yDrvOneWireHandle_t *handle)
+{
+    uint32_t level;
+
+    // 器件输出的数据只保证到时隙起始后15us，拉低到采样期间关中断
+    level = prv_OneWireSlot(handle->pinInfo.port, handle->pinInfo.pinMask,
+                            prv_Loops(handle, YDRV_ONEWIRE_READ_LOW),
+                            prv_Loops(handle, YDRV_ONEWIRE_READ_SAMPLE),
+                            prv_Loops(handle, YDRV_ONEWIRE_READ_REST), 1);
+
+    return (level != 0U) ? 1U : 0U;
+}
+
+YDRV_BITBANG_RAMFUNC static void prv_Ws2812Fill(yDrvWs2812Handle_t *handle, uint16_t *slot)
+{
+    uint32_t i;
+    uint32_t bit;
+    uint32_t value;
+    uint32_t n = 0;
+
+    // 高位先发，每字节8个比较值
+    for (i = 0; i < YDRV_WS2812_HALF_BITS / 8U && handle->pos < handle->len; i++)
+    {
+        value = handle->data[handle->pos++];
+        for (bit = 0; bit < 8U; bit++)
+        {
+            slot[n++] = (value & 0x80U) ? YDRV_WS2812_T1H : YDRV_WS2812_T0H;
+            value <<= 1;
+        }
+    }
+
+    if (n == 0U)
+    {
+        handle->idle++;
+    }
+
+    while (n < YDRV_WS2812_HALF_BITS)
+    {
+        slot[n++] = 0;
+    }
+}
+
+YDRV_BITBANG_RAMFUNC static void prv_Ws2812Event(void *arg, yDrvDmaExti_t event)
+{
+    yDrvWs2812Handle_t *handle = (yDrvWs2812Handle_t *)arg;
+
+    if (event == YDRV_DMA_EXTI_TE)
+    {
+        prv_Ws2812Finish(handle);
+        return;
+    }
+
+    // 播放完的半区在两个半区之后才再次播放，此时重填正好赶在它之前
+    prv_Ws2812Fill(handle, (event == YDRV_DMA_EXTI_HT) ? &handle->slot[0]
+                                                       : &handle->slot[YDRV_WS2812_HALF_BITS]);
+
+    // 第k次填入全0时，已播放的全0半区为k-2个
+    if (handle->idle >= handle->idleMax)
+    {
+        prv_Ws2812Finish(handle);
+    }
+}
+
+static void prv_Ws2812Finish(yDrvWs2812Handle_t *handle)
+{
+    yDrvWs2812Done_t done = handle->done;
+
+    (void)yDrvTimDmaStop(&handle->tim);
+    yDrvTimSetCompare(&handle->tim, 0);
+    handle->busy = 0;
+
+    if (done != NULL)
+    {
+        done(handle->arg);
+    }
+}
@@ -0,0 +1,332 @@
+/**
+ ******************************************************************************
+ * @file    yDrv_clock.c
+ * @author  yLab2.0
+ * @brief   系统时钟调频实现文件
+ * @details 升频：PRE通知 -> HSE/PLL就绪 -> 临界区(加等待周期、切换、重算时基、POST通知)
+ *          降频：PRE通知 -> 临界区(切换、减等待周期、关闭PLL/HSE、重算时基、POST通知)
+ *          - Flash等待周期：24MHz以下0，48MHz以下1，64MHz为2(电压范围1)
+ *          - TIM17保持1MHz计数，改预分频时保存并恢复计数值，微秒时间戳不跳变
+ *          - SysTick运行时按新频率重设重装载值，RTOS节拍周期不变
+ ******************************************************************************
+ * @attention
+ * POST通知在关中断下执行，切换期间外设时钟已变而分频尚未重算，
+ * 驱动须在PRE中确认没有进行中的传输
+ ******************************************************************************
+ */
+
+/* 包含的头文件 ----------------------------------------------------------------*/
+#include "stm32g0xx.h"
+#include "stm32g0xx_ll_rcc.h"
+#include "stm32g0xx_ll_system.h"
+#include "stm32g0xx_ll_utils.h"
+#include "stm32g0xx_ll_tim.h"
+#include "yDrv_clock.h"
+
+/* 私有变量 --------------------------------------------------------------------*/
+
+/**
+ * @brief 各等级的SYSCLK频率
+ */
+static const uint32_t clock_level_hz[YDRV_CLOCK_LEVEL_MAX] = {
+    [YDRV_CLOCK_64MHZ] = 64000000U,
+    [YDRV_CLOCK_16MHZ] = 16000000U,
+    [YDRV_CLOCK_8MHZ] = 8000000U,
+    [YDRV_CLOCK_4MHZ] = 4000000U,
+};
+
+/**
+ * @brief HSI等级的HSISYS分频
+ */
+static const uint32_t clock_hsi_div[YDRV_CLOCK_LEVEL_MAX] = {
+    [YDRV_CLOCK_64MHZ] = LL_RCC_HSI_DIV_1,
+    [YDRV_CLOCK_16MHZ] = LL_RCC_HSI_DIV_1,
+    [YDRV_CLOCK_8MHZ] = LL_RCC_HSI_DIV_2,
+    [YDRV_CLOCK_4MHZ] = LL_RCC_HSI_DIV_4,
+};
+
+/**
+ * @brief 当前等级，上电为YDRV_CLOCK_BOOT_LEVEL
+ */
+static yDrvClockLevel_t clock_level = YDRV_CLOCK_BOOT_LEVEL;
+
+/**
+ * @brief 已注册的通知
+ */
+static YLIB_LIST_HEAD(clock_notifiers);
+
+/* 私有函数 --------------------------------------------------------------------*/
+
+/**
+ * @brief 频率对应的Flash等待周期
+ */
+static uint32_t yDrv_ClockLatency(uint32_t hz)
+{
+    if (hz <= 24000000U)
+    {
+        return LL_FLASH_LATENCY_0;
+    }
+    if (hz <= 48000000U)
+    {
+        return LL_FLASH_LATENCY_1;
+    }
+    return LL_FLASH_LATENCY_2;
+}
+
+/**
+ * @brief 设置Flash等待周期并等待生效
+ */
+static void yDrv_ClockSetLatency(uint32_t latency)
+{
+    LL_FLASH_SetLatency(latency);
+    while (LL_FLASH_GetLatency() != latency)
+    {
+        // 等待Flash延迟设置完成
+    }
+}
+
+/**
+ * @brief 启动HSE和PLL
+ * @note PLL输出频率 = HSE * N / (M * R) = 8MHz * 16 / (1 * 2) = 64MHz；已就绪时直接返回
+ */
+static void yDrv_ClockStartPll(void)
+{
+    if (LL_RCC_PLL_IsReady() != 0)
+    {
+        return;
+    }
+
+    LL_RCC_HSE_Enable();
+    while (LL_RCC_HSE_IsReady() != 1)
+    {
+        // 等待HSE就绪
+    }
+
+    LL_RCC_PLL_ConfigDomain_SYS(LL_RCC_PLLSOURCE_HSE, LL_RCC_PLLM_DIV_1, 16, LL_RCC_PLLR_DIV_2);
+    LL_RCC_PLL_Enable();
+    LL_RCC_PLL_EnableDomain_SYS();
+    while (LL_RCC_PLL_IsReady() != 1)
+    {
+        // 等待PLL就绪
+    }
+}
+
+/**
+ * @brief 切换时钟源和Flash等待周期
+ * @param level 目标等级
+ * @note 64MHz须先调用yDrv_ClockStartPll；升频先加等待周期，降频后减
+ */
+static void yDrv_ClockApply(yDrvClockLevel_t level)
+{
+    uint32_t latency = yDrv_ClockLatency(clock_level_hz[level]);
+
+    if (latency > LL_FLASH_GetLatency())
+    {
+        yDrv_ClockSetLatency(latency);
+    }
+
+    LL_RCC_SetAHBPrescaler(LL_RCC_SYSCLK_DIV_1);
+    if (level == YDRV_CLOCK_64MHZ)
+    {
+        LL_RCC_SetSysClkSource(LL_RCC_SYS_CLKSOURCE_PLL);
+        while (LL_RCC_GetSysClkSource() != LL_RCC_SYS_CLKSOURCE_STATUS_PLL)
+        {
+            // 等待系统时钟源切换完成
+        }
+    }
+    else
+    {
+        LL_RCC_HSI_Enable();
+        while (LL_RCC_HSI_IsReady() != 1)
+        {
+            // 等待HSI就绪
+        }
+        LL_RCC_SetHSIDiv(clock_hsi_div[level]);
+        LL_RCC_SetSysClkSource(LL_RCC_SYS_CLKSOURCE_HSI);
+        while (LL_RCC_GetSysClkSource() != LL_RCC_SYS_CLKSOURCE_STATUS_HSI)
+        {
+            // 等待系统时钟源切换完成
+        }
+
+        // 不再使用的PLL和HSE关闭，降低运行电流
+        LL_RCC_PLL_Disable();
+        LL_RCC_HSE_Disable();
+    }
+    LL_RCC_SetAPB1Prescaler(LL_RCC_APB1_DIV_1);
+
+    if (latency < LL_FLASH_GetLatency())
+    {
+        yDrv_ClockSetLatency(latency);
+    }
+
+    LL_SetSystemCoreClock(clock_level_hz[level]);
+}
+
+/**
+ * @brief 按新频率重算系统时基
+ * @param hz 新的SYSCLK频率
+ * @note TIM17预分频经更新事件立即装载，URS置位使该事件不触发毫秒中断，计数值写回保持连续；
+ *       SysTick只在RTOS已启动它时重设
+ */
+static void yDrv_ClockRetimeBase(uint32_t hz)
+{
+    uint32_t cnt;
+
+    cnt = LL_TIM_GetCounter(TIM17);
+    LL_TIM_SetUpdateSource(TIM17, LL_TIM_UPDATESOURCE_COUNTER);
+    LL_TIM_SetPrescaler(TIM17, (hz / 1000000U) - 1U);
+    LL_TIM_GenerateEvent_UPDATE(TIM17);
+    LL_TIM_SetCounter(TIM17, cnt);
+    LL_TIM_SetUpdateSource(TIM17, LL_TIM_UPDATESOURCE_REGULAR);
+
+    if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) != 0)
+    {
+        SysTick->LOAD = (uint32_t)(((uint64_t)SysTick->LOAD + 1U) * hz / SystemCoreClock) - 1U;
+        SysTick->VAL = 0;
+    }
+}
+
+/* 公共函数 --------------------------------------------------------------------*/
+
+void yDrvClockRegister(yDrvClockNotifier_t *notifier)
+{
+    yDrvClockNotifier_t *pos;
+    uint32_t primask;
+
+    if ((notifier == NULL) || (notifier->callback == NULL))
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ylib_list_for_each_entry(pos, &clock_notifiers, node)
+    {
+        if (pos == notifier)
+        {
+            __set_PRIMASK(primask);
+            return;
+        }
+    }
+    ylib_list_add_tail(&notifier->node, &clock_notifiers);
+    __set_PRIMASK(primask);
+}
+
+void yDrvClockUnregister(yDrvClockNotifier_t *notifier)
+{
+    yDrvClockNotifier_t *pos;
+    uint32_t primask;
+
+    if (notifier == NULL)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ylib_list_for_each_entry(pos, &clock_notifiers, node)
+    {
+        if (pos == notifier)
+        {
+            ylib_list_del_init(&notifier->node);
+            break;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+yDrvStatus_t yDrvClockSet(yDrvClockLevel_t level)
+{
+    yDrvClockNotifier_t *pos;
+    yDrvClockNotifier_t *veto;
+    uint32_t old_hz;
+    uint32_t new_hz;
+    uint32_t primask;
+
+    if ((uint32_t)level >= YDRV_CLOCK_LEVEL_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+    if (level == clock_level)
+    {
+        return YDRV_OK;
+    }
+
+    old_hz = clock_level_hz[clock_level];
+    new_hz = clock_level_hz[level];
+
+    // 1. 切换前通知，被否决时撤销已通过的通知
+    veto = NULL;
+    ylib_list_for_each_entry(pos, &clock_notifiers, node)
+    {
+        if (pos->callback(YDRV_CLOCK_PRE, old_hz, new_hz, pos->arg) != YDRV_OK)
+        {
+            veto = pos;
+            break;
+        }
+    }
+    if (veto != NULL)
+    {
+        ylib_list_for_each_entry(pos, &clock_notifiers, node)
+        {
+            if (pos == veto)
+            {
+                break;
+            }
+            (void)pos->callback(YDRV_CLOCK_ABORT, old_hz, new_hz, pos->arg);
+        }
+        return YDRV_BUSY;
+    }
+
+    // 2. HSE起振和PLL锁定需要毫秒级时间，放在临界区外
+    if (level == YDRV_CLOCK_64MHZ)
+    {
+        yDrv_ClockStartPll();
+    }
+
+    // 3. 切换并重算时基和外设分频
+    primask = __get_PRIMASK();
+    __disable_irq();
+    yDrv_ClockRetimeBase(new_hz);
+    yDrv_ClockApply(level);
+    clock_level = level;
+    ylib_list_for_each_entry(pos, &clock_notifiers, node)
+    {
+        (void)pos->callback(YDRV_CLOCK_POST, old_hz, new_hz, pos->arg);
+    }
+    __set_PRIMASK(primask);
+
+    return YDRV_OK;
+}
+
+yDrvClockLevel_t yDrvClockGet(void)
+{
+    return clock_level;
+}
+
+uint32_t yDrvClockLevelHz(yDrvClockLevel_t level)
+{
+    if ((uint32_t)level >= YDRV_CLOCK_LEVEL_MAX)
+    {
+        return 0;
+    }
+    return clock_level_hz[level];
+}
+
+void yDrvClockRestore(void)
+{
+    if (clock_level == YDRV_CLOCK_64MHZ)
+    {
+        yDrv_ClockStartPll();
+    }
+    yDrv_ClockApply(clock_level);
+}
+
+void yDrvClockBoot(void)
+{
+    // 起振与后续初始化并行，升频时yDrv_ClockStartPll等待HSE就绪已基本不耗时
+    if (clock_level != YDRV_CLOCK_64MHZ)
+    {
+        LL_RCC_HSE_Enable();
+    }
+}
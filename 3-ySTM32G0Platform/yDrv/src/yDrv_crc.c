@@ -0,0 +1,540 @@
+/**
+ ******************************************************************************
+ * @file    yDrv_crc.c
+ * @author  yLab2.0
+ * @brief   硬件CRC驱动实现文件
+ * @details 基于STM32G0平台CRC计算单元实现的CRC驱动程序
+ *          - 支持可编程多项式、初始值和位反转
+ *          - 4字节对齐部分按字写入，其余按字节写入
+ *          - DMA喂数和yLib CRC硬件后端
+ ******************************************************************************
+ * @attention
+ * 数据寄存器按字写入时先处理最高字节，字节流顺序输入时需先做字节交换；
+ * 按字反转输入时硬件已经把最低字节放到最前面，无需交换
+ ******************************************************************************
+ */
+
+/* 包含的头文件 ----------------------------------------------------------------*/
+#include <string.h>
+#include "yDrv_crc.h"
+#include "yLib_crc.h"
+
+/* 私有宏定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief yLib后端每段数据长度
+ * @note 每段在临界区内完成，64字节约16次字写入，关中断时间不超过几微秒
+ */
+#define YDRV_CRC_YLIB_CHUNK (64U)
+
+/**
+ * @brief DMA单次传输的最大数据项数
+ */
+#define YDRV_CRC_DMA_MAX (0xFFFFU)
+
+/* 私有变量 --------------------------------------------------------------------*/
+
+/**
+ * @brief 结果掩码，按多项式位宽截取数据寄存器
+ */
+static uint32_t crc_mask = 0xFFFFFFFFUL;
+
+/**
+ * @brief 当前输入反转模式
+ */
+static yDrvCrcRevIn_t crc_rev_in = YDRV_CRC_REV_IN_NONE;
+
+/**
+ * @brief 结果异或值
+ */
+static uint32_t crc_xor_out = 0;
+
+/**
+ * @brief DMA计算进行中，期间yLib后端退回查表
+ */
+static volatile uint8_t crc_dma_busy = 0;
+
+/**
+ * @brief 本次DMA计算启动了传输(全部由CPU写入时为0)
+ */
+static uint8_t crc_dma_active = 0;
+
+/**
+ * @brief DMA传输结束后由CPU写入的尾部字节
+ */
+static const uint8_t *crc_dma_tail = NULL;
+static uint32_t crc_dma_tail_len = 0;
+
+/**
+ * @brief 已注册为yLib后端
+ */
+static uint8_t crc_ylib_registered = 0;
+
+/* 私有函数声明 ----------------------------------------------------------------*/
+
+/**
+ * @brief 向数据寄存器写入一段数据
+ * @param data 数据指针
+ * @param len 数据长度
+ * @param revIn 当前输入反转模式
+ * @retval 无
+ * @note 按半字反转时字写入的字节顺序与字节流不一致，全部按字节写入
+ */
+static void prv_Feed(const uint8_t *data, uint32_t len, yDrvCrcRevIn_t revIn);
+
+/**
+ * @brief 以临时配置计算一段数据，完成后恢复原配置
+ * @param poly 多项式
+ * @param init 初始值
+ * @param cr 控制寄存器值(位宽和输入反转)
+ * @param data 数据指针
+ * @param len 数据长度
+ * @retval 数据寄存器的值
+ * @note 调用者须关中断
+ */
+static uint32_t prv_Run(uint32_t poly, uint32_t init, uint32_t cr, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 32位按位反转
+ * @note M0+没有RBIT指令
+ */
+static inline uint32_t prv_Rbit(uint32_t v);
+
+/**
+ * @brief yLib CRC-32后端
+ */
+static uint32_t prv_YlibCrc32(uint32_t crc, const void *data, size_t len);
+
+/**
+ * @brief yLib CRC-16后端
+ */
+static uint16_t prv_YlibCrc16(uint16_t crc, const void *data, size_t len);
+
+/**
+ * @brief yLib后端操作表
+ */
+static const struct ylib_crc_ops crc_ylib_ops = {
+    .crc32 = prv_YlibCrc32,
+    .crc16 = prv_YlibCrc16,
+};
+
+/* 私有函数实现 ----------------------------------------------------------------*/
+
+/**
+ * @brief 数据写入实现
+ */
+static void prv_Feed(const uint8_t *data, uint32_t len, yDrvCrcRevIn_t revIn)
+{
+    uint32_t word;
+
+    if (revIn != YDRV_CRC_REV_IN_HALFWORD)
+    {
+        while (len >= 4U)
+        {
+            memcpy(&word, data, sizeof(word));
+            CRC->DR = (revIn == YDRV_CRC_REV_IN_WORD) ? word : __REV(word);
+            data += 4U;
+            len -= 4U;
+        }
+    }
+
+    while (len--)
+    {
+        *(volatile uint8_t *)&CRC->DR = *data++;
+    }
+}
+
+/**
+ * @brief 临时配置计算实现
+ */
+static uint32_t prv_Run(uint32_t poly, uint32_t init, uint32_t cr, const uint8_t *data, uint32_t len)
+{
+    uint32_t saved_pol = CRC->POL;
+    uint32_t saved_init = CRC->INIT;
+    uint32_t saved_cr = CRC->CR;
+    uint32_t result;
+
+    CRC->POL = poly;
+    CRC->INIT = init;
+    CRC->CR = cr | CRC_CR_RESET;
+    prv_Feed(data, len, (yDrvCrcRevIn_t)(cr & CRC_CR_REV_IN));
+    result = CRC->DR;
+
+    CRC->POL = saved_pol;
+    CRC->INIT = saved_init;
+    CRC->CR = saved_cr | CRC_CR_RESET;
+
+    return result;
+}
+
+/**
+ * @brief 按位反转实现
+ */
+static inline uint32_t prv_Rbit(uint32_t v)
+{
+    v = ((v >> 1) & 0x55555555UL) | ((v & 0x55555555UL) << 1);
+    v = ((v >> 2) & 0x33333333UL) | ((v & 0x33333333UL) << 2);
+    v = ((v >> 4) & 0x0F0F0F0FUL) | ((v & 0x0F0F0F0FUL) << 4);
+    return __REV(v);
+}
+
+/**
+ * @brief yLib CRC-32后端实现
+ * @note 硬件寄存器是不反射的形式，与ylib_crc32的反射寄存器互为按位反转；
+ *       输入按字节反转，输出不反转，段与段之间用初始值寄存器衔接
+ */
+static uint32_t prv_YlibCrc32(uint32_t crc, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t state = prv_Rbit(~crc);
+    uint32_t primask;
+    uint32_t n;
+
+    while (len > 0U)
+    {
+        n = (len > YDRV_CRC_YLIB_CHUNK) ? YDRV_CRC_YLIB_CHUNK : (uint32_t)len;
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (crc_dma_busy)
+        {
+            __set_PRIMASK(primask);
+            return ylib_crc32_sw(~prv_Rbit(state), p, len);
+        }
+        state = prv_Run(0x04C11DB7UL, state,
+                        (uint32_t)YDRV_CRC_POLY_32BIT | (uint32_t)YDRV_CRC_REV_IN_BYTE, p, n);
+        __set_PRIMASK(primask);
+
+        p += n;
+        len -= n;
+    }
+
+    return ~prv_Rbit(state);
+}
+
+/**
+ * @brief yLib CRC-16后端实现
+ */
+static uint16_t prv_YlibCrc16(uint16_t crc, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t primask;
+    uint32_t n;
+
+    while (len > 0U)
+    {
+        n = (len > YDRV_CRC_YLIB_CHUNK) ? YDRV_CRC_YLIB_CHUNK : (uint32_t)len;
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (crc_dma_busy)
+        {
+            __set_PRIMASK(primask);
+            return ylib_crc16_sw(crc, p, len);
+        }
+        crc = (uint16_t)prv_Run(0x1021UL, crc,
+                                (uint32_t)YDRV_CRC_POLY_16BIT | (uint32_t)YDRV_CRC_REV_IN_NONE, p, n);
+        __set_PRIMASK(primask);
+
+        p += n;
+        len -= n;
+    }
+
+    return crc;
+}
+
+/* 公共函数实现 ----------------------------------------------------------------*/
+
+/**
+ * @brief CRC初始化实现
+ */
+yDrvStatus_t yDrvCrcInitStatic(const yDrvCrcConfig_t *config)
+{
+    if (config == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+
+    switch (config->polySize)
+    {
+    case YDRV_CRC_POLY_7BIT:
+        crc_mask = 0x7FUL;
+        break;
+    case YDRV_CRC_POLY_8BIT:
+        crc_mask = 0xFFUL;
+        break;
+    case YDRV_CRC_POLY_16BIT:
+        crc_mask = 0xFFFFUL;
+        break;
+    case YDRV_CRC_POLY_32BIT:
+        crc_mask = 0xFFFFFFFFUL;
+        break;
+    default:
+        return YDRV_INVALID_PARAM;
+    }
+
+    crc_rev_in = config->revIn;
+    crc_xor_out = config->xorOut;
+    CRC->POL = config->poly;
+    CRC->INIT = config->init;
+    CRC->CR = (uint32_t)config->polySize |
+              (uint32_t)config->revIn |
+              (config->revOut ? CRC_CR_REV_OUT : 0U) |
+              CRC_CR_RESET;
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief CRC反初始化实现
+ */
+yDrvStatus_t yDrvCrcDeInitStatic(void)
+{
+    if (crc_ylib_registered)
+    {
+        ylib_crc_register(NULL);
+        crc_ylib_registered = 0;
+    }
+
+    LL_AHB1_GRP1_ForceReset(LL_AHB1_GRP1_PERIPH_CRC);
+    LL_AHB1_GRP1_ReleaseReset(LL_AHB1_GRP1_PERIPH_CRC);
+    LL_AHB1_GRP1_DisableClock(LL_AHB1_GRP1_PERIPH_CRC);
+
+    crc_mask = 0xFFFFFFFFUL;
+    crc_rev_in = YDRV_CRC_REV_IN_NONE;
+    crc_xor_out = 0;
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief CRC计算实现
+ */
+uint32_t yDrvCrcCalculate(const void *data, uint32_t len)
+{
+    yDrvCrcReset();
+    return yDrvCrcAccumulate(data, len);
+}
+
+/**
+ * @brief CRC累加实现
+ */
+uint32_t yDrvCrcAccumulate(const void *data, uint32_t len)
+{
+    if (data != NULL)
+    {
+        prv_Feed((const uint8_t *)data, len, crc_rev_in);
+    }
+
+    return (CRC->DR ^ crc_xor_out) & crc_mask;
+}
+
+/**
+ * @brief CRC的DMA通道初始化实现
+ */
+yDrvStatus_t yDrvCrcDmaInit(yDrvDmaHandle_t *handle, yDrvDmaChannel_t channel)
+{
+    yDrvDmaConfig_t config = YDRV_DMA_CONFIG_DEFAULT();
+
+    if (handle == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 内存到内存通道，源地址为外设端，目标地址为存储器端
+    config.channel = channel;
+    config.src_width = YDRV_DMA_WIDTH_32BIT;
+    config.dst_width = YDRV_DMA_WIDTH_32BIT;
+    config.src_inc = YDRV_DMA_INC_ENABLE;
+    config.dst_inc = YDRV_DMA_INC_DISABLE;
+    config.dst_buffer = (void *)&CRC->DR;
+    config.owner = "crc";
+
+    return yDrvDmaInitStatic(&config, handle, YDRV_DMA_DIR_M2M);
+}
+
+/**
+ * @brief CRC的DMA通道反初始化实现
+ */
+yDrvStatus_t yDrvCrcDmaDeInit(yDrvDmaHandle_t *handle)
+{
+    yDrvStatus_t status;
+
+    if (handle == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    status = yDrvDmaDeInitStatic(handle);
+    if (crc_dma_busy)
+    {
+        CRC->CR = (CRC->CR & ~CRC_CR_REV_IN) | (uint32_t)crc_rev_in;
+        crc_dma_busy = 0;
+    }
+
+    return status;
+}
+
+/**
+ * @brief DMA计算启动实现
+ */
+yDrvStatus_t yDrvCrcDmaStart(yDrvDmaHandle_t *handle, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    yDrvDmaDataWidth_t width;
+    uint32_t head = 0;
+    uint32_t count;
+    uint32_t primask;
+    uint8_t word;
+
+    if ((handle == NULL) || ((data == NULL) && (len != 0U)))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 按字节反转的字节流与按字反转的小端字相同，DMA可以直接按字写入
+    word = (crc_rev_in == YDRV_CRC_REV_IN_BYTE) || (crc_rev_in == YDRV_CRC_REV_IN_WORD);
+    if (word)
+    {
+        head = (4U - ((uint32_t)p & 3U)) & 3U;
+        if (head > len)
+        {
+            head = len;
+        }
+        count = (len - head) / 4U;
+    }
+    else
+    {
+        count = len;
+    }
+    if (count > YDRV_CRC_DMA_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (crc_dma_busy)
+    {
+        __set_PRIMASK(primask);
+        return YDRV_BUSY;
+    }
+    crc_dma_busy = 1;
+    __set_PRIMASK(primask);
+
+    yDrvCrcReset();
+    prv_Feed(p, head, crc_rev_in);
+    p += head;
+
+    crc_dma_active = (count > 0U) ? 1U : 0U;
+    crc_dma_tail = word ? (p + count * 4U) : NULL;
+    crc_dma_tail_len = word ? (len - head - count * 4U) : 0U;
+
+    if (crc_dma_active)
+    {
+        if (word)
+        {
+            CRC->CR = (CRC->CR & ~CRC_CR_REV_IN) | (uint32_t)YDRV_CRC_REV_IN_WORD;
+        }
+        width = word ? YDRV_DMA_WIDTH_32BIT : YDRV_DMA_WIDTH_8BIT;
+
+        yDrvDmaTransDisable(handle);
+        yDrvDmaClearFlags(handle);
+        yDrvDmaSrcBufferSet(handle, (void *)p, width);
+        yDrvDmaDstBufferSet(handle, (void *)&CRC->DR, width);
+        yDrvDmaDstBufferLen(handle, count);
+        yDrvDmaTransEnable(handle);
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief DMA计算结束实现
+ */
+yDrvStatus_t yDrvCrcDmaFinish(yDrvDmaHandle_t *handle, uint32_t *result)
+{
+    uint32_t error;
+
+    if ((handle == NULL) || (result == NULL))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+    if (!crc_dma_busy)
+    {
+        return YDRV_ERROR;
+    }
+
+    if (crc_dma_active)
+    {
+        error = READ_BIT(handle->DmaInfo.dma->ISR, DMA_ISR_TEIF1 << (handle->DmaInfo.channel * 4U));
+        if ((error == 0U) && !yDrvDmaIsTransComplete(handle))
+        {
+            return YDRV_BUSY;
+        }
+
+        yDrvDmaTransDisable(handle);
+        yDrvDmaClearFlags(handle);
+        CRC->CR = (CRC->CR & ~CRC_CR_REV_IN) | (uint32_t)crc_rev_in;
+        if (error != 0U)
+        {
+            crc_dma_busy = 0;
+            return YDRV_ERROR;
+        }
+    }
+
+    prv_Feed(crc_dma_tail, crc_dma_tail_len, crc_rev_in);
+    *result = (CRC->DR ^ crc_xor_out) & crc_mask;
+    crc_dma_busy = 0;
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 占用CRC单元实现
+ */
+yDrvStatus_t yDrvCrcStreamBegin(void)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (crc_dma_busy)
+    {
+        __set_PRIMASK(primask);
+        return YDRV_BUSY;
+    }
+    crc_dma_busy = 1;
+    __set_PRIMASK(primask);
+
+    // 外设按字节写入，输入反转保持当前配置
+    crc_dma_active = 0;
+    yDrvCrcReset();
+    return YDRV_OK;
+}
+
+/**
+ * @brief 释放CRC单元实现
+ */
+uint32_t yDrvCrcStreamEnd(void)
+{
+    uint32_t result = (CRC->DR ^ crc_xor_out) & crc_mask;
+
+    crc_dma_busy = 0;
+    return result;
+}
+
+/**
+ * @brief 注册yLib后端实现
+ */
+yDrvStatus_t yDrvCrcRegisterYlib(void)
+{
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+
+    ylib_crc_register(&crc_ylib_ops);
+    crc_ylib_registered = 1;
+
+    return YDRV_OK;
+}
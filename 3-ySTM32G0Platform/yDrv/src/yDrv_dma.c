@@ -13,6 +13,9 @@
  * - 多种传输模式支持（内存到内存、内存到外设、外设到内存）
  * - 中断管理和状态查询
  * - DMAMUX请求信号配置
+ * - 通道动态分配和占用记录
+ * - DMAMUX请求生成器、通道同步和溢出统计
+ * - 软件描述符链，TC中断中装载下一段
  * - 传输参数动态设置
  *
  * @par 更新历史:
@@ -20,6 +23,7 @@
  */
 
 #include "yDrv_dma.h"
+#include "yLib_trace.h"
 #include <string.h>
 
 // ==================== 私有定义 ====================
@@ -38,12 +42,147 @@ static const IRQn_Type DMA_IRQ_MAP[YDRV_DMA_CHANNEL_MAX] = {
     DMA1_Ch4_7_DMAMUX1_OVR_IRQn, /*!< DMA1通道4_7共享中断 */
 };
 
+/**
+ * @brief DMA通道中断回调表
+ * @note 按通道索引保存TC/HT/TE三类中断的回调函数和使能标志
+ */
+static struct
+{
+    yDrvInterruptCallback_t callback[YDRV_DMA_EXTI_MAX];
+    uint8_t flags[YDRV_DMA_EXTI_MAX];
+} exit_callback[YDRV_DMA_CHANNEL_MAX];
+
+/**
+ * @brief 已使能中断的标志位掩码
+ * @note 位布局与DMA_ISR相同，注册/反注册回调时更新，中断分发时与ISR相与一次得到全部待处理事件
+ */
+static volatile uint32_t dma_it_mask;
+
+/**
+ * @brief 中断类型对应的通道1标志位
+ * @note 按yDrvDmaExti_t顺序排列，通道n左移4*n位
+ */
+static const uint32_t DMA_EXTI_FLAG[YDRV_DMA_EXTI_MAX] = {
+    DMA_ISR_TCIF1, /*!< 传输完成 */
+    DMA_ISR_HTIF1, /*!< 半传输 */
+    DMA_ISR_TEIF1, /*!< 传输错误 */
+};
+
+/**
+ * @brief DMA通道占用表
+ * @note 按通道索引记录占用的句柄和使用者名称，handle为NULL表示空闲
+ */
+static struct
+{
+    const yDrvDmaHandle_t *handle;
+    const char *owner;
+} channel_owner[YDRV_DMA_CHANNEL_MAX];
+
+/**
+ * @brief DMAMUX请求生成器占用表
+ * @note 按生成器编号记录占用的句柄和使用者名称，handle为NULL表示空闲
+ */
+static struct
+{
+    const yDrvDmaGenHandle_t *handle;
+    const char *owner;
+} gen_owner[YDRV_DMA_GEN_MAX];
+
+/**
+ * @brief 通道同步事件溢出次数
+ * @note 同步事件到达时上一次放行的请求尚未处理完即计一次溢出
+ */
+static volatile uint32_t sync_overrun[YDRV_DMA_CHANNEL_MAX];
+
+/**
+ * @brief 请求生成器触发溢出次数
+ * @note 触发信号到达时上一次产生的请求尚未处理完即计一次溢出
+ */
+static volatile uint32_t gen_overrun[YDRV_DMA_GEN_MAX];
+
+/**
+ * @brief 单段最多传输的数据项数
+ * @note CNDTR为16位
+ */
+#define DMA_CHAIN_SEG_MAX (0xFFFFU)
+
+/**
+ * @brief 链式传输运行状态
+ * @note 按通道索引保存，desc为NULL表示通道不在链式传输中；
+ *       periph/memory是下一段的起始地址，remain是当前描述符还未装载的数据项数
+ */
+static struct
+{
+    const yDrvDmaDesc_t *volatile desc; // 当前描述符
+    uint32_t periph;                    // 下一段外设地址
+    uint32_t memory;                    // 下一段存储器地址
+    uint32_t remain;                    // 当前描述符剩余数据项数
+    uint8_t pstep;                      // 外设端每项字节数，不递增为0
+    uint8_t mstep;                      // 存储器端每项字节数，不递增为0
+} dma_chain[YDRV_DMA_CHANNEL_MAX];
+
 // ==================== 私有函数声明 ====================
 
+/**
+ * @brief 为句柄占用DMA通道
+ * @param config DMA配置指针
+ * @param handle DMA句柄指针
+ * @param channel 输出的通道索引
+ * @retval yDrvStatus_t 占用状态
+ * @note 自动分配时，高优先级从通道1向后查找，低优先级从通道7向前查找：
+ *       软件优先级相同时编号小的通道先被仲裁，高优先级请求应占用编号小的通道；
+ *       句柄重新初始化到其他通道时释放原通道
+ */
+static yDrvStatus_t prv_DmaChannelClaim(const yDrvDmaConfig_t *config,
+                                        yDrvDmaHandle_t *handle,
+                                        yDrvDmaChannel_t *channel);
+
+/**
+ * @brief 释放句柄占用的DMA通道
+ * @param handle DMA句柄指针
+ * @retval 无
+ * @note 通道已被其他句柄占用时不做处理
+ */
+static void prv_DmaChannelRelease(const yDrvDmaHandle_t *handle);
+
+/**
+ * @brief DMA中断分发处理
+ * @param range 中断线覆盖通道的标志位掩码
+ * @note 读一次ISR并与已使能中断掩码相与，一次写IFCR清除全部待处理标志，
+ *       再按通道从低到高依次调用TE、HT、TC回调，没有事件的通道不做任何检查
+ */
+static void prv_DmaIrqDispatch(uint32_t range);
+
+/**
+ * @brief 调用通道中断回调
+ * @param index DMA通道索引
+ * @param type 中断类型
+ * @retval 无
+ */
+static void prv_DmaCallback(uint32_t index, yDrvDmaExti_t type);
+
+/**
+ * @brief 装载链式传输的下一段并重新使能通道
+ * @param index DMA通道索引
+ * @retval uint32_t 1=已装载, 0=链已结束
+ * @note 在TC中断中调用，只写四个通道寄存器，不经过LL的通道偏移查表
+ */
+static uint32_t prv_DmaChainLoad(uint32_t index);
+
+/**
+ * @brief DMAMUX溢出中断处理
+ * @retval 无
+ * @note 清除同步溢出和生成器溢出标志并计数，溢出说明触发频率超过了DMA的搬运能力
+ */
+static void prv_DmamuxOverrunIrq(void);
+
 // ==================== 基础函数实现 ====================
 
 yDrvStatus_t yDrvDmaInitStatic(const yDrvDmaConfig_t *config, yDrvDmaHandle_t *handle, yDrvDmaDirection_t direction)
 {
+    yDrvDmaChannel_t channel;
+    yDrvStatus_t status;
+
     // 参数有效性检查
     if (config == NULL || handle == NULL)
     {
@@ -51,14 +190,22 @@ yDrvStatus_t yDrvDmaInitStatic(const yDrvDmaConfig_t *config, yDrvDmaHandle_t *h
     }
 
     // 检查通道范围
-    if (config->channel >= YDRV_DMA_CHANNEL_MAX)
+    if ((config->channel >= YDRV_DMA_CHANNEL_MAX) && (config->channel != YDRV_DMA_CHANNEL_AUTO))
     {
         return YDRV_ERROR;
     }
 
+    // 占用通道
+    status = prv_DmaChannelClaim(config, handle, &channel);
+    if (status != YDRV_OK)
+    {
+        return status;
+    }
+
     // 初始化句柄结构体
-    yDrvParseDma(config->channel, &handle->DmaInfo);
-    handle->IRQ = DMA_IRQ_MAP[config->channel];
+    yDrvParseDma(channel, &handle->DmaInfo);
+    handle->IRQ = DMA_IRQ_MAP[channel];
+    handle->index = channel;
 
     // 禁用DMA通道
     LL_DMA_DisableChannel(handle->DmaInfo.dma,
@@ -87,11 +234,11 @@ yDrvStatus_t yDrvDmaInitStatic(const yDrvDmaConfig_t *config, yDrvDmaHandle_t *h
                                 (config->src_inc == YDRV_DMA_INC_DISABLE) ? LL_DMA_MEMORY_NOINCREMENT : LL_DMA_MEMORY_INCREMENT); // 配置优先级
         LL_DMA_SetMemorySize(handle->DmaInfo.dma,
                              handle->DmaInfo.channel,
-                             config->src_width);
+                             YDRV_DMA_MEM_WIDTH(config->src_width));
 
         LL_DMA_SetMemorySize(handle->DmaInfo.dma,
                              handle->DmaInfo.channel,
-                             config->src_width);
+                             YDRV_DMA_MEM_WIDTH(config->src_width));
         LL_DMA_SetMemoryAddress(handle->DmaInfo.dma,
                                 handle->DmaInfo.channel,
                                 (uint32_t)config->src_buffer);
@@ -102,7 +249,7 @@ yDrvStatus_t yDrvDmaInitStatic(const yDrvDmaConfig_t *config, yDrvDmaHandle_t *h
                                 (config->dst_inc == YDRV_DMA_INC_DISABLE) ? LL_DMA_MEMORY_NOINCREMENT : LL_DMA_MEMORY_INCREMENT); // 配置优先级
         LL_DMA_SetMemorySize(handle->DmaInfo.dma,
                              handle->DmaInfo.channel,
-                             config->dst_width);
+                             YDRV_DMA_MEM_WIDTH(config->dst_width));
         LL_DMA_SetMemoryAddress(handle->DmaInfo.dma,
                                 handle->DmaInfo.channel,
                                 (uint32_t)config->dst_buffer);
@@ -116,7 +263,7 @@ yDrvStatus_t yDrvDmaInitStatic(const yDrvDmaConfig_t *config, yDrvDmaHandle_t *h
                                 (config->src_inc == YDRV_DMA_INC_DISABLE) ? LL_DMA_PERIPH_NOINCREMENT : LL_DMA_PERIPH_INCREMENT); // 配置优先级
         LL_DMA_SetMemorySize(handle->DmaInfo.dma,
                              handle->DmaInfo.channel,
-                             config->dst_width);
+                             YDRV_DMA_MEM_WIDTH(config->dst_width));
         LL_DMA_SetPeriphSize(handle->DmaInfo.dma,
                              handle->DmaInfo.channel,
                              config->src_width);
@@ -147,8 +294,750 @@ yDrvStatus_t yDrvDmaDeInitStatic(yDrvDmaHandle_t *handle)
         return YDRV_ERROR;
     }
 
+    if ((handle->DmaInfo.dma == NULL) || (handle->index >= YDRV_DMA_CHANNEL_MAX))
+    {
+        return YDRV_OK;
+    }
+
     LL_DMA_DisableChannel(handle->DmaInfo.dma,
                           handle->DmaInfo.channel);
 
+    // 通道仍属于该句柄时才复位，已被重新分配的通道保持原样
+    if (channel_owner[handle->index].handle == handle)
+    {
+        dma_chain[handle->index].desc = NULL;
+        yDrvDmaUnregisterCallback(handle, YDRV_DMA_EXTI_MAX);
+        yDrvDmaSyncConfig(handle, NULL);
+        yDrvDmaClearFlags(handle);
+        LL_DMA_SetPeriphRequest(handle->DmaInfo.dma,
+                                handle->DmaInfo.channel,
+                                LL_DMAMUX_REQ_MEM2MEM); // 释放DMAMUX请求线
+        prv_DmaChannelRelease(handle);
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 查询DMA通道占用信息
+ * @param channel DMA通道
+ * @param info 输出的占用信息
+ * @retval yDrvStatus_t 查询状态
+ * @note 请求信号和优先级直接读取寄存器，反映使用者初始化后的修改
+ */
+yDrvStatus_t yDrvDmaGetChannelInfo(yDrvDmaChannel_t channel, yDrvDmaChannelInfo_t *info)
+{
+    yDrvDmaInfo_t dma_info;
+
+    if ((info == NULL) || (yDrvParseDma(channel, &dma_info) != YDRV_OK))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    info->used = (channel_owner[channel].handle != NULL) ? 1U : 0U;
+    info->owner = channel_owner[channel].owner;
+    info->request = LL_DMA_GetPeriphRequest(dma_info.dma, dma_info.channel);
+    info->priority = LL_DMA_GetChannelPriorityLevel(dma_info.dma, dma_info.channel);
+    info->enabled = (uint8_t)LL_DMA_IsEnabledChannel(dma_info.dma, dma_info.channel);
+    info->overrun = sync_overrun[channel];
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 查询是否所有DMA通道均已关闭
+ * @retval uint8_t 1=全部关闭, 0=有通道在传输
+ * @note 直接读取各通道EN位，未经yDrvDmaInitStatic占用的通道(如CRC的DMA)同样计入；
+ *       循环模式的通道一直保持使能
+ */
+uint8_t yDrvDmaIsIdle(void)
+{
+    yDrvDmaInfo_t dma_info;
+    uint32_t channel;
+
+    for (channel = 0; channel < YDRV_DMA_CHANNEL_MAX; channel++)
+    {
+        if ((yDrvParseDma((yDrvDmaChannel_t)channel, &dma_info) == YDRV_OK) &&
+            LL_DMA_IsEnabledChannel(dma_info.dma, dma_info.channel))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// ==================== 中断管理函数实现 ====================
+
+/**
+ * @brief 注册DMA中断回调函数
+ * @param handle DMA句柄指针
+ * @param exti 中断配置指针
+ * @retval yDrvStatus_t 注册状态
+ * @note 保存回调后使能通道对应的中断源，并按配置的优先级打开NVIC中断
+ */
+yDrvStatus_t yDrvDmaRegisterCallback(yDrvDmaHandle_t *handle,
+                                     yDrvDmaExtiConfig_t *exti)
+{
+    uint32_t primask;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->DmaInfo.dma == NULL || exti == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->index >= YDRV_DMA_CHANNEL_MAX || exti->trigger >= YDRV_DMA_EXTI_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 存储回调函数和参数
+    exit_callback[handle->index].callback[exti->trigger].function = exti->function;
+    exit_callback[handle->index].callback[exti->trigger].arg = exti->arg;
+    exit_callback[handle->index].flags[exti->trigger] = exti->enable;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    dma_it_mask |= DMA_EXTI_FLAG[exti->trigger] << (handle->index * 4U);
+    __set_PRIMASK(primask);
+
+    // 根据中断类型使能对应的通道中断
+    switch (exti->trigger)
+    {
+    case YDRV_DMA_EXTI_TC:
+        LL_DMA_EnableIT_TC(handle->DmaInfo.dma, handle->DmaInfo.channel);
+        break;
+    case YDRV_DMA_EXTI_HT:
+        LL_DMA_EnableIT_HT(handle->DmaInfo.dma, handle->DmaInfo.channel);
+        break;
+    case YDRV_DMA_EXTI_TE:
+        LL_DMA_EnableIT_TE(handle->DmaInfo.dma, handle->DmaInfo.channel);
+        break;
+    default:
+        return YDRV_INVALID_PARAM;
+    }
+
+    yDrvIrqSetPriority(handle->IRQ, exti->prio);
+    if (exti->enable)
+    { // 使能NVIC中断
+        NVIC_EnableIRQ(handle->IRQ);
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 反注册DMA中断回调函数
+ * @param handle DMA句柄指针
+ * @param type 中断类型，YDRV_DMA_EXTI_MAX表示全部中断
+ * @retval yDrvStatus_t 反注册状态
+ * @note 共享中断线上可能还有其他通道，因此不关闭NVIC中断
+ */
+yDrvStatus_t yDrvDmaUnregisterCallback(yDrvDmaHandle_t *handle,
+                                       yDrvDmaExti_t type)
+{
+    uint32_t primask;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->DmaInfo.dma == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->index >= YDRV_DMA_CHANNEL_MAX || type > YDRV_DMA_EXTI_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (type == YDRV_DMA_EXTI_MAX)
+    {
+        for (type = YDRV_DMA_EXTI_TC; type < YDRV_DMA_EXTI_MAX; type++)
+        {
+            yDrvDmaUnregisterCallback(handle, type);
+        }
+        return YDRV_OK;
+    }
+
+    switch (type)
+    {
+    case YDRV_DMA_EXTI_TC:
+        LL_DMA_DisableIT_TC(handle->DmaInfo.dma, handle->DmaInfo.channel);
+        break;
+    case YDRV_DMA_EXTI_HT:
+        LL_DMA_DisableIT_HT(handle->DmaInfo.dma, handle->DmaInfo.channel);
+        break;
+    case YDRV_DMA_EXTI_TE:
+        LL_DMA_DisableIT_TE(handle->DmaInfo.dma, handle->DmaInfo.channel);
+        break;
+    default:
+        return YDRV_INVALID_PARAM;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    dma_it_mask &= ~(DMA_EXTI_FLAG[type] << (handle->index * 4U));
+    __set_PRIMASK(primask);
+    exit_callback[handle->index].callback[type].function = NULL;
+    exit_callback[handle->index].callback[type].arg = NULL;
+    exit_callback[handle->index].flags[type] = 0;
+
+    return YDRV_OK;
+}
+
+// ==================== DMAMUX请求生成器与同步函数实现 ====================
+
+/**
+ * @brief 初始化DMAMUX请求生成器
+ * @param config 生成器配置指针
+ * @param handle 生成器句柄指针
+ * @retval yDrvStatus_t 初始化状态
+ * @note 指定生成器已被其他句柄占用或没有空闲生成器时返回YDRV_BUSY；
+ *       GNBREQ只能在生成器关闭时写入，因此先关闭再配置
+ */
+yDrvStatus_t yDrvDmaGenInit(const yDrvDmaGenConfig_t *config, yDrvDmaGenHandle_t *handle)
+{
+    uint32_t primask;
+    uint32_t index;
+
+    if ((config == NULL) || (handle == NULL) ||
+        (config->signal >= YDRV_DMA_SIGNAL_MAX) || (config->edge > YDRV_DMA_EDGE_BOTH) ||
+        (config->nbreq == 0U) || (config->nbreq > 32U) ||
+        ((config->generator >= YDRV_DMA_GEN_MAX) && (config->generator != YDRV_DMA_GEN_AUTO)))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    index = config->generator;
+    if (index == YDRV_DMA_GEN_AUTO)
+    {
+        // 句柄已占用生成器时原地重新配置
+        index = handle->index;
+        if ((index >= YDRV_DMA_GEN_MAX) || (gen_owner[index].handle != handle))
+        {
+            for (index = 0; index < YDRV_DMA_GEN_MAX; index++)
+            {
+                if (gen_owner[index].handle == NULL)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if ((index >= YDRV_DMA_GEN_MAX) ||
+        ((gen_owner[index].handle != NULL) && (gen_owner[index].handle != handle)))
+    {
+        __set_PRIMASK(primask);
+        return YDRV_BUSY;
+    }
+
+    // 句柄换到其他生成器时释放原生成器
+    if ((handle->index < YDRV_DMA_GEN_MAX) && (handle->index != index) &&
+        (gen_owner[handle->index].handle == handle))
+    {
+        LL_DMAMUX_DisableRequestGen(DMAMUX1, handle->index);
+        LL_DMAMUX_DisableIT_RGO(DMAMUX1, handle->index);
+        gen_owner[handle->index].handle = NULL;
+        gen_owner[handle->index].owner = NULL;
+    }
+
+    gen_owner[index].handle = handle;
+    gen_owner[index].owner = config->owner;
+    __set_PRIMASK(primask);
+
+    handle->index = (uint8_t)index;
+    handle->request = (yDrvDmaRequest_t)(YDRV_DMA_REQ_GENERATOR0 + index);
+
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1); // DMAMUX与DMA1共用时钟
+    LL_DMAMUX_DisableRequestGen(DMAMUX1, index);
+    LL_DMAMUX_SetRequestSignalID(DMAMUX1, index,
+                                 (uint32_t)config->signal << DMAMUX_RGxCR_SIG_ID_Pos); // 配置触发信号
+    LL_DMAMUX_SetRequestGenPolarity(DMAMUX1, index,
+                                    (uint32_t)config->edge << DMAMUX_RGxCR_GPOL_Pos); // 配置触发边沿
+    LL_DMAMUX_SetGenRequestNb(DMAMUX1, index, config->nbreq); // 配置每次触发的请求数
+
+    WRITE_REG(DMAMUX1_RequestGenStatus->RGCFR, 1UL << index);
+    gen_overrun[index] = 0;
+    LL_DMAMUX_EnableIT_RGO(DMAMUX1, index);
+    yDrvIrqSetPriority(DMA1_Ch4_7_DMAMUX1_OVR_IRQn, config->prio);
+    NVIC_EnableIRQ(DMA1_Ch4_7_DMAMUX1_OVR_IRQn);
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 反初始化DMAMUX请求生成器
+ * @param handle 生成器句柄指针
+ * @retval yDrvStatus_t 反初始化状态
+ */
+yDrvStatus_t yDrvDmaGenDeInit(yDrvDmaGenHandle_t *handle)
+{
+    uint32_t primask;
+
+    if (handle == NULL)
+    {
+        return YDRV_ERROR;
+    }
+
+    if (handle->index >= YDRV_DMA_GEN_MAX)
+    {
+        return YDRV_OK;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (gen_owner[handle->index].handle == handle)
+    {
+        LL_DMAMUX_DisableRequestGen(DMAMUX1, handle->index);
+        LL_DMAMUX_DisableIT_RGO(DMAMUX1, handle->index);
+        gen_owner[handle->index].handle = NULL;
+        gen_owner[handle->index].owner = NULL;
+    }
+    __set_PRIMASK(primask);
+
+    handle->index = YDRV_DMA_GEN_MAX;
+    handle->request = YDRV_DMA_REQ_MEM2MEM;
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 查询DMAMUX请求生成器占用信息
+ * @param generator 生成器编号
+ * @param info 输出的占用信息
+ * @retval yDrvStatus_t 查询状态
+ * @note 信号、边沿和请求数直接读取寄存器
+ */
+yDrvStatus_t yDrvDmaGenGetInfo(uint32_t generator, yDrvDmaGenInfo_t *info)
+{
+    if ((info == NULL) || (generator >= YDRV_DMA_GEN_MAX))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    info->used = (gen_owner[generator].handle != NULL) ? 1U : 0U;
+    info->owner = gen_owner[generator].owner;
+    info->signal = LL_DMAMUX_GetRequestSignalID(DMAMUX1, generator) >> DMAMUX_RGxCR_SIG_ID_Pos;
+    info->edge = LL_DMAMUX_GetRequestGenPolarity(DMAMUX1, generator) >> DMAMUX_RGxCR_GPOL_Pos;
+    info->nbreq = LL_DMAMUX_GetGenRequestNb(DMAMUX1, generator);
+    info->enabled = (uint8_t)LL_DMAMUX_IsEnabledRequestGen(DMAMUX1, generator);
+    info->overrun = gen_overrun[generator];
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 配置DMA通道同步
+ * @param handle DMA句柄指针
+ * @param config 同步配置指针
+ * @retval yDrvStatus_t 配置状态
+ * @note NBREQ只能在SE和EGE都关闭时写入，因此先关闭同步和事件输出再配置
+ */
+yDrvStatus_t yDrvDmaSyncConfig(yDrvDmaHandle_t *handle, const yDrvDmaSyncConfig_t *config)
+{
+    uint32_t index;
+
+    if ((handle == NULL) || (handle->index >= YDRV_DMA_CHANNEL_MAX))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((config != NULL) &&
+        ((config->signal >= YDRV_DMA_SIGNAL_MAX) || (config->edge > YDRV_DMA_EDGE_BOTH) ||
+         (config->nbreq == 0U) || (config->nbreq > 32U)))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    index = (uint32_t)handle->index; // DMAMUX通道n对应DMA1通道n+1
+    LL_DMAMUX_DisableSync(DMAMUX1, index);
+    LL_DMAMUX_DisableEventGeneration(DMAMUX1, index);
+    LL_DMAMUX_DisableIT_SO(DMAMUX1, index);
+
+    if (config == NULL)
+    {
+        return YDRV_OK;
+    }
+
+    LL_DMAMUX_SetSyncID(DMAMUX1, index,
+                        (uint32_t)config->signal << DMAMUX_CxCR_SYNC_ID_Pos); // 配置同步信号
+    LL_DMAMUX_SetSyncPolarity(DMAMUX1, index,
+                              (uint32_t)config->edge << DMAMUX_CxCR_SPOL_Pos); // 配置同步边沿
+    LL_DMAMUX_SetSyncRequestNb(DMAMUX1, index, config->nbreq); // 配置每次放行的请求数
+
+    if (config->event)
+    {
+        LL_DMAMUX_EnableEventGeneration(DMAMUX1, index);
+    }
+
+    if (config->edge != YDRV_DMA_EDGE_NONE)
+    {
+        WRITE_REG(DMAMUX1_ChannelStatus->CFR, 1UL << index);
+        sync_overrun[index] = 0;
+        LL_DMAMUX_EnableIT_SO(DMAMUX1, index);
+        yDrvIrqSetPriority(DMA1_Ch4_7_DMAMUX1_OVR_IRQn, config->prio);
+        NVIC_EnableIRQ(DMA1_Ch4_7_DMAMUX1_OVR_IRQn);
+        LL_DMAMUX_EnableSync(DMAMUX1, index);
+    }
+
     return YDRV_OK;
 }
+
+// ==================== 链式传输函数实现 ====================
+
+/**
+ * @brief 启动链式传输
+ * @param handle DMA句柄指针
+ * @param desc 第一个描述符
+ * @retval yDrvStatus_t 启动状态
+ * @note 位宽和递增模式从CCR读取，即沿用yDrvDmaInitStatic的配置
+ */
+yDrvStatus_t yDrvDmaChainStart(yDrvDmaHandle_t *handle, const yDrvDmaDesc_t *desc)
+{
+    DMA_Channel_TypeDef *reg;
+    uint32_t ccr;
+    uint32_t index;
+
+    if ((handle == NULL) || (handle->DmaInfo.dma == NULL) ||
+        (handle->index >= YDRV_DMA_CHANNEL_MAX) || (desc == NULL))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    index = (uint32_t)handle->index;
+    if ((dma_it_mask & (DMA_ISR_TCIF1 << (index * 4U))) == 0U)
+    {
+        return YDRV_ERROR; // 没有TC中断无法装载下一段
+    }
+
+    reg = DMA1_Channel1 + index;
+    ccr = READ_REG(reg->CCR);
+    if ((ccr & DMA_CCR_CIRC) != 0U)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    CLEAR_BIT(reg->CCR, DMA_CCR_EN);
+    yDrvDmaClearFlags(handle);
+
+    dma_chain[index].pstep = ((ccr & DMA_CCR_PINC) != 0U) ? (uint8_t)(1U << ((ccr & DMA_CCR_PSIZE) >> DMA_CCR_PSIZE_Pos)) : 0U;
+    dma_chain[index].mstep = ((ccr & DMA_CCR_MINC) != 0U) ? (uint8_t)(1U << ((ccr & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos)) : 0U;
+    dma_chain[index].periph = (desc->periph != 0U) ? desc->periph : READ_REG(reg->CPAR);
+    dma_chain[index].memory = desc->memory;
+    dma_chain[index].remain = desc->length;
+    dma_chain[index].desc = desc;
+
+    if (prv_DmaChainLoad(index) == 0U)
+    {
+        return YDRV_INVALID_PARAM; // 整条链都是空描述符
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 停止链式传输
+ * @param handle DMA句柄指针
+ * @retval yDrvStatus_t 停止状态
+ * @note 关中断完成，避免已置位的TC在关闭通道后又装载下一段
+ */
+yDrvStatus_t yDrvDmaChainStop(yDrvDmaHandle_t *handle)
+{
+    uint32_t primask;
+
+    if ((handle == NULL) || (handle->DmaInfo.dma == NULL) || (handle->index >= YDRV_DMA_CHANNEL_MAX))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    LL_DMA_DisableChannel(handle->DmaInfo.dma, handle->DmaInfo.channel);
+    dma_chain[handle->index].desc = NULL;
+    yDrvDmaClearFlags(handle);
+    __set_PRIMASK(primask);
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 查询链式传输是否进行中
+ * @param handle DMA句柄指针
+ * @retval uint8_t 1=进行中, 0=已完成或未启动
+ */
+uint8_t yDrvDmaChainIsBusy(const yDrvDmaHandle_t *handle)
+{
+    if ((handle == NULL) || (handle->index >= YDRV_DMA_CHANNEL_MAX))
+    {
+        return 0;
+    }
+
+    return (dma_chain[handle->index].desc != NULL) ? 1U : 0U;
+}
+
+// ==================== 私有函数实现 ====================
+
+/**
+ * @brief 占用DMA通道实现
+ */
+static yDrvStatus_t prv_DmaChannelClaim(const yDrvDmaConfig_t *config,
+                                        yDrvDmaHandle_t *handle,
+                                        yDrvDmaChannel_t *channel)
+{
+    yDrvStatus_t status = YDRV_OK;
+    uint32_t primask;
+    int32_t index;
+    int32_t step;
+    int32_t end;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (config->channel == YDRV_DMA_CHANNEL_AUTO)
+    {
+        // 句柄已占用通道时直接复用
+        if ((handle->index < YDRV_DMA_CHANNEL_MAX) &&
+            (channel_owner[handle->index].handle == handle))
+        {
+            *channel = handle->index;
+        }
+        else
+        {
+            if (config->priority >= YDRV_DMA_PRIORITY_HIGH)
+            {
+                index = YDRV_DMA1_CHANNEL1;
+                end = YDRV_DMA_CHANNEL_MAX;
+                step = 1;
+            }
+            else
+            {
+                index = YDRV_DMA_CHANNEL_MAX - 1;
+                end = -1;
+                step = -1;
+            }
+            for (; index != end; index += step)
+            {
+                if (channel_owner[index].handle == NULL)
+                {
+                    break;
+                }
+            }
+            if (index == end)
+            {
+                status = YDRV_BUSY;
+            }
+            else
+            {
+                *channel = (yDrvDmaChannel_t)index;
+            }
+        }
+    }
+    else if ((channel_owner[config->channel].handle != NULL) &&
+             (channel_owner[config->channel].handle != handle))
+    {
+        status = YDRV_BUSY;
+    }
+    else
+    {
+        *channel = config->channel;
+    }
+
+    if (status == YDRV_OK)
+    {
+        // 句柄改用其他通道时释放原通道
+        if ((handle->index < YDRV_DMA_CHANNEL_MAX) &&
+            (handle->index != *channel) &&
+            (channel_owner[handle->index].handle == handle))
+        {
+            channel_owner[handle->index].handle = NULL;
+            channel_owner[handle->index].owner = NULL;
+        }
+        channel_owner[*channel].handle = handle;
+        channel_owner[*channel].owner = config->owner;
+    }
+
+    __set_PRIMASK(primask);
+
+    return status;
+}
+
+/**
+ * @brief 释放DMA通道实现
+ */
+static void prv_DmaChannelRelease(const yDrvDmaHandle_t *handle)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (channel_owner[handle->index].handle == handle)
+    {
+        channel_owner[handle->index].handle = NULL;
+        channel_owner[handle->index].owner = NULL;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 调用通道中断回调实现
+ */
+YLIB_RAMFUNC static void prv_DmaCallback(uint32_t index, yDrvDmaExti_t type)
+{
+    if (exit_callback[index].flags[type] &&
+        exit_callback[index].callback[type].function)
+    {
+        exit_callback[index].callback[type].function(
+            exit_callback[index].callback[type].arg);
+    }
+}
+
+/**
+ * @brief 装载链式传输下一段实现
+ */
+YLIB_RAMFUNC static uint32_t prv_DmaChainLoad(uint32_t index)
+{
+    DMA_Channel_TypeDef *reg = DMA1_Channel1 + index;
+    const yDrvDmaDesc_t *desc = dma_chain[index].desc;
+    uint32_t count;
+
+    // 当前描述符已装载完，转到下一个，跳过空描述符
+    while (dma_chain[index].remain == 0U)
+    {
+        desc = desc->next;
+        if (desc == NULL)
+        {
+            dma_chain[index].desc = NULL;
+            return 0;
+        }
+        if (desc->periph != 0U)
+        {
+            dma_chain[index].periph = desc->periph;
+        }
+        dma_chain[index].memory = desc->memory;
+        dma_chain[index].remain = desc->length;
+        dma_chain[index].desc = desc;
+    }
+
+    count = (dma_chain[index].remain > DMA_CHAIN_SEG_MAX) ? DMA_CHAIN_SEG_MAX : dma_chain[index].remain;
+
+    // 正常模式传输结束后EN仍为1，关闭后才能写地址和长度
+    CLEAR_BIT(reg->CCR, DMA_CCR_EN);
+    WRITE_REG(reg->CPAR, dma_chain[index].periph);
+    WRITE_REG(reg->CMAR, dma_chain[index].memory);
+    WRITE_REG(reg->CNDTR, count);
+    SET_BIT(reg->CCR, DMA_CCR_EN);
+
+    dma_chain[index].periph += count * dma_chain[index].pstep;
+    dma_chain[index].memory += count * dma_chain[index].mstep;
+    dma_chain[index].remain -= count;
+
+    return 1;
+}
+
+/**
+ * @brief DMA中断分发实现
+ */
+YLIB_RAMFUNC static void prv_DmaIrqDispatch(uint32_t range)
+{
+    uint32_t pending;
+    uint32_t index;
+
+    pending = DMA1->ISR & dma_it_mask & range;
+    if (pending == 0U)
+    {
+        return;
+    }
+    WRITE_REG(DMA1->IFCR, pending); // IFCR与ISR位布局相同
+
+    for (index = 0; pending != 0U; index++, pending >>= 4U)
+    {
+        if ((pending & 0xFU) == 0U)
+        {
+            continue;
+        }
+        if ((pending & DMA_ISR_TEIF1) != 0U)
+        {
+            dma_chain[index].desc = NULL; // 传输错误时硬件已关闭通道，链随之停止
+            prv_DmaCallback(index, YDRV_DMA_EXTI_TE);
+        }
+        if ((pending & DMA_ISR_HTIF1) != 0U)
+        {
+            prv_DmaCallback(index, YDRV_DMA_EXTI_HT);
+        }
+        if (((pending & DMA_ISR_TCIF1) != 0U) &&
+            ((dma_chain[index].desc == NULL) || (prv_DmaChainLoad(index) == 0U)))
+        {
+            prv_DmaCallback(index, YDRV_DMA_EXTI_TC);
+        }
+    }
+}
+
+/**
+ * @brief DMAMUX溢出中断处理实现
+ */
+static void prv_DmamuxOverrunIrq(void)
+{
+    uint32_t flags;
+    uint32_t index;
+
+    flags = DMAMUX1_ChannelStatus->CSR;
+    if (flags != 0U)
+    {
+        WRITE_REG(DMAMUX1_ChannelStatus->CFR, flags);
+        for (index = 0; (flags != 0U) && (index < YDRV_DMA_CHANNEL_MAX); index++, flags >>= 1U)
+        {
+            if ((flags & 1U) != 0U)
+            {
+                sync_overrun[index]++;
+            }
+        }
+    }
+
+    flags = DMAMUX1_RequestGenStatus->RGSR;
+    if (flags != 0U)
+    {
+        WRITE_REG(DMAMUX1_RequestGenStatus->RGCFR, flags);
+        for (index = 0; (flags != 0U) && (index < YDRV_DMA_GEN_MAX); index++, flags >>= 1U)
+        {
+            if ((flags & 1U) != 0U)
+            {
+                gen_overrun[index]++;
+            }
+        }
+    }
+}
+
+// ==================== 中断服务函数 ====================
+
+/**
+ * @brief DMA1通道1中断服务函数
+ */
+YLIB_RAMFUNC void DMA1_Channel1_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    prv_DmaIrqDispatch(0x0000000FUL);
+}
+
+/**
+ * @brief DMA1通道2/3共享中断服务函数
+ */
+YLIB_RAMFUNC void DMA1_Channel2_3_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    prv_DmaIrqDispatch(0x00000FF0UL);
+}
+
+/**
+ * @brief DMA1通道4~7与DMAMUX溢出共享中断服务函数
+ */
+YLIB_RAMFUNC void DMA1_Ch4_7_DMAMUX1_OVR_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    prv_DmaIrqDispatch(0x0FFFF000UL);
+    prv_DmamuxOverrunIrq();
+}
@@ -0,0 +1,250 @@
+/**
+ ******************************************************************************
+ * @file    yDrv_fault.c
+ * @author  yLab2.0
+ * @brief   故障记录与主堆栈监视实现文件
+ * @details 故障记录放在.noinit段，启动代码不清零，软件复位后仍可读出
+ *          - HardFault入口取出异常帧后转入C函数记录
+ *          - 寄存器填好后调用应用注册的采集钩子补充附加数据
+ *          - 记录以魔数和逐字异或校验判断有效
+ *          - 主堆栈按FreeRTOS相同的0xA5填充，从低端向上找第一个被改写的字
+ ******************************************************************************
+ * @attention
+ * 故障发生时堆栈可能已经损坏，记录过程只用很少的栈，不调用RTOS接口
+ ******************************************************************************
+ */
+
+/* 包含的头文件 ----------------------------------------------------------------*/
+#include "stm32g0xx.h"
+#include "yDrv_fault.h"
+
+/* 私有宏定义 ------------------------------------------------------------------*/
+
+#define YDRV_FAULT_MAGIC (0x464C5459UL) /*!< "YTLF" */
+
+#define YDRV_STACK_FILL (0xA5A5A5A5UL) /*!< 主堆栈填充值，与FreeRTOS任务堆栈相同 */
+
+/* 私有变量 --------------------------------------------------------------------*/
+
+/**
+ * @brief 故障记录
+ */
+static yDrvFaultRecord_t fault_record __attribute__((section(".noinit")));
+
+/**
+ * @brief 应用注册的采集钩子
+ */
+static yDrvFaultHook_t fault_hook;
+
+/**
+ * @brief 采集钩子执行中，钩子再出错时跳过
+ */
+static uint8_t fault_in_hook;
+
+/**
+ * @brief 主堆栈范围，由链接脚本定义
+ */
+extern uint32_t __main_stack_start[];
+extern uint32_t _estack[];
+
+/**
+ * @brief 主堆栈已填充
+ */
+static uint8_t main_stack_painted;
+
+/* 私有函数 --------------------------------------------------------------------*/
+
+/**
+ * @brief 计算记录校验
+ */
+static uint32_t yDrv_FaultCheck(const yDrvFaultRecord_t *record)
+{
+    const uint32_t *word = (const uint32_t *)record;
+    uint32_t check = 0x5A5A5A5AUL;
+    uint32_t i;
+
+    for (i = 0; i < offsetof(yDrvFaultRecord_t, check) / sizeof(uint32_t); i++)
+    {
+        check = ((check << 1) | (check >> 31)) ^ word[i];
+    }
+    return check;
+}
+
+/**
+ * @brief 写入记录并复位
+ * @param frame 异常帧(r0 r1 r2 r3 r12 lr pc xpsr)，非HardFault时为NULL
+ */
+static void __attribute__((noreturn)) yDrv_FaultCommit(yDrvFaultType_t type, uint32_t arg, const char *name,
+                                                       const uint32_t *frame, uint32_t pc, uint32_t sp)
+{
+    uint32_t count;
+    uint32_t i;
+
+    __disable_irq();
+
+    // 上一条记录有效时累计次数，上电后的随机内容从0开始
+    count = ((fault_record.magic == YDRV_FAULT_MAGIC) && (fault_record.check == yDrv_FaultCheck(&fault_record)))
+                ? fault_record.count
+                : 0U;
+
+    fault_record.magic = YDRV_FAULT_MAGIC;
+    fault_record.type = (uint32_t)type;
+    fault_record.count = count + 1U;
+    fault_record.time_ms = yDrvGetTimeMs();
+    fault_record.r0 = (frame != NULL) ? frame[0] : 0U;
+    fault_record.r1 = (frame != NULL) ? frame[1] : 0U;
+    fault_record.r2 = (frame != NULL) ? frame[2] : 0U;
+    fault_record.r3 = (frame != NULL) ? frame[3] : 0U;
+    fault_record.r12 = (frame != NULL) ? frame[4] : 0U;
+    fault_record.pc = pc;
+    fault_record.lr = (frame != NULL) ? frame[5] : 0U;
+    fault_record.psr = (frame != NULL) ? frame[7] : 0U;
+    fault_record.sp = sp;
+    fault_record.arg = arg;
+    for (i = 0; (name != NULL) && (i < YDRV_FAULT_NAME_LEN - 1U) && (name[i] != '\0'); i++)
+    {
+        fault_record.name[i] = name[i];
+    }
+    for (; i < YDRV_FAULT_NAME_LEN; i++)
+    {
+        fault_record.name[i] = '\0';
+    }
+    fault_record.extra_len = 0U;
+    for (i = 0; i < YDRV_FAULT_EXTRA_SIZE / 4U; i++)
+    {
+        fault_record.extra[i] = 0U;
+    }
+
+    // 钩子里再出错时重入这里，跳过钩子直接写入已有的部分
+    if ((fault_hook != NULL) && (fault_in_hook == 0U))
+    {
+        fault_in_hook = 1U;
+        fault_hook(&fault_record);
+        if (fault_record.extra_len > YDRV_FAULT_EXTRA_SIZE)
+        {
+            fault_record.extra_len = YDRV_FAULT_EXTRA_SIZE;
+        }
+    }
+    fault_record.check = yDrv_FaultCheck(&fault_record);
+
+#if YDRV_FAULT_RESET
+    NVIC_SystemReset();
+#else
+    for (;;)
+    {
+    }
+#endif
+}
+
+/**
+ * @brief HardFault的C语言部分
+ * @param frame 异常帧：r0 r1 r2 r3 r12 lr pc xpsr
+ * @param exc_return 异常返回值，未使用
+ */
+static void __attribute__((used, noreturn)) yDrv_FaultHard(uint32_t *frame, uint32_t exc_return)
+{
+    (void)exc_return;
+    yDrv_FaultCommit(YDRV_FAULT_HARDFAULT, 0U, NULL, frame, frame[6], (uint32_t)(frame + 8));
+}
+
+/* 公共函数 --------------------------------------------------------------------*/
+
+/**
+ * @brief HardFault异常入口
+ * @note 按EXC_RETURN的bit2选择出错时使用的堆栈(MSP/PSP)，异常帧地址作为第一个参数
+ */
+void __attribute__((naked)) HardFault_Handler(void)
+{
+    __asm volatile("movs r0, #4          \n"
+                   "mov  r1, lr          \n"
+                   "tst  r0, r1          \n"
+                   "beq  1f              \n"
+                   "mrs  r0, psp         \n"
+                   "b    2f              \n"
+                   "1:                   \n"
+                   "mrs  r0, msp         \n"
+                   "2:                   \n"
+                   "bl   yDrv_FaultHard  \n");
+}
+
+void yDrvFaultLog(yDrvFaultType_t type, uint32_t arg, const char *name)
+{
+    yDrv_FaultCommit(type, arg, name, NULL, (uint32_t)__builtin_return_address(0), __get_MSP());
+}
+
+void yDrvFaultAssert(uint32_t line)
+{
+    yDrv_FaultCommit(YDRV_FAULT_ASSERT, line, NULL, NULL, (uint32_t)__builtin_return_address(0), __get_MSP());
+}
+
+void yDrvFaultRegisterHook(yDrvFaultHook_t hook)
+{
+    fault_hook = hook;
+}
+
+uint8_t yDrvFaultValid(const yDrvFaultRecord_t *record)
+{
+    return ((record->magic == YDRV_FAULT_MAGIC) && (record->check == yDrv_FaultCheck(record))) ? 1U : 0U;
+}
+
+uint8_t yDrvFaultGet(yDrvFaultRecord_t *record)
+{
+    if ((yDrvFaultValid(&fault_record) == 0U) || (fault_record.type == YDRV_FAULT_NONE))
+    {
+        return 0;
+    }
+    if (record != NULL)
+    {
+        *record = fault_record;
+    }
+    return 1;
+}
+
+void yDrvFaultClear(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if ((fault_record.magic == YDRV_FAULT_MAGIC) && (fault_record.check == yDrv_FaultCheck(&fault_record)))
+    {
+        fault_record.type = YDRV_FAULT_NONE;
+        fault_record.check = yDrv_FaultCheck(&fault_record);
+    }
+    __set_PRIMASK(primask);
+}
+
+void yDrvMainStackPaint(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t *word;
+    uint32_t *top;
+
+    // 线程模式下关中断后MSP以下没有使用者
+    __disable_irq();
+    top = (uint32_t *)__get_MSP();
+    for (word = __main_stack_start; word < top; word++)
+    {
+        *word = YDRV_STACK_FILL;
+    }
+    main_stack_painted = 1;
+    __set_PRIMASK(primask);
+}
+
+uint32_t yDrvMainStackUsed(uint32_t *size)
+{
+    const uint32_t *word = __main_stack_start;
+
+    if (size != NULL)
+    {
+        *size = (uint32_t)((uintptr_t)_estack - (uintptr_t)__main_stack_start);
+    }
+    if (main_stack_painted == 0)
+    {
+        return 0;
+    }
+    while ((word < _estack) && (*word == YDRV_STACK_FILL))
+    {
+        word++;
+    }
+    return (uint32_t)((uintptr_t)_estack - (uintptr_t)word);
+}
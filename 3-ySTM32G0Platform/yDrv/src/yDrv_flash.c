@@ -0,0 +1,215 @@
+/**
+ ******************************************************************************
+ * @file    yDrv_flash.c
+ * @author  yLab2.0
+ * @brief   片内Flash编程驱动实现文件
+ * @details 基于STM32G0平台Flash接口实现的页擦除和编程
+ *          - 解锁、参数检查和数据整理在Flash中执行
+ *          - 启动操作到BSY1清零的整段在RAM中执行，其间不取Flash中的指令和常量
+ *          - 整行快速编程，其余双字编程
+ ******************************************************************************
+ * @attention
+ * RAM函数固定放入.RamFunc段，不随YLIB_RAMFUNC_ENABLE关闭；RAM函数之间只互相调用，
+ * 只使用强制内联的CMSIS内部函数。双字的两次字写入之间关中断，避免中断中读取Flash
+ * 插在两次写入之间；快速编程从置FSTPG到BSY1清零全程关中断，满足双字写入间隔要求
+ ******************************************************************************
+ */
+
+/* 包含的头文件 ----------------------------------------------------------------*/
+#include <string.h>
+#include "yDrv_flash.h"
+
+/* 私有宏定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief 放入RAM执行的函数
+ */
+#define YDRV_FLASH_RAMFUNC __attribute__((section(".RamFunc"), noinline))
+
+/**
+ * @brief Flash解锁密钥
+ */
+#define YDRV_FLASH_KEY1 (0x45670123UL)
+#define YDRV_FLASH_KEY2 (0xCDEF89ABUL)
+
+/**
+ * @brief SR中的编程错误位
+ */
+#define YDRV_FLASH_SR_ERRORS (FLASH_SR_OPERR | FLASH_SR_PROGERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR | \
+                              FLASH_SR_SIZERR | FLASH_SR_PGSERR | FLASH_SR_MISERR | FLASH_SR_FASTERR)
+
+/* 私有变量 --------------------------------------------------------------------*/
+
+/**
+ * @brief 最近一次操作的错误位
+ */
+static uint32_t flash_error = 0;
+
+/* 私有函数 --------------------------------------------------------------------*/
+
+/**
+ * @brief 等待操作结束并清除状态
+ * @retval SR中的错误位
+ */
+YDRV_FLASH_RAMFUNC static uint32_t prv_Wait(void)
+{
+    uint32_t sr;
+
+    while ((FLASH->SR & (FLASH_SR_BSY1 | FLASH_SR_CFGBSY)) != 0U)
+    {
+    }
+    sr = FLASH->SR & YDRV_FLASH_SR_ERRORS;
+    FLASH->SR = sr | FLASH_SR_EOP;
+    return sr;
+}
+
+/**
+ * @brief 擦除一页
+ * @param page 页号
+ * @retval SR中的错误位
+ * @note 开中断等待，RAM中的中断照常响应
+ */
+YDRV_FLASH_RAMFUNC static uint32_t prv_ErasePage(uint32_t page)
+{
+    uint32_t sr;
+
+    FLASH->CR = (FLASH->CR & ~(FLASH_CR_PNB | FLASH_CR_PG | FLASH_CR_FSTPG)) |
+                ((page << FLASH_CR_PNB_Pos) & FLASH_CR_PNB) | FLASH_CR_PER;
+    FLASH->CR |= FLASH_CR_STRT;
+    sr = prv_Wait();
+    FLASH->CR &= ~(FLASH_CR_PER | FLASH_CR_PNB);
+    return sr;
+}
+
+/**
+ * @brief 编程一个双字
+ * @param dst 目标地址
+ * @param lo 低位字
+ * @param hi 高位字
+ * @retval SR中的错误位
+ */
+YDRV_FLASH_RAMFUNC static uint32_t prv_ProgramDword(volatile uint32_t *dst, uint32_t lo, uint32_t hi)
+{
+    uint32_t primask;
+    uint32_t sr;
+
+    FLASH->CR |= FLASH_CR_PG;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    dst[0] = lo;
+    __ISB();
+    dst[1] = hi;
+    __set_PRIMASK(primask);
+    sr = prv_Wait();
+    FLASH->CR &= ~FLASH_CR_PG;
+    return sr;
+}
+
+#if YDRV_FLASH_FAST_ENABLE
+/**
+ * @brief 快速编程一行
+ * @param dst 目标地址，行对齐
+ * @param src 数据，字对齐且位于RAM中
+ * @retval SR中的错误位
+ */
+YDRV_FLASH_RAMFUNC static uint32_t prv_ProgramRow(volatile uint32_t *dst, const uint32_t *src)
+{
+    uint32_t primask;
+    uint32_t sr;
+    uint32_t i;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    FLASH->CR |= FLASH_CR_FSTPG;
+    for (i = 0; i < (YDRV_FLASH_ROW_SIZE / 4U); i++)
+    {
+        dst[i] = src[i];
+    }
+    sr = prv_Wait();
+    FLASH->CR &= ~FLASH_CR_FSTPG;
+    __set_PRIMASK(primask);
+    return sr;
+}
+#endif
+
+/**
+ * @brief 解锁Flash控制寄存器并清除残留状态
+ */
+static void prv_Unlock(void)
+{
+    if ((FLASH->CR & FLASH_CR_LOCK) != 0U)
+    {
+        FLASH->KEYR = YDRV_FLASH_KEY1;
+        FLASH->KEYR = YDRV_FLASH_KEY2;
+    }
+    FLASH->SR = YDRV_FLASH_SR_ERRORS | FLASH_SR_EOP;
+}
+
+/**
+ * @brief 上锁并记录错误
+ * @param sr 错误位
+ * @retval yDrv状态
+ */
+static yDrvStatus_t prv_Finish(uint32_t sr)
+{
+    FLASH->CR |= FLASH_CR_LOCK;
+    flash_error |= sr;
+    return (sr == 0U) ? YDRV_OK : YDRV_ERROR;
+}
+
+/* 公共函数 --------------------------------------------------------------------*/
+
+yDrvStatus_t yDrvFlashErasePage(uint32_t page)
+{
+    if (page >= (FLASH_SIZE / YDRV_FLASH_PAGE_SIZE))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    prv_Unlock();
+    return prv_Finish(prv_ErasePage(page));
+}
+
+yDrvStatus_t yDrvFlashProgram(uint32_t address, const void *data, uint32_t size)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    uint32_t word[2];
+    uint32_t sr = 0;
+
+    if ((data == NULL) || ((address % YDRV_FLASH_PROG_SIZE) != 0U) || ((size % YDRV_FLASH_PROG_SIZE) != 0U) ||
+        (address < FLASH_BASE) || (size > FLASH_SIZE) || ((address - FLASH_BASE) > (FLASH_SIZE - size)))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    prv_Unlock();
+    while ((size > 0U) && (sr == 0U))
+    {
+#if YDRV_FLASH_FAST_ENABLE
+        if (((address % YDRV_FLASH_ROW_SIZE) == 0U) && (size >= YDRV_FLASH_ROW_SIZE) &&
+            (((uint32_t)src & 3U) == 0U) && ((uint32_t)src >= SRAM_BASE))
+        {
+            sr = prv_ProgramRow((volatile uint32_t *)address, (const uint32_t *)src);
+            address += YDRV_FLASH_ROW_SIZE;
+            src += YDRV_FLASH_ROW_SIZE;
+            size -= YDRV_FLASH_ROW_SIZE;
+            continue;
+        }
+#endif
+        memcpy(word, src, sizeof(word));
+        sr = prv_ProgramDword((volatile uint32_t *)address, word[0], word[1]);
+        address += YDRV_FLASH_PROG_SIZE;
+        src += YDRV_FLASH_PROG_SIZE;
+        size -= YDRV_FLASH_PROG_SIZE;
+    }
+
+    return prv_Finish(sr);
+}
+
+uint32_t yDrvFlashTakeError(void)
+{
+    uint32_t sr = flash_error;
+
+    flash_error = 0;
+    return sr;
+}
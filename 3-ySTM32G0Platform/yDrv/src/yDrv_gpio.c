@@ -7,24 +7,61 @@
  */
 
 #include "yDrv_gpio.h"
+#include "yLib_trace.h"
 #include "yDrv_basic.h"
 #include <string.h>
 
 // ==================== 私有定义 ====================
 
+/**
+ * @brief EXTI回调链节点
+ * @note 链按order从小到大排列，相同order按注册先后
+ */
+typedef struct yDrvGpioExtiNode
+{
+    yDrvInterruptCallback_t callback; /*!< 回调函数，function为NULL表示空闲 */
+    struct yDrvGpioExtiNode *next;    /*!< 下一个回调 */
+    uint32_t order;                   /*!< 执行顺序 */
+} yDrvGpioExtiNode_t;
+
 /**
  * @brief 全局EXTI中断回调函数数组
- * @note 存储所有EXTI线的回调函数
+ * @note 每条线每个边沿的第一个回调直接存放在这里，只有一个回调时中断处理不访问节点池；
+ *       其余回调从exti_nodes中分配，挂在链上
  */
 static struct
 {
-    yDrvInterruptCallback_t rising_edge_callback;
-    yDrvInterruptCallback_t falling_edge_callback;
-    uint8_t rising_edge_flag;
-    uint8_t falling_edge_flag;
-
+    yDrvGpioExtiNode_t rising_edge_callback;
+    yDrvGpioExtiNode_t falling_edge_callback;
 } exti_callbacks[16]; // EXTI0-EXTI15对应的回调函数
 
+/**
+ * @brief 共享EXTI线的附加回调节点池
+ */
+static yDrvGpioExtiNode_t exti_nodes[YDRV_GPIO_EXTI_CHAIN_MAX];
+
+/**
+ * @brief 已注册上升沿/下降沿回调的EXTI线掩码
+ * @note 第n位对应EXTIn，中断处理时与挂起寄存器相与，只遍历已触发且已注册的线
+ */
+static volatile uint32_t exti_rising_mask;
+static volatile uint32_t exti_falling_mask;
+
+/**
+ * @brief 各EXTI中断向量覆盖的线
+ */
+#define YDRV_GPIO_EXTI0_1_LINES (0x0003UL)
+#define YDRV_GPIO_EXTI2_3_LINES (0x000CUL)
+#define YDRV_GPIO_EXTI4_15_LINES (0xFFF0UL)
+
+/**
+ * @brief 单个置位位到位号的de Bruijn查找表
+ * @note Cortex-M0+没有CLZ指令，__CLZ会展开为软件循环；乘法为单周期，查表为常数时间
+ */
+static const uint8_t exti_bit_index[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9};
+
 // ==================== 基础函数实现 ====================
 
 yDrvStatus_t yDrvGpioInitStatic(yDrvGpioConfig_t *config, yDrvGpioHandle_t *handle)
@@ -184,6 +221,125 @@ void yDrvGpioExtiConfigStructInit(yDrvGpioExtiConfig_t *extiConfig)
     extiConfig->function = NULL;
     extiConfig->arg = NULL;
     extiConfig->enable = 0;
+    extiConfig->order = 0;
+}
+
+// ==================== GPIO端口组函数实现 ====================
+
+yDrvStatus_t yDrvGpioPortInitStatic(yDrvGpioPortConfig_t *config, yDrvGpioPortHandle_t *handle)
+{
+    LL_GPIO_InitTypeDef gpio_init;
+    yDrvGpioInfo_t gpio_info;
+    uint32_t mask;
+
+    // 参数有效性检查
+    if ((config == NULL) || (handle == NULL) || (config->mask == 0))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 解析最低位引脚，得到端口和移位量，同时使能端口时钟
+    if (yDrvParseGpio(config->pin, &gpio_info) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 组内引脚必须全部落在同一端口内
+    mask = (uint32_t)config->mask << gpio_info.pinIndex;
+    if ((mask & 0xFFFF0000UL) != 0)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    handle->port = gpio_info.port;
+    handle->mask = mask;
+    handle->shift = gpio_info.pinIndex;
+    handle->flag = 0;
+
+    // 组内引脚一次配置
+    LL_GPIO_StructInit(&gpio_init);
+
+    gpio_init.Pin = mask;
+
+    switch (config->mode)
+    {
+    case YDRV_GPIO_MODE_INPUT:
+        gpio_init.Mode = LL_GPIO_MODE_INPUT;
+        break;
+    case YDRV_GPIO_MODE_OUTPUT_PP:
+        gpio_init.Mode = LL_GPIO_MODE_OUTPUT;
+        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
+        break;
+    case YDRV_GPIO_MODE_OUTPUT_OD:
+        gpio_init.Mode = LL_GPIO_MODE_OUTPUT;
+        gpio_init.OutputType = LL_GPIO_OUTPUT_OPENDRAIN;
+        break;
+    case YDRV_GPIO_MODE_ANALOG:
+        gpio_init.Mode = LL_GPIO_MODE_ANALOG;
+        break;
+    default:
+        return YDRV_INVALID_PARAM;
+    }
+
+    gpio_init.Speed = config->speed;
+    gpio_init.Pull = config->pupd;
+    gpio_init.Alternate = 0;
+
+    if (LL_GPIO_Init(handle->port, &gpio_init) != SUCCESS)
+    {
+        return YDRV_ERROR;
+    }
+
+    handle->flag = 1;
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvGpioPortDeInitStatic(yDrvGpioPortHandle_t *handle)
+{
+    LL_GPIO_InitTypeDef gpio_init;
+
+    // 参数有效性检查
+    if ((handle == NULL) || (handle->flag == 0))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 组内引脚恢复为模拟模式
+    LL_GPIO_StructInit(&gpio_init);
+
+    gpio_init.Pin = handle->mask;
+    gpio_init.Mode = LL_GPIO_MODE_ANALOG;
+    gpio_init.Speed = LL_GPIO_SPEED_FREQ_LOW;
+    gpio_init.Pull = LL_GPIO_PULL_NO;
+    gpio_init.OutputType = LL_GPIO_OUTPUT_OPENDRAIN;
+    gpio_init.Alternate = 0;
+
+    LL_GPIO_Init(handle->port, &gpio_init);
+
+    handle->flag = 0;
+
+    return YDRV_OK;
+}
+
+void yDrvGpioPortConfigStructInit(yDrvGpioPortConfig_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    *config = YDRV_GPIO_PORT_CONFIG_DEFAULT();
+}
+
+void yDrvGpioPortHandleStructInit(yDrvGpioPortHandle_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    *handle = YDRV_GPIO_PORT_HANDLE_DEFAULT();
 }
 
 // ==================== EXTI中断管理函数实现 ====================
@@ -289,13 +445,44 @@ static yDrvStatus_t yDrv_Gpio_Exit_Source_Set(yDrvGpioHandle_t *handle)
     return YDRV_OK;
 }
 
+/**
+ * @brief 在回调链中插入回调
+ * @param head 链首，即exti_callbacks中的槽位
+ * @param exti 回调配置
+ * @retval yDrv状态，节点池用尽时返回YDRV_BUSY
+ * @note 调用方关中断；同一函数和参数已在链上时先移除再按新的order插入
+ */
+static yDrvStatus_t yDrv_Gpio_ExtiChainAdd(yDrvGpioExtiNode_t *head, const yDrvGpioExtiConfig_t *exti);
+
+/**
+ * @brief 从回调链中移除回调
+ * @param head 链首
+ * @param function 回调函数，NULL时移除全部
+ * @param arg 回调参数
+ * @note 调用方关中断；链首被移除时后继前移，链首为空即该边沿没有回调
+ */
+static void yDrv_Gpio_ExtiChainRemove(yDrvGpioExtiNode_t *head, void (*function)(void *para), void *arg);
+
+/**
+ * @brief 按已注册掩码配置EXTI线的触发边沿和中断屏蔽
+ * @param handle GPIO句柄
+ */
+static void yDrv_Gpio_ExtiApply(yDrvGpioHandle_t *handle);
+
 yDrvStatus_t yDrvGpioRegisterCallback(yDrvGpioHandle_t *handle,
                                       yDrvGpioExtiConfig_t *exti)
 {
-    LL_EXTI_InitTypeDef EXTI_InitStruct;
+    yDrvGpioExtiNode_t *rising;
+    yDrvGpioExtiNode_t *falling;
+    yDrvStatus_t status = YDRV_OK;
+    uint32_t primask;
 
     // 参数有效性检查
-    if ((handle == NULL) || (exti == NULL))
+    if ((handle == NULL) || (exti == NULL) || (exti->function == NULL))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+    if ((exti->trigger < YDRV_GPIO_EXTI_TRIGGER_RISING) || (exti->trigger > YDRV_GPIO_EXTI_TRIGGER_RISING_FALLING))
     {
         return YDRV_INVALID_PARAM;
     }
@@ -305,50 +492,42 @@ yDrvStatus_t yDrvGpioRegisterCallback(yDrvGpioHandle_t *handle,
         return YDRV_ERROR;
     }
 
-    EXTI_InitStruct.Line_0_31 = handle->gpioInfo.pinMask;
-    EXTI_InitStruct.LineCommand = ENABLE;
-    switch (exti->trigger)
+    rising = &exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback;
+    falling = &exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback;
+
+    // 链和掩码在中断处理中读取，修改期间关中断
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if ((exti->trigger & YDRV_GPIO_EXTI_TRIGGER_RISING) != 0)
     {
-    case YDRV_GPIO_EXTI_TRIGGER_RISING:
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_flag = 1;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback.function = exti->function;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback.arg = exti->arg;
-        EXTI_InitStruct.Mode = LL_EXTI_MODE_IT; // 当前只有IT
-        EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_RISING;
-        break;
-    case YDRV_GPIO_EXTI_TRIGGER_FALLING:
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_flag = 1;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback.function = exti->function;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback.arg = exti->arg;
-        EXTI_InitStruct.Mode = LL_EXTI_MODE_IT; // 当前只有IT
-        EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_FALLING;
-        break;
-    case YDRV_GPIO_EXTI_TRIGGER_RISING_FALLING:
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_flag = 1;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback.function = exti->function;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback.arg = exti->arg;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_flag = 1;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback.function = exti->function;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback.arg = exti->arg;
-        EXTI_InitStruct.Mode = LL_EXTI_MODE_IT; // 当前只有IT
-        EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_RISING_FALLING;
-        break;
-    default:
-        return YDRV_INVALID_PARAM;
+        status = yDrv_Gpio_ExtiChainAdd(rising, exti);
     }
-
-    if (LL_EXTI_Init(&EXTI_InitStruct) != 0)
+    if ((status == YDRV_OK) && ((exti->trigger & YDRV_GPIO_EXTI_TRIGGER_FALLING) != 0))
     {
-        return YDRV_ERROR;
+        status = yDrv_Gpio_ExtiChainAdd(falling, exti);
+        if ((status != YDRV_OK) && ((exti->trigger & YDRV_GPIO_EXTI_TRIGGER_RISING) != 0))
+        {
+            // 双沿注册失败时撤销已加入的上升沿
+            yDrv_Gpio_ExtiChainRemove(rising, exti->function, exti->arg);
+        }
+    }
+    if (rising->callback.function != NULL)
+    {
+        exti_rising_mask |= handle->gpioInfo.pinMask;
     }
+    if (falling->callback.function != NULL)
+    {
+        exti_falling_mask |= handle->gpioInfo.pinMask;
+    }
+    yDrv_Gpio_ExtiApply(handle);
+    __set_PRIMASK(primask);
 
-    // 3. 初始化EXTI
-    if (yDrv_Gpio_Exit_Source_Set(handle) != YDRV_OK)
+    if (status != YDRV_OK)
     {
-        return YDRV_ERROR;
+        return status;
     }
 
-    NVIC_SetPriority(handle->IRQ, exti->prio);
+    yDrvIrqSetPriority(handle->IRQ, exti->prio);
     if (exti->enable == 1)
     {
         NVIC_EnableIRQ(handle->IRQ);
@@ -357,88 +536,85 @@ yDrvStatus_t yDrvGpioRegisterCallback(yDrvGpioHandle_t *handle,
     return YDRV_OK;
 }
 
-yDrvStatus_t yDrvGpioUnregisterCallback(yDrvGpioHandle_t *handle, yDrvGpioExti_t trigger)
+/**
+ * @brief 按边沿移除回调并更新EXTI配置
+ * @param handle GPIO句柄
+ * @param trigger 边沿
+ * @param function 回调函数，NULL时移除该边沿全部回调
+ * @param arg 回调参数
+ */
+static void yDrv_Gpio_ExtiRemove(yDrvGpioHandle_t *handle, yDrvGpioExti_t trigger,
+                                 void (*function)(void *para), void *arg)
 {
-    LL_EXTI_InitTypeDef EXTI_InitStruct;
+    yDrvGpioExtiNode_t *rising = &exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback;
+    yDrvGpioExtiNode_t *falling = &exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback;
+    uint32_t primask;
+    uint32_t lines;
 
-    // 参数有效性检查
-    if (handle == NULL)
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if ((trigger & YDRV_GPIO_EXTI_TRIGGER_RISING) != 0)
     {
-        return YDRV_INVALID_PARAM;
+        yDrv_Gpio_ExtiChainRemove(rising, function, arg);
+        if (rising->callback.function == NULL)
+        {
+            exti_rising_mask &= ~(uint32_t)handle->gpioInfo.pinMask;
+        }
     }
-
-    EXTI_InitStruct.Line_0_31 = handle->gpioInfo.pinMask;
-    EXTI_InitStruct.Mode = LL_EXTI_MODE_IT; // 当前只有IT
-    switch (trigger)
+    if ((trigger & YDRV_GPIO_EXTI_TRIGGER_FALLING) != 0)
     {
-    case YDRV_GPIO_EXTI_TRIGGER_RISING:
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_flag = 0;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback.function = NULL;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback.arg = NULL;
-        EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_FALLING;
-        break;
-    case YDRV_GPIO_EXTI_TRIGGER_FALLING:
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_flag = 0;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback.function = NULL;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback.arg = NULL;
-        EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_RISING;
-        break;
-    case YDRV_GPIO_EXTI_TRIGGER_RISING_FALLING:
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_flag = 0;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback.function = NULL;
-        exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_callback.arg = NULL;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_flag = 0;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback.function = NULL;
-        exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_callback.arg = NULL;
-        break;
-    default:
-        break;
+        yDrv_Gpio_ExtiChainRemove(falling, function, arg);
+        if (falling->callback.function == NULL)
+        {
+            exti_falling_mask &= ~(uint32_t)handle->gpioInfo.pinMask;
+        }
     }
+    yDrv_Gpio_ExtiApply(handle);
+    __set_PRIMASK(primask);
 
-    if ((exti_callbacks[handle->gpioInfo.pinIndex].falling_edge_flag == 0) &&
-        (exti_callbacks[handle->gpioInfo.pinIndex].rising_edge_flag == 0))
+    // 同一中断向量下没有任何已注册的线时关闭中断
+    if ((handle->gpioInfo.pinMask & YDRV_GPIO_EXTI0_1_LINES) != 0)
     {
-        EXTI_InitStruct.LineCommand = DISABLE;
+        lines = YDRV_GPIO_EXTI0_1_LINES;
     }
-    else
+    else if ((handle->gpioInfo.pinMask & YDRV_GPIO_EXTI2_3_LINES) != 0)
     {
-        EXTI_InitStruct.LineCommand = DISABLE;
+        lines = YDRV_GPIO_EXTI2_3_LINES;
     }
-
-    if (LL_EXTI_Init(&EXTI_InitStruct) == 0)
+    else
     {
-        return YDRV_ERROR;
+        lines = YDRV_GPIO_EXTI4_15_LINES;
     }
 
-    if (((handle->gpioInfo.pinIndex == 1) || (handle->gpioInfo.pinIndex == 0)) &&
-        (exti_callbacks[0].falling_edge_flag == 0) &&
-        (exti_callbacks[0].rising_edge_flag == 0) &&
-        (exti_callbacks[1].falling_edge_flag == 0) &&
-        (exti_callbacks[1].rising_edge_flag == 0))
+    if (((exti_rising_mask | exti_falling_mask) & lines) == 0)
     {
         NVIC_DisableIRQ(handle->IRQ);
     }
-    else if (((handle->gpioInfo.pinIndex == 2) || (handle->gpioInfo.pinIndex == 3)) &&
-             (exti_callbacks[2].falling_edge_flag == 0) &&
-             (exti_callbacks[2].rising_edge_flag == 0) &&
-             (exti_callbacks[3].falling_edge_flag == 0) &&
-             (exti_callbacks[3].rising_edge_flag == 0))
+}
+
+yDrvStatus_t yDrvGpioUnregisterCallback(yDrvGpioHandle_t *handle, yDrvGpioExti_t trigger)
+{
+    // 参数有效性检查
+    if (handle == NULL)
     {
-        NVIC_DisableIRQ(handle->IRQ);
+        return YDRV_INVALID_PARAM;
     }
-    else if (((handle->gpioInfo.pinIndex >= 4) || (handle->gpioInfo.pinIndex <= 15)))
+
+    yDrv_Gpio_ExtiRemove(handle, trigger, NULL, NULL);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvGpioUnregisterHandler(yDrvGpioHandle_t *handle, yDrvGpioExtiConfig_t *exti)
+{
+    // 参数有效性检查
+    if ((handle == NULL) || (exti == NULL) || (exti->function == NULL))
     {
-        for (size_t i = 4; i < 16; i++)
-        {
-            if (exti_callbacks[i].falling_edge_flag == 1 ||
-                exti_callbacks[i].rising_edge_flag == 1)
-            {
-                return YDRV_OK;
-            }
-        }
-        NVIC_DisableIRQ(handle->IRQ);
+        return YDRV_INVALID_PARAM;
     }
 
+    yDrv_Gpio_ExtiRemove(handle, exti->trigger, exti->function, exti->arg);
+
     return YDRV_OK;
 }
 
@@ -475,32 +651,184 @@ uint8_t yDrvGpioGetInterruptFlag(yDrvGpioHandle_t *handle)
 // ==================== 私有函数实现 ====================
 
 /**
- * @brief EXTI中断统一处理函数
- * @param extiLine EXTI线编号
- * @note 检查中断标志并调用对应的回调函数
+ * @brief 在回调链中插入回调实现
+ */
+static yDrvStatus_t yDrv_Gpio_ExtiChainAdd(yDrvGpioExtiNode_t *head, const yDrvGpioExtiConfig_t *exti)
+{
+    yDrvGpioExtiNode_t *node;
+    yDrvGpioExtiNode_t *prev;
+    uint32_t i;
+
+    yDrv_Gpio_ExtiChainRemove(head, exti->function, exti->arg);
+
+    // 空链直接放在链首，单回调不占用节点池
+    if (head->callback.function == NULL)
+    {
+        head->callback.function = exti->function;
+        head->callback.arg = exti->arg;
+        head->order = exti->order;
+        head->next = NULL;
+        return YDRV_OK;
+    }
+
+    for (i = 0; i < YDRV_GPIO_EXTI_CHAIN_MAX; i++)
+    {
+        if (exti_nodes[i].callback.function == NULL)
+        {
+            break;
+        }
+    }
+    if (i == YDRV_GPIO_EXTI_CHAIN_MAX)
+    {
+        return YDRV_BUSY;
+    }
+    node = &exti_nodes[i];
+
+    if (exti->order < head->order)
+    {
+        // 新回调排在最前：原链首移入节点，新回调占据链首
+        *node = *head;
+        head->callback.function = exti->function;
+        head->callback.arg = exti->arg;
+        head->order = exti->order;
+        head->next = node;
+        return YDRV_OK;
+    }
+
+    node->callback.function = exti->function;
+    node->callback.arg = exti->arg;
+    node->order = exti->order;
+    for (prev = head; (prev->next != NULL) && (prev->next->order <= exti->order); prev = prev->next)
+    {
+    }
+    node->next = prev->next;
+    prev->next = node;
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 从回调链中移除回调实现
  */
-#define GPIO_HANDLE_EXIT_IRQ(extiLine)                                                                                       \
-    do                                                                                                                       \
-    {                                                                                                                        \
-        if ((LL_EXTI_IsActiveRisingFlag_0_31((1U << extiLine)) != RESET) &&                                                  \
-            (exti_callbacks[extiLine].rising_edge_flag == 1))                                                                \
-        {                                                                                                                    \
-            LL_EXTI_ClearRisingFlag_0_31((1U << extiLine));                                                                  \
-            if (exti_callbacks[extiLine].rising_edge_callback.function != NULL)                                              \
-            {                                                                                                                \
-                exti_callbacks[extiLine].rising_edge_callback.function(exti_callbacks[extiLine].rising_edge_callback.arg);   \
-            }                                                                                                                \
-        }                                                                                                                    \
-        if ((LL_EXTI_IsActiveFallingFlag_0_31((1U << extiLine)) != RESET) &&                                                 \
-            (exti_callbacks[extiLine].falling_edge_flag == 1))                                                               \
-        {                                                                                                                    \
-            LL_EXTI_ClearFallingFlag_0_31((1U << extiLine));                                                                 \
-            if (exti_callbacks[extiLine].falling_edge_callback.function != NULL)                                             \
-            {                                                                                                                \
-                exti_callbacks[extiLine].falling_edge_callback.function(exti_callbacks[extiLine].falling_edge_callback.arg); \
-            }                                                                                                                \
-        }                                                                                                                    \
-    } while (0)
+static void yDrv_Gpio_ExtiChainRemove(yDrvGpioExtiNode_t *head, void (*function)(void *para), void *arg)
+{
+    yDrvGpioExtiNode_t *prev;
+    yDrvGpioExtiNode_t *node;
+
+    // 先处理链上的节点，最后处理链首
+    prev = head;
+    while (prev->next != NULL)
+    {
+        node = prev->next;
+        if ((function == NULL) || ((node->callback.function == function) && (node->callback.arg == arg)))
+        {
+            prev->next = node->next;
+            node->callback.function = NULL;
+            node->next = NULL;
+        }
+        else
+        {
+            prev = node;
+        }
+    }
+
+    if ((function == NULL) || ((head->callback.function == function) && (head->callback.arg == arg)))
+    {
+        node = head->next;
+        if (node != NULL)
+        {
+            // 后继前移到链首，归还节点
+            *head = *node;
+            node->callback.function = NULL;
+            node->next = NULL;
+        }
+        else
+        {
+            head->callback.function = NULL;
+            head->callback.arg = NULL;
+        }
+    }
+}
+
+/**
+ * @brief 按已注册掩码配置EXTI线实现
+ */
+static void yDrv_Gpio_ExtiApply(yDrvGpioHandle_t *handle)
+{
+    uint32_t mask = handle->gpioInfo.pinMask;
+
+    if ((exti_rising_mask & mask) != 0)
+    {
+        LL_EXTI_EnableRisingTrig_0_31(mask);
+    }
+    else
+    {
+        LL_EXTI_DisableRisingTrig_0_31(mask);
+    }
+
+    if ((exti_falling_mask & mask) != 0)
+    {
+        LL_EXTI_EnableFallingTrig_0_31(mask);
+    }
+    else
+    {
+        LL_EXTI_DisableFallingTrig_0_31(mask);
+    }
+
+    if (((exti_rising_mask | exti_falling_mask) & mask) != 0)
+    {
+        LL_EXTI_EnableIT_0_31(mask);
+    }
+    else
+    {
+        LL_EXTI_DisableIT_0_31(mask);
+    }
+}
+
+/**
+ * @brief EXTI中断统一分发函数
+ * @param lines 当前中断向量覆盖的EXTI线掩码
+ * @note 上升沿和下降沿挂起寄存器各读一次，与已注册掩码相与后只遍历置位的线；
+ *       先清除挂起位再调用回调，回调执行期间的新边沿会再次进入中断。
+ *       掩码置位的线链首必有回调，直接调用；只有next非空时才遍历共享回调
+ */
+YLIB_RAMFUNC static void yDrv_Gpio_ExtiDispatch(uint32_t lines)
+{
+    uint32_t rising = EXTI->RPR1 & exti_rising_mask & lines;
+    uint32_t falling = EXTI->FPR1 & exti_falling_mask & lines;
+    const yDrvGpioExtiNode_t *node;
+    uint32_t bit;
+    uint32_t line;
+
+    EXTI->RPR1 = rising;
+    EXTI->FPR1 = falling;
+
+    while (rising != 0)
+    {
+        bit = rising & (0U - rising); // 取最低置位位
+        rising ^= bit;
+        line = exti_bit_index[(bit * 0x077CB531UL) >> 27];
+        node = &exti_callbacks[line].rising_edge_callback;
+        do
+        {
+            node->callback.function(node->callback.arg);
+            node = node->next;
+        } while (node != NULL);
+    }
+
+    while (falling != 0)
+    {
+        bit = falling & (0U - falling);
+        falling ^= bit;
+        line = exti_bit_index[(bit * 0x077CB531UL) >> 27];
+        node = &exti_callbacks[line].falling_edge_callback;
+        do
+        {
+            node->callback.function(node->callback.arg);
+            node = node->next;
+        } while (node != NULL);
+    }
+}
 
 // ==================== EXTI中断处理函数 ====================
 
@@ -508,42 +836,28 @@ uint8_t yDrvGpioGetInterruptFlag(yDrvGpioHandle_t *handle)
  * @brief EXTI0_1中断处理函数
  * @note 此函数由NVIC调用，处理EXTI0-1线中断
  */
-void EXTI0_1_IRQHandler(void)
+YLIB_RAMFUNC void EXTI0_1_IRQHandler(void)
 {
-    // 检查EXTI0-1各线的中断标志
-    GPIO_HANDLE_EXIT_IRQ(0);
-    GPIO_HANDLE_EXIT_IRQ(1);
+    YLIB_TRACE_ISR();
+    yDrv_Gpio_ExtiDispatch(YDRV_GPIO_EXTI0_1_LINES);
 }
 
 /**
  * @brief EXTI2_3中断处理函数
  * @note 此函数由NVIC调用，处理EXTI2-3线中断
  */
-void EXTI2_3_IRQHandler(void)
+YLIB_RAMFUNC void EXTI2_3_IRQHandler(void)
 {
-    // 检查EXTI2-3各线的中断标志
-    GPIO_HANDLE_EXIT_IRQ(2);
-    GPIO_HANDLE_EXIT_IRQ(3);
+    YLIB_TRACE_ISR();
+    yDrv_Gpio_ExtiDispatch(YDRV_GPIO_EXTI2_3_LINES);
 }
 
 /**
  * @brief EXTI4_15中断处理函数
  * @note 此函数由NVIC调用，处理EXTI4-15线中断
  */
-void EXTI4_15_IRQHandler(void)
+YLIB_RAMFUNC void EXTI4_15_IRQHandler(void)
 {
-    // 检查EXTI4-15各线的中断标志
-
-    GPIO_HANDLE_EXIT_IRQ(4);
-    GPIO_HANDLE_EXIT_IRQ(5);
-    GPIO_HANDLE_EXIT_IRQ(6);
-    GPIO_HANDLE_EXIT_IRQ(7);
-    GPIO_HANDLE_EXIT_IRQ(8);
-    GPIO_HANDLE_EXIT_IRQ(9);
-    GPIO_HANDLE_EXIT_IRQ(10);
-    GPIO_HANDLE_EXIT_IRQ(11);
-    GPIO_HANDLE_EXIT_IRQ(12);
-    GPIO_HANDLE_EXIT_IRQ(13);
-    GPIO_HANDLE_EXIT_IRQ(14);
-    GPIO_HANDLE_EXIT_IRQ(15);
+    YLIB_TRACE_ISR();
+    yDrv_Gpio_ExtiDispatch(YDRV_GPIO_EXTI4_15_LINES);
 }
@@ -0,0 +1,952 @@
+/**
+ * @file yDrv_i2c.c
+ * @brief STM32G0 I2C主机驱动程序实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现I2C主机的时序计算、中断/DMA传输状态机和总线恢复
+ *
+ * @par 实现说明:
+ * - 内核时钟固定取PCLK，TIMINGR在初始化、改速和系统时钟切换时按实际PCLK计算
+ * - 每段传输按255字节分片：分片未完时置RELOAD，TCR中断里写入下一片的NBYTES；
+ *   DMA长度为整段长度，分片期间DMA不停，CPU只在分片边界进一次中断
+ * - 写段后接读段时写段不置AUTOEND，TC中断里直接发重复起始；最后一段置AUTOEND，
+ *   STOPF中断结束传输
+ * - NACK后硬件在AUTOEND=0时不会自动发STOP，由中断补发，统一在STOPF中结束
+ * - BERR/ARLO/OVR不保证有STOP，立即软件复位外设结束传输
+ */
+
+#include <string.h> // For memset
+#include "yDrv_i2c.h"
+#include "yDrv_clock.h"
+#include "yLib_trace.h"
+#include "stm32g0xx_ll_rcc.h"
+
+// ==================== 私有定义 ====================
+
+/**
+ * @brief 传输阶段
+ */
+#define YDRV_I2C_PHASE_IDLE (0U)
+#define YDRV_I2C_PHASE_WRITE (1U)
+#define YDRV_I2C_PHASE_READ (2U)
+#define YDRV_I2C_PHASE_PROBE (3U)
+
+/**
+ * @brief 单个NBYTES分片最大字节数
+ */
+#define YDRV_I2C_NBYTES_MAX (255U)
+
+/**
+ * @brief 传输期间使能的中断，TCIE同时覆盖TC和TCR
+ */
+#define YDRV_I2C_IT_XFER (I2C_CR1_ERRIE | I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_NACKIE)
+
+/**
+ * @brief CR1中所有中断和DMA请求使能位
+ */
+#define YDRV_I2C_IT_ALL (YDRV_I2C_IT_XFER | I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_ADDRIE | \
+                         I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN)
+
+/**
+ * @brief 模拟滤波器引入的延迟(ns)
+ */
+#define YDRV_I2C_AF_MIN_NS (50U)
+#define YDRV_I2C_AF_MAX_NS (260U)
+
+/**
+ * @brief 总线恢复时SCL半周期(微秒)，对应约100kHz
+ */
+#define YDRV_I2C_RECOVER_HALF_US (5U)
+
+/**
+ * @brief 总线时序参数(ns)
+ * @note 高低电平和建立/有效时间取规范限值，上升/下降沿取典型板级估计值
+ */
+typedef struct
+{
+    uint32_t hz;      /*!< 总线速率 */
+    uint16_t lowMin;  /*!< SCL低电平最小时间 tLOW */
+    uint16_t highMin; /*!< SCL高电平最小时间 tHIGH */
+    uint16_t suDat;   /*!< 数据建立时间 tSU;DAT */
+    uint16_t vdDat;   /*!< 数据有效时间最大值 tVD;DAT */
+    uint16_t tr;      /*!< 上升时间 */
+    uint16_t tf;      /*!< 下降时间 */
+} yDrvI2cSpec_t;
+
+static const yDrvI2cSpec_t i2c_spec[] = {
+    {YDRV_I2C_SPEED_100K, 4700, 4000, 250, 3450, 500, 100},
+    {YDRV_I2C_SPEED_400K, 1300, 600, 100, 900, 250, 100},
+    {YDRV_I2C_SPEED_1M, 500, 260, 50, 450, 50, 20},
+};
+
+/**
+ * @brief 实例寄存器、中断号、DMA请求和FM+使能位映射
+ */
+static I2C_TypeDef *const I2C_INSTANCE_MAP[YDRV_I2C_MAX] = {I2C1, I2C2};
+static const IRQn_Type I2C_IRQ_MAP[YDRV_I2C_MAX] = {I2C1_IRQn, I2C2_IRQn};
+static const uint32_t I2C_CLOCK_MAP[YDRV_I2C_MAX] = {LL_APB1_GRP1_PERIPH_I2C1, LL_APB1_GRP1_PERIPH_I2C2};
+static const yDrvDmaRequest_t I2C_DMA_TX_MAP[YDRV_I2C_MAX] = {YDRV_DMA_REQ_I2C1_TX, YDRV_DMA_REQ_I2C2_TX};
+static const yDrvDmaRequest_t I2C_DMA_RX_MAP[YDRV_I2C_MAX] = {YDRV_DMA_REQ_I2C1_RX, YDRV_DMA_REQ_I2C2_RX};
+static const uint32_t I2C_FMP_MAP[YDRV_I2C_MAX] = {SYSCFG_CFGR1_I2C1_FMP, SYSCFG_CFGR1_I2C2_FMP};
+
+/**
+ * @brief 各实例当前句柄，中断使用
+ */
+static yDrvI2cHandle_t *i2c_handle[YDRV_I2C_MAX] = {NULL};
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 获取I2C内核时钟频率
+ * @retval uint32_t PCLK频率(Hz)
+ */
+static uint32_t prv_GetClockFreq(void);
+
+/**
+ * @brief 按速率写入TIMINGR和FM+驱动使能
+ * @param handle 句柄指针
+ * @param speed 总线速率
+ * @retval yDrvStatus_t 操作状态
+ * @note 调用时PE必须为0
+ */
+static yDrvStatus_t prv_ApplySpeed(yDrvI2cHandle_t *handle, yDrvI2cSpeed_t speed);
+
+/**
+ * @brief 系统时钟切换通知
+ * @note PRE确认总线空闲且新频率下能达到原速率，POST重写TIMINGR
+ */
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg);
+
+/**
+ * @brief 系统时钟切换通知，所有实例共用
+ */
+static yDrvClockNotifier_t i2c_clock_notifier = {.callback = prv_ClockNotify};
+
+/**
+ * @brief 申请并配置一个方向的DMA通道
+ * @param handle 句柄指针
+ * @param config 配置参数指针
+ * @param dma DMA句柄
+ * @param channel DMA通道
+ * @param request DMAMUX请求
+ * @param direction 传输方向
+ * @param periph 外设数据寄存器
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t prv_DmaInit(const yDrvI2cConfig_t *config,
+                                yDrvDmaHandle_t *dma,
+                                yDrvDmaChannel_t channel,
+                                yDrvDmaRequest_t request,
+                                yDrvDmaDirection_t direction,
+                                volatile uint32_t *periph);
+
+/**
+ * @brief 释放DMA通道
+ * @param dma DMA句柄
+ */
+static void prv_DmaDeInit(yDrvDmaHandle_t *dma);
+
+/**
+ * @brief 启动一段传输
+ * @param handle 句柄指针
+ * @param phase YDRV_I2C_PHASE_WRITE或YDRV_I2C_PHASE_READ
+ * @note 先配置DMA或中断，最后写CR2发START
+ */
+static void prv_StartPhase(yDrvI2cHandle_t *handle, uint8_t phase);
+
+/**
+ * @brief 当前段是否为最后一段
+ * @param handle 句柄指针
+ * @retval uint32_t 1=最后一段
+ */
+static uint32_t prv_IsLastPhase(yDrvI2cHandle_t *handle);
+
+/**
+ * @brief 软件复位外设
+ * @param instance I2C寄存器指针
+ * @note PE清零后状态机和标志复位，TIMINGR等配置寄存器保持
+ */
+static void prv_SoftReset(I2C_TypeDef *instance);
+
+/**
+ * @brief 停止硬件活动
+ * @param handle 句柄指针
+ * @note 关闭中断和DMA请求，停止DMA通道，软件复位外设
+ */
+static void prv_Halt(yDrvI2cHandle_t *handle);
+
+/**
+ * @brief 结束传输并调用回调
+ * @param handle 句柄指针
+ * @param result 传输结果
+ */
+static void prv_Finish(yDrvI2cHandle_t *handle, yDrvI2cResult_t result);
+
+/**
+ * @brief 引脚配置为复用功能开漏
+ * @param handle 句柄指针
+ * @param info 引脚信息
+ * @param pull 上拉配置
+ */
+static void prv_PinInit(yDrvI2cHandle_t *handle, const yDrvGpioInfo_t *info, uint32_t pull);
+
+/**
+ * @brief 忙等待微秒延时
+ * @param us 延时(微秒)
+ * @note 按每次循环至少4个周期估算，实际延时偏长
+ */
+static void prv_DelayUs(uint32_t us);
+
+/**
+ * @brief I2C中断公共处理
+ * @param handle 句柄指针
+ */
+static void prv_IrqHandler(yDrvI2cHandle_t *handle);
+
+// ==================== 基础函数实现 ====================
+
+yDrvStatus_t yDrvI2cInitStatic(const yDrvI2cConfig_t *config, yDrvI2cHandle_t *handle)
+{
+    uint32_t pull;
+    yDrvStatus_t status;
+
+    // 参数有效性检查
+    if (config == NULL || handle == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (config->i2cId >= YDRV_I2C_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (i2c_handle[config->i2cId] != NULL)
+    {
+        return YDRV_BUSY;
+    }
+
+    *handle = YDRV_I2C_HANDLE_DEFAULT();
+
+    if ((yDrvParseGpio(config->scl, &handle->sclInfo) != YDRV_OK) ||
+        (yDrvParseGpio(config->sda, &handle->sdaInfo) != YDRV_OK))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 1. 时钟和复位，内核时钟选PCLK
+    LL_APB1_GRP1_EnableClock(I2C_CLOCK_MAP[config->i2cId]);
+    LL_APB1_GRP1_ForceReset(I2C_CLOCK_MAP[config->i2cId]);
+    LL_APB1_GRP1_ReleaseReset(I2C_CLOCK_MAP[config->i2cId]);
+    if (config->i2cId == YDRV_I2C_1)
+    {
+        CLEAR_BIT(RCC->CCIPR, RCC_CCIPR_I2C1SEL);
+    }
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_SYSCFG);
+
+    handle->instance = I2C_INSTANCE_MAP[config->i2cId];
+    handle->IRQ = I2C_IRQ_MAP[config->i2cId];
+    handle->i2cId = config->i2cId;
+
+    // 2. 时序，模拟滤波打开，数字滤波关闭
+    handle->instance->CR1 = 0;
+    if (prv_ApplySpeed(handle, config->speed) != YDRV_OK)
+    {
+        LL_APB1_GRP1_DisableClock(I2C_CLOCK_MAP[config->i2cId]);
+        handle->instance = NULL;
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 3. DMA通道在初始化时申请，传输时只改地址和长度
+    if (config->useDma)
+    {
+        status = prv_DmaInit(config, &handle->txDma, config->txChannel,
+                             I2C_DMA_TX_MAP[config->i2cId], YDRV_DMA_DIR_M2P, &handle->instance->TXDR);
+        if (status == YDRV_OK)
+        {
+            status = prv_DmaInit(config, &handle->rxDma, config->rxChannel,
+                                 I2C_DMA_RX_MAP[config->i2cId], YDRV_DMA_DIR_P2M, &handle->instance->RXDR);
+        }
+        if (status != YDRV_OK)
+        {
+            prv_DmaDeInit(&handle->txDma);
+            CLEAR_BIT(SYSCFG->CFGR1, I2C_FMP_MAP[config->i2cId]);
+            LL_APB1_GRP1_DisableClock(I2C_CLOCK_MAP[config->i2cId]);
+            handle->instance = NULL;
+            return YDRV_BUSY;
+        }
+    }
+
+    // 4. 引脚，外设使能后再切到复用功能，避免切换瞬间在总线上产生毛刺
+    handle->pinAF = config->pinAF;
+    pull = config->pullUp ? LL_GPIO_PULL_UP : LL_GPIO_PULL_NO;
+    SET_BIT(handle->instance->CR1, I2C_CR1_PE);
+    prv_PinInit(handle, &handle->sclInfo, pull);
+    prv_PinInit(handle, &handle->sdaInfo, pull);
+
+    handle->dmaThreshold = config->dmaThreshold;
+    handle->callback = config->callback;
+    handle->arg = config->arg;
+    handle->phase = YDRV_I2C_PHASE_IDLE;
+    handle->result = YDRV_I2C_RESULT_OK;
+
+    yDrvIrqSetPriority(handle->IRQ, config->prio);
+    NVIC_ClearPendingIRQ(handle->IRQ);
+    NVIC_EnableIRQ(handle->IRQ);
+
+    i2c_handle[config->i2cId] = handle;
+    yDrvClockRegister(&i2c_clock_notifier);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvI2cDeInitStatic(yDrvI2cHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    NVIC_DisableIRQ(handle->IRQ);
+    prv_Halt(handle);
+    handle->phase = YDRV_I2C_PHASE_IDLE;
+
+    prv_DmaDeInit(&handle->txDma);
+    prv_DmaDeInit(&handle->rxDma);
+
+    CLEAR_BIT(handle->instance->CR1, I2C_CR1_PE);
+    CLEAR_BIT(SYSCFG->CFGR1, I2C_FMP_MAP[handle->i2cId]);
+    LL_APB1_GRP1_DisableClock(I2C_CLOCK_MAP[handle->i2cId]);
+
+    LL_GPIO_SetPinMode(handle->sclInfo.port, handle->sclInfo.pinMask, LL_GPIO_MODE_ANALOG);
+    LL_GPIO_SetPinMode(handle->sdaInfo.port, handle->sdaInfo.pinMask, LL_GPIO_MODE_ANALOG);
+
+    i2c_handle[handle->i2cId] = NULL;
+    handle->instance = NULL;
+
+    return YDRV_OK;
+}
+
+void yDrvI2cConfigStructInit(yDrvI2cConfig_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    *config = YDRV_I2C_CONFIG_DEFAULT();
+}
+
+void yDrvI2cHandleStructInit(yDrvI2cHandle_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    memset(handle, 0, sizeof(yDrvI2cHandle_t));
+    *handle = YDRV_I2C_HANDLE_DEFAULT();
+}
+
+yDrvStatus_t yDrvI2cCalcTiming(uint32_t clock, yDrvI2cSpeed_t speed, uint32_t *timing)
+{
+    const yDrvI2cSpec_t *spec = NULL;
+    uint32_t scldel, sdadel_min, sdadel_max;
+    uint32_t low, high, sum, extra;
+    int32_t period;
+
+    if (timing == NULL || clock == 0U)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0; i < sizeof(i2c_spec) / sizeof(i2c_spec[0]); i++)
+    {
+        if (i2c_spec[i].hz == (uint32_t)speed)
+        {
+            spec = &i2c_spec[i];
+            break;
+        }
+    }
+
+    if (spec == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+// 纳秒换算为内核时钟周期数，向上/向下取整
+#define NS_CEIL(_ns) ((uint32_t)(((uint64_t)(_ns) * clock + 999999999ULL) / 1000000000ULL))
+#define NS_FLOOR(_ns) ((uint32_t)(((uint64_t)(_ns) * clock) / 1000000000ULL))
+
+    // 一个SCL周期里扣除同步、边沿和滤波延迟后留给SCLL/SCLH的周期数
+    period = (int32_t)(clock / spec->hz) -
+             (int32_t)NS_CEIL(spec->tr + spec->tf + 2U * YDRV_I2C_AF_MIN_NS) - 4;
+
+    for (uint32_t presc = 1; presc <= 16U; presc++)
+    {
+        // tSCLDEL = (SCLDEL+1)*tPRESC >= tr + tSU;DAT
+        scldel = (NS_CEIL(spec->tr + spec->suDat) + presc - 1U) / presc;
+        scldel = (scldel > 0U) ? scldel - 1U : 0U;
+        if (scldel > 15U)
+        {
+            continue;
+        }
+
+        // tf - tAF(min) - 3*tI2CCLK <= SDADEL*tPRESC <= tVD;DAT - tr - tAF(max) - 4*tI2CCLK
+        sdadel_min = (spec->tf > YDRV_I2C_AF_MIN_NS) ? NS_CEIL(spec->tf - YDRV_I2C_AF_MIN_NS) : 0U;
+        sdadel_min = (sdadel_min > 3U) ? (sdadel_min - 3U + presc - 1U) / presc : 0U;
+        sdadel_max = NS_FLOOR(spec->vdDat - spec->tr - YDRV_I2C_AF_MAX_NS);
+        sdadel_max = (sdadel_max > 4U) ? (sdadel_max - 4U) / presc : 0U;
+        if ((sdadel_min > 15U) || (sdadel_min > sdadel_max))
+        {
+            continue;
+        }
+
+        // 实测低电平还包含下降沿、滤波和2个同步周期，高电平同理；先满足最小时间，余量平分，奇数周期给低电平
+        low = NS_CEIL(spec->lowMin - spec->tf - YDRV_I2C_AF_MIN_NS);
+        low = ((low > 3U) ? low - 2U + presc - 1U : presc) / presc;
+        high = NS_CEIL(spec->highMin - spec->tr - YDRV_I2C_AF_MIN_NS);
+        high = ((high > 3U) ? high - 2U + presc - 1U : presc) / presc;
+        if ((period <= 0) || ((uint32_t)period / presc < low + high))
+        {
+            break; // 预分频越大余量越小，不必继续
+        }
+        sum = (uint32_t)period / presc;
+        extra = sum - low - high;
+        low += (extra + 1U) / 2U;
+        high += extra / 2U;
+        if ((low > 256U) || (high > 256U))
+        {
+            continue;
+        }
+
+        *timing = ((presc - 1U) << I2C_TIMINGR_PRESC_Pos) |
+                  (scldel << I2C_TIMINGR_SCLDEL_Pos) |
+                  (sdadel_min << I2C_TIMINGR_SDADEL_Pos) |
+                  ((high - 1U) << I2C_TIMINGR_SCLH_Pos) |
+                  ((low - 1U) << I2C_TIMINGR_SCLL_Pos);
+        return YDRV_OK;
+    }
+
+#undef NS_CEIL
+#undef NS_FLOOR
+
+    return YDRV_INVALID_PARAM;
+}
+
+yDrvStatus_t yDrvI2cSetSpeed(yDrvI2cHandle_t *handle, yDrvI2cSpeed_t speed)
+{
+    yDrvStatus_t status;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->phase != YDRV_I2C_PHASE_IDLE)
+    {
+        return YDRV_BUSY;
+    }
+
+    // TIMINGR只能在PE=0时修改
+    CLEAR_BIT(handle->instance->CR1, I2C_CR1_PE);
+    status = prv_ApplySpeed(handle, speed);
+    SET_BIT(handle->instance->CR1, I2C_CR1_PE);
+
+    return status;
+}
+
+// ==================== 传输函数实现 ====================
+
+yDrvStatus_t yDrvI2cTransfer(yDrvI2cHandle_t *handle, uint16_t addr,
+                             const uint8_t *txBuf, uint32_t txLen,
+                             uint8_t *rxBuf, uint32_t rxLen)
+{
+    I2C_TypeDef *i2c;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((addr > 0x7FU) || (txLen > YDRV_I2C_XFER_MAX) || (rxLen > YDRV_I2C_XFER_MAX) ||
+        ((txLen != 0U) && (txBuf == NULL)) || ((rxLen != 0U) && (rxBuf == NULL)))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    i2c = handle->instance;
+    if ((handle->phase != YDRV_I2C_PHASE_IDLE) || (READ_BIT(i2c->ISR, I2C_ISR_BUSY) != 0U))
+    {
+        return YDRV_BUSY;
+    }
+
+    handle->addr = addr;
+    handle->txBuf = txBuf;
+    handle->txLen = txLen;
+    handle->rxBuf = rxBuf;
+    handle->rxLen = rxLen;
+    handle->result = YDRV_I2C_RESULT_OK;
+
+    // 清除上次残留的标志，丢弃TXDR中未发出的数据
+    WRITE_REG(i2c->ICR, I2C_ICR_STOPCF | I2C_ICR_NACKCF | I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF);
+    SET_BIT(i2c->ISR, I2C_ISR_TXE);
+
+    if (txLen != 0U)
+    {
+        prv_StartPhase(handle, YDRV_I2C_PHASE_WRITE);
+    }
+    else if (rxLen != 0U)
+    {
+        prv_StartPhase(handle, YDRV_I2C_PHASE_READ);
+    }
+    else
+    {
+        // 只发地址：NBYTES=0加AUTOEND，应答后直接STOP
+        handle->phase = YDRV_I2C_PHASE_PROBE;
+        handle->remain = 0;
+        MODIFY_REG(i2c->CR1, YDRV_I2C_IT_ALL, YDRV_I2C_IT_XFER);
+        WRITE_REG(i2c->CR2, ((uint32_t)addr << 1) | I2C_CR2_AUTOEND | I2C_CR2_START);
+    }
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvI2cAbort(yDrvI2cHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    NVIC_DisableIRQ(handle->IRQ);
+    prv_Halt(handle);
+    handle->phase = YDRV_I2C_PHASE_IDLE;
+    handle->result = YDRV_I2C_RESULT_ABORT;
+    NVIC_ClearPendingIRQ(handle->IRQ);
+    NVIC_EnableIRQ(handle->IRQ);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvI2cRecover(yDrvI2cHandle_t *handle)
+{
+    GPIO_TypeDef *scl_port, *sda_port;
+    uint32_t scl, sda;
+    yDrvStatus_t status;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    (void)yDrvI2cAbort(handle);
+
+    scl_port = handle->sclInfo.port;
+    sda_port = handle->sdaInfo.port;
+    scl = handle->sclInfo.pinMask;
+    sda = handle->sdaInfo.pinMask;
+
+    // 1. 引脚切换为开漏输出并释放
+    LL_GPIO_SetOutputPin(scl_port, scl);
+    LL_GPIO_SetOutputPin(sda_port, sda);
+    LL_GPIO_SetPinMode(scl_port, scl, LL_GPIO_MODE_OUTPUT);
+    LL_GPIO_SetPinMode(sda_port, sda, LL_GPIO_MODE_OUTPUT);
+    prv_DelayUs(YDRV_I2C_RECOVER_HALF_US);
+
+    // 2. 从机在读操作中拉住SDA时，补足时钟让它送完当前字节
+    for (uint32_t i = 0; (i < 9U) && (LL_GPIO_IsInputPinSet(sda_port, sda) == 0U); i++)
+    {
+        LL_GPIO_ResetOutputPin(scl_port, scl);
+        prv_DelayUs(YDRV_I2C_RECOVER_HALF_US);
+        LL_GPIO_SetOutputPin(scl_port, scl);
+        prv_DelayUs(YDRV_I2C_RECOVER_HALF_US);
+    }
+
+    // 3. SCL为高时SDA由低变高即STOP，复位所有从机的状态机
+    LL_GPIO_ResetOutputPin(scl_port, scl);
+    prv_DelayUs(YDRV_I2C_RECOVER_HALF_US);
+    LL_GPIO_ResetOutputPin(sda_port, sda);
+    prv_DelayUs(YDRV_I2C_RECOVER_HALF_US);
+    LL_GPIO_SetOutputPin(scl_port, scl);
+    prv_DelayUs(YDRV_I2C_RECOVER_HALF_US);
+    LL_GPIO_SetOutputPin(sda_port, sda);
+    prv_DelayUs(YDRV_I2C_RECOVER_HALF_US);
+
+    status = (LL_GPIO_IsInputPinSet(sda_port, sda) != 0U) ? YDRV_OK : YDRV_ERROR;
+
+    // 4. 恢复复用功能，软件复位清除外设记录的总线忙状态
+    LL_GPIO_SetPinMode(scl_port, scl, LL_GPIO_MODE_ALTERNATE);
+    LL_GPIO_SetPinMode(sda_port, sda, LL_GPIO_MODE_ALTERNATE);
+    prv_SoftReset(handle->instance);
+
+    return status;
+}
+
+// ==================== 私有函数实现 ====================
+
+static uint32_t prv_GetClockFreq(void)
+{
+    return __LL_RCC_CALC_PCLK1_FREQ(SystemCoreClock, LL_RCC_GetAPB1Prescaler());
+}
+
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg)
+{
+    yDrvI2cHandle_t *handle;
+    uint32_t timing;
+    uint32_t id;
+
+    (void)oldHz;
+    (void)arg;
+
+    for (id = 0; id < YDRV_I2C_MAX; id++)
+    {
+        handle = i2c_handle[id];
+        if (handle == NULL)
+        {
+            continue;
+        }
+
+        if (event == YDRV_CLOCK_PRE)
+        {
+            // APB不分频，PCLK即SYSCLK
+            if ((handle->phase != YDRV_I2C_PHASE_IDLE) ||
+                (yDrvI2cCalcTiming(newHz, (yDrvI2cSpeed_t)handle->speed, &timing) != YDRV_OK))
+            {
+                return YDRV_BUSY;
+            }
+        }
+        else if (event == YDRV_CLOCK_POST)
+        {
+            // TIMINGR只能在PE=0时修改
+            CLEAR_BIT(handle->instance->CR1, I2C_CR1_PE);
+            (void)prv_ApplySpeed(handle, (yDrvI2cSpeed_t)handle->speed);
+            SET_BIT(handle->instance->CR1, I2C_CR1_PE);
+        }
+    }
+
+    return YDRV_OK;
+}
+
+static yDrvStatus_t prv_ApplySpeed(yDrvI2cHandle_t *handle, yDrvI2cSpeed_t speed)
+{
+    uint32_t timing;
+
+    if (yDrvI2cCalcTiming(prv_GetClockFreq(), speed, &timing) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 1MHz需要引脚20mA灌电流能力
+    if (speed == YDRV_I2C_SPEED_1M)
+    {
+        SET_BIT(SYSCFG->CFGR1, I2C_FMP_MAP[handle->i2cId]);
+    }
+    else
+    {
+        CLEAR_BIT(SYSCFG->CFGR1, I2C_FMP_MAP[handle->i2cId]);
+    }
+
+    handle->instance->TIMINGR = timing;
+    handle->timing = timing;
+    handle->speed = (uint32_t)speed;
+
+    return YDRV_OK;
+}
+
+static yDrvStatus_t prv_DmaInit(const yDrvI2cConfig_t *config,
+                                yDrvDmaHandle_t *dma,
+                                yDrvDmaChannel_t channel,
+                                yDrvDmaRequest_t request,
+                                yDrvDmaDirection_t direction,
+                                volatile uint32_t *periph)
+{
+    yDrvDmaConfig_t dma_config = YDRV_DMA_CONFIG_DEFAULT();
+
+    dma_config.channel = channel;
+    dma_config.request = request;
+    dma_config.priority = config->dmaPriority;
+    dma_config.mode = YDRV_DMA_MODE_NORMAL;
+    dma_config.src_width = YDRV_DMA_WIDTH_8BIT;
+    dma_config.dst_width = YDRV_DMA_WIDTH_8BIT;
+    dma_config.src_inc = YDRV_DMA_INC_ENABLE;
+    dma_config.dst_inc = YDRV_DMA_INC_ENABLE;
+    dma_config.trans_len = 0;
+    dma_config.owner = "i2c";
+
+    if (yDrvDmaInitStatic(&dma_config, dma, direction) != YDRV_OK)
+    {
+        *dma = YDRV_DMA_HANDLE_DEFAULT();
+        return YDRV_BUSY;
+    }
+
+    // 数据寄存器按字节访问，外设地址不递增
+    LL_DMA_SetPeriphAddress(dma->DmaInfo.dma, dma->DmaInfo.channel, (uint32_t)periph);
+    LL_DMA_SetPeriphSize(dma->DmaInfo.dma, dma->DmaInfo.channel, LL_DMA_PDATAALIGN_BYTE);
+    LL_DMA_SetPeriphIncMode(dma->DmaInfo.dma, dma->DmaInfo.channel, LL_DMA_PERIPH_NOINCREMENT);
+
+    return YDRV_OK;
+}
+
+static void prv_DmaDeInit(yDrvDmaHandle_t *dma)
+{
+    if (dma->DmaInfo.dma != NULL)
+    {
+        yDrvDmaTransDisable(dma);
+        (void)yDrvDmaDeInitStatic(dma);
+        *dma = YDRV_DMA_HANDLE_DEFAULT();
+    }
+}
+
+static uint32_t prv_IsLastPhase(yDrvI2cHandle_t *handle)
+{
+    return ((handle->phase == YDRV_I2C_PHASE_READ) || (handle->rxLen == 0U)) ? 1U : 0U;
+}
+
+static void prv_StartPhase(yDrvI2cHandle_t *handle, uint8_t phase)
+{
+    I2C_TypeDef *i2c = handle->instance;
+    yDrvDmaHandle_t *dma;
+    uint32_t len, n, cr1, cr2;
+    void *buf;
+
+    handle->phase = phase;
+    if (phase == YDRV_I2C_PHASE_WRITE)
+    {
+        len = handle->txLen;
+        buf = (void *)handle->txBuf;
+        dma = &handle->txDma;
+        cr1 = I2C_CR1_TXDMAEN;
+        cr2 = 0;
+    }
+    else
+    {
+        len = handle->rxLen;
+        buf = handle->rxBuf;
+        dma = &handle->rxDma;
+        cr1 = I2C_CR1_RXDMAEN;
+        cr2 = I2C_CR2_RD_WRN;
+    }
+
+    n = (len > YDRV_I2C_NBYTES_MAX) ? YDRV_I2C_NBYTES_MAX : len;
+    handle->remain = len - n;
+
+    cr2 |= ((uint32_t)handle->addr << 1) | (n << I2C_CR2_NBYTES_Pos) | I2C_CR2_START;
+    if (handle->remain != 0U)
+    {
+        cr2 |= I2C_CR2_RELOAD;
+    }
+    else if (prv_IsLastPhase(handle))
+    {
+        cr2 |= I2C_CR2_AUTOEND;
+    }
+
+    // 长段走DMA，整段一次搬完；短段逐字节中断
+    handle->dmaOn = ((dma->DmaInfo.dma != NULL) && (len >= handle->dmaThreshold)) ? 1U : 0U;
+    if (handle->dmaOn)
+    {
+        yDrvDmaTransDisable(dma);
+        LL_DMA_SetMemoryAddress(dma->DmaInfo.dma, dma->DmaInfo.channel, (uint32_t)buf);
+        yDrvDmaDstBufferLen(dma, len);
+        yDrvDmaClearFlags(dma);
+        yDrvDmaTransEnable(dma);
+    }
+    else
+    {
+        cr1 = (phase == YDRV_I2C_PHASE_WRITE) ? I2C_CR1_TXIE : I2C_CR1_RXIE;
+    }
+
+    MODIFY_REG(i2c->CR1, YDRV_I2C_IT_ALL, YDRV_I2C_IT_XFER | cr1);
+    WRITE_REG(i2c->CR2, cr2);
+}
+
+static void prv_SoftReset(I2C_TypeDef *instance)
+{
+    CLEAR_BIT(instance->CR1, I2C_CR1_PE);
+    // PE需要保持清零至少3个APB周期，回读确认写入已完成
+    while (READ_BIT(instance->CR1, I2C_CR1_PE) != 0U)
+    {
+    }
+    (void)instance->CR1;
+    (void)instance->CR1;
+    SET_BIT(instance->CR1, I2C_CR1_PE);
+}
+
+static void prv_Halt(yDrvI2cHandle_t *handle)
+{
+    CLEAR_BIT(handle->instance->CR1, YDRV_I2C_IT_ALL);
+    if (handle->txDma.DmaInfo.dma != NULL)
+    {
+        yDrvDmaTransDisable(&handle->txDma);
+    }
+    if (handle->rxDma.DmaInfo.dma != NULL)
+    {
+        yDrvDmaTransDisable(&handle->rxDma);
+    }
+    prv_SoftReset(handle->instance);
+}
+
+static void prv_Finish(yDrvI2cHandle_t *handle, yDrvI2cResult_t result)
+{
+    I2C_TypeDef *i2c = handle->instance;
+
+    if (result == YDRV_I2C_RESULT_OK || result == YDRV_I2C_RESULT_NACK)
+    {
+        // 已经发出STOP，外设状态正常，只关中断和DMA请求
+        CLEAR_BIT(i2c->CR1, YDRV_I2C_IT_ALL);
+        if (handle->dmaOn)
+        {
+            yDrvDmaTransDisable((handle->phase == YDRV_I2C_PHASE_WRITE) ? &handle->txDma : &handle->rxDma);
+        }
+        WRITE_REG(i2c->CR2, 0);
+    }
+    else
+    {
+        prv_Halt(handle);
+    }
+
+    handle->result = (uint8_t)result;
+    handle->phase = YDRV_I2C_PHASE_IDLE;
+
+    if (handle->callback != NULL)
+    {
+        handle->callback(handle->arg, result);
+    }
+}
+
+static void prv_PinInit(yDrvI2cHandle_t *handle, const yDrvGpioInfo_t *info, uint32_t pull)
+{
+    LL_GPIO_InitTypeDef gpio_init;
+
+    gpio_init.Pin = info->pinMask;
+    gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
+    gpio_init.Speed = LL_GPIO_SPEED_FREQ_HIGH;
+    gpio_init.OutputType = LL_GPIO_OUTPUT_OPENDRAIN;
+    gpio_init.Pull = pull;
+    gpio_init.Alternate = handle->pinAF;
+    LL_GPIO_Init(info->port, &gpio_init);
+}
+
+static void prv_DelayUs(uint32_t us)
+{
+    volatile uint32_t loops = (SystemCoreClock / 4000000U + 1U) * us;
+
+    while (loops != 0U)
+    {
+        loops--;
+    }
+}
+
+static void prv_IrqHandler(yDrvI2cHandle_t *handle)
+{
+    I2C_TypeDef *i2c = handle->instance;
+    uint32_t isr = i2c->ISR;
+    uint32_t n, cr2;
+
+    if (handle->phase == YDRV_I2C_PHASE_IDLE)
+    {
+        CLEAR_BIT(i2c->CR1, YDRV_I2C_IT_ALL);
+        return;
+    }
+
+    // 1. 总线错误和仲裁丢失，不保证有STOP，立即复位结束
+    if ((isr & (I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR)) != 0U)
+    {
+        WRITE_REG(i2c->ICR, I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF);
+        prv_Finish(handle, ((isr & I2C_ISR_ARLO) != 0U) ? YDRV_I2C_RESULT_ARB_LOST : YDRV_I2C_RESULT_BUS_ERROR);
+        return;
+    }
+
+    // 2. 未应答，AUTOEND=0时补发STOP，在STOPF中结束
+    if ((isr & I2C_ISR_NACKF) != 0U)
+    {
+        WRITE_REG(i2c->ICR, I2C_ICR_NACKCF);
+        handle->result = YDRV_I2C_RESULT_NACK;
+        if (READ_BIT(i2c->CR2, I2C_CR2_AUTOEND) == 0U)
+        {
+            SET_BIT(i2c->CR2, I2C_CR2_STOP);
+        }
+        CLEAR_BIT(i2c->CR1, I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_TCIE);
+    }
+
+    // 3. 中断方式逐字节收发
+    if (((isr & I2C_ISR_TXIS) != 0U) && (READ_BIT(i2c->CR1, I2C_CR1_TXIE) != 0U))
+    {
+        i2c->TXDR = *handle->txBuf++;
+    }
+    if (((isr & I2C_ISR_RXNE) != 0U) && (READ_BIT(i2c->CR1, I2C_CR1_RXIE) != 0U))
+    {
+        *handle->rxBuf++ = (uint8_t)i2c->RXDR;
+    }
+
+    // 4. 分片结束，装入下一片
+    if (((isr & I2C_ISR_TCR) != 0U) && (READ_BIT(i2c->CR1, I2C_CR1_TCIE) != 0U))
+    {
+        n = (handle->remain > YDRV_I2C_NBYTES_MAX) ? YDRV_I2C_NBYTES_MAX : handle->remain;
+        handle->remain -= n;
+
+        cr2 = i2c->CR2 & ~(I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_AUTOEND | I2C_CR2_START);
+        cr2 |= n << I2C_CR2_NBYTES_Pos;
+        if (handle->remain != 0U)
+        {
+            cr2 |= I2C_CR2_RELOAD;
+        }
+        else if (prv_IsLastPhase(handle))
+        {
+            cr2 |= I2C_CR2_AUTOEND;
+        }
+        WRITE_REG(i2c->CR2, cr2);
+    }
+
+    // 5. 写段结束，重复起始进入读段
+    if (((isr & I2C_ISR_TC) != 0U) && (READ_BIT(i2c->CR1, I2C_CR1_TCIE) != 0U) &&
+        (handle->phase == YDRV_I2C_PHASE_WRITE))
+    {
+        if (handle->dmaOn)
+        {
+            yDrvDmaTransDisable(&handle->txDma);
+        }
+        prv_StartPhase(handle, YDRV_I2C_PHASE_READ);
+    }
+
+    // 6. STOP已发出，传输结束
+    if ((isr & I2C_ISR_STOPF) != 0U)
+    {
+        WRITE_REG(i2c->ICR, I2C_ICR_STOPCF);
+        prv_Finish(handle, (yDrvI2cResult_t)handle->result);
+    }
+}
+
+// ==================== 中断处理函数 ====================
+
+/**
+ * @brief I2C1中断处理函数
+ */
+void I2C1_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    if (i2c_handle[YDRV_I2C_1] != NULL)
+    {
+        prv_IrqHandler(i2c_handle[YDRV_I2C_1]);
+    }
+}
+
+/**
+ * @brief I2C2中断处理函数
+ */
+void I2C2_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    if (i2c_handle[YDRV_I2C_2] != NULL)
+    {
+        prv_IrqHandler(i2c_handle[YDRV_I2C_2]);
+    }
+}
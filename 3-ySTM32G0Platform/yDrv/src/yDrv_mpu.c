@@ -0,0 +1,167 @@
+/**
+ * @file yDrv_mpu.c
+ * @brief STM32G0 MPU驱动程序实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 区域寄存器值在设置时一次算好，任务切换只做寄存器写入，不在切换路径上计算大小和子区域
+ */
+
+#include "yDrv_mpu.h"
+
+// ==================== 私有定义 ====================
+
+/**
+ * @brief 访问权限对应的AP字段
+ * @note 任务以特权级运行，只读使用"特权和非特权均只读"编码
+ */
+static const uint32_t MPU_AP_MAP[] = {
+    0U << MPU_RASR_AP_Pos, /*!< 禁止访问 */
+    6U << MPU_RASR_AP_Pos, /*!< 只读 */
+    3U << MPU_RASR_AP_Pos, /*!< 读写 */
+};
+
+// ==================== 公共函数实现 ====================
+
+/**
+ * @brief 生成区域寄存器值
+ * @param region 输出的寄存器值
+ * @param number 区域编号
+ * @param base 起始地址
+ * @param size 长度
+ * @param access 访问权限
+ * @param attr 存储器属性
+ * @retval yDrvStatus_t 生成状态
+ * @note 从256字节起找第一个能容纳整个范围的对齐块，再检查范围是否落在子区域边界上
+ */
+yDrvStatus_t yDrvMpuRegionMake(yDrvMpuRegion_t *region, uint32_t number, uint32_t base, uint32_t size,
+                               yDrvMpuAccess_t access, uint32_t attr)
+{
+    uint32_t shift;
+    uint32_t start;
+    uint32_t enabled;
+    uint32_t rasr;
+
+    if ((region == NULL) || (number >= 8U) || (access > YDRV_MPU_READ_WRITE))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    region->rbar = MPU_RBAR_VALID_Msk | number;
+    region->rasr = 0;
+    if (size == 0U)
+    {
+        return YDRV_OK;
+    }
+
+    if (((base | size) & (YDRV_MPU_GUARD_SIZE - 1U)) != 0U || ((base + size) < base))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    for (shift = 8U; shift < 32U; shift++)
+    {
+        start = base & ~((1UL << shift) - 1U);
+        if ((base + size - start) <= (1UL << shift))
+        {
+            break;
+        }
+    }
+
+    // 子区域为对齐块的1/8
+    if ((shift >= 32U) || (((base - start) | size) & ((1UL << (shift - 3U)) - 1U)) != 0U)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+    enabled = ((1UL << (size >> (shift - 3U))) - 1U) << ((base - start) >> (shift - 3U));
+
+    rasr = MPU_RASR_ENABLE_Msk | ((shift - 1U) << MPU_RASR_SIZE_Pos) |
+           ((~enabled & 0xFFU) << MPU_RASR_SRD_Pos) | MPU_AP_MAP[access];
+    if ((attr & YDRV_MPU_ATTR_DEVICE) != 0U)
+    {
+        rasr |= MPU_RASR_S_Msk | MPU_RASR_B_Msk;
+    }
+    else
+    {
+        rasr |= MPU_RASR_C_Msk;
+    }
+    if ((attr & YDRV_MPU_ATTR_XN) != 0U)
+    {
+        rasr |= MPU_RASR_XN_Msk;
+    }
+
+    region->rbar = start | MPU_RBAR_VALID_Msk | number;
+    region->rasr = rasr;
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 生成堆栈保护区域
+ * @param region 输出的寄存器值
+ * @param stack 堆栈起始地址
+ * @param size 堆栈大小
+ * @retval yDrvStatus_t 生成状态
+ * @note 保护区之上至少保留一个保护区大小的可用堆栈
+ */
+yDrvStatus_t yDrvMpuGuardMake(yDrvMpuRegion_t *region, const void *stack, uint32_t size)
+{
+    uint32_t guard = ((uint32_t)stack + YDRV_MPU_GUARD_SIZE - 1U) & ~(YDRV_MPU_GUARD_SIZE - 1U);
+
+    if ((stack == NULL) || ((guard + 2U * YDRV_MPU_GUARD_SIZE) > ((uint32_t)stack + size)))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    return yDrvMpuRegionMake(region, YDRV_MPU_SET_BASE + YDRV_MPU_SET_GUARD, guard, YDRV_MPU_GUARD_SIZE,
+                             YDRV_MPU_READ_ONLY, YDRV_MPU_ATTR_XN);
+}
+
+/**
+ * @brief 把区域组清为全部关闭
+ * @param set 区域组
+ */
+void yDrvMpuSetClear(yDrvMpuSet_t *set)
+{
+    uint32_t i;
+
+    for (i = 0; i < YDRV_MPU_SET_REGIONS; i++)
+    {
+        set->region[i].rbar = MPU_RBAR_VALID_Msk | (YDRV_MPU_SET_BASE + i);
+        set->region[i].rasr = 0;
+    }
+}
+
+/**
+ * @brief 写入一个区域
+ * @param region 区域寄存器值
+ * @note 先关闭再写基址，避免新基址与旧属性组合出短暂的错误区域
+ */
+void yDrvMpuWrite(const yDrvMpuRegion_t *region)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    MPU->RNR = region->rbar & MPU_RBAR_REGION_Msk;
+    MPU->RASR = 0;
+    MPU->RBAR = region->rbar;
+    MPU->RASR = region->rasr;
+    __DSB();
+    __ISB();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 使能/关闭MPU
+ * @param enable 1使能，0关闭
+ */
+void yDrvMpuEnable(uint32_t enable)
+{
+    __DSB();
+    MPU->CTRL = (enable != 0U) ? (MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk) : 0U;
+    __DSB();
+    __ISB();
+}
@@ -18,18 +18,69 @@
 /* 包含的头文件 ----------------------------------------------------------------*/
 #include <string.h> // For memset
 #include "yDrv_spi.h"
+#include "yDrv_clock.h"
+#include "yLib_trace.h"
 
 /* 私有宏定义 ------------------------------------------------------------------*/
 
 /**
- * @brief SPI中断回调函数存储结构
- * @note 用于存储每个SPI实例的中断回调函数和标志
+ * @brief 中断传输发送领先接收的最大帧数
+ * @note 接收FIFO为32位，领先两帧在中断延迟下也不会溢出
  */
-// struct
-// {
-//     yDrvInterruptCallback_t callback[YDRV_SPI_EXTI_MAX]; /*!< 中断回调函数数组 */
-//     uint8_t flags[YDRV_SPI_EXTI_MAX];                    /*!< 中断标志数组 */
-// } exit_callback[YDRV_SPI_MAX];
+#define YDRV_SPI_IT_AHEAD (2U)
+
+/**
+ * @brief 轮询批量传输发送领先接收的最大字节数
+ * @note 与接收FIFO深度(4字节)相同，接收FIFO写满前发送端必然停下
+ */
+#define YDRV_SPI_PACK_AHEAD (4U)
+
+/**
+ * @brief 软件模拟SPI传输函数段属性
+ */
+#if YDRV_SPI_SOFT_RAM
+#define YDRV_SPI_SOFT_FUNC YLIB_RAMFUNC
+#else
+#define YDRV_SPI_SOFT_FUNC
+#endif
+
+/**
+ * @brief 软件模拟SPI单个位(前沿采样，CPHA=0)
+ * @note 先输出数据位，半周期后前沿采样，再半周期回到空闲电平
+ */
+#define YDRV_SPI_SOFT_BIT_CPHA0()                            \
+    do                                                       \
+    {                                                        \
+        mosi->BSRR = mosi_word >> ((out >> 3) & 0x10U);      \
+        out <<= 1;                                           \
+        prv_SoftDelay(delay);                                \
+        sck->BSRR = lead;                                    \
+        in = (in << 1) | ((miso->IDR & miso_mask) ? 1U : 0U); \
+        prv_SoftDelay(delay);                                \
+        sck->BSRR = trail;                                   \
+    } while (0)
+
+/**
+ * @brief 软件模拟SPI单个位(后沿采样，CPHA=1)
+ * @note 前沿输出数据位，半周期后后沿采样
+ */
+#define YDRV_SPI_SOFT_BIT_CPHA1()                            \
+    do                                                       \
+    {                                                        \
+        sck->BSRR = lead;                                    \
+        mosi->BSRR = mosi_word >> ((out >> 3) & 0x10U);      \
+        out <<= 1;                                           \
+        prv_SoftDelay(delay);                                \
+        sck->BSRR = trail;                                   \
+        in = (in << 1) | ((miso->IDR & miso_mask) ? 1U : 0U); \
+        prv_SoftDelay(delay);                                \
+    } while (0)
+
+/**
+ * @brief SPI中断传输句柄登记表
+ * @note 按SPI实例保存正在使用中断传输的句柄，供中断服务函数分发
+ */
+static yDrvSpiHandle_t *spi_it_handle[YDRV_SPI_MAX];
 
 static const uint32_t spi_data_width[] = {
     LL_SPI_DATAWIDTH_4BIT,  /*!< 4位数据宽度 */
@@ -84,12 +135,149 @@ static void yDrvSpiGetInstance(yDrvSpiId_t spiId,
  */
 static yDrvStatus_t prv_ConfigGpio(const yDrvSpiConfig_t *config, yDrvSpiHandle_t *handle);
 
+/**
+ * @brief 填写一个复用功能引脚配置项
+ * @param setup 配置项
+ * @param pin 引脚
+ * @param af 复用功能编号，YDRV_GPIO_AF_AUTO按signal查表
+ * @param signal 外设信号
+ * @param pull 上下拉
+ * @param info 输出引脚信息
+ * @retval uint32_t 固定为1，便于累加配置项数
+ */
+static uint32_t prv_AddPin(yDrvGpioPinSetup_t *setup, yDrvGpioPin_t pin, uint32_t af, uint32_t signal,
+                           uint32_t pull, yDrvGpioInfo_t *info);
+
 /**
  * @brief 反初始化SPI相关的GPIO引脚
  * @param handle SPI句柄指针
  */
 static void prv_DeInitGpio(yDrvSpiHandle_t *handle);
 
+/**
+ * @brief 结束SPI DMA传输
+ * @param handle SPI句柄指针
+ * @param status 传输结果
+ * @retval 无
+ * @note 关闭DMA通道和请求，等待发送FIFO排空后清空接收FIFO
+ */
+static void prv_DmaFinish(yDrvSpiHandle_t *handle, yDrvStatus_t status);
+
+/**
+ * @brief SPI DMA接收完成中断回调
+ * @param arg SPI句柄指针
+ * @note 全双工时接收完成晚于发送完成，以接收TC作为整次传输结束
+ */
+static void prv_DmaRxComplete(void *arg);
+
+/**
+ * @brief SPI DMA传输错误中断回调
+ * @param arg SPI句柄指针
+ */
+static void prv_DmaError(void *arg);
+
+/**
+ * @brief 装载一个DMA传输分段
+ * @param handle SPI句柄指针
+ * @param seg 分段描述符指针
+ * @retval 无
+ * @note 设置收发通道地址、长度和递增模式后先使能接收通道再使能发送通道
+ */
+static void prv_DmaArm(yDrvSpiHandle_t *handle, const yDrvSpiSeg_t *seg);
+
+/**
+ * @brief 结束SPI中断传输
+ * @param handle SPI句柄指针
+ * @param status 传输结果
+ * @retval 无
+ * @note 关闭RXNE/TXE中断并调用完成回调
+ */
+static void prv_ItFinish(yDrvSpiHandle_t *handle, yDrvStatus_t status);
+
+/**
+ * @brief SPI实例中断分发处理
+ * @param spiId SPI实例ID
+ * @note 读出接收FIFO中的帧，按领先窗口补充发送帧
+ */
+static void prv_SpiIrqHandler(yDrvSpiId_t spiId);
+
+/**
+ * @brief 初始化软件模拟SPI
+ * @param config SPI配置参数指针
+ * @param handle SPI句柄指针
+ * @retval yDrvStatus_t 初始化状态
+ * @note 仅支持主机、全双工、8位数据和软件片选；SCK/MOSI为推挽输出，MISO为上拉输入
+ */
+static yDrvStatus_t prv_SoftInit(const yDrvSpiConfig_t *config, yDrvSpiHandle_t *handle);
+
+/**
+ * @brief 设置软件模拟SPI时钟模式和速率
+ * @param handle SPI句柄指针
+ * @param polarity 时钟极性
+ * @param phase 时钟相位
+ * @param speed 速率等级
+ * @retval 无
+ * @note 分频系数2^(n+1)换算为半周期延时2^n-1次循环，LEVEL7不延时
+ */
+static void prv_SoftSetFormat(yDrvSpiHandle_t *handle,
+                              yDrvSpiClockPolarity_t polarity,
+                              yDrvSpiClockPhase_t phase,
+                              yDrvSpiSpeedLevel_t speed);
+
+/**
+ * @brief 软件模拟SPI半周期延时
+ * @param loops 延时循环次数
+ * @retval 无
+ */
+static inline void prv_SoftDelay(uint32_t loops);
+
+/**
+ * @brief 8位数据位序反转
+ * @param data 输入数据
+ * @retval uint8_t 反转后的数据
+ */
+static inline uint8_t prv_SoftReverse(uint8_t data);
+
+/**
+ * @brief 软件模拟SPI批量传输
+ * @param handle SPI句柄指针
+ * @param tx 发送缓冲区，NULL表示发送0xFF
+ * @param rx 接收缓冲区，NULL表示丢弃
+ * @param len 传输字节数
+ * @retval uint32_t 实际传输的字节数
+ * @note 每字节8位完全展开，位操作只有BSRR写入和IDR读取
+ */
+static uint32_t prv_SoftTransfer(yDrvSpiHandle_t *handle, const uint8_t *tx, uint8_t *rx, uint32_t len);
+
+/**
+ * @brief 按SCK上限选择分频
+ * @param pclk SPI内核时钟(Hz)
+ * @param sckHz SCK上限(Hz)
+ * @retval uint32_t BR字段值(0=2分频 ~ 7=256分频)，256分频仍超过上限时返回8
+ */
+static uint32_t prv_BrForSck(uint32_t pclk, uint32_t sckHz);
+
+/**
+ * @brief 系统时钟切换通知
+ * @note PRE确认总线空闲，POST按新频率选择不超过原SCK的分频
+ */
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg);
+
+/**
+ * @brief 各主机实例的SCK频率，按配置时的时钟和速率等级计算
+ */
+static struct
+{
+    SPI_TypeDef *instance; /*!< 已初始化的主机实例，NULL为未使用 */
+    uint32_t sckHz;        /*!< 配置的SCK频率(Hz) */
+    uint8_t suspended;     /*!< 外设时钟已关闭 */
+} spi_retime[YDRV_SPI_MAX];
+
+/**
+ * @brief 系统时钟切换通知，所有实例共用
+ */
+static yDrvClockNotifier_t spi_clock_notifier = {.callback = prv_ClockNotify};
+
 /* 公共函数实现 ----------------------------------------------------------------*/
 
 /**
@@ -115,6 +303,12 @@ yDrvStatus_t yDrvSpiInitStatic(yDrvSpiConfig_t *config, yDrvSpiHandle_t *handle)
 
     yDrvSpiHandleStructInit(handle);
 
+    // 软件模拟SPI不占用外设，由GPIO完成收发
+    if (config->spiId == YDRV_SPI_SOFT)
+    {
+        return prv_SoftInit(config, handle);
+    }
+
     // 1. 获取SPI实例
     yDrvSpiGetInstance(config->spiId, handle);
     if (handle->instance == NULL)
@@ -143,6 +337,11 @@ yDrvStatus_t yDrvSpiInitStatic(yDrvSpiConfig_t *config, yDrvSpiHandle_t *handle)
     spi_init.ClockPolarity = config->polarity;
     spi_init.ClockPhase = config->phase;
     spi_init.NSS = config->csMode;
+    if ((config->nssPulse != 0) &&
+        ((config->csMode != YDRV_SPI_CS_HARD_OUTPUT) || (config->phase != YDRV_SPI_PHASE_1EDGE)))
+    {
+        return YDRV_INVALID_PARAM; // NSS脉冲只在硬件NSS输出且CPHA=0时有效
+    }
     spi_init.BaudRate = config->speed;
     spi_init.BitOrder = config->bitOrder;
     if (config->crc != 0)
@@ -160,12 +359,49 @@ yDrvStatus_t yDrvSpiInitStatic(yDrvSpiConfig_t *config, yDrvSpiHandle_t *handle)
         return YDRV_ERROR;
     }
     handle->flagBtyeSend = (config->dataBits > 8) ? 1 : 0;
-    handle->flagCsControl = (config->csMode == YDRV_SPI_CS_SOFT) ? 1 : 0;
     LL_SPI_SetStandard(handle->instance, LL_SPI_PROTOCOL_MOTOROLA);
-    // LL_SPI_EnableNSSPulseMgt(handle->instance);
+    // 8位帧每收到一帧即产生RXNE，否则DMA请求要等FIFO满16位才发出
+    LL_SPI_SetRxFIFOThreshold(handle->instance,
+                              (config->dataBits > 8) ? LL_SPI_RX_FIFO_TH_HALF : LL_SPI_RX_FIFO_TH_QUARTER);
+
+    // 4. 选定片选策略
+    handle->csSetup = config->csSetup;
+    handle->csHold = config->csHold;
+    handle->csCtrl = YDRV_SPI_CS_CTRL_NONE;
+    if (config->mode == YDRV_SPI_MODE_MASTER)
+    {
+        if ((config->csMode == YDRV_SPI_CS_SOFT) && (handle->csPinInfo.flag != 0))
+        {
+            handle->csCtrl = YDRV_SPI_CS_CTRL_SOFT;
+        }
+        else if (config->csMode == YDRV_SPI_CS_HARD_OUTPUT)
+        {
+            handle->csCtrl = YDRV_SPI_CS_CTRL_HARD;
+        }
+    }
+    if (config->nssPulse != 0)
+    {
+        LL_SPI_EnableNSSPulseMgt(handle->instance);
+    }
+    else
+    {
+        LL_SPI_DisableNSSPulseMgt(handle->instance);
+    }
+
+    // 5. 使能SPI，硬件NSS输出时SPE即片选，保持关闭直到选中
+    if (handle->csCtrl != YDRV_SPI_CS_CTRL_HARD)
+    {
+        LL_SPI_Enable(handle->instance);
+    }
 
-    // 4. 使能SPI
-    LL_SPI_Enable(handle->instance);
+    // 6. 主机登记SCK频率，系统时钟切换后按它重选分频
+    if (config->mode == YDRV_SPI_MODE_MASTER)
+    {
+        spi_retime[config->spiId].instance = handle->instance;
+        spi_retime[config->spiId].sckHz = SystemCoreClock >> (((uint32_t)config->speed >> SPI_CR1_BR_Pos) + 1U);
+        spi_retime[config->spiId].suspended = 0;
+        yDrvClockRegister(&spi_clock_notifier);
+    }
 
     return YDRV_OK;
 }
@@ -181,6 +417,14 @@ yDrvStatus_t yDrvSpiInitStatic(yDrvSpiConfig_t *config, yDrvSpiHandle_t *handle)
  */
 yDrvStatus_t yDrvSpiDeInitStatic(yDrvSpiHandle_t *handle)
 {
+    // 软件模拟SPI只需释放引脚
+    if ((handle != NULL) && (handle->spiId == YDRV_SPI_SOFT) && (handle->soft.sckPort != NULL))
+    {
+        prv_DeInitGpio(handle);
+        handle->soft.sckPort = NULL;
+        return YDRV_OK;
+    }
+
     // 参数有效性检查
     if (handle == NULL || handle->instance == NULL)
     {
@@ -195,6 +439,171 @@ yDrvStatus_t yDrvSpiDeInitStatic(yDrvSpiHandle_t *handle)
 
     // 3. 禁用SPI外设时钟
     prv_DisableClock(handle->spiId);
+    spi_retime[handle->spiId].instance = NULL;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 修改SPI时钟模式和速率
+ * @param handle SPI句柄指针
+ * @param polarity 时钟极性
+ * @param phase 时钟相位
+ * @param speed 速率等级
+ * @retval yDrvStatus_t 操作状态
+ * @note 参考手册要求关闭SPI前发送FIFO为空且BSY为0
+ */
+yDrvStatus_t yDrvSpiSetFormat(yDrvSpiHandle_t *handle,
+                              yDrvSpiClockPolarity_t polarity,
+                              yDrvSpiClockPhase_t phase,
+                              yDrvSpiSpeedLevel_t speed)
+{
+    uint32_t enabled;
+
+    if ((handle != NULL) && (handle->spiId == YDRV_SPI_SOFT) && (handle->soft.sckPort != NULL))
+    {
+        prv_SoftSetFormat(handle, polarity, phase, speed);
+        return YDRV_OK;
+    }
+
+    if (yDrvSpiHandleIsValid(handle) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((handle->dma.busy != 0) || (handle->it.busy != 0))
+    {
+        return YDRV_BUSY;
+    }
+
+    // 1. 等待最后一帧发送完成
+    while (LL_SPI_GetTxFIFOLevel(handle->instance) != LL_SPI_TX_FIFO_EMPTY)
+    {
+    }
+    while (LL_SPI_IsActiveFlag_BSY(handle->instance) != 0)
+    {
+    }
+
+    // 2. 关闭SPI后修改时钟参数，硬件NSS输出时SPE即片选，保持原状态
+    enabled = LL_SPI_IsEnabled(handle->instance);
+    LL_SPI_Disable(handle->instance);
+    LL_SPI_SetClockPolarity(handle->instance, (uint32_t)polarity);
+    LL_SPI_SetClockPhase(handle->instance, (uint32_t)phase);
+    LL_SPI_SetBaudRatePrescaler(handle->instance, (uint32_t)speed);
+    spi_retime[handle->spiId].sckHz = SystemCoreClock >> (((uint32_t)speed >> SPI_CR1_BR_Pos) + 1U);
+
+    // 3. 清空接收FIFO中的残留数据后重新使能
+    while (LL_SPI_GetRxFIFOLevel(handle->instance) != LL_SPI_RX_FIFO_EMPTY)
+    {
+        (void)LL_SPI_ReceiveData8(handle->instance);
+    }
+    if (enabled != 0)
+    {
+        LL_SPI_Enable(handle->instance);
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 挂起SPI
+ * @param handle SPI句柄指针
+ * @retval yDrvStatus_t 操作状态
+ * @note 关闭时钟不复位寄存器，恢复时钟后无需重新配置
+ */
+yDrvStatus_t yDrvSpiSuspend(yDrvSpiHandle_t *handle)
+{
+    if ((handle != NULL) && (handle->spiId == YDRV_SPI_SOFT) && (handle->soft.sckPort != NULL))
+    {
+        return YDRV_OK;
+    }
+
+    if (yDrvSpiHandleIsValid(handle) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((handle->dma.busy != 0) || (handle->it.busy != 0))
+    {
+        return YDRV_BUSY;
+    }
+
+    // 等待最后一帧发送完成后再关闭时钟
+    while (LL_SPI_GetTxFIFOLevel(handle->instance) != LL_SPI_TX_FIFO_EMPTY)
+    {
+    }
+    while (LL_SPI_IsActiveFlag_BSY(handle->instance) != 0)
+    {
+    }
+
+    prv_DisableClock(handle->spiId);
+    spi_retime[handle->spiId].suspended = 1;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 恢复SPI
+ * @param handle SPI句柄指针
+ * @retval yDrvStatus_t 操作状态
+ */
+yDrvStatus_t yDrvSpiResume(yDrvSpiHandle_t *handle)
+{
+    if ((handle != NULL) && (handle->spiId == YDRV_SPI_SOFT) && (handle->soft.sckPort != NULL))
+    {
+        return YDRV_OK;
+    }
+
+    if (yDrvSpiHandleIsValid(handle) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    prv_EnableClock(handle->spiId);
+    spi_retime[handle->spiId].suspended = 0;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 复位SPI外设并恢复配置
+ * @param handle SPI句柄指针
+ * @retval yDrvStatus_t 操作状态
+ */
+yDrvStatus_t yDrvSpiFlush(yDrvSpiHandle_t *handle)
+{
+    uint32_t cr1;
+    uint32_t cr2;
+    uint32_t crcpr;
+
+    if (yDrvSpiHandleIsValid(handle) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 1. 保存配置，CR1最后写入以便SPE在其余配置就绪后才置位
+    cr1 = READ_REG(handle->instance->CR1);
+    cr2 = READ_REG(handle->instance->CR2);
+    crcpr = READ_REG(handle->instance->CRCPR);
+
+    // 2. RCC复位外设，收发FIFO随之清空
+    switch (handle->spiId)
+    {
+    case YDRV_SPI_1:
+        LL_APB2_GRP1_ForceReset(LL_APB2_GRP1_PERIPH_SPI1);
+        LL_APB2_GRP1_ReleaseReset(LL_APB2_GRP1_PERIPH_SPI1);
+        break;
+    case YDRV_SPI_2:
+        LL_APB1_GRP1_ForceReset(LL_APB1_GRP1_PERIPH_SPI2);
+        LL_APB1_GRP1_ReleaseReset(LL_APB1_GRP1_PERIPH_SPI2);
+        break;
+    default:
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    // 3. 恢复配置
+    WRITE_REG(handle->instance->CR1, cr1 & ~SPI_CR1_SPE);
+    WRITE_REG(handle->instance->CRCPR, crcpr);
+    WRITE_REG(handle->instance->CR2, cr2);
+    WRITE_REG(handle->instance->CR1, cr1);
+
     return YDRV_OK;
 }
 
@@ -221,10 +630,10 @@ void yDrvSpiConfigStructInit(yDrvSpiConfig_t *config)
     config->misoPin = YDRV_PINNULL;
     config->mosiPin = YDRV_PINNULL;
     config->csPin = YDRV_PINNULL;
-    config->sckAF = 0;
-    config->misoAF = 0;
-    config->mosiAF = 0;
-    config->csAF = 0;
+    config->sckAF = YDRV_GPIO_AF_AUTO;
+    config->misoAF = YDRV_GPIO_AF_AUTO;
+    config->mosiAF = YDRV_GPIO_AF_AUTO;
+    config->csAF = YDRV_GPIO_AF_AUTO;
     config->mode = LL_SPI_MODE_MASTER;
     config->direction = LL_SPI_FULL_DUPLEX;
     config->polarity = LL_SPI_POLARITY_LOW;
@@ -232,6 +641,9 @@ void yDrvSpiConfigStructInit(yDrvSpiConfig_t *config)
     config->csMode = LL_SPI_NSS_SOFT;
     config->speed = LL_SPI_BAUDRATEPRESCALER_DIV256;
     config->bitOrder = LL_SPI_MSB_FIRST;
+    config->nssPulse = 0;
+    config->csSetup = 0;
+    config->csHold = 0;
 }
 
 /**
@@ -252,6 +664,15 @@ void yDrvSpiHandleStructInit(yDrvSpiHandle_t *handle)
     handle->misoPinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
     handle->mosiPinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
     handle->csPinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
+    handle->csCtrl = YDRV_SPI_CS_CTRL_NONE;
+    handle->csSetup = 0;
+    handle->csHold = 0;
+
+    memset(&handle->dma, 0, sizeof(handle->dma));
+    memset(&handle->it, 0, sizeof(handle->it));
+    memset(&handle->soft, 0, sizeof(handle->soft));
+    handle->dma.rx = YDRV_DMA_HANDLE_DEFAULT();
+    handle->dma.tx = YDRV_DMA_HANDLE_DEFAULT();
 }
 
 /**
@@ -381,50 +802,843 @@ yDrvStatus_t yDrvSpiDmaRead(yDrvSpiHandle_t *handle, yDrvDmaChannel_t *channel)
     return YDRV_OK;
 }
 
-/* 私有函数实现 ----------------------------------------------------------------*/
-
 /**
- * @brief 获取SPI实例信息
- * @param spiId SPI实例ID
+ * @brief 配置SPI全双工DMA传输引擎
  * @param handle SPI句柄指针
- * @retval 无
- * @note 根据SPI ID填充句柄中的硬件实例信息
- *       - 设置SPI外设基地址指针
- *       - 配置对应的SPI实例ID
- *       - 支持STM32G0系列的SPI1和SPI2外设
+ * @param rxChannel 接收DMA通道，可为YDRV_DMA_CHANNEL_AUTO
+ * @param txChannel 发送DMA通道，可为YDRV_DMA_CHANNEL_AUTO
+ * @param prio DMA中断优先级
+ * @retval yDrvStatus_t 配置状态
+ * @note 配置流程：
+ *       1. 接收通道外设到内存，最高优先级，避免接收FIFO溢出
+ *       2. 发送通道内存到外设
+ *       3. 注册接收TC和收发TE中断
  */
-static void yDrvSpiGetInstance(yDrvSpiId_t spiId,
-                               yDrvSpiHandle_t *handle)
+yDrvStatus_t yDrvSpiDmaInit(yDrvSpiHandle_t *handle,
+                            yDrvDmaChannel_t rxChannel,
+                            yDrvDmaChannel_t txChannel,
+                            uint32_t prio)
 {
-    // 根据SPI ID返回对应的外设实例指针
-    handle->spiId = spiId;
-    switch (handle->spiId)
+    yDrvDmaConfig_t dma_config;
+    yDrvDmaExtiConfig_t exti_config;
+    yDrvDmaDataWidth_t width;
+
+    // 参数有效性检查
+    if ((yDrvSpiHandleIsValid(handle) != YDRV_OK) ||
+        ((rxChannel >= YDRV_DMA_CHANNEL_MAX) && (rxChannel != YDRV_DMA_CHANNEL_AUTO)) ||
+        ((txChannel >= YDRV_DMA_CHANNEL_MAX) && (txChannel != YDRV_DMA_CHANNEL_AUTO)) ||
+        ((rxChannel == txChannel) && (rxChannel != YDRV_DMA_CHANNEL_AUTO)))
     {
-    case YDRV_SPI_1:
-        handle->instance = SPI1;
-        handle->IRQ = SPI1_IRQn; // 设置SPI1的中断号
-        break;
-    case YDRV_SPI_2:
-        handle->instance = SPI2;
-        handle->IRQ = SPI2_IRQn; // 设置SPI2的中断号
-        break;
-    default:
-        handle->instance = NULL;
-        break;
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((handle->spiId != YDRV_SPI_1) && (handle->spiId != YDRV_SPI_2))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    width = (handle->flagBtyeSend != 0) ? YDRV_DMA_WIDTH_16BIT : YDRV_DMA_WIDTH_8BIT;
+    handle->dma.txDummy = 0xFFFF;
+
+    // 1. 接收通道
+    dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    dma_config.channel = rxChannel;
+    dma_config.request = (handle->spiId == YDRV_SPI_1) ? YDRV_DMA_REQ_SPI1_RX : YDRV_DMA_REQ_SPI2_RX;
+    dma_config.priority = YDRV_DMA_PRIORITY_VERY_HIGH;
+    dma_config.dst_width = width;
+    dma_config.dst_buffer = &handle->dma.rxDummy;
+    dma_config.trans_len = 0;
+    dma_config.owner = "spi rx";
+    if (yDrvDmaInitStatic(&dma_config, &handle->dma.rx, YDRV_DMA_DIR_P2M) != YDRV_OK)
+    {
+        return YDRV_ERROR;
+    }
+
+    // 2. 发送通道
+    dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    dma_config.channel = txChannel;
+    dma_config.request = (handle->spiId == YDRV_SPI_1) ? YDRV_DMA_REQ_SPI1_TX : YDRV_DMA_REQ_SPI2_TX;
+    dma_config.priority = YDRV_DMA_PRIORITY_HIGH;
+    dma_config.src_width = width;
+    dma_config.src_buffer = &handle->dma.txDummy;
+    dma_config.trans_len = 0;
+    dma_config.owner = "spi tx";
+    if (yDrvDmaInitStatic(&dma_config, &handle->dma.tx, YDRV_DMA_DIR_M2P) != YDRV_OK)
+    {
+        yDrvDmaDeInitStatic(&handle->dma.rx);
+        return YDRV_ERROR;
+    }
+
+    // 3. 注册中断
+    exti_config = YDRV_DMA_EXTI_CONFIG_DEFAULT();
+    exti_config.prio = prio;
+    exti_config.arg = handle;
+    exti_config.enable = 1;
+
+    exti_config.trigger = YDRV_DMA_EXTI_TC;
+    exti_config.function = prv_DmaRxComplete;
+    if (yDrvDmaRegisterCallback(&handle->dma.rx, &exti_config) != YDRV_OK)
+    {
+        yDrvSpiDmaDeInit(handle);
+        return YDRV_ERROR;
+    }
+
+    exti_config.trigger = YDRV_DMA_EXTI_TE;
+    exti_config.function = prv_DmaError;
+    if ((yDrvDmaRegisterCallback(&handle->dma.rx, &exti_config) != YDRV_OK) ||
+        (yDrvDmaRegisterCallback(&handle->dma.tx, &exti_config) != YDRV_OK))
+    {
+        yDrvSpiDmaDeInit(handle);
+        return YDRV_ERROR;
     }
+
+    handle->dma.busy = 0;
+    handle->dma.status = YDRV_OK;
+    handle->dma.flagReady = 1;
+    return YDRV_OK;
 }
 
 /**
- * @brief 使能SPI外设时钟
- * @param spiId SPI外设ID
- * @note 根据SPI ID使能对应的RCC时钟
+ * @brief 释放SPI DMA传输引擎
+ * @param handle SPI句柄指针
+ * @retval yDrvStatus_t 操作状态
+ * @note 未完成的传输被中止，不调用完成回调
  */
-static void prv_EnableClock(yDrvSpiId_t spiId)
+yDrvStatus_t yDrvSpiDmaDeInit(yDrvSpiHandle_t *handle)
 {
-    switch (spiId)
+    if (yDrvSpiHandleIsValid(handle) != YDRV_OK)
     {
-    case YDRV_SPI_1:
-        LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_SPI1);
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->dma.busy != 0)
+    {
+        (void)yDrvSpiTransferDmaAbort(handle);
+    }
+
+    if (handle->dma.rx.DmaInfo.dma != NULL)
+    {
+        yDrvDmaUnregisterCallback(&handle->dma.rx, YDRV_DMA_EXTI_TC);
+        yDrvDmaUnregisterCallback(&handle->dma.rx, YDRV_DMA_EXTI_TE);
+        yDrvDmaDeInitStatic(&handle->dma.rx);
+    }
+    if (handle->dma.tx.DmaInfo.dma != NULL)
+    {
+        yDrvDmaUnregisterCallback(&handle->dma.tx, YDRV_DMA_EXTI_TE);
+        yDrvDmaDeInitStatic(&handle->dma.tx);
+    }
+    yDrvSpiDmaStop(handle);
+
+    handle->dma.rx = YDRV_DMA_HANDLE_DEFAULT();
+    handle->dma.tx = YDRV_DMA_HANDLE_DEFAULT();
+    handle->dma.flagReady = 0;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 启动SPI全双工DMA传输
+ * @param handle SPI句柄指针
+ * @param tx 发送缓冲区，NULL表示发送填充数据
+ * @param rx 接收缓冲区，NULL表示丢弃接收数据
+ * @param len 传输字节数
+ * @param callback 完成回调，NULL表示阻塞等待
+ * @param arg 完成回调参数
+ * @retval yDrvStatus_t 操作状态
+ * @note 以单段描述符调用分段DMA传输
+ */
+yDrvStatus_t yDrvSpiTransferDma(yDrvSpiHandle_t *handle,
+                                const void *tx,
+                                void *rx,
+                                uint32_t len,
+                                yDrvSpiDmaCallback_t callback,
+                                void *arg)
+{
+    // 参数有效性检查
+    if (yDrvSpiHandleIsValid(handle) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->dma.busy != 0)
+    {
+        return YDRV_BUSY;
+    }
+
+    // 单段传输使用句柄内部描述符
+    handle->dma.single.tx = tx;
+    handle->dma.single.rx = rx;
+    handle->dma.single.len = len;
+
+    return yDrvSpiTransferDmaSg(handle, &handle->dma.single, 1, callback, arg);
+}
+
+/**
+ * @brief 启动SPI分段DMA传输
+ * @param handle SPI句柄指针
+ * @param seg 分段描述符数组
+ * @param count 分段数量
+ * @param callback 完成回调
+ * @param arg 完成回调参数
+ * @retval yDrvStatus_t 操作状态
+ */
+yDrvStatus_t yDrvSpiTransferDmaSg(yDrvSpiHandle_t *handle,
+                                  const yDrvSpiSeg_t *seg,
+                                  uint32_t count,
+                                  yDrvSpiDmaCallback_t callback,
+                                  void *arg)
+{
+    uint32_t frames;
+    uint32_t start;
+    uint32_t i;
+
+    // 参数有效性检查
+    if ((yDrvSpiHandleIsValid(handle) != YDRV_OK) || (seg == NULL) || (count == 0))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->dma.flagReady == 0)
+    {
+        return YDRV_NOT_INITIALIZED;
+    }
+
+    if ((handle->dma.busy != 0) || (handle->it.busy != 0))
+    {
+        return YDRV_BUSY;
+    }
+
+    // 硬件NSS时SPE随片选打开，未选中时与轮询传输一样拒绝
+    if (LL_SPI_IsEnabled(handle->instance) == 0)
+    {
+        return YDRV_ERROR;
+    }
+
+    // 每段长度都须可由一次DMA完成
+    for (i = 0; i < count; i++)
+    {
+        frames = (handle->flagBtyeSend != 0) ? (seg[i].len / 2U) : seg[i].len;
+        if ((frames == 0) || (frames > 0xFFFFU) ||
+            ((handle->flagBtyeSend != 0) && ((seg[i].len & 1U) != 0)))
+        {
+            return YDRV_INVALID_PARAM;
+        }
+    }
+
+    // 1. 关闭通道，清除残留标志和接收FIFO中的旧数据
+    yDrvDmaTransDisable(&handle->dma.rx);
+    yDrvDmaTransDisable(&handle->dma.tx);
+    while (LL_SPI_GetRxFIFOLevel(handle->instance) != LL_SPI_RX_FIFO_EMPTY)
+    {
+        (void)LL_SPI_ReceiveData8(handle->instance);
+    }
+
+    handle->dma.callback = callback;
+    handle->dma.arg = arg;
+    handle->dma.seg = seg;
+    handle->dma.segCount = count;
+    handle->dma.segIndex = 0;
+    handle->dma.status = YDRV_OK;
+    handle->dma.busy = 1;
+
+    // 2. 配置外设地址和请求后装载第一段，后续分段在接收完成中断中装载
+    yDrvSpiDmaRead(handle, &handle->dma.rx.index);
+    yDrvSpiDmaWrite(handle, &handle->dma.tx.index);
+    prv_DmaArm(handle, &seg[0]);
+
+    // 3. 阻塞模式等待中断中结束传输，超时则中止
+    if (callback == NULL)
+    {
+        start = yDrvGetTimeMs();
+        while (handle->dma.busy != 0)
+        {
+            if ((yDrvGetTimeMs() - start) > YDRV_SPI_DMA_TIMEOUT_MS)
+            {
+                (void)yDrvSpiTransferDmaAbort(handle);
+                return YDRV_TIMEOUT;
+            }
+        }
+        return (yDrvStatus_t)handle->dma.status;
+    }
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 中止SPI DMA传输
+ * @param handle SPI句柄指针
+ * @retval uint32_t 尚未接收的字节数
+ */
+uint32_t yDrvSpiTransferDmaAbort(yDrvSpiHandle_t *handle)
+{
+    uint32_t remain;
+    uint32_t i;
+
+    if ((yDrvSpiHandleIsValid(handle) != YDRV_OK) || (handle->dma.busy == 0))
+    {
+        return 0;
+    }
+
+    yDrvDisableIrq();
+    remain = 0;
+    if (handle->dma.busy != 0)
+    {
+        // 当前分段剩余帧数加上未开始分段的帧数
+        remain = yDrvDmaCurLenGet(&handle->dma.rx);
+        for (i = handle->dma.segIndex + 1U; i < handle->dma.segCount; i++)
+        {
+            remain += (handle->flagBtyeSend != 0) ? (handle->dma.seg[i].len / 2U) : handle->dma.seg[i].len;
+        }
+        handle->dma.callback = NULL;
+        prv_DmaFinish(handle, YDRV_TIMEOUT);
+    }
+    yDrvEnableIrq();
+
+    return (handle->flagBtyeSend != 0) ? (remain * 2U) : remain;
+}
+
+/**
+ * @brief 注册SPI中断传输
+ * @param handle SPI句柄指针
+ * @param prio SPI中断优先级
+ * @retval yDrvStatus_t 注册状态
+ */
+yDrvStatus_t yDrvSpiItInit(yDrvSpiHandle_t *handle, uint32_t prio)
+{
+    if ((yDrvSpiHandleIsValid(handle) != YDRV_OK) || (handle->spiId >= YDRV_SPI_MAX))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((spi_it_handle[handle->spiId] != NULL) && (spi_it_handle[handle->spiId] != handle))
+    {
+        return YDRV_BUSY;
+    }
+
+    LL_SPI_DisableIT_RXNE(handle->instance);
+    LL_SPI_DisableIT_TXE(handle->instance);
+    memset(&handle->it, 0, sizeof(handle->it));
+    spi_it_handle[handle->spiId] = handle;
+
+    yDrvIrqSetPriority(handle->IRQ, prio);
+    NVIC_EnableIRQ(handle->IRQ);
+
+    handle->it.flagReady = 1;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 注销SPI中断传输
+ * @param handle SPI句柄指针
+ * @retval yDrvStatus_t 操作状态
+ */
+yDrvStatus_t yDrvSpiItDeInit(yDrvSpiHandle_t *handle)
+{
+    if ((yDrvSpiHandleIsValid(handle) != YDRV_OK) || (handle->spiId >= YDRV_SPI_MAX))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    (void)yDrvSpiTransferItAbort(handle);
+    NVIC_DisableIRQ(handle->IRQ);
+    if (spi_it_handle[handle->spiId] == handle)
+    {
+        spi_it_handle[handle->spiId] = NULL;
+    }
+    handle->it.flagReady = 0;
+    return YDRV_OK;
+}
+
+/**
+ * @brief 启动SPI中断驱动传输
+ * @param handle SPI句柄指针
+ * @param tx 发送缓冲区
+ * @param rx 接收缓冲区
+ * @param len 传输字节数
+ * @param callback 完成回调
+ * @param arg 完成回调参数
+ * @retval yDrvStatus_t 操作状态
+ * @note 先使能RXNE中断再使能TXE中断，TXE中断立即触发并发出首帧
+ */
+yDrvStatus_t yDrvSpiTransferIt(yDrvSpiHandle_t *handle,
+                               const void *tx,
+                               void *rx,
+                               uint32_t len,
+                               yDrvSpiDmaCallback_t callback,
+                               void *arg)
+{
+    uint32_t frames;
+
+    if (yDrvSpiHandleIsValid(handle) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->it.flagReady == 0)
+    {
+        return YDRV_NOT_INITIALIZED;
+    }
+
+    if ((handle->it.busy != 0) || (handle->dma.busy != 0))
+    {
+        return YDRV_BUSY;
+    }
+
+    // 硬件NSS时SPE随片选打开，未选中时与轮询传输一样拒绝
+    if (LL_SPI_IsEnabled(handle->instance) == 0)
+    {
+        return YDRV_ERROR;
+    }
+
+    frames = (handle->flagBtyeSend != 0) ? (len / 2U) : len;
+    if ((frames == 0) || ((handle->flagBtyeSend != 0) && ((len & 1U) != 0)))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 清空接收FIFO中的旧数据
+    while (LL_SPI_GetRxFIFOLevel(handle->instance) != LL_SPI_RX_FIFO_EMPTY)
+    {
+        (void)LL_SPI_ReceiveData8(handle->instance);
+    }
+    LL_SPI_ClearFlag_OVR(handle->instance);
+
+    handle->it.tx = (const uint8_t *)tx;
+    handle->it.rx = (uint8_t *)rx;
+    handle->it.txRemain = frames;
+    handle->it.rxRemain = frames;
+    handle->it.callback = callback;
+    handle->it.arg = arg;
+    handle->it.status = YDRV_OK;
+    handle->it.busy = 1;
+
+    LL_SPI_EnableIT_RXNE(handle->instance);
+    LL_SPI_EnableIT_TXE(handle->instance);
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 中止SPI中断传输
+ * @param handle SPI句柄指针
+ * @retval uint32_t 尚未接收的字节数
+ */
+uint32_t yDrvSpiTransferItAbort(yDrvSpiHandle_t *handle)
+{
+    uint32_t remain;
+
+    if ((yDrvSpiHandleIsValid(handle) != YDRV_OK) || (handle->it.busy == 0))
+    {
+        return 0;
+    }
+
+    yDrvDisableIrq();
+    remain = (handle->it.busy != 0) ? handle->it.rxRemain : 0;
+    if (handle->it.busy != 0)
+    {
+        handle->it.callback = NULL;
+        prv_ItFinish(handle, YDRV_TIMEOUT);
+    }
+    yDrvEnableIrq();
+
+    return (handle->flagBtyeSend != 0) ? (remain * 2U) : remain;
+}
+
+/**
+ * @brief SPI轮询批量传输实现
+ * @param handle SPI句柄指针
+ * @param tx 发送缓冲区
+ * @param rx 接收缓冲区
+ * @param len 传输字节数
+ * @retval uint32_t 实际传输的字节数
+ */
+YLIB_RAMFUNC uint32_t yDrvSpiTransferPolled(yDrvSpiHandle_t *handle, const void *tx, void *rx, uint32_t len)
+{
+    __IO uint16_t *dr16;
+    const uint8_t *tx_buff;
+    uint8_t *rx_buff;
+    uint32_t tx_index;
+    uint32_t rx_index;
+    uint16_t frame;
+
+    if ((handle != NULL) && (handle->spiId == YDRV_SPI_SOFT) && (handle->soft.sckPort != NULL))
+    {
+        return prv_SoftTransfer(handle, (const uint8_t *)tx, (uint8_t *)rx, len);
+    }
+
+    if ((yDrvSpiHandleIsValid(handle) != YDRV_OK) ||
+        (LL_SPI_IsEnabled(handle->instance) == 0) ||
+        (handle->it.busy != 0) || (handle->dma.busy != 0))
+    {
+        return 0;
+    }
+
+    if ((handle->flagBtyeSend != 0) && ((len & 1U) != 0))
+    {
+        len--;
+    }
+
+    dr16 = (__IO uint16_t *)&handle->instance->DR;
+    tx_buff = (const uint8_t *)tx;
+    rx_buff = (uint8_t *)rx;
+    tx_index = 0;
+    rx_index = 0;
+
+    // 1. 16位帧：每次访问一帧
+    if (handle->flagBtyeSend != 0)
+    {
+        while (rx_index < len)
+        {
+            if ((tx_index < len) && ((tx_index - rx_index) < YDRV_SPI_PACK_AHEAD) &&
+                (LL_SPI_IsActiveFlag_TXE(handle->instance) != 0))
+            {
+                frame = (tx_buff != NULL) ? (uint16_t)(tx_buff[tx_index] | ((uint16_t)tx_buff[tx_index + 1] << 8)) : 0xFFFFU;
+                *dr16 = frame;
+                tx_index += 2;
+            }
+            if (LL_SPI_IsActiveFlag_RXNE(handle->instance) != 0)
+            {
+                frame = *dr16;
+                if (rx_buff != NULL)
+                {
+                    rx_buff[rx_index] = (uint8_t)frame;
+                    rx_buff[rx_index + 1] = (uint8_t)(frame >> 8);
+                }
+                rx_index += 2;
+            }
+        }
+        return len;
+    }
+
+    // 2. 8位帧：成对打包访问，接收阈值设为半满，RXNE表示至少两帧
+    LL_SPI_SetRxFIFOThreshold(handle->instance, LL_SPI_RX_FIFO_TH_HALF);
+    while (rx_index < len)
+    {
+        if ((tx_index < len) && (LL_SPI_IsActiveFlag_TXE(handle->instance) != 0))
+        {
+            if (((len - tx_index) >= 2U) && ((tx_index - rx_index) <= (YDRV_SPI_PACK_AHEAD - 2U)))
+            {
+                frame = (tx_buff != NULL) ? (uint16_t)(tx_buff[tx_index] | ((uint16_t)tx_buff[tx_index + 1] << 8)) : 0xFFFFU;
+                *dr16 = frame;
+                tx_index += 2;
+            }
+            else if (((len - tx_index) == 1U) && ((tx_index - rx_index) < YDRV_SPI_PACK_AHEAD))
+            {
+                LL_SPI_TransmitData8(handle->instance, (tx_buff != NULL) ? tx_buff[tx_index] : 0xFFU);
+                tx_index++;
+            }
+        }
+
+        // 只剩最后一帧时阈值改回1/4，否则RXNE不会置位
+        if ((len - rx_index) == 1U)
+        {
+            LL_SPI_SetRxFIFOThreshold(handle->instance, LL_SPI_RX_FIFO_TH_QUARTER);
+        }
+
+        if (LL_SPI_IsActiveFlag_RXNE(handle->instance) != 0)
+        {
+            if ((len - rx_index) >= 2U)
+            {
+                frame = *dr16;
+                if (rx_buff != NULL)
+                {
+                    rx_buff[rx_index] = (uint8_t)frame;
+                    rx_buff[rx_index + 1] = (uint8_t)(frame >> 8);
+                }
+                rx_index += 2;
+            }
+            else
+            {
+                frame = LL_SPI_ReceiveData8(handle->instance);
+                if (rx_buff != NULL)
+                {
+                    rx_buff[rx_index] = (uint8_t)frame;
+                }
+                rx_index++;
+            }
+        }
+    }
+    LL_SPI_SetRxFIFOThreshold(handle->instance, LL_SPI_RX_FIFO_TH_QUARTER);
+
+    return len;
+}
+
+/* 私有函数实现 ----------------------------------------------------------------*/
+
+/**
+ * @brief 结束SPI中断传输
+ * @param handle SPI句柄指针
+ * @param status 传输结果
+ */
+static void prv_ItFinish(yDrvSpiHandle_t *handle, yDrvStatus_t status)
+{
+    yDrvSpiDmaCallback_t callback;
+
+    LL_SPI_DisableIT_TXE(handle->instance);
+    LL_SPI_DisableIT_RXNE(handle->instance);
+
+    callback = handle->it.callback;
+    handle->it.callback = NULL;
+    handle->it.status = (uint8_t)status;
+    handle->it.busy = 0;
+
+    if (callback != NULL)
+    {
+        callback(handle->it.arg, status);
+    }
+}
+
+/**
+ * @brief SPI实例中断分发处理
+ * @param spiId SPI实例ID
+ */
+YLIB_RAMFUNC static void prv_SpiIrqHandler(yDrvSpiId_t spiId)
+{
+    yDrvSpiHandle_t *handle = spi_it_handle[spiId];
+    yDrvSpiIt_t *it;
+    uint16_t frame;
+
+    if ((handle == NULL) || (handle->it.busy == 0))
+    {
+        if (handle != NULL)
+        {
+            LL_SPI_DisableIT_TXE(handle->instance);
+            LL_SPI_DisableIT_RXNE(handle->instance);
+        }
+        return;
+    }
+    it = &handle->it;
+
+    // 接收溢出时数据已丢失，直接结束
+    if (LL_SPI_IsActiveFlag_OVR(handle->instance) != 0)
+    {
+        LL_SPI_ClearFlag_OVR(handle->instance);
+        prv_ItFinish(handle, YDRV_OVERFLOW);
+        return;
+    }
+
+    // 1. 读出已接收的帧
+    while ((it->rxRemain > 0) && (LL_SPI_IsActiveFlag_RXNE(handle->instance) != 0))
+    {
+        if (handle->flagBtyeSend == 0)
+        {
+            frame = LL_SPI_ReceiveData8(handle->instance);
+            if (it->rx != NULL)
+            {
+                *it->rx++ = (uint8_t)frame;
+            }
+        }
+        else
+        {
+            frame = LL_SPI_ReceiveData16(handle->instance);
+            if (it->rx != NULL)
+            {
+                *it->rx++ = (uint8_t)frame;
+                *it->rx++ = (uint8_t)(frame >> 8);
+            }
+        }
+        it->rxRemain--;
+    }
+
+    // 2. 在领先窗口内补充发送帧
+    while ((it->txRemain > 0) &&
+           ((it->rxRemain - it->txRemain) < YDRV_SPI_IT_AHEAD) &&
+           (LL_SPI_IsActiveFlag_TXE(handle->instance) != 0))
+    {
+        if (handle->flagBtyeSend == 0)
+        {
+            LL_SPI_TransmitData8(handle->instance, (it->tx != NULL) ? *it->tx++ : 0xFFU);
+        }
+        else
+        {
+            frame = 0xFFFFU;
+            if (it->tx != NULL)
+            {
+                frame = (uint16_t)(it->tx[0] | ((uint16_t)it->tx[1] << 8));
+                it->tx += 2;
+            }
+            LL_SPI_TransmitData16(handle->instance, frame);
+        }
+        it->txRemain--;
+    }
+
+    // 3. 发送完毕或窗口已满时关闭TXE中断，由RXNE中断推进
+    if ((it->txRemain == 0) || ((it->rxRemain - it->txRemain) >= YDRV_SPI_IT_AHEAD))
+    {
+        LL_SPI_DisableIT_TXE(handle->instance);
+    }
+    else
+    {
+        LL_SPI_EnableIT_TXE(handle->instance);
+    }
+
+    if (it->rxRemain == 0)
+    {
+        prv_ItFinish(handle, YDRV_OK);
+    }
+}
+
+/**
+ * @brief 结束SPI DMA传输
+ * @param handle SPI句柄指针
+ * @param status 传输结果
+ * @note 先关通道再等待移位完成，最后读空接收FIFO，保证下一次传输从干净状态开始
+ */
+static void prv_DmaFinish(yDrvSpiHandle_t *handle, yDrvStatus_t status)
+{
+    yDrvSpiDmaCallback_t callback;
+    uint32_t guard;
+
+    yDrvDmaTransDisable(&handle->dma.tx);
+    yDrvDmaTransDisable(&handle->dma.rx);
+
+    // 等待发送FIFO排空且总线空闲，guard防止异常时死等
+    for (guard = 0xFFFFU;
+         (guard > 0) &&
+         ((LL_SPI_GetTxFIFOLevel(handle->instance) != LL_SPI_TX_FIFO_EMPTY) ||
+          (LL_SPI_IsActiveFlag_BSY(handle->instance) != 0));
+         guard--)
+    {
+    }
+
+    yDrvSpiDmaStop(handle);
+    while (LL_SPI_GetRxFIFOLevel(handle->instance) != LL_SPI_RX_FIFO_EMPTY)
+    {
+        (void)LL_SPI_ReceiveData8(handle->instance);
+    }
+
+    callback = handle->dma.callback;
+    handle->dma.callback = NULL;
+    handle->dma.status = (uint8_t)status;
+    handle->dma.busy = 0;
+
+    if (callback != NULL)
+    {
+        callback(handle->dma.arg, status);
+    }
+}
+
+/**
+ * @brief SPI DMA接收完成中断回调
+ * @param arg SPI句柄指针
+ */
+static void prv_DmaRxComplete(void *arg)
+{
+    yDrvSpiHandle_t *handle = (yDrvSpiHandle_t *)arg;
+
+    if (handle->dma.busy == 0)
+    {
+        return;
+    }
+
+    // 还有分段时立即装载下一段，SPI DMA请求保持使能
+    if ((handle->dma.segIndex + 1U) < handle->dma.segCount)
+    {
+        handle->dma.segIndex++;
+        prv_DmaArm(handle, &handle->dma.seg[handle->dma.segIndex]);
+        return;
+    }
+
+    prv_DmaFinish(handle, YDRV_OK);
+}
+
+/**
+ * @brief 装载一个DMA传输分段
+ * @param handle SPI句柄指针
+ * @param seg 分段描述符指针
+ */
+static void prv_DmaArm(yDrvSpiHandle_t *handle, const yDrvSpiSeg_t *seg)
+{
+    yDrvDmaDataWidth_t width;
+    uint32_t frames;
+
+    width = (handle->flagBtyeSend != 0) ? YDRV_DMA_WIDTH_16BIT : YDRV_DMA_WIDTH_8BIT;
+    frames = (handle->flagBtyeSend != 0) ? (seg->len / 2U) : seg->len;
+
+    yDrvDmaTransDisable(&handle->dma.rx);
+    yDrvDmaTransDisable(&handle->dma.tx);
+    yDrvDmaClearFlags(&handle->dma.rx);
+    yDrvDmaClearFlags(&handle->dma.tx);
+
+    // NULL缓冲区使用固定地址不递增，设置了写入目标时接收数据直接写入该地址
+    LL_DMA_SetMemoryIncMode(handle->dma.rx.DmaInfo.dma, handle->dma.rx.DmaInfo.channel,
+                            (seg->rx != NULL) ? LL_DMA_MEMORY_INCREMENT : LL_DMA_MEMORY_NOINCREMENT);
+    yDrvDmaDstBufferSet(&handle->dma.rx,
+                        (seg->rx != NULL)                ? seg->rx
+                        : (handle->dma.rxSink != NULL) ? handle->dma.rxSink
+                                                         : (void *)&handle->dma.rxDummy,
+                        width);
+    yDrvDmaDstBufferLen(&handle->dma.rx, frames);
+    LL_DMA_SetPeriphSize(handle->dma.rx.DmaInfo.dma, handle->dma.rx.DmaInfo.channel, width);
+
+    LL_DMA_SetMemoryIncMode(handle->dma.tx.DmaInfo.dma, handle->dma.tx.DmaInfo.channel,
+                            (seg->tx != NULL) ? LL_DMA_MEMORY_INCREMENT : LL_DMA_MEMORY_NOINCREMENT);
+    yDrvDmaDstBufferSet(&handle->dma.tx, (seg->tx != NULL) ? (void *)seg->tx : (void *)&handle->dma.txDummy, width);
+    yDrvDmaDstBufferLen(&handle->dma.tx, frames);
+    LL_DMA_SetPeriphSize(handle->dma.tx.DmaInfo.dma, handle->dma.tx.DmaInfo.channel, width);
+
+    handle->dma.frames = frames;
+
+    // 先接收后发送，保证第一帧数据不会丢失
+    yDrvDmaTransEnable(&handle->dma.rx);
+    yDrvDmaTransEnable(&handle->dma.tx);
+}
+
+/**
+ * @brief SPI DMA传输错误中断回调
+ * @param arg SPI句柄指针
+ */
+static void prv_DmaError(void *arg)
+{
+    yDrvSpiHandle_t *handle = (yDrvSpiHandle_t *)arg;
+
+    if (handle->dma.busy != 0)
+    {
+        prv_DmaFinish(handle, YDRV_ERROR);
+    }
+}
+
+/**
+ * @brief 获取SPI实例信息
+ * @param spiId SPI实例ID
+ * @param handle SPI句柄指针
+ * @retval 无
+ * @note 根据SPI ID填充句柄中的硬件实例信息
+ *       - 设置SPI外设基地址指针
+ *       - 配置对应的SPI实例ID
+ *       - 支持STM32G0系列的SPI1和SPI2外设
+ */
+static void yDrvSpiGetInstance(yDrvSpiId_t spiId,
+                               yDrvSpiHandle_t *handle)
+{
+    // 根据SPI ID返回对应的外设实例指针
+    handle->spiId = spiId;
+    switch (handle->spiId)
+    {
+    case YDRV_SPI_1:
+        handle->instance = SPI1;
+        handle->IRQ = SPI1_IRQn; // 设置SPI1的中断号
+        break;
+    case YDRV_SPI_2:
+        handle->instance = SPI2;
+        handle->IRQ = SPI2_IRQn; // 设置SPI2的中断号
+        break;
+    default:
+        handle->instance = NULL;
+        break;
+    }
+}
+
+/**
+ * @brief 使能SPI外设时钟
+ * @param spiId SPI外设ID
+ * @note 根据SPI ID使能对应的RCC时钟
+ */
+static void prv_EnableClock(yDrvSpiId_t spiId)
+{
+    switch (spiId)
+    {
+    case YDRV_SPI_1:
+        LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_SPI1);
         break;
     case YDRV_SPI_2:
         LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_SPI2);
@@ -454,6 +1668,25 @@ static void prv_DisableClock(yDrvSpiId_t spiId)
     }
 }
 
+/**
+ * @brief 填写一个复用功能引脚配置项实现
+ */
+static uint32_t prv_AddPin(yDrvGpioPinSetup_t *setup, yDrvGpioPin_t pin, uint32_t af, uint32_t signal,
+                           uint32_t pull, yDrvGpioInfo_t *info)
+{
+    setup->pin = pin;
+    setup->mode = LL_GPIO_MODE_ALTERNATE;
+    setup->speed = LL_GPIO_SPEED_FREQ_HIGH;
+    setup->outputType = LL_GPIO_OUTPUT_PUSHPULL;
+    setup->pull = (uint8_t)pull;
+    setup->af = (uint8_t)af;
+    setup->signal = (uint8_t)signal;
+    setup->preset = 0;
+    setup->info = info;
+
+    return 1;
+}
+
 /**
  * @brief 配置SPI相关的GPIO引脚
  * @param config SPI配置参数指针
@@ -463,116 +1696,262 @@ static void prv_DisableClock(yDrvSpiId_t spiId)
  */
 static yDrvStatus_t prv_ConfigGpio(const yDrvSpiConfig_t *config, yDrvSpiHandle_t *handle)
 {
-    yDrvStatus_t status;
-    LL_GPIO_InitTypeDef gpio_init;
+    yDrvGpioPinSetup_t setup[4];
+    uint32_t sig = (config->spiId == YDRV_SPI_2) ? YDRV_GPIO_SIG_SPI2_SCK : YDRV_GPIO_SIG_SPI1_SCK;
+    uint32_t count = 0;
 
-    // 配置SCK引脚：复用功能、推挽输出、高速
+    // SCK引脚：复用功能、推挽输出、高速
     if (config->sckPin != YDRV_PINNULL)
     {
-        status = yDrvParseGpio(config->sckPin, &handle->sckPinInfo);
-        if (status != YDRV_OK)
-        {
-            return YDRV_INVALID_PARAM;
-        }
-
-        gpio_init.Pin = handle->sckPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
-        gpio_init.Speed = LL_GPIO_SPEED_FREQ_HIGH;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_NO;
-        gpio_init.Alternate = config->sckAF;
-
-        // 配置SCK引脚为复用功能模式
-        LL_GPIO_Init(handle->sckPinInfo.port, &gpio_init);
-        handle->sckPinInfo.flag = 1;
+        count += prv_AddPin(&setup[count], config->sckPin, config->sckAF, sig + 0U,
+                            LL_GPIO_PULL_NO, &handle->sckPinInfo);
     }
 
-    // 配置MISO引脚：复用功能（仅在全双工或接收模式下配置）
+    // MISO引脚：仅在全双工或接收模式下配置
     if ((config->direction == LL_SPI_FULL_DUPLEX) ||
         (config->direction == LL_SPI_SIMPLEX_RX) ||
         (config->direction == LL_SPI_HALF_DUPLEX_RX))
     {
-        status = yDrvParseGpio(config->misoPin, &handle->misoPinInfo);
-        if (status != YDRV_OK)
-        {
-            return YDRV_INVALID_PARAM;
-        }
-
-        gpio_init.Pin = handle->misoPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
-        gpio_init.Speed = LL_GPIO_SPEED_FREQ_HIGH;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_NO;
-        gpio_init.Alternate = config->misoAF;
-
-        // 配置MISO引脚为复用功能模式
-        LL_GPIO_Init(handle->misoPinInfo.port, &gpio_init);
-        handle->misoPinInfo.flag = 1;
+        count += prv_AddPin(&setup[count], config->misoPin, config->misoAF, sig + 1U,
+                            LL_GPIO_PULL_NO, &handle->misoPinInfo);
     }
 
-    // 配置MOSI引脚：复用功能（仅在全双工或发送模式下配置）
+    // MOSI引脚：仅在全双工或发送模式下配置
     if ((config->direction == LL_SPI_FULL_DUPLEX) ||
         (config->direction == LL_SPI_HALF_DUPLEX_TX))
     {
-        status = yDrvParseGpio(config->mosiPin, &handle->mosiPinInfo);
-        if (status != YDRV_OK)
-        {
-            return YDRV_INVALID_PARAM;
-        }
+        count += prv_AddPin(&setup[count], config->mosiPin, config->mosiAF, sig + 2U,
+                            LL_GPIO_PULL_NO, &handle->mosiPinInfo);
+    }
 
-        gpio_init.Pin = handle->mosiPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
-        gpio_init.Speed = LL_GPIO_SPEED_FREQ_HIGH;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_NO;
-        gpio_init.Alternate = config->mosiAF;
+    // NSS引脚：硬件NSS为复用功能；软件片选为推挽输出，先置高避免切换模式时误选中，未配置时跳过
+    if (config->csMode != LL_SPI_NSS_SOFT)
+    {
+        count += prv_AddPin(&setup[count], config->csPin, config->csAF, sig + 3U,
+                            LL_GPIO_PULL_UP, &handle->csPinInfo);
+    }
+    else if (yDrvIsGpioValid(config->csPin) == 1)
+    {
+        (void)prv_AddPin(&setup[count], config->csPin, 0, 0, LL_GPIO_PULL_UP, &handle->csPinInfo);
+        setup[count].mode = LL_GPIO_MODE_OUTPUT;
+        setup[count].preset = 2;
+        count++;
+    }
 
-        // 配置MOSI引脚为复用功能模式
-        LL_GPIO_Init(handle->mosiPinInfo.port, &gpio_init);
-        handle->mosiPinInfo.flag = 1;
+    if (count == 0U)
+    {
+        return YDRV_OK;
     }
 
-    // 配置NSS引脚：仅在硬件NSS模式下配置
-    if (config->csMode != LL_SPI_NSS_SOFT)
+    // 同一端口的模式和复用寄存器只改写一次
+    return (yDrvGpioSetupPins(setup, count) == YDRV_OK) ? YDRV_OK : YDRV_INVALID_PARAM;
+}
+
+/**
+ * @brief 初始化软件模拟SPI实现
+ * @param config SPI配置参数指针
+ * @param handle SPI句柄指针
+ * @retval yDrvStatus_t 初始化状态
+ */
+static yDrvStatus_t prv_SoftInit(const yDrvSpiConfig_t *config, yDrvSpiHandle_t *handle)
+{
+    LL_GPIO_InitTypeDef gpio_init;
+
+    if ((config->mode != YDRV_SPI_MODE_MASTER) ||
+        (config->direction != YDRV_SPI_DIR_2LINES_FULL_DUPLEX) ||
+        (config->dataBits != 8) || (config->crc != 0) ||
+        (config->csMode != YDRV_SPI_CS_SOFT) || (config->nssPulse != 0))
     {
-        status = yDrvParseGpio(config->csPin, &handle->csPinInfo);
-        if (status != YDRV_OK)
-        {
-            return YDRV_INVALID_PARAM;
-        }
+        return YDRV_INVALID_PARAM;
+    }
+
+    handle->spiId = YDRV_SPI_SOFT;
+    if ((yDrvParseGpio(config->sckPin, &handle->sckPinInfo) != YDRV_OK) ||
+        (yDrvParseGpio(config->mosiPin, &handle->mosiPinInfo) != YDRV_OK))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 1. SCK和MOSI配置为推挽输出，SCK先置为空闲电平
+    LL_GPIO_StructInit(&gpio_init);
+    gpio_init.Mode = LL_GPIO_MODE_OUTPUT;
+    gpio_init.Speed = LL_GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
+    gpio_init.Pull = LL_GPIO_PULL_NO;
+
+    handle->soft.sckPort = handle->sckPinInfo.port;
+    handle->soft.mosiPort = handle->mosiPinInfo.port;
+    handle->soft.mosiWord = (uint32_t)handle->mosiPinInfo.pinMask << 16;
+    handle->soft.lsbFirst = (config->bitOrder == YDRV_SPI_BITORDER_LSB) ? 1 : 0;
+    prv_SoftSetFormat(handle, config->polarity, config->phase, config->speed);
+
+    gpio_init.Pin = handle->sckPinInfo.pinMask;
+    LL_GPIO_Init(handle->sckPinInfo.port, &gpio_init);
+    handle->sckPinInfo.flag = 1;
+
+    gpio_init.Pin = handle->mosiPinInfo.pinMask;
+    LL_GPIO_Init(handle->mosiPinInfo.port, &gpio_init);
+    handle->mosiPinInfo.flag = 1;
+
+    // 2. MISO可选，未配置时读取恒为0，传输循环内不需要判断
+    handle->soft.misoPort = handle->sckPinInfo.port;
+    handle->soft.misoMask = 0;
+    if (yDrvParseGpio(config->misoPin, &handle->misoPinInfo) == YDRV_OK)
+    {
+        gpio_init.Pin = handle->misoPinInfo.pinMask;
+        gpio_init.Mode = LL_GPIO_MODE_INPUT;
+        gpio_init.Pull = LL_GPIO_PULL_UP;
+        LL_GPIO_Init(handle->misoPinInfo.port, &gpio_init);
+        handle->misoPinInfo.flag = 1;
+        handle->soft.misoPort = handle->misoPinInfo.port;
+        handle->soft.misoMask = handle->misoPinInfo.pinMask;
+    }
 
+    // 3. 软件片选复用硬件SPI的GPIO片选路径
+    if (yDrvParseGpio(config->csPin, &handle->csPinInfo) == YDRV_OK)
+    {
         gpio_init.Pin = handle->csPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
+        gpio_init.Mode = LL_GPIO_MODE_OUTPUT;
         gpio_init.Speed = LL_GPIO_SPEED_FREQ_HIGH;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_UP; // NSS通常需要上拉
-        gpio_init.Alternate = config->csAF;
-
-        // 配置NSS引脚为复用功能模式
+        gpio_init.Pull = LL_GPIO_PULL_UP;
+        LL_GPIO_SetOutputPin(handle->csPinInfo.port, handle->csPinInfo.pinMask);
         LL_GPIO_Init(handle->csPinInfo.port, &gpio_init);
         handle->csPinInfo.flag = 1;
+        handle->csCtrl = YDRV_SPI_CS_CTRL_SOFT;
+    }
+    handle->csSetup = config->csSetup;
+    handle->csHold = config->csHold;
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 设置软件模拟SPI时钟模式和速率实现
+ * @param handle SPI句柄指针
+ * @param polarity 时钟极性
+ * @param phase 时钟相位
+ * @param speed 速率等级
+ * @retval 无
+ */
+static void prv_SoftSetFormat(yDrvSpiHandle_t *handle,
+                              yDrvSpiClockPolarity_t polarity,
+                              yDrvSpiClockPhase_t phase,
+                              yDrvSpiSpeedLevel_t speed)
+{
+    uint32_t sck_mask;
+
+    // 前沿从空闲电平翻转，后沿回到空闲电平
+    sck_mask = handle->sckPinInfo.pinMask;
+    if (polarity == YDRV_SPI_POLARITY_LOW)
+    {
+        handle->soft.sckLead = sck_mask;
+        handle->soft.sckTrail = sck_mask << 16;
     }
     else
     {
-        status = yDrvParseGpio(config->csPin, &handle->csPinInfo);
-        if (status != YDRV_OK)
+        handle->soft.sckLead = sck_mask << 16;
+        handle->soft.sckTrail = sck_mask;
+    }
+    handle->soft.cpha = (phase == YDRV_SPI_PHASE_2EDGE) ? 1 : 0;
+
+    // BR位域n对应2^(n+1)分频，LEVEL7(DIV2)全速运行
+    handle->soft.delay = (uint8_t)((1U << (((uint32_t)speed & SPI_CR1_BR) >> SPI_CR1_BR_Pos)) - 1U);
+
+    handle->soft.sckPort->BSRR = handle->soft.sckTrail;
+}
+
+/**
+ * @brief 软件模拟SPI半周期延时实现
+ * @param loops 延时循环次数
+ * @retval 无
+ */
+static inline void prv_SoftDelay(uint32_t loops)
+{
+    while (loops != 0)
+    {
+        __NOP();
+        loops--;
+    }
+}
+
+/**
+ * @brief 8位数据位序反转实现
+ * @param data 输入数据
+ * @retval uint8_t 反转后的数据
+ */
+static inline uint8_t prv_SoftReverse(uint8_t data)
+{
+    data = (uint8_t)(((data & 0xF0U) >> 4) | ((data & 0x0FU) << 4));
+    data = (uint8_t)(((data & 0xCCU) >> 2) | ((data & 0x33U) << 2));
+    data = (uint8_t)(((data & 0xAAU) >> 1) | ((data & 0x55U) << 1));
+    return data;
+}
+
+/**
+ * @brief 软件模拟SPI批量传输实现
+ * @param handle SPI句柄指针
+ * @param tx 发送缓冲区
+ * @param rx 接收缓冲区
+ * @param len 传输字节数
+ * @retval uint32_t 实际传输的字节数
+ */
+YDRV_SPI_SOFT_FUNC static uint32_t prv_SoftTransfer(yDrvSpiHandle_t *handle,
+                                                   const uint8_t *tx,
+                                                   uint8_t *rx,
+                                                   uint32_t len)
+{
+    GPIO_TypeDef *sck = handle->soft.sckPort;
+    GPIO_TypeDef *mosi = handle->soft.mosiPort;
+    GPIO_TypeDef *miso = handle->soft.misoPort;
+    const uint32_t lead = handle->soft.sckLead;
+    const uint32_t trail = handle->soft.sckTrail;
+    const uint32_t mosi_word = handle->soft.mosiWord;
+    const uint32_t miso_mask = handle->soft.misoMask;
+    const uint32_t delay = handle->soft.delay;
+    uint32_t out;
+    uint32_t in;
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        out = (tx != NULL) ? tx[i] : 0xFFU;
+        if (handle->soft.lsbFirst != 0)
         {
-            return YDRV_OK;
+            out = prv_SoftReverse((uint8_t)out);
         }
+        in = 0;
 
-        gpio_init.Pin = handle->csPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
-        gpio_init.Speed = LL_GPIO_SPEED_FREQ_HIGH;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_UP; // CS通常需要上拉
-        gpio_init.Alternate = 0;
+        // 每字节8位完全展开，当前位总在bit7，右移3位取0x10决定MOSI写置位还是复位
+        if (handle->soft.cpha == 0)
+        {
+            YDRV_SPI_SOFT_BIT_CPHA0();
+            YDRV_SPI_SOFT_BIT_CPHA0();
+            YDRV_SPI_SOFT_BIT_CPHA0();
+            YDRV_SPI_SOFT_BIT_CPHA0();
+            YDRV_SPI_SOFT_BIT_CPHA0();
+            YDRV_SPI_SOFT_BIT_CPHA0();
+            YDRV_SPI_SOFT_BIT_CPHA0();
+            YDRV_SPI_SOFT_BIT_CPHA0();
+        }
+        else
+        {
+            YDRV_SPI_SOFT_BIT_CPHA1();
+            YDRV_SPI_SOFT_BIT_CPHA1();
+            YDRV_SPI_SOFT_BIT_CPHA1();
+            YDRV_SPI_SOFT_BIT_CPHA1();
+            YDRV_SPI_SOFT_BIT_CPHA1();
+            YDRV_SPI_SOFT_BIT_CPHA1();
+            YDRV_SPI_SOFT_BIT_CPHA1();
+            YDRV_SPI_SOFT_BIT_CPHA1();
+        }
 
-        // 配置NSS引脚为复用功能模式
-        LL_GPIO_Init(handle->csPinInfo.port, &gpio_init);
-        handle->csPinInfo.flag = 1;
+        if (rx != NULL)
+        {
+            rx[i] = (handle->soft.lsbFirst != 0) ? prv_SoftReverse((uint8_t)in) : (uint8_t)in;
+        }
     }
 
-    return YDRV_OK;
+    return len;
 }
 
 /**
@@ -629,3 +2008,96 @@ static void prv_DeInitGpio(yDrvSpiHandle_t *handle)
         handle->csPinInfo.flag = 0;
     }
 }
+
+/* 中断服务函数 ----------------------------------------------------------------*/
+
+/**
+ * @brief SPI1中断服务函数
+ */
+YLIB_RAMFUNC void SPI1_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    prv_SpiIrqHandler(YDRV_SPI_1);
+}
+
+/**
+ * @brief SPI2中断服务函数
+ */
+YLIB_RAMFUNC void SPI2_IRQHandler(void)
+{
+    YLIB_TRACE_ISR();
+    prv_SpiIrqHandler(YDRV_SPI_2);
+}
+
+/**
+ * @brief 按SCK上限选择分频实现
+ */
+static uint32_t prv_BrForSck(uint32_t pclk, uint32_t sckHz)
+{
+    uint32_t br = 0;
+
+    while ((br < 8U) && ((pclk >> (br + 1U)) > sckHz))
+    {
+        br++;
+    }
+    return br;
+}
+
+/**
+ * @brief 系统时钟切换通知实现
+ * @note APB不分频，SPI内核时钟即SYSCLK；降频后达不到原SCK时取2分频；
+ *       只改BR不切换SPE，硬件NSS输出时片选上不会产生脉冲
+ */
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg)
+{
+    SPI_TypeDef *spi;
+    uint32_t id;
+    uint32_t br;
+
+    (void)oldHz;
+    (void)arg;
+
+    for (id = YDRV_SPI_1; id < YDRV_SPI_MAX; id++)
+    {
+        spi = spi_retime[id].instance;
+        if (spi == NULL)
+        {
+            continue;
+        }
+
+        br = prv_BrForSck(newHz, spi_retime[id].sckHz);
+        if (event == YDRV_CLOCK_PRE)
+        {
+            // 256分频仍超过原SCK，或者正在传输
+            if (br > 7U)
+            {
+                return YDRV_BUSY;
+            }
+            if ((spi_retime[id].suspended == 0) &&
+                (((spi_it_handle[id] != NULL) && (spi_it_handle[id]->it.busy != 0)) ||
+                 (LL_SPI_IsActiveFlag_BSY(spi) != 0) ||
+                 (LL_SPI_GetTxFIFOLevel(spi) != LL_SPI_TX_FIFO_EMPTY)))
+            {
+                return YDRV_BUSY;
+            }
+        }
+        else if (event == YDRV_CLOCK_POST)
+        {
+            if (br > 7U)
+            {
+                br = 7U;
+            }
+            if (spi_retime[id].suspended != 0)
+            {
+                prv_EnableClock((yDrvSpiId_t)id);
+            }
+            LL_SPI_SetBaudRatePrescaler(spi, br << SPI_CR1_BR_Pos);
+            if (spi_retime[id].suspended != 0)
+            {
+                prv_DisableClock((yDrvSpiId_t)id);
+            }
+        }
+    }
+
+    return YDRV_OK;
+}
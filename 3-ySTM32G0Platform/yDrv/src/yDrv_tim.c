@@ -0,0 +1,921 @@
+/**
+ * @file yDrv_tim.c
+ * @brief STM32G0 通用定时器驱动程序实现
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 实现定时器单通道的PWM输出、输入捕获和单脉冲模式，以及DMA突发输出和捕获DMA
+ *
+ * @par 实现说明:
+ * - 突发输出以TIMx_UP为DMA请求，外设地址为DMAR，DCR决定每次更新写入哪些寄存器
+ * - 捕获DMA以TIMx_CHy为DMA请求，外设地址为CCRx
+ * - 只有配置了回调时才注册DMA中断，循环模式下无回调的传输全程没有中断
+ * - 系统时钟切换后按初始化时的计数频率重算预分频，周期和比较值不变
+ */
+
+#include <string.h> // For memset
+#include "yDrv_tim.h"
+#include "yDrv_clock.h"
+#include "stm32g0xx_ll_rcc.h"
+
+// ==================== 私有定义 ====================
+
+/**
+ * @brief 表示该定时器通道没有DMA请求
+ */
+#define YDRV_TIM_DMA_REQ_NONE (LL_DMAMUX_REQ_MEM2MEM)
+
+/**
+ * @brief 定时器实例表
+ */
+static TIM_TypeDef *const tim_instance[YDRV_TIM_MAX] = {
+    [YDRV_TIM_1] = TIM1,
+    [YDRV_TIM_3] = TIM3,
+    [YDRV_TIM_14] = TIM14,
+#if defined(TIM15)
+    [YDRV_TIM_15] = TIM15,
+#endif
+    [YDRV_TIM_16] = TIM16,
+};
+
+/**
+ * @brief 各定时器的通道数
+ */
+static const uint8_t tim_channel_num[YDRV_TIM_MAX] = {
+    [YDRV_TIM_1] = 4,
+    [YDRV_TIM_3] = 4,
+    [YDRV_TIM_14] = 1,
+    [YDRV_TIM_15] = 2,
+    [YDRV_TIM_16] = 1,
+};
+
+/**
+ * @brief 各定时器的更新事件DMA请求
+ */
+static const uint32_t tim_dma_up[YDRV_TIM_MAX] = {
+    [YDRV_TIM_1] = LL_DMAMUX_REQ_TIM1_UP,
+    [YDRV_TIM_3] = LL_DMAMUX_REQ_TIM3_UP,
+    [YDRV_TIM_14] = YDRV_TIM_DMA_REQ_NONE,
+#if defined(TIM15)
+    [YDRV_TIM_15] = LL_DMAMUX_REQ_TIM15_UP,
+#endif
+    [YDRV_TIM_16] = LL_DMAMUX_REQ_TIM16_UP,
+};
+
+/**
+ * @brief 各定时器重复计数器决定的单次脉冲串最大脉冲数，0表示没有重复计数器
+ * @note TIM1的RCR为16位，TIM15/TIM16为8位；DMA单次传输不超过65535
+ */
+static const uint32_t tim_rep_max[YDRV_TIM_MAX] = {
+    [YDRV_TIM_1] = 0xFFFFU,
+    [YDRV_TIM_3] = 0,
+    [YDRV_TIM_14] = 0,
+    [YDRV_TIM_15] = 0x100U,
+    [YDRV_TIM_16] = 0x100U,
+};
+
+/**
+ * @brief 各定时器通道的捕获/比较DMA请求
+ */
+static const uint32_t tim_dma_cc[YDRV_TIM_MAX][YDRV_TIM_CH_MAX] = {
+    [YDRV_TIM_1] = {LL_DMAMUX_REQ_TIM1_CH1, LL_DMAMUX_REQ_TIM1_CH2,
+                    LL_DMAMUX_REQ_TIM1_CH3, LL_DMAMUX_REQ_TIM1_CH4},
+    [YDRV_TIM_3] = {LL_DMAMUX_REQ_TIM3_CH1, LL_DMAMUX_REQ_TIM3_CH2,
+                    LL_DMAMUX_REQ_TIM3_CH3, LL_DMAMUX_REQ_TIM3_CH4},
+    [YDRV_TIM_14] = {YDRV_TIM_DMA_REQ_NONE},
+#if defined(TIM15)
+    [YDRV_TIM_15] = {LL_DMAMUX_REQ_TIM15_CH1, LL_DMAMUX_REQ_TIM15_CH2},
+#endif
+    [YDRV_TIM_16] = {LL_DMAMUX_REQ_TIM16_CH1},
+};
+
+/**
+ * @brief 通道编号到LL库通道编码
+ */
+static const uint32_t tim_ll_channel[YDRV_TIM_CH_MAX] = {
+    LL_TIM_CHANNEL_CH1,
+    LL_TIM_CHANNEL_CH2,
+    LL_TIM_CHANNEL_CH3,
+    LL_TIM_CHANNEL_CH4,
+};
+
+// ==================== 私有函数声明 ====================
+
+/**
+ * @brief 使能/禁用指定定时器的时钟
+ * @param timId 定时器实例ID
+ * @param enable 1=使能，0=禁用
+ * @retval 无
+ */
+static void prv_ClockCtrl(yDrvTimId_t timId, uint32_t enable);
+
+/**
+ * @brief 获取定时器内核时钟频率
+ * @retval uint32_t 时钟频率(Hz)
+ * @note APB不分频时等于HCLK，分频时为PCLK的两倍
+ */
+static uint32_t prv_GetClockFreq(void);
+
+/**
+ * @brief 系统时钟切换通知
+ * @note PRE确认新时钟能整数分频得到原计数频率，POST重写预分频
+ */
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg);
+
+/**
+ * @brief 各定时器的计数频率，0为未使用
+ */
+static uint32_t tim_tick_hz[YDRV_TIM_MAX];
+
+/**
+ * @brief 系统时钟切换通知，所有定时器共用
+ */
+static yDrvClockNotifier_t tim_clock_notifier = {.callback = prv_ClockNotify};
+
+/**
+ * @brief 配置通道引脚
+ * @param config 配置参数指针
+ * @param handle 句柄指针
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t prv_ConfigGpio(const yDrvTimConfig_t *config, yDrvTimHandle_t *handle);
+
+/**
+ * @brief 启动定时器DMA通道
+ * @param handle 句柄指针
+ * @param request DMAMUX请求
+ * @param direction 传输方向
+ * @param periph 外设寄存器地址
+ * @param buffer 存储器缓冲区
+ * @param len 传输数据项数
+ * @param width 数据项位宽，定时器寄存器为半字
+ * @retval yDrvStatus_t 操作状态
+ */
+static yDrvStatus_t prv_DmaStart(yDrvTimHandle_t *handle,
+                                 uint32_t request,
+                                 yDrvDmaDirection_t direction,
+                                 volatile void *periph,
+                                 void *buffer,
+                                 uint32_t len,
+                                 yDrvDmaDataWidth_t width);
+
+/**
+ * @brief DMA传输完成中断回调
+ * @param arg 定时器句柄指针
+ */
+static void prv_DmaTc(void *arg);
+
+/**
+ * @brief DMA半传输中断回调
+ * @param arg 定时器句柄指针
+ */
+static void prv_DmaHt(void *arg);
+
+/**
+ * @brief DMA传输错误中断回调
+ * @param arg 定时器句柄指针
+ */
+static void prv_DmaTe(void *arg);
+
+// ==================== 基础函数实现 ====================
+
+yDrvStatus_t yDrvTimInitStatic(const yDrvTimConfig_t *config, yDrvTimHandle_t *handle)
+{
+    LL_TIM_InitTypeDef tim_init;
+    LL_TIM_OC_InitTypeDef oc_init;
+    LL_TIM_IC_InitTypeDef ic_init;
+    TIM_TypeDef *tim;
+    uint32_t clock;
+    uint32_t psc;
+    uint32_t reload;
+
+    // 参数有效性检查
+    if (handle == NULL || config == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    yDrvTimHandleStructInit(handle);
+
+    if ((config->timId >= YDRV_TIM_MAX) || (tim_instance[config->timId] == NULL) ||
+        (config->channel >= tim_channel_num[config->timId]) || (config->tickHz == 0U))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 1. 计算预分频和重装载值
+    clock = prv_GetClockFreq();
+    psc = clock / config->tickHz;
+    if ((psc == 0U) || (psc > 0x10000U))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    switch (config->mode)
+    {
+    case YDRV_TIM_MODE_PWM:
+        reload = config->period;
+        break;
+    case YDRV_TIM_MODE_CAPTURE:
+        reload = 0x10000U; // 16位自由运行，捕获差值直接按16位回绕计算
+        break;
+    case YDRV_TIM_MODE_ONE_PULSE:
+        if ((config->delay == 0U) || (config->pulse == 0U))
+        {
+            return YDRV_INVALID_PARAM;
+        }
+        reload = config->delay + config->pulse;
+        break;
+    default:
+        return YDRV_INVALID_PARAM;
+    }
+    if ((reload == 0U) || (reload > 0x10000U))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    tim = tim_instance[config->timId];
+    handle->instance = tim;
+    handle->timId = (uint8_t)config->timId;
+    handle->channel = (uint8_t)config->channel;
+    handle->mode = (uint8_t)config->mode;
+    handle->llChannel = tim_ll_channel[config->channel];
+    handle->ccr = &tim->CCR1 + config->channel; // CCR1~CCR4地址连续
+    handle->tickHz = clock / psc;
+    handle->dmaConfig = config->dma;
+
+    prv_ClockCtrl(config->timId, 1);
+
+    // 2. 时基，LL_TIM_Init产生更新事件装载预分频器，清除该事件标志
+    LL_TIM_StructInit(&tim_init);
+    tim_init.Prescaler = (uint16_t)(psc - 1U);
+    tim_init.CounterMode = LL_TIM_COUNTERMODE_UP;
+    tim_init.Autoreload = reload - 1U;
+    tim_init.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1;
+    tim_init.RepetitionCounter = 0;
+    LL_TIM_Init(tim, &tim_init);
+    LL_TIM_ClearFlag_UPDATE(tim);
+
+    // 3. 通道
+    switch (config->mode)
+    {
+    case YDRV_TIM_MODE_PWM:
+        LL_TIM_OC_StructInit(&oc_init);
+        oc_init.OCMode = LL_TIM_OCMODE_PWM1;
+        oc_init.OCState = LL_TIM_OCSTATE_DISABLE; // 启动时再使能
+        oc_init.CompareValue = config->pulse;
+        oc_init.OCPolarity = config->polarity;
+        LL_TIM_OC_Init(tim, handle->llChannel, &oc_init);
+        // 预装载保证周期和比较值在更新事件成对生效，突发DMA每组值恰好持续一个周期
+        LL_TIM_OC_EnablePreload(tim, handle->llChannel);
+        LL_TIM_EnableARRPreload(tim);
+        break;
+
+    case YDRV_TIM_MODE_ONE_PULSE:
+        // PWM2：计数值小于CCR时无效，之后有效直到更新事件停止计数
+        LL_TIM_OC_StructInit(&oc_init);
+        oc_init.OCMode = LL_TIM_OCMODE_PWM2;
+        oc_init.OCState = LL_TIM_OCSTATE_DISABLE;
+        oc_init.CompareValue = config->delay;
+        oc_init.OCPolarity = config->polarity;
+        LL_TIM_OC_Init(tim, handle->llChannel, &oc_init);
+        LL_TIM_SetOnePulseMode(tim, LL_TIM_ONEPULSEMODE_SINGLE);
+        break;
+
+    case YDRV_TIM_MODE_CAPTURE:
+    default:
+        LL_TIM_IC_StructInit(&ic_init);
+        ic_init.ICPolarity = config->edge;
+        ic_init.ICActiveInput = LL_TIM_ACTIVEINPUT_DIRECTTI;
+        ic_init.ICPrescaler = LL_TIM_ICPSC_DIV1;
+        ic_init.ICFilter = ((uint32_t)config->filter & 0x0FU) << (TIM_CCMR1_IC1F_Pos + 16U);
+        LL_TIM_IC_Init(tim, handle->llChannel, &ic_init);
+        break;
+    }
+
+    // 带刹车功能的定时器需要打开主输出
+    if (IS_TIM_BREAK_INSTANCE(tim))
+    {
+        LL_TIM_EnableAllOutputs(tim);
+    }
+
+    // 4. 引脚
+    if (prv_ConfigGpio(config, handle) != YDRV_OK)
+    {
+        prv_ClockCtrl(config->timId, 0);
+        handle->instance = NULL;
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 5. 登记计数频率，系统时钟切换后重算预分频
+    tim_tick_hz[config->timId] = handle->tickHz;
+    yDrvClockRegister(&tim_clock_notifier);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvTimDeInitStatic(yDrvTimHandle_t *handle)
+{
+    LL_GPIO_InitTypeDef gpio_init;
+
+    // 参数有效性检查
+    if (handle == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->instance == NULL)
+    {
+        return YDRV_OK;
+    }
+
+    (void)yDrvTimDmaStop(handle);
+    (void)yDrvTimStop(handle);
+    LL_TIM_DeInit(handle->instance);
+    prv_ClockCtrl((yDrvTimId_t)handle->timId, 0);
+    tim_tick_hz[handle->timId] = 0;
+
+    // 引脚恢复为模拟模式
+    if (handle->pinInfo.flag == 1)
+    {
+        LL_GPIO_StructInit(&gpio_init);
+        gpio_init.Pin = handle->pinInfo.pinMask;
+        gpio_init.Mode = LL_GPIO_MODE_ANALOG;
+        gpio_init.Speed = LL_GPIO_SPEED_FREQ_LOW;
+        gpio_init.Pull = LL_GPIO_PULL_NO;
+        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
+        LL_GPIO_Init(handle->pinInfo.port, &gpio_init);
+        handle->pinInfo.flag = 0;
+    }
+
+    handle->instance = NULL;
+    return YDRV_OK;
+}
+
+void yDrvTimConfigStructInit(yDrvTimConfig_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    *config = YDRV_TIM_CONFIG_DEFAULT();
+}
+
+void yDrvTimHandleStructInit(yDrvTimHandle_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    memset(handle, 0, sizeof(yDrvTimHandle_t));
+    *handle = YDRV_TIM_HANDLE_DEFAULT();
+}
+
+// ==================== 运行控制函数实现 ====================
+
+yDrvStatus_t yDrvTimStart(yDrvTimHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    LL_TIM_CC_EnableChannel(handle->instance, handle->llChannel);
+    if (handle->mode == YDRV_TIM_MODE_ONE_PULSE)
+    {
+        return YDRV_OK;
+    }
+
+    // 停止期间写入的周期和比较值还在预装载寄存器中，先产生更新事件装载
+    if (handle->mode == YDRV_TIM_MODE_PWM)
+    {
+        LL_TIM_GenerateEvent_UPDATE(handle->instance);
+        LL_TIM_ClearFlag_UPDATE(handle->instance);
+    }
+    LL_TIM_EnableCounter(handle->instance);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvTimStop(yDrvTimHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    LL_TIM_DisableCounter(handle->instance);
+    LL_TIM_CC_DisableChannel(handle->instance, handle->llChannel);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvTimTrigger(yDrvTimHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->mode != YDRV_TIM_MODE_ONE_PULSE)
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    // OPM在更新事件清除CEN，CEN仍置位说明上一个脉冲未结束
+    if (LL_TIM_IsEnabledCounter(handle->instance))
+    {
+        return YDRV_BUSY;
+    }
+
+    LL_TIM_SetCounter(handle->instance, 0);
+    LL_TIM_EnableCounter(handle->instance);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvTimSetPulse(yDrvTimHandle_t *handle, uint32_t delay, uint32_t width)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((delay == 0U) || (width == 0U) || ((delay + width) > 0x10000U))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (LL_TIM_IsEnabledCounter(handle->instance))
+    {
+        return YDRV_BUSY;
+    }
+
+    // 单脉冲模式未开预装载，计数器停止时直接生效
+    LL_TIM_SetAutoReload(handle->instance, delay + width - 1U);
+    *handle->ccr = delay;
+
+    return YDRV_OK;
+}
+
+// ==================== DMA函数实现 ====================
+
+yDrvStatus_t yDrvTimBurstStart(yDrvTimHandle_t *handle,
+                               yDrvTimBurstBase_t base,
+                               uint32_t count,
+                               const uint16_t *buffer,
+                               uint32_t len)
+{
+    yDrvStatus_t status;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL || buffer == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((count == 0U) || (count > YDRV_TIM_BURST_MAX) ||
+        (len == 0U) || (len > 0xFFFFU) || ((len % count) != 0U))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((handle->mode != YDRV_TIM_MODE_PWM) ||
+        (tim_dma_up[handle->timId] == YDRV_TIM_DMA_REQ_NONE))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    if (handle->dmaActive)
+    {
+        return YDRV_BUSY;
+    }
+
+    LL_TIM_ConfigDMABurst(handle->instance, base, (count - 1U) << TIM_DCR_DBL_Pos);
+
+    status = prv_DmaStart(handle, tim_dma_up[handle->timId], YDRV_DMA_DIR_M2P,
+                          &handle->instance->DMAR, (void *)buffer, len, YDRV_DMA_WIDTH_16BIT);
+    if (status != YDRV_OK)
+    {
+        return status;
+    }
+
+    // 每个更新事件产生count个DMA请求，依次写入起始寄存器之后的count个寄存器
+    LL_TIM_EnableDMAReq_UPDATE(handle->instance);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvTimCaptureStart(yDrvTimHandle_t *handle, uint16_t *buffer, uint32_t len)
+{
+    yDrvStatus_t status;
+    uint32_t request;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL || buffer == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((len == 0U) || (len > 0xFFFFU))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    request = tim_dma_cc[handle->timId][handle->channel];
+    if ((handle->mode != YDRV_TIM_MODE_CAPTURE) || (request == YDRV_TIM_DMA_REQ_NONE))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    if (handle->dmaActive)
+    {
+        return YDRV_BUSY;
+    }
+
+    status = prv_DmaStart(handle, request, YDRV_DMA_DIR_P2M, handle->ccr, buffer, len, YDRV_DMA_WIDTH_16BIT);
+    if (status != YDRV_OK)
+    {
+        return status;
+    }
+
+    SET_BIT(handle->instance->DIER, TIM_DIER_CC1DE << handle->channel);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvTimPulseDmaStart(yDrvTimHandle_t *handle, volatile void *periph, const uint8_t *buffer, uint32_t len)
+{
+    yDrvStatus_t status;
+    uint32_t request;
+
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL || periph == NULL || buffer == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    request = tim_dma_cc[handle->timId][handle->channel];
+    if ((handle->mode != YDRV_TIM_MODE_ONE_PULSE) || (request == YDRV_TIM_DMA_REQ_NONE) ||
+        (tim_rep_max[handle->timId] == 0U))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    if ((len == 0U) || (len > tim_rep_max[handle->timId]))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 上一串的最后一个脉冲还没结束，或DMA仍在传输
+    if (LL_TIM_IsEnabledCounter(handle->instance) || handle->dmaActive)
+    {
+        return YDRV_BUSY;
+    }
+
+    // 1. DMA通道首次使用时分配，之后只更新地址和长度，可在完成回调中直接启动下一串
+    if (handle->dma.DmaInfo.dma == NULL)
+    {
+        handle->dmaConfig.circular = 0;
+        status = prv_DmaStart(handle, request, YDRV_DMA_DIR_M2P, periph, (void *)buffer, len, YDRV_DMA_WIDTH_8BIT);
+        if (status != YDRV_OK)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        yDrvDmaTransDisable(&handle->dma);
+        LL_DMA_SetPeriphAddress(handle->dma.DmaInfo.dma, handle->dma.DmaInfo.channel, (uint32_t)periph);
+        LL_DMA_SetMemoryAddress(handle->dma.DmaInfo.dma, handle->dma.DmaInfo.channel, (uint32_t)buffer);
+        yDrvDmaDstBufferLen(&handle->dma, len);
+        yDrvDmaClearFlags(&handle->dma);
+        handle->dmaLen = len;
+        handle->dmaActive = 1;
+        yDrvDmaTransEnable(&handle->dma);
+    }
+
+    // 2. 重复计数器由更新事件装载，OPM在len个周期后的更新事件停止计数
+    LL_TIM_SetRepetitionCounter(handle->instance, len - 1U);
+    LL_TIM_GenerateEvent_UPDATE(handle->instance);
+    LL_TIM_ClearFlag_UPDATE(handle->instance);
+
+    // 3. 每个脉冲有效沿的比较事件请求一次DMA，数据在脉冲期间更新，结束沿锁存
+    SET_BIT(handle->instance->DIER, TIM_DIER_CC1DE << handle->channel);
+    LL_TIM_CC_EnableChannel(handle->instance, handle->llChannel);
+    LL_TIM_SetCounter(handle->instance, 0);
+    LL_TIM_EnableCounter(handle->instance);
+
+    return YDRV_OK;
+}
+
+uint32_t yDrvTimPulseDmaMax(yDrvTimHandle_t *handle)
+{
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return 0;
+    }
+
+    return tim_rep_max[handle->timId];
+}
+
+uint8_t yDrvTimIsRunning(yDrvTimHandle_t *handle)
+{
+    return (LL_TIM_IsEnabledCounter(handle->instance) != 0U) ? 1U : 0U;
+}
+
+yDrvStatus_t yDrvTimDmaStop(yDrvTimHandle_t *handle)
+{
+    // 参数有效性检查
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (handle->dmaActive == 0U && handle->dma.DmaInfo.dma == NULL)
+    {
+        return YDRV_OK;
+    }
+
+    // 先关闭定时器请求，再释放DMA通道
+    LL_TIM_DisableDMAReq_UPDATE(handle->instance);
+    CLEAR_BIT(handle->instance->DIER, TIM_DIER_CC1DE << handle->channel);
+
+    (void)yDrvDmaDeInitStatic(&handle->dma);
+    handle->dma = YDRV_DMA_HANDLE_DEFAULT();
+    handle->dmaActive = 0;
+    handle->dmaLen = 0;
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvTimCaptureInterval(yDrvTimHandle_t *handle, const uint16_t *buffer, uint32_t *ticks)
+{
+    uint32_t remain;
+    uint32_t pos;
+    uint32_t len;
+    uint16_t last;
+    uint16_t prev;
+    uint32_t wrapped;
+
+    // 参数有效性检查
+    if (handle == NULL || buffer == NULL || ticks == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if ((handle->dmaLen == 0U) || (handle->dma.DmaInfo.dma == NULL))
+    {
+        return YDRV_NOT_INITIALIZED;
+    }
+
+    len = handle->dmaLen;
+
+    // 读取前后剩余计数不变，说明两个样本之间没有新的写入
+    do
+    {
+        remain = yDrvDmaCurLenGet(&handle->dma);
+        pos = (remain == 0U) ? len : (len - remain); // 下一个写入位置
+        wrapped = (handle->dmaWrap != 0U) ||
+                  ((handle->dmaConfig.callback == NULL) && yDrvDmaIsTransComplete(&handle->dma));
+
+        if ((pos < 2U) && (!wrapped || !handle->dmaConfig.circular))
+        {
+            return YDRV_BUSY;
+        }
+
+        last = buffer[(pos + len - 1U) % len];
+        prev = buffer[(pos + len - 2U) % len];
+    } while (yDrvDmaCurLenGet(&handle->dma) != remain);
+
+    *ticks = (uint16_t)(last - prev);
+
+    return YDRV_OK;
+}
+
+// ==================== 私有函数实现 ====================
+
+static void prv_ClockCtrl(yDrvTimId_t timId, uint32_t enable)
+{
+    switch (timId)
+    {
+    case YDRV_TIM_1:
+        enable ? LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM1)
+               : LL_APB2_GRP1_DisableClock(LL_APB2_GRP1_PERIPH_TIM1);
+        break;
+    case YDRV_TIM_3:
+        enable ? LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM3)
+               : LL_APB1_GRP1_DisableClock(LL_APB1_GRP1_PERIPH_TIM3);
+        break;
+    case YDRV_TIM_14:
+        enable ? LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM14)
+               : LL_APB2_GRP1_DisableClock(LL_APB2_GRP1_PERIPH_TIM14);
+        break;
+#if defined(TIM15)
+    case YDRV_TIM_15:
+        enable ? LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM15)
+               : LL_APB2_GRP1_DisableClock(LL_APB2_GRP1_PERIPH_TIM15);
+        break;
+#endif
+    case YDRV_TIM_16:
+        enable ? LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM16)
+               : LL_APB2_GRP1_DisableClock(LL_APB2_GRP1_PERIPH_TIM16);
+        break;
+    default:
+        break;
+    }
+}
+
+static uint32_t prv_GetClockFreq(void)
+{
+    uint32_t apb = LL_RCC_GetAPB1Prescaler();
+
+    if (apb == LL_RCC_APB1_DIV_1)
+    {
+        return SystemCoreClock;
+    }
+
+    return __LL_RCC_CALC_PCLK1_FREQ(SystemCoreClock, apb) * 2U;
+}
+
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg)
+{
+    TIM_TypeDef *tim;
+    uint32_t clock;
+    uint32_t psc;
+    uint32_t cnt;
+    uint32_t id;
+
+    (void)oldHz;
+    (void)arg;
+
+    // APB不分频，定时器时钟等于SYSCLK
+    clock = (event == YDRV_CLOCK_PRE) ? newHz : prv_GetClockFreq();
+    for (id = 0; id < YDRV_TIM_MAX; id++)
+    {
+        if (tim_tick_hz[id] == 0U)
+        {
+            continue;
+        }
+
+        psc = clock / tim_tick_hz[id];
+        if (event == YDRV_CLOCK_PRE)
+        {
+            // 不能整数分频时计数频率会变，否决切换
+            if ((psc == 0U) || (psc > 0x10000U) || ((clock % tim_tick_hz[id]) != 0U))
+            {
+                return YDRV_BUSY;
+            }
+        }
+        else if (event == YDRV_CLOCK_POST)
+        {
+            // 更新事件立即装载预分频，URS置位时不产生更新中断和DMA请求，计数值写回
+            tim = tim_instance[id];
+            cnt = LL_TIM_GetCounter(tim);
+            LL_TIM_SetUpdateSource(tim, LL_TIM_UPDATESOURCE_COUNTER);
+            LL_TIM_SetPrescaler(tim, psc - 1U);
+            LL_TIM_GenerateEvent_UPDATE(tim);
+            LL_TIM_SetCounter(tim, cnt);
+            LL_TIM_SetUpdateSource(tim, LL_TIM_UPDATESOURCE_REGULAR);
+        }
+    }
+
+    return YDRV_OK;
+}
+
+static yDrvStatus_t prv_ConfigGpio(const yDrvTimConfig_t *config, yDrvTimHandle_t *handle)
+{
+    LL_GPIO_InitTypeDef gpio_init;
+
+    if (config->pin == YDRV_PINNULL)
+    {
+        return YDRV_OK;
+    }
+
+    if (yDrvParseGpio(config->pin, &handle->pinInfo) != YDRV_OK)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    gpio_init.Pin = handle->pinInfo.pinMask;
+    gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
+    gpio_init.Speed = LL_GPIO_SPEED_FREQ_LOW;
+    gpio_init.OutputType = (config->openDrain && (config->mode != YDRV_TIM_MODE_CAPTURE))
+                               ? LL_GPIO_OUTPUT_OPENDRAIN
+                               : LL_GPIO_OUTPUT_PUSHPULL;
+    gpio_init.Pull = LL_GPIO_PULL_NO;
+    gpio_init.Alternate = config->pinAF;
+
+    LL_GPIO_Init(handle->pinInfo.port, &gpio_init);
+    handle->pinInfo.flag = 1;
+
+    return YDRV_OK;
+}
+
+static yDrvStatus_t prv_DmaStart(yDrvTimHandle_t *handle,
+                                 uint32_t request,
+                                 yDrvDmaDirection_t direction,
+                                 volatile void *periph,
+                                 void *buffer,
+                                 uint32_t len,
+                                 yDrvDmaDataWidth_t width)
+{
+    yDrvDmaConfig_t dma_config = YDRV_DMA_CONFIG_DEFAULT();
+    yDrvDmaExtiConfig_t exti;
+    yDrvStatus_t status;
+
+    dma_config.channel = handle->dmaConfig.channel;
+    dma_config.request = (yDrvDmaRequest_t)request;
+    dma_config.priority = handle->dmaConfig.priority;
+    dma_config.mode = handle->dmaConfig.circular ? YDRV_DMA_MODE_CIRCULAR : YDRV_DMA_MODE_NORMAL;
+    dma_config.src_width = width;
+    dma_config.dst_width = width;
+    dma_config.src_inc = YDRV_DMA_INC_ENABLE;
+    dma_config.dst_inc = YDRV_DMA_INC_ENABLE;
+    dma_config.src_buffer = buffer; // M2P使用源缓冲区
+    dma_config.dst_buffer = buffer; // P2M使用目标缓冲区
+    dma_config.trans_len = len;
+    dma_config.owner = "tim";
+
+    status = yDrvDmaInitStatic(&dma_config, &handle->dma, direction);
+    if (status != YDRV_OK)
+    {
+        handle->dma = YDRV_DMA_HANDLE_DEFAULT();
+        return status;
+    }
+
+    // 定时器寄存器按半字访问，脉冲串按字节写入端口，外设地址不递增
+    LL_DMA_SetPeriphAddress(handle->dma.DmaInfo.dma, handle->dma.DmaInfo.channel, (uint32_t)periph);
+    LL_DMA_SetPeriphSize(handle->dma.DmaInfo.dma, handle->dma.DmaInfo.channel, width);
+    LL_DMA_SetPeriphIncMode(handle->dma.DmaInfo.dma, handle->dma.DmaInfo.channel, LL_DMA_PERIPH_NOINCREMENT);
+    yDrvDmaClearFlags(&handle->dma);
+
+    handle->dmaLen = len;
+    handle->dmaWrap = 0;
+
+    if (handle->dmaConfig.callback != NULL)
+    {
+        exti.prio = handle->dmaConfig.prio;
+        exti.arg = handle;
+        exti.enable = 1;
+
+        exti.trigger = YDRV_DMA_EXTI_TC;
+        exti.function = prv_DmaTc;
+        yDrvDmaRegisterCallback(&handle->dma, &exti);
+        exti.trigger = YDRV_DMA_EXTI_HT;
+        exti.function = prv_DmaHt;
+        yDrvDmaRegisterCallback(&handle->dma, &exti);
+        exti.trigger = YDRV_DMA_EXTI_TE;
+        exti.function = prv_DmaTe;
+        yDrvDmaRegisterCallback(&handle->dma, &exti);
+    }
+
+    handle->dmaActive = 1;
+    yDrvDmaTransEnable(&handle->dma);
+
+    return YDRV_OK;
+}
+
+static void prv_DmaTc(void *arg)
+{
+    yDrvTimHandle_t *handle = (yDrvTimHandle_t *)arg;
+
+    handle->dmaWrap++;
+    if (!handle->dmaConfig.circular)
+    {
+        handle->dmaActive = 0;
+    }
+    if (handle->dmaConfig.callback != NULL)
+    {
+        handle->dmaConfig.callback(handle->dmaConfig.arg, YDRV_DMA_EXTI_TC);
+    }
+}
+
+static void prv_DmaHt(void *arg)
+{
+    yDrvTimHandle_t *handle = (yDrvTimHandle_t *)arg;
+
+    if (handle->dmaConfig.callback != NULL)
+    {
+        handle->dmaConfig.callback(handle->dmaConfig.arg, YDRV_DMA_EXTI_HT);
+    }
+}
+
+static void prv_DmaTe(void *arg)
+{
+    yDrvTimHandle_t *handle = (yDrvTimHandle_t *)arg;
+
+    handle->dmaActive = 0;
+    if (handle->dmaConfig.callback != NULL)
+    {
+        handle->dmaConfig.callback(handle->dmaConfig.arg, YDRV_DMA_EXTI_TE);
+    }
+}
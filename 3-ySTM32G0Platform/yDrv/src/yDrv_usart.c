@@ -14,13 +14,24 @@
  * - 中断管理和回调处理
  * - GPIO引脚复用功能配置
  * - 错误处理和状态查询
+ * - 接收超时帧边界检测
  */
 
 #include <string.h> // For memset
 #include "yDrv_usart.h"
+#include "yDrv_clock.h"
+#include "yLib_trace.h"
+#include "yLib_probe.h"
+#include "stm32g0xx_ll_rcc.h"
 
 // ==================== 私有定义 ====================
 
+/**
+ * @brief 支持接收超时的实例，G0只有全功能的USART1/USART2
+ */
+#define USART_HAS_RX_TIMEOUT(instance) (((instance) == USART1) || ((instance) == USART2))
+#define USART_RX_TIMEOUT_MAX 0xFFFFFFU
+
 /**
  * @brief USART中断回调函数存储结构
  * @note 用于存储每个USART实例的中断回调函数和标志
@@ -29,8 +40,14 @@ struct
 {
     yDrvInterruptCallback_t callback[YDRV_USART_EXTI_MAX]; /*!< 中断回调函数数组 */
     uint8_t flags[YDRV_USART_EXTI_MAX];                    /*!< 中断标志数组 */
+    yDrvUsartErrorStats_t errors;                          /*!< 接收错误计数，中断中累加 */
 } exit_callback[YDRV_USART_MAX];
 
+/**
+ * @brief USART3/USART4共享中断的处理耗时
+ */
+YLIB_PROBE_DEFINE(usart34_isr);
+
 // ==================== 私有函数声明 ====================
 
 /**
@@ -68,12 +85,100 @@ static void yDrvUsartGetInstance(yDrvUsartId_t usartId,
  */
 static yDrvStatus_t prv_ConfigGpio(const yDrvUsartConfig_t *config, yDrvUsartHandle_t *handle);
 
+/**
+ * @brief 填写一个复用功能引脚配置项
+ * @param setup 配置项
+ * @param pin 引脚
+ * @param af 复用功能编号，YDRV_GPIO_AF_AUTO按signal查表
+ * @param signal 外设信号
+ * @param info 输出引脚信息
+ * @retval uint32_t 固定为1，便于累加配置项数
+ */
+static uint32_t prv_AddPin(yDrvGpioPinSetup_t *setup, yDrvGpioPin_t pin, uint32_t af, uint32_t signal,
+                           yDrvGpioInfo_t *info);
+
 /**
  * @brief 反初始化USART相关的GPIO引脚
  * @param handle USART句柄指针
  */
 static void prv_DeInitGpio(yDrvUsartHandle_t *handle);
 
+/**
+ * @brief 获取USART内核时钟频率
+ * @param instance USART寄存器指针
+ * @retval uint32_t 时钟频率(Hz)
+ * @note USART1/USART2可选时钟源，其他实例固定使用PCLK
+ */
+static uint32_t prv_GetClockFreq(const USART_TypeDef *instance);
+
+/**
+ * @brief 内核时钟是否随系统时钟变化
+ * @param instance USART寄存器指针
+ * @retval uint32_t 1=PCLK或SYSCLK，0=HSI16或LSE
+ */
+static uint32_t prv_ClockFollowsSysclk(const USART_TypeDef *instance);
+
+/**
+ * @brief 系统时钟切换通知
+ * @note PRE等待最后一个字符发完，POST按新频率重算BRR
+ */
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg);
+
+/**
+ * @brief 检查实例是否只使能了IDLE/RTO/PE/ERR中断
+ * @param instance USART实例
+ * @param index USART实例ID
+ * @retval 1 只有这些中断，且使能IDLE/RTO时已注册回调
+ * @retval 0 使能了其他中断
+ */
+static uint32_t prv_IdleOnly(const USART_TypeDef *instance, yDrvUsartId_t index);
+
+/**
+ * @brief 恢复中断向量的通用入口
+ * @param irq USART中断号
+ * @retval 无
+ */
+static void prv_IdleFastRestore(IRQn_Type irq);
+
+/**
+ * @brief 通用中断入口(启动文件向量表中的入口)
+ */
+void USART1_IRQHandler(void);
+void USART2_IRQHandler(void);
+void USART3_4_IRQHandler(void);
+
+/**
+ * @brief 只处理空闲中断的入口
+ */
+static void prv_Usart1IdleIrq(void);
+static void prv_Usart2IdleIrq(void);
+static void prv_Usart3_4IdleIrq(void);
+
+// ==================== 空闲中断快速入口 ====================
+
+/**
+ * @brief 已安装快速入口的中断向量，按IRQn置位
+ */
+static uint32_t usart_idle_fast;
+
+// ==================== 时钟切换 ====================
+
+/**
+ * @brief 各实例的波特率设定，系统时钟切换后按新频率重算BRR
+ */
+static struct
+{
+    USART_TypeDef *instance; /*!< 已初始化的实例，NULL为未使用 */
+    uint32_t baudRate;       /*!< 设定的波特率 */
+    uint32_t overSampling;   /*!< 过采样倍数 */
+    uint8_t suspended;       /*!< 外设时钟已关闭 */
+} usart_retime[YDRV_USART_MAX];
+
+/**
+ * @brief 系统时钟切换通知，所有实例共用
+ */
+static yDrvClockNotifier_t usart_clock_notifier = {.callback = prv_ClockNotify};
+
 // ==================== 基础函数实现 ====================
 
 yDrvStatus_t yDrvUsartInitStatic(const yDrvUsartConfig_t *config, yDrvUsartHandle_t *handle)
@@ -113,7 +218,7 @@ yDrvStatus_t yDrvUsartInitStatic(const yDrvUsartConfig_t *config, yDrvUsartHandl
     usart_init.Parity = config->parity;                   // 设置校验位
     usart_init.TransferDirection = config->direction;     // 设置传输方向
     usart_init.HardwareFlowControl = config->flowControl; // 设置硬件流控制
-    usart_init.OverSampling = LL_USART_OVERSAMPLING_16;   // 过采样
+    usart_init.OverSampling = config->overSampling;       // 过采样
 
     // 应用USART配置
     if (LL_USART_Init(handle->instance, &usart_init) != SUCCESS)
@@ -159,12 +264,80 @@ yDrvStatus_t yDrvUsartInitStatic(const yDrvUsartConfig_t *config, yDrvUsartHandl
 
     // 7. 初始化句柄结构
 
+    handle->overSampling = config->overSampling;
     handle->flagBtyeSend = ((config->parity == YDRV_USART_PARITY_NONE) &&
                             (config->dataBits == YDRV_USART_DATA_9BIT))
                                ? 1
                                : 0;
+
+    // 配置RS-485驱动使能：DE在起始位前由硬件拉有效，最后一个停止位后释放
+    if (config->dePin != YDRV_PINNULL)
+    {
+        if (!IS_UART_DRIVER_ENABLE_INSTANCE(handle->instance) ||
+            (config->flowControl == YDRV_USART_FLOW_RTS) ||
+            (config->flowControl == YDRV_USART_FLOW_RTS_CTS))
+        {
+            return YDRV_INVALID_PARAM;
+        }
+        LL_USART_SetDESignalPolarity(handle->instance,
+                                     config->dePolarity ? LL_USART_DE_POLARITY_LOW
+                                                        : LL_USART_DE_POLARITY_HIGH);
+        LL_USART_SetDEAssertionTime(handle->instance, config->deAssertTime & 0x1FU);
+        LL_USART_SetDEDeassertionTime(handle->instance, config->deDeassertTime & 0x1FU);
+        LL_USART_EnableDEMode(handle->instance);
+    }
+
+    // 配置硬件FIFO（仅USART1/USART2支持）
+    if (config->fifoEnable)
+    {
+        if (!IS_UART_FIFO_INSTANCE(handle->instance))
+        {
+            return YDRV_NOT_SUPPORTED;
+        }
+        LL_USART_SetRXFIFOThreshold(handle->instance, (uint32_t)config->rxFifoThreshold);
+        LL_USART_SetTXFIFOThreshold(handle->instance, (uint32_t)config->txFifoThreshold);
+        LL_USART_EnableFIFO(handle->instance);
+    }
+    else
+    {
+        LL_USART_DisableFIFO(handle->instance);
+    }
+
+    // 配置字符匹配：ADDM7=1时CMF比较ADD[7:0]完整8位，需在UE=0时写入
+    if (config->matchEnable)
+    {
+        LL_USART_ConfigNodeAddress(handle->instance, LL_USART_ADDRESS_DETECT_7B,
+                                   config->matchChar);
+    }
+
+    // 配置接收超时：RTOR计数从最后一个停止位结束开始，收到新字符重新计时
+    if (config->rxTimeout != 0)
+    {
+        if (!USART_HAS_RX_TIMEOUT(handle->instance))
+        {
+            return YDRV_NOT_SUPPORTED;
+        }
+        if (config->rxTimeout > USART_RX_TIMEOUT_MAX)
+        {
+            return YDRV_INVALID_PARAM;
+        }
+        LL_USART_SetRxTimeout(handle->instance, config->rxTimeout);
+        LL_USART_EnableRxTimeout(handle->instance);
+    }
+    else
+    {
+        LL_USART_DisableRxTimeout(handle->instance);
+    }
+
     // 6. 使能USART外设
     LL_USART_Enable(handle->instance);
+
+    // 7. 登记波特率，系统时钟切换后重算
+    usart_retime[handle->usartId].instance = handle->instance;
+    usart_retime[handle->usartId].baudRate = config->baudRate;
+    usart_retime[handle->usartId].overSampling = handle->overSampling;
+    usart_retime[handle->usartId].suspended = 0;
+    yDrvClockRegister(&usart_clock_notifier);
     return YDRV_OK;
 }
 
@@ -184,6 +357,7 @@ yDrvStatus_t yDrvUsartDeInitStatic(yDrvUsartHandle_t *handle)
 
     // 3. 禁用USART外设时钟以节省功耗
     prv_DisableClock(handle->usartId);
+    usart_retime[handle->usartId].instance = NULL;
 
     return YDRV_OK;
 }
@@ -200,6 +374,7 @@ void yDrvUsartConfigStructInit(yDrvUsartConfig_t *config)
     config->rxPin = YDRV_PINNULL;
     config->rtsPin = YDRV_PINNULL;
     config->ctsPin = YDRV_PINNULL;
+    config->dePin = YDRV_PINNULL;
     config->baudRate = 115200;
     config->dataBits = YDRV_USART_DATA_8BIT;
     config->stopBits = YDRV_USART_STOP_1BIT;
@@ -207,10 +382,21 @@ void yDrvUsartConfigStructInit(yDrvUsartConfig_t *config)
     config->direction = YDRV_USART_DIR_TX_RX;
     config->flowControl = YDRV_USART_FLOW_NONE;
     config->mode = YDRV_USART_MODE_ASYNCHRONOUS;
-    config->txAF = 0;
-    config->rxAF = 0;
-    config->ctsAF = 0;
-    config->rtsAF = 0;
+    config->overSampling = YDRV_USART_OVERSAMPLING_16;
+    config->txAF = YDRV_GPIO_AF_AUTO;
+    config->rxAF = YDRV_GPIO_AF_AUTO;
+    config->ctsAF = YDRV_GPIO_AF_AUTO;
+    config->rtsAF = YDRV_GPIO_AF_AUTO;
+    config->deAF = YDRV_GPIO_AF_AUTO;
+    config->dePolarity = 0;
+    config->deAssertTime = 0;
+    config->deDeassertTime = 0;
+    config->fifoEnable = 0;
+    config->rxFifoThreshold = YDRV_USART_FIFO_TH_1_8;
+    config->txFifoThreshold = YDRV_USART_FIFO_TH_1_8;
+    config->matchEnable = 0;
+    config->matchChar = 0;
+    config->rxTimeout = 0;
 }
 
 void yDrvUsartHandleStructInit(yDrvUsartHandle_t *handle)
@@ -228,8 +414,163 @@ void yDrvUsartHandleStructInit(yDrvUsartHandle_t *handle)
     handle->rxPinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
     handle->rtsPinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
     handle->ctsPinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
+    handle->dePinInfo = (yDrvGpioInfo_t){NULL, 0, 0, 0};
 
     handle->flagBtyeSend = 0;
+    handle->overSampling = YDRV_USART_OVERSAMPLING_16;
+}
+
+yDrvStatus_t yDrvUsartSuspend(yDrvUsartHandle_t *handle)
+{
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 关闭时钟会截断正在发送的字符
+    if ((LL_USART_GetTransferDirection(handle->instance) & LL_USART_DIRECTION_TX) &&
+        !LL_USART_IsActiveFlag_TC(handle->instance))
+    {
+        return YDRV_BUSY;
+    }
+
+    prv_DisableClock(handle->usartId);
+    usart_retime[handle->usartId].suspended = 1;
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvUsartResume(yDrvUsartHandle_t *handle)
+{
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    prv_EnableClock(handle->usartId);
+    usart_retime[handle->usartId].suspended = 0;
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvUsartSetBaudRate(yDrvUsartHandle_t *handle, uint32_t baudRate)
+{
+    uint32_t clock;
+    uint32_t maxBaud;
+
+    if (handle == NULL || handle->instance == NULL || baudRate == 0)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // USARTDIV最小为16：16倍过采样上限fck/16，8倍过采样上限fck/8
+    clock = prv_GetClockFreq(handle->instance);
+    maxBaud = (handle->overSampling == YDRV_USART_OVERSAMPLING_8) ? (clock / 8U) : (clock / 16U);
+    if (baudRate > maxBaud)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 关闭UE会丢弃正在发送的字符
+    if ((LL_USART_GetTransferDirection(handle->instance) & LL_USART_DIRECTION_TX) &&
+        !LL_USART_IsActiveFlag_TC(handle->instance))
+    {
+        return YDRV_BUSY;
+    }
+
+    LL_USART_Disable(handle->instance);
+    LL_USART_SetBaudRate(handle->instance, clock, LL_USART_PRESCALER_DIV1,
+                         handle->overSampling, baudRate);
+    LL_USART_Enable(handle->instance);
+    usart_retime[handle->usartId].baudRate = baudRate;
+
+    return YDRV_OK;
+}
+
+uint32_t yDrvUsartGetBaudRate(yDrvUsartHandle_t *handle)
+{
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return 0;
+    }
+
+    return LL_USART_GetBaudRate(handle->instance, prv_GetClockFreq(handle->instance),
+                                LL_USART_PRESCALER_DIV1, handle->overSampling);
+}
+
+yDrvStatus_t yDrvUsartAutoBaudStart(yDrvUsartHandle_t *handle, yDrvUsartAutoBaud_t mode)
+{
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (!IS_USART_AUTOBAUDRATE_DETECTION_INSTANCE(handle->instance))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    // ABRMODE/ABREN只能在UE=0时修改
+    LL_USART_Disable(handle->instance);
+    LL_USART_SetAutoBaudRateMode(handle->instance, (uint32_t)mode);
+    LL_USART_EnableAutoBaudRate(handle->instance);
+    LL_USART_Enable(handle->instance);
+
+    // 清除上一次的ABRF/ABRE，下一个字符重新测量
+    LL_USART_RequestAutoBaudRate(handle->instance);
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvUsartAutoBaudPoll(yDrvUsartHandle_t *handle, uint32_t *baudRate)
+{
+    if (handle == NULL || handle->instance == NULL)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (LL_USART_IsActiveFlag_ABRE(handle->instance))
+    {
+        return YDRV_ERROR;
+    }
+
+    if (!LL_USART_IsActiveFlag_ABR(handle->instance))
+    {
+        return YDRV_BUSY;
+    }
+
+    // 测得的波特率作为设定值，系统时钟切换后按它重算
+    usart_retime[handle->usartId].baudRate = yDrvUsartGetBaudRate(handle);
+    if (baudRate != NULL)
+    {
+        *baudRate = usart_retime[handle->usartId].baudRate;
+    }
+
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvUsartSetRxTimeout(yDrvUsartHandle_t *handle, uint32_t bits)
+{
+    if (handle == NULL || handle->instance == NULL || bits > USART_RX_TIMEOUT_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    if (!USART_HAS_RX_TIMEOUT(handle->instance))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    if (bits == 0)
+    {
+        LL_USART_DisableRxTimeout(handle->instance);
+        return YDRV_OK;
+    }
+
+    LL_USART_SetRxTimeout(handle->instance, bits);
+    LL_USART_EnableRxTimeout(handle->instance);
+
+    return YDRV_OK;
 }
 
 void yDrvUsartExtiConfigStructInit(yDrvUsartExtiConfig_t *extiConfig)
@@ -371,6 +712,20 @@ yDrvStatus_t yDrvUsartRegisterCallback(yDrvUsartHandle_t *handle,
         return YDRV_INVALID_PARAM;
     }
 
+    // 接收超时需先在配置中使能
+    if ((exti->trigger == YDRV_USART_EXTI_RTO) && !LL_USART_IsEnabledRxTimeout(handle->instance))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    // 快速入口只处理IDLE/RTO/PE/ERR，使能其他中断前先恢复通用入口
+    if (!((exti->trigger == YDRV_USART_EXTI_PE) || (exti->trigger == YDRV_USART_EXTI_ERR) ||
+          (((exti->trigger == YDRV_USART_EXTI_IDLE) || (exti->trigger == YDRV_USART_EXTI_RTO)) &&
+           (exti->function != NULL))))
+    {
+        prv_IdleFastRestore(handle->IRQ);
+    }
+
     // 存储回调函数和参数
     exit_callback[handle->usartId].callback[exti->trigger].function = exti->function;
     exit_callback[handle->usartId].callback[exti->trigger].arg = exti->arg;
@@ -411,12 +766,29 @@ yDrvStatus_t yDrvUsartRegisterCallback(yDrvUsartHandle_t *handle,
         LL_USART_EnableIT_CTS(handle->instance);
         break;
 
+    case YDRV_USART_EXTI_CM:
+        LL_USART_EnableIT_CM(handle->instance);
+        break;
+
+    case YDRV_USART_EXTI_RXFT:
+        LL_USART_EnableIT_RXFT(handle->instance);
+        break;
+
+    case YDRV_USART_EXTI_TXFT:
+        LL_USART_EnableIT_TXFT(handle->instance);
+        break;
+
+    case YDRV_USART_EXTI_RTO:
+        LL_USART_ClearFlag_RTO(handle->instance);
+        LL_USART_EnableIT_RTO(handle->instance);
+        break;
+
     default:
         return YDRV_INVALID_PARAM;
     }
 
     // 设置中断优先级
-    NVIC_SetPriority(handle->IRQ, exti->prio);
+    yDrvIrqSetPriority(handle->IRQ, exti->prio);
 
     if (exti->enable)
     { // 使能NVIC中断
@@ -434,6 +806,12 @@ yDrvStatus_t yDrvUsartUnregisterCallback(yDrvUsartHandle_t *handle, yDrvUsartExt
 
 {
     // 参数有效性检查
+    // 快速入口不检查IDLE/RTO回调是否为空，清除回调前恢复通用入口
+    if ((type == YDRV_USART_EXTI_IDLE) || (type == YDRV_USART_EXTI_RTO))
+    {
+        prv_IdleFastRestore(handle->IRQ);
+    }
+
     // 禁用对应的硬件中断
     switch (type)
     {
@@ -469,6 +847,22 @@ yDrvStatus_t yDrvUsartUnregisterCallback(yDrvUsartHandle_t *handle, yDrvUsartExt
         LL_USART_DisableIT_CTS(handle->instance);
         break;
 
+    case YDRV_USART_EXTI_CM:
+        LL_USART_DisableIT_CM(handle->instance);
+        break;
+
+    case YDRV_USART_EXTI_RXFT:
+        LL_USART_DisableIT_RXFT(handle->instance);
+        break;
+
+    case YDRV_USART_EXTI_TXFT:
+        LL_USART_DisableIT_TXFT(handle->instance);
+        break;
+
+    case YDRV_USART_EXTI_RTO:
+        LL_USART_DisableIT_RTO(handle->instance);
+        break;
+
     default:
         return YDRV_INVALID_PARAM;
     }
@@ -479,6 +873,69 @@ yDrvStatus_t yDrvUsartUnregisterCallback(yDrvUsartHandle_t *handle, yDrvUsartExt
 
     return YDRV_OK;
 }
+
+yDrvStatus_t yDrvUsartIdleFastPath(yDrvUsartHandle_t *handle)
+{
+    yDrvIrqHandler_t handler;
+    uint32_t ok;
+
+    if (handle == NULL || handle->instance == NULL || handle->usartId >= YDRV_USART_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 共用向量的实例都要满足条件，未开时钟的实例读出0
+    switch (handle->IRQ)
+    {
+    case USART1_IRQn:
+        ok = prv_IdleOnly(USART1, YDRV_USART_1);
+        handler = prv_Usart1IdleIrq;
+        break;
+
+    case USART2_IRQn:
+        ok = prv_IdleOnly(USART2, YDRV_USART_2);
+        handler = prv_Usart2IdleIrq;
+        break;
+
+    case USART3_4_IRQn:
+        ok = prv_IdleOnly(USART3, YDRV_USART_3) && prv_IdleOnly(USART4, YDRV_USART_4);
+        handler = prv_Usart3_4IdleIrq;
+        break;
+
+    default:
+        return YDRV_NOT_SUPPORTED;
+    }
+
+    if (!ok || (yDrvIrqSetHandler(handle->IRQ, handler) == NULL))
+    {
+        return YDRV_NOT_SUPPORTED;
+    }
+    usart_idle_fast |= 1UL << (uint32_t)handle->IRQ;
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvUsartGetErrorStats(yDrvUsartHandle_t *handle, yDrvUsartErrorStats_t *stats)
+{
+    if (handle == NULL || stats == NULL || handle->usartId >= YDRV_USART_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    *stats = exit_callback[handle->usartId].errors;
+    return YDRV_OK;
+}
+
+yDrvStatus_t yDrvUsartResetErrorStats(yDrvUsartHandle_t *handle)
+{
+    if (handle == NULL || handle->usartId >= YDRV_USART_MAX)
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    memset(&exit_callback[handle->usartId].errors, 0, sizeof(yDrvUsartErrorStats_t));
+    return YDRV_OK;
+}
+
 yDrvStatus_t yDrvUsartDmaWrite(yDrvUsartHandle_t *handle, yDrvDmaChannel_t *channel)
 {
     yDrvDmaInfo_t dma_info;
@@ -498,6 +955,7 @@ yDrvStatus_t yDrvUsartDmaWrite(yDrvUsartHandle_t *handle, yDrvDmaChannel_t *chan
                          LL_DMA_PDATAALIGN_BYTE);
     LL_DMA_SetPeriphIncMode(dma_info.dma,
                             dma_info.channel, LL_DMA_PERIPH_NOINCREMENT); // 配置优先级
+    LL_USART_EnableDMAReq_TX(handle->instance);
     switch (handle->usartId)
     {
     case YDRV_USART_1:
@@ -638,6 +1096,25 @@ static void prv_DisableClock(yDrvUsartId_t usartId)
     }
 }
 
+/**
+ * @brief 填写一个复用功能引脚配置项实现
+ */
+static uint32_t prv_AddPin(yDrvGpioPinSetup_t *setup, yDrvGpioPin_t pin, uint32_t af, uint32_t signal,
+                           yDrvGpioInfo_t *info)
+{
+    setup->pin = pin;
+    setup->mode = LL_GPIO_MODE_ALTERNATE;
+    setup->speed = LL_GPIO_SPEED_FREQ_LOW;
+    setup->outputType = LL_GPIO_OUTPUT_PUSHPULL;
+    setup->pull = LL_GPIO_PULL_NO;
+    setup->af = (uint8_t)af;
+    setup->signal = (uint8_t)signal;
+    setup->preset = 0;
+    setup->info = info;
+
+    return 1;
+}
+
 /**
  * @brief 配置USART相关的GPIO引脚
  * @param config USART配置结构指针
@@ -645,98 +1122,51 @@ static void prv_DisableClock(yDrvUsartId_t usartId)
  */
 static yDrvStatus_t prv_ConfigGpio(const yDrvUsartConfig_t *config, yDrvUsartHandle_t *handle)
 {
-    yDrvStatus_t status;
-    LL_GPIO_InitTypeDef gpio_init;
+    yDrvGpioPinSetup_t setup[5];
+    uint32_t sig = YDRV_GPIO_SIG_USART1_TX + (uint32_t)config->usartId * 4U;
+    uint32_t count = 0;
 
-    // 配置TX引脚：复用功能、推挽输出
+    // TX引脚：复用功能、推挽输出
     if ((config->direction == YDRV_USART_DIR_TX) ||
         (config->direction == YDRV_USART_DIR_TX_RX))
     {
-        status = yDrvParseGpio(config->txPin, &handle->txPinInfo);
-        if (status != YDRV_OK)
-        {
-            return YDRV_INVALID_PARAM;
-        }
-
-        gpio_init.Pin = handle->txPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
-        gpio_init.Speed = LL_GPIO_SPEED_FREQ_LOW;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_NO;
-        gpio_init.Alternate = config->txAF;
-
-        // 配置TX引脚为复用功能模式
-        LL_GPIO_Init(handle->txPinInfo.port, &gpio_init);
-        handle->txPinInfo.flag = 1;
+        count += prv_AddPin(&setup[count], config->txPin, config->txAF, sig + 0U, &handle->txPinInfo);
     }
 
-    // 配置RX引脚：复用功能
+    // RX引脚：复用功能
     if ((config->direction == YDRV_USART_DIR_RX) ||
         (config->direction == YDRV_USART_DIR_TX_RX))
     {
-        status = yDrvParseGpio(config->rxPin, &handle->txPinInfo);
-        if (status != YDRV_OK)
-        {
-            return YDRV_INVALID_PARAM;
-        }
-
-        gpio_init.Pin = handle->txPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
-        gpio_init.Speed = LL_GPIO_SPEED_FREQ_LOW;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_NO;
-        gpio_init.Alternate = config->rxAF;
-
-        // 配置RX引脚为复用功能模式
-        LL_GPIO_Init(handle->txPinInfo.port, &gpio_init);
-        handle->rxPinInfo.flag = 1;
+        count += prv_AddPin(&setup[count], config->rxPin, config->rxAF, sig + 1U, &handle->rxPinInfo);
     }
 
     // 如果使能RTS流控，配置RTS引脚
     if ((config->flowControl == YDRV_USART_FLOW_RTS) ||
         (config->flowControl == YDRV_USART_FLOW_RTS_CTS))
     {
-        status = yDrvParseGpio(config->rtsPin, &handle->rtsPinInfo);
-        if (status != YDRV_OK)
-        {
-            return YDRV_INVALID_PARAM;
-        }
-
-        gpio_init.Pin = handle->rtsPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
-        gpio_init.Speed = LL_GPIO_SPEED_FREQ_LOW;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_NO;
-        gpio_init.Alternate = config->rtsAF;
-
-        // 配置RTS引脚为复用功能模式
-        LL_GPIO_Init(handle->rtsPinInfo.port, &gpio_init);
-        handle->rtsPinInfo.flag = 1;
+        count += prv_AddPin(&setup[count], config->rtsPin, config->rtsAF, sig + 2U, &handle->rtsPinInfo);
     }
 
     // 如果使能CTS流控，配置CTS引脚
     if ((config->flowControl == YDRV_USART_FLOW_CTS) ||
         (config->flowControl == YDRV_USART_FLOW_RTS_CTS))
     {
-        status = yDrvParseGpio(config->ctsPin, &handle->ctsPinInfo);
-        if (status != YDRV_OK)
-        {
-            return YDRV_INVALID_PARAM;
-        }
+        count += prv_AddPin(&setup[count], config->ctsPin, config->ctsAF, sig + 3U, &handle->ctsPinInfo);
+    }
 
-        gpio_init.Pin = handle->ctsPinInfo.pinMask;
-        gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
-        gpio_init.Speed = LL_GPIO_SPEED_FREQ_LOW;
-        gpio_init.OutputType = LL_GPIO_OUTPUT_PUSHPULL;
-        gpio_init.Pull = LL_GPIO_PULL_NO;
-        gpio_init.Alternate = config->ctsAF;
+    // 如果使能RS-485驱动使能，配置DE引脚(与RTS同一信号)
+    if (config->dePin != YDRV_PINNULL)
+    {
+        count += prv_AddPin(&setup[count], config->dePin, config->deAF, sig + 2U, &handle->dePinInfo);
+    }
 
-        // 配置CTS引脚为复用功能模式
-        LL_GPIO_Init(handle->ctsPinInfo.port, &gpio_init);
-        handle->ctsPinInfo.flag = 1;
+    if (count == 0U)
+    {
+        return YDRV_OK;
     }
 
-    return YDRV_OK;
+    // 同一端口的模式和复用寄存器只改写一次
+    return (yDrvGpioSetupPins(setup, count) == YDRV_OK) ? YDRV_OK : YDRV_INVALID_PARAM;
 }
 
 /**
@@ -788,6 +1218,176 @@ static void prv_DeInitGpio(yDrvUsartHandle_t *handle)
         LL_GPIO_Init(handle->ctsPinInfo.port, &gpio_init);
         handle->ctsPinInfo.flag = 0;
     }
+
+    if (handle->dePinInfo.flag == 1)
+    {
+        gpio_init.Pin = handle->dePinInfo.pinMask;
+        LL_GPIO_Init(handle->dePinInfo.port, &gpio_init);
+        handle->dePinInfo.flag = 0;
+    }
+}
+
+/**
+ * @brief 获取USART内核时钟频率实现
+ */
+static uint32_t prv_GetClockFreq(const USART_TypeDef *instance)
+{
+    LL_RCC_ClocksTypeDef clocks;
+
+    if (instance == USART1)
+    {
+        return LL_RCC_GetUSARTClockFreq(LL_RCC_USART1_CLKSOURCE);
+    }
+#if defined(RCC_CCIPR_USART2SEL)
+    if (instance == USART2)
+    {
+        return LL_RCC_GetUSARTClockFreq(LL_RCC_USART2_CLKSOURCE);
+    }
+#endif
+
+    LL_RCC_GetSystemClocksFreq(&clocks);
+    return clocks.PCLK1_Frequency;
+}
+
+/**
+ * @brief 内核时钟是否随系统时钟变化实现
+ */
+static uint32_t prv_ClockFollowsSysclk(const USART_TypeDef *instance)
+{
+    uint32_t source;
+
+    if (instance == USART1)
+    {
+        source = LL_RCC_GetUSARTClockSource(LL_RCC_USART1_CLKSOURCE);
+        return ((source == LL_RCC_USART1_CLKSOURCE_PCLK1) || (source == LL_RCC_USART1_CLKSOURCE_SYSCLK)) ? 1U : 0U;
+    }
+#if defined(RCC_CCIPR_USART2SEL)
+    if (instance == USART2)
+    {
+        source = LL_RCC_GetUSARTClockSource(LL_RCC_USART2_CLKSOURCE);
+        return ((source == LL_RCC_USART2_CLKSOURCE_PCLK1) || (source == LL_RCC_USART2_CLKSOURCE_SYSCLK)) ? 1U : 0U;
+    }
+#endif
+
+    return 1U;
+}
+
+/**
+ * @brief 系统时钟切换通知实现
+ * @note PRE：新频率下波特率超出上限时否决，正在发送的字符最多等两个字符时间，仍未发完则否决；
+ *       POST：UE=0时才能写BRR，重新使能会丢弃正在接收的字符；时钟已关闭的实例临时打开时钟写入
+ */
+static uint32_t prv_IdleOnly(const USART_TypeDef *instance, yDrvUsartId_t index)
+{
+    const uint32_t cr1 = USART_CR1_TXEIE_TXFNFIE | USART_CR1_TCIE | USART_CR1_RXNEIE_RXFNEIE |
+                         USART_CR1_CMIE | USART_CR1_EOBIE |
+                         USART_CR1_TXFEIE | USART_CR1_RXFFIE;
+    const uint32_t cr3 = USART_CR3_CTSIE | USART_CR3_WUFIE | USART_CR3_TXFTIE |
+                         USART_CR3_RXFTIE | USART_CR3_TCBGTIE;
+
+    if ((instance->CR1 & cr1) || (instance->CR2 & USART_CR2_LBDIE) || (instance->CR3 & cr3))
+    {
+        return 0;
+    }
+    if ((instance->CR1 & USART_CR1_IDLEIE) &&
+        (exit_callback[index].callback[YDRV_USART_EXTI_IDLE].function == NULL))
+    {
+        return 0;
+    }
+    if ((instance->CR1 & USART_CR1_RTOIE) &&
+        (exit_callback[index].callback[YDRV_USART_EXTI_RTO].function == NULL))
+    {
+        return 0;
+    }
+    return 1;
+}
+
+static void prv_IdleFastRestore(IRQn_Type irq)
+{
+    if ((irq < 0) || !(usart_idle_fast & (1UL << (uint32_t)irq)))
+    {
+        return;
+    }
+
+    switch (irq)
+    {
+    case USART1_IRQn:
+        yDrvIrqSetHandler(irq, USART1_IRQHandler);
+        break;
+
+    case USART2_IRQn:
+        yDrvIrqSetHandler(irq, USART2_IRQHandler);
+        break;
+
+    default:
+        yDrvIrqSetHandler(irq, USART3_4_IRQHandler);
+        break;
+    }
+    usart_idle_fast &= ~(1UL << (uint32_t)irq);
+}
+
+static yDrvStatus_t prv_ClockNotify(yDrvClockEvent_t event, uint32_t oldHz, uint32_t newHz, void *arg)
+{
+    USART_TypeDef *usart;
+    uint32_t id;
+    uint32_t start;
+    uint32_t limit;
+    uint32_t clock;
+
+    (void)oldHz;
+    (void)arg;
+
+    for (id = 0; id < YDRV_USART_MAX; id++)
+    {
+        usart = usart_retime[id].instance;
+        if ((usart == NULL) || (prv_ClockFollowsSysclk(usart) == 0))
+        {
+            continue;
+        }
+
+        if (event == YDRV_CLOCK_PRE)
+        {
+            limit = (usart_retime[id].overSampling == YDRV_USART_OVERSAMPLING_8) ? (newHz / 8U) : (newHz / 16U);
+            if (usart_retime[id].baudRate > limit)
+            {
+                return YDRV_BUSY;
+            }
+            if (usart_retime[id].suspended != 0)
+            {
+                continue;
+            }
+
+            // 一个字符最多12位，两个字符时间
+            limit = (24000000U / usart_retime[id].baudRate) + 1U;
+            start = yDrvGetTimeUs();
+            while ((LL_USART_GetTransferDirection(usart) & LL_USART_DIRECTION_TX) &&
+                   !LL_USART_IsActiveFlag_TC(usart))
+            {
+                if ((yDrvGetTimeUs() - start) > limit)
+                {
+                    return YDRV_BUSY;
+                }
+            }
+        }
+        else if (event == YDRV_CLOCK_POST)
+        {
+            if (usart_retime[id].suspended != 0)
+            {
+                prv_EnableClock((yDrvUsartId_t)id);
+            }
+            clock = prv_GetClockFreq(usart);
+            LL_USART_Disable(usart);
+            LL_USART_SetBaudRate(usart, clock, LL_USART_PRESCALER_DIV1,
+                                 usart_retime[id].overSampling, usart_retime[id].baudRate);
+            LL_USART_Enable(usart);
+            if (usart_retime[id].suspended != 0)
+            {
+                prv_DisableClock((yDrvUsartId_t)id);
+            }
+        }
+    }
+
+    return YDRV_OK;
 }
 
 // // ==================== 中断处理函数（优化版本） ====================
@@ -832,31 +1432,41 @@ static void prv_DeInitGpio(yDrvUsartHandle_t *handle)
                 exit_callback[index].callback[YDRV_USART_EXTI_IDLE].arg); \
         }                                                                 \
                                                                           \
-        /* 5. 奇偶校验错误中断 (PE) */                                    \
+        /* 5. 奇偶校验错误中断 (PE)，未注册回调时也计数并清除 */          \
         if (LL_USART_IsActiveFlag_PE(instance) &&                         \
-            LL_USART_IsEnabledIT_PE(instance) &&                          \
-            exit_callback[index].callback[YDRV_USART_EXTI_PE].function)   \
+            LL_USART_IsEnabledIT_PE(instance))                            \
         {                                                                 \
             LL_USART_ClearFlag_PE(instance);                              \
-            exit_callback[index].callback[YDRV_USART_EXTI_PE].function(   \
-                exit_callback[index].callback[YDRV_USART_EXTI_PE].arg);   \
+            exit_callback[index].errors.pe++;                             \
+            if (exit_callback[index].callback[YDRV_USART_EXTI_PE].function) \
+                exit_callback[index].callback[YDRV_USART_EXTI_PE].function( \
+                    exit_callback[index].callback[YDRV_USART_EXTI_PE].arg); \
         }                                                                 \
                                                                           \
-        /* 6. 错误中断 (FE, NE, ORE) */                                   \
+        /* 6. 错误中断 (FE, NE, ORE)，未注册回调时也计数并清除 */         \
         if ((LL_USART_IsActiveFlag_FE(instance) ||                        \
              LL_USART_IsActiveFlag_NE(instance) ||                        \
              LL_USART_IsActiveFlag_ORE(instance)) &&                      \
-            LL_USART_IsEnabledIT_ERROR(instance) &&                       \
-            exit_callback[index].callback[YDRV_USART_EXTI_ERR].function)  \
+            LL_USART_IsEnabledIT_ERROR(instance))                         \
         {                                                                 \
             if (LL_USART_IsActiveFlag_FE(instance))                       \
+            {                                                             \
                 LL_USART_ClearFlag_FE(instance);                          \
+                exit_callback[index].errors.fe++;                         \
+            }                                                             \
             if (LL_USART_IsActiveFlag_NE(instance))                       \
+            {                                                             \
                 LL_USART_ClearFlag_NE(instance);                          \
+                exit_callback[index].errors.ne++;                         \
+            }                                                             \
             if (LL_USART_IsActiveFlag_ORE(instance))                      \
+            {                                                             \
                 LL_USART_ClearFlag_ORE(instance);                         \
-            exit_callback[index].callback[YDRV_USART_EXTI_ERR].function(  \
-                exit_callback[index].callback[YDRV_USART_EXTI_ERR].arg);  \
+                exit_callback[index].errors.ore++;                        \
+            }                                                             \
+            if (exit_callback[index].callback[YDRV_USART_EXTI_ERR].function) \
+                exit_callback[index].callback[YDRV_USART_EXTI_ERR].function( \
+                    exit_callback[index].callback[YDRV_USART_EXTI_ERR].arg); \
         }                                                                 \
                                                                           \
         /* 7. LIN断开检测中断 (LBD) */                                    \
@@ -878,6 +1488,40 @@ static void prv_DeInitGpio(yDrvUsartHandle_t *handle)
             exit_callback[index].callback[YDRV_USART_EXTI_CTS].function(  \
                 exit_callback[index].callback[YDRV_USART_EXTI_CTS].arg);  \
         }                                                                 \
+        /* 9. 字符匹配中断 (CM) */                                              \
+        if (LL_USART_IsActiveFlag_CM(instance) &&                         \
+            LL_USART_IsEnabledIT_CM(instance) &&                          \
+            exit_callback[index].callback[YDRV_USART_EXTI_CM].function)   \
+        {                                                                 \
+            LL_USART_ClearFlag_CM(instance);                              \
+            exit_callback[index].callback[YDRV_USART_EXTI_CM].function(   \
+                exit_callback[index].callback[YDRV_USART_EXTI_CM].arg);   \
+        }                                                                 \
+        /* 10. 接收FIFO阈值中断 (RXFT，读空FIFO后自动清除) */                           \
+        if (LL_USART_IsActiveFlag_RXFT(instance) &&                       \
+            LL_USART_IsEnabledIT_RXFT(instance) &&                        \
+            exit_callback[index].callback[YDRV_USART_EXTI_RXFT].function) \
+        {                                                                 \
+            exit_callback[index].callback[YDRV_USART_EXTI_RXFT].function( \
+                exit_callback[index].callback[YDRV_USART_EXTI_RXFT].arg); \
+        }                                                                 \
+        /* 11. 发送FIFO阈值中断 (TXFT，写满FIFO后自动清除) */                           \
+        if (LL_USART_IsActiveFlag_TXFT(instance) &&                       \
+            LL_USART_IsEnabledIT_TXFT(instance) &&                        \
+            exit_callback[index].callback[YDRV_USART_EXTI_TXFT].function) \
+        {                                                                 \
+            exit_callback[index].callback[YDRV_USART_EXTI_TXFT].function( \
+                exit_callback[index].callback[YDRV_USART_EXTI_TXFT].arg); \
+        }                                                                 \
+        /* 12. 接收超时中断 (RTO) */                                      \
+        if (LL_USART_IsActiveFlag_RTO(instance) &&                        \
+            LL_USART_IsEnabledIT_RTO(instance) &&                         \
+            exit_callback[index].callback[YDRV_USART_EXTI_RTO].function)  \
+        {                                                                 \
+            LL_USART_ClearFlag_RTO(instance);                             \
+            exit_callback[index].callback[YDRV_USART_EXTI_RTO].function(  \
+                exit_callback[index].callback[YDRV_USART_EXTI_RTO].arg);  \
+        }                                                                 \
     } while (0)
 
 // ==================== 中断处理函数实现 ====================
@@ -885,36 +1529,42 @@ static void prv_DeInitGpio(yDrvUsartHandle_t *handle)
 /**
  * @brief USART1中断处理函数
  */
-void USART1_IRQHandler(void)
+YLIB_RAMFUNC void USART1_IRQHandler(void)
 {
+    YLIB_TRACE_ISR();
     USART_HANDLE_EXIT_IRQ(USART1, YDRV_USART_1);
 }
 
 /**
  * @brief USART2中断处理函数
  */
-void USART2_IRQHandler(void)
+YLIB_RAMFUNC void USART2_IRQHandler(void)
 {
+    YLIB_TRACE_ISR();
     USART_HANDLE_EXIT_IRQ(USART2, YDRV_USART_2);
 }
 
 /**
  * @brief USART3/USART4共享中断处理函数
  */
-void USART3_4_IRQHandler(void)
+YLIB_RAMFUNC void USART3_4_IRQHandler(void)
 {
+    YLIB_TRACE_ISR();
+    YLIB_PROBE_BEGIN(usart34_isr);
     // 检查是USART3还是USART4产生的中断
     USART_HANDLE_EXIT_IRQ(USART3, YDRV_USART_3);
 
     USART_HANDLE_EXIT_IRQ(USART4, YDRV_USART_4);
+    YLIB_PROBE_END(usart34_isr);
 }
 
 #ifdef USART5
 /**
  * @brief USART5/USART6共享中断处理函数
  */
-void USART5_6_IRQHandler(void)
+YLIB_RAMFUNC void USART5_6_IRQHandler(void)
 {
+    YLIB_TRACE_ISR();
     // 检查是USART5还是USART6产生的中断
     if (exit_callback[YDRV_USART_5].callback != NULL)
     {
@@ -929,3 +1579,101 @@ void USART5_6_IRQHandler(void)
 #endif
 }
 #endif
+
+// ==================== 空闲中断快速入口 ====================
+
+/**
+ * @brief 快速入口的错误处理，与通用入口一样计数并清除
+ * @param instance USART实例
+ * @param index USART实例ID
+ * @param isr 进入中断时的ISR
+ */
+YLIB_RAMFUNC static void prv_IdleFastErrors(USART_TypeDef *instance, yDrvUsartId_t index, uint32_t isr)
+{
+    if ((isr & USART_ISR_PE) && LL_USART_IsEnabledIT_PE(instance))
+    {
+        LL_USART_ClearFlag_PE(instance);
+        exit_callback[index].errors.pe++;
+        if (exit_callback[index].callback[YDRV_USART_EXTI_PE].function)
+            exit_callback[index].callback[YDRV_USART_EXTI_PE].function(
+                exit_callback[index].callback[YDRV_USART_EXTI_PE].arg);
+    }
+
+    if ((isr & (USART_ISR_FE | USART_ISR_NE | USART_ISR_ORE)) && LL_USART_IsEnabledIT_ERROR(instance))
+    {
+        if (isr & USART_ISR_FE)
+        {
+            LL_USART_ClearFlag_FE(instance);
+            exit_callback[index].errors.fe++;
+        }
+        if (isr & USART_ISR_NE)
+        {
+            LL_USART_ClearFlag_NE(instance);
+            exit_callback[index].errors.ne++;
+        }
+        if (isr & USART_ISR_ORE)
+        {
+            LL_USART_ClearFlag_ORE(instance);
+            exit_callback[index].errors.ore++;
+        }
+        if (exit_callback[index].callback[YDRV_USART_EXTI_ERR].function)
+            exit_callback[index].callback[YDRV_USART_EXTI_ERR].function(
+                exit_callback[index].callback[YDRV_USART_EXTI_ERR].arg);
+    }
+}
+
+/**
+ * @brief 只检查IDLE和RTOF的中断处理
+ * @note 只读一次ISR，安装时已确认除IDLE/RTO/PE/ERR外没有使能其他中断，
+ *       IDLE/RTO回调安装时已确认非空
+ */
+#define USART_HANDLE_IDLE_IRQ(instance, index)                                   \
+    do                                                                           \
+    {                                                                            \
+        uint32_t isr = (instance)->ISR;                                          \
+                                                                                 \
+        if ((isr & USART_ISR_IDLE) && ((instance)->CR1 & USART_CR1_IDLEIE))      \
+        {                                                                        \
+            LL_USART_ClearFlag_IDLE(instance);                                   \
+            exit_callback[index].callback[YDRV_USART_EXTI_IDLE].function(        \
+                exit_callback[index].callback[YDRV_USART_EXTI_IDLE].arg);        \
+        }                                                                        \
+        if ((isr & USART_ISR_RTOF) && ((instance)->CR1 & USART_CR1_RTOIE))      \
+        {                                                                        \
+            LL_USART_ClearFlag_RTO(instance);                                    \
+            exit_callback[index].callback[YDRV_USART_EXTI_RTO].function(         \
+                exit_callback[index].callback[YDRV_USART_EXTI_RTO].arg);         \
+        }                                                                        \
+        if (isr & (USART_ISR_PE | USART_ISR_FE | USART_ISR_NE | USART_ISR_ORE)) \
+        {                                                                        \
+            prv_IdleFastErrors(instance, index, isr);                            \
+        }                                                                        \
+    } while (0)
+
+/**
+ * @brief USART1空闲中断快速入口
+ */
+YLIB_RAMFUNC static void prv_Usart1IdleIrq(void)
+{
+    YLIB_TRACE_ISR();
+    USART_HANDLE_IDLE_IRQ(USART1, YDRV_USART_1);
+}
+
+/**
+ * @brief USART2空闲中断快速入口
+ */
+YLIB_RAMFUNC static void prv_Usart2IdleIrq(void)
+{
+    YLIB_TRACE_ISR();
+    USART_HANDLE_IDLE_IRQ(USART2, YDRV_USART_2);
+}
+
+/**
+ * @brief USART3/USART4空闲中断快速入口
+ */
+YLIB_RAMFUNC static void prv_Usart3_4IdleIrq(void)
+{
+    YLIB_TRACE_ISR();
+    USART_HANDLE_IDLE_IRQ(USART3, YDRV_USART_3);
+    USART_HANDLE_IDLE_IRQ(USART4, YDRV_USART_4);
+}
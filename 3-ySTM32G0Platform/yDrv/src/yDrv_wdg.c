@@ -0,0 +1,96 @@
+/**
+ ******************************************************************************
+ * @file    yDrv_wdg.c
+ * @author  yLab2.0
+ * @brief   独立看门狗驱动实现文件
+ * @details 基于STM32G0平台IWDG实现的看门狗驱动程序
+ *          - 写入0xCCCC启动看门狗，LSI随之自动打开
+ *          - 写入0x5555解锁预分频和重载寄存器，等待状态寄存器更新完成
+ *          - 复位标志在RCC_CSR中，读出后写RMVF清除
+ ******************************************************************************
+ * @attention
+ * RMVF会清除所有复位标志，其他模块需要复位原因时应在此之前读取或改用本模块的结果
+ ******************************************************************************
+ */
+
+/* 包含的头文件 ----------------------------------------------------------------*/
+#include "yDrv_wdg.h"
+
+/* 私有宏定义 ------------------------------------------------------------------*/
+
+#define YDRV_IWDG_KEY_START (0xCCCCU)  /*!< 启动看门狗 */
+#define YDRV_IWDG_KEY_ACCESS (0x5555U) /*!< 解锁PR/RLR */
+
+#define YDRV_IWDG_RELOAD_MAX (0x0FFFUL) /*!< 12位重载值 */
+
+/**
+ * @brief 等待寄存器更新的最长循环次数
+ * @note 更新需要5个LSI周期，约160us
+ */
+#define YDRV_IWDG_SYNC_LOOPS (100000UL)
+
+/* 私有变量 --------------------------------------------------------------------*/
+
+/**
+ * @brief 复位原因：0未读取，1看门狗复位，2其他
+ */
+static uint8_t iwdg_reset_cause = 0;
+
+/* 公共函数 --------------------------------------------------------------------*/
+
+/**
+ * @brief 启动独立看门狗
+ */
+yDrvStatus_t yDrvIwdgStart(uint32_t timeoutMs)
+{
+    uint32_t reload;
+    uint32_t prescaler = 0;
+    uint32_t loops = 0;
+
+    if ((timeoutMs == 0U) || (timeoutMs > YDRV_IWDG_TIMEOUT_MAX))
+    {
+        return YDRV_INVALID_PARAM;
+    }
+
+    // 分频系数为4<<prescaler，取重载值不溢出的最小分频
+    reload = (timeoutMs * (YDRV_IWDG_LSI_HZ / 1000U)) / 4U;
+    while (reload > YDRV_IWDG_RELOAD_MAX + 1U)
+    {
+        prescaler++;
+        reload = (reload + 1U) / 2U;
+    }
+
+    // 调试器暂停内核时看门狗同时暂停
+    RCC->APBENR1 |= RCC_APBENR1_DBGEN;
+    DBG->APBFZ1 |= DBG_APB_FZ1_DBG_IWDG_STOP;
+
+    (void)yDrvIwdgWasReset();
+
+    IWDG->KR = YDRV_IWDG_KEY_START;
+    IWDG->KR = YDRV_IWDG_KEY_ACCESS;
+    IWDG->PR = prescaler;
+    IWDG->RLR = reload - 1U;
+    while ((IWDG->SR & (IWDG_SR_PVU | IWDG_SR_RVU)) != 0U)
+    {
+        if (++loops > YDRV_IWDG_SYNC_LOOPS)
+        {
+            return YDRV_TIMEOUT;
+        }
+    }
+    yDrvIwdgKick();
+
+    return YDRV_OK;
+}
+
+/**
+ * @brief 查询上一次复位是否由独立看门狗引起
+ */
+uint8_t yDrvIwdgWasReset(void)
+{
+    if (iwdg_reset_cause == 0U)
+    {
+        iwdg_reset_cause = ((RCC->CSR & RCC_CSR_IWDGRSTF) != 0U) ? 1U : 2U;
+        RCC->CSR |= RCC_CSR_RMVF;
+    }
+    return (iwdg_reset_cause == 1U) ? 1U : 0U;
+}
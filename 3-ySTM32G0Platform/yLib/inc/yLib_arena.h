@@ -0,0 +1,147 @@
+/**
+ ******************************************************************************
+ * @file       yLib_arena.h
+ * @brief      线性(bump)分配器
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       在调用者提供的缓冲区上顺序分配，不单独释放，按标记整体回退；
+ *             用于单次请求内的临时缓冲区，替代函数中的大数组以减小任务栈
+ ******************************************************************************
+ */
+#ifndef YLIB_ARENA_H
+#define YLIB_ARENA_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/* 分配粒度，与堆对齐一致 */
+#define YLIB_ARENA_ALIGN configBYTE_ALIGNMENT
+#define ylib_arena_align_up(size) (((size) + (YLIB_ARENA_ALIGN - 1)) & ~(size_t)(YLIB_ARENA_ALIGN - 1))
+
+    /**
+     * @brief 线性分配器
+     */
+    typedef struct
+    {
+        uint8_t *base; /* 缓冲区起始(已对齐) */
+        size_t size;   /* 缓冲区可用大小 */
+        size_t used;   /* 已分配字节数，始终按YLIB_ARENA_ALIGN对齐 */
+        size_t peak;   /* 历史最大已分配字节数 */
+        size_t fails;  /* 空间不足次数 */
+    } ylib_arena_t;
+
+    /**
+     * @brief 作用域，退出时回退到进入时的位置
+     */
+    typedef struct
+    {
+        ylib_arena_t *arena; /* 所属分配器，NULL表示空作用域 */
+        size_t mark;         /* 进入时的已分配字节数 */
+    } ylib_arena_scope_t;
+
+    /**
+     * @brief 初始化线性分配器
+     * @param arena 分配器
+     * @param buffer 缓冲区
+     * @param size 缓冲区大小
+     * @return 0成功，-1参数无效
+     */
+    int ylib_arena_init(ylib_arena_t *arena, void *buffer, size_t size);
+
+    /**
+     * @brief 分配内存
+     * @param arena 分配器
+     * @param size 字节数
+     * @return 按YLIB_ARENA_ALIGN对齐的内存，空间不足返回NULL
+     */
+    static inline void *ylib_arena_alloc(ylib_arena_t *arena, size_t size)
+    {
+        size_t start = arena->used;
+
+        size = ylib_arena_align_up(size);
+        if (size > arena->size - start)
+        {
+            arena->fails++;
+            return NULL;
+        }
+        arena->used = start + size;
+        if (arena->used > arena->peak)
+            arena->peak = arena->used;
+        return arena->base + start;
+    }
+
+    /**
+     * @brief 获取当前位置
+     * @param arena 分配器
+     * @return 标记，交给ylib_arena_reset回退
+     */
+    static inline size_t ylib_arena_mark(const ylib_arena_t *arena)
+    {
+        return arena->used;
+    }
+
+    /**
+     * @brief 回退到标记位置，其后分配的内存全部失效
+     * @param arena 分配器
+     * @param mark ylib_arena_mark的返回值，0表示清空
+     */
+    static inline void ylib_arena_reset(ylib_arena_t *arena, size_t mark)
+    {
+        if (mark < arena->used)
+            arena->used = mark;
+    }
+
+    /**
+     * @brief 剩余可分配字节数
+     * @param arena 分配器
+     * @return 字节数
+     */
+    static inline size_t ylib_arena_available(const ylib_arena_t *arena)
+    {
+        return arena->size - arena->used;
+    }
+
+    static inline ylib_arena_scope_t ylib_arena_scope_begin(ylib_arena_t *arena)
+    {
+        ylib_arena_scope_t scope = {arena, (arena != NULL) ? arena->used : 0};
+        return scope;
+    }
+
+    static inline void ylib_arena_scope_end(ylib_arena_scope_t *scope)
+    {
+        if (scope->arena != NULL)
+            ylib_arena_reset(scope->arena, scope->mark);
+    }
+
+/**
+ * @brief 声明一个作用域，离开所在代码块(含return)时自动回退
+ * @param name 作用域变量名
+ * @param arena 分配器，可为NULL
+ * @note 作用域可嵌套，内层先于外层退出
+ */
+#define YLIB_ARENA_SCOPE(name, arena) \
+    ylib_arena_scope_t name __attribute__((cleanup(ylib_arena_scope_end))) = ylib_arena_scope_begin(arena)
+
+    /**
+     * @brief 绑定当前任务的线性分配器
+     * @param arena 分配器，NULL表示解除绑定
+     * @note 由FreeRTOS移植层heap_ylib.c借助线程本地存储指针实现
+     */
+    void ylib_arena_task_bind(ylib_arena_t *arena);
+
+    /**
+     * @brief 获取当前任务绑定的线性分配器
+     * @return 分配器，未绑定或调度器未运行时返回NULL
+     */
+    ylib_arena_t *ylib_arena_task(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_ARENA_H */
@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file       yLib_bench.h
+  * @brief      周期计时的微基准测试
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       测试项以YLIB_BENCH注册到.ylib_bench段，运行时逐项关中断计时多次，
+  *             减去实测的计时开销后给出最小、中位数和最大周期数；
+  *             计数器由平台通过ylib_bench_register_clock注册，M0+没有DWT，一般用SysTick当前值
+  ******************************************************************************
+  */
+#ifndef YLIB_BENCH_H
+#define YLIB_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 测试项
+ */
+struct ylib_bench {
+    const char *name;    /* 名称 */
+    void (*run)(void);   /* 测试体，每次采样调用一次 */
+    void (*setup)(void); /* 开始采样前调用一次，不计时，可为NULL */
+};
+
+/**
+ * @brief 一项测试的结果(周期数，已减去计时开销)
+ */
+struct ylib_bench_result {
+    uint32_t min;      /* 最小值，代码本身的耗时 */
+    uint32_t median;   /* 中位数 */
+    uint32_t max;      /* 最大值，含Flash取指等待等抖动 */
+    uint32_t overhead; /* 已减去的计时开销 */
+};
+
+/**
+ * @brief 注册测试项，后面紧跟测试体
+ * @param name 测试名，同时用于生成函数和表项名
+ * @code
+ * YLIB_BENCH(ring_put_get)
+ * {
+ *     (void)ylib_ring_enqueue(&ring, &v, sizeof(v));
+ *     (void)ylib_ring_dequeue(&ring, &v, sizeof(v));
+ * }
+ * @endcode
+ */
+#define YLIB_BENCH(name) YLIB_BENCH_SETUP(name, NULL)
+
+/**
+ * @brief 注册带准备函数的测试项
+ * @param setup 开始采样前调用一次的函数，用于初始化测试体用到的数据
+ */
+#define YLIB_BENCH_SETUP(name, setup)                                            \
+    static void ylib_bench_##name(void);                                         \
+    YLIB_USED const struct ylib_bench ylib_bench_entry_##name                    \
+        YLIB_SECTION(".ylib_bench") = {#name, ylib_bench_##name, (setup)};       \
+    static void ylib_bench_##name(void)
+
+/**
+ * @brief 注册计数器
+ * @param now 读取计数值
+ * @param since 返回从start到现在经过的周期数，处理计数器回绕
+ * @note 两个函数都在关中断时调用；now为NULL时不能运行测试
+ */
+void ylib_bench_register_clock(uint32_t (*now)(void), uint32_t (*since)(uint32_t start));
+
+/**
+ * @brief 按序号取测试项
+ * @param index 序号，从0开始
+ * @return 测试项，超出范围返回NULL
+ */
+const struct ylib_bench *ylib_bench_iterate(unsigned int index);
+
+/**
+ * @brief 按名称查找测试项
+ * @return 测试项，不存在返回NULL
+ */
+const struct ylib_bench *ylib_bench_find(const char *name);
+
+/**
+ * @brief 运行一项测试
+ * @param bench 测试项
+ * @param samples 采样次数，0或超过YLIB_BENCH_SAMPLES时取YLIB_BENCH_SAMPLES
+ * @param result 输出结果
+ * @return 0成功，-1未注册计数器或参数错误
+ * @note 先以空测试体测出计时开销(最小值)，各样本减去开销后排序
+ */
+int ylib_bench_run(const struct ylib_bench *bench, unsigned int samples, struct ylib_bench_result *result);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_BENCH_H */
@@ -0,0 +1,203 @@
+/**
+  ******************************************************************************
+  * @file       yLib_bitmap.h
+  * @brief      位图与位扫描
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       位i存放在第i/32个字的第i%32位；查找按字跳过全0/全1的字，每个字内用de Bruijn
+  *             乘法查表定位(M0+没有CLZ/CTZ指令)，1024位最多扫描32个字；
+  *             _atomic后缀和alloc/free接口在YLIB_BITMAP_LOCK内完成，任务和中断可共用，其余接口不带锁
+  ******************************************************************************
+  */
+#ifndef YLIB_BITMAP_H
+#define YLIB_BITMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+#define YLIB_BITMAP_BITS_PER_WORD 32U
+
+/**
+ * @brief 存放bits位所需的字数
+ */
+#define YLIB_BITMAP_WORDS(bits) (((bits) + YLIB_BITMAP_BITS_PER_WORD - 1U) / YLIB_BITMAP_BITS_PER_WORD)
+
+/**
+ * @brief 定义位图，全部位为0
+ * @param name 数组名
+ * @param bits 位数
+ */
+#define YLIB_BITMAP_DECLARE(name, bits) uint32_t name[YLIB_BITMAP_WORDS(bits)]
+
+extern const uint8_t ylib_debruijn_ffs[32];
+extern const uint8_t ylib_debruijn_fls[32];
+
+/**
+ * @brief 最低置位的位号
+ * @param word 不能为0
+ */
+YLIB_INLINE unsigned int ylib_ffs32(uint32_t word)
+{
+    return ylib_debruijn_ffs[((word & (0U - word)) * 0x077CB531U) >> 27];
+}
+
+/**
+ * @brief 最高置位的位号
+ * @param word 不能为0
+ */
+YLIB_INLINE unsigned int ylib_fls32(uint32_t word)
+{
+    word |= word >> 1;
+    word |= word >> 2;
+    word |= word >> 4;
+    word |= word >> 8;
+    word |= word >> 16;
+    return ylib_debruijn_fls[(word * 0x07C4ACDDU) >> 27];
+}
+
+YLIB_INLINE void ylib_bitmap_set(uint32_t *map, unsigned int bit)
+{
+    map[bit / YLIB_BITMAP_BITS_PER_WORD] |= 1U << (bit % YLIB_BITMAP_BITS_PER_WORD);
+}
+
+YLIB_INLINE void ylib_bitmap_clear(uint32_t *map, unsigned int bit)
+{
+    map[bit / YLIB_BITMAP_BITS_PER_WORD] &= ~(1U << (bit % YLIB_BITMAP_BITS_PER_WORD));
+}
+
+YLIB_INLINE bool ylib_bitmap_test(const uint32_t *map, unsigned int bit)
+{
+    return (map[bit / YLIB_BITMAP_BITS_PER_WORD] >> (bit % YLIB_BITMAP_BITS_PER_WORD)) & 1U;
+}
+
+/**
+ * @brief 置位并返回原值，与其他_atomic操作和中断互斥
+ */
+YLIB_INLINE bool ylib_bitmap_test_and_set_atomic(uint32_t *map, unsigned int bit)
+{
+    uint32_t state;
+    bool old;
+
+    YLIB_BITMAP_LOCK(state);
+    old = ylib_bitmap_test(map, bit);
+    ylib_bitmap_set(map, bit);
+    YLIB_BITMAP_UNLOCK(state);
+    return old;
+}
+
+/**
+ * @brief 清零并返回原值，与其他_atomic操作和中断互斥
+ */
+YLIB_INLINE bool ylib_bitmap_test_and_clear_atomic(uint32_t *map, unsigned int bit)
+{
+    uint32_t state;
+    bool old;
+
+    YLIB_BITMAP_LOCK(state);
+    old = ylib_bitmap_test(map, bit);
+    ylib_bitmap_clear(map, bit);
+    YLIB_BITMAP_UNLOCK(state);
+    return old;
+}
+
+YLIB_INLINE void ylib_bitmap_set_atomic(uint32_t *map, unsigned int bit)
+{
+    (void)ylib_bitmap_test_and_set_atomic(map, bit);
+}
+
+YLIB_INLINE void ylib_bitmap_clear_atomic(uint32_t *map, unsigned int bit)
+{
+    (void)ylib_bitmap_test_and_clear_atomic(map, bit);
+}
+
+/**
+ * @brief 全部位清零
+ */
+void ylib_bitmap_zero(uint32_t *map, unsigned int bits);
+
+/**
+ * @brief 全部位置1，最后一个字中超出bits的位保持0
+ */
+void ylib_bitmap_fill(uint32_t *map, unsigned int bits);
+
+/**
+ * @brief 将[start, start + n)置1
+ */
+void ylib_bitmap_set_range(uint32_t *map, unsigned int start, unsigned int n);
+
+/**
+ * @brief 将[start, start + n)清零
+ */
+void ylib_bitmap_clear_range(uint32_t *map, unsigned int start, unsigned int n);
+
+/**
+ * @brief 从start起查找第一个置位的位
+ * @param map 位图
+ * @param bits 位图位数
+ * @param start 起始位号
+ * @return 位号，没有时返回bits
+ */
+unsigned int ylib_bitmap_find_next_set(const uint32_t *map, unsigned int bits, unsigned int start);
+
+/**
+ * @brief 从start起查找第一个为0的位
+ * @return 位号，没有时返回bits
+ */
+unsigned int ylib_bitmap_find_next_zero(const uint32_t *map, unsigned int bits, unsigned int start);
+
+YLIB_INLINE unsigned int ylib_bitmap_find_first_set(const uint32_t *map, unsigned int bits)
+{
+    return ylib_bitmap_find_next_set(map, bits, 0);
+}
+
+YLIB_INLINE unsigned int ylib_bitmap_find_first_zero(const uint32_t *map, unsigned int bits)
+{
+    return ylib_bitmap_find_next_zero(map, bits, 0);
+}
+
+/**
+ * @brief 从start起查找n个连续为0的位
+ * @return 起始位号，没有时返回bits
+ */
+unsigned int ylib_bitmap_find_zero_area(const uint32_t *map, unsigned int bits, unsigned int start,
+                                        unsigned int n);
+
+/**
+ * @brief 置位的位数
+ */
+unsigned int ylib_bitmap_weight(const uint32_t *map, unsigned int bits);
+
+/**
+ * @brief 分配n个连续为0的位并置1
+ * @param map 位图
+ * @param bits 位图位数
+ * @param n 位数
+ * @return 起始位号，空间不足时返回bits
+ * @note 查找和置位在同一个临界区内，关中断时间随位图字数增长
+ */
+unsigned int ylib_bitmap_alloc(uint32_t *map, unsigned int bits, unsigned int n);
+
+/**
+ * @brief 释放ylib_bitmap_alloc分配的位
+ */
+void ylib_bitmap_free(uint32_t *map, unsigned int start, unsigned int n);
+
+/**
+ * @brief 遍历全部置位的位
+ * @param bit 当前位号(unsigned int)
+ * @param map 位图
+ * @param bits 位图位数
+ */
+#define ylib_bitmap_for_each_set(bit, map, bits)                             \
+    for ((bit) = ylib_bitmap_find_first_set(map, bits); (bit) < (bits);      \
+         (bit) = ylib_bitmap_find_next_set(map, bits, (bit) + 1U))
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_BITMAP_H */
@@ -0,0 +1,143 @@
+/**
+ ******************************************************************************
+ * @file       yLib_cache.h
+ * @brief      定长对象缓存(slab)
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       每个缓存由若干yLib_mempool分区(slab)组成，分区用尽时从堆申请新的分区；
+ *             对象分配释放只做分区空闲链表头操作，不产生堆碎片
+ ******************************************************************************
+ */
+#ifndef YLIB_CACHE_H
+#define YLIB_CACHE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+#include "yLib_mempool.h"
+
+    /* 对象构造/析构钩子，分别在分配返回前和释放归还前调用 */
+    typedef void (*ylib_cache_ctor_t)(void *obj);
+    typedef void (*ylib_cache_dtor_t)(void *obj);
+
+    /**
+     * @brief 缓存分区(slab)
+     */
+    typedef struct ylib_cache_slab
+    {
+        struct ylib_cache_slab *next; /* 同一缓存的下一个分区 */
+        YLIB_MEM *mem;                /* 分区控制块 */
+        uint8_t *start;               /* 第一个对象地址 */
+        uint8_t *end;                 /* 最后一个对象之后的地址 */
+    } ylib_cache_slab_t;
+
+    /**
+     * @brief 缓存统计信息
+     */
+    typedef struct
+    {
+        const char *name;    /* 缓存名称 */
+        uint32_t obj_size;   /* 对象大小(字节) */
+        uint32_t stride;     /* 对象实际占用(对齐后) */
+        uint32_t slabs;      /* 当前分区数量 */
+        uint32_t total;      /* 对象总数 */
+        uint32_t in_use;     /* 已分配对象数 */
+        uint32_t peak;       /* 历史最大已分配对象数 */
+        uint32_t allocs;     /* 成功分配次数 */
+        uint32_t frees;      /* 释放次数 */
+        uint32_t grow_fails; /* 扩展分区失败次数 */
+    } ylib_cache_stats_t;
+
+    /**
+     * @brief 对象缓存
+     */
+    typedef struct ylib_cache
+    {
+        struct ylib_cache *next;  /* 全局缓存链表 */
+        ylib_cache_slab_t *slabs; /* 分区链表，新分区在表头 */
+        ylib_cache_slab_t *hint;  /* 最近一次有空闲对象的分区 */
+        ylib_cache_ctor_t ctor;   /* 构造钩子，可为NULL */
+        ylib_cache_dtor_t dtor;   /* 析构钩子，可为NULL */
+        uint32_t align;           /* 对象对齐 */
+        uint32_t per_slab;        /* 每个分区的对象数 */
+        uint32_t max_slabs;       /* 分区数上限，0表示不限 */
+        ylib_cache_stats_t stats; /* 统计信息 */
+    } ylib_cache_t;
+
+    /**
+     * @brief 创建对象缓存并预分配第一个分区
+     * @param name 缓存名称，须长期有效
+     * @param obj_size 对象大小(字节)
+     * @param align 对象对齐，必须为2的幂，小于configBYTE_ALIGNMENT时按configBYTE_ALIGNMENT
+     * @param count 每个分区的对象数，至少为2
+     * @return 缓存指针，失败返回NULL
+     */
+    ylib_cache_t *ylib_cache_create(const char *name, size_t obj_size, size_t align, size_t count);
+
+    /**
+     * @brief 设置构造/析构钩子
+     * @param cache 缓存指针
+     * @param ctor 构造钩子，可为NULL
+     * @param dtor 析构钩子，可为NULL
+     */
+    void ylib_cache_set_hooks(ylib_cache_t *cache, ylib_cache_ctor_t ctor, ylib_cache_dtor_t dtor);
+
+    /**
+     * @brief 限制分区数量
+     * @param cache 缓存指针
+     * @param max_slabs 分区数上限，0表示不限
+     */
+    void ylib_cache_set_limit(ylib_cache_t *cache, uint32_t max_slabs);
+
+    /**
+     * @brief 分配一个对象
+     * @param cache 缓存指针
+     * @return 对象指针，分区用尽且无法扩展时返回NULL
+     * @note 任务和中断中均可调用；扩展分区时走堆分配
+     */
+    void *ylib_cache_alloc(ylib_cache_t *cache);
+
+    /**
+     * @brief 释放一个对象
+     * @param cache 缓存指针
+     * @param obj 对象指针
+     * @return 0成功，-1对象不属于该缓存
+     */
+    int ylib_cache_free(ylib_cache_t *cache, void *obj);
+
+    /**
+     * @brief 归还全空的分区给堆，至少保留一个分区
+     * @param cache 缓存指针
+     * @return 归还的分区数量
+     */
+    uint32_t ylib_cache_shrink(ylib_cache_t *cache);
+
+    /**
+     * @brief 销毁缓存，未释放的对象一并失效
+     * @param cache 缓存指针
+     */
+    void ylib_cache_destroy(ylib_cache_t *cache);
+
+    /**
+     * @brief 获取缓存统计信息
+     * @param cache 缓存指针
+     * @param stats 统计信息输出
+     */
+    void ylib_cache_get_stats(ylib_cache_t *cache, ylib_cache_stats_t *stats);
+
+    /**
+     * @brief 按序号遍历全部缓存
+     * @param index 序号，从0开始
+     * @return 缓存指针，超出范围返回NULL
+     */
+    ylib_cache_t *ylib_cache_iterate(uint32_t index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_CACHE_H */
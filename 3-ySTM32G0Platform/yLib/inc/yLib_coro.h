@@ -0,0 +1,197 @@
+/**
+  ******************************************************************************
+  * @file       yLib_coro.h
+  * @brief      无栈协程
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       协程是工作队列中的一个工作项，被唤醒时由工作任务调用协程函数，从上次等待处继续；
+  *             等待点按行号记录在协程中，协程函数返回即让出，所有协程共用工作任务的堆栈；
+  *             唤醒即重新提交工作项，可在中断、定时器回调和其他协程中调用，重复唤醒合并，
+  *             协程运行中被唤醒会再运行一次，不会丢失唤醒；
+  *             等待条件在每次被唤醒时重新求值，条件成立的一方负责唤醒(异步传输完成回调、
+  *             环形队列的生产者、定时器超时)
+  * @attention  局部变量在等待点之间不保留，需要保留的状态放在嵌入协程的结构体中，用container_of取回；
+  *             等待宏展开为以行号为值的case标签，一行最多一个等待宏，协程函数体内不能再用switch跨越等待点
+  ******************************************************************************
+  */
+#ifndef YLIB_CORO_H
+#define YLIB_CORO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+#include "yLib_work.h"
+#include "yLib_timer.h"
+
+/**
+ * @brief 协程函数返回值
+ */
+#define YLIB_CORO_WAITING 0 /* 在等待点让出 */
+#define YLIB_CORO_DONE 1    /* 执行结束 */
+
+/**
+ * @brief 等待宏中从赋值落入case标签，避免-Wimplicit-fallthrough警告
+ */
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define YLIB_CORO_FALLTHROUGH __attribute__((fallthrough))
+#else
+#define YLIB_CORO_FALLTHROUGH
+#endif
+
+struct ylib_coro;
+
+/**
+ * @brief 协程函数
+ * @param co 协程
+ * @return YLIB_CORO_WAITING或YLIB_CORO_DONE，由YLIB_CORO_*宏给出
+ */
+typedef int (*ylib_coro_func_t)(struct ylib_coro *co);
+
+/**
+ * @brief 协程
+ */
+struct ylib_coro {
+    struct ylib_work work;    /* 在执行器(工作队列)中的工作项 */
+    struct ylib_timer timer;  /* 睡眠和等待超时 */
+    ylib_coro_func_t func;    /* 协程函数 */
+    volatile int32_t result;  /* 唤醒方给出的结果，如异步传输状态 */
+    volatile uint32_t value;  /* 唤醒方给出的数值，如实际传输字节数 */
+    uint16_t line;            /* 恢复点行号，0为从头开始 */
+    volatile uint8_t timeout; /* 本次等待已超时 */
+    uint8_t running;          /* 已启动未结束 */
+};
+
+/**
+ * @brief 初始化协程
+ * @param co 协程
+ * @param func 协程函数
+ * @param prio 执行器的工作队列号，见ylib_work_init
+ */
+void ylib_coro_init(struct ylib_coro *co, ylib_coro_func_t func, unsigned int prio);
+
+/**
+ * @brief 从头启动协程
+ * @note 第一次运行在工作任务中；运行中的协程重新启动会从头开始
+ */
+void ylib_coro_start(struct ylib_coro *co);
+
+/**
+ * @brief 停止协程，取消等待中的定时器和尚未执行的唤醒
+ * @note 在协程自己或同一工作队列的其他协程中调用；正在进行的异步传输由调用者取消
+ */
+void ylib_coro_stop(struct ylib_coro *co);
+
+/**
+ * @brief 唤醒协程重新求值等待条件
+ * @note 任务、中断中均可调用，未启动或已结束的协程忽略
+ */
+void ylib_coro_wake(struct ylib_coro *co);
+
+/**
+ * @brief 给出结果并唤醒协程
+ * @param result 写入co->result
+ * @param value 写入co->value
+ */
+void ylib_coro_complete(struct ylib_coro *co, int32_t result, uint32_t value);
+
+/**
+ * @brief 协程是否已启动未结束
+ */
+static inline int ylib_coro_running(const struct ylib_coro *co)
+{
+    return co->running;
+}
+
+/**
+ * @brief 最近一次带超时的等待是否因超时结束
+ */
+static inline int ylib_coro_timed_out(const struct ylib_coro *co)
+{
+    return co->timeout;
+}
+
+/* 协程函数体 */
+
+/**
+ * @brief 协程函数体开始，放在所有等待宏之前
+ */
+#define YLIB_CORO_BEGIN(co)  \
+    switch ((co)->line) {    \
+    case 0:
+
+/**
+ * @brief 协程函数体结束，执行到这里协程结束
+ */
+#define YLIB_CORO_END(co) \
+    }                     \
+    (co)->line = 0;       \
+    return YLIB_CORO_DONE
+
+/**
+ * @brief 等待条件成立
+ * @note 条件不成立时让出，之后每次被唤醒重新求值
+ */
+#define YLIB_CORO_WAIT_UNTIL(co, cond)      \
+    do {                                    \
+        (co)->line = __LINE__;              \
+        YLIB_CORO_FALLTHROUGH;              \
+    case __LINE__:                          \
+        if (!(cond))                        \
+            return YLIB_CORO_WAITING;       \
+    } while (0)
+
+/**
+ * @brief 等待条件成立或超时
+ * @param ms 超时时间(毫秒)
+ * @note 之后用ylib_coro_timed_out区分；条件和超时同时满足时以条件为准，须重新检查条件
+ */
+#define YLIB_CORO_WAIT_UNTIL_TIMEOUT(co, cond, ms)                 \
+    do {                                                           \
+        ylib_coro_arm((co), (ms));                                 \
+        YLIB_CORO_WAIT_UNTIL((co), (cond) || (co)->timeout);       \
+        ylib_timer_stop(&(co)->timer);                             \
+    } while (0)
+
+/**
+ * @brief 睡眠
+ * @param ms 时间(毫秒)，按定时轮节拍向上取整
+ */
+#define YLIB_CORO_SLEEP(co, ms)                      \
+    do {                                             \
+        ylib_coro_arm((co), (ms));                   \
+        YLIB_CORO_WAIT_UNTIL((co), (co)->timeout);   \
+    } while (0)
+
+/**
+ * @brief 让出一次，排到同一工作队列中已就绪的工作项之后
+ */
+#define YLIB_CORO_YIELD(co)                 \
+    do {                                    \
+        ylib_coro_wake(co);                 \
+        (co)->line = __LINE__;              \
+        return YLIB_CORO_WAITING;           \
+    case __LINE__:;                         \
+    } while (0)
+
+/**
+ * @brief 结束协程
+ */
+#define YLIB_CORO_EXIT(co)     \
+    do {                       \
+        (co)->line = 0;        \
+        return YLIB_CORO_DONE; \
+    } while (0)
+
+/**
+ * @brief 启动超时定时器，供等待宏使用
+ */
+void ylib_coro_arm(struct ylib_coro *co, uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_CORO_H */
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file       yLib_crc.h
+  * @brief      CRC校验
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       CRC-32(ISO-HDLC，与zlib相同)和CRC-16/CCITT-FALSE，默认查表计算；
+  *             平台注册硬件后端后，不短于YLIB_CRC_HW_MIN的数据交给硬件；
+  *             两者均可分段计算，上一段的返回值作为下一段的crc参数
+  ******************************************************************************
+  */
+#ifndef YLIB_CRC_H
+#define YLIB_CRC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+#define YLIB_CRC32_INIT 0x00000000U /* ylib_crc32第一段的crc参数 */
+#define YLIB_CRC16_INIT 0xFFFFU     /* ylib_crc16第一段的crc参数 */
+
+/**
+ * @brief CRC硬件后端，参数和返回值与ylib_crc32/ylib_crc16相同
+ */
+struct ylib_crc_ops {
+    uint32_t (*crc32)(uint32_t crc, const void *data, size_t len); /* CRC-32，NULL表示不支持 */
+    uint16_t (*crc16)(uint16_t crc, const void *data, size_t len); /* CRC-16/CCITT-FALSE，NULL表示不支持 */
+};
+
+/**
+ * @brief 注册CRC硬件后端
+ * @param ops 后端，NULL恢复查表计算
+ * @note 后端须可在任务和中断中调用，硬件忙时自行退回ylib_crc32_sw/ylib_crc16_sw
+ */
+void ylib_crc_register(const struct ylib_crc_ops *ops);
+
+/**
+ * @brief 计算CRC-32
+ * @param crc 上一段结果，第一段传YLIB_CRC32_INIT
+ * @param data 数据
+ * @param len 字节数
+ * @return CRC-32
+ */
+uint32_t ylib_crc32(uint32_t crc, const void *data, size_t len);
+
+/**
+ * @brief 计算CRC-16/CCITT-FALSE
+ * @param crc 上一段结果，第一段传YLIB_CRC16_INIT
+ * @param data 数据
+ * @param len 字节数
+ * @return CRC-16
+ */
+uint16_t ylib_crc16(uint16_t crc, const void *data, size_t len);
+
+/**
+ * @brief 查表计算CRC-32，不经过硬件后端
+ */
+uint32_t ylib_crc32_sw(uint32_t crc, const void *data, size_t len);
+
+/**
+ * @brief 查表计算CRC-16/CCITT-FALSE，不经过硬件后端
+ */
+uint16_t ylib_crc16_sw(uint16_t crc, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_CRC_H */
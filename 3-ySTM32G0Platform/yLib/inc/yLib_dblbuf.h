@@ -0,0 +1,123 @@
+/**
+  ******************************************************************************
+  * @file       yLib_dblbuf.h
+  * @brief      DMA循环采集的多块缓冲
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       DMA循环写入连续的N块存储，每写满一块(半满/全满中断)由生产者登记，消费者按登记顺序
+  *             取出、处理、释放；DMA写到消费者尚未释放的块即为溢出，生产者计数，
+  *             消费者取块时跳过已被覆盖的块，释放时报告持有期间是否被覆盖。
+  *             单生产者(中断)单消费者(任务)，双方各写各的计数，不需要临界区
+  ******************************************************************************
+  */
+#ifndef YLIB_DBLBUF_H
+#define YLIB_DBLBUF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 最大块数，块数须为2的幂次
+ */
+#ifndef YLIB_DBLBUF_MAX
+#define YLIB_DBLBUF_MAX 8
+#endif
+
+/**
+ * @brief 多块缓冲结构体
+ * @note filled和released为自由递增的计数，filled-released即已写满未释放的块数
+ */
+typedef struct ylib_dblbuf {
+    uint8_t *base;                     /* 第一块起始地址，N块连续存放，即DMA循环缓冲区 */
+    uint32_t block_size;               /* 每块字节数 */
+    uint8_t mask;                      /* 块数-1 */
+    volatile uint8_t dma;              /* DMA正在写入的块号(生产者写) */
+    uint8_t order[YLIB_DBLBUF_MAX];    /* 按filled取余登记写满的块号(生产者写) */
+    volatile uint32_t filled;          /* 已写满的块数(生产者写) */
+    volatile uint32_t overruns;        /* DMA进入未释放块的次数(生产者写) */
+    volatile uint32_t released;        /* 已释放的块数(消费者写) */
+    uint32_t late;                     /* 消费者来迟而跳过的块数(消费者写) */
+} ylib_dblbuf_t;
+
+/**
+ * @brief 初始化多块缓冲
+ * @param db 缓冲结构体
+ * @param buffer DMA循环缓冲区，大小为block_size*count
+ * @param block_size 每块字节数
+ * @param count 块数，2~YLIB_DBLBUF_MAX且为2的幂次
+ * @return 0成功，-1参数错误
+ */
+int ylib_dblbuf_init(ylib_dblbuf_t *db, void *buffer, uint32_t block_size, unsigned int count);
+
+/**
+ * @brief 清空登记和统计，DMA从第0块开始
+ * @param db 缓冲结构体
+ * @note DMA停止且消费者不在访问时调用
+ */
+void ylib_dblbuf_reset(ylib_dblbuf_t *db);
+
+/**
+ * @brief 登记一块写满
+ * @param db 缓冲结构体
+ * @param block 写满的块号，半满中断为0、全满中断为1(N=2)
+ * @return 写满的块起始地址
+ * @note 生产者在DMA中断中调用；以中断给出的块号登记，DMA重启回到第0块时顺序依然正确
+ */
+void *ylib_dblbuf_produce(ylib_dblbuf_t *db, unsigned int block);
+
+/**
+ * @brief 取最早写满的块
+ * @param db 缓冲结构体
+ * @return 块起始地址，没有写满的块返回NULL
+ * @note 消费者调用，处理完调用ylib_dblbuf_release；已被DMA覆盖的块跳过并计入late，
+ *       重复调用返回同一块
+ */
+void *ylib_dblbuf_acquire(ylib_dblbuf_t *db);
+
+/**
+ * @brief 释放ylib_dblbuf_acquire取得的块
+ * @param db 缓冲结构体
+ * @return 1块在持有期间完整，0持有期间已被DMA覆盖，处理结果应丢弃
+ */
+int ylib_dblbuf_release(ylib_dblbuf_t *db);
+
+/**
+ * @brief 已写满未释放的块数
+ * @param db 缓冲结构体
+ * @return 块数，超过块数-1时最早的块已被覆盖
+ */
+static inline unsigned int ylib_dblbuf_pending(const ylib_dblbuf_t *db)
+{
+    return db->filled - db->released;
+}
+
+/**
+ * @brief DMA正在写入的块号
+ * @param db 缓冲结构体
+ * @return 块号
+ */
+static inline unsigned int ylib_dblbuf_dma_block(const ylib_dblbuf_t *db)
+{
+    return db->dma;
+}
+
+/**
+ * @brief 块起始地址
+ * @param db 缓冲结构体
+ * @param block 块号
+ * @return 起始地址
+ */
+static inline void *ylib_dblbuf_block(const ylib_dblbuf_t *db, unsigned int block)
+{
+    return db->base + (block & db->mask) * db->block_size;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_DBLBUF_H */
@@ -63,6 +63,22 @@ extern "C"
 #error "当前编译器不受支持！"
 #endif
 
+/**
+ * @brief RAM函数属性
+ * @note 放入链接脚本收集到.data中的.RamFunc段，避开Flash等待周期；
+ *       禁止内联，否则函数体会被复制回Flash中的调用者；
+ *       只用于中断入口和内层循环，RAM函数调用Flash中的函数仍要取指
+ */
+#if YLIB_RAMFUNC_ENABLE
+#if defined(__IAR_SYSTEMS_ICC__)
+#define YLIB_RAMFUNC __ramfunc
+#else
+#define YLIB_RAMFUNC __attribute__((section(".RamFunc"), noinline))
+#endif
+#else
+#define YLIB_RAMFUNC
+#endif
+
 /**
  * @brief 宏连接和命名工具
  */
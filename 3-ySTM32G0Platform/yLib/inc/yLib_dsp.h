@@ -0,0 +1,234 @@
+/**
+  ******************************************************************************
+  * @file       yLib_dsp.h
+  * @brief      定点数学与滤波(Q15/Q31)
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       G070没有FPU，软件浮点每次运算数百周期；这里全部用整数运算：
+  *             Q15为int16_t表示[-1, 1)，Q31为int32_t表示[-1, 1)；乘加饱和不回绕；
+  *             倒数和平方根用查表初值加牛顿迭代，迭代只用乘法(M0+没有除法指令)；
+  *             FIR和双二阶IIR按缓冲区处理，每个样本的周期数固定，可在ADC半块回调中直接调用
+  ******************************************************************************
+  */
+#ifndef YLIB_DSP_H
+#define YLIB_DSP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+typedef int16_t ylib_q15_t;
+typedef int32_t ylib_q31_t;
+
+#define YLIB_Q15_MAX ((ylib_q15_t)0x7FFF)
+#define YLIB_Q15_MIN ((ylib_q15_t)-0x8000)
+#define YLIB_Q31_MAX ((ylib_q31_t)0x7FFFFFFF)
+#define YLIB_Q31_MIN ((ylib_q31_t)(-0x7FFFFFFF - 1))
+
+/**
+ * @brief 由常量生成Q15/Q31值，四舍五入
+ * @note 只用于编译期常量(如滤波器系数)，运行时变量会引入软件浮点
+ */
+#define YLIB_Q15(x) ((ylib_q15_t)((x) >= 0.99996948 ? 32767 : (x) * 32768.0 + ((x) >= 0 ? 0.5 : -0.5)))
+#define YLIB_Q31(x) ((ylib_q31_t)((x) >= 0.9999999995 ? 2147483647.0 : (x) * 2147483648.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+/**
+ * @brief 角度：一整圈为65536，即1 = 2π/65536
+ */
+typedef uint16_t ylib_angle_t;
+
+#define YLIB_ANGLE_DEG(deg) ((ylib_angle_t)((deg) * 65536L / 360))
+
+YLIB_INLINE ylib_q15_t ylib_q15_sat(int32_t x)
+{
+    if (x > YLIB_Q15_MAX)
+        return YLIB_Q15_MAX;
+    if (x < YLIB_Q15_MIN)
+        return YLIB_Q15_MIN;
+    return (ylib_q15_t)x;
+}
+
+YLIB_INLINE ylib_q31_t ylib_q31_sat(int64_t x)
+{
+    if (x > YLIB_Q31_MAX)
+        return YLIB_Q31_MAX;
+    if (x < YLIB_Q31_MIN)
+        return YLIB_Q31_MIN;
+    return (ylib_q31_t)x;
+}
+
+YLIB_INLINE ylib_q15_t ylib_q15_add(ylib_q15_t a, ylib_q15_t b)
+{
+    return ylib_q15_sat((int32_t)a + b);
+}
+
+YLIB_INLINE ylib_q15_t ylib_q15_sub(ylib_q15_t a, ylib_q15_t b)
+{
+    return ylib_q15_sat((int32_t)a - b);
+}
+
+/**
+ * @brief Q15乘法，四舍五入，-1*-1饱和为最大值
+ */
+YLIB_INLINE ylib_q15_t ylib_q15_mul(ylib_q15_t a, ylib_q15_t b)
+{
+    return ylib_q15_sat(((int32_t)a * b + 0x4000) >> 15);
+}
+
+YLIB_INLINE ylib_q31_t ylib_q31_add(ylib_q31_t a, ylib_q31_t b)
+{
+    return ylib_q31_sat((int64_t)a + b);
+}
+
+YLIB_INLINE ylib_q31_t ylib_q31_sub(ylib_q31_t a, ylib_q31_t b)
+{
+    return ylib_q31_sat((int64_t)a - b);
+}
+
+/**
+ * @brief Q31乘法，四舍五入，-1*-1饱和为最大值
+ * @note 32x32->64位乘法在M0+上由libgcc的__aeabi_lmul完成，约二十多个周期
+ */
+YLIB_INLINE ylib_q31_t ylib_q31_mul(ylib_q31_t a, ylib_q31_t b)
+{
+    return ylib_q31_sat(((int64_t)a * b + 0x40000000) >> 31);
+}
+
+/**
+ * @brief Q31与Q15相乘，结果为Q31
+ */
+YLIB_INLINE ylib_q31_t ylib_q31_mul_q15(ylib_q31_t a, ylib_q15_t b)
+{
+    return ylib_q31_sat(((int64_t)a * b + 0x4000) >> 15);
+}
+
+YLIB_INLINE ylib_q15_t ylib_q31_to_q15(ylib_q31_t x)
+{
+    return ylib_q15_sat((x >> 16) + ((x >> 15) & 1));
+}
+
+YLIB_INLINE ylib_q31_t ylib_q15_to_q31(ylib_q15_t x)
+{
+    return (ylib_q31_t)x << 16;
+}
+
+/**
+ * @brief 倒数
+ * @param d 除数，不能为0
+ * @param shift 输出移位数
+ * @return m，1/d ≈ m / 2^shift，m在[2^30, 2^31]内，相对误差约2^-30
+ * @note 同一个除数反复使用时先求倒数，之后每次除法变成一次乘法和移位，见ylib_recip_mul
+ */
+uint32_t ylib_recip(uint32_t d, unsigned int *shift);
+
+/**
+ * @brief 以ylib_recip的结果计算n/d，四舍五入
+ */
+YLIB_INLINE uint32_t ylib_recip_mul(uint32_t n, uint32_t m, unsigned int shift)
+{
+    return (uint32_t)(((uint64_t)n * m + ((uint64_t)1 << (shift - 1))) >> shift);
+}
+
+/**
+ * @brief Q15除法num/den，结果超出[-1, 1)时饱和
+ * @param den 不能为0
+ */
+ylib_q15_t ylib_q15_div(ylib_q15_t num, ylib_q15_t den);
+
+/**
+ * @brief 整数平方根
+ * @return floor(sqrt(x))
+ */
+uint32_t ylib_sqrt_u32(uint32_t x);
+
+/**
+ * @brief Q15平方根，负数返回0
+ */
+ylib_q15_t ylib_q15_sqrt(ylib_q15_t x);
+
+/**
+ * @brief Q31平方根，四舍五入，负数返回0
+ */
+ylib_q31_t ylib_q31_sqrt(ylib_q31_t x);
+
+/**
+ * @brief 正弦，四分之一周期129点表线性插值，误差约1 LSB
+ * @param angle 角度，一整圈为65536
+ * @return sin(angle)，Q15
+ */
+ylib_q15_t ylib_q15_sin(ylib_angle_t angle);
+
+/**
+ * @brief 余弦
+ */
+YLIB_INLINE ylib_q15_t ylib_q15_cos(ylib_angle_t angle)
+{
+    return ylib_q15_sin((ylib_angle_t)(angle + 0x4000U));
+}
+
+/**
+ * @brief Q15 FIR滤波器
+ * @note 状态数组长度为2*taps，每个样本同时写入两个位置，卷积窗口总是连续的，不需要取模
+ */
+struct ylib_fir_q15 {
+    const ylib_q15_t *coeffs; /* 系数b[0..taps-1]，b[0]乘最新样本 */
+    ylib_q15_t *state;        /* 历史样本，长度2*taps */
+    unsigned int taps;        /* 阶数+1 */
+    unsigned int pos;         /* 下一个样本的写入位置 */
+};
+
+/**
+ * @brief 初始化FIR滤波器，历史样本清零
+ * @param fir 滤波器
+ * @param coeffs 系数，长度taps
+ * @param state 状态数组，长度2*taps
+ * @param taps 系数个数
+ */
+void ylib_fir_q15_init(struct ylib_fir_q15 *fir, const ylib_q15_t *coeffs, ylib_q15_t *state,
+                       unsigned int taps);
+
+/**
+ * @brief FIR滤波一段样本
+ * @param fir 滤波器
+ * @param in 输入
+ * @param out 输出，可以与in相同
+ * @param n 样本数
+ * @note 64位累加，结果舍入后饱和到Q15
+ */
+void ylib_fir_q15_process(struct ylib_fir_q15 *fir, const ylib_q15_t *in, ylib_q15_t *out,
+                          unsigned int n);
+
+/**
+ * @brief Q15级联双二阶IIR滤波器(直接I型)
+ * @note 每级系数{b0, b1, b2, a1, a2}，差分方程y = b0*x + b1*x1 + b2*x2 + a1*y1 + a2*y2，
+ *       a1/a2与常见写法符号相反(与CMSIS-DSP相同)；系数按2^-shift缩小存放，
+ *       |a1|可达2时取shift=1
+ */
+struct ylib_biquad_q15 {
+    const ylib_q15_t *coeffs; /* 系数，5*stages个 */
+    ylib_q15_t *state;        /* 每级{x1, x2, y1, y2}，4*stages个 */
+    unsigned int stages;      /* 级数 */
+    unsigned int shift;       /* 系数缩小的位数 */
+};
+
+/**
+ * @brief 初始化双二阶IIR滤波器，状态清零
+ */
+void ylib_biquad_q15_init(struct ylib_biquad_q15 *iir, const ylib_q15_t *coeffs, ylib_q15_t *state,
+                          unsigned int stages, unsigned int shift);
+
+/**
+ * @brief 双二阶IIR滤波一段样本
+ * @param out 输出，可以与in相同
+ */
+void ylib_biquad_q15_process(struct ylib_biquad_q15 *iir, const ylib_q15_t *in, ylib_q15_t *out,
+                             unsigned int n);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_DSP_H */
@@ -16,6 +16,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include "yLib_def.h"
+#include "yLib_span.h"
 
 /**
  * @brief FIFO队列结构体
@@ -152,6 +153,44 @@ unsigned int ylib_fifo_peek(struct ylib_fifo *fifo, void *buffer,
  */
 unsigned int ylib_fifo_skip(struct ylib_fifo *fifo, unsigned int len);
 
+/**
+ * @brief 预留可直接写入的空闲区域
+ * @param fifo FIFO指针
+ * @param len 希望预留的元素个数
+ * @param span 区域输出，跨越缓冲区末尾时为两段
+ * @param element_size 元素大小
+ * @return 实际预留的元素个数
+ * @note 适合DMA或协议解析直接写入，写完后调用ylib_fifo_commit
+ */
+unsigned int ylib_fifo_reserve(struct ylib_fifo *fifo, unsigned int len,
+                               ylib_span_t *span, size_t element_size);
+
+/**
+ * @brief 发布已写入预留区域的元素
+ * @param fifo FIFO指针
+ * @param len 元素个数，不超过预留的个数
+ */
+void ylib_fifo_commit(struct ylib_fifo *fifo, unsigned int len);
+
+/**
+ * @brief 获取可直接读取的数据区域
+ * @param fifo FIFO指针
+ * @param len 希望读取的元素个数
+ * @param span 区域输出，跨越缓冲区末尾时为两段
+ * @param element_size 元素大小
+ * @return 实际可读的元素个数
+ * @note 读完后调用ylib_fifo_release
+ */
+unsigned int ylib_fifo_peek_linear(struct ylib_fifo *fifo, unsigned int len,
+                                   ylib_span_t *span, size_t element_size);
+
+/**
+ * @brief 释放已读取的元素
+ * @param fifo FIFO指针
+ * @param len 元素个数，不超过peek_linear返回的个数
+ */
+void ylib_fifo_release(struct ylib_fifo *fifo, unsigned int len);
+
 /* 类型安全的宏定义 */
 
 /**
@@ -193,6 +232,47 @@ struct { \
 #define ylib_fifo_get(fifo, val) \
     ylib_fifo_out(&(fifo)->fifo, val, 1, sizeof(*(val)))
 
+/* 静态定义 */
+
+/**
+ * @brief 静态定义FIFO，存储和控制块在编译期分配，无需调用init
+ * @param name FIFO变量名，同时生成name_buffer、name_put(val)和name_get(&val)
+ * @param type 元素类型
+ * @param count 元素个数（必须是2的幂次）
+ * @note name_put/name_get按元素类型直接存取，与ylib_fifo_*接口可混用
+ */
+#define YLIB_FIFO_DEFINE(name, type, count) YLIB_FIFO_DEFINE_ATTR(name, type, count, )
+
+/**
+ * @brief 静态定义FIFO并为存储附加属性
+ * @param attr 存储属性，如__attribute__((section(".noinit")))
+ */
+#define YLIB_FIFO_DEFINE_ATTR(name, type, count, attr)                                      \
+    _Static_assert((count) > 0 && ((count) & ((count) - 1)) == 0, #name " size must be power of 2"); \
+    static type name##_buffer[count] __attribute__((aligned(YLIB_RING_ALIGN))) attr;        \
+    static struct ylib_fifo name = {.mask = (count) - 1, .data = name##_buffer};            \
+    static inline int name##_put(type val)                                                  \
+    {                                                                                       \
+        unsigned int in = name.in;                                                          \
+        if (in - name.out >= (count))                                                       \
+            return 0;                                                                       \
+        name##_buffer[in & ((count) - 1)] = val;                                            \
+        YLIB_RING_BARRIER();                                                                \
+        name.in = in + 1;                                                                   \
+        return 1;                                                                           \
+    }                                                                                       \
+    static inline int name##_get(type *val)                                                 \
+    {                                                                                       \
+        unsigned int out = name.out;                                                        \
+        if (out == name.in)                                                                 \
+            return 0;                                                                       \
+        YLIB_RING_BARRIER();                                                                \
+        *val = name##_buffer[out & ((count) - 1)];                                          \
+        YLIB_RING_BARRIER();                                                                \
+        name.out = out + 1;                                                                 \
+        return 1;                                                                           \
+    }
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
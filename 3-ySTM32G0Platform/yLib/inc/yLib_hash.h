@@ -0,0 +1,173 @@
+/**
+  ******************************************************************************
+  * @file       yLib_hash.h
+  * @brief      开放寻址哈希表
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       线性探测+Robin Hood插入，删除时后移回填，不留墓碑；
+  *             键为整数或字符串指针(不复制字符串，调用者保证其生存期)；
+  *             不带锁，多任务访问时由调用者加锁
+  ******************************************************************************
+  */
+#ifndef YLIB_HASH_H
+#define YLIB_HASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 键类型
+ */
+#define YLIB_HASH_KEY_INT 0 /* 整数键，按值比较 */
+#define YLIB_HASH_KEY_STR 1 /* 字符串键，按内容比较 */
+
+/**
+ * @brief 哈希槽
+ */
+typedef struct {
+    uint32_t hash;  /* 键哈希，0表示空槽 */
+    uintptr_t key;  /* 整数键或字符串指针 */
+    void *value;    /* 值 */
+} ylib_hash_slot_t;
+
+/* 32位目标上为12字节，与红黑树节点开销相同但无需额外的节点分配 */
+_Static_assert(sizeof(ylib_hash_slot_t) <= 3 * sizeof(void *), "ylib_hash_slot_t must fit in three words");
+
+/**
+ * @brief 哈希表
+ */
+struct ylib_hash {
+    ylib_hash_slot_t *slots; /* 槽数组 */
+    uint32_t mask;           /* 槽数-1，槽数为2的幂次 */
+    uint32_t count;          /* 元素个数 */
+    uint8_t key_type;        /* 键类型YLIB_HASH_KEY_xxx */
+    uint8_t dynamic;         /* 槽数组来自堆，可扩容 */
+};
+
+/**
+ * @brief 静态定义哈希表，槽数组在编译期分配，无需调用init
+ * @param name 哈希表变量名，同时生成name_slots
+ * @param count 槽数（必须是2的幂次），可存放count*YLIB_HASH_LOAD_PERCENT/100个元素
+ * @param key_type 键类型YLIB_HASH_KEY_xxx
+ */
+#define YLIB_HASH_DEFINE(name, count, key_type)                                              \
+    _Static_assert((count) > 0 && ((count) & ((count) - 1)) == 0, #name " size must be power of 2"); \
+    static ylib_hash_slot_t name##_slots[count];                                             \
+    static struct ylib_hash name = {name##_slots, (count) - 1, 0, (key_type), 0}
+
+/**
+ * @brief 以调用者提供的槽数组初始化哈希表，不扩容
+ * @param hash 哈希表指针
+ * @param slots 槽数组
+ * @param size 槽数（必须是2的幂次）
+ * @param key_type 键类型
+ * @return 0成功，-1失败
+ */
+int ylib_hash_init(struct ylib_hash *hash, ylib_hash_slot_t *slots, unsigned int size, uint8_t key_type);
+
+/**
+ * @brief 以堆存储创建哈希表，超过装载率时自动扩容
+ * @note YLIB_NO_HEAP_AFTER_INIT下堆封闭后不再扩容，超过装载率的插入返回-1
+ * @param hash 哈希表指针
+ * @param size 初始槽数，向上取整为2的幂次
+ * @param key_type 键类型
+ * @return 0成功，-1内存不足
+ */
+int ylib_hash_create(struct ylib_hash *hash, unsigned int size, uint8_t key_type);
+
+/**
+ * @brief 释放堆存储的槽数组
+ * @param hash 哈希表指针
+ */
+void ylib_hash_destroy(struct ylib_hash *hash);
+
+/**
+ * @brief 清空哈希表
+ * @param hash 哈希表指针
+ */
+void ylib_hash_clear(struct ylib_hash *hash);
+
+/**
+ * @brief 插入或更新
+ * @param hash 哈希表指针
+ * @param key 键
+ * @param value 值
+ * @return 0成功，-1表满(静态存储)或扩容失败
+ */
+int ylib_hash_put(struct ylib_hash *hash, uintptr_t key, void *value);
+
+/**
+ * @brief 查找
+ * @param hash 哈希表指针
+ * @param key 键
+ * @return 值所在位置，未找到返回NULL；插入或删除后失效
+ */
+void **ylib_hash_find(struct ylib_hash *hash, uintptr_t key);
+
+/**
+ * @brief 删除
+ * @param hash 哈希表指针
+ * @param key 键
+ * @param value 被删除的值输出，可为NULL
+ * @return 0成功，-1未找到
+ */
+int ylib_hash_remove(struct ylib_hash *hash, uintptr_t key, void **value);
+
+/**
+ * @brief 遍历
+ * @param hash 哈希表指针
+ * @param iter 遍历位置，首次调用前置0
+ * @return 下一个元素的槽，遍历结束返回NULL
+ * @note 遍历期间不能插入或删除
+ */
+ylib_hash_slot_t *ylib_hash_next(struct ylib_hash *hash, unsigned int *iter);
+
+/**
+ * @brief 获取元素个数
+ * @param hash 哈希表指针
+ * @return 元素个数
+ */
+static inline unsigned int ylib_hash_count(struct ylib_hash *hash)
+{
+    return hash->count;
+}
+
+/**
+ * @brief 查找值
+ * @param hash 哈希表指针
+ * @param key 键
+ * @return 值，未找到返回NULL
+ */
+static inline void *ylib_hash_get(struct ylib_hash *hash, uintptr_t key)
+{
+    void **value = ylib_hash_find(hash, key);
+
+    return value ? *value : NULL;
+}
+
+/* 字符串键 */
+
+static inline int ylib_hash_put_str(struct ylib_hash *hash, const char *key, void *value)
+{
+    return ylib_hash_put(hash, (uintptr_t)key, value);
+}
+
+static inline void *ylib_hash_get_str(struct ylib_hash *hash, const char *key)
+{
+    return ylib_hash_get(hash, (uintptr_t)key);
+}
+
+static inline int ylib_hash_remove_str(struct ylib_hash *hash, const char *key, void **value)
+{
+    return ylib_hash_remove(hash, (uintptr_t)key, value);
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_HASH_H */
@@ -23,10 +23,64 @@ extern "C"
 #define ylib_heap_align_up(size) (((size) + (configBYTE_ALIGNMENT - 1)) & ~(configBYTE_ALIGNMENT - 1))
 #define ylib_heap_align_down(size) ((size) & ~(configBYTE_ALIGNMENT - 1))
 
+/* 分配者编号，用于按所属者统计占用；应用可在YLIB_HEAP_OWNER_USER之后自行编号 */
+#define YLIB_HEAP_OWNER_APP 0  /* ylib_malloc默认归属 */
+#define YLIB_HEAP_OWNER_RTOS 1 /* FreeRTOS内核对象和任务栈 */
+#define YLIB_HEAP_OWNER_USER 2 /* 第一个应用自定义编号 */
+#define YLIB_HEAP_OWNER_UNKNOWN 0xFFu /* 块头已损坏或不属于堆，无法确定分配者 */
+
 /* 魔术数字用于检测内存损坏 */
 #define YLIB_HEAP_MAGIC_FREE 0xDEADBEEF
 #define YLIB_HEAP_MAGIC_ALLOC 0xABCDEF00
 
+/* 尾部哨兵，实际写入值与块地址异或，整块拷贝到别处时也能发现 */
+#if configHEAP_GUARD_ENABLE
+#if !configHEAP_CHECK_ENABLE
+#error "configHEAP_GUARD_ENABLE需要configHEAP_CHECK_ENABLE"
+#endif
+#define YLIB_HEAP_GUARD_WORD 0x5AFEC0DEu
+#define YLIB_HEAP_GUARD_SIZE sizeof(uint32_t)
+#else
+#define YLIB_HEAP_GUARD_SIZE 0u
+#endif
+
+/* 损坏类型 */
+#define YLIB_HEAP_FAULT_HEADER 1u /* 块头魔术数字、大小或标志错误 */
+#define YLIB_HEAP_FAULT_GUARD 2u  /* 尾部哨兵被改写，块内越界写 */
+#define YLIB_HEAP_FAULT_LINK 3u   /* 空闲链表指针越界或计数不符 */
+
+#if configHEAP_USE_TLSF
+/* TLSF两级索引参数：二级按SL_COUNT等分，一级覆盖到2^(FL_MAX+1)字节 */
+#if configBYTE_ALIGNMENT == 4
+#define YLIB_TLSF_ALIGN_LOG2 (2)
+#elif configBYTE_ALIGNMENT == 8
+#define YLIB_TLSF_ALIGN_LOG2 (3)
+#else
+#error "TLSF堆只支持4或8字节对齐"
+#endif
+#define YLIB_TLSF_SL_COUNT (1U << configHEAP_TLSF_SL_LOG2)
+#define YLIB_TLSF_FL_SHIFT (configHEAP_TLSF_SL_LOG2 + YLIB_TLSF_ALIGN_LOG2)
+#define YLIB_TLSF_FL_COUNT (configHEAP_TLSF_FL_MAX - YLIB_TLSF_FL_SHIFT + 2)
+
+    /**
+     * @brief 内存块头结构(TLSF)
+     * @note 空闲块的前后链表指针存放在用户区开头，已分配块只占用头部
+     */
+    typedef struct ylib_block_link
+    {
+        struct ylib_block_link *prev_phys_block; /* 物理相邻的前一块，仅前一块空闲时有效 */
+        size_t block_size;                       /* 块大小（包含头部），低两位为本块/前一块空闲标志 */
+#if configHEAP_CHECK_ENABLE
+        uint32_t magic; /* 魔术数字 */
+#endif
+#if configHEAP_CHECK_ENABLE || configHEAP_OWNER_MAX
+        uint32_t owner; /* 分配者编号，仅已分配块有效；同时保持头部按8字节对齐 */
+#endif
+#if configHEAP_OWNER_MAX && !configHEAP_CHECK_ENABLE
+        uint32_t reserved; /* 保持头部按8字节对齐 */
+#endif
+    } ylib_block_link_t;
+#else
     /**
      * @brief 内存块头结构
      */
@@ -36,8 +90,12 @@ extern "C"
         size_t block_size;                       /* 块大小（包含头部） */
 #if configHEAP_CHECK_ENABLE
         uint32_t magic; /* 魔术数字 */
+#endif
+#if configHEAP_OWNER_MAX
+        uint32_t owner; /* 分配者编号，仅已分配块有效 */
 #endif
     } ylib_block_link_t;
+#endif
 
     /**
      * @brief 堆统计信息
@@ -52,6 +110,11 @@ extern "C"
         size_t min_block_size;              /* 最小空闲块大小 */
         size_t successful_allocations;      /* 成功分配次数 */
         size_t successful_frees;            /* 成功释放次数 */
+        uint32_t largest_free_permille;     /* 最大空闲块占空闲总量的千分比，越低碎片越严重 */
+#if configHEAP_OWNER_MAX
+        size_t owner_in_use[configHEAP_OWNER_MAX]; /* 各分配者当前占用(含块头) */
+        size_t owner_peak[configHEAP_OWNER_MAX];   /* 各分配者历史最大占用 */
+#endif
     } ylib_heap_stats_t;
 
     /**
@@ -61,14 +124,34 @@ extern "C"
     {
         uint8_t *heap_start;                 /* 堆起始地址 */
         uint8_t *heap_end;                   /* 堆结束地址 */
+#if configHEAP_USE_TLSF
+        uint32_t fl_bitmap;                                                   /* 非空一级索引位图 */
+        uint32_t sl_bitmap[YLIB_TLSF_FL_COUNT];                               /* 各一级索引下非空二级索引位图 */
+        ylib_block_link_t *blocks[YLIB_TLSF_FL_COUNT][YLIB_TLSF_SL_COUNT]; /* 分级空闲链表头 */
+#else
         ylib_block_link_t *free_blocks_list; /* 空闲块链表 */
+#endif
         size_t heap_size;                    /* 堆大小 */
         bool initialized;                    /* 初始化标志 */
+#if configHEAP_CHECK_ENABLE
+        ylib_block_link_t *scrub; /* 后台巡检游标，指向下一个待查块头，NULL表示从头开始 */
+#endif
 #if configHEAP_STATS_ENABLE
         ylib_heap_stats_t stats; /* 堆统计信息 */
 #endif
     } ylib_heap_t;
 
+    /**
+     * @brief 损坏报告
+     */
+    typedef struct
+    {
+        void *block;     /* 损坏位置：堆块为块头地址，内存分区为存放错误链表指针的空闲块，NULL表示控制块 */
+        void *pool;      /* 所在内存分区(YLIB_MEM *)，堆块为NULL */
+        uint32_t owner;  /* 分配者编号，无法确定时为YLIB_HEAP_OWNER_UNKNOWN */
+        uint32_t reason; /* 损坏类型YLIB_HEAP_FAULT_xxx */
+    } ylib_heap_fault_t;
+
     /* 全局堆管理器实例 */
     extern ylib_heap_t g_ylib_heap;
 
@@ -89,12 +172,38 @@ extern "C"
      */
     void *ylib_malloc(size_t wanted_size);
 
+    /**
+     * @brief 按所属者分配内存
+     * @param wanted_size 请求的内存大小
+     * @param owner 分配者编号，超出configHEAP_OWNER_MAX时计入YLIB_HEAP_OWNER_APP
+     * @return 分配的内存指针，失败返回NULL
+     * @note realloc搬移后沿用原块的所属者
+     */
+    void *ylib_malloc_owner(size_t wanted_size, uint8_t owner);
+
+    /**
+     * @brief 按所属者分配内存并指定调用者地址
+     * @param wanted_size 请求的内存大小
+     * @param owner 分配者编号
+     * @param caller 调用者地址，原样传给分配钩子
+     * @return 分配的内存指针，失败返回NULL
+     * @note 供再封装一层的分配接口(如pvPortMalloc)把自己的返回地址传下来
+     */
+    void *ylib_malloc_from(size_t wanted_size, uint8_t owner, const void *caller);
+
     /**
      * @brief 释放内存
      * @param pv 要释放的内存指针
      */
     void ylib_free(void *pv);
 
+    /**
+     * @brief 释放内存并指定调用者地址
+     * @param pv 要释放的内存指针
+     * @param caller 调用者地址，原样传给释放钩子
+     */
+    void ylib_free_from(void *pv, const void *caller);
+
     /**
      * @brief 重新分配内存
      * @param pv 原内存指针
@@ -111,6 +220,27 @@ extern "C"
      */
     void *ylib_calloc(size_t num, size_t size);
 
+#if YLIB_NO_HEAP_AFTER_INIT
+    /**
+     * @brief 封闭堆，之后的分配都进入ylib_heap_seal_trap()
+     * @note 初始化完成后调用一次，不可撤销
+     */
+    void ylib_heap_seal(void);
+
+    /**
+     * @brief 堆是否已封闭
+     * @return 1已封闭，0未封闭
+     */
+    int ylib_heap_sealed(void);
+
+    /**
+     * @brief 封闭后分配的处理，弱定义，默认记录调用者后关中断停机
+     * @param caller 调用分配接口处的返回地址
+     * @note 应用可重新定义为写故障记录后复位，不得返回
+     */
+    void ylib_heap_seal_trap(const void *caller) __attribute__((noreturn));
+#endif
+
     /**
      * @brief 获取空闲堆大小
      * @return 空闲堆大小
@@ -142,6 +272,33 @@ extern "C"
      * @brief 打印堆信息（调试用）
      */
     void ylib_heap_print_info(void);
+
+    /**
+     * @brief 增量巡检堆
+     * @param budget 本次最多检查的块数
+     * @return 1完成一整遍并回到堆头，0本次未查完，-1发现损坏或已有损坏记录
+     * @note 每检查一块进出一次临界区；分配释放引起的合并会同步移动游标，无需从头重查
+     */
+    int ylib_heap_scrub(uint32_t budget);
+
+    /**
+     * @brief 报告损坏，只记录第一次，之后的报告和巡检都被忽略直到清除
+     * @param fault 损坏信息
+     * @note 供堆和内存分区内部调用，同时转交损坏钩子
+     */
+    void ylib_heap_report_fault(const ylib_heap_fault_t *fault);
+
+    /**
+     * @brief 获取记录的第一次损坏
+     * @param fault 损坏信息输出，可为NULL
+     * @return 1有记录，0无
+     */
+    int ylib_heap_get_fault(ylib_heap_fault_t *fault);
+
+    /**
+     * @brief 清除损坏记录，巡检重新开始
+     */
+    void ylib_heap_clear_fault(void);
 #endif
 
     /* 高级API */
@@ -159,15 +316,19 @@ extern "C"
      * 具体实现和完整API请参考 yLib_mempool.h
      */
 
-    /* 钩子函数类型定义 */
+    /* 钩子函数类型定义
+     * size为块可用大小；caller为调用分配/释放接口处的返回地址(Thumb下最低位为1)；
+     * realloc原地调整大小时依次调用释放钩子和分配钩子；钩子在堆锁外调用，可能在中断中 */
     typedef void (*ylib_malloc_failed_hook_t)(void);
-    typedef void (*ylib_free_hook_t)(void *pv, size_t size);
-    typedef void (*ylib_malloc_hook_t)(void *pv, size_t size);
+    typedef void (*ylib_free_hook_t)(void *pv, size_t size, const void *caller);
+    typedef void (*ylib_malloc_hook_t)(void *pv, size_t size, const void *caller);
+    typedef void (*ylib_fault_hook_t)(const ylib_heap_fault_t *fault); /* 第一次发现损坏时调用，可能在中断中 */
 
     /* 钩子函数设置 */
     void ylib_set_malloc_failed_hook(ylib_malloc_failed_hook_t hook);
     void ylib_set_free_hook(ylib_free_hook_t hook);
     void ylib_set_malloc_hook(ylib_malloc_hook_t hook);
+    void ylib_set_fault_hook(ylib_fault_hook_t hook);
 
     /* 内部辅助函数 */
     static inline void *ylib_heap_get_user_ptr(ylib_block_link_t *block)
@@ -180,11 +341,7 @@ extern "C"
         return (ylib_block_link_t *)((uint8_t *)user_ptr - sizeof(ylib_block_link_t));
     }
 
-/* 快速分配宏（类似FreeRTOS） */
-#define pvPortMalloc(size) ylib_malloc(size)
-#define vPortFree(ptr) ylib_free(ptr)
-#define xPortGetFreeHeapSize() ylib_get_free_heap_size()
-#define xPortGetMinimumEverFreeHeapSize() ylib_get_minimum_ever_free_heap_size()
+/* FreeRTOS的pvPortMalloc/vPortFree由freeRTOS/src/heap_ylib.c实现，与yLib共用同一个堆 */
 
 #ifdef __cplusplus
 }
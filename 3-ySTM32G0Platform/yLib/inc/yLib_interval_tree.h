@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file       yLib_interval_tree.h
+  * @brief      区间树（基于增强红黑树）
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       按起点排序，每个节点保存子树中最大的终点；区间为闭区间[start, last]，
+  *             可以重叠；查询与[start, last]相交的全部区间为O(log n + k)；不带锁
+  ******************************************************************************
+  */
+#ifndef YLIB_INTERVAL_TREE_H
+#define YLIB_INTERVAL_TREE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_rbtree.h"
+
+/**
+ * @brief 区间树节点，嵌入在元素结构体中
+ */
+struct ylib_interval_node {
+    struct ylib_rb_node rb; /* 红黑树节点 */
+    uint32_t start;         /* 起点 */
+    uint32_t last;          /* 终点(含) */
+    uint32_t subtree_last;  /* 子树中最大的终点 */
+};
+
+/**
+ * @brief 插入区间
+ * @param node 节点指针，调用者已设置start和last
+ * @param root 树根指针
+ */
+void ylib_interval_tree_insert(struct ylib_interval_node *node, struct ylib_rb_root_cached *root);
+
+/**
+ * @brief 删除区间
+ * @param node 节点指针
+ * @param root 树根指针
+ */
+void ylib_interval_tree_remove(struct ylib_interval_node *node, struct ylib_rb_root_cached *root);
+
+/**
+ * @brief 查找第一个与[start, last]相交的区间
+ * @param root 树根指针
+ * @param start 查询起点
+ * @param last 查询终点(含)
+ * @return 起点最小的相交区间，没有时返回NULL
+ */
+struct ylib_interval_node *ylib_interval_tree_iter_first(struct ylib_rb_root_cached *root,
+                                                         uint32_t start, uint32_t last);
+
+/**
+ * @brief 查找下一个与[start, last]相交的区间
+ * @param node 上一个结果
+ * @param start 查询起点
+ * @param last 查询终点(含)
+ * @return 下一个相交区间，没有时返回NULL
+ */
+struct ylib_interval_node *ylib_interval_tree_iter_next(struct ylib_interval_node *node,
+                                                        uint32_t start, uint32_t last);
+
+/**
+ * @brief 遍历与[start, last]相交的区间
+ * @param pos 当前节点指针
+ * @param root 树根指针
+ * @param start 查询起点
+ * @param last 查询终点(含)
+ * @note 遍历中删除pos前需先取下一个
+ */
+#define ylib_interval_tree_for_each(pos, root, start, last)                \
+    for (pos = ylib_interval_tree_iter_first(root, start, last); pos;      \
+         pos = ylib_interval_tree_iter_next(pos, start, last))
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_INTERVAL_TREE_H */
@@ -150,6 +150,23 @@ static inline int ylib_list_empty(const struct ylib_list_head *head)
     return head->next == head;
 }
 
+/**
+ * @brief 把整条链表接到另一条链表尾部，并把原链表置空
+ * @param list 被移走的链表头
+ * @param head 目标链表头
+ */
+static inline void ylib_list_splice_tail_init(struct ylib_list_head *list,
+                                              struct ylib_list_head *head)
+{
+    if (!ylib_list_empty(list)) {
+        list->next->prev = head->prev;
+        head->prev->next = list->next;
+        list->prev->next = head;
+        head->prev = list->prev;
+        YLIB_INIT_LIST_HEAD(list);
+    }
+}
+
 /**
  * @brief 获取包含链表节点的结构体指针
  * @param ptr 链表节点指针
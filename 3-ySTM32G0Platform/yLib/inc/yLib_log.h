@@ -0,0 +1,178 @@
+/**
+  ******************************************************************************
+  * @file       yLib_log.h
+  * @brief      延迟格式化的二进制日志
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       调用处只把格式串编号、时间戳和最多4个32位参数写入静态字环，不做任何格式化；
+  *             格式串放在ylib_log_fmt段，编号即相对段起始的偏移，由低优先级任务在设备上展开，
+  *             或原样发给上位机，由tools/log_decode.py对照ELF展开。
+  *             参数一律按32位整数保存：支持%d/%u/%x/%c/%p，%s只适用于常量字符串(保存的是指针)，
+  *             不支持浮点和64位参数
+  ******************************************************************************
+  */
+#ifndef YLIB_LOG_H
+#define YLIB_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 日志级别
+ */
+enum ylib_log_level {
+    YLIB_LOG_DEBUG = 0,
+    YLIB_LOG_INFO = 1,
+    YLIB_LOG_WARN = 2,
+    YLIB_LOG_ERROR = 3,
+};
+
+#define YLIB_LOG_ARGS_MAX 4         /* 每条记录的参数个数上限 */
+#define YLIB_LOG_ID_LOST 0xFFFFU    /* 丢失记录的编号，参数为丢弃条数，由记录器自动插入 */
+
+/**
+ * @brief 记录头：位0~15格式串编号，位16~18参数个数，位20~21级别，高8位为0
+ * @note 高位为0保证记录头不会是0xFFFFFFFF，存到Flash时可据此找到写入位置
+ */
+#define YLIB_LOG_HDR(id, nargs, level) \
+    ((uint32_t)(id) | ((uint32_t)(nargs) << 16) | ((uint32_t)(level) << 20))
+#define YLIB_LOG_HDR_ID(hdr) ((hdr) & 0xFFFFU)
+#define YLIB_LOG_HDR_NARGS(hdr) (((hdr) >> 16) & 0x7U)
+#define YLIB_LOG_HDR_LEVEL(hdr) (((hdr) >> 20) & 0x3U)
+
+/**
+ * @brief 一条记录的字数：记录头、时间戳和参数
+ */
+#define YLIB_LOG_REC_WORDS(hdr) (2U + YLIB_LOG_HDR_NARGS(hdr))
+
+/**
+ * @brief 格式串段的起止，固件由链接脚本定义，主机由链接器按段名生成
+ */
+extern const char __start_ylib_log_fmt[];
+extern const char __stop_ylib_log_fmt[];
+
+/**
+ * @brief 运行时级别门限，低于它的日志只有一次读和判断
+ */
+extern volatile uint8_t ylib_log_threshold;
+
+/**
+ * @brief 写入一条记录
+ * @param hdr 记录头，见YLIB_LOG_HDR
+ * @param args 参数，个数由记录头给出
+ * @note 一般通过YLIB_LOG调用；可在任务和中断中调用，只在一次短临界区内取时间戳和写入
+ */
+void ylib_log_write(uint32_t hdr, const uint32_t *args);
+
+/**
+ * @brief 只用于编译期检查格式串和参数类型，从不调用
+ */
+__attribute__((format(printf, 1, 2))) YLIB_INLINE void ylib_log_check(const char *fmt, ...)
+{
+    (void)fmt;
+}
+
+#define YLIB_LOG_NARGS(...) YLIB_LOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define YLIB_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+#define YLIB_LOG_CAT(a, b) YLIB_LOG_CAT_(a, b)
+#define YLIB_LOG_CAT_(a, b) a##b
+#define YLIB_LOG_U32(x) ((uint32_t)(uintptr_t)(x))
+#define YLIB_LOG_ARGS_0() NULL
+#define YLIB_LOG_ARGS_1(a) ((const uint32_t[]){YLIB_LOG_U32(a)})
+#define YLIB_LOG_ARGS_2(a, b) ((const uint32_t[]){YLIB_LOG_U32(a), YLIB_LOG_U32(b)})
+#define YLIB_LOG_ARGS_3(a, b, c) ((const uint32_t[]){YLIB_LOG_U32(a), YLIB_LOG_U32(b), YLIB_LOG_U32(c)})
+#define YLIB_LOG_ARGS_4(a, b, c, d) \
+    ((const uint32_t[]){YLIB_LOG_U32(a), YLIB_LOG_U32(b), YLIB_LOG_U32(c), YLIB_LOG_U32(d)})
+
+#if YLIB_LOG_ENABLE
+/**
+ * @brief 记录一条日志
+ * @param level 级别，低于YLIB_LOG_LEVEL_MIN的在编译期去掉
+ * @param fmt 格式串字面量
+ * @note 格式串和参数类型按printf检查，不进入RAM也不在运行时解析
+ */
+#define YLIB_LOG(level, fmt, ...)                                                                \
+    do {                                                                                         \
+        _Static_assert(YLIB_LOG_NARGS(__VA_ARGS__) <= YLIB_LOG_ARGS_MAX, "too many log arguments"); \
+        if ((level) >= YLIB_LOG_LEVEL_MIN && (level) >= ylib_log_threshold) {                    \
+            static const char ylib_log_fmt_[] YLIB_SECTION("ylib_log_fmt") = fmt;                \
+            if (0)                                                                               \
+                ylib_log_check(fmt, ##__VA_ARGS__);                                              \
+            ylib_log_write(YLIB_LOG_HDR(ylib_log_fmt_ - __start_ylib_log_fmt,                    \
+                                        YLIB_LOG_NARGS(__VA_ARGS__), (level)),                   \
+                           YLIB_LOG_CAT(YLIB_LOG_ARGS_, YLIB_LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)); \
+        }                                                                                        \
+    } while (0)
+#else
+#define YLIB_LOG(level, fmt, ...) \
+    do {                          \
+    } while (0)
+#endif
+
+#define YLIB_LOGD(fmt, ...) YLIB_LOG(YLIB_LOG_DEBUG, fmt, ##__VA_ARGS__)
+#define YLIB_LOGI(fmt, ...) YLIB_LOG(YLIB_LOG_INFO, fmt, ##__VA_ARGS__)
+#define YLIB_LOGW(fmt, ...) YLIB_LOG(YLIB_LOG_WARN, fmt, ##__VA_ARGS__)
+#define YLIB_LOGE(fmt, ...) YLIB_LOG(YLIB_LOG_ERROR, fmt, ##__VA_ARGS__)
+
+/**
+ * @brief 注册时间戳时钟
+ * @param now 读取32位自由递增计数的函数，须可在中断和关中断时调用
+ * @param hz 时钟频率，随导出数据一起给解码器
+ */
+void ylib_log_register_clock(uint32_t (*now)(void), uint32_t hz);
+
+/**
+ * @brief 时钟频率，未注册时为0
+ */
+uint32_t ylib_log_clock_hz(void);
+
+/**
+ * @brief 注册积压通知
+ * @param notify 队列占用超过一半时调用，可能在中断中调用；NULL取消
+ * @note 消费任务平时可以长周期轮询，突发日志时由它提前唤醒
+ */
+void ylib_log_register_notify(void (*notify)(void));
+
+/**
+ * @brief 读出并移除完整的记录
+ * @param words 输出缓冲区
+ * @param n 缓冲区字数
+ * @return 实际读出的字数，只含完整的记录
+ * @note 单消费者，记录期间也可调用
+ */
+unsigned int ylib_log_read(uint32_t *words, unsigned int n);
+
+/**
+ * @brief 按编号取格式串
+ * @return 格式串，编号越界返回NULL
+ */
+const char *ylib_log_fmt_string(unsigned int id);
+
+/**
+ * @brief 在设备上展开一条记录，不含时间戳和级别
+ * @param rec 记录，从记录头开始
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 同snprintf
+ */
+int ylib_log_format(const uint32_t *rec, char *buf, size_t size);
+
+/**
+ * @brief 队列中的字数
+ */
+unsigned int ylib_log_count(void);
+
+/**
+ * @brief 丢弃的记录总数
+ */
+uint32_t ylib_log_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_LOG_H */
@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file       yLib_lz.h
+  * @brief      LZSS压缩与流式解压
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/18
+  * @note       字节对齐的LZSS格式，窗口1024字节，不使用堆：
+  *             压缩以整块输入为历史，不需要额外RAM，用于日志等一次在RAM中的数据；
+  *             解压有整块接口，也有带1KB窗口的流式接口，输入可以任意切分(如逐帧收到的固件)。
+  *             主机端的同格式实现见tools/lz.py
+  *
+  * @par 流格式:
+  * 由若干组组成，每组一个标志字节后跟最多8项，标志从最低位起每位对应一项：
+  * - 0：字面量，1字节
+  * - 1：匹配，2字节 b0 | b1，距离 = (b0 | (b1 >> 6) << 8) + 1，长度 = (b1 & 0x3F) + 3，
+  *   从已输出数据中向前距离处复制长度个字节，距离可小于长度(重复模式)
+  * 流没有结束标记，长度由外层记录；最后一组的多余标志位为0
+  ******************************************************************************
+  */
+#ifndef YLIB_LZ_H
+#define YLIB_LZ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+#define YLIB_LZ_WINDOW 1024U  /* 窗口字节数，即最大匹配距离 */
+#define YLIB_LZ_MATCH_MIN 3U  /* 最短匹配 */
+#define YLIB_LZ_MATCH_MAX 66U /* 最长匹配 */
+
+/**
+ * @brief 最坏情况下的压缩输出长度，全部为字面量时每8字节多1个标志字节
+ */
+#define YLIB_LZ_BOUND(len) ((len) + ((len) + 7U) / 8U)
+
+/**
+ * @brief 流式解压状态
+ */
+struct ylib_lz_dec {
+    uint8_t window[YLIB_LZ_WINDOW]; /* 最近输出的数据 */
+    uint16_t pos;                   /* 窗口写入位置 */
+    uint16_t copy_dist;             /* 未完成匹配的距离 */
+    uint8_t copy_len;               /* 未完成匹配的剩余长度 */
+    uint8_t flags;                  /* 当前组的标志，已用的位移出 */
+    uint8_t items;                  /* 当前组剩余项数，0时下一个字节为标志 */
+    uint8_t half;                   /* 已读入匹配的第一个字节 */
+    uint8_t b0;                     /* 匹配的第一个字节 */
+};
+
+/**
+ * @brief 压缩一块数据
+ * @param in 输入
+ * @param len 输入字节数
+ * @param out 输出缓冲区
+ * @param cap 输出缓冲区字节数
+ * @return 压缩后的字节数，输出放不下返回0(调用者可改为原样存放)
+ * @note 贪心匹配，每个位置向前搜索YLIB_LZ_SEARCH_MAX字节，耗时与len * 搜索距离成正比
+ */
+size_t ylib_lz_compress(const void *in, size_t len, void *out, size_t cap);
+
+/**
+ * @brief 解压一块数据
+ * @param in 压缩数据
+ * @param len 压缩数据字节数
+ * @param out 输出缓冲区，同时作为窗口
+ * @param cap 输出缓冲区字节数
+ * @return 解压后的字节数，输出超出cap或距离超出已输出数据返回0
+ */
+size_t ylib_lz_decompress(const void *in, size_t len, void *out, size_t cap);
+
+/**
+ * @brief 初始化流式解压
+ * @param dec 解压状态
+ */
+void ylib_lz_dec_init(struct ylib_lz_dec *dec);
+
+/**
+ * @brief 流式解压
+ * @param dec 解压状态
+ * @param in 输入指针，返回时指向未消耗的输入
+ * @param len 输入字节数，返回时为未消耗的字节数
+ * @param out 输出缓冲区
+ * @param cap 输出缓冲区字节数
+ * @return 本次输出的字节数，小于cap时输入已全部消耗
+ * @note 输出满时停在任意位置(包括匹配中间)，下次调用继续；
+ *       距离超出已输出数据时读到窗口初始的0，由外层的长度和CRC发现
+ */
+size_t ylib_lz_dec_run(struct ylib_lz_dec *dec, const uint8_t **in, size_t *len, uint8_t *out, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_LZ_H */
@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file       yLib_memops.h
+  * @brief      按字优化的内存复制、填充和比较
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       newlib-nano为了体积逐字节处理；这里先按字节对齐目的地址，主体用LDM/STM每次
+  *             搬16字节，源地址不对齐时按字读出再移位拼接，尾部逐字节；
+  *             YLIB_MEMOPS_OVERRIDE_LIBC=1时同时替换C库的memcpy/memset/memcmp
+  ******************************************************************************
+  */
+#ifndef YLIB_MEMOPS_H
+#define YLIB_MEMOPS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 复制内存，区域不能重叠
+ * @param dst 目的地址
+ * @param src 源地址
+ * @param n 字节数
+ * @return dst
+ */
+void *ylib_memcpy(void *dst, const void *src, size_t n);
+
+/**
+ * @brief 填充内存
+ * @param dst 目的地址
+ * @param c 填充值，取低8位
+ * @param n 字节数
+ * @return dst
+ */
+void *ylib_memset(void *dst, int c, size_t n);
+
+/**
+ * @brief 比较内存
+ * @param a 地址a
+ * @param b 地址b
+ * @param n 字节数
+ * @return 第一个不同字节a-b的差，相同返回0
+ */
+int ylib_memcmp(const void *a, const void *b, size_t n);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_MEMOPS_H */
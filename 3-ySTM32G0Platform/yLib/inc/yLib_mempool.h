@@ -42,16 +42,19 @@ extern "C"
      */
     typedef struct ylib_mem
     {
-        void *MemAddr;                /* 内存分区起始地址 */
-        struct ylib_mem *MemFreeList; /* 空闲内存块链表指针 */
-        uint32_t MemBlkSize;          /* 内存块大小（字节） */
-        uint32_t MemNBlks;            /* 总的内存块数量 */
-        uint32_t MemNFree;            /* 空闲内存块数量 */
+        void *MemAddr;       /* 内存分区起始地址 */
+        void *MemFreeList;   /* 空闲内存块链表指针，每个空闲块开头存放下一块地址 */
+        uint32_t MemBlkSize; /* 内存块大小（字节） */
+        uint32_t MemNBlks;   /* 总的内存块数量 */
+        uint32_t MemNFree;   /* 空闲内存块数量 */
+        uint32_t MemNMinFree; /* 历史最少空闲块数量 */
 #if YLIB_MEM_NAME_EN > 0u
         uint8_t *MemName; /* 内存分区名称 */
 #endif
 #if configHEAP_CHECK_ENABLE
-        uint32_t MemMagic; /* 魔术数字用于检测 */
+        uint32_t MemMagic;       /* 魔术数字用于检测 */
+        uint32_t MemSeq;         /* 空闲链表修改次数，巡检据此判断游标是否失效 */
+        struct ylib_mem *MemNext; /* 全局分区链表，供后台巡检遍历 */
 #endif
     } YLIB_MEM;
 
@@ -66,10 +69,26 @@ extern "C"
         uint32_t MemNBlks;   /* 总的内存块数量 */
         uint32_t MemNFree;   /* 空闲内存块数量 */
         uint32_t MemNUsed;   /* 已使用内存块数量 */
+        uint32_t MemNMinFree; /* 历史最少空闲块数量，总数减去即峰值占用 */
+#if YLIB_MEM_NAME_EN > 0u
+        uint8_t *MemName; /* 内存分区名称 */
+#endif
     } YLIB_MEM_DATA;
 
     /* uC/OS风格的核心API */
 
+    /**
+     * @brief 在调用者提供的控制块上初始化内存分区（静态构造，不使用堆）
+     * @param pmem 内存分区控制块，通常为静态变量
+     * @param addr 内存分区起始地址
+     * @param nblks 内存块数量
+     * @param blksize 每个内存块大小（字节）
+     * @param perr 错误码指针
+     * @return 内存分区控制块指针，即pmem；失败返回NULL
+     * @note 用YLibMemDeinit注销，不能用YLibMemDel；注销前不得重复初始化同一控制块
+     */
+    YLIB_MEM *YLibMemInit(YLIB_MEM *pmem, void *addr, uint32_t nblks, uint32_t blksize, uint8_t *perr);
+
     /**
      * @brief 创建内存分区（仿照OSMemCreate）
      * @param addr 内存分区起始地址
@@ -80,6 +99,20 @@ extern "C"
      */
     YLIB_MEM *YLibMemCreate(void *addr, uint32_t nblks, uint32_t blksize, uint8_t *perr);
 
+    /**
+     * @brief 删除内存分区，释放控制块
+     * @param pmem 内存分区控制块指针
+     * @note 分区内存由调用者自行释放；删除后不再参与巡检
+     */
+    void YLibMemDel(YLIB_MEM *pmem);
+
+    /**
+     * @brief 注销YLibMemInit初始化的内存分区
+     * @param pmem 内存分区控制块指针
+     * @note 控制块和分区内存都由调用者管理；注销后不再参与巡检
+     */
+    void YLibMemDeinit(YLIB_MEM *pmem);
+
     /**
      * @brief 从内存分区获取内存块（仿照OSMemGet）
      * @param pmem 内存分区控制块指针
@@ -96,6 +129,25 @@ extern "C"
      */
     uint8_t YLibMemPut(YLIB_MEM *pmem, void *pblk);
 
+    /**
+     * @brief 一次从内存分区获取多个内存块
+     * @param pmem 内存分区控制块指针
+     * @param pblks 返回的内存块指针数组
+     * @param nblks 需要的块数量
+     * @param perr 错误码指针
+     * @return 实际获取的块数量，空闲块不足时返回0且不取出任何块
+     */
+    uint32_t YLibMemGetN(YLIB_MEM *pmem, void **pblks, uint32_t nblks, uint8_t *perr);
+
+    /**
+     * @brief 一次释放多个内存块到内存分区
+     * @param pmem 内存分区控制块指针
+     * @param pblks 要释放的内存块指针数组
+     * @param nblks 块数量
+     * @return 错误码，任一块无效时不释放任何块
+     */
+    uint8_t YLibMemPutN(YLIB_MEM *pmem, void **pblks, uint32_t nblks);
+
     /**
      * @brief 获取内存分区信息（仿照OSMemQuery）
      * @param pmem 内存分区控制块指针
@@ -176,14 +228,14 @@ extern "C"
     static YLIB_MEM name##_mem_partition
 
 /**
- * @brief 初始化静态内存池
+ * @brief 初始化静态内存池，控制块和内存块都是静态变量，不使用堆
  * @param name 内存池名称
  * @param type 内存块类型
  * @param count 内存块数量
  * @param perr 错误码指针
  */
 #define YLIB_MEM_PARTITION_INIT(name, type, count, perr) \
-    YLibMemCreate(name##_pool_buffer, count, sizeof(type), perr)
+    YLibMemInit(&name##_mem_partition, name##_pool_buffer, count, sizeof(type), perr)
 
 /**
  * @brief 计算内存分区所需的总内存大小
@@ -202,11 +254,28 @@ extern "C"
      */
     int YLibMemCheckIntegrity(YLIB_MEM *pmem);
 
+    /**
+     * @brief 按创建顺序的倒序获取第index个内存分区的信息
+     * @param index 分区序号，0为最近创建的分区
+     * @param p_mem_data 返回的内存信息结构指针
+     * @return 错误码，index超出分区数量时返回YLIB_MEM_INVALID_POOL
+     * @note 供控制台逐个列出全部分区，遍历期间创建或删除分区可能使序号错位
+     */
+    uint8_t YLibMemQueryIndex(uint32_t index, YLIB_MEM_DATA *p_mem_data);
+
     /**
      * @brief 打印内存分区信息
      * @param pmem 内存分区控制块指针
      */
     void YLibMemPrintInfo(YLIB_MEM *pmem);
+
+    /**
+     * @brief 增量巡检全部内存分区的空闲链表
+     * @param budget 本次最多检查的空闲块数
+     * @return 1完成一整遍，0本次未查完，-1发现损坏或已有损坏记录
+     * @note 损坏通过ylib_heap_report_fault报告；分区在检查期间被修改时该分区从头重查
+     */
+    int YLibMemScrub(uint32_t budget);
 #endif
 
 /* 兼容uC/OS的宏定义 */
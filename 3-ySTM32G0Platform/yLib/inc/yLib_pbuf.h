@@ -0,0 +1,123 @@
+/**
+  ******************************************************************************
+  * @file       yLib_pbuf.h
+  * @brief      引用计数的零拷贝数据缓冲区
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       描述符和数据块放在同一个内存池块中，数据以payload/len描述，前部预留头部空间；
+  *             多段缓冲区以next串成链，tot_len为本段及之后各段的总长度；
+  *             引用计数归零时块归还内存池，任务和中断中都可以释放
+  ******************************************************************************
+  */
+#ifndef YLIB_PBUF_H
+#define YLIB_PBUF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 数据指向外部存储，不在内存池块中
+ */
+#define YLIB_PBUF_FLAG_REF 0x01u
+
+/**
+ * @brief 缓冲区描述符
+ */
+typedef struct ylib_pbuf {
+    struct ylib_pbuf *next; /* 链中的下一段，NULL为最后一段 */
+    uint8_t *payload;       /* 本段数据起始 */
+    uint16_t len;           /* 本段数据长度 */
+    uint16_t tot_len;       /* 本段及之后各段的总长度 */
+    uint16_t ref;           /* 引用计数 */
+    uint8_t flags;          /* YLIB_PBUF_FLAG_* */
+    uint8_t reserved;       /* 保留 */
+} ylib_pbuf_t;
+
+/**
+ * @brief 内存池统计
+ */
+struct ylib_pbuf_stats {
+    uint32_t total;    /* 块总数 */
+    uint32_t free;     /* 空闲块数 */
+    uint32_t min_free; /* 历史最少空闲块数 */
+    uint32_t failed;   /* 分配失败次数 */
+};
+
+/**
+ * @brief 创建内存池
+ * @return 0成功，-1失败
+ * @note 首次分配时自动调用；会从堆上分配分区控制块，须在任务中调用
+ */
+int ylib_pbuf_init(void);
+
+/**
+ * @brief 分配一段缓冲区
+ * @param headroom 数据前预留的头部空间
+ * @param len 数据长度
+ * @return 缓冲区，引用计数为1；headroom + len超过YLIB_PBUF_SIZE或内存池耗尽时返回NULL
+ */
+ylib_pbuf_t *ylib_pbuf_alloc(unsigned int headroom, unsigned int len);
+
+/**
+ * @brief 分配指向外部数据的缓冲区
+ * @param data 外部数据，在缓冲区释放前保持有效
+ * @param len 数据长度
+ * @return 缓冲区，引用计数为1；内存池耗尽时返回NULL
+ * @note 用于把常量表或静态缓冲区接入链中，数据不拷贝
+ */
+ylib_pbuf_t *ylib_pbuf_alloc_ref(const void *data, unsigned int len);
+
+/**
+ * @brief 增加一个引用
+ */
+void ylib_pbuf_ref(ylib_pbuf_t *p);
+
+/**
+ * @brief 释放一个引用
+ * @return 归还内存池的块数
+ * @note 引用计数归零的段归还内存池并继续释放下一段，遇到仍被引用的段停止
+ */
+unsigned int ylib_pbuf_free(ylib_pbuf_t *p);
+
+/**
+ * @brief 把tail接到head链尾
+ * @note tail的引用转移给head，调用后不再单独释放tail
+ */
+void ylib_pbuf_cat(ylib_pbuf_t *head, ylib_pbuf_t *tail);
+
+/**
+ * @brief 把tail接到head链尾并保留调用者的引用
+ */
+void ylib_pbuf_chain(ylib_pbuf_t *head, ylib_pbuf_t *tail);
+
+/**
+ * @brief 调整第一段的数据起始
+ * @param delta 正数向前露出头部空间，负数从前部隐藏数据
+ * @return 0成功，-1头部空间或数据不足，外部数据不能露出头部
+ */
+int ylib_pbuf_header(ylib_pbuf_t *p, int delta);
+
+/**
+ * @brief 从链中拷贝数据
+ * @param p 缓冲区链
+ * @param offset 起始偏移
+ * @param buf 输出缓冲区
+ * @param len 最多拷贝的字节数
+ * @return 实际拷贝的字节数
+ */
+unsigned int ylib_pbuf_copy_out(const ylib_pbuf_t *p, unsigned int offset, void *buf, unsigned int len);
+
+/**
+ * @brief 读取内存池统计
+ */
+void ylib_pbuf_get_stats(struct ylib_pbuf_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_PBUF_H */
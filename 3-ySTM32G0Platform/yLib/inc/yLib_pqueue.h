@@ -0,0 +1,195 @@
+/**
+  ******************************************************************************
+  * @file       yLib_pqueue.h
+  * @brief      索引二叉堆优先队列
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       节点嵌入在元素结构体中(与yLib_list相同)，节点记录自己在堆数组中的位置，
+  *             因此可按句柄删除、修改键后原地调整；比较函数以宏展开到各类型专用的内联函数中，
+  *             不经过函数指针；插入、弹出、删除、调整均为O(log n)；不带锁
+  ******************************************************************************
+  */
+#ifndef YLIB_PQUEUE_H
+#define YLIB_PQUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/* 节点不在队列中 */
+#define YLIB_PQ_NONE 0xFFFFFFFFU
+
+/**
+ * @brief 队列节点，嵌入在元素结构体中
+ */
+struct ylib_pq_node {
+    unsigned int index; /* 在堆数组中的位置，YLIB_PQ_NONE表示不在队列中 */
+};
+
+/**
+ * @brief 优先队列
+ */
+struct ylib_pq {
+    struct ylib_pq_node **heap; /* 节点指针数组，heap[0]为最小元素 */
+    unsigned int count;         /* 元素个数 */
+    unsigned int size;          /* 数组容量 */
+};
+
+/**
+ * @brief 节点静态初始化
+ */
+#define YLIB_PQ_NODE_INIT { YLIB_PQ_NONE }
+
+/**
+ * @brief 静态定义优先队列
+ * @param name 队列变量名，同时生成name_heap
+ * @param capacity 最大元素个数
+ */
+#define YLIB_PQ_STORAGE(name, capacity)                            \
+    static struct ylib_pq_node *name##_heap[capacity];             \
+    static struct ylib_pq name = {name##_heap, 0, (capacity)}
+
+/**
+ * @brief 以调用者提供的数组(静态数组或内存池块)初始化优先队列
+ * @param pq 队列指针
+ * @param buffer 节点指针数组
+ * @param size 数组容量
+ */
+static inline void ylib_pq_init(struct ylib_pq *pq, struct ylib_pq_node **buffer, unsigned int size)
+{
+    pq->heap = buffer;
+    pq->count = 0;
+    pq->size = size;
+}
+
+/**
+ * @brief 初始化节点
+ * @param node 节点指针
+ */
+static inline void ylib_pq_node_init(struct ylib_pq_node *node)
+{
+    node->index = YLIB_PQ_NONE;
+}
+
+/**
+ * @brief 节点是否在队列中
+ * @param node 节点指针
+ * @return 1在队列中，0不在
+ */
+static inline int ylib_pq_queued(const struct ylib_pq_node *node)
+{
+    return node->index != YLIB_PQ_NONE;
+}
+
+/**
+ * @brief 获取元素个数
+ * @param pq 队列指针
+ * @return 元素个数
+ */
+static inline unsigned int ylib_pq_count(const struct ylib_pq *pq)
+{
+    return pq->count;
+}
+
+/**
+ * @brief 生成类型专用的优先队列操作
+ * @param prefix 函数名前缀，生成prefix_push/peek/pop/remove/update
+ * @param type 元素类型
+ * @param member 节点在元素中的成员名
+ * @param less 比较宏或内联函数less(const type *a, const type *b)，a应排在b前时为真
+ * @note prefix_update在修改元素键后调用，键变大变小均可
+ *
+ * 使用示例:
+ * @code
+ * struct job { uint32_t deadline; struct ylib_pq_node pq; };
+ * #define job_less(a, b) ((int32_t)((a)->deadline - (b)->deadline) < 0)
+ * YLIB_PQ_DEFINE(job_pq, struct job, pq, job_less)
+ * @endcode
+ */
+#define YLIB_PQ_DEFINE(prefix, type, member, less)                                           \
+    static inline type *prefix##_entry(struct ylib_pq_node *node)                            \
+    {                                                                                        \
+        return container_of(node, type, member);                                             \
+    }                                                                                        \
+    static inline void prefix##_sift_up(struct ylib_pq *pq, unsigned int i)                  \
+    {                                                                                        \
+        struct ylib_pq_node *node = pq->heap[i];                                             \
+        unsigned int parent;                                                                 \
+        while (i > 0) {                                                                      \
+            parent = (i - 1) / 2;                                                            \
+            if (!less(prefix##_entry(node), prefix##_entry(pq->heap[parent])))               \
+                break;                                                                       \
+            pq->heap[i] = pq->heap[parent];                                                  \
+            pq->heap[i]->index = i;                                                          \
+            i = parent;                                                                      \
+        }                                                                                    \
+        pq->heap[i] = node;                                                                  \
+        node->index = i;                                                                     \
+    }                                                                                        \
+    static inline void prefix##_sift_down(struct ylib_pq *pq, unsigned int i)                \
+    {                                                                                        \
+        struct ylib_pq_node *node = pq->heap[i];                                             \
+        unsigned int child;                                                                  \
+        while ((child = 2 * i + 1) < pq->count) {                                            \
+            if (child + 1 < pq->count &&                                                     \
+                less(prefix##_entry(pq->heap[child + 1]), prefix##_entry(pq->heap[child])))  \
+                child++;                                                                     \
+            if (!less(prefix##_entry(pq->heap[child]), prefix##_entry(node)))               \
+                break;                                                                       \
+            pq->heap[i] = pq->heap[child];                                                   \
+            pq->heap[i]->index = i;                                                          \
+            i = child;                                                                       \
+        }                                                                                    \
+        pq->heap[i] = node;                                                                  \
+        node->index = i;                                                                     \
+    }                                                                                        \
+    static inline int prefix##_push(struct ylib_pq *pq, type *item)                          \
+    {                                                                                        \
+        if (pq->count >= pq->size)                                                           \
+            return -1;                                                                       \
+        pq->heap[pq->count] = &item->member;                                                 \
+        prefix##_sift_up(pq, pq->count++);                                                   \
+        return 0;                                                                            \
+    }                                                                                        \
+    static inline type *prefix##_peek(struct ylib_pq *pq)                                    \
+    {                                                                                        \
+        return pq->count ? prefix##_entry(pq->heap[0]) : NULL;                               \
+    }                                                                                        \
+    static inline int prefix##_remove(struct ylib_pq *pq, type *item)                        \
+    {                                                                                        \
+        unsigned int i = item->member.index;                                                 \
+        if (i >= pq->count || pq->heap[i] != &item->member)                                  \
+            return -1;                                                                       \
+        item->member.index = YLIB_PQ_NONE;                                                   \
+        if (i != --pq->count) {                                                              \
+            struct ylib_pq_node *last = pq->heap[pq->count];                                 \
+            pq->heap[i] = last;                                                              \
+            prefix##_sift_up(pq, i);                                                         \
+            prefix##_sift_down(pq, last->index);                                             \
+        }                                                                                    \
+        return 0;                                                                            \
+    }                                                                                        \
+    static inline type *prefix##_pop(struct ylib_pq *pq)                                     \
+    {                                                                                        \
+        type *top = prefix##_peek(pq);                                                       \
+        if (top != NULL)                                                                     \
+            prefix##_remove(pq, top);                                                        \
+        return top;                                                                          \
+    }                                                                                        \
+    static inline void prefix##_update(struct ylib_pq *pq, type *item)                       \
+    {                                                                                        \
+        unsigned int i = item->member.index;                                                 \
+        if (i >= pq->count || pq->heap[i] != &item->member)                                  \
+            return;                                                                          \
+        prefix##_sift_up(pq, i);                                                             \
+        prefix##_sift_down(pq, item->member.index);                                          \
+    }
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_PQUEUE_H */
@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************
+  * @file       yLib_probe.h
+  * @brief      代码段耗时探针
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       探针以YLIB_PROBE_DEFINE定义在RAM中的.ylib_probe段，带名称；
+  *             YLIB_PROBE_BEGIN/YLIB_PROBE_END之间的耗时按微秒累计次数、最小、最大和总和，
+  *             时钟由平台通过ylib_probe_register_clock注册；
+  *             YLIB_PROBE_ENABLE为0时全部宏展开为空，探针不占RAM也不进入固件
+  ******************************************************************************
+  */
+#ifndef YLIB_PROBE_H
+#define YLIB_PROBE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 探针
+ */
+struct ylib_probe {
+    const char *name; /* 名称 */
+    uint32_t count;   /* 记录次数 */
+    uint32_t min;     /* 最短耗时(us)，无记录时为UINT32_MAX */
+    uint32_t max;     /* 最长耗时(us) */
+    uint64_t sum;     /* 耗时总和(us) */
+};
+
+/**
+ * @brief 探针统计快照
+ */
+struct ylib_probe_stats {
+    uint32_t count; /* 记录次数 */
+    uint32_t min;   /* 最短耗时(us)，无记录时为0 */
+    uint32_t max;   /* 最长耗时(us) */
+    uint32_t avg;   /* 平均耗时(us) */
+};
+
+#if YLIB_PROBE_ENABLE
+extern uint32_t (*ylib_probe_now)(void);
+
+/**
+ * @brief 读取时钟，未注册时为0，此时记录的耗时全为0
+ */
+YLIB_INLINE uint32_t ylib_probe_clock(void)
+{
+    return (ylib_probe_now != NULL) ? ylib_probe_now() : 0;
+}
+
+/**
+ * @brief 定义探针，放在文件作用域
+ * @param id 探针名，同时用于生成变量名
+ */
+#define YLIB_PROBE_DEFINE(id)                                                     \
+    YLIB_USED struct ylib_probe ylib_probe_##id YLIB_SECTION(".ylib_probe") = { \
+        #id, 0, UINT32_MAX, 0, 0}
+
+/**
+ * @brief 引用其他文件中定义的探针
+ */
+#define YLIB_PROBE_DECLARE(id) extern struct ylib_probe ylib_probe_##id
+
+/**
+ * @brief 开始计时，在同一作用域内与YLIB_PROBE_END配对
+ * @note 定义一个局部变量保存起始时间，同一作用域内同一探针只能开始一次
+ */
+#define YLIB_PROBE_BEGIN(id) const uint32_t ylib_probe_start_##id = ylib_probe_clock()
+
+/**
+ * @brief 结束计时并记录
+ */
+#define YLIB_PROBE_END(id) ylib_probe_record(&ylib_probe_##id, ylib_probe_clock() - ylib_probe_start_##id)
+#else
+#define YLIB_PROBE_DEFINE(id) extern struct ylib_probe ylib_probe_##id
+#define YLIB_PROBE_DECLARE(id) extern struct ylib_probe ylib_probe_##id
+#define YLIB_PROBE_BEGIN(id) ((void)0)
+#define YLIB_PROBE_END(id) ((void)0)
+#endif
+
+/**
+ * @brief 注册微秒时钟
+ * @param now 读取32位自由递增微秒计数的函数，须可在中断中调用
+ */
+void ylib_probe_register_clock(uint32_t (*now)(void));
+
+/**
+ * @brief 记录一次耗时
+ * @param probe 探针
+ * @param us 耗时(us)
+ * @note 一般通过YLIB_PROBE_END调用；任务和中断都可调用，四个字段在一次短临界区内更新
+ */
+void ylib_probe_record(struct ylib_probe *probe, uint32_t us);
+
+/**
+ * @brief 按序号取探针
+ * @param index 序号，从0开始
+ * @return 探针，超出范围或未编译探针时返回NULL
+ */
+struct ylib_probe *ylib_probe_iterate(unsigned int index);
+
+/**
+ * @brief 读取统计快照
+ * @param probe 探针
+ * @param stats 输出
+ * @param reset 非0时读取后清零
+ * @note 读取和清零在同一临界区内，两次读取之间的记录不会丢失
+ */
+void ylib_probe_read(struct ylib_probe *probe, struct ylib_probe_stats *stats, int reset);
+
+/**
+ * @brief 清零全部探针
+ */
+void ylib_probe_reset_all(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_PROBE_H */
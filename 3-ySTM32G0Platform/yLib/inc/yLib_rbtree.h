@@ -44,6 +44,20 @@ struct ylib_rb_root {
  */
 #define YLIB_RB_ROOT   (struct ylib_rb_root) { NULL, }
 
+/**
+ * @brief 缓存最左节点的红黑树根
+ * @note 取最小节点为O(1)，适合反复取最早到期项的调度场景
+ */
+struct ylib_rb_root_cached {
+    struct ylib_rb_root rb_root;
+    struct ylib_rb_node *rb_leftmost;
+};
+
+/**
+ * @brief 缓存最左节点的红黑树根初始化
+ */
+#define YLIB_RB_ROOT_CACHED (struct ylib_rb_root_cached) { {NULL, }, NULL }
+
 /**
  * @brief 获取父节点
  * @param node 节点指针
@@ -206,6 +220,40 @@ struct ylib_rb_node *ylib_rb_prev(const struct ylib_rb_node *node);
 void ylib_rb_link_node(struct ylib_rb_node *node, struct ylib_rb_node *parent,
                        struct ylib_rb_node **rb_link);
 
+/* 缓存最左节点的操作 */
+
+/**
+ * @brief 获取第一个节点（最小值），O(1)
+ * @param root 树根指针
+ */
+#define ylib_rb_first_cached(root) ((root)->rb_leftmost)
+
+/**
+ * @brief 插入节点并重新平衡树，同时维护最左节点
+ * @param node 要插入的节点
+ * @param root 树根指针
+ * @param leftmost 查找插入位置时是否一直向左走
+ */
+static inline void ylib_rb_insert_color_cached(struct ylib_rb_node *node,
+                                               struct ylib_rb_root_cached *root, bool leftmost)
+{
+    if (leftmost)
+        root->rb_leftmost = node;
+    ylib_rb_insert_color(node, &root->rb_root);
+}
+
+/**
+ * @brief 删除节点并重新平衡树，同时维护最左节点
+ * @param node 要删除的节点
+ * @param root 树根指针
+ */
+static inline void ylib_rb_erase_cached(struct ylib_rb_node *node, struct ylib_rb_root_cached *root)
+{
+    if (root->rb_leftmost == node)
+        root->rb_leftmost = ylib_rb_next(node);
+    ylib_rb_erase(node, &root->rb_root);
+}
+
 /* 遍历宏 */
 
 /**
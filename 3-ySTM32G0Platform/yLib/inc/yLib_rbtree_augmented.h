@@ -0,0 +1,104 @@
+/**
+  ******************************************************************************
+  * @file       yLib_rbtree_augmented.h
+  * @brief      增强红黑树（参考Linux rbtree_augmented.h）
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       每个节点额外保存一个由自身和左右子树算出的值(如子树最大端点)；
+  *             插入时调用者沿查找路径更新该值，旋转和删除由回调维护
+  ******************************************************************************
+  */
+#ifndef YLIB_RBTREE_AUGMENTED_H
+#define YLIB_RBTREE_AUGMENTED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_rbtree.h"
+
+/**
+ * @brief 增强值维护回调
+ */
+struct ylib_rb_augment_callbacks {
+    void (*propagate)(struct ylib_rb_node *node, struct ylib_rb_node *stop); /* 从node向上重算到stop(不含) */
+    void (*rotate)(struct ylib_rb_node *old, struct ylib_rb_node *new_node); /* new_node旋转到old原来的位置 */
+};
+
+/**
+ * @brief 生成增强值维护回调
+ * @param rbstatic 回调结构体的存储类型，如static
+ * @param rbname 回调结构体名
+ * @param rbstruct 节点所在结构体类型
+ * @param rbfield 红黑树节点成员名
+ * @param rbaugmented 增强值成员名
+ * @param rbcompute 由节点和左右子树计算增强值的函数或宏
+ */
+#define YLIB_RB_DECLARE_CALLBACKS(rbstatic, rbname, rbstruct, rbfield, rbaugmented, rbcompute) \
+    static void rbname##_propagate(struct ylib_rb_node *rb, struct ylib_rb_node *stop)         \
+    {                                                                                           \
+        while (rb != stop) {                                                                    \
+            rbstruct *node = ylib_rb_entry(rb, rbstruct, rbfield);                              \
+            node->rbaugmented = rbcompute(node);                                                \
+            rb = ylib_rb_parent(&node->rbfield);                                                \
+        }                                                                                       \
+    }                                                                                           \
+    static void rbname##_rotate(struct ylib_rb_node *rb_old, struct ylib_rb_node *rb_new)      \
+    {                                                                                           \
+        rbstruct *old = ylib_rb_entry(rb_old, rbstruct, rbfield);                               \
+        rbstruct *new_node = ylib_rb_entry(rb_new, rbstruct, rbfield);                          \
+        new_node->rbaugmented = old->rbaugmented;                                               \
+        old->rbaugmented = rbcompute(old);                                                      \
+    }                                                                                           \
+    rbstatic const struct ylib_rb_augment_callbacks rbname = {                                  \
+        rbname##_propagate, rbname##_rotate                                                     \
+    }
+
+/**
+ * @brief 插入增强树节点并重新平衡
+ * @param node 已链接的节点，调用者已更新查找路径上和node自身的增强值
+ * @param root 树根指针
+ * @param augment 回调
+ */
+void ylib_rb_insert_augmented(struct ylib_rb_node *node, struct ylib_rb_root *root,
+                              const struct ylib_rb_augment_callbacks *augment);
+
+/**
+ * @brief 删除增强树节点并重新平衡
+ * @param node 要删除的节点
+ * @param root 树根指针
+ * @param augment 回调
+ */
+void ylib_rb_erase_augmented(struct ylib_rb_node *node, struct ylib_rb_root *root,
+                             const struct ylib_rb_augment_callbacks *augment);
+
+/**
+ * @brief 插入增强树节点，同时维护最左节点
+ */
+static inline void ylib_rb_insert_augmented_cached(struct ylib_rb_node *node,
+                                                   struct ylib_rb_root_cached *root, bool leftmost,
+                                                   const struct ylib_rb_augment_callbacks *augment)
+{
+    if (leftmost)
+        root->rb_leftmost = node;
+    ylib_rb_insert_augmented(node, &root->rb_root, augment);
+}
+
+/**
+ * @brief 删除增强树节点，同时维护最左节点
+ */
+static inline void ylib_rb_erase_augmented_cached(struct ylib_rb_node *node,
+                                                  struct ylib_rb_root_cached *root,
+                                                  const struct ylib_rb_augment_callbacks *augment)
+{
+    if (root->rb_leftmost == node)
+        root->rb_leftmost = ylib_rb_next(node);
+    ylib_rb_erase_augmented(node, &root->rb_root, augment);
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_RBTREE_AUGMENTED_H */
@@ -16,16 +16,25 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include "yLib_def.h"
+#include "yLib_span.h"
 
 /**
  * @brief 环形队列结构体
+ * @note head/tail为自由递增的32位计数，取余数定位元素，tail-head即元素个数，全部size个槽位都可用；
+ *       单生产者单消费者时入队只写tail、出队只写head，中断入队、任务出队不需要临界区；
+ *       多生产者/多消费者在临界区内只预留计数，数据在临界区外复制，最后一个完成的一方统一提交，
+ *       提交始终按预留顺序；同一侧不能同时混用单生产者(消费者)和多生产者(消费者)接口
  */
 struct ylib_ring {
-    volatile unsigned int head;    /* 读取位置 */
-    volatile unsigned int tail;    /* 写入位置 */
-    unsigned int size;             /* 队列大小 */
-    unsigned int mask;             /* 大小掩码 */
-    void *ring;                    /* 数据缓冲区 */
+    volatile unsigned int head;      /* 已读取计数(消费者已提交) */
+    volatile unsigned int tail;      /* 已写入计数(生产者已提交) */
+    unsigned int size;               /* 队列大小 */
+    unsigned int mask;               /* 大小掩码 */
+    void *ring;                      /* 数据缓冲区 */
+    volatile unsigned int prod_head; /* 生产者已预留计数 */
+    volatile unsigned int cons_head; /* 消费者已预留计数 */
+    volatile unsigned int prod_busy; /* 已预留未提交的生产者数 */
+    volatile unsigned int cons_busy; /* 已预留未提交的消费者数 */
 };
 
 /**
@@ -42,6 +51,21 @@ struct ylib_ring *ylib_ring_create(unsigned int size, size_t element_size);
  */
 void ylib_ring_destroy(struct ylib_ring *ring);
 
+/**
+ * @brief 重置环形队列
+ * @param ring 环形队列指针
+ * @note 生产者和消费者都不在访问时调用
+ */
+static inline void ylib_ring_reset(struct ylib_ring *ring)
+{
+    ring->head = 0;
+    ring->tail = 0;
+    ring->prod_head = 0;
+    ring->cons_head = 0;
+    ring->prod_busy = 0;
+    ring->cons_busy = 0;
+}
+
 /**
  * @brief 初始化环形队列
  * @param ring 环形队列指针
@@ -55,25 +79,14 @@ static inline int ylib_ring_init(struct ylib_ring *ring, void *buffer, unsigned
     if (!size || (size & (size - 1)))
         return -1;
     
-    ring->head = 0;
-    ring->tail = 0;
     ring->size = size;
     ring->mask = size - 1;
     ring->ring = buffer;
+    ylib_ring_reset(ring);
     
     return 0;
 }
 
-/**
- * @brief 重置环形队列
- * @param ring 环形队列指针
- */
-static inline void ylib_ring_reset(struct ylib_ring *ring)
-{
-    ring->head = 0;
-    ring->tail = 0;
-}
-
 /**
  * @brief 获取队列中元素个数
  * @param ring 环形队列指针
@@ -120,6 +133,7 @@ static inline int ylib_ring_full(struct ylib_ring *ring)
  * @param data 数据指针
  * @param element_size 元素大小
  * @return 1成功，0失败（队列已满）
+ * @note 单生产者，可在中断中调用，与出队并发时无需临界区
  */
 int ylib_ring_enqueue(struct ylib_ring *ring, const void *data, size_t element_size);
 
@@ -129,6 +143,7 @@ int ylib_ring_enqueue(struct ylib_ring *ring, const void *data, size_t element_s
  * @param data 数据指针
  * @param element_size 元素大小
  * @return 1成功，0失败（队列为空）
+ * @note 单消费者，与入队并发时无需临界区
  */
 int ylib_ring_dequeue(struct ylib_ring *ring, void *data, size_t element_size);
 
@@ -174,8 +189,73 @@ int ylib_ring_peek(struct ylib_ring *ring, void *data, size_t element_size);
 int ylib_ring_peek_at(struct ylib_ring *ring, unsigned int index, 
                       void *data, size_t element_size);
 
+/* 零拷贝接口（单生产者/单消费者） */
+
+/**
+ * @brief 预留可直接写入的空闲区域
+ * @param ring 环形队列指针
+ * @param count 希望预留的元素个数
+ * @param span 区域输出，跨越缓冲区末尾时为两段
+ * @param element_size 元素大小
+ * @return 实际预留的元素个数
+ * @note 写完后调用ylib_ring_commit发布，预留到提交之间不能有其他入队
+ */
+unsigned int ylib_ring_reserve(struct ylib_ring *ring, unsigned int count,
+                               ylib_span_t *span, size_t element_size);
+
+/**
+ * @brief 发布已写入预留区域的元素
+ * @param ring 环形队列指针
+ * @param count 元素个数，不超过预留的个数
+ */
+void ylib_ring_commit(struct ylib_ring *ring, unsigned int count);
+
+/**
+ * @brief 获取可直接读取的队首区域
+ * @param ring 环形队列指针
+ * @param count 希望读取的元素个数
+ * @param span 区域输出，跨越缓冲区末尾时为两段
+ * @param element_size 元素大小
+ * @return 实际可读的元素个数
+ * @note 读完后调用ylib_ring_release释放槽位
+ */
+unsigned int ylib_ring_peek_linear(struct ylib_ring *ring, unsigned int count,
+                                   ylib_span_t *span, size_t element_size);
+
+/**
+ * @brief 释放已读取的队首元素
+ * @param ring 环形队列指针
+ * @param count 元素个数，不超过peek_linear返回的个数
+ */
+void ylib_ring_release(struct ylib_ring *ring, unsigned int count);
+
 /* 多生产者/多消费者支持 */
 
+/**
+ * @brief 多生产者批量入队
+ * @param ring 环形队列指针
+ * @param data 数据缓冲区
+ * @param count 元素个数
+ * @param element_size 元素大小
+ * @return 实际入队的元素个数
+ * @note 多个任务和中断可同时入队，关中断只覆盖预留和提交两次计数更新；
+ *       被抢占的生产者复制完成前，后预留者的数据对消费者不可见
+ */
+unsigned int ylib_ring_mp_enqueue_bulk(struct ylib_ring *ring, const void *data,
+                                       unsigned int count, size_t element_size);
+
+/**
+ * @brief 多消费者批量出队
+ * @param ring 环形队列指针
+ * @param data 数据缓冲区
+ * @param count 元素个数
+ * @param element_size 元素大小
+ * @return 实际出队的元素个数
+ * @note 多个任务和中断可同时出队，关中断只覆盖预留和提交两次计数更新
+ */
+unsigned int ylib_ring_mc_dequeue_bulk(struct ylib_ring *ring, void *data,
+                                       unsigned int count, size_t element_size);
+
 /**
  * @brief 多生产者入队操作
  * @param ring 环形队列指针
@@ -183,7 +263,10 @@ int ylib_ring_peek_at(struct ylib_ring *ring, unsigned int index,
  * @param element_size 元素大小
  * @return 1成功，0失败
  */
-int ylib_ring_mp_enqueue(struct ylib_ring *ring, const void *data, size_t element_size);
+static inline int ylib_ring_mp_enqueue(struct ylib_ring *ring, const void *data, size_t element_size)
+{
+    return (int)ylib_ring_mp_enqueue_bulk(ring, data, 1, element_size);
+}
 
 /**
  * @brief 多消费者出队操作
@@ -192,7 +275,10 @@ int ylib_ring_mp_enqueue(struct ylib_ring *ring, const void *data, size_t elemen
  * @param element_size 元素大小
  * @return 1成功，0失败
  */
-int ylib_ring_mc_dequeue(struct ylib_ring *ring, void *data, size_t element_size);
+static inline int ylib_ring_mc_dequeue(struct ylib_ring *ring, void *data, size_t element_size)
+{
+    return (int)ylib_ring_mc_dequeue_bulk(ring, data, 1, element_size);
+}
 
 /* 类型安全的宏定义 */
 
@@ -235,6 +321,49 @@ struct { \
 #define ylib_ring_get(ring_var, val) \
     ylib_ring_dequeue(&(ring_var)->ring, val, sizeof(*(val)))
 
+/* 静态定义 */
+
+/**
+ * @brief 静态定义环形队列，存储和控制块在编译期分配，无需调用init
+ * @param name 队列变量名，同时生成name_buffer、name_put(val)和name_get(&val)
+ * @param type 元素类型
+ * @param count 元素个数（必须是2的幂次）
+ * @note name_put/name_get按元素类型直接存取，单生产者单消费者，与ylib_ring_*接口可混用
+ */
+#define YLIB_RING_DEFINE(name, type, count) YLIB_RING_DEFINE_ATTR(name, type, count, )
+
+/**
+ * @brief 静态定义环形队列并为存储附加属性
+ * @param attr 存储属性，如__attribute__((section(".noinit")))
+ */
+#define YLIB_RING_DEFINE_ATTR(name, type, count, attr)                                      \
+    _Static_assert((count) > 0 && ((count) & ((count) - 1)) == 0, #name " size must be power of 2"); \
+    static type name##_buffer[count] __attribute__((aligned(YLIB_RING_ALIGN))) attr;        \
+    static struct ylib_ring name = {.size = (count), .mask = (count) - 1, .ring = name##_buffer}; \
+    static inline int name##_put(type val)                                                  \
+    {                                                                                       \
+        unsigned int tail = name.tail;                                                      \
+        if (tail - name.head >= (count))                                                    \
+            return 0;                                                                       \
+        name##_buffer[tail & ((count) - 1)] = val;                                          \
+        YLIB_RING_BARRIER();                                                                \
+        name.prod_head = tail + 1;                                                          \
+        name.tail = tail + 1;                                                               \
+        return 1;                                                                           \
+    }                                                                                       \
+    static inline int name##_get(type *val)                                                 \
+    {                                                                                       \
+        unsigned int head = name.head;                                                      \
+        if (head == name.tail)                                                              \
+            return 0;                                                                       \
+        YLIB_RING_BARRIER();                                                                \
+        *val = name##_buffer[head & ((count) - 1)];                                         \
+        YLIB_RING_BARRIER();                                                                \
+        name.cons_head = head + 1;                                                          \
+        name.head = head + 1;                                                               \
+        return 1;                                                                           \
+    }
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,118 @@
+/**
+  ******************************************************************************
+  * @file       yLib_sbtree.h
+  * @brief      存放在外部Flash中的只读静态B树索引
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       由主机工具tools/sbtree_build.py生成镜像，键为uint32_t，值为定长字节串；
+  *             每个节点占一页，查找从根逐层读入一页，读页数等于层数(256字节页时通常2~3层)；
+  *             打开时把能整层放进固定缓冲区的上层节点读入RAM，这些层查找时不再读Flash。
+  *             查找共用句柄内的页缓冲区，不带锁
+  *
+  * @par 镜像格式(小端):
+  * - 第0页：头部(struct ylib_sbtree_header)，其余填0xFF
+  * - 之后按层存放节点，根在前，叶子层在最后；每层的节点连续存放
+  * - 内部节点：最多page_size/4个键，第j个键是第j个子节点的最小键；
+  *   第l层第i个节点的子节点是第l+1层第i*F~i*F+F-1个节点(F=page_size/4)，子节点号不存储
+  * - 叶子节点：先是R个键，再是R个值(R=page_size/(4+value_size))，第i个叶子存放第i*R条起的记录
+  ******************************************************************************
+  */
+#ifndef YLIB_SBTREE_H
+#define YLIB_SBTREE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+#define YLIB_SBTREE_MAGIC 0x31544253U /* "SBT1" */
+
+/**
+ * @brief 镜像头部，位于镜像第0页
+ */
+struct ylib_sbtree_header {
+    uint32_t magic;      /* YLIB_SBTREE_MAGIC */
+    uint16_t page_size;  /* 节点页字节数，2的幂 */
+    uint8_t value_size;  /* 每个值的字节数 */
+    uint8_t levels;      /* 层数，含叶子层 */
+    uint32_t count;      /* 记录数 */
+    uint32_t image_crc;  /* 第1页起全部节点页的CRC-32 */
+    uint32_t header_crc; /* 以上字段的CRC-32 */
+};
+
+/**
+ * @brief 读取回调
+ * @param ctx 回调参数
+ * @param addr 地址
+ * @param buf 输出缓冲区
+ * @param len 字节数
+ * @return 0成功，其他为失败
+ */
+typedef int (*ylib_sbtree_read_t)(void *ctx, uint32_t addr, void *buf, uint32_t len);
+
+/**
+ * @brief 静态B树句柄
+ */
+struct ylib_sbtree {
+    ylib_sbtree_read_t read;                 /* 读取回调 */
+    void *ctx;                               /* 回调参数 */
+    uint32_t base;                           /* 镜像起始地址 */
+    struct ylib_sbtree_header hdr;           /* 镜像头部 */
+    uint32_t first[YLIB_SBTREE_LEVELS_MAX];  /* 每层第一个节点的页号 */
+    uint32_t nodes[YLIB_SBTREE_LEVELS_MAX];  /* 每层节点数 */
+    uint32_t *pin;                           /* 常驻RAM的上层节点 */
+    uint8_t pinned;                          /* 常驻RAM的层数 */
+    uint32_t reads;                          /* 查找读取的页数 */
+    uint32_t lookups;                        /* 查找次数 */
+    uint32_t page[YLIB_SBTREE_PAGE_MAX / 4]; /* 页缓冲区 */
+};
+
+/**
+ * @brief 打开镜像
+ * @param tree 句柄
+ * @param read 读取回调
+ * @param ctx 回调参数
+ * @param base 镜像起始地址，按页对齐时每个节点只落在一个Flash页内
+ * @param pin 常驻上层节点的缓冲区，4字节对齐，可为NULL
+ * @param pin_size 缓冲区字节数
+ * @return 0成功，-1读取失败、头部校验错误或页大小、层数超出配置
+ * @note 从根开始，整层放得下的层全部读入pin，放不下的层及以下查找时按页读取
+ */
+int ylib_sbtree_open(struct ylib_sbtree *tree, ylib_sbtree_read_t read, void *ctx, uint32_t base,
+                     void *pin, uint32_t pin_size);
+
+/**
+ * @brief 校验全部节点页
+ * @param tree 已打开的句柄
+ * @return 0一致，-1读取失败或CRC不符
+ * @note 逐页读取整个镜像，用于写入后或启动自检，查找本身不校验
+ */
+int ylib_sbtree_verify(struct ylib_sbtree *tree);
+
+/**
+ * @brief 精确查找
+ * @param tree 已打开的句柄
+ * @param key 键
+ * @param value 值输出，value_size字节，可为NULL
+ * @return 1找到，0不存在，-1读取失败
+ */
+int ylib_sbtree_find(struct ylib_sbtree *tree, uint32_t key, void *value);
+
+/**
+ * @brief 查找不大于key的最大键
+ * @param tree 已打开的句柄
+ * @param key 键
+ * @param found 找到的键输出，可为NULL
+ * @param value 值输出，value_size字节，可为NULL
+ * @return 1找到，0key小于全部键，-1读取失败
+ * @note 用于分段表和校准曲线：找到的记录覆盖从found起到下一个键之前的区间
+ */
+int ylib_sbtree_floor(struct ylib_sbtree *tree, uint32_t key, uint32_t *found, void *value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_SBTREE_H */
@@ -0,0 +1,57 @@
+/**
+  ******************************************************************************
+  * @file       yLib_span.h
+  * @brief      环形存储的零拷贝读写区域
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       yLib_ring和yLib_fifo共用：按自由递增计数和掩码换算出可直接读写的存储区域，
+  *             跨越缓冲区末尾时分为两段
+  ******************************************************************************
+  */
+#ifndef YLIB_SPAN_H
+#define YLIB_SPAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 可直接读写的存储区域
+ */
+typedef struct {
+    void *data[2];       /* 两段起始地址，第二段不存在时为NULL */
+    unsigned int len[2]; /* 两段元素个数 */
+} ylib_span_t;
+
+/**
+ * @brief 计算从计数pos开始n个元素所在的存储区域
+ * @param span 区域输出
+ * @param base 缓冲区起始地址
+ * @param mask 大小掩码
+ * @param pos 起始计数
+ * @param n 元素个数
+ * @param element_size 元素大小
+ * @return 元素个数n
+ */
+static inline unsigned int ylib_span_init(ylib_span_t *span, void *base, unsigned int mask,
+                                          unsigned int pos, unsigned int n, size_t element_size)
+{
+    unsigned int idx = pos & mask;
+    unsigned int first = MIN(n, mask + 1 - idx);
+
+    span->data[0] = (char *)base + idx * element_size;
+    span->len[0] = first;
+    span->data[1] = (n > first) ? base : NULL;
+    span->len[1] = n - first;
+
+    return n;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_SPAN_H */
@@ -0,0 +1,157 @@
+/**
+  ******************************************************************************
+  * @file       yLib_timer.h
+  * @brief      分层定时轮
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       启动、停止为O(1)，每个节拍只处理第0层一个槽，第0层转满一圈时从上层搬下一个槽；
+  *             定时轮本身不带锁也不读时钟，由适配层(timer_ylib.c)用一个FreeRTOS定时器驱动
+  ******************************************************************************
+  */
+#ifndef YLIB_TIMER_H
+#define YLIB_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+#include "yLib_list.h"
+
+#define YLIB_TIMER_ROOT_SIZE (1U << YLIB_TIMER_ROOT_BITS)
+#define YLIB_TIMER_LEVEL_SIZE (1U << YLIB_TIMER_LEVEL_BITS)
+
+/* ylib_timer_wheel_idle: 定时轮中没有任何定时器 */
+#define YLIB_TIMER_IDLE_FOREVER 0xFFFFFFFFUL
+
+/**
+ * @brief 超时回调
+ * @param arg 启动时设置的参数
+ */
+typedef void (*ylib_timer_func_t)(void *arg);
+
+/**
+ * @brief 定时器
+ */
+struct ylib_timer {
+    struct ylib_list_head node; /* 所在槽或到期链表，不在任何链表时指向自身 */
+    uint32_t expires;           /* 到期节拍 */
+    uint32_t period;            /* 周期节拍，0为单次 */
+    ylib_timer_func_t func;     /* 超时回调 */
+    void *arg;                  /* 回调参数 */
+};
+
+/**
+ * @brief 定时轮
+ */
+struct ylib_timer_wheel {
+    uint32_t now;                                                          /* 下一个待处理的节拍 */
+    struct ylib_list_head root[YLIB_TIMER_ROOT_SIZE];                      /* 第0层，每槽一个节拍 */
+    struct ylib_list_head level[YLIB_TIMER_LEVELS][YLIB_TIMER_LEVEL_SIZE]; /* 上层，每槽覆盖下一层一整圈 */
+    struct ylib_list_head expired;                                         /* 已到期待回调 */
+};
+
+/**
+ * @brief 初始化定时器
+ * @param timer 定时器指针
+ * @param func 超时回调
+ * @param arg 回调参数
+ */
+static inline void ylib_timer_init(struct ylib_timer *timer, ylib_timer_func_t func, void *arg)
+{
+    YLIB_INIT_LIST_HEAD(&timer->node);
+    timer->expires = 0;
+    timer->period = 0;
+    timer->func = func;
+    timer->arg = arg;
+}
+
+/**
+ * @brief 定时器是否在运行(已启动未到期，或已到期未回调)
+ * @param timer 定时器指针
+ * @return 1运行中，0未运行
+ */
+static inline int ylib_timer_pending(const struct ylib_timer *timer)
+{
+    return !ylib_list_empty(&timer->node);
+}
+
+/**
+ * @brief 初始化定时轮
+ * @param wheel 定时轮指针
+ * @param now 当前节拍
+ */
+void ylib_timer_wheel_init(struct ylib_timer_wheel *wheel, uint32_t now);
+
+/**
+ * @brief 启动或重启定时器
+ * @param wheel 定时轮指针
+ * @param timer 定时器指针，已在运行时先停止
+ * @param expires 到期节拍，早于当前节拍时在下一个节拍到期
+ */
+void ylib_timer_wheel_add(struct ylib_timer_wheel *wheel, struct ylib_timer *timer, uint32_t expires);
+
+/**
+ * @brief 停止定时器
+ * @param timer 定时器指针
+ * @return 1已停止运行中的定时器，0本来就未运行
+ */
+int ylib_timer_wheel_del(struct ylib_timer *timer);
+
+/**
+ * @brief 推进定时轮到指定节拍，到期的定时器移入到期链表
+ * @param wheel 定时轮指针
+ * @param now 当前节拍
+ * @note 耗时与经过的节拍数成正比，与定时器数量无关(搬移上层槽时除外)
+ */
+void ylib_timer_wheel_advance(struct ylib_timer_wheel *wheel, uint32_t now);
+
+/**
+ * @brief 取出一个已到期的定时器
+ * @param wheel 定时轮指针
+ * @return 定时器指针，没有时返回NULL；周期定时器已按周期重新加入
+ * @note 调用者随后执行timer->func(timer->arg)，回调可以在锁外执行
+ */
+struct ylib_timer *ylib_timer_wheel_expired(struct ylib_timer_wheel *wheel);
+
+/**
+ * @brief 从当前节拍起可以跳过的节拍数
+ * @param wheel 定时轮指针
+ * @return n: 节拍now~now+n-1无事可做，推进到now+n时才有定时器到期或需要搬移上层槽；
+ *         到期链表非空时为0；定时轮为空时为YLIB_TIMER_IDLE_FOREVER
+ * @note 供无周期节拍的驱动方式计算下一次唤醒时刻；最多扫描第0层一圈，结果不超过YLIB_TIMER_ROOT_SIZE
+ */
+uint32_t ylib_timer_wheel_idle(const struct ylib_timer_wheel *wheel);
+
+/* 以下由RTOS适配层(timer_ylib.c，中断运行模式下为os_irqrun.c)实现，定时轮节拍为YLIB_TIMER_TICK_MS */
+
+/**
+ * @brief 创建驱动定时轮的FreeRTOS定时器
+ * @return 0成功，-1失败
+ * @note 回调在定时器服务任务中执行，不能阻塞
+ */
+int ylib_timer_service_init(void);
+
+/**
+ * @brief 启动定时器
+ * @param timer 定时器指针
+ * @param timeout_ms 超时时间，向上取整到节拍
+ * @param period_ms 周期，0为单次
+ * @note 可在任务和中断中调用
+ */
+void ylib_timer_start(struct ylib_timer *timer, uint32_t timeout_ms, uint32_t period_ms);
+
+/**
+ * @brief 停止定时器
+ * @param timer 定时器指针
+ * @return 1已停止运行中的定时器，0本来就未运行
+ * @note 可在任务和中断中调用
+ */
+int ylib_timer_stop(struct ylib_timer *timer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_TIMER_H */
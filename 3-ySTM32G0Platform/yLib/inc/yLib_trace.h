@@ -0,0 +1,163 @@
+/**
+  ******************************************************************************
+  * @file       yLib_trace.h
+  * @brief      二进制事件跟踪记录
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       每个事件一条8字节记录{与上一条的时间差, 事件号, 参数}，写入静态环形队列；
+  *             时间差超过16位时先插入一条绝对时间记录，队列满时丢弃并在恢复后插入丢失计数；
+  *             写入方(任务切换、中断、任务)在一次短临界区内取时间戳并入队，读出方单消费者无锁，
+  *             可以边记录边导出；时钟由平台通过ylib_trace_register_clock注册
+  ******************************************************************************
+  */
+#ifndef YLIB_TRACE_H
+#define YLIB_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+
+/**
+ * @brief 事件号，0~31，每个事件对应掩码中的一位
+ */
+enum ylib_trace_event {
+    YLIB_TRACE_EV_TIME = 0,        /* 绝对时间，arg为时钟值，由记录器自动插入 */
+    YLIB_TRACE_EV_LOST = 1,        /* 队列满丢弃的记录数，arg为条数，由记录器自动插入 */
+    YLIB_TRACE_EV_TASK_IN = 2,     /* 任务切入，arg为任务编号 */
+    YLIB_TRACE_EV_TASK_CREATE = 3, /* 任务创建，arg为任务编号 */
+    YLIB_TRACE_EV_TICK = 4,        /* 系统滴答，arg为滴答计数 */
+    YLIB_TRACE_EV_ISR = 5,         /* 进入中断，arg为异常号(IRQn + 16) */
+    YLIB_TRACE_EV_QUEUE_SEND = 6,  /* 队列/信号量发送，arg为队列地址 */
+    YLIB_TRACE_EV_QUEUE_RECV = 7,  /* 队列/信号量接收，arg为队列地址 */
+    YLIB_TRACE_EV_DEV_BEGIN = 8,   /* yDev操作开始，arg为句柄地址|操作类型 */
+    YLIB_TRACE_EV_DEV_END = 9,     /* yDev操作结束，arg为返回值 */
+    YLIB_TRACE_EV_USER = 16,       /* 16~31留给应用 */
+    YLIB_TRACE_EV_MAX = 32,
+};
+
+/**
+ * @brief 事件掩码
+ */
+#define YLIB_TRACE_MASK(event) (1U << (event))
+
+/**
+ * @brief 默认掩码：除滴答外的全部内核和设备事件
+ */
+#define YLIB_TRACE_MASK_DEFAULT (~YLIB_TRACE_MASK(YLIB_TRACE_EV_TICK))
+
+/**
+ * @brief 跟踪记录
+ */
+struct ylib_trace_rec {
+    uint16_t delta; /* 与上一条记录的时间差(时钟计数) */
+    uint16_t event; /* 事件号 */
+    uint32_t arg;   /* 参数 */
+};
+
+extern volatile uint32_t ylib_trace_mask;
+
+/**
+ * @brief 写入一条记录
+ * @note 一般通过YLIB_TRACE调用，掩码判断在调用前完成
+ */
+void ylib_trace_record(unsigned int event, uint32_t arg);
+
+#if YLIB_TRACE_ENABLE
+/**
+ * @brief 记录事件，未开始记录或事件被屏蔽时只有一次读和判断
+ * @note 表达式形式，可用在逗号表达式中
+ */
+#define YLIB_TRACE(event, arg)                                                                   \
+    ((ylib_trace_mask & YLIB_TRACE_MASK(event)) ? ylib_trace_record((event), (uint32_t)(arg)) \
+                                                 : (void)0)
+#else
+#define YLIB_TRACE(event, arg) ((void)0)
+#endif
+
+/**
+ * @brief 当前异常号
+ */
+YLIB_INLINE uint32_t ylib_trace_ipsr(void)
+{
+#if defined(__arm__)
+    uint32_t ipsr;
+
+    __asm volatile("mrs %0, ipsr" : "=r"(ipsr));
+    return ipsr;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief 中断入口钩子，放在中断处理函数开头
+ */
+#define YLIB_TRACE_ISR() YLIB_TRACE(YLIB_TRACE_EV_ISR, ylib_trace_ipsr())
+
+/**
+ * @brief 注册时间戳时钟
+ * @param now 读取32位自由递增计数的函数，须可在中断和关中断时调用
+ * @param hz 时钟频率，随导出数据一起给解码器
+ */
+void ylib_trace_register_clock(uint32_t (*now)(void), uint32_t hz);
+
+/**
+ * @brief 时钟频率，未注册时为0
+ */
+uint32_t ylib_trace_clock_hz(void);
+
+/**
+ * @brief 开始记录
+ * @param mask 事件掩码，见YLIB_TRACE_MASK
+ * @return 0成功，-1未注册时钟
+ * @note 开始后的第一条记录前自动插入绝对时间记录，之后的时间差以它为起点
+ */
+int ylib_trace_start(uint32_t mask);
+
+/**
+ * @brief 停止记录，已有记录保留
+ */
+void ylib_trace_stop(void);
+
+/**
+ * @brief 清空记录和丢失计数
+ * @note 停止记录后调用
+ */
+void ylib_trace_clear(void);
+
+/**
+ * @brief 读出并移除记录
+ * @param recs 输出缓冲区
+ * @param n 最多条数
+ * @return 实际条数
+ * @note 单消费者，记录期间也可调用
+ */
+unsigned int ylib_trace_read(struct ylib_trace_rec *recs, unsigned int n);
+
+/**
+ * @brief 复制最新的若干条记录，不移除
+ * @param recs 输出缓冲区，按时间先后排列
+ * @param n 最多条数
+ * @return 实际条数
+ * @note 不加锁，供故障现场关中断后保存最近的事件；第一条的时间差相对于更早的记录，解码时从0开始
+ */
+unsigned int ylib_trace_peek_tail(struct ylib_trace_rec *recs, unsigned int n);
+
+/**
+ * @brief 队列中的记录条数
+ */
+unsigned int ylib_trace_count(void);
+
+/**
+ * @brief 开始记录以来丢弃的记录总数
+ */
+uint32_t ylib_trace_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_TRACE_H */
@@ -0,0 +1,134 @@
+/**
+  ******************************************************************************
+  * @file       yLib_work.h
+  * @brief      中断下半部工作队列
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       中断只把静态的工作项挂到对应优先级的队列尾并唤醒工作任务，应用逻辑在任务中执行；
+  *             工作项已在队列中时重复提交直接合并，执行开始后再提交会再执行一次；
+  *             队列本身不带锁，由适配层(work_ylib.c)关中断保护并为每个优先级创建一个工作任务
+  ******************************************************************************
+  */
+#ifndef YLIB_WORK_H
+#define YLIB_WORK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "yLib_def.h"
+#include "yLib_list.h"
+
+/**
+ * @brief 工作函数
+ * @param arg 初始化时设置的参数
+ */
+typedef void (*ylib_work_func_t)(void *arg);
+
+/**
+ * @brief 工作项
+ */
+struct ylib_work {
+    struct ylib_list_head node; /* 所在队列，不在队列中时指向自身 */
+    ylib_work_func_t func;      /* 工作函数 */
+    void *arg;                  /* 函数参数 */
+    uint8_t prio;               /* 队列号，0优先级最高 */
+};
+
+/**
+ * @brief 工作队列
+ */
+struct ylib_work_queue {
+    struct ylib_list_head list; /* 待执行的工作项 */
+    uint32_t posts;             /* 新入队次数 */
+    uint32_t merged;            /* 已在队列中被合并的提交次数 */
+    uint32_t runs;              /* 执行次数 */
+    uint16_t depth;             /* 当前队列长度 */
+    uint16_t max_depth;         /* 队列长度峰值 */
+};
+
+/**
+ * @brief 初始化工作项
+ * @param work 工作项
+ * @param func 工作函数
+ * @param arg 函数参数
+ * @param prio 队列号，小于YLIB_WORK_PRIOS
+ */
+static inline void ylib_work_init(struct ylib_work *work, ylib_work_func_t func, void *arg,
+                                  unsigned int prio)
+{
+    YLIB_INIT_LIST_HEAD(&work->node);
+    work->func = func;
+    work->arg = arg;
+    work->prio = (uint8_t)((prio < YLIB_WORK_PRIOS) ? prio : (YLIB_WORK_PRIOS - 1));
+}
+
+/**
+ * @brief 工作项是否在队列中等待执行
+ */
+static inline int ylib_work_pending(const struct ylib_work *work)
+{
+    return !ylib_list_empty(&work->node);
+}
+
+/**
+ * @brief 初始化工作队列
+ */
+void ylib_work_queue_init(struct ylib_work_queue *queue);
+
+/**
+ * @brief 工作项入队
+ * @return -1已在队列中(合并)，0入队，1入队且队列原来为空(需要唤醒工作任务)
+ */
+int ylib_work_queue_add(struct ylib_work_queue *queue, struct ylib_work *work);
+
+/**
+ * @brief 取出队首工作项
+ * @return 工作项，队列空时返回NULL
+ * @note 取出后工作项不再处于等待状态，执行期间的提交会让它再次入队
+ */
+struct ylib_work *ylib_work_queue_take(struct ylib_work_queue *queue);
+
+/**
+ * @brief 从队列中移除工作项
+ * @return 1已移除，0不在队列中
+ */
+int ylib_work_queue_del(struct ylib_work_queue *queue, struct ylib_work *work);
+
+/* 以下由RTOS适配层(work_ylib.c)实现 */
+
+/**
+ * @brief 创建各优先级的工作任务
+ * @return 0成功，-1失败
+ * @note 创建前提交的工作项在任务启动后执行
+ */
+int ylib_work_service_init(void);
+
+/**
+ * @brief 提交工作项，任务和中断中均可调用
+ * @param work 工作项
+ * @return 1新入队，0已在队列中(合并)
+ * @note 只在队列由空变为非空时唤醒工作任务
+ */
+int ylib_work_post(struct ylib_work *work);
+
+/**
+ * @brief 取消尚未执行的工作项
+ * @return 1已取消，0不在队列中(未提交或正在执行)
+ */
+int ylib_work_cancel(struct ylib_work *work);
+
+/**
+ * @brief 读取队列统计
+ * @param prio 队列号
+ * @param stats 输出，list成员无意义
+ * @return 0成功，-1队列号无效
+ */
+int ylib_work_stats(unsigned int prio, struct ylib_work_queue *stats);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* YLIB_WORK_H */
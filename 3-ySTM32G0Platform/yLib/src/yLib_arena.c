@@ -0,0 +1,30 @@
+/**
+ ******************************************************************************
+ * @file       yLib_arena.c
+ * @brief      线性(bump)分配器实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       分配、标记和回退均为头文件中的内联函数，这里只做初始化
+ ******************************************************************************
+ */
+
+#include "yLib_arena.h"
+
+int ylib_arena_init(ylib_arena_t *arena, void *buffer, size_t size)
+{
+    uintptr_t start;
+    uintptr_t end;
+
+    if (arena == NULL || buffer == NULL)
+        return -1;
+
+    start = ylib_arena_align_up((uintptr_t)buffer);
+    end = ((uintptr_t)buffer + size) & ~(uintptr_t)(YLIB_ARENA_ALIGN - 1);
+    arena->base = (uint8_t *)start;
+    arena->size = (end > start) ? (size_t)(end - start) : 0;
+    arena->used = 0;
+    arena->peak = 0;
+    arena->fails = 0;
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************
+  * @file       yLib_bench.c
+  * @brief      周期计时的微基准测试实现
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       测试体经函数指针调用，计时开销同样经函数指针调用空函数测得，
+  *             两者的调用和返回开销相同，相减后只剩测试体本身
+  ******************************************************************************
+  */
+
+#include "yLib_bench.h"
+
+/* 链接脚本在.ylib_bench段前后定义，用链接器符号界定，链接时优化不会折叠两端的地址比较 */
+extern const struct ylib_bench __ylib_bench_start[];
+extern const struct ylib_bench __ylib_bench_end[];
+
+static uint32_t (*ylib_bench_now)(void);
+static uint32_t (*ylib_bench_since)(uint32_t start);
+
+/**
+ * @brief 空测试体，用于测量计时开销
+ */
+static __attribute__((noinline)) void ylib_bench_empty(void)
+{
+    __asm volatile("" : : : "memory");
+}
+
+/**
+ * @brief 单次采样
+ */
+static uint32_t ylib_bench_sample(void (*run)(void))
+{
+    uint32_t state;
+    uint32_t start;
+    uint32_t cycles;
+
+    YLIB_BENCH_LOCK(state);
+    start = ylib_bench_now();
+    run();
+    cycles = ylib_bench_since(start);
+    YLIB_BENCH_UNLOCK(state);
+    return cycles;
+}
+
+void ylib_bench_register_clock(uint32_t (*now)(void), uint32_t (*since)(uint32_t start))
+{
+    ylib_bench_now = now;
+    ylib_bench_since = since;
+}
+
+const struct ylib_bench *ylib_bench_iterate(unsigned int index)
+{
+    const struct ylib_bench *bench = __ylib_bench_start + index;
+
+    return (bench < __ylib_bench_end) ? bench : NULL;
+}
+
+const struct ylib_bench *ylib_bench_find(const char *name)
+{
+    const struct ylib_bench *bench;
+
+    for (bench = __ylib_bench_start; bench < __ylib_bench_end; bench++) {
+        if (strcmp(bench->name, name) == 0)
+            return bench;
+    }
+    return NULL;
+}
+
+int ylib_bench_run(const struct ylib_bench *bench, unsigned int samples, struct ylib_bench_result *result)
+{
+    uint32_t cycles[YLIB_BENCH_SAMPLES];
+    uint32_t overhead = UINT32_MAX;
+    uint32_t value;
+    unsigned int i;
+    unsigned int j;
+
+    if ((bench == NULL) || (result == NULL) || (ylib_bench_now == NULL) || (ylib_bench_since == NULL))
+        return -1;
+    if ((samples == 0) || (samples > YLIB_BENCH_SAMPLES))
+        samples = YLIB_BENCH_SAMPLES;
+
+    for (i = 0; i < samples; i++) {
+        value = ylib_bench_sample(ylib_bench_empty);
+        if (value < overhead)
+            overhead = value;
+    }
+
+    if (bench->setup != NULL)
+        bench->setup();
+
+    /* 插入排序，样本数很少 */
+    for (i = 0; i < samples; i++) {
+        value = ylib_bench_sample(bench->run);
+        value = (value > overhead) ? (value - overhead) : 0;
+        for (j = i; (j > 0) && (cycles[j - 1] > value); j--)
+            cycles[j] = cycles[j - 1];
+        cycles[j] = value;
+    }
+
+    result->min = cycles[0];
+    result->median = cycles[samples / 2];
+    result->max = cycles[samples - 1];
+    result->overhead = overhead;
+    return 0;
+}
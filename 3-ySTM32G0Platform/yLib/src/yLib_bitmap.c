@@ -0,0 +1,180 @@
+/**
+ ******************************************************************************
+ * @file       yLib_bitmap.c
+ * @brief      位图实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       查找时把字与invert异或，找0和找1共用同一段代码
+ ******************************************************************************
+ */
+
+#include "yLib_bitmap.h"
+
+/**
+ * @brief de Bruijn位扫描查找表
+ * @note ffs表以0x077CB531乘最低置位，fls表以0x07C4ACDD乘低位全填1的值，取高5位查表
+ */
+const uint8_t ylib_debruijn_ffs[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9};
+const uint8_t ylib_debruijn_fls[32] = {
+    0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+    8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31};
+
+/**
+ * @brief 从第bit位开始、共n位(bit + n <= 32)的字掩码
+ */
+static inline uint32_t ylib_bitmap_mask(unsigned int bit, unsigned int n)
+{
+    return (n >= YLIB_BITMAP_BITS_PER_WORD) ? ~0U : (((1U << n) - 1U) << bit);
+}
+
+void ylib_bitmap_zero(uint32_t *map, unsigned int bits)
+{
+    memset(map, 0, YLIB_BITMAP_WORDS(bits) * sizeof(uint32_t));
+}
+
+void ylib_bitmap_fill(uint32_t *map, unsigned int bits)
+{
+    unsigned int words = YLIB_BITMAP_WORDS(bits);
+
+    if (words == 0)
+        return;
+    memset(map, 0xFF, words * sizeof(uint32_t));
+    if (bits % YLIB_BITMAP_BITS_PER_WORD)
+        map[words - 1] = ylib_bitmap_mask(0, bits % YLIB_BITMAP_BITS_PER_WORD);
+}
+
+void ylib_bitmap_set_range(uint32_t *map, unsigned int start, unsigned int n)
+{
+    uint32_t *p = map + start / YLIB_BITMAP_BITS_PER_WORD;
+    unsigned int bit = start % YLIB_BITMAP_BITS_PER_WORD;
+    unsigned int cnt;
+
+    while (n) {
+        cnt = YLIB_BITMAP_BITS_PER_WORD - bit;
+        if (cnt > n)
+            cnt = n;
+        *p++ |= ylib_bitmap_mask(bit, cnt);
+        n -= cnt;
+        bit = 0;
+    }
+}
+
+void ylib_bitmap_clear_range(uint32_t *map, unsigned int start, unsigned int n)
+{
+    uint32_t *p = map + start / YLIB_BITMAP_BITS_PER_WORD;
+    unsigned int bit = start % YLIB_BITMAP_BITS_PER_WORD;
+    unsigned int cnt;
+
+    while (n) {
+        cnt = YLIB_BITMAP_BITS_PER_WORD - bit;
+        if (cnt > n)
+            cnt = n;
+        *p++ &= ~ylib_bitmap_mask(bit, cnt);
+        n -= cnt;
+        bit = 0;
+    }
+}
+
+/**
+ * @brief 查找实现，invert为0时找1，为全1时找0
+ */
+static unsigned int ylib_bitmap_find(const uint32_t *map, unsigned int bits, unsigned int start,
+                                     uint32_t invert)
+{
+    unsigned int words = YLIB_BITMAP_WORDS(bits);
+    unsigned int idx;
+    uint32_t word;
+
+    if (start >= bits)
+        return bits;
+
+    idx = start / YLIB_BITMAP_BITS_PER_WORD;
+    word = (map[idx] ^ invert) & (~0U << (start % YLIB_BITMAP_BITS_PER_WORD));
+    while (!word) {
+        if (++idx >= words)
+            return bits;
+        word = map[idx] ^ invert;
+    }
+
+    /* 最后一个字中超出bits的位可能被误认为命中 */
+    start = idx * YLIB_BITMAP_BITS_PER_WORD + ylib_ffs32(word);
+    return (start < bits) ? start : bits;
+}
+
+unsigned int ylib_bitmap_find_next_set(const uint32_t *map, unsigned int bits, unsigned int start)
+{
+    return ylib_bitmap_find(map, bits, start, 0);
+}
+
+unsigned int ylib_bitmap_find_next_zero(const uint32_t *map, unsigned int bits, unsigned int start)
+{
+    return ylib_bitmap_find(map, bits, start, ~0U);
+}
+
+unsigned int ylib_bitmap_find_zero_area(const uint32_t *map, unsigned int bits, unsigned int start,
+                                        unsigned int n)
+{
+    unsigned int set;
+
+    if (n == 0 || n > bits)
+        return bits;
+
+    for (;;) {
+        start = ylib_bitmap_find_next_zero(map, bits, start);
+        if (start > bits - n)
+            return bits;
+        /* [start, start + n)中有1时从该位之后重新找 */
+        set = ylib_bitmap_find_next_set(map, start + n, start);
+        if (set >= start + n)
+            return start;
+        start = set + 1;
+    }
+}
+
+unsigned int ylib_bitmap_weight(const uint32_t *map, unsigned int bits)
+{
+    unsigned int words = bits / YLIB_BITMAP_BITS_PER_WORD;
+    unsigned int count = 0;
+    unsigned int i;
+    uint32_t w;
+
+    for (i = 0; i <= words; i++) {
+        if (i == words) {
+            if (bits % YLIB_BITMAP_BITS_PER_WORD == 0)
+                break;
+            w = map[i] & ylib_bitmap_mask(0, bits % YLIB_BITMAP_BITS_PER_WORD);
+        } else {
+            w = map[i];
+        }
+        w = w - ((w >> 1) & 0x55555555U);
+        w = (w & 0x33333333U) + ((w >> 2) & 0x33333333U);
+        w = (w + (w >> 4)) & 0x0F0F0F0FU;
+        count += (w * 0x01010101U) >> 24;
+    }
+    return count;
+}
+
+unsigned int ylib_bitmap_alloc(uint32_t *map, unsigned int bits, unsigned int n)
+{
+    uint32_t state;
+    unsigned int start;
+
+    YLIB_BITMAP_LOCK(state);
+    start = ylib_bitmap_find_zero_area(map, bits, 0, n);
+    if (start < bits)
+        ylib_bitmap_set_range(map, start, n);
+    YLIB_BITMAP_UNLOCK(state);
+    return start;
+}
+
+void ylib_bitmap_free(uint32_t *map, unsigned int start, unsigned int n)
+{
+    uint32_t state;
+
+    YLIB_BITMAP_LOCK(state);
+    ylib_bitmap_clear_range(map, start, n);
+    YLIB_BITMAP_UNLOCK(state);
+}
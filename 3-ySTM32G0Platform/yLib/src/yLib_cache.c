@@ -0,0 +1,319 @@
+/**
+ ******************************************************************************
+ * @file       yLib_cache.c
+ * @brief      定长对象缓存(slab)实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note
+ ******************************************************************************
+ */
+
+#include "yLib_cache.h"
+#include "yLib_heap.h"
+
+/* 全局缓存链表 */
+static ylib_cache_t *cache_list = NULL;
+
+/* 查找对象所在分区，须在锁内调用 */
+static ylib_cache_slab_t *ylib_cache_find_slab(ylib_cache_t *cache, const void *obj)
+{
+    const uint8_t *p = (const uint8_t *)obj;
+    ylib_cache_slab_t *slab;
+
+    if (cache->hint && p >= cache->hint->start && p < cache->hint->end)
+        return cache->hint;
+    for (slab = cache->slabs; slab; slab = slab->next)
+    {
+        if (p >= slab->start && p < slab->end)
+            return slab;
+    }
+    return NULL;
+}
+
+/* 从堆申请一个新分区，分区头、对齐填充和对象区一次分配 */
+static ylib_cache_slab_t *ylib_cache_new_slab(ylib_cache_t *cache)
+{
+    ylib_cache_slab_t *slab;
+    uintptr_t start;
+    uint8_t err;
+
+    slab = (ylib_cache_slab_t *)ylib_malloc(sizeof(ylib_cache_slab_t) + cache->align - 1u +
+                                            (size_t)cache->per_slab * cache->stats.stride);
+    if (slab == NULL)
+        return NULL;
+
+    start = ((uintptr_t)(slab + 1) + cache->align - 1u) & ~(uintptr_t)(cache->align - 1u);
+    slab->mem = YLibMemCreate((void *)start, cache->per_slab, cache->stats.stride, &err);
+    if (err != YLIB_MEM_NO_ERR)
+    {
+        ylib_free(slab);
+        return NULL;
+    }
+    slab->start = (uint8_t *)start;
+    slab->end = slab->start + (size_t)cache->per_slab * slab->mem->MemBlkSize;
+    slab->next = NULL;
+    return slab;
+}
+
+/* 释放分区及其控制块 */
+static void ylib_cache_free_slab(ylib_cache_slab_t *slab)
+{
+    YLibMemDel(slab->mem);
+    ylib_free(slab);
+}
+
+/* 从已有分区取一个对象并更新统计，须在锁内调用 */
+static void *ylib_cache_take(ylib_cache_t *cache)
+{
+    ylib_cache_slab_t *slab = cache->hint;
+    void *obj = NULL;
+    uint8_t err;
+
+    if (slab == NULL || slab->mem->MemNFree == 0u)
+    {
+        for (slab = cache->slabs; slab; slab = slab->next)
+        {
+            if (slab->mem->MemNFree != 0u)
+                break;
+        }
+    }
+    if (slab)
+    {
+        obj = YLibMemGet(slab->mem, &err);
+        cache->hint = slab;
+        cache->stats.in_use++;
+        cache->stats.allocs++;
+        if (cache->stats.in_use > cache->stats.peak)
+            cache->stats.peak = cache->stats.in_use;
+    }
+    return obj;
+}
+
+ylib_cache_t *ylib_cache_create(const char *name, size_t obj_size, size_t align, size_t count)
+{
+    ylib_cache_t *cache;
+    ylib_cache_slab_t *slab;
+    uint32_t lock;
+
+    if (align == 0u)
+        align = configBYTE_ALIGNMENT;
+    if (obj_size == 0u || count < 2u || (align & (align - 1u)) != 0u)
+        return NULL;
+    // 分区按configBYTE_ALIGNMENT取整块大小，对齐不能比它小
+    if (align < configBYTE_ALIGNMENT)
+        align = configBYTE_ALIGNMENT;
+
+    cache = (ylib_cache_t *)ylib_malloc(sizeof(ylib_cache_t));
+    if (cache == NULL)
+        return NULL;
+    memset(cache, 0, sizeof(ylib_cache_t));
+    cache->align = (uint32_t)align;
+    cache->per_slab = (uint32_t)count;
+    cache->stats.name = name;
+    cache->stats.obj_size = (uint32_t)obj_size;
+    // 对象间隔按对齐取整，空闲时开头存放分区链表指针
+    cache->stats.stride = (uint32_t)((obj_size + align - 1u) & ~(align - 1u));
+
+    slab = ylib_cache_new_slab(cache);
+    if (slab == NULL)
+    {
+        ylib_free(cache);
+        return NULL;
+    }
+    cache->slabs = slab;
+    cache->hint = slab;
+    cache->stats.slabs = 1u;
+    cache->stats.total = cache->per_slab;
+
+    YLIB_MEM_LOCK(lock);
+    cache->next = cache_list;
+    cache_list = cache;
+    YLIB_MEM_UNLOCK(lock);
+    return cache;
+}
+
+void ylib_cache_set_hooks(ylib_cache_t *cache, ylib_cache_ctor_t ctor, ylib_cache_dtor_t dtor)
+{
+    if (cache == NULL)
+        return;
+    cache->ctor = ctor;
+    cache->dtor = dtor;
+}
+
+void ylib_cache_set_limit(ylib_cache_t *cache, uint32_t max_slabs)
+{
+    if (cache)
+        cache->max_slabs = max_slabs;
+}
+
+void *ylib_cache_alloc(ylib_cache_t *cache)
+{
+    ylib_cache_slab_t *slab;
+    void *obj;
+    uint32_t lock;
+    bool grow;
+
+    if (cache == NULL)
+        return NULL;
+
+    YLIB_MEM_LOCK(lock);
+    obj = ylib_cache_take(cache);
+    YLIB_MEM_UNLOCK(lock);
+
+    // 分区用尽，在锁外向堆申请新分区
+    if (obj == NULL)
+    {
+        slab = NULL;
+        grow = (cache->max_slabs == 0u || cache->stats.slabs < cache->max_slabs);
+#if YLIB_NO_HEAP_AFTER_INIT
+        // 堆封闭后不再扩充，按初始化时的分区数当作定长池
+        grow = grow && !ylib_heap_sealed();
+#endif
+        if (grow)
+            slab = ylib_cache_new_slab(cache);
+
+        YLIB_MEM_LOCK(lock);
+        if (slab)
+        {
+            slab->next = cache->slabs;
+            cache->slabs = slab;
+            cache->hint = slab;
+            cache->stats.slabs++;
+            cache->stats.total += cache->per_slab;
+        }
+        else
+        {
+            cache->stats.grow_fails++;
+        }
+        obj = ylib_cache_take(cache);
+        YLIB_MEM_UNLOCK(lock);
+    }
+
+    if (obj && cache->ctor)
+        cache->ctor(obj);
+    return obj;
+}
+
+int ylib_cache_free(ylib_cache_t *cache, void *obj)
+{
+    ylib_cache_slab_t *slab;
+    uint32_t lock;
+
+    if (cache == NULL || obj == NULL)
+        return -1;
+
+    // 对象未归还前所在分区不会被回收，查到后可在锁外调用析构
+    YLIB_MEM_LOCK(lock);
+    slab = ylib_cache_find_slab(cache, obj);
+    YLIB_MEM_UNLOCK(lock);
+    if (slab == NULL)
+        return -1;
+
+    if (cache->dtor)
+        cache->dtor(obj);
+
+    YLIB_MEM_LOCK(lock);
+    if (YLibMemPut(slab->mem, obj) != YLIB_MEM_NO_ERR)
+    {
+        YLIB_MEM_UNLOCK(lock);
+        return -1;
+    }
+    cache->hint = slab;
+    cache->stats.in_use--;
+    cache->stats.frees++;
+    YLIB_MEM_UNLOCK(lock);
+    return 0;
+}
+
+uint32_t ylib_cache_shrink(ylib_cache_t *cache)
+{
+    ylib_cache_slab_t **link;
+    ylib_cache_slab_t *slab;
+    ylib_cache_slab_t *released = NULL;
+    uint32_t count = 0u;
+    uint32_t lock;
+
+    if (cache == NULL)
+        return 0u;
+
+    YLIB_MEM_LOCK(lock);
+    link = &cache->slabs;
+    while ((slab = *link) != NULL)
+    {
+        if (cache->stats.slabs > 1u && slab->mem->MemNFree == slab->mem->MemNBlks)
+        {
+            *link = slab->next;
+            slab->next = released;
+            released = slab;
+            cache->stats.slabs--;
+            cache->stats.total -= cache->per_slab;
+            count++;
+        }
+        else
+        {
+            link = &slab->next;
+        }
+    }
+    cache->hint = cache->slabs;
+    YLIB_MEM_UNLOCK(lock);
+
+    while (released)
+    {
+        slab = released;
+        released = slab->next;
+        ylib_cache_free_slab(slab);
+    }
+    return count;
+}
+
+void ylib_cache_destroy(ylib_cache_t *cache)
+{
+    ylib_cache_t **link;
+    ylib_cache_slab_t *slab;
+    uint32_t lock;
+
+    if (cache == NULL)
+        return;
+
+    YLIB_MEM_LOCK(lock);
+    for (link = &cache_list; *link; link = &(*link)->next)
+    {
+        if (*link == cache)
+        {
+            *link = cache->next;
+            break;
+        }
+    }
+    YLIB_MEM_UNLOCK(lock);
+
+    while ((slab = cache->slabs) != NULL)
+    {
+        cache->slabs = slab->next;
+        ylib_cache_free_slab(slab);
+    }
+    ylib_free(cache);
+}
+
+void ylib_cache_get_stats(ylib_cache_t *cache, ylib_cache_stats_t *stats)
+{
+    uint32_t lock;
+
+    if (cache == NULL || stats == NULL)
+        return;
+    YLIB_MEM_LOCK(lock);
+    *stats = cache->stats;
+    YLIB_MEM_UNLOCK(lock);
+}
+
+ylib_cache_t *ylib_cache_iterate(uint32_t index)
+{
+    ylib_cache_t *cache;
+    uint32_t lock;
+
+    YLIB_MEM_LOCK(lock);
+    for (cache = cache_list; cache && index; cache = cache->next)
+        index--;
+    YLIB_MEM_UNLOCK(lock);
+    return cache;
+}
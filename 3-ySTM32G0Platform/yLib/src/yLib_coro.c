@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ * @file       yLib_coro.c
+ * @brief      无栈协程实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       执行器就是工作队列，协程本身只有工作项、定时器和恢复点；
+ *             定时器回调在定时器服务任务中执行，优先级高于工作任务，停止定时器后不会再收到超时
+ ******************************************************************************
+ */
+
+#include "yLib_coro.h"
+
+/**
+ * @brief 工作项入口，运行协程到下一个等待点
+ */
+static void ylib_coro_run(void *arg)
+{
+    struct ylib_coro *co = (struct ylib_coro *)arg;
+
+    if (!co->running)
+        return;
+    if (co->func(co) == YLIB_CORO_DONE) {
+        co->running = 0;
+        ylib_timer_stop(&co->timer);
+    }
+}
+
+/**
+ * @brief 超时回调
+ */
+static void ylib_coro_expire(void *arg)
+{
+    struct ylib_coro *co = (struct ylib_coro *)arg;
+
+    co->timeout = 1;
+    ylib_coro_wake(co);
+}
+
+void ylib_coro_init(struct ylib_coro *co, ylib_coro_func_t func, unsigned int prio)
+{
+    ylib_work_init(&co->work, ylib_coro_run, co, prio);
+    ylib_timer_init(&co->timer, ylib_coro_expire, co);
+    co->func = func;
+    co->result = 0;
+    co->value = 0;
+    co->line = 0;
+    co->timeout = 0;
+    co->running = 0;
+}
+
+void ylib_coro_start(struct ylib_coro *co)
+{
+    ylib_timer_stop(&co->timer);
+    co->line = 0;
+    co->timeout = 0;
+    co->running = 1;
+    ylib_work_post(&co->work);
+}
+
+void ylib_coro_stop(struct ylib_coro *co)
+{
+    co->running = 0;
+    ylib_timer_stop(&co->timer);
+    ylib_work_cancel(&co->work);
+    co->line = 0;
+}
+
+void ylib_coro_wake(struct ylib_coro *co)
+{
+    if (co->running)
+        ylib_work_post(&co->work);
+}
+
+void ylib_coro_complete(struct ylib_coro *co, int32_t result, uint32_t value)
+{
+    co->result = result;
+    co->value = value;
+    ylib_coro_wake(co);
+}
+
+void ylib_coro_arm(struct ylib_coro *co, uint32_t ms)
+{
+    ylib_timer_stop(&co->timer);
+    co->timeout = 0;
+    ylib_timer_start(&co->timer, ms, 0);
+}
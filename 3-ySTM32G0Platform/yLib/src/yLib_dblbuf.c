@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ * @file       yLib_dblbuf.c
+ * @brief      DMA循环采集的多块缓冲实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       生产者只写filled/overruns/order/dma，消费者只写released/late；
+ *             块数为2的幂次，中断中只有掩码和乘法，不调用除法库函数
+ ******************************************************************************
+ */
+
+#include "yLib_dblbuf.h"
+
+int ylib_dblbuf_init(ylib_dblbuf_t *db, void *buffer, uint32_t block_size, unsigned int count)
+{
+    if ((db == NULL) || (buffer == NULL) || (block_size == 0U))
+        return -1;
+    if ((count < 2U) || (count > YLIB_DBLBUF_MAX) || ((count & (count - 1U)) != 0U))
+        return -1;
+
+    db->base = (uint8_t *)buffer;
+    db->block_size = block_size;
+    db->mask = (uint8_t)(count - 1U);
+    ylib_dblbuf_reset(db);
+
+    return 0;
+}
+
+void ylib_dblbuf_reset(ylib_dblbuf_t *db)
+{
+    db->dma = 0;
+    db->filled = 0;
+    db->overruns = 0;
+    db->released = 0;
+    db->late = 0;
+}
+
+void *ylib_dblbuf_produce(ylib_dblbuf_t *db, unsigned int block)
+{
+    uint32_t filled = db->filled;
+
+    block &= db->mask;
+    db->order[filled & db->mask] = (uint8_t)block;
+    db->filled = filled + 1U;
+    db->dma = (uint8_t)((block + 1U) & db->mask);
+
+    /* 未释放的块数达到块数时，DMA正在写入的块还没有被释放 */
+    if ((filled + 1U - db->released) > db->mask)
+        db->overruns++;
+
+    return ylib_dblbuf_block(db, block);
+}
+
+void *ylib_dblbuf_acquire(ylib_dblbuf_t *db)
+{
+    uint32_t released = db->released;
+    uint32_t pending = db->filled - released;
+
+    if (pending == 0U)
+        return NULL;
+
+    /* 最多保留块数-1块，更早的已被DMA覆盖 */
+    if (pending > db->mask) {
+        db->late += pending - db->mask;
+        released += pending - db->mask;
+        db->released = released;
+    }
+
+    return ylib_dblbuf_block(db, db->order[released & db->mask]);
+}
+
+int ylib_dblbuf_release(ylib_dblbuf_t *db)
+{
+    uint32_t released = db->released;
+    int intact;
+
+    if (db->filled == released)
+        return 0;
+
+    /* 持有期间DMA转满一圈回到这一块 */
+    intact = ((db->filled - released) <= db->mask) ? 1 : 0;
+    db->released = released + 1U;
+
+    return intact;
+}
@@ -0,0 +1,303 @@
+/**
+ ******************************************************************************
+ * @file       yLib_dsp.c
+ * @brief      定点数学与滤波实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       倒数和平方根先把输入归一化到[0.5, 1)或[0.25, 1)，高位查表得初值，牛顿迭代每次
+ *             精度翻倍：倒数y = y*(2 - d*y)，平方根倒数y = y*(3 - x*y*y)/2，sqrt(x) = x*y
+ ******************************************************************************
+ */
+
+#include "yLib_dsp.h"
+#include "yLib_bitmap.h"
+
+/* 滤波函数放入RAM，每个样本的周期数不受Flash等待周期和预取影响 */
+#if YLIB_DSP_RAM
+#define YLIB_DSP_FUNC YLIB_RAMFUNC
+#else
+#define YLIB_DSP_FUNC
+#endif
+
+/**
+ * @brief 四分之一周期正弦表，sin(i*π/256)，Q15
+ */
+static const ylib_q15_t ylib_sin_table[129] = {
+    0, 402, 804, 1206, 1608, 2009, 2411, 2811,
+    3212, 3612, 4011, 4410, 4808, 5205, 5602, 5998,
+    6393, 6787, 7180, 7571, 7962, 8351, 8740, 9127,
+    9512, 9896, 10279, 10660, 11039, 11417, 11793, 12167,
+    12540, 12910, 13279, 13646, 14010, 14373, 14733, 15091,
+    15447, 15800, 16151, 16500, 16846, 17190, 17531, 17869,
+    18205, 18538, 18868, 19195, 19520, 19841, 20160, 20475,
+    20788, 21097, 21403, 21706, 22006, 22302, 22595, 22884,
+    23170, 23453, 23732, 24008, 24279, 24548, 24812, 25073,
+    25330, 25583, 25833, 26078, 26320, 26557, 26791, 27020,
+    27246, 27467, 27684, 27897, 28106, 28311, 28511, 28707,
+    28899, 29086, 29269, 29448, 29622, 29792, 29957, 30118,
+    30274, 30425, 30572, 30715, 30853, 30986, 31114, 31238,
+    31357, 31471, 31581, 31686, 31786, 31881, 31972, 32058,
+    32138, 32214, 32286, 32352, 32413, 32470, 32522, 32568,
+    32610, 32647, 32679, 32706, 32729, 32746, 32758, 32766,
+    32767,};
+
+/**
+ * @brief 倒数初值，下标为归一化除数[2^31, 2^32)的第26~30位，取区间中点的2^62/d
+ */
+static const uint32_t ylib_recip_seed[32] = {
+    0x7E07E07EU, 0x7A44C6B0U, 0x76B981DBU, 0x73615A24U, 0x70381C0EU, 0x6D3A06D4U,
+    0x6A63BD82U, 0x67B23A54U, 0x6522C3F3U, 0x62B2E43EU, 0x60606060U, 0x5E293206U,
+    0x5C0B8170U, 0x5A05A05AU, 0x58160581U, 0x563B48C2U, 0x54741FACU, 0x52BF5A81U,
+    0x511BE196U, 0x4F88B2F4U, 0x4E04E04EU, 0x4C8F8D29U, 0x4B27ED36U, 0x49CD42E2U,
+    0x487EDE05U, 0x473C1AB7U, 0x46046046U, 0x44D72045U, 0x43B3D5B0U, 0x429A042AU,
+    0x4189374CU, 0x40810204U,};
+
+/**
+ * @brief 平方根倒数初值，下标为归一化输入[2^30, 2^32)的第26~31位减16，取区间中点的2^30/sqrt(x/2^32)
+ */
+static const uint32_t ylib_rsqrt_seed[48] = {
+    0x7E0BB221U, 0x7A64336BU, 0x77099EFBU, 0x73F1F68DU, 0x7114F644U, 0x6E6BB6E9U,
+    0x6BF06762U, 0x699E16D0U, 0x67708AF9U, 0x65641FAEU, 0x6375AD16U, 0x61A27320U,
+    0x5FE808FCU, 0x5E444FAFU, 0x5CB56711U, 0x5B39A4C7U, 0x59CF8CBCU, 0x5875CADEU,
+    0x572B2DE0U, 0x55EEA2C4U, 0x54BF311AU, 0x539BF7CDU, 0x52842A5FU, 0x51770E8FU,
+    0x5073FA50U, 0x4F7A5202U, 0x4E8986EAU, 0x4DA115DAU, 0x4CC08605U, 0x4BE767F5U,
+    0x4B1554A6U, 0x4A49ECB3U, 0x4984D7A4U, 0x48C5C34BU, 0x480C6332U, 0x4758701CU,
+    0x46A9A794U, 0x45FFCB80U, 0x455AA1CBU, 0x44B9F40BU, 0x441D8F3BU, 0x43854374U,
+    0x42F0E3AEU, 0x4260458EU, 0x41D3412AU, 0x4149B0E5U, 0x40C3713BU, 0x404060A1U,};
+
+static inline ylib_q15_t ylib_q15_sat64(int64_t x)
+{
+    if (x > YLIB_Q15_MAX)
+        return YLIB_Q15_MAX;
+    if (x < YLIB_Q15_MIN)
+        return YLIB_Q15_MIN;
+    return (ylib_q15_t)x;
+}
+
+uint32_t ylib_recip(uint32_t d, unsigned int *shift)
+{
+    unsigned int k = ylib_fls32(d);
+    uint32_t dn = d << (31U - k);
+    uint32_t y = ylib_recip_seed[(dn >> 26) - 32U];
+    uint32_t t;
+    int i;
+
+    /* y为Q30的1/(dn/2^32)；初值约6位精度，三次迭代到Q30的舍入误差 */
+    for (i = 0; i < 3; i++) {
+        t = (uint32_t)(((uint64_t)dn * y) >> 32);
+        y = (uint32_t)(((uint64_t)y * (0x80000000U - t)) >> 30);
+    }
+
+    /* 1/d = 2^(31-k)/dn = y/2^(31+k) */
+    *shift = 31U + k;
+    return y;
+}
+
+ylib_q15_t ylib_q15_div(ylib_q15_t num, ylib_q15_t den)
+{
+    uint32_t n = (num < 0) ? (uint32_t)-(int32_t)num : (uint32_t)num;
+    uint32_t d = (den < 0) ? (uint32_t)-(int32_t)den : (uint32_t)den;
+    unsigned int shift;
+    uint32_t m;
+    int32_t q;
+
+    if (n >= d)
+        return ((num < 0) != (den < 0)) ? YLIB_Q15_MIN : YLIB_Q15_MAX;
+
+    m = ylib_recip(d, &shift);
+    q = (int32_t)ylib_recip_mul(n << 15, m, shift);
+    return ylib_q15_sat(((num < 0) != (den < 0)) ? -q : q);
+}
+
+/**
+ * @brief 归一化输入的平方根倒数
+ * @param xn 归一化输入，[2^30, 2^32)
+ * @param iters 迭代次数，初值约7位精度，每次约翻倍
+ * @return Q30的1/sqrt(xn/2^32)
+ */
+static uint32_t ylib_rsqrt_norm(uint32_t xn, unsigned int iters)
+{
+    uint32_t y = ylib_rsqrt_seed[(xn >> 26) - 16U];
+    uint32_t t;
+
+    while (iters--) {
+        t = (uint32_t)(((uint64_t)y * y) >> 32); /* y*y，Q28 */
+        t = (uint32_t)(((uint64_t)xn * t) >> 32); /* x*y*y，Q28 */
+        y = (uint32_t)(((uint64_t)y * (0x30000000U - t)) >> 29);
+    }
+    return y;
+}
+
+uint32_t ylib_sqrt_u32(uint32_t x)
+{
+    unsigned int k;
+    uint32_t xn;
+    uint32_t s;
+
+    if (x == 0)
+        return 0;
+
+    /* 左移偶数位归一化，sqrt(xn) = xn*y >> 46 */
+    k = (31U - ylib_fls32(x)) >> 1;
+    xn = x << (2U * k);
+    s = (uint32_t)(((uint64_t)xn * ylib_rsqrt_norm(xn, 2)) >> (46U + k));
+
+    /* 迭代结果与真值最多差1，校正到floor */
+    while ((uint64_t)s * s > x)
+        s--;
+    while ((uint64_t)(s + 1U) * (s + 1U) <= x)
+        s++;
+    return s;
+}
+
+ylib_q15_t ylib_q15_sqrt(ylib_q15_t x)
+{
+    if (x <= 0)
+        return 0;
+    return (ylib_q15_t)ylib_sqrt_u32((uint32_t)x << 15);
+}
+
+ylib_q31_t ylib_q31_sqrt(ylib_q31_t x)
+{
+    uint64_t n = (uint64_t)x << 31;
+    uint32_t u;
+    uint32_t un;
+    unsigned int k;
+    uint64_t s;
+
+    if (x <= 0)
+        return 0;
+
+    /* sqrt(x*2^31) = sqrt(2x)*2^15 */
+    u = (uint32_t)x << 1;
+    k = (31U - ylib_fls32(u)) >> 1;
+    un = u << (2U * k);
+    s = ((uint64_t)un * ylib_rsqrt_norm(un, 3)) >> (31U + k);
+
+    /* y只有Q30精度，结果差几个LSB；按余数校正到floor再四舍五入 */
+    while (s * s > n)
+        s--;
+    while ((s + 1U) * (s + 1U) <= n)
+        s++;
+    if (n - s * s > s)
+        s++;
+    return (s > (uint64_t)YLIB_Q31_MAX) ? YLIB_Q31_MAX : (ylib_q31_t)s;
+}
+
+ylib_q15_t ylib_q15_sin(ylib_angle_t angle)
+{
+    unsigned int quad = angle >> 14;
+    unsigned int idx = angle & 0x3FFFU;
+    unsigned int i;
+    unsigned int frac;
+    int32_t v;
+
+    /* 第二、四象限镜像 */
+    if (quad & 1U)
+        idx = 0x4000U - idx;
+
+    i = idx >> 7;
+    frac = idx & 0x7FU;
+    v = ylib_sin_table[i];
+    if (frac)
+        v += ((ylib_sin_table[i + 1] - v) * (int32_t)frac + 64) >> 7;
+
+    return (ylib_q15_t)((quad & 2U) ? -v : v);
+}
+
+void ylib_fir_q15_init(struct ylib_fir_q15 *fir, const ylib_q15_t *coeffs, ylib_q15_t *state,
+                       unsigned int taps)
+{
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->taps = taps;
+    fir->pos = 0;
+    memset(state, 0, 2U * taps * sizeof(ylib_q15_t));
+}
+
+YLIB_DSP_FUNC void ylib_fir_q15_process(struct ylib_fir_q15 *fir, const ylib_q15_t *in, ylib_q15_t *out,
+                                        unsigned int n)
+{
+    const ylib_q15_t *c;
+    const ylib_q15_t *s;
+    unsigned int taps = fir->taps;
+    unsigned int pos = fir->pos;
+    unsigned int i;
+    ylib_q15_t x;
+    int64_t acc;
+
+    while (n--) {
+        x = *in++;
+        fir->state[pos] = x;
+        fir->state[pos + taps] = x;
+
+        /* state[pos + taps]为最新样本，向前连续taps个 */
+        c = fir->coeffs;
+        s = &fir->state[pos + taps];
+        acc = 0;
+        for (i = 0; i < taps; i++)
+            acc += (int32_t)c[i] * *s--;
+        *out++ = ylib_q15_sat64((acc + 0x4000) >> 15);
+
+        if (++pos == taps)
+            pos = 0;
+    }
+    fir->pos = pos;
+}
+
+void ylib_biquad_q15_init(struct ylib_biquad_q15 *iir, const ylib_q15_t *coeffs, ylib_q15_t *state,
+                          unsigned int stages, unsigned int shift)
+{
+    iir->coeffs = coeffs;
+    iir->state = state;
+    iir->stages = stages;
+    iir->shift = shift;
+    memset(state, 0, 4U * stages * sizeof(ylib_q15_t));
+}
+
+YLIB_DSP_FUNC void ylib_biquad_q15_process(struct ylib_biquad_q15 *iir, const ylib_q15_t *in,
+                                           ylib_q15_t *out, unsigned int n)
+{
+    const ylib_q15_t *c = iir->coeffs;
+    ylib_q15_t *st = iir->state;
+    unsigned int rshift = 15U - iir->shift;
+    int64_t round = rshift ? ((int64_t)1 << (rshift - 1U)) : 0;
+    const ylib_q15_t *src = in;
+    unsigned int stage;
+    unsigned int k;
+    int32_t x1, x2, y1, y2;
+    int64_t acc;
+    ylib_q15_t x;
+    ylib_q15_t y;
+
+    /* 逐级处理整段，第二级起在out上原地进行 */
+    for (stage = 0; stage < iir->stages; stage++) {
+        x1 = st[0];
+        x2 = st[1];
+        y1 = st[2];
+        y2 = st[3];
+        for (k = 0; k < n; k++) {
+            x = src[k];
+            acc = (int32_t)c[0] * x;
+            acc += (int32_t)c[1] * x1;
+            acc += (int32_t)c[2] * x2;
+            acc += (int32_t)c[3] * y1;
+            acc += (int32_t)c[4] * y2;
+            y = ylib_q15_sat64((acc + round) >> rshift);
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            out[k] = y;
+        }
+        st[0] = (ylib_q15_t)x1;
+        st[1] = (ylib_q15_t)x2;
+        st[2] = (ylib_q15_t)y1;
+        st[3] = (ylib_q15_t)y2;
+
+        c += 5;
+        st += 4;
+        src = out;
+    }
+}
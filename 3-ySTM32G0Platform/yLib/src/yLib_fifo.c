@@ -10,6 +10,7 @@
   */
 
 #include "yLib_fifo.h"
+#include "yLib_heap.h"
 
 /**
  * @brief 内部复制函数 - 从线性缓冲区复制到环形缓冲区
@@ -68,19 +69,19 @@ struct ylib_fifo *ylib_fifo_alloc(unsigned int size, size_t element_size)
     if (!size || (size & (size - 1)))
         return NULL;
 
-    fifo = malloc(sizeof(struct ylib_fifo));
+    fifo = ylib_malloc(sizeof(struct ylib_fifo));
     if (!fifo)
         return NULL;
 
-    buffer = malloc(size * element_size);
+    buffer = ylib_malloc(size * element_size);
     if (!buffer) {
-        free(fifo);
+        ylib_free(fifo);
         return NULL;
     }
 
     if (ylib_fifo_init(fifo, buffer, size) < 0) {
-        free(buffer);
-        free(fifo);
+        ylib_free(buffer);
+        ylib_free(fifo);
         return NULL;
     }
 
@@ -94,8 +95,8 @@ struct ylib_fifo *ylib_fifo_alloc(unsigned int size, size_t element_size)
 void ylib_fifo_free(struct ylib_fifo *fifo)
 {
     if (fifo) {
-        free(fifo->data);
-        free(fifo);
+        ylib_free(fifo->data);
+        ylib_free(fifo);
     }
 }
 
@@ -163,16 +164,69 @@ unsigned int ylib_fifo_peek(struct ylib_fifo *fifo, void *buffer,
  * @brief 跳过指定数量的元素
  * @param fifo FIFO指针
  * @param len 要跳过的元素个数
- * @param element_size 元素大小
  * @return 实际跳过的元素个数
  */
-unsigned int ylib_fifo_skip(struct ylib_fifo *fifo, size_t len)
+unsigned int ylib_fifo_skip(struct ylib_fifo *fifo, unsigned int len)
 {
     len = MIN(len, fifo->in - fifo->out);
     fifo->out += len;
     return len;
 }
 
+/**
+ * @brief 预留可直接写入的空闲区域
+ * @param fifo FIFO指针
+ * @param len 希望预留的元素个数
+ * @param span 区域输出
+ * @param element_size 元素大小
+ * @return 实际预留的元素个数
+ */
+unsigned int ylib_fifo_reserve(struct ylib_fifo *fifo, unsigned int len,
+                               ylib_span_t *span, size_t element_size)
+{
+    len = MIN(len, ylib_fifo_avail(fifo));
+    YLIB_RING_BARRIER();
+    return ylib_span_init(span, fifo->data, fifo->mask, fifo->in, len, element_size);
+}
+
+/**
+ * @brief 发布已写入预留区域的元素
+ * @param fifo FIFO指针
+ * @param len 元素个数
+ */
+void ylib_fifo_commit(struct ylib_fifo *fifo, unsigned int len)
+{
+    YLIB_RING_BARRIER();
+    fifo->in += len;
+}
+
+/**
+ * @brief 获取可直接读取的数据区域
+ * @param fifo FIFO指针
+ * @param len 希望读取的元素个数
+ * @param span 区域输出
+ * @param element_size 元素大小
+ * @return 实际可读的元素个数
+ */
+unsigned int ylib_fifo_peek_linear(struct ylib_fifo *fifo, unsigned int len,
+                                   ylib_span_t *span, size_t element_size)
+{
+    len = MIN(len, fifo->in - fifo->out);
+    YLIB_RING_BARRIER();
+    return ylib_span_init(span, fifo->data, fifo->mask, fifo->out, len, element_size);
+}
+
+/**
+ * @brief 释放已读取的元素
+ * @param fifo FIFO指针
+ * @param len 元素个数
+ */
+void ylib_fifo_release(struct ylib_fifo *fifo, unsigned int len)
+{
+    YLIB_RING_BARRIER();
+    fifo->out += len;
+}
+
 /**
  * @brief min宏的简单实现
  */
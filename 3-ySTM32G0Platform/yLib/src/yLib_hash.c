@@ -0,0 +1,273 @@
+/**
+ ******************************************************************************
+ * @file       yLib_hash.c
+ * @brief      开放寻址哈希表实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       每个元素离自己起始槽的距离称为探测距离；插入时距离更短的元素让位，
+ *             查找时遇到距离比当前更短的元素即可判定不存在；删除时把后续元素依次前移一格
+ ******************************************************************************
+ */
+
+#include "yLib_hash.h"
+#include "yLib_heap.h"
+
+/* 元素在槽idx处的探测距离 */
+#define YLIB_HASH_DIST(hash, idx, h) (((idx) - (h)) & (hash)->mask)
+
+/**
+ * @brief 计算键哈希
+ */
+static uint32_t ylib_hash_key(const struct ylib_hash *hash, uintptr_t key)
+{
+    uint32_t h;
+
+    if (hash->key_type == YLIB_HASH_KEY_STR)
+    {
+        /* FNV-1a */
+        const uint8_t *p = (const uint8_t *)key;
+
+        h = 2166136261u;
+        while (*p)
+            h = (h ^ *p++) * 16777619u;
+    }
+    else
+    {
+        /* 整数混洗，低位也受高位影响 */
+        h = (uint32_t)key;
+        h ^= h >> 16;
+        h *= 0x45d9f3bu;
+        h ^= h >> 16;
+    }
+
+    /* 0留给空槽 */
+    return h ? h : 1;
+}
+
+/**
+ * @brief 比较键
+ */
+static bool ylib_hash_key_equal(const struct ylib_hash *hash, const ylib_hash_slot_t *slot,
+                                uint32_t h, uintptr_t key)
+{
+    if (slot->hash != h)
+        return false;
+    if (hash->key_type == YLIB_HASH_KEY_STR)
+        return slot->key == key || strcmp((const char *)slot->key, (const char *)key) == 0;
+    return slot->key == key;
+}
+
+/**
+ * @brief 查找键所在槽
+ */
+static ylib_hash_slot_t *ylib_hash_lookup(struct ylib_hash *hash, uint32_t h, uintptr_t key)
+{
+    uint32_t idx = h & hash->mask;
+    uint32_t dist = 0;
+    ylib_hash_slot_t *slot;
+
+    for (;;)
+    {
+        slot = &hash->slots[idx];
+        if (slot->hash == 0 || YLIB_HASH_DIST(hash, idx, slot->hash) < dist)
+            return NULL;
+        if (ylib_hash_key_equal(hash, slot, h, key))
+            return slot;
+        idx = (idx + 1) & hash->mask;
+        dist++;
+    }
+}
+
+/**
+ * @brief 放入一个确定不存在的元素，调用者保证有空槽
+ */
+static void ylib_hash_place(struct ylib_hash *hash, ylib_hash_slot_t entry)
+{
+    uint32_t idx = entry.hash & hash->mask;
+    uint32_t dist = 0;
+    uint32_t slot_dist;
+    ylib_hash_slot_t *slot;
+    ylib_hash_slot_t tmp;
+
+    for (;;)
+    {
+        slot = &hash->slots[idx];
+        if (slot->hash == 0)
+        {
+            *slot = entry;
+            return;
+        }
+
+        /* 距离更短的元素让位，继续为它找位置 */
+        slot_dist = YLIB_HASH_DIST(hash, idx, slot->hash);
+        if (slot_dist < dist)
+        {
+            tmp = *slot;
+            *slot = entry;
+            entry = tmp;
+            dist = slot_dist;
+        }
+        idx = (idx + 1) & hash->mask;
+        dist++;
+    }
+}
+
+/**
+ * @brief 堆存储的表扩容一倍
+ */
+static int ylib_hash_grow(struct ylib_hash *hash)
+{
+    ylib_hash_slot_t *old = hash->slots;
+    uint32_t size = hash->mask + 1;
+    uint32_t i;
+
+    hash->slots = ylib_calloc(size * 2, sizeof(ylib_hash_slot_t));
+    if (hash->slots == NULL)
+    {
+        hash->slots = old;
+        return -1;
+    }
+    hash->mask = size * 2 - 1;
+
+    for (i = 0; i < size; i++)
+    {
+        if (old[i].hash != 0)
+            ylib_hash_place(hash, old[i]);
+    }
+    ylib_free(old);
+    return 0;
+}
+
+int ylib_hash_init(struct ylib_hash *hash, ylib_hash_slot_t *slots, unsigned int size, uint8_t key_type)
+{
+    /* 检查size是否为2的幂次 */
+    if (hash == NULL || slots == NULL || !size || (size & (size - 1)))
+        return -1;
+
+    hash->slots = slots;
+    hash->mask = size - 1;
+    hash->key_type = key_type;
+    hash->dynamic = 0;
+    ylib_hash_clear(hash);
+    return 0;
+}
+
+int ylib_hash_create(struct ylib_hash *hash, unsigned int size, uint8_t key_type)
+{
+    unsigned int n = YLIB_HASH_MIN_SIZE;
+
+    while (n < size)
+        n <<= 1;
+
+    hash->slots = ylib_calloc(n, sizeof(ylib_hash_slot_t));
+    if (hash->slots == NULL)
+        return -1;
+    hash->mask = n - 1;
+    hash->count = 0;
+    hash->key_type = key_type;
+    hash->dynamic = 1;
+    return 0;
+}
+
+void ylib_hash_destroy(struct ylib_hash *hash)
+{
+    if (hash->dynamic)
+    {
+        ylib_free(hash->slots);
+        hash->slots = NULL;
+        hash->mask = 0;
+        hash->count = 0;
+    }
+}
+
+void ylib_hash_clear(struct ylib_hash *hash)
+{
+    memset(hash->slots, 0, (hash->mask + 1) * sizeof(ylib_hash_slot_t));
+    hash->count = 0;
+}
+
+int ylib_hash_put(struct ylib_hash *hash, uintptr_t key, void *value)
+{
+    ylib_hash_slot_t entry;
+    ylib_hash_slot_t *slot;
+
+    entry.hash = ylib_hash_key(hash, key);
+    slot = ylib_hash_lookup(hash, entry.hash, key);
+    if (slot != NULL)
+    {
+        slot->value = value;
+        return 0;
+    }
+
+    /* 超过装载率：堆存储扩容，静态存储拒绝 */
+    if ((hash->count + 1) * 100 > (hash->mask + 1) * YLIB_HASH_LOAD_PERCENT)
+    {
+        if (!hash->dynamic)
+            return -1;
+#if YLIB_NO_HEAP_AFTER_INIT
+        /* 堆封闭后不再扩容，按当前槽数当作定长表 */
+        if (ylib_heap_sealed())
+            return -1;
+#endif
+        if (ylib_hash_grow(hash) < 0)
+            return -1;
+    }
+
+    entry.key = key;
+    entry.value = value;
+    ylib_hash_place(hash, entry);
+    hash->count++;
+    return 0;
+}
+
+void **ylib_hash_find(struct ylib_hash *hash, uintptr_t key)
+{
+    ylib_hash_slot_t *slot;
+
+    if (hash->count == 0)
+        return NULL;
+    slot = ylib_hash_lookup(hash, ylib_hash_key(hash, key), key);
+    return slot ? &slot->value : NULL;
+}
+
+int ylib_hash_remove(struct ylib_hash *hash, uintptr_t key, void **value)
+{
+    ylib_hash_slot_t *slot;
+    uint32_t idx;
+    uint32_t next;
+
+    if (hash->count == 0)
+        return -1;
+    slot = ylib_hash_lookup(hash, ylib_hash_key(hash, key), key);
+    if (slot == NULL)
+        return -1;
+    if (value != NULL)
+        *value = slot->value;
+
+    /* 后续元素前移，直到遇到空槽或已在起始槽的元素 */
+    idx = (uint32_t)(slot - hash->slots);
+    for (;;)
+    {
+        next = (idx + 1) & hash->mask;
+        if (hash->slots[next].hash == 0 || YLIB_HASH_DIST(hash, next, hash->slots[next].hash) == 0)
+            break;
+        hash->slots[idx] = hash->slots[next];
+        idx = next;
+    }
+    hash->slots[idx].hash = 0;
+    hash->count--;
+    return 0;
+}
+
+ylib_hash_slot_t *ylib_hash_next(struct ylib_hash *hash, unsigned int *iter)
+{
+    while (*iter <= hash->mask)
+    {
+        ylib_hash_slot_t *slot = &hash->slots[(*iter)++];
+
+        if (slot->hash != 0)
+            return slot;
+    }
+    return NULL;
+}
@@ -10,20 +10,373 @@
  */
 
 #include "yLib_heap.h"
+#include "yLib_bitmap.h"
 #include <string.h>
 
+#if YLIB_HEAP_USE_LINKER_ARENA
+/* 链接脚本在.bss之后到栈保留区之前划出的堆区 */
+extern uint8_t __ylib_heap_start[];
+extern uint8_t __ylib_heap_end[];
+#else
 #ifndef YLIB_HEAP_STATIC_BUFFER_SIZE
 #define YLIB_HEAP_STATIC_BUFFER_SIZE YLIB_TOTAL_HEAP_SIZE
 #endif
 
 static uint8_t ylib_heap_static_buffer[YLIB_HEAP_STATIC_BUFFER_SIZE];
+#endif
 
 ylib_heap_t g_ylib_heap = {0};
 
 static ylib_malloc_failed_hook_t malloc_failed_hook = NULL;
 static ylib_free_hook_t free_hook = NULL;
 static ylib_malloc_hook_t malloc_hook = NULL;
+static ylib_fault_hook_t fault_hook = NULL;
+
+#if YLIB_NO_HEAP_AFTER_INIT
+static volatile bool heap_sealed = false;
+static const void *volatile heap_seal_caller; /* 封闭后第一次分配的调用者，调试器可查看 */
+#endif
+
+#if configHEAP_CHECK_ENABLE
+static ylib_heap_fault_t heap_fault; /* 第一次损坏记录 */
+static bool heap_faulted = false;
+
+/* 块被合并进前面的块后不再是块头，巡检游标跟到合并后的块，须在锁内调用 */
+#define ylib_heap_scrub_merge(from, into)   \
+    do                                      \
+    {                                       \
+        if (g_ylib_heap.scrub == (from))    \
+            g_ylib_heap.scrub = (into);     \
+    } while (0)
+#else
+#define ylib_heap_scrub_merge(from, into) ((void)0)
+#endif
+
+#if configHEAP_USE_TLSF
+/* =============================================================================
+ * TLSF分配器
+ * 空闲块按大小映射到(一级, 二级)链表，两级位图记录非空链表，
+ * 查找只做两次位扫描；块头记录物理前一块，释放时与前后空闲块立即合并
+ * =============================================================================
+ */
+
+/* 块头低两位标志，块大小按configBYTE_ALIGNMENT对齐因此低位恒为0 */
+#define YLIB_TLSF_BLOCK_FREE ((size_t)1U)
+#define YLIB_TLSF_PREV_FREE ((size_t)2U)
+#define YLIB_TLSF_FLAGS (YLIB_TLSF_BLOCK_FREE | YLIB_TLSF_PREV_FREE)
+
+#define YLIB_TLSF_HEADER_SIZE (sizeof(ylib_block_link_t))
+#define YLIB_TLSF_SMALL_BLOCK (1U << YLIB_TLSF_FL_SHIFT)
+#define YLIB_TLSF_BLOCK_MAX (((size_t)1U << (configHEAP_TLSF_FL_MAX + 1)) - configBYTE_ALIGNMENT)
+
+/**
+ * @brief 空闲块链表指针，存放在空闲块的用户区
+ */
+typedef struct
+{
+    ylib_block_link_t *next_free_block; /* 同一链表的下一个空闲块 */
+    ylib_block_link_t *prev_free_block; /* 同一链表的上一个空闲块 */
+} ylib_tlsf_links_t;
+
+/* 最小块需容纳头部和空闲链表指针 */
+#define YLIB_TLSF_LINKS_SIZE \
+    ((sizeof(ylib_tlsf_links_t) > configMINIMAL_BLOCK_SIZE) ? sizeof(ylib_tlsf_links_t) : configMINIMAL_BLOCK_SIZE)
+#define YLIB_TLSF_BLOCK_MIN ylib_heap_align_up(YLIB_TLSF_HEADER_SIZE + YLIB_TLSF_LINKS_SIZE)
+
+/* 最低置位位号，word不能为0 */
+static inline uint32_t ylib_tlsf_ffs(uint32_t word)
+{
+    return ylib_ffs32(word);
+}
+
+/* 最高置位位号，word不能为0 */
+static inline uint32_t ylib_tlsf_fls(uint32_t word)
+{
+    return ylib_fls32(word);
+}
+
+static inline size_t ylib_tlsf_size(const ylib_block_link_t *block)
+{
+    return block->block_size & ~YLIB_TLSF_FLAGS;
+}
+
+static inline ylib_block_link_t *ylib_tlsf_next(const ylib_block_link_t *block)
+{
+    return (ylib_block_link_t *)((uint8_t *)block + ylib_tlsf_size(block));
+}
+
+static inline ylib_tlsf_links_t *ylib_tlsf_links(ylib_block_link_t *block)
+{
+    return (ylib_tlsf_links_t *)ylib_heap_get_user_ptr(block);
+}
+
+/* 块大小映射到链表索引 */
+static void ylib_tlsf_mapping(size_t size, uint32_t *fl, uint32_t *sl)
+{
+    uint32_t s = (uint32_t)size;
+    uint32_t t;
+
+    if (s < YLIB_TLSF_SMALL_BLOCK)
+    {
+        *fl = 0;
+        *sl = s >> YLIB_TLSF_ALIGN_LOG2;
+    }
+    else
+    {
+        t = ylib_tlsf_fls(s);
+        *sl = (s >> (t - configHEAP_TLSF_SL_LOG2)) ^ YLIB_TLSF_SL_COUNT;
+        *fl = t - YLIB_TLSF_FL_SHIFT + 1U;
+    }
+}
+
+static void ylib_tlsf_insert(ylib_block_link_t *block)
+{
+    uint32_t fl, sl;
+    ylib_block_link_t *head;
+
+    ylib_tlsf_mapping(ylib_tlsf_size(block), &fl, &sl);
+    head = g_ylib_heap.blocks[fl][sl];
+    ylib_tlsf_links(block)->next_free_block = head;
+    ylib_tlsf_links(block)->prev_free_block = NULL;
+    if (head)
+        ylib_tlsf_links(head)->prev_free_block = block;
+    g_ylib_heap.blocks[fl][sl] = block;
+    g_ylib_heap.fl_bitmap |= 1U << fl;
+    g_ylib_heap.sl_bitmap[fl] |= 1U << sl;
+#if configHEAP_STATS_ENABLE
+    g_ylib_heap.stats.number_of_free_blocks++;
+#endif
+}
+
+static void ylib_tlsf_remove(ylib_block_link_t *block)
+{
+    uint32_t fl, sl;
+    ylib_block_link_t *next = ylib_tlsf_links(block)->next_free_block;
+    ylib_block_link_t *prev = ylib_tlsf_links(block)->prev_free_block;
+
+    ylib_tlsf_mapping(ylib_tlsf_size(block), &fl, &sl);
+    if (next)
+        ylib_tlsf_links(next)->prev_free_block = prev;
+    if (prev)
+    {
+        ylib_tlsf_links(prev)->next_free_block = next;
+    }
+    else
+    {
+        g_ylib_heap.blocks[fl][sl] = next;
+        if (next == NULL)
+        {
+            g_ylib_heap.sl_bitmap[fl] &= ~(1U << sl);
+            if (g_ylib_heap.sl_bitmap[fl] == 0)
+                g_ylib_heap.fl_bitmap &= ~(1U << fl);
+        }
+    }
+#if configHEAP_STATS_ENABLE
+    g_ylib_heap.stats.number_of_free_blocks--;
+#endif
+}
+
+/* 查找不小于size的空闲块：先把size上取到所在二级区间的上界，保证链表中任一块都够用 */
+static ylib_block_link_t *ylib_tlsf_find(size_t size)
+{
+    uint32_t fl, sl, sl_map, fl_map;
+
+    if (size >= YLIB_TLSF_SMALL_BLOCK)
+        size += ((size_t)1U << (ylib_tlsf_fls((uint32_t)size) - configHEAP_TLSF_SL_LOG2)) - 1U;
+    ylib_tlsf_mapping(size, &fl, &sl);
+    if (fl >= YLIB_TLSF_FL_COUNT)
+        return NULL;
+
+    sl_map = g_ylib_heap.sl_bitmap[fl] & (~0U << sl);
+    if (sl_map == 0)
+    {
+        fl_map = g_ylib_heap.fl_bitmap & (~0U << (fl + 1U));
+        if (fl_map == 0)
+            return NULL;
+        fl = ylib_tlsf_ffs(fl_map);
+        sl_map = g_ylib_heap.sl_bitmap[fl];
+    }
+    sl = ylib_tlsf_ffs(sl_map);
+
+    return g_ylib_heap.blocks[fl][sl];
+}
 
+/* 已摘下的块按size切分，剩余部分作为空闲块放回 */
+static void ylib_tlsf_split(ylib_block_link_t *block, size_t size)
+{
+    size_t total = ylib_tlsf_size(block);
+    ylib_block_link_t *remain;
+
+    if (total - size < YLIB_TLSF_BLOCK_MIN)
+        return;
+
+    remain = (ylib_block_link_t *)((uint8_t *)block + size);
+    remain->block_size = (total - size) | YLIB_TLSF_BLOCK_FREE;
+#if configHEAP_CHECK_ENABLE
+    remain->magic = YLIB_HEAP_MAGIC_FREE;
+#endif
+    block->block_size = size | (block->block_size & YLIB_TLSF_FLAGS);
+    ylib_tlsf_next(remain)->prev_phys_block = remain;
+    ylib_tlsf_next(remain)->block_size |= YLIB_TLSF_PREV_FREE;
+    ylib_tlsf_insert(remain);
+}
+
+/* 请求大小换算为块大小，0表示超出上限 */
+static size_t ylib_tlsf_block_size(size_t wanted_size)
+{
+    size_t size;
+
+    if (wanted_size > YLIB_TLSF_BLOCK_MAX - YLIB_TLSF_HEADER_SIZE)
+        return 0;
+    size = ylib_heap_align_up(wanted_size + YLIB_TLSF_HEADER_SIZE);
+    return (size < YLIB_TLSF_BLOCK_MIN) ? YLIB_TLSF_BLOCK_MIN : size;
+}
+
+static int ylib_heap_init_region(void *heap_buffer, size_t heap_size)
+{
+    uintptr_t start, end;
+    ylib_block_link_t *first, *sentinel;
+    size_t size;
+
+    start = ylib_heap_align_up((uintptr_t)heap_buffer);
+    end = ylib_heap_align_down((uintptr_t)heap_buffer + heap_size);
+    if (end <= start || end - start < YLIB_TLSF_BLOCK_MIN + YLIB_TLSF_HEADER_SIZE)
+        return -1;
+
+    // 末尾留一个大小为0的已用哨兵块，合并时不必判断堆边界
+    size = end - start - YLIB_TLSF_HEADER_SIZE;
+    if (size > YLIB_TLSF_BLOCK_MAX)
+        size = YLIB_TLSF_BLOCK_MAX;
+
+    memset(&g_ylib_heap, 0, sizeof(g_ylib_heap));
+    g_ylib_heap.heap_start = (uint8_t *)start;
+    g_ylib_heap.heap_end = (uint8_t *)start + size + YLIB_TLSF_HEADER_SIZE;
+    g_ylib_heap.heap_size = size;
+    g_ylib_heap.initialized = true;
+
+    first = (ylib_block_link_t *)start;
+    first->prev_phys_block = NULL;
+    first->block_size = size | YLIB_TLSF_BLOCK_FREE;
+#if configHEAP_CHECK_ENABLE
+    first->magic = YLIB_HEAP_MAGIC_FREE;
+#endif
+    sentinel = ylib_tlsf_next(first);
+    sentinel->prev_phys_block = first;
+    sentinel->block_size = YLIB_TLSF_PREV_FREE;
+#if configHEAP_CHECK_ENABLE
+    sentinel->magic = YLIB_HEAP_MAGIC_ALLOC;
+#endif
+#if configHEAP_STATS_ENABLE
+    g_ylib_heap.stats.total_heap_size = size;
+    g_ylib_heap.stats.free_heap_size = size;
+    g_ylib_heap.stats.minimum_ever_free_heap_size = size;
+    g_ylib_heap.stats.max_block_size = size;
+    g_ylib_heap.stats.min_block_size = size;
+#endif
+    ylib_tlsf_insert(first);
+    return 0;
+}
+
+/* 取出一个不小于wanted_size的块并标记为已分配，失败返回NULL */
+static ylib_block_link_t *ylib_heap_take(size_t wanted_size)
+{
+    ylib_block_link_t *block;
+    size_t size;
+
+    size = ylib_tlsf_block_size(wanted_size);
+    block = size ? ylib_tlsf_find(size) : NULL;
+    if (block == NULL)
+        return NULL;
+
+    ylib_tlsf_remove(block);
+    ylib_tlsf_split(block, size);
+    block->block_size &= ~YLIB_TLSF_BLOCK_FREE;
+    ylib_tlsf_next(block)->block_size &= ~YLIB_TLSF_PREV_FREE;
+    return block;
+}
+
+/* 已分配块放回空闲链表，与物理前后的空闲块合并 */
+static void ylib_heap_give(ylib_block_link_t *block)
+{
+    ylib_block_link_t *next;
+
+    block->block_size |= YLIB_TLSF_BLOCK_FREE;
+
+    if (block->block_size & YLIB_TLSF_PREV_FREE)
+    {
+        ylib_block_link_t *prev = block->prev_phys_block;
+        ylib_tlsf_remove(prev);
+        prev->block_size += ylib_tlsf_size(block);
+        ylib_heap_scrub_merge(block, prev);
+        block = prev;
+    }
+    next = ylib_tlsf_next(block);
+    if (next->block_size & YLIB_TLSF_BLOCK_FREE)
+    {
+        ylib_tlsf_remove(next);
+        block->block_size += ylib_tlsf_size(next);
+        ylib_heap_scrub_merge(next, block);
+        next = ylib_tlsf_next(block);
+    }
+    next->prev_phys_block = block;
+    next->block_size |= YLIB_TLSF_PREV_FREE;
+    ylib_tlsf_insert(block);
+}
+
+/* 原地调整已分配块大小：缩小时释放尾部，扩大时吞并后一空闲块，返回0表示需要搬移 */
+static int ylib_heap_resize_in_place(ylib_block_link_t *block, size_t wanted_size)
+{
+    size_t size = ylib_tlsf_block_size(wanted_size);
+    size_t old = ylib_tlsf_size(block);
+    ylib_block_link_t *next = ylib_tlsf_next(block);
+    ylib_block_link_t *tail;
+
+    if (size == 0)
+        return 0;
+    if (size > old)
+    {
+        if (!(next->block_size & YLIB_TLSF_BLOCK_FREE) || old + ylib_tlsf_size(next) < size)
+            return 0;
+        ylib_tlsf_remove(next);
+        block->block_size += ylib_tlsf_size(next);
+        ylib_heap_scrub_merge(next, block);
+        next = ylib_tlsf_next(block);
+        next->block_size &= ~YLIB_TLSF_PREV_FREE;
+    }
+
+    // 切下的尾部与后一空闲块合并后放回
+    if (ylib_tlsf_size(block) - size >= YLIB_TLSF_BLOCK_MIN)
+    {
+        tail = (ylib_block_link_t *)((uint8_t *)block + size);
+        tail->block_size = ylib_tlsf_size(block) - size;
+        block->block_size = size | (block->block_size & YLIB_TLSF_FLAGS);
+        if (next->block_size & YLIB_TLSF_BLOCK_FREE)
+        {
+            ylib_tlsf_remove(next);
+            tail->block_size += ylib_tlsf_size(next);
+            ylib_heap_scrub_merge(next, tail);
+            next = ylib_tlsf_next(tail);
+        }
+        tail->block_size |= YLIB_TLSF_BLOCK_FREE;
+#if configHEAP_CHECK_ENABLE
+        tail->magic = YLIB_HEAP_MAGIC_FREE;
+#endif
+        tail->prev_phys_block = block;
+        next->prev_phys_block = tail;
+        next->block_size |= YLIB_TLSF_PREV_FREE;
+        ylib_tlsf_insert(tail);
+    }
+    return 1;
+}
+
+#define ylib_heap_block_size(block) ylib_tlsf_size(block)
+#else
+static inline ylib_block_link_t *ylib_heap_phys_next(ylib_block_link_t *block)
+{
+    return (ylib_block_link_t *)((uint8_t *)block + block->block_size);
+}
+
+/* 按地址顺序插入空闲链表，并与物理相邻的前后空闲块合并 */
 static void ylib_heap_insert_block(ylib_block_link_t *block)
 {
     ylib_block_link_t *prev = NULL, *cur = g_ylib_heap.free_blocks_list;
@@ -32,8 +385,20 @@ static void ylib_heap_insert_block(ylib_block_link_t *block)
         prev = cur;
         cur = cur->next_free_block;
     }
+    if (cur && ylib_heap_phys_next(block) == cur)
+    {
+        block->block_size += cur->block_size;
+        ylib_heap_scrub_merge(cur, block);
+        cur = cur->next_free_block;
+    }
     block->next_free_block = cur;
-    if (prev)
+    if (prev && ylib_heap_phys_next(prev) == block)
+    {
+        prev->block_size += block->block_size;
+        prev->next_free_block = cur;
+        ylib_heap_scrub_merge(block, prev);
+    }
+    else if (prev)
     {
         prev->next_free_block = block;
     }
@@ -43,13 +408,8 @@ static void ylib_heap_insert_block(ylib_block_link_t *block)
     }
 }
 
-int ylib_heap_init(void *heap_buffer, size_t heap_size)
+static int ylib_heap_init_region(void *heap_buffer, size_t heap_size)
 {
-    if (heap_buffer == NULL)
-    {
-        heap_buffer = ylib_heap_static_buffer;
-        heap_size = YLIB_HEAP_STATIC_BUFFER_SIZE;
-    }
     heap_size = ylib_heap_align_down(heap_size);
     if (heap_size < sizeof(ylib_block_link_t) * 2)
         return -1;
@@ -57,6 +417,9 @@ int ylib_heap_init(void *heap_buffer, size_t heap_size)
     g_ylib_heap.heap_end = g_ylib_heap.heap_start + heap_size;
     g_ylib_heap.heap_size = heap_size;
     g_ylib_heap.initialized = true;
+#if configHEAP_CHECK_ENABLE
+    g_ylib_heap.scrub = NULL;
+#endif
     ylib_block_link_t *first = (ylib_block_link_t *)g_ylib_heap.heap_start;
     first->block_size = heap_size;
 #if configHEAP_CHECK_ENABLE
@@ -76,12 +439,9 @@ int ylib_heap_init(void *heap_buffer, size_t heap_size)
     return 0;
 }
 
-void *ylib_malloc(size_t wanted_size)
+/* 取出一个不小于wanted_size的块并标记为已分配，失败返回NULL */
+static ylib_block_link_t *ylib_heap_take(size_t wanted_size)
 {
-    if (!g_ylib_heap.initialized)
-        ylib_heap_init(NULL, 0);
-    if (wanted_size == 0)
-        return NULL;
     wanted_size = ylib_heap_align_up(wanted_size + sizeof(ylib_block_link_t));
     ylib_block_link_t *prev = NULL, *cur = g_ylib_heap.free_blocks_list;
     while (cur)
@@ -99,10 +459,6 @@ void *ylib_malloc(size_t wanted_size)
                 cur->block_size = wanted_size;
                 cur->next_free_block = split;
             }
-            else
-            {
-                wanted_size = cur->block_size;
-            }
             if (prev)
             {
                 prev->next_free_block = cur->next_free_block;
@@ -111,72 +467,305 @@ void *ylib_malloc(size_t wanted_size)
             {
                 g_ylib_heap.free_blocks_list = cur->next_free_block;
             }
-#if configHEAP_CHECK_ENABLE
-            cur->magic = YLIB_HEAP_MAGIC_ALLOC;
-#endif
-#if configHEAP_STATS_ENABLE
-            g_ylib_heap.stats.free_heap_size -= wanted_size;
-            if (g_ylib_heap.stats.free_heap_size < g_ylib_heap.stats.minimum_ever_free_heap_size)
-                g_ylib_heap.stats.minimum_ever_free_heap_size = g_ylib_heap.stats.free_heap_size;
-            g_ylib_heap.stats.successful_allocations++;
-#endif
-            if (malloc_hook)
-                malloc_hook(ylib_heap_get_user_ptr(cur), wanted_size - sizeof(ylib_block_link_t));
-            return ylib_heap_get_user_ptr(cur);
+            return cur;
         }
         prev = cur;
         cur = cur->next_free_block;
     }
-    if (malloc_failed_hook)
-        malloc_failed_hook();
     return NULL;
 }
 
-void ylib_free(void *pv)
+#define ylib_heap_give(block) ylib_heap_insert_block(block)
+
+/* 原地调整已分配块大小：缩小时释放尾部，扩大时吞并物理相邻的后一空闲块，返回0表示需要搬移 */
+static int ylib_heap_resize_in_place(ylib_block_link_t *block, size_t wanted_size)
+{
+    size_t size = ylib_heap_align_up(wanted_size + sizeof(ylib_block_link_t));
+    size_t old = block->block_size;
+    ylib_block_link_t *next = ylib_heap_phys_next(block);
+    ylib_block_link_t *prev = NULL, *cur = g_ylib_heap.free_blocks_list;
+
+    if (size > old)
+    {
+        while (cur && cur < next)
+        {
+            prev = cur;
+            cur = cur->next_free_block;
+        }
+        if (cur != next || old + next->block_size < size)
+            return 0;
+        if (prev)
+            prev->next_free_block = next->next_free_block;
+        else
+            g_ylib_heap.free_blocks_list = next->next_free_block;
+        block->block_size += next->block_size;
+        ylib_heap_scrub_merge(next, block);
+    }
+
+    // 剩余部分足够成块时切下放回空闲链表
+    if (block->block_size - size > configMINIMAL_BLOCK_SIZE + sizeof(ylib_block_link_t))
+    {
+        ylib_block_link_t *tail = (ylib_block_link_t *)((uint8_t *)block + size);
+        tail->block_size = block->block_size - size;
+#if configHEAP_CHECK_ENABLE
+        tail->magic = YLIB_HEAP_MAGIC_FREE;
+#endif
+        block->block_size = size;
+        ylib_heap_insert_block(tail);
+    }
+    return 1;
+}
+
+#define ylib_heap_block_size(block) ((block)->block_size)
+#endif
+
+int ylib_heap_init(void *heap_buffer, size_t heap_size)
 {
+    if (heap_buffer == NULL)
+    {
+#if YLIB_HEAP_USE_LINKER_ARENA
+        heap_buffer = __ylib_heap_start;
+        heap_size = (size_t)(__ylib_heap_end - __ylib_heap_start);
+#else
+        heap_buffer = ylib_heap_static_buffer;
+        heap_size = YLIB_HEAP_STATIC_BUFFER_SIZE;
+#endif
+    }
+    return ylib_heap_init_region(heap_buffer, heap_size);
+}
+
+/* 块可用大小，不含块头和尾部哨兵 */
+#define ylib_heap_user_size(block) (ylib_heap_block_size(block) - sizeof(ylib_block_link_t) - YLIB_HEAP_GUARD_SIZE)
+
+#if configHEAP_GUARD_ENABLE
+static inline uint32_t *ylib_heap_guard(ylib_block_link_t *block)
+{
+    return (uint32_t *)((uint8_t *)block + ylib_heap_block_size(block) - YLIB_HEAP_GUARD_SIZE);
+}
+
+/* 在块末尾写入哨兵，块大小确定后在锁内调用 */
+static inline void ylib_heap_guard_set(ylib_block_link_t *block)
+{
+    *ylib_heap_guard(block) = YLIB_HEAP_GUARD_WORD ^ (uint32_t)(uintptr_t)block;
+}
+
+static inline int ylib_heap_guard_ok(ylib_block_link_t *block)
+{
+    return *ylib_heap_guard(block) == (YLIB_HEAP_GUARD_WORD ^ (uint32_t)(uintptr_t)block);
+}
+#else
+#define ylib_heap_guard_set(block) ((void)0)
+#define ylib_heap_guard_ok(block) (1)
+#endif
+
+/* 已分配块大小变化后更新空闲统计和所属者占用，须在锁内调用 */
+static inline void ylib_heap_account(ylib_block_link_t *block, size_t old_size, size_t new_size)
+{
+#if configHEAP_STATS_ENABLE
+    g_ylib_heap.stats.free_heap_size = g_ylib_heap.stats.free_heap_size + old_size - new_size;
+    if (g_ylib_heap.stats.free_heap_size < g_ylib_heap.stats.minimum_ever_free_heap_size)
+        g_ylib_heap.stats.minimum_ever_free_heap_size = g_ylib_heap.stats.free_heap_size;
+#if configHEAP_OWNER_MAX
+    size_t *in_use = &g_ylib_heap.stats.owner_in_use[block->owner];
+    *in_use = *in_use + new_size - old_size;
+    if (*in_use > g_ylib_heap.stats.owner_peak[block->owner])
+        g_ylib_heap.stats.owner_peak[block->owner] = *in_use;
+#endif
+#endif
+    (void)block;
+}
+
+void *ylib_malloc_from(size_t wanted_size, uint8_t owner, const void *caller)
+{
+    ylib_block_link_t *block = NULL;
+    size_t size = 0;
+    uint32_t lock;
+
+    if (wanted_size == 0)
+        return NULL;
+#if YLIB_NO_HEAP_AFTER_INIT
+    if (heap_sealed)
+        ylib_heap_seal_trap(caller);
+#endif
+    YLIB_HEAP_LOCK(lock);
+    if (!g_ylib_heap.initialized)
+        ylib_heap_init(NULL, 0);
+    if (g_ylib_heap.initialized)
+        block = ylib_heap_take(wanted_size + YLIB_HEAP_GUARD_SIZE);
+    if (block)
+    {
+        size = ylib_heap_block_size(block);
+#if configHEAP_CHECK_ENABLE
+        block->magic = YLIB_HEAP_MAGIC_ALLOC;
+#endif
+        ylib_heap_guard_set(block);
+#if configHEAP_OWNER_MAX
+        block->owner = (owner < configHEAP_OWNER_MAX) ? owner : YLIB_HEAP_OWNER_APP;
+#endif
+        ylib_heap_account(block, 0, size);
+#if configHEAP_STATS_ENABLE
+        g_ylib_heap.stats.successful_allocations++;
+#endif
+    }
+    YLIB_HEAP_UNLOCK(lock);
+    (void)owner;
+
+    // 钩子在锁外调用，允许其中打印或记录
+    if (block == NULL)
+    {
+        if (malloc_failed_hook)
+            malloc_failed_hook();
+        return NULL;
+    }
+    if (malloc_hook)
+        malloc_hook(ylib_heap_get_user_ptr(block), size - sizeof(ylib_block_link_t) - YLIB_HEAP_GUARD_SIZE, caller);
+    return ylib_heap_get_user_ptr(block);
+}
+
+void *ylib_malloc_owner(size_t wanted_size, uint8_t owner)
+{
+    return ylib_malloc_from(wanted_size, owner, __builtin_return_address(0));
+}
+
+void *ylib_malloc(size_t wanted_size)
+{
+    return ylib_malloc_from(wanted_size, YLIB_HEAP_OWNER_APP, __builtin_return_address(0));
+}
+
+void ylib_free_from(void *pv, const void *caller)
+{
+    ylib_block_link_t *block;
+    size_t size;
+    uint32_t lock;
+
     if (!pv)
         return;
-    ylib_block_link_t *block = ylib_heap_get_block_ptr(pv);
+    block = ylib_heap_get_block_ptr(pv);
+    YLIB_HEAP_LOCK(lock);
 #if configHEAP_CHECK_ENABLE
     if (block->magic != YLIB_HEAP_MAGIC_ALLOC)
+    {
+        YLIB_HEAP_UNLOCK(lock);
         return;
+    }
+#if configHEAP_GUARD_ENABLE
+    // 哨兵已被改写说明越界写到了块外，不放回空闲链表以免扩散
+    if (!ylib_heap_guard_ok(block))
+    {
+        ylib_heap_fault_t fault = {block, NULL, YLIB_HEAP_OWNER_UNKNOWN, YLIB_HEAP_FAULT_GUARD};
+#if configHEAP_OWNER_MAX
+        fault.owner = block->owner;
+#endif
+        YLIB_HEAP_UNLOCK(lock);
+        ylib_heap_report_fault(&fault);
+        return;
+    }
+#endif
     block->magic = YLIB_HEAP_MAGIC_FREE;
 #endif
-    ylib_heap_insert_block(block);
+    // 合并后块头可能已失效，先取出大小
+    size = ylib_heap_block_size(block);
+    ylib_heap_account(block, size, 0);
 #if configHEAP_STATS_ENABLE
-    g_ylib_heap.stats.free_heap_size += block->block_size;
     g_ylib_heap.stats.successful_frees++;
 #endif
+    ylib_heap_give(block);
+    YLIB_HEAP_UNLOCK(lock);
+
     if (free_hook)
-        free_hook(pv, block->block_size - sizeof(ylib_block_link_t));
+        free_hook(pv, size - sizeof(ylib_block_link_t) - YLIB_HEAP_GUARD_SIZE, caller);
+}
+
+void ylib_free(void *pv)
+{
+    ylib_free_from(pv, __builtin_return_address(0));
 }
 
 void *ylib_realloc(void *pv, size_t wanted_size)
 {
+    const void *caller = __builtin_return_address(0);
+    uint32_t lock;
+    size_t old_block;
+    size_t new_block;
+    int resized;
+    uint8_t owner = YLIB_HEAP_OWNER_APP;
+
     if (!pv)
-        return ylib_malloc(wanted_size);
+        return ylib_malloc_from(wanted_size, owner, caller);
     if (wanted_size == 0)
     {
-        ylib_free(pv);
+        ylib_free_from(pv, caller);
         return NULL;
     }
+#if YLIB_NO_HEAP_AFTER_INIT
+    // realloc一律视为分配，是否停机不取决于当时能否原地调整
+    if (heap_sealed)
+        ylib_heap_seal_trap(caller);
+#endif
     ylib_block_link_t *block = ylib_heap_get_block_ptr(pv);
-    size_t old_size = block->block_size - sizeof(ylib_block_link_t);
+    YLIB_HEAP_LOCK(lock);
+    old_block = ylib_heap_block_size(block);
+    resized = ylib_heap_resize_in_place(block, wanted_size + YLIB_HEAP_GUARD_SIZE);
+    new_block = ylib_heap_block_size(block);
+    if (resized)
+    {
+        ylib_heap_guard_set(block);
+        ylib_heap_account(block, old_block, new_block);
+    }
+#if configHEAP_OWNER_MAX
+    owner = block->owner;
+#endif
+    YLIB_HEAP_UNLOCK(lock);
+
+    size_t old_size = old_block - sizeof(ylib_block_link_t) - YLIB_HEAP_GUARD_SIZE;
+    if (resized)
+    {
+        // 原地调整对钩子表现为同一地址的释放加分配
+        if (free_hook)
+            free_hook(pv, old_size, caller);
+        if (malloc_hook)
+            malloc_hook(pv, new_block - sizeof(ylib_block_link_t) - YLIB_HEAP_GUARD_SIZE, caller);
+        return pv;
+    }
     if (old_size >= wanted_size)
         return pv;
-    void *new_ptr = ylib_malloc(wanted_size);
+    void *new_ptr = ylib_malloc_from(wanted_size, owner, caller);
     if (new_ptr)
     {
         memcpy(new_ptr, pv, old_size);
-        ylib_free(pv);
+        ylib_free_from(pv, caller);
     }
     return new_ptr;
 }
 
+#if YLIB_NO_HEAP_AFTER_INIT
+void ylib_heap_seal(void)
+{
+    heap_sealed = true;
+}
+
+int ylib_heap_sealed(void)
+{
+    return heap_sealed ? 1 : 0;
+}
+
+YLIB_WEAK void ylib_heap_seal_trap(const void *caller)
+{
+    uint32_t lock;
+
+    heap_seal_caller = caller;
+    YLIB_HEAP_LOCK(lock);
+    (void)lock;
+    for (;;)
+    {
+    }
+}
+#endif
+
 void *ylib_calloc(size_t num, size_t size)
 {
     size_t total = num * size;
-    void *ptr = ylib_malloc(total);
+    void *ptr = ylib_malloc_from(total, YLIB_HEAP_OWNER_APP, __builtin_return_address(0));
     if (ptr)
         memset(ptr, 0, total);
     return ptr;
@@ -186,6 +775,16 @@ size_t ylib_get_free_heap_size(void)
 {
 #if configHEAP_STATS_ENABLE
     return g_ylib_heap.stats.free_heap_size;
+#elif configHEAP_USE_TLSF
+    size_t total = 0;
+    ylib_block_link_t *cur = (ylib_block_link_t *)g_ylib_heap.heap_start;
+    while (cur && ylib_tlsf_size(cur) != 0)
+    {
+        if (cur->block_size & YLIB_TLSF_BLOCK_FREE)
+            total += ylib_tlsf_size(cur);
+        cur = ylib_tlsf_next(cur);
+    }
+    return total;
 #else
     size_t total = 0;
     ylib_block_link_t *cur = g_ylib_heap.free_blocks_list;
@@ -210,12 +809,122 @@ size_t ylib_get_minimum_ever_free_heap_size(void)
 #if configHEAP_STATS_ENABLE
 void ylib_get_heap_stats(ylib_heap_stats_t *stats)
 {
-    if (stats)
-        *stats = g_ylib_heap.stats;
+    uint32_t lock;
+    if (!stats)
+        return;
+    YLIB_HEAP_LOCK(lock);
+#if configHEAP_USE_TLSF
+    // 最大/最小空闲块只需查最高和最低的非空链表
+    ylib_block_link_t *cur;
+    uint32_t fl;
+    g_ylib_heap.stats.max_block_size = 0;
+    g_ylib_heap.stats.min_block_size = 0;
+    if (g_ylib_heap.fl_bitmap)
+    {
+        fl = ylib_tlsf_fls(g_ylib_heap.fl_bitmap);
+        cur = g_ylib_heap.blocks[fl][ylib_tlsf_fls(g_ylib_heap.sl_bitmap[fl])];
+        for (; cur; cur = ylib_tlsf_links(cur)->next_free_block)
+            if (ylib_tlsf_size(cur) > g_ylib_heap.stats.max_block_size)
+                g_ylib_heap.stats.max_block_size = ylib_tlsf_size(cur);
+        fl = ylib_tlsf_ffs(g_ylib_heap.fl_bitmap);
+        cur = g_ylib_heap.blocks[fl][ylib_tlsf_ffs(g_ylib_heap.sl_bitmap[fl])];
+        g_ylib_heap.stats.min_block_size = ylib_tlsf_size(cur);
+        for (; cur; cur = ylib_tlsf_links(cur)->next_free_block)
+            if (ylib_tlsf_size(cur) < g_ylib_heap.stats.min_block_size)
+                g_ylib_heap.stats.min_block_size = ylib_tlsf_size(cur);
+    }
+#else
+    // 首次适配链表只在查询时遍历统计
+    ylib_block_link_t *cur = g_ylib_heap.free_blocks_list;
+    g_ylib_heap.stats.number_of_free_blocks = 0;
+    g_ylib_heap.stats.max_block_size = 0;
+    g_ylib_heap.stats.min_block_size = cur ? cur->block_size : 0;
+    for (; cur; cur = cur->next_free_block)
+    {
+        g_ylib_heap.stats.number_of_free_blocks++;
+        if (cur->block_size > g_ylib_heap.stats.max_block_size)
+            g_ylib_heap.stats.max_block_size = cur->block_size;
+        if (cur->block_size < g_ylib_heap.stats.min_block_size)
+            g_ylib_heap.stats.min_block_size = cur->block_size;
+    }
+#endif
+    g_ylib_heap.stats.largest_free_permille =
+        g_ylib_heap.stats.free_heap_size
+            ? (uint32_t)((uint64_t)g_ylib_heap.stats.max_block_size * 1000U / g_ylib_heap.stats.free_heap_size)
+            : 1000U;
+    *stats = g_ylib_heap.stats;
+    YLIB_HEAP_UNLOCK(lock);
 }
 #endif
 
 #if configHEAP_CHECK_ENABLE
+#if configHEAP_USE_TLSF
+int ylib_heap_check_integrity(void)
+{
+    ylib_block_link_t *cur = (ylib_block_link_t *)g_ylib_heap.heap_start;
+    ylib_block_link_t *next;
+    size_t prev_free = 0;
+    uint32_t fl, sl;
+
+    if (!g_ylib_heap.initialized)
+        return 1;
+    // 按物理顺序检查：魔术数字、标志一致、没有相邻的空闲块
+    while (ylib_tlsf_size(cur) != 0)
+    {
+        next = ylib_tlsf_next(cur);
+        if ((uint8_t *)next >= g_ylib_heap.heap_end)
+            return 0;
+        if (cur->magic != ((cur->block_size & YLIB_TLSF_BLOCK_FREE) ? YLIB_HEAP_MAGIC_FREE : YLIB_HEAP_MAGIC_ALLOC))
+            return 0;
+        if ((cur->block_size & YLIB_TLSF_PREV_FREE) != prev_free)
+            return 0;
+        prev_free = (cur->block_size & YLIB_TLSF_BLOCK_FREE) ? YLIB_TLSF_PREV_FREE : 0;
+        if (prev_free && (cur->block_size & YLIB_TLSF_PREV_FREE))
+            return 0;
+        if (prev_free && next->prev_phys_block != cur)
+            return 0;
+        cur = next;
+    }
+    if ((uint8_t *)cur + YLIB_TLSF_HEADER_SIZE != g_ylib_heap.heap_end || (cur->block_size & YLIB_TLSF_PREV_FREE) != prev_free)
+        return 0;
+
+    // 位图与链表一致，链表中的块都是空闲块且落在对应区间
+    for (fl = 0; fl < YLIB_TLSF_FL_COUNT; fl++)
+    {
+        if (((g_ylib_heap.fl_bitmap >> fl) & 1U) != (g_ylib_heap.sl_bitmap[fl] != 0))
+            return 0;
+        for (sl = 0; sl < YLIB_TLSF_SL_COUNT; sl++)
+        {
+            if (((g_ylib_heap.sl_bitmap[fl] >> sl) & 1U) != (g_ylib_heap.blocks[fl][sl] != NULL))
+                return 0;
+            for (cur = g_ylib_heap.blocks[fl][sl]; cur; cur = ylib_tlsf_links(cur)->next_free_block)
+            {
+                uint32_t f, s;
+                if (cur->magic != YLIB_HEAP_MAGIC_FREE || !(cur->block_size & YLIB_TLSF_BLOCK_FREE))
+                    return 0;
+                ylib_tlsf_mapping(ylib_tlsf_size(cur), &f, &s);
+                if (f != fl || s != sl)
+                    return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+void ylib_heap_print_info(void)
+{
+    ylib_block_link_t *cur = (ylib_block_link_t *)g_ylib_heap.heap_start;
+    size_t idx = 0;
+    printf("[YLIB HEAP] TLSF blocks:\n");
+    while (cur && ylib_tlsf_size(cur) != 0)
+    {
+        printf("  Block %zu: addr=%p, size=%zu, %s\n", idx++, (void *)cur, ylib_tlsf_size(cur),
+               (cur->block_size & YLIB_TLSF_BLOCK_FREE) ? "free" : "used");
+        cur = ylib_tlsf_next(cur);
+    }
+    printf("[YLIB HEAP] Free heap size: %zu\n", ylib_get_free_heap_size());
+}
+#else
 int ylib_heap_check_integrity(void)
 {
     ylib_block_link_t *cur = g_ylib_heap.free_blocks_list;
@@ -225,6 +934,9 @@ int ylib_heap_check_integrity(void)
             return 0;
         if (cur->magic != YLIB_HEAP_MAGIC_FREE)
             return 0;
+        // 链表按地址有序，且合并后不应存在物理相邻的空闲块
+        if (cur->next_free_block && ylib_heap_phys_next(cur) >= cur->next_free_block)
+            return 0;
         cur = cur->next_free_block;
     }
     return 1;
@@ -244,16 +956,164 @@ void ylib_heap_print_info(void)
 }
 #endif
 
+/* 检查一个物理块，正常时返回0并给出下一块，否则填写损坏信息返回-1；须在锁内调用 */
+static int ylib_heap_scrub_block(ylib_block_link_t *cur, ylib_block_link_t **next, ylib_heap_fault_t *fault)
+{
+    size_t size = ylib_heap_block_size(cur);
+    size_t room = (size_t)(g_ylib_heap.heap_end - (uint8_t *)cur);
+    int is_free;
+
+    fault->block = cur;
+    fault->pool = NULL;
+    fault->owner = YLIB_HEAP_OWNER_UNKNOWN;
+    fault->reason = YLIB_HEAP_FAULT_HEADER;
+
+#if configHEAP_USE_TLSF
+    // 末尾哨兵块占一个块头，普通块不能越过它
+    is_free = (cur->block_size & YLIB_TLSF_BLOCK_FREE) != 0;
+    if (size < YLIB_TLSF_BLOCK_MIN || (size & (configBYTE_ALIGNMENT - 1)) || size > room - YLIB_TLSF_HEADER_SIZE)
+        return -1;
+    if (cur->magic != (is_free ? YLIB_HEAP_MAGIC_FREE : YLIB_HEAP_MAGIC_ALLOC))
+        return -1;
+    if (cur->block_size & YLIB_TLSF_PREV_FREE)
+    {
+        ylib_block_link_t *prev = cur->prev_phys_block;
+        if ((uint8_t *)prev < g_ylib_heap.heap_start || prev >= cur || ylib_tlsf_next(prev) != cur)
+            return -1;
+    }
+    if (is_free)
+    {
+        ylib_tlsf_links_t *links = ylib_tlsf_links(cur);
+        fault->reason = YLIB_HEAP_FAULT_LINK;
+        if (links->next_free_block && ((uint8_t *)links->next_free_block < g_ylib_heap.heap_start ||
+                                       (uint8_t *)links->next_free_block >= g_ylib_heap.heap_end))
+            return -1;
+        if (links->prev_free_block && ((uint8_t *)links->prev_free_block < g_ylib_heap.heap_start ||
+                                       (uint8_t *)links->prev_free_block >= g_ylib_heap.heap_end))
+            return -1;
+    }
+#else
+    is_free = (cur->magic == YLIB_HEAP_MAGIC_FREE);
+    if (size < sizeof(ylib_block_link_t) || (size & (configBYTE_ALIGNMENT - 1)) || size > room)
+        return -1;
+    if (!is_free && cur->magic != YLIB_HEAP_MAGIC_ALLOC)
+        return -1;
+    // 空闲链表按地址递增
+    if (is_free && cur->next_free_block &&
+        (cur->next_free_block <= cur || (uint8_t *)cur->next_free_block >= g_ylib_heap.heap_end))
+    {
+        fault->reason = YLIB_HEAP_FAULT_LINK;
+        return -1;
+    }
+#endif
+    *next = (ylib_block_link_t *)((uint8_t *)cur + size);
+    if (is_free)
+        return 0;
+#if configHEAP_OWNER_MAX
+    if (cur->owner >= configHEAP_OWNER_MAX)
+        return -1;
+    fault->owner = cur->owner;
+#endif
+    if (!ylib_heap_guard_ok(cur))
+    {
+        fault->reason = YLIB_HEAP_FAULT_GUARD;
+        return -1;
+    }
+    return 0;
+}
+
+int ylib_heap_scrub(uint32_t budget)
+{
+    ylib_heap_fault_t fault;
+    ylib_block_link_t *cur;
+    ylib_block_link_t *next;
+    uint32_t lock;
+
+    while (budget--)
+    {
+        YLIB_HEAP_LOCK(lock);
+        if (heap_faulted || !g_ylib_heap.initialized)
+        {
+            YLIB_HEAP_UNLOCK(lock);
+            return heap_faulted ? -1 : 1;
+        }
+        cur = g_ylib_heap.scrub ? g_ylib_heap.scrub : (ylib_block_link_t *)g_ylib_heap.heap_start;
+#if configHEAP_USE_TLSF
+        if ((uint8_t *)cur + YLIB_TLSF_HEADER_SIZE >= g_ylib_heap.heap_end)
+#else
+        if ((uint8_t *)cur >= g_ylib_heap.heap_end)
+#endif
+        {
+            g_ylib_heap.scrub = NULL;
+            YLIB_HEAP_UNLOCK(lock);
+            return 1;
+        }
+        if (ylib_heap_scrub_block(cur, &next, &fault) != 0)
+        {
+            g_ylib_heap.scrub = NULL;
+            YLIB_HEAP_UNLOCK(lock);
+            ylib_heap_report_fault(&fault);
+            return -1;
+        }
+        g_ylib_heap.scrub = next;
+        YLIB_HEAP_UNLOCK(lock);
+    }
+    return 0;
+}
+
+void ylib_heap_report_fault(const ylib_heap_fault_t *fault)
+{
+    uint32_t lock;
+    bool first;
+
+    YLIB_HEAP_LOCK(lock);
+    first = !heap_faulted;
+    if (first)
+    {
+        heap_fault = *fault;
+        heap_faulted = true;
+    }
+    YLIB_HEAP_UNLOCK(lock);
+
+    if (first && fault_hook)
+        fault_hook(fault);
+}
+
+int ylib_heap_get_fault(ylib_heap_fault_t *fault)
+{
+    uint32_t lock;
+    int faulted;
+
+    YLIB_HEAP_LOCK(lock);
+    faulted = heap_faulted;
+    if (faulted && fault)
+        *fault = heap_fault;
+    YLIB_HEAP_UNLOCK(lock);
+    return faulted;
+}
+
+void ylib_heap_clear_fault(void)
+{
+    uint32_t lock;
+
+    YLIB_HEAP_LOCK(lock);
+    heap_faulted = false;
+    g_ylib_heap.scrub = NULL;
+    YLIB_HEAP_UNLOCK(lock);
+}
+#endif
+
 size_t ylib_malloc_size(void *pv)
 {
     if (!pv)
         return 0;
     ylib_block_link_t *block = ylib_heap_get_block_ptr(pv);
-    return block->block_size - sizeof(ylib_block_link_t);
+    return ylib_heap_user_size(block);
 }
 
 void ylib_set_malloc_failed_hook(ylib_malloc_failed_hook_t hook) { malloc_failed_hook = hook; }
 void ylib_set_free_hook(ylib_free_hook_t hook) { free_hook = hook; }
 void ylib_set_malloc_hook(ylib_malloc_hook_t hook) { malloc_hook = hook; }
+void ylib_set_fault_hook(ylib_fault_hook_t hook) { fault_hook = hook; }
 
 /* 内存池相关实现略，可按需补充 */
@@ -0,0 +1,143 @@
+/**
+ ******************************************************************************
+ * @file       yLib_interval_tree.c
+ * @brief      区间树实现（参考Linux interval_tree_generic.h）
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       节点与查询相交的条件：node->start <= last(条件1)且start <= node->last(条件2)；
+ *             左子树subtree_last < start时整棵左子树都不满足条件2，可以跳过
+ ******************************************************************************
+ */
+
+#include "yLib_interval_tree.h"
+#include "yLib_rbtree_augmented.h"
+
+#define ylib_interval_entry(ptr) ylib_rb_entry(ptr, struct ylib_interval_node, rb)
+
+/**
+ * @brief 由节点和左右子树计算子树最大终点
+ */
+static inline uint32_t ylib_interval_compute_last(struct ylib_interval_node *node)
+{
+    uint32_t max = node->last;
+
+    if (node->rb.rb_left && ylib_interval_entry(node->rb.rb_left)->subtree_last > max)
+        max = ylib_interval_entry(node->rb.rb_left)->subtree_last;
+    if (node->rb.rb_right && ylib_interval_entry(node->rb.rb_right)->subtree_last > max)
+        max = ylib_interval_entry(node->rb.rb_right)->subtree_last;
+    return max;
+}
+
+YLIB_RB_DECLARE_CALLBACKS(static, ylib_interval_augment, struct ylib_interval_node, rb,
+                          subtree_last, ylib_interval_compute_last);
+
+void ylib_interval_tree_insert(struct ylib_interval_node *node, struct ylib_rb_root_cached *root)
+{
+    struct ylib_rb_node **link = &root->rb_root.rb_node;
+    struct ylib_rb_node *rb_parent = NULL;
+    struct ylib_interval_node *parent;
+    bool leftmost = true;
+
+    while (*link) {
+        rb_parent = *link;
+        parent = ylib_interval_entry(rb_parent);
+        if (parent->subtree_last < node->last)
+            parent->subtree_last = node->last;
+        if (node->start < parent->start) {
+            link = &parent->rb.rb_left;
+        } else {
+            link = &parent->rb.rb_right;
+            leftmost = false;
+        }
+    }
+
+    node->subtree_last = node->last;
+    ylib_rb_link_node(&node->rb, rb_parent, link);
+    ylib_rb_insert_augmented_cached(&node->rb, root, leftmost, &ylib_interval_augment);
+}
+
+void ylib_interval_tree_remove(struct ylib_interval_node *node, struct ylib_rb_root_cached *root)
+{
+    ylib_rb_erase_augmented_cached(&node->rb, root, &ylib_interval_augment);
+}
+
+/**
+ * @brief 在node为根的子树中找起点最小的相交区间，调用者保证start <= node->subtree_last
+ */
+static struct ylib_interval_node *ylib_interval_subtree_search(struct ylib_interval_node *node,
+                                                               uint32_t start, uint32_t last)
+{
+    struct ylib_interval_node *left;
+
+    for (;;) {
+        if (node->rb.rb_left) {
+            left = ylib_interval_entry(node->rb.rb_left);
+            if (start <= left->subtree_last) {
+                /* 左子树中有满足条件2的节点，且起点更小 */
+                node = left;
+                continue;
+            }
+        }
+        if (node->start <= last) {
+            if (start <= node->last)
+                return node;
+            if (node->rb.rb_right) {
+                node = ylib_interval_entry(node->rb.rb_right);
+                if (start <= node->subtree_last)
+                    continue;
+            }
+        }
+        return NULL;
+    }
+}
+
+struct ylib_interval_node *ylib_interval_tree_iter_first(struct ylib_rb_root_cached *root,
+                                                         uint32_t start, uint32_t last)
+{
+    struct ylib_interval_node *node;
+
+    if (!root->rb_root.rb_node)
+        return NULL;
+
+    /* 全部终点都在查询起点之前，或全部起点都在查询终点之后 */
+    node = ylib_interval_entry(root->rb_root.rb_node);
+    if (node->subtree_last < start)
+        return NULL;
+    if (ylib_interval_entry(root->rb_leftmost)->start > last)
+        return NULL;
+
+    return ylib_interval_subtree_search(node, start, last);
+}
+
+struct ylib_interval_node *ylib_interval_tree_iter_next(struct ylib_interval_node *node,
+                                                        uint32_t start, uint32_t last)
+{
+    struct ylib_rb_node *rb = node->rb.rb_right;
+    struct ylib_rb_node *prev;
+    struct ylib_interval_node *right;
+
+    for (;;) {
+        /* 先找右子树 */
+        if (rb) {
+            right = ylib_interval_entry(rb);
+            if (start <= right->subtree_last)
+                return ylib_interval_subtree_search(right, start, last);
+        }
+
+        /* 向上回溯，直到从某个节点的左子树返回 */
+        do {
+            rb = ylib_rb_parent(&node->rb);
+            if (!rb)
+                return NULL;
+            prev = &node->rb;
+            node = ylib_interval_entry(rb);
+            rb = node->rb.rb_right;
+        } while (prev == rb);
+
+        if (last < node->start)
+            return NULL;
+        if (start <= node->last)
+            return node;
+    }
+}
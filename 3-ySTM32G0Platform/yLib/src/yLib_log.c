@@ -0,0 +1,142 @@
+/**
+ ******************************************************************************
+ * @file       yLib_log.c
+ * @brief      延迟格式化的二进制日志实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       记录按字连续写入字环，记录头、时间戳、参数在同一次临界区内写完再发布，
+ *             读出方看到的总是完整记录；空间不够时整条丢弃，恢复后先插入一条丢失记录
+ ******************************************************************************
+ */
+
+#include "yLib_log.h"
+#include "yLib_ring.h"
+#include <stdio.h>
+
+YLIB_RING_DEFINE(ylib_log_ring, uint32_t, YLIB_LOG_WORDS);
+
+volatile uint8_t ylib_log_threshold;
+
+static uint32_t (*ylib_log_now)(void);
+static uint32_t ylib_log_hz;
+static void (*ylib_log_notify)(void);
+static uint32_t ylib_log_lost;    /* 尚未写入丢失记录的丢弃条数 */
+static uint32_t ylib_log_dropcnt; /* 丢弃总数 */
+
+void ylib_log_write(uint32_t hdr, const uint32_t *args)
+{
+    uint32_t state;
+    uint32_t now;
+    unsigned int tail;
+    unsigned int nargs = YLIB_LOG_HDR_NARGS(hdr);
+    unsigned int need = 2U + nargs;
+    unsigned int used;
+    unsigned int i;
+
+    YLIB_LOG_LOCK(state);
+    now = (ylib_log_now != NULL) ? ylib_log_now() : 0U;
+    tail = ylib_log_ring.tail;
+    if (ylib_log_lost)
+        need += 3U;
+    if (YLIB_LOG_WORDS - (tail - ylib_log_ring.head) < need) {
+        ylib_log_lost++;
+        ylib_log_dropcnt++;
+        YLIB_LOG_UNLOCK(state);
+        return;
+    }
+
+    if (ylib_log_lost) {
+        ylib_log_ring_buffer[tail++ & (YLIB_LOG_WORDS - 1U)] = YLIB_LOG_HDR(YLIB_LOG_ID_LOST, 1, YLIB_LOG_WARN);
+        ylib_log_ring_buffer[tail++ & (YLIB_LOG_WORDS - 1U)] = now;
+        ylib_log_ring_buffer[tail++ & (YLIB_LOG_WORDS - 1U)] = ylib_log_lost;
+        ylib_log_lost = 0;
+    }
+    ylib_log_ring_buffer[tail++ & (YLIB_LOG_WORDS - 1U)] = hdr;
+    ylib_log_ring_buffer[tail++ & (YLIB_LOG_WORDS - 1U)] = now;
+    for (i = 0; i < nargs; i++)
+        ylib_log_ring_buffer[tail++ & (YLIB_LOG_WORDS - 1U)] = args[i];
+    YLIB_RING_BARRIER();
+    ylib_log_ring.prod_head = tail;
+    ylib_log_ring.tail = tail;
+    used = tail - ylib_log_ring.head;
+    YLIB_LOG_UNLOCK(state);
+
+    /* 只在本次写入越过一半时通知，积压期间不重复通知 */
+    if ((ylib_log_notify != NULL) && (used >= YLIB_LOG_WORDS / 2U) && (used - need < YLIB_LOG_WORDS / 2U))
+        ylib_log_notify();
+}
+
+void ylib_log_register_clock(uint32_t (*now)(void), uint32_t hz)
+{
+    ylib_log_now = now;
+    ylib_log_hz = (now != NULL) ? hz : 0;
+}
+
+uint32_t ylib_log_clock_hz(void)
+{
+    return ylib_log_hz;
+}
+
+void ylib_log_register_notify(void (*notify)(void))
+{
+    ylib_log_notify = notify;
+}
+
+unsigned int ylib_log_read(uint32_t *words, unsigned int n)
+{
+    unsigned int head = ylib_log_ring.head;
+    unsigned int tail = ylib_log_ring.tail;
+    unsigned int out = 0;
+    unsigned int len;
+    unsigned int i;
+
+    YLIB_RING_BARRIER();
+    while (head != tail) {
+        len = YLIB_LOG_REC_WORDS(ylib_log_ring_buffer[head & (YLIB_LOG_WORDS - 1U)]);
+        if (out + len > n)
+            break;
+        for (i = 0; i < len; i++)
+            words[out++] = ylib_log_ring_buffer[head++ & (YLIB_LOG_WORDS - 1U)];
+    }
+    YLIB_RING_BARRIER();
+    ylib_log_ring.cons_head = head;
+    ylib_log_ring.head = head;
+    return out;
+}
+
+const char *ylib_log_fmt_string(unsigned int id)
+{
+    return (id < (unsigned int)(__stop_ylib_log_fmt - __start_ylib_log_fmt)) ? __start_ylib_log_fmt + id : NULL;
+}
+
+int ylib_log_format(const uint32_t *rec, char *buf, size_t size)
+{
+    const uint32_t *a = rec + 2;
+    uint32_t v[YLIB_LOG_ARGS_MAX] = {0};
+    unsigned int nargs = YLIB_LOG_HDR_NARGS(rec[0]);
+    unsigned int i;
+    const char *fmt;
+
+    if (YLIB_LOG_HDR_ID(rec[0]) == YLIB_LOG_ID_LOST)
+        return snprintf(buf, size, "<%lu lost>", (unsigned long)a[0]);
+
+    fmt = ylib_log_fmt_string(YLIB_LOG_HDR_ID(rec[0]));
+    if (fmt == NULL)
+        return snprintf(buf, size, "<unknown format %lu>", (unsigned long)YLIB_LOG_HDR_ID(rec[0]));
+
+    /* 多余的参数printf不会读取；参数在32位目标上与int/long/指针同宽 */
+    for (i = 0; (i < nargs) && (i < YLIB_LOG_ARGS_MAX); i++)
+        v[i] = a[i];
+    return snprintf(buf, size, fmt, v[0], v[1], v[2], v[3]);
+}
+
+unsigned int ylib_log_count(void)
+{
+    return ylib_ring_count(&ylib_log_ring);
+}
+
+uint32_t ylib_log_dropped(void)
+{
+    return ylib_log_dropcnt;
+}
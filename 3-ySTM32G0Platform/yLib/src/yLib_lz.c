@@ -0,0 +1,182 @@
+/**
+ ******************************************************************************
+ * @file       yLib_lz.c
+ * @brief      LZSS压缩与流式解压实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/18
+ * @note       压缩从最近的位置向前逐个比较，先比前两个字节过滤；
+ *             找到最长匹配即停止，长度相同时保留距离最近的
+ ******************************************************************************
+ */
+
+#include "yLib_lz.h"
+
+#if (YLIB_LZ_SEARCH_MAX > YLIB_LZ_WINDOW) || (YLIB_LZ_SEARCH_MAX < 1)
+#error "YLIB_LZ_SEARCH_MAX must be 1..YLIB_LZ_WINDOW"
+#endif
+
+#define LZ_WINDOW_MASK (YLIB_LZ_WINDOW - 1U)
+
+/**
+ * @brief 在src[i]之前找最长匹配
+ * @param dist 匹配距离输出
+ * @return 匹配长度，小于YLIB_LZ_MATCH_MIN时不可用
+ */
+static size_t lz_match(const uint8_t *src, size_t i, size_t len, size_t *dist)
+{
+    size_t max = MIN(len - i, (size_t)YLIB_LZ_MATCH_MAX);
+    size_t start = (i > YLIB_LZ_SEARCH_MAX) ? i - YLIB_LZ_SEARCH_MAX : 0;
+    size_t best = 0;
+    size_t j;
+    size_t n;
+
+    if (max < YLIB_LZ_MATCH_MIN)
+        return 0;
+
+    for (j = i; j-- > start;) {
+        if ((src[j] != src[i]) || (src[j + 1U] != src[i + 1U]))
+            continue;
+        for (n = 2; (n < max) && (src[j + n] == src[i + n]); n++)
+            ;
+        if (n > best) {
+            best = n;
+            *dist = i - j;
+            if (n == max)
+                break;
+        }
+    }
+    return best;
+}
+
+size_t ylib_lz_compress(const void *in, size_t len, void *out, size_t cap)
+{
+    const uint8_t *src = (const uint8_t *)in;
+    uint8_t *dst = (uint8_t *)out;
+    size_t flag_at = 0;
+    size_t item = 8;
+    size_t o = 0;
+    size_t i = 0;
+    size_t dist = 0;
+    size_t n;
+
+    while (i < len) {
+        if (item == 8U) {
+            if (o >= cap)
+                return 0;
+            flag_at = o;
+            dst[o++] = 0;
+            item = 0;
+        }
+
+        n = lz_match(src, i, len, &dist);
+        if (n >= YLIB_LZ_MATCH_MIN) {
+            if (o + 2U > cap)
+                return 0;
+            dst[flag_at] |= (uint8_t)(1U << item);
+            dst[o++] = (uint8_t)(dist - 1U);
+            dst[o++] = (uint8_t)((((dist - 1U) >> 8) << 6) | (n - YLIB_LZ_MATCH_MIN));
+            i += n;
+        } else {
+            if (o >= cap)
+                return 0;
+            dst[o++] = src[i++];
+        }
+        item++;
+    }
+    return o;
+}
+
+size_t ylib_lz_decompress(const void *in, size_t len, void *out, size_t cap)
+{
+    const uint8_t *src = (const uint8_t *)in;
+    uint8_t *dst = (uint8_t *)out;
+    uint8_t flags = 0;
+    uint8_t items = 0;
+    size_t o = 0;
+    size_t i = 0;
+    size_t dist;
+    size_t n;
+
+    while (i < len) {
+        if (items == 0) {
+            flags = src[i++];
+            items = 8;
+            continue;
+        }
+
+        if (flags & 1U) {
+            if (i + 2U > len)
+                return 0;
+            dist = ((size_t)src[i] | ((size_t)(src[i + 1U] >> 6) << 8)) + 1U;
+            n = (size_t)(src[i + 1U] & 0x3FU) + YLIB_LZ_MATCH_MIN;
+            i += 2;
+            if ((dist > o) || (n > cap - o))
+                return 0;
+            // 距离小于长度时逐字节复制才能展开重复模式
+            for (; n > 0; n--, o++)
+                dst[o] = dst[o - dist];
+        } else {
+            if (o >= cap)
+                return 0;
+            dst[o++] = src[i++];
+        }
+        flags >>= 1;
+        items--;
+    }
+    return o;
+}
+
+void ylib_lz_dec_init(struct ylib_lz_dec *dec)
+{
+    memset(dec, 0, sizeof(*dec));
+}
+
+size_t ylib_lz_dec_run(struct ylib_lz_dec *dec, const uint8_t **in, size_t *len, uint8_t *out, size_t cap)
+{
+    const uint8_t *src = *in;
+    size_t left = *len;
+    size_t o = 0;
+    uint8_t c;
+
+    while (o < cap) {
+        if (dec->copy_len != 0) {
+            c = dec->window[((uint32_t)dec->pos - dec->copy_dist) & LZ_WINDOW_MASK];
+            dec->copy_len--;
+        } else {
+            if (left == 0)
+                break;
+            c = *src++;
+            left--;
+
+            if (dec->items == 0) {
+                dec->flags = c;
+                dec->items = 8;
+                continue;
+            }
+            if (dec->flags & 1U) {
+                if (!dec->half) {
+                    dec->b0 = c;
+                    dec->half = 1;
+                    continue;
+                }
+                dec->half = 0;
+                dec->copy_dist = (uint16_t)(((uint32_t)dec->b0 | ((uint32_t)(c >> 6) << 8)) + 1U);
+                dec->copy_len = (uint8_t)((c & 0x3FU) + YLIB_LZ_MATCH_MIN);
+                dec->flags >>= 1;
+                dec->items--;
+                continue;
+            }
+            dec->flags >>= 1;
+            dec->items--;
+        }
+
+        dec->window[dec->pos] = c;
+        dec->pos = (uint16_t)((dec->pos + 1U) & LZ_WINDOW_MASK);
+        out[o++] = c;
+    }
+
+    *in = src;
+    *len = left;
+    return o;
+}
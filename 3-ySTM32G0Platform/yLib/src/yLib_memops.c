@@ -0,0 +1,187 @@
+/**
+ ******************************************************************************
+ * @file       yLib_memops.c
+ * @brief      按字优化的内存复制、填充和比较实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       M0+的LDM/STM只能用低寄存器，每次搬4个字(r3-r6)；非对齐访问会触发HardFault，
+ *             所以源地址不对齐时只做对齐的字读，再按偏移移位拼接(小端)
+ ******************************************************************************
+ */
+
+#include "yLib_memops.h"
+
+/* 禁止编译器把循环识别回memcpy/memset，否则替换C库时会递归调用自己 */
+#if YLIB_MEMOPS_RAM
+#define YLIB_MEMOPS_FUNC YLIB_RAMFUNC __attribute__((optimize("no-tree-loop-distribute-patterns")))
+#else
+#define YLIB_MEMOPS_FUNC __attribute__((optimize("no-tree-loop-distribute-patterns")))
+#endif
+
+#define YLIB_MEMOPS_ALIGNED(p) (((uintptr_t)(p) & 3U) == 0)
+
+/* 按字访问任意类型的数据，不受严格别名规则约束 */
+typedef uint32_t __attribute__((may_alias)) ylib_word_t;
+
+/**
+ * @brief 对齐复制16字节块
+ */
+static inline void ylib_memops_copy16(ylib_word_t **d, const ylib_word_t **s)
+{
+#if defined(__arm__)
+    __asm volatile("ldmia %1!, {r3, r4, r5, r6}\n"
+                   "stmia %0!, {r3, r4, r5, r6}\n"
+                   : "+l"(*d), "+l"(*s)
+                   :
+                   : "r3", "r4", "r5", "r6", "memory");
+#else
+    (*d)[0] = (*s)[0];
+    (*d)[1] = (*s)[1];
+    (*d)[2] = (*s)[2];
+    (*d)[3] = (*s)[3];
+    *d += 4;
+    *s += 4;
+#endif
+}
+
+YLIB_MEMOPS_FUNC void *ylib_memcpy(void *dst, const void *src, size_t n)
+{
+    uint8_t *d8 = dst;
+    const uint8_t *s8 = src;
+    ylib_word_t *d;
+    const ylib_word_t *s;
+    uint32_t prev, next;
+    unsigned int shift;
+
+    /* 太短时直接逐字节 */
+    if (n < 8)
+        goto tail;
+
+    /* 目的地址对齐到字 */
+    while (!YLIB_MEMOPS_ALIGNED(d8)) {
+        *d8++ = *s8++;
+        n--;
+    }
+    d = (ylib_word_t *)d8;
+
+    if (YLIB_MEMOPS_ALIGNED(s8)) {
+        s = (const ylib_word_t *)s8;
+        while (n >= 16) {
+            ylib_memops_copy16(&d, &s);
+            n -= 16;
+        }
+        while (n >= 4) {
+            *d++ = *s++;
+            n -= 4;
+        }
+        s8 = (const uint8_t *)s;
+    } else {
+        /* 源地址不对齐：读对齐的字，前一个字右移、后一个字左移拼成一个字 */
+        shift = ((uintptr_t)s8 & 3U) * 8U;
+        s = (const ylib_word_t *)((uintptr_t)s8 & ~(uintptr_t)3U);
+        prev = *s++;
+        /* 保留至少8字节，保证读下一个字时不越过源区域末尾 */
+        while (n >= 8) {
+            next = *s++;
+            *d++ = (prev >> shift) | (next << (32U - shift));
+            prev = next;
+            n -= 4;
+        }
+        s8 = (const uint8_t *)s - 4 + shift / 8U;
+    }
+    d8 = (uint8_t *)d;
+
+tail:
+    while (n--)
+        *d8++ = *s8++;
+    return dst;
+}
+
+YLIB_MEMOPS_FUNC void *ylib_memset(void *dst, int c, size_t n)
+{
+    uint8_t *d8 = dst;
+    ylib_word_t *d;
+    uint32_t v = (uint8_t)c * 0x01010101U;
+
+    if (n < 8)
+        goto tail;
+
+    while (!YLIB_MEMOPS_ALIGNED(d8)) {
+        *d8++ = (uint8_t)c;
+        n--;
+    }
+    d = (ylib_word_t *)d8;
+
+    while (n >= 16) {
+#if defined(__arm__)
+        __asm volatile("mov r3, %1\n"
+                       "mov r4, %1\n"
+                       "mov r5, %1\n"
+                       "mov r6, %1\n"
+                       "stmia %0!, {r3, r4, r5, r6}\n"
+                       : "+l"(d)
+                       : "l"(v)
+                       : "r3", "r4", "r5", "r6", "memory");
+#else
+        d[0] = v;
+        d[1] = v;
+        d[2] = v;
+        d[3] = v;
+        d += 4;
+#endif
+        n -= 16;
+    }
+    while (n >= 4) {
+        *d++ = v;
+        n -= 4;
+    }
+    d8 = (uint8_t *)d;
+
+tail:
+    while (n--)
+        *d8++ = (uint8_t)c;
+    return dst;
+}
+
+YLIB_MEMOPS_FUNC int ylib_memcmp(const void *a, const void *b, size_t n)
+{
+    const uint8_t *a8 = a;
+    const uint8_t *b8 = b;
+    const ylib_word_t *aw;
+    const ylib_word_t *bw;
+
+    /* 两者对齐偏移相同时按字比较，遇到不同的字再逐字节定位 */
+    if (n >= 8 && (((uintptr_t)a8 ^ (uintptr_t)b8) & 3U) == 0) {
+        while (!YLIB_MEMOPS_ALIGNED(a8)) {
+            if (*a8 != *b8)
+                return *a8 - *b8;
+            a8++;
+            b8++;
+            n--;
+        }
+        aw = (const ylib_word_t *)a8;
+        bw = (const ylib_word_t *)b8;
+        while (n >= 4 && *aw == *bw) {
+            aw++;
+            bw++;
+            n -= 4;
+        }
+        a8 = (const uint8_t *)aw;
+        b8 = (const uint8_t *)bw;
+    }
+
+    while (n--) {
+        if (*a8 != *b8)
+            return *a8 - *b8;
+        a8++;
+        b8++;
+    }
+    return 0;
+}
+
+#if YLIB_MEMOPS_OVERRIDE_LIBC
+void *memcpy(void *dst, const void *src, size_t n) __attribute__((alias("ylib_memcpy")));
+void *memset(void *dst, int c, size_t n) __attribute__((alias("ylib_memset")));
+int memcmp(const void *a, const void *b, size_t n) __attribute__((alias("ylib_memcmp")));
+#endif
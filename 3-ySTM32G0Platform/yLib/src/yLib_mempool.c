@@ -21,31 +21,75 @@
  * Note(s): 1) 这个模块仿照uC/OS-II的内存管理实现
  *          2) 采用固定大小的内存块分配策略
  *          3) 使用链表管理空闲块
+ *          4) 链表操作在YLIB_MEM_LOCK临界区内完成，任务和中断可同时使用同一分区
  *********************************************************************************************************
  */
 
+#if configHEAP_CHECK_ENABLE
+/* 全部分区链表，供后台巡检遍历 */
+static YLIB_MEM *mem_list = NULL;
+
 /**
- * @brief 创建内存分区（仿照OSMemCreate）
+ * @brief 后台巡检游标
+ */
+static struct
+{
+    YLIB_MEM *pmem; /* 正在检查的分区，NULL表示从链表头开始 */
+    void *pprev;    /* 上一个检查过的空闲块，NULL表示从空闲链表头开始 */
+    uint32_t count; /* 已检查的空闲块数 */
+    uint32_t seq;   /* 开始检查时分区的MemSeq */
+} mem_scrub;
+
+#define YLIB_MEM_MODIFIED(pmem) ((pmem)->MemSeq++)
+#else
+#define YLIB_MEM_MODIFIED(pmem) ((void)0)
+#endif
+
+/**
+ * @brief 检查块指针是否属于分区且按块大小对齐
+ * @param pmem 内存分区控制块指针
+ * @param pblk 内存块指针
+ * @return 1有效，0无效
+ */
+static int YLibMemBlkValid(const YLIB_MEM *pmem, const void *pblk)
+{
+    const uint8_t *pblk_addr = (const uint8_t *)pblk;
+    const uint8_t *pmem_start = (const uint8_t *)pmem->MemAddr;
+    const uint8_t *pmem_end = pmem_start + (pmem->MemNBlks * pmem->MemBlkSize);
+
+    if ((pblk_addr < pmem_start) || (pblk_addr >= pmem_end))
+    {
+        return 0;
+    }
+
+    return ((uint32_t)(pblk_addr - pmem_start) % pmem->MemBlkSize) == 0u;
+}
+
+/**
+ * @brief 在调用者提供的控制块上初始化内存分区，不使用堆
+ * @param pmem 内存分区控制块
  * @param addr 内存分区起始地址
  * @param nblks 内存块数量
  * @param blksize 每个内存块大小（字节）
  * @param perr 错误码指针
- * @return 内存分区控制块指针
+ * @return 内存分区控制块指针，即pmem
  */
-YLIB_MEM *YLibMemCreate(void *addr, uint32_t nblks, uint32_t blksize, uint8_t *perr)
+YLIB_MEM *YLibMemInit(YLIB_MEM *pmem, void *addr, uint32_t nblks, uint32_t blksize, uint8_t *perr)
 {
-    YLIB_MEM *pmem;
     uint8_t *pblk;
     void **plink;
     uint32_t i;
     uint32_t aligned_blksize;
+#if configHEAP_CHECK_ENABLE
+    uint32_t lock;
+#endif
 
 #ifdef YLIB_ARG_CHK_EN
     if (perr == NULL)
     {
         return NULL;
     }
-    if (addr == NULL)
+    if ((pmem == NULL) || (addr == NULL))
     {
         *perr = YLIB_MEM_INVALID_ADDR;
         return NULL;
@@ -69,29 +113,18 @@ YLIB_MEM *YLibMemCreate(void *addr, uint32_t nblks, uint32_t blksize, uint8_t *p
         aligned_blksize = sizeof(void *);
     }
 
-    /* 分配内存分区控制块 */
-    pmem = (YLIB_MEM *)ylib_malloc(sizeof(YLIB_MEM));
-    if (pmem == NULL)
-    {
-        *perr = YLIB_MEM_NO_FREE_BLKS;
-        return NULL;
-    }
-
     /* 初始化内存分区控制块 */
     pmem->MemAddr = addr;
     pmem->MemFreeList = addr;
     pmem->MemBlkSize = aligned_blksize;
     pmem->MemNBlks = nblks;
     pmem->MemNFree = nblks;
+    pmem->MemNMinFree = nblks;
 
 #if YLIB_MEM_NAME_EN > 0u
     pmem->MemName = (uint8_t *)"?MEM";
 #endif
 
-#if configHEAP_CHECK_ENABLE
-    pmem->MemMagic = YLIB_MEM_MAGIC;
-#endif
-
     /* 链接所有内存块形成空闲链表 */
     plink = (void **)addr;
     pblk = (uint8_t *)addr;
@@ -103,10 +136,100 @@ YLIB_MEM *YLibMemCreate(void *addr, uint32_t nblks, uint32_t blksize, uint8_t *p
     }
     *plink = NULL; /* 最后一个块指向NULL */
 
+#if configHEAP_CHECK_ENABLE
+    pmem->MemMagic = YLIB_MEM_MAGIC;
+    pmem->MemSeq = 0u;
+    YLIB_MEM_LOCK(lock);
+    pmem->MemNext = mem_list;
+    mem_list = pmem;
+    YLIB_MEM_UNLOCK(lock);
+#endif
+
     *perr = YLIB_MEM_NO_ERR;
     return pmem;
 }
 
+/**
+ * @brief 创建内存分区（仿照OSMemCreate）
+ * @param addr 内存分区起始地址
+ * @param nblks 内存块数量
+ * @param blksize 每个内存块大小（字节）
+ * @param perr 错误码指针
+ * @return 内存分区控制块指针
+ */
+YLIB_MEM *YLibMemCreate(void *addr, uint32_t nblks, uint32_t blksize, uint8_t *perr)
+{
+    YLIB_MEM *pmem;
+
+    /* 分配内存分区控制块 */
+    pmem = (YLIB_MEM *)ylib_malloc(sizeof(YLIB_MEM));
+    if (pmem == NULL)
+    {
+        *perr = YLIB_MEM_NO_FREE_BLKS;
+        return NULL;
+    }
+    if (YLibMemInit(pmem, addr, nblks, blksize, perr) == NULL)
+    {
+        ylib_free(pmem);
+        return NULL;
+    }
+    return pmem;
+}
+
+/**
+ * @brief 注销内存分区，不释放控制块
+ * @param pmem 内存分区控制块指针
+ */
+void YLibMemDeinit(YLIB_MEM *pmem)
+{
+#if configHEAP_CHECK_ENABLE
+    YLIB_MEM **plink;
+    uint32_t lock;
+#endif
+
+    if (pmem == NULL)
+    {
+        return;
+    }
+
+#if configHEAP_CHECK_ENABLE
+    YLIB_MEM_LOCK(lock);
+    for (plink = &mem_list; *plink != NULL; plink = &(*plink)->MemNext)
+    {
+        if (*plink == pmem)
+        {
+            *plink = pmem->MemNext;
+            break;
+        }
+    }
+    /* 巡检游标指向被删除的分区时跳到下一个分区 */
+    if (mem_scrub.pmem == pmem)
+    {
+        mem_scrub.pmem = pmem->MemNext;
+        mem_scrub.pprev = NULL;
+        mem_scrub.count = 0u;
+        mem_scrub.seq = (pmem->MemNext != NULL) ? pmem->MemNext->MemSeq : 0u;
+    }
+    pmem->MemMagic = 0u;
+    YLIB_MEM_UNLOCK(lock);
+#endif
+}
+
+/**
+ * @brief 删除内存分区，释放控制块
+ * @param pmem 内存分区控制块指针
+ */
+void YLibMemDel(YLIB_MEM *pmem)
+{
+    if (pmem == NULL)
+    {
+        return;
+    }
+
+    YLibMemDeinit(pmem);
+    ylib_free(pmem);
+}
+
 /**
  * @brief 从内存分区获取内存块（仿照OSMemGet）
  * @param pmem 内存分区控制块指针
@@ -116,6 +239,7 @@ YLIB_MEM *YLibMemCreate(void *addr, uint32_t nblks, uint32_t blksize, uint8_t *p
 void *YLibMemGet(YLIB_MEM *pmem, uint8_t *perr)
 {
     void *pblk;
+    uint32_t lock;
 
 #ifdef YLIB_ARG_CHK_EN
     if (perr == NULL)
@@ -137,9 +261,12 @@ void *YLibMemGet(YLIB_MEM *pmem, uint8_t *perr)
     }
 #endif
 
+    YLIB_MEM_LOCK(lock);
+
     /* 检查是否有空闲块 */
     if (pmem->MemNFree == 0u)
     {
+        YLIB_MEM_UNLOCK(lock);
         *perr = YLIB_MEM_NO_FREE_BLKS;
         return NULL;
     }
@@ -148,6 +275,13 @@ void *YLibMemGet(YLIB_MEM *pmem, uint8_t *perr)
     pblk = pmem->MemFreeList;
     pmem->MemFreeList = *(void **)pblk;
     pmem->MemNFree--;
+    if (pmem->MemNFree < pmem->MemNMinFree)
+    {
+        pmem->MemNMinFree = pmem->MemNFree;
+    }
+    YLIB_MEM_MODIFIED(pmem);
+
+    YLIB_MEM_UNLOCK(lock);
 
     *perr = YLIB_MEM_NO_ERR;
     return pblk;
@@ -161,9 +295,7 @@ void *YLibMemGet(YLIB_MEM *pmem, uint8_t *perr)
  */
 uint8_t YLibMemPut(YLIB_MEM *pmem, void *pblk)
 {
-    uint8_t *pblk_addr;
-    uint8_t *pmem_start;
-    uint8_t *pmem_end;
+    uint32_t lock;
 
 #ifdef YLIB_ARG_CHK_EN
     if (pmem == NULL)
@@ -183,25 +315,17 @@ uint8_t YLibMemPut(YLIB_MEM *pmem, void *pblk)
     }
 #endif
 
-    /* 检查内存块是否在有效范围内 */
-    pblk_addr = (uint8_t *)pblk;
-    pmem_start = (uint8_t *)pmem->MemAddr;
-    pmem_end = pmem_start + (pmem->MemNBlks * pmem->MemBlkSize);
-
-    if ((pblk_addr < pmem_start) || (pblk_addr >= pmem_end))
+    if (!YLibMemBlkValid(pmem, pblk))
     {
         return YLIB_MEM_INVALID_PBLK;
     }
 
-    /* 检查地址是否按块大小对齐 */
-    if (((pblk_addr - pmem_start) % pmem->MemBlkSize) != 0u)
-    {
-        return YLIB_MEM_INVALID_PBLK;
-    }
+    YLIB_MEM_LOCK(lock);
 
     /* 检查是否已满 */
     if (pmem->MemNFree >= pmem->MemNBlks)
     {
+        YLIB_MEM_UNLOCK(lock);
         return YLIB_MEM_FULL;
     }
 
@@ -209,6 +333,141 @@ uint8_t YLibMemPut(YLIB_MEM *pmem, void *pblk)
     *(void **)pblk = pmem->MemFreeList;
     pmem->MemFreeList = pblk;
     pmem->MemNFree++;
+    YLIB_MEM_MODIFIED(pmem);
+
+    YLIB_MEM_UNLOCK(lock);
+
+    return YLIB_MEM_NO_ERR;
+}
+
+/**
+ * @brief 一次从内存分区获取多个内存块
+ * @param pmem 内存分区控制块指针
+ * @param pblks 返回的内存块指针数组
+ * @param nblks 需要的块数量
+ * @param perr 错误码指针
+ * @return 实际获取的块数量，空闲块不足时不取出任何块并返回0
+ * @note 整批在一次临界区内完成，关中断时间与nblks成正比
+ */
+uint32_t YLibMemGetN(YLIB_MEM *pmem, void **pblks, uint32_t nblks, uint8_t *perr)
+{
+    uint32_t lock;
+    uint32_t i;
+
+#ifdef YLIB_ARG_CHK_EN
+    if (perr == NULL)
+    {
+        return 0u;
+    }
+    if (pmem == NULL)
+    {
+        *perr = YLIB_MEM_INVALID_POOL;
+        return 0u;
+    }
+    if (pblks == NULL)
+    {
+        *perr = YLIB_MEM_INVALID_ADDR;
+        return 0u;
+    }
+#endif
+
+#if configHEAP_CHECK_ENABLE
+    if (pmem->MemMagic != YLIB_MEM_MAGIC)
+    {
+        *perr = YLIB_MEM_INVALID_POOL;
+        return 0u;
+    }
+#endif
+
+    YLIB_MEM_LOCK(lock);
+
+    if (pmem->MemNFree < nblks)
+    {
+        YLIB_MEM_UNLOCK(lock);
+        *perr = YLIB_MEM_NO_FREE_BLKS;
+        return 0u;
+    }
+
+    for (i = 0u; i < nblks; i++)
+    {
+        pblks[i] = pmem->MemFreeList;
+        pmem->MemFreeList = *(void **)pblks[i];
+    }
+    pmem->MemNFree -= nblks;
+    if (pmem->MemNFree < pmem->MemNMinFree)
+    {
+        pmem->MemNMinFree = pmem->MemNFree;
+    }
+    YLIB_MEM_MODIFIED(pmem);
+
+    YLIB_MEM_UNLOCK(lock);
+
+    *perr = YLIB_MEM_NO_ERR;
+    return nblks;
+}
+
+/**
+ * @brief 一次释放多个内存块到内存分区
+ * @param pmem 内存分区控制块指针
+ * @param pblks 要释放的内存块指针数组
+ * @param nblks 块数量
+ * @return 错误码，任一块无效或超出容量时不释放任何块
+ * @note 先在临界区外串好链表，临界区内只拼接到空闲链表头
+ */
+uint8_t YLibMemPutN(YLIB_MEM *pmem, void **pblks, uint32_t nblks)
+{
+    uint32_t lock;
+    uint32_t i;
+
+#ifdef YLIB_ARG_CHK_EN
+    if (pmem == NULL)
+    {
+        return YLIB_MEM_INVALID_POOL;
+    }
+    if (pblks == NULL)
+    {
+        return YLIB_MEM_INVALID_PBLK;
+    }
+#endif
+
+#if configHEAP_CHECK_ENABLE
+    if (pmem->MemMagic != YLIB_MEM_MAGIC)
+    {
+        return YLIB_MEM_INVALID_POOL;
+    }
+#endif
+
+    if (nblks == 0u)
+    {
+        return YLIB_MEM_NO_ERR;
+    }
+
+    for (i = 0u; i < nblks; i++)
+    {
+        if (!YLibMemBlkValid(pmem, pblks[i]))
+        {
+            return YLIB_MEM_INVALID_PBLK;
+        }
+        if (i + 1u < nblks)
+        {
+            *(void **)pblks[i] = pblks[i + 1u];
+        }
+    }
+
+    YLIB_MEM_LOCK(lock);
+
+    if (pmem->MemNFree + nblks > pmem->MemNBlks)
+    {
+        YLIB_MEM_UNLOCK(lock);
+        return YLIB_MEM_FULL;
+    }
+
+    *(void **)pblks[nblks - 1u] = pmem->MemFreeList;
+    pmem->MemFreeList = pblks[0];
+    pmem->MemNFree += nblks;
+    YLIB_MEM_MODIFIED(pmem);
+
+    YLIB_MEM_UNLOCK(lock);
 
     return YLIB_MEM_NO_ERR;
 }
@@ -221,6 +480,8 @@ uint8_t YLibMemPut(YLIB_MEM *pmem, void *pblk)
  */
 uint8_t YLibMemQuery(YLIB_MEM *pmem, YLIB_MEM_DATA *p_mem_data)
 {
+    uint32_t lock;
+
 #ifdef YLIB_ARG_CHK_EN
     if (pmem == NULL)
     {
@@ -240,12 +501,18 @@ uint8_t YLibMemQuery(YLIB_MEM *pmem, YLIB_MEM_DATA *p_mem_data)
 #endif
 
     /* 复制内存分区信息 */
+    YLIB_MEM_LOCK(lock);
     p_mem_data->MemAddr = pmem->MemAddr;
     p_mem_data->MemFreeList = pmem->MemFreeList;
     p_mem_data->MemBlkSize = pmem->MemBlkSize;
     p_mem_data->MemNBlks = pmem->MemNBlks;
     p_mem_data->MemNFree = pmem->MemNFree;
     p_mem_data->MemNUsed = pmem->MemNBlks - pmem->MemNFree;
+    p_mem_data->MemNMinFree = pmem->MemNMinFree;
+#if YLIB_MEM_NAME_EN > 0u
+    p_mem_data->MemName = pmem->MemName;
+#endif
+    YLIB_MEM_UNLOCK(lock);
 
     return YLIB_MEM_NO_ERR;
 }
@@ -397,6 +664,48 @@ int YLibMemCheckIntegrity(YLIB_MEM *pmem)
     return 1;
 }
 
+/**
+ * @brief 按序号获取内存分区信息
+ * @param index 分区序号，0为最近创建的分区
+ * @param p_mem_data 返回的内存信息结构指针
+ * @return 错误码
+ */
+uint8_t YLibMemQueryIndex(uint32_t index, YLIB_MEM_DATA *p_mem_data)
+{
+    YLIB_MEM *pmem;
+    uint32_t lock;
+
+    if (p_mem_data == NULL)
+    {
+        return YLIB_MEM_INVALID_ADDR;
+    }
+
+    /* 查找和复制在同一临界区内，分区不会在中途被删除 */
+    YLIB_MEM_LOCK(lock);
+    for (pmem = mem_list; (pmem != NULL) && (index > 0u); pmem = pmem->MemNext)
+    {
+        index--;
+    }
+    if (pmem == NULL)
+    {
+        YLIB_MEM_UNLOCK(lock);
+        return YLIB_MEM_INVALID_POOL;
+    }
+    p_mem_data->MemAddr = pmem->MemAddr;
+    p_mem_data->MemFreeList = pmem->MemFreeList;
+    p_mem_data->MemBlkSize = pmem->MemBlkSize;
+    p_mem_data->MemNBlks = pmem->MemNBlks;
+    p_mem_data->MemNFree = pmem->MemNFree;
+    p_mem_data->MemNUsed = pmem->MemNBlks - pmem->MemNFree;
+    p_mem_data->MemNMinFree = pmem->MemNMinFree;
+#if YLIB_MEM_NAME_EN > 0u
+    p_mem_data->MemName = pmem->MemName;
+#endif
+    YLIB_MEM_UNLOCK(lock);
+
+    return YLIB_MEM_NO_ERR;
+}
+
 /**
  * @brief 打印内存分区信息
  * @param pmem 内存分区控制块指针
@@ -435,6 +744,96 @@ void YLibMemPrintInfo(YLIB_MEM *pmem)
     }
 #endif
 }
+
+/**
+ * @brief 增量巡检全部内存分区的空闲链表
+ * @param budget 本次最多检查的空闲块数
+ * @return 1完成一整遍，0本次未查完，-1发现损坏或已有损坏记录
+ * @note 每检查一块进出一次临界区
+ */
+int YLibMemScrub(uint32_t budget)
+{
+    ylib_heap_fault_t fault;
+    YLIB_MEM *pmem;
+    void *pblk;
+    uint32_t lock;
+
+    if (ylib_heap_get_fault(NULL))
+    {
+        return -1;
+    }
+
+    while (budget--)
+    {
+        YLIB_MEM_LOCK(lock);
+
+        /* 一遍开始，或分区在两次检查之间被修改，从空闲链表头重查 */
+        if (mem_scrub.pmem == NULL)
+        {
+            mem_scrub.pmem = mem_list;
+            if (mem_scrub.pmem == NULL)
+            {
+                YLIB_MEM_UNLOCK(lock);
+                return 1;
+            }
+            mem_scrub.seq = mem_scrub.pmem->MemSeq + 1u;
+        }
+        pmem = mem_scrub.pmem;
+        if (mem_scrub.seq != pmem->MemSeq)
+        {
+            mem_scrub.pprev = NULL;
+            mem_scrub.count = 0u;
+            mem_scrub.seq = pmem->MemSeq;
+        }
+
+        fault.block = mem_scrub.pprev;
+        fault.pool = pmem;
+        fault.owner = YLIB_HEAP_OWNER_UNKNOWN;
+        fault.reason = YLIB_HEAP_FAULT_LINK;
+        if ((pmem->MemMagic != YLIB_MEM_MAGIC) || (pmem->MemNFree > pmem->MemNBlks))
+        {
+            fault.reason = YLIB_HEAP_FAULT_HEADER;
+            goto corrupt;
+        }
+
+        pblk = (mem_scrub.pprev == NULL) ? pmem->MemFreeList : *(void **)mem_scrub.pprev;
+        if (pblk == NULL)
+        {
+            if (mem_scrub.count != pmem->MemNFree)
+            {
+                goto corrupt;
+            }
+            /* 本分区查完，转到下一个分区 */
+            mem_scrub.pmem = pmem->MemNext;
+            mem_scrub.pprev = NULL;
+            mem_scrub.count = 0u;
+            if (mem_scrub.pmem == NULL)
+            {
+                YLIB_MEM_UNLOCK(lock);
+                return 1;
+            }
+            mem_scrub.seq = mem_scrub.pmem->MemSeq;
+        }
+        else
+        {
+            if ((mem_scrub.count >= pmem->MemNFree) || !YLibMemBlkValid(pmem, pblk))
+            {
+                goto corrupt;
+            }
+            mem_scrub.pprev = pblk;
+            mem_scrub.count++;
+        }
+
+        YLIB_MEM_UNLOCK(lock);
+    }
+    return 0;
+
+corrupt:
+    mem_scrub.pmem = NULL;
+    YLIB_MEM_UNLOCK(lock);
+    ylib_heap_report_fault(&fault);
+    return -1;
+}
 #endif
 
 /*
@@ -513,7 +912,7 @@ void ylib_mempool_destroy(ylib_mempool_t *pool)
     if (pool)
     {
         ylib_free(pool->MemAddr); /* 释放内存池缓冲区 */
-        ylib_free(pool);          /* 释放控制块 */
+        YLibMemDel(pool);         /* 释放控制块 */
     }
 }
 
@@ -0,0 +1,203 @@
+/**
+ ******************************************************************************
+ * @file       yLib_pbuf.c
+ * @brief      引用计数的零拷贝数据缓冲区实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       块由yLib_mempool分配，描述符在块开头，数据紧随其后；
+ *             引用计数的增减在YLIB_PBUF_LOCK临界区内完成
+ ******************************************************************************
+ */
+
+#include "yLib_pbuf.h"
+#include "yLib_mempool.h"
+#include <string.h>
+
+/**
+ * @brief 内存池块：描述符加数据
+ */
+typedef struct {
+    ylib_pbuf_t desc;                        /* 描述符 */
+    uint32_t data[(YLIB_PBUF_SIZE + 3) / 4]; /* 数据，按字对齐 */
+} ylib_pbuf_block_t;
+
+YLIB_MEM_PARTITION_DECLARE(pbuf, ylib_pbuf_block_t, YLIB_PBUF_COUNT);
+static YLIB_MEM *pbuf_pool = NULL;
+static uint32_t pbuf_failed;
+
+/**
+ * @brief 取一个块并初始化描述符
+ */
+static ylib_pbuf_t *pbuf_take(void)
+{
+    ylib_pbuf_t *p;
+    uint8_t err;
+
+    if ((pbuf_pool == NULL) && (ylib_pbuf_init() != 0))
+        return NULL;
+
+    p = (ylib_pbuf_t *)YLibMemGet(pbuf_pool, &err);
+    if (p == NULL) {
+        pbuf_failed++;
+        return NULL;
+    }
+
+    p->next = NULL;
+    p->ref = 1;
+    p->flags = 0;
+    p->reserved = 0;
+    return p;
+}
+
+int ylib_pbuf_init(void)
+{
+    uint8_t err;
+
+    if (pbuf_pool != NULL)
+        return 0;
+
+    (void)pbuf_mem_partition;
+    pbuf_pool = YLIB_MEM_PARTITION_INIT(pbuf, ylib_pbuf_block_t, YLIB_PBUF_COUNT, &err);
+    return (pbuf_pool != NULL) ? 0 : -1;
+}
+
+ylib_pbuf_t *ylib_pbuf_alloc(unsigned int headroom, unsigned int len)
+{
+    ylib_pbuf_t *p;
+
+    if ((headroom > YLIB_PBUF_SIZE) || (len > (YLIB_PBUF_SIZE - headroom)))
+        return NULL;
+
+    p = pbuf_take();
+    if (p == NULL)
+        return NULL;
+
+    p->payload = (uint8_t *)((ylib_pbuf_block_t *)p)->data + headroom;
+    p->len = (uint16_t)len;
+    p->tot_len = (uint16_t)len;
+    return p;
+}
+
+ylib_pbuf_t *ylib_pbuf_alloc_ref(const void *data, unsigned int len)
+{
+    ylib_pbuf_t *p;
+
+    if (len > 0xFFFFu)
+        return NULL;
+
+    p = pbuf_take();
+    if (p == NULL)
+        return NULL;
+
+    p->payload = (uint8_t *)data;
+    p->len = (uint16_t)len;
+    p->tot_len = (uint16_t)len;
+    p->flags = YLIB_PBUF_FLAG_REF;
+    return p;
+}
+
+void ylib_pbuf_ref(ylib_pbuf_t *p)
+{
+    uint32_t lock;
+
+    if (p == NULL)
+        return;
+
+    YLIB_PBUF_LOCK(lock);
+    p->ref++;
+    YLIB_PBUF_UNLOCK(lock);
+}
+
+unsigned int ylib_pbuf_free(ylib_pbuf_t *p)
+{
+    ylib_pbuf_t *next;
+    unsigned int count = 0;
+    uint16_t ref;
+    uint32_t lock;
+
+    while (p != NULL) {
+        YLIB_PBUF_LOCK(lock);
+        ref = --p->ref;
+        YLIB_PBUF_UNLOCK(lock);
+        if (ref != 0)
+            break;
+
+        /* 这一段持有下一段的引用，归还后继续释放下一段 */
+        next = p->next;
+        (void)YLibMemPut(pbuf_pool, p);
+        count++;
+        p = next;
+    }
+
+    return count;
+}
+
+void ylib_pbuf_cat(ylib_pbuf_t *head, ylib_pbuf_t *tail)
+{
+    ylib_pbuf_t *p;
+
+    for (p = head; p->next != NULL; p = p->next)
+        p->tot_len = (uint16_t)(p->tot_len + tail->tot_len);
+    p->tot_len = (uint16_t)(p->tot_len + tail->tot_len);
+    p->next = tail;
+}
+
+void ylib_pbuf_chain(ylib_pbuf_t *head, ylib_pbuf_t *tail)
+{
+    ylib_pbuf_cat(head, tail);
+    ylib_pbuf_ref(tail);
+}
+
+int ylib_pbuf_header(ylib_pbuf_t *p, int delta)
+{
+    uint8_t *start;
+
+    if (delta < 0) {
+        if ((unsigned int)(-delta) > p->len)
+            return -1;
+    } else if (delta > 0) {
+        start = (uint8_t *)((ylib_pbuf_block_t *)p)->data;
+        if ((p->flags & YLIB_PBUF_FLAG_REF) || ((unsigned int)delta > (unsigned int)(p->payload - start)))
+            return -1;
+    }
+
+    p->payload -= delta;
+    p->len = (uint16_t)(p->len + delta);
+    p->tot_len = (uint16_t)(p->tot_len + delta);
+    return 0;
+}
+
+unsigned int ylib_pbuf_copy_out(const ylib_pbuf_t *p, unsigned int offset, void *buf, unsigned int len)
+{
+    uint8_t *out = (uint8_t *)buf;
+    unsigned int copied = 0;
+    unsigned int n;
+
+    for (; (p != NULL) && (copied < len); p = p->next) {
+        if (offset >= p->len) {
+            offset -= p->len;
+            continue;
+        }
+        n = MIN(p->len - offset, len - copied);
+        memcpy(&out[copied], &p->payload[offset], n);
+        copied += n;
+        offset = 0;
+    }
+
+    return copied;
+}
+
+void ylib_pbuf_get_stats(struct ylib_pbuf_stats *stats)
+{
+    YLIB_MEM_DATA data;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->failed = pbuf_failed;
+    if ((pbuf_pool == NULL) || (YLibMemQuery(pbuf_pool, &data) != YLIB_MEM_NO_ERR))
+        return;
+
+    stats->total = data.MemNBlks;
+    stats->free = data.MemNFree;
+    stats->min_free = data.MemNMinFree;
+}
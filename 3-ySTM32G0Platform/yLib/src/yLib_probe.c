@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file       yLib_probe.c
+  * @brief      代码段耗时探针实现
+  * @author     Ryan
+  * @version    V2.0.0
+  * @date       2025/06/16
+  * @note       M0+没有64位原子加，总和与其他字段一起在临界区内更新；
+  *             平均值在读取时由总和除以次数得到，记录路径上没有除法
+  ******************************************************************************
+  */
+
+#include "yLib_probe.h"
+
+#if YLIB_PROBE_ENABLE
+/* 链接脚本在.ylib_probe段前后定义 */
+extern struct ylib_probe __ylib_probe_start[];
+extern struct ylib_probe __ylib_probe_end[];
+
+uint32_t (*ylib_probe_now)(void);
+#endif
+
+void ylib_probe_register_clock(uint32_t (*now)(void))
+{
+#if YLIB_PROBE_ENABLE
+    ylib_probe_now = now;
+#else
+    (void)now;
+#endif
+}
+
+void ylib_probe_record(struct ylib_probe *probe, uint32_t us)
+{
+    uint32_t state;
+
+    YLIB_PROBE_LOCK(state);
+    probe->count++;
+    probe->sum += us;
+    if (us < probe->min)
+        probe->min = us;
+    if (us > probe->max)
+        probe->max = us;
+    YLIB_PROBE_UNLOCK(state);
+}
+
+struct ylib_probe *ylib_probe_iterate(unsigned int index)
+{
+#if YLIB_PROBE_ENABLE
+    struct ylib_probe *probe = __ylib_probe_start + index;
+
+    return (probe < __ylib_probe_end) ? probe : NULL;
+#else
+    (void)index;
+    return NULL;
+#endif
+}
+
+void ylib_probe_read(struct ylib_probe *probe, struct ylib_probe_stats *stats, int reset)
+{
+    uint32_t state;
+    uint64_t sum;
+
+    YLIB_PROBE_LOCK(state);
+    stats->count = probe->count;
+    stats->min = (probe->count != 0) ? probe->min : 0;
+    stats->max = probe->max;
+    sum = probe->sum;
+    if (reset) {
+        probe->count = 0;
+        probe->min = UINT32_MAX;
+        probe->max = 0;
+        probe->sum = 0;
+    }
+    YLIB_PROBE_UNLOCK(state);
+
+    stats->avg = (stats->count != 0) ? (uint32_t)(sum / stats->count) : 0;
+}
+
+void ylib_probe_reset_all(void)
+{
+    struct ylib_probe_stats stats;
+    struct ylib_probe *probe;
+    unsigned int index;
+
+    for (index = 0; (probe = ylib_probe_iterate(index)) != NULL; index++)
+        ylib_probe_read(probe, &stats, 1);
+}
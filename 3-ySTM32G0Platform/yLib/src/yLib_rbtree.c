@@ -9,13 +9,15 @@
   ******************************************************************************
   */
 
-#include "yLib_rbtree.h"
+#include "yLib_rbtree_augmented.h"
 
 /*
  * 红黑树核心算法实现，参考Linux内核实现，适当精简
+ * 增强树的旋转通过augment->rotate通知，删除后从受影响的最低节点向上重算增强值
  */
 
-static void ylib_rb_rotate_left(struct ylib_rb_node *node, struct ylib_rb_root *root)
+static void ylib_rb_rotate_left(struct ylib_rb_node *node, struct ylib_rb_root *root,
+                                const struct ylib_rb_augment_callbacks *augment)
 {
     struct ylib_rb_node *right = node->rb_right;
     struct ylib_rb_node *parent = ylib_rb_parent(node);
@@ -35,9 +37,12 @@ static void ylib_rb_rotate_left(struct ylib_rb_node *node, struct ylib_rb_root *
         root->rb_node = right;
     }
     ylib_rb_set_parent(node, right);
+    if (augment)
+        augment->rotate(node, right);
 }
 
-static void ylib_rb_rotate_right(struct ylib_rb_node *node, struct ylib_rb_root *root)
+static void ylib_rb_rotate_right(struct ylib_rb_node *node, struct ylib_rb_root *root,
+                                 const struct ylib_rb_augment_callbacks *augment)
 {
     struct ylib_rb_node *left = node->rb_left;
     struct ylib_rb_node *parent = ylib_rb_parent(node);
@@ -57,6 +62,8 @@ static void ylib_rb_rotate_right(struct ylib_rb_node *node, struct ylib_rb_root
         root->rb_node = left;
     }
     ylib_rb_set_parent(node, left);
+    if (augment)
+        augment->rotate(node, left);
 }
 
 void ylib_rb_link_node(struct ylib_rb_node *node, struct ylib_rb_node *parent,
@@ -67,7 +74,8 @@ void ylib_rb_link_node(struct ylib_rb_node *node, struct ylib_rb_node *parent,
     *rb_link = node;
 }
 
-void ylib_rb_insert_color(struct ylib_rb_node *node, struct ylib_rb_root *root)
+static void __ylib_rb_insert_color(struct ylib_rb_node *node, struct ylib_rb_root *root,
+                                   const struct ylib_rb_augment_callbacks *augment)
 {
     struct ylib_rb_node *parent, *gparent;
 
@@ -84,13 +92,13 @@ void ylib_rb_insert_color(struct ylib_rb_node *node, struct ylib_rb_root *root)
             }
             if (parent->rb_right == node) {
                 node = parent;
-                ylib_rb_rotate_left(node, root);
+                ylib_rb_rotate_left(node, root, augment);
                 parent = ylib_rb_parent(node);
                 gparent = ylib_rb_parent(parent);
             }
             ylib_rb_set_color(parent, YLIB_RB_BLACK);
             ylib_rb_set_color(gparent, YLIB_RB_RED);
-            ylib_rb_rotate_right(gparent, root);
+            ylib_rb_rotate_right(gparent, root, augment);
         } else {
             struct ylib_rb_node *uncle = gparent->rb_left;
             if (uncle && ylib_rb_is_red(uncle)) {
@@ -102,19 +110,20 @@ void ylib_rb_insert_color(struct ylib_rb_node *node, struct ylib_rb_root *root)
             }
             if (parent->rb_left == node) {
                 node = parent;
-                ylib_rb_rotate_right(node, root);
+                ylib_rb_rotate_right(node, root, augment);
                 parent = ylib_rb_parent(node);
                 gparent = ylib_rb_parent(parent);
             }
             ylib_rb_set_color(parent, YLIB_RB_BLACK);
             ylib_rb_set_color(gparent, YLIB_RB_RED);
-            ylib_rb_rotate_left(gparent, root);
+            ylib_rb_rotate_left(gparent, root, augment);
         }
     }
     ylib_rb_set_color(root->rb_node, YLIB_RB_BLACK);
 }
 
-void ylib_rb_erase(struct ylib_rb_node *node, struct ylib_rb_root *root)
+static void __ylib_rb_erase(struct ylib_rb_node *node, struct ylib_rb_root *root,
+                            const struct ylib_rb_augment_callbacks *augment)
 {
     struct ylib_rb_node *child, *parent;
     int color;
@@ -166,6 +175,9 @@ void ylib_rb_erase(struct ylib_rb_node *node, struct ylib_rb_root *root)
         root->rb_node = child;
     }
 color_fixup:
+    /* parent是结构变化后最低的受影响节点，先把增强值修正到根，旋转时才能正确传递 */
+    if (augment)
+        augment->propagate(parent, NULL);
     if (color == YLIB_RB_BLACK) {
         while (child != root->rb_node && (!child || ylib_rb_is_black(child))) {
             if (child == parent->rb_left) {
@@ -173,7 +185,7 @@ color_fixup:
                 if (ylib_rb_is_red(sibling)) {
                     ylib_rb_set_color(sibling, YLIB_RB_BLACK);
                     ylib_rb_set_color(parent, YLIB_RB_RED);
-                    ylib_rb_rotate_left(parent, root);
+                    ylib_rb_rotate_left(parent, root, augment);
                     sibling = parent->rb_right;
                 }
                 if ((!sibling->rb_left || ylib_rb_is_black(sibling->rb_left)) &&
@@ -186,14 +198,14 @@ color_fixup:
                         if (sibling->rb_left)
                             ylib_rb_set_color(sibling->rb_left, YLIB_RB_BLACK);
                         ylib_rb_set_color(sibling, YLIB_RB_RED);
-                        ylib_rb_rotate_right(sibling, root);
+                        ylib_rb_rotate_right(sibling, root, augment);
                         sibling = parent->rb_right;
                     }
                     ylib_rb_set_color(sibling, ylib_rb_color(parent));
                     ylib_rb_set_color(parent, YLIB_RB_BLACK);
                     if (sibling->rb_right)
                         ylib_rb_set_color(sibling->rb_right, YLIB_RB_BLACK);
-                    ylib_rb_rotate_left(parent, root);
+                    ylib_rb_rotate_left(parent, root, augment);
                     child = root->rb_node;
                     break;
                 }
@@ -202,7 +214,7 @@ color_fixup:
                 if (ylib_rb_is_red(sibling)) {
                     ylib_rb_set_color(sibling, YLIB_RB_BLACK);
                     ylib_rb_set_color(parent, YLIB_RB_RED);
-                    ylib_rb_rotate_right(parent, root);
+                    ylib_rb_rotate_right(parent, root, augment);
                     sibling = parent->rb_left;
                 }
                 if ((!sibling->rb_left || ylib_rb_is_black(sibling->rb_left)) &&
@@ -215,14 +227,14 @@ color_fixup:
                         if (sibling->rb_right)
                             ylib_rb_set_color(sibling->rb_right, YLIB_RB_BLACK);
                         ylib_rb_set_color(sibling, YLIB_RB_RED);
-                        ylib_rb_rotate_left(sibling, root);
+                        ylib_rb_rotate_left(sibling, root, augment);
                         sibling = parent->rb_left;
                     }
                     ylib_rb_set_color(sibling, ylib_rb_color(parent));
                     ylib_rb_set_color(parent, YLIB_RB_BLACK);
                     if (sibling->rb_left)
                         ylib_rb_set_color(sibling->rb_left, YLIB_RB_BLACK);
-                    ylib_rb_rotate_right(parent, root);
+                    ylib_rb_rotate_right(parent, root, augment);
                     child = root->rb_node;
                     break;
                 }
@@ -233,6 +245,28 @@ color_fixup:
     }
 }
 
+void ylib_rb_insert_color(struct ylib_rb_node *node, struct ylib_rb_root *root)
+{
+    __ylib_rb_insert_color(node, root, NULL);
+}
+
+void ylib_rb_erase(struct ylib_rb_node *node, struct ylib_rb_root *root)
+{
+    __ylib_rb_erase(node, root, NULL);
+}
+
+void ylib_rb_insert_augmented(struct ylib_rb_node *node, struct ylib_rb_root *root,
+                              const struct ylib_rb_augment_callbacks *augment)
+{
+    __ylib_rb_insert_color(node, root, augment);
+}
+
+void ylib_rb_erase_augmented(struct ylib_rb_node *node, struct ylib_rb_root *root,
+                             const struct ylib_rb_augment_callbacks *augment)
+{
+    __ylib_rb_erase(node, root, augment);
+}
+
 void ylib_rb_replace_node(struct ylib_rb_node *victim, struct ylib_rb_node *new_node,
                          struct ylib_rb_root *root)
 {
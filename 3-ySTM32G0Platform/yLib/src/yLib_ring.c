@@ -10,43 +10,42 @@
  */
 
 #include "yLib_ring.h"
+#include "yLib_heap.h"
 
 #ifndef MIN
 #define MIN(x, y) ((x) < (y) ? (x) : (y))
 #endif
 
-/* 原子操作的简单实现（单线程环境） */
-#ifndef __atomic_load_n
-#define __atomic_load_n(ptr, model) (*(ptr))
-#endif
-
-#ifndef __atomic_store_n
-#define __atomic_store_n(ptr, val, model) (*(ptr) = (val))
-#endif
+/* 按计数定位元素 */
+#define YLIB_RING_SLOT(ring, pos, element_size) ((char *)(ring)->ring + ((pos) & (ring)->mask) * (element_size))
 
-#ifndef __atomic_compare_exchange_n
-/* 使用内联函数替代GNU扩展的语句表达式 */
-static inline int ylib_atomic_compare_exchange_uint(volatile unsigned int *ptr,
-                                                    unsigned int *expected,
-                                                    unsigned int desired)
+/**
+ * @brief 从计数pos开始连续写入n个元素，跨越缓冲区末尾时分两段
+ */
+YLIB_RAMFUNC static void ylib_ring_copy_in(struct ylib_ring *ring, unsigned int pos, const void *data,
+                                           unsigned int n, size_t element_size)
 {
-    unsigned int old = *expected;
-    unsigned int cur = *ptr;
-    if (cur == old)
-    {
-        *ptr = desired;
-        return 1;
-    }
-    else
-    {
-        *expected = cur;
-        return 0;
-    }
+    unsigned int idx = pos & ring->mask;
+    unsigned int first = MIN(n, ring->size - idx);
+
+    memcpy((char *)ring->ring + idx * element_size, data, first * element_size);
+    if (n > first)
+        memcpy(ring->ring, (const char *)data + first * element_size, (n - first) * element_size);
 }
 
-#define __atomic_compare_exchange_n(ptr, expected, desired, weak, success_model, failure_model) \
-    ylib_atomic_compare_exchange_uint((ptr), (expected), (desired))
-#endif
+/**
+ * @brief 从计数pos开始连续读出n个元素，跨越缓冲区末尾时分两段
+ */
+YLIB_RAMFUNC static void ylib_ring_copy_out(struct ylib_ring *ring, unsigned int pos, void *data,
+                                            unsigned int n, size_t element_size)
+{
+    unsigned int idx = pos & ring->mask;
+    unsigned int first = MIN(n, ring->size - idx);
+
+    memcpy(data, (char *)ring->ring + idx * element_size, first * element_size);
+    if (n > first)
+        memcpy((char *)data + first * element_size, ring->ring, (n - first) * element_size);
+}
 
 /**
  * @brief 创建环形队列
@@ -63,21 +62,21 @@ struct ylib_ring *ylib_ring_create(unsigned int size, size_t element_size)
     if (!size || (size & (size - 1)))
         return NULL;
 
-    ring = malloc(sizeof(struct ylib_ring));
+    ring = ylib_malloc(sizeof(struct ylib_ring));
     if (!ring)
         return NULL;
 
-    buffer = malloc(size * element_size);
+    buffer = ylib_malloc(size * element_size);
     if (!buffer)
     {
-        free(ring);
+        ylib_free(ring);
         return NULL;
     }
 
     if (ylib_ring_init(ring, buffer, size) < 0)
     {
-        free(buffer);
-        free(ring);
+        ylib_free(buffer);
+        ylib_free(ring);
         return NULL;
     }
 
@@ -92,8 +91,8 @@ void ylib_ring_destroy(struct ylib_ring *ring)
 {
     if (ring)
     {
-        free(ring->ring);
-        free(ring);
+        ylib_free(ring->ring);
+        ylib_free(ring);
     }
 }
 
@@ -104,21 +103,22 @@ void ylib_ring_destroy(struct ylib_ring *ring)
  * @param element_size 元素大小
  * @return 1成功，0失败（队列已满）
  */
-int ylib_ring_enqueue(struct ylib_ring *ring, const void *data, size_t element_size)
+YLIB_RAMFUNC int ylib_ring_enqueue(struct ylib_ring *ring, const void *data, size_t element_size)
 {
-    unsigned int head = ring->head;
     unsigned int tail = ring->tail;
-    unsigned int next_tail = (tail + 1) & ring->mask;
+    unsigned int head = ring->head;
 
     /* 检查队列是否已满 */
-    if (next_tail == head)
+    if (tail - head >= ring->size)
         return 0;
 
     /* 复制数据 */
-    memcpy((char *)ring->ring + tail * element_size, data, element_size);
+    memcpy(YLIB_RING_SLOT(ring, tail, element_size), data, element_size);
 
-    /* 更新tail */
-    ring->tail = next_tail;
+    /* 数据写完后再发布tail */
+    YLIB_RING_BARRIER();
+    ring->prod_head = tail + 1;
+    ring->tail = tail + 1;
 
     return 1;
 }
@@ -130,7 +130,7 @@ int ylib_ring_enqueue(struct ylib_ring *ring, const void *data, size_t element_s
  * @param element_size 元素大小
  * @return 1成功，0失败（队列为空）
  */
-int ylib_ring_dequeue(struct ylib_ring *ring, void *data, size_t element_size)
+YLIB_RAMFUNC int ylib_ring_dequeue(struct ylib_ring *ring, void *data, size_t element_size)
 {
     unsigned int head = ring->head;
     unsigned int tail = ring->tail;
@@ -139,11 +139,12 @@ int ylib_ring_dequeue(struct ylib_ring *ring, void *data, size_t element_size)
     if (head == tail)
         return 0;
 
-    /* 复制数据 */
-    memcpy(data, (char *)ring->ring + head * element_size, element_size);
-
-    /* 更新head */
-    ring->head = (head + 1) & ring->mask;
+    /* 先读tail再读数据，读完后再释放槽位 */
+    YLIB_RING_BARRIER();
+    memcpy(data, YLIB_RING_SLOT(ring, head, element_size), element_size);
+    YLIB_RING_BARRIER();
+    ring->cons_head = head + 1;
+    ring->head = head + 1;
 
     return 1;
 }
@@ -156,40 +157,24 @@ int ylib_ring_dequeue(struct ylib_ring *ring, void *data, size_t element_size)
  * @param element_size 元素大小
  * @return 实际入队的元素个数
  */
-unsigned int ylib_ring_enqueue_bulk(struct ylib_ring *ring, const void *data,
-                                    unsigned int count, size_t element_size)
+YLIB_RAMFUNC unsigned int ylib_ring_enqueue_bulk(struct ylib_ring *ring, const void *data,
+                                                 unsigned int count, size_t element_size)
 {
-    unsigned int head = ring->head;
     unsigned int tail = ring->tail;
-    unsigned int free_space = ring->size - ((tail - head) & ring->mask);
-    unsigned int n, idx;
-
-    if (count == 0)
-        return 0;
+    unsigned int head = ring->head;
+    unsigned int n;
 
     /* 限制入队数量 */
-    n = MIN(count, free_space);
+    n = MIN(count, ring->size - (tail - head));
     if (n == 0)
         return 0;
 
-    /* 分段复制数据 */
-    idx = tail & ring->mask;
-    if (idx + n <= ring->size)
-    {
-        /* 连续复制 */
-        memcpy((char *)ring->ring + idx * element_size, data, n * element_size);
-    }
-    else
-    {
-        /* 分两段复制 */
-        unsigned int first_part = ring->size - idx;
-        memcpy((char *)ring->ring + idx * element_size, data, first_part * element_size);
-        memcpy(ring->ring, (char *)data + first_part * element_size,
-               (n - first_part) * element_size);
-    }
+    ylib_ring_copy_in(ring, tail, data, n, element_size);
 
-    /* 更新tail */
-    ring->tail = (tail + n) & ring->mask;
+    /* 数据写完后再发布tail */
+    YLIB_RING_BARRIER();
+    ring->prod_head = tail + n;
+    ring->tail = tail + n;
 
     return n;
 }
@@ -202,40 +187,23 @@ unsigned int ylib_ring_enqueue_bulk(struct ylib_ring *ring, const void *data,
  * @param element_size 元素大小
  * @return 实际出队的元素个数
  */
-unsigned int ylib_ring_dequeue_bulk(struct ylib_ring *ring, void *data,
-                                    unsigned int count, size_t element_size)
+YLIB_RAMFUNC unsigned int ylib_ring_dequeue_bulk(struct ylib_ring *ring, void *data,
+                                                 unsigned int count, size_t element_size)
 {
     unsigned int head = ring->head;
     unsigned int tail = ring->tail;
-    unsigned int available = (tail - head) & ring->mask;
-    unsigned int n, idx;
-
-    if (count == 0)
-        return 0;
+    unsigned int n;
 
     /* 限制出队数量 */
-    n = MIN(count, available);
+    n = MIN(count, tail - head);
     if (n == 0)
         return 0;
 
-    /* 分段复制数据 */
-    idx = head & ring->mask;
-    if (idx + n <= ring->size)
-    {
-        /* 连续复制 */
-        memcpy(data, (char *)ring->ring + idx * element_size, n * element_size);
-    }
-    else
-    {
-        /* 分两段复制 */
-        unsigned int first_part = ring->size - idx;
-        memcpy(data, (char *)ring->ring + idx * element_size, first_part * element_size);
-        memcpy((char *)data + first_part * element_size, ring->ring,
-               (n - first_part) * element_size);
-    }
-
-    /* 更新head */
-    ring->head = (head + n) & ring->mask;
+    YLIB_RING_BARRIER();
+    ylib_ring_copy_out(ring, head, data, n, element_size);
+    YLIB_RING_BARRIER();
+    ring->cons_head = head + n;
+    ring->head = head + n;
 
     return n;
 }
@@ -249,17 +217,7 @@ unsigned int ylib_ring_dequeue_bulk(struct ylib_ring *ring, void *data,
  */
 int ylib_ring_peek(struct ylib_ring *ring, void *data, size_t element_size)
 {
-    unsigned int head = ring->head;
-    unsigned int tail = ring->tail;
-
-    /* 检查队列是否为空 */
-    if (head == tail)
-        return 0;
-
-    /* 复制数据 */
-    memcpy(data, (char *)ring->ring + head * element_size, element_size);
-
-    return 1;
+    return ylib_ring_peek_at(ring, 0, data, element_size);
 }
 
 /**
@@ -275,80 +233,161 @@ int ylib_ring_peek_at(struct ylib_ring *ring, unsigned int index,
 {
     unsigned int head = ring->head;
     unsigned int tail = ring->tail;
-    unsigned int available = (tail - head) & ring->mask;
 
     /* 检查索引是否有效 */
-    if (index >= available)
+    if (index >= tail - head)
         return 0;
 
-    /* 计算实际位置并复制数据 */
-    unsigned int pos = (head + index) & ring->mask;
-    memcpy(data, (char *)ring->ring + pos * element_size, element_size);
+    YLIB_RING_BARRIER();
+    memcpy(data, YLIB_RING_SLOT(ring, head + index, element_size), element_size);
 
     return 1;
 }
 
 /**
- * @brief 多生产者入队操作
+ * @brief 预留可直接写入的空闲区域
  * @param ring 环形队列指针
- * @param data 数据指针
+ * @param count 希望预留的元素个数
+ * @param span 区域输出，跨越缓冲区末尾时为两段
  * @param element_size 元素大小
- * @return 1成功，0失败
+ * @return 实际预留的元素个数
  */
-int ylib_ring_mp_enqueue(struct ylib_ring *ring, const void *data, size_t element_size)
+unsigned int ylib_ring_reserve(struct ylib_ring *ring, unsigned int count,
+                               ylib_span_t *span, size_t element_size)
 {
-    unsigned int head, tail, next_tail;
-    int success;
+    unsigned int tail = ring->tail;
+    unsigned int n = MIN(count, ring->size - (tail - ring->head));
 
-    do
-    {
-        head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
-        tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
-        next_tail = (tail + 1) & ring->mask;
+    /* 先读head再写槽位，消费者释放前的读取不会被覆盖 */
+    YLIB_RING_BARRIER();
+    return ylib_span_init(span, ring->ring, ring->mask, tail, n, element_size);
+}
 
-        /* 检查队列是否已满 */
-        if (next_tail == head)
-            return 0;
+/**
+ * @brief 发布已写入预留区域的元素
+ * @param ring 环形队列指针
+ * @param count 元素个数
+ */
+void ylib_ring_commit(struct ylib_ring *ring, unsigned int count)
+{
+    unsigned int tail = ring->tail + count;
 
-        success = __atomic_compare_exchange_n(&ring->tail, &tail, next_tail,
-                                              0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
-    } while (!success);
+    /* 数据写完后再发布tail */
+    YLIB_RING_BARRIER();
+    ring->prod_head = tail;
+    ring->tail = tail;
+}
 
-    /* 复制数据 */
-    memcpy((char *)ring->ring + tail * element_size, data, element_size);
+/**
+ * @brief 获取可直接读取的队首区域
+ * @param ring 环形队列指针
+ * @param count 希望读取的元素个数
+ * @param span 区域输出，跨越缓冲区末尾时为两段
+ * @param element_size 元素大小
+ * @return 实际可读的元素个数
+ */
+unsigned int ylib_ring_peek_linear(struct ylib_ring *ring, unsigned int count,
+                                   ylib_span_t *span, size_t element_size)
+{
+    unsigned int head = ring->head;
+    unsigned int n = MIN(count, ring->tail - head);
 
-    return 1;
+    /* 先读tail再读数据 */
+    YLIB_RING_BARRIER();
+    return ylib_span_init(span, ring->ring, ring->mask, head, n, element_size);
 }
 
 /**
- * @brief 多消费者出队操作
+ * @brief 释放已读取的队首元素
  * @param ring 环形队列指针
- * @param data 数据指针
+ * @param count 元素个数
+ */
+void ylib_ring_release(struct ylib_ring *ring, unsigned int count)
+{
+    unsigned int head = ring->head + count;
+
+    /* 数据读完后再释放槽位 */
+    YLIB_RING_BARRIER();
+    ring->cons_head = head;
+    ring->head = head;
+}
+
+/**
+ * @brief 多生产者批量入队
+ * @param ring 环形队列指针
+ * @param data 数据缓冲区
+ * @param count 元素个数
  * @param element_size 元素大小
- * @return 1成功，0失败
+ * @return 实际入队的元素个数
  */
-int ylib_ring_mc_dequeue(struct ylib_ring *ring, void *data, size_t element_size)
+unsigned int ylib_ring_mp_enqueue_bulk(struct ylib_ring *ring, const void *data,
+                                       unsigned int count, size_t element_size)
 {
-    unsigned int head, tail, next_head;
-    int success;
+    unsigned int pos, n;
+    uint32_t lock;
 
-    do
+    /* 预留：只推进prod_head */
+    YLIB_RING_LOCK(lock);
+    pos = ring->prod_head;
+    n = MIN(count, ring->size - (pos - ring->head));
+    if (n == 0)
     {
-        head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
-        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        YLIB_RING_UNLOCK(lock);
+        return 0;
+    }
+    ring->prod_head = pos + n;
+    ring->prod_busy++;
+    YLIB_RING_UNLOCK(lock);
 
-        /* 检查队列是否为空 */
-        if (head == tail)
-            return 0;
+    /* 复制在临界区外，可被其他生产者抢占 */
+    ylib_ring_copy_in(ring, pos, data, n, element_size);
 
-        next_head = (head + 1) & ring->mask;
+    /* 提交：最后一个完成的生产者把tail推进到全部预留位置，之前预留的数据此时都已写完 */
+    YLIB_RING_BARRIER();
+    YLIB_RING_LOCK(lock);
+    if (--ring->prod_busy == 0)
+        ring->tail = ring->prod_head;
+    YLIB_RING_UNLOCK(lock);
 
-        success = __atomic_compare_exchange_n(&ring->head, &head, next_head,
-                                              0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
-    } while (!success);
+    return n;
+}
 
-    /* 复制数据 */
-    memcpy(data, (char *)ring->ring + head * element_size, element_size);
+/**
+ * @brief 多消费者批量出队
+ * @param ring 环形队列指针
+ * @param data 数据缓冲区
+ * @param count 元素个数
+ * @param element_size 元素大小
+ * @return 实际出队的元素个数
+ */
+unsigned int ylib_ring_mc_dequeue_bulk(struct ylib_ring *ring, void *data,
+                                       unsigned int count, size_t element_size)
+{
+    unsigned int pos, n;
+    uint32_t lock;
 
-    return 1;
+    /* 预留：只推进cons_head */
+    YLIB_RING_LOCK(lock);
+    pos = ring->cons_head;
+    n = MIN(count, ring->tail - pos);
+    if (n == 0)
+    {
+        YLIB_RING_UNLOCK(lock);
+        return 0;
+    }
+    ring->cons_head = pos + n;
+    ring->cons_busy++;
+    YLIB_RING_UNLOCK(lock);
+
+    YLIB_RING_BARRIER();
+    ylib_ring_copy_out(ring, pos, data, n, element_size);
+
+    /* 提交：最后一个完成的消费者释放全部已预留槽位 */
+    YLIB_RING_BARRIER();
+    YLIB_RING_LOCK(lock);
+    if (--ring->cons_busy == 0)
+        ring->head = ring->cons_head;
+    YLIB_RING_UNLOCK(lock);
+
+    return n;
 }
@@ -0,0 +1,203 @@
+/**
+ ******************************************************************************
+ * @file       yLib_sbtree.c
+ * @brief      只读静态B树索引实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       节点内二分查找第一个大于目标的键，前一个即应下降的子节点或叶子中的记录；
+ *             各层节点数由记录数和页大小算出，与头部的层数核对，不信任镜像中的其他结构
+ ******************************************************************************
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "yLib_sbtree.h"
+#include "yLib_crc.h"
+
+#define SBTREE_HEADER_CRC_LEN offsetof(struct ylib_sbtree_header, header_crc)
+
+/**
+ * @brief 镜像第page页的地址
+ */
+static inline uint32_t sbtree_page_addr(const struct ylib_sbtree *tree, uint32_t page)
+{
+    return tree->base + page * tree->hdr.page_size;
+}
+
+/**
+ * @brief 叶子每页的记录数
+ */
+static inline uint32_t sbtree_leaf_records(const struct ylib_sbtree *tree)
+{
+    return tree->hdr.page_size / (4U + tree->hdr.value_size);
+}
+
+/**
+ * @brief 第一个大于key的键的序号
+ */
+static uint32_t sbtree_upper(const uint32_t *keys, uint32_t n, uint32_t key)
+{
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    uint32_t mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2U;
+        if (keys[mid] <= key)
+            lo = mid + 1U;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief 取得第level层第index个节点，常驻层直接返回RAM中的节点
+ */
+static const uint32_t *sbtree_node(struct ylib_sbtree *tree, uint32_t level, uint32_t index)
+{
+    uint32_t page = tree->first[level] + index;
+
+    if (level < tree->pinned)
+        return tree->pin + (page - 1U) * (tree->hdr.page_size / 4U);
+
+    tree->reads++;
+    if (tree->read(tree->ctx, sbtree_page_addr(tree, page), tree->page, tree->hdr.page_size) != 0)
+        return NULL;
+    return tree->page;
+}
+
+/**
+ * @brief 从根下降到叶子，找出不大于key的最大键
+ */
+static int sbtree_search(struct ylib_sbtree *tree, uint32_t key, int exact, uint32_t *found, void *value)
+{
+    uint32_t fanout = tree->hdr.page_size / 4U;
+    uint32_t records = sbtree_leaf_records(tree);
+    uint32_t last = tree->hdr.levels - 1U;
+    const uint32_t *node;
+    uint32_t index = 0;
+    uint32_t level;
+    uint32_t n;
+    uint32_t j;
+
+    tree->lookups++;
+    for (level = 0; level <= last; level++) {
+        node = sbtree_node(tree, level, index);
+        if (node == NULL)
+            return -1;
+
+        if (level < last)
+            n = MIN(fanout, tree->nodes[level + 1] - index * fanout);
+        else
+            n = MIN(records, tree->hdr.count - index * records);
+
+        // 只有根可能整个大于key，其下的节点由上层保证首键不大于key
+        j = sbtree_upper(node, n, key);
+        if (j == 0)
+            return 0;
+        j--;
+
+        if (level < last) {
+            index = index * fanout + j;
+            continue;
+        }
+
+        if (exact && (node[j] != key))
+            return 0;
+        if (found != NULL)
+            *found = node[j];
+        if (value != NULL)
+            memcpy(value, (const uint8_t *)node + records * 4U + j * tree->hdr.value_size,
+                   tree->hdr.value_size);
+    }
+    return 1;
+}
+
+int ylib_sbtree_open(struct ylib_sbtree *tree, ylib_sbtree_read_t read, void *ctx, uint32_t base,
+                     void *pin, uint32_t pin_size)
+{
+    struct ylib_sbtree_header *hdr = &tree->hdr;
+    uint32_t nodes[YLIB_SBTREE_LEVELS_MAX];
+    uint32_t levels = 0;
+    uint32_t pages;
+    uint32_t n;
+    uint32_t i;
+
+    memset(tree, 0, sizeof(*tree));
+    tree->read = read;
+    tree->ctx = ctx;
+    tree->base = base;
+
+    if ((read == NULL) || (read(ctx, base, hdr, sizeof(*hdr)) != 0))
+        return -1;
+    if ((hdr->magic != YLIB_SBTREE_MAGIC) ||
+        (hdr->header_crc != ylib_crc32(YLIB_CRC32_INIT, hdr, SBTREE_HEADER_CRC_LEN)))
+        return -1;
+    if ((hdr->page_size < 16U) || (hdr->page_size > YLIB_SBTREE_PAGE_MAX) ||
+        ((hdr->page_size & (hdr->page_size - 1U)) != 0) || (hdr->value_size == 0) ||
+        (sbtree_leaf_records(tree) == 0) || (hdr->count == 0) ||
+        (hdr->levels == 0) || (hdr->levels > YLIB_SBTREE_LEVELS_MAX))
+        return -1;
+
+    // 从叶子层向上算各层节点数，层数须与头部一致
+    n = (hdr->count + sbtree_leaf_records(tree) - 1U) / sbtree_leaf_records(tree);
+    for (;;) {
+        if (levels >= hdr->levels)
+            return -1;
+        nodes[levels++] = n;
+        if (n == 1U)
+            break;
+        n = (n + hdr->page_size / 4U - 1U) / (hdr->page_size / 4U);
+    }
+    if (levels != hdr->levels)
+        return -1;
+
+    pages = 1;
+    for (i = 0; i < levels; i++) {
+        tree->nodes[i] = nodes[levels - 1U - i];
+        tree->first[i] = pages;
+        pages += tree->nodes[i];
+    }
+
+    // 整层放得下的上层常驻RAM，连续的页一次读入
+    if (pin != NULL) {
+        pages = 0;
+        while ((tree->pinned < levels) &&
+               ((pages + tree->nodes[tree->pinned]) * hdr->page_size <= pin_size))
+            pages += tree->nodes[tree->pinned++];
+        if ((pages != 0) && (read(ctx, sbtree_page_addr(tree, 1), pin, pages * hdr->page_size) != 0)) {
+            tree->pinned = 0;
+            return -1;
+        }
+        tree->pin = (uint32_t *)pin;
+    }
+    return 0;
+}
+
+int ylib_sbtree_verify(struct ylib_sbtree *tree)
+{
+    uint32_t crc = YLIB_CRC32_INIT;
+    uint32_t last = tree->hdr.levels - 1U;
+    uint32_t pages = tree->first[last] + tree->nodes[last];
+    uint32_t page;
+
+    for (page = 1; page < pages; page++) {
+        if (tree->read(tree->ctx, sbtree_page_addr(tree, page), tree->page, tree->hdr.page_size) != 0)
+            return -1;
+        crc = ylib_crc32(crc, tree->page, tree->hdr.page_size);
+    }
+    return (crc == tree->hdr.image_crc) ? 0 : -1;
+}
+
+int ylib_sbtree_find(struct ylib_sbtree *tree, uint32_t key, void *value)
+{
+    return sbtree_search(tree, key, 1, NULL, value);
+}
+
+int ylib_sbtree_floor(struct ylib_sbtree *tree, uint32_t key, uint32_t *found, void *value)
+{
+    return sbtree_search(tree, key, 0, found, value);
+}
@@ -0,0 +1,176 @@
+/**
+ ******************************************************************************
+ * @file       yLib_timer.c
+ * @brief      分层定时轮实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       按到期节拍与now的差值选层：第0层直接按到期节拍的低位选槽，第l层按对应位段选槽；
+ *             now的低位回到0时把上层当前槽的定时器重新加入，它们会落到更低的层
+ ******************************************************************************
+ */
+
+#include "yLib_timer.h"
+
+/* 第l层的起始位 */
+#define YLIB_TIMER_SHIFT(l) (YLIB_TIMER_ROOT_BITS + (l) * YLIB_TIMER_LEVEL_BITS)
+
+/* 定时轮可表示的最大节拍差 */
+#define YLIB_TIMER_MAX_DELTA ((1UL << YLIB_TIMER_SHIFT(YLIB_TIMER_LEVELS)) - 1)
+
+_Static_assert(YLIB_TIMER_SHIFT(YLIB_TIMER_LEVELS) < 32, "timer wheel levels exceed 32 bits");
+
+/**
+ * @brief 按到期节拍把定时器放入对应槽
+ */
+static void ylib_timer_wheel_place(struct ylib_timer_wheel *wheel, struct ylib_timer *timer)
+{
+    uint32_t expires = timer->expires;
+    uint32_t delta = expires - wheel->now;
+    struct ylib_list_head *slot;
+    unsigned int l;
+
+    if ((int32_t)delta < 0)
+    {
+        /* 已过期：放入当前槽，下一个节拍处理 */
+        slot = &wheel->root[wheel->now & (YLIB_TIMER_ROOT_SIZE - 1)];
+    }
+    else if (delta < YLIB_TIMER_ROOT_SIZE)
+    {
+        slot = &wheel->root[expires & (YLIB_TIMER_ROOT_SIZE - 1)];
+    }
+    else
+    {
+        /* 超出范围的放在最高层最远处，搬下来时再按剩余时间重排 */
+        if (delta > YLIB_TIMER_MAX_DELTA)
+            expires = wheel->now + YLIB_TIMER_MAX_DELTA;
+        for (l = 0; l < YLIB_TIMER_LEVELS - 1; l++)
+        {
+            if ((expires - wheel->now) < (1UL << YLIB_TIMER_SHIFT(l + 1)))
+                break;
+        }
+        slot = &wheel->level[l][(expires >> YLIB_TIMER_SHIFT(l)) & (YLIB_TIMER_LEVEL_SIZE - 1)];
+    }
+    ylib_list_add_tail(&timer->node, slot);
+}
+
+/**
+ * @brief 把第l层index槽的定时器重新加入
+ * @return index，为0说明该层也转满了一圈
+ */
+static unsigned int ylib_timer_wheel_cascade(struct ylib_timer_wheel *wheel, unsigned int l, unsigned int index)
+{
+    struct ylib_list_head list;
+    struct ylib_timer *timer, *n;
+
+    YLIB_INIT_LIST_HEAD(&list);
+    ylib_list_splice_tail_init(&wheel->level[l][index], &list);
+    ylib_list_for_each_entry_safe(timer, n, &list, node)
+    {
+        ylib_timer_wheel_place(wheel, timer);
+    }
+    return index;
+}
+
+void ylib_timer_wheel_init(struct ylib_timer_wheel *wheel, uint32_t now)
+{
+    unsigned int i, l;
+
+    wheel->now = now;
+    for (i = 0; i < YLIB_TIMER_ROOT_SIZE; i++)
+        YLIB_INIT_LIST_HEAD(&wheel->root[i]);
+    for (l = 0; l < YLIB_TIMER_LEVELS; l++)
+    {
+        for (i = 0; i < YLIB_TIMER_LEVEL_SIZE; i++)
+            YLIB_INIT_LIST_HEAD(&wheel->level[l][i]);
+    }
+    YLIB_INIT_LIST_HEAD(&wheel->expired);
+}
+
+void ylib_timer_wheel_add(struct ylib_timer_wheel *wheel, struct ylib_timer *timer, uint32_t expires)
+{
+    if (ylib_timer_pending(timer))
+        ylib_list_del(&timer->node);
+    timer->expires = expires;
+    ylib_timer_wheel_place(wheel, timer);
+}
+
+int ylib_timer_wheel_del(struct ylib_timer *timer)
+{
+    if (!ylib_timer_pending(timer))
+        return 0;
+    ylib_list_del_init(&timer->node);
+    return 1;
+}
+
+void ylib_timer_wheel_advance(struct ylib_timer_wheel *wheel, uint32_t now)
+{
+    unsigned int index;
+    unsigned int l;
+
+    while ((int32_t)(now - wheel->now) >= 0)
+    {
+        index = wheel->now & (YLIB_TIMER_ROOT_SIZE - 1);
+
+        /* 第0层转满一圈，逐层向下搬移 */
+        if (index == 0)
+        {
+            for (l = 0; l < YLIB_TIMER_LEVELS; l++)
+            {
+                if (ylib_timer_wheel_cascade(wheel, l, (wheel->now >> YLIB_TIMER_SHIFT(l)) & (YLIB_TIMER_LEVEL_SIZE - 1)) != 0)
+                    break;
+            }
+        }
+
+        wheel->now++;
+        ylib_list_splice_tail_init(&wheel->root[index], &wheel->expired);
+    }
+}
+
+struct ylib_timer *ylib_timer_wheel_expired(struct ylib_timer_wheel *wheel)
+{
+    struct ylib_timer *timer;
+
+    if (ylib_list_empty(&wheel->expired))
+        return NULL;
+
+    timer = ylib_list_first_entry(&wheel->expired, struct ylib_timer, node);
+    ylib_list_del_init(&timer->node);
+    if (timer->period != 0)
+        ylib_timer_wheel_add(wheel, timer, timer->expires + timer->period);
+    return timer;
+}
+
+uint32_t ylib_timer_wheel_idle(const struct ylib_timer_wheel *wheel)
+{
+    unsigned int index;
+    unsigned int i, l;
+    uint32_t ticks;
+    int upper = 0;
+
+    if (!ylib_list_empty(&wheel->expired))
+        return 0;
+
+    for (l = 0; (l < YLIB_TIMER_LEVELS) && !upper; l++)
+    {
+        for (i = 0; i < YLIB_TIMER_LEVEL_SIZE; i++)
+        {
+            if (!ylib_list_empty(&wheel->level[l][i]))
+            {
+                upper = 1;
+                break;
+            }
+        }
+    }
+
+    /* 上层有定时器时第0层回到0的节拍要搬移，否则扫完一圈为空即整个定时轮为空 */
+    for (ticks = 0; ticks < YLIB_TIMER_ROOT_SIZE; ticks++)
+    {
+        index = (wheel->now + ticks) & (YLIB_TIMER_ROOT_SIZE - 1);
+        if ((index == 0) && upper)
+            return ticks;
+        if (!ylib_list_empty(&wheel->root[index]))
+            return ticks;
+    }
+    return YLIB_TIMER_IDLE_FOREVER;
+}
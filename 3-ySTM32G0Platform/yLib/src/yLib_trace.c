@@ -0,0 +1,143 @@
+/**
+ ******************************************************************************
+ * @file       yLib_trace.c
+ * @brief      二进制事件跟踪记录实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       写入前先算好本次需要的条数(丢失计数、绝对时间、事件)，空间不够时整体丢弃，
+ *             不会留下只有时间没有事件的半截记录
+ ******************************************************************************
+ */
+
+#include "yLib_trace.h"
+#include "yLib_ring.h"
+
+YLIB_RING_DEFINE(ylib_trace_ring, struct ylib_trace_rec, YLIB_TRACE_RECORDS);
+
+volatile uint32_t ylib_trace_mask;
+
+static uint32_t (*ylib_trace_now)(void);
+static uint32_t ylib_trace_hz;
+static uint32_t ylib_trace_last;    /* 上一条记录的时间戳 */
+static uint32_t ylib_trace_lost;    /* 尚未写入LOST记录的丢弃条数 */
+static uint32_t ylib_trace_dropcnt; /* 丢弃总数 */
+
+void ylib_trace_record(unsigned int event, uint32_t arg)
+{
+    struct ylib_trace_rec rec;
+    uint32_t state;
+    uint32_t now;
+    uint32_t delta;
+    unsigned int need;
+
+    YLIB_TRACE_LOCK(state);
+    if (!(ylib_trace_mask & YLIB_TRACE_MASK(event))) {
+        /* 判断和加锁之间被停止 */
+        YLIB_TRACE_UNLOCK(state);
+        return;
+    }
+
+    now = ylib_trace_now();
+    delta = now - ylib_trace_last;
+    need = 1U + (ylib_trace_lost ? 1U : 0U) + ((delta > 0xFFFFU) ? 1U : 0U);
+    if (YLIB_TRACE_RECORDS - (ylib_trace_ring.tail - ylib_trace_ring.head) < need) {
+        ylib_trace_lost++;
+        ylib_trace_dropcnt++;
+        YLIB_TRACE_UNLOCK(state);
+        return;
+    }
+
+    if (ylib_trace_lost) {
+        rec.delta = 0;
+        rec.event = YLIB_TRACE_EV_LOST;
+        rec.arg = ylib_trace_lost;
+        ylib_trace_ring_put(rec);
+        ylib_trace_lost = 0;
+    }
+    if (delta > 0xFFFFU) {
+        rec.delta = 0;
+        rec.event = YLIB_TRACE_EV_TIME;
+        rec.arg = now;
+        ylib_trace_ring_put(rec);
+        delta = 0;
+    }
+    rec.delta = (uint16_t)delta;
+    rec.event = (uint16_t)event;
+    rec.arg = arg;
+    ylib_trace_ring_put(rec);
+    ylib_trace_last = now;
+    YLIB_TRACE_UNLOCK(state);
+}
+
+void ylib_trace_register_clock(uint32_t (*now)(void), uint32_t hz)
+{
+    ylib_trace_stop();
+    ylib_trace_now = now;
+    ylib_trace_hz = (now != NULL) ? hz : 0;
+}
+
+uint32_t ylib_trace_clock_hz(void)
+{
+    return ylib_trace_hz;
+}
+
+int ylib_trace_start(uint32_t mask)
+{
+    uint32_t state;
+
+    if (ylib_trace_now == NULL)
+        return -1;
+
+    /* 让时间差必然溢出，开始后的第一条记录前自动插入绝对时间，解码器从这里开始累加 */
+    YLIB_TRACE_LOCK(state);
+    ylib_trace_last = ylib_trace_now() - 0x10000U;
+    ylib_trace_mask = mask;
+    YLIB_TRACE_UNLOCK(state);
+    return 0;
+}
+
+void ylib_trace_stop(void)
+{
+    ylib_trace_mask = 0;
+}
+
+void ylib_trace_clear(void)
+{
+    uint32_t state;
+
+    YLIB_TRACE_LOCK(state);
+    ylib_ring_reset(&ylib_trace_ring);
+    ylib_trace_lost = 0;
+    ylib_trace_dropcnt = 0;
+    YLIB_TRACE_UNLOCK(state);
+}
+
+unsigned int ylib_trace_read(struct ylib_trace_rec *recs, unsigned int n)
+{
+    return ylib_ring_dequeue_bulk(&ylib_trace_ring, recs, n, sizeof(*recs));
+}
+
+unsigned int ylib_trace_peek_tail(struct ylib_trace_rec *recs, unsigned int n)
+{
+    unsigned int count = ylib_ring_count(&ylib_trace_ring);
+    unsigned int i;
+
+    if (n > count)
+        n = count;
+    for (i = 0; i < n; i++) {
+        if (!ylib_ring_peek_at(&ylib_trace_ring, count - n + i, &recs[i], sizeof(*recs)))
+            break;
+    }
+    return i;
+}
+
+unsigned int ylib_trace_count(void)
+{
+    return ylib_ring_count(&ylib_trace_ring);
+}
+
+uint32_t ylib_trace_dropped(void)
+{
+    return ylib_trace_dropcnt;
+}
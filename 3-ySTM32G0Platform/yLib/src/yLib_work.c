@@ -0,0 +1,63 @@
+/**
+ ******************************************************************************
+ * @file       yLib_work.c
+ * @brief      中断下半部工作队列实现
+ * @author     Ryan
+ * @version    V2.0.0
+ * @date       2025/06/16
+ * @note       入队和出队都是常数时间的链表操作，中断中的提交只多出几条指令
+ ******************************************************************************
+ */
+
+#include "yLib_work.h"
+
+void ylib_work_queue_init(struct ylib_work_queue *queue)
+{
+    YLIB_INIT_LIST_HEAD(&queue->list);
+    queue->posts = 0;
+    queue->merged = 0;
+    queue->runs = 0;
+    queue->depth = 0;
+    queue->max_depth = 0;
+}
+
+int ylib_work_queue_add(struct ylib_work_queue *queue, struct ylib_work *work)
+{
+    int was_empty;
+
+    if (ylib_work_pending(work)) {
+        queue->merged++;
+        return -1;
+    }
+
+    was_empty = ylib_list_empty(&queue->list);
+    ylib_list_add_tail(&work->node, &queue->list);
+    queue->posts++;
+    if (++queue->depth > queue->max_depth)
+        queue->max_depth = queue->depth;
+    return was_empty;
+}
+
+struct ylib_work *ylib_work_queue_take(struct ylib_work_queue *queue)
+{
+    struct ylib_work *work;
+
+    if (ylib_list_empty(&queue->list))
+        return NULL;
+
+    work = ylib_list_first_entry(&queue->list, struct ylib_work, node);
+    ylib_list_del_init(&work->node);
+    queue->depth--;
+    queue->runs++;
+    return work;
+}
+
+int ylib_work_queue_del(struct ylib_work_queue *queue, struct ylib_work *work)
+{
+    if (!ylib_work_pending(work))
+        return 0;
+
+    ylib_list_del_init(&work->node);
+    queue->depth--;
+    return 1;
+}
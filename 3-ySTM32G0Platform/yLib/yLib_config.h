@@ -62,6 +62,16 @@ extern "C"
 #define DBG_EXIT() ((void)0)
 #endif
 
+/**
+ * @brief 热路径函数放入RAM执行
+ * @note 1=YLIB_RAMFUNC标注的函数放入.RamFunc段，启动时随.data从Flash拷贝到RAM；
+ *       64MHz下Flash有2个等待周期，中断入口和内层循环的周期数因此不再随取指命中与否波动；
+ *       0=全部留在Flash，可由构建选项YLIB_RAMFUNC_ENABLE关闭以节省RAM
+ */
+#ifndef YLIB_RAMFUNC_ENABLE
+#define YLIB_RAMFUNC_ENABLE 1
+#endif
+
 /**
  * @brief 断言配置
  */
@@ -87,13 +97,46 @@ extern "C"
  * =============================================================================
  */
 
+/**
+ * @brief 堆区来源配置
+ * @note 1=使用链接脚本在.bss之后划出的__ylib_heap_start/__ylib_heap_end，RAM剩余多少堆就有多少；
+ *       0=使用YLIB_TOTAL_HEAP_SIZE大小的静态数组
+ */
+#ifndef YLIB_HEAP_USE_LINKER_ARENA
+#define YLIB_HEAP_USE_LINKER_ARENA (1) /* 默认使用链接脚本堆区 */
+#endif
+
 /**
  * @brief 堆总大小配置
+ * @note 仅YLIB_HEAP_USE_LINKER_ARENA为0时有效
  */
 #ifndef YLIB_TOTAL_HEAP_SIZE
 #define YLIB_TOTAL_HEAP_SIZE (32 * 1024) /* 默认堆大小32KB */
 #endif
 
+/**
+ * @brief 堆操作临界区
+ * @note 默认保存PRIMASK后关中断，任务和中断中都可以分配释放；首次适配时关中断时间随空闲块数增长，
+ *       对中断延迟敏感时选用TLSF
+ */
+#ifndef YLIB_HEAP_LOCK
+#if defined(__arm__)
+#define YLIB_HEAP_LOCK(state) __asm volatile("mrs %0, primask\n\tcpsid i" : "=r"(state) : : "memory")
+#define YLIB_HEAP_UNLOCK(state) __asm volatile("msr primask, %0" : : "r"(state) : "memory")
+#else
+#define YLIB_HEAP_LOCK(state) ((state) = 0)
+#define YLIB_HEAP_UNLOCK(state) ((void)(state))
+#endif
+#endif
+
+/**
+ * @brief 按分配者统计的编号数量
+ * @note 每个块头记录分配者编号，统计中给出各编号的当前和历史最大占用；0表示关闭
+ */
+#ifndef configHEAP_OWNER_MAX
+#define configHEAP_OWNER_MAX (4) /* 默认4个分配者 */
+#endif
+
 /**
  * @brief 最小块大小配置
  */
@@ -122,6 +165,56 @@ extern "C"
 #define configHEAP_CHECK_ENABLE (1) /* 启用堆检查 */
 #endif
 
+/**
+ * @brief 堆块尾部哨兵配置
+ * @note 每个已分配块末尾多占4字节写入与块地址相关的哨兵，释放和后台巡检时校验，
+ *       越界写在破坏下一块块头之前即可发现；需要configHEAP_CHECK_ENABLE
+ */
+#ifndef configHEAP_GUARD_ENABLE
+#define configHEAP_GUARD_ENABLE (0) /* 默认关闭 */
+#endif
+
+/**
+ * @brief 初始化后禁止分配
+ * @note 1=ylib_heap_seal()之后任何分配(含realloc扩大、calloc和pvPortMalloc)都进入ylib_heap_seal_trap()，
+ *       记录调用者后停机；释放仍然允许。用于证明运行期没有分配，运行期对象改用各模块的静态构造接口
+ */
+#ifndef YLIB_NO_HEAP_AFTER_INIT
+#define YLIB_NO_HEAP_AFTER_INIT (0) /* 默认关闭 */
+#endif
+
+/**
+ * @brief 后台巡检每次检查的块数
+ * @note 空闲任务钩子每次调用检查的堆块或内存分区空闲块数量，决定单次关中断之外的总耗时；0表示不巡检
+ */
+#ifndef YLIB_HEAP_SCRUB_BUDGET
+#define YLIB_HEAP_SCRUB_BUDGET (4) /* 每次4块 */
+#endif
+
+/**
+ * @brief 堆分配算法配置
+ * @note 0=按地址排序的首次适配链表；1=TLSF两级分离适配，分配和释放为常数时间并立即合并相邻空闲块
+ */
+#ifndef configHEAP_USE_TLSF
+#define configHEAP_USE_TLSF (0) /* 默认首次适配 */
+#endif
+
+/**
+ * @brief TLSF二级索引位数
+ * @note 每个2的幂区间再等分为2^N个链表，N越大内部碎片越小，索引表越大
+ */
+#ifndef configHEAP_TLSF_SL_LOG2
+#define configHEAP_TLSF_SL_LOG2 (3) /* 每级8个链表 */
+#endif
+
+/**
+ * @brief TLSF一级索引最高位
+ * @note 单个空闲块最大不超过2^(N+1)字节，更大的堆按该上限截断
+ */
+#ifndef configHEAP_TLSF_FL_MAX
+#define configHEAP_TLSF_FL_MAX (20) /* 单块最大2MB */
+#endif
+
 /* =============================================================================
  * 内存池管理器配置 (yLib_mempool)
  * =============================================================================
@@ -141,6 +234,91 @@ extern "C"
 #define YLIB_MEM_NAME_SIZE 16u /* 内存分区名称最大长度 */
 #endif
 
+/**
+ * @brief 内存分区临界区
+ * @note 默认与堆相同，保存PRIMASK后关中断；临界区内只做链表头操作，任务和中断可共用同一分区
+ */
+#ifndef YLIB_MEM_LOCK
+#define YLIB_MEM_LOCK(state) YLIB_HEAP_LOCK(state)
+#define YLIB_MEM_UNLOCK(state) YLIB_HEAP_UNLOCK(state)
+#endif
+
+/* =============================================================================
+ * 零拷贝缓冲区配置 (yLib_pbuf)
+ * =============================================================================
+ */
+
+/**
+ * @brief 每块的数据容量(字节)，含头部空间，须为4的倍数
+ */
+#ifndef YLIB_PBUF_SIZE
+#define YLIB_PBUF_SIZE 160
+#endif
+
+/**
+ * @brief 内存池块数，所有使用者共用
+ */
+#ifndef YLIB_PBUF_COUNT
+#define YLIB_PBUF_COUNT 6
+#endif
+
+/**
+ * @brief 引用计数临界区
+ * @note 默认与堆相同，任务和中断可同时增减同一缓冲区的引用
+ */
+#ifndef YLIB_PBUF_LOCK
+#define YLIB_PBUF_LOCK(state) YLIB_HEAP_LOCK(state)
+#define YLIB_PBUF_UNLOCK(state) YLIB_HEAP_UNLOCK(state)
+#endif
+
+/* =============================================================================
+ * 内存操作配置 (yLib_memops)
+ * =============================================================================
+ */
+
+/**
+ * @brief 内存复制/填充/比较函数放入RAM
+ * @note 1=放入.RamFunc段，避开Flash等待周期；G070在64MHz下Flash有2个等待周期，取指占循环的大部分
+ */
+#ifndef YLIB_MEMOPS_RAM
+#define YLIB_MEMOPS_RAM 1
+#endif
+
+/**
+ * @brief 以ylib_memcpy/memset/memcmp替换C库的同名函数
+ * @note 1=定义memcpy、memset、memcmp强符号，链接时不再取newlib-nano的逐字节实现，
+ *       编译器生成的结构体复制等隐式调用也一并替换
+ */
+#ifndef YLIB_MEMOPS_OVERRIDE_LIBC
+#define YLIB_MEMOPS_OVERRIDE_LIBC 0
+#endif
+
+/* =============================================================================
+ * 线性分配器配置 (yLib_arena)
+ * =============================================================================
+ */
+
+/**
+ * @brief 任务线性分配器所用的FreeRTOS线程本地存储指针索引
+ * @note 须小于configNUM_THREAD_LOCAL_STORAGE_POINTERS，否则ylib_arena_task始终返回NULL
+ */
+#ifndef YLIB_ARENA_TLS_INDEX
+#define YLIB_ARENA_TLS_INDEX 0
+#endif
+
+/* =============================================================================
+ * CRC校验配置 (yLib_crc)
+ * =============================================================================
+ */
+
+/**
+ * @brief 交给硬件后端的最短数据长度(字节)
+ * @note 硬件每次调用要重写多项式、初始值和控制寄存器并进出临界区，更短的数据查表更快
+ */
+#ifndef YLIB_CRC_HW_MIN
+#define YLIB_CRC_HW_MIN 16
+#endif
+
 /* =============================================================================
  * FIFO队列配置 (yLib_fifo)
  * =============================================================================
@@ -173,10 +351,169 @@ extern "C"
 #endif
 
 /**
- * @brief 环形缓冲区是否启用原子操作
+ * @brief 环形缓冲区发布/获取屏障
+ * @note 生产者写完数据后、更新tail前，消费者读到tail后、读数据前各执行一次；
+ *       单核M0+上编译器屏障已足够，DMB额外保证DMA等其他总线主设备看到的顺序，只需几个周期
+ */
+#ifndef YLIB_RING_BARRIER
+#if defined(__arm__)
+#define YLIB_RING_BARRIER() __asm volatile("dmb" : : : "memory")
+#else
+#define YLIB_RING_BARRIER() __sync_synchronize()
+#endif
+#endif
+
+/**
+ * @brief 环形缓冲区多生产者/多消费者临界区
+ * @note M0+没有LDREX/STREX，多生产者或多消费者时用关中断代替比较交换
+ */
+#ifndef YLIB_RING_LOCK
+#define YLIB_RING_LOCK(state) YLIB_HEAP_LOCK(state)
+#define YLIB_RING_UNLOCK(state) YLIB_HEAP_UNLOCK(state)
+#endif
+
+/**
+ * @brief 静态定义的环形缓冲区/FIFO存储对齐
+ * @note M0+没有数据缓存，按字对齐即可让DMA按字搬运、元素按字存取；带缓存的内核可改为缓存行大小
+ */
+#ifndef YLIB_RING_ALIGN
+#define YLIB_RING_ALIGN 4
+#endif
+
+/* =============================================================================
+ * 定点数学配置 (yLib_dsp)
+ * =============================================================================
+ */
+
+/**
+ * @brief FIR/IIR滤波函数放入RAM
+ * @note 1=放入.RamFunc段，每个样本的周期数固定，不受Flash等待周期影响
+ */
+#ifndef YLIB_DSP_RAM
+#define YLIB_DSP_RAM 1
+#endif
+
+/* =============================================================================
+ * 位图配置 (yLib_bitmap)
+ * =============================================================================
+ */
+
+/**
+ * @brief 位图原子操作临界区
+ * @note M0+没有LDREX/STREX，读改写用关中断保护；单个位操作只有几条指令
+ */
+#ifndef YLIB_BITMAP_LOCK
+#define YLIB_BITMAP_LOCK(state) YLIB_HEAP_LOCK(state)
+#define YLIB_BITMAP_UNLOCK(state) YLIB_HEAP_UNLOCK(state)
+#endif
+
+/* =============================================================================
+ * 跟踪记录配置 (yLib_trace)
+ * =============================================================================
+ */
+
+/**
+ * @brief 是否编译跟踪钩子
+ * @note 0时YLIB_TRACE展开为空；1时未开始记录的钩子只有一次掩码判断
+ */
+#ifndef YLIB_TRACE_ENABLE
+#define YLIB_TRACE_ENABLE 1
+#endif
+
+/**
+ * @brief 跟踪记录环的条目数(2的幂)，每条8字节
+ */
+#ifndef YLIB_TRACE_RECORDS
+#define YLIB_TRACE_RECORDS 256
+#endif
+
+/**
+ * @brief 跟踪记录临界区
+ * @note 任务切换、中断和任务都会写入，时间戳和入队须在同一临界区内保证顺序
+ */
+#ifndef YLIB_TRACE_LOCK
+#define YLIB_TRACE_LOCK(state) YLIB_HEAP_LOCK(state)
+#define YLIB_TRACE_UNLOCK(state) YLIB_HEAP_UNLOCK(state)
+#endif
+
+/* =============================================================================
+ * 二进制日志配置 (yLib_log)
+ * =============================================================================
+ */
+
+/**
+ * @brief 是否编译日志调用
+ * @note 0时YLIB_LOG展开为空，格式串也不进入固件
+ */
+#ifndef YLIB_LOG_ENABLE
+#define YLIB_LOG_ENABLE 1
+#endif
+
+/**
+ * @brief 编译期级别门限，低于它的YLIB_LOG连同格式串一起去掉
+ */
+#ifndef YLIB_LOG_LEVEL_MIN
+#define YLIB_LOG_LEVEL_MIN 0
+#endif
+
+/**
+ * @brief 日志字环的字数(2的幂)，每条记录2~6个字
+ */
+#ifndef YLIB_LOG_WORDS
+#define YLIB_LOG_WORDS 256
+#endif
+
+/**
+ * @brief 日志写入临界区
+ * @note 任务和中断都会写入，时间戳和整条记录的写入在同一临界区内，读出方看到的时间戳单调
+ */
+#ifndef YLIB_LOG_LOCK
+#define YLIB_LOG_LOCK(state) YLIB_HEAP_LOCK(state)
+#define YLIB_LOG_UNLOCK(state) YLIB_HEAP_UNLOCK(state)
+#endif
+
+/* =============================================================================
+ * 周期计时基准测试配置 (yLib_bench)
+ * =============================================================================
+ */
+
+/**
+ * @brief 每项测试的默认采样次数
+ * @note 每次采样的周期数存在调用者栈上，取奇数时中位数即中间一个样本
+ */
+#ifndef YLIB_BENCH_SAMPLES
+#define YLIB_BENCH_SAMPLES 31
+#endif
+
+/**
+ * @brief 单次采样期间的临界区
+ * @note 关中断后计时，结果不含其他中断和任务切换；测试体内可以短暂开中断测量中断开销
  */
-#ifndef YLIB_RING_ATOMIC_OPS
-#define YLIB_RING_ATOMIC_OPS 0 /* 0=不启用, 1=启用原子操作 */
+#ifndef YLIB_BENCH_LOCK
+#define YLIB_BENCH_LOCK(state) YLIB_HEAP_LOCK(state)
+#define YLIB_BENCH_UNLOCK(state) YLIB_HEAP_UNLOCK(state)
+#endif
+
+/* =============================================================================
+ * 耗时探针配置 (yLib_probe)
+ * =============================================================================
+ */
+
+/**
+ * @brief 是否编译耗时探针
+ * @note 0时YLIB_PROBE_xxx展开为空，探针变量和名称都不进入固件
+ */
+#ifndef YLIB_PROBE_ENABLE
+#define YLIB_PROBE_ENABLE 1
+#endif
+
+/**
+ * @brief 探针记录临界区
+ * @note 中断和任务都会记录，四个字段(含64位总和)须一起更新
+ */
+#ifndef YLIB_PROBE_LOCK
+#define YLIB_PROBE_LOCK(state) YLIB_HEAP_LOCK(state)
+#define YLIB_PROBE_UNLOCK(state) YLIB_HEAP_UNLOCK(state)
 #endif
 
 /* =============================================================================
@@ -198,6 +535,114 @@ extern "C"
 #define YLIB_RBTREE_VERIFY_ENABLE 1 /* 启用红黑树验证 */
 #endif
 
+/* =============================================================================
+ * 哈希表配置 (yLib_hash)
+ * =============================================================================
+ */
+
+/**
+ * @brief 哈希表最大装载率(百分比)
+ * @note 线性探测+Robin Hood在80%以内平均探测长度仍在2次左右；超过时堆存储的表扩容一倍，静态存储的表插入失败
+ */
+#ifndef YLIB_HASH_LOAD_PERCENT
+#define YLIB_HASH_LOAD_PERCENT 75
+#endif
+
+/**
+ * @brief 堆存储哈希表的最小槽位数
+ */
+#ifndef YLIB_HASH_MIN_SIZE
+#define YLIB_HASH_MIN_SIZE 8
+#endif
+
+/* =============================================================================
+ * 静态B树索引配置 (yLib_sbtree)
+ * =============================================================================
+ */
+
+/**
+ * @brief 节点页的最大字节数
+ * @note 查找时按页读入句柄内的缓冲区，默认与25Q的编程页相同
+ */
+#ifndef YLIB_SBTREE_PAGE_MAX
+#define YLIB_SBTREE_PAGE_MAX 256
+#endif
+
+/**
+ * @brief 最多层数(含叶子层)
+ * @note 256字节页、4字节值时第一层以下每层扇出64，4层可索引约800万条记录
+ */
+#ifndef YLIB_SBTREE_LEVELS_MAX
+#define YLIB_SBTREE_LEVELS_MAX 4
+#endif
+
+/* =============================================================================
+ * LZ压缩配置 (yLib_lz)
+ * =============================================================================
+ */
+
+/**
+ * @brief 压缩时向前搜索匹配的最大距离
+ * @note 不超过格式规定的窗口1024字节；减小可加快压缩，压缩率随之下降，解压不受影响
+ */
+#ifndef YLIB_LZ_SEARCH_MAX
+#define YLIB_LZ_SEARCH_MAX 1024
+#endif
+
+/* =============================================================================
+ * 定时轮配置 (yLib_timer)
+ * =============================================================================
+ */
+
+/**
+ * @brief 定时轮节拍(ms)
+ */
+#ifndef YLIB_TIMER_TICK_MS
+#define YLIB_TIMER_TICK_MS 10
+#endif
+
+/**
+ * @brief 定时轮层级
+ * @note 第0层2^ROOT_BITS个槽，其上LEVELS层各2^LEVEL_BITS个槽，每个槽8字节；
+ *       默认64+3*16个槽共896字节，覆盖2^18个节拍(10ms节拍约43分钟)，更远的超时在最高层反复重排
+ */
+#ifndef YLIB_TIMER_ROOT_BITS
+#define YLIB_TIMER_ROOT_BITS 6
+#endif
+#ifndef YLIB_TIMER_LEVEL_BITS
+#define YLIB_TIMER_LEVEL_BITS 4
+#endif
+#ifndef YLIB_TIMER_LEVELS
+#define YLIB_TIMER_LEVELS 3
+#endif
+
+/* =============================================================================
+ * 工作队列配置 (yLib_work)
+ * =============================================================================
+ */
+
+/**
+ * @brief 工作队列个数，每个队列一个工作任务，队列0优先级最高
+ */
+#ifndef YLIB_WORK_PRIOS
+#define YLIB_WORK_PRIOS 2
+#endif
+
+/**
+ * @brief 队列0工作任务的FreeRTOS优先级，队列i为该值减i
+ * @note 低于定时器服务任务，高于普通应用任务
+ */
+#ifndef YLIB_WORK_TASK_PRIO
+#define YLIB_WORK_TASK_PRIO 30
+#endif
+
+/**
+ * @brief 工作任务栈大小(字)
+ */
+#ifndef YLIB_WORK_STACK_SIZE
+#define YLIB_WORK_STACK_SIZE 256
+#endif
+
 /* =============================================================================
  * 链表配置 (yLib_list)
  * =============================================================================
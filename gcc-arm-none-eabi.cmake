@@ -32,6 +32,8 @@ set(CMAKE_CXX_COMPILER              ${TOOLCHAIN_PREFIX}g++${EXE_SUFFIX})      #
 set(CMAKE_LINKER                    ${TOOLCHAIN_PREFIX}g++${EXE_SUFFIX})      # 链接器
 set(CMAKE_OBJCOPY                   ${TOOLCHAIN_PREFIX}objcopy${EXE_SUFFIX}) # 目标文件转换工具
 set(CMAKE_SIZE                      ${TOOLCHAIN_PREFIX}size${EXE_SUFFIX})    # 文件大小分析工具
+set(CMAKE_AR                        ${TOOLCHAIN_PREFIX}gcc-ar${EXE_SUFFIX})  # 归档工具，gcc-ar能为LTO目标文件生成符号索引
+set(CMAKE_RANLIB                    ${TOOLCHAIN_PREFIX}gcc-ranlib${EXE_SUFFIX}) # 归档索引工具
 
 
 # ============================================================================
@@ -72,6 +74,14 @@ set(CMAKE_C_FLAGS_RELEASE "-Os -g0")        # 发布模式：大小优化，无
 set(CMAKE_CXX_FLAGS_DEBUG "-O0 -g3")        # C++ 调试模式
 set(CMAKE_CXX_FLAGS_RELEASE "-Os -g0")      # C++ 发布模式
 
+# 速度/大小兼顾模式：整体-Os并做链接时优化，热点模块在各自的CMakeLists中改为-O2；
+# GCC按函数记录编译时的优化级别，链接时优化不会把-O2模块重新按-Os生成。
+# -ffat-lto-objects让目标文件同时带机器码，构建后的堆栈分析仍能拿到.su(为非LTO结果，偏保守)
+set(CMAKE_C_FLAGS_RELEASEFAST "-Os -g0 -flto -ffat-lto-objects")
+set(CMAKE_CXX_FLAGS_RELEASEFAST "-Os -g0 -flto -ffat-lto-objects")
+set(CMAKE_ASM_FLAGS_RELEASEFAST "")
+set(CMAKE_EXE_LINKER_FLAGS_RELEASEFAST "-Os -flto")
+
 # ============================================================================
 # C++特定编译标志
 # ============================================================================
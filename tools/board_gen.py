@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""
+板级资源表生成
+
+从1-app/device/board.def生成board.h，设备配置中的外设编号、引脚、复用功能和DMA通道
+都取自生成的宏，格式见board.def的文件头。生成时检查:
+- 同一引脚被两个设备使用或落在保留引脚上
+- 同一外设被两个设备使用
+- 固定分配的DMA通道加上留给运行时自动分配的通道超过7个
+任何一项不满足时打印所有冲突并以非零状态退出，构建停止。
+DMA请求按优先级从通道1起分配(同优先级按描述顺序)，通道号小的在仲裁中优先。
+构建时由1-app/device/CMakeLists.txt调用，也可单独运行检查描述。
+
+用法:
+    board_gen.py board.def board.h
+    board_gen.py board.def --check
+"""
+
+import argparse
+import re
+import sys
+
+DMA_CHANNELS = 7
+DMA_PRIORITY = ("VERY_HIGH", "HIGH", "MEDIUM", "LOW")
+
+# G070的引脚：PA/PB/PC全部，PD0~9，PF0~3
+PORT_PINS = {"A": 16, "B": 16, "C": 16, "D": 10, "F": 4}
+
+ENTRY = re.compile(r"^(BOARD_\w+)\s*\((.*)\)\s*$")
+IDENT = re.compile(r"^[A-Za-z_]\w*$")
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", lambda m: "\n" * m.group(0).count("\n"), text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def parse_pin(name):
+    m = re.match(r"^P([A-Z])(\d+)$", name)
+    if not m or m.group(1) not in PORT_PINS or int(m.group(2)) >= PORT_PINS[m.group(1)]:
+        return None
+    return "YDRV_PIN%s%d" % (m.group(1), int(m.group(2)))
+
+
+class Board:
+    def __init__(self):
+        self.devices = []  # (name, periph, line)
+        self.pins = []  # (device, signal, pin, af, line)
+        self.dma = []  # (device, request, priority, line)
+        self.reserve = []  # (usage, pin, line)
+        self.spare = 0
+        self.spare_line = 1
+        self.errors = []
+
+    def error(self, path, line, msg):
+        self.errors.append("%s:%d: %s" % (path, line, msg))
+
+
+def parse(path):
+    board = Board()
+    with open(path, encoding="utf-8") as f:
+        lines = strip_comments(f.read()).split("\n")
+
+    known = set()
+    for no, text in enumerate(lines, 1):
+        text = text.strip()
+        if not text:
+            continue
+        m = ENTRY.match(text)
+        if not m:
+            board.error(path, no, "cannot parse '%s'" % text)
+            continue
+        kind = m.group(1)
+        args = [a.strip() for a in m.group(2).split(",")]
+        if not all(IDENT.match(a) or a.isdigit() for a in args):
+            board.error(path, no, "bad argument in '%s'" % text)
+            continue
+
+        if kind == "BOARD_DEVICE" and len(args) == 2:
+            if args[0] in known:
+                board.error(path, no, "device %s declared twice" % args[0])
+            known.add(args[0])
+            board.devices.append((args[0], args[1], no))
+        elif kind == "BOARD_PIN" and len(args) in (3, 4):
+            if args[0] not in known:
+                board.error(path, no, "pin of undeclared device %s" % args[0])
+            if parse_pin(args[2]) is None:
+                board.error(path, no, "no pin %s on this chip" % args[2])
+            af = args[3] if len(args) == 4 else None
+            if af is not None and af != "AUTO" and not (af.isdigit() and int(af) < 8):
+                board.error(path, no, "bad alternate function %s" % af)
+            board.pins.append((args[0], args[1], args[2], af, no))
+        elif kind == "BOARD_DMA" and len(args) == 3:
+            if args[0] not in known:
+                board.error(path, no, "dma of undeclared device %s" % args[0])
+            if args[2] not in DMA_PRIORITY:
+                board.error(path, no, "bad dma priority %s" % args[2])
+            board.dma.append((args[0], args[1], args[2], no))
+        elif kind == "BOARD_DMA_SPARE" and len(args) == 1 and args[0].isdigit():
+            board.spare = int(args[0])
+            board.spare_line = no
+        elif kind == "BOARD_RESERVE" and len(args) == 2:
+            if parse_pin(args[1]) is None:
+                board.error(path, no, "no pin %s on this chip" % args[1])
+            board.reserve.append((args[0], args[1], no))
+        else:
+            board.error(path, no, "bad entry '%s'" % text)
+    return board
+
+
+def check(board, path):
+    owner = {}
+    for usage, pin, no in board.reserve:
+        owner[pin] = "reserved for %s" % usage
+    for dev, signal, pin, af, no in board.pins:
+        user = "%s.%s" % (dev, signal)
+        if pin in owner:
+            board.error(path, no, "pin %s of %s already used by %s" % (pin, user, owner[pin]))
+        else:
+            owner[pin] = user
+
+    periphs = {}
+    for name, periph, no in board.devices:
+        if periph == "NONE":
+            continue
+        if periph in periphs:
+            board.error(path, no, "peripheral %s of %s already used by %s" % (periph, name, periphs[periph]))
+        else:
+            periphs[periph] = name
+
+    used = len(board.dma) + board.spare
+    if used > DMA_CHANNELS:
+        board.error(path, board.spare_line,
+                    "%d dma requests and %d spare exceed %d channels" % (len(board.dma), board.spare, DMA_CHANNELS))
+
+
+def assign_dma(board):
+    order = sorted(range(len(board.dma)), key=lambda i: (DMA_PRIORITY.index(board.dma[i][2]), i))
+    channel = {}
+    for n, i in enumerate(order):
+        channel[i] = n + 1
+    return [(board.dma[i][0], board.dma[i][1], board.dma[i][2], channel[i]) for i in range(len(board.dma))]
+
+
+def macro(*parts):
+    return "BOARD_" + "_".join(p.upper() for p in parts)
+
+
+def generate(board, source):
+    dma = assign_dma(board)
+    lines = []
+    lines.append("/* 由tools/board_gen.py从%s生成，不要手工修改 */" % source)
+    lines.append("")
+    lines.append("#ifndef BOARD_H")
+    lines.append("#define BOARD_H")
+
+    for name, periph, no in board.devices:
+        lines.append("")
+        lines.append("/* %s */" % name)
+        defs = [(macro(name, "NAME"), '"%s"' % name)]
+        if periph != "NONE":
+            defs.append((macro(name, "PERIPH"), "YDRV_" + periph))
+        for dev, signal, pin, af, _ in board.pins:
+            if dev != name:
+                continue
+            defs.append((macro(name, signal, "PIN"), parse_pin(pin)))
+            if af is not None:
+                defs.append((macro(name, signal, "AF"), "YDRV_GPIO_AF_AUTO" if af == "AUTO" else "(%sU)" % af))
+        for dev, request, prio, ch in dma:
+            if dev == name:
+                defs.append((macro(name, request, "DMA"), "YDRV_DMA1_CHANNEL%d" % ch))
+        width = max(len(d[0]) for d in defs)
+        for d in defs:
+            lines.append("#define %s %s" % (d[0].ljust(width), d[1]))
+
+    lines.append("")
+    lines.append("/* DMA通道分配，通道%d~%d留给运行时自动分配 */" % (len(dma) + 1, DMA_CHANNELS))
+    for dev, request, prio, ch in sorted(dma, key=lambda d: d[3]):
+        lines.append("/*   CH%d  %-12s %s */" % (ch, "%s.%s" % (dev, request), prio))
+    lines.append("#define BOARD_DMA_FIXED (%dU)" % len(dma))
+    lines.append("")
+    lines.append("#endif /* BOARD_H */")
+    lines.append("")
+    return "\n".join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="generate board resource header from board description")
+    ap.add_argument("board")
+    ap.add_argument("output", nargs="?")
+    ap.add_argument("--check", action="store_true", help="only check for conflicts")
+    args = ap.parse_args()
+
+    board = parse(args.board)
+    check(board, args.board)
+    if board.errors:
+        for e in board.errors:
+            print(e, file=sys.stderr)
+        return 1
+    if args.check:
+        return 0
+    if args.output is None:
+        ap.error("output required")
+
+    text = generate(board, args.board.replace("\\", "/").split("/")[-1])
+    with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
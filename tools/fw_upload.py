@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""
+固件升级上传
+
+把固件镜像(.bin)经帧协议发给设备(格式见1-app/task/inc/fwupdate.h)：先发FWUP_BEGIN并等待
+槽擦除完成，然后以滑动窗口连续发送FWUP_DATA，收到偏移不连续的回复时从设备给出的偏移重发，
+最后发FWUP_END等待校验和提交。--compress时用tools/lz.py压缩后发送，设备边收边解压，
+传输字节数一般降到镜像的60%~70%。需要pyserial。
+
+用法:
+    fw_upload.py /dev/ttyUSB0 build/Release/YLab_STM32G0_Template.bin
+    fw_upload.py COM5 app.bin --baud 921600 --version 0x00020001 --window 8 --compress
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+import lz
+from mem_decode import cobs_encode
+from trace_decode import crc16_ccitt_false, frames
+
+FWUP_FRAME_ID = 0x55
+FWUP_CHUNK = 120
+
+FWUP_BEGIN = 0
+FWUP_DATA = 1
+FWUP_END = 2
+FWUP_STATUS = 3
+
+FWUP_ERR_OK = 0
+FWUP_ERR_BUSY = 1
+FWUP_ERR_OFFSET = 2
+ERRORS = ("ok", "busy", "offset", "state", "size", "crc", "flash")
+
+FWUP_ERASING = 1
+
+
+def encode(payload):
+    body = bytes([FWUP_FRAME_ID]) + payload
+    return b"\x00" + cobs_encode(body + struct.pack("<H", crc16_ccitt_false(body))) + b"\x00"
+
+
+class Link:
+    """串口收发，回复按0x00分隔后解码；shell文本等其他输出被丢弃"""
+
+    def __init__(self, port):
+        self.port = port
+        self.pending = b""
+
+    def send(self, payload):
+        self.port.write(encode(payload))
+
+    def replies(self, timeout):
+        """返回超时前收到的(类型, 结果, 偏移, 槽, 状态)"""
+        end = time.monotonic() + timeout
+        result = []
+        while time.monotonic() < end and not result:
+            self.pending += self.port.read(self.port.in_waiting or 1)
+            cut = self.pending.rfind(b"\x00")
+            if cut < 0:
+                continue
+            raw, self.pending = self.pending[:cut + 1], self.pending[cut + 1:]
+            for fid, payload in frames(raw):
+                if fid == FWUP_FRAME_ID and len(payload) == 8:
+                    result.append((payload[0] & 0x7F, payload[1], struct.unpack_from("<I", payload, 2)[0],
+                                   payload[6], payload[7]))
+        return result
+
+    def request(self, payload, timeout=2.0):
+        self.send(payload)
+        for reply in self.replies(timeout):
+            if reply[0] == payload[0]:
+                return reply
+        raise RuntimeError("no reply to type %d" % payload[0])
+
+
+def upload(link, image, version, window, compress):
+    crc = zlib.crc32(image) & 0xFFFFFFFF
+    begin = struct.pack("<BIII", FWUP_BEGIN, len(image), crc, version)
+    stream = image
+    if compress:
+        stream = lz.compress(image)
+        begin += struct.pack("<I", len(stream))
+        sys.stderr.write("compressed %d -> %d bytes\n" % (len(image), len(stream)))
+    reply = link.request(begin)
+    if reply[1] != FWUP_ERR_OK:
+        raise RuntimeError("begin failed: %s" % ERRORS[reply[1]])
+    slot = "AB"[reply[3]]
+
+    # 槽擦除在后台进行
+    while link.request(bytes([FWUP_STATUS]))[4] == FWUP_ERASING:
+        time.sleep(0.05)
+
+    start = time.monotonic()
+    acked = 0
+    sent = 0
+    while acked < len(stream):
+        while sent < len(stream) and sent - acked < window * FWUP_CHUNK:
+            chunk = stream[sent:sent + FWUP_CHUNK]
+            link.send(struct.pack("<BI", FWUP_DATA, sent) + chunk)
+            sent += len(chunk)
+        replies = link.replies(1.0)
+        if not replies:
+            sent = acked  # 回复丢失，从确认处重发
+            continue
+        for _, err, offset, _, _ in replies:
+            if err == FWUP_ERR_OK:
+                acked = max(acked, offset)
+            elif err in (FWUP_ERR_BUSY, FWUP_ERR_OFFSET):
+                acked = offset
+                sent = offset
+            else:
+                raise RuntimeError("data failed at %d: %s" % (offset, ERRORS[err]))
+        sys.stderr.write("\r%d/%d" % (acked, len(stream)))
+    elapsed = time.monotonic() - start
+
+    reply = link.request(bytes([FWUP_END]), timeout=10.0)
+    if reply[1] != FWUP_ERR_OK:
+        raise RuntimeError("end failed: %s" % ERRORS[reply[1]])
+    sys.stderr.write("\nslot %s: %d bytes, crc 0x%08x, %.1f KB/s\n" %
+                     (slot, len(image), crc, len(image) / 1024.0 / max(elapsed, 1e-6)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="upload a firmware image over the frame protocol")
+    parser.add_argument("port", help="serial port")
+    parser.add_argument("image", help="firmware binary")
+    parser.add_argument("--baud", type=int, default=115200, help="baud rate")
+    parser.add_argument("--version", type=lambda s: int(s, 0), default=0, help="image version stored in the slot header")
+    parser.add_argument("--window", type=int, default=4, help="data frames in flight")
+    parser.add_argument("--compress", action="store_true", help="send the image lz-compressed")
+    args = parser.parse_args()
+
+    try:
+        import serial
+    except ImportError:
+        sys.stderr.write("pyserial is required: pip install pyserial\n")
+        return 1
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    with serial.Serial(args.port, args.baud, timeout=0.05) as port:
+        try:
+            upload(Link(port), image, args.version, max(1, args.window), args.compress)
+        except RuntimeError as e:
+            sys.stderr.write("\n%s\n" % e)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,111 @@
+/**
+ * @file bench.c
+ * @brief 主机基准测试运行器
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 用法:
+ * ylab_bench [-f 名称子串] [-t 最短秒数] [--csv]
+ *
+ * @par 计时方法:
+ * 每项从1次迭代开始，运行时间不足最短时间时按已测耗时估算次数重跑，
+ * 每轮最多放大10倍，取最后一轮的结果
+ */
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* 链接器为名称是合法标识符的段生成起止符号 */
+extern const bench_def_t __start_bench_def[];
+extern const bench_def_t __stop_bench_def[];
+
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 运行一项，返回每次迭代的秒数
+ */
+static double bench_run(const bench_def_t *def, double min_time, bench_state_t *state)
+{
+    double elapsed;
+    double scale;
+    double start;
+
+    state->iterations = 1;
+    for (;;) {
+        state->bytes = 0;
+        state->arg = def->arg;
+        start = bench_now();
+        def->func(state);
+        elapsed = bench_now() - start;
+        if ((elapsed >= min_time) || (state->iterations >= (1ULL << 40)))
+            break;
+
+        // 多估计40%，尽量一次达到最短时间
+        scale = (elapsed > 0.0) ? (min_time * 1.4 / elapsed) : 10.0;
+        if (scale > 10.0)
+            scale = 10.0;
+        if (scale < 2.0)
+            scale = 2.0;
+        state->iterations = (uint64_t)((double)state->iterations * scale);
+    }
+    return elapsed / (double)state->iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    const bench_def_t *def;
+    const char *filter = NULL;
+    double min_time = 0.2;
+    bench_state_t state;
+    double per_iter;
+    int csv = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-f") == 0) && (i + 1 < argc))
+            filter = argv[++i];
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+            min_time = atof(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0)
+            csv = 1;
+        else {
+            fprintf(stderr, "usage: %s [-f filter] [-t min_seconds] [--csv]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (csv)
+        printf("name,iterations,ns_per_op,mb_per_s\n");
+    else
+        printf("%-32s %12s %12s %10s\n", "benchmark", "iterations", "ns/op", "MB/s");
+
+    for (def = __start_bench_def; def < __stop_bench_def; def++) {
+        if ((filter != NULL) && (strstr(def->name, filter) == NULL))
+            continue;
+
+        per_iter = bench_run(def, min_time, &state);
+        if (csv) {
+            printf("%s,%llu,%.2f,%.1f\n", def->name, (unsigned long long)state.iterations, per_iter * 1e9,
+                   state.bytes ? (double)state.bytes / per_iter / 1e6 : 0.0);
+        } else if (state.bytes != 0) {
+            printf("%-32s %12llu %12.2f %10.1f\n", def->name, (unsigned long long)state.iterations,
+                   per_iter * 1e9, (double)state.bytes / per_iter / 1e6);
+        } else {
+            printf("%-32s %12llu %12.2f %10s\n", def->name, (unsigned long long)state.iterations,
+                   per_iter * 1e9, "-");
+        }
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file bench.h
+ * @brief 主机基准测试框架
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 在PC上运行与硬件无关的模块(yLib数据结构、shell解析器)的基准测试，
+ * 修改算法后不用烧录即可比较性能；结果以纳秒/次和MB/s给出，
+ * 只反映相对快慢，不代表Cortex-M0+上的绝对耗时
+ *
+ * @par 使用示例:
+ * @code
+ * static void bench_foo(bench_state_t *state)
+ * {
+ *     BENCH_LOOP(state)
+ *     {
+ *         bench_keep(foo(state->arg));
+ *     }
+ * }
+ * BENCH_REGISTER_ARG(bench_foo, 64);
+ * @endcode
+ */
+
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief 单次运行的状态
+ */
+typedef struct bench_state {
+    uint64_t iterations; /* 本轮迭代次数，由框架按最短运行时间调整 */
+    uint64_t bytes;      /* 每次迭代处理的字节数，非0时输出吞吐量 */
+    uint64_t arg;        /* 注册时给出的参数 */
+} bench_state_t;
+
+/**
+ * @brief 基准测试项
+ */
+typedef struct bench_def {
+    const char *name;                    /* 名称，带参数时为"函数名/参数" */
+    void (*func)(bench_state_t *state);  /* 测试函数，执行state->iterations次 */
+    uint64_t arg;                        /* 参数 */
+} bench_def_t;
+
+/**
+ * @brief 注册基准测试项
+ * @note 放入bench_def段，由运行器遍历，与设备操作表和shell命令的导出方式相同；
+ *       显式指定对齐，否则编译器会把较大的静态对象放大对齐，段中各项之间出现空隙
+ */
+#define BENCH_DEF_ATTR __attribute__((used, section("bench_def"), aligned(sizeof(void *))))
+
+#define BENCH_REGISTER_ARG(_func, _arg) \
+    BENCH_DEF_ATTR static const bench_def_t bench_def_##_func##_##_arg = {#_func "/" #_arg, _func, _arg}
+
+#define BENCH_REGISTER(_func) \
+    BENCH_DEF_ATTR static const bench_def_t bench_def_##_func = {#_func, _func, 0}
+
+/**
+ * @brief 计时循环
+ */
+#define BENCH_LOOP(state) for (uint64_t bench_i = 0; bench_i < (state)->iterations; bench_i++)
+
+/**
+ * @brief 阻止编译器把结果当作无用而删除计算
+ */
+static inline void bench_keep(const void *p)
+{
+    __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+/**
+ * @brief 伪随机数，结果可复现
+ */
+static inline uint32_t bench_rand(uint32_t *seed)
+{
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+#endif /* HOST_BENCH_H */
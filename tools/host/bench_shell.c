@@ -0,0 +1,97 @@
+/**
+ * @file bench_shell.c
+ * @brief shell解析器基准测试
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ *
+ * @par 功能描述:
+ * 以shellRun执行整行命令，覆盖分词、命令查找和参数转换，输出丢弃
+ */
+
+#include "bench.h"
+#include "shell.h"
+
+#define BENCH_SHELL_BUFFER 512 /* 与串口shell相同的输入缓冲大小 */
+
+static Shell bench_shell;
+static char bench_shell_buffer[BENCH_SHELL_BUFFER];
+static volatile int bench_shell_sum;
+
+static int32_t bench_shell_write(const void *data, uint16_t len)
+{
+    (void)data;
+    return len;
+}
+
+static int32_t bench_shell_read(void *data, uint16_t len)
+{
+    (void)data;
+    (void)len;
+    return 0;
+}
+
+static int bench_shell_nop(int argc, char *argv[])
+{
+    (void)argv;
+    bench_shell_sum += argc;
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN),
+                 bnop, bench_shell_nop, benchmark no-op);
+
+static int bench_shell_add(int a, int b, int c)
+{
+    bench_shell_sum += a + b + c;
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN,
+                 badd, bench_shell_add, benchmark typed arguments);
+
+static void bench_shell_init(void)
+{
+    if (bench_shell.write == NULL) {
+        bench_shell.write = bench_shell_write;
+        bench_shell.read = bench_shell_read;
+        shellInit(&bench_shell, bench_shell_buffer, BENCH_SHELL_BUFFER);
+    }
+}
+
+/**
+ * @brief main风格命令，字符串参数不转换
+ */
+static void bench_shell_main(bench_state_t *state)
+{
+    bench_shell_init();
+    BENCH_LOOP(state)
+    {
+        (void)shellRun(&bench_shell, "bnop alpha \"quoted arg\" 3");
+    }
+}
+BENCH_REGISTER(bench_shell_main);
+
+/**
+ * @brief 函数风格命令，参数按类型转换为整数
+ */
+static void bench_shell_func(bench_state_t *state)
+{
+    bench_shell_init();
+    BENCH_LOOP(state)
+    {
+        (void)shellRun(&bench_shell, "badd 12 0x20 -7");
+    }
+}
+BENCH_REGISTER(bench_shell_func);
+
+/**
+ * @brief 不存在的命令，测量查找失败的路径
+ */
+static void bench_shell_miss(bench_state_t *state)
+{
+    bench_shell_init();
+    BENCH_LOOP(state)
+    {
+        (void)shellRun(&bench_shell, "nosuchcommand 1 2");
+    }
+}
+BENCH_REGISTER(bench_shell_miss);
@@ -0,0 +1,229 @@
+/**
+ * @file bench_ylib.c
+ * @brief yLib数据结构基准测试
+ * @version 1.0
+ * @date 2025
+ * @author YLab Development Team
+ */
+
+#include "bench.h"
+#include "yLib_crc.h"
+#include "yLib_hash.h"
+#include "yLib_heap.h"
+#include "yLib_memops.h"
+#include "yLib_mempool.h"
+#include "yLib_rbtree.h"
+#include "yLib_ring.h"
+
+#include <string.h>
+
+#define BENCH_RING_SIZE 256   /* 环形队列元素数 */
+#define BENCH_HEAP_SLOTS 32   /* 堆测试同时持有的块数 */
+#define BENCH_TREE_NODES 1024 /* 红黑树节点数上限 */
+#define BENCH_HASH_SLOTS 1024 /* 哈希表槽数 */
+#define BENCH_BUF_SIZE 4096   /* 拷贝和校验缓冲区大小 */
+
+static uint8_t bench_src[BENCH_BUF_SIZE];
+static uint8_t bench_dst[BENCH_BUF_SIZE];
+
+/**
+ * @brief 环形队列批量入队再出队，参数为每批元素数
+ */
+static void bench_ring_bulk(bench_state_t *state)
+{
+    static uint32_t buffer[BENCH_RING_SIZE];
+    static uint32_t data[BENCH_RING_SIZE];
+    struct ylib_ring ring;
+    unsigned int n = (unsigned int)state->arg;
+
+    ylib_ring_init(&ring, buffer, BENCH_RING_SIZE);
+    BENCH_LOOP(state)
+    {
+        (void)ylib_ring_enqueue_bulk(&ring, data, n, sizeof(uint32_t));
+        (void)ylib_ring_dequeue_bulk(&ring, data, n, sizeof(uint32_t));
+        bench_keep(data);
+    }
+    state->bytes = (uint64_t)n * sizeof(uint32_t);
+}
+BENCH_REGISTER_ARG(bench_ring_bulk, 1);
+BENCH_REGISTER_ARG(bench_ring_bulk, 16);
+BENCH_REGISTER_ARG(bench_ring_bulk, 128);
+
+/**
+ * @brief 多生产者接口入队出队单个元素，与单生产者比较CAS开销
+ */
+static void bench_ring_mp(bench_state_t *state)
+{
+    static uint32_t buffer[BENCH_RING_SIZE];
+    struct ylib_ring ring;
+    uint32_t value = 0;
+
+    ylib_ring_init(&ring, buffer, BENCH_RING_SIZE);
+    BENCH_LOOP(state)
+    {
+        (void)ylib_ring_mp_enqueue(&ring, &value, sizeof(value));
+        (void)ylib_ring_mc_dequeue(&ring, &value, sizeof(value));
+    }
+    bench_keep(&value);
+}
+BENCH_REGISTER(bench_ring_mp);
+
+/**
+ * @brief 随机大小的分配和释放，参数为最大块大小
+ * @note 同时持有BENCH_HEAP_SLOTS个块，每次替换其中一个，模拟碎片化后的稳态
+ */
+static void bench_heap_mixed(bench_state_t *state)
+{
+    void *slots[BENCH_HEAP_SLOTS] = {0};
+    uint32_t seed = 1;
+    uint32_t r;
+
+    BENCH_LOOP(state)
+    {
+        r = bench_rand(&seed);
+        ylib_free(slots[r % BENCH_HEAP_SLOTS]);
+        slots[r % BENCH_HEAP_SLOTS] = ylib_malloc(8 + (r >> 8) % state->arg);
+    }
+    for (r = 0; r < BENCH_HEAP_SLOTS; r++)
+        ylib_free(slots[r]);
+}
+BENCH_REGISTER_ARG(bench_heap_mixed, 64);
+BENCH_REGISTER_ARG(bench_heap_mixed, 512);
+
+/**
+ * @brief 固定大小内存池分配和释放
+ */
+static void bench_mempool(bench_state_t *state)
+{
+    ylib_mempool_t *pool = ylib_mempool_create(32, 16);
+    void *block;
+
+    if (pool == NULL)
+        return;
+    BENCH_LOOP(state)
+    {
+        block = ylib_mempool_alloc(pool);
+        bench_keep(block);
+        (void)ylib_mempool_free(pool, block);
+    }
+    ylib_mempool_destroy(pool);
+}
+BENCH_REGISTER(bench_mempool);
+
+typedef struct {
+    struct ylib_rb_node node;
+    uint32_t key;
+} bench_tree_node_t;
+
+static void bench_tree_insert(struct ylib_rb_root *root, bench_tree_node_t *item)
+{
+    struct ylib_rb_node **link = &root->rb_node;
+    struct ylib_rb_node *parent = NULL;
+
+    while (*link != NULL) {
+        parent = *link;
+        if (item->key < ylib_rb_entry(parent, bench_tree_node_t, node)->key)
+            link = &parent->rb_left;
+        else
+            link = &parent->rb_right;
+    }
+    ylib_rb_link_node(&item->node, parent, link);
+    ylib_rb_insert_color(&item->node, root);
+}
+
+/**
+ * @brief 红黑树插入再删除，参数为树中节点数
+ * @note 每次迭代删除一个节点再以新键插入，树大小保持不变
+ */
+static void bench_rbtree(bench_state_t *state)
+{
+    static bench_tree_node_t nodes[BENCH_TREE_NODES];
+    struct ylib_rb_root root = YLIB_RB_ROOT;
+    uint32_t n = (uint32_t)state->arg;
+    uint32_t seed = 1;
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        nodes[i].key = bench_rand(&seed);
+        bench_tree_insert(&root, &nodes[i]);
+    }
+    BENCH_LOOP(state)
+    {
+        i = bench_rand(&seed) % n;
+        ylib_rb_erase(&nodes[i].node, &root);
+        nodes[i].key = bench_rand(&seed);
+        bench_tree_insert(&root, &nodes[i]);
+    }
+    bench_keep(&root);
+}
+BENCH_REGISTER_ARG(bench_rbtree, 64);
+BENCH_REGISTER_ARG(bench_rbtree, 1024);
+
+/**
+ * @brief 整数键哈希表插入、查找和删除，参数为表中元素数
+ */
+static void bench_hash(bench_state_t *state)
+{
+    static ylib_hash_slot_t slots[BENCH_HASH_SLOTS];
+    struct ylib_hash hash;
+    uint32_t n = (uint32_t)state->arg;
+    uintptr_t key;
+    void *value;
+    uint32_t i;
+
+    (void)ylib_hash_init(&hash, slots, BENCH_HASH_SLOTS, YLIB_HASH_KEY_INT);
+    for (i = 1; i <= n; i++)
+        (void)ylib_hash_put(&hash, i, (void *)(uintptr_t)i);
+    BENCH_LOOP(state)
+    {
+        key = (uintptr_t)(bench_i % n) + 1;
+        bench_keep(ylib_hash_get(&hash, key));
+        (void)ylib_hash_remove(&hash, key, &value);
+        (void)ylib_hash_put(&hash, key, value);
+    }
+}
+BENCH_REGISTER_ARG(bench_hash, 64);
+BENCH_REGISTER_ARG(bench_hash, 512);
+
+/**
+ * @brief 软件CRC-32，参数为数据长度
+ */
+static void bench_crc32(bench_state_t *state)
+{
+    uint32_t crc = 0;
+
+    BENCH_LOOP(state)
+    {
+        crc = ylib_crc32_sw(crc, bench_src, (size_t)state->arg);
+    }
+    bench_keep(&crc);
+    state->bytes = state->arg;
+}
+BENCH_REGISTER_ARG(bench_crc32, 64);
+BENCH_REGISTER_ARG(bench_crc32, 4096);
+
+/**
+ * @brief 内存拷贝，参数为长度，源和目的错开1字节测试非对齐路径
+ */
+static void bench_memcpy(bench_state_t *state)
+{
+    BENCH_LOOP(state)
+    {
+        (void)ylib_memcpy(bench_dst, bench_src, (size_t)state->arg);
+        bench_keep(bench_dst);
+    }
+    state->bytes = state->arg;
+}
+BENCH_REGISTER_ARG(bench_memcpy, 16);
+BENCH_REGISTER_ARG(bench_memcpy, 4096);
+
+static void bench_memcpy_unaligned(bench_state_t *state)
+{
+    BENCH_LOOP(state)
+    {
+        (void)ylib_memcpy(bench_dst + 1, bench_src, (size_t)state->arg);
+        bench_keep(bench_dst);
+    }
+    state->bytes = state->arg;
+}
+BENCH_REGISTER_ARG(bench_memcpy_unaligned, 4095);
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+yLib_log 二进制日志解码
+
+从串口抓取的原始字节中取LOG_FRAME_ID帧(格式见1-app/task/inc/logsink.h)，
+按固件ELF中ylib_log_fmt段的格式串展开为文本。记录中的格式串编号是相对段起始的偏移；
+%s参数是常量字符串的地址，从ELF中可加载的段里取出。
+串口上的 log sink frame 输出和 log dump 导出的Flash日志区格式相同。
+
+用法:
+    log_decode.py build/Release/YLab_STM32G0_Template.elf capture.bin
+    log_decode.py app.elf capture.bin --level 2
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from trace_decode import frames
+
+LOG_FRAME_ID = 0x4C
+
+LOGSINK_HEADER = 0
+LOGSINK_RECORDS = 1
+
+ID_LOST = 0xFFFF
+LEVELS = "DIWE"
+
+# printf转换说明：标志、宽度、精度、长度修饰、转换字符
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*|\*)(?:\.(\d*|\*))?(hh|h|ll|l|j|z|t|L)?([diouxXcspfFeEgGaA%])")
+
+
+class Elf:
+    """只读取节头，取出格式串段和可加载段"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError("%s: not a little-endian ELF32 file" % path)
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+        headers = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+        self.sections = {}
+        self.loaded = []
+        for name, kind, flags, addr, offset, size, _, _, _, _ in headers:
+            end = data.index(b"\0", names[4] + name)
+            sname = data[names[4] + name:end].decode()
+            body = data[offset:offset + size] if kind != 8 else b""  # SHT_NOBITS
+            self.sections[sname] = body
+            if flags & 0x2 and body:  # SHF_ALLOC
+                self.loaded.append((addr, body))
+        if "ylib_log_fmt" not in self.sections:
+            raise ValueError("%s: no ylib_log_fmt section" % path)
+        self.fmt = self.sections["ylib_log_fmt"]
+
+    def string(self, data, offset):
+        end = data.find(b"\0", offset)
+        return data[offset:end if end >= 0 else len(data)].decode("utf-8", "replace")
+
+    def format_string(self, ident):
+        return self.string(self.fmt, ident) if ident < len(self.fmt) else None
+
+    def cstring(self, addr):
+        for base, body in self.loaded:
+            if base <= addr < base + len(body):
+                return self.string(body, addr - base)
+        return None
+
+
+def expand(elf, fmt, args):
+    """按printf规则展开，参数均为32位整数"""
+    args = list(args)
+
+    def repl(m):
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            return "%"
+        if not args:
+            return m.group(0)
+        value = args.pop(0)
+        if conv in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+        elif conv == "c":
+            value = chr(value & 0xFF)
+        elif conv == "s":
+            text = elf.cstring(value)
+            value = text if text is not None else "<0x%08x>" % value
+        elif conv == "p":
+            conv, flags = "x", flags + "#"
+        elif conv not in "ouxX":
+            return "<%s:0x%08x>" % (m.group(0), value)
+        spec = "%" + flags + width + ("." + prec if prec is not None else "") + conv.replace("u", "d")
+        return spec % value
+
+    return CONVERSION.sub(repl, fmt)
+
+
+def records(raw):
+    """依次返回('header', 时钟频率, 丢弃数)或('record', 记录头, 时间戳, 参数)"""
+    for fid, payload in frames(raw):
+        if fid != LOG_FRAME_ID or len(payload) < 1:
+            continue
+        kind = payload[0]
+        if kind == LOGSINK_HEADER and len(payload) >= 14 and payload[1:5] == b"YLOG":
+            hz, dropped = struct.unpack_from("<II", payload, 6)
+            yield ("header", hz, dropped)
+        elif kind == LOGSINK_RECORDS:
+            words = struct.unpack_from("<%dI" % ((len(payload) - 1) // 4), payload, 1)
+            i = 0
+            while i + 2 <= len(words):
+                hdr = words[i]
+                n = (hdr >> 16) & 0x7
+                yield ("record", hdr, words[i + 1], words[i + 2:i + 2 + n])
+                i += 2 + n
+
+
+def main():
+    parser = argparse.ArgumentParser(description="expand yLib_log binary records")
+    parser.add_argument("elf", help="firmware ELF with the ylib_log_fmt section")
+    parser.add_argument("capture", help="raw serial capture")
+    parser.add_argument("--level", type=int, default=0, help="minimum level to print (0~3)")
+    args = parser.parse_args()
+
+    try:
+        elf = Elf(args.elf)
+    except (OSError, ValueError) as e:
+        sys.stderr.write("%s\n" % e)
+        return 1
+    with open(args.capture, "rb") as f:
+        raw = f.read()
+
+    hz = 1000000
+    for item in records(raw):
+        if item[0] == "header":
+            hz = item[1] or hz
+            print("-- log start, %d Hz, %d dropped before" % (hz, item[2]))
+            continue
+        _, hdr, stamp, values = item
+        level = (hdr >> 20) & 0x3
+        if level < args.level:
+            continue
+        ident = hdr & 0xFFFF
+        if ident == ID_LOST:
+            text = "<%d lost>" % (values[0] if values else 0)
+        else:
+            fmt = elf.format_string(ident)
+            text = expand(elf, fmt, values) if fmt is not None else "<unknown format %d>" % ident
+        print("[%.6f %s] %s" % (stamp / float(hz), LEVELS[level], text))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+yLib_lz格式的压缩和解压
+
+与3-ySTM32G0Platform/yLib/inc/yLib_lz.h的流格式相同：窗口1024字节，标志字节后跟最多8项，
+字面量1字节，匹配2字节(距离10位、长度6位，长度3~66)。fw_upload.py用它压缩固件镜像，
+设备边收边流式解压。压缩用3字节前缀的位置表代替设备上的逐个比较，结果同样合法，
+但不保证与设备压缩的输出逐字节相同。
+
+用法:
+    lz.py app.bin app.lz
+    lz.py -d app.lz app.bin
+"""
+
+import argparse
+import sys
+
+WINDOW = 1024
+MATCH_MIN = 3
+MATCH_MAX = 66
+CANDIDATES = 64  # 每个前缀最多比较的位置数
+
+
+def compress(data):
+    out = bytearray()
+    heads = {}
+    flag_at = 0
+    item = 8
+    i = 0
+
+    def remember(pos):
+        if pos + MATCH_MIN <= len(data):
+            heads.setdefault(data[pos:pos + MATCH_MIN], []).append(pos)
+
+    while i < len(data):
+        if item == 8:
+            flag_at = len(out)
+            out.append(0)
+            item = 0
+
+        best, dist = 0, 0
+        limit = min(len(data) - i, MATCH_MAX)
+        if limit >= MATCH_MIN:
+            for j in reversed(heads.get(data[i:i + MATCH_MIN], [])[-CANDIDATES:]):
+                if i - j > WINDOW:
+                    break
+                n = MATCH_MIN
+                while n < limit and data[j + n] == data[i + n]:
+                    n += 1
+                if n > best:
+                    best, dist = n, i - j
+                    if n == limit:
+                        break
+
+        if best >= MATCH_MIN:
+            out[flag_at] |= 1 << item
+            out.append((dist - 1) & 0xFF)
+            out.append(((dist - 1) >> 8) << 6 | (best - MATCH_MIN))
+            for k in range(best):
+                remember(i + k)
+            i += best
+        else:
+            out.append(data[i])
+            remember(i)
+            i += 1
+        item += 1
+    return bytes(out)
+
+
+def decompress(data):
+    out = bytearray()
+    flags = 0
+    items = 0
+    i = 0
+    while i < len(data):
+        if items == 0:
+            flags, items = data[i], 8
+            i += 1
+            continue
+        if flags & 1:
+            if i + 2 > len(data):
+                raise ValueError("truncated match at %d" % i)
+            dist = (data[i] | (data[i + 1] >> 6) << 8) + 1
+            n = (data[i + 1] & 0x3F) + MATCH_MIN
+            i += 2
+            if dist > len(out):
+                raise ValueError("distance %d before start at %d" % (dist, i))
+            for _ in range(n):
+                out.append(out[-dist])
+        else:
+            out.append(data[i])
+            i += 1
+        flags >>= 1
+        items -= 1
+    return bytes(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="compress or decompress in the yLib_lz format")
+    ap.add_argument("input")
+    ap.add_argument("output")
+    ap.add_argument("-d", "--decompress", action="store_true", help="decompress instead")
+    args = ap.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    try:
+        result = decompress(data) if args.decompress else compress(data)
+    except ValueError as e:
+        sys.stderr.write("%s: %s\n" % (args.input, e))
+        return 1
+    with open(args.output, "wb") as f:
+        f.write(result)
+    print("%d -> %d bytes" % (len(data), len(result)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""
+内存预算报告
+
+解析链接生成的map文件，按模块(静态库/CMake目标)和输出段统计Flash与RAM用量，
+单列任务堆栈、内核对象、缓冲区和yLib/FreeRTOS共用堆，余量低于门限时返回非0使构建失败。
+构建后自动执行，门限由CMake缓存变量YLAB_BUDGET_*给出，也可单独运行。
+
+模块名取自目标文件路径：libyDrv.a(...) -> yDrv，CMakeFiles/yDev.dir/... -> yDev；
+LTO构建中目标文件是临时的ltrans文件，归为lto。
+缓冲区按-fdata-sections产生的输入段名(.bss.<变量名>)中含buf/buffer/ring/dma识别。
+
+用法:
+    mem_budget.py YLab_STM32G0_Template.map
+    mem_budget.py YLab_STM32G0_Template.map --min-flash-free 4096 --min-heap 10240
+"""
+
+import argparse
+import os
+import re
+import sys
+
+from ram_report import RAM_SECTIONS, parse
+
+SKIP_PREFIXES = (".debug", ".comment", ".ARM.attributes", "._user_heap_stack")
+RE_FLASH = re.compile(r"^FLASH\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+RE_ARCHIVE = re.compile(r"lib([^/\\]+)\.a\(")
+RE_TARGET = re.compile(r"CMakeFiles[/\\]([^/\\]+)\.dir[/\\]")
+RE_BUFFER = re.compile(r"buf|ring|dma", re.IGNORECASE)
+
+
+def flash_length(path):
+    """ram_report只解析RAM区，Flash区长度在这里单独读取"""
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            r = RE_FLASH.match(line)
+            if r:
+                return int(r.group(2), 16)
+    return None
+
+
+def module_name(path):
+    path = path.strip()
+    a = RE_ARCHIVE.search(path)
+    if a:
+        return a.group(1)
+    t = RE_TARGET.search(path)
+    if t:
+        return t.group(1)
+    if ".ltrans" in path:
+        return "lto"
+    return os.path.basename(path)
+
+
+def is_ram(section):
+    return section in RAM_SECTIONS
+
+
+def modules(m):
+    """模块 -> [flash, ram]，.data同时占用Flash(初值)和RAM"""
+    result = {}
+    for output, _, size, obj in m.inputs:
+        if output.startswith(SKIP_PREFIXES):
+            continue
+        entry = result.setdefault(module_name(obj), [0, 0])
+        if is_ram(output):
+            entry[1] += size
+            if output == ".data":
+                entry[0] += size
+        else:
+            entry[0] += size
+    return result
+
+
+def report(m, flash_total, top, out):
+    """输出报告，返回(Flash余量, 共用堆大小)"""
+    flash = 0
+    ram = 0
+    out.write("%-20s %8s %8s\n" % ("section", "flash", "ram"))
+    for name, (_, size) in sorted(m.outputs.items(), key=lambda kv: kv[1][0]):
+        if name.startswith(SKIP_PREFIXES) or size == 0:
+            continue
+        if is_ram(name):
+            ram += size
+            fsize = size if name == ".data" else 0
+            out.write("%-20s %8d %8d\n" % (name, fsize, size))
+        else:
+            fsize = size
+            out.write("%-20s %8d %8s\n" % (name, size, "-"))
+        flash += fsize
+
+    flash_free = None
+    if flash_total is not None:
+        flash_free = flash_total - flash
+        out.write("%-20s %8d / %d, %d free\n" % ("flash total", flash, flash_total, flash_free))
+    if m.ram is not None:
+        out.write("%-20s %8d / %d\n" % ("static ram", ram, m.ram[1]))
+
+    heap = None
+    start = m.symbols.get("__ylib_heap_start")
+    end = m.symbols.get("__ylib_heap_end")
+    if start is not None and end is not None:
+        heap = end - start
+        out.write("%-20s %8d (shared yLib/FreeRTOS heap, RAM headroom)\n" % ("ylib heap", heap))
+    msp = m.symbols.get("_Min_Stack_Size")
+    if msp is not None:
+        out.write("%-20s %8d (main stack, interrupts)\n" % ("msp", msp))
+
+    out.write("\n%-24s %8s %8s\n" % ("module", "flash", "ram"))
+    for name, (f, r) in sorted(modules(m).items(), key=lambda kv: -(kv[1][0] + kv[1][1])):
+        out.write("%-24s %8d %8d\n" % (name, f, r))
+
+    stacks = [(size, module_name(obj)) for output, _, size, obj in m.inputs if output == ".os_stack"]
+    objects = sum(size for output, _, size, _ in m.inputs if output == ".os_object")
+    out.write("\ntask stacks %d, kernel objects %d\n" % (sum(s for s, _ in stacks), objects))
+    for size, name in sorted(stacks, reverse=True):
+        out.write("  %7d  %s\n" % (size, name))
+
+    buffers = [(size, name, module_name(obj)) for output, name, size, obj in m.inputs
+               if is_ram(output) and RE_BUFFER.search(name)]
+    if buffers and top > 0:
+        out.write("\nbuffers %d\n" % sum(s for s, _, _ in buffers))
+        for size, name, obj in sorted(buffers, reverse=True)[:top]:
+            out.write("  %7d  %-32s %s\n" % (size, name, obj))
+
+    return flash_free, heap
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flash/RAM budget report from a GNU ld map file")
+    parser.add_argument("map", help="linker map file")
+    parser.add_argument("--top", type=int, default=10, help="number of largest buffers to list")
+    parser.add_argument("--min-flash-free", type=int, default=0, help="fail if free flash drops below this")
+    parser.add_argument("--min-heap", type=int, default=0, help="fail if the shared heap drops below this")
+    args = parser.parse_args()
+
+    with open(args.map, "r", errors="replace") as f:
+        m = parse(f)
+    if not m.outputs:
+        sys.stderr.write("no sections found in %s\n" % args.map)
+        return 1
+    flash_free, heap = report(m, flash_length(args.map), args.top, sys.stdout)
+
+    failed = False
+    if flash_free is not None and flash_free < args.min_flash_free:
+        sys.stderr.write("budget: flash free %d < %d\n" % (flash_free, args.min_flash_free))
+        failed = True
+    if heap is not None and heap < args.min_heap:
+        sys.stderr.write("budget: shared heap %d < %d\n" % (heap, args.min_heap))
+        failed = True
+    return 2 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
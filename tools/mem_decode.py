@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+内存导出解码
+
+从串口抓取的原始字节中取MEMDIAG_FRAME_ID帧(格式见1-app/task/inc/memdiag.h)，
+按帧中的地址把数据拼回二进制文件，缺失的部分报告出来并以0xFF填充。
+导出由shell的 md -b <addr> <len> 触发，或用 --request 生成读取请求帧直接发给设备。
+
+用法:
+    mem_decode.py capture.bin dump.bin
+    mem_decode.py --request 0x20000000 0x9000 > request.bin
+"""
+
+import argparse
+import struct
+import sys
+
+from trace_decode import crc16_ccitt_false, frames
+
+MEMDIAG_FRAME_ID = 0x4D
+
+MEMDIAG_DATA = 0
+MEMDIAG_END = 1
+MEMDIAG_READ = 2
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for b in data:
+        if b == 0:
+            out.append(len(block) + 1)
+            out += block
+            block = bytearray()
+            continue
+        block.append(b)
+        if len(block) == 254:
+            out.append(255)
+            out += block
+            block = bytearray()
+    out.append(len(block) + 1)
+    out += block
+    return bytes(out)
+
+
+def request(addr, length):
+    body = bytes([MEMDIAG_FRAME_ID, MEMDIAG_READ]) + struct.pack("<II", addr, length)
+    return b"\x00" + cobs_encode(body + struct.pack("<H", crc16_ccitt_false(body))) + b"\x00"
+
+
+def parse(raw):
+    """返回最后一次完整导出的(起始地址, 长度, {地址: 数据})"""
+    chunks = {}
+    result = None
+    for fid, payload in frames(raw):
+        if fid != MEMDIAG_FRAME_ID or len(payload) < 5:
+            continue
+        kind = payload[0]
+        addr = struct.unpack_from("<I", payload, 1)[0]
+        if kind == MEMDIAG_DATA:
+            chunks[addr] = payload[5:]
+        elif kind == MEMDIAG_END and len(payload) >= 9:
+            length = struct.unpack_from("<I", payload, 5)[0]
+            result = (addr, length, {a: d for a, d in chunks.items() if addr <= a < addr + length})
+            chunks = {}
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode memdiag memory dump frames")
+    parser.add_argument("capture", nargs="?", help="raw serial capture")
+    parser.add_argument("output", nargs="?", help="binary output file")
+    parser.add_argument("--request", nargs=2, metavar=("ADDR", "LEN"), help="write a read request frame to stdout")
+    args = parser.parse_args()
+
+    if args.request:
+        sys.stdout.buffer.write(request(int(args.request[0], 0), int(args.request[1], 0)))
+        return 0
+    if not args.capture or not args.output:
+        parser.error("capture and output are required")
+
+    with open(args.capture, "rb") as f:
+        result = parse(f.read())
+    if result is None:
+        print("no complete dump found", file=sys.stderr)
+        return 1
+    start, length, chunks = result
+    if length == 0:
+        print("device rejected 0x%08x" % start, file=sys.stderr)
+        return 1
+
+    image = bytearray(b"\xff" * length)
+    covered = bytearray(length)
+    for addr, data in chunks.items():
+        off = addr - start
+        data = data[:length - off]
+        image[off:off + len(data)] = data
+        covered[off:off + len(data)] = b"\x01" * len(data)
+    missing = covered.count(0)
+    if missing:
+        print("%d bytes missing" % missing, file=sys.stderr)
+    with open(args.output, "wb") as f:
+        f.write(image)
+    print("0x%08x %d bytes" % (start, length))
+    return 0 if missing == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+性能回归检查
+
+收集设备perfsuite命令发出的PERF帧(格式见1-app/task/inc/serialshell.h)，保存为基线或与基线比较。
+结果可以直接从串口取：经隧道shell帧发送perfsuite并等待结束帧；也可以读取事先保存的串口原始数据。
+ylab_bench固件不带shell，自己周期性地发出一轮结果，用--listen只接收，从第一个结束帧之后开始收一整轮。
+比较时按类型区分方向：周期数和微秒数变大、吞吐量变小超过阈值记为回归，有回归时返回1。
+主频与基线不同时只给出警告，周期数仍可比较，时间和吞吐量的差别要结合主频看。
+从串口读取需要pyserial。
+
+用法:
+    perf_check.py --port /dev/ttyUSB0 --save perf_baseline.json
+    perf_check.py --port COM5 --baseline perf_baseline.json --threshold 5
+    perf_check.py --capture perf.bin --baseline perf_baseline.json
+    perf_check.py --listen /dev/ttyUSB0 --baseline bench_baseline.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+from mem_decode import cobs_encode
+from trace_decode import crc16_ccitt_false, frames
+
+PERF_FRAME_ID = 0x50
+SHELL_TUNNEL_FRAME_ID = 0x53
+
+KIND_CYCLES = 0
+KIND_US = 1
+KIND_KBPS = 2
+KIND_END = 0xFF
+
+UNITS = {KIND_CYCLES: "cycles", KIND_US: "us", KIND_KBPS: "KB/s"}
+HIGHER_IS_BETTER = {KIND_KBPS}
+
+
+def parse(raw):
+    """返回({名称: (类型, 数值)}, 结束帧的名称)，没有结束帧时后者为None"""
+    metrics = {}
+    info = None
+    for fid, payload in frames(raw):
+        if fid != PERF_FRAME_ID or len(payload) < 5:
+            continue
+        kind, value = payload[0], struct.unpack_from("<I", payload, 1)[0]
+        name = payload[5:].decode(errors="replace")
+        if kind == KIND_END:
+            info = name
+        elif kind in UNITS:
+            metrics[name] = (kind, value)
+    return metrics, info
+
+
+def collect(port, baud, timeout, listen=False):
+    """经隧道shell运行perfsuite，返回收到结束帧前的原始数据
+
+    listen为True时不发命令，丢弃第一个结束帧及之前的数据(可能是半轮)，返回下一整轮
+    """
+    import serial
+
+    body = bytes([SHELL_TUNNEL_FRAME_ID]) + b"perfsuite\r"
+    request = b"\x00" + cobs_encode(body + struct.pack("<H", crc16_ccitt_false(body))) + b"\x00"
+    raw = b""
+    synced = not listen
+    with serial.Serial(port, baud, timeout=0.05) as link:
+        link.reset_input_buffer()
+        if not listen:
+            link.write(request)
+        end = time.monotonic() + timeout
+        while time.monotonic() < end:
+            raw += link.read(link.in_waiting or 1)
+            if parse(raw)[1] is None:
+                continue
+            if synced:
+                break
+            # 从结束帧的尾分隔符之后重新开始，下一轮的帧都是完整的
+            raw = raw[raw.rindex(b"\x00"):]
+            synced = True
+    return raw
+
+
+def compare(metrics, base, threshold):
+    """打印逐项对比，返回回归项数"""
+    regressions = 0
+    for name in sorted(set(metrics) | set(base)):
+        if name not in metrics:
+            print("%-16s missing" % name)
+            regressions += 1
+            continue
+        kind, value = metrics[name]
+        if name not in base:
+            print("%-16s %10d %-6s new" % (name, value, UNITS[kind]))
+            continue
+        old = base[name]["value"]
+        change = (value - old) * 100.0 / old if old else 0.0
+        worse = -change if kind in HIGHER_IS_BETTER else change
+        mark = "REGRESSION" if worse > threshold else ""
+        regressions += 1 if mark else 0
+        print("%-16s %10d %-6s %10d %+7.1f%% %s" % (name, value, UNITS[kind], old, change, mark))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="check perfsuite results against a baseline")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port, runs perfsuite on the device")
+    source.add_argument("--listen", help="serial port of a ylab_bench image, only receives")
+    source.add_argument("--capture", help="raw serial capture containing PERF frames")
+    parser.add_argument("--baud", type=int, default=115200, help="baud rate")
+    parser.add_argument("--timeout", type=float, default=30.0, help="seconds to wait for the suite")
+    parser.add_argument("--save", help="write the results as a new baseline")
+    parser.add_argument("--baseline", help="baseline to compare with")
+    parser.add_argument("--threshold", type=float, default=5.0, help="regression threshold in percent")
+    args = parser.parse_args()
+
+    if args.port or args.listen:
+        try:
+            raw = collect(args.port or args.listen, args.baud, args.timeout, listen=bool(args.listen))
+        except ImportError:
+            sys.stderr.write("pyserial is required: pip install pyserial\n")
+            return 1
+    else:
+        with open(args.capture, "rb") as f:
+            raw = f.read()
+
+    metrics, info = parse(raw)
+    if info is None:
+        sys.stderr.write("no end frame, suite incomplete (%d results)\n" % len(metrics))
+        return 1
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump({"clock": info,
+                       "metrics": {n: {"unit": UNITS[k], "value": v} for n, (k, v) in sorted(metrics.items())}},
+                      f, indent=2)
+            f.write("\n")
+        print("%d results saved to %s (%s)" % (len(metrics), args.save, info))
+
+    if not args.baseline:
+        if not args.save:
+            for name, (kind, value) in sorted(metrics.items()):
+                print("%-16s %10d %s" % (name, value, UNITS[kind]))
+        return 0
+
+    with open(args.baseline) as f:
+        base = json.load(f)
+    if base.get("clock") != info:
+        print("warning: clock %s, baseline %s" % (info, base.get("clock")))
+    regressions = compare(metrics, base["metrics"], args.threshold)
+    print("%d regressions over %.1f%%" % (regressions, args.threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
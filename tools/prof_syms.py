@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""
+采样分析器函数表生成
+
+读取链接后ELF的符号表，取全部有长度的函数(含static和放在RAM中的函数)，
+按1-app/task/inc/prof.h中的格式生成函数表，原位写入ELF中预留的.prof_syms段。
+段大小在编译时固定，写入不改变任何地址；放不下时舍去最短的函数，
+设备上落在这些函数中的样本按地址计数，可在map文件中查到。
+没有.prof_syms段(YLAB_PROF_SYMS_SIZE为0)时不做任何事。
+
+用法:
+    prof_syms.py build/YLab_STM32G0_Template.elf
+    prof_syms.py app.elf --list
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x4D595350
+HEADER = 12
+ENTRY = 8
+NAME_MAX = 31                    # 名字截断长度，不含结尾的0
+SIZE_MAX = 0xFFFF
+
+SHT_SYMTAB = 2
+SHT_PROGBITS = 1
+STT_FUNC = 2
+
+
+def sections(elf):
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        raise ValueError("not a 32-bit little-endian ELF")
+    shoff, = struct.unpack_from("<I", elf, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+    secs = []
+    for i in range(shnum):
+        name, stype, _, addr, offset, size, link = struct.unpack_from("<IIIIIII", elf, shoff + i * shentsize)
+        secs.append({"name": name, "type": stype, "addr": addr, "offset": offset, "size": size, "link": link})
+    strtab = secs[shstrndx]
+    for s in secs:
+        end = elf.index(b"\0", strtab["offset"] + s["name"])
+        s["name"] = elf[strtab["offset"] + s["name"]:end].decode()
+    return secs
+
+
+def functions(elf, secs):
+    funcs = {}
+    for sym in (s for s in secs if s["type"] == SHT_SYMTAB):
+        strtab = secs[sym["link"]]
+        for off in range(sym["offset"], sym["offset"] + sym["size"], 16):
+            name, value, size, info, _, shndx = struct.unpack_from("<IIIBBH", elf, off)
+            if (info & 0xF) != STT_FUNC or size == 0 or shndx == 0:
+                continue
+            end = elf.index(b"\0", strtab["offset"] + name)
+            addr = value & ~1
+            # 同一地址的别名只保留第一个
+            funcs.setdefault(addr, (min(size, SIZE_MAX), elf[strtab["offset"] + name:end][:NAME_MAX]))
+    return funcs
+
+
+def build(funcs, capacity):
+    # 从最长的函数开始放，放不下的舍去
+    keep = {}
+    used = HEADER
+    for addr, (size, name) in sorted(funcs.items(), key=lambda f: -f[1][0]):
+        cost = ENTRY + len(name) + 1
+        if used + cost > capacity:
+            continue
+        keep[addr] = (size, name)
+        used += cost
+
+    entries = bytearray()
+    names = bytearray()
+    for addr in sorted(keep):
+        size, name = keep[addr]
+        entries += struct.pack("<IHH", addr, size, len(names))
+        names += name + b"\0"
+    table = struct.pack("<III", MAGIC, len(keep), HEADER + len(entries)) + entries + names
+    return table + bytes(capacity - len(table)), len(keep)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="fill the profiler function table in a linked ELF")
+    ap.add_argument("elf")
+    ap.add_argument("--list", action="store_true", help="print the functions that were kept")
+    args = ap.parse_args()
+
+    with open(args.elf, "rb") as f:
+        elf = bytearray(f.read())
+    try:
+        secs = sections(elf)
+    except ValueError as e:
+        sys.stderr.write("%s: %s\n" % (args.elf, e))
+        return 1
+
+    target = next((s for s in secs if s["name"] == ".prof_syms"), None)
+    if target is None or target["size"] < HEADER:
+        print("prof_syms: no .prof_syms section, skipped")
+        return 0
+    if target["type"] != SHT_PROGBITS:
+        sys.stderr.write("%s: .prof_syms is not PROGBITS\n" % args.elf)
+        return 1
+
+    funcs = functions(elf, secs)
+    table, kept = build(funcs, target["size"])
+    elf[target["offset"]:target["offset"] + target["size"]] = table
+    with open(args.elf, "wb") as f:
+        f.write(elf)
+
+    print("prof_syms: %d of %d functions in %d bytes at 0x%08x" % (kept, len(funcs), target["size"], target["addr"]))
+    if args.list:
+        count, = struct.unpack_from("<I", table, 4)
+        for i in range(count):
+            addr, size, _ = struct.unpack_from("<IHH", table, HEADER + i * ENTRY)
+            print("0x%08x %6d %s" % (addr, size, funcs[addr][1].decode(errors="replace")))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""
+RAM分布报告
+
+解析链接生成的map文件，列出RAM中各输出段的大小、FreeRTOS静态对象(os_static.h的
+.os_object/.os_stack段)按目标文件的分布、.bss中最大的若干项，以及.bss之后剩余给
+yLib/FreeRTOS共用堆的大小。构建后自动执行，也可单独运行。
+
+用法:
+    ram_report.py YLab_STM32G0_Template.map
+    ram_report.py YLab_STM32G0_Template.map --top 20
+"""
+
+import argparse
+import os
+import re
+import sys
+
+RAM_SECTIONS = (".ram_vector", ".data", ".bss", ".os_object", ".os_stack", ".noinit")
+OS_SECTIONS = (".os_object", ".os_stack")
+
+RE_REGION = re.compile(r"^(\w+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+RE_OUTPUT = re.compile(r"^(\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address.*)?)?\s*$")
+RE_INPUT = re.compile(r"^ (\.\S+|COMMON)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*))?\s*$")
+RE_CONT = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(\S.*))?$")
+RE_ASSIGN = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+(\w+) = ")
+
+
+class MapFile:
+    def __init__(self):
+        self.ram = None              # (origin, length)
+        self.outputs = {}            # 输出段 -> (address, size)
+        self.inputs = []             # (输出段, 输入段, size, 目标文件)
+        self.symbols = {}            # 链接脚本赋值的符号 -> address
+
+
+def parse(lines):
+    m = MapFile()
+    in_memcfg = False
+    in_map = False
+    output = None
+    pending_out = None               # 段名过长时地址和大小在下一行
+    pending_in = None
+
+    for line in lines:
+        line = line.rstrip("\n")
+        if line.startswith("Memory Configuration"):
+            in_memcfg = True
+            continue
+        if line.startswith("Linker script and memory map"):
+            in_memcfg = False
+            in_map = True
+            continue
+        if in_memcfg:
+            r = RE_REGION.match(line)
+            if r and r.group(1) == "RAM":
+                m.ram = (int(r.group(2), 16), int(r.group(3), 16))
+            continue
+        if not in_map:
+            continue
+
+        a = RE_ASSIGN.match(line)
+        if a:
+            m.symbols[a.group(2)] = int(a.group(1), 16)
+            continue
+
+        if pending_out is not None:
+            c = RE_CONT.match(line)
+            if c:
+                m.outputs[pending_out] = (int(c.group(1), 16), int(c.group(2), 16))
+            pending_out = None
+            continue
+        if pending_in is not None:
+            c = RE_CONT.match(line)
+            if c and c.group(3):
+                m.inputs.append((output, pending_in, int(c.group(2), 16), c.group(3)))
+            pending_in = None
+            continue
+
+        o = RE_OUTPUT.match(line)
+        if o:
+            output = o.group(1)
+            if o.group(2) is None:
+                pending_out = output
+            else:
+                m.outputs[output] = (int(o.group(2), 16), int(o.group(3), 16))
+            continue
+
+        i = RE_INPUT.match(line)
+        if i and output is not None:
+            if i.group(2) is None:
+                pending_in = i.group(1)
+            elif int(i.group(3), 16) != 0:
+                m.inputs.append((output, i.group(1), int(i.group(3), 16), i.group(4)))
+    return m
+
+
+def object_name(path):
+    """CMakeFiles/xxx.dir/.../blink.c.obj -> blink.c，库成员保留库名"""
+    name = os.path.basename(path.strip())
+    for suffix in (".obj", ".o"):
+        if name.endswith(suffix):
+            return name[:-len(suffix)]
+    return name
+
+
+def report(m, top, out):
+    total = 0
+    out.write("RAM usage by section\n")
+    for sec in RAM_SECTIONS:
+        if sec not in m.outputs:
+            continue
+        size = m.outputs[sec][1]
+        total += size
+        out.write("  %-20s %7d\n" % (sec, size))
+    if m.ram is not None:
+        out.write("  %-20s %7d / %d\n" % ("static total", total, m.ram[1]))
+    if "._user_heap_stack" in m.outputs:
+        out.write("  %-20s %7d (minimum heap + stack reserve)\n" %
+                  ("._user_heap_stack", m.outputs["._user_heap_stack"][1]))
+
+    start = m.symbols.get("__ylib_heap_start")
+    end = m.symbols.get("__ylib_heap_end")
+    if start is not None and end is not None:
+        out.write("  %-20s %7d (shared yLib/FreeRTOS heap)\n" % ("ylib heap", end - start))
+
+    for sec in OS_SECTIONS:
+        items = {}
+        for output, _, size, obj in m.inputs:
+            if output == sec:
+                key = object_name(obj)
+                items[key] = items.get(key, 0) + size
+        if not items:
+            continue
+        out.write("\n%s\n" % sec)
+        for name, size in sorted(items.items(), key=lambda kv: -kv[1]):
+            out.write("  %7d  %s\n" % (size, name))
+
+    bss = [(size, name, object_name(obj)) for output, name, size, obj in m.inputs if output == ".bss"]
+    if bss and top > 0:
+        out.write("\n.bss top %d\n" % top)
+        for size, name, obj in sorted(bss, reverse=True)[:top]:
+            out.write("  %7d  %-32s %s\n" % (size, name, obj))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RAM usage report from a GNU ld map file")
+    parser.add_argument("map", help="linker map file")
+    parser.add_argument("--top", type=int, default=10, help="number of largest .bss entries to list")
+    args = parser.parse_args()
+
+    with open(args.map, "r", errors="replace") as f:
+        m = parse(f)
+    if not m.outputs:
+        sys.stderr.write("no sections found in %s\n" % args.map)
+        return 1
+    report(m, args.top, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+静态B树索引镜像生成
+
+把"键,值"文本表(校准曲线、ID映射等)生成yLib_sbtree格式的二进制镜像，写入外部Flash后由
+ylib_sbtree_open/find/floor查找，格式见3-ySTM32G0Platform/yLib/inc/yLib_sbtree.h：
+- 键为32位无符号整数，按升序排列，不能重复
+- 值按--value-size字节小端存放，--signed时按有符号数检查范围
+- 每个节点一页，页大小与25Q编程页相同时镜像按页对齐写入，每次查找每层只读一页
+输入每行一条记录，#开头的行和空行忽略，数字可带0x前缀。
+生成后打印层数和各层节点数，以及给定常驻缓冲区大小时每次查找需读取的页数。
+
+用法:
+    sbtree_build.py table.csv table.bin
+    sbtree_build.py table.csv table.bin --value-size 2 --signed --pin 512
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = 0x31544253
+LEVELS_MAX = 4  # 与yLib_config.h中的YLIB_SBTREE_LEVELS_MAX一致
+HEADER = struct.Struct("<IHBBII")
+
+
+def load(path, value_size, signed):
+    lo = -(1 << (value_size * 8 - 1)) if signed else 0
+    hi = (1 << (value_size * 8 - 1)) - 1 if signed else (1 << (value_size * 8)) - 1
+    records = {}
+    with open(path, encoding="utf-8") as f:
+        for no, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            try:
+                key, value = (int(x.strip(), 0) for x in line.split(","))
+            except ValueError:
+                sys.exit("%s:%d: expected 'key,value'" % (path, no))
+            if not 0 <= key <= 0xFFFFFFFF:
+                sys.exit("%s:%d: key out of range" % (path, no))
+            if not lo <= value <= hi:
+                sys.exit("%s:%d: value does not fit in %d bytes" % (path, no, value_size))
+            if key in records:
+                sys.exit("%s:%d: duplicate key 0x%x" % (path, no, key))
+            records[key] = value
+    if not records:
+        sys.exit("%s: no records" % path)
+    return sorted(records.items())
+
+
+def build(records, page_size, value_size, signed):
+    per_leaf = page_size // (4 + value_size)
+    fanout = page_size // 4
+    if per_leaf == 0:
+        sys.exit("value too large for page")
+
+    # 叶子层
+    levels = []
+    leaves = []
+    firsts = []
+    for i in range(0, len(records), per_leaf):
+        chunk = records[i:i + per_leaf]
+        keys = [k for k, _ in chunk] + [0xFFFFFFFF] * (per_leaf - len(chunk))
+        page = struct.pack("<%dI" % per_leaf, *keys)
+        page += b"".join(v.to_bytes(value_size, "little", signed=signed) for _, v in chunk)
+        page += b"\xff" * (page_size - len(page))
+        leaves.append(page)
+        firsts.append(chunk[0][0])
+    levels.append(leaves)
+
+    # 逐层向上，每个节点记录各子节点的最小键
+    while len(levels[0]) > 1:
+        nodes = []
+        upper = []
+        for i in range(0, len(firsts), fanout):
+            keys = firsts[i:i + fanout]
+            nodes.append(struct.pack("<%dI" % len(keys), *keys) + b"\xff" * (page_size - 4 * len(keys)))
+            upper.append(keys[0])
+        levels.insert(0, nodes)
+        firsts = upper
+    if len(levels) > LEVELS_MAX:
+        sys.exit("%d levels exceed YLIB_SBTREE_LEVELS_MAX" % len(levels))
+
+    body = b"".join(b"".join(level) for level in levels)
+    head = HEADER.pack(MAGIC, page_size, value_size, len(levels), len(records), zlib.crc32(body) & 0xFFFFFFFF)
+    head += struct.pack("<I", zlib.crc32(head) & 0xFFFFFFFF)
+    return head + b"\xff" * (page_size - len(head)) + body, [len(level) for level in levels]
+
+
+def main():
+    ap = argparse.ArgumentParser(description="build a static B-tree image for yLib_sbtree")
+    ap.add_argument("input")
+    ap.add_argument("output")
+    ap.add_argument("--page-size", type=int, default=256, help="node page size, power of two (default 256)")
+    ap.add_argument("--value-size", type=int, default=4, help="bytes per value (default 4)")
+    ap.add_argument("--signed", action="store_true", help="values are signed")
+    ap.add_argument("--pin", type=int, default=0, help="RAM bytes for pinned levels, for the report")
+    args = ap.parse_args()
+
+    if args.page_size < 16 or args.page_size > 0xFFFF or args.page_size & (args.page_size - 1):
+        ap.error("page size must be a power of two from 16")
+    if not 1 <= args.value_size <= 255:
+        ap.error("value size must be 1..255")
+
+    records = load(args.input, args.value_size, args.signed)
+    image, nodes = build(records, args.page_size, args.value_size, args.signed)
+    with open(args.output, "wb") as f:
+        f.write(image)
+
+    pinned = 0
+    pages = 0
+    for n in nodes:
+        if (pages + n) * args.page_size > args.pin:
+            break
+        pages += n
+        pinned += 1
+    print("%d records, %d bytes, levels %s" % (len(records), len(image), "/".join(str(n) for n in nodes)))
+    print("pinned %d levels (%d bytes), %d page reads per lookup" %
+          (pinned, pages * args.page_size, len(nodes) - pinned))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
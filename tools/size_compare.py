@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+构建配置的大小/速度对比
+
+比较两次构建(一般是Release和ReleaseFast)的map文件：各输出段的大小、Flash和静态RAM
+合计，以及按函数/数据项(-ffunction-sections/-fdata-sections产生的输入段)变化最大的若干项。
+LTO构建中的目标文件名是临时的ltrans文件，因此按输入段名而不是按目标文件对比。
+
+可选再给出两份shell中bench命令的输出，对比各测试项的中位数周期。
+
+用法:
+    size_compare.py build/Release/YLab_STM32G0_Template.map build/ReleaseFast/YLab_STM32G0_Template.map
+    size_compare.py A.map B.map --top 30 --bench release_bench.txt fast_bench.txt
+"""
+
+import argparse
+import re
+import sys
+
+from ram_report import RAM_SECTIONS, parse
+
+SKIP_PREFIXES = (".debug", ".comment", ".ARM.attributes", "._user_heap_stack")
+RE_LTO_SUFFIX = re.compile(r"(\.(lto_priv|constprop|isra|part|cold)\.?\d*)+$")
+RE_BENCH = re.compile(r"^(\S+)\s+(\d+)\s+(\d+)\s+(\d+)\s*$")
+
+
+def load(path):
+    with open(path, "r", errors="replace") as f:
+        return parse(f)
+
+
+def totals(m):
+    """返回(各输出段大小, Flash合计, 静态RAM合计)，.data同时占用Flash和RAM"""
+    sections = {}
+    flash = 0
+    ram = 0
+    for name, (_, size) in m.outputs.items():
+        if name.startswith(SKIP_PREFIXES) or size == 0:
+            continue
+        sections[name] = size
+        if name in RAM_SECTIONS:
+            ram += size
+            if name == ".data":
+                flash += size
+        else:
+            flash += size
+    return sections, flash, ram
+
+
+def items(m):
+    """输入段名(去掉LTO/克隆后缀) -> 大小"""
+    result = {}
+    for output, name, size, _ in m.inputs:
+        if output.startswith(SKIP_PREFIXES):
+            continue
+        key = RE_LTO_SUFFIX.sub("", name)
+        result[key] = result.get(key, 0) + size
+    return result
+
+
+def load_bench(path):
+    """解析bench命令输出：名称 最小 中位数 最大"""
+    result = {}
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            b = RE_BENCH.match(line.strip())
+            if b:
+                result[b.group(1)] = int(b.group(3))
+    return result
+
+
+def delta(a, b):
+    return "%+d" % (b - a)
+
+
+def report(a, b, top, out):
+    sec_a, flash_a, ram_a = totals(a)
+    sec_b, flash_b, ram_b = totals(b)
+
+    out.write("%-20s %8s %8s %8s\n" % ("section", "A", "B", "delta"))
+    for name in sorted(set(sec_a) | set(sec_b)):
+        sa = sec_a.get(name, 0)
+        sb = sec_b.get(name, 0)
+        out.write("%-20s %8d %8d %8s\n" % (name, sa, sb, delta(sa, sb)))
+    out.write("%-20s %8d %8d %8s\n" % ("flash total", flash_a, flash_b, delta(flash_a, flash_b)))
+    out.write("%-20s %8d %8d %8s\n" % ("static ram", ram_a, ram_b, delta(ram_a, ram_b)))
+
+    if top <= 0:
+        return
+    it_a = items(a)
+    it_b = items(b)
+    changes = []
+    for name in set(it_a) | set(it_b):
+        sa = it_a.get(name, 0)
+        sb = it_b.get(name, 0)
+        if sa != sb:
+            changes.append((abs(sb - sa), name, sa, sb))
+    if changes:
+        out.write("\nlargest changes (0 = removed or inlined)\n")
+        for _, name, sa, sb in sorted(changes, reverse=True)[:top]:
+            out.write("  %7d %7d %7s  %s\n" % (sa, sb, delta(sa, sb), name))
+
+
+def report_bench(a, b, out):
+    out.write("\n%-12s %8s %8s %8s\n" % ("bench", "A", "B", "delta"))
+    for name in sorted(set(a) | set(b)):
+        if name in a and name in b:
+            out.write("%-12s %8d %8d %8s\n" % (name, a[name], b[name], delta(a[name], b[name])))
+        else:
+            out.write("%-12s %8s %8s\n" % (name, a.get(name, "-"), b.get(name, "-")))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare size (and bench cycles) of two builds")
+    parser.add_argument("map_a", help="linker map file of the baseline build")
+    parser.add_argument("map_b", help="linker map file of the build to compare")
+    parser.add_argument("--top", type=int, default=15, help="number of largest per-item changes to list")
+    parser.add_argument("--bench", nargs=2, metavar=("A", "B"), help="captured output of the shell bench command")
+    args = parser.parse_args()
+
+    a = load(args.map_a)
+    b = load(args.map_b)
+    for path, m in ((args.map_a, a), (args.map_b, b)):
+        if not m.outputs:
+            sys.stderr.write("no sections found in %s\n" % path)
+            return 1
+    report(a, b, args.top, sys.stdout)
+
+    if args.bench:
+        report_bench(load_bench(args.bench[0]), load_bench(args.bench[1]), sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+最坏情况堆栈分析
+
+读取编译时 -fstack-usage -fcallgraph-info=su 生成的 .ci 调用图(每个目标文件一个)，
+合并为全局调用图后，从任务入口和中断入口出发求最深路径上的堆栈之和。
+
+结果是下限还是上限取决于调用图是否完整，以下情况在输出中标出：
+    indirect  经函数指针调用(shell命令、驱动操作表、回调)，目标不可知，未计入
+    recursive 递归调用，环上只计一次
+    dynamic   函数内有变长数组或alloca，帧大小不固定
+    extern    调用了没有调用图的函数(newlib、汇编)，未计入
+任务的结果另加上下文切换帧(64字节)，中断的结果另加硬件异常帧(32字节)；
+中断嵌套时主堆栈需要各优先级中最深者之和。
+
+用法:
+    stack_report.py build_dir --root serial_shell_task --root BlinkTaskProcess
+    stack_report.py build_dir --root Startup --path
+"""
+
+import argparse
+import os
+import re
+import sys
+
+TASK_FRAME = 64                  # PendSV保存的r4-r11加硬件压栈的8个字
+ISR_FRAME = 32                   # 硬件压栈的8个字
+MARGIN = 1.25                    # 建议值在最坏情况上留25%余量
+
+RE_NODE = re.compile(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"')
+RE_EDGE = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"')
+RE_BYTES = re.compile(r"(\d+) bytes \(([^)]*)\)")
+
+INDIRECT = "__indirect_call"
+
+
+class Func:
+    def __init__(self, title, size, qualifier):
+        self.title = title
+        self.size = size
+        self.dynamic = "dynamic" in qualifier and "bounded" not in qualifier
+        self.calls = set()
+
+
+def load(build_dir):
+    funcs = {}
+    edges = []
+    for root, _, files in os.walk(build_dir):
+        for name in files:
+            if not name.endswith(".ci"):
+                continue
+            with open(os.path.join(root, name), "r", errors="replace") as f:
+                text = f.read()
+            for title, label in RE_NODE.findall(text):
+                b = RE_BYTES.search(label.replace("\\n", "\n"))
+                if b:
+                    funcs[title] = Func(title, int(b.group(1)), b.group(2))
+            edges += RE_EDGE.findall(text)
+    for src, dst in edges:
+        if src in funcs:
+            funcs[src].calls.add(dst)
+    return funcs
+
+
+def short(title):
+    """静态函数的标题为 file.c:name"""
+    return title.rsplit(":", 1)[-1]
+
+
+def find(funcs, name):
+    if name in funcs:
+        return [name]
+    return sorted(t for t in funcs if short(t) == name)
+
+
+class Solver:
+    def __init__(self, funcs):
+        self.funcs = funcs
+        self.memo = {}
+        self.active = set()
+
+    def resolve(self, title):
+        """外部调用按函数名找定义，静态函数的标题已带文件名"""
+        if title in self.funcs:
+            return title
+        return None
+
+    def solve(self, title):
+        """返回 (最深堆栈, 路径, 标记集合, 未解析的外部函数)"""
+        if title in self.memo:
+            return self.memo[title]
+        f = self.funcs[title]
+        self.active.add(title)
+        best = (0, [], set(), set())
+        flags = set()
+        externs = set()
+        if f.dynamic:
+            flags.add("dynamic")
+        for callee in f.calls:
+            if callee == INDIRECT:
+                flags.add("indirect")
+                continue
+            target = self.resolve(callee)
+            if target is None:
+                externs.add(callee)
+                continue
+            if target in self.active:
+                flags.add("recursive")
+                continue
+            depth, path, sub_flags, sub_externs = self.solve(target)
+            flags |= sub_flags
+            externs |= sub_externs
+            if depth > best[0]:
+                best = (depth, path, set(), set())
+        self.active.discard(title)
+        result = (f.size + best[0], [title] + best[1], flags, externs)
+        self.memo[title] = result
+        return result
+
+
+def report(funcs, roots, show_path, out):
+    solver = Solver(funcs)
+
+    def line(title, frame, kind):
+        depth, path, flags, externs = solver.solve(title)
+        need = depth + frame
+        note = " ".join(sorted(flags | ({"extern"} if externs else set())))
+        if kind == "task":
+            words = int(need * MARGIN + 3) // 4
+            out.write("  %-28s %6d %6d  %5d  %s\n" % (short(title), depth, need, words, note))
+        else:
+            out.write("  %-28s %6d %6d         %s\n" % (short(title), depth, need, note))
+        if show_path:
+            out.write("      %s\n" % " > ".join(short(t) for t in path))
+            if externs:
+                out.write("      extern: %s\n" % ", ".join(sorted(short(e) for e in externs)))
+        return need
+
+    out.write("task entry                     depth   need  words  (need = depth + %d, words = need x %.2f)\n" %
+              (TASK_FRAME, MARGIN))
+    for name in roots:
+        titles = find(funcs, name)
+        if not titles:
+            out.write("  %-28s   (no call graph)\n" % name)
+        for title in titles:
+            line(title, TASK_FRAME, "task")
+
+    handlers = sorted(t for t in funcs if short(t).endswith("_IRQHandler") or short(t).endswith("_Handler"))
+    if handlers:
+        worst = 0
+        out.write("\ninterrupt entry                depth   need         (need = depth + %d)\n" % ISR_FRAME)
+        for title in handlers:
+            worst = max(worst, line(title, ISR_FRAME, "isr"))
+        out.write("  deepest single handler needs %d bytes of the main stack (_Min_Stack_Size)\n" % worst)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="worst-case stack usage from GCC call graph info")
+    parser.add_argument("build_dir", help="directory searched recursively for .ci files")
+    parser.add_argument("--root", action="append", default=[], help="task entry function, may repeat")
+    parser.add_argument("--path", action="store_true", help="print the deepest call path of each entry")
+    args = parser.parse_args()
+
+    funcs = load(args.build_dir)
+    if not funcs:
+        sys.stderr.write("no .ci files in %s (needs GCC 10+ with -fcallgraph-info=su)\n" % args.build_dir)
+        return 1
+    report(funcs, args.root, args.path, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
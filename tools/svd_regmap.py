@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+SVD寄存器表生成
+
+从STM32G070.svd生成shell的regdump命令使用的寄存器表(C源文件)，结构见
+1-app/task/inc/memdiag.h。表只保留外设名、基地址和寄存器名、偏移：
+- 名称集中在一个字符串池中，表项用16位偏移引用
+- derivedFrom的外设共用被派生外设的寄存器区间
+- 只写寄存器和读出有副作用的寄存器(接收数据寄存器等)标记为不可读，regdump跳过
+- --exclude列出的外设不生成外设项(SVD覆盖整个G0系列，G070没有这些外设，读取会落在保留区)
+构建时由1-app/task/CMakeLists.txt调用，也可单独运行。
+
+用法:
+    svd_regmap.py STM32G070.svd regmap.c
+    svd_regmap.py STM32G070.svd regmap.c --exclude DAC,LPUART
+"""
+
+import argparse
+import sys
+import xml.etree.ElementTree as ET
+
+# 读出会清除标志或弹出FIFO的寄存器，按 外设(派生前) -> 寄存器名
+READ_SIDE_EFFECT = {
+    "ADC": ("ADC_DR",),
+    "SPI1": ("DR",),
+    "USART1": ("RDR",),
+    "LPUART": ("RDR",),
+    "I2C1": ("RXDR",),
+    "HDMI_CEC": ("CEC_RXDR",),
+    "RNG": ("DR",),
+}
+
+# 与memdiag.h中的REGMAP_NOREAD一致
+REGMAP_NOREAD = 0x8000
+
+
+class NamePool:
+    def __init__(self):
+        self.data = bytearray()
+        self.index = {}
+
+    def add(self, name):
+        if name not in self.index:
+            self.index[name] = len(self.data)
+            self.data += name.encode("ascii") + b"\0"
+        return self.index[name]
+
+
+def parse(path):
+    root = ET.parse(path).getroot()
+    periphs = []
+    regs = {}
+    for p in root.iter("peripheral"):
+        name = p.findtext("name")
+        base = int(p.findtext("baseAddress"), 0)
+        periphs.append((name, base, p.get("derivedFrom")))
+        block = p.find("registers")
+        if block is None:
+            continue
+        items = []
+        for r in block.findall("register"):
+            rname = r.findtext("name")
+            offset = int(r.findtext("addressOffset"), 0)
+            readable = r.findtext("access") != "write-only" and rname not in READ_SIDE_EFFECT.get(name, ())
+            items.append((offset, rname, readable))
+        items.sort()
+        regs[name] = items
+    return periphs, regs
+
+
+def generate(periphs, regs, exclude, svd_name):
+    pool = NamePool()
+    reg_lines = []
+    ranges = {}
+    # 只为要生成的外设排布寄存器区间，被排除的外设仍可能是其他外设的派生源(TIM3派生自TIM2)
+    used = set(derived if derived is not None else name for name, _, derived in periphs if name not in exclude)
+    for name, _, derived in periphs:
+        if derived is not None or name not in regs or name not in used:
+            continue
+        ranges[name] = (len(reg_lines), len(regs[name]))
+        for offset, rname, readable in regs[name]:
+            if offset >= REGMAP_NOREAD:
+                sys.exit("%s.%s: offset 0x%x too large" % (name, rname, offset))
+            flags = 0 if readable else REGMAP_NOREAD
+            reg_lines.append("    {%u, 0x%04X}, /* %s */" % (pool.add(rname), offset | flags, rname))
+
+    periph_lines = []
+    for name, base, derived in sorted(periphs, key=lambda x: x[0]):
+        if name in exclude:
+            continue
+        src = derived if derived is not None else name
+        if src not in ranges:
+            continue
+        first, count = ranges[src]
+        periph_lines.append("    {%u, %u, %u, 0x%08XUL}, /* %s */" % (pool.add(name), first, count, base, name))
+
+    if len(pool.data) > 0xFFFF or len(reg_lines) > 0xFFFF:
+        sys.exit("register map too large")
+
+    text = []
+    text.append("/* 由tools/svd_regmap.py从%s生成，不要手工修改 */" % svd_name)
+    text.append('#include "memdiag.h"')
+    text.append("")
+    text.append("static const char regmap_names[] =")
+    line = ""
+    for chunk in pool.data.split(b"\0")[:-1]:
+        piece = chunk.decode("ascii") + "\\0"
+        if len(line) + len(piece) > 100:
+            text.append('    "%s"' % line)
+            line = ""
+        line += piece
+    if line:
+        text.append('    "%s"' % line)
+    text[-1] += ";"
+    text.append("")
+    text.append("static const RegMapReg_t regmap_regs[] = {")
+    text.extend(reg_lines)
+    text.append("};")
+    text.append("")
+    text.append("/* 按名称排序，查找时可二分 */")
+    text.append("static const RegMapPeriph_t regmap_periphs[] = {")
+    text.extend(periph_lines)
+    text.append("};")
+    text.append("")
+    text.append("const RegMap_t regmap = {")
+    text.append("    regmap_names,")
+    text.append("    regmap_regs,")
+    text.append("    regmap_periphs,")
+    text.append("    sizeof(regmap_periphs) / sizeof(regmap_periphs[0]),")
+    text.append("};")
+    text.append("")
+    return "\n".join(text)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="generate regdump register map from SVD")
+    ap.add_argument("svd")
+    ap.add_argument("output")
+    ap.add_argument("--exclude", default="", help="comma separated peripherals to leave out")
+    args = ap.parse_args()
+
+    exclude = set(x for x in args.exclude.split(",") if x)
+    periphs, regs = parse(args.svd)
+    text = generate(periphs, regs, exclude, args.svd.replace("\\", "/").split("/")[-1])
+    with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
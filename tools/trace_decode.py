@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""
+yLib_trace 跟踪记录解码
+
+从串口抓取的原始字节中找出帧(0x00 | COBS(id | payload | crc16) | 0x00)，
+取TRACE_FRAME_ID帧按1-app/task/inc/tracerec.h中的格式解析，输出文本时间线，
+或用 --chrome 输出Chrome/Perfetto可打开的JSON(chrome://tracing, ui.perfetto.dev)。
+shell文本与帧混在同一个串口上时，文本段CRC不通过，直接丢弃。
+
+用法:
+    trace_decode.py capture.bin
+    trace_decode.py capture.bin --chrome trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_FRAME_ID = 0x54
+
+SEG_HEADER = 0
+SEG_TASK = 1
+SEG_RECORDS = 2
+SEG_END = 3
+
+EV_TIME = 0
+EV_LOST = 1
+EV_TASK_IN = 2
+EV_TASK_CREATE = 3
+EV_TICK = 4
+EV_ISR = 5
+EV_QUEUE_SEND = 6
+EV_QUEUE_RECV = 7
+EV_DEV_BEGIN = 8
+EV_DEV_END = 9
+EV_USER = 16
+
+EVENT_NAMES = {
+    EV_TIME: "time",
+    EV_LOST: "lost",
+    EV_TASK_IN: "task_in",
+    EV_TASK_CREATE: "task_create",
+    EV_TICK: "tick",
+    EV_ISR: "isr",
+    EV_QUEUE_SEND: "queue_send",
+    EV_QUEUE_RECV: "queue_recv",
+    EV_DEV_BEGIN: "dev_begin",
+    EV_DEV_END: "dev_end",
+}
+
+# yDev.h中的yDevStatOp_t
+DEV_OPS = ("read", "write", "ioctl", "op3")
+
+# STM32G070中断号，事件参数为异常号(IRQn + 16)
+IRQ_NAMES = {
+    0: "WWDG", 2: "RTC_TAMP", 3: "FLASH", 4: "RCC", 5: "EXTI0_1", 6: "EXTI2_3", 7: "EXTI4_15",
+    9: "DMA1_Ch1", 10: "DMA1_Ch2_3", 11: "DMA1_Ch4_7", 12: "ADC1", 13: "TIM1_BRK_UP", 14: "TIM1_CC",
+    16: "TIM3", 17: "TIM6", 18: "TIM7", 19: "TIM14", 20: "TIM15", 21: "TIM16", 22: "TIM17",
+    23: "I2C1", 24: "I2C2", 25: "SPI1", 26: "SPI2", 27: "USART1", 28: "USART2", 29: "USART3_4",
+}
+
+
+def crc16_ccitt_false(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def frames(raw):
+    """按0x00切分，返回校验通过的(id, payload)"""
+    for chunk in raw.split(b"\x00"):
+        if len(chunk) < 4:
+            continue
+        frame = cobs_decode(chunk)
+        if frame is None or len(frame) < 3:
+            continue
+        body, crc = frame[:-2], struct.unpack("<H", frame[-2:])[0]
+        if crc16_ccitt_false(body) != crc:
+            continue
+        yield body[0], body[1:]
+
+
+class Capture:
+    """一次导出：头部、任务名和记录"""
+
+    def __init__(self):
+        self.clock_hz = 1000000
+        self.count = 0
+        self.dropped = 0
+        self.tasks = {}
+        self.records = []
+        self.complete = False
+
+
+def parse(raw):
+    captures = []
+    cap = None
+    for fid, payload in frames(raw):
+        if fid != TRACE_FRAME_ID or not payload:
+            continue
+        seg, body = payload[0], payload[1:]
+        if seg == SEG_HEADER:
+            if body[:4] != b"YTRC" or body[5] != 8:
+                cap = None
+                continue
+            cap = Capture()
+            cap.clock_hz, cap.count, cap.dropped = struct.unpack_from("<III", body, 6)
+            captures.append(cap)
+        elif cap is None:
+            continue
+        elif seg == SEG_TASK:
+            number = struct.unpack_from("<I", body)[0]
+            cap.tasks[number] = body[4:].decode("ascii", "replace")
+        elif seg == SEG_RECORDS:
+            for off in range(0, len(body) - 7, 8):
+                cap.records.append(struct.unpack_from("<HHI", body, off))
+        elif seg == SEG_END:
+            cap.complete = True
+            cap = None
+    return captures
+
+
+def timeline(cap):
+    """累加时间差得到绝对时间(微秒)，TIME记录重新对齐，32位时钟回绕后继续递增"""
+    now = None
+    for delta, event, arg in cap.records:
+        if event == EV_TIME:
+            now = arg if now is None else now + ((arg - now) & 0xFFFFFFFF)
+            continue
+        if now is None:
+            # 记录被截断，第一条绝对时间之前的时间差没有起点
+            continue
+        now += delta
+        yield now * 1e6 / cap.clock_hz, event, arg
+
+
+def describe(cap, event, arg):
+    if event in (EV_TASK_IN, EV_TASK_CREATE):
+        return cap.tasks.get(arg, "#%d" % arg)
+    if event == EV_ISR:
+        return IRQ_NAMES.get(arg - 16, "exc%d" % arg)
+    if event in (EV_QUEUE_SEND, EV_QUEUE_RECV):
+        return "0x%08x" % arg
+    if event == EV_DEV_BEGIN:
+        return "0x%08x %s" % (arg & ~3, DEV_OPS[arg & 3])
+    if event == EV_DEV_END:
+        return str(arg - (1 << 32) if arg & 0x80000000 else arg)
+    return str(arg)
+
+
+def print_text(cap, out):
+    out.write("# %d records, %d dropped, clock %d Hz%s\n" %
+              (cap.count, cap.dropped, cap.clock_hz, "" if cap.complete else ", incomplete"))
+    start = None
+    for us, event, arg in timeline(cap):
+        if start is None:
+            start = us
+        name = EVENT_NAMES.get(event, "user%d" % (event - EV_USER) if event >= EV_USER else "ev%d" % event)
+        out.write("%12.1f  %-12s %s\n" % (us - start, name, describe(cap, event, arg)))
+
+
+def chrome_events(cap, pid):
+    """任务切入到下一次切入为一个切片，yDev开始到结束为一个切片，其余为瞬时事件"""
+    events = []
+    current = None
+    dev_open = 0
+    last_us = 0.0
+    for us, event, arg in timeline(cap):
+        last_us = us
+        if event == EV_TASK_IN:
+            if current is not None:
+                events.append({"ph": "E", "pid": pid, "tid": 0, "ts": us})
+            current = arg
+            events.append({"ph": "B", "pid": pid, "tid": 0, "ts": us, "name": describe(cap, event, arg)})
+        elif event == EV_DEV_BEGIN:
+            dev_open += 1
+            events.append({"ph": "B", "pid": pid, "tid": 1, "ts": us, "name": describe(cap, event, arg)})
+        elif event == EV_DEV_END:
+            if dev_open:
+                dev_open -= 1
+                events.append({"ph": "E", "pid": pid, "tid": 1, "ts": us, "args": {"ret": describe(cap, event, arg)}})
+        else:
+            name = EVENT_NAMES.get(event, "user%d" % (event - EV_USER))
+            tid = 2 if event == EV_ISR else 3
+            events.append({"ph": "i", "s": "t", "pid": pid, "tid": tid, "ts": us,
+                           "name": "%s %s" % (name, describe(cap, event, arg))})
+    if current is not None:
+        events.append({"ph": "E", "pid": pid, "tid": 0, "ts": last_us})
+    while dev_open:
+        dev_open -= 1
+        events.append({"ph": "E", "pid": pid, "tid": 1, "ts": last_us})
+    for tid, name in enumerate(("tasks", "ydev", "isr", "kernel")):
+        events.append({"ph": "M", "pid": pid, "tid": tid, "name": "thread_name", "args": {"name": name}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode yLib_trace frames")
+    parser.add_argument("capture", help="raw serial capture")
+    parser.add_argument("--chrome", metavar="JSON", help="write Chrome/Perfetto trace events")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        captures = parse(f.read())
+    if not captures:
+        sys.stderr.write("no trace frames found\n")
+        return 1
+
+    if args.chrome:
+        events = []
+        for pid, cap in enumerate(captures):
+            events += chrome_events(cap, pid)
+        with open(args.chrome, "w") as f:
+            json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, f)
+    else:
+        for cap in captures:
+            print_text(cap, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""
+变量采样解码
+
+从串口抓取的原始字节中取WATCH_FRAME_ID帧(格式见1-app/task/inc/watch.h)，
+输出CSV：第一列为样本序号，第二列为按采样频率换算的时间(秒)，其后每个变量一列。
+采样由shell的 watch <var...> @ <rate> 启动，序号不连续处为设备端缓冲区满丢弃的样本。
+
+用法:
+    watch_decode.py capture.bin > samples.csv
+    watch_decode.py capture.bin --names speed,current > samples.csv
+"""
+
+import argparse
+import struct
+import sys
+
+from trace_decode import frames
+
+WATCH_FRAME_ID = 0x57
+
+WATCH_START = 0
+WATCH_DATA = 1
+WATCH_END = 2
+
+
+def parse(raw):
+    """返回最后一次采样的(频率, 变量数, [(序号, 值元组)], 丢弃数或None)"""
+    result = None
+    for fid, payload in frames(raw):
+        if fid != WATCH_FRAME_ID or len(payload) < 1:
+            continue
+        kind = payload[0]
+        if kind == WATCH_START and len(payload) >= 6:
+            rate, count = struct.unpack_from("<IB", payload, 1)
+            result = [rate, count, [], None]
+        elif result is None:
+            continue
+        elif kind == WATCH_DATA and len(payload) >= 6:
+            seq, count = struct.unpack_from("<IB", payload, 1)
+            if count == 0 or count != result[1]:
+                continue
+            values = payload[6:]
+            step = 4 * count
+            for i in range(len(values) // step):
+                result[2].append((seq + i, struct.unpack_from("<%di" % count, values, i * step)))
+        elif kind == WATCH_END and len(payload) >= 9:
+            result[3] = struct.unpack_from("<I", payload, 5)[0]
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode watch variable sample frames to CSV")
+    parser.add_argument("capture", help="raw serial capture")
+    parser.add_argument("--names", default="", help="comma separated column names")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        result = parse(f.read())
+    if result is None:
+        print("no watch session found", file=sys.stderr)
+        return 1
+    rate, count, samples, dropped = result
+    names = [x for x in args.names.split(",") if x]
+    names += ["var%d" % i for i in range(len(names), count)]
+
+    out = sys.stdout
+    out.write("seq,time,%s\n" % ",".join(names[:count]))
+    for seq, values in samples:
+        out.write("%d,%.6f,%s\n" % (seq, seq / rate if rate else 0.0, ",".join(str(v) for v in values)))
+    gaps = (samples[-1][0] + 1 - len(samples)) if samples else 0
+    if dropped is None:
+        print("%d samples, no end frame" % len(samples), file=sys.stderr)
+    else:
+        print("%d samples, %d dropped" % (len(samples), dropped), file=sys.stderr)
+    return 0 if gaps == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())